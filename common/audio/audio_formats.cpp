@@ -1,7 +1,9 @@
 #include "audio_formats.h"
 
+#include <algorithm>
+
 #include "common/log/log.h"
-#include "common/util/BinaryWriter.h"
+#include "common/util/ThreadPool.h"
 
 #include "third-party/fmt/core.h"
 
@@ -27,79 +29,92 @@ void write_wave_file_mono(const std::vector<s16>& samples, s32 sample_rate, cons
   memcpy(header.subchunk2_id, "data", 4);
   header.subchunk2_size = samples.size() * sizeof(s16);
 
-  BinaryWriter writer;
-  writer.add(header);
-
-  for (auto& samp : samples) {
-    writer.add(samp);
+  // build the whole file, then write it at once.
+  std::vector<u8> data(sizeof(WaveFileHeader) + samples.size() * sizeof(s16));
+  memcpy(data.data(), &header, sizeof(WaveFileHeader));
+  if (!samples.empty()) {
+    memcpy(data.data() + sizeof(WaveFileHeader), samples.data(), samples.size() * sizeof(s16));
   }
-
-  writer.write_to_file(name);
+  file_util::write_binary_file(name, data.data(), data.size());
 }
 
 std::vector<s16> decode_adpcm(BinaryReader& reader) {
   std::vector<s16> decoded_samples;
-  s32 sample_prev[2] = {0, 0};
+  reader.ffwd(decode_adpcm(reader.here(), reader.bytes_left(), &decoded_samples));
+  return decoded_samples;
+}
+
+/*!
+ * Decode ADPCM blocks into out, stopping at the end of the data or at a block with the end flag.
+ * Returns how many bytes were used.
+ */
+size_t decode_adpcm(const u8* data, size_t size, std::vector<s16>* out) {
   constexpr s32 f1[5] = {0, 60, 115, 98, 122};
   constexpr s32 f2[5] = {0, 0, -52, -55, -60};
+  constexpr size_t kBlockBytes = 16;
+  constexpr int kBlockSamples = 28;
 
-  int block_idx = 0;
-  while (true) {
-    if (!reader.bytes_left()) {
-      break;
-    }
-    u8 shift_filter = reader.read<u8>();
-    u8 flags = reader.read<u8>();
+  // each block is a 2 byte header and 14 bytes of samples, so this is enough.
+  size_t first_sample = out->size();
+  out->resize(first_sample + (size / kBlockBytes) * kBlockSamples);
+  s16* dst = out->data() + first_sample;
+
+  s32 sample_prev[2] = {0, 0};
+  size_t offset = 0;
+  while (offset < size) {
+    ASSERT(offset + 2 <= size);
+    u8 shift_filter = data[offset];
+    u8 flags = data[offset + 1];
+    offset += 2;
     u8 shift = shift_filter & 0b1111;
     u8 filter = shift_filter >> 4;
-
-    if (shift > 12) {
-      ASSERT(false);
-    }
-
-    if (filter > 4) {
-      ASSERT(false);
-    }
+    ASSERT(shift <= 12);
+    ASSERT(filter <= 4);
 
     if (flags == 7) {
       break;
     }
 
-    u8 input_buffer[14];
+    ASSERT(offset + 14 <= size);
+    const u8* input_buffer = data + offset;
+    offset += 14;
 
-    for (int i = 0; i < 14; i++) {
-      input_buffer[i] = reader.read<u8>();
+    // unpacking doesn't depend on the previous samples, so it's done first where the compiler can
+    // vectorize it. Only the filter has to go one sample at a time.
+    s32 deltas[kBlockSamples];
+    for (int i = 0; i < kBlockSamples; i++) {
+      u8 nibble = (input_buffer[i / 2] >> ((i % 2) * 4)) & 0xf;
+      deltas[i] = ((s32)(s16)(nibble << 12)) >> shift;
     }
 
-    for (int i = 0; i < 28; i++) {
-      int16_t nibble = input_buffer[i / 2];
-      if (i % 2 == 0) {
-        nibble = (nibble & 0x0f);
-      } else {
-        nibble = (nibble & 0xf0) >> 4;
-      }
-
-      s32 sample = (s32)(s16)(nibble << 12);
-      sample >>= shift;
-      sample += (sample_prev[0] * f1[filter] + sample_prev[1] * f2[filter] + 32) / 64;
-
-      if (sample > 0x7fff) {
-        sample = 0x7fff;
-      }
-
-      if (sample < -0x8000) {
-        sample = -0x8000;
-      }
-
+    const s32 c1 = f1[filter];
+    const s32 c2 = f2[filter];
+    for (int i = 0; i < kBlockSamples; i++) {
+      s32 sample = deltas[i] + (sample_prev[0] * c1 + sample_prev[1] * c2 + 32) / 64;
+      sample = std::clamp(sample, -0x8000, 0x7fff);
       sample_prev[1] = sample_prev[0];
       sample_prev[0] = sample;
-
-      decoded_samples.push_back(sample);
+      *dst++ = sample;
     }
-    block_idx++;
   }
 
-  return decoded_samples;
+  out->resize(dst - out->data());
+  return offset;
+}
+
+/*!
+ * Decode each stream and write it to a wave file. The streams are spread over the global thread
+ * pool, with each one written by the thread that decoded it, so writing one file overlaps decoding
+ * the others. The output folders must already exist.
+ */
+void decode_adpcm_to_wave_files(std::vector<AdpcmWaveJob>& jobs) {
+  parallel_for(jobs.size(), [&](int i) {
+    auto& job = jobs[i];
+    std::vector<s16> samples;
+    job.bytes_used = decode_adpcm(job.data, job.size, &samples);
+    job.sample_count = samples.size();
+    write_wave_file_mono(samples, job.sample_rate, job.output);
+  });
 }
 
 // I attempted to write an encoder below, which works, but has some limitations.
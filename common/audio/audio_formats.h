@@ -32,5 +32,20 @@ struct WaveFileHeader {
 void write_wave_file_mono(const std::vector<s16>& samples, s32 sample_rate, const fs::path& name);
 
 std::vector<s16> decode_adpcm(BinaryReader& reader);
+size_t decode_adpcm(const u8* data, size_t size, std::vector<s16>* out);
+
+// One stream for decode_adpcm_to_wave_files.
+struct AdpcmWaveJob {
+  const u8* data = nullptr;  // ADPCM blocks, after the VAG header. Must stay alive until done.
+  size_t size = 0;
+  s32 sample_rate = 0;
+  fs::path output;
+
+  // set when done
+  size_t sample_count = 0;
+  size_t bytes_used = 0;  // up to and including the end block's header
+};
+
+void decode_adpcm_to_wave_files(std::vector<AdpcmWaveJob>& jobs);
 
 std::vector<u8> encode_adpcm(const std::vector<s16>& samples);
@@ -21,7 +21,7 @@ class XSocketServer {
   XSocketServer& operator=(const XSocketServer&) = delete;
 
   bool init_server();
-  void shutdown_server();
+  virtual void shutdown_server();
   void close_server_socket();
 
   // Abstract methods -- use-case dependent
@@ -1,7 +1,9 @@
 #include "Tfrag3Data.h"
 
 #include <algorithm>
+#include <cstring>
 #include <functional>
+#include <map>
 
 #include "common/util/Assert.h"
 
@@ -279,6 +281,98 @@ void ShrubTree::unpack() {
   ASSERT(i == unpacked.vertices.size());
 }
 
+void ShrubTree::unpack_instanced() {
+  instanced.vertices.resize(packed_vertices.vertices.size());
+  for (size_t i = 0; i < packed_vertices.vertices.size(); i++) {
+    const auto& in = packed_vertices.vertices[i];
+    auto& out = instanced.vertices[i];
+    out.x = in.x;
+    out.y = in.y;
+    out.z = in.z;
+    out.s = in.s;
+    out.t = in.t;
+    memcpy(out.rgba_base, in.rgba, 3);
+    out.pad = 0;
+  }
+
+  // the indices refer to the vertices that unpack() would create, which are all instance groups'
+  // vertices one after another. Find where each group starts so we can map back to prototypes.
+  std::vector<u32> group_starts;
+  u32 total_verts = 0;
+  for (const auto& grp : packed_vertices.instance_groups) {
+    group_starts.push_back(total_verts);
+    total_verts += grp.end_vert - grp.start_vert;
+  }
+  ASSERT(total_verts == packed_vertices.total_vertex_count);
+
+  instanced.instances.clear();
+  instanced.indices.clear();
+  instanced.commands.clear();
+  instanced.draw_commands.clear();
+  for (const auto& draw : static_draws) {
+    // prototype strips -> the groups drawing them, in order of first use.
+    std::map<std::vector<u32>, u32> batch_lookup;
+    std::vector<std::pair<std::vector<u32>, std::vector<u32>>> batches;
+    std::vector<u32> strips;
+    int group = -1;
+
+    auto flush = [&]() {
+      while (!strips.empty() && strips.back() == UINT32_MAX) {
+        strips.pop_back();
+      }
+      if (group >= 0 && !strips.empty()) {
+        auto it = batch_lookup.find(strips);
+        if (it == batch_lookup.end()) {
+          it = batch_lookup.insert({strips, batches.size()}).first;
+          batches.emplace_back().first = strips;
+        }
+        batches[it->second].second.push_back(group);
+      }
+      strips.clear();
+    };
+
+    for (u32 i = 0; i < draw.num_indices; i++) {
+      u32 idx = indices[draw.first_index_index + i];
+      if (idx == UINT32_MAX) {
+        if (!strips.empty()) {
+          strips.push_back(UINT32_MAX);
+        }
+        continue;
+      }
+      auto group_it = std::upper_bound(group_starts.begin(), group_starts.end(), idx);
+      int idx_group = (group_it - group_starts.begin()) - 1;
+      if (idx_group != group) {
+        flush();
+        group = idx_group;
+      }
+      const auto& grp = packed_vertices.instance_groups[group];
+      ASSERT(idx - group_starts[group] < grp.end_vert - grp.start_vert);
+      strips.push_back(idx - group_starts[group] + grp.start_vert);
+    }
+    flush();
+
+    instanced.draw_commands.emplace_back(instanced.commands.size(), batches.size());
+    for (const auto& [batch_strips, groups] : batches) {
+      auto& cmd = instanced.commands.emplace_back();
+      cmd.count = batch_strips.size();
+      cmd.instance_count = groups.size();
+      cmd.first_index = instanced.indices.size();
+      cmd.base_vertex = 0;
+      cmd.base_instance = instanced.instances.size();
+      instanced.indices.insert(instanced.indices.end(), batch_strips.begin(), batch_strips.end());
+      for (auto group_idx : groups) {
+        const auto& grp = packed_vertices.instance_groups[group_idx];
+        auto& inst = instanced.instances.emplace_back();
+        for (int j = 0; j < 4; j++) {
+          inst.mat[j] = packed_vertices.matrices[grp.matrix_idx][j];
+        }
+        inst.color_index = grp.color_index;
+        inst.pad[0] = inst.pad[1] = inst.pad[2] = 0;
+      }
+    }
+  }
+}
+
 void TfragTree::unpack() {
   unpacked.vertices.resize(packed_vertices.vertices.size());
   for (size_t i = 0; i < unpacked.vertices.size(); i++) {
@@ -379,10 +473,13 @@ void Texture::serialize(Serializer& ser) {
   ser.from_ptr(&w);
   ser.from_ptr(&h);
   ser.from_ptr(&combo_id);
-  ser.from_pod_vector(&data);
+  ser.from_pod_vector_or_view(&data, &data_view);
   ser.from_str(&debug_name);
   ser.from_str(&debug_tpage_name);
   ser.from_ptr(&load_to_pool);
+  ser.from_ptr(&compression);
+  ser.from_ptr(&num_mips);
+  ser.from_pod_vector_or_view(&compressed_data, &compressed_data_view);
 }
 
 void CollisionMesh::serialize(Serializer& ser) {
@@ -636,7 +733,7 @@ void TfragTree::memory_usage(MemoryUsageTracker* tracker) const {
 }
 
 void Texture::memory_usage(MemoryUsageTracker* tracker) const {
-  tracker->add(MemoryUsageCategory::TEXTURE, data.size() * sizeof(u32));
+  tracker->add(MemoryUsageCategory::TEXTURE, rgba_size_bytes() + compressed_size_bytes());
 }
 
 void Level::memory_usage(MemoryUsageTracker* tracker) const {
@@ -716,9 +813,27 @@ void print_memory_usage(const tfrag3::Level& lev, int uncompressed_data_size) {
   }
 }
 
+namespace {
+u64 float_bits_for_hash(float f) {
+  // +0 and -0 compare equal, so they must hash the same. Adding zero turns -0 into +0.
+  f += 0.f;
+  u32 bits;
+  memcpy(&bits, &f, sizeof(u32));
+  return bits;
+}
+}  // namespace
+
 std::size_t PreloadedVertex::hash::operator()(const PreloadedVertex& v) const {
-  return std::hash<float>()(v.x) ^ std::hash<float>()(v.y) ^ std::hash<float>()(v.z) ^
-         std::hash<float>()(v.s) ^ std::hash<float>()(v.t) ^ std::hash<u16>()(v.color_index);
+  // xor-ing the fields together made vertices with swapped or repeated components collide, so
+  // the fields are mixed into the hash one at a time instead.
+  u64 h = float_bits_for_hash(v.x);
+  h = (h * 0x9E3779B97F4A7C15ull) ^ float_bits_for_hash(v.y);
+  h = (h * 0x9E3779B97F4A7C15ull) ^ float_bits_for_hash(v.z);
+  h = (h * 0x9E3779B97F4A7C15ull) ^ float_bits_for_hash(v.s);
+  h = (h * 0x9E3779B97F4A7C15ull) ^ float_bits_for_hash(v.t);
+  h = (h * 0x9E3779B97F4A7C15ull) ^ v.color_index;
+  h ^= h >> 32;
+  return h;
 }
 
 }  // namespace tfrag3
@@ -18,7 +18,7 @@ namespace tfrag3 {
 // - if changing any large things (vertices, vis, bvh, colors, textures) update get_memory_usage
 // - if adding a new category to the memory usage, update extract_level to print it.
 
-constexpr int TFRAG3_VERSION = 36;
+constexpr int TFRAG3_VERSION = 37;
 
 enum MemoryUsageCategory {
   TEXTURE,
@@ -148,6 +148,32 @@ struct ShrubGpuVertex {
 };
 static_assert(sizeof(ShrubGpuVertex) == 32, "ShrubGpuVertex size");
 
+// Shrub prototype vertex, for drawing with instancing. The instance matrix is applied on the GPU.
+struct ShrubProtoGpuVertex {
+  float x, y, z;
+  float s, t;
+  u8 rgba_base[3];
+  u8 pad;
+};
+static_assert(sizeof(ShrubProtoGpuVertex) == 24, "ShrubProtoGpuVertex size");
+
+struct ShrubGpuInstance {
+  math::Vector4f mat[4];
+  u32 color_index;
+  u32 pad[3];
+};
+static_assert(sizeof(ShrubGpuInstance) == 80, "ShrubGpuInstance size");
+
+// same layout as OpenGL's DrawElementsIndirectCommand
+struct DrawElementsIndirectCommand {
+  u32 count;
+  u32 instance_count;
+  u32 first_index;
+  u32 base_vertex;
+  u32 base_instance;
+};
+static_assert(sizeof(DrawElementsIndirectCommand) == 20, "DrawElementsIndirectCommand size");
+
 struct PackedShrubVertices {
   struct Vertex {
     float x, y, z;
@@ -280,6 +306,8 @@ struct TimeOfDayColor {
 };
 
 // A single texture. Stored as RGBA8888.
+enum class TextureCompression : u8 { NONE = 0, BC1 = 1, BC3 = 2 };
+
 struct Texture {
   u16 w, h;
   u32 combo_id = 0;
@@ -287,6 +315,31 @@ struct Texture {
   std::string debug_name;
   std::string debug_tpage_name;
   bool load_to_pool = false;
+
+  // if compressed, data is empty and compressed_data has all mip levels, largest first.
+  TextureCompression compression = TextureCompression::NONE;
+  u8 num_mips = 1;
+  std::vector<u8> compressed_data;
+
+  // When loaded by a Serializer that allows views, the pixels are left in the loaded file's data
+  // instead of being copied into data and compressed_data. Use the accessors below to read either.
+  PodView<u32> data_view;
+  PodView<u8> compressed_data_view;
+
+  const u8* rgba_bytes() const {
+    return data_view.empty() ? (const u8*)data.data() : data_view.bytes;
+  }
+  size_t rgba_size_bytes() const {
+    return data_view.empty() ? data.size() * sizeof(u32) : data_view.size_bytes();
+  }
+  const u8* compressed_bytes() const {
+    return compressed_data_view.empty() ? compressed_data.data() : compressed_data_view.bytes;
+  }
+  size_t compressed_size_bytes() const {
+    return compressed_data_view.empty() ? compressed_data.size()
+                                        : compressed_data_view.size_bytes();
+  }
+
   void serialize(Serializer& ser);
   void memory_usage(MemoryUsageTracker* tracker) const;
 };
@@ -415,9 +468,21 @@ struct ShrubTree {
     std::vector<ShrubGpuVertex> vertices;  // mesh vertices
   } unpacked;
 
+  // Alternative to unpacked, for drawing with instancing. Instances that draw the same strips of
+  // the same prototype vertices are grouped into a single indirect draw command.
+  struct {
+    std::vector<ShrubProtoGpuVertex> vertices;  // prototype vertices
+    std::vector<ShrubGpuInstance> instances;
+    std::vector<u32> indices;  // into vertices
+    std::vector<DrawElementsIndirectCommand> commands;
+    // for each static draw, the first command and the number of commands.
+    std::vector<std::pair<u32, u32>> draw_commands;
+  } instanced;
+
   void serialize(Serializer& ser);
   void memory_usage(MemoryUsageTracker* tracker) const;
   void unpack();
+  void unpack_instanced();
 };
 
 struct CollisionMesh {
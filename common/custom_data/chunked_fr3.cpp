@@ -0,0 +1,224 @@
+#include "chunked_fr3.h"
+
+#include <algorithm>
+
+#include "common/util/ThreadPool.h"
+#include "common/util/compress.h"
+
+#include "third-party/fmt/core.h"
+
+namespace tfrag3 {
+
+namespace {
+constexpr u32 TEXTURES_PER_CHUNK = 32;
+
+/*!
+ * The header chunk has the level name and the size of every array, so the other chunks can be
+ * loaded in any order.
+ */
+void serialize_header(Serializer& ser, Level& level) {
+  ser.from_ptr(&level.version);
+  if (ser.is_loading() && level.version != TFRAG3_VERSION) {
+    ASSERT_MSG(false, fmt::format("version mismatch when loading tfrag3 data. Got {}, expected {}, "
+                                  "did you forget to re-decompile?",
+                                  level.version, TFRAG3_VERSION));
+  }
+  ser.from_str(&level.level_name);
+
+  auto from_size = [&](auto& vec) {
+    if (ser.is_saving()) {
+      ser.save<size_t>(vec.size());
+    } else {
+      vec.resize(ser.load<size_t>());
+    }
+  };
+
+  from_size(level.textures);
+  for (auto& geo : level.tfrag_trees) {
+    from_size(geo);
+  }
+  for (auto& geo : level.tie_trees) {
+    from_size(geo);
+  }
+  from_size(level.shrub_trees);
+  level.version2 = level.version;
+}
+
+/*!
+ * Serialize (save or load) the contents of a single non-header chunk.
+ */
+void serialize_chunk(Serializer& ser, const Fr3Chunk& chunk, Level& level) {
+  switch (chunk.section) {
+    case Fr3Section::TEXTURE:
+      ASSERT(chunk.first + chunk.count <= level.textures.size());
+      for (u32 i = 0; i < chunk.count; i++) {
+        level.textures[chunk.first + i].serialize(ser);
+      }
+      break;
+    case Fr3Section::TFRAG:
+      ASSERT(chunk.geo < level.tfrag_trees.size());
+      ASSERT(chunk.first + chunk.count <= level.tfrag_trees[chunk.geo].size());
+      for (u32 i = 0; i < chunk.count; i++) {
+        level.tfrag_trees[chunk.geo][chunk.first + i].serialize(ser);
+      }
+      break;
+    case Fr3Section::TIE:
+      ASSERT(chunk.geo < level.tie_trees.size());
+      ASSERT(chunk.first + chunk.count <= level.tie_trees[chunk.geo].size());
+      for (u32 i = 0; i < chunk.count; i++) {
+        level.tie_trees[chunk.geo][chunk.first + i].serialize(ser);
+      }
+      break;
+    case Fr3Section::SHRUB:
+      ASSERT(chunk.first + chunk.count <= level.shrub_trees.size());
+      for (u32 i = 0; i < chunk.count; i++) {
+        level.shrub_trees[chunk.first + i].serialize(ser);
+      }
+      break;
+    case Fr3Section::COLLISION:
+      level.collision.serialize(ser);
+      break;
+    case Fr3Section::MERC:
+      level.merc_data.serialize(ser);
+      break;
+    default:
+      ASSERT_NOT_REACHED();
+  }
+}
+}  // namespace
+
+std::vector<u8> save_chunked_fr3(Level& level, size_t* uncompressed_size) {
+  // build the list of chunks, in loader order.
+  std::vector<Fr3Chunk> chunks;
+  auto add_chunk = [&](Fr3Section section, u32 geo, u32 first, u32 count) {
+    auto& chunk = chunks.emplace_back();
+    chunk.section = section;
+    chunk.geo = geo;
+    chunk.first = first;
+    chunk.count = count;
+    chunk.offset = 0;
+    chunk.size = 0;
+  };
+  add_chunk(Fr3Section::HEADER, 0, 0, 0);
+  for (u32 geo = 0; geo < level.tie_trees.size(); geo++) {
+    for (u32 i = 0; i < level.tie_trees[geo].size(); i++) {
+      add_chunk(Fr3Section::TIE, geo, i, 1);
+    }
+  }
+  for (u32 i = 0; i < level.textures.size(); i += TEXTURES_PER_CHUNK) {
+    add_chunk(Fr3Section::TEXTURE, 0, i,
+              std::min(TEXTURES_PER_CHUNK, (u32)level.textures.size() - i));
+  }
+  for (u32 geo = 0; geo < level.tfrag_trees.size(); geo++) {
+    for (u32 i = 0; i < level.tfrag_trees[geo].size(); i++) {
+      add_chunk(Fr3Section::TFRAG, geo, i, 1);
+    }
+  }
+  for (u32 i = 0; i < level.shrub_trees.size(); i++) {
+    add_chunk(Fr3Section::SHRUB, 0, i, 1);
+  }
+  add_chunk(Fr3Section::COLLISION, 0, 0, 0);
+  add_chunk(Fr3Section::MERC, 0, 0, 0);
+
+  // compress each chunk. They're independent, so this is spread over the thread pool.
+  std::vector<std::vector<u8>> chunk_data(chunks.size());
+  std::vector<size_t> chunk_uncompressed(chunks.size());
+  parallel_for(chunks.size(), [&](int i) {
+    Serializer ser;
+    if (chunks[i].section == Fr3Section::HEADER) {
+      serialize_header(ser, level);
+    } else {
+      serialize_chunk(ser, chunks[i], level);
+    }
+    chunk_uncompressed[i] = ser.get_save_result().second;
+    chunk_data[i] =
+        compression::compress_zstd(ser.get_save_result().first, ser.get_save_result().second);
+  });
+  size_t total_uncompressed = 0;
+  for (auto size : chunk_uncompressed) {
+    total_uncompressed += size;
+  }
+
+  ChunkedFr3Header header;
+  header.magic = CHUNKED_FR3_MAGIC;
+  header.version = TFRAG3_VERSION;
+  header.chunk_count = chunks.size();
+  header.pad = 0;
+
+  size_t offset = sizeof(ChunkedFr3Header) + sizeof(Fr3Chunk) * chunks.size();
+  for (size_t i = 0; i < chunks.size(); i++) {
+    chunks[i].offset = offset;
+    chunks[i].size = chunk_data[i].size();
+    offset += chunk_data[i].size();
+  }
+
+  std::vector<u8> result(offset);
+  memcpy(result.data(), &header, sizeof(ChunkedFr3Header));
+  memcpy(result.data() + sizeof(ChunkedFr3Header), chunks.data(), sizeof(Fr3Chunk) * chunks.size());
+  for (size_t i = 0; i < chunks.size(); i++) {
+    memcpy(result.data() + chunks[i].offset, chunk_data[i].data(), chunk_data[i].size());
+  }
+
+  if (uncompressed_size) {
+    *uncompressed_size = total_uncompressed;
+  }
+  return result;
+}
+
+bool is_chunked_fr3(const u8* data, size_t size) {
+  if (size < sizeof(ChunkedFr3Header)) {
+    return false;
+  }
+  u32 magic;
+  memcpy(&magic, data, sizeof(u32));
+  return magic == CHUNKED_FR3_MAGIC;
+}
+
+std::vector<Fr3Chunk> read_fr3_chunk_table(const u8* data, size_t size) {
+  ASSERT(is_chunked_fr3(data, size));
+  ChunkedFr3Header header;
+  memcpy(&header, data, sizeof(ChunkedFr3Header));
+  if (header.version != TFRAG3_VERSION) {
+    ASSERT_MSG(false, fmt::format("version mismatch when loading tfrag3 data. Got {}, expected {}, "
+                                  "did you forget to re-decompile?",
+                                  header.version, TFRAG3_VERSION));
+  }
+
+  size_t table_end = sizeof(ChunkedFr3Header) + sizeof(Fr3Chunk) * (size_t)header.chunk_count;
+  ASSERT(table_end <= size);
+  std::vector<Fr3Chunk> result(header.chunk_count);
+  memcpy(result.data(), data + sizeof(ChunkedFr3Header), sizeof(Fr3Chunk) * result.size());
+  for (auto& chunk : result) {
+    ASSERT(chunk.section < Fr3Section::COUNT);
+    ASSERT(chunk.offset >= table_end && chunk.offset + chunk.size <= size);
+  }
+  ASSERT(!result.empty() && result.front().section == Fr3Section::HEADER);
+  return result;
+}
+
+void load_fr3_chunk(const u8* data, const Fr3Chunk& chunk, Level* level) {
+  // textures go straight to the GPU, so they are left in the decompressed chunk instead of being
+  // copied. A texture chunk has little else in it.
+  Serializer ser(compression::decompress_zstd(data + chunk.offset, chunk.size),
+                 chunk.section == Fr3Section::TEXTURE);
+  if (chunk.section == Fr3Section::HEADER) {
+    serialize_header(ser, *level);
+  } else {
+    serialize_chunk(ser, chunk, *level);
+  }
+  ASSERT(ser.get_load_finished());
+}
+
+void load_fr3(const u8* data, size_t size, Level* level) {
+  if (is_chunked_fr3(data, size)) {
+    for (auto& chunk : read_fr3_chunk_table(data, size)) {
+      load_fr3_chunk(data, chunk, level);
+    }
+  } else {
+    // views would keep the whole level's data around.
+    Serializer ser(compression::decompress_zstd(data, size), false);
+    level->serialize(ser);
+  }
+}
+
+}  // namespace tfrag3
@@ -0,0 +1,75 @@
+#pragma once
+
+/*!
+ * @file chunked_fr3.h
+ * Chunked container for tfrag3::Level data.
+ *
+ * The level is split into independently compressed chunks: a small header with the sizes of
+ * everything, then textures (in groups), each tfrag/tie/shrub tree, collision, and merc.
+ * This lets the loader map the file and decompress chunks in parallel, without ever holding a
+ * copy of the whole compressed and decompressed file.
+ *
+ * Layout:
+ *  ChunkedFr3Header
+ *  Fr3Chunk[chunk_count]
+ *  chunk data (compression::compress_zstd format)
+ *
+ * The first chunk is always the header chunk, and the remaining chunks are sorted by section,
+ * in the order the loader uploads them.
+ */
+
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/custom_data/Tfrag3Data.h"
+
+namespace tfrag3 {
+
+constexpr u32 CHUNKED_FR3_MAGIC = 0x43335246;  // FR3C
+
+enum class Fr3Section : u32 { HEADER, TIE, TEXTURE, TFRAG, SHRUB, COLLISION, MERC, COUNT };
+constexpr int FR3_SECTION_COUNT = (int)Fr3Section::COUNT;
+
+struct ChunkedFr3Header {
+  u32 magic;
+  u32 version;
+  u32 chunk_count;
+  u32 pad;
+};
+
+struct Fr3Chunk {
+  Fr3Section section;
+  u32 geo;    // for trees, the geometry index
+  u32 first;  // first texture or tree in this chunk
+  u32 count;  // number of textures or trees in this chunk
+  u64 offset;
+  u64 size;
+};
+
+/*!
+ * Serialize and compress a level. The total uncompressed size is stored in uncompressed_size.
+ */
+std::vector<u8> save_chunked_fr3(Level& level, size_t* uncompressed_size = nullptr);
+
+/*!
+ * Does this data look like a chunked fr3 file? If not, it's the older single zstd frame format.
+ */
+bool is_chunked_fr3(const u8* data, size_t size);
+
+/*!
+ * Read the chunk table. Validates the version and that all chunks are inside the file.
+ */
+std::vector<Fr3Chunk> read_fr3_chunk_table(const u8* data, size_t size);
+
+/*!
+ * Decompress and load a single chunk into a level. The header chunk must be loaded first, and
+ * sizes the arrays so the remaining chunks can be loaded in any order, from any thread.
+ */
+void load_fr3_chunk(const u8* data, const Fr3Chunk& chunk, Level* level);
+
+/*!
+ * Load a level from either the chunked or the old format.
+ */
+void load_fr3(const u8* data, size_t size, Level* level);
+
+}  // namespace tfrag3
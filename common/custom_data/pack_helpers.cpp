@@ -1,6 +1,6 @@
 #include "pack_helpers.h"
 
-#include <map>
+#include <unordered_map>
 
 #include "common/log/log.h"
 
@@ -28,7 +28,9 @@ std::pair<u64, u16> position_to_cluster_and_offset(float in) {
 void pack_tfrag_vertices(tfrag3::PackedTfragVertices* result,
                          const std::vector<tfrag3::PreloadedVertex>& vertices) {
   u32 next_cluster_idx = 0;
-  std::map<u64, u32> clusters;
+  // clusters are numbered in the order they're first seen, the map is only for lookup.
+  std::unordered_map<u64, u32> clusters;
+  result->vertices.reserve(result->vertices.size() + vertices.size());
 
   for (auto& vtx : vertices) {
     auto x = position_to_cluster_and_offset(vtx.x);
@@ -0,0 +1,45 @@
+#include "dma_chain_read.h"
+
+#include <algorithm>
+
+#include "common/util/ThreadPool.h"
+
+void DmaChainIndex::build(const void* base, u32 buckets_base, u32 bucket_count) {
+  m_base = base;
+  m_buckets_base = buckets_base;
+  // kept between frames, so there's no allocation once they're big enough.
+  m_scratch.resize(bucket_count);
+
+  ParallelForOptions options;
+  options.priority = TaskPriority::HIGH;
+  // most buckets are just a few tags.
+  options.grain = 8;
+  parallel_for(
+      bucket_count,
+      [&](int bucket) {
+        auto& transfers = m_scratch[bucket];
+        transfers.clear();
+        u32 end = bucket_start(bucket + 1);
+        DmaFollower dma(base, bucket_start(bucket));
+        while (dma.current_tag_offset() != end) {
+          auto& indexed = transfers.emplace_back();
+          indexed.tag_offset = dma.current_tag_offset();
+          indexed.transfer = dma.read_and_advance();
+          indexed.ends_chain = dma.ended();
+        }
+      },
+      options);
+
+  m_bucket_first.resize(bucket_count + 1);
+  u32 total = 0;
+  for (u32 bucket = 0; bucket < bucket_count; bucket++) {
+    m_bucket_first[bucket] = total;
+    total += m_scratch[bucket].size();
+  }
+  m_bucket_first[bucket_count] = total;
+  m_transfers.resize(total);
+  for (u32 bucket = 0; bucket < bucket_count; bucket++) {
+    std::copy(m_scratch[bucket].begin(), m_scratch[bucket].end(),
+              m_transfers.begin() + m_bucket_first[bucket]);
+  }
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstring>
+#include <vector>
 
 #include "common/dma/dma.h"
 #include "common/util/Assert.h"
@@ -41,10 +42,34 @@ struct DmaTransfer {
   }
 };
 
+/*!
+ * A transfer and the tag it came from, as recorded by DmaChainIndex.
+ */
+struct IndexedDmaTransfer {
+  DmaTransfer transfer;
+  u32 tag_offset = 0;
+  bool ends_chain = false;  // END or REFE
+};
+
 class DmaFollower {
  public:
   DmaFollower() { m_ended = true; }
   DmaFollower(const void* data, u32 start_offset) : m_base(data), m_tag_offset(start_offset) {}
+
+  /*!
+   * Follow transfers that were already read by a DmaChainIndex, instead of the tags in memory.
+   * After the last one, the current tag is the one at end_offset.
+   */
+  DmaFollower(const void* data,
+              const IndexedDmaTransfer* transfers,
+              u32 count,
+              u32 end_offset)
+      : m_base(data),
+        m_tag_offset(count ? transfers[0].tag_offset : end_offset),
+        m_indexed(transfers),
+        m_indexed_count(count),
+        m_indexed_end_offset(end_offset) {}
+
   template <typename T>
   T read_val(u32 offset) const {
     T result;
@@ -56,6 +81,9 @@ class DmaFollower {
    * Read the current tag, return its transfer, then advance to the next.
    */
   DmaTransfer read_and_advance() {
+    if (m_indexed) {
+      return read_and_advance_indexed();
+    }
     DmaTag tag(read_val<u64>(m_tag_offset));
     DmaTransfer result;
     result.transferred_tag = read_val<u64>(m_tag_offset + 8);
@@ -123,12 +151,61 @@ class DmaFollower {
   VifCode current_tag_vifcode0() const { return VifCode(current_tag_vif0()); }
   VifCode current_tag_vifcode1() const { return VifCode(current_tag_vif1()); }
   u32 current_tag_offset() const { return m_tag_offset; }
+  const void* base() const { return m_base; }
   bool ended() const { return m_ended; }
 
  private:
+  DmaTransfer read_and_advance_indexed() {
+    ASSERT(m_indexed_pos < m_indexed_count);
+    const auto& indexed = m_indexed[m_indexed_pos++];
+    m_ended = indexed.ends_chain;
+    m_tag_offset = m_indexed_pos < m_indexed_count ? m_indexed[m_indexed_pos].tag_offset
+                                                   : m_indexed_end_offset;
+    return indexed.transfer;
+  }
+
   const void* m_base = nullptr;
   u32 m_tag_offset = 0;
   s32 m_sp = 0;
   s32 m_stack[2] = {-1, -1};
   bool m_ended = false;
+
+  const IndexedDmaTransfer* m_indexed = nullptr;
+  u32 m_indexed_count = 0;
+  u32 m_indexed_pos = 0;
+  u32 m_indexed_end_offset = 0;
+};
+
+/*!
+ * Every transfer of a frame's buckets, read in one pass into a flat array. Bucket i's chain starts
+ * at the tag at buckets_base + 16 * i and ends at the next bucket's, so the buckets are independent
+ * and are read in parallel. Renderers can then follow their bucket from the array, and buckets
+ * can be processed at the same time.
+ */
+class DmaChainIndex {
+ public:
+  void build(const void* base, u32 buckets_base, u32 bucket_count);
+
+  u32 bucket_count() const { return m_bucket_first.empty() ? 0 : m_bucket_first.size() - 1; }
+  const IndexedDmaTransfer* bucket_transfers(u32 bucket) const {
+    return m_transfers.data() + m_bucket_first.at(bucket);
+  }
+  u32 bucket_transfer_count(u32 bucket) const {
+    return m_bucket_first.at(bucket + 1) - m_bucket_first.at(bucket);
+  }
+  // the offset of the tag that starts the bucket. A bucket's chain ends at the next one's start.
+  u32 bucket_start(u32 bucket) const { return m_buckets_base + 16 * bucket; }
+  size_t transfer_count() const { return m_transfers.size(); }
+
+  DmaFollower follower(u32 bucket) const {
+    return DmaFollower(m_base, bucket_transfers(bucket), bucket_transfer_count(bucket),
+                       bucket_start(bucket + 1));
+  }
+
+ private:
+  const void* m_base = nullptr;
+  u32 m_buckets_base = 0;
+  std::vector<IndexedDmaTransfer> m_transfers;
+  std::vector<u32> m_bucket_first;  // index of each bucket's first transfer, then the total.
+  std::vector<std::vector<IndexedDmaTransfer>> m_scratch;
 };
@@ -196,3 +196,23 @@ const DmaData& FixedChunkDmaCopier::run(const void* memory, u32 offset, bool ver
   m_result.stats.sync_time_ms = timer.getMs();
   return m_result;
 }
+
+TripleBufferedDmaCopier::TripleBufferedDmaCopier(u32 main_memory_size) {
+  for (auto& copier : m_copiers) {
+    copier = std::make_unique<FixedChunkDmaCopier>(main_memory_size);
+  }
+}
+
+void TripleBufferedDmaCopier::submit(const void* memory, u32 offset) {
+  m_copiers[m_back]->run(memory, offset, false);
+  // release: the copy must be visible before the renderer can see the index.
+  m_back = m_middle.exchange(m_back | kNewBit, std::memory_order_acq_rel) & ~kNewBit;
+}
+
+bool TripleBufferedDmaCopier::acquire() {
+  if (!has_new_chain()) {
+    return false;
+  }
+  m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & ~kNewBit;
+  return true;
+}
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <memory>
 #include <vector>
 
 #include "common/common_types.h"
@@ -51,6 +54,45 @@ class FixedChunkDmaCopier {
   const void* m_input_data = nullptr;
 };
 
+/*!
+ * Three FixedChunkDmaCopiers, used to hand DMA chains from the game thread to the render thread
+ * without either waiting on the other. The game copies each chain into its own back copier, then
+ * swaps it with the middle one. The renderer swaps its front copier with the middle one if it has a
+ * newer chain. Chains that the renderer doesn't pick up in time are skipped.
+ */
+class TripleBufferedDmaCopier {
+ public:
+  TripleBufferedDmaCopier(u32 main_memory_size);
+
+  /*!
+   * Copy a chain and make it available to the renderer. Called from the game thread.
+   */
+  void submit(const void* memory, u32 offset);
+
+  /*!
+   * Does the middle copier have a chain that hasn't been acquired yet?
+   */
+  bool has_new_chain() const { return m_middle.load(std::memory_order_acquire) & kNewBit; }
+
+  /*!
+   * If there is a new chain, make it the front. Returns false if there was no new chain. Called
+   * from the render thread.
+   */
+  bool acquire();
+
+  /*!
+   * The copier holding the last acquired chain. Only valid on the render thread.
+   */
+  FixedChunkDmaCopier& front() { return *m_copiers[m_front]; }
+
+ private:
+  static constexpr u32 kNewBit = 4;
+  std::array<std::unique_ptr<FixedChunkDmaCopier>, 3> m_copiers;
+  u32 m_back = 0;                // owned by the game thread
+  u32 m_front = 1;               // owned by the render thread
+  std::atomic<u32> m_middle{2};  // index of the middle copier, plus kNewBit if not yet acquired
+};
+
 /*!
  * Convert a DMA chain to an array of bytes that can be directly fed to VIF.
  */
@@ -0,0 +1,233 @@
+#include "vif_unpack.h"
+
+#include <immintrin.h>
+
+#include <algorithm>
+
+namespace {
+
+// the low 4 bits of an unpack are the format: vn (components - 1) in bits 2-3, and vl in bits 0-1
+// (32, 16, 8 or 5 bits).
+constexpr u8 UNPACK_FORMAT_MASK = 0b1111;
+constexpr u8 UNPACK_MASKED_BIT = 0b10000;
+
+int format_components(u8 format) {
+  return (format >> 2) + 1;
+}
+
+int format_bits(u8 format) {
+  return 32 >> (format & 0b11);
+}
+
+bool is_unpack(VifCode::Kind kind) {
+  return ((u8)kind & (u8)VifCode::Kind::UNPACK_MASK) == (u8)VifCode::Kind::UNPACK_MASK;
+}
+
+/*!
+ * Unpack count vectors to consecutive quadwords.
+ */
+using UnpackRun = void (*)(u8* dst, const u8* src, u32 count);
+
+template <typename T>
+T load(const u8* src) {
+  T result;
+  memcpy(&result, src, sizeof(T));
+  return result;
+}
+
+/*!
+ * Load the bytes of one vector with loads of their exact size. Copying them through memory to
+ * make a full quadword is much slower, because the wide load can't use the narrow stores.
+ */
+template <int BYTES>
+u64 load_small(const u8* src) {
+  if constexpr (BYTES == 8) {
+    return load<u64>(src);
+  } else if constexpr (BYTES == 6) {
+    return load<u32>(src) | ((u64)load<u16>(src + 4) << 32);
+  } else if constexpr (BYTES == 4) {
+    return load<u32>(src);
+  } else if constexpr (BYTES == 3) {
+    return load<u16>(src) | ((u64)src[2] << 16);
+  } else if constexpr (BYTES == 2) {
+    return load<u16>(src);
+  } else {
+    static_assert(BYTES == 1);
+    return src[0];
+  }
+}
+
+template <int N, int BITS, bool USN>
+__m128i load_vector(const u8* src) {
+  constexpr int kSrcBytes = N * BITS / 8;
+  if constexpr (kSrcBytes == 12) {
+    return _mm_insert_epi32(_mm_loadl_epi64((const __m128i*)src), load<s32>(src + 8), 2);
+  } else if constexpr (kSrcBytes == 16) {
+    return _mm_loadu_si128((const __m128i*)src);
+  } else {
+    __m128i v = _mm_cvtsi64_si128(load_small<kSrcBytes>(src));
+    if constexpr (BITS == 32) {
+      return v;
+    } else if constexpr (BITS == 16) {
+      return USN ? _mm_cvtepu16_epi32(v) : _mm_cvtepi16_epi32(v);
+    } else {
+      return USN ? _mm_cvtepu8_epi32(v) : _mm_cvtepi8_epi32(v);
+    }
+  }
+}
+
+template <int N, int BITS, bool USN>
+void unpack_run(u8* dst, const u8* src, u32 count) {
+  constexpr int kSrcBytes = N * BITS / 8;
+  u32 i = 0;
+
+  // the common formats do several vectors per load.
+  if constexpr (N == 4 && BITS == 32) {
+    memcpy(dst, src, 16 * count);
+    return;
+  } else if constexpr (N == 4 && BITS == 16) {
+    for (; i + 2 <= count; i += 2) {
+      __m128i v = _mm_loadu_si128((const __m128i*)(src + 8 * i));
+      __m128i hi = _mm_srli_si128(v, 8);
+      _mm_storeu_si128((__m128i*)(dst + 16 * i),
+                       USN ? _mm_cvtepu16_epi32(v) : _mm_cvtepi16_epi32(v));
+      _mm_storeu_si128((__m128i*)(dst + 16 * i + 16),
+                       USN ? _mm_cvtepu16_epi32(hi) : _mm_cvtepi16_epi32(hi));
+    }
+  } else if constexpr (N == 4 && BITS == 8) {
+    for (; i + 4 <= count; i += 4) {
+      __m128i v = _mm_loadu_si128((const __m128i*)(src + 4 * i));
+      for (int j = 0; j < 4; j++) {
+        _mm_storeu_si128((__m128i*)(dst + 16 * (i + j)),
+                         USN ? _mm_cvtepu8_epi32(v) : _mm_cvtepi8_epi32(v));
+        v = _mm_srli_si128(v, 4);
+      }
+    }
+  }
+
+  for (; i < count; i++) {
+    __m128i v = load_vector<N, BITS, USN>(src + kSrcBytes * i);
+    u8* out = dst + 16 * i;
+    if constexpr (N == 1) {
+      v = _mm_shuffle_epi32(v, 0);
+    } else if constexpr (N < 4) {
+      constexpr int kKeepOld = N == 2 ? 0b1100 : 0b1000;
+      __m128 old = _mm_loadu_ps((const float*)out);
+      v = _mm_castps_si128(_mm_blend_ps(_mm_castsi128_ps(v), old, kKeepOld));
+    }
+    _mm_storeu_si128((__m128i*)out, v);
+  }
+}
+
+template <int N, int BITS>
+constexpr UnpackRun run_for_usn(bool usn) {
+  return usn ? unpack_run<N, BITS, true> : unpack_run<N, BITS, false>;
+}
+
+// indexed by format, then usn. The 32-bit formats ignore usn.
+const UnpackRun kUnpackRuns[16][2] = {
+    {run_for_usn<1, 32>(false), run_for_usn<1, 32>(true)},
+    {run_for_usn<1, 16>(false), run_for_usn<1, 16>(true)},
+    {run_for_usn<1, 8>(false), run_for_usn<1, 8>(true)},
+    {nullptr, nullptr},
+    {run_for_usn<2, 32>(false), run_for_usn<2, 32>(true)},
+    {run_for_usn<2, 16>(false), run_for_usn<2, 16>(true)},
+    {run_for_usn<2, 8>(false), run_for_usn<2, 8>(true)},
+    {nullptr, nullptr},
+    {run_for_usn<3, 32>(false), run_for_usn<3, 32>(true)},
+    {run_for_usn<3, 16>(false), run_for_usn<3, 16>(true)},
+    {run_for_usn<3, 8>(false), run_for_usn<3, 8>(true)},
+    {nullptr, nullptr},
+    {run_for_usn<4, 32>(false), run_for_usn<4, 32>(true)},
+    {run_for_usn<4, 16>(false), run_for_usn<4, 16>(true)},
+    {run_for_usn<4, 8>(false), run_for_usn<4, 8>(true)},
+    {nullptr, nullptr},  // V4-5
+};
+
+/*!
+ * Call run for each group of vectors written together in the cl/wl write cycle.
+ */
+template <typename F>
+void for_each_write_cycle(VifCode::Kind kind,
+                          void* dst,
+                          const void* src,
+                          u32 num,
+                          u16 cl,
+                          u16 wl,
+                          const F& run) {
+  ASSERT_MSG(vif_unpack_supported(kind), fmt::format("Unsupported unpack {}", (int)kind));
+  ASSERT(wl > 0 && wl <= cl);
+  u8 format = (u8)kind & UNPACK_FORMAT_MASK;
+  u32 src_vector_bytes = format_components(format) * format_bits(format) / 8;
+  if (cl == wl) {
+    run((u8*)dst, (const u8*)src, num);
+    return;
+  }
+  for (u32 done = 0; done < num; done += wl) {
+    run((u8*)dst + 16 * cl * (done / wl), (const u8*)src + src_vector_bytes * done,
+        std::min((u32)wl, num - done));
+  }
+}
+
+}  // namespace
+
+u32 vif_unpack_src_bytes(VifCode::Kind kind, u32 num) {
+  u8 format = (u8)kind & UNPACK_FORMAT_MASK;
+  u32 bits = num * format_components(format) * format_bits(format);
+  return ((bits + 31) / 32) * 4;
+}
+
+bool vif_unpack_supported(VifCode::Kind kind) {
+  return is_unpack(kind) && !((u8)kind & UNPACK_MASKED_BIT) &&
+         kUnpackRuns[(u8)kind & UNPACK_FORMAT_MASK][0];
+}
+
+void vif_unpack(void* dst,
+                const void* src,
+                VifCode::Kind kind,
+                u32 num,
+                bool usn,
+                u16 cl,
+                u16 wl) {
+  UnpackRun run = kUnpackRuns[(u8)kind & UNPACK_FORMAT_MASK][usn];
+  for_each_write_cycle(kind, dst, src, num, cl, wl, run);
+}
+
+void vif_unpack_reference(void* dst,
+                          const void* src,
+                          VifCode::Kind kind,
+                          u32 num,
+                          bool usn,
+                          u16 cl,
+                          u16 wl) {
+  u8 format = (u8)kind & UNPACK_FORMAT_MASK;
+  int components = format_components(format);
+  int bits = format_bits(format);
+  for_each_write_cycle(kind, dst, src, num, cl, wl, [&](u8* out, const u8* in, u32 count) {
+    for (u32 i = 0; i < count; i++) {
+      u32 values[4];
+      for (int c = 0; c < components; c++) {
+        const u8* value = in + (i * components + c) * bits / 8;
+        switch (bits) {
+          case 32:
+            memcpy(&values[c], value, 4);
+            break;
+          case 16: {
+            u16 v;
+            memcpy(&v, value, 2);
+            values[c] = usn ? (u32)v : (u32)(s32)(s16)v;
+          } break;
+          case 8:
+            values[c] = usn ? (u32)*value : (u32)(s32)(s8)*value;
+            break;
+        }
+      }
+      int written = components;
+      if (components == 1) {
+        values[1] = values[2] = values[3] = values[0];
+        written = 4;
+      }
+      memcpy(out + 16 * i, values, 4 * written);
+    }
+  });
+}
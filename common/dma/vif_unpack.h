@@ -0,0 +1,42 @@
+#pragma once
+
+/*!
+ * @file vif_unpack.h
+ * Emulation of the VIF's UNPACK, which expands vectors of 8, 16 or 32-bit values to quadwords of
+ * VU memory.
+ */
+
+#include "common/common_types.h"
+#include "common/dma/dma.h"
+
+// the number of bytes of DMA data used by an unpack of num vectors. It's padded to 4 bytes.
+u32 vif_unpack_src_bytes(VifCode::Kind kind, u32 num);
+
+// masked unpacks (STMASK) and the V4-5 format aren't supported.
+bool vif_unpack_supported(VifCode::Kind kind);
+
+/*!
+ * Unpack num vectors from src to dst, which is VU memory at the unpack's address. With a write
+ * cycle (STCYCL) of cl/wl, wl quadwords are written, then cl - wl are skipped. Filling writes
+ * (wl > cl) aren't supported.
+ * 8 and 16-bit values are zero extended if usn is set, and sign extended otherwise. Scalars are
+ * written to all four components. V2 and V3 leave the components they don't have alone.
+ */
+void vif_unpack(void* dst,
+                const void* src,
+                VifCode::Kind kind,
+                u32 num,
+                bool usn,
+                u16 cl = 4,
+                u16 wl = 4);
+
+/*!
+ * Same as vif_unpack, but one value at a time. For testing and benchmarking vif_unpack.
+ */
+void vif_unpack_reference(void* dst,
+                          const void* src,
+                          VifCode::Kind kind,
+                          u32 num,
+                          bool usn,
+                          u16 cl = 4,
+                          u16 wl = 4);
@@ -1,5 +1,7 @@
 #include "formatter.h"
 
+#include <algorithm>
+
 #include "formatter_tree.h"
 
 #include "common/util/FileUtil.h"
@@ -77,25 +79,144 @@ std::string apply_formatting(const FormatterTreeNode& curr_node,
 }
 
 std::optional<std::string> formatter::format_code(const std::string& source) {
-  // Create a parser.
-  std::shared_ptr<TSParser> parser(ts_parser_new(), TreeSitterParserDeleter());
+  return Formatter().format(source);
+}
 
-  // Set the parser's language (JSON in this case).
-  ts_parser_set_language(parser.get(), tree_sitter_opengoal());
+namespace {
+TSPoint point_at_offset(const std::string& text, size_t offset) {
+  TSPoint point = {0, 0};
+  size_t line_start = 0;
+  for (size_t i = 0; i < offset; i++) {
+    if (text[i] == '\n') {
+      point.row++;
+      line_start = i + 1;
+    }
+  }
+  point.column = offset - line_start;
+  return point;
+}
+}  // namespace
 
-  // Build a syntax tree based on source code stored in a string.
-  std::shared_ptr<TSTree> tree(
-      ts_parser_parse_string(parser.get(), NULL, source.c_str(), source.length()),
-      TreeSitterTreeDeleter());
+formatter::Formatter::Formatter() : m_parser(ts_parser_new(), TreeSitterParserDeleter()) {
+  ts_parser_set_language(m_parser.get(), tree_sitter_opengoal());
+}
 
-  // Get the root node of the syntax tree.
-  TSNode root_node = ts_tree_root_node(tree.get());
+TSNode formatter::Formatter::parse(const std::string& source) {
+  TSTree* old_tree = nullptr;
+  if (m_tree) {
+    // Tell tree-sitter what changed since the last version, as a single edit from the first byte
+    // that's different to the last one. Then it only has to re-parse around that.
+    size_t common_size = std::min(m_source.size(), source.size());
+    size_t prefix = 0;
+    while (prefix < common_size && m_source[prefix] == source[prefix]) {
+      prefix++;
+    }
+    size_t suffix = 0;
+    while (suffix < common_size - prefix &&
+           m_source[m_source.size() - 1 - suffix] == source[source.size() - 1 - suffix]) {
+      suffix++;
+    }
+    TSInputEdit edit;
+    edit.start_byte = prefix;
+    edit.old_end_byte = m_source.size() - suffix;
+    edit.new_end_byte = source.size() - suffix;
+    edit.start_point = point_at_offset(source, edit.start_byte);
+    edit.old_end_point = point_at_offset(m_source, edit.old_end_byte);
+    edit.new_end_point = point_at_offset(source, edit.new_end_byte);
+    ts_tree_edit(m_tree.get(), &edit);
+    old_tree = m_tree.get();
+  }
+  m_tree.reset(ts_parser_parse_string(m_parser.get(), old_tree, source.c_str(), source.length()),
+               TreeSitterTreeDeleter());
+  m_source = source;
+  return ts_tree_root_node(m_tree.get());
+}
+
+/*!
+ * Format the top-level elements of the file, the same way apply_formatting does for the root, but
+ * with the text for forms that haven't changed since the last version taken from last time.
+ */
+std::optional<formatter::Formatter::TopLevelText> formatter::Formatter::format_top_level(
+    const std::string& source) {
+  TSNode root_node = parse(source);
   if (ts_node_is_null(root_node) || ts_node_has_error(root_node)) {
     return std::nullopt;
   }
 
   const auto formatting_tree = FormatterTree(source, root_node);
-  std::string formatted_code = apply_formatting(formatting_tree.root, "");
+  const auto& root = formatting_tree.root;
+  TopLevelText result;
+  std::unordered_map<std::string, std::string> formatted_forms;
+  for (int i = 0; i < (int)root.refs.size(); i++) {
+    const auto& ref = root.refs.at(i);
+    root.get_formatting_rule(0, i)->append_newline(result.text, ref, root, 0, i);
+    auto& element = result.elements.emplace_back();
+    element.start_line = ref.metadata.start_line;
+    element.end_line = ref.metadata.end_line;
+    element.text_start = result.text.size();
+    if (ref.token) {
+      root.get_formatting_rule(0, i)->indent_token(result.text, ref, root, 1, i);
+      result.text += ref.token.value();
+    } else {
+      const auto form_source =
+          source.substr(ref.metadata.start_byte, ref.metadata.end_byte - ref.metadata.start_byte);
+      // a form is never formatted to nothing, so empty means it hasn't been done yet.
+      auto& formatted = formatted_forms[form_source];
+      if (formatted.empty()) {
+        const auto prev = m_formatted_forms.find(form_source);
+        formatted = prev != m_formatted_forms.end() ? prev->second : apply_formatting(ref, "", 1);
+      }
+      result.text += formatted;
+    }
+    element.text_end = result.text.size();
+    formatter_rules::blank_lines::separate_by_newline(result.text, root, ref, i);
+  }
+  m_formatted_forms = std::move(formatted_forms);
+  return result;
+}
+
+std::optional<std::string> formatter::Formatter::format(const std::string& source) {
+  auto result = format_top_level(source);
+  if (!result) {
+    return std::nullopt;
+  }
+  return std::move(result->text);
+}
 
-  return formatted_code;
+std::optional<formatter::FormattedRange> formatter::Formatter::format_range(
+    const std::string& source,
+    uint32_t start_line,
+    uint32_t end_line) {
+  const auto formatted = format_top_level(source);
+  if (!formatted) {
+    return std::nullopt;
+  }
+  const auto& elements = formatted->elements;
+  int first = -1;
+  int last = -1;
+  for (int i = 0; i < (int)elements.size(); i++) {
+    if (elements.at(i).end_line >= start_line && elements.at(i).start_line <= end_line) {
+      if (first < 0) {
+        first = i;
+      }
+      last = i;
+    }
+  }
+  if (first < 0) {
+    return std::nullopt;
+  }
+  // Whole lines are replaced, so include anything that shares a line with the first and last.
+  while (first > 0 && elements.at(first - 1).end_line == elements.at(first).start_line) {
+    first--;
+  }
+  while (last + 1 < (int)elements.size() &&
+         elements.at(last + 1).start_line == elements.at(last).end_line) {
+    last++;
+  }
+  FormattedRange result;
+  result.start_line = elements.at(first).start_line;
+  result.end_line = elements.at(last).end_line;
+  result.text = formatted->text.substr(elements.at(first).text_start,
+                                       elements.at(last).text_end - elements.at(first).text_start);
+  return result;
 }
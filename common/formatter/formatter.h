@@ -1,7 +1,11 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "formatting_rules.h"
 
@@ -19,4 +23,48 @@ struct TreeSitterTreeDeleter {
 };
 
 std::optional<std::string> format_code(const std::string& source);
+
+// The formatted text for some lines of a file, which replaces lines [start_line, end_line]
+// (zero-based, inclusive) of the source.
+struct FormattedRange {
+  uint32_t start_line = 0;
+  uint32_t end_line = 0;
+  std::string text;
+};
+
+// Formats versions of the same file, like an editor does as it's being changed. The tree-sitter
+// tree of the last version is edited and re-used, so only the part of the file that changed is
+// parsed again, and top-level forms that didn't change re-use the text they were formatted to.
+class Formatter {
+ public:
+  Formatter();
+  std::optional<std::string> format(const std::string& source);
+  // Format only the top-level forms on lines [start_line, end_line]. The result can cover more
+  // lines than that, if there are forms that start or end on the same line as others.
+  std::optional<FormattedRange> format_range(const std::string& source,
+                                             uint32_t start_line,
+                                             uint32_t end_line);
+
+ private:
+  struct TopLevelElement {
+    // where it is in the formatted text, without the newlines that separate it from the next one
+    size_t text_start = 0;
+    size_t text_end = 0;
+    // the lines it was on in the source
+    uint32_t start_line = 0;
+    uint32_t end_line = 0;
+  };
+  struct TopLevelText {
+    std::string text;
+    std::vector<TopLevelElement> elements;
+  };
+  std::optional<TopLevelText> format_top_level(const std::string& source);
+  TSNode parse(const std::string& source);
+
+  std::shared_ptr<TSParser> m_parser;
+  std::shared_ptr<TSTree> m_tree;
+  std::string m_source;
+  // formatted text of the top-level forms of the last version, by their source
+  std::unordered_map<std::string, std::string> m_formatted_forms;
+};
 }  // namespace formatter
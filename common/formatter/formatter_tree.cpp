@@ -1,5 +1,7 @@
 #include "formatter_tree.h"
 
+#include <algorithm>
+
 #include "common/util/string_util.h"
 
 #include "config/rule_config.h"
@@ -47,6 +49,11 @@ FormatterTreeNode::FormatterTreeNode(const std::string& source, const TSNode& no
   metadata.is_comment = str_util::starts_with(str_util::ltrim(token.value()), ";");
   metadata.num_blank_lines_following = num_blank_lines_following_node(source, node);
   metadata.is_inline = !node_preceeded_by_only_whitespace(source, node);
+  metadata.start_byte = ts_node_start_byte(node);
+  metadata.end_byte = metadata.start_byte + token.value().length();
+  metadata.start_line = ts_node_start_point(node).row;
+  metadata.end_line =
+      metadata.start_line + std::count(token.value().begin(), token.value().end(), '\n');
 };
 
 std::shared_ptr<IndentationRule> FormatterTreeNode::get_formatting_rule(const int depth,
@@ -75,11 +82,10 @@ bool node_followed_by_only_whitespace(const std::string& source, const TSNode& n
 }
 
 bool nodes_on_same_line(const std::string& source, const TSNode& n1, const TSNode& n2) {
-  // Get the source between the two lines, if there are any new-lines, the answer is NO
-  uint32_t start = ts_node_start_byte(n1);
-  uint32_t end = ts_node_end_byte(n2);
-  const auto code_between = source.substr(start, end - start);
-  return !str_util::contains(code_between, "\n");
+  // If there are any new-lines between the start of the first and the end of the second, the answer
+  // is NO. The rows from tree-sitter tell us that without copying the code between them, which adds
+  // up when the first node is the whole file.
+  return ts_node_start_point(n1).row == ts_node_end_point(n2).row;
 }
 
 FormatterTree::FormatterTree(const std::string& source, const TSNode& root_node) {
@@ -100,6 +106,10 @@ void FormatterTree::construct_formatter_tree_recursive(const std::string& source
   FormatterTreeNode list_node;
   if (curr_node_type == "list_lit") {
     list_node = FormatterTreeNode();
+    list_node.metadata.start_byte = ts_node_start_byte(curr_node);
+    list_node.metadata.end_byte = ts_node_end_byte(curr_node);
+    list_node.metadata.start_line = ts_node_start_point(curr_node).row;
+    list_node.metadata.end_line = ts_node_end_point(curr_node).row;
   }
   for (size_t i = 0; i < ts_node_child_count(curr_node); i++) {
     const auto child_node = ts_node_child(curr_node, i);
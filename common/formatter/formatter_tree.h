@@ -45,6 +45,11 @@ class FormatterTreeNode {
     // (println "test")
     bool multiple_elements_first_line = false;
     bool was_on_first_line_of_form = false;
+    // Where it was in the source, the lines are zero-based
+    uint32_t start_byte = 0;
+    uint32_t end_byte = 0;
+    uint32_t start_line = 0;
+    uint32_t end_line = 0;
   };
   std::vector<FormatterTreeNode> refs;
   Metadata metadata;
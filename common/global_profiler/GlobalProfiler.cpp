@@ -1,86 +1,227 @@
-// clang-format off
 #include "GlobalProfiler.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cstring>
-#include <thread>
 
+#include "common/log/log.h"
 #include "common/util/Assert.h"
 #include "common/util/FileUtil.h"
-#include "common/common_types.h"
 
 #include "third-party/fmt/core.h"
 #include "third-party/json.hpp"
 
-#ifdef OS_POSIX
-u64 get_current_tid() {
-  return (u64)pthread_self();
+namespace {
+std::atomic<u64> g_next_profiler_id = 1;
+
+nlohmann::json event_to_json(const ProfNode& event, u32 tid, u64 t0) {
+  nlohmann::json json_event;
+  switch (event.kind) {
+    case ProfNode::BEGIN:
+      json_event["name"] = event.name;
+      json_event["ph"] = "B";
+      break;
+    case ProfNode::END:
+      json_event["ph"] = "E";
+      break;
+    case ProfNode::INSTANT:
+      json_event["name"] = event.name;
+      json_event["ph"] = "i";
+      break;
+    case ProfNode::COUNTER:
+      json_event["name"] = event.name;
+      json_event["ph"] = "C";
+      json_event["args"]["value"] = event.value;
+      break;
+    case ProfNode::COMPLETE:
+      json_event["name"] = event.name;
+      json_event["ph"] = "X";
+      json_event["dur"] = event.value / 1000.;
+      break;
+    case ProfNode::FRAME_MARK:
+      json_event["name"] = event.name;
+      json_event["ph"] = "i";
+      json_event["s"] = "g";
+      break;
+    default:
+      ASSERT(false);
+  }
+  json_event["pid"] = 1;
+  json_event["tid"] = tid;
+  json_event["ts"] = (event.ts - t0) / 1000.;
+  return json_event;
 }
-#else
-#define NOMINMAX
-#define WIN32_LEAN_AND_MEAN
-#include <windows.h>
-#include "Processthreadsapi.h"
-u64 get_current_tid() {
-  return (u64)GetCurrentThreadId();
+
+nlohmann::json thread_name_to_json(const std::string& name, u32 tid) {
+  nlohmann::json json_event;
+  json_event["name"] = "thread_name";
+  json_event["ph"] = "M";
+  json_event["pid"] = 1;
+  json_event["tid"] = tid;
+  json_event["args"]["name"] = name;
+  return json_event;
 }
-#endif
-#include "common/log/log.h"
-// clang-format on
 
-u64 get_current_ts() {
+std::string dump_json(const nlohmann::json& json) {
+  // event names come from GOAL strings, which might not be valid UTF-8.
+  return json.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+}
+}  // namespace
+
+u64 GlobalProfiler::timestamp() {
   return std::chrono::steady_clock::now().time_since_epoch().count();
 }
 
-GlobalProfiler::GlobalProfiler() {
-  m_t0 = get_current_ts();
-  set_max_events(65536);
+GlobalProfiler::GlobalProfiler() : m_id(g_next_profiler_id++) {
+  m_t0 = timestamp();
+  set_max_events(16384);
+}
+
+GlobalProfiler::~GlobalProfiler() {
+  stop_streaming();
 }
 
 void GlobalProfiler::set_max_events(size_t event_count) {
   ASSERT(!m_enabled);
-  m_nodes.resize(event_count);
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_events_per_thread = std::max(event_count, size_t(1));
+  for (auto& buffer : m_buffers) {
+    if (!buffer->nodes.empty()) {
+      buffer->nodes.assign(m_events_per_thread, ProfNode());
+    }
+    buffer->next_idx = 0;
+    buffer->stream_idx = 0;
+  }
 }
 
-void GlobalProfiler::event(const char* name, ProfNode::Kind kind) {
-  if (!m_enabled) {
-    return;
+GlobalProfiler::ThreadBuffer& GlobalProfiler::this_thread_buffer() {
+  // threads almost always record to the same profiler, so remember which buffer is theirs.
+  thread_local u64 cached_profiler_id = 0;
+  thread_local ThreadBuffer* cached_buffer = nullptr;
+  if (cached_profiler_id == m_id) {
+    return *cached_buffer;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto id = std::this_thread::get_id();
+  ThreadBuffer* buffer = nullptr;
+  for (auto& b : m_buffers) {
+    if (b->owner == id) {
+      buffer = b.get();
+    }
+  }
+  if (!buffer) {
+    buffer = m_buffers.emplace_back(std::make_unique<ThreadBuffer>()).get();
+    buffer->owner = id;
+    buffer->short_id = m_buffers.size() - 1;
   }
-  size_t my_idx = (m_next_idx++ % m_nodes.size());
-  auto& node = m_nodes[my_idx];
-  node.ts = get_current_ts() - m_t0;
-  node.tid = get_current_tid();
+  cached_profiler_id = m_id;
+  cached_buffer = buffer;
+  return *buffer;
+}
+
+void GlobalProfiler::record(const char* name, ProfNode::Kind kind, double value) {
+  write_node(this_thread_buffer(), timestamp(), name, kind, value);
+}
+
+void GlobalProfiler::write_node(ThreadBuffer& buffer,
+                                u64 ts,
+                                const char* name,
+                                ProfNode::Kind kind,
+                                double value) {
+  if (buffer.nodes.empty()) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    buffer.nodes.resize(m_events_per_thread);
+  }
+
+  // only one thread writes to the buffer, so there's no need for an atomic increment.
+  u64 idx = buffer.next_idx.load(std::memory_order_relaxed);
+  auto& node = buffer.nodes[idx % buffer.nodes.size()];
+  node.ts = ts;
+  node.value = value;
   node.kind = kind;
   strncpy(node.name, name, sizeof(node.name));
   node.name[sizeof(node.name) - 1] = '\0';
+  buffer.next_idx.store(idx + 1, std::memory_order_release);
 }
 
-void GlobalProfiler::instant_event(const char* name) {
-  event(name, ProfNode::INSTANT);
+void GlobalProfiler::set_thread_name(const char* name) {
+  auto& buffer = this_thread_buffer();
+  std::lock_guard<std::mutex> lock(m_mutex);
+  buffer.name = name;
+  buffer.name_streamed = false;
 }
 
-void GlobalProfiler::root_event() {
-  instant_event("ROOT");
+u32 GlobalProfiler::add_track(const char* name) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  // no thread has the default id, so threads never use this buffer.
+  auto& buffer = m_buffers.emplace_back(std::make_unique<ThreadBuffer>());
+  buffer->short_id = m_buffers.size() - 1;
+  buffer->name = name;
+  return buffer->short_id;
+}
+
+void GlobalProfiler::track_zone(u32 track, const char* name, u64 begin_ts, u64 end_ts) {
+  if (!enabled()) {
+    return;
+  }
+  ThreadBuffer* buffer;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    buffer = m_buffers.at(track).get();
+  }
+  u64 duration = end_ts > begin_ts ? end_ts - begin_ts : 0;
+  write_node(*buffer, begin_ts, name, ProfNode::COMPLETE, duration);
 }
 
-void GlobalProfiler::begin_event(const char* name) {
-  event(name, ProfNode::BEGIN);
+std::vector<GlobalProfiler::ThreadBuffer*> GlobalProfiler::all_buffers() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  std::vector<ThreadBuffer*> result;
+  for (auto& buffer : m_buffers) {
+    result.push_back(buffer.get());
+  }
+  return result;
 }
 
-void GlobalProfiler::end_event() {
-  if (!m_enabled) {
-    return;
+/*!
+ * Copy the events from index start, up to the most recent one, oldest first. The owner of the
+ * buffer may keep recording while this runs, so events that were overwritten before or during the
+ * copy are skipped and counted in dropped. end is set to the index after the last event copied.
+ */
+std::vector<ProfNode> GlobalProfiler::copy_events(ThreadBuffer& buffer,
+                                                  u64 start,
+                                                  u64* end,
+                                                  u64* dropped) {
+  std::vector<ProfNode> result;
+  u64 next = buffer.next_idx.load(std::memory_order_acquire);
+  *end = next;
+  *dropped = 0;
+  if (next <= start) {
+    return result;
   }
-  size_t my_idx = (m_next_idx++ % m_nodes.size());
-  auto& node = m_nodes[my_idx];
-  node.ts = get_current_ts() - m_t0;
-  node.tid = get_current_tid();
-  node.kind = ProfNode::END;
-  node.name[0] = '\0';
+
+  u64 size = buffer.nodes.size();
+  u64 first = std::max(start, next > size ? next - size : 0);
+  for (u64 i = first; i < next; i++) {
+    result.push_back(buffer.nodes[i % size]);
+  }
+
+  // the slot for the event after now may be half written, so it isn't safe either.
+  std::atomic_thread_fence(std::memory_order_acquire);
+  u64 now = buffer.next_idx.load(std::memory_order_relaxed);
+  u64 oldest_safe = now + 1 > size ? now + 1 - size : 0;
+  u64 overwritten = oldest_safe > first ? std::min(oldest_safe - first, (u64)result.size()) : 0;
+  result.erase(result.begin(), result.begin() + overwritten);
+  *dropped = (first - start) + overwritten;
+  return result;
 }
 
 void GlobalProfiler::clear() {
-  m_next_idx = 0;
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (auto& buffer : m_buffers) {
+    buffer->next_idx = 0;
+    buffer->stream_idx = 0;
+  }
 }
 
 void GlobalProfiler::set_enable(bool en) {
@@ -92,91 +233,132 @@ void GlobalProfiler::dump_to_json(const std::string& path) {
 
   nlohmann::json json;
   auto& trace_events = json["traceEvents"];
+  trace_events = nlohmann::json::array();
   json["displayTimeUnit"] = "ms";
 
-  u64 lowest_ts = UINT64_MAX;
-  struct ThreadInfo {
-    size_t lowest_at_target = UINT64_MAX;
-    size_t highest_at_target = 0;
-    size_t debug = 0;
-    u32 short_id = 0;
-  };
-  std::unordered_map<u32, ThreadInfo> info_per_thread;
-
-  // first, find all the threads
-  std::string kRootName = "ROOT";
-  for (size_t offset = m_nodes.size(); offset-- > 0;) {
-    size_t idx = (m_next_idx + offset) % m_nodes.size();
-    const auto& event = m_nodes[idx];
-
-    if (event.kind != ProfNode::UNUSED) {
-      lowest_ts = std::min(event.ts, lowest_ts);
+  const std::string kRootName = "ROOT";
+  for (auto* buffer : all_buffers()) {
+    u64 end, dropped;
+    auto events = copy_events(*buffer, 0, &end, &dropped);
+
+    // The ring doesn't have the start of events that were overwritten. A thread records a ROOT
+    // event when no events are open, so from the first to the last ROOT, begins and ends match.
+    // Threads that never record a ROOT keep everything.
+    size_t first = 0;
+    size_t last = events.size();
+    bool found_root = false;
+    for (size_t i = 0; i < events.size(); i++) {
+      if (events[i].kind == ProfNode::INSTANT && kRootName == events[i].name) {
+        if (!found_root) {
+          first = i;
+          found_root = true;
+        }
+        last = i + 1;
+      }
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (!buffer->name.empty()) {
+        trace_events.push_back(thread_name_to_json(buffer->name, buffer->short_id));
+      }
     }
-    if (event.kind == ProfNode::INSTANT && kRootName == event.name) {
-      auto& info = info_per_thread[event.tid];
-      info.lowest_at_target = std::min(info.lowest_at_target, offset);
-      info.highest_at_target = std::max(info.highest_at_target, offset);
+    for (size_t i = first; i < last; i++) {
+      trace_events.push_back(event_to_json(events[i], buffer->short_id, m_t0));
     }
   }
 
-  u32 i = 0;
-  for (auto& info : info_per_thread) {
-    info.second.short_id = i++;
+  file_util::write_text_file(path, dump_json(json));
+}
+
+bool GlobalProfiler::start_streaming(const std::string& path) {
+  if (streaming()) {
+    return false;
+  }
+  file_util::create_dir_if_needed_for_file(path);
+  m_stream_file = file_util::open_file(path, "w");
+  if (!m_stream_file) {
+    lg::error("Failed to open {} for the event profiler stream", path);
+    return false;
   }
+  fmt::print(m_stream_file, "{{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
 
-  for (size_t event_idx = 0; event_idx < m_nodes.size(); event_idx++) {
-    auto& event = m_nodes[(event_idx + m_next_idx) % m_nodes.size()];
-    if (event.kind == ProfNode::UNUSED) {
-      continue;
-    }
-    auto& info = info_per_thread.at(event.tid);
-    if (event_idx < info.lowest_at_target || event_idx > info.highest_at_target) {
-      continue;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& buffer : m_buffers) {
+      buffer->stream_idx = buffer->next_idx.load(std::memory_order_acquire);
+      buffer->name_streamed = false;
     }
+  }
+  m_stream_stop = false;
+  m_stream_first_event = true;
+  m_stream_dropped = 0;
+  m_stream_thread = std::thread([this]() { stream_thread_loop(); });
+  lg::info("Streaming profiler events to {}", path);
+  return true;
+}
 
-    auto& json_event = trace_events.emplace_back();
-    // name
-    if (event.kind != ProfNode::END) {
-      json_event["name"] = event.name;
-    }
+void GlobalProfiler::stop_streaming() {
+  if (!streaming()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_stream_mutex);
+    m_stream_stop = true;
+  }
+  m_stream_cv.notify_all();
+  m_stream_thread.join();
 
-    // cat
-    // json_event["cat"] = "a";  // ??
-    // ph BEi
-    switch (event.kind) {
-      case ProfNode::END:
-        json_event["ph"] = "E";
-        break;
-      case ProfNode::BEGIN:
-        json_event["ph"] = "B";
-        break;
-      case ProfNode::INSTANT:
-        json_event["ph"] = "i";
-        break;
-      default:
-        ASSERT(false);
-    }
-    // pid
-    json_event["pid"] = 1;
-    // tid
-    json_event["tid"] = info.short_id;
-    // ts
-    json_event["ts"] = (event.ts - lowest_ts) / 1000.f;
-    if (event.ts < info.debug) {
-      lg::debug("out of order: {} {} {} ms", event.ts / 1000.f, info.debug / 1000.f,
-                (info.debug - event.ts) / 1000000.f);
-      lg::debug("  idx: {}, range {} {}", event_idx, info.lowest_at_target, info.highest_at_target);
-      lg::debug("  now: {}", m_next_idx);
-    }
-    info.debug = event.ts;
+  fmt::print(m_stream_file, "\n]}}\n");
+  fclose(m_stream_file);
+  m_stream_file = nullptr;
+  if (m_stream_dropped) {
+    lg::warn("Event profiler stream dropped {} events, which were recorded faster than written",
+             m_stream_dropped);
   }
+}
 
-  for (auto& t : info_per_thread) {
-    lg::debug("thread: {}: {} -> {}", t.first, t.second.lowest_at_target,
-              t.second.highest_at_target);
+void GlobalProfiler::stream_thread_loop() {
+  std::unique_lock<std::mutex> lock(m_stream_mutex);
+  bool stop = false;
+  while (!stop) {
+    m_stream_cv.wait_for(lock, std::chrono::milliseconds(100), [&]() { return m_stream_stop; });
+    stop = m_stream_stop;
+    lock.unlock();
+    stream_events();
+    lock.lock();
   }
+}
 
-  file_util::write_text_file(path, json.dump());
+/*!
+ * Write the events recorded since the last call to the stream file.
+ */
+void GlobalProfiler::stream_events() {
+  std::vector<nlohmann::json> json_events;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& buffer : m_buffers) {
+      if (!buffer->name_streamed && !buffer->name.empty()) {
+        json_events.push_back(thread_name_to_json(buffer->name, buffer->short_id));
+        buffer->name_streamed = true;
+      }
+      u64 dropped;
+      auto events = copy_events(*buffer, buffer->stream_idx, &buffer->stream_idx, &dropped);
+      m_stream_dropped += dropped;
+      for (auto& event : events) {
+        json_events.push_back(event_to_json(event, buffer->short_id, m_t0));
+      }
+    }
+  }
+
+  std::string out;
+  for (auto& json_event : json_events) {
+    out += m_stream_first_event ? "" : ",\n";
+    out += dump_json(json_event);
+    m_stream_first_event = false;
+  }
+  fwrite(out.data(), 1, out.size(), m_stream_file);
+  fflush(m_stream_file);
 }
 
 GlobalProfiler gprof;
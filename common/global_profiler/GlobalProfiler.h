@@ -1,36 +1,121 @@
 #pragma once
 
 #include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "common/common_types.h"
 
 struct ProfNode {
   u64 ts;
-  u64 tid;
+  double value;  // for COUNTER, or the duration in ns for COMPLETE
   char name[128];
-  enum Kind : u8 { BEGIN, END, INSTANT, UNUSED } kind = UNUSED;
+  // BEGIN, END and INSTANT are also used by GOAL's pc-prof-event, so they can't change.
+  enum Kind : u8 { BEGIN, END, INSTANT, COUNTER, COMPLETE, FRAME_MARK, UNUSED } kind = UNUSED;
 };
 
+/*!
+ * Records a timeline of events, which can be saved in the Chrome trace format and opened in
+ * chrome://tracing or Perfetto.
+ *
+ * Each thread writes to its own ring buffer, without locking. When the ring is full, the oldest
+ * events are overwritten. The events can be dumped after the fact with dump_to_json, or streamed to
+ * a file while recording with start_streaming.
+ *
+ * When disabled, recording an event is just a check of a flag.
+ */
 class GlobalProfiler {
  public:
   GlobalProfiler();
+  ~GlobalProfiler();
+  GlobalProfiler(const GlobalProfiler&) = delete;
+  GlobalProfiler& operator=(const GlobalProfiler&) = delete;
+
+  // the size of each thread's ring buffer.
   void set_max_events(size_t event_count);
-  void instant_event(const char* name);
-  void begin_event(const char* name);
-  void event(const char* name, ProfNode::Kind kind);
-  void end_event();
+  bool enabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+  void event(const char* name, ProfNode::Kind kind, double value = 0) {
+    if (enabled()) {
+      record(name, kind, value);
+    }
+  }
+  void instant_event(const char* name) { event(name, ProfNode::INSTANT); }
+  void begin_event(const char* name) { event(name, ProfNode::BEGIN); }
+  void end_event() { event("", ProfNode::END); }
+  void counter(const char* name, double value) { event(name, ProfNode::COUNTER, value); }
+  void root_event() { instant_event("ROOT"); }
+  // an instant event drawn across every thread.
+  void frame_mark(const char* name) { event(name, ProfNode::FRAME_MARK); }
+
+  /*!
+   * A track is a timeline for something that isn't a thread, like the GPU. Its events have their
+   * own times, from timestamp(), and may be added out of order. Only one thread at a time may add
+   * events to a track.
+   */
+  u32 add_track(const char* name);
+  void track_zone(u32 track, const char* name, u64 begin_ts, u64 end_ts);
+  // the time in ns used for events.
+  static u64 timestamp();
+
+  // name shown for the current thread in the trace.
+  void set_thread_name(const char* name);
+
   void clear();
   void set_enable(bool en);
   void dump_to_json(const std::string& path);
-  void root_event();
+
+  /*!
+   * Write events to path as they are recorded, until stop_streaming. Events from before this are
+   * not included. If a thread records events faster than they are written, some are lost.
+   */
+  bool start_streaming(const std::string& path);
+  void stop_streaming();
+  bool streaming() const { return m_stream_file != nullptr; }
 
  private:
+  struct ThreadBuffer {
+    std::thread::id owner;
+    u32 short_id = 0;
+    std::vector<ProfNode> nodes;   // allocated on the first event
+    std::atomic<u64> next_idx = 0;  // number of events ever written, only changed by owner
+    u64 stream_idx = 0;             // next event for the stream thread to write
+    std::string name;               // guarded by m_mutex
+    bool name_streamed = false;
+  };
+
+  void record(const char* name, ProfNode::Kind kind, double value);
+  void write_node(ThreadBuffer& buffer,
+                  u64 ts,
+                  const char* name,
+                  ProfNode::Kind kind,
+                  double value);
+  ThreadBuffer& this_thread_buffer();
+  std::vector<ThreadBuffer*> all_buffers();
+  std::vector<ProfNode> copy_events(ThreadBuffer& buffer, u64 start, u64* end, u64* dropped);
+  void stream_thread_loop();
+  void stream_events();
+
+  const u64 m_id;
   std::atomic_bool m_enabled = false;
   u64 m_t0 = 0;
-  std::atomic_size_t m_next_idx = 0;
-  std::vector<ProfNode> m_nodes;
+  size_t m_events_per_thread = 0;
+
+  std::mutex m_mutex;
+  std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;
+
+  FILE* m_stream_file = nullptr;
+  std::thread m_stream_thread;
+  std::mutex m_stream_mutex;
+  std::condition_variable m_stream_cv;
+  bool m_stream_stop = false;
+  bool m_stream_first_event = true;
+  u64 m_stream_dropped = 0;
 };
 
 struct ScopedEvent {
@@ -46,3 +131,19 @@ struct ScopedEvent {
 
 GlobalProfiler& prof();
 ScopedEvent scoped_prof(const char* name);
+
+// Instrumentation that is compiled out when the INSTRUMENTATION build option is off.
+#ifdef OPENGOAL_INSTRUMENTATION
+#define PROF_CONCAT_IMPL(a, b) a##b
+#define PROF_CONCAT(a, b) PROF_CONCAT_IMPL(a, b)
+// an event from here to the end of the scope.
+#define PROF_ZONE(name) auto PROF_CONCAT(prof_zone_, __LINE__) = scoped_prof(name)
+#define PROF_FRAME_MARK(name) prof().frame_mark(name)
+#define PROF_PLOT(name, value) prof().counter(name, value)
+#define PROF_THREAD_NAME(name) prof().set_thread_name(name)
+#else
+#define PROF_ZONE(name) (void)0
+#define PROF_FRAME_MARK(name) (void)0
+#define PROF_PLOT(name, value) (void)0
+#define PROF_THREAD_NAME(name) (void)0
+#endif
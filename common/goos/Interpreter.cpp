@@ -109,6 +109,13 @@ Interpreter::Interpreter(const std::string& username) {
                     {"macro", ObjectType::MACRO},
                     {"environment", ObjectType::ENVIRONMENT}};
 
+  for (const auto& [name, fn] : special_forms) {
+    m_forms_by_symbol[intern_ptr(name)].special = fn;
+  }
+  for (const auto& [name, fn] : builtin_forms) {
+    m_forms_by_symbol[intern_ptr(name)].builtin = fn;
+  }
+
   // load the standard library
   load_goos_library();
 }
@@ -121,7 +128,9 @@ void Interpreter::register_form(
     const std::string& name,
     const std::function<
         Object(const Object&, Arguments&, const std::shared_ptr<EnvironmentObject>&)>& form) {
-  m_custom_forms[name] = form;
+  auto& entry = m_custom_forms[name];
+  entry = form;
+  m_forms_by_symbol[intern_ptr(name)].custom = &entry;
 }
 
 Interpreter::~Interpreter() {
@@ -417,6 +426,7 @@ ArgumentSpec Interpreter::parse_arg_spec(const Object& form, Object& rest) {
       }
 
       spec.rest = rest_name.as_symbol()->name;
+      spec.rest_sym = rest_name.heap_obj.get();
 
       if (!current.as_pair()->cdr.is_empty_list()) {
         throw_eval_error(form, "rest must be the last argument");
@@ -431,7 +441,9 @@ ArgumentSpec Interpreter::parse_arg_spec(const Object& form, Object& rest) {
         if (spec.named.find(key_arg_name) != spec.named.end()) {
           throw_eval_error(form, "key argument " + key_arg_name + " multiply defined");
         }
-        spec.named[key_arg_name] = NamedArg();
+        NamedArg na;
+        na.sym = key_arg.heap_obj.get();
+        spec.named[key_arg_name] = na;
       } else if (key_arg.is_pair()) {
         // form is &key (name default-value)
         auto key_iter = key_arg;
@@ -445,6 +457,7 @@ ArgumentSpec Interpreter::parse_arg_spec(const Object& form, Object& rest) {
           throw_eval_error(form, "key argument " + key_arg_name + " multiply defined");
         }
         NamedArg na;
+        na.sym = kn.heap_obj.get();
 
         if (!key_iter.is_pair()) {
           throw_eval_error(form, "invalid keyword argument definition");
@@ -463,6 +476,7 @@ ArgumentSpec Interpreter::parse_arg_spec(const Object& form, Object& rest) {
       }
     } else {
       spec.unnamed.push_back(arg.as_symbol()->name);
+      spec.unnamed_syms.push_back(arg.heap_obj.get());
     }
 
     current = current.as_pair()->cdr;
@@ -548,7 +562,8 @@ bool try_symbol_lookup(const Object& sym,
                        const std::shared_ptr<EnvironmentObject>& env,
                        Object* dest) {
   // booleans are hard-coded here
-  if (sym.as_symbol()->name == "#t" || sym.as_symbol()->name == "#f") {
+  const auto& name = sym.as_symbol()->name;
+  if (name.size() == 2 && name[0] == '#' && (name[1] == 't' || name[1] == 'f')) {
     *dest = sym;
     return true;
   }
@@ -599,28 +614,28 @@ Object Interpreter::eval_pair(const Object& obj, const std::shared_ptr<Environme
 
   // first see if we got a symbol:
   if (head.type == ObjectType::SYMBOL) {
-    const auto& head_sym = head.as_symbol();
-
-    // try a special form first
-    const auto& kv_sf = special_forms.find(head_sym->name);
-    if (kv_sf != special_forms.end()) {
-      return ((*this).*(kv_sf->second))(obj, rest, env);
-    }
+    static const ArgumentSpec varargs = make_varargs();
+    const auto& kv_form = m_forms_by_symbol.find(head.heap_obj.get());
+    if (kv_form != m_forms_by_symbol.end()) {
+      const auto& forms = kv_form->second;
+      // try a special form first
+      if (forms.special) {
+        return ((*this).*(forms.special))(obj, rest, env);
+      }
 
-    // try builtins next
-    const auto& kv_b = builtin_forms.find(head_sym->name);
-    if (kv_b != builtin_forms.end()) {
-      Arguments args = get_args(obj, rest, make_varargs());
-      // all "built-in" forms expect arguments to be evaluated (that's why they aren't special)
-      eval_args(&args, env);
-      return ((*this).*(kv_b->second))(obj, args, env);
-    }
+      // try builtins next
+      if (forms.builtin) {
+        Arguments args = get_args(obj, rest, varargs);
+        // all "built-in" forms expect arguments to be evaluated (that's why they aren't special)
+        eval_args(&args, env);
+        return ((*this).*(forms.builtin))(obj, args, env);
+      }
 
-    // try custom forms next
-    const auto& kv_u = m_custom_forms.find(head_sym->name);
-    if (kv_u != m_custom_forms.end()) {
-      Arguments args = get_args(obj, rest, make_varargs());
-      return (kv_u->second)(obj, args, env);
+      // try custom forms next
+      if (forms.custom) {
+        Arguments args = get_args(obj, rest, varargs);
+        return (*forms.custom)(obj, args, env);
+      }
     }
 
     // try macros next
@@ -673,19 +688,23 @@ void Interpreter::set_args_in_env(const Object& form,
   }
 
   // unnamed args
+  const bool have_syms = arg_spec.unnamed_syms.size() == arg_spec.unnamed.size();
   for (size_t i = 0; i < arg_spec.unnamed.size(); i++) {
-    env->vars[intern(arg_spec.unnamed.at(i)).as_symbol()] = args.unnamed.at(i);
+    auto* sym = have_syms ? arg_spec.unnamed_syms[i] : intern_ptr(arg_spec.unnamed[i]);
+    env->vars[sym] = args.unnamed.at(i);
   }
 
   // named args
   for (const auto& kv : arg_spec.named) {
-    env->vars[intern(kv.first).as_symbol()] = args.named.at(kv.first);
+    auto* sym = kv.second.sym ? kv.second.sym : intern_ptr(kv.first);
+    env->vars[sym] = args.named.at(kv.first);
   }
 
   // rest args
   if (!arg_spec.rest.empty()) {
     // will correctly handle the '() case
-    env->vars[intern(arg_spec.rest).as_symbol()] = build_list(args.rest);
+    auto* sym = arg_spec.rest_sym ? arg_spec.rest_sym : intern_ptr(arg_spec.rest);
+    env->vars[sym] = build_list(args.rest);
   } else {
     if (!args.rest.empty()) {
       throw_eval_error(form, "got too many arguments");
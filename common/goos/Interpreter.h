@@ -289,6 +289,21 @@ class Interpreter {
                                              const Object& rest,
                                              const std::shared_ptr<EnvironmentObject>& env)>
       special_forms;
+
+  // the forms above, looked up by the symbol of their name. eval_pair uses this so it doesn't have
+  // to hash the name of every form it evaluates.
+  struct FormLookup {
+    Object (Interpreter::*special)(const Object& form,
+                                   const Object& rest,
+                                   const std::shared_ptr<EnvironmentObject>& env) = nullptr;
+    Object (Interpreter::*builtin)(const Object& form,
+                                   Arguments& args,
+                                   const std::shared_ptr<EnvironmentObject>& env) = nullptr;
+    const std::function<
+        Object(const Object&, Arguments&, const std::shared_ptr<EnvironmentObject>&)>* custom =
+        nullptr;
+  };
+  std::unordered_map<HeapObject*, FormLookup> m_forms_by_symbol;
   int64_t gensym_id = 0;
 
   std::unordered_map<std::string, ObjectType> string_to_type;
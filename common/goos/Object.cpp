@@ -5,7 +5,7 @@
  * An "Object" is an efficient wrapper around any of these types.
  * Some types are "heap allocated", and have reference semantics, and others are
  * "fixed" and have value semantics.  Heap allocated objects implement reference counting with
- * std::shared_ptr.
+ * std::shared_ptr. Pairs and strings are allocated from a pool, see make_pooled.
  *
  * To create a new Object for a heap allocated type, use the make_new static method of the type of
  * object you want to make. This will return a correctly setup Object. For fixed objects, use
@@ -42,6 +42,7 @@
 
 #include <cinttypes>
 #include <cstring>
+#include <mutex>
 
 #include "common/util/FileUtil.h"
 #include "common/util/print_float.h"
@@ -50,6 +51,114 @@
 
 namespace goos {
 
+namespace {
+// blocks are multiples of 16 bytes, up to 256. Bigger allocations just use malloc.
+constexpr size_t POOL_BLOCK_ALIGN = 16;
+constexpr size_t POOL_SIZE_CLASSES = 16;
+constexpr size_t POOL_CHUNK_SIZE = 64 * 1024;
+
+struct PoolBlock {
+  PoolBlock* next;
+};
+
+// blocks freed by threads that have exited, for any thread to reuse.
+std::mutex g_pool_mutex;
+PoolBlock* g_pool_orphans[POOL_SIZE_CLASSES] = {};
+
+thread_local PoolBlock* t_pool_free[POOL_SIZE_CLASSES] = {};
+thread_local bool t_pool_exited = false;
+
+void push_orphans(size_t size_class, PoolBlock* head) {
+  if (!head) {
+    return;
+  }
+  PoolBlock* tail = head;
+  while (tail->next) {
+    tail = tail->next;
+  }
+  std::lock_guard<std::mutex> lk(g_pool_mutex);
+  tail->next = g_pool_orphans[size_class];
+  g_pool_orphans[size_class] = head;
+}
+
+// when a thread exits, its free blocks are handed over. Objects freed after this (during static
+// destruction, for example) go straight to the orphans.
+struct PoolThreadExit {
+  ~PoolThreadExit() {
+    t_pool_exited = true;
+    for (size_t i = 0; i < POOL_SIZE_CLASSES; i++) {
+      push_orphans(i, t_pool_free[i]);
+      t_pool_free[i] = nullptr;
+    }
+  }
+};
+thread_local PoolThreadExit t_pool_exit;
+
+PoolBlock* refill_pool(size_t size_class) {
+  {
+    std::lock_guard<std::mutex> lk(g_pool_mutex);
+    if (g_pool_orphans[size_class]) {
+      auto* result = g_pool_orphans[size_class];
+      g_pool_orphans[size_class] = nullptr;
+      return result;
+    }
+  }
+
+  const size_t block_size = (size_class + 1) * POOL_BLOCK_ALIGN;
+  const size_t count = POOL_CHUNK_SIZE / block_size;
+  // operator new is 16 byte aligned on all the platforms we support.
+  static_assert(__STDCPP_DEFAULT_NEW_ALIGNMENT__ >= POOL_BLOCK_ALIGN);
+  u8* chunk = (u8*)::operator new(count * block_size);
+  PoolBlock* head = nullptr;
+  for (size_t i = count; i-- > 0;) {
+    auto* block = (PoolBlock*)(chunk + i * block_size);
+    block->next = head;
+    head = block;
+  }
+  return head;
+}
+}  // namespace
+
+void* pool_allocate(size_t size) {
+  const size_t size_class = (size - 1) / POOL_BLOCK_ALIGN;
+  if (size == 0 || size_class >= POOL_SIZE_CLASSES) {
+    return ::operator new(size);
+  }
+
+  if (t_pool_exited) {
+    PoolBlock* head = refill_pool(size_class);
+    push_orphans(size_class, head->next);
+    return head;
+  }
+
+  // make sure this thread's blocks are handed over when it exits.
+  (void)t_pool_exit;
+  auto& free = t_pool_free[size_class];
+  if (!free) {
+    free = refill_pool(size_class);
+  }
+  PoolBlock* result = free;
+  free = result->next;
+  return result;
+}
+
+void pool_free(void* ptr, size_t size) {
+  const size_t size_class = (size - 1) / POOL_BLOCK_ALIGN;
+  if (size == 0 || size_class >= POOL_SIZE_CLASSES) {
+    ::operator delete(ptr);
+    return;
+  }
+
+  auto* block = (PoolBlock*)ptr;
+  if (t_pool_exited) {
+    block->next = nullptr;
+    push_orphans(size_class, block);
+    return;
+  }
+  block->next = t_pool_free[size_class];
+  t_pool_free[size_class] = block;
+}
+
 /*!
  * Convert type to string (name in brackets)
  */
@@ -158,7 +267,7 @@ Object build_list(const std::vector<Object>& objects) {
   // this is by far the most expensive part of parsing, so this is done a bit carefully.
   // we maintain a std::shared_ptr<PairObject> that represents the list, built from back to front.
   std::shared_ptr<PairObject> head =
-      std::make_shared<PairObject>(objects.back(), Object::make_empty_list());
+      make_pooled<PairObject>(objects.back(), Object::make_empty_list());
 
   s64 idx = ((s64)objects.size()) - 2;
   while (idx >= 0) {
@@ -166,7 +275,7 @@ Object build_list(const std::vector<Object>& objects) {
     next.type = ObjectType::PAIR;
     next.heap_obj = std::move(head);
 
-    head = std::make_shared<PairObject>();
+    head = make_pooled<PairObject>();
     head->car = objects[idx];
     head->cdr = std::move(next);
 
@@ -187,7 +296,7 @@ Object build_list(std::vector<Object>&& objects) {
   // this is by far the most expensive part of parsing, so this is done a bit carefully.
   // we maintain a std::shared_ptr<PairObject> that represents the list, built from back to front.
   std::shared_ptr<PairObject> head =
-      std::make_shared<PairObject>(objects.back(), Object::make_empty_list());
+      make_pooled<PairObject>(objects.back(), Object::make_empty_list());
 
   s64 idx = ((s64)objects.size()) - 2;
   while (idx >= 0) {
@@ -195,7 +304,7 @@ Object build_list(std::vector<Object>&& objects) {
     next.type = ObjectType::PAIR;
     next.heap_obj = std::move(head);
 
-    head = std::make_shared<PairObject>();
+    head = make_pooled<PairObject>();
     head->car = std::move(objects[idx]);
     head->cdr = std::move(next);
 
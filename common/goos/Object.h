@@ -7,7 +7,7 @@
  * An "Object" is an efficient wrapper around any of these types.
  * Some types are "heap allocated", and have reference semantics, and others are
  * "fixed" and have value semantics.  Heap allocated objects implement reference counting with
- * std::shared_ptr.
+ * std::shared_ptr. Pairs and strings are allocated from a pool, see make_pooled.
  *
  * To create a new Object for a heap allocated type, use the make_new static method of the type of
  * object you want to make. This will return a correctly setup Object. For fixed objects, use
@@ -159,6 +159,38 @@ class HeapObject {
   virtual ~HeapObject() = default;
 };
 
+// Reading and macro expanding a big file makes and frees millions of pairs and strings. These come
+// from per-thread free lists of fixed size blocks instead of from malloc. The memory is reused, but
+// never given back to the system.
+void* pool_allocate(size_t size);
+void pool_free(void* ptr, size_t size);
+
+template <typename T>
+struct PoolAllocator {
+  using value_type = T;
+  PoolAllocator() = default;
+  template <typename U>
+  PoolAllocator(const PoolAllocator<U>&) {}
+  T* allocate(size_t n) { return (T*)pool_allocate(n * sizeof(T)); }
+  void deallocate(T* ptr, size_t n) { pool_free(ptr, n * sizeof(T)); }
+  template <typename U>
+  bool operator==(const PoolAllocator<U>&) const {
+    return true;
+  }
+  template <typename U>
+  bool operator!=(const PoolAllocator<U>&) const {
+    return false;
+  }
+};
+
+/*!
+ * Like std::make_shared, but the object and its reference count are allocated from the pool.
+ */
+template <typename T, typename... Args>
+std::shared_ptr<T> make_pooled(Args&&... args) {
+  return std::allocate_shared<T>(PoolAllocator<T>(), std::forward<Args>(args)...);
+}
+
 // forward declare all HeapObjects
 class PairObject;
 class EnvironmentObject;
@@ -373,7 +405,7 @@ class StringObject : public HeapObject {
   static Object make_new(const std::string& text) {
     Object obj;
     obj.type = ObjectType::STRING;
-    obj.heap_obj = std::make_shared<StringObject>(text);
+    obj.heap_obj = make_pooled<StringObject>(text);
     return obj;
   }
 
@@ -393,7 +425,7 @@ class PairObject : public HeapObject {
   static Object make_new(const Object& a, const Object& b) {
     Object obj;
     obj.type = ObjectType::PAIR;
-    obj.heap_obj = std::make_shared<PairObject>(a, b);
+    obj.heap_obj = make_pooled<PairObject>(a, b);
     return obj;
   }
 
@@ -490,6 +522,8 @@ class EnvironmentObject : public HeapObject {
 struct NamedArg {
   bool has_default = false;
   Object default_value;
+  // the symbol for the name, if the spec was made by Interpreter::parse_arg_spec.
+  HeapObject* sym = nullptr;
 };
 
 struct ArgumentSpec {
@@ -497,6 +531,10 @@ struct ArgumentSpec {
   std::vector<std::string> unnamed;
   std::unordered_map<std::string, NamedArg> named;
   std::string rest;
+  // the symbols for unnamed and rest, interned by Interpreter::parse_arg_spec so that binding the
+  // arguments doesn't have to look up the names on each call. Empty for specs made elsewhere.
+  std::vector<HeapObject*> unnamed_syms;
+  HeapObject* rest_sym = nullptr;
   std::string print() const;
 };
 
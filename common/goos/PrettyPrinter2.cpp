@@ -1,5 +1,7 @@
 #include "PrettyPrinter2.h"
 
+#include <algorithm>
+
 #include "common/common_types.h"
 #include "common/util/Assert.h"
 
@@ -35,12 +37,14 @@ struct Node {
 
   Node* parent = nullptr;
   u32 my_depth = 0;
+  u32 order_idx = 0;  // index in bfs_order, parents come before their children.
 
   int get_quote_length() const;
 
   void link(Node* this_parent, std::vector<Node*>* bfs_order, u32 depth) {
     parent = this_parent;
     my_depth = depth;
+    order_idx = bfs_order->size();
     bfs_order->push_back(this);
     switch (kind) {
       case Kind::ATOM:
@@ -86,6 +90,8 @@ struct Node {
   u32 text_len = 0;
 
   bool break_list = false;
+  // set while waiting for text_len to be recomputed after breaking lists
+  bool length_dirty = false;
   u8 top_line_count = 0;
   u8 sub_elt_indent = 0;
 };
@@ -109,7 +115,7 @@ inline const std::string quote_symbol(Node::QuoteKind kind) {
 int Node::get_quote_length() const {
   int out = 0;
   for (auto& q : quotes) {
-    out += quote_symbol(q).length();
+    out += q == QuoteKind::UNQUOTE_SPLICING ? 2 : 1;
   }
   return out;
 }
@@ -150,6 +156,11 @@ Node to_node(const goos::Object& obj) {
 
       // not quoted, so either list or pair
       std::vector<Node> children;
+      size_t child_count = 1;
+      for (auto* it = &obj.as_pair()->cdr; it->is_pair(); it = &it->as_pair()->cdr) {
+        child_count++;
+      }
+      children.reserve(child_count + 1);
       auto* to_print = &obj;
       for (;;) {
         if (to_print->is_pair()) {
@@ -179,64 +190,91 @@ Node to_node(const goos::Object& obj) {
   }
 }
 
-void recompute_lengths(const std::vector<Node*>& bfs_order) {
-  // iterate from leaves up
-  for (auto it = bfs_order.rbegin(); it != bfs_order.rend(); it++) {
-    Node* node = *it;
-    switch (node->kind) {
-      case Node::Kind::ATOM:
-        node->text_len = node->atom_str.length() + node->get_quote_length();
-        break;
-      case Node::Kind::IMPROPER_LIST:
-      case Node::Kind::LIST: {
-        if (node->break_list) {
-          // special case compute first line length
-          int first_line_len = 1 + node->get_quote_length();  // open paren + quotes
-          int nodes_on_first_line =
-              std::min(int(node->child_nodes.size()), int(node->top_line_count));
-          if (nodes_on_first_line > 0) {
-            for (int node_idx = 0; node_idx < nodes_on_first_line; node_idx++) {
-              first_line_len += node->child_nodes.at(node_idx).text_len;
-              first_line_len++;  // trailing space
-            }
-            first_line_len--;  // last one doesn't have a trailing space
+void recompute_length(Node* node) {
+  switch (node->kind) {
+    case Node::Kind::ATOM:
+      node->text_len = node->atom_str.length() + node->get_quote_length();
+      break;
+    case Node::Kind::IMPROPER_LIST:
+    case Node::Kind::LIST: {
+      if (node->break_list) {
+        // special case compute first line length
+        int first_line_len = 1 + node->get_quote_length();  // open paren + quotes
+        int nodes_on_first_line =
+            std::min(int(node->child_nodes.size()), int(node->top_line_count));
+        if (nodes_on_first_line > 0) {
+          for (int node_idx = 0; node_idx < nodes_on_first_line; node_idx++) {
+            first_line_len += node->child_nodes.at(node_idx).text_len;
+            first_line_len++;  // trailing space
           }
+          first_line_len--;  // last one doesn't have a trailing space
+        }
 
-          int max_line_len = first_line_len;
+        int max_line_len = first_line_len;
 
-          // now the length of all the things below
-          for (u32 node_idx = nodes_on_first_line; node_idx < node->child_nodes.size();
-               node_idx++) {
-            int line_len = node->sub_elt_indent + node->child_nodes.at(node_idx).text_len;
-            max_line_len = std::max(max_line_len, line_len);
-          }
+        // now the length of all the things below
+        for (u32 node_idx = nodes_on_first_line; node_idx < node->child_nodes.size(); node_idx++) {
+          int line_len = node->sub_elt_indent + node->child_nodes.at(node_idx).text_len;
+          max_line_len = std::max(max_line_len, line_len);
+        }
 
-          node->text_len = max_line_len;
-        } else {
-          node->text_len = 1 + node->get_quote_length();  // open paren + quotes
-          for (auto& child : node->child_nodes) {
-            node->text_len += (child.text_len + 1);  // space or close paren.
-          }
+        node->text_len = max_line_len;
+      } else {
+        node->text_len = 1 + node->get_quote_length();  // open paren + quotes
+        for (auto& child : node->child_nodes) {
+          node->text_len += (child.text_len + 1);  // space or close paren.
         }
-      } break;
-      default:
-        ASSERT(false);
+      }
+    } break;
+    default:
+      ASSERT(false);
+  }
+}
+
+void recompute_lengths(const std::vector<Node*>& bfs_order) {
+  // iterate from leaves up
+  for (auto it = bfs_order.rbegin(); it != bfs_order.rend(); it++) {
+    recompute_length(*it);
+  }
+}
+
+/*!
+ * Recompute the lengths of lists that were just broken, and everything above them. The rest of the
+ * tree is the same as the last time lengths were computed, so there's no need to visit it.
+ */
+void recompute_lengths(const std::vector<Node*>& broken, std::vector<Node*>* dirty) {
+  dirty->clear();
+  for (auto node : broken) {
+    for (Node* n = node; n && !n->length_dirty; n = n->parent) {
+      n->length_dirty = true;
+      dirty->push_back(n);
     }
   }
+  // children have a larger order_idx than their parents, so this goes from leaves up.
+  std::sort(dirty->begin(), dirty->end(),
+            [](const Node* a, const Node* b) { return a->order_idx > b->order_idx; });
+  for (auto node : *dirty) {
+    recompute_length(node);
+    node->length_dirty = false;
+  }
 }
 
 /*!
  * Note: this has special cases for how to insert breaks.
  * These rules will be used if the printer decides it should break up the list.
  * If you want to force a form to always be broken up, see insert_required_breaks
+ * Every list that gets broken is added to broken, if it is set.
  */
-void break_list(Node* node) {
+void break_list(Node* node, std::vector<Node*>* broken = nullptr) {
   ASSERT(!node->break_list);
   node->break_list = true;
+  if (broken) {
+    broken->push_back(node);
+  }
   node->sub_elt_indent = 2;
   node->top_line_count = 1;
 
-  const std::unordered_set<std::string> sameline_splitters = {
+  static const std::unordered_set<std::string> sameline_splitters = {
       "if",
       "<",
       ">",
@@ -300,7 +338,7 @@ void break_list(Node* node) {
       if (node->child_nodes.size() > 1 && node->child_nodes[1].child_nodes.size() > 1 &&
           !node->child_nodes[1].break_list) {
         // and break the defs.
-        break_list(&node->child_nodes[1]);
+        break_list(&node->child_nodes[1], broken);
       }
     } else if (sameline_splitters.count(name) > 0) {
       // if has a special indent rule:
@@ -311,7 +349,7 @@ void break_list(Node* node) {
       for (size_t i = 1; i < node->child_nodes.size(); i++) {
         auto& cond_body = node->child_nodes[i];
         if (cond_body.kind == Node::Kind::LIST && !cond_body.break_list) {
-          break_list(&cond_body);
+          break_list(&cond_body, broken);
         }
       }
     } else if (name == "case") {
@@ -320,7 +358,7 @@ void break_list(Node* node) {
       for (size_t i = 2; i < node->child_nodes.size(); i++) {
         auto& cond_body = node->child_nodes[i];
         if (cond_body.kind == Node::Kind::LIST && !cond_body.break_list) {
-          break_list(&cond_body);
+          break_list(&cond_body, broken);
         }
       }
     }
@@ -329,14 +367,14 @@ void break_list(Node* node) {
   Node* child = node;
   for (Node* p = node->parent; p; p = p->parent) {
     if (!p->break_list && &p->child_nodes.back() != child) {
-      break_list(p);
+      break_list(p, broken);
     }
     child = p;
   }
 }
 
 void insert_required_breaks(const std::vector<Node*>& bfs_order) {
-  const std::unordered_set<std::string> always_break = {
+  static const std::unordered_set<std::string> always_break = {
       "when",    "defun-debug", "countdown", "case",     "defun",   "defmethod", "let",
       "until",   "while",       "if",        "dotimes",  "cond",    "else",      "defbehavior",
       "with-pp", "rlet",        "defstate",  "behavior", "defpart", "loop",      "let*"};
@@ -350,7 +388,10 @@ void insert_required_breaks(const std::vector<Node*>& bfs_order) {
   }
 }
 
-int run_algorithm(const std::vector<Node*>& bfs_order, int line_length) {
+int run_algorithm(const std::vector<Node*>& bfs_order,
+                  int line_length,
+                  std::vector<Node*>* broken,
+                  std::vector<Node*>* dirty) {
   // our approach is to go in reverse order and find the first list node that is:
   // - too long
   // - not already split.
@@ -358,6 +399,7 @@ int run_algorithm(const std::vector<Node*>& bfs_order, int line_length) {
   // the "too long" check above ignores the sublist.
 
   int num_broken = 0;
+  broken->clear();
   std::optional<s32> min_depth;
   for (auto it = bfs_order.rbegin(); it != bfs_order.rend(); it++) {
     Node* node = *it;
@@ -367,14 +409,14 @@ int run_algorithm(const std::vector<Node*>& bfs_order, int line_length) {
 
     if (node->kind != Node::Kind::ATOM && (int)node->text_len > line_length &&
         node->break_list == false) {
-      break_list(node);
+      break_list(node, broken);
       num_broken++;
       if (!min_depth) {
         min_depth = node->my_depth;
       }
     }
   }
-  recompute_lengths(bfs_order);
+  recompute_lengths(*broken, dirty);
   return num_broken;
 }
 
@@ -499,8 +541,18 @@ void append_node_to_string(const Node* node,
   }
 }
 
-std::string node_to_string(const Node* node) {
+std::string node_to_string(const Node* node, const std::vector<Node*>& bfs_order) {
+  // guess the size of the output, so the string doesn't have to be grown while printing:
+  // the text, a space or newline after each thing, and indentation for things on their own line.
+  size_t size_estimate = 0;
+  for (const auto* n : bfs_order) {
+    size_estimate += (n->kind == Node::Kind::ATOM ? n->atom_str.length() : 2) + 1;
+    if (n->parent && n->parent->break_list) {
+      size_estimate += 2 * n->my_depth;
+    }
+  }
   std::string result;
+  result.reserve(size_estimate);
   append_node_to_string(node, result, 0, 0);
   return result;
 }
@@ -527,11 +579,12 @@ std::string to_string(const goos::Object& obj, int line_length) {
     max_depth = std::max((int)node->my_depth, max_depth);
   }
 
+  std::vector<Node*> broken, dirty;
   int num_broken = 1;
   while (num_broken) {
-    num_broken = run_algorithm(bfs_order, line_length);
+    num_broken = run_algorithm(bfs_order, line_length, &broken, &dirty);
   }
 
-  return node_to_string(&root);
+  return node_to_string(&root, bfs_order);
 }
 }  // namespace pretty_print
@@ -11,6 +11,8 @@
 
 #include "Reader.h"
 
+#include <cstring>
+
 #include "common/log/log.h"
 #include "common/repl/util.h"
 #include "common/util/FileUtil.h"
@@ -53,6 +55,13 @@ bool str_contains(const std::string& str, char c) {
   }
   return false;
 }
+
+/*!
+ * Does this character end a token?
+ */
+bool token_end(char c) {
+  return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == ')' || c == ';' || c == '(';
+}
 }  // namespace
 
 /*!
@@ -71,11 +80,17 @@ void TextStream::seek_past_whitespace_and_comments() {
         read();
         break;
 
-      case ';':
-        // line comment.
-        while (text_remains() && read() != '\n') {
+      case ';': {
+        // line comment. these are most of the text in some files, so look for the end with memchr.
+        const char* start = text->get_text() + seek;
+        const void* end = memchr(start, '\n', text->get_size() - seek);
+        if (end) {
+          seek += (const char*)end - start + 1;
+          line_count++;
+        } else {
+          seek = text->get_size();
         }
-        break;
+      } break;
 
       case '#':
         if (text_remains(1) && peek(1) == '|') {
@@ -86,8 +101,13 @@ void TextStream::seek_past_whitespace_and_comments() {
           // find |#
           while (text_remains() && !found_end) {
             // find |
-            while (text_remains() && read() != '|') {
+            const char* start = text->get_text() + seek;
+            const void* bar = memchr(start, '|', text->get_size() - seek);
+            if (!bar) {
+              skip(text->get_size() - seek);
+              break;
             }
+            skip((const char*)bar - start + 1);
             if (text_remains() && read() == '#') {
               found_end = true;
             }
@@ -272,6 +292,9 @@ Object Reader::internal_read(std::shared_ptr<SourceText> text,
     }
   }
 
+  // each list gets linked in the db, so count them first.
+  db.reserve_links(std::count(text->get_text(), text->get_text() + text->get_size(), '('));
+
   // first create stream
   TextStream ts(text);
 
@@ -338,17 +361,15 @@ Token Reader::get_next_token(TextStream& stream) {
   }
 
   // Second - not a special token, so we read until we get a character that ends the token.
-  while (stream.text_remains()) {
-    char next = stream.peek();
-    if (next == ' ' || next == '\n' || next == '\t' || next == '\r' || next == ')' || next == ';' ||
-        next == '(') {
-      return t;
-    } else {
-      // not the end, so add to token.
-      t.text.push_back(stream.read());
-    }
-  }
-
+  // The token can't contain a newline, so there are no lines to count.
+  const char* text = stream.text->get_text();
+  const int size = stream.text->get_size();
+  int end = stream.seek;
+  while (end < size && !token_end(text[end])) {
+    end++;
+  }
+  t.text.append(text + stream.seek, end - stream.seek);
+  stream.seek = end;
   return t;
 }
 
@@ -624,6 +645,19 @@ bool Reader::read_string(TextStream& stream, Object& obj) {
   std::string str;
 
   while (stream.text_remains()) {
+    // copy up to the next quote or escape at once.
+    const char* start = stream.text->get_text() + stream.seek;
+    const char* end = start;
+    const char* text_end = stream.text->get_text() + stream.text->get_size();
+    while (end < text_end && *end != '"' && *end != '\\') {
+      end++;
+    }
+    str.append(start, end - start);
+    stream.skip(end - start);
+    if (!stream.text_remains()) {
+      break;
+    }
+
     char c = stream.read();
     if (c == '"') {
       obj = StringObject::make_new(str);
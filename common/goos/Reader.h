@@ -11,6 +11,7 @@
  * launching the compiler or the compiler test.
  */
 
+#include <algorithm>
 #include <memory>
 #include <optional>
 #include <unordered_map>
@@ -51,6 +52,16 @@ struct TextStream {
     return c;
   }
 
+  /*!
+   * Skip ahead count characters, counting lines.
+   */
+  void skip(int count) {
+    ASSERT(seek + count <= text->get_size());
+    const char* start = text->get_text() + seek;
+    line_count += std::count(start, start + count, '\n');
+    seek += count;
+  }
+
   bool text_remains() { return seek < text->get_size(); }
   bool text_remains(int i) { return seek + i < text->get_size(); }
   void seek_past_whitespace_and_comments();
@@ -13,6 +13,8 @@
 
 #include "TextDB.h"
 
+#include <algorithm>
+
 #include "common/util/FileUtil.h"
 
 #include "third-party/fmt/core.h"
@@ -112,6 +114,17 @@ void TextDb::link(const Object& o, std::shared_ptr<SourceText> frag, int offset)
   m_map[o.heap_obj] = ref;
 }
 
+/*!
+ * Make room for count more calls to link, so reading a big file doesn't rehash as it goes.
+ */
+void TextDb::reserve_links(size_t count) {
+  size_t needed = m_map.size() + count;
+  if (needed > m_map.bucket_count() * m_map.max_load_factor()) {
+    // at least double, so reading lots of small files doesn't rehash on each one.
+    m_map.reserve(std::max(needed, 2 * m_map.size()));
+  }
+}
+
 /*!
  * Given an object, get a string representing where it's from. Or "?" if we can't find it.
  */
@@ -106,6 +106,7 @@ class TextDb {
 
   void insert(const std::shared_ptr<SourceText>& frag);
   void link(const Object& o, std::shared_ptr<SourceText> frag, int offset);
+  void reserve_links(size_t count);
   std::string get_info_for(const Object& o, bool* terminate_compiler_error = nullptr) const;
   std::optional<ShortInfo> get_short_info_for(const Object& o) const;
   std::string get_info_for(const std::shared_ptr<SourceText>& frag, int offset) const;
@@ -40,7 +40,8 @@ enum ListenerToTargetMsgKind : u16 {
   LTT_MSG_RESET = 8,          //! Reset the game
   LTT_MSG_CODE = 9,           //! Send code to patch into the game
   // below here are added
-  LTT_MSG_SHUTDOWN = 10  //! Shut down the runtime.
+  LTT_MSG_SHUTDOWN = 10,  //! Shut down the runtime.
+  LTT_MSG_CODE_ZSTD = 11  //! LTT_MSG_CODE, compressed with compression::compress_zstd
 };
 
 /*!
@@ -1,8 +1,13 @@
 #include "log.h"
 
+#include <atomic>
+#include <condition_variable>
 #include <cstdio>
 #include <cstdlib>
+#include <memory>
 #include <mutex>
+#include <thread>
+#include <vector>
 
 #include "third-party/fmt/color.h"
 #ifdef _WIN32  // see lg::initialize
@@ -14,6 +19,91 @@
 #include "common/util/FileUtil.h"
 
 namespace lg {
+namespace {
+struct Record {
+  level log_level = level::info;
+  bool is_print = false;  // from lg::print, which has no level or time
+  LogTime time;
+  std::string message;
+};
+
+/*!
+ * Fixed size queue that many threads can add to without locking, and one thread takes from.
+ * Each slot has a sequence number that says whether it's waiting to be filled or to be read.
+ */
+class RecordQueue {
+ public:
+  explicit RecordQueue(size_t size) {
+    size_t rounded = 1;
+    while (rounded < size) {
+      rounded *= 2;
+    }
+    m_mask = rounded - 1;
+    m_slots = std::make_unique<Slot[]>(rounded);
+    for (size_t i = 0; i < rounded; i++) {
+      m_slots[i].seq.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  // false if the queue is full.
+  bool try_push(Record& record) {
+    size_t pos = m_push_pos.load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;) {
+      slot = &m_slots[pos & m_mask];
+      size_t seq = slot->seq.load(std::memory_order_acquire);
+      auto diff = (std::ptrdiff_t)seq - (std::ptrdiff_t)pos;
+      if (diff == 0) {
+        if (m_push_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = m_push_pos.load(std::memory_order_relaxed);
+      }
+    }
+    slot->record = std::move(record);
+    slot->seq.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  // only called from the writer thread.
+  bool try_pop(Record& record) {
+    auto& slot = m_slots[m_pop_pos & m_mask];
+    if (slot.seq.load(std::memory_order_acquire) != m_pop_pos + 1) {
+      return false;
+    }
+    record = std::move(slot.record);
+    slot.seq.store(m_pop_pos + m_mask + 1, std::memory_order_release);
+    m_pop_pos++;
+    return true;
+  }
+
+ private:
+  struct Slot {
+    std::atomic<size_t> seq;
+    Record record;
+  };
+  std::unique_ptr<Slot[]> m_slots;
+  size_t m_mask = 0;
+  std::atomic<size_t> m_push_pos = 0;
+  size_t m_pop_pos = 0;
+};
+
+struct AsyncWriter {
+  explicit AsyncWriter(const AsyncOptions& opts) : options(opts), queue(opts.queue_size) {}
+  AsyncOptions options;
+  RecordQueue queue;
+  std::thread thread;
+  std::mutex wake_mutex;
+  std::condition_variable wake_cv;
+  std::atomic<bool> sleeping = false;
+  bool stop = false;  // guarded by wake_mutex
+  std::atomic<u64> dropped = 0;
+};
+}  // namespace
+
 struct Logger {
   Logger() = default;
 
@@ -24,8 +114,14 @@ struct Logger {
   level flush_level = level::trace;
   std::mutex mutex;
 
+  std::unique_ptr<AsyncWriter> async;
+  std::atomic<bool> async_running = false;
+  // threads between checking async_running and finishing their push.
+  std::atomic<int> async_pushers = 0;
+
   ~Logger() {
     // will run when program exits.
+    stop_async();
     if (fp) {
       fclose(fp);
     }
@@ -40,7 +136,11 @@ const fmt::color log_colors[] = {
     fmt::color::gray, fmt::color::turquoise, fmt::color::light_green, fmt::color::yellow,
     fmt::color::red,  fmt::color::hot_pink,  fmt::color::hot_pink};
 
-void log_message(level log_level, LogTime& now, const char* message) {
+/*!
+ * Write a message to the file and stdout. Returns true if it should be flushed. Must hold the
+ * logger's mutex.
+ */
+bool write_message(level log_level, const LogTime& now, const char* message) {
 #ifdef __linux__
   char date_time_buffer[128];
   time_t now_seconds = now.tv.tv_sec;
@@ -53,57 +153,190 @@ void log_message(level log_level, LogTime& now, const char* message) {
   std::string time_string = fmt::format("[{}]", date_time_buffer);
 #endif
 
-  {
-    std::lock_guard<std::mutex> lock(gLogger.mutex);
-    if (gLogger.fp && log_level >= gLogger.file_log_level) {
-      // log to file
-      std::string file_string =
-          fmt::format("{} [{}] {}\n", time_string, log_level_names[int(log_level)], message);
-      fwrite(file_string.c_str(), file_string.length(), 1, gLogger.fp);
-      if (log_level >= gLogger.flush_level) {
-        fflush(gLogger.fp);
+  bool flush = false;
+  if (gLogger.fp && log_level >= gLogger.file_log_level) {
+    // log to file
+    std::string file_string =
+        fmt::format("{} [{}] {}\n", time_string, log_level_names[int(log_level)], message);
+    fwrite(file_string.c_str(), file_string.length(), 1, gLogger.fp);
+    flush = log_level >= gLogger.flush_level;
+  }
+
+  if (log_level >= gLogger.stdout_log_level ||
+      (log_level == level::die && gLogger.stdout_log_level == level::off_unless_die)) {
+    fmt::print("{} [", time_string);
+    fmt::print(fg(log_colors[int(log_level)]), "{}", log_level_names[int(log_level)]);
+    fmt::print("] {}\n", message);
+    flush = flush || log_level >= gLogger.flush_level;
+  }
+  return flush;
+}
+
+void write_print(const char* message) {
+  if (gLogger.fp) {
+    // Log to File
+    std::string msg(message);
+    fwrite(msg.c_str(), msg.length(), 1, gLogger.fp);
+  }
+
+  if (gLogger.stdout_log_level < lg::level::off_unless_die) {
+    fmt::print(message);
+  }
+}
+
+void flush_all() {
+  fflush(stdout);
+  fflush(stderr);
+  if (gLogger.fp) {
+    fflush(gLogger.fp);
+  }
+}
+
+/*!
+ * Add a record to the async queue. Returns false if the logger isn't async, and the caller should
+ * write it instead.
+ */
+bool try_log_async(Record& record) {
+  gLogger.async_pushers++;
+  if (!gLogger.async_running) {
+    gLogger.async_pushers--;
+    return false;
+  }
+
+  auto& async = *gLogger.async;
+  bool wait = record.is_print || record.log_level >= async.options.drop_below;
+  while (!async.queue.try_push(record)) {
+    if (!wait) {
+      async.dropped++;
+      gLogger.async_pushers--;
+      return true;
+    }
+    // full, so the writer is awake, and will make room soon.
+    std::this_thread::yield();
+  }
+
+  // pairs with the fence in the writer, so either it sees the record, or we see it sleeping.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (async.sleeping.load(std::memory_order_relaxed)) {
+    std::lock_guard<std::mutex> lock(async.wake_mutex);
+    async.wake_cv.notify_one();
+  }
+  gLogger.async_pushers--;
+  return true;
+}
+
+void async_writer_loop(AsyncWriter& async) {
+  Record record;
+  u64 reported_dropped = 0;
+  for (;;) {
+    bool wrote = false;
+    bool flush = false;
+    {
+      std::lock_guard<std::mutex> lock(gLogger.mutex);
+      // write in batches, so the lock isn't taken for every message.
+      for (int i = 0; i < 256 && async.queue.try_pop(record); i++) {
+        if (record.is_print) {
+          write_print(record.message.c_str());
+          flush = true;
+        } else {
+          flush = write_message(record.log_level, record.time, record.message.c_str()) || flush;
+        }
+        wrote = true;
+      }
+      u64 dropped = async.dropped.load();
+      if (dropped != reported_dropped) {
+        LogTime now;
+#ifdef __linux__
+        gettimeofday(&now.tv, nullptr);
+#else
+        now.tim = time(nullptr);
+#endif
+        write_message(level::warn, now,
+                      fmt::format("dropped {} log messages because they were logged faster than "
+                                  "they could be written",
+                                  dropped - reported_dropped)
+                          .c_str());
+        reported_dropped = dropped;
+      }
+      if (flush) {
+        flush_all();
       }
     }
+    if (wrote) {
+      continue;
+    }
 
-    if (log_level >= gLogger.stdout_log_level ||
-        (log_level == level::die && gLogger.stdout_log_level == level::off_unless_die)) {
-      fmt::print("{} [", time_string);
-      fmt::print(fg(log_colors[int(log_level)]), "{}", log_level_names[int(log_level)]);
-      fmt::print("] {}\n", message);
-      if (log_level >= gLogger.flush_level) {
-        fflush(stdout);
-        fflush(stderr);
+    // nothing to write, so flush what's buffered and sleep until there's more.
+    {
+      std::lock_guard<std::mutex> lock(gLogger.mutex);
+      flush_all();
+    }
+    std::unique_lock<std::mutex> lock(async.wake_mutex);
+    async.sleeping = true;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (async.queue.try_pop(record)) {
+      // raced with a push, put the record back in front by writing it now.
+      async.sleeping = false;
+      lock.unlock();
+      std::lock_guard<std::mutex> log_lock(gLogger.mutex);
+      if (record.is_print) {
+        write_print(record.message.c_str());
+      } else {
+        write_message(record.log_level, record.time, record.message.c_str());
       }
+      continue;
     }
+    if (async.stop) {
+      async.sleeping = false;
+      return;
+    }
+    // the timeout is just in case, a push always wakes us.
+    async.wake_cv.wait_for(lock, std::chrono::milliseconds(100));
+    async.sleeping = false;
   }
+}
 
+void log_message(level log_level, LogTime& now, const char* message) {
   if (log_level == level::die) {
-    fflush(stdout);
-    fflush(stderr);
-    if (gLogger.fp) {
-      fflush(gLogger.fp);
+    // write everything before it, then die right away.
+    stop_async();
+  } else {
+    Record record;
+    record.log_level = log_level;
+    record.time = now;
+    record.message = message;
+    if (try_log_async(record)) {
+      return;
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(gLogger.mutex);
+    if (write_message(log_level, now, message)) {
+      flush_all();
     }
+  }
+
+  if (log_level == level::die) {
+    flush_all();
     abort();
   }
 }
 
 void log_print(const char* message) {
+  Record record;
+  record.is_print = true;
+  record.message = message;
+  if (try_log_async(record)) {
+    return;
+  }
+
   {
     // We always immediately flush prints because since it has no associated level
     // it could be anything from a fatal error to a useless debug log.
     std::lock_guard<std::mutex> lock(gLogger.mutex);
-    if (gLogger.fp) {
-      // Log to File
-      std::string msg(message);
-      fwrite(msg.c_str(), msg.length(), 1, gLogger.fp);
-      fflush(gLogger.fp);
-    }
-
-    if (gLogger.stdout_log_level < lg::level::off_unless_die) {
-      fmt::print(message);
-      fflush(stdout);
-      fflush(stderr);
-    }
+    write_print(message);
+    flush_all();
   }
 }
 }  // namespace internal
@@ -197,7 +430,35 @@ void initialize() {
   gLogger.initialized = true;
 }
 
+void start_async(const AsyncOptions& options) {
+  if (gLogger.async) {
+    return;
+  }
+  gLogger.async = std::make_unique<AsyncWriter>(options);
+  gLogger.async->thread = std::thread([]() { internal::async_writer_loop(*gLogger.async); });
+  gLogger.async_running = true;
+}
+
+void stop_async() {
+  if (!gLogger.async) {
+    return;
+  }
+  // new messages are written by their thread from now on. Wait for ones already being pushed.
+  gLogger.async_running = false;
+  while (gLogger.async_pushers.load() != 0) {
+    std::this_thread::yield();
+  }
+  {
+    std::lock_guard<std::mutex> lock(gLogger.async->wake_mutex);
+    gLogger.async->stop = true;
+  }
+  gLogger.async->wake_cv.notify_one();
+  gLogger.async->thread.join();
+  gLogger.async.reset();
+}
+
 void finish() {
+  stop_async();
   {
     std::lock_guard<std::mutex> lock(gLogger.mutex);
     if (gLogger.fp) {
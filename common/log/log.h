@@ -50,6 +50,21 @@ void set_max_debug_levels();
 void initialize();
 void finish();
 
+struct AsyncOptions {
+  // messages that can be waiting to be written, rounded up to a power of two.
+  size_t queue_size = 4096;
+  // when the queue is full, messages below this level are dropped, and others wait for room.
+  level drop_below = level::info;
+};
+
+/*!
+ * Write messages from a background thread, so logging doesn't wait on the console or the file.
+ * Messages are still written in the order they were logged. die is always written right away.
+ */
+void start_async(const AsyncOptions& options = {});
+// write everything that's queued, then go back to writing on the logging thread.
+void stop_async();
+
 template <typename... Args>
 void log(level log_level, const std::string& format, Args&&... args) {
   LogTime now;
@@ -1,6 +1,10 @@
 // clang-format off
 #include "ReplServer.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
 #include "common/cross_sockets/XSocket.h"
 #include "common/versions/versions.h"
 
@@ -23,136 +27,172 @@
 // TODO - The server also needs to eventually return the result of the evaluation
 
 ReplServer::~ReplServer() {
-  // Close all our client sockets!
-  for (const int& sock : client_sockets) {
-    close_socket(sock);
-  }
+  stop_network();
 }
 
 void ReplServer::post_init() {
-  // Add the listening socket to our set of sockets
   lg::info("[nREPL:{}:{}] awaiting connections", tcp_port, listening_socket);
+  stop_network_thread = false;
+  network_thread = std::thread([this]() { network_loop(); });
 }
 
-void ReplServer::ping_response(int socket) {
-  std::string ping = fmt::format("Connected to OpenGOAL v{}.{} nREPL!",
-                                 versions::GOAL_VERSION_MAJOR, versions::GOAL_VERSION_MINOR);
-  auto resp = write_to_socket(socket, ping.c_str(), ping.size());
-  if (resp == -1) {
-    lg::warn("[nREPL:{}] Client Disconnected: {}", tcp_port, inet_ntoa(addr.sin_addr),
-             ntohs(addr.sin_port), socket);
-    close_socket(socket);
-    client_sockets.erase(socket);
+void ReplServer::shutdown_server() {
+  // the network thread has to be done with the listening socket before it's closed.
+  stop_network();
+  XSocketServer::shutdown_server();
+}
+
+void ReplServer::stop_network() {
+  stop_network_thread = true;
+  if (network_thread.joinable()) {
+    network_thread.join();
+  }
+  // Close all our client sockets!
+  for (const auto& [sock, client] : clients) {
+    close_socket(sock);
   }
+  clients.clear();
 }
 
-std::optional<std::string> ReplServer::get_msg() {
-  // Clear the sockets we are listening on
-  FD_ZERO(&read_sockets);
+bool ReplServer::ping_response(int socket) {
+  std::string ping = fmt::format("Connected to OpenGOAL v{}.{} nREPL!",
+                                 versions::GOAL_VERSION_MAJOR, versions::GOAL_VERSION_MINOR);
+  return write_to_socket(socket, ping.c_str(), ping.size()) != -1;
+}
 
-  // Add the server's main listening socket (where we accept clients from)
-  FD_SET(listening_socket, &read_sockets);
+void ReplServer::disconnect_client(int sock) {
+  // TODO - add a queue of messages in the REPL::Wrapper so we can print _BEFORE_ the prompt
+  // is output
+  lg::warn("[nREPL:{}] Client Disconnected: {}", tcp_port, sock);
+  close_socket(sock);
+  clients.erase(sock);
+}
 
-  int max_sd = listening_socket;
-  for (const int& sock : client_sockets) {
-    if (sock > max_sd) {
-      max_sd = sock;
-    }
-    if (sock > 0) {
-      FD_SET(sock, &read_sockets);
-    }
+void ReplServer::accept_client() {
+  sockaddr_in client_addr = {};
+  socklen_t addr_len = sizeof(client_addr);
+  auto new_socket = accept_socket(listening_socket, (sockaddr*)&client_addr, &addr_len);
+  if (new_socket < 0) {
+    return;
+  }
+  if ((int)clients.size() >= max_clients) {
+    lg::warn("[nREPL:{}]: Too many clients, refusing connection from {}:{}", tcp_port,
+             inet_ntoa(client_addr.sin_addr), ntohs(client_addr.sin_port));
+    close_socket(new_socket);
+    return;
   }
+  lg::info("[nREPL:{}]: New socket connection: {}:{}:{}", tcp_port,
+           inet_ntoa(client_addr.sin_addr), ntohs(client_addr.sin_port), new_socket);
 
-  // Wait for activity on _something_, with a timeout so we don't get stuck here on exit.
-  struct timeval timeout;
-  timeout.tv_sec = 0;
-  timeout.tv_usec = 100000;
-  auto activity = select(max_sd + 1, &read_sockets, NULL, NULL, &timeout);
+  // Say hello
+  if (!ping_response(new_socket)) {
+    close_socket(new_socket);
+    return;
+  }
+  clients[new_socket] = {};
+}
 
-  if (activity < 0) {  // TODO - || error!
-    return std::nullopt;
+/*!
+ * Read what the client has sent, and handle each message that is now complete. Only called when
+ * select says the socket is readable, so the read doesn't block. Returns false if the client
+ * should be disconnected.
+ */
+bool ReplServer::read_from_client(int sock, Client& client) {
+  constexpr int kReadSize = 64 * 1024;
+  const size_t old_size = client.incoming.size();
+  client.incoming.resize(old_size + kReadSize);
+  auto got = read_from_socket(sock, client.incoming.data() + old_size, kReadSize);
+  if (got < 0 && socket_timed_out()) {
+    client.incoming.resize(old_size);
+    return true;
+  }
+  if (got <= 0) {
+    return false;
   }
+  client.incoming.resize(old_size + got);
+
+  size_t offset = 0;
+  while (client.incoming.size() - offset >= sizeof(ReplServerHeader)) {
+    ReplServerHeader header;
+    memcpy(&header, client.incoming.data() + offset, sizeof(ReplServerHeader));
+    if (header.length > buffer.size()) {
+      lg::error("[nREPL:{}]: Bad message from {}, message size {} is larger than the limit {}",
+                tcp_port, sock, header.length, buffer.size());
+      return false;
+    }
+    if (client.incoming.size() - offset - sizeof(ReplServerHeader) < header.length) {
+      break;  // wait for the rest of the body
+    }
+    const char* body = client.incoming.data() + offset + sizeof(ReplServerHeader);
+    offset += sizeof(ReplServerHeader) + header.length;
 
-  // If something happened on the master socket - it's a new connection
-  if (FD_ISSET(listening_socket, &read_sockets)) {
-    socklen_t addr_len = sizeof(addr);
-    auto new_socket = accept_socket(listening_socket, (sockaddr*)&addr, &addr_len);
-    if (new_socket < 0) {
-      // TODO - handle error
-    } else {
-      lg::info("[nREPL:{}]: New socket connection: {}:{}:{}", tcp_port, inet_ntoa(addr.sin_addr),
-               ntohs(addr.sin_port), new_socket);
-
-      // Say hello
-      ping_response(new_socket);
-      // Track the new socket
-      if ((int)client_sockets.size() < max_clients) {
-        client_sockets.insert(new_socket);
-      } else {
-        // TODO - Respond with NO
-      }
+    switch (header.type) {
+      case ReplServerMessageType::PING:
+        if (!ping_response(sock)) {
+          return false;
+        }
+        break;
+      case ReplServerMessageType::EVAL: {
+        std::string msg(body, header.length);
+        lg::debug("[nREPL:{}] Received Message: {}", tcp_port, msg);
+        std::lock_guard<std::mutex> lk(eval_queue_mutex);
+        eval_queue.push_back(std::move(msg));
+        eval_queue_cv.notify_one();
+      } break;
+      default:
+        lg::warn("[nREPL:{}] Ignoring message with unknown type {}", tcp_port, header.type);
+        break;
     }
   }
+  client.incoming.erase(client.incoming.begin(), client.incoming.begin() + offset);
+  return true;
+}
 
-  // otherwise (and no matter what) check all the clients to see if they have sent us anything
-  // else its some IO operation on some other socket
-  //
-  // RACE - the first client wins
-
-  // TODO - there are ways to do this with iterators but, couldn't figure it out!
-  std::vector<int> sockets_to_scan(client_sockets.begin(), client_sockets.end());
-  for (const int& sock : sockets_to_scan) {
-    if (FD_ISSET(sock, &read_sockets)) {
-      // Attempt to read a header
-      // TODO - should this be in a loop?
-      auto req_bytes = read_from_socket(sock, header_buffer.data(), header_buffer.size());
-      if (req_bytes == 0) {
-        // Socket disconnected
-        // TODO - add a queue of messages in the REPL::Wrapper so we can print _BEFORE_ the prompt
-        // is output
-        lg::warn("[nREPL:{}] Client Disconnected: {}", tcp_port, inet_ntoa(addr.sin_addr),
-                 ntohs(addr.sin_port), sock);
-
-        // Cleanup the socket and remove it from our set
-        close_socket(sock);
-        client_sockets.erase(sock);
-      } else {
-        // Otherwise, process the message
-        auto* header = (ReplServerHeader*)(header_buffer.data());
-        // get the body of the message
-        int expected_size = header->length;
-        int got = 0;
-        int tries = 0;
-        while (got < expected_size) {
-          tries++;
-          if (tries > 100) {
-            break;
-          }
-          if (got + expected_size > (int)buffer.size()) {
-            lg::error(
-                "[nREPL:{}]: Bad message, aborting the read.  Got :{}, Expected: {}, Buffer "
-                "Size: {}",
-                tcp_port, got, expected_size, buffer.size());
-            return std::nullopt;
-          }
-          auto x = read_from_socket(sock, buffer.data() + got, expected_size - got);
-          if (want_exit_callback()) {
-            return std::nullopt;
-          }
-          got += x > 0 ? x : 0;
-        }
+void ReplServer::network_loop() {
+  while (!stop_network_thread && !want_exit_callback()) {
+    fd_set read_sockets;
+    FD_ZERO(&read_sockets);
+    // the server's main listening socket (where we accept clients from), and every client.
+    FD_SET(listening_socket, &read_sockets);
+    int max_sd = listening_socket;
+    for (const auto& [sock, client] : clients) {
+      max_sd = std::max(max_sd, sock);
+      FD_SET(sock, &read_sockets);
+    }
 
-        switch (header->type) {
-          case ReplServerMessageType::PING:
-            ping_response(sock);
-            return std::nullopt;
-          case ReplServerMessageType::EVAL:
-            std::string msg(buffer.data(), header->length);
-            lg::debug("[nREPL:{}] Received Message: {}", tcp_port, msg);
-            return std::make_optional(msg);
-        }
+    // Wait for activity on _something_, with a timeout so we don't get stuck here on exit.
+    struct timeval timeout;
+    timeout.tv_sec = 0;
+    timeout.tv_usec = 100000;
+    auto activity = select(max_sd + 1, &read_sockets, NULL, NULL, &timeout);
+    if (activity <= 0) {
+      continue;
+    }
+
+    std::vector<int> ready_clients;
+    for (const auto& [sock, client] : clients) {
+      if (FD_ISSET(sock, &read_sockets)) {
+        ready_clients.push_back(sock);
       }
     }
+    for (int sock : ready_clients) {
+      if (!read_from_client(sock, clients.at(sock))) {
+        disconnect_client(sock);
+      }
+    }
+    if (FD_ISSET(listening_socket, &read_sockets)) {
+      accept_client();
+    }
+  }
+}
+
+std::optional<std::string> ReplServer::get_msg() {
+  std::unique_lock<std::mutex> lk(eval_queue_mutex);
+  eval_queue_cv.wait_for(lk, std::chrono::milliseconds(100), [&]() { return !eval_queue.empty(); });
+  if (eval_queue.empty()) {
+    return std::nullopt;
   }
-  return std::nullopt;
+  auto msg = std::move(eval_queue.front());
+  eval_queue.pop_front();
+  return msg;
 }
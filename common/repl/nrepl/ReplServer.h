@@ -1,7 +1,14 @@
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
 #include <optional>
-#include <set>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "common/cross_sockets/XSocketServer.h"
 
@@ -12,20 +19,41 @@ struct ReplServerHeader {
   u32 type;
 };
 
+/// The nREPL server. Clients are serviced on a network thread that waits on all of their sockets
+/// at once, so one client that is slow to send a message doesn't hold up the others. Forms to
+/// evaluate are queued, and taken off the queue with get_msg on whatever thread runs the compiler,
+/// so the network thread keeps accepting clients and answering pings during a compile.
 class ReplServer : public XSocketServer {
  public:
   using XSocketServer::XSocketServer;
   virtual ~ReplServer();
 
   void post_init() override;
+  void shutdown_server() override;
 
+  /// The next form to evaluate, from any client, waiting a short time for one to arrive.
   std::optional<std::string> get_msg();
 
  private:
-  int max_clients = 50;
-  std::vector<char> header_buffer = std::vector<char>((int)sizeof(ReplServerHeader));
-  fd_set read_sockets;
-  std::set<int> client_sockets = {};
+  struct Client {
+    // received bytes that don't make a whole message yet.
+    std::vector<char> incoming;
+  };
 
-  void ping_response(int socket);
+  int max_clients = 50;
+  // only used on the network thread
+  std::map<int, Client> clients;
+
+  std::thread network_thread;
+  std::atomic<bool> stop_network_thread = false;
+  std::mutex eval_queue_mutex;
+  std::condition_variable eval_queue_cv;
+  std::deque<std::string> eval_queue;
+
+  void network_loop();
+  void accept_client();
+  bool read_from_client(int sock, Client& client);
+  void stop_network();
+  void disconnect_client(int sock);
+  bool ping_response(int socket);
 };
@@ -3,6 +3,7 @@
 #include "common/goos/ParseHelpers.h"
 #include "common/goos/Reader.h"
 #include "common/util/FileUtil.h"
+#include "common/util/ThreadPool.h"
 #include "common/util/json_util.h"
 
 #include "third-party/fmt/core.h"
@@ -411,7 +412,48 @@ void parse_subtitle(const goos::Object& data,
   }
 }
 
+namespace {
+/*!
+ * Read a json subtitle file, merged over its base file if it has one.
+ */
+json read_subtitle_json_with_base(const std::optional<std::string>& base_path,
+                                  const std::string& path,
+                                  const std::vector<std::string>& merged_keys) {
+  const auto& project_dir = file_util::get_jak_project_dir();
+  auto data = read_commented_json_file((project_dir / path).string());
+  if (!base_path) {
+    return *data;
+  }
+  json result = *read_commented_json_file((project_dir / base_path.value()).string());
+  for (const auto& key : merged_keys) {
+    result.at(key).update(data->at(key));
+  }
+  return result;
+}
+}  // namespace
+
+SubtitleJsonFiles read_subtitle_json_files(const GameSubtitleDefinitionFile& file_info) {
+  SubtitleJsonFiles result;
+  try {
+    result.meta = read_subtitle_json_with_base(file_info.meta_base_path, file_info.meta_path,
+                                               {"cutscenes", "hints"});
+    result.lines = read_subtitle_json_with_base(file_info.lines_base_path, file_info.lines_path,
+                                                {"cutscenes", "hints", "speakers"});
+  } catch (std::exception& e) {
+    lg::error("Unable to parse subtitle json entry, couldn't successfully load files - {}",
+              e.what());
+    throw;
+  }
+  return result;
+}
+
 void parse_subtitle_json(GameSubtitleDB& db, const GameSubtitleDefinitionFile& file_info) {
+  parse_subtitle_json(db, file_info, read_subtitle_json_files(file_info));
+}
+
+void parse_subtitle_json(GameSubtitleDB& db,
+                         const GameSubtitleDefinitionFile& file_info,
+                         const SubtitleJsonFiles& files) {
   // TODO - some validation
   // Init Settings
   std::shared_ptr<GameSubtitleBank> bank;
@@ -424,52 +466,8 @@ void parse_subtitle_json(GameSubtitleDB& db, const GameSubtitleDefinitionFile& f
   bank->m_text_version = file_info.text_version;
   bank->m_file_path = file_info.lines_path;
   const GameTextFontBank* font = get_font_bank(file_info.text_version);
-  // Parse the file
-  SubtitleMetadataFile meta_file;
-  SubtitleFile lines_file;
-  try {
-    // If we have a base file defined, load that and merge it
-    if (file_info.meta_base_path) {
-      auto base_data =
-          parse_commented_json(file_util::read_text_file(file_util::get_jak_project_dir() /
-                                                         file_info.meta_base_path.value()),
-                               "subtitle_meta_base_path");
-      auto data = parse_commented_json(
-          file_util::read_text_file(file_util::get_jak_project_dir() / file_info.meta_path),
-          "subtitle_meta_path");
-      base_data.at("cutscenes").update(data.at("cutscenes"));
-      base_data.at("hints").update(data.at("hints"));
-      meta_file = base_data;
-
-    } else {
-      meta_file = parse_commented_json(
-          file_util::read_text_file(file_util::get_jak_project_dir() / file_info.meta_path),
-          "subtitle_meta_path");
-    }
-    if (file_info.lines_base_path) {
-      auto base_data =
-          parse_commented_json(file_util::read_text_file(file_util::get_jak_project_dir() /
-                                                         file_info.lines_base_path.value()),
-                               "subtitle_line_base_path");
-
-      auto data = parse_commented_json(
-          file_util::read_text_file(file_util::get_jak_project_dir() / file_info.lines_path),
-          "subtitle_line_path");
-      base_data.at("cutscenes").update(data.at("cutscenes"));
-      base_data.at("hints").update(data.at("hints"));
-      base_data.at("speakers").update(data.at("speakers"));
-      auto test = base_data.dump();
-      lines_file = base_data;
-    } else {
-      lines_file = parse_commented_json(
-          file_util::read_text_file(file_util::get_jak_project_dir() / file_info.lines_path),
-          "subtitle_line_path");
-    }
-  } catch (std::exception& e) {
-    lg::error("Unable to parse subtitle json entry, couldn't successfully load files - {}",
-              e.what());
-    throw;
-  }
+  const auto& meta_file = files.meta;
+  const auto& lines_file = files.lines;
   // Iterate through the metadata file as blank lines are no omitted from the lines file now
   // Cutscenes First
   for (const auto& [cutscene_name, cutscene_lines] : meta_file.cutscenes) {
@@ -958,26 +956,43 @@ SubtitleFile dump_bank_as_json(std::shared_ptr<GameSubtitleBank> bank,
   return file;
 }
 
+void parse_subtitle_files(GameSubtitleDB& db,
+                          const std::vector<GameSubtitleDefinitionFile>& files) {
+  // reading and parsing the json is independent for each file, so do that in parallel. Adding the
+  // results to the db is done in order, so later files still override earlier ones.
+  std::vector<SubtitleJsonFiles> json_files(files.size());
+  ThreadPool::global().parallel_for(
+      [&](int i) {
+        if (files[i].format == GameSubtitleDefinitionFile::Format::JSON) {
+          json_files[i] = read_subtitle_json_files(files[i]);
+        }
+      },
+      files.size());
+
+  goos::Reader reader;
+  for (size_t i = 0; i < files.size(); i++) {
+    const auto& file = files[i];
+    if (file.format == GameSubtitleDefinitionFile::Format::GOAL) {
+      auto code = reader.read_from_file({file.lines_path});
+      parse_subtitle(code, db, file.lines_path);
+    } else if (file.format == GameSubtitleDefinitionFile::Format::JSON) {
+      parse_subtitle_json(db, file, json_files[i]);
+    }
+  }
+}
+
 GameSubtitleDB load_subtitle_project(GameVersion game_version) {
   // Load the subtitle files
   GameSubtitleDB db;
   db.m_subtitle_groups = std::make_unique<GameSubtitleGroups>();
   db.m_subtitle_groups->hydrate_from_asset_file();
   try {
-    goos::Reader reader;
     std::vector<GameSubtitleDefinitionFile> files;
     std::string subtitle_project = (file_util::get_jak_project_dir() / "game" / "assets" /
                                     version_to_game_name(game_version) / "game_subtitle.gp")
                                        .string();
     open_subtitle_project("subtitle", subtitle_project, files);
-    for (auto& file : files) {
-      if (file.format == GameSubtitleDefinitionFile::Format::GOAL) {
-        auto code = reader.read_from_file({file.lines_path});
-        parse_subtitle(code, db, file.lines_path);
-      } else if (file.format == GameSubtitleDefinitionFile::Format::JSON) {
-        parse_subtitle_json(db, file);
-      }
-    }
+    parse_subtitle_files(db, files);
   } catch (std::runtime_error& e) {
     lg::error("error loading subtitle project: {}", e.what());
   }
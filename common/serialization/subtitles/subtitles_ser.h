@@ -262,6 +262,20 @@ void parse_text_json(const nlohmann::json& json,
 void parse_subtitle(const goos::Object& data, GameSubtitleDB& db, const std::string& file_path);
 void parse_subtitle_json(GameSubtitleDB& db, const GameSubtitleDefinitionFile& file_info);
 
+// the metadata and lines of a json subtitle file, merged with their base files.
+struct SubtitleJsonFiles {
+  SubtitleMetadataFile meta;
+  SubtitleFile lines;
+};
+// doesn't touch the db, so it can run on any thread.
+SubtitleJsonFiles read_subtitle_json_files(const GameSubtitleDefinitionFile& file_info);
+void parse_subtitle_json(GameSubtitleDB& db,
+                         const GameSubtitleDefinitionFile& file_info,
+                         const SubtitleJsonFiles& files);
+// parse all of the files, reading the json ones in parallel.
+void parse_subtitle_files(GameSubtitleDB& db,
+                          const std::vector<GameSubtitleDefinitionFile>& files);
+
 GameTextVersion parse_text_only_version(const std::string& filename);
 GameTextVersion parse_text_only_version(const goos::Object& data);
 
@@ -1,27 +1,54 @@
 #include "subtitles2_deser.h"
 
+#include <atomic>
+
 #include "common/log/log.h"
 #include "common/util/FileUtil.h"
+#include "common/util/ThreadPool.h"
 
 #include "third-party/json.hpp"
+#include "third-party/zstd/lib/common/xxhash.h"
 
 const std::vector<std::string> locale_lookup = {"en-US", "fr-FR", "de-DE", "es-ES",
                                                 "it-IT", "jp-JP", "ko-KR", "en-GB"};
 
-bool write_subtitle_db_to_files(const GameSubtitle2DB& db, const GameVersion game_version) {
+/*!
+ * Save the banks that changed since they were last saved. The banks are serialized in parallel, and
+ * a bank is only written if its json is different from what was saved, or from the file the first
+ * time.
+ */
+bool write_subtitle_db_to_files(GameSubtitle2DB& db, const GameVersion game_version) {
+  std::vector<std::pair<int, GameSubtitle2Bank*>> banks;
+  for (auto& [language_id, bank] : db.m_banks) {
+    banks.push_back({language_id, bank.get()});
+  }
+  std::atomic<int> written = 0;
   try {
-    for (const auto& [language_id, bank] : db.m_banks) {
-      json data;
-      to_json(data, *bank);
-      std::string dump_path = (file_util::get_jak_project_dir() / "game" / "assets" /
-                               version_to_game_name(game_version) / "subtitle" /
-                               fmt::format("subtitle_{}.json", locale_lookup.at(language_id)))
-                                  .string();
-      file_util::write_text_file(dump_path, data.dump(2));
-    }
+    ThreadPool::global().parallel_for(
+        [&](int i) {
+          auto [language_id, bank_ptr] = banks[i];
+          auto& bank = *bank_ptr;
+          json data;
+          to_json(data, bank);
+          auto text = data.dump(2);
+          u64 hash = XXH64(text.data(), text.size(), 0);
+          if (hash == bank.saved_hash) {
+            return;
+          }
+          auto dump_path = file_util::get_jak_project_dir() / "game" / "assets" /
+                           version_to_game_name(game_version) / "subtitle" /
+                           fmt::format("subtitle_{}.json", locale_lookup.at(language_id));
+          if (!fs::exists(dump_path) || file_util::read_text_file(dump_path) != text) {
+            file_util::write_text_file(dump_path, text);
+            written++;
+          }
+          bank.saved_hash = hash;
+        },
+        banks.size());
   } catch (std::exception& ex) {
     lg::error(ex.what());
     return false;
   }
+  lg::info("saved {} of {} subtitle files", written.load(), banks.size());
   return true;
 }
@@ -4,6 +4,7 @@
 #include "common/goos/Reader.h"
 #include "common/log/log.h"
 #include "common/util/FileUtil.h"
+#include "common/util/ThreadPool.h"
 #include "common/util/json_util.h"
 
 // matches enum in `subtitle2.gc` with "none" (first) and "max" (last) removed
@@ -69,10 +70,9 @@ void parse_subtitle2_json(GameSubtitle2DB& db, const GameSubtitle2DefinitionFile
     bank->text_version = file_info.text_version;
     bank->file_path = file_info.file_path;
     // Parse the file
-    auto file = parse_commented_json(
-        file_util::read_text_file(file_util::get_jak_project_dir() / file_info.file_path),
-        "subtitle2_json");
-    from_json(file, *bank);
+    auto file = read_commented_json_file(
+        (file_util::get_jak_project_dir() / file_info.file_path).string());
+    from_json(*file, *bank);
   } catch (std::exception& e) {
     lg::error("Unable to parse subtitle json entry, couldn't successfully load files - {}",
               e.what());
@@ -80,6 +80,30 @@ void parse_subtitle2_json(GameSubtitle2DB& db, const GameSubtitle2DefinitionFile
   }
 }
 
+void parse_subtitle2_files(GameSubtitle2DB& db,
+                           const std::vector<GameSubtitle2DefinitionFile>& files) {
+  // the languages don't share anything, so they are parsed in parallel. The files of one language
+  // are still parsed in order, so later files override earlier ones.
+  std::map<int, std::vector<const GameSubtitle2DefinitionFile*>> files_by_lang;
+  for (auto& file : files) {
+    if (!db.bank_exists(file.language_id)) {
+      db.add_bank(std::make_shared<GameSubtitle2Bank>(file.language_id));
+    }
+    files_by_lang[file.language_id].push_back(&file);
+  }
+  std::vector<std::vector<const GameSubtitle2DefinitionFile*>*> langs;
+  for (auto& [lang, lang_files] : files_by_lang) {
+    langs.push_back(&lang_files);
+  }
+  ThreadPool::global().parallel_for(
+      [&](int i) {
+        for (auto* file : *langs[i]) {
+          parse_subtitle2_json(db, *file);
+        }
+      },
+      langs.size());
+}
+
 void to_json(json& j, const Subtitle2Line& obj) {
   j = json{{"start", obj.start}, {"end", obj.end},         {"offscreen", obj.offscreen},
            {"merge", obj.merge}, {"speaker", obj.speaker}, {"text", obj.text}};
@@ -176,15 +200,12 @@ GameSubtitle2DB load_subtitle2_project(GameVersion game_version) {
   // Load the subtitle files
   GameSubtitle2DB db(game_version);
   try {
-    goos::Reader reader;
     std::vector<GameSubtitle2DefinitionFile> files;
     std::string subtitle_project = (file_util::get_jak_project_dir() / "game" / "assets" /
                                     version_to_game_name(game_version) / "game_subtitle.gp")
                                        .string();
     open_subtitle2_project("subtitle2", subtitle_project, files);
-    for (auto& file : files) {
-      parse_subtitle2_json(db, file);
-    }
+    parse_subtitle2_files(db, files);
   } catch (std::runtime_error& e) {
     lg::error("error loading subtitle project: {}", e.what());
   }
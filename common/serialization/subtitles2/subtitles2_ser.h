@@ -56,6 +56,9 @@ struct GameSubtitle2Bank {
   std::map<std::string, std::string> speakers;
   std::map<std::string, Subtitle2Scene> scenes;
 
+  // hash of the json that was last saved, to skip saving banks that didn't change.
+  u64 saved_hash = 0;
+
   bool scene_exists(const std::string& name) const { return scenes.find(name) != scenes.end(); }
   void add_scene(const std::string& name, Subtitle2Scene& scene) {
     ASSERT(!scene_exists(name));
@@ -101,6 +104,9 @@ struct GameSubtitle2DefinitionFile {
 };
 
 void parse_subtitle2_json(GameSubtitle2DB& db, const GameSubtitle2DefinitionFile& file_info);
+// parse all of the files, one thread per language.
+void parse_subtitle2_files(GameSubtitle2DB& db,
+                           const std::vector<GameSubtitle2DefinitionFile>& files);
 void open_subtitle2_project(const std::string& kind,
                             const std::string& filename,
                             std::vector<GameSubtitle2DefinitionFile>& inputs);
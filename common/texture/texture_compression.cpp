@@ -0,0 +1,322 @@
+#include "texture_compression.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace texture_compression {
+
+namespace {
+
+struct Rgba {
+  u8 c[4];
+};
+
+Rgba unpack(u32 px) {
+  Rgba result;
+  memcpy(result.c, &px, 4);
+  return result;
+}
+
+u32 pack(const Rgba& px) {
+  u32 result;
+  memcpy(&result, px.c, 4);
+  return result;
+}
+
+u16 to_565(const u8* c) {
+  u16 r = (c[0] * 31 + 127) / 255;
+  u16 g = (c[1] * 63 + 127) / 255;
+  u16 b = (c[2] * 31 + 127) / 255;
+  return (r << 11) | (g << 5) | b;
+}
+
+void from_565(u16 val, u8* c) {
+  u8 r = (val >> 11) & 31;
+  u8 g = (val >> 5) & 63;
+  u8 b = val & 31;
+  c[0] = (r << 3) | (r >> 2);
+  c[1] = (g << 2) | (g >> 4);
+  c[2] = (b << 3) | (b >> 2);
+}
+
+/*!
+ * Build the 4 (or 3 + transparent) color palette for a BC1 color block.
+ */
+void bc1_palette(u16 c0, u16 c1, bool force_four_color, Rgba* palette) {
+  from_565(c0, palette[0].c);
+  from_565(c1, palette[1].c);
+  palette[0].c[3] = 255;
+  palette[1].c[3] = 255;
+  palette[2].c[3] = 255;
+  palette[3].c[3] = 255;
+  if (c0 > c1 || force_four_color) {
+    for (int i = 0; i < 3; i++) {
+      palette[2].c[i] = (2 * palette[0].c[i] + palette[1].c[i]) / 3;
+      palette[3].c[i] = (palette[0].c[i] + 2 * palette[1].c[i]) / 3;
+    }
+  } else {
+    for (int i = 0; i < 3; i++) {
+      palette[2].c[i] = (palette[0].c[i] + palette[1].c[i]) / 2;
+      palette[3].c[i] = 0;
+    }
+    palette[3].c[3] = 0;
+  }
+}
+
+void bc3_alpha_palette(u8 a0, u8 a1, u8* palette) {
+  palette[0] = a0;
+  palette[1] = a1;
+  if (a0 > a1) {
+    for (int i = 1; i < 7; i++) {
+      palette[i + 1] = ((7 - i) * a0 + i * a1) / 7;
+    }
+  } else {
+    for (int i = 1; i < 5; i++) {
+      palette[i + 1] = ((5 - i) * a0 + i * a1) / 5;
+    }
+    palette[6] = 0;
+    palette[7] = 255;
+  }
+}
+
+/*!
+ * Load a 4x4 block, clamping to the edge of the texture for textures smaller than a block.
+ */
+void load_block(const u32* rgba, int w, int h, int bx, int by, Rgba* block) {
+  for (int y = 0; y < 4; y++) {
+    for (int x = 0; x < 4; x++) {
+      int sx = std::min(bx * 4 + x, w - 1);
+      int sy = std::min(by * 4 + y, h - 1);
+      block[y * 4 + x] = unpack(rgba[sy * w + sx]);
+    }
+  }
+}
+
+void encode_color_block(const Rgba* block, u8* out) {
+  // bounding box endpoints, inset a bit to reduce error.
+  u8 lo[3] = {255, 255, 255};
+  u8 hi[3] = {0, 0, 0};
+  for (int i = 0; i < 16; i++) {
+    for (int c = 0; c < 3; c++) {
+      lo[c] = std::min(lo[c], block[i].c[c]);
+      hi[c] = std::max(hi[c], block[i].c[c]);
+    }
+  }
+  for (int c = 0; c < 3; c++) {
+    int inset = (hi[c] - lo[c]) / 16;
+    lo[c] += inset;
+    hi[c] -= inset;
+  }
+
+  u16 c0 = to_565(hi);
+  u16 c1 = to_565(lo);
+  if (c0 < c1) {
+    std::swap(c0, c1);
+  }
+
+  u32 indices = 0;
+  if (c0 != c1) {
+    Rgba palette[4];
+    bc1_palette(c0, c1, true, palette);
+    for (int i = 0; i < 16; i++) {
+      int best_idx = 0;
+      int best_dist = INT32_MAX;
+      for (int p = 0; p < 4; p++) {
+        int dist = 0;
+        for (int c = 0; c < 3; c++) {
+          int diff = (int)block[i].c[c] - (int)palette[p].c[c];
+          dist += diff * diff;
+        }
+        if (dist < best_dist) {
+          best_dist = dist;
+          best_idx = p;
+        }
+      }
+      indices |= best_idx << (2 * i);
+    }
+  }
+
+  memcpy(out, &c0, 2);
+  memcpy(out + 2, &c1, 2);
+  memcpy(out + 4, &indices, 4);
+}
+
+void encode_alpha_block(const Rgba* block, u8* out) {
+  u8 a0 = 0;
+  u8 a1 = 255;
+  for (int i = 0; i < 16; i++) {
+    a0 = std::max(a0, block[i].c[3]);
+    a1 = std::min(a1, block[i].c[3]);
+  }
+
+  u64 indices = 0;
+  if (a0 != a1) {
+    u8 palette[8];
+    bc3_alpha_palette(a0, a1, palette);
+    for (int i = 0; i < 16; i++) {
+      int best_idx = 0;
+      int best_dist = INT32_MAX;
+      for (int p = 0; p < 8; p++) {
+        int dist = std::abs((int)block[i].c[3] - (int)palette[p]);
+        if (dist < best_dist) {
+          best_dist = dist;
+          best_idx = p;
+        }
+      }
+      indices |= ((u64)best_idx) << (3 * i);
+    }
+  }
+
+  out[0] = a0;
+  out[1] = a1;
+  memcpy(out + 2, &indices, 6);
+}
+
+void decode_color_block(const u8* in, bool force_four_color, Rgba* block) {
+  u16 c0, c1;
+  u32 indices;
+  memcpy(&c0, in, 2);
+  memcpy(&c1, in + 2, 2);
+  memcpy(&indices, in + 4, 4);
+  Rgba palette[4];
+  bc1_palette(c0, c1, force_four_color, palette);
+  for (int i = 0; i < 16; i++) {
+    block[i] = palette[(indices >> (2 * i)) & 3];
+  }
+}
+
+void decode_alpha_block(const u8* in, Rgba* block) {
+  u8 palette[8];
+  bc3_alpha_palette(in[0], in[1], palette);
+  u64 indices = 0;
+  memcpy(&indices, in + 2, 6);
+  for (int i = 0; i < 16; i++) {
+    block[i].c[3] = palette[(indices >> (3 * i)) & 7];
+  }
+}
+
+u32 block_bytes(tfrag3::TextureCompression format) {
+  switch (format) {
+    case tfrag3::TextureCompression::BC1:
+      return 8;
+    case tfrag3::TextureCompression::BC3:
+      return 16;
+    default:
+      ASSERT_NOT_REACHED();
+  }
+}
+
+/*!
+ * 2x2 box filter, like glGenerateMipmap.
+ */
+std::vector<u32> downsample(const std::vector<u32>& in, int w, int h) {
+  int out_w = std::max(1, w / 2);
+  int out_h = std::max(1, h / 2);
+  std::vector<u32> result(out_w * out_h);
+  for (int y = 0; y < out_h; y++) {
+    for (int x = 0; x < out_w; x++) {
+      int x0 = std::min(x * 2, w - 1);
+      int x1 = std::min(x * 2 + 1, w - 1);
+      int y0 = std::min(y * 2, h - 1);
+      int y1 = std::min(y * 2 + 1, h - 1);
+      Rgba samples[4] = {unpack(in[y0 * w + x0]), unpack(in[y0 * w + x1]),
+                         unpack(in[y1 * w + x0]), unpack(in[y1 * w + x1])};
+      Rgba out;
+      for (int c = 0; c < 4; c++) {
+        out.c[c] =
+            (samples[0].c[c] + samples[1].c[c] + samples[2].c[c] + samples[3].c[c] + 2) / 4;
+      }
+      result[y * out_w + x] = pack(out);
+    }
+  }
+  return result;
+}
+
+}  // namespace
+
+u32 level_size(tfrag3::TextureCompression format, int w, int h) {
+  return ((w + 3) / 4) * ((h + 3) / 4) * block_bytes(format);
+}
+
+std::vector<u8> compress_level(tfrag3::TextureCompression format, const u32* rgba, int w, int h) {
+  std::vector<u8> result(level_size(format, w, h));
+  u8* out = result.data();
+  Rgba block[16];
+  for (int by = 0; by < (h + 3) / 4; by++) {
+    for (int bx = 0; bx < (w + 3) / 4; bx++) {
+      load_block(rgba, w, h, bx, by, block);
+      if (format == tfrag3::TextureCompression::BC3) {
+        encode_alpha_block(block, out);
+        out += 8;
+      }
+      encode_color_block(block, out);
+      out += 8;
+    }
+  }
+  return result;
+}
+
+std::vector<u32> decompress_level(tfrag3::TextureCompression format, const u8* data, int w, int h) {
+  std::vector<u32> result(w * h);
+  Rgba block[16];
+  for (int by = 0; by < (h + 3) / 4; by++) {
+    for (int bx = 0; bx < (w + 3) / 4; bx++) {
+      if (format == tfrag3::TextureCompression::BC3) {
+        decode_color_block(data + 8, true, block);
+        decode_alpha_block(data, block);
+        data += 16;
+      } else {
+        decode_color_block(data, false, block);
+        data += 8;
+      }
+      for (int y = 0; y < 4; y++) {
+        for (int x = 0; x < 4; x++) {
+          int px = bx * 4 + x;
+          int py = by * 4 + y;
+          if (px < w && py < h) {
+            result[py * w + px] = pack(block[y * 4 + x]);
+          }
+        }
+      }
+    }
+  }
+  return result;
+}
+
+void compress_texture(tfrag3::Texture& tex) {
+  if (tex.load_to_pool || tex.compression != tfrag3::TextureCompression::NONE || tex.data.empty()) {
+    return;
+  }
+
+  bool opaque = std::all_of(tex.data.begin(), tex.data.end(),
+                            [](u32 px) { return (px >> 24) == 0xff; });
+  tex.compression = opaque ? tfrag3::TextureCompression::BC1 : tfrag3::TextureCompression::BC3;
+
+  std::vector<u32> level = std::move(tex.data);
+  tex.data.clear();
+  int w = tex.w;
+  int h = tex.h;
+  tex.num_mips = 0;
+  while (true) {
+    auto compressed = compress_level(tex.compression, level.data(), w, h);
+    tex.compressed_data.insert(tex.compressed_data.end(), compressed.begin(), compressed.end());
+    tex.num_mips++;
+    if (w == 1 && h == 1) {
+      break;
+    }
+    level = downsample(level, w, h);
+    w = std::max(1, w / 2);
+    h = std::max(1, h / 2);
+  }
+}
+
+std::vector<u32> texture_rgba(const tfrag3::Texture& tex) {
+  if (tex.compression == tfrag3::TextureCompression::NONE) {
+    std::vector<u32> result(tex.rgba_size_bytes() / sizeof(u32));
+    memcpy(result.data(), tex.rgba_bytes(), tex.rgba_size_bytes());
+    return result;
+  }
+  return decompress_level(tex.compression, tex.compressed_bytes(), tex.w, tex.h);
+}
+
+}  // namespace texture_compression
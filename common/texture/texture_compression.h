@@ -0,0 +1,37 @@
+#pragma once
+
+/*!
+ * @file texture_compression.h
+ * Simple BC1/BC3 (DXT1/DXT5) block compression for textures in .fr3 files.
+ * The encoder uses bounding-box endpoints, which is fast and good enough for PS2 resolution
+ * textures. There's also a decoder, for tools and for drivers without S3TC support.
+ */
+
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/custom_data/Tfrag3Data.h"
+
+namespace texture_compression {
+
+// size, in bytes, of a single mip level
+u32 level_size(tfrag3::TextureCompression format, int w, int h);
+
+// compress a single level of RGBA8888 data (R in the low byte).
+std::vector<u8> compress_level(tfrag3::TextureCompression format, const u32* rgba, int w, int h);
+
+// decompress a single level to RGBA8888.
+std::vector<u32> decompress_level(tfrag3::TextureCompression format, const u8* data, int w, int h);
+
+/*!
+ * Pick a format, generate mipmaps, and compress the texture. The RGBA data is removed.
+ * Textures that must be given to the texture pool are left alone, the pool needs RGBA data.
+ */
+void compress_texture(tfrag3::Texture& tex);
+
+/*!
+ * Get the full-resolution RGBA data of a texture, decompressing if needed.
+ */
+std::vector<u32> texture_rgba(const tfrag3::Texture& tex);
+
+}  // namespace texture_compression
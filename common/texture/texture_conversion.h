@@ -1,5 +1,9 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+
 #include "common/common_types.h"
 #include "common/util/Assert.h"
 
@@ -222,3 +226,207 @@ inline u32 rgba16_to_rgba32(u32 in) {
 enum class PSM { PSMCT32 = 0x0, PSMCT16 = 0x02, PSMT8 = 0x13, PSMT4 = 0x14 };
 // clut format enums
 enum class CPSM { PSMCT32 = 0x0, PSMCT16 = 0x02 };
+
+/*!
+ * The swizzles above only depend on the position within a page, and pages are laid out linearly.
+ * These tables hold the address within a page for each pixel, so converting a whole texture is a
+ * table lookup per pixel instead of recomputing the block and column layout each time.
+ */
+template <int W, int H>
+struct SwizzlePageTable {
+  static constexpr int width = W;
+  static constexpr int height = H;
+  u16 offset[H][W];
+};
+
+// PSMCT32 pages are 64x32 pixels, 8 kB. Offsets in bytes.
+inline const SwizzlePageTable<64, 32>& psmct32_page_table() {
+  static const auto table = []() {
+    SwizzlePageTable<64, 32> result;
+    for (int y = 0; y < 32; y++) {
+      for (int x = 0; x < 64; x++) {
+        result.offset[y][x] = psmct32_addr(x, y, 64);
+      }
+    }
+    return result;
+  }();
+  return table;
+}
+
+// PSMCT16 pages are 64x64 pixels, 8 kB. Offsets in bytes.
+inline const SwizzlePageTable<64, 64>& psmct16_page_table() {
+  static const auto table = []() {
+    SwizzlePageTable<64, 64> result;
+    for (int y = 0; y < 64; y++) {
+      for (int x = 0; x < 64; x++) {
+        result.offset[y][x] = psmct16_addr(x, y, 64);
+      }
+    }
+    return result;
+  }();
+  return table;
+}
+
+// PSMT8 pages are 128x64 pixels, 8 kB. Offsets in bytes.
+inline const SwizzlePageTable<128, 64>& psmt8_page_table() {
+  static const auto table = []() {
+    SwizzlePageTable<128, 64> result;
+    for (int y = 0; y < 64; y++) {
+      for (int x = 0; x < 128; x++) {
+        result.offset[y][x] = psmt8_addr(x, y, 128);
+      }
+    }
+    return result;
+  }();
+  return table;
+}
+
+// PSMT4 pages are 128x128 pixels, 8 kB. Offsets in half bytes.
+inline const SwizzlePageTable<128, 128>& psmt4_page_table() {
+  static const auto table = []() {
+    SwizzlePageTable<128, 128> result;
+    for (int y = 0; y < 128; y++) {
+      for (int x = 0; x < 128; x++) {
+        result.offset[y][x] = psmt4_addr_half_byte(x, y, 128);
+      }
+    }
+    return result;
+  }();
+  return table;
+}
+
+/*!
+ * Call fn(out_idx, addr) for every pixel of a w x h texture, where addr is what the matching
+ * psmXX_addr function returns for (x, y, width), plus base. Pixels are visited in output order.
+ */
+template <typename Table, typename Fn>
+inline void for_each_swizzled_pixel(const Table& table,
+                                    u32 page_size,
+                                    u32 base,
+                                    u32 w,
+                                    u32 h,
+                                    u32 width,
+                                    Fn&& fn) {
+  const u32 pages_per_row = width / Table::width;
+  u32 out_idx = 0;
+  for (u32 y = 0; y < h; y++) {
+    const u16* row = table.offset[y % Table::height];
+    const u32 row_base = base + (y / Table::height) * pages_per_row * page_size;
+    for (u32 x0 = 0; x0 < w; x0 += Table::width) {
+      const u32 page_base = row_base + (x0 / Table::width) * page_size;
+      const u32 end = std::min(w - x0, (u32)Table::width);
+      for (u32 x = 0; x < end; x++) {
+        fn(out_idx++, page_base + row[x]);
+      }
+    }
+  }
+}
+
+/*!
+ * rgba16_to_rgba32, with a table for the 5-bit channels.
+ */
+inline u32 rgba16_to_rgba32_table(u32 in) {
+  static const auto expand = []() {
+    std::array<u8, 32> result;
+    float ratio = 255.0 / 31.0;
+    for (u32 i = 0; i < 32; i++) {
+      result[i] = (u32)(i * ratio);
+    }
+    return result;
+  }();
+  u32 r = expand[in & 0b11111];
+  u32 g = expand[(in >> 5) & 0b11111];
+  u32 b = expand[(in >> 10) & 0b11111];
+  u32 a = (in & 0x8000) ? 0x80 : 0;
+  return (a << 24) | (b << 16) | (g << 8) | r;
+}
+
+/*!
+ * Read a CLUT from VRAM (CSM1) and convert it to RGBA8888. clut_base is in bytes.
+ * For 8-bit textures there are 256 entries, for 4-bit textures there are 16.
+ */
+inline void load_clut_rgba8888(u32* palette,
+                               const u8* vram,
+                               u32 clut_base,
+                               bool psmt4,
+                               bool psmct16) {
+  const int count = psmt4 ? 16 : 256;
+  for (int value = 0; value < count; value++) {
+    u32 clx, cly;
+    if (psmt4) {
+      // See GS manual 2.7.3 CLUT Storage Mode, IDTEX4 in CSM1 mode.
+      clx = value & 0x7;
+      cly = value >> 3;
+    } else {
+      // See GS manual 2.7.3 CLUT Storage Mode, IDTEX8 in CSM1 mode.
+      u32 clut_chunk = value / 16;
+      u32 off_in_chunk = value % 16;
+      clx = (clut_chunk & 1) ? 8 : 0;
+      cly = (clut_chunk >> 1) * 2;
+      if (off_in_chunk >= 8) {
+        off_in_chunk -= 8;
+        cly++;
+      }
+      clx += off_in_chunk;
+    }
+    if (psmct16) {
+      u16 clut_value;
+      memcpy(&clut_value, vram + psmct16_addr(clx, cly, 64) + clut_base, 2);
+      palette[value] = rgba16_to_rgba32_table(clut_value);
+    } else {
+      memcpy(&palette[value], vram + psmct32_addr(clx, cly, 64) + clut_base, 4);
+    }
+  }
+}
+
+/*!
+ * Convert a texture in VRAM to RGBA8888. tex_base is in 256 byte blocks, like TEX0 TBP0, and
+ * width is the buffer width in pixels. CLUT formats need a palette from load_clut_rgba8888.
+ * Returns false for unsupported formats.
+ */
+inline bool vram_to_rgba8888(u32* out,
+                             const u8* vram,
+                             u32 tex_base,
+                             u32 w,
+                             u32 h,
+                             u32 width,
+                             PSM psm,
+                             const u32* palette) {
+  constexpr u32 PAGE_BYTES = 8192;
+  switch (psm) {
+    case PSM::PSMT8:
+      for_each_swizzled_pixel(psmt8_page_table(), PAGE_BYTES, tex_base * 256, w, h, width,
+                              [&](u32 i, u32 addr) { out[i] = palette[vram[addr]]; });
+      return true;
+    case PSM::PSMT4:
+      // half byte addressing
+      for_each_swizzled_pixel(psmt4_page_table(), PAGE_BYTES * 2, tex_base * 512, w, h, width,
+                              [&](u32 i, u32 addr) {
+                                u8 value = vram[addr / 2];
+                                out[i] = palette[(addr & 1) ? (value >> 4) : (value & 0x0f)];
+                              });
+      return true;
+    case PSM::PSMCT16:
+      for_each_swizzled_pixel(psmct16_page_table(), PAGE_BYTES, tex_base * 256, w, h, width,
+                              [&](u32 i, u32 addr) {
+                                u16 value;
+                                memcpy(&value, vram + addr, 2);
+                                out[i] = rgba16_to_rgba32_table(value);
+                              });
+      return true;
+    case PSM::PSMCT32:
+      for_each_swizzled_pixel(psmct32_page_table(), PAGE_BYTES, tex_base * 256, w, h, width,
+                              [&](u32 i, u32 addr) { memcpy(&out[i], vram + addr, 4); });
+      return true;
+    default:
+      return false;
+  }
+}
+
+/*!
+ * Copy w x h words to VRAM as PSMCT32, the way textures are uploaded. dest is in words.
+ */
+inline void upload_psmct32(u8* vram, const u32* data, u32 dest, u32 w, u32 h) {
+  for_each_swizzled_pixel(psmct32_page_table(), 8192, dest * 4, w, h, w,
+                          [&](u32 i, u32 addr) { memcpy(vram + addr, &data[i], 4); });
+}
@@ -9,6 +9,7 @@
 
 #include "common/log/log.h"
 #include "common/util/Assert.h"
+#include "common/util/Serializer.h"
 
 #include "third-party/fmt/core.h"
 
@@ -30,6 +31,37 @@ std::string reg_kind_to_string(RegClass kind) {
 
 }  // namespace
 
+void DefinitionMetadata::serialize(Serializer& ser) {
+  bool has_info = definition_info.has_value();
+  ser.from_ptr(&has_info);
+  if (ser.is_loading()) {
+    definition_info = has_info ? std::optional(goos::TextDb::ShortInfo()) : std::nullopt;
+  }
+  if (has_info) {
+    ser.from_str(&definition_info->filename);
+    ser.from_ptr(&definition_info->line_idx_to_display);
+    ser.from_ptr(&definition_info->pos_in_line);
+    ser.from_str(&definition_info->line_text);
+  }
+  ser.from_optional_str(&docstring);
+}
+
+void serialize_handler_metadata(Serializer& ser,
+                                std::unordered_map<std::string, DefinitionMetadata>* metadata) {
+  ser.from_string_map(metadata, [](Serializer& s, DefinitionMetadata* m) { m->serialize(s); });
+}
+
+void MethodInfo::serialize(Serializer& ser) {
+  ser.from_ptr(&id);
+  ser.from_str(&name);
+  type.serialize(ser);
+  ser.from_str(&defined_in_type);
+  ser.from_ptr(&no_virtual);
+  ser.from_ptr(&overrides_parent);
+  ser.from_ptr(&only_overrides_docstring);
+  ser.from_optional_str(&docstring);
+}
+
 /*!
  * Compare method for equality. This is used to determine if a new method declaration would
  * modify the existing type information.
@@ -138,6 +170,20 @@ bool Field::operator==(const Field& other) const {
   // clang-format on
 }
 
+void Field::serialize(Serializer& ser) {
+  ser.from_str(&m_name);
+  m_type.serialize(ser);
+  ser.from_ptr(&m_offset);
+  ser.from_ptr(&m_inline);
+  ser.from_ptr(&m_dynamic);
+  ser.from_ptr(&m_array);
+  ser.from_ptr(&m_array_size);
+  ser.from_ptr(&m_alignment);
+  ser.from_ptr(&m_skip_in_static_decomp);
+  ser.from_ptr(&m_placed_by_user);
+  ser.from_ptr(&m_field_score);
+}
+
 std::string Field::diff(const Field& other) const {
   std::string result;
   if (m_name != other.m_name) {
@@ -466,6 +512,23 @@ void Type::add_state(const std::string& name, const TypeSpec& type) {
   }
 }
 
+void Type::serialize(Serializer& ser) {
+  ser.from_vector(&m_methods, [](Serializer& s, MethodInfo* m) { m->serialize(s); });
+  ser.from_string_map(&m_states, [](Serializer& s, TypeSpec* ts) { ts->serialize(s); });
+  m_new_method_info.serialize(ser);
+  ser.from_ptr(&m_new_method_info_defined);
+  ser.from_ptr(&m_generate_inspect);
+  ser.from_str(&m_parent);
+  ser.from_str(&m_name);
+  ser.from_ptr(&m_allow_in_runtime);
+  ser.from_str(&m_runtime_name);
+  ser.from_ptr(&m_is_boxed);
+  ser.from_ptr(&m_heap_base);
+  m_metadata.serialize(ser);
+  ser.from_string_map(&m_virtual_state_definition_meta, serialize_handler_metadata);
+  ser.from_string_map(&m_state_definition_meta, serialize_handler_metadata);
+}
+
 std::string Type::incompatible_diff(const Type& other) const {
   return fmt::format("diff is not implemented between {} and {}\n", typeid((*this)).name(),
                      typeid(other).name());
@@ -627,6 +690,14 @@ int ValueType::get_inline_array_start_alignment() const {
   return m_size;
 }
 
+void ValueType::serialize(Serializer& ser) {
+  Type::serialize(ser);
+  ser.from_ptr(&m_size);
+  ser.from_ptr(&m_offset);
+  ser.from_ptr(&m_sign_extend);
+  ser.from_ptr(&m_reg_kind);
+}
+
 /*!
  * Inherit settings from a parent. User-defined types will pick the appropriate parent to get
  * the settings they want.
@@ -747,6 +818,18 @@ StructureType::StructureType(std::string parent,
       m_dynamic(dynamic),
       m_pack(pack) {}
 
+void StructureType::serialize(Serializer& ser) {
+  Type::serialize(ser);
+  ser.from_vector(&m_fields, [](Serializer& s, Field* f) { f->serialize(s); });
+  ser.from_ptr(&m_dynamic);
+  ser.from_ptr(&m_size_in_mem);
+  ser.from_ptr(&m_pack);
+  ser.from_ptr(&m_allow_misalign);
+  ser.from_ptr(&m_offset);
+  ser.from_ptr(&m_always_stack_singleton);
+  ser.from_ptr(&m_idx_of_first_unique_field);
+}
+
 std::string StructureType::print() const {
   std::string result = fmt::format(
       "[StructureType] {}\n parent: {}\n boxed: {}\n dynamic: {}\n size: {}\n pack: {}\n misalign: "
@@ -920,6 +1003,11 @@ bool StructureType::lookup_field(const std::string& name, Field* out) {
 BasicType::BasicType(std::string parent, std::string name, bool dynamic, int heap_base)
     : StructureType(std::move(parent), std::move(name), true, dynamic, false, heap_base) {}
 
+void BasicType::serialize(Serializer& ser) {
+  StructureType::serialize(ser);
+  ser.from_ptr(&m_final);
+}
+
 std::string BasicType::print() const {
   std::string result = fmt::format(
       "[BasicType] {}\n parent: {}\n dynamic: {}\n size: {}\n heap-base: {}\n fields:\n", m_name,
@@ -1032,6 +1120,11 @@ std::string BitField::diff(const BitField& other) const {
 BitFieldType::BitFieldType(std::string parent, std::string name, int size, bool sign_extend)
     : ValueType(std::move(parent), std::move(name), false, size, sign_extend, RegClass::GPR_64) {}
 
+void BitFieldType::serialize(Serializer& ser) {
+  ValueType::serialize(ser);
+  ser.from_vector(&m_fields, [](Serializer& s, BitField* f) { f->serialize(s); });
+}
+
 bool BitFieldType::lookup_field(const std::string& name, BitField* out) const {
   for (auto& field : m_fields) {
     if (field.name() == name) {
@@ -1042,6 +1135,14 @@ bool BitFieldType::lookup_field(const std::string& name, BitField* out) const {
   return false;
 }
 
+void BitField::serialize(Serializer& ser) {
+  m_type.serialize(ser);
+  ser.from_str(&m_name);
+  ser.from_ptr(&m_offset);
+  ser.from_ptr(&m_size);
+  ser.from_ptr(&m_skip_in_static_decomp);
+}
+
 std::string BitField::print() const {
   return fmt::format("[{} {}] sz {} off {}", name(), type().print(), size(), offset());
 }
@@ -1121,6 +1222,12 @@ EnumType::EnumType(const ValueType* parent,
       m_is_bitfield(is_bitfield),
       m_entries(entries) {}
 
+void EnumType::serialize(Serializer& ser) {
+  ValueType::serialize(ser);
+  ser.from_ptr(&m_is_bitfield);
+  ser.from_string_map(&m_entries, [](Serializer& s, s64* value) { s.from_ptr(value); });
+}
+
 std::string EnumType::print() const {
   return fmt::format("Enum Type {}", m_name);
 }
@@ -15,14 +15,21 @@
 #include "common/goos/TextDB.h"
 #include "common/util/Assert.h"
 
+class Serializer;
 class TypeSystem;
 
 // Various metadata that can be associated with a symbol or form
 struct DefinitionMetadata {
   std::optional<goos::TextDb::ShortInfo> definition_info;
   std::optional<std::string> docstring;
+
+  void serialize(Serializer& ser);
 };
 
+// {handler : doc}
+void serialize_handler_metadata(Serializer& ser,
+                                std::unordered_map<std::string, DefinitionMetadata>* metadata);
+
 struct MethodInfo {
   int id = -1;
   std::string name;
@@ -37,6 +44,7 @@ struct MethodInfo {
   bool operator!=(const MethodInfo& other) const { return !((*this) == other); }
   std::string print_one_line() const;
   std::string diff(const MethodInfo& other) const;
+  void serialize(Serializer& ser);
 };
 
 /*!
@@ -75,6 +83,9 @@ class Type {
   // print some information for debugging
   virtual std::string print() const = 0;
 
+  // save or load everything about this type. The TypeSystem writes which class it is.
+  virtual void serialize(Serializer& ser);
+
   bool operator!=(const Type& other) const { return !(*this == other); }
 
   bool common_type_info_equal(const Type& other) const;
@@ -187,6 +198,7 @@ class ValueType : public Type {
   std::string print() const override;
   bool operator==(const Type& other) const override;
   std::string diff_impl(const Type& other) const override;
+  void serialize(Serializer& ser) override;
   ~ValueType() = default;
   void inherit(const ValueType* parent);
 
@@ -236,6 +248,7 @@ class Field {
   bool operator==(const Field& other) const;
   bool operator!=(const Field& other) const { return !((*this) == other); }
   std::string diff(const Field& other) const;
+  void serialize(Serializer& ser);
 
   int alignment() const {
     ASSERT(m_alignment != -1);
@@ -285,6 +298,7 @@ class StructureType : public ReferenceType {
   bool operator==(const Type& other) const override;
   std::string diff_impl(const Type& other) const override;
   std::string diff_structure_common(const StructureType& other) const;
+  void serialize(Serializer& ser) override;
   int get_size_in_memory() const override;
   int get_offset() const override;
   int get_in_memory_alignment() const override;
@@ -337,6 +351,7 @@ class BasicType : public StructureType {
   ~BasicType() = default;
   bool operator==(const Type& other) const override;
   std::string diff_impl(const Type& other) const override;
+  void serialize(Serializer& ser) override;
 
  protected:
   bool m_final = false;
@@ -355,6 +370,7 @@ class BitField {
   bool operator!=(const BitField& other) const { return !((*this) == other); }
   std::string diff(const BitField& other) const;
   std::string print() const;
+  void serialize(Serializer& ser);
 
  private:
   TypeSpec m_type;
@@ -373,6 +389,7 @@ class BitFieldType : public ValueType {
   const std::vector<BitField>& fields() const { return m_fields; }
   std::string diff_impl(const Type& other) const override;
   void set_gen_inspect(bool gen_inspect) { m_generate_inspect = gen_inspect; }
+  void serialize(Serializer& ser) override;
 
  private:
   friend class TypeSystem;
@@ -390,6 +407,7 @@ class EnumType : public ValueType {
   const std::unordered_map<std::string, s64>& entries() const { return m_entries; }
   bool is_bitfield() const { return m_is_bitfield; }
   std::string diff_impl(const Type& other) const override;
+  void serialize(Serializer& ser) override;
 
  private:
   friend class TypeSystem;
@@ -7,6 +7,8 @@
 
 #include <stdexcept>
 
+#include "common/util/Serializer.h"
+
 #include "third-party/fmt/core.h"
 
 bool TypeTag::operator==(const TypeTag& other) const {
@@ -136,3 +138,20 @@ void TypeSpec::add_or_modify_tag(const std::string& tag_name, const std::string&
   }
   m_tags.push_back({tag_name, tag_value});
 }
+
+void TypeSpec::serialize(Serializer& ser) {
+  ser.from_str(&m_type);
+  size_t num_args = arg_count();
+  ser.from_ptr(&num_args);
+  if (ser.is_loading()) {
+    delete m_arguments;
+    m_arguments = num_args ? new std::vector<TypeSpec>(num_args) : nullptr;
+  }
+  for (size_t i = 0; i < num_args; i++) {
+    (*m_arguments)[i].serialize(ser);
+  }
+  ser.from_vector(&m_tags, [](Serializer& s, TypeTag* tag) {
+    s.from_str(&tag->name);
+    s.from_str(&tag->value);
+  });
+}
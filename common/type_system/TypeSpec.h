@@ -12,6 +12,8 @@
 #include "common/util/Assert.h"
 #include "common/util/SmallVector.h"
 
+class Serializer;
+
 /*!
  * A :name value modifier to apply to a type.
  */
@@ -66,6 +68,27 @@ class TypeSpec {
     return *this;
   }
 
+  // moves just steal the argument list, so passing TypeSpecs around by value doesn't deep copy.
+  TypeSpec(TypeSpec&& other) noexcept
+      : m_type(std::move(other.m_type)),
+        m_arguments(other.m_arguments),
+        m_tags(std::move(other.m_tags)) {
+    other.m_arguments = nullptr;
+  }
+
+  TypeSpec& operator=(TypeSpec&& other) noexcept {
+    if (this == &other) {
+      return *this;
+    }
+
+    delete m_arguments;
+    m_type = std::move(other.m_type);
+    m_arguments = other.m_arguments;
+    m_tags = std::move(other.m_tags);
+    other.m_arguments = nullptr;
+    return *this;
+  }
+
   ~TypeSpec() { delete m_arguments; }
 
   //  TypeSpec(const std::string& type, const std::vector<TypeTag>& tags)
@@ -149,6 +172,8 @@ class TypeSpec {
 
   const std::vector<TypeTag>& tags() const { return m_tags; }
 
+  void serialize(Serializer& ser);
+
  private:
   friend class TypeSystem;
   std::string m_type;
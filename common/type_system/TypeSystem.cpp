@@ -12,6 +12,7 @@
 
 #include "common/log/log.h"
 #include "common/util/Assert.h"
+#include "common/util/Serializer.h"
 #include "common/util/math_util.h"
 
 #include "third-party/fmt/color.h"
@@ -30,6 +31,52 @@ template <typename... Args>
   throw std::runtime_error(
       fmt::format("Type Error: {}", fmt::format(str, std::forward<Args>(args)...)));
 }
+
+// which class a serialized type is, so it can be constructed before it's loaded.
+enum class SerializedTypeKind : u8 { NONE, VALUE, STRUCTURE, BASIC, BITFIELD, ENUM };
+
+SerializedTypeKind serialized_type_kind(const Type* type) {
+  // children first, they can be cast to their parents.
+  if (dynamic_cast<const EnumType*>(type)) {
+    return SerializedTypeKind::ENUM;
+  } else if (dynamic_cast<const BitFieldType*>(type)) {
+    return SerializedTypeKind::BITFIELD;
+  } else if (dynamic_cast<const ValueType*>(type)) {
+    return SerializedTypeKind::VALUE;
+  } else if (dynamic_cast<const BasicType*>(type)) {
+    return SerializedTypeKind::BASIC;
+  } else if (dynamic_cast<const StructureType*>(type)) {
+    return SerializedTypeKind::STRUCTURE;
+  } else if (dynamic_cast<const NullType*>(type)) {
+    return SerializedTypeKind::NONE;
+  }
+  throw std::runtime_error("Can't serialize type " + type->get_name());
+}
+
+/*!
+ * Make a type of the given kind. The arguments don't matter, everything is overwritten when it's
+ * loaded.
+ */
+std::unique_ptr<Type> make_type_to_load(SerializedTypeKind kind) {
+  switch (kind) {
+    case SerializedTypeKind::NONE:
+      return std::make_unique<NullType>("");
+    case SerializedTypeKind::VALUE:
+      return std::make_unique<ValueType>("", "", false, 0, false, RegClass::GPR_64);
+    case SerializedTypeKind::STRUCTURE:
+      return std::make_unique<StructureType>("", "", false, false, false, 0);
+    case SerializedTypeKind::BASIC:
+      return std::make_unique<BasicType>("", "", false, 0);
+    case SerializedTypeKind::BITFIELD:
+      return std::make_unique<BitFieldType>("", "", 0, false);
+    case SerializedTypeKind::ENUM: {
+      ValueType parent("", "", false, 0, false, RegClass::GPR_64);
+      return std::make_unique<EnumType>(&parent, "", false, std::unordered_map<std::string, s64>());
+    }
+    default:
+      throw std::runtime_error("Invalid serialized type kind");
+  }
+}
 }  // namespace
 
 TypeSystem::TypeSystem() {
@@ -74,6 +121,12 @@ Type* TypeSystem::add_type(const std::string& name, std::unique_ptr<Type> type)
 
         // update the type
         m_types[name] = std::move(type);
+
+        // the old type may be in the chain of any type, so redo them all.
+        m_parent_chains.clear();
+        for (const auto& [type_name, type_info] : m_types) {
+          update_parent_chain(type_name);
+        }
       } else {
         throw_typesystem_error(
             "Inconsistent type definition. Type {} was originally\n{}\nand is redefined "
@@ -99,6 +152,7 @@ Type* TypeSystem::add_type(const std::string& name, std::unique_ptr<Type> type)
     }
 
     m_types[name] = std::move(type);
+    update_parent_chain(name);
     auto fwd_it = m_forward_declared_types.find(name);
     if (fwd_it != m_forward_declared_types.end()) {
       // need to check parent is correct.
@@ -417,6 +471,81 @@ TypeSpec TypeSystem::make_inline_array_typespec(const TypeSpec& type) const {
   return TypeSpec("inline-array", {type});
 }
 
+/*!
+ * Remember the parents of a fully defined type. If a parent isn't fully defined, the type doesn't
+ * get a chain, and lookups walk up the tree by name instead.
+ */
+void TypeSystem::update_parent_chain(const std::string& name) {
+  ParentChain chain;
+  chain.type = m_types.at(name).get();
+  const Type* type = chain.type;
+  while (type->has_parent()) {
+    auto it = m_types.find(type->get_parent());
+    if (it == m_types.end()) {
+      m_parent_chains.erase(name);
+      return;
+    }
+    type = it->second.get();
+    chain.parents.push_back(type);
+  }
+  m_parent_chains[name] = std::move(chain);
+}
+
+/*!
+ * Get the parents of a type, or nullptr if it doesn't have a chain. Types that have been redefined
+ * don't have one.
+ */
+const std::vector<const Type*>* TypeSystem::try_get_parent_chain(const Type* type) const {
+  auto it = m_parent_chains.find(type->get_name());
+  if (it == m_parent_chains.end() || it->second.type != type) {
+    return nullptr;
+  }
+  return &it->second.parents;
+}
+
+/*!
+ * Save or load the types, forward declarations and redefinition settings. This is everything that
+ * deftype, defenum and declare-type add, so a loaded type system doesn't need to parse them again.
+ * Types that were redefined aren't saved, only their latest definition.
+ */
+void TypeSystem::serialize(Serializer& ser) {
+  if (ser.is_saving()) {
+    ser.save<size_t>(m_types.size());
+    for (auto& [name, type] : m_types) {
+      ser.save<SerializedTypeKind>(serialized_type_kind(type.get()));
+      ser.save_str(&name);
+      type->serialize(ser);
+    }
+  } else {
+    // keep the old types, in case somebody has a pointer to one.
+    for (auto& [name, type] : m_types) {
+      m_old_types.push_back(std::move(type));
+    }
+    m_types.clear();
+    m_parent_chains.clear();
+    size_t count = ser.load<size_t>();
+    for (size_t i = 0; i < count; i++) {
+      auto type = make_type_to_load(ser.load<SerializedTypeKind>());
+      auto name = ser.load_string();
+      type->serialize(ser);
+      m_types[name] = std::move(type);
+    }
+    // only once all are loaded, parents may come after their children.
+    for (const auto& [type_name, type_info] : m_types) {
+      update_parent_chain(type_name);
+    }
+    m_forward_declared_types.clear();
+    m_forward_declared_method_counts.clear();
+  }
+
+  ser.from_string_map(&m_forward_declared_types,
+                      [](Serializer& s, std::string* parent) { s.from_str(parent); });
+  ser.from_string_map(&m_forward_declared_method_counts,
+                      [](Serializer& s, int* count) { s.from_ptr(count); });
+  ser.from_string_vector(&m_types_allowed_to_be_redefined);
+  ser.from_ptr(&m_allow_redefinition);
+}
+
 /*!
  * Get full type information. Throws if the type doesn't exist. If the given type is redefined after
  * a call to lookup_type, the Type* will still be valid, but will point to the old data. Whenever
@@ -706,23 +835,8 @@ MethodInfo TypeSystem::lookup_method(const std::string& type_name,
   }
 
   MethodInfo info;
-
-  // first lookup the type
-  auto* type = lookup_type(type_name);
-
-  auto* iter_type = type;
-  // look up the method
-  while (true) {
-    if (iter_type->get_my_method(method_name, &info)) {
-      return info;
-    }
-
-    if (iter_type->has_parent()) {
-      iter_type = lookup_type(iter_type->get_parent());
-    } else {
-      // couldn't find method.
-      break;
-    }
+  if (try_lookup_method(lookup_type(type_name), method_name, &info)) {
+    return info;
   }
 
   throw_typesystem_error("The method {} of type {} could not be found.\n", method_name, type_name);
@@ -756,24 +870,32 @@ bool TypeSystem::try_lookup_method(const std::string& type_name,
     return false;
   }
 
-  auto* iter_type = kv->second.get();
-  // look up the method
-  while (true) {
+  auto try_type = [&](const Type* type) {
     if (method_id == GOAL_NEW_METHOD) {
-      if (iter_type->get_my_new_method(info)) {
-        return true;
-      }
+      return type->get_my_new_method(info);
     } else {
-      if (iter_type->get_my_method(method_id, info)) {
+      return type->get_my_method(method_id, info);
+    }
+  };
+
+  auto* iter_type = kv->second.get();
+  if (try_type(iter_type)) {
+    return true;
+  }
+  if (auto* chain = try_get_parent_chain(iter_type)) {
+    for (auto* parent : *chain) {
+      if (try_type(parent)) {
         return true;
       }
     }
+    return false;
+  }
 
-    if (iter_type->has_parent()) {
-      iter_type = lookup_type(iter_type->get_parent());
-    } else {
-      // couldn't find method.
-      break;
+  // look up the method
+  while (iter_type->has_parent()) {
+    iter_type = lookup_type(iter_type->get_parent());
+    if (try_type(iter_type)) {
+      return true;
     }
   }
   return false;
@@ -782,23 +904,32 @@ bool TypeSystem::try_lookup_method(const std::string& type_name,
 bool TypeSystem::try_lookup_method(const Type* type,
                                    const std::string& method_name,
                                    MethodInfo* info) const {
-  // look up the method
-  while (true) {
-    if (method_name == "new") {
-      if (type->get_my_new_method(info)) {
-        return true;
-      }
+  const bool is_new = method_name == "new";
+  auto try_type = [&](const Type* t) {
+    if (is_new) {
+      return t->get_my_new_method(info);
     } else {
-      if (type->get_my_method(method_name, info)) {
+      return t->get_my_method(method_name, info);
+    }
+  };
+
+  if (try_type(type)) {
+    return true;
+  }
+  if (auto* chain = try_get_parent_chain(type)) {
+    for (auto* parent : *chain) {
+      if (try_type(parent)) {
         return true;
       }
     }
+    return false;
+  }
 
-    if (type->has_parent()) {
-      type = lookup_type(type->get_parent());
-    } else {
-      // couldn't find method.
-      break;
+  // look up the method
+  while (type->has_parent()) {
+    type = lookup_type(type->get_parent());
+    if (try_type(type)) {
+      return true;
     }
   }
   return false;
@@ -815,22 +946,10 @@ MethodInfo TypeSystem::lookup_method(const std::string& type_name, int method_id
 
   MethodInfo info;
 
-  // first lookup the type
-  auto* type = lookup_type(type_name);
-
-  auto* iter_type = type;
-  // look up the method
-  while (true) {
-    if (iter_type->get_my_method(method_id, &info)) {
-      return info;
-    }
-
-    if (iter_type->has_parent()) {
-      iter_type = lookup_type(iter_type->get_parent());
-    } else {
-      // couldn't find method.
-      break;
-    }
+  // first lookup the type, so this throws if it doesn't exist.
+  lookup_type(type_name);
+  if (try_lookup_method(type_name, method_id, &info)) {
+    return info;
   }
 
   throw_typesystem_error("The method with id {} of type {} could not be found.", method_id,
@@ -1620,47 +1739,62 @@ bool TypeSystem::typecheck_and_throw(const TypeSpec& expected,
 bool TypeSystem::typecheck_base_types(const std::string& input_expected,
                                       const std::string& input_actual,
                                       bool allow_alias) const {
-  std::string expected = input_expected;
-  std::string actual = input_actual;
+  // this is called a lot, so avoid copying the names.
+  static const std::string float_name = "float";
+  static const std::string time_frame_name = "time-frame";
+  static const std::string int_name = "int";
+  const std::string* expected_ptr = &input_expected;
+  const std::string* actual_ptr = &input_actual;
 
   // the unit types aren't picky.
-  if (expected == "meters") {
-    expected = "float";
+  if (*expected_ptr == "meters") {
+    expected_ptr = &float_name;
   }
 
-  if (expected == "seconds") {
-    expected = "time-frame";
+  if (*expected_ptr == "seconds") {
+    expected_ptr = &time_frame_name;
   }
 
-  if (actual == "seconds") {
-    actual = "time-frame";
+  if (*actual_ptr == "seconds") {
+    actual_ptr = &time_frame_name;
   }
 
-  if (expected == "degrees") {
-    expected = "float";
+  if (*expected_ptr == "degrees") {
+    expected_ptr = &float_name;
   }
 
   // the decompiler prefers no aliasing so it can detect casts properly
   if (allow_alias) {
-    if (expected == "time-frame") {
-      expected = "int";
+    if (*expected_ptr == "time-frame") {
+      expected_ptr = &int_name;
     }
 
-    if (actual == "time-frame") {
-      actual = "int";
+    if (*actual_ptr == "time-frame") {
+      actual_ptr = &int_name;
     }
   }
 
+  const std::string& expected = *expected_ptr;
+  const std::string& actual = *actual_ptr;
+
   // just to make sure it exists.
   lookup_type_allow_partial_def(expected);
 
-  if (expected == actual || expected == lookup_type_allow_partial_def(actual)->get_name()) {
-    lookup_type_allow_partial_def(actual);  // make sure it exists
+  auto actual_type = lookup_type_allow_partial_def(actual);
+  if (expected == actual || expected == actual_type->get_name()) {
     return true;
   }
 
+  if (auto* chain = try_get_parent_chain(actual_type)) {
+    for (auto* parent : *chain) {
+      if (parent->get_name() == expected) {
+        return true;
+      }
+    }
+    return false;
+  }
+
   std::string actual_name = actual;
-  auto actual_type = lookup_type_allow_partial_def(actual_name);
   while (actual_type->has_parent()) {
     actual_name = actual_type->get_parent();
     actual_type = lookup_type_allow_partial_def(actual_name);
@@ -1689,7 +1823,18 @@ EnumType* TypeSystem::try_enum_lookup(const TypeSpec& type) const {
  * Get a path from type to object.
  */
 std::vector<std::string> TypeSystem::get_path_up_tree(const std::string& type) const {
-  auto parent = lookup_type_allow_partial_def(type)->get_parent();
+  auto* type_info = lookup_type_allow_partial_def(type);
+  if (auto* chain = try_get_parent_chain(type_info)) {
+    std::vector<std::string> path = {type};
+    for (auto* parent : *chain) {
+      path.push_back(parent->get_name());
+    }
+    if (path.size() > 1) {
+      return path;
+    }
+  }
+
+  auto parent = type_info->get_parent();
   std::vector<std::string> path = {type};
   path.push_back(parent);
   auto parent_type = lookup_type_allow_partial_def(parent);
@@ -1715,6 +1860,27 @@ std::string TypeSystem::lca_base(const std::string& a, const std::string& b) con
     return "none";
   }
 
+  // for fully defined types, compare the chains without building the paths.
+  auto* a_type = lookup_type_allow_partial_def(a);
+  auto* b_type = lookup_type_allow_partial_def(b);
+  auto* a_chain = try_get_parent_chain(a_type);
+  auto* b_chain = try_get_parent_chain(b_type);
+  if (a_chain && b_chain && !a_chain->empty() && !b_chain->empty() && a_type->get_name() == a &&
+      b_type->get_name() == b) {
+    auto a_at = [&](int i) { return i == 0 ? a_type : a_chain->at(i - 1); };
+    auto b_at = [&](int i) { return i == 0 ? b_type : b_chain->at(i - 1); };
+    int ai = a_chain->size();
+    int bi = b_chain->size();
+    const Type* result = nullptr;
+    while (ai >= 0 && bi >= 0 && a_at(ai) == b_at(bi)) {
+      result = a_at(ai);
+      ai--;
+      bi--;
+    }
+    ASSERT(result);
+    return result->get_name();
+  }
+
   auto a_up = get_path_up_tree(a);
   auto b_up = get_path_up_tree(b);
 
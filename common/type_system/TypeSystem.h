@@ -220,6 +220,9 @@ class TypeSystem {
 
   void add_builtin_types(GameVersion version);
 
+  // save or load all types and forward declarations. Loading replaces all types in this.
+  void serialize(Serializer& ser);
+
   std::string print_all_type_information() const;
   bool typecheck_and_throw(const TypeSpec& expected,
                            const TypeSpec& actual,
@@ -308,8 +311,18 @@ class TypeSystem {
                                     bool sign_extend = false,
                                     RegClass reg = RegClass::GPR_64);
   void builtin_structure_inherit(StructureType* st);
+  void update_parent_chain(const std::string& name);
+  const std::vector<const Type*>* try_get_parent_chain(const Type* type) const;
 
   std::unordered_map<std::string, std::unique_ptr<Type>> m_types;
+  // for each fully defined type, its parents from the closest up to object. Typechecks and method
+  // lookups walk up the tree a lot, and this saves looking up each parent by name. These are built
+  // in add_type, so lookups from multiple threads don't have to lock anything.
+  struct ParentChain {
+    const Type* type = nullptr;
+    std::vector<const Type*> parents;
+  };
+  std::unordered_map<std::string, ParentChain> m_parent_chains;
   std::unordered_map<std::string, std::string> m_forward_declared_types;
   std::unordered_map<std::string, int> m_forward_declared_method_counts;
 
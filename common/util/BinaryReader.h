@@ -3,6 +3,7 @@
 /*!
  * @file BinaryReader.h
  * Read raw data like a stream.
+ * The reader doesn't copy the data, so the data must outlive the reader.
  */
 
 #include <cstdint>
@@ -14,28 +15,32 @@
 
 class BinaryReader {
  public:
-  explicit BinaryReader(const std::vector<uint8_t>& _buffer) : m_buffer(_buffer) {}
+  explicit BinaryReader(const std::vector<uint8_t>& _buffer)
+      : BinaryReader(_buffer.data(), _buffer.size()) {}
+  explicit BinaryReader(std::vector<uint8_t>&& _buffer) = delete;
+  BinaryReader(const u8* data, size_t size) : m_data(data), m_size(size) {}
 
   template <typename T>
   T read() {
-    ASSERT(m_seek + sizeof(T) <= m_buffer.size());
+    ASSERT(m_seek + sizeof(T) <= m_size);
     T obj;
-    memcpy(&obj, m_buffer.data() + m_seek, sizeof(T));
+    memcpy(&obj, m_data + m_seek, sizeof(T));
     m_seek += sizeof(T);
     return obj;
   }
 
   void ffwd(int amount) {
     m_seek += amount;
-    ASSERT(m_seek <= m_buffer.size());
+    ASSERT(m_seek <= m_size);
   }
 
-  uint32_t bytes_left() const { return m_buffer.size() - m_seek; }
-  uint8_t* here() { return m_buffer.data() + m_seek; }
+  uint32_t bytes_left() const { return m_size - m_seek; }
+  const uint8_t* here() const { return m_data + m_seek; }
   uint32_t get_seek() const { return m_seek; }
   void set_seek(u32 seek) { m_seek = seek; }
 
  private:
-  std::vector<u8> m_buffer;
+  const u8* m_data = nullptr;
+  size_t m_size = 0;
   uint32_t m_seek = 0;
 };
@@ -1,6 +1,5 @@
 #include "DgoReader.h"
 
-#include <cstring>
 #include <unordered_set>
 #include <utility>
 
@@ -12,9 +11,34 @@
 
 #include "third-party/json.hpp"
 
-DgoReader::DgoReader(std::string file_name, const std::vector<u8>& data)
+DgoFileData::DgoFileData(const fs::path& path) {
+  m_file = std::make_unique<file_util::MappedFile>(path);
+  m_file_size = m_file->size();
+  if (file_util::dgo_header_is_compressed(m_file->data(), m_file->size())) {
+    m_decompressed = file_util::decompress_dgo(m_file->data(), m_file->size());
+    m_file.reset();
+    m_data = m_decompressed.data();
+    m_size = m_decompressed.size();
+  } else {
+    // all of the objects will be read, so start reading the file in now.
+    m_file->prefetch();
+    m_data = m_file->data();
+    m_size = m_file->size();
+  }
+}
+
+DgoReader::DgoReader(std::string file_name, const u8* data, size_t size)
     : m_file_name(std::move(file_name)) {
-  BinaryReader reader(data);
+  read_entries(data, size);
+}
+
+DgoReader::DgoReader(const fs::path& path)
+    : m_file(std::make_unique<DgoFileData>(path)), m_file_name(path.filename().string()) {
+  read_entries(m_file->data(), m_file->size());
+}
+
+void DgoReader::read_entries(const u8* data, size_t size) {
+  BinaryReader reader(data, size);
   auto header = reader.read<DgoHeader>();
   m_internal_name = header.name;
   std::unordered_set<std::string> all_unique_names;
@@ -46,11 +70,10 @@ DgoReader::DgoReader(std::string file_name, const std::vector<u8>& data)
     }
 
     all_unique_names.insert(entry.unique_name);
-    entry.data.resize(obj_header.size);
-
     ASSERT((reader.get_seek() % 16) == 0);
-    memcpy(entry.data.data(), reader.here(), obj_header.size);
-    m_entries.push_back(entry);
+    entry.data = reader.here();
+    entry.size = obj_header.size;
+    m_entries.push_back(std::move(entry));
 
     reader.ffwd(align16(obj_header.size));
   }
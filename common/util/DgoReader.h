@@ -1,23 +1,60 @@
 #pragma once
 
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "common/common_types.h"
+#include "common/util/FileUtil.h"
+#include "common/util/MappedFile.h"
 
+/*!
+ * The contents of a DGO file. An uncompressed DGO is memory mapped instead of being read, so its
+ * objects can be used in place. A compressed DGO is decompressed into memory.
+ */
+class DgoFileData {
+ public:
+  explicit DgoFileData(const fs::path& path);
+
+  const u8* data() const { return m_data; }
+  size_t size() const { return m_size; }
+  size_t file_size() const { return m_file_size; }
+  bool was_compressed() const { return !m_decompressed.empty(); }
+
+ private:
+  std::unique_ptr<file_util::MappedFile> m_file;
+  std::vector<u8> m_decompressed;
+  const u8* m_data = nullptr;
+  size_t m_size = 0;
+  size_t m_file_size = 0;
+};
+
+/*!
+ * An object in a DGO. The data isn't copied: it points into the data the DgoReader was made from.
+ */
 struct DgoDataEntry {
-  std::vector<u8> data;
+  const u8* data = nullptr;
+  size_t size = 0;
   std::string internal_name;
   std::string unique_name;
 };
 
 class DgoReader {
  public:
-  DgoReader(std::string file_name, const std::vector<u8>& data);
-  const std::vector<DgoDataEntry> entries() const { return m_entries; }
+  DgoReader(std::string file_name, const u8* data, size_t size);
+  DgoReader(std::string file_name, const std::vector<u8>& data)
+      : DgoReader(std::move(file_name), data.data(), data.size()) {}
+  DgoReader(std::string file_name, std::vector<u8>&& data) = delete;
+  // map (or decompress) the DGO file at path. The entries stay valid as long as the reader.
+  explicit DgoReader(const fs::path& path);
+
+  const std::vector<DgoDataEntry>& entries() const { return m_entries; }
+  const DgoFileData* file() const { return m_file.get(); }
   std::string description_as_json() const;
 
  private:
+  void read_entries(const u8* data, size_t size);
+  std::unique_ptr<DgoFileData> m_file;
   std::vector<DgoDataEntry> m_entries;
   std::string m_internal_name, m_file_name;
-};
\ No newline at end of file
+};
@@ -5,30 +5,86 @@
 
 #include "DgoWriter.h"
 
-#include "BinaryWriter.h"
+#include <stdexcept>
+
 #include "FileUtil.h"
+#include "MappedFile.h"
 
 void build_dgo(const DgoDescription& description, const std::string& output_prefix) {
-  BinaryWriter writer;
-  // dgo header
-  writer.add<uint32_t>(description.entries.size());
-  writer.add_cstr_len(description.dgo_name.c_str(), 60);
+  DgoFileWriter writer(
+      file_util::get_jak_project_dir() / "out" / output_prefix / "iso" / description.dgo_name,
+      description.dgo_name, description.entries.size());
 
   for (auto& obj : description.entries) {
-    auto obj_data = file_util::read_binary_file(file_util::get_jak_project_dir() / "out" /
-                                                output_prefix / "obj" / obj.file_name);
-    // size
-    writer.add<uint32_t>(obj_data.size());
-    // name
-    writer.add_str_len(obj.name_in_dgo, 60);
-    // data
-    writer.add_data(obj_data.data(), obj_data.size());
-    // pad
-    while (writer.get_size() & 0xf) {
-      writer.add<uint8_t>(0);
-    }
-  }
-
-  writer.write_to_file(file_util::get_jak_project_dir() / "out" / output_prefix / "iso" /
-                       description.dgo_name);
+    file_util::MappedFile obj_data(file_util::get_jak_project_dir() / "out" / output_prefix /
+                                   "obj" / obj.file_name);
+    writer.add_object(obj.name_in_dgo, obj_data.data(), obj_data.size());
+  }
+  writer.finish();
+}
+
+DgoFileWriter::DgoFileWriter(const fs::path& path, const std::string& dgo_name, u32 object_count)
+    : m_path(path), m_objects_left(object_count) {
+  m_fp = file_util::open_file(path.string().c_str(), "wb");
+  if (!m_fp) {
+    throw std::runtime_error("failed to open " + path.string());
+  }
+  // dgo header
+  write(&object_count, sizeof(u32));
+  write_name(dgo_name, 60);
+}
+
+DgoFileWriter::~DgoFileWriter() {
+  if (m_fp) {
+    fclose(m_fp);
+  }
+}
+
+void DgoFileWriter::add_object(const std::string& name_in_dgo,
+                               const void* data,
+                               u32 size,
+                               u32 size_in_header) {
+  if (!m_objects_left) {
+    throw std::runtime_error("too many objects for " + m_path.string());
+  }
+  m_objects_left--;
+  // size
+  write(&size_in_header, sizeof(u32));
+  // name
+  write_name(name_in_dgo, 60);
+  // data
+  write(data, size);
+  // pad
+  static const u8 zeros[16] = {0};
+  write(zeros, (16 - (m_size & 15)) & 15);
+}
+
+void DgoFileWriter::finish() {
+  if (m_objects_left) {
+    throw std::runtime_error("missing objects for " + m_path.string());
+  }
+  FILE* fp = m_fp;
+  m_fp = nullptr;
+  if (fclose(fp) != 0) {
+    throw std::runtime_error("failed to write " + m_path.string());
+  }
+}
+
+void DgoFileWriter::write(const void* data, size_t size) {
+  if (size && fwrite(data, size, 1, m_fp) != 1) {
+    throw std::runtime_error("failed to write " + m_path.string());
+  }
+  m_size += size;
+}
+
+/*!
+ * Write a name padded with zeros to len bytes. Like BinaryWriter::add_str_len, a longer name isn't
+ * cut off.
+ */
+void DgoFileWriter::write_name(const std::string& name, size_t len) {
+  write(name.data(), name.size());
+  static const char zeros[64] = {0};
+  if (name.size() < len) {
+    write(zeros, len - name.size());
+  }
 }
@@ -5,9 +5,13 @@
  * Create a DGO from existing files.
  */
 
+#include <cstdio>
 #include <string>
 #include <vector>
 
+#include "common/common_types.h"
+#include "common/util/FileUtil.h"
+
 struct DgoDescription {
   std::string dgo_name;
   struct DgoEntry {
@@ -18,3 +22,33 @@ struct DgoDescription {
 };
 
 void build_dgo(const DgoDescription& description, const std::string& output_prefix);
+
+/*!
+ * Writes a DGO file as objects are added, so the whole DGO is never in memory.
+ * Throws std::runtime_error if the file can't be written.
+ */
+class DgoFileWriter {
+ public:
+  DgoFileWriter(const fs::path& path, const std::string& dgo_name, u32 object_count);
+  ~DgoFileWriter();
+  DgoFileWriter(const DgoFileWriter&) = delete;
+  DgoFileWriter& operator=(const DgoFileWriter&) = delete;
+
+  // add the next object. The size in the object's header is usually the size of the data, but some
+  // tools store the size padded to 16 bytes.
+  void add_object(const std::string& name_in_dgo, const void* data, u32 size, u32 size_in_header);
+  void add_object(const std::string& name_in_dgo, const void* data, u32 size) {
+    add_object(name_in_dgo, data, size, size);
+  }
+  // close the file, after checking that all of the objects were added.
+  void finish();
+
+ private:
+  void write(const void* data, size_t size);
+  void write_name(const std::string& name, size_t len);
+
+  fs::path m_path;
+  FILE* m_fp = nullptr;
+  u32 m_objects_left = 0;
+  size_t m_size = 0;
+};
@@ -283,7 +283,17 @@ void write_binary_file(const std::string& name, const void* data, size_t size) {
   write_binary_file(fs::path(name), data, size);
 }
 
+namespace {
+void init_fpng() {
+  // fpng only uses its SSE crc32 and adler32 paths after it has checked the CPU. PNGs may be
+  // written from several threads, and a static local is initialized once and thread safe.
+  static const bool fpng_initialized = (fpng::fpng_init(), true);
+  (void)fpng_initialized;
+}
+}  // namespace
+
 void write_rgba_png(const fs::path& name, void* data, int w, int h) {
+  init_fpng();
   auto flags = 0;
 
   auto ok = fpng::fpng_encode_image_to_file(name.string().c_str(), data, w, h, 4, flags);
@@ -293,6 +303,27 @@ void write_rgba_png(const fs::path& name, void* data, int w, int h) {
   }
 }
 
+std::vector<u8> encode_rgba_png(const void* data, int w, int h) {
+  init_fpng();
+  std::vector<u8> result;
+  if (!fpng::fpng_encode_image_to_memory(data, w, h, 4, result)) {
+    throw std::runtime_error(fmt::format("couldn't encode {}x{} png", w, h));
+  }
+  return result;
+}
+
+bool read_rgba_png(const fs::path& name, std::vector<u8>* data, int* w, int* h) {
+  init_fpng();
+  u32 width, height, channels;
+  if (fpng::fpng_decode_file(name.string().c_str(), *data, width, height, channels, 4) !=
+      fpng::FPNG_DECODE_SUCCESS) {
+    return false;
+  }
+  *w = width;
+  *h = height;
+  return true;
+}
+
 void write_text_file(const std::string& file_name, const std::string& text) {
   write_text_file(fs::path(file_name), text);
 }
@@ -588,22 +619,33 @@ void assert_file_exists(const char* path, const char* error_message) {
  * Check if the given DGO header (or entire file) is compressed.
  */
 bool dgo_header_is_compressed(const std::vector<u8>& data) {
+  return dgo_header_is_compressed(data.data(), data.size());
+}
+
+bool dgo_header_is_compressed(const u8* data, size_t size) {
   const char compressed_header[] = "oZlB";
+  if (size < 4) {
+    return false;
+  }
   bool is_compressed = true;
   for (int i = 0; i < 4; i++) {
-    if (compressed_header[i] != data.at(i)) {
+    if (compressed_header[i] != data[i]) {
       is_compressed = false;
     }
   }
   return is_compressed;
 }
 
+std::vector<u8> decompress_dgo(const std::vector<u8>& data_in) {
+  return decompress_dgo(data_in.data(), data_in.size());
+}
+
 /*!
  * Decompress a DGO. Resulting data will start at the DGO header.
  */
-std::vector<u8> decompress_dgo(const std::vector<u8>& data_in) {
+std::vector<u8> decompress_dgo(const u8* data_in, size_t size) {
   constexpr int MAX_CHUNK_SIZE = 0x8000;
-  BinaryReader compressed_reader(data_in);
+  BinaryReader compressed_reader(data_in, size);
   // seek past oZlB
   compressed_reader.ffwd(4);
   std::size_t decompressed_size = compressed_reader.read<uint32_t>();
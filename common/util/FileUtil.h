@@ -33,6 +33,7 @@ fs::path get_user_settings_dir(GameVersion game_version);
 fs::path get_user_memcard_dir(GameVersion game_version);
 fs::path get_user_misc_dir(GameVersion game_version);
 fs::path get_jak_project_dir();
+std::string get_current_executable_path();
 
 bool create_dir_if_needed(const fs::path& path);
 bool create_dir_if_needed_for_file(const std::string& path);
@@ -43,6 +44,9 @@ std::string get_file_path(const std::vector<std::string>& path);
 void write_binary_file(const std::string& name, const void* data, size_t size);
 void write_binary_file(const fs::path& name, const void* data, size_t size);
 void write_rgba_png(const fs::path& name, void* data, int w, int h);
+std::vector<u8> encode_rgba_png(const void* data, int w, int h);
+// only for pngs written by write_rgba_png. False if the file can't be read.
+bool read_rgba_png(const fs::path& name, std::vector<u8>* data, int* w, int* h);
 void write_text_file(const std::string& file_name, const std::string& text);
 void write_text_file(const fs::path& file_name, const std::string& text);
 std::vector<uint8_t> read_binary_file(const std::string& filename);
@@ -60,7 +64,9 @@ void MakeISOName(char* dst, const char* src);
 void ISONameFromAnimationName(char* dst, const char* src);
 void assert_file_exists(const char* path, const char* error_message);
 bool dgo_header_is_compressed(const std::vector<u8>& data);
+bool dgo_header_is_compressed(const u8* data, size_t size);
 std::vector<u8> decompress_dgo(const std::vector<u8>& data_in);
+std::vector<u8> decompress_dgo(const u8* data_in, size_t size);
 FILE* open_file(const fs::path& path, const std::string& mode);
 std::vector<fs::path> find_files_recursively(const fs::path& base_dir, const std::regex& pattern);
 std::vector<fs::path> find_directories_in_dir(const fs::path& base_dir);
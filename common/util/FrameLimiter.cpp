@@ -1,9 +1,18 @@
 #include "FrameLimiter.h"
 
+#include <algorithm>
+#include <cmath>
 #include <thread>
 
 #include "common/common_types.h"
 
+namespace {
+// limits for how early we wake up from sleeps. A sleep that was very late shouldn't make us spin
+// for most of the frame.
+constexpr double MIN_SLEEP_MARGIN = 0.00005;
+constexpr double MAX_SLEEP_MARGIN = 0.004;
+}  // namespace
+
 double FrameLimiter::round_to_nearest_60fps(double current) {
   double one_frame = 1.f / 60.f;
   int frames_missed = (current / one_frame);  // rounds down
@@ -13,12 +22,6 @@ double FrameLimiter::round_to_nearest_60fps(double current) {
   return (frames_missed + 1) * one_frame;
 }
 
-#ifdef OS_POSIX
-
-FrameLimiter::FrameLimiter() {}
-
-FrameLimiter::~FrameLimiter() {}
-
 void FrameLimiter::run(double target_fps,
                        bool experimental_accurate_lag,
                        bool do_sleeps,
@@ -29,17 +32,99 @@ void FrameLimiter::run(double target_fps,
   } else {
     target_seconds = 1.f / target_fps;
   }
-  double remaining_time = target_seconds - m_timer.getSeconds();
+  m_period = std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<double>(target_seconds));
 
-  if (do_sleeps && remaining_time > 0.001) {
-    std::this_thread::sleep_for(std::chrono::microseconds(int((remaining_time - 0.001) * 1e6)));
+  auto now = Clock::now();
+  if (!m_have_deadline) {
+    m_deadline = now;
+    m_have_deadline = true;
+  }
+  m_deadline += m_period;
+  if (now >= m_deadline) {
+    // start over from now, instead of rushing the next frames to catch up.
+    m_missed_deadlines++;
+    m_deadline = now;
+    return;
   }
+  wait_until(m_deadline, do_sleeps);
+}
 
-  while (remaining_time > 0) {
-    remaining_time = target_seconds - m_timer.getSeconds();
+void FrameLimiter::wait_until(Clock::time_point deadline, bool do_sleeps) {
+  if (do_sleeps) {
+    double margin = std::clamp(m_overshoot_avg + 3 * std::sqrt(m_overshoot_var), MIN_SLEEP_MARGIN,
+                               MAX_SLEEP_MARGIN);
+    auto before = Clock::now();
+    auto sleep_time = deadline - before -
+                      std::chrono::duration_cast<Clock::duration>(
+                          std::chrono::duration<double>(margin));
+    if (sleep_time > Clock::duration::zero()) {
+      sleep_for(sleep_time);
+      // update the estimate of how late the OS wakes us up.
+      double overshoot =
+          std::chrono::duration<double>(Clock::now() - before - sleep_time).count();
+      overshoot = std::clamp(overshoot, 0., MAX_SLEEP_MARGIN);
+      double diff = overshoot - m_overshoot_avg;
+      m_overshoot_avg += 0.1 * diff;
+      m_overshoot_var = 0.9 * (m_overshoot_var + 0.1 * diff * diff);
+    }
   }
 
-  m_timer.start();
+  while (Clock::now() < deadline) {
+  }
+}
+
+void FrameLimiter::frame_presented() {
+  auto now = Clock::now();
+  if (m_have_present) {
+    m_present_intervals[m_present_idx++] =
+        std::chrono::duration<double, std::milli>(now - m_last_present).count();
+    if (m_present_idx == SIZE) {
+      m_present_idx = 0;
+    }
+    m_present_count = std::min(m_present_count + 1, SIZE);
+  }
+  m_last_present = now;
+  m_have_present = true;
+
+  // if presenting blocked for a while, it was waiting for vsync and the frame went out now. Count
+  // the next frame from here, so we don't wait for it a second time.
+  if (m_have_deadline && now - m_deadline > m_period / 4) {
+    m_deadline = now;
+  }
+}
+
+FrameLimiter::Stats FrameLimiter::stats() const {
+  Stats result;
+  result.missed_deadlines = m_missed_deadlines;
+  result.sleep_margin_ms = 1000 * std::clamp(m_overshoot_avg + 3 * std::sqrt(m_overshoot_var),
+                                             MIN_SLEEP_MARGIN, MAX_SLEEP_MARGIN);
+  if (!m_present_count) {
+    return result;
+  }
+  double total = 0;
+  for (int i = 0; i < m_present_count; i++) {
+    total += m_present_intervals[i];
+    result.worst_ms = std::max(result.worst_ms, m_present_intervals[i]);
+  }
+  result.avg_ms = total / m_present_count;
+  double variance = 0;
+  for (int i = 0; i < m_present_count; i++) {
+    double diff = m_present_intervals[i] - result.avg_ms;
+    variance += diff * diff;
+  }
+  result.jitter_ms = std::sqrt(variance / m_present_count);
+  return result;
+}
+
+#ifdef OS_POSIX
+
+FrameLimiter::FrameLimiter() {}
+
+FrameLimiter::~FrameLimiter() {}
+
+void FrameLimiter::sleep_for(Clock::duration duration) {
+  std::this_thread::sleep_for(duration);
 }
 
 #else
@@ -47,35 +132,38 @@ void FrameLimiter::run(double target_fps,
 #define NOMINMAX
 #include <Windows.h>
 
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
 FrameLimiter::FrameLimiter() {
   timeBeginPeriod(1);
+  // high resolution timers wake up within a fraction of a millisecond, instead of the 1 ms timer
+  // period. Only on Windows 10 1803 and later, otherwise we use Sleep.
+  m_waitable_timer = CreateWaitableTimerExW(nullptr, nullptr,
+                                            CREATE_WAITABLE_TIMER_HIGH_RESOLUTION,
+                                            TIMER_ALL_ACCESS);
 }
 
 FrameLimiter::~FrameLimiter() {
-  timeEndPeriod(0);
-}
-
-void FrameLimiter::run(double target_fps,
-                       bool experimental_accurate_lag,
-                       bool do_sleeps,
-                       double engine_time) {
-  double target_seconds;
-  if (experimental_accurate_lag) {
-    target_seconds = round_to_nearest_60fps(engine_time);
-  } else {
-    target_seconds = 1.f / target_fps;
-  }
-  double remaining_time = target_seconds - m_timer.getSeconds();
-
-  if (do_sleeps && remaining_time > 0.001) {
-    Sleep((remaining_time * 1000) - 1);
+  if (m_waitable_timer) {
+    CloseHandle(m_waitable_timer);
   }
+  timeEndPeriod(1);
+}
 
-  while (remaining_time > 0) {
-    remaining_time = target_seconds - m_timer.getSeconds();
+void FrameLimiter::sleep_for(Clock::duration duration) {
+  if (m_waitable_timer) {
+    LARGE_INTEGER due_time;
+    // negative is relative, in units of 100 ns.
+    due_time.QuadPart =
+        -(LONGLONG)(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count() / 100);
+    if (SetWaitableTimerEx(m_waitable_timer, &due_time, 0, nullptr, nullptr, nullptr, 0)) {
+      WaitForSingleObject(m_waitable_timer, INFINITE);
+      return;
+    }
   }
-
-  m_timer.start();
+  Sleep((DWORD)std::chrono::duration_cast<std::chrono::milliseconds>(duration).count());
 }
 
 #endif
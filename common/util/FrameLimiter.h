@@ -1,16 +1,62 @@
 #pragma once
 
-#include "common/util/Timer.h"
+#include <chrono>
 
+/*!
+ * Paces frames to a target frame rate. Each frame has a deadline one period after the last one,
+ * so a frame that finishes early doesn't make the next one early too. The wait sleeps for as long
+ * as the OS has been reliably waking us up on time, then spins for the rest.
+ */
 class FrameLimiter {
  public:
+  struct Stats {
+    double avg_ms = 0;
+    // standard deviation of the time between presents.
+    double jitter_ms = 0;
+    double worst_ms = 0;
+    // frames that weren't ready by their deadline.
+    int missed_deadlines = 0;
+    // how early we wake up from sleeping, to make up for the OS waking us up late.
+    double sleep_margin_ms = 0;
+  };
+
   FrameLimiter();
   ~FrameLimiter();
+  FrameLimiter(const FrameLimiter&) = delete;
+  FrameLimiter& operator=(const FrameLimiter&) = delete;
 
   void run(double target_fps, bool experimental_accurate_lag, bool do_sleeps, double engine_time);
+  // call after the frame is presented (buffers are swapped), for the stats and so that waiting for
+  // vsync isn't waited for again.
+  void frame_presented();
+  // stats of the last SIZE presents.
+  Stats stats() const;
+
+  static constexpr int SIZE = 240;
 
  private:
+  using Clock = std::chrono::steady_clock;
+
   double round_to_nearest_60fps(double current);
+  void wait_until(Clock::time_point deadline, bool do_sleeps);
+  void sleep_for(Clock::duration duration);
+
+  Clock::time_point m_deadline;
+  Clock::duration m_period{};
+  bool m_have_deadline = false;
+
+  // estimate of how late sleeps end, in seconds.
+  double m_overshoot_avg = 0.001;
+  double m_overshoot_var = 0;
+
+  Clock::time_point m_last_present;
+  bool m_have_present = false;
+  double m_present_intervals[SIZE] = {0};
+  int m_present_idx = 0;
+  int m_present_count = 0;
+  int m_missed_deadlines = 0;
 
-  Timer m_timer;
-};
\ No newline at end of file
+#ifdef _WIN32
+  void* m_waitable_timer = nullptr;
+#endif
+};
@@ -0,0 +1,132 @@
+#include "FuzzyIndex.h"
+
+#include <algorithm>
+
+namespace {
+char lower(char c) {
+  return (c >= 'A' && c <= 'Z') ? c - 'A' + 'a' : c;
+}
+
+bool is_word_separator(char c) {
+  switch (c) {
+    case '-':
+    case '_':
+    case '!':
+    case '?':
+    case '*':
+    case ':':
+    case '/':
+    case '.':
+    case '>':
+      return true;
+    default:
+      return false;
+  }
+}
+}  // namespace
+
+FuzzyIndex::FuzzyIndex(std::vector<std::string> names) : m_names(std::move(names)) {
+  m_masks.reserve(m_names.size());
+  for (auto& name : m_names) {
+    m_masks.push_back(char_mask(name));
+  }
+}
+
+/*!
+ * A bit for each letter and digit, and the other characters share the rest. If a name is missing
+ * a bit of the query, it can't match.
+ */
+u64 FuzzyIndex::char_mask(std::string_view str) {
+  u64 mask = 0;
+  for (char c : str) {
+    c = lower(c);
+    if (c >= 'a' && c <= 'z') {
+      mask |= 1ull << (c - 'a');
+    } else if (c >= '0' && c <= '9') {
+      mask |= 1ull << (26 + c - '0');
+    } else {
+      mask |= 1ull << (36 + (u8)c % 28);
+    }
+  }
+  return mask;
+}
+
+std::optional<int> FuzzyIndex::score(std::string_view query, std::string_view name) {
+  if (query.size() > name.size()) {
+    return std::nullopt;
+  }
+
+  // match each character of the query to the first one after the last match.
+  int result = 0;
+  size_t pos = 0;
+  size_t first_match = 0;
+  size_t last_match = 0;
+  for (size_t qi = 0; qi < query.size(); qi++) {
+    char q = lower(query[qi]);
+    while (pos < name.size() && lower(name[pos]) != q) {
+      pos++;
+    }
+    if (pos == name.size()) {
+      return std::nullopt;
+    }
+    if (qi == 0) {
+      first_match = pos;
+    }
+
+    result += 1;
+    if (pos == 0) {
+      result += 8;
+    } else if (is_word_separator(name[pos - 1])) {
+      result += 6;
+    }
+    if (qi > 0 && last_match + 1 == pos) {
+      result += 4;  // consecutive
+    }
+    last_match = pos;
+    pos++;
+  }
+
+  if (first_match == 0 && pos == query.size()) {
+    result += query.size() == name.size() ? 100 : 50;
+  }
+  // prefer matches near the start, and names that aren't much longer than the query.
+  result -= (int)std::min<size_t>(first_match, 8);
+  result -= (int)((name.size() - query.size()) / 4);
+  return result;
+}
+
+std::vector<FuzzyIndex::Match> FuzzyIndex::search(std::string_view query,
+                                                  size_t max_results,
+                                                  bool* truncated) const {
+  const u64 query_mask = char_mask(query);
+  std::vector<Match> matches;
+  for (size_t i = 0; i < m_names.size(); i++) {
+    if (query_mask & ~m_masks[i]) {
+      continue;
+    }
+    auto s = score(query, m_names[i]);
+    if (s) {
+      matches.push_back({(int)i, *s});
+    }
+  }
+
+  if (truncated) {
+    *truncated = matches.size() > max_results;
+  }
+  // best score, then the shortest name, then the name, so results don't change from run to run.
+  auto better = [&](const Match& a, const Match& b) {
+    if (a.score != b.score) {
+      return a.score > b.score;
+    }
+    const auto& name_a = m_names[a.idx];
+    const auto& name_b = m_names[b.idx];
+    if (name_a.size() != name_b.size()) {
+      return name_a.size() < name_b.size();
+    }
+    return name_a < name_b;
+  };
+  size_t count = std::min(max_results, matches.size());
+  std::partial_sort(matches.begin(), matches.begin() + count, matches.end(), better);
+  matches.resize(count);
+  return matches;
+}
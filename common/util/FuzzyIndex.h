@@ -0,0 +1,55 @@
+#pragma once
+
+/*!
+ * @file FuzzyIndex.h
+ * Fuzzy search over a fixed list of names, for completion.
+ */
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "common/common_types.h"
+
+/*!
+ * Finds the names that contain the characters of a query in order, like "dmi" for "draw-model-id",
+ * ranked so prefixes and matches at the start of words come first.
+ *
+ * Each name keeps a bitmask of the characters in it, so most names are rejected with one AND
+ * before any of their characters are looked at. Searching tens of thousands of names takes well
+ * under a millisecond.
+ */
+class FuzzyIndex {
+ public:
+  struct Match {
+    int idx = -1;  // into the names the index was built from
+    int score = 0;
+  };
+
+  FuzzyIndex() = default;
+  explicit FuzzyIndex(std::vector<std::string> names);
+
+  /*!
+   * The best matches, best first, at most max_results of them. If there were more,
+   * truncated is set.
+   */
+  std::vector<Match> search(std::string_view query,
+                            size_t max_results,
+                            bool* truncated = nullptr) const;
+
+  const std::string& name(int idx) const { return m_names.at(idx); }
+  size_t size() const { return m_names.size(); }
+
+  /*!
+   * How well the query matches the name, or nothing if it doesn't. Higher is better.
+   * Case is ignored.
+   */
+  static std::optional<int> score(std::string_view query, std::string_view name);
+
+ private:
+  static u64 char_mask(std::string_view str);
+
+  std::vector<std::string> m_names;
+  std::vector<u64> m_masks;
+};
@@ -0,0 +1,112 @@
+#include "MappedFile.h"
+
+#include <cstring>
+#include <stdexcept>
+
+#include "third-party/fmt/core.h"
+
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace file_util {
+
+#ifdef _WIN32
+MappedFile::MappedFile(const fs::path& path) {
+  HANDLE file = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    throw std::runtime_error(fmt::format("File {} cannot be opened", path.string()));
+  }
+  m_file = file;
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size)) {
+    CloseHandle(file);
+    throw std::runtime_error(fmt::format("File {} size could not be read", path.string()));
+  }
+  m_size = size.QuadPart;
+  if (m_size == 0) {
+    return;
+  }
+
+  HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (!mapping) {
+    CloseHandle(file);
+    throw std::runtime_error(fmt::format("File {} cannot be mapped", path.string()));
+  }
+  m_mapping = mapping;
+  m_data = (const u8*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (!m_data) {
+    CloseHandle(mapping);
+    CloseHandle(file);
+    throw std::runtime_error(fmt::format("File {} cannot be mapped", path.string()));
+  }
+}
+
+void MappedFile::prefetch() const {
+  // PrefetchVirtualMemory needs Windows 8, so this is left as a hint we don't act on.
+}
+
+MappedFile::~MappedFile() {
+  if (m_data) {
+    UnmapViewOfFile(m_data);
+  }
+  if (m_mapping) {
+    CloseHandle(m_mapping);
+  }
+  if (m_file) {
+    CloseHandle(m_file);
+  }
+}
+#else
+MappedFile::MappedFile(const fs::path& path) {
+  int fd = open(path.string().c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error(
+        fmt::format("File {} cannot be opened: {}", path.string(), strerror(errno)));
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    close(fd);
+    throw std::runtime_error(
+        fmt::format("File {} size could not be read: {}", path.string(), strerror(errno)));
+  }
+  m_size = st.st_size;
+  if (m_size == 0) {
+    close(fd);
+    return;
+  }
+
+  void* mem = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // the mapping stays valid after the file is closed.
+  close(fd);
+  if (mem == MAP_FAILED) {
+    throw std::runtime_error(
+        fmt::format("File {} cannot be mapped: {}", path.string(), strerror(errno)));
+  }
+  m_data = (const u8*)mem;
+}
+
+void MappedFile::prefetch() const {
+  if (m_data) {
+    madvise((void*)m_data, m_size, MADV_WILLNEED);
+  }
+}
+
+MappedFile::~MappedFile() {
+  if (m_data) {
+    munmap((void*)m_data, m_size);
+  }
+}
+#endif
+
+}  // namespace file_util
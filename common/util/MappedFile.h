@@ -0,0 +1,44 @@
+#pragma once
+
+/*!
+ * @file MappedFile.h
+ * Read-only memory mapped file.
+ */
+
+#include <cstddef>
+
+#include "common/common_types.h"
+#include "common/util/FileUtil.h"
+
+namespace file_util {
+
+/*!
+ * A read-only view of a file, mapped into memory. Pages are only read from disk when touched, so
+ * this is a good way to read a few parts of a big file without holding a copy of the whole thing.
+ * Throws std::runtime_error if the file can't be opened or mapped.
+ */
+class MappedFile {
+ public:
+  explicit MappedFile(const fs::path& path);
+  ~MappedFile();
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  const u8* data() const { return m_data; }
+  size_t size() const { return m_size; }
+
+  /*!
+   * Hint that the whole file will be read soon, so the OS can start reading it in the background.
+   */
+  void prefetch() const;
+
+ private:
+  const u8* m_data = nullptr;
+  size_t m_size = 0;
+#ifdef _WIN32
+  void* m_file = nullptr;
+  void* m_mapping = nullptr;
+#endif
+};
+
+}  // namespace file_util
@@ -1,12 +1,29 @@
 #pragma once
 
 #include <cstring>
+#include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
 #include "common/common_types.h"
 #include "common/util/Assert.h"
 
+/*!
+ * A read-only array of T that was loaded without copying. It points into the buffer of the
+ * Serializer that loaded it, and keeps that buffer alive. The data may not be aligned for T, so
+ * it is only available as bytes.
+ */
+template <typename T>
+struct PodView {
+  const u8* bytes = nullptr;
+  size_t count = 0;
+  std::shared_ptr<const std::vector<u8>> buffer;
+
+  bool empty() const { return count == 0; }
+  size_t size_bytes() const { return count * sizeof(T); }
+};
+
 /*!
  * The Serializer is a tool to load or save data from a buffer.
  * It's currently used to save graphics dumps, but could also be used for savestates in the future.
@@ -29,6 +46,9 @@
  * Methods like "from_ptr" can work in either save or load mode, and will work in either.
  * In general, you can only use most of these on POD, and saving more complicated data structures
  * requires special handling.
+ *
+ * A serializer constructed from a std::vector<u8>&& loads without copying the buffer, and with
+ * allow_views, large arrays can be loaded as PodViews that point into it.
  */
 class Serializer {
  public:
@@ -52,6 +72,18 @@ class Serializer {
     memcpy(m_data, data, size);
   }
 
+  /*!
+   * Construct a serializer that reads from the given data, which is moved in instead of copied.
+   * If allow_views is set, from_pod_vector_or_view loads into views of the data.
+   */
+  Serializer(std::vector<u8>&& data, bool allow_views)
+      : m_buffer(std::make_shared<const std::vector<u8>>(std::move(data))),
+        m_allow_views(allow_views) {
+    m_data = const_cast<u8*>(m_buffer->data());
+    m_size = m_buffer->size();
+    m_writing = false;
+  }
+
   // don't allow copying, assigning, or move constructing.
   Serializer(const Serializer& other) = delete;
   Serializer& operator=(const Serializer& other) = delete;
@@ -63,10 +95,15 @@ class Serializer {
       return *this;
     }
 
+    if (!m_buffer) {
+      free(m_data);
+    }
     m_data = other.m_data;
     m_size = other.m_size;
     m_offset = other.m_offset;
     m_writing = other.m_writing;
+    m_buffer = std::move(other.m_buffer);
+    m_allow_views = other.m_allow_views;
 
     other.m_data = nullptr;
     other.m_size = 0;
@@ -74,7 +111,11 @@ class Serializer {
     return *this;
   }
 
-  ~Serializer() { free(m_data); }
+  ~Serializer() {
+    if (!m_buffer) {
+      free(m_data);
+    }
+  }
 
   /*!
    * Save or load the thing pointed to by ptr.
@@ -156,6 +197,33 @@ class Serializer {
     from_raw_data(vec->data(), sizeof(T) * vec->size());
   }
 
+  /*!
+   * Save or load an array of POD that is in either vec or view, in the same format as
+   * from_pod_vector. If this serializer allows views, it's loaded into view without copying,
+   * otherwise into vec. When saving, whichever one isn't empty is saved.
+   */
+  template <typename T>
+  void from_pod_vector_or_view(std::vector<T>* vec, PodView<T>* view) {
+    if (is_saving()) {
+      if (view->empty()) {
+        from_pod_vector(vec);
+      } else {
+        save<size_t>(view->count);
+        read_or_write(const_cast<u8*>(view->bytes), view->size_bytes());
+      }
+    } else if (m_allow_views) {
+      vec->clear();
+      view->count = load<size_t>();
+      ASSERT(m_offset + view->size_bytes() <= m_size);
+      view->bytes = m_data + m_offset;
+      view->buffer = m_buffer;
+      m_offset += view->size_bytes();
+    } else {
+      *view = {};
+      from_pod_vector(vec);
+    }
+  }
+
   void from_string_vector(std::vector<std::string>* vec) {
     if (is_saving()) {
       save<size_t>(vec->size());
@@ -167,6 +235,56 @@ class Serializer {
     }
   }
 
+  /*!
+   * Save or load an optional string.
+   */
+  void from_optional_str(std::optional<std::string>* str) {
+    bool has_value = str->has_value();
+    from_ptr(&has_value);
+    if (is_loading()) {
+      *str = has_value ? std::optional<std::string>(load_string()) : std::nullopt;
+    } else if (has_value) {
+      save_str(&str->value());
+    }
+  }
+
+  /*!
+   * Save or load a vector of anything. f(Serializer&, T*) saves or loads one element.
+   */
+  template <typename T, typename F>
+  void from_vector(std::vector<T>* vec, F&& f) {
+    if (is_saving()) {
+      save<size_t>(vec->size());
+    } else {
+      vec->clear();
+      vec->resize(load<size_t>());
+    }
+    for (auto& x : *vec) {
+      f(*this, &x);
+    }
+  }
+
+  /*!
+   * Save or load a map (or unordered_map) from strings to anything. f(Serializer&, Value*) saves
+   * or loads one value. When loading, the entries are added to whatever is in the map already.
+   */
+  template <typename Map, typename F>
+  void from_string_map(Map* map, F&& f) {
+    if (is_saving()) {
+      save<size_t>(map->size());
+      for (auto& [key, value] : *map) {
+        save_str(&key);
+        f(*this, &value);
+      }
+    } else {
+      size_t count = load<size_t>();
+      for (size_t i = 0; i < count; i++) {
+        auto key = load_string();
+        f(*this, &(*map)[key]);
+      }
+    }
+  }
+
   /*!
    * Are we saving?
    */
@@ -230,4 +348,7 @@ class Serializer {
   size_t m_size = 0;
   size_t m_offset = 0;
   bool m_writing = false;
+  // if set, m_data is owned by this instead of malloc'd.
+  std::shared_ptr<const std::vector<u8>> m_buffer;
+  bool m_allow_views = false;
 };
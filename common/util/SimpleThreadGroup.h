@@ -1,6 +1,9 @@
+#pragma once
+
 #include <functional>
-#include <thread>
-#include <vector>
+#include <memory>
+
+#include "common/util/ThreadPool.h"
 
 /*!
  * Very simple group of threads.
@@ -8,22 +11,27 @@
  *  for (int i = 0; i < num_runs; i++) {
  *    func(i);
  *  }
- * but in parallel.
+ * but in parallel, on the global ThreadPool. Indices are handed out one at a time as workers
+ * become free, and the thread that calls join works on them too. There's no guarantee that all
+ * of the runs are going at the same time, so they must not wait on each other.
  *
  * Two things to watch out for:
  * - you must call join before this object is destroyed. The pattern of "join in the destructor"
  *   can cause confusing issues where resources used by threads are destroyed before the threads
  *   are joined, if you aren't careful about the order you declare variables.
  * - the function is copied (once)
+ *
+ * If func throws, join rethrows the first exception, after the other runs are done.
  */
 class SimpleThreadGroup {
  public:
+  explicit SimpleThreadGroup(TaskPriority priority = TaskPriority::NORMAL)
+      : m_priority(priority) {}
   void run(const std::function<void(int)>& func, int num_runs, int num_workers);
   void run(const std::function<void(int)>& func, int num_runs);
   void join();
 
  private:
-  bool m_joined = true;
-  std::vector<std::thread> m_threads;
-  std::function<void(int)> m_func;
-};
\ No newline at end of file
+  TaskPriority m_priority;
+  std::shared_ptr<ThreadPool::ForJob> m_job;
+};
@@ -468,6 +468,7 @@ class SmallVector {
     destroy_objects(m_storage_begin, m_size);
     if (using_heap_storage()) {
       free_heap_storage(m_storage_begin);
+      set_inline_storage();
     }
     m_size = 0;
   }
@@ -507,12 +508,62 @@ class SmallVector {
     return result;
   }
 
+  /*!
+   * Insert the values in [first, last) _before_ pos.
+   */
+  template <typename InputIt>
+  iterator insert(iterator pos, InputIt first, InputIt last) {
+    auto objects_before_insert = pos - begin();
+    auto objects_after_insert = end() - pos;
+    std::size_t count = std::distance(first, last);
+    if (count == 0) {
+      return pos;
+    }
+    if (size() + count > capacity()) {
+      // not enough room, need to reallocate
+      auto old_storage = m_storage_begin;
+      auto old_used_heap = using_heap_storage();
+      allocate_and_set_heap_storage(cu::max(std::size_t(GROW_AMOUNT * size()), size() + count));
+      move_and_destroy(m_storage_begin, old_storage, objects_before_insert);
+      move_and_destroy(m_storage_begin + objects_before_insert + count,
+                       old_storage + objects_before_insert, objects_after_insert);
+      if (old_used_heap) {
+        free_heap_storage(old_storage);
+      }
+    } else {
+      move_and_destroy_reverse(begin() + objects_before_insert + count,
+                               begin() + objects_before_insert, objects_after_insert);
+    }
+    copy_objects_from_range(m_storage_begin + objects_before_insert, first, last);
+    m_size += count;
+    return m_storage_begin + objects_before_insert;
+  }
+
   // insert iterator T&& value
   // insert iterator count value
-  // insert iterator (it, it)
 
   // emplace
-  // erase
+
+  /*!
+   * Remove the elements in [first, last). Returns an iterator to the element after the last one
+   * removed. Keeps the current storage.
+   */
+  iterator erase(const_iterator first, const_iterator last) {
+    auto dst = begin() + (first - cbegin());
+    auto src = begin() + (last - cbegin());
+    auto count = src - dst;
+    if (count > 0) {
+      destroy_objects(dst, count);
+      move_and_destroy(dst, src, end() - src);
+      m_size -= count;
+    }
+    return dst;
+  }
+
+  /*!
+   * Remove the element at pos. Returns an iterator to the element after it.
+   */
+  iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
 
   // push_back
   void push_back(const T& value) {
@@ -0,0 +1,178 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+#include "common/global_profiler/GlobalProfiler.h"
+
+#include "third-party/fmt/core.h"
+
+namespace {
+// the index of the current thread's queue, if it's a worker.
+thread_local int t_worker_idx = -1;
+thread_local ThreadPool* t_worker_pool = nullptr;
+}  // namespace
+
+ThreadPool::ThreadPool(int num_threads) {
+  num_threads = std::max(1, num_threads);
+  for (int i = 0; i < num_threads; i++) {
+    m_queues.push_back(std::make_unique<Queue>());
+  }
+  for (int i = 0; i < num_threads; i++) {
+    m_threads.emplace_back([this, i]() { worker_loop(i); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(m_sleep_mutex);
+    m_stop = true;
+  }
+  m_sleep_cv.notify_all();
+  for (auto& t : m_threads) {
+    t.join();
+  }
+}
+
+ThreadPool& ThreadPool::global() {
+  static ThreadPool pool((int)std::thread::hardware_concurrency() - 1);
+  return pool;
+}
+
+void ThreadPool::submit(std::function<void()> task, TaskPriority priority) {
+  // workers keep their own tasks, so nested work stays on the same core. Others are spread out.
+  int queue_idx = t_worker_pool == this
+                      ? t_worker_idx
+                      : (int)((unsigned)m_next_queue++ % (unsigned)m_queues.size());
+  {
+    auto& queue = *m_queues[queue_idx];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks[(int)priority].push_back(std::move(task));
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_sleep_mutex);
+    m_pending++;
+  }
+  m_sleep_cv.notify_one();
+}
+
+/*!
+ * Take the highest priority task there is. A worker takes the newest task from its own queue, or
+ * steals the oldest from another queue.
+ */
+bool ThreadPool::try_pop(int worker_idx, std::function<void()>& task) {
+  const int num_queues = (int)m_queues.size();
+  for (int priority = 0; priority < (int)TaskPriority::COUNT; priority++) {
+    for (int i = 0; i < num_queues; i++) {
+      int queue_idx = (worker_idx + i) % num_queues;
+      auto& queue = *m_queues[queue_idx];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      auto& tasks = queue.tasks[priority];
+      if (tasks.empty()) {
+        continue;
+      }
+      if (i == 0) {
+        task = std::move(tasks.back());
+        tasks.pop_back();
+      } else {
+        task = std::move(tasks.front());
+        tasks.pop_front();
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+void ThreadPool::worker_loop(int worker_idx) {
+  t_worker_idx = worker_idx;
+  t_worker_pool = this;
+  PROF_THREAD_NAME(fmt::format("Pool {}", worker_idx).c_str());
+  std::function<void()> task;
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(m_sleep_mutex);
+      m_sleep_cv.wait(lock, [&]() { return m_pending > 0 || m_stop; });
+      if (m_pending == 0 && m_stop) {
+        return;
+      }
+      // reserve a task, so the number of workers that go looking matches the number of tasks.
+      m_pending--;
+    }
+    // the task may be in any queue, and another worker may be moving it, so keep looking.
+    while (!try_pop(worker_idx, task)) {
+      std::this_thread::yield();
+    }
+    task();
+    task = nullptr;
+  }
+}
+
+std::shared_ptr<ThreadPool::ForJob> ThreadPool::start_parallel_for(
+    std::function<void(int)> func,
+    int count,
+    const ParallelForOptions& options) {
+  auto job = std::make_shared<ForJob>(std::move(func), count, options);
+  int grain = std::max(1, options.grain);
+  int chunks = (count + grain - 1) / grain;
+  // the caller works on it too, in finish_parallel_for.
+  int helpers = std::min(num_threads(), chunks - 1);
+  if (options.max_workers > 0) {
+    helpers = std::min(helpers, options.max_workers - 1);
+  }
+  for (int i = 0; i < helpers; i++) {
+    submit([job]() { job->work(); }, options.priority);
+  }
+  return job;
+}
+
+void ThreadPool::finish_parallel_for(ForJob& job) {
+  job.work();
+  job.wait();
+  job.rethrow_if_failed();
+}
+
+void ThreadPool::ForJob::work() {
+  for (;;) {
+    int start = m_next.fetch_add(m_grain);
+    if (start >= m_count) {
+      return;
+    }
+    int end = std::min(m_count, start + m_grain);
+    std::exception_ptr error;
+    for (int i = start; i < end; i++) {
+      if (m_cancel.cancelled() || m_failed.load(std::memory_order_relaxed)) {
+        break;
+      }
+      try {
+        m_func(i);
+      } catch (...) {
+        error = std::current_exception();
+        // skip the rest, like a serial loop would.
+        m_failed = true;
+        break;
+      }
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (error && !m_error) {
+      m_error = error;
+    }
+    m_done += end - start;
+    if (m_done == m_count) {
+      m_cv.notify_all();
+    }
+  }
+}
+
+void ThreadPool::ForJob::wait() {
+  // every index is claimed by now, and the threads that claimed them are running them.
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_cv.wait(lock, [&]() { return m_done == m_count; });
+}
+
+void ThreadPool::ForJob::rethrow_if_failed() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_error) {
+    std::rethrow_exception(m_error);
+  }
+}
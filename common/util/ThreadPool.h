@@ -0,0 +1,157 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*!
+ * Tasks with a higher priority are started first. A task that has already started is never
+ * interrupted.
+ */
+enum class TaskPriority {
+  HIGH = 0,    // work the current frame is waiting on
+  NORMAL = 1,  // default
+  LOW = 2,     // background work, like loading levels ahead of time
+  COUNT = 3
+};
+
+/*!
+ * Shared flag to stop a parallel_for early. Copies refer to the same flag.
+ * Indices that haven't started when the token is cancelled are skipped.
+ */
+class CancelToken {
+ public:
+  void cancel() { m_cancelled->store(true, std::memory_order_relaxed); }
+  bool cancelled() const { return m_cancelled->load(std::memory_order_relaxed); }
+
+ private:
+  std::shared_ptr<std::atomic<bool>> m_cancelled = std::make_shared<std::atomic<bool>>(false);
+};
+
+struct ParallelForOptions {
+  TaskPriority priority = TaskPriority::NORMAL;
+  // indices claimed at a time, bigger is less overhead for tiny loop bodies.
+  int grain = 1;
+  // limit on threads working on this loop, including the caller. 0 for no limit.
+  int max_workers = 0;
+  const CancelToken* cancel = nullptr;
+};
+
+/*!
+ * A pool of worker threads shared by the whole process.
+ *
+ * Each worker has its own queue: tasks submitted from a worker go on its own queue, and a worker
+ * with nothing to do steals from the others. The thread that waits on a parallel_for also works on
+ * it, so a parallel_for inside of another one doesn't need any more threads, and can't deadlock.
+ */
+class ThreadPool {
+ public:
+  explicit ThreadPool(int num_threads);
+  ~ThreadPool();
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /*!
+   * The pool used by everything. It has one thread less than the number of cores, because the
+   * thread waiting for the work helps too.
+   */
+  static ThreadPool& global();
+
+  int num_threads() const { return (int)m_threads.size(); }
+
+  /*!
+   * Run a task on some worker, eventually. The task must not throw.
+   */
+  void submit(std::function<void()> task, TaskPriority priority = TaskPriority::NORMAL);
+
+  class ForJob;
+
+  /*!
+   * Start running func(i) for i in [0, count) on the workers. The caller must call
+   * finish_parallel_for before anything used by func goes away.
+   */
+  std::shared_ptr<ForJob> start_parallel_for(std::function<void(int)> func,
+                                             int count,
+                                             const ParallelForOptions& options = {});
+
+  /*!
+   * Work on the job until every index is done. If func threw, the first exception is rethrown.
+   */
+  static void finish_parallel_for(ForJob& job);
+
+  /*!
+   * Run func(i) for i in [0, count), in parallel, and return when all are done. The indices are
+   * handed out as threads become free, so uneven work is balanced.
+   */
+  void parallel_for(std::function<void(int)> func,
+                    int count,
+                    const ParallelForOptions& options = {}) {
+    finish_parallel_for(*start_parallel_for(std::move(func), count, options));
+  }
+
+ private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks[(int)TaskPriority::COUNT];
+  };
+
+  void worker_loop(int worker_idx);
+  bool try_pop(int worker_idx, std::function<void()>& task);
+
+  std::vector<std::unique_ptr<Queue>> m_queues;
+  std::vector<std::thread> m_threads;
+  std::atomic<int> m_next_queue = 0;
+
+  // for sleeping workers
+  std::mutex m_sleep_mutex;
+  std::condition_variable m_sleep_cv;
+  int m_pending = 0;  // tasks submitted, but not taken yet
+  bool m_stop = false;
+};
+
+/*!
+ * The state of a parallel_for. Shared between the caller and the tasks that help with it, which
+ * may start after the loop is finished and must then do nothing.
+ */
+class ThreadPool::ForJob {
+ public:
+  ForJob(std::function<void(int)> func, int count, const ParallelForOptions& options)
+      : m_func(std::move(func)),
+        m_count(std::max(0, count)),
+        m_grain(std::max(1, options.grain)),
+        m_cancel(options.cancel ? *options.cancel : CancelToken()) {}
+
+  // claim and run indices until there are none left.
+  void work();
+  void wait();
+  void rethrow_if_failed();
+
+ private:
+  std::function<void(int)> m_func;
+  int m_count;
+  int m_grain;
+  CancelToken m_cancel;
+  std::atomic<int> m_next = 0;
+  std::atomic<bool> m_failed = false;
+
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  int m_done = 0;
+  std::exception_ptr m_error;
+};
+
+/*!
+ * Run func(i) for i in [0, count) on the global pool.
+ */
+inline void parallel_for(int count,
+                         std::function<void(int)> func,
+                         const ParallelForOptions& options = {}) {
+  ThreadPool::global().parallel_for(std::move(func), count, options);
+}
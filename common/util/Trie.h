@@ -1,9 +1,10 @@
 #pragma once
 
-#include <string>
+#include <memory>
+#include <string_view>
 #include <vector>
 
-#include "common/util/Assert.h"
+#include "common/common_types.h"
 
 /*!
  * A simple prefix tree. It works similarly to a map, but also supports fast lookups by prefix with
@@ -13,178 +14,153 @@
  * Doing an insert will create a copy of your object.
  *
  * Other that deleting the whole thing, there is no support for removing a node.
+ *
+ * The nodes are stored in a single array and refer to each other by index. The children of a node
+ * are a list of siblings sorted by character, so a node is 16 bytes, instead of a table of 256
+ * child pointers, and lookups by prefix return objects sorted by key.
  */
 template <typename T>
 class Trie {
  public:
-  Trie() = default;
+  Trie() : m_nodes(1) {}
   Trie(const Trie&) = delete;
   Trie& operator=(const Trie&) = delete;
 
   // Insert an object, replacing an existing one if it exists
-  void insert(const std::string& str, const T& obj);
+  void insert(std::string_view str, const T& obj);
 
   // Get the object at the string. Default construct a new one if none exists.
-  T* operator[](const std::string& str);
+  T* operator[](std::string_view str);
 
   // Lookup an existing object. If none exists, return nullptr.
-  T* lookup(const std::string& str) const;
+  T* lookup(std::string_view str) const;
 
   // return the number of entries.
   int size() const { return m_size; }
 
   // Get all objects starting with the given prefix.
-  std::vector<T*> lookup_prefix(const std::string& str) const;
+  std::vector<T*> lookup_prefix(std::string_view str) const;
 
   // Get all nodes in the tree.
   std::vector<T*> get_all_nodes() const;
-  ~Trie();
 
  private:
-  static constexpr int CHAR_SIZE = 256;
-
-  static int idx(char c) { return (u8)c; }
+  static constexpr u32 NONE = UINT32_MAX;
 
   struct Node {
-    T* value = nullptr;
-    Node* children[CHAR_SIZE] = {0};
-
-    void delete_children() {
-      if (value) {
-        delete value;
-        value = nullptr;
-      }
-      for (auto child : children) {
-        if (child) {
-          child->delete_children();
-          delete child;
-          child = nullptr;
-        }
-      }
-    }
+    u32 first_child = NONE;
+    u32 next_sibling = NONE;
+    u32 value = NONE;  // index in m_values
+    u8 c = 0;
+  };
 
-    /*!
-     * Return true if a new object was inserted.
-     */
-    bool insert(const char* str, const T* obj) {
-      if (!*str) {
-        // we are the child!
-        if (value) {
-          delete value;
-          value = new T(*obj);
-          return false;  // didn't change the count.
-        } else {
-          value = new T(*obj);
-          return true;  // did change the count
-        }
-
-      } else {
-        // still more to go
-        char first = *str;
-        if (!children[idx(first)]) {
-          children[idx(first)] = new Node();
-        }
-        return children[idx(first)]->insert(str + 1, obj);
-      }
-    }
+  // Returns the node for the string, or NONE if there isn't one.
+  u32 find_node(std::string_view str) const;
+  // Returns the node for the string, adding nodes if needed.
+  u32 find_or_add_node(std::string_view str);
+  void get_all_children(u32 node, std::vector<T*>& result) const;
 
-    T* bracket_operator(const char* str, bool* inserted) {
-      if (!*str) {
-        // we are the child!
-        if (!value) {
-          value = new T();
-          *inserted = true;
-        } else {
-          *inserted = false;
-        }
-
-        return value;
-      } else {
-        // still more to go
-        char first = *str;
-        if (!children[idx(first)]) {
-          children[idx(first)] = new Node();
-        }
-        return children[idx(first)]->bracket_operator(str + 1, inserted);
-      }
-    }
+  std::vector<Node> m_nodes;  // the root is m_nodes[0]
+  std::vector<std::unique_ptr<T>> m_values;
+  int m_size = 0;
+};
 
-    T* lookup(const char* str) const {
-      if (!*str) {
-        return value;
-      }
-      if (children[idx(*str)]) {
-        return children[idx(*str)]->lookup(str + 1);
-      }
-      return nullptr;
+template <typename T>
+u32 Trie<T>::find_node(std::string_view str) const {
+  u32 node = 0;
+  for (char ch : str) {
+    u8 c = ch;
+    u32 child = m_nodes[node].first_child;
+    while (child != NONE && m_nodes[child].c < c) {
+      child = m_nodes[child].next_sibling;
     }
-
-    void get_all_children(std::vector<T*>& result) const {
-      if (value) {
-        result.push_back(value);
-      }
-      for (auto child : children) {
-        if (child) {
-          child->get_all_children(result);
-        }
-      }
+    if (child == NONE || m_nodes[child].c != c) {
+      return NONE;
     }
+    node = child;
+  }
+  return node;
+}
 
-    std::vector<T*> lookup_prefix(const char* str) const {
-      if (!*str) {
-        std::vector<T*> result;
-        get_all_children(result);
-        return result;
-      } else {
-        if (children[idx(*str)]) {
-          return children[idx(*str)]->lookup_prefix(str + 1);
-        } else {
-          return {};
-        }
-      }
+template <typename T>
+u32 Trie<T>::find_or_add_node(std::string_view str) {
+  u32 node = 0;
+  for (char ch : str) {
+    u8 c = ch;
+    u32* link = &m_nodes[node].first_child;
+    while (*link != NONE && m_nodes[*link].c < c) {
+      link = &m_nodes[*link].next_sibling;
     }
-  };
-
-  Node m_root;
-  int m_size = 0;
-};
+    if (*link == NONE || m_nodes[*link].c != c) {
+      Node new_node;
+      new_node.c = c;
+      new_node.next_sibling = *link;
+      node = m_nodes.size();
+      // link points into m_nodes, so set it before adding the node.
+      *link = node;
+      m_nodes.push_back(new_node);
+    } else {
+      node = *link;
+    }
+  }
+  return node;
+}
 
 template <typename T>
-Trie<T>::~Trie<T>() {
-  m_root.delete_children();
-  m_size = 0;
+void Trie<T>::get_all_children(u32 node, std::vector<T*>& result) const {
+  if (m_nodes[node].value != NONE) {
+    result.push_back(m_values[m_nodes[node].value].get());
+  }
+  for (u32 child = m_nodes[node].first_child; child != NONE; child = m_nodes[child].next_sibling) {
+    get_all_children(child, result);
+  }
 }
 
 template <typename T>
-void Trie<T>::insert(const std::string& str, const T& obj) {
-  if (m_root.insert(str.c_str(), &obj)) {
+void Trie<T>::insert(std::string_view str, const T& obj) {
+  u32 node = find_or_add_node(str);
+  if (m_nodes[node].value != NONE) {
+    m_values[m_nodes[node].value] = std::make_unique<T>(obj);
+  } else {
+    m_nodes[node].value = m_values.size();
+    m_values.push_back(std::make_unique<T>(obj));
     m_size++;
   }
 }
 
 template <typename T>
-T* Trie<T>::lookup(const std::string& str) const {
-  return m_root.lookup(str.c_str());
+T* Trie<T>::lookup(std::string_view str) const {
+  u32 node = find_node(str);
+  if (node == NONE || m_nodes[node].value == NONE) {
+    return nullptr;
+  }
+  return m_values[m_nodes[node].value].get();
 }
 
 template <typename T>
-T* Trie<T>::operator[](const std::string& str) {
-  bool added = false;
-  auto result = m_root.bracket_operator(str.c_str(), &added);
-  if (added) {
+T* Trie<T>::operator[](std::string_view str) {
+  u32 node = find_or_add_node(str);
+  if (m_nodes[node].value == NONE) {
+    m_nodes[node].value = m_values.size();
+    m_values.push_back(std::make_unique<T>());
     m_size++;
   }
-  return result;
+  return m_values[m_nodes[node].value].get();
 }
 
 template <typename T>
-std::vector<T*> Trie<T>::lookup_prefix(const std::string& str) const {
-  return m_root.lookup_prefix(str.c_str());
+std::vector<T*> Trie<T>::lookup_prefix(std::string_view str) const {
+  std::vector<T*> result;
+  u32 node = find_node(str);
+  if (node != NONE) {
+    get_all_children(node, result);
+  }
+  return result;
 }
 
 template <typename T>
 std::vector<T*> Trie<T>::get_all_nodes() const {
   std::vector<T*> result;
-  m_root.get_all_children(result);
+  get_all_children(0, result);
   return result;
 }
@@ -1,5 +1,6 @@
 #include "compress.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
 
@@ -10,40 +11,258 @@
 
 namespace compression {
 
+namespace {
+void check_zstd(size_t result) {
+  if (ZSTD_isError(result)) {
+    ASSERT_MSG(false, fmt::format("ZSTD error: {}", ZSTD_getErrorName(result)));
+  }
+}
+
 /*!
- * Compress data with zstd.  There is an 8-byte header containing the decompressed data's size.
+ * Contexts are big and slow to create, so each thread keeps one around for compressing lots of
+ * small things.
  */
-std::vector<u8> compress_zstd(const void* data, size_t size) {
+ZSTD_CCtx* thread_cctx() {
+  struct Holder {
+    ZSTD_CCtx* ctx = ZSTD_createCCtx();
+    ~Holder() { ZSTD_freeCCtx(ctx); }
+  };
+  thread_local Holder holder;
+  return holder.ctx;
+}
+
+ZSTD_DCtx* thread_dctx() {
+  struct Holder {
+    ZSTD_DCtx* ctx = ZSTD_createDCtx();
+    ~Holder() { ZSTD_freeDCtx(ctx); }
+  };
+  thread_local Holder holder;
+  return holder.ctx;
+}
+
+void set_options(ZSTD_CCtx* ctx, const ZstdOptions& options) {
+  check_zstd(ZSTD_CCtx_setParameter(ctx, ZSTD_c_compressionLevel, options.level));
+  if (options.workers > 0) {
+    // this fails if zstd was built without threads, and then the caller does all the work.
+    ZSTD_CCtx_setParameter(ctx, ZSTD_c_nbWorkers, options.workers);
+  }
+}
+
+/*!
+ * Compress with ctx, which has its parameters set, and add the size header.
+ */
+std::vector<u8> compress_with(ZSTD_CCtx* ctx,
+                              const ZSTD_CDict* dict,
+                              const void* data,
+                              size_t size) {
   auto max_compressed = ZSTD_compressBound(size);
   std::vector<u8> result(sizeof(size_t) + max_compressed);
   memcpy(result.data(), &size, sizeof(size_t));
   auto compressed_size =
-      ZSTD_compress(result.data() + sizeof(size_t), max_compressed, data, size, 1);
-  if (ZSTD_isError(compressed_size)) {
-    ASSERT_MSG(false, fmt::format("ZSTD error: {}", ZSTD_getErrorName(compressed_size)));
-  }
+      dict ? ZSTD_compress_usingCDict(ctx, result.data() + sizeof(size_t), max_compressed, data,
+                                      size, dict)
+           : ZSTD_compress2(ctx, result.data() + sizeof(size_t), max_compressed, data, size);
+  check_zstd(compressed_size);
   result.resize(sizeof(size_t) + compressed_size);
   return result;
 }
 
+/*!
+ * Decompress the frame after the size header into dst. Returns the size, or a zstd error code.
+ */
+size_t decompress_frame(const void* data,
+                        size_t size,
+                        void* dst,
+                        size_t dst_size,
+                        const ZstdDictionary* dict) {
+  auto* frame = (const u8*)data + sizeof(size_t);
+  size_t frame_size = size - sizeof(size_t);
+  if (dict) {
+    return ZSTD_decompress_usingDDict(thread_dctx(), dst, dst_size, frame, frame_size,
+                                      dict->ddict());
+  }
+  return ZSTD_decompressDCtx(thread_dctx(), dst, dst_size, frame, frame_size);
+}
+}  // namespace
+
+ZstdDictionary::ZstdDictionary(std::vector<u8> content, int level) : m_content(std::move(content)) {
+  // content without zstd's dictionary header is used as-is, as data to refer back to.
+  m_cdict = ZSTD_createCDict(m_content.data(), m_content.size(), level);
+  m_ddict = ZSTD_createDDict(m_content.data(), m_content.size());
+  ASSERT(m_cdict && m_ddict);
+}
+
+ZstdDictionary::~ZstdDictionary() {
+  ZSTD_freeCDict(m_cdict);
+  ZSTD_freeDDict(m_ddict);
+}
+
+std::vector<u8> ZstdDictionary::content_from_samples(const std::vector<std::vector<u8>>& samples,
+                                                     size_t max_size) {
+  // zstd's dictionary trainer isn't included, so this just keeps as many samples as fit. The ones
+  // at the end win, and the earliest one kept may lose its start.
+  size_t total = 0;
+  size_t first = samples.size();
+  while (first > 0 && total < max_size) {
+    first--;
+    total += samples[first].size();
+  }
+
+  std::vector<u8> result;
+  result.reserve(std::min(total, max_size));
+  for (size_t i = first; i < samples.size(); i++) {
+    auto& sample = samples[i];
+    size_t skip = total > max_size && i == first ? total - max_size : 0;
+    result.insert(result.end(), sample.begin() + skip, sample.end());
+  }
+  return result;
+}
+
+/*!
+ * Compress data with zstd.  There is an 8-byte header containing the decompressed data's size.
+ */
+std::vector<u8> compress_zstd(const void* data, size_t size) {
+  return compress_zstd(data, size, ZstdOptions());
+}
+
+std::vector<u8> compress_zstd(const void* data, size_t size, const ZstdOptions& options) {
+  if (options.workers > 0) {
+    // the workers belong to the context, so don't keep them around after this.
+    ZSTD_CCtx* ctx = ZSTD_createCCtx();
+    set_options(ctx, options);
+    auto result = compress_with(ctx, nullptr, data, size);
+    ZSTD_freeCCtx(ctx);
+    return result;
+  }
+  ZSTD_CCtx* ctx = thread_cctx();
+  ZSTD_CCtx_reset(ctx, ZSTD_reset_session_and_parameters);
+  set_options(ctx, options);
+  return compress_with(ctx, nullptr, data, size);
+}
+
+std::vector<u8> compress_zstd(const void* data, size_t size, const ZstdDictionary& dict) {
+  return compress_with(thread_cctx(), dict.cdict(), data, size);
+}
+
 /*!
  * Decompress data with zstd.  The first 8-bytes of the data should be a header containing the
  * decompressed data's size.
  */
 std::vector<u8> decompress_zstd(const void* data, size_t size) {
   ASSERT(size >= sizeof(size_t));
+  std::vector<u8> result(zstd_decompressed_size(data, size));
+  auto decomp_size = decompress_frame(data, size, result.data(), result.size(), nullptr);
+  check_zstd(decomp_size);
+  ASSERT(decomp_size == result.size());
+  return result;
+}
+
+std::vector<u8> decompress_zstd(const void* data, size_t size, const ZstdDictionary& dict) {
+  ASSERT(size >= sizeof(size_t));
+  std::vector<u8> result(zstd_decompressed_size(data, size));
+  auto decomp_size = decompress_frame(data, size, result.data(), result.size(), &dict);
+  check_zstd(decomp_size);
+  ASSERT(decomp_size == result.size());
+  return result;
+}
+
+size_t zstd_decompressed_size(const void* data, size_t size) {
+  if (size < sizeof(size_t)) {
+    return 0;
+  }
   size_t decompressed_size;
   memcpy(&decompressed_size, data, sizeof(size_t));
-  size_t compressed_size = size - sizeof(size_t);
+  return decompressed_size;
+}
 
-  std::vector<u8> result(decompressed_size);
-  auto decomp_size = ZSTD_decompress(result.data(), decompressed_size,
-                                     (const u8*)data + sizeof(size_t), compressed_size);
-  if (ZSTD_isError(decomp_size)) {
-    ASSERT_MSG(false, fmt::format("ZSTD error: {}", ZSTD_getErrorName(compressed_size)));
+/*!
+ * Like decompress_zstd, but writes the data to dst instead of a new vector.
+ */
+bool decompress_zstd_into(const void* data,
+                          size_t size,
+                          void* dst,
+                          size_t dst_size,
+                          const ZstdDictionary* dict) {
+  size_t decompressed_size = zstd_decompressed_size(data, size);
+  if (!decompressed_size || decompressed_size > dst_size) {
+    return false;
   }
+  auto decomp_size = decompress_frame(data, size, dst, decompressed_size, dict);
+  return !ZSTD_isError(decomp_size) && decomp_size == decompressed_size;
+}
 
-  ASSERT(decomp_size == decompressed_size);
-  return result;
+ZstdStreamCompressor::ZstdStreamCompressor(const ZstdOptions& options) {
+  m_ctx = ZSTD_createCCtx();
+  set_options(m_ctx, options);
+  // the size goes here at the end.
+  m_out.resize(sizeof(size_t) + ZSTD_CStreamOutSize());
+  m_out_size = sizeof(size_t);
+}
+
+ZstdStreamCompressor::~ZstdStreamCompressor() {
+  ZSTD_freeCCtx(m_ctx);
+}
+
+void ZstdStreamCompressor::write(const void* data, size_t size) {
+  ASSERT(m_ctx);
+  m_in_size += size;
+  compress(data, size, false);
+}
+
+void ZstdStreamCompressor::compress(const void* data, size_t size, bool end) {
+  ZSTD_inBuffer in = {data, size, 0};
+  for (;;) {
+    if (m_out.size() - m_out_size < ZSTD_CStreamOutSize()) {
+      m_out.resize(std::max(m_out.size() * 2, m_out_size + ZSTD_CStreamOutSize()));
+    }
+    ZSTD_outBuffer out = {m_out.data() + m_out_size, m_out.size() - m_out_size, 0};
+    size_t remaining =
+        ZSTD_compressStream2(m_ctx, &out, &in, end ? ZSTD_e_end : ZSTD_e_continue);
+    check_zstd(remaining);
+    m_out_size += out.pos;
+    if (end ? remaining == 0 : in.pos == in.size) {
+      return;
+    }
+  }
+}
+
+std::vector<u8> ZstdStreamCompressor::finish() {
+  ASSERT(m_ctx);
+  compress(nullptr, 0, true);
+  ZSTD_freeCCtx(m_ctx);
+  m_ctx = nullptr;
+  memcpy(m_out.data(), &m_in_size, sizeof(size_t));
+  m_out.resize(m_out_size);
+  return std::move(m_out);
+}
+
+ZstdStreamDecompressor::ZstdStreamDecompressor(const void* data,
+                                               size_t size,
+                                               const ZstdDictionary* dict)
+    : m_data((const u8*)data), m_size(size) {
+  ASSERT(size >= sizeof(size_t));
+  m_decompressed_size = zstd_decompressed_size(data, size);
+  m_pos = sizeof(size_t);
+  m_ctx = ZSTD_createDCtx();
+  if (dict) {
+    check_zstd(ZSTD_DCtx_refDDict(m_ctx, dict->ddict()));
+  }
+}
+
+ZstdStreamDecompressor::~ZstdStreamDecompressor() {
+  ZSTD_freeDCtx(m_ctx);
+}
+
+size_t ZstdStreamDecompressor::read(void* dst, size_t dst_size) {
+  ZSTD_outBuffer out = {dst, std::min(dst_size, m_decompressed_size - m_read), 0};
+  while (out.pos < out.size) {
+    ZSTD_inBuffer in = {m_data, m_size, m_pos};
+    size_t out_before = out.pos;
+    check_zstd(ZSTD_decompressStream(m_ctx, &out, &in));
+    ASSERT_MSG(in.pos != m_pos || out.pos != out_before, "ZSTD error: data ended early");
+    m_pos = in.pos;
+  }
+  m_read += out.pos;
+  return out.pos;
 }
 }  // namespace compression
@@ -4,8 +4,111 @@
 #include <vector>
 
 #include "common/common_types.h"
+
+struct ZSTD_CCtx_s;
+struct ZSTD_DCtx_s;
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
 namespace compression {
+
+struct ZstdOptions {
+  int level = 1;
+  // threads compressing the data, in addition to the caller. 0 is just the caller. Only worth it
+  // for data that's a few MB or more.
+  int workers = 0;
+};
+
+/*!
+ * A dictionary of data that's common to many small buffers, so each of them can refer to it
+ * instead of starting from nothing. Data compressed with a dictionary must be decompressed with
+ * the same one.
+ */
+class ZstdDictionary {
+ public:
+  explicit ZstdDictionary(std::vector<u8> content, int level = 1);
+  ~ZstdDictionary();
+  ZstdDictionary(const ZstdDictionary&) = delete;
+  ZstdDictionary& operator=(const ZstdDictionary&) = delete;
+
+  /*!
+   * Build a dictionary from examples of the data, keeping at most max_size bytes. Later samples
+   * are cheaper to refer to, so the most typical data should be last.
+   */
+  static std::vector<u8> content_from_samples(const std::vector<std::vector<u8>>& samples,
+                                              size_t max_size);
+
+  const std::vector<u8>& content() const { return m_content; }
+  ZSTD_CDict_s* cdict() const { return m_cdict; }
+  ZSTD_DDict_s* ddict() const { return m_ddict; }
+
+ private:
+  std::vector<u8> m_content;
+  ZSTD_CDict_s* m_cdict = nullptr;
+  ZSTD_DDict_s* m_ddict = nullptr;
+};
+
 // compress and decompress data with zstd
 std::vector<u8> compress_zstd(const void* data, size_t size);
+std::vector<u8> compress_zstd(const void* data, size_t size, const ZstdOptions& options);
+std::vector<u8> compress_zstd(const void* data, size_t size, const ZstdDictionary& dict);
 std::vector<u8> decompress_zstd(const void* data, size_t size);
-}  // namespace compression
\ No newline at end of file
+std::vector<u8> decompress_zstd(const void* data, size_t size, const ZstdDictionary& dict);
+// the size of the data decompress_zstd would return, from the header. 0 if there's no header.
+size_t zstd_decompressed_size(const void* data, size_t size);
+// decompress into dst, which must have room for zstd_decompressed_size bytes. False on error.
+bool decompress_zstd_into(const void* data,
+                          size_t size,
+                          void* dst,
+                          size_t dst_size,
+                          const ZstdDictionary* dict = nullptr);
+
+/*!
+ * Compress data that arrives in pieces, without having all of it in memory at once. The result is
+ * the same format as compress_zstd.
+ */
+class ZstdStreamCompressor {
+ public:
+  explicit ZstdStreamCompressor(const ZstdOptions& options = {});
+  ~ZstdStreamCompressor();
+  ZstdStreamCompressor(const ZstdStreamCompressor&) = delete;
+  ZstdStreamCompressor& operator=(const ZstdStreamCompressor&) = delete;
+
+  void write(const void* data, size_t size);
+  // end the data, and return all of the compressed data. The compressor can't be used after this.
+  std::vector<u8> finish();
+
+ private:
+  void compress(const void* data, size_t size, bool end);
+
+  ZSTD_CCtx_s* m_ctx = nullptr;
+  std::vector<u8> m_out;
+  size_t m_out_size = 0;
+  size_t m_in_size = 0;
+};
+
+/*!
+ * Decompress data from compress_zstd in pieces, into caller provided buffers. The compressed data
+ * must stay alive until everything is read.
+ */
+class ZstdStreamDecompressor {
+ public:
+  ZstdStreamDecompressor(const void* data, size_t size, const ZstdDictionary* dict = nullptr);
+  ~ZstdStreamDecompressor();
+  ZstdStreamDecompressor(const ZstdStreamDecompressor&) = delete;
+  ZstdStreamDecompressor& operator=(const ZstdStreamDecompressor&) = delete;
+
+  size_t decompressed_size() const { return m_decompressed_size; }
+  bool done() const { return m_read == m_decompressed_size; }
+  // decompress up to dst_size bytes into dst. Returns the number of bytes written.
+  size_t read(void* dst, size_t dst_size);
+
+ private:
+  ZSTD_DCtx_s* m_ctx = nullptr;
+  const u8* m_data = nullptr;
+  size_t m_size = 0;
+  size_t m_pos = 0;
+  size_t m_decompressed_size = 0;
+  size_t m_read = 0;
+};
+}  // namespace compression
@@ -21,7 +21,7 @@ void assert_string_empty_after(const char* str, int size) {
   }
 }
 
-std::string get_object_file_name(const std::string& original_name, u8* data, int size) {
+std::string get_object_file_name(const std::string& original_name, const u8* data, int size) {
   const std::string art_group_text_strings[] = {
       fmt::format("/src/next/data/art-group{}/", versions::jak1::ART_FILE_VERSION),
       fmt::format("/src/jak2/final/art-group{}/", versions::jak2::ART_FILE_VERSION)};
@@ -1,7 +1,14 @@
 #include "json_util.h"
 
+#include <mutex>
+#include <unordered_map>
+
 #include "common/log/log.h"
 #include "common/util/Assert.h"
+#include "common/util/FileUtil.h"
+#include "common/util/ThreadPool.h"
+
+#include "third-party/zstd/lib/common/xxhash.h"
 
 /*!
  * Strip out // and / * comments
@@ -90,6 +97,174 @@ nlohmann::json parse_commented_json(const std::string& input, const std::string&
   }
 }
 
+namespace {
+size_t skip_json_whitespace(const std::string& text, size_t i) {
+  while (i < text.size() &&
+         (text[i] == ' ' || text[i] == '\n' || text[i] == '\r' || text[i] == '\t')) {
+    i++;
+  }
+  return i;
+}
+
+/*!
+ * Given the index of the opening quote of a string, the index after its closing quote, or npos.
+ */
+size_t end_of_json_string(const std::string& text, size_t i) {
+  for (i++; i < text.size(); i++) {
+    if (text[i] == '\\') {
+      i++;
+    } else if (text[i] == '"') {
+      return i + 1;
+    }
+  }
+  return std::string::npos;
+}
+
+struct JsonMemberText {
+  size_t key_start, key_end;
+  size_t value_start, value_end;
+};
+
+/*!
+ * Find the keys and values of the members of a json object, without parsing the values. Only
+ * brackets and strings are looked at, so the values might not be valid json. Returns false if the
+ * text isn't an object.
+ */
+bool split_json_object_members(const std::string& text, std::vector<JsonMemberText>* out) {
+  size_t i = skip_json_whitespace(text, 0);
+  if (i >= text.size() || text[i] != '{') {
+    return false;
+  }
+  i = skip_json_whitespace(text, i + 1);
+  if (i < text.size() && text[i] == '}') {
+    return skip_json_whitespace(text, i + 1) == text.size();
+  }
+
+  while (true) {
+    if (i >= text.size() || text[i] != '"') {
+      return false;
+    }
+    JsonMemberText member;
+    member.key_start = i;
+    i = end_of_json_string(text, i);
+    if (i == std::string::npos) {
+      return false;
+    }
+    member.key_end = i;
+    i = skip_json_whitespace(text, i);
+    if (i >= text.size() || text[i] != ':') {
+      return false;
+    }
+    member.value_start = i + 1;
+
+    // the value ends at the first , or } that isn't nested in it.
+    int depth = 0;
+    i++;
+    while (i < text.size()) {
+      char c = text[i];
+      if (c == '"') {
+        i = end_of_json_string(text, i);
+        if (i == std::string::npos) {
+          return false;
+        }
+        continue;
+      }
+      if (c == '{' || c == '[') {
+        depth++;
+      } else if (c == '}' || c == ']') {
+        if (depth == 0) {
+          break;
+        }
+        depth--;
+      } else if (c == ',' && depth == 0) {
+        break;
+      }
+      i++;
+    }
+    if (i >= text.size()) {
+      return false;
+    }
+    member.value_end = i;
+    out->push_back(member);
+
+    if (text[i] == '}') {
+      return skip_json_whitespace(text, i + 1) == text.size();
+    }
+    i = skip_json_whitespace(text, i + 1);
+  }
+}
+}  // namespace
+
+/*!
+ * Parse a JSON file with comments, like parse_commented_json, but if the top level is an object,
+ * parse its members at the same time on the thread pool. This is for big config files that are a
+ * map from a function or file name to its settings. The result is the same as
+ * parse_commented_json, including for duplicate keys, where the last one is kept.
+ */
+nlohmann::json parse_commented_json_parallel(const std::string& input,
+                                             const std::string& source_name) {
+  const std::string text = strip_cpp_style_comments(input);
+  std::vector<JsonMemberText> members;
+  if (!split_json_object_members(text, &members)) {
+    return parse_commented_json(input, source_name);
+  }
+
+  std::vector<std::string> keys(members.size());
+  std::vector<nlohmann::json> values(members.size());
+  try {
+    ParallelForOptions options;
+    options.grain = 16;
+    parallel_for(
+        members.size(),
+        [&](int i) {
+          const auto& m = members[i];
+          keys[i] = nlohmann::json::parse(text.begin() + m.key_start, text.begin() + m.key_end)
+                        .get<std::string>();
+          values[i] =
+              nlohmann::json::parse(text.begin() + m.value_start, text.begin() + m.value_end);
+        },
+        options);
+  } catch (const std::exception&) {
+    // parse the whole thing to get the error message for the right place in the file.
+    return parse_commented_json(input, source_name);
+  }
+
+  nlohmann::json result = nlohmann::json::object();
+  for (size_t i = 0; i < members.size(); i++) {
+    result[keys[i]] = std::move(values[i]);
+  }
+  return result;
+}
+
+/*!
+ * Read and parse a commented json file. The result is kept, keyed on the hash of the file's
+ * contents, so reading an unchanged file again doesn't parse it again. Can be called from any
+ * thread.
+ */
+std::shared_ptr<const nlohmann::json> read_commented_json_file(const std::string& path) {
+  struct CachedFile {
+    u64 hash = 0;
+    std::shared_ptr<const nlohmann::json> data;
+  };
+  static std::mutex cache_mutex;
+  static std::unordered_map<std::string, CachedFile> cache;
+
+  auto text = file_util::read_text_file(path);
+  u64 hash = XXH64(text.data(), text.size(), 0);
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    auto it = cache.find(path);
+    if (it != cache.end() && it->second.hash == hash) {
+      return it->second.data;
+    }
+  }
+
+  auto data = std::make_shared<const nlohmann::json>(parse_commented_json(text, path));
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  cache[path] = {hash, data};
+  return data;
+}
+
 /*!
  * Parse something like:
  * 2 -> Range(2, 3)
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <optional>
 #include <stdexcept>
 
@@ -11,6 +12,9 @@ using json = nlohmann::json;
 
 std::string strip_cpp_style_comments(const std::string& input);
 nlohmann::json parse_commented_json(const std::string& input, const std::string& source_name);
+nlohmann::json parse_commented_json_parallel(const std::string& input,
+                                             const std::string& source_name);
+std::shared_ptr<const nlohmann::json> read_commented_json_file(const std::string& path);
 Range<int> parse_json_optional_integer_range(const nlohmann::json& json);
 
 #define json_serialize(field_name) j[#field_name] = obj.field_name;
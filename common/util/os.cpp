@@ -78,6 +78,7 @@ void setup_cpu_info() {
     int result[4];
     __cpuidex(result, 1, 0);
     gCpuInfo.has_avx = result[2] & (1 << 28);
+    gCpuInfo.has_fma = result[2] & (1 << 12);
   }
 
   printf("-------- CPU Information --------\n");
@@ -85,6 +86,7 @@ void setup_cpu_info() {
   printf(" Model: %s\n", gCpuInfo.model.c_str());
   printf(" AVX  : %s\n", gCpuInfo.has_avx ? "true" : "false");
   printf(" AVX2 : %s\n", gCpuInfo.has_avx2 ? "true" : "false");
+  printf(" FMA  : %s\n", gCpuInfo.has_fma ? "true" : "false");
   fflush(stdout);
 
   gCpuInfo.initialized = true;
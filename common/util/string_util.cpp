@@ -1,5 +1,6 @@
 #include "string_util.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <random>
 #include <regex>
@@ -9,47 +10,68 @@
 
 namespace str_util {
 
-const std::string WHITESPACE = " \n\r\t\f\v";
+constexpr std::string_view WHITESPACE = " \n\r\t\f\v";
 
-bool contains(const std::string& s, const std::string& substr) {
-  return s.find(substr) != std::string::npos;
+bool contains(std::string_view s, std::string_view substr) {
+  return s.find(substr) != std::string_view::npos;
 }
 
-bool starts_with(const std::string& s, const std::string& prefix) {
+bool starts_with(std::string_view s, std::string_view prefix) {
   return s.size() >= prefix.size() && 0 == s.compare(0, prefix.size(), prefix);
 }
 
-bool ends_with(const std::string& s, const std::string& suffix) {
+bool ends_with(std::string_view s, std::string_view suffix) {
   return s.size() >= suffix.size() &&
          0 == s.compare(s.size() - suffix.size(), suffix.size(), suffix);
 }
 
-std::string ltrim(const std::string& s) {
+std::string_view ltrim_view(std::string_view s) {
   size_t start = s.find_first_not_of(WHITESPACE);
-  return (start == std::string::npos) ? "" : s.substr(start);
+  return (start == std::string_view::npos) ? std::string_view() : s.substr(start);
 }
 
-// TODO - used a lot in formatting, and its slow because i bet it iterates from the start and not
-// the end
-std::string rtrim(const std::string& s) {
+std::string_view rtrim_view(std::string_view s) {
   size_t end = s.find_last_not_of(WHITESPACE);
-  return (end == std::string::npos) ? "" : s.substr(0, end + 1);
+  return (end == std::string_view::npos) ? std::string_view() : s.substr(0, end + 1);
+}
+
+std::string_view trim_view(std::string_view s) {
+  return rtrim_view(ltrim_view(s));
+}
+
+std::string ltrim(const std::string& s) {
+  return std::string(ltrim_view(s));
+}
+
+std::string rtrim(const std::string& s) {
+  return std::string(rtrim_view(s));
 }
 
 std::string trim(const std::string& s) {
-  return rtrim(ltrim(s));
+  return std::string(trim_view(s));
 }
 
 std::string trim_newline_indents(const std::string& s) {
-  auto lines = split(s, '\n');
-  std::vector<std::string> trimmed_lines;
-  std::transform(lines.begin(), lines.end(), std::back_inserter(trimmed_lines),
-                 [](const std::string& line) { return ltrim(line); });
-  return join(trimmed_lines, "\n");
+  std::string out;
+  out.reserve(s.size());
+  bool first = true;
+  for (auto line : split_view(s, '\n')) {
+    if (!first) {
+      out.push_back('\n');
+    }
+    first = false;
+    out += ltrim_view(line);
+  }
+  return out;
 }
 
 std::string join(const std::vector<std::string>& strs, const std::string& join_with) {
   std::string out;
+  size_t size = 0;
+  for (auto& str : strs) {
+    size += str.size() + join_with.size();
+  }
+  out.reserve(size);
   for (size_t i = 0; i < strs.size(); i++) {
     out += strs.at(i);
     if (i < strs.size() - 1) {
@@ -60,13 +82,7 @@ std::string join(const std::vector<std::string>& strs, const std::string& join_w
 }
 
 int line_count(const std::string& str) {
-  int result = 0;
-  for (auto& c : str) {
-    if (c == '\n') {
-      result++;
-    }
-  }
-  return result;
+  return std::count(str.begin(), str.end(), '\n');
 }
 
 // NOTE - this won't work running within gk.exe!
@@ -84,7 +100,22 @@ std::string diff(const std::string& lhs, const std::string& rhs) {
 }
 /// Default splits on \n characters
 std::vector<std::string> split(const ::std::string& str, char delimiter) {
-  return google_diff::split_string(str, delimiter);
+  auto views = split_view(str, delimiter);
+  return std::vector<std::string>(views.begin(), views.end());
+}
+
+std::vector<std::string_view> split_view(std::string_view str, char delimiter) {
+  std::vector<std::string_view> parts;
+  size_t pos = 0;
+  while (true) {
+    size_t end = str.find(delimiter, pos);
+    if (end == std::string_view::npos) {
+      parts.push_back(str.substr(pos));
+      return parts;
+    }
+    parts.push_back(str.substr(pos, end - pos));
+    pos = end + 1;
+  }
 }
 
 std::vector<std::string> regex_get_capture_groups(const std::string& str,
@@ -109,6 +140,7 @@ bool replace(std::string& str, const std::string& from, const std::string& to) {
 
 std::string lower(const std::string& str) {
   std::string res;
+  res.reserve(str.size());
   for (auto c : str) {
     res.push_back(tolower(c));
   }
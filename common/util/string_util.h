@@ -1,15 +1,20 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace str_util {
-bool contains(const std::string& s, const std::string& substr);
-bool starts_with(const std::string& s, const std::string& prefix);
-bool ends_with(const std::string& s, const std::string& suffix);
+bool contains(std::string_view s, std::string_view substr);
+bool starts_with(std::string_view s, std::string_view prefix);
+bool ends_with(std::string_view s, std::string_view suffix);
 std::string ltrim(const std::string& s);
 std::string rtrim(const std::string& s);
 std::string trim(const std::string& s);
+/// The _view versions of trim don't copy, the result points into s.
+std::string_view ltrim_view(std::string_view s);
+std::string_view rtrim_view(std::string_view s);
+std::string_view trim_view(std::string_view s);
 /// Given a string with new-lines, split and trim the leading whitespace from each line
 /// then return the string with the new-lines back in place.
 std::string trim_newline_indents(const std::string& s);
@@ -18,6 +23,8 @@ bool valid_regex(const std::string& regex);
 std::string diff(const std::string& lhs, const std::string& rhs);
 /// Default splits on \n characters
 std::vector<std::string> split(const ::std::string& str, char delimiter = '\n');
+/// Like split, but the parts point into str instead of being copied.
+std::vector<std::string_view> split_view(std::string_view str, char delimiter = '\n');
 std::string join(const std::vector<std::string>& strs, const std::string& join_with);
 std::vector<std::string> regex_get_capture_groups(const std::string& str, const std::string& regex);
 bool replace(std::string& str, const std::string& from, const std::string& to);
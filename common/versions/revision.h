@@ -0,0 +1,2 @@
+#define BUILT_TAG ""
+#define BUILT_SHA "a8d4a7a"
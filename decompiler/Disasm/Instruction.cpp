@@ -6,6 +6,9 @@
 
 #include "Instruction.h"
 
+#include <mutex>
+#include <unordered_set>
+
 #include "common/util/Assert.h"
 
 #include "decompiler/ObjectFile/LinkedObjectFile.h"
@@ -13,6 +16,19 @@
 #include "third-party/fmt/core.h"
 
 namespace decompiler {
+namespace {
+/*!
+ * Get a copy of the symbol name that lives forever, so atoms can point to it. There are only a few
+ * thousand symbol names, but many more atoms that refer to them.
+ */
+const char* intern_symbol_name(const std::string& name) {
+  static std::mutex mutex;
+  static std::unordered_set<std::string> names;
+  std::lock_guard<std::mutex> lock(mutex);
+  return names.insert(name).first->c_str();
+}
+}  // namespace
+
 /*!
  * Convert atom to a string for disassembly.
  */
@@ -83,7 +99,7 @@ void InstructionAtom::set_vu_q() {
  */
 void InstructionAtom::set_sym(const std::string& _sym) {
   kind = IMM_SYM;
-  sym = _sym;
+  sym = intern_symbol_name(_sym);
 }
 
 /*!
@@ -91,7 +107,7 @@ void InstructionAtom::set_sym(const std::string& _sym) {
  */
 void InstructionAtom::set_sym_val_ptr(const std::string& _sym) {
   kind = IMM_SYM_VAL_PTR;
-  sym = _sym;
+  sym = intern_symbol_name(_sym);
 }
 
 /*!
@@ -4,6 +4,8 @@
  * @file Instruction.h
  * An EE instruction, represented as an operation, plus a list of source/destination atoms.
  * Can print itself (within the context of a LinkedObjectFile).
+ * Instructions are small and trivially copyable: there's one for every word of code, and the
+ * atoms don't own any memory.
  */
 
 #include <vector>
@@ -19,7 +21,7 @@ constexpr int MAX_INTRUCTION_DEST = 1;
 
 // An "atom", representing a single register, immediate, etc... for use in an Instruction.
 struct InstructionAtom {
-  enum AtomKind {
+  enum AtomKind : uint8_t {
     REGISTER,         // An EE Register
     IMM,              // An immediate value (stored as int32)
     IMM_SYM,          // An immediate value (a symbolic link)
@@ -64,7 +66,7 @@ struct InstructionAtom {
   int32_t imm;
   int label_id;
   Register reg;
-  std::string sym;
+  const char* sym = nullptr;  // interned, never freed
 };
 
 // An "Instruction", consisting of a "kind" (the opcode), and the source/destination atoms it
@@ -6,6 +6,8 @@
 
 #include "InstructionDecode.h"
 
+#include <array>
+
 #include "common/util/Assert.h"
 
 #include "decompiler/ObjectFile/LinkedObjectFile.h"
@@ -917,127 +919,107 @@ static InstructionKind decode_cache(OpcodeFields fields) {
   }
 }
 
+static InstructionKind decode_lui(OpcodeFields fields) {
+  ASSERT(fields.rs() == 0);
+  return InstructionKind::LUI;
+}
+
+static InstructionKind decode_bgtzl(OpcodeFields fields) {
+  ASSERT(fields.rt() == 0);
+  return InstructionKind::BGTZL;
+}
+
+namespace {
+/*!
+ * Entry in the top level decode table: either the instruction kind, or the function to decode the
+ * rest of the instruction with.
+ */
+struct PrimaryOpcode {
+  InstructionKind kind = InstructionKind::UNKNOWN;
+  InstructionKind (*decode)(OpcodeFields) = nullptr;
+};
+
+std::array<PrimaryOpcode, 64> make_primary_opcode_table() {
+  typedef InstructionKind IK;
+  std::array<PrimaryOpcode, 64> table;
+  auto kind = [&](u32 op, IK k) { table[op].kind = k; };
+  auto decoder = [&](u32 op, InstructionKind (*f)(OpcodeFields)) { table[op].decode = f; };
+
+  decoder(0b000000, decode_special);
+  decoder(0b000001, decode_regimm);
+  // J      010
+  // JAL    011
+  kind(0b000100, IK::BEQ);
+  kind(0b000101, IK::BNE);
+  kind(0b000110, IK::BLEZ);
+  kind(0b000111, IK::BGTZ);
+  // ADDI  1000
+  kind(0b001001, IK::ADDIU);
+  kind(0b001010, IK::SLTI);
+  kind(0b001011, IK::SLTIU);
+  kind(0b001100, IK::ANDI);
+  kind(0b001101, IK::ORI);
+  kind(0b001110, IK::XORI);
+  decoder(0b001111, decode_lui);
+  decoder(0b010000, decode_cop0);
+  decoder(0b010001, decode_cop1);
+  decoder(0b010010, decode_cop2);
+  //     010011:
+  //  reserved
+  kind(0b010100, IK::BEQL);
+  kind(0b010101, IK::BNEL);
+  //     010110
+  //  blezl
+  decoder(0b010111, decode_bgtzl);
+  //   0b011000:
+  //  daddi
+  kind(0b011001, IK::DADDIU);
+  kind(0b011010, IK::LDL);
+  kind(0b011011, IK::LDR);
+  decoder(0b011100, decode_mmi);
+  //   0b011101:
+  // reserved
+  kind(0b011110, IK::LQ);
+  kind(0b011111, IK::SQ);
+  kind(0b100000, IK::LB);
+  kind(0b100001, IK::LH);
+  kind(0b100010, IK::LWL);
+  kind(0b100011, IK::LW);
+  kind(0b100100, IK::LBU);
+  kind(0b100101, IK::LHU);
+  kind(0b100110, IK::LWR);
+  kind(0b100111, IK::LWU);
+  kind(0b101000, IK::SB);
+  kind(0b101001, IK::SH);
+  kind(0b101011, IK::SW);
+  // SDL
+  // SDR
+  // SWR
+  decoder(0b101111, decode_cache);
+  kind(0b110001, IK::LWC1);
+  kind(0b110011, IK::PREF);
+  kind(0b110110, IK::LQC2);
+  kind(0b110111, IK::LD);
+  kind(0b111001, IK::SWC1);
+  kind(0b111110, IK::SQC2);
+  kind(0b111111, IK::SD);
+  return table;
+}
+
+const std::array<PrimaryOpcode, 64> primary_opcodes = make_primary_opcode_table();
+}  // namespace
+
 /*!
  * Top level opcode decode
  */
 static InstructionKind decode_opcode(uint32_t code) {
   OpcodeFields fields(code);
-  typedef InstructionKind IK;
-  switch (fields.op()) {
-    case 0b000000:
-      return decode_special(fields);
-    case 0b000001:
-      return decode_regimm(fields);
-    // J      010
-    // JAL    011
-    case 0b000100:
-      return IK::BEQ;
-    case 0b000101:
-      return IK::BNE;
-    case 0b000110:
-      return IK::BLEZ;
-    case 0b000111:
-      return IK::BGTZ;
-    // ADDI  1000
-    case 0b001001:
-      return IK::ADDIU;
-    case 0b001010:
-      return IK::SLTI;
-    case 0b001011:
-      return IK::SLTIU;
-    case 0b001100:
-      return IK::ANDI;
-    case 0b001101:
-      return IK::ORI;
-    case 0b001110:
-      return IK::XORI;
-    case 0b001111:
-      ASSERT(fields.rs() == 0);
-      return IK::LUI;
-    case 0b010000:
-      return decode_cop0(fields);
-    case 0b010001:
-      return decode_cop1(fields);
-    case 0b010010:
-      return decode_cop2(fields);
-    //     010011:
-    //  reserved
-    case 0b010100:
-      return IK::BEQL;
-    case 0b010101:
-      return IK::BNEL;
-    //     010110
-    //  blezl
-    case 0b010111:
-      ASSERT(fields.rt() == 0);
-      return IK::BGTZL;
-    //   0b011000:
-    //  daddi
-    case 0b011001:
-      return IK::DADDIU;
-    case 0b011010:
-      return IK::LDL;
-    case 0b011011:
-      return IK::LDR;
-    case 0b011100:
-      return decode_mmi(fields);
-    //   0b011101:
-    // reserved
-    case 0b011110:
-      return IK::LQ;
-    case 0b011111:
-      return IK::SQ;
-    case 0b100000:
-      return IK::LB;
-    case 0b100001:
-      return IK::LH;
-    case 0b100010:
-      return IK::LWL;
-    case 0b100011:
-      return IK::LW;
-    case 0b100100:
-      return IK::LBU;
-    case 0b100101:
-      return IK::LHU;
-    case 0b100110:
-      return IK::LWR;
-    case 0b100111:
-      return IK::LWU;
-    case 0b101000:
-      return IK::SB;
-    case 0b101001:
-      return IK::SH;
-    case 0b101011:
-      return IK::SW;
-    // SDL
-    // SDR
-    // SWR
-    case 0b101111:
-      return decode_cache(fields);
-
-    // unsupported
-    case 0b110001:
-      return IK::LWC1;
-    // unsupported
-    case 0b110011:
-      return IK::PREF;
-    // unsupported
-    // unsupported
-    case 0b110110:
-      return IK::LQC2;
-    case 0b110111:
-      return IK::LD;
-    case 0b111001:
-      return IK::SWC1;
-    case 0b111110:
-      return IK::SQC2;
-    case 0b111111:
-      return IK::SD;
-    default:
-      ASSERT(false);
-      return IK::UNKNOWN;
-      break;
+  const auto& entry = primary_opcodes[fields.op()];
+  if (entry.decode) {
+    return entry.decode(fields);
   }
+  ASSERT(entry.kind != InstructionKind::UNKNOWN);
+  return entry.kind;
 }
 
 /*!
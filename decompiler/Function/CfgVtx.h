@@ -338,13 +338,16 @@ class ControlFlowGraph {
   bool clean_up_asm_branches();
 
   /*!
-   * Apply a function f to each top-level vertex.
-   * If f returns false, stops.
+   * Apply a function f to each top-level vertex, in the order they were allocated.
+   * If f returns false, stops. Vertices allocated by f aren't visited.
    */
   template <typename Func>
   void for_each_top_level_vtx(Func f) {
-    for (auto* x : m_node_pool) {
-      if (!x->parent && x != entry() && x != exit()) {
+    remove_claimed_from_top_level();
+    size_t count = m_top_level.size();
+    for (size_t i = 0; i < count; i++) {
+      auto* x = m_top_level[i];
+      if (!x->parent) {
         if (!f(x)) {
           return;
         }
@@ -362,6 +365,7 @@ class ControlFlowGraph {
   T* alloc(Args&&... args) {
     T* new_obj = new T(std::forward<Args>(args)...);
     m_node_pool.push_back(new_obj);
+    m_top_level.push_back(new_obj);
     new_obj->uid = m_uid++;
     return new_obj;
   }
@@ -380,7 +384,12 @@ class ControlFlowGraph {
   bool is_goto_not_end_and_unreachable(CfgVtx* b0, CfgVtx* b1);
   bool is_infinite_continue(CfgVtx* b0);
   std::vector<BlockVtx*> m_blocks;   // all block nodes, in order.
+  void remove_claimed_from_top_level();
+
   std::vector<CfgVtx*> m_node_pool;  // all nodes allocated
+  // nodes that may not have a parent yet, in allocation order. Doesn't include entry and exit.
+  // The matchers scan this over and over, so claimed nodes are removed as we go.
+  std::vector<CfgVtx*> m_top_level;
   EntryVtx* m_entry;                 // the entry vertex
   ExitVtx* m_exit;                   // the exit vertex
   int m_uid = 0;
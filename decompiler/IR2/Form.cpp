@@ -19,15 +19,23 @@ namespace decompiler {
 ///////////////////
 
 FormPool::~FormPool() {
+  // the memory is freed with the blocks.
   for (auto& x : m_forms) {
-    delete x;
+    x->~Form();
   }
 
   for (auto& x : m_elements) {
-    delete x;
+    x->~FormElement();
   }
 }
 
+void FormPool::alloc_block(size_t min_size) {
+  size_t size = std::max(kBlockSize, min_size);
+  m_blocks.emplace_back(new u8[size]);
+  m_block_ptr = m_blocks.back().get();
+  m_block_end = m_block_ptr + size;
+}
+
 ///////////////////
 // FormElement
 ///////////////////
@@ -8,6 +8,7 @@
 #include "common/goos/Object.h"
 #include "common/math/Vector.h"
 #include "common/type_system/TypeSystem.h"
+#include "common/util/SmallVector.h"
 #include "common/type_system/state.h"
 
 #include "decompiler/Disasm/DecompilerLabel.h"
@@ -1866,6 +1867,9 @@ class ResLumpMacroElement : public FormElement {
   TypeSpec m_result_type;
 };
 
+// Most forms have a single element, so it is stored inline instead of in a separate allocation.
+using FormElementList = cu::SmallVector<FormElement*, 1>;
+
 /*!
  * A Form is a wrapper around one or more FormElements.
  * This is done for two reasons:
@@ -1881,6 +1885,13 @@ class Form {
   }
 
   Form(FormElement* parent, const std::vector<FormElement*>& sequence)
+      : parent_element(parent), m_elements(sequence.begin(), sequence.end()) {
+    for (auto& x : sequence) {
+      x->parent_form = this;
+    }
+  }
+
+  Form(FormElement* parent, const FormElementList& sequence)
       : parent_element(parent), m_elements(sequence) {
     for (auto& x : sequence) {
       x->parent_form = this;
@@ -1958,8 +1969,8 @@ class Form {
     m_elements.pop_back();
   }
 
-  const std::vector<FormElement*>& elts() const { return m_elements; }
-  std::vector<FormElement*>& elts() { return m_elements; }
+  const FormElementList& elts() const { return m_elements; }
+  FormElementList& elts() { return m_elements; }
   void claim_all_children() {
     for (auto elt : elts()) {
       elt->parent_form = this;
@@ -1999,7 +2010,7 @@ class Form {
   FormElement* parent_element = nullptr;
 
  private:
-  std::vector<FormElement*> m_elements;
+  FormElementList m_elements;
 };
 
 class CfgVtx;
@@ -2012,49 +2023,57 @@ class CfgVtx;
  */
 class FormPool {
  public:
+  FormPool() = default;
+  FormPool(const FormPool&) = delete;
+  FormPool& operator=(const FormPool&) = delete;
+
   template <typename T, class... Args>
   T* alloc_element(Args&&... args) {
-    auto elt = new T(std::forward<Args>(args)...);
+    auto elt = construct<T>(std::forward<Args>(args)...);
     m_elements.emplace_back(elt);
     return elt;
   }
 
   template <typename T, class... Args>
   Form* alloc_single_element_form(FormElement* parent, Args&&... args) {
-    auto elt = new T(std::forward<Args>(args)...);
-    m_elements.emplace_back(elt);
+    auto elt = alloc_element<T>(std::forward<Args>(args)...);
     auto form = alloc_single_form(parent, elt);
     return form;
   }
 
   template <typename T, class... Args>
   Form* form(Args&&... args) {
-    auto elt = new T(std::forward<Args>(args)...);
-    m_elements.emplace_back(elt);
+    auto elt = alloc_element<T>(std::forward<Args>(args)...);
     auto form = alloc_single_form(nullptr, elt);
     return form;
   }
 
   Form* alloc_single_form(FormElement* parent, FormElement* elt) {
-    auto form = new Form(parent, elt);
+    auto form = construct<Form>(parent, elt);
     m_forms.push_back(form);
     return form;
   }
 
-  Form* alloc_sequence_form(FormElement* parent, const std::vector<FormElement*> sequence) {
-    auto form = new Form(parent, sequence);
+  Form* alloc_sequence_form(FormElement* parent, const std::vector<FormElement*>& sequence) {
+    auto form = construct<Form>(parent, sequence);
     m_forms.push_back(form);
     return form;
   }
 
-  Form* acquire(std::unique_ptr<Form> form_ptr) {
-    Form* form = form_ptr.release();
+  Form* alloc_sequence_form(FormElement* parent, const FormElementList& sequence) {
+    auto form = construct<Form>(parent, sequence);
     m_forms.push_back(form);
     return form;
   }
 
+  Form* acquire(std::unique_ptr<Form> form_ptr) {
+    Form* form = form_ptr.get();
+    m_acquired_forms.push_back(std::move(form_ptr));
+    return form;
+  }
+
   Form* alloc_empty_form() {
-    Form* form = new Form;
+    Form* form = construct<Form>();
     m_forms.push_back(form);
     return form;
   }
@@ -2075,8 +2094,34 @@ class FormPool {
   ~FormPool();
 
  private:
+  // Forms and elements are bump allocated from large blocks that are all freed with the pool,
+  // instead of being allocated one at a time. Their destructors are run by ~FormPool.
+  static constexpr size_t kBlockSize = 64 * 1024;
+
+  void* alloc_bytes(size_t size, size_t align) {
+    auto ptr = (u8*)(((uintptr_t)m_block_ptr + align - 1) & ~(uintptr_t)(align - 1));
+    if (!m_block_ptr || ptr + size > m_block_end) {
+      alloc_block(size + align);
+      ptr = (u8*)(((uintptr_t)m_block_ptr + align - 1) & ~(uintptr_t)(align - 1));
+    }
+    m_block_ptr = ptr + size;
+    return ptr;
+  }
+
+  template <typename T, class... Args>
+  T* construct(Args&&... args) {
+    return new (alloc_bytes(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+  }
+
+  void alloc_block(size_t min_size);
+
+  std::vector<std::unique_ptr<u8[]>> m_blocks;
+  u8* m_block_ptr = nullptr;
+  u8* m_block_end = nullptr;
+
   std::vector<Form*> m_forms;
   std::vector<FormElement*> m_elements;
+  std::vector<std::unique_ptr<Form>> m_acquired_forms;
   std::unordered_map<const CfgVtx*, Form*> m_vtx_to_form_cache;
 };
 
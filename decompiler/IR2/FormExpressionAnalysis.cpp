@@ -612,7 +612,7 @@ void Form::update_children_from_stack(const Env& env,
     x->parent_form = this;
   }
 
-  m_elements = new_elts;
+  m_elements.assign(new_elts.begin(), new_elts.end());
 }
 
 /*!
@@ -370,10 +370,12 @@ std::vector<FormElement*> FormStack::rewrite(FormPool& pool, const Env& env) con
   return result;
 }
 
-std::optional<RegisterAccess> rewrite_to_get_var(std::vector<FormElement*>& default_result,
-                                                 FormPool& pool,
-                                                 const RegisterAccess& var,
-                                                 const Env& env) {
+namespace {
+template <typename List>
+std::optional<RegisterAccess> rewrite_list_to_get_var(List& default_result,
+                                                      FormPool& pool,
+                                                      const RegisterAccess& var,
+                                                      const Env& env) {
   bool keep_going = true;
   RegisterAccess var_to_get = var;
 
@@ -406,7 +408,8 @@ std::optional<RegisterAccess> rewrite_to_get_var(std::vector<FormElement*>& defa
         result = {pool.alloc_element<CastElement>(
             *cast, pool.alloc_sequence_form(nullptr, last_op_as_set->src()->elts()))};
       } else {
-        result = last_op_as_set->src()->elts();
+        const auto& src_elts = last_op_as_set->src()->elts();
+        result.assign(src_elts.begin(), src_elts.end());
       }
       result_access = last_op_as_set->dst();
     }
@@ -423,6 +426,21 @@ std::optional<RegisterAccess> rewrite_to_get_var(std::vector<FormElement*>& defa
     return result_access;
   }
 }
+}  // namespace
+
+std::optional<RegisterAccess> rewrite_to_get_var(std::vector<FormElement*>& default_result,
+                                                 FormPool& pool,
+                                                 const RegisterAccess& var,
+                                                 const Env& env) {
+  return rewrite_list_to_get_var(default_result, pool, var, env);
+}
+
+std::optional<RegisterAccess> rewrite_to_get_var(FormElementList& default_result,
+                                                 FormPool& pool,
+                                                 const RegisterAccess& var,
+                                                 const Env& env) {
+  return rewrite_list_to_get_var(default_result, pool, var, env);
+}
 
 std::vector<FormElement*> rewrite_to_get_var(FormStack& stack,
                                              FormPool& pool,
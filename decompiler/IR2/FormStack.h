@@ -4,6 +4,7 @@
 
 #include "decompiler/Disasm/Register.h"
 #include "decompiler/IR2/AtomicOp.h"
+#include "decompiler/IR2/Form.h"
 
 namespace decompiler {
 class Form;
@@ -140,6 +141,10 @@ std::optional<RegisterAccess> rewrite_to_get_var(std::vector<FormElement*>& defa
                                                  FormPool& pool,
                                                  const RegisterAccess& var,
                                                  const Env& env);
+std::optional<RegisterAccess> rewrite_to_get_var(FormElementList& default_result,
+                                                 FormPool& pool,
+                                                 const RegisterAccess& var,
+                                                 const Env& env);
 std::vector<FormElement*> rewrite_to_get_var(FormStack& stack,
                                              FormPool& pool,
                                              const RegisterAccess& var,
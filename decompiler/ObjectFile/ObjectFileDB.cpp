@@ -9,6 +9,8 @@
 
 #include <algorithm>
 #include <cstring>
+#include <deque>
+#include <future>
 #include <map>
 #include <set>
 
@@ -19,6 +21,7 @@
 #include "common/util/BinaryReader.h"
 #include "common/util/BitUtils.h"
 #include "common/util/FileUtil.h"
+#include "common/util/ThreadPool.h"
 #include "common/util/Timer.h"
 #include "common/util/crc32.h"
 #include "common/util/dgo_util.h"
@@ -123,7 +126,7 @@ ObjectFileDB::ObjectFileDB(const std::vector<fs::path>& _dgos,
   Timer timer;
 
   lg::info("-Loading types...");
-  dts.parse_type_defs({config.all_types_file});
+  dts.parse_type_defs({config.all_types_file}, config.decompile_cache);
 
   if (!obj_file_name_map_file.empty()) {
     lg::info("-Loading obj name map file...");
@@ -137,9 +140,21 @@ ObjectFileDB::ObjectFileDB(const std::vector<fs::path>& _dgos,
   }
 
   lg::info("-Loading {} DGOs...", _dgos.size());
+  // Reading and decompressing a DGO is mostly waiting on the disk, so the next few DGOs are loaded
+  // on other threads while this one is split into object files. The splitting has to happen in
+  // order, because object file names depend on the order they are seen in.
+  constexpr size_t kDgoReadAhead = 4;
+  std::deque<std::future<DgoFileData>> loading;
+  size_t next_to_load = 0;
   for (auto& dgo : _dgos) {
+    while (next_to_load < _dgos.size() && loading.size() < kDgoReadAhead) {
+      loading.push_back(std::async(std::launch::async,
+                                   [&path = _dgos[next_to_load++]] { return DgoFileData(path); }));
+    }
+    auto loaded = std::move(loading.front());
+    loading.pop_front();
     try {
-      get_objs_from_dgo(dgo, config);
+      get_objs_from_dgo(dgo, loaded.get(), config);
     } catch (std::runtime_error& e) {
       lg::warn("Error when reading DGOs: {} on {}", e.what(), dgo.string());
     }
@@ -262,15 +277,11 @@ void ObjectFileDB::load_map_file(const std::string& map_data) {
 /*!
  * Load the objects stored in the given DGO into the ObjectFileDB
  */
-void ObjectFileDB::get_objs_from_dgo(const fs::path& filename, const Config& config) {
-  auto dgo_data = file_util::read_binary_file(filename);
-  stats.total_dgo_bytes += dgo_data.size();
-
-  if (file_util::dgo_header_is_compressed(dgo_data)) {
-    dgo_data = file_util::decompress_dgo(dgo_data);
-  }
-
-  BinaryReader reader(dgo_data);
+void ObjectFileDB::get_objs_from_dgo(const fs::path& filename,
+                                     const DgoFileData& dgo,
+                                     const Config& config) {
+  stats.total_dgo_bytes += dgo.file_size();
+  BinaryReader reader(dgo.data(), dgo.size());
   auto header = reader.read<DgoHeader>();
 
   auto dgo_base_name = filename.filename().string();
@@ -707,18 +718,28 @@ std::string ObjectFileDB::process_tpages(TextureDB& tex_db, const fs::path& outp
   Timer timer;
 
   std::string result;
+  std::vector<ObjectFileData*> tpages;
   for_each_obj([&](ObjectFileData& data) {
     if (data.name_in_dgo.substr(0, tpage_string.length()) == tpage_string) {
-      auto statistics = process_tpage(data, tex_db, output_path);
-      total += statistics.total_textures;
-      success += statistics.successful_textures;
-      total_px += statistics.num_px;
+      tpages.push_back(&data);
     } else if (data.name_in_dgo == "dir-tpages") {
       result = process_dir_tpages(data).to_source();
       tpage_dir_count++;
     }
   });
 
+  // decoding and writing PNGs is independent per tpage, so it's done in parallel. The tpages are
+  // added to the texture db afterward, in the original order.
+  std::vector<DecodedTPage> decoded(tpages.size());
+  parallel_for(tpages.size(), [&](int i) { decoded[i] = decode_tpage(*tpages[i], output_path); });
+
+  for (auto& tpage : decoded) {
+    total += tpage.stats.total_textures;
+    success += tpage.stats.successful_textures;
+    total_px += tpage.stats.num_px;
+    add_tpage_to_db(std::move(tpage), tex_db);
+  }
+
   ASSERT(tpage_dir_count <= 1);
 
   lg::info("Processed {} / {} textures ({} px) {:.2f}% in {:.2f} ms", success, total, total_px,
@@ -7,6 +7,8 @@
  * (there may be different object files with the same name sometimes)
  */
 
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -15,11 +17,15 @@
 
 #include "common/common_types.h"
 #include "common/util/Assert.h"
+#include "common/util/DgoReader.h"
 #include "common/util/FileUtil.h"
+#include "common/util/Timer.h"
 
 #include "decompiler/analysis/symbol_def_map.h"
 #include "decompiler/data/TextureDB.h"
 #include "decompiler/util/DecompilerTypeSystem.h"
+#include "decompiler/util/OutputWriter.h"
+#include "decompiler/util/PassProfiler.h"
 
 #include "third-party/fmt/core.h"
 
@@ -142,6 +148,7 @@ struct LetRewriteStats {
     ja += other.ja;
     set_vector += other.set_vector;
     set_vector2 += other.set_vector2;
+    set_vector3 += other.set_vector3;
     case_no_else += other.case_no_else;
     case_with_else += other.case_with_else;
     unused += other.unused;
@@ -153,6 +160,7 @@ struct LetRewriteStats {
     rand_float_gen += other.rand_float_gen;
     set_let += other.set_let;
     with_dma_buf_add_bucket += other.with_dma_buf_add_bucket;
+    dma_buffer_add_gs_set += other.dma_buffer_add_gs_set;
     return *this;
   }
 };
@@ -261,7 +269,7 @@ class ObjectFileDB {
                             TypeSpec* result);
 
   void load_map_file(const std::string& map_data);
-  void get_objs_from_dgo(const fs::path& filename, const Config& config);
+  void get_objs_from_dgo(const fs::path& filename, const DgoFileData& dgo, const Config& config);
   void add_obj_from_dgo(const std::string& obj_name,
                         const std::string& name_in_dgo,
                         const uint8_t* obj_data,
@@ -359,7 +367,14 @@ class ObjectFileDB {
     int fn = 0;
     if (data.linked_data.segments == 3) {
       for (size_t j = data.linked_data.functions_by_seg.at(seg).size(); j-- > 0;) {
-        f(data.linked_data.functions_by_seg.at(seg).at(j));
+        auto& func = data.linked_data.functions_by_seg.at(seg).at(j);
+        if (profiler.timing_functions()) {
+          Timer timer;
+          f(func);
+          profiler.add_function_time(func.name(), data.to_unique_name(), timer.getMs());
+        } else {
+          f(func);
+        }
         fn++;
       }
     }
@@ -381,11 +396,18 @@ class ObjectFileDB {
     uint32_t unique_obj_files = 0;
     uint32_t unique_obj_bytes = 0;
   } stats;
+  // guards stats.let, which is updated from analysis threads.
+  std::mutex stats_mutex;
+
+  // per-pass timing of the IR2 passes, for benchmarking. Disabled unless enabled by the caller.
+  PassProfiler profiler;
 
   GameVersion version() const { return m_version; }
 
  private:
   GameVersion m_version;
+  // writes the IR2 results during analyze_functions_ir2, if there's an output folder.
+  std::unique_ptr<OutputWriter> m_output_writer;
 };
 
 std::string print_art_elt_for_dump(const std::string& group_name, const std::string& name, int idx);
@@ -5,11 +5,19 @@
 
 #include "ObjectFileDB.h"
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
 #include "common/goos/PrettyPrinter.h"
 #include "common/link_types.h"
 #include "common/log/log.h"
 #include "common/util/FileUtil.h"
+#include "common/util/SimpleThreadGroup.h"
 #include "common/util/Timer.h"
+#include "common/util/crc32.h"
+#include "common/util/string_util.h"
+#include "common/versions/versions.h"
 
 #include "decompiler/IR2/Form.h"
 #include "decompiler/analysis/analyze_inspect_method.h"
@@ -43,7 +51,7 @@ void ObjectFileDB::process_object_file_data(
   ir2_do_segment_analysis_phase1(TOP_LEVEL_SEGMENT, config, data);
   ir2_do_segment_analysis_phase1(DEBUG_SEGMENT, config, data);
   ir2_do_segment_analysis_phase1(MAIN_SEGMENT, config, data);
-  ir2_setup_labels(config, data);
+  profiler.run("setup_labels", [&] { ir2_setup_labels(config, data); });
   ir2_do_segment_analysis_phase2(TOP_LEVEL_SEGMENT, config, data);
   if (data.linked_data.functions_by_seg.size() == 3) {
     enum { DEFPART, DEFSTATE, DEFSKELGROUP } step = DEFPART;
@@ -71,13 +79,15 @@ void ObjectFileDB::process_object_file_data(
   ir2_do_segment_analysis_phase2(DEBUG_SEGMENT, config, data);
   ir2_do_segment_analysis_phase2(MAIN_SEGMENT, config, data);
 
-  ir2_insert_anonymous_functions(DEBUG_SEGMENT, data);
-  ir2_insert_anonymous_functions(MAIN_SEGMENT, data);
-  ir2_insert_anonymous_functions(TOP_LEVEL_SEGMENT, data);
+  profiler.run("insert_anonymous_functions", [&] {
+    ir2_insert_anonymous_functions(DEBUG_SEGMENT, data);
+    ir2_insert_anonymous_functions(MAIN_SEGMENT, data);
+    ir2_insert_anonymous_functions(TOP_LEVEL_SEGMENT, data);
+  });
 
-  ir2_run_mips2c(config, data);
+  profiler.run("mips2c", [&] { ir2_run_mips2c(config, data); });
 
-  ir2_symbol_definition_map(data);
+  profiler.run("symbol_definition_map", [&] { ir2_symbol_definition_map(data); });
 
   // TODO - insert the game_name into the import line automatically
   // instead of `goal_src/jak1/import/something.gc`
@@ -90,12 +100,14 @@ void ObjectFileDB::process_object_file_data(
     imports = imports_it->second;
   }
 
-  if (!output_dir.string().empty()) {
-    ir2_write_results(output_dir, config, imports, data);
-  } else {
-    data.output_with_skips = ir2_final_out(data, imports, skip_functions);
-    data.full_output = ir2_final_out(data, imports, {});
-  }
+  profiler.run("write_results", [&] {
+    if (!output_dir.string().empty()) {
+      ir2_write_results(output_dir, config, imports, data);
+    } else {
+      data.output_with_skips = ir2_final_out(data, imports, skip_functions);
+      data.full_output = ir2_final_out(data, imports, {});
+    }
+  });
 
   if (!config.generate_all_types) {
     // this frees ir2 memory, but means future passes can't look back on this function.
@@ -117,6 +129,145 @@ void ObjectFileDB::process_object_file_data(
   lg::info("Done in {:.2f}ms", file_timer.getMs());
 }
 
+namespace {
+constexpr int IR2_CACHE_VERSION = 1;
+
+class CacheHasher {
+ public:
+  void add_word(u64 x) { m_data.insert(m_data.end(), (u8*)&x, (u8*)(&x + 1)); }
+  void add_string(const std::string& str) {
+    add_word(str.size());
+    m_data.insert(m_data.end(), str.begin(), str.end());
+  }
+  u64 hash() const {
+    return ((u64)crc32(m_data.data(), m_data.size()) << 32) | (u32)m_data.size();
+  }
+
+ private:
+  std::vector<u8> m_data;
+};
+
+/*!
+ * Hash of everything outside of the config that can change the output of any object file: the
+ * decompiler itself, the types of symbols (including global functions found in other object
+ * files), and the art group info.
+ */
+u64 ir2_cache_global_hash(const Config& config, const DecompilerTypeSystem& dts) {
+  CacheHasher hasher;
+  hasher.add_word(IR2_CACHE_VERSION);
+  hasher.add_string(build_revision());
+  hasher.add_word(config.global_hash);
+
+  std::vector<std::string> lines;
+  for (const auto& [name, type] : dts.symbol_types) {
+    lines.push_back(fmt::format("sym {} {}", name, type.print()));
+  }
+  for (const auto& [file, elts] : dts.art_group_info) {
+    for (const auto& [idx, name] : elts) {
+      lines.push_back(fmt::format("art {} {} {}", file, idx, name));
+    }
+  }
+  std::sort(lines.begin(), lines.end());
+  for (const auto& line : lines) {
+    hasher.add_string(line);
+  }
+  return hasher.hash();
+}
+
+/*!
+ * Remembers what each object file was analyzed from, and what it wrote. An object file is up to
+ * date if its data, the config for it and its functions, and the global hash are all the same as
+ * last time, and its output files haven't changed size since.
+ */
+class IR2Cache {
+ public:
+  void load(const fs::path& path, u64 global_hash) {
+    m_path = path;
+    m_global_hash = global_hash;
+    if (!fs::exists(path)) {
+      return;
+    }
+    for (auto& line : str_util::split(file_util::read_text_file(path))) {
+      auto parts = str_util::split(line, ' ');
+      if (parts.size() != 3) {
+        continue;
+      }
+      Entry entry;
+      entry.key = std::stoull(parts[0], nullptr, 16);
+      entry.outputs = std::stoull(parts[1], nullptr, 16);
+      m_entries[parts[2]] = entry;
+    }
+  }
+
+  bool up_to_date(const ObjectFileData& data, const Config& config, const fs::path& output_dir) {
+    const auto name = data.to_unique_name();
+    const u64 key = object_key(data, config);
+    m_keys[name] = key;
+    auto it = m_entries.find(name);
+    return it != m_entries.end() && it->second.key == key &&
+           it->second.outputs == outputs_hash(data, output_dir);
+  }
+
+  void update(const ObjectFileData& data, const fs::path& output_dir) {
+    const auto name = data.to_unique_name();
+    m_entries[name] = {m_keys.at(name), outputs_hash(data, output_dir)};
+  }
+
+  void save() {
+    std::string text;
+    for (auto& [name, entry] : m_entries) {
+      text += fmt::format("{:016x} {:016x} {}\n", entry.key, entry.outputs, name);
+    }
+    try {
+      file_util::write_text_file(m_path, text);
+    } catch (std::exception& e) {
+      lg::warn("Failed to save decompile cache {}: {}", m_path.string(), e.what());
+    }
+  }
+
+ private:
+  struct Entry {
+    u64 key = 0;
+    u64 outputs = 0;
+  };
+
+  u64 object_key(const ObjectFileData& data, const Config& config) const {
+    CacheHasher hasher;
+    auto add_config = [&](const std::string& name) {
+      hasher.add_string(name);
+      auto it = config.hash_by_name.find(name);
+      hasher.add_word(it == config.hash_by_name.end() ? 0 : it->second);
+    };
+    hasher.add_word(m_global_hash);
+    hasher.add_word(data.record.hash);
+    hasher.add_word(data.data.size());
+    add_config(data.to_unique_name());
+    for (const auto& seg_functions : data.linked_data.functions_by_seg) {
+      for (const auto& func : seg_functions) {
+        add_config(func.name());
+        hasher.add_string(func.type.print());
+      }
+    }
+    return hasher.hash();
+  }
+
+  static u64 outputs_hash(const ObjectFileData& data, const fs::path& output_dir) {
+    CacheHasher hasher;
+    for (const auto& suffix : {"_ir2.asm", "_disasm.gc"}) {
+      auto path = output_dir / (data.to_unique_name() + suffix);
+      hasher.add_word(fs::exists(path) ? fs::file_size(path) : -1);
+    }
+    return hasher.hash();
+  }
+
+  fs::path m_path;
+  u64 m_global_hash = 0;
+  std::unordered_map<std::string, Entry> m_entries;
+  // the keys for the object files in this run
+  std::unordered_map<std::string, u64> m_keys;
+};
+}  // namespace
+
 /*!
  * Main IR2 analysis pass.
  * At this point, we assume that the files are loaded and we've run find_code to locate all
@@ -129,27 +280,103 @@ void ObjectFileDB::analyze_functions_ir2(
     const std::optional<std::function<void()>> postfile_callback,
     const std::unordered_set<std::string>& skip_functions,
     const std::unordered_map<std::string, std::unordered_set<std::string>>& skip_states) {
-  int total_file_count = 0;
-  for (auto& f : obj_files_by_name) {
-    total_file_count += f.second.size();
+  std::vector<ObjectFileData*> objs;
+  for_each_obj([&](ObjectFileData& data) { objs.push_back(&data); });
+
+  // the cache only knows about the output files, so it can't be used when the caller wants the
+  // analysis results.
+  const bool use_cache = config.decompile_cache && !output_dir.empty() && !prefile_callback &&
+                         !postfile_callback && skip_functions.empty() && skip_states.empty() &&
+                         !config.generate_all_types && !config.generate_symbol_definition_map;
+  IR2Cache cache;
+  if (use_cache) {
+    cache.load(output_dir / "ir2-cache.txt", ir2_cache_global_hash(config, dts));
+    size_t total = objs.size();
+    objs.erase(std::remove_if(objs.begin(), objs.end(),
+                              [&](const ObjectFileData* data) {
+                                return cache.up_to_date(*data, config, output_dir);
+                              }),
+               objs.end());
+    lg::info("{} of {} object files are up to date", total - objs.size(), total);
   }
-  int file_idx = 1;
-  for_each_obj([&](ObjectFileData& data) {
-    if (prefile_callback) {
-      prefile_callback.value()(data.to_unique_name());
+
+  int total_file_count = objs.size();
+  int num_threads = config.decompile_threads;
+  if (num_threads <= 0) {
+    num_threads = std::max(1, (int)std::thread::hardware_concurrency());
+  }
+  num_threads = std::min(num_threads, std::max(1, total_file_count));
+
+  if (!output_dir.empty()) {
+    m_output_writer = std::make_unique<OutputWriter>(4, config.skip_unchanged_output);
+  }
+
+  if (num_threads == 1 || prefile_callback || postfile_callback) {
+    int file_idx = 1;
+    for (auto* data : objs) {
+      if (prefile_callback) {
+        prefile_callback.value()(data->to_unique_name());
+      }
+      lg::info("[{:3d}/{}]------ {}", file_idx++, total_file_count, data->to_unique_name());
+      process_object_file_data(*data, output_dir, config, skip_functions, skip_states);
+      if (postfile_callback) {
+        postfile_callback.value()();
+      }
     }
-    lg::info("[{:3d}/{}]------ {}", file_idx++, total_file_count, data.to_unique_name());
-    process_object_file_data(data, output_dir, config, skip_functions, skip_states);
-    if (postfile_callback) {
-      postfile_callback.value()();
+  } else {
+    // Object files are independent once the top level pass has run: each thread takes the next
+    // unprocessed file. The per-file output doesn't depend on the order files are finished in.
+    lg::info("Analyzing {} object files on {} threads", objs.size(), num_threads);
+
+    std::atomic<int> next_obj = 0;
+    std::atomic<int> file_idx = 1;
+    std::vector<std::exception_ptr> errors(objs.size());
+    SimpleThreadGroup threads;
+    threads.run(
+        [&](int) {
+          for (int i = next_obj++; i < (int)objs.size(); i = next_obj++) {
+            lg::info("[{:3d}/{}]------ {}", file_idx++, total_file_count,
+                     objs[i]->to_unique_name());
+            try {
+              process_object_file_data(*objs[i], output_dir, config, skip_functions, skip_states);
+            } catch (...) {
+              errors[i] = std::current_exception();
+            }
+          }
+        },
+        num_threads, num_threads);
+    threads.join();
+    for (auto& e : errors) {
+      if (e) {
+        std::rethrow_exception(e);
+      }
     }
-  });
+  }
+
+  if (m_output_writer) {
+    // the cache looks at the output files, so they must be written first.
+    auto writer = std::move(m_output_writer);
+    writer->finish();
+    if (config.skip_unchanged_output) {
+      lg::info("Wrote {} output files, {} were unchanged", writer->files_written(),
+               writer->files_unchanged());
+    }
+  }
+
+  if (use_cache) {
+    for (auto* data : objs) {
+      cache.update(*data, output_dir);
+    }
+    cache.save();
+  }
 
   lg::info("{}", stats.let.print());
 
   if (config.generate_symbol_definition_map) {
     lg::info("Generating symbol definition map...");
-    map_builder.build_map();
+    std::vector<std::string> object_order;
+    for_each_obj([&](ObjectFileData& data) { object_order.push_back(data.to_unique_name()); });
+    map_builder.build_map(object_order);
     std::string result = map_builder.convert_to_json();
     file_util::write_text_file(output_dir / "symbol_map.json", result);
   }
@@ -158,25 +385,25 @@ void ObjectFileDB::analyze_functions_ir2(
 void ObjectFileDB::ir2_do_segment_analysis_phase1(int seg,
                                                   const Config& config,
                                                   ObjectFileData& data) {
-  ir2_basic_block_pass(seg, config, data);
-  ir2_stack_spill_slot_pass(seg, data);
-  ir2_atomic_op_pass(seg, config, data);
+  profiler.run("basic_blocks", [&] { ir2_basic_block_pass(seg, config, data); });
+  profiler.run("stack_spill_slots", [&] { ir2_stack_spill_slot_pass(seg, data); });
+  profiler.run("atomic_ops", [&] { ir2_atomic_op_pass(seg, config, data); });
 }
 
 void ObjectFileDB::ir2_do_segment_analysis_phase2(int seg,
                                                   const Config& config,
                                                   ObjectFileData& data) {
-  ir2_type_analysis_pass(seg, config, data);
-  ir2_register_usage_pass(seg, data);
-  ir2_variable_pass(seg, data);
-  ir2_cfg_build_pass(seg, data);
+  profiler.run("type_analysis", [&] { ir2_type_analysis_pass(seg, config, data); });
+  profiler.run("register_usage", [&] { ir2_register_usage_pass(seg, data); });
+  profiler.run("variables", [&] { ir2_variable_pass(seg, data); });
+  profiler.run("cfg_build", [&] { ir2_cfg_build_pass(seg, data); });
 
-  ir2_build_expressions(seg, config, data);
-  ir2_rewrite_inline_asm_instructions(seg, data);
+  profiler.run("expressions", [&] { ir2_build_expressions(seg, config, data); });
+  profiler.run("inline_asm", [&] { ir2_rewrite_inline_asm_instructions(seg, data); });
 
-  ir2_insert_lets(seg, data);
+  profiler.run("insert_lets", [&] { ir2_insert_lets(seg, data); });
 
-  ir2_add_store_errors(seg, data);
+  profiler.run("store_errors", [&] { ir2_add_store_errors(seg, data); });
 }
 
 void ObjectFileDB::ir2_setup_labels(const Config& config, ObjectFileData& data) {
@@ -430,7 +657,14 @@ void ObjectFileDB::ir2_basic_block_pass(int seg, const Config& config, ObjectFil
         asm_br_blocks = asm_lookup->second;
       }
 
-      func.cfg = build_cfg(data.linked_data, seg, func, hack, asm_br_blocks, config.game_version);
+      // timed on its own, giant state handlers can spend most of the pass here.
+      profiler.run("build_cfg", [&] {
+        Timer timer;
+        func.cfg = build_cfg(data.linked_data, seg, func, hack, asm_br_blocks, config.game_version);
+        if (profiler.timing_functions()) {
+          profiler.add_function_time(func.name(), data.to_unique_name(), timer.getMs());
+        }
+      });
       if (!func.cfg->is_fully_resolved()) {
         lg::warn("Function {} from {} failed to build control flow graph!", func.name(),
                  data.to_unique_name());
@@ -703,10 +937,11 @@ void ObjectFileDB::ir2_build_expressions(int seg, const Config& config, ObjectFi
 }
 
 void ObjectFileDB::ir2_insert_lets(int seg, ObjectFileData& data) {
+  LetRewriteStats let_stats;
   for_each_function_in_seg_in_obj(seg, data, [&](Function& func) {
     if (func.ir2.expressions_succeeded) {
       try {
-        insert_lets(func, func.ir2.env, *func.ir2.form_pool, func.ir2.top_form, stats.let);
+        insert_lets(func, func.ir2.env, *func.ir2.form_pool, func.ir2.top_form, let_stats);
       } catch (const std::exception& e) {
         const auto err = fmt::format(
             "Error while inserting lets: {}. Make sure that the return type is not "
@@ -717,6 +952,9 @@ void ObjectFileDB::ir2_insert_lets(int seg, ObjectFileData& data) {
       }
     }
   });
+
+  std::lock_guard<std::mutex> lock(stats_mutex);
+  stats.let += let_stats;
 }
 
 void ObjectFileDB::ir2_add_store_errors(int seg, ObjectFileData& data) {
@@ -765,13 +1003,15 @@ void ObjectFileDB::ir2_write_results(const fs::path& output_dir,
                                      const std::vector<std::string>& imports,
                                      ObjectFileData& obj) {
   if (obj.linked_data.has_any_functions()) {
-    auto file_text = ir2_to_file(obj, config);
-    auto file_name = output_dir / (obj.to_unique_name() + "_ir2.asm");
-    file_util::write_text_file(file_name, file_text);
-
-    auto final = ir2_final_out(obj, imports, {});
-    auto final_name = output_dir / (obj.to_unique_name() + "_disasm.gc");
-    file_util::write_text_file(final_name, final);
+    auto write = [&](const fs::path& path, std::string text) {
+      if (m_output_writer) {
+        m_output_writer->write(path, std::move(text));
+      } else {
+        file_util::write_text_file(path, text);
+      }
+    };
+    write(output_dir / (obj.to_unique_name() + "_ir2.asm"), ir2_to_file(obj, config));
+    write(output_dir / (obj.to_unique_name() + "_disasm.gc"), ir2_final_out(obj, imports, {}));
   }
 }
 
@@ -1719,7 +1719,7 @@ void convert_and_inline(FormPool& pool, Function& f, const BlockVtx* as_block, T
 void insert_cfg_into_list(FormPool& pool,
                           Function& f,
                           const CfgVtx* vtx,
-                          std::vector<FormElement*>* output) {
+                          FormElementList* output) {
   auto as_sequence = dynamic_cast<const SequenceVtx*>(vtx);
   auto as_block = dynamic_cast<const BlockVtx*>(vtx);
   if (as_sequence) {
@@ -1995,7 +1995,7 @@ void build_initial_forms(Function& function) {
   try {
     auto& pool = function.ir2.form_pool;
     auto top_level = function.cfg->get_single_top_level();
-    std::vector<FormElement*> top_level_elts;
+    FormElementList top_level_elts;
     insert_cfg_into_list(*pool, function, top_level, &top_level_elts);
     auto result = pool->alloc_sequence_form(nullptr, top_level_elts);
 
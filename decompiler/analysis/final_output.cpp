@@ -306,7 +306,7 @@ std::string write_from_top_level_form(Form* top_form,
                                       const std::unordered_set<std::string>& skip_functions,
                                       const std::vector<std::string>& imports,
                                       const Env& env) {
-  std::vector<FormElement*> forms = top_form->elts();
+  FormElementList forms = top_form->elts();
   ASSERT(!forms.empty());
 
   // remove a (none) from the end, if it exists.
@@ -2943,7 +2943,7 @@ LetStats insert_lets(const Function& func,
     }
     ASSERT(elt_idx == group.first->size());
 
-    group.first->elts() = new_body;
+    group.first->elts().assign(new_body.begin(), new_body.end());
     group.first->claim_all_children();
   }
 
@@ -11,32 +11,59 @@ void SymbolMapBuilder::add_object(const ObjectFileData& data) {
   if (data.obj_version != 3) {
     return;
   }
-  m_first_detections.emplace_back();
-  m_first_detections.back().object_file_name = data.name_from_map;
+  ObjectSymbolUses uses;
+  uses.object_file_name = data.name_from_map;
   // add load/stores from all functions
+  std::unordered_set<std::string> seen;
   for (const auto& seg_functions : data.linked_data.functions_by_seg) {
     for (const auto& function : seg_functions) {
-      add_load_store_from_function(function, &m_first_detections.back());
+      add_load_store_from_function(function, &seen, &uses);
     }
   }
 
   // add deftypes in the top level function
   const auto& top_level_functions = data.linked_data.functions_by_seg.at(TOP_LEVEL_SEGMENT);
   ASSERT(top_level_functions.size() == 1);
-  add_deftypes_from_top_level_function(top_level_functions.at(0), &m_first_detections.back());
+  add_deftypes_from_top_level_function(top_level_functions.at(0), &uses);
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_uses[data.to_unique_name()] = std::move(uses);
 }
 
-void SymbolMapBuilder::build_map() {
+void SymbolMapBuilder::build_map(const std::vector<std::string>& object_order) {
+  // find the first place we see each symbol
+  std::unordered_set<std::string> seen_symbols;
+  std::unordered_set<std::string> seen_types;
+  std::vector<ObjectSymbolList> first_detections;
+  for (const auto& obj_name : object_order) {
+    auto it = m_uses.find(obj_name);
+    if (it == m_uses.end()) {
+      continue;
+    }
+    auto& obj_info = first_detections.emplace_back();
+    obj_info.object_file_name = it->second.object_file_name;
+    for (const auto& name : it->second.loads_and_stores) {
+      if (seen_symbols.insert(name).second) {
+        obj_info.symbols.push_back({name, false});
+      }
+    }
+    for (const auto& name : it->second.types) {
+      if (seen_types.insert(name).second) {
+        obj_info.symbols.push_back({name, true});
+      }
+    }
+  }
+
   // build a map where each symbol appears only once.  If a symbol appears as both a type and a
   // load/store, then the load/store will be removed.
   m_result.clear();
-  for (auto& obj_info : m_first_detections) {
+  for (auto& obj_info : first_detections) {
     ObjectSymbolList result;
     result.object_file_name = obj_info.object_file_name;
 
     for (auto& sym_info : obj_info.symbols) {
       if (sym_info.is_type ||
-          (!sym_info.is_type && (m_seen_types.find(sym_info.name) == m_seen_types.end()))) {
+          (!sym_info.is_type && (seen_types.find(sym_info.name) == seen_types.end()))) {
         result.symbols.push_back(sym_info);
       }
     }
@@ -91,7 +118,9 @@ std::optional<std::string> get_loaded_or_stored_symbol_name(const AtomicOp* op)
 }
 }  // namespace
 
-void SymbolMapBuilder::add_load_store_from_function(const Function& f, ObjectSymbolList* output) {
+void SymbolMapBuilder::add_load_store_from_function(const Function& f,
+                                                    std::unordered_set<std::string>* seen,
+                                                    ObjectSymbolUses* output) {
   if (!f.ir2.atomic_ops_succeeded) {
     if (!f.suspected_asm) {
       // some asm functions will use mips2c which doesn't require atomic ops.
@@ -104,27 +133,18 @@ void SymbolMapBuilder::add_load_store_from_function(const Function& f, ObjectSym
 
   for (const auto& op : f.ir2.atomic_ops->ops) {
     const auto sym = get_loaded_or_stored_symbol_name(op.get());
-    if (sym) {
-      if (m_seen_symbols.find(*sym) == m_seen_symbols.end()) {
-        SymbolInfo info;
-        info.name = *sym;
-        info.is_type = false;
-        output->symbols.push_back(info);
-        m_seen_symbols.insert(*sym);
-      }
+    if (sym && seen->insert(*sym).second) {
+      output->loads_and_stores.push_back(*sym);
     }
   }
 }
 
 void SymbolMapBuilder::add_deftypes_from_top_level_function(const Function& f,
-                                                            ObjectSymbolList* output) {
+                                                            ObjectSymbolUses* output) {
+  std::unordered_set<std::string> seen;
   for (const auto& name : f.types_defined) {
-    if (m_seen_types.find(name) == m_seen_types.end()) {
-      SymbolInfo info;
-      info.name = name;
-      info.is_type = true;
-      output->symbols.push_back(info);
-      m_seen_types.insert(name);
+    if (seen.insert(name).second) {
+      output->types.push_back(name);
     }
   }
 }
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -11,8 +13,10 @@ class Function;
 
 class SymbolMapBuilder {
  public:
+  // may be called from several threads, in any order.
   void add_object(const ObjectFileData& data);
-  void build_map();
+  // object_order is the list of unique object names, in the order used to find first detections.
+  void build_map(const std::vector<std::string>& object_order);
   std::string convert_to_json() const;
 
  private:
@@ -26,13 +30,18 @@ class SymbolMapBuilder {
     std::vector<SymbolInfo> symbols;
   };
 
-  // symbols that we've seen load/store
-  std::unordered_set<std::string> m_seen_symbols;
-  // symbol that we've seen used in a deftype
-  std::unordered_set<std::string> m_seen_types;
+  // the symbols used by a single object file, each appearing once, in the order they were found.
+  struct ObjectSymbolUses {
+    std::string object_file_name;
+    // symbols that are loaded/stored
+    std::vector<std::string> loads_and_stores;
+    // symbols used in a deftype
+    std::vector<std::string> types;
+  };
 
-  // the first place we see symbols
-  std::vector<ObjectSymbolList> m_first_detections;
+  std::mutex m_mutex;
+  // by unique object name
+  std::unordered_map<std::string, ObjectSymbolUses> m_uses;
 
   // the output of this tool - a list of where symbols are "defined" meaning:
   // - if it's a type, the location of the deftype
@@ -40,8 +49,10 @@ class SymbolMapBuilder {
   // - other symbols do not appear.
   std::vector<ObjectSymbolList> m_result;
 
-  void add_load_store_from_function(const Function& f, ObjectSymbolList* output);
-  void add_deftypes_from_top_level_function(const Function& f, ObjectSymbolList* output);
+  void add_load_store_from_function(const Function& f,
+                                    std::unordered_set<std::string>* seen,
+                                    ObjectSymbolUses* output);
+  void add_deftypes_from_top_level_function(const Function& f, ObjectSymbolUses* output);
 };
 
 }  // namespace decompiler
\ No newline at end of file
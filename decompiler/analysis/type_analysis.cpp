@@ -83,6 +83,8 @@ bool run_type_analysis_ir2(const TypeSpec& my_type, DecompilerTypeSystem& dts, F
   // STEP 0 - set decompiler type system settings for this function. In config we can manually
   if (func.guessed_name.kind == FunctionName::FunctionKind::METHOD) {
     dts.type_prop_settings.current_method_type = func.guessed_name.type_name;
+  } else {
+    dts.type_prop_settings.reset();
   }
 
   if (my_type.last_arg() == TypeSpec("none")) {
@@ -1,7 +1,11 @@
 #include "config.h"
 
+#include <unordered_map>
+
 #include "common/log/log.h"
 #include "common/util/FileUtil.h"
+#include "common/util/ThreadPool.h"
+#include "common/util/crc32.h"
 #include "common/util/json_util.h"
 
 #include "decompiler/util/config_parsers.h"
@@ -12,14 +16,78 @@
 namespace decompiler {
 
 namespace {
+using ConfigJsonFiles = std::unordered_map<std::string, nlohmann::json>;
+
 /*!
- * Read an entry from cfg containing the name of a json file, and parse that file.
+ * Read the json files named by entries in cfg, and parse them. They are read at the same time on
+ * the thread pool, and the members of each one are parsed in parallel, because type_casts and
+ * label_types are big enough to be a large part of the decompiler's startup time.
  * Relative to jak-project directory.
  */
-nlohmann::json read_json_file_from_config(const nlohmann::json& json, const std::string& file_key) {
-  auto file_name = json.at(file_key).get<std::string>();
-  auto file_txt = file_util::read_text_file(file_util::get_file_path({file_name}));
-  return parse_commented_json(file_txt, file_name);
+ConfigJsonFiles read_json_files_from_config(const nlohmann::json& json) {
+  static const char* file_keys[] = {"inputs_file",
+                                     "type_casts_file",
+                                     "type_casts_merge_file",
+                                     "anonymous_function_types_file",
+                                     "anonymous_function_types_merge_file",
+                                     "var_names_file",
+                                     "label_types_file",
+                                     "label_types_merge_file",
+                                     "stack_structures_file",
+                                     "stack_structures_merge_file",
+                                     "hacks_file",
+                                     "hacks_merge_file",
+                                     "art_info_file",
+                                     "import_deps_file"};
+  std::vector<std::string> present_keys;
+  for (auto key : file_keys) {
+    if (json.contains(key)) {
+      present_keys.push_back(key);
+    }
+  }
+
+  std::vector<nlohmann::json> parsed(present_keys.size());
+  parallel_for(present_keys.size(), [&](int i) {
+    auto file_name = json.at(present_keys[i]).get<std::string>();
+    auto file_txt = file_util::read_text_file(file_util::get_file_path({file_name}));
+    parsed[i] = parse_commented_json_parallel(file_txt, file_name);
+  });
+
+  ConfigJsonFiles result;
+  for (size_t i = 0; i < present_keys.size(); i++) {
+    result[present_keys[i]] = std::move(parsed[i]);
+  }
+  return result;
+}
+
+/*!
+ * Take a parsed json file from the ones read by read_json_files_from_config.
+ */
+nlohmann::json read_json_file_from_config(ConfigJsonFiles& files, const std::string& file_key) {
+  auto it = files.find(file_key);
+  if (it == files.end()) {
+    throw std::runtime_error(fmt::format("Config is missing {}", file_key));
+  }
+  return std::move(it->second);
+}
+
+u64 hash_config_text(const std::string& text) {
+  return ((u64)crc32((const u8*)text.data(), text.size()) << 32) | (u32)text.size();
+}
+
+/*!
+ * Remember the config entry for a function or object file, so the decompile cache can tell when
+ * it changes.
+ */
+void add_name_hash(Config& config,
+                   const std::string& kind,
+                   const std::string& name,
+                   const nlohmann::json& entry) {
+  if (!config.decompile_cache) {
+    return;
+  }
+  auto& hash = config.hash_by_name[name];
+  hash = hash_config_text(fmt::format("{:016x} {} {}", hash, kind, entry.dump()));
 }
 
 Config make_config_via_json(nlohmann::json& json) {
@@ -34,7 +102,8 @@ Config make_config_via_json(nlohmann::json& json) {
   }
   config.all_types_file = json.at("all_types_file").get<std::string>();
 
-  auto inputs_json = read_json_file_from_config(json, "inputs_file");
+  auto files = read_json_files_from_config(json);
+  auto inputs_json = read_json_file_from_config(files, "inputs_file");
   config.dgo_names = inputs_json.at("dgo_names").get<std::vector<std::string>>();
   config.object_file_names = inputs_json.at("object_file_names").get<std::vector<std::string>>();
   config.str_file_names = inputs_json.at("str_file_names").get<std::vector<std::string>>();
@@ -74,10 +143,22 @@ Config make_config_via_json(nlohmann::json& json) {
   config.find_functions = json.at("find_functions").get<bool>();
   config.dump_objs = json.at("dump_objs").get<bool>();
   config.print_cfgs = json.at("print_cfgs").get<bool>();
+  if (json.contains("decompile_threads")) {
+    config.decompile_threads = json.at("decompile_threads").get<int>();
+  }
+  if (json.contains("decompile_cache")) {
+    config.decompile_cache = json.at("decompile_cache").get<bool>();
+  }
+  if (json.contains("skip_unchanged_output")) {
+    config.skip_unchanged_output = json.at("skip_unchanged_output").get<bool>();
+  }
   config.generate_symbol_definition_map = json.at("generate_symbol_definition_map").get<bool>();
   config.is_pal = json.at("is_pal").get<bool>();
   config.rip_levels = json.at("rip_levels").get<bool>();
   config.extract_collision = json.at("extract_collision").get<bool>();
+  if (json.contains("compress_textures")) {
+    config.compress_textures = json.at("compress_textures").get<bool>();
+  }
   config.generate_all_types = json.at("generate_all_types").get<bool>();
   if (json.contains("read_spools")) {
     config.read_spools = json.at("read_spools").get<bool>();
@@ -94,13 +175,14 @@ Config make_config_via_json(nlohmann::json& json) {
     config.banned_objects.insert(x);
   }
 
-  auto type_casts_json = read_json_file_from_config(json, "type_casts_file");
+  auto type_casts_json = read_json_file_from_config(files, "type_casts_file");
   if (json.contains("type_casts_merge_file")) {
-    type_casts_json.update(read_json_file_from_config(json, "type_casts_merge_file"));
+    type_casts_json.update(read_json_file_from_config(files, "type_casts_merge_file"));
   }
   for (auto& kv : type_casts_json.items()) {
     auto& function_name = kv.key();
     auto& casts = kv.value();
+    add_name_hash(config, "type_casts", function_name, casts);
     for (auto& cast : casts) {
       if (cast.at(0).is_string()) {
         auto cast_name = cast.at(0).get<std::string>();
@@ -128,22 +210,24 @@ Config make_config_via_json(nlohmann::json& json) {
     }
   }
 
-  auto anon_func_json = read_json_file_from_config(json, "anonymous_function_types_file");
+  auto anon_func_json = read_json_file_from_config(files, "anonymous_function_types_file");
   if (json.contains("anonymous_function_types_merge_file")) {
-    anon_func_json.update(read_json_file_from_config(json, "anonymous_function_types_merge_file"));
+    anon_func_json.update(read_json_file_from_config(files, "anonymous_function_types_merge_file"));
   }
   for (auto& kv : anon_func_json.items()) {
     auto& obj_file_name = kv.key();
     auto& anon_types = kv.value();
+    add_name_hash(config, "anonymous_function_types", obj_file_name, anon_types);
     for (auto& anon_type : anon_types) {
       auto id = anon_type.at(0).get<int>();
       const auto& type_name = anon_type.at(1).get<std::string>();
       config.anon_function_types_by_obj_by_id[obj_file_name][id] = type_name;
     }
   }
-  auto var_names_json = read_json_file_from_config(json, "var_names_file");
+  auto var_names_json = read_json_file_from_config(files, "var_names_file");
   for (auto& kv : var_names_json.items()) {
     auto& function_name = kv.key();
+    add_name_hash(config, "var_names", function_name, kv.value());
     auto arg = kv.value().find("args");
     if (arg != kv.value().end()) {
       for (auto& x : arg.value()) {
@@ -168,13 +252,14 @@ Config make_config_via_json(nlohmann::json& json) {
     }
   }
 
-  auto label_types_json = read_json_file_from_config(json, "label_types_file");
+  auto label_types_json = read_json_file_from_config(files, "label_types_file");
   if (json.contains("label_types_merge_file")) {
-    label_types_json.update(read_json_file_from_config(json, "label_types_merge_file"));
+    label_types_json.update(read_json_file_from_config(files, "label_types_merge_file"));
   }
   for (auto& kv : label_types_json.items()) {
     auto& obj_name = kv.key();
     auto& types = kv.value();
+    add_name_hash(config, "label_types", obj_name, types);
     for (auto& x : types) {
       const auto& name = x.at(0).get<std::string>();
       const auto& type_name = x.at(1).get<std::string>();
@@ -192,22 +277,23 @@ Config make_config_via_json(nlohmann::json& json) {
     }
   }
 
-  auto stack_structures_json = read_json_file_from_config(json, "stack_structures_file");
+  auto stack_structures_json = read_json_file_from_config(files, "stack_structures_file");
   if (json.contains("stack_structures_merge_file")) {
-    stack_structures_json.update(read_json_file_from_config(json, "stack_structures_merge_file"));
+    stack_structures_json.update(read_json_file_from_config(files, "stack_structures_merge_file"));
   }
   for (auto& kv : stack_structures_json.items()) {
     auto& func_name = kv.key();
     auto& stack_structures = kv.value();
+    add_name_hash(config, "stack_structures", func_name, stack_structures);
     config.stack_structure_hints_by_function[func_name] =
         parse_stack_structure_hints(stack_structures);
   }
 
-  auto hacks_json = read_json_file_from_config(json, "hacks_file");
+  auto hacks_json = read_json_file_from_config(files, "hacks_file");
   if (json.contains("hacks_merge_file")) {
     // NOTE - here we merge one level deeper because it's worth doing here
     // - chances are you just need to override a few individual hacks
-    const auto hack_overrides = read_json_file_from_config(json, "hacks_merge_file");
+    const auto hack_overrides = read_json_file_from_config(files, "hacks_merge_file");
     for (const auto& entry : hack_overrides.items()) {
       if (hacks_json.contains(entry.key())) {
         // If the parent json file has this, update it
@@ -267,15 +353,18 @@ Config make_config_via_json(nlohmann::json& json) {
   config.levels_to_extract = inputs_json.at("levels_to_extract").get<std::vector<std::string>>();
   config.levels_extract = json.at("levels_extract").get<bool>();
 
-  auto art_info_json = read_json_file_from_config(json, "art_info_file");
+  auto art_info_json = read_json_file_from_config(files, "art_info_file");
   config.art_groups_by_file =
       art_info_json.at("files").get<std::unordered_map<std::string, std::string>>();
   config.art_groups_by_function =
       art_info_json.at("functions").get<std::unordered_map<std::string, std::string>>();
 
-  auto import_deps = read_json_file_from_config(json, "import_deps_file");
+  auto import_deps = read_json_file_from_config(files, "import_deps_file");
   config.import_deps_by_file =
       import_deps.get<std::unordered_map<std::string, std::vector<std::string>>>();
+  for (auto& kv : import_deps.items()) {
+    add_name_hash(config, "import_deps", kv.key(), kv.value());
+  }
 
   config.write_patches = json.at("write_patches").get<bool>();
   config.apply_patches = json.at("apply_patches").get<bool>();
@@ -288,6 +377,18 @@ Config make_config_via_json(nlohmann::json& json) {
     config.object_patches.insert({obj, new_pch});
   }
 
+  if (config.decompile_cache) {
+    // options that only pick which objects to analyze, or how, don't change the output.
+    auto global_json = json;
+    for (const auto& key : {"allowed_objects", "banned_objects", "decompile_threads",
+                            "skip_unchanged_output"}) {
+      global_json.erase(key);
+    }
+    config.global_hash = hash_config_text(
+        global_json.dump() + hacks_json.dump() + art_info_json.dump() +
+        file_util::read_text_file(file_util::get_file_path({config.all_types_file})));
+  }
+
   return config;
 }
 }  // namespace
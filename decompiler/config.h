@@ -117,8 +117,15 @@ struct Config {
   bool dump_art_group_info = false;
   bool rip_levels = false;
   bool extract_collision = false;
+  bool compress_textures = false;
   bool find_functions = false;
   bool read_spools = false;
+  // number of threads used for IR2 analysis of object files, 0 to use all cores.
+  int decompile_threads = 1;
+  // skip analysis of object files whose inputs haven't changed since the last run.
+  bool decompile_cache = false;
+  // don't rewrite output files that already have the same text.
+  bool skip_unchanged_output = false;
 
   bool write_hex_near_instructions = false;
   bool hexdump_code = false;
@@ -169,6 +176,12 @@ struct Config {
   std::unordered_map<std::string, std::unordered_map<int, std::string>> art_group_info_dump;
 
   std::unordered_map<std::string, std::vector<std::string>> import_deps_by_file;
+
+  // hashes used by the decompile cache to find object files that must be analyzed again.
+  // settings that can change the output of any object file: the main config, hacks, types.
+  u64 global_hash = 0;
+  // config entries for a single function or object file: casts, variable names, labels...
+  std::unordered_map<std::string, u64> hash_by_name;
 };
 
 Config read_config_file(const fs::path& path_to_config_file,
@@ -1,7 +1,10 @@
 #include "TextureDB.h"
 
+#include <algorithm>
+
 #include "common/log/log.h"
 #include "common/util/Assert.h"
+#include "common/util/ThreadPool.h"
 
 #include "third-party/fmt/core.h"
 #define STBI_WINDOWS_UTF8
@@ -11,7 +14,7 @@ namespace decompiler {
 
 void TextureDB::add_texture(u32 tpage,
                             u32 texid,
-                            const std::vector<u32>& data,
+                            std::vector<u32> data,
                             u16 w,
                             u16 h,
                             const std::string& tex_name,
@@ -38,7 +41,7 @@ void TextureDB::add_texture(u32 tpage,
     ASSERT(existing_tex->second.dest == dest);
   } else {
     auto& new_tex = textures[combo_id];
-    new_tex.rgba_bytes = data;
+    new_tex.rgba_bytes = std::move(data);
     new_tex.name = tex_name;
     new_tex.w = w;
     new_tex.h = h;
@@ -53,23 +56,31 @@ void TextureDB::add_texture(u32 tpage,
 
 void TextureDB::replace_textures(const fs::path& path) {
   fs::path base_path(path);
+  // find the replacements first, then load the PNGs in parallel. Each only changes its own texture.
+  std::vector<std::pair<TextureData*, fs::path>> replacements;
   for (auto& tex : textures) {
     fs::path full_path = base_path / tpage_names.at(tex.second.page) / (tex.second.name + ".png");
     if (fs::exists(full_path)) {
-      lg::info("Replacing {}", full_path.string().c_str());
-      int w, h;
-      auto data = stbi_load(full_path.string().c_str(), &w, &h, 0, 4);  // rgba channels
-      if (!data) {
-        lg::warn("failed to load PNG file: {}", full_path.string().c_str());
-        continue;
-      }
-      tex.second.rgba_bytes.resize(w * h);
-      memcpy(tex.second.rgba_bytes.data(), data, w * h * 4);
-      tex.second.w = w;
-      tex.second.h = h;
-      stbi_image_free(data);
+      replacements.emplace_back(&tex.second, full_path);
     }
   }
+
+  parallel_for(replacements.size(), [&](int i) {
+    auto& tex = *replacements[i].first;
+    auto& full_path = replacements[i].second;
+    lg::info("Replacing {}", full_path.string().c_str());
+    int w, h;
+    auto data = stbi_load(full_path.string().c_str(), &w, &h, 0, 4);  // rgba channels
+    if (!data) {
+      lg::warn("failed to load PNG file: {}", full_path.string().c_str());
+      return;
+    }
+    tex.rgba_bytes.resize(w * h);
+    memcpy(tex.rgba_bytes.data(), data, w * h * 4);
+    tex.w = w;
+    tex.h = h;
+    stbi_image_free(data);
+  });
 }
 
 /*!
@@ -26,7 +26,7 @@ struct TextureDB {
 
   void add_texture(u32 tpage,
                    u32 texid,
-                   const std::vector<u32>& data,
+                   std::vector<u32> data,
                    u16 w,
                    u16 h,
                    const std::string& tex_name,
@@ -47,15 +47,6 @@ struct AudioDir {
   }
 };
 
-/*!
- * Read an entry from a WAD and return the binary data.
- */
-std::vector<u8> read_entry(const AudioDir& dir, const std::vector<u8>& data, int entry_idx) {
-  const auto& entry = dir.entries.at(entry_idx);
-  ASSERT(entry.end_byte > 0);
-  return std::vector<u8>(data.begin() + entry.start_byte, data.begin() + entry.end_byte);
-}
-
 /*!
  * Matches the format in file.
  */
@@ -140,16 +131,16 @@ std::string remove_trailing_spaces(const std::string& in) {
   return short_name;
 }
 
-struct AudioFileInfo {
-  std::string filename;
-  double length_seconds;
-};
-
-AudioFileInfo process_audio_file(const fs::path& output_folder,
-                                 const std::vector<u8>& data,
-                                 const std::string& name,
-                                 const std::string& suffix) {
-  BinaryReader reader(data);
+/*!
+ * Check the header of a VAG file in a WAD and set up a job to decode it to a wave file.
+ * Returns the name of the VAG file from its header.
+ */
+std::string prepare_audio_file(const fs::path& output_folder,
+                               const u8* data,
+                               size_t size,
+                               const std::string& name,
+                               AdpcmWaveJob* job) {
+  BinaryReader reader(data, size);
 
   auto header = reader.read<VagFileHeader>();
   if (header.magic[0] == 'V') {
@@ -163,15 +154,10 @@ AudioFileInfo process_audio_file(const fs::path& output_folder,
     ASSERT(reader.read<u8>() == 0);
   }
 
-  std::vector<s16> decoded_samples = decode_adpcm(reader);
-
-  while (reader.bytes_left()) {
-    ASSERT(reader.read<u8>() == 0);
-  }
-
-  file_util::create_dir_if_needed(output_folder / suffix);
-  auto file_name = fmt::format("{}.wav", remove_trailing_spaces(name));
-  write_wave_file_mono(decoded_samples, header.sample_rate, output_folder / suffix / file_name);
+  job->data = reader.here();
+  job->size = reader.bytes_left();
+  job->sample_rate = header.sample_rate;
+  job->output = output_folder / fmt::format("{}.wav", remove_trailing_spaces(name));
 
   std::string vag_filename;
   for (int i = 0; i < 16; i++) {
@@ -179,7 +165,7 @@ AudioFileInfo process_audio_file(const fs::path& output_folder,
       vag_filename.push_back(header.name[i]);
     }
   }
-  return {vag_filename, (double)decoded_samples.size() / header.sample_rate};
+  return vag_filename;
 }
 
 void process_streamed_audio(const fs::path& output_path,
@@ -204,13 +190,30 @@ void process_streamed_audio(const fs::path& output_path,
     auto suffix = fs::path(file).extension().u8string().substr(1);
     langs.push_back(suffix);
     dir_data.set_file_size(wad_data.size());
+    file_util::create_dir_if_needed(output_path / suffix);
+
+    // the headers are read here, then all of the files in this WAD are decoded and written in
+    // parallel.
+    std::vector<AdpcmWaveJob> jobs(dir_data.entry_count());
+    for (int i = 0; i < dir_data.entry_count(); i++) {
+      const auto& entry = dir_data.entries.at(i);
+      ASSERT(entry.end_byte > 0);
+      filename_data[i][lang_id + 1] =
+          prepare_audio_file(output_path / suffix, wad_data.data() + entry.start_byte,
+                             entry.end_byte - entry.start_byte, entry.name, &jobs[i]);
+    }
+    decode_adpcm_to_wave_files(jobs);
+
     for (int i = 0; i < dir_data.entry_count(); i++) {
-      auto audio_data = read_entry(dir_data, wad_data, i);
-      lg::info("File {}, total {:.2f} minutes", dir_data.entries.at(i).name, audio_len / 60.0);
-      auto info = process_audio_file(output_path, audio_data, dir_data.entries.at(i).name, suffix);
-      audio_len += info.length_seconds;
-      filename_data[i][lang_id + 1] = info.filename;
+      const auto& job = jobs[i];
+      // after the end, the entry is padded with zeros.
+      for (size_t j = job.bytes_used; j < job.size; j++) {
+        ASSERT(job.data[j] == 0);
+      }
+      audio_len += (double)job.sample_count / job.sample_rate;
     }
+    lg::info("Extracted {} files from {}, total {:.2f} minutes", jobs.size(), file,
+             audio_len / 60.0);
   }
 
   nlohmann::json file_list;
@@ -426,13 +426,12 @@ TexturePage read_texture_page(ObjectFileData& data,
 }  // namespace
 
 /*!
- * Process a texture page.
- * TODO - document
+ * Convert the textures in a texture page to RGBA, and write each to a PNG in output_path.
+ * This doesn't touch anything shared, so different tpages can be decoded in parallel.
  */
-TPageResultStats process_tpage(ObjectFileData& data,
-                               TextureDB& texture_db,
-                               const fs::path& output_path) {
-  TPageResultStats stats;
+DecodedTPage decode_tpage(ObjectFileData& data, const fs::path& output_path) {
+  DecodedTPage result;
+  auto& stats = result.stats;
   auto& words = data.linked_data.words_by_seg.at(0);
   const auto& level_names = data.dgo_names;
 
@@ -451,6 +450,9 @@ TPageResultStats process_tpage(ObjectFileData& data,
 
   // Read the texture_page struct
   TexturePage texture_page = read_texture_page(data, words, 0, end_of_texture_page);
+  result.id = texture_page.id;
+  result.name = texture_page.name;
+  result.level_names = level_names;
   auto texture_dump_dir = output_path / texture_page.name;
   file_util::create_dir_if_needed(texture_dump_dir);
 
@@ -474,13 +476,7 @@ TPageResultStats process_tpage(ObjectFileData& data,
   int copy_height = tex_size / copy_width;
 
   // copy texture to "VRAM" in PSMCT32 format, regardless of actual texture format.
-  for (int y = 0; y < copy_height; y++) {
-    for (int x = 0; x < copy_width; x++) {
-      // VRAM address (bytes)
-      auto addr32 = psmct32_addr(x, y, copy_width);
-      *(u32*)(vram.data() + addr32) = *(u32*)(tex_data.data() + (x + y * copy_width));
-    }
-  }
+  upload_psmct32(vram.data(), tex_data.data(), 0, copy_width, copy_height);
 
   // get all textures in the tpage
   for (u32 tex_id = 0; tex_id < texture_page.textures.size(); tex_id++) {
@@ -494,232 +490,46 @@ TPageResultStats process_tpage(ObjectFileData& data,
     stats.total_textures++;
     stats.num_px += tex.w * tex.h;
 
-    if (tex.psm == int(PSM::PSMT8) && tex.clutpsm == int(CPSM::PSMCT32)) {
-      // this is the only supported texture format for now.
-
-      // will store output pixels, rgba (8888)
-      std::vector<u32> out;
-
-      // width is like the TEX0 register, in 64 texel units.
-      // not sure what the other widths are yet.
-      int read_width = 64 * tex.width[0];
-
-      // loop over pixels in output texture image
-      for (int y = 0; y < tex.h; y++) {
-        for (int x = 0; x < tex.w; x++) {
-          // read as the PSMT8 type. The dest field tells us a block offset.
-          auto addr8 = psmt8_addr(x, y, read_width) + tex.dest[0] * 256;
-          u8 value = *(u8*)(vram.data() + addr8);
-
-          // there's yet another scramble from the CLUT. The palette index turns into an X, Y value
-          // See GS manual 2.7.3 CLUT Storage Mode, IDTEX8 in CSM1 mode.
-          u32 clut_chunk = value / 16;
-          u32 off_in_chunk = value % 16;
-          u8 clx = 0, cly = 0;
-          if (clut_chunk & 1) {
-            clx = 8;
-          }
-          cly = (clut_chunk >> 1) * 2;
-          if (off_in_chunk >= 8) {
-            off_in_chunk -= 8;
-            cly++;
-          }
-          clx += off_in_chunk;
-
-          // the x, y CLUT value is looked up in PSMCT32 mode
-          u32 clut_addr = psmct32_addr(clx, cly, 64) + tex.clutdest * 256;
-          u32 clut_value = *(u32*)(vram.data() + clut_addr);
-          out.push_back(clut_value);
-        }
-      }
-
-      // write texture to a PNG.
-      file_util::write_rgba_png(texture_dump_dir / fmt::format("{}.png", tex.name), out.data(),
-                                tex.w, tex.h);
-      texture_db.add_texture(texture_page.id, tex_id, out, tex.w, tex.h, tex.name,
-                             texture_page.name, level_names, tex.num_mips, tex.dest[0]);
-      stats.successful_textures++;
-    } else if (tex.psm == int(PSM::PSMT8) && tex.clutpsm == int(CPSM::PSMCT16)) {
-      // will store output pixels, rgba (8888)
-      std::vector<u32> out;
-
-      // width is like the TEX0 register, in 64 texel units.
-      // not sure what the other widths are yet.
-      int read_width = 64 * tex.width[0];
-
-      // loop over pixels in output texture image
-      for (int y = 0; y < tex.h; y++) {
-        for (int x = 0; x < tex.w; x++) {
-          // read as the PSMT8 type. The dest field tells us a block offset.
-          auto addr8 = psmt8_addr(x, y, read_width) + tex.dest[0] * 256;
-          u8 value = *(u8*)(vram.data() + addr8);
-
-          // there's yet another scramble from the CLUT. The palette index turns into an X, Y value
-          // See GS manual 2.7.3 CLUT Storage Mode, IDTEX8 in CSM1 mode.
-          u32 clut_chunk = value / 16;
-          u32 off_in_chunk = value % 16;
-          u8 clx = 0, cly = 0;
-          if (clut_chunk & 1) {
-            clx = 8;
-          }
-          cly = (clut_chunk >> 1) * 2;
-          if (off_in_chunk >= 8) {
-            off_in_chunk -= 8;
-            cly++;
-          }
-          clx += off_in_chunk;
-
-          // the x, y CLUT value is looked up in PSMCT32 mode
-          u32 clut_addr = psmct16_addr(clx, cly, 64) + tex.clutdest * 256;
-          u32 clut_value = *(u16*)(vram.data() + clut_addr);
-          out.push_back(rgba16_to_rgba32(clut_value));
-        }
-      }
-
-      // write texture to a PNG.
-      file_util::write_rgba_png(texture_dump_dir / fmt::format("{}.png", tex.name), out.data(),
-                                tex.w, tex.h);
-      texture_db.add_texture(texture_page.id, tex_id, out, tex.w, tex.h, tex.name,
-                             texture_page.name, level_names, tex.num_mips, tex.dest[0]);
-      stats.successful_textures++;
-    } else if (tex.psm == int(PSM::PSMCT16) && tex.clutpsm == 0) {
-      // not a clut.
-      // will store output pixels, rgba (8888)
-      std::vector<u32> out;
-
-      // width is like the TEX0 register, in 64 texel units.
-      // not sure what the other widths are yet.
-      int read_width = 64 * tex.width[0];
-
-      // loop over pixels in output texture image
-      for (int y = 0; y < tex.h; y++) {
-        for (int x = 0; x < tex.w; x++) {
-          // read as the PSMT8 type. The dest field tells us a block offset.
-          auto addr8 = psmct16_addr(x, y, read_width) + tex.dest[0] * 256;
-          u16 value = *(u16*)(vram.data() + addr8);
-          out.push_back(rgba16_to_rgba32(value));
-        }
-      }
-
-      // write texture to a PNG.
-      file_util::write_rgba_png(texture_dump_dir / fmt::format("{}.png", tex.name), out.data(),
-                                tex.w, tex.h);
-      texture_db.add_texture(texture_page.id, tex_id, out, tex.w, tex.h, tex.name,
-                             texture_page.name, level_names, tex.num_mips, tex.dest[0]);
-      stats.successful_textures++;
-    } else if (tex.psm == int(PSM::PSMT4) && tex.clutpsm == int(CPSM::PSMCT16)) {
-      // will store output pixels, rgba (8888)
-      std::vector<u32> out;
-
-      // width is like the TEX0 register, in 64 texel units.
-      // not sure what the other widths are yet.
-      int read_width = 64 * tex.width[0];
-
-      // loop over pixels in output texture image
-      for (int y = 0; y < tex.h; y++) {
-        for (int x = 0; x < tex.w; x++) {
-          // read as the PSMT4 type, use half byte addressing
-          auto addr4 = psmt4_addr_half_byte(x, y, read_width) + tex.dest[0] * 512;
-
-          // read (half bytes)
-          u8 value = *(u8*)(vram.data() + addr4 / 2);
-          if (addr4 & 1) {
-            value >>= 4;
-          } else {
-            value = value & 0x0f;
-          }
-
-          // there's yet another scramble from the CLUT. The palette index turns into an X, Y value
-          // See GS manual 2.7.3 CLUT Storage Mode, IDTEX4 in CSM1 mode.
-
-          u8 clx = value & 0x7;
-          u8 cly = value >> 3;
-
-          // the x, y CLUT value is looked up in PSMCT16 mode
-          u32 clut_addr = psmct16_addr(clx, cly, 64) + tex.clutdest * 256;
-          u32 clut_value = *(u16*)(vram.data() + clut_addr);
-          out.push_back(rgba16_to_rgba32(clut_value));
-        }
-      }
-
-      // write texture to a PNG.
-      file_util::write_rgba_png(texture_dump_dir / fmt::format("{}.png", tex.name), out.data(),
-                                tex.w, tex.h);
-      texture_db.add_texture(texture_page.id, tex_id, out, tex.w, tex.h, tex.name,
-                             texture_page.name, level_names, tex.num_mips, tex.dest[0]);
-      stats.successful_textures++;
-    } else if (tex.psm == int(PSM::PSMT4) && tex.clutpsm == int(CPSM::PSMCT32)) {
-      // will store output pixels, rgba (8888)
-      std::vector<u32> out;
-
-      // width is like the TEX0 register, in 64 texel units.
-      // not sure what the other widths are yet.
-      int read_width = 64 * tex.width[0];
-
-      // loop over pixels in output texture image
-      for (int y = 0; y < tex.h; y++) {
-        for (int x = 0; x < tex.w; x++) {
-          // read as the PSMT4 type, use half byte addressing
-          auto addr4 = psmt4_addr_half_byte(x, y, read_width) + tex.dest[0] * 512;
-
-          // read (half bytes)
-          u8 value = *(u8*)(vram.data() + addr4 / 2);
-          if (addr4 & 1) {
-            value >>= 4;
-          } else {
-            value = value & 0x0f;
-          }
-
-          // there's yet another scramble from the CLUT. The palette index turns into an X, Y value
-          // See GS manual 2.7.3 CLUT Storage Mode, IDTEX4 in CSM1 mode.
-
-          u8 clx = value & 0x7;
-          u8 cly = value >> 3;
-
-          // the x, y CLUT value is looked up in PSMCT16 mode
-          u32 clut_addr = psmct32_addr(clx, cly, 64) + tex.clutdest * 256;
-          u32 clut_value = *(u32*)(vram.data() + clut_addr);
-          out.push_back(clut_value);
-        }
-      }
-
-      // write texture to a PNG.
-      file_util::write_rgba_png(texture_dump_dir / fmt::format("{}.png", tex.name), out.data(),
-                                tex.w, tex.h);
-      texture_db.add_texture(texture_page.id, tex_id, out, tex.w, tex.h, tex.name,
-                             texture_page.name, level_names, tex.num_mips, tex.dest[0]);
-      stats.successful_textures++;
-    } else if (tex.psm == int(PSM::PSMCT32) && tex.clutpsm == 0) {
-      // not a clut.
-      // will store output pixels, rgba (8888)
-      std::vector<u32> out;
-
-      // width is like the TEX0 register, in 64 texel units.
-      // not sure what the other widths are yet.
-      int read_width = 64 * tex.width[0];
-
-      // loop over pixels in output texture image
-      for (int y = 0; y < tex.h; y++) {
-        for (int x = 0; x < tex.w; x++) {
-          // read as the PSMT32 type. The dest field tells us a block offset.
-          auto addr32 = psmct32_addr(x, y, read_width) + tex.dest[0] * 256;
-          u32 value = *(u32*)(vram.data() + addr32);
-          out.push_back(value);
-        }
-      }
-
-      // write texture to a PNG.
-      file_util::write_rgba_png(texture_dump_dir / fmt::format("{}.png", tex.name), out.data(),
-                                tex.w, tex.h);
-      texture_db.add_texture(texture_page.id, tex_id, out, tex.w, tex.h, tex.name,
-                             texture_page.name, level_names, tex.num_mips, tex.dest[0]);
-      stats.successful_textures++;
+    bool is_clut = tex.psm == int(PSM::PSMT8) || tex.psm == int(PSM::PSMT4);
+    bool supported = is_clut ? (tex.clutpsm == int(CPSM::PSMCT32) ||
+                                tex.clutpsm == int(CPSM::PSMCT16))
+                             : ((tex.psm == int(PSM::PSMCT16) || tex.psm == int(PSM::PSMCT32)) &&
+                                tex.clutpsm == 0);
+    if (!supported) {
+      printf("Unsupported texture 0x%x 0x%x\n", tex.psm, tex.clutpsm);
+      continue;
     }
 
-    else {
-      printf("Unsupported texture 0x%x 0x%x\n", tex.psm, tex.clutpsm);
+    // convert the palette once, instead of looking it up for each pixel.
+    u32 palette[256];
+    if (is_clut) {
+      load_clut_rgba8888(palette, vram.data(), tex.clutdest * 256, tex.psm == int(PSM::PSMT4),
+                         tex.clutpsm == int(CPSM::PSMCT16));
     }
+
+    // will store output pixels, rgba (8888)
+    std::vector<u32> out(tex.w * tex.h);
+
+    // width is like the TEX0 register, in 64 texel units.
+    // not sure what the other widths are yet.
+    int read_width = 64 * tex.width[0];
+    vram_to_rgba8888(out.data(), vram.data(), tex.dest[0], tex.w, tex.h, read_width, PSM(tex.psm),
+                     palette);
+
+    // write texture to a PNG.
+    file_util::write_rgba_png(texture_dump_dir / fmt::format("{}.png", tex.name), out.data(),
+                              tex.w, tex.h);
+    result.textures.push_back(
+        {tex_id, std::move(out), u16(tex.w), u16(tex.h), tex.name, tex.num_mips, tex.dest[0]});
+    stats.successful_textures++;
+  }
+  return result;
+}
+
+void add_tpage_to_db(DecodedTPage&& tpage, TextureDB& texture_db) {
+  for (auto& tex : tpage.textures) {
+    texture_db.add_texture(tpage.id, tex.tex_id, std::move(tex.rgba), tex.w, tex.h, tex.name,
+                           tpage.name, tpage.level_names, tex.num_mips, tex.dest);
   }
-  return stats;
 }
 }  // namespace decompiler
@@ -11,7 +11,25 @@ struct TPageResultStats {
   int num_px = 0;
 };
 
-TPageResultStats process_tpage(ObjectFileData& data,
-                               TextureDB& texture_db,
-                               const fs::path& output_path);
+/*!
+ * The textures of a tpage, converted to RGBA but not yet added to a TextureDB.
+ */
+struct DecodedTPage {
+  struct Texture {
+    u32 tex_id;
+    std::vector<u32> rgba;
+    u16 w, h;
+    std::string name;
+    u32 num_mips;
+    u32 dest;
+  };
+  u32 id = 0;
+  std::string name;
+  std::vector<std::string> level_names;
+  std::vector<Texture> textures;
+  TPageResultStats stats;
+};
+
+DecodedTPage decode_tpage(ObjectFileData& data, const fs::path& output_path);
+void add_tpage_to_db(DecodedTPage&& tpage, TextureDB& texture_db);
 }  // namespace decompiler
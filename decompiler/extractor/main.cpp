@@ -1,3 +1,4 @@
+#include <future>
 #include <map>
 #include <regex>
 #include <unordered_map>
@@ -140,7 +141,8 @@ void decompile(const fs::path& iso_data_path, const std::string& data_subfolder)
   auto out_folder = file_util::get_jak_project_dir() / "decompiler_out" / data_subfolder;
   auto raw_obj_folder = out_folder / "raw_obj";
   file_util::create_dir_if_needed(raw_obj_folder);
-  db.dump_raw_objects(raw_obj_folder);
+  // writing these out only reads the object data, so it can happen while the link data is processed.
+  auto dump_raw = std::async(std::launch::async, [&] { db.dump_raw_objects(raw_obj_folder); });
 
   // analyze object file link data
   db.process_link_data(config);
@@ -150,13 +152,14 @@ void decompile(const fs::path& iso_data_path, const std::string& data_subfolder)
   // ensure asset dir exists
   file_util::create_dir_if_needed(out_folder / "assets");
 
-  // text files
-  {
+  // text files. these are different object files from the tpages, so they can be done while the
+  // textures are extracted.
+  auto text = std::async(std::launch::async, [&] {
     auto result = db.process_game_text_files(config);
     if (!result.empty()) {
       file_util::write_text_file(out_folder / "assets" / "game_text.txt", result);
     }
-  }
+  });
 
   // textures
   decompiler::TextureDB tex_db;
@@ -178,13 +181,17 @@ void decompile(const fs::path& iso_data_path, const std::string& data_subfolder)
     }
   }
 
+  text.get();
+  dump_raw.get();
+
   // levels
   {
     auto level_out_path =
         file_util::get_jak_project_dir() / "out" / game_version_names[config.game_version] / "fr3";
     file_util::create_dir_if_needed(level_out_path);
     extract_all_levels(db, tex_db, config.levels_to_extract, "GAME.CGO", config.hacks,
-                       config.rip_levels, config.extract_collision, level_out_path);
+                       config.rip_levels, config.extract_collision, config.compress_textures,
+                       level_out_path);
   }
 }
 
@@ -1,12 +1,14 @@
 #include "extract_level.h"
 
+#include <algorithm>
 #include <set>
 #include <thread>
 
+#include "common/custom_data/chunked_fr3.h"
 #include "common/log/log.h"
+#include "common/texture/texture_compression.h"
 #include "common/util/FileUtil.h"
-#include "common/util/SimpleThreadGroup.h"
-#include "common/util/compress.h"
+#include "common/util/ThreadPool.h"
 #include "common/util/string_util.h"
 
 #include "decompiler/level_extractor/BspHeader.h"
@@ -93,6 +95,21 @@ void add_all_textures_from_level(tfrag3::Level& lev,
   }
 }
 
+/*!
+ * Convert textures to BC1/BC3 with mipmaps. Textures that go to the texture pool stay RGBA.
+ */
+void compress_level_textures(tfrag3::Level& lev) {
+  int compressed_count = 0;
+  for (auto& tex : lev.textures) {
+    texture_compression::compress_texture(tex);
+    if (tex.compression != tfrag3::TextureCompression::NONE) {
+      compressed_count++;
+    }
+  }
+  lg::info("compressed {} of {} textures in {}", compressed_count, lev.textures.size(),
+           lev.level_name);
+}
+
 void confirm_textures_identical(const TextureDB& tex_db) {
   std::unordered_map<std::string, std::vector<u32>> tex_dupl;
   for (auto& tex : tex_db.textures) {
@@ -224,6 +241,7 @@ void extract_common(const ObjectFileDB& db,
                     const TextureDB& tex_db,
                     const std::string& dgo_name,
                     bool dump_levels,
+                    bool compress_textures,
                     const fs::path& output_folder) {
   if (db.obj_files_by_dgo.count(dgo_name) == 0) {
     lg::warn("Skipping common extract for {} because the DGO was not part of the input", dgo_name);
@@ -240,16 +258,17 @@ void extract_common(const ObjectFileDB& db,
   tfrag3::Level tfrag_level;
   add_all_textures_from_level(tfrag_level, dgo_name, tex_db);
   extract_art_groups_from_level(db, tex_db, {}, dgo_name, tfrag_level);
+  if (compress_textures) {
+    compress_level_textures(tfrag_level);
+  }
 
-  Serializer ser;
-  tfrag_level.serialize(ser);
-  auto compressed =
-      compression::compress_zstd(ser.get_save_result().first, ser.get_save_result().second);
+  size_t uncompressed_size = 0;
+  auto compressed = tfrag3::save_chunked_fr3(tfrag_level, &uncompressed_size);
 
   lg::info("stats for {}", dgo_name);
-  print_memory_usage(tfrag_level, ser.get_save_result().second);
-  lg::info("compressed: {} -> {} ({:.2f}%)", ser.get_save_result().second, compressed.size(),
-           100.f * compressed.size() / ser.get_save_result().second);
+  print_memory_usage(tfrag_level, uncompressed_size);
+  lg::info("compressed: {} -> {} ({:.2f}%)", uncompressed_size, compressed.size(),
+           100.f * compressed.size() / uncompressed_size);
   file_util::write_binary_file(
       output_folder / fmt::format("{}.fr3", dgo_name.substr(0, dgo_name.length() - 4)),
       compressed.data(), compressed.size());
@@ -267,6 +286,7 @@ void extract_from_level(const ObjectFileDB& db,
                         const DecompileHacks& hacks,
                         bool dump_level,
                         bool extract_collision,
+                        bool compress_textures,
                         const fs::path& output_folder) {
   if (db.obj_files_by_dgo.count(dgo_name) == 0) {
     lg::warn("Skipping extract for {} because the DGO was not part of the input", dgo_name);
@@ -296,14 +316,16 @@ void extract_from_level(const ObjectFileDB& db,
     return;
   }
   
-  Serializer ser;
-  level_data.serialize(ser);
-  auto compressed =
-      compression::compress_zstd(ser.get_save_result().first, ser.get_save_result().second);
+  if (compress_textures) {
+    compress_level_textures(level_data);
+  }
+
+  size_t uncompressed_size = 0;
+  auto compressed = tfrag3::save_chunked_fr3(level_data, &uncompressed_size);
   lg::info("stats for {}", dgo_name);
-  print_memory_usage(level_data, ser.get_save_result().second);
-  lg::info("compressed: {} -> {} ({:.2f}%)", ser.get_save_result().second, compressed.size(),
-           100.f * compressed.size() / ser.get_save_result().second);
+  print_memory_usage(level_data, uncompressed_size);
+  lg::info("compressed: {} -> {} ({:.2f}%)", uncompressed_size, compressed.size(),
+           100.f * compressed.size() / uncompressed_size);
   file_util::write_binary_file(
       output_folder / fmt::format("{}.fr3", dgo_name.substr(0, dgo_name.length() - 4)),
       compressed.data(), compressed.size());
@@ -505,16 +527,35 @@ void extract_all_levels(const ObjectFileDB& db,
                         const DecompileHacks& hacks,
                         bool debug_dump_level,
                         bool extract_collision,
+                        bool compress_textures,
                         const fs::path& output_path) {
-  extract_common(db, tex_db, common_name, debug_dump_level, output_path);
-  SimpleThreadGroup threads;
-  threads.run(
-      [&](int idx) {
-        extract_from_level(db, tex_db, dgo_names[idx], hacks, debug_dump_level, extract_collision,
-                           output_path);
-      },
-      dgo_names.size());
-  threads.join();
+  extract_common(db, tex_db, common_name, debug_dump_level, compress_textures, output_path);
+
+  // A few levels take much longer than the rest, so start the biggest levels first and have each
+  // thread take the next level when it finishes one. Otherwise the slowest levels can end up on the
+  // same thread, or be started last.
+  std::vector<std::pair<size_t, int>> size_and_idx;
+  for (int i = 0; i < (int)dgo_names.size(); i++) {
+    size_t size = 0;
+    auto dgo_it = db.obj_files_by_dgo.find(dgo_names[i]);
+    if (dgo_it != db.obj_files_by_dgo.end()) {
+      for (auto& rec : dgo_it->second) {
+        for (auto& obj : db.obj_files_by_name.at(rec.name)) {
+          if (obj.record.hash == rec.hash) {
+            size += obj.data.size();
+          }
+        }
+      }
+    }
+    size_and_idx.emplace_back(size, i);
+  }
+  std::stable_sort(size_and_idx.begin(), size_and_idx.end(),
+                   [](const auto& a, const auto& b) { return a.first > b.first; });
+
+  parallel_for(size_and_idx.size(), [&](int i) {
+    extract_from_level(db, tex_db, dgo_names[size_and_idx[i].second], hacks, debug_dump_level,
+                       extract_collision, compress_textures, output_path);
+  });
 }
 
 }  // namespace decompiler
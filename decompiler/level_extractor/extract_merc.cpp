@@ -1,8 +1,12 @@
 #include "extract_merc.h"
 
+#include <cstring>
+#include <unordered_map>
+
 #include "common/log/log.h"
 #include "common/util/BitUtils.h"
 #include "common/util/FileUtil.h"
+#include "common/util/ThreadPool.h"
 #include "common/util/colors.h"
 #include "common/util/string_util.h"
 
@@ -10,6 +14,8 @@
 #include "decompiler/level_extractor/extract_common.h"
 #include "decompiler/util/goal_data_reader.h"
 
+#include "third-party/zstd/lib/common/xxhash.h"
+
 namespace decompiler {
 
 // number of slots on VU1 data memory to store matrices
@@ -152,7 +158,9 @@ struct ConvertedMercEffect {
   std::vector<u32> verts_per_frag;
   bool has_envmap = false;
   DrawMode envmap_mode;
-  u32 envmap_texture;
+  // the envmap texture is added to the level after converting, effects are converted in parallel.
+  u32 envmap_tex_combo = 0;
+  const char* envmap_debug_name = "";
   std::optional<s8> eye_slot;
   float pos_scale = 0;
 
@@ -802,8 +810,6 @@ ConvertedMercEffect convert_merc_effect(const MercEffect& input_effect,
                                         size_t ctrl_idx,
                                         size_t effect_idx,
                                         bool dump,
-                                        const TextureDB& tex_db,
-                                        tfrag3::Level& out,
                                         GameVersion version) {
   ConvertedMercEffect result;
   result.ctrl_idx = ctrl_idx;
@@ -825,9 +831,8 @@ ConvertedMercEffect convert_merc_effect(const MercEffect& input_effect,
     // texture the texture page/texture index, and convert to a PC port texture ID
     u32 tpage = new_tex >> 20;
     u32 tidx = (new_tex >> 8) & 0b1111'1111'1111;
-    u32 tex_combo = (((u32)tpage) << 16) | tidx;
-    result.envmap_texture = find_or_add_texture_to_level(out, tex_db, "envmap", tex_combo,
-                                                         ctrl_header, nullptr, version);
+    result.envmap_tex_combo = (((u32)tpage) << 16) | tidx;
+    result.envmap_debug_name = "envmap";
   } else if (input_effect.envmap_or_effect_usage) {
     u32 tex_combo = 0;
     switch (version) {
@@ -846,8 +851,8 @@ ConvertedMercEffect convert_merc_effect(const MercEffect& input_effect,
         ASSERT_NOT_REACHED();
     }
 
-    result.envmap_texture = find_or_add_texture_to_level(out, tex_db, "envmap-default", tex_combo,
-                                                         ctrl_header, nullptr, version);
+    result.envmap_tex_combo = tex_combo;
+    result.envmap_debug_name = "envmap-default";
 
     DrawMode mode;
     mode.set_at(false);
@@ -1182,6 +1187,19 @@ struct VertexSourceInfo {
   int flump4;
 };
 
+struct MercVertexHash {
+  size_t operator()(const tfrag3::MercVertex& vtx) const {
+    return XXH64(&vtx, sizeof(vtx), 0);
+  }
+};
+
+struct MercVertexEqual {
+  bool operator()(const tfrag3::MercVertex& a, const tfrag3::MercVertex& b) const {
+    // convert_vertex sets the padding, so the bytes can be compared.
+    return memcmp(&a, &b, sizeof(a)) == 0;
+  }
+};
+
 // ND used VIF to do int->float conversion.
 // This is a little tricky because you can only do an int + int, then interpret that as a float.
 // This resulting conversion is linear (for some range of input):
@@ -1595,20 +1613,37 @@ void extract_merc(const ObjectFileData& ag_data,
   auto ctrl_locations = find_merc_ctrls(ag_data.linked_data);
 
   // extract them. this does very basic unpacking of data, as done by the VIF/DMA on PS2.
-  std::vector<MercCtrl> ctrls;
-  for (auto location : ctrl_locations) {
-    auto ctrl = extract_merc_ctrl(ag_data.linked_data, dts, location);
-    ctrls.push_back(ctrl);
-  }
+  std::vector<MercCtrl> ctrls(ctrl_locations.size());
+  parallel_for(ctrls.size(), [&](int ci) {
+    ctrls[ci] = extract_merc_ctrl(ag_data.linked_data, dts, ctrl_locations[ci]);
+  });
 
   // extract draws. this does no regrouping yet.
-  std::vector<std::vector<ConvertedMercEffect>> all_effects;
+  // effects don't depend on each other, so they are all converted in parallel.
+  std::vector<std::vector<ConvertedMercEffect>> all_effects(ctrls.size());
+  std::vector<std::pair<size_t, size_t>> effect_idxs;  // ctrl, effect
   for (size_t ci = 0; ci < ctrls.size(); ci++) {
-    auto& effects_in_ctrl = all_effects.emplace_back();
+    all_effects[ci].resize(ctrls[ci].effects.size());
     for (size_t ei = 0; ei < ctrls[ci].effects.size(); ei++) {
-      effects_in_ctrl.push_back(convert_merc_effect(ctrls[ci].effects[ei], ctrls[ci].header, map,
-                                                    ctrls[ci].name, ci, ei, dump_level, tex_db, out,
-                                                    version));
+      effect_idxs.emplace_back(ci, ei);
+    }
+  }
+  parallel_for(effect_idxs.size(), [&](int i) {
+    auto [ci, ei] = effect_idxs[i];
+    all_effects[ci][ei] = convert_merc_effect(ctrls[ci].effects[ei], ctrls[ci].header, map,
+                                              ctrls[ci].name, ci, ei, dump_level, version);
+  });
+
+  // adding textures to the level isn't thread safe, add envmap textures in the original order.
+  std::vector<std::vector<u32>> envmap_textures(ctrls.size());
+  for (size_t ci = 0; ci < ctrls.size(); ci++) {
+    for (auto& effect : all_effects[ci]) {
+      envmap_textures[ci].push_back(
+          effect.has_envmap
+              ? find_or_add_texture_to_level(out, tex_db, effect.envmap_debug_name,
+                                             effect.envmap_tex_combo, ctrls[ci].header, nullptr,
+                                             version)
+              : 0);
     }
   }
 
@@ -1636,11 +1671,26 @@ void extract_merc(const ObjectFileData& ag_data,
       auto& pc_effect = pc_ctrl.effects.emplace_back();
       auto& effect = all_effects[ci][ei];
       pc_effect.has_envmap = effect.has_envmap;
-      pc_effect.envmap_texture = effect.envmap_texture;
+      pc_effect.envmap_texture = envmap_textures[ci][ei];
       pc_effect.envmap_mode = effect.envmap_mode;
-      u32 first_vertex = out.merc_data.vertices.size();
+
+      // fragments repeat the vertices they share with other fragments. Vertices that can't be
+      // modified are only added once per effect. Modifiable ones are kept, the runtime updates
+      // each of them from its own spot in EE memory.
+      std::unordered_map<tfrag3::MercVertex, u32, MercVertexHash, MercVertexEqual> fixed_vertices;
+      std::vector<u32> vertex_remap;  // effect vertex to level vertex
+      vertex_remap.reserve(effect.vertices.size());
       for (auto& vtx : effect.vertices) {
         auto cvtx = convert_vertex(vtx, ctrl.header.xyz_scale);
+        if (!vtx.can_be_modified) {
+          auto [it, inserted] =
+              fixed_vertices.try_emplace(cvtx, (u32)out.merc_data.vertices.size());
+          if (!inserted) {
+            vertex_remap.push_back(it->second);
+            continue;
+          }
+        }
+        vertex_remap.push_back(out.merc_data.vertices.size());
         vertex_modify_flags.push_back(vtx.can_be_modified);
         vertex_srcs.push_back({vtx.idx_in_combined_lump4, vtx.frag, vtx.flump4});
         out.merc_data.vertices.push_back(cvtx);
@@ -1675,7 +1725,7 @@ void extract_merc(const ObjectFileData& ag_data,
           if (idx == UINT32_MAX) {
             indices_temp[ci][ei][pc_draw_idx].push_back(idx);
           } else {
-            indices_temp[ci][ei][pc_draw_idx].push_back(idx + first_vertex);
+            indices_temp[ci][ei][pc_draw_idx].push_back(vertex_remap.at(idx));
           }
         }
       }
@@ -1,9 +1,11 @@
 #include "extract_tie.h"
 
+#include <algorithm>
 #include <array>
 
 #include "common/log/log.h"
 #include "common/util/FileUtil.h"
+#include "common/util/SimpleThreadGroup.h"
 #include "common/util/string_util.h"
 
 #include "decompiler/ObjectFile/LinkedObjectFile.h"
@@ -279,8 +281,34 @@ struct TieFrag {
   std::vector<TieStrip> strips;
 
   // this contains vertices, key is the address of the actual xyzf/st/rgbaq data in VU1 memory
-  // after the prototype program runs
-  std::unordered_map<u32, TieProtoVertex> vertex_by_dest_addr;
+  // after the prototype program runs. These are added in program order, then sorted by address once
+  // the program is done, which is much cheaper than a map for the number of vertices we have.
+  std::vector<std::pair<u32, TieProtoVertex>> vertex_by_dest_addr;
+
+  void add_vertex(u32 addr, const TieProtoVertex& vtx) {
+    vertex_by_dest_addr.emplace_back(addr, vtx);
+  }
+
+  bool has_vertex(u32 addr) const {
+    return std::any_of(vertex_by_dest_addr.begin(), vertex_by_dest_addr.end(),
+                       [&](const auto& x) { return x.first == addr; });
+  }
+
+  // sort by address, and make sure that no address was written twice.
+  void sort_vertices() {
+    std::sort(vertex_by_dest_addr.begin(), vertex_by_dest_addr.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+    for (size_t i = 1; i < vertex_by_dest_addr.size(); i++) {
+      ASSERT(vertex_by_dest_addr[i - 1].first != vertex_by_dest_addr[i].first);
+    }
+  }
+
+  const TieProtoVertex& vertex_at(u32 addr) const {
+    auto it = std::lower_bound(vertex_by_dest_addr.begin(), vertex_by_dest_addr.end(), addr,
+                               [](const auto& x, u32 a) { return x.first < a; });
+    ASSERT(it != vertex_by_dest_addr.end() && it->first == addr);
+    return it->second;
+  }
 
   math::Vector<u8, 4> envmap_tint_color = math::Vector<u8, 4>::zero();
 
@@ -1621,8 +1649,7 @@ void emulate_tie_instance_program(std::vector<TieProtoInfo>& protos) {
           vertex_info.envmap_tint_color = frag.envmap_tint_color;
           vertex_info.nrm = frag.get_normal_if_present(normal_table_offset++);
 
-          bool inserted = frag.vertex_by_dest_addr.insert({(u32)dest_ptr, vertex_info}).second;
-          ASSERT(inserted);
+          frag.add_vertex(dest_ptr, vertex_info);
           nd.bp1++;
 
           if (reached_target) {
@@ -1666,11 +1693,9 @@ void emulate_tie_instance_program(std::vector<TieProtoInfo>& protos) {
           vertex_info.nrm = frag.get_normal_if_present(normal_table_offset++);
 
           // lg::print("double draw: {} {}\n", dest_ptr, dest2_ptr);
-          bool inserted = frag.vertex_by_dest_addr.insert({(u32)dest_ptr, vertex_info}).second;
-          ASSERT(inserted);
+          frag.add_vertex(dest_ptr, vertex_info);
 
-          bool inserted2 = frag.vertex_by_dest_addr.insert({(u32)dest2_ptr, vertex_info}).second;
-          ASSERT(inserted2);
+          frag.add_vertex(dest2_ptr, vertex_info);
 
           if (reached_target) {
             past_target++;
@@ -1789,8 +1814,7 @@ void emulate_tie_instance_program(std::vector<TieProtoInfo>& protos) {
           vertex_info.envmap_tint_color = frag.envmap_tint_color;
           vertex_info.nrm = frag.get_normal_if_present(normal_table_offset++);
 
-          bool inserted = frag.vertex_by_dest_addr.insert({(u32)dest_ptr, vertex_info}).second;
-          ASSERT(inserted);
+          frag.add_vertex(dest_ptr, vertex_info);
           nd.ip1++;
           ip_1_count++;
         }
@@ -1823,15 +1847,13 @@ void emulate_tie_instance_program(std::vector<TieProtoInfo>& protos) {
           vertex_info.envmap_tint_color = frag.envmap_tint_color;
           vertex_info.nrm = frag.get_normal_if_present(normal_table_offset++);
 
-          bool inserted = frag.vertex_by_dest_addr.insert({(u32)dest_ptr, vertex_info}).second;
-          ASSERT(inserted);
+          frag.add_vertex(dest_ptr, vertex_info);
 
           // first iteration of ip2 is a bit strange because how it jumps from loop to loop.
           // in some cases it uses ip2 on a point that should have used ip1 with the same addr
           // twice. I am pretty sure it's not our fault because we get exactly the right dvert.
-          bool inserted2 = frag.vertex_by_dest_addr.insert({(u32)dest2_ptr, vertex_info}).second;
-          if (!first_iter) {
-            ASSERT(inserted2);
+          if (!first_iter || !frag.has_vertex(dest2_ptr)) {
+            frag.add_vertex(dest2_ptr, vertex_info);
           }
           nd.ip2++;
           first_iter = false;
@@ -1843,6 +1865,7 @@ void emulate_tie_instance_program(std::vector<TieProtoInfo>& protos) {
       ASSERT(frag.vertex_by_dest_addr.size() == frag.expected_dverts);
 
     program_end:;
+      frag.sort_vertices();
       if (!frag.normal_data_packed.empty()) {
         // check that we have a normal per point, if we have normals
         // in ETIE, the normal count must be a multiple of 4 due to VIF upload
@@ -1909,7 +1932,7 @@ void emulate_kicks(std::vector<TieProtoInfo>& protos) {
         // 470 gifbuf again
         // 654 ??
         ASSERT(!frag.vertex_by_dest_addr.empty());
-        int gifbuf_addr = frag.vertex_by_dest_addr.begin()->first;
+        int gifbuf_addr = frag.vertex_by_dest_addr.front().first;
         int base_address = 286;
         if (gifbuf_addr >= 654) {
           base_address = 654;
@@ -1926,7 +1949,7 @@ void emulate_kicks(std::vector<TieProtoInfo>& protos) {
           // compute the address of this vertex (stored after the strgif)
           u32 vtx_addr = str_it->address + 1 + (3 * vtx) + base_address;
           // and grab it from the vertex map we made earlier.
-          strip.verts.push_back(frag.vertex_by_dest_addr.at(vtx_addr));
+          strip.verts.push_back(frag.vertex_at(vtx_addr));
         }
 
         str_it++;
@@ -2697,6 +2720,90 @@ void merge_groups(std::vector<tfrag3::StripDraw::VisGroup>& grps) {
   std::swap(result, grps);
 }
 
+/*!
+ * Result of emulating the VU programs for one geom (level of detail) of a tie tree.
+ */
+struct TieGeomInfo {
+  tfrag3::TieTree tree;
+  std::unordered_map<int, int> instance_parents;
+  std::vector<TieProtoInfo> info;
+  BigPalette palette;
+};
+
+/*!
+ * Emulate the VU programs for one geom of a tie tree. This only reads the tree, so the geoms can
+ * be done in parallel.
+ */
+void emulate_tie_geom(const level_tools::DrawableTreeInstanceTie* tree,
+                      const std::string& debug_name,
+                      const std::vector<level_tools::TextureRemap>& tex_map,
+                      int geo,
+                      bool dump_level,
+                      GameVersion version,
+                      TieGeomInfo& result) {
+  auto& this_tree = result.tree;
+
+  // sanity check the vis tree (not a perfect check, but this is used in game and should be right)
+  ASSERT(tree->length == (int)tree->arrays.size());
+  ASSERT(tree->length > 0);
+  auto last_array = tree->arrays.back().get();
+  auto as_instance_array = dynamic_cast<level_tools::DrawableInlineArrayInstanceTie*>(last_array);
+  ASSERT(as_instance_array);
+  ASSERT(as_instance_array->length == (int)as_instance_array->instances.size());
+  ASSERT(as_instance_array->length > 0);
+  u16 idx = as_instance_array->instances.front().id;
+  for (auto& elt : as_instance_array->instances) {
+    ASSERT(elt.id == idx);
+    idx++;
+  }
+  bool ok = verify_node_indices(tree);
+  ASSERT(ok);
+
+  // extract the vis tree. Note that this extracts the tree only down to the last draw node, a
+  // parent of between 1 and 8 instances.
+  extract_vis_data(tree, as_instance_array->instances.front().id, this_tree);
+
+  // we use the index of the instance in the instance list as its index. But this is different
+  // from its visibility index. This map goes from instance index to the parent node in the vis
+  // tree. later, we can use this to remap from instance idx to the visiblity node index.
+  for (size_t node_idx = 0; node_idx < this_tree.bvh.vis_nodes.size(); node_idx++) {
+    const auto& node = this_tree.bvh.vis_nodes[node_idx];
+    if (node.flags == 0) {
+      for (int i = 0; i < node.num_kids; i++) {
+        result.instance_parents[node.child_id + i] = node_idx;
+      }
+    }
+  }
+
+  // convert level format data to a nicer format
+  auto& info = result.info;
+  info = collect_instance_info(as_instance_array, &tree->prototypes.prototype_array_tie.data, geo);
+  update_proto_info(&info, tex_map, tree->prototypes.prototype_array_tie.data, geo, version);
+  if (version != GameVersion::Jak2) {
+    check_wind_vectors_zero(info, tree->prototypes.wind_vectors);
+  }
+  // determine draws from VU program
+  emulate_tie_prototype_program(info);
+  emulate_tie_instance_program(info);
+  emulate_kicks(info);
+
+  // debug save to .obj
+  if (dump_level) {
+    auto dir = file_util::get_file_path({fmt::format("debug_out/lod{}-tie-{}/", geo, debug_name)});
+    file_util::create_dir_if_needed(dir);
+    for (auto& proto : info) {
+      auto data = debug_dump_proto_to_obj(proto);
+      file_util::write_text_file(fmt::format("{}/{}.obj", dir, proto.name), data);
+    }
+
+    auto full = dump_full_to_obj(info);
+    file_util::write_text_file(fmt::format("{}/ALL.obj", dir), full);
+  }
+
+  // create time of day data.
+  result.palette = make_big_palette(info);
+}
+
 void extract_tie(const level_tools::DrawableTreeInstanceTie* tree,
                  const std::string& debug_name,
                  const std::vector<level_tools::TextureRemap>& tex_map,
@@ -2704,73 +2811,24 @@ void extract_tie(const level_tools::DrawableTreeInstanceTie* tree,
                  tfrag3::Level& out,
                  bool dump_level,
                  GameVersion version) {
-  for (int geo = 0; geo < GEOM_MAX; ++geo) {
-    tfrag3::TieTree this_tree;
-
-    // sanity check the vis tree (not a perfect check, but this is used in game and should be right)
-    ASSERT(tree->length == (int)tree->arrays.size());
-    ASSERT(tree->length > 0);
-    auto last_array = tree->arrays.back().get();
-    auto as_instance_array = dynamic_cast<level_tools::DrawableInlineArrayInstanceTie*>(last_array);
-    ASSERT(as_instance_array);
-    ASSERT(as_instance_array->length == (int)as_instance_array->instances.size());
-    ASSERT(as_instance_array->length > 0);
-    u16 idx = as_instance_array->instances.front().id;
-    for (auto& elt : as_instance_array->instances) {
-      ASSERT(elt.id == idx);
-      idx++;
-    }
-    bool ok = verify_node_indices(tree);
-    ASSERT(ok);
-
-    // extract the vis tree. Note that this extracts the tree only down to the last draw node, a
-    // parent of between 1 and 8 instances.
-    extract_vis_data(tree, as_instance_array->instances.front().id, this_tree);
-
-    // we use the index of the instance in the instance list as its index. But this is different
-    // from its visibility index. This map goes from instance index to the parent node in the vis
-    // tree. later, we can use this to remap from instance idx to the visiblity node index.
-    std::unordered_map<int, int> instance_parents;
-    for (size_t node_idx = 0; node_idx < this_tree.bvh.vis_nodes.size(); node_idx++) {
-      const auto& node = this_tree.bvh.vis_nodes[node_idx];
-      if (node.flags == 0) {
-        for (int i = 0; i < node.num_kids; i++) {
-          instance_parents[node.child_id + i] = node_idx;
-        }
-      }
-    }
+  // The VU emulation is most of the time spent on a level, and each geom is independent. Adding
+  // the draws to the level adds textures to it, so that part is done afterward, in geom order, to
+  // get the same output as doing everything serially.
+  std::array<TieGeomInfo, GEOM_MAX> geoms;
+  SimpleThreadGroup threads;
+  threads.run(
+      [&](int geo) {
+        emulate_tie_geom(tree, debug_name, tex_map, geo, dump_level, version, geoms[geo]);
+      },
+      GEOM_MAX, GEOM_MAX);
+  threads.join();
 
-    // convert level format data to a nicer format
-    auto info =
-        collect_instance_info(as_instance_array, &tree->prototypes.prototype_array_tie.data, geo);
-    update_proto_info(&info, tex_map, tree->prototypes.prototype_array_tie.data, geo, version);
-    if (version != GameVersion::Jak2) {
-      check_wind_vectors_zero(info, tree->prototypes.wind_vectors);
-    }
-    // determine draws from VU program
-    emulate_tie_prototype_program(info);
-    emulate_tie_instance_program(info);
-    emulate_kicks(info);
-
-    // debug save to .obj
-    if (dump_level) {
-      auto dir =
-          file_util::get_file_path({fmt::format("debug_out/lod{}-tie-{}/", geo, debug_name)});
-      file_util::create_dir_if_needed(dir);
-      for (auto& proto : info) {
-        auto data = debug_dump_proto_to_obj(proto);
-        file_util::write_text_file(fmt::format("{}/{}.obj", dir, proto.name), data);
-      }
-
-      auto full = dump_full_to_obj(info);
-      file_util::write_text_file(fmt::format("{}/ALL.obj", dir), full);
-    }
-
-    // create time of day data.
-    auto full_palette = make_big_palette(info);
+  for (int geo = 0; geo < GEOM_MAX; ++geo) {
+    auto& this_tree = geoms[geo].tree;
+    const auto& instance_parents = geoms[geo].instance_parents;
 
     // create draws
-    add_vertices_and_static_draw(this_tree, out, tex_db, info, version);
+    add_vertices_and_static_draw(this_tree, out, tex_db, geoms[geo].info, version);
 
     // remap vis indices and merge
     for (auto& draw : this_tree.static_draws) {
@@ -2798,7 +2856,7 @@ void extract_tie(const level_tools::DrawableTreeInstanceTie* tree,
       merge_groups(draw.instance_groups);
     }
 
-    this_tree.colors = full_palette.colors;
+    this_tree.colors = geoms[geo].palette.colors;
     out.tie_trees[geo].push_back(std::move(this_tree));
   }
 }
@@ -1,12 +1,17 @@
 #include "fr3_to_gltf.h"
 
+#include <functional>
+#include <sstream>
 #include <unordered_map>
 
 #include "common/custom_data/Tfrag3Data.h"
 #include "common/math/Vector.h"
+#include "common/texture/texture_compression.h"
+#include "common/util/ThreadPool.h"
 
 #include "decompiler/level_extractor/tfrag_tie_fixup.h"
 
+#include "third-party/json.hpp"
 #include "third-party/tiny_gltf/tiny_gltf.h"
 
 namespace {
@@ -99,681 +104,452 @@ std::vector<math::Vector3f> extract_positions(const std::vector<tfrag3::Preloade
   return result;
 }
 
+
+constexpr int kMaxColor = 1;
+
 /*!
- * Set up a buffer for the positions of the given vertices.
- * Return the index of the accessor.
+ * Vertex and index data for one tree (or for all merc models), converted to the gltf format.
+ * Making these is most of the work of the export. It doesn't touch the gltf model, so several can
+ * be made at once.
  */
+struct MeshData {
+  struct Draw {
+    u32 start = 0;  // first index in indices
+    u32 count = 0;
+    u32 tex_id = 0;
+    DrawMode mode;
+  };
+
+  // each node gets the next draw_count draws.
+  struct Node {
+    std::string name;
+    int draw_count = 0;
+  };
+
+  int vertex_count = 0;
+  std::vector<u8> positions;          // vec3 float
+  std::vector<u8> texcoords;          // vec2 float
+  std::vector<u8> colors[kMaxColor];  // vec4 float
+  std::vector<u8> indices;            // u32 triangles
+  std::vector<Draw> draws;
+  std::vector<Node> nodes;
+};
+
+template <typename T>
+std::vector<u8> to_bytes(const std::vector<T>& data) {
+  std::vector<u8> result(sizeof(T) * data.size());
+  if (!data.empty()) {
+    memcpy(result.data(), data.data(), result.size());
+  }
+  return result;
+}
+
 template <typename T>
-int make_position_buffer_accessor(const std::vector<T>& vertices, tinygltf::Model& model) {
-  // first create a buffer:
-  int buffer_idx = (int)model.buffers.size();
-  auto& buffer = model.buffers.emplace_back();
-  buffer.data.resize(sizeof(float) * 3 * vertices.size());
-
-  // and fill it
-  u8* buffer_ptr = buffer.data.data();
+std::vector<u8> position_data(const std::vector<T>& vertices) {
+  std::vector<float> floats;
+  floats.reserve(3 * vertices.size());
   for (const auto& vtx : vertices) {
     if constexpr (std::is_same<T, tfrag3::MercVertex>::value) {
-      float xyz[3] = {vtx.pos[0] / 4096.f, vtx.pos[1] / 4096.f, vtx.pos[2] / 4096.f};
-      memcpy(buffer_ptr, xyz, 3 * sizeof(float));
-      buffer_ptr += 3 * sizeof(float);
+      floats.insert(floats.end(), {vtx.pos[0] / 4096.f, vtx.pos[1] / 4096.f, vtx.pos[2] / 4096.f});
     } else {
-      float xyz[3] = {vtx.x / 4096.f, vtx.y / 4096.f, vtx.z / 4096.f};
-      memcpy(buffer_ptr, xyz, 3 * sizeof(float));
-      buffer_ptr += 3 * sizeof(float);
+      floats.insert(floats.end(), {vtx.x / 4096.f, vtx.y / 4096.f, vtx.z / 4096.f});
     }
   }
-
-  // create a view of this buffer
-  int buffer_view_idx = (int)model.bufferViews.size();
-  auto& buffer_view = model.bufferViews.emplace_back();
-  buffer_view.buffer = buffer_idx;
-  buffer_view.byteOffset = 0;
-  buffer_view.byteLength = buffer.data.size();
-  buffer_view.byteStride = 0;  // tightly packed
-  buffer_view.target = TINYGLTF_TARGET_ARRAY_BUFFER;
-
-  int accessor_idx = (int)model.accessors.size();
-  auto& accessor = model.accessors.emplace_back();
-  accessor.bufferView = buffer_view_idx;
-  accessor.byteOffset = 0;
-  accessor.componentType = TINYGLTF_COMPONENT_TYPE_FLOAT;
-  accessor.count = vertices.size();
-  accessor.type = TINYGLTF_TYPE_VEC3;
-
-  return accessor_idx;
+  return to_bytes(floats);
 }
 
 /*!
- * Set up a buffer for the texture coordinates of the given vertices, multiplying by scale.
- * Return the index of the accessor.
+ * Texture coordinates of the given vertices, multiplied by scale.
  */
 template <typename T>
-int make_tex_buffer_accessor(const std::vector<T>& vertices, tinygltf::Model& model, float scale) {
-  // first create a buffer:
-  int buffer_idx = (int)model.buffers.size();
-  auto& buffer = model.buffers.emplace_back();
-  buffer.data.resize(sizeof(float) * 2 * vertices.size());
-
-  // and fill it
-  u8* buffer_ptr = buffer.data.data();
+std::vector<u8> tex_data(const std::vector<T>& vertices, float scale) {
+  std::vector<float> floats;
+  floats.reserve(2 * vertices.size());
   for (const auto& vtx : vertices) {
     if constexpr (std::is_same<T, tfrag3::MercVertex>::value) {
-      float st[2] = {vtx.st[0] * scale, vtx.st[1] * scale};
-      memcpy(buffer_ptr, st, 2 * sizeof(float));
-      buffer_ptr += 2 * sizeof(float);
+      floats.insert(floats.end(), {vtx.st[0] * scale, vtx.st[1] * scale});
     } else {
-      float st[2] = {vtx.s * scale, vtx.t * scale};
-      memcpy(buffer_ptr, st, 2 * sizeof(float));
-      buffer_ptr += 2 * sizeof(float);
+      floats.insert(floats.end(), {vtx.s * scale, vtx.t * scale});
     }
   }
-
-  // create a view of this buffer
-  int buffer_view_idx = (int)model.bufferViews.size();
-  auto& buffer_view = model.bufferViews.emplace_back();
-  buffer_view.buffer = buffer_idx;
-  buffer_view.byteOffset = 0;
-  buffer_view.byteLength = buffer.data.size();
-  buffer_view.byteStride = 0;  // tightly packed
-  buffer_view.target = TINYGLTF_TARGET_ARRAY_BUFFER;
-
-  int accessor_idx = (int)model.accessors.size();
-  auto& accessor = model.accessors.emplace_back();
-  accessor.bufferView = buffer_view_idx;
-  accessor.byteOffset = 0;
-  accessor.componentType = TINYGLTF_COMPONENT_TYPE_FLOAT;
-  accessor.count = vertices.size();
-  accessor.type = TINYGLTF_TYPE_VEC2;
-
-  return accessor_idx;
+  return to_bytes(floats);
 }
 
 /*!
- * Set up a buffer of vertex colors for the given time of day index, for tfrag.
- * Uses the time of day texture to look up colors.
+ * Vertex colors, with the rgb of each vertex from get_rgb(vertex_idx).
  */
-int make_color_buffer_accessor(const std::vector<tfrag3::PreloadedVertex>& vertices,
-                               tinygltf::Model& model,
-                               const tfrag3::TfragTree& tfrag_tree,
-                               int time_of_day) {
-  // first create a buffer:
-  int buffer_idx = (int)model.buffers.size();
-  auto& buffer = model.buffers.emplace_back();
-  buffer.data.resize(sizeof(float) * 4 * vertices.size());
+template <typename F>
+std::vector<u8> color_data(size_t vertex_count, F&& get_rgb) {
   std::vector<float> floats;
-
-  for (size_t i = 0; i < vertices.size(); i++) {
-    auto& color = tfrag_tree.colors.at(vertices[i].color_index);
+  floats.reserve(4 * vertex_count);
+  for (size_t i = 0; i < vertex_count; i++) {
+    const u8* rgb = get_rgb(i);
     for (int j = 0; j < 3; j++) {
-      floats.push_back(((float)color.rgba[time_of_day][j]) / 255.f);
+      floats.push_back(((float)rgb[j]) / 255.f);
     }
     floats.push_back(1.f);
   }
-  memcpy(buffer.data.data(), floats.data(), sizeof(float) * floats.size());
-
-  // create a view of this buffer
-  int buffer_view_idx = (int)model.bufferViews.size();
-  auto& buffer_view = model.bufferViews.emplace_back();
-  buffer_view.buffer = buffer_idx;
-  buffer_view.byteOffset = 0;
-  buffer_view.byteLength = buffer.data.size();
-  buffer_view.byteStride = 0;  // tightly packed
-  buffer_view.target = TINYGLTF_TARGET_ARRAY_BUFFER;
-
-  int accessor_idx = (int)model.accessors.size();
-  auto& accessor = model.accessors.emplace_back();
-  accessor.bufferView = buffer_view_idx;
-  accessor.byteOffset = 0;
-  accessor.componentType = TINYGLTF_COMPONENT_TYPE_FLOAT;
-  accessor.count = vertices.size();
-  accessor.type = TINYGLTF_TYPE_VEC4;
-
-  return accessor_idx;
+  return to_bytes(floats);
 }
 
 /*!
- * Set up a buffer of vertex colors for the given time of day index, for tie.
- * Uses the time of day texture to look up colors.
+ * Convert a tfrag or tie tree. Uses the time of day colors to look up vertex colors.
  */
-int make_color_buffer_accessor(const std::vector<tfrag3::PreloadedVertex>& vertices,
-                               tinygltf::Model& model,
-                               const tfrag3::TieTree& tie_tree,
-                               int time_of_day) {
-  // first create a buffer:
-  int buffer_idx = (int)model.buffers.size();
-  auto& buffer = model.buffers.emplace_back();
-  buffer.data.resize(sizeof(float) * 4 * vertices.size());
-  std::vector<float> floats;
-
-  for (size_t i = 0; i < vertices.size(); i++) {
-    auto& color = tie_tree.colors.at(vertices[i].color_index);
-    for (int j = 0; j < 3; j++) {
-      floats.push_back(((float)color.rgba[time_of_day][j]) / 255.f);
-    }
-    floats.push_back(1.f);
+template <typename Tree>
+MeshData tfrag_tie_mesh_data(const Tree& tree_in) {
+  // copy and unpack in place
+  Tree tree = tree_in;
+  tree.unpack();
+  const auto& vertices = tree.unpacked.vertices;
+
+  MeshData result;
+  result.vertex_count = vertices.size();
+  result.positions = position_data(vertices);
+  result.texcoords = tex_data(vertices, 1.f);
+  for (int i = 0; i < kMaxColor; i++) {
+    result.colors[i] = color_data(vertices.size(), [&](size_t v) {
+      return tree.colors.at(vertices[v].color_index).rgba[i].data();
+    });
   }
-  memcpy(buffer.data.data(), floats.data(), sizeof(float) * floats.size());
-
-  // create a view of this buffer
-  int buffer_view_idx = (int)model.bufferViews.size();
-  auto& buffer_view = model.bufferViews.emplace_back();
-  buffer_view.buffer = buffer_idx;
-  buffer_view.byteOffset = 0;
-  buffer_view.byteLength = buffer.data.size();
-  buffer_view.byteStride = 0;  // tightly packed
-  buffer_view.target = TINYGLTF_TARGET_ARRAY_BUFFER;
-
-  int accessor_idx = (int)model.accessors.size();
-  auto& accessor = model.accessors.emplace_back();
-  accessor.bufferView = buffer_view_idx;
-  accessor.byteOffset = 0;
-  accessor.componentType = TINYGLTF_COMPONENT_TYPE_FLOAT;
-  accessor.count = vertices.size();
-  accessor.type = TINYGLTF_TYPE_VEC4;
-
-  return accessor_idx;
-}
 
-int make_color_buffer_accessor(const std::vector<tfrag3::MercVertex>& vertices,
-                               tinygltf::Model& model) {
-  // first create a buffer:
-  int buffer_idx = (int)model.buffers.size();
-  auto& buffer = model.buffers.emplace_back();
-  buffer.data.resize(sizeof(float) * 4 * vertices.size());
-  std::vector<float> floats;
+  std::vector<u32> unstripped, index_map;
+  unstrip_tfrag_tie(tree.unpacked.indices, extract_positions(vertices), unstripped, index_map);
+  result.indices = to_bytes(unstripped);
 
-  for (size_t i = 0; i < vertices.size(); i++) {
-    for (int j = 0; j < 3; j++) {
-      floats.push_back(((float)vertices[i].rgba[j]) / 255.f);
+  const auto& draws = [&]() -> const std::vector<tfrag3::StripDraw>& {
+    if constexpr (std::is_same<Tree, tfrag3::TfragTree>::value) {
+      return tree.draws;
+    } else {
+      return tree.static_draws;
     }
-    floats.push_back(1.f);
+  }();
+  for (auto& draw : draws) {
+    result.draws.push_back({index_map.at(draw.unpacked.idx_of_first_idx_in_full_buffer),
+                            draw.num_triangles * 3, draw.tree_tex_id, draw.mode});
   }
-  memcpy(buffer.data.data(), floats.data(), sizeof(float) * floats.size());
-
-  // create a view of this buffer
-  int buffer_view_idx = (int)model.bufferViews.size();
-  auto& buffer_view = model.bufferViews.emplace_back();
-  buffer_view.buffer = buffer_idx;
-  buffer_view.byteOffset = 0;
-  buffer_view.byteLength = buffer.data.size();
-  buffer_view.byteStride = 0;  // tightly packed
-  buffer_view.target = TINYGLTF_TARGET_ARRAY_BUFFER;
-
-  int accessor_idx = (int)model.accessors.size();
-  auto& accessor = model.accessors.emplace_back();
-  accessor.bufferView = buffer_view_idx;
-  accessor.byteOffset = 0;
-  accessor.componentType = TINYGLTF_COMPONENT_TYPE_FLOAT;
-  accessor.count = vertices.size();
-  accessor.type = TINYGLTF_TYPE_VEC4;
-
-  return accessor_idx;
+  result.nodes.push_back({"", (int)result.draws.size()});
+  return result;
 }
 
-/*!
- * Set up a buffer of vertex colors for the given time of day index, for shrub.
- * Uses the time of day texture to look up colors.
- */
-int make_color_buffer_accessor(const std::vector<tfrag3::ShrubGpuVertex>& vertices,
-                               tinygltf::Model& model,
-                               const tfrag3::ShrubTree& shrub_tree,
-                               int time_of_day) {
-  // first create a buffer:
-  int buffer_idx = (int)model.buffers.size();
-  auto& buffer = model.buffers.emplace_back();
-  buffer.data.resize(sizeof(float) * 4 * vertices.size());
-  std::vector<float> floats;
+MeshData shrub_mesh_data(const tfrag3::ShrubTree& shrub_in) {
+  // copy and unpack in place
+  tfrag3::ShrubTree shrub = shrub_in;
+  shrub.unpack();
+  const auto& vertices = shrub.unpacked.vertices;
 
-  for (size_t i = 0; i < vertices.size(); i++) {
-    auto& color = shrub_tree.time_of_day_colors.at(vertices[i].color_index);
-    for (int j = 0; j < 3; j++) {
-      floats.push_back(((float)color.rgba[time_of_day][j]) / 255.f);
-    }
-    floats.push_back(1.f);
+  MeshData result;
+  result.vertex_count = vertices.size();
+  result.positions = position_data(vertices);
+  result.texcoords = tex_data(vertices, 1.f / 4096.f);
+  for (int i = 0; i < kMaxColor; i++) {
+    result.colors[i] = color_data(vertices.size(), [&](size_t v) {
+      return shrub.time_of_day_colors.at(vertices[v].color_index).rgba[i].data();
+    });
   }
-  memcpy(buffer.data.data(), floats.data(), sizeof(float) * floats.size());
-
-  // create a view of this buffer
-  int buffer_view_idx = (int)model.bufferViews.size();
-  auto& buffer_view = model.bufferViews.emplace_back();
-  buffer_view.buffer = buffer_idx;
-  buffer_view.byteOffset = 0;
-  buffer_view.byteLength = buffer.data.size();
-  buffer_view.byteStride = 0;  // tightly packed
-  buffer_view.target = TINYGLTF_TARGET_ARRAY_BUFFER;
-
-  int accessor_idx = (int)model.accessors.size();
-  auto& accessor = model.accessors.emplace_back();
-  accessor.bufferView = buffer_view_idx;
-  accessor.byteOffset = 0;
-  accessor.componentType = TINYGLTF_COMPONENT_TYPE_FLOAT;
-  accessor.count = vertices.size();
-  accessor.type = TINYGLTF_TYPE_VEC4;
-
-  return accessor_idx;
-}
 
-/*!
- * Create a tinygltf buffer and buffer view for indices, and convert to gltf format.
- * The map can be used to go from slots in the old index buffer to new.
- */
-int make_tfrag_tie_index_buffer_view(const std::vector<u32>& indices,
-                                     const std::vector<math::Vector3f>& positions,
-                                     tinygltf::Model& model,
-                                     std::vector<u32>& map_out) {
-  std::vector<u32> unstripped;
-  unstrip_tfrag_tie(indices, positions, unstripped, map_out);
-
-  // first create a buffer:
-  int buffer_idx = (int)model.buffers.size();
-  auto& buffer = model.buffers.emplace_back();
-  buffer.data.resize(sizeof(u32) * unstripped.size());
-
-  // and fill it
-  memcpy(buffer.data.data(), unstripped.data(), buffer.data.size());
-
-  // create a view of this buffer
-  int buffer_view_idx = (int)model.bufferViews.size();
-  auto& buffer_view = model.bufferViews.emplace_back();
-  buffer_view.buffer = buffer_idx;
-  buffer_view.byteOffset = 0;
-  buffer_view.byteLength = buffer.data.size();
-  buffer_view.byteStride = 0;  // tightly packed
-  buffer_view.target = TINYGLTF_TARGET_ELEMENT_ARRAY_BUFFER;
-  return buffer_view_idx;
+  std::vector<u32> unstripped, draw_to_start, draw_to_count;
+  unstrip_shrub_draws(shrub.indices, unstripped, draw_to_start, draw_to_count,
+                      shrub.static_draws);
+  result.indices = to_bytes(unstripped);
+  for (size_t draw_idx = 0; draw_idx < shrub.static_draws.size(); draw_idx++) {
+    auto& draw = shrub.static_draws[draw_idx];
+    result.draws.push_back({draw_to_start.at(draw_idx), draw_to_count.at(draw_idx),
+                            draw.tree_tex_id, draw.mode});
+  }
+  result.nodes.push_back({"", (int)result.draws.size()});
+  return result;
 }
 
 /*!
- * Create a tinygltf buffer and buffer view for indices, and convert to gltf format.
- * The map can be used to go from slots in the old index buffer to new.
+ * Convert all merc models. They share one set of buffers, and each model gets its own node.
  */
-int make_shrub_index_buffer_view(const std::vector<u32>& indices,
-                                 const std::vector<tfrag3::ShrubDraw>& draws,
-                                 tinygltf::Model& model,
-                                 std::vector<u32>& draw_to_start,
-                                 std::vector<u32>& draw_to_count) {
-  std::vector<u32> unstripped;
-  unstrip_shrub_draws(indices, unstripped, draw_to_start, draw_to_count, draws);
-
-  // first create a buffer:
-  int buffer_idx = (int)model.buffers.size();
-  auto& buffer = model.buffers.emplace_back();
-  buffer.data.resize(sizeof(u32) * unstripped.size());
-
-  // and fill it
-  memcpy(buffer.data.data(), unstripped.data(), buffer.data.size());
-
-  // create a view of this buffer
-  int buffer_view_idx = (int)model.bufferViews.size();
-  auto& buffer_view = model.bufferViews.emplace_back();
-  buffer_view.buffer = buffer_idx;
-  buffer_view.byteOffset = 0;
-  buffer_view.byteLength = buffer.data.size();
-  buffer_view.byteStride = 0;  // tightly packed
-  buffer_view.target = TINYGLTF_TARGET_ELEMENT_ARRAY_BUFFER;
-  return buffer_view_idx;
-}
-
-int make_merc_index_buffer_view(const std::vector<u32>& indices,
-                                const std::vector<tfrag3::MercModel>& models,
-                                tinygltf::Model& model,
-                                std::vector<std::vector<std::vector<u32>>>& draw_to_start,
-                                std::vector<std::vector<std::vector<u32>>>& draw_to_count) {
-  std::vector<u32> unstripped;
-  unstrip_merc_draws(indices, models, unstripped, draw_to_start, draw_to_count);
-
-  // first create a buffer:
-  int buffer_idx = (int)model.buffers.size();
-  auto& buffer = model.buffers.emplace_back();
-  buffer.data.resize(sizeof(u32) * unstripped.size());
-
-  // and fill it
-  memcpy(buffer.data.data(), unstripped.data(), buffer.data.size());
-
-  // create a view of this buffer
-  int buffer_view_idx = (int)model.bufferViews.size();
-  auto& buffer_view = model.bufferViews.emplace_back();
-  buffer_view.buffer = buffer_idx;
-  buffer_view.byteOffset = 0;
-  buffer_view.byteLength = buffer.data.size();
-  buffer_view.byteStride = 0;  // tightly packed
-  buffer_view.target = TINYGLTF_TARGET_ELEMENT_ARRAY_BUFFER;
-  return buffer_view_idx;
-}
-
-int make_index_buffer_accessor(tinygltf::Model& model,
-                               const tfrag3::StripDraw& draw,
-                               const std::vector<u32>& idx_map,
-                               int buffer_view_idx) {
-  int accessor_idx = (int)model.accessors.size();
-  auto& accessor = model.accessors.emplace_back();
-  accessor.bufferView = buffer_view_idx;
-  accessor.byteOffset = sizeof(u32) * idx_map.at(draw.unpacked.idx_of_first_idx_in_full_buffer);
-  accessor.componentType = TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT;
-  accessor.count = draw.num_triangles * 3;
-  accessor.type = TINYGLTF_TYPE_SCALAR;
-
-  return accessor_idx;
-}
-
-int make_index_buffer_accessor(tinygltf::Model& model, u32 start, u32 count, int buffer_view_idx) {
-  int accessor_idx = (int)model.accessors.size();
-  auto& accessor = model.accessors.emplace_back();
-  accessor.bufferView = buffer_view_idx;
+MeshData merc_mesh_data(const tfrag3::Level& level) {
+  const auto& mverts = level.merc_data.vertices;
 
-  accessor.byteOffset = sizeof(u32) * start;
-  accessor.componentType = TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT;
-  accessor.count = count;
-  accessor.type = TINYGLTF_TYPE_SCALAR;
+  MeshData result;
+  result.vertex_count = mverts.size();
+  result.positions = position_data(mverts);
+  result.texcoords = tex_data(mverts, 1.f);
+  result.colors[0] = color_data(mverts.size(), [&](size_t v) { return mverts[v].rgba; });
 
-  return accessor_idx;
-}
+  std::vector<u32> unstripped;
+  std::vector<std::vector<std::vector<u32>>> draw_to_start, draw_to_count;
+  unstrip_merc_draws(level.merc_data.indices, level.merc_data.models, unstripped, draw_to_start,
+                     draw_to_count);
+  result.indices = to_bytes(unstripped);
 
-int add_image_for_tex(const tfrag3::Level& level,
-                      tinygltf::Model& model,
-                      int tex_idx,
-                      std::unordered_map<int, int>& tex_image_map) {
-  const auto& existing = tex_image_map.find(tex_idx);
-  if (existing != tex_image_map.end()) {
-    return existing->second;
+  for (size_t model_idx = 0; model_idx < level.merc_data.models.size(); model_idx++) {
+    const auto& mmodel = level.merc_data.models[model_idx];
+    auto& node = result.nodes.emplace_back();
+    node.name = mmodel.name;
+    for (size_t effect_idx = 0; effect_idx < mmodel.effects.size(); effect_idx++) {
+      const auto& effect = mmodel.effects[effect_idx];
+      for (size_t draw_idx = 0; draw_idx < effect.all_draws.size(); draw_idx++) {
+        const auto& draw = effect.all_draws[draw_idx];
+        result.draws.push_back({draw_to_start[model_idx][effect_idx][draw_idx],
+                                draw_to_count[model_idx][effect_idx][draw_idx], draw.tree_tex_id,
+                                draw.mode});
+        node.draw_count++;
+      }
+    }
   }
-
-  auto& tex = level.textures.at(tex_idx);
-  int image_idx = (int)model.images.size();
-  auto& image = model.images.emplace_back();
-  image.pixel_type = TINYGLTF_TEXTURE_TYPE_UNSIGNED_BYTE;
-  image.width = tex.w;
-  image.height = tex.h;
-  image.image.resize(tex.data.size() * 4);
-  image.bits = 8;
-  image.component = 4;
-  image.mimeType = "image/png";
-  image.name = tex.debug_name;
-  memcpy(image.image.data(), tex.data.data(), tex.data.size() * 4);
-
-  tex_image_map[tex_idx] = image_idx;
-  return image_idx;
-}
-
-int add_material_for_tex(const tfrag3::Level& level,
-                         tinygltf::Model& model,
-                         int tex_idx,
-                         std::unordered_map<int, int>& tex_image_map,
-                         const DrawMode& draw_mode) {
-  int mat_idx = (int)model.materials.size();
-  auto& mat = model.materials.emplace_back();
-  auto& tex = level.textures.at(tex_idx);
-
-  mat.doubleSided = true;
-  // the 2.0 here compensates for the ps2's weird blending where 0.5 behaves like 1.0
-  mat.pbrMetallicRoughness.baseColorFactor = {2.0, 2.0, 2.0, 2.0};
-  mat.pbrMetallicRoughness.baseColorTexture.texCoord = 0;  // TEXCOORD_0, I think
-  mat.pbrMetallicRoughness.baseColorTexture.index = model.textures.size();
-  mat.alphaMode = draw_mode.get_ab_enable() ? "BLEND" : "MASK";
-  // the foreground and background renderers both use this cutoff
-  mat.alphaCutoff = (float)0x26 / 255.f;
-  auto& gltf_texture = model.textures.emplace_back();
-  gltf_texture.name = tex.debug_name;
-  gltf_texture.sampler = model.samplers.size();
-  auto& sampler = model.samplers.emplace_back();
-  sampler.minFilter = draw_mode.get_filt_enable() ? TINYGLTF_TEXTURE_FILTER_LINEAR
-                                                  : TINYGLTF_TEXTURE_FILTER_NEAREST;
-  sampler.magFilter = draw_mode.get_filt_enable() ? TINYGLTF_TEXTURE_FILTER_LINEAR
-                                                  : TINYGLTF_TEXTURE_FILTER_NEAREST;
-  sampler.wrapS = draw_mode.get_clamp_s_enable() ? TINYGLTF_TEXTURE_WRAP_CLAMP_TO_EDGE
-                                                 : TINYGLTF_TEXTURE_WRAP_REPEAT;
-  sampler.wrapT = draw_mode.get_clamp_t_enable() ? TINYGLTF_TEXTURE_WRAP_CLAMP_TO_EDGE
-                                                 : TINYGLTF_TEXTURE_WRAP_REPEAT;
-  sampler.name = tex.debug_name;
-
-  gltf_texture.source = add_image_for_tex(level, model, tex_idx, tex_image_map);
-
-  return mat_idx;
+  return result;
 }
 
-constexpr int kMaxColor = 1;
 /*!
- * Add the given tfrag data to a node under tfrag_root.
+ * The binary chunk of the glb file, which holds the vertex data, indices, and images. All buffer
+ * views point into this one buffer. It's kept as separate pieces which are written out one after
+ * another, instead of being copied into one big allocation.
  */
-void add_tfrag(const tfrag3::Level& level,
-               const tfrag3::TfragTree& tfrag_in,
-               tinygltf::Model& model,
-               std::unordered_map<int, int>& tex_image_map) {
-  // copy and unpack in place
-  tfrag3::TfragTree tfrag = tfrag_in;
-  tfrag.unpack();
-
-  // we'll make a Node, Mesh, Primitive, then add the data to the primitive.
-  int node_idx = (int)model.nodes.size();
-  auto& node = model.nodes.emplace_back();
-  model.scenes.at(0).nodes.push_back(node_idx);
-
-  int mesh_idx = (int)model.meshes.size();
-  auto& mesh = model.meshes.emplace_back();
-  node.mesh = mesh_idx;
-
-  int position_buffer_accessor = make_position_buffer_accessor(tfrag.unpacked.vertices, model);
-  int texture_buffer_accessor = make_tex_buffer_accessor(tfrag.unpacked.vertices, model, 1.f);
-  std::vector<u32> index_map;
-  int index_buffer_view = make_tfrag_tie_index_buffer_view(
-      tfrag.unpacked.indices, extract_positions(tfrag.unpacked.vertices), model, index_map);
-  int colors[kMaxColor];
-
-  for (int i = 0; i < kMaxColor; i++) {
-    colors[i] = make_color_buffer_accessor(tfrag.unpacked.vertices, model, tfrag, i);
+class GlbBinary {
+ public:
+  /*!
+   * Add a buffer view for this data. Return the index of the buffer view.
+   */
+  int add_buffer_view(tinygltf::Model& model, std::vector<u8>&& data, int target) {
+    int buffer_view_idx = (int)model.bufferViews.size();
+    auto& buffer_view = model.bufferViews.emplace_back();
+    buffer_view.buffer = 0;
+    buffer_view.byteOffset = m_size;
+    buffer_view.byteLength = data.size();
+    buffer_view.byteStride = 0;  // tightly packed
+    buffer_view.target = target;
+
+    // buffer views of floats and u32s must be 4-byte aligned.
+    data.resize((data.size() + 3) & ~3);
+    m_size += data.size();
+    m_pieces.push_back(std::move(data));
+    return buffer_view_idx;
   }
 
-  for (auto& draw : tfrag.draws) {
-    auto& prim = mesh.primitives.emplace_back();
-    prim.material = add_material_for_tex(level, model, draw.tree_tex_id, tex_image_map, draw.mode);
-    prim.indices = make_index_buffer_accessor(model, draw, index_map, index_buffer_view);
-    prim.attributes["POSITION"] = position_buffer_accessor;
-    prim.attributes["TEXCOORD_0"] = texture_buffer_accessor;
-    for (int i = 0; i < kMaxColor; i++) {
-      prim.attributes[fmt::format("COLOR_{}", i)] = colors[i];
+  /*!
+   * Write the glb file: the header, the json for the model, then the binary chunk.
+   */
+  void write(tinygltf::Model& model, const fs::path& glb_file) {
+    std::stringstream json_stream;
+    tinygltf::TinyGLTF gltf;
+    gltf.WriteGltfSceneToStream(&model, json_stream, false, false);
+    auto json = nlohmann::json::parse(json_stream.str());
+    json["buffers"] = nlohmann::json::array({nlohmann::json{{"byteLength", m_size}}});
+    auto json_text = json.dump();
+    json_text.resize((json_text.size() + 3) & ~3, ' ');
+
+    FILE* fp = file_util::open_file(glb_file, "wb");
+    if (!fp) {
+      throw std::runtime_error("couldn't open file " + glb_file.string());
+    }
+    auto write_u32 = [&](u32 x) { fwrite(&x, sizeof(u32), 1, fp); };
+    write_u32(0x46546C67);  // glTF
+    write_u32(2);           // version
+    write_u32(12 + 8 + json_text.size() + 8 + m_size);
+    write_u32(json_text.size());
+    write_u32(0x4E4F534A);  // JSON
+    fwrite(json_text.data(), json_text.size(), 1, fp);
+    write_u32(m_size);
+    write_u32(0x004E4942);  // BIN
+    for (auto& piece : m_pieces) {
+      if (!piece.empty() && fwrite(piece.data(), piece.size(), 1, fp) != 1) {
+        fclose(fp);
+        throw std::runtime_error("couldn't write file " + glb_file.string());
+      }
+      std::vector<u8>().swap(piece);
     }
-    prim.mode = TINYGLTF_MODE_TRIANGLES;
+    fclose(fp);
   }
-}
-
-void add_tie(const tfrag3::Level& level,
-             const tfrag3::TieTree& tie_in,
-             tinygltf::Model& model,
-             std::unordered_map<int, int>& tex_image_map) {
-  // copy and unpack in place
-  tfrag3::TieTree tie = tie_in;
-  tie.unpack();
 
-  // we'll make a Node, Mesh, Primitive, then add the data to the primitive.
-  int node_idx = (int)model.nodes.size();
-  auto& node = model.nodes.emplace_back();
-  model.scenes.at(0).nodes.push_back(node_idx);
+ private:
+  std::vector<std::vector<u8>> m_pieces;
+  size_t m_size = 0;
+};
 
-  int mesh_idx = (int)model.meshes.size();
-  auto& mesh = model.meshes.emplace_back();
-  node.mesh = mesh_idx;
-
-  int position_buffer_accessor = make_position_buffer_accessor(tie.unpacked.vertices, model);
-  int texture_buffer_accessor = make_tex_buffer_accessor(tie.unpacked.vertices, model, 1.f);
-  std::vector<u32> index_map;
-  int index_buffer_view = make_tfrag_tie_index_buffer_view(
-      tie.unpacked.indices, extract_positions(tie.unpacked.vertices), model, index_map);
-  int colors[kMaxColor];
-
-  for (int i = 0; i < kMaxColor; i++) {
-    colors[i] = make_color_buffer_accessor(tie.unpacked.vertices, model, tie, i);
+/*!
+ * Builds up the model, with all geometry and images in one binary buffer.
+ */
+class GltfBuilder {
+ public:
+  explicit GltfBuilder(const tfrag3::Level& level) : m_level(level) {
+    // a "scene" is a traditional scene graph, made up of Nodes.
+    // sadly, attempting to nest stuff makes the blender importer unhappy, so we just dump
+    // everything into the top level.
+    m_model.scenes.emplace_back();
+
+    // hack, add a default material.
+    tinygltf::Material mat;
+    mat.pbrMetallicRoughness.baseColorFactor = {1.0f, 0.9f, 0.9f, 1.0f};
+    mat.doubleSided = true;
+    m_model.materials.push_back(mat);
   }
 
-  for (auto& draw : tie.static_draws) {
-    auto& prim = mesh.primitives.emplace_back();
-    prim.material = add_material_for_tex(level, model, draw.tree_tex_id, tex_image_map, draw.mode);
-    prim.indices = make_index_buffer_accessor(model, draw, index_map, index_buffer_view);
-    prim.attributes["POSITION"] = position_buffer_accessor;
-    prim.attributes["TEXCOORD_0"] = texture_buffer_accessor;
+  /*!
+   * Add the nodes and meshes for this data, in the top level of the scene.
+   */
+  void add_mesh(MeshData&& data) {
+    int position_accessor = add_vertex_accessor(std::move(data.positions), data.vertex_count,
+                                                TINYGLTF_TYPE_VEC3);
+    int texture_accessor = add_vertex_accessor(std::move(data.texcoords), data.vertex_count,
+                                               TINYGLTF_TYPE_VEC2);
+    int colors[kMaxColor];
     for (int i = 0; i < kMaxColor; i++) {
-      prim.attributes[fmt::format("COLOR_{}", i)] = colors[i];
+      colors[i] =
+          add_vertex_accessor(std::move(data.colors[i]), data.vertex_count, TINYGLTF_TYPE_VEC4);
+    }
+    int index_buffer_view = m_bin.add_buffer_view(m_model, std::move(data.indices),
+                                                  TINYGLTF_TARGET_ELEMENT_ARRAY_BUFFER);
+
+    size_t draw_idx = 0;
+    for (auto& node_data : data.nodes) {
+      int node_idx = (int)m_model.nodes.size();
+      auto& node = m_model.nodes.emplace_back();
+      m_model.scenes.at(0).nodes.push_back(node_idx);
+      node.name = node_data.name;
+      int mesh_idx = (int)m_model.meshes.size();
+      auto& mesh = m_model.meshes.emplace_back();
+      mesh.name = node.name;
+      node.mesh = mesh_idx;
+
+      for (int i = 0; i < node_data.draw_count; i++) {
+        const auto& draw = data.draws.at(draw_idx++);
+        auto& prim = mesh.primitives.emplace_back();
+        prim.material = add_material_for_tex(draw.tex_id, draw.mode);
+        prim.indices = add_index_accessor(draw.start, draw.count, index_buffer_view);
+        prim.attributes["POSITION"] = position_accessor;
+        prim.attributes["TEXCOORD_0"] = texture_accessor;
+        for (int c = 0; c < kMaxColor; c++) {
+          prim.attributes[fmt::format("COLOR_{}", c)] = colors[c];
+        }
+        prim.mode = TINYGLTF_MODE_TRIANGLES;
+      }
     }
-    prim.mode = TINYGLTF_MODE_TRIANGLES;
   }
-}
 
-void add_shrub(const tfrag3::Level& level,
-               const tfrag3::ShrubTree& shrub_in,
-               tinygltf::Model& model,
-               std::unordered_map<int, int>& tex_image_map) {
-  // copy and unpack in place
-  tfrag3::ShrubTree shrub = shrub_in;
-  shrub.unpack();
+  /*!
+   * Encode the images as png and write the glb file.
+   */
+  void write(const fs::path& glb_file) {
+    std::vector<std::vector<u8>> pngs(m_image_textures.size());
+    parallel_for(pngs.size(), [&](int i) {
+      const auto& tex = m_level.textures.at(m_image_textures[i]);
+      auto rgba = texture_compression::texture_rgba(tex);
+      pngs[i] = file_util::encode_rgba_png(rgba.data(), tex.w, tex.h);
+    });
+    for (size_t i = 0; i < pngs.size(); i++) {
+      m_model.images.at(i).bufferView = m_bin.add_buffer_view(m_model, std::move(pngs[i]), 0);
+    }
 
-  // we'll make a Node, Mesh, Primitive, then add the data to the primitive.
-  int node_idx = (int)model.nodes.size();
-  auto& node = model.nodes.emplace_back();
-  model.scenes.at(0).nodes.push_back(node_idx);
-
-  int mesh_idx = (int)model.meshes.size();
-  auto& mesh = model.meshes.emplace_back();
-  node.mesh = mesh_idx;
-
-  int position_buffer_accessor = make_position_buffer_accessor(shrub.unpacked.vertices, model);
-  int texture_buffer_accessor =
-      make_tex_buffer_accessor(shrub.unpacked.vertices, model, 1.f / 4096.f);
-  std::vector<u32> draw_to_start, draw_to_count;
-  int index_buffer_view = make_shrub_index_buffer_view(shrub.indices, shrub.static_draws, model,
-                                                       draw_to_start, draw_to_count);
-  int colors[kMaxColor];
-  for (int i = 0; i < kMaxColor; i++) {
-    colors[i] = make_color_buffer_accessor(shrub.unpacked.vertices, model, shrub, i);
+    m_model.asset.generator = "opengoal";
+    m_bin.write(m_model, glb_file);
   }
 
-  // for (auto& draw : shrub.static_draws) {
-  for (size_t draw_idx = 0; draw_idx < shrub.static_draws.size(); draw_idx++) {
-    auto& draw = shrub.static_draws[draw_idx];
-    auto& prim = mesh.primitives.emplace_back();
-    prim.material = add_material_for_tex(level, model, draw.tree_tex_id, tex_image_map, draw.mode);
-    prim.indices = make_index_buffer_accessor(model, draw_to_start.at(draw_idx),
-                                              draw_to_count.at(draw_idx), index_buffer_view);
-    prim.attributes["POSITION"] = position_buffer_accessor;
-    prim.attributes["TEXCOORD_0"] = texture_buffer_accessor;
-    for (int i = 0; i < kMaxColor; i++) {
-      prim.attributes[fmt::format("COLOR_{}", i)] = colors[i];
-    }
-    prim.mode = TINYGLTF_MODE_TRIANGLES;
+ private:
+  int add_vertex_accessor(std::vector<u8>&& data, int count, int type) {
+    int accessor_idx = (int)m_model.accessors.size();
+    auto& accessor = m_model.accessors.emplace_back();
+    accessor.bufferView =
+        m_bin.add_buffer_view(m_model, std::move(data), TINYGLTF_TARGET_ARRAY_BUFFER);
+    accessor.byteOffset = 0;
+    accessor.componentType = TINYGLTF_COMPONENT_TYPE_FLOAT;
+    accessor.count = count;
+    accessor.type = type;
+    return accessor_idx;
   }
-}
 
-void add_merc(const tfrag3::Level& level,
-              tinygltf::Model& model,
-              std::unordered_map<int, int>& tex_image_map) {
-  const auto& mverts = level.merc_data.vertices;
-
-  // create position and uv buffers
-  int position_buffer_accessor = make_position_buffer_accessor(mverts, model);
-  int texture_buffer_accessor = make_tex_buffer_accessor(mverts, model, 1.f);
-
-  std::vector<std::vector<std::vector<u32>>> draw_to_start, draw_to_count;
-  int index_buffer_view = make_merc_index_buffer_view(
-      level.merc_data.indices, level.merc_data.models, model, draw_to_start, draw_to_count);
-  int colors = make_color_buffer_accessor(mverts, model);
+  int add_index_accessor(u32 start, u32 count, int buffer_view_idx) {
+    int accessor_idx = (int)m_model.accessors.size();
+    auto& accessor = m_model.accessors.emplace_back();
+    accessor.bufferView = buffer_view_idx;
+    accessor.byteOffset = sizeof(u32) * start;
+    accessor.componentType = TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT;
+    accessor.count = count;
+    accessor.type = TINYGLTF_TYPE_SCALAR;
+    return accessor_idx;
+  }
 
-  for (size_t model_idx = 0; model_idx < level.merc_data.models.size(); model_idx++) {
-    const auto& mmodel = level.merc_data.models[model_idx];
+  /*!
+   * Get the image for a texture. The png data is added later, by write().
+   */
+  int add_image_for_tex(int tex_idx) {
+    const auto& existing = m_tex_image_map.find(tex_idx);
+    if (existing != m_tex_image_map.end()) {
+      return existing->second;
+    }
 
-    int node_idx = (int)model.nodes.size();
-    auto& node = model.nodes.emplace_back();
-    model.scenes.at(0).nodes.push_back(node_idx);
-    node.name = mmodel.name;
-    int mesh_idx = (int)model.meshes.size();
-    auto& mesh = model.meshes.emplace_back();
-    mesh.name = node.name;
-    node.mesh = mesh_idx;
+    int image_idx = (int)m_model.images.size();
+    auto& image = m_model.images.emplace_back();
+    image.mimeType = "image/png";
+    image.name = m_level.textures.at(tex_idx).debug_name;
+    m_image_textures.push_back(tex_idx);
+    m_tex_image_map[tex_idx] = image_idx;
+    return image_idx;
+  }
 
-    for (size_t effect_idx = 0; effect_idx < mmodel.effects.size(); effect_idx++) {
-      const auto& effect = mmodel.effects[effect_idx];
-      for (size_t draw_idx = 0; draw_idx < effect.all_draws.size(); draw_idx++) {
-        const auto& draw = effect.all_draws[draw_idx];
-        auto& prim = mesh.primitives.emplace_back();
-        prim.material =
-            add_material_for_tex(level, model, draw.tree_tex_id, tex_image_map, draw.mode);
-        prim.indices = make_index_buffer_accessor(
-            model, draw_to_start[model_idx][effect_idx][draw_idx],
-            draw_to_count[model_idx][effect_idx][draw_idx], index_buffer_view);
-        prim.attributes["POSITION"] = position_buffer_accessor;
-        prim.attributes["TEXCOORD_0"] = texture_buffer_accessor;
-        prim.attributes["COLOR_0"] = colors;
-        prim.mode = TINYGLTF_MODE_TRIANGLES;
-      }
-    }
+  int add_material_for_tex(int tex_idx, const DrawMode& draw_mode) {
+    int mat_idx = (int)m_model.materials.size();
+    auto& mat = m_model.materials.emplace_back();
+    auto& tex = m_level.textures.at(tex_idx);
+
+    mat.doubleSided = true;
+    // the 2.0 here compensates for the ps2's weird blending where 0.5 behaves like 1.0
+    mat.pbrMetallicRoughness.baseColorFactor = {2.0, 2.0, 2.0, 2.0};
+    mat.pbrMetallicRoughness.baseColorTexture.texCoord = 0;  // TEXCOORD_0, I think
+    mat.pbrMetallicRoughness.baseColorTexture.index = m_model.textures.size();
+    mat.alphaMode = draw_mode.get_ab_enable() ? "BLEND" : "MASK";
+    // the foreground and background renderers both use this cutoff
+    mat.alphaCutoff = (float)0x26 / 255.f;
+    auto& gltf_texture = m_model.textures.emplace_back();
+    gltf_texture.name = tex.debug_name;
+    gltf_texture.sampler = m_model.samplers.size();
+    auto& sampler = m_model.samplers.emplace_back();
+    sampler.minFilter = draw_mode.get_filt_enable() ? TINYGLTF_TEXTURE_FILTER_LINEAR
+                                                    : TINYGLTF_TEXTURE_FILTER_NEAREST;
+    sampler.magFilter = draw_mode.get_filt_enable() ? TINYGLTF_TEXTURE_FILTER_LINEAR
+                                                    : TINYGLTF_TEXTURE_FILTER_NEAREST;
+    sampler.wrapS = draw_mode.get_clamp_s_enable() ? TINYGLTF_TEXTURE_WRAP_CLAMP_TO_EDGE
+                                                   : TINYGLTF_TEXTURE_WRAP_REPEAT;
+    sampler.wrapT = draw_mode.get_clamp_t_enable() ? TINYGLTF_TEXTURE_WRAP_CLAMP_TO_EDGE
+                                                   : TINYGLTF_TEXTURE_WRAP_REPEAT;
+    sampler.name = tex.debug_name;
+
+    gltf_texture.source = add_image_for_tex(tex_idx);
+
+    return mat_idx;
   }
-}
+
+  const tfrag3::Level& m_level;
+  tinygltf::Model m_model;
+  GlbBinary m_bin;
+  std::unordered_map<int, int> m_tex_image_map;
+  std::vector<int> m_image_textures;  // the texture for each image
+};
 }  // namespace
 
 /*!
  * Export the background geometry (tie, tfrag, shrub) to a GLTF binary format (.glb) file.
  */
 void save_level_background_as_gltf(const tfrag3::Level& level, const fs::path& glb_file) {
-  // the top level container for everything is the model.
-  tinygltf::Model model;
-
-  // a "scene" is a traditional scene graph, made up of Nodes.
-  // sadly, attempting to nest stuff makes the blender importer unhappy, so we just dump
-  // everything into the top level.
-  model.scenes.emplace_back();
-
-  // hack, add a default material.
-  tinygltf::Material mat;
-  mat.pbrMetallicRoughness.baseColorFactor = {1.0f, 0.9f, 0.9f, 1.0f};
-  mat.doubleSided = true;
-  model.materials.push_back(mat);
-
-  std::unordered_map<int, int> tex_image_map;
-
-  // add all hi-lod tfrag trees
+  // all hi-lod tfrag trees, then ties, then shrubs. Each tree is converted on its own.
+  std::vector<std::function<MeshData()>> trees;
   for (const auto& tfrag : level.tfrag_trees.at(0)) {
-    add_tfrag(level, tfrag, model, tex_image_map);
+    trees.push_back([&]() { return tfrag_tie_mesh_data(tfrag); });
   }
-
   for (const auto& tie : level.tie_trees.at(0)) {
-    add_tie(level, tie, model, tex_image_map);
+    trees.push_back([&]() { return tfrag_tie_mesh_data(tie); });
   }
-
   for (const auto& shrub : level.shrub_trees) {
-    add_shrub(level, shrub, model, tex_image_map);
+    trees.push_back([&]() { return shrub_mesh_data(shrub); });
   }
+  std::vector<MeshData> meshes(trees.size());
+  parallel_for(trees.size(), [&](int i) { meshes[i] = trees[i](); });
 
-  model.asset.generator = "opengoal";
-  tinygltf::TinyGLTF gltf;
-  gltf.WriteGltfSceneToFile(&model, glb_file.string(),
-                            true,   // embedImages
-                            true,   // embedBuffers
-                            true,   // pretty print
-                            true);  // write binary
+  // adding to the model happens in order, so the output doesn't depend on thread timing.
+  GltfBuilder builder(level);
+  for (auto& mesh : meshes) {
+    builder.add_mesh(std::move(mesh));
+  }
+  builder.write(glb_file);
 }
 
 void save_level_foreground_as_gltf(const tfrag3::Level& level, const fs::path& glb_file) {
-  // the top level container for everything is the model.
-  tinygltf::Model model;
-
-  // a "scene" is a traditional scene graph, made up of Nodes.
-  // sadly, attempting to nest stuff makes the blender importer unhappy, so we just dump
-  // everything into the top level.
-  model.scenes.emplace_back();
-
-  // hack, add a default material.
-  tinygltf::Material mat;
-  mat.pbrMetallicRoughness.baseColorFactor = {1.0f, 0.9f, 0.9f, 1.0f};
-  mat.doubleSided = true;
-  model.materials.push_back(mat);
-
-  std::unordered_map<int, int> tex_image_map;
-
-  add_merc(level, model, tex_image_map);
-
-  model.asset.generator = "opengoal";
-  tinygltf::TinyGLTF gltf;
-  gltf.WriteGltfSceneToFile(&model, glb_file.string(),
-                            true,   // embedImages
-                            true,   // embedBuffers
-                            true,   // pretty print
-                            true);  // write binary
-}
\ No newline at end of file
+  GltfBuilder builder(level);
+  builder.add_mesh(merc_mesh_data(level));
+  builder.write(glb_file);
+}
@@ -110,6 +110,10 @@ void build_function(FunctionCache& function_cache,
   // figure out the order we'll visit all blocks
   // todo: do something with unreachables?
   function_cache.block_visit_order = func.bb_topo_sort().vist_order;
+  function_cache.visit_position.resize(function_cache.blocks.size(), -1);
+  for (size_t i = 0; i < function_cache.block_visit_order.size(); i++) {
+    function_cache.visit_position.at(function_cache.block_visit_order[i]) = i;
+  }
 
   // to save time, we store types at the entry of each block, then in the instructions inside
   // each block, store types sparsely. This saves very slow copying around of types.
@@ -324,7 +328,7 @@ void backprop_from_preds(FunctionCache& cache,
               ASSERT(!st.tag.has_tag());
               st.tag.kind = Tag::BLOCK_ENTRY;
               st.tag.block_entry = tag;
-              succ_cblock.needs_run = true;
+              cache.mark_needs_run(succ_idx);
             }
           }
         }
@@ -333,7 +337,7 @@ void backprop_from_preds(FunctionCache& cache,
         if (resolve_type) {
           if (backprop_tagged_type(*resolve_type, *(*block_end_typestate)[reg], dts)) {
             // if we've changed things, mark this block to be re-ran.
-            cblock.needs_run = true;
+            cache.mark_needs_run(block_idx);
           }
         }
       }
@@ -347,35 +351,38 @@ void backprop_from_preds(FunctionCache& cache,
       tags_updated = true;
       my_tag->updated = false;
       // lg::print("clearing {}\n", block_idx);
-      cblock.needs_run = true;      // maybe?
+      cache.mark_needs_run(block_idx);  // maybe?
       *my_tag->type_to_clear = {};  // meh..
     }
   }
 
   if (tags_updated) {
     for (auto& pred : block.pred) {
-      cache.blocks.at(pred).needs_run = true;
+      cache.mark_needs_run(pred);
     }
   }
 }
 
-std::optional<TP_Type> tp_lca(const types2::Type& existing,
-                              const types2::Type& add,
-                              bool* changed,
-                              DecompilerTypeSystem& dts) {
-  if (existing.type && add.type) {
-    return dts.tp_lca(*existing.type, *add.type, changed);
-  } else if (existing.type && !add.type) {
-    *changed = false;
-    return existing.type;
-  } else if (!existing.type && add.type) {
-    *changed = true;
-    return add.type;
-  } else {
-    // neither
-    *changed = false;
-    return {};
+/*!
+ * Update existing to the least common ancestor of existing and add. Returns true if it changed.
+ * Unchanged types are left alone, rather than being copied back into place.
+ */
+bool tp_lca(types2::Type* existing, const types2::Type& add, DecompilerTypeSystem& dts) {
+  if (!add.type) {
+    return false;
+  }
+
+  if (!existing->type) {
+    existing->type = add.type;
+    return true;
+  }
+
+  bool changed = false;
+  auto new_type = dts.tp_lca(*existing->type, *add.type, &changed);
+  if (changed) {
+    existing->type = std::move(new_type);
   }
+  return changed;
 }
 
 /*!
@@ -384,25 +391,18 @@ std::optional<TP_Type> tp_lca(const types2::Type& existing,
 bool tp_lca(types2::TypeState* combined, const types2::TypeState& add, DecompilerTypeSystem& dts) {
   bool result = false;
   for (int i = 0; i < 32; i++) {
-    bool diff = false;
-    auto new_type = tp_lca(*combined->gpr_types[i], *add.gpr_types[i], &diff, dts);
-    if (diff) {
+    if (tp_lca(combined->gpr_types[i], *add.gpr_types[i], dts)) {
       result = true;
-      combined->gpr_types[i]->type = new_type;
     }
   }
 
   for (int i = 0; i < 32; i++) {
-    bool diff = false;
-    auto new_type = tp_lca(*combined->fpr_types[i], *add.fpr_types[i], &diff, dts);
-    if (diff) {
+    if (tp_lca(combined->fpr_types[i], *add.fpr_types[i], dts)) {
       result = true;
-      combined->fpr_types[i]->type = new_type;
     }
   }
 
   for (auto& x : add.stack_slot_types) {
-    bool diff = false;
     auto comb = combined->try_find_stack_spill_slot(x->slot);
     if (!comb) {
       lg::print("failed to find {}\n", x->slot);
@@ -411,18 +411,13 @@ bool tp_lca(types2::TypeState* combined, const types2::TypeState& add, Decompile
       }
     }
     ASSERT(comb);
-    auto new_type = tp_lca(*comb, x->type, &diff, dts);
-    if (diff) {
+    if (tp_lca(comb, x->type, dts)) {
       result = true;
-      comb->type = new_type;
     }
   }
 
-  bool diff = false;
-  auto new_type = tp_lca(*combined->next_state_type, *add.next_state_type, &diff, dts);
-  if (diff) {
+  if (tp_lca(combined->next_state_type, *add.next_state_type, dts)) {
     result = true;
-    combined->next_state_type->type = new_type;
   }
 
   return result;
@@ -460,7 +455,7 @@ bool propagate_block(FunctionCache& cache,
         return false;
       }
       if (extras.needs_rerun) {
-        cblock.needs_run = true;
+        cache.mark_needs_run(block_idx);
       }
       // propagate forward
       // TODO
@@ -485,7 +480,7 @@ bool propagate_block(FunctionCache& cache,
       // set types to LCA (current, new)
       if (tp_lca(&cache.blocks.at(succ_block_id).start_type_state, *previous_typestate, dts)) {
         // if something changed, run again!
-        cache.blocks.at(succ_block_id).needs_run = true;
+        cache.mark_needs_run(succ_block_id);
       }
     }
   }
@@ -584,6 +579,26 @@ bool convert_to_old_format(Output& out,
   return true;
 }
 
+/*!
+ * Run one pass over the queued blocks, in visit order. A block queued at or before the current
+ * position (including the block being run) waits for the next pass, so this visits blocks in the
+ * same order as a sweep over block_visit_order that checks needs_run, without the sweep.
+ */
+bool run_queued_blocks(FunctionCache& cache, Function& func, bool tag_lock, int* blocks_run) {
+  int pos = -1;
+  for (auto it = cache.run_queue.upper_bound(pos); it != cache.run_queue.end();
+       it = cache.run_queue.upper_bound(pos)) {
+    pos = *it;
+    cache.run_queue.erase(it);
+    (*blocks_run)++;
+    if (!propagate_block(cache, cache.block_visit_order.at(pos), func, *func.ir2.env.dts,
+                         tag_lock)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 /*!
  * Main Types2 Analysis pass.
  */
@@ -596,6 +611,8 @@ void run(Output& out, const Input& input) {
   // annoying hack
   if (input.func->guessed_name.kind == FunctionName::FunctionKind::METHOD) {
     input.dts->type_prop_settings.current_method_type = input.func->guessed_name.type_name;
+  } else {
+    input.dts->type_prop_settings.reset();
   }
 
   if (input.function_type.last_arg() == TypeSpec("none")) {
@@ -605,7 +622,7 @@ void run(Output& out, const Input& input) {
   }
 
   // mark the entry block
-  function_cache.blocks.at(0).needs_run = true;
+  function_cache.mark_needs_run(0);
   construct_function_entry_types(function_cache.blocks.at(0).start_types, input.function_type,
                                  stack_slots);
 
@@ -616,19 +633,12 @@ void run(Output& out, const Input& input) {
   bool hit_error = false;
   while (needs_rerun) {
     outer_iterations++;
-    needs_rerun = false;
-
-    for (auto block_idx : function_cache.block_visit_order) {
-      if (function_cache.blocks.at(block_idx).needs_run) {
-        blocks_run++;
-        needs_rerun = true;
-        if (!propagate_block(function_cache, block_idx, *input.func, *input.func->ir2.env.dts,
-                             false)) {
-          hit_error = true;
-          goto end_type_pass;
-        }
-      }
+    int blocks_run_before = blocks_run;
+    if (!run_queued_blocks(function_cache, *input.func, false, &blocks_run)) {
+      hit_error = true;
+      goto end_type_pass;
     }
+    needs_rerun = blocks_run != blocks_run_before;
 
     auto& return_type = input.function_type.last_arg();
     if (return_type != TypeSpec("none")) {
@@ -663,21 +673,15 @@ void run(Output& out, const Input& input) {
   }
 
   needs_rerun = true;
-  function_cache.blocks.at(0).needs_run = true;
+  function_cache.mark_needs_run(0);
   while (needs_rerun) {
     outer_iterations++;
-    needs_rerun = false;
-    for (auto block_idx : function_cache.block_visit_order) {
-      if (function_cache.blocks.at(block_idx).needs_run) {
-        blocks_run++;
-        needs_rerun = true;
-        if (!propagate_block(function_cache, block_idx, *input.func, *input.func->ir2.env.dts,
-                             true)) {
-          hit_error = true;
-          goto end_type_pass;
-        }
-      }
+    int blocks_run_before = blocks_run;
+    if (!run_queued_blocks(function_cache, *input.func, true, &blocks_run)) {
+      hit_error = true;
+      goto end_type_pass;
     }
+    needs_rerun = blocks_run != blocks_run_before;
   }
 
 end_type_pass:
@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <optional>
+#include <set>
 #include <variant>
 #include <vector>
 
@@ -219,6 +220,18 @@ struct FunctionCache {
   std::vector<RegType> reg_type_casts;
   std::vector<StackSlotType> stack_slot_casts;
   std::vector<int> block_visit_order;
+  // index of each block in block_visit_order, or -1 if the block is never visited.
+  std::vector<int> visit_position;
+  // visit positions of the blocks that have needs_run set.
+  std::set<int> run_queue;
+
+  void mark_needs_run(int block_idx) {
+    blocks.at(block_idx).needs_run = true;
+    int pos = visit_position.at(block_idx);
+    if (pos >= 0) {
+      run_queue.insert(pos);
+    }
+  }
 };
 
 struct Output {
@@ -6,12 +6,17 @@
 #include "common/log/log.h"
 #include "common/type_system/defenum.h"
 #include "common/type_system/deftype.h"
+#include "common/util/Serializer.h"
 #include "common/util/string_util.h"
 
 #include "decompiler/Disasm/Register.h"
 
+#include "third-party/zstd/lib/common/xxhash.h"
+
 namespace decompiler {
-DecompilerTypeSystem::DecompilerTypeSystem(GameVersion version) {
+thread_local DecompilerTypeSystem::TypePropSettings DecompilerTypeSystem::type_prop_settings;
+
+DecompilerTypeSystem::DecompilerTypeSystem(GameVersion version) : m_version(version) {
   ts.add_builtin_types(version);
 }
 
@@ -46,9 +51,32 @@ void for_each_in_list(goos::Object& list, T f) {
     throw std::runtime_error("malformed list");
   }
 }
+
+// change this when the cache format changes, or when parsing types gives different results.
+constexpr u64 TYPE_DEFS_CACHE_VERSION = 1;
+
+struct TypeDefsCacheHeader {
+  u64 source_hash = 0;
+  u64 data_size = 0;  // bytes after the header
+};
 }  // namespace
 
-void DecompilerTypeSystem::parse_type_defs(const std::vector<std::string>& file_path) {
+void DecompilerTypeSystem::parse_type_defs(const std::vector<std::string>& file_path,
+                                           bool use_cache) {
+  fs::path cache_path;
+  u64 source_hash = 0;
+  if (use_cache) {
+    auto source_path = file_util::get_file_path(file_path);
+    auto text = file_util::read_text_file(source_path);
+    source_hash = XXH64(text.data(), text.size(), TYPE_DEFS_CACHE_VERSION * 16 + (u64)m_version);
+    cache_path = file_util::get_jak_project_dir() / "out" / game_version_names[m_version] /
+                 (fs::path(source_path).stem().string() + ".typedb");
+    if (try_load_type_defs_cache(cache_path, source_hash)) {
+      lg::info("Loaded types from {}", cache_path.string());
+      return;
+    }
+  }
+
   auto read = m_reader.read_from_file(file_path);
   auto& data = cdr(read);
 
@@ -113,9 +141,75 @@ void DecompilerTypeSystem::parse_type_defs(const std::vector<std::string>& file_
       throw e;
     }
   });
+
+  if (use_cache) {
+    save_type_defs_cache(cache_path, source_hash);
+  }
+}
+
+bool DecompilerTypeSystem::try_load_type_defs_cache(const fs::path& path, u64 source_hash) {
+  if (!fs::exists(path)) {
+    return false;
+  }
+  auto data = file_util::read_binary_file(path);
+  TypeDefsCacheHeader header;
+  if (data.size() < sizeof(header)) {
+    return false;
+  }
+  memcpy(&header, data.data(), sizeof(header));
+  // the size is checked so a cut off file is just ignored, loading it would assert.
+  if (header.source_hash != source_hash || header.data_size != data.size() - sizeof(header)) {
+    return false;
+  }
+  Serializer ser(std::move(data), false);
+  ser.load<TypeDefsCacheHeader>();
+  serialize_type_defs(ser);
+  ASSERT(ser.get_load_finished());
+  return true;
+}
+
+void DecompilerTypeSystem::save_type_defs_cache(const fs::path& path, u64 source_hash) {
+  Serializer ser;
+  serialize_type_defs(ser);
+  auto [data, size] = ser.get_save_result();
+  TypeDefsCacheHeader header;
+  header.source_hash = source_hash;
+  header.data_size = size;
+  std::vector<u8> file_data(sizeof(header) + size);
+  memcpy(file_data.data(), &header, sizeof(header));
+  memcpy(file_data.data() + sizeof(header), data, size);
+  try {
+    // written to a temporary file first, so another decompiler starting now can't read half of it.
+    file_util::create_dir_if_needed_for_file(path);
+    auto temp_path = path;
+    temp_path += ".tmp";
+    file_util::write_binary_file(temp_path, file_data.data(), file_data.size());
+    fs::rename(temp_path, path);
+  } catch (std::exception& e) {
+    lg::warn("Failed to save type cache {}: {}", path.string(), e.what());
+  }
+}
+
+/*!
+ * Save or load everything that parse_type_defs adds.
+ */
+void DecompilerTypeSystem::serialize_type_defs(Serializer& ser) {
+  ts.serialize(ser);
+  ser.from_string_map(&symbol_types, [](Serializer& s, TypeSpec* type) { type->serialize(s); });
+  ser.from_string_vector(&symbol_add_order);
+  if (ser.is_loading()) {
+    symbols = std::unordered_set<std::string>(symbol_add_order.begin(), symbol_add_order.end());
+  }
+  ser.from_string_map(&symbol_metadata_map,
+                      [](Serializer& s, DefinitionMetadata* metadata) { metadata->serialize(s); });
+  ser.from_string_map(&virtual_state_metadata, [](Serializer& s, auto* methods) {
+    s.from_string_map(methods, serialize_handler_metadata);
+  });
+  ser.from_string_map(&state_metadata, serialize_handler_metadata);
 }
 
 TypeSpec DecompilerTypeSystem::parse_type_spec(const std::string& str) const {
+  std::lock_guard<std::mutex> lock(*m_reader_mutex);
   auto read = m_reader.read_from_string(str);
   auto data = cdr(read);
   return parse_typespec(&ts, car(data));
@@ -1,8 +1,12 @@
 #pragma once
 
+#include <memory>
+#include <mutex>
+
 #include "common/goos/Reader.h"
 #include "common/goos/TextDB.h"
 #include "common/type_system/TypeSystem.h"
+#include "common/util/FileUtil.h"
 
 #include "decompiler/Disasm/Register.h"
 
@@ -54,7 +58,12 @@ class DecompilerTypeSystem {
   void add_symbol(const std::string& name,
                   const TypeSpec& type_spec,
                   const DefinitionMetadata& symbol_metadata);
-  void parse_type_defs(const std::vector<std::string>& file_path);
+  /*!
+   * Add the deftypes, defenums and define-externs in a file. With use_cache, the results are also
+   * saved to out/<game>/, and loaded from there next time if the file hasn't changed. The cache
+   * holds everything, so it's only correct if nothing else was parsed first.
+   */
+  void parse_type_defs(const std::vector<std::string>& file_path, bool use_cache = false);
   TypeSpec parse_type_spec(const std::string& str) const;
   void add_type_flags(const std::string& name, u64 flags);
   void add_type_parent(const std::string& child, const std::string& parent);
@@ -70,12 +79,21 @@ class DecompilerTypeSystem {
   bool should_attempt_cast_simplify(const TypeSpec& expected, const TypeSpec& actual) const;
 
   // todo - totally eliminate this.
-  struct {
+  // per-thread, so object files can be analyzed in parallel.
+  struct TypePropSettings {
     std::string current_method_type;
     void reset() { current_method_type.clear(); }
-  } type_prop_settings;
+  };
+  static thread_local TypePropSettings type_prop_settings;
 
  private:
+  bool try_load_type_defs_cache(const fs::path& path, u64 source_hash);
+  void save_type_defs_cache(const fs::path& path, u64 source_hash);
+  void serialize_type_defs(Serializer& ser);
+
+  GameVersion m_version;
   mutable goos::Reader m_reader;
+  // parse_type_spec is called from analysis threads. In a unique_ptr to keep this movable.
+  std::unique_ptr<std::mutex> m_reader_mutex = std::make_unique<std::mutex>();
 };
 }  // namespace decompiler
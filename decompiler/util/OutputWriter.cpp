@@ -0,0 +1,99 @@
+#include "OutputWriter.h"
+
+#include <algorithm>
+
+namespace decompiler {
+
+namespace {
+/*!
+ * Does the file already hold what write_text_file would write?
+ */
+bool file_has_text(const fs::path& path, const std::string& text) {
+  if (!fs::exists(path)) {
+    return false;
+  }
+  auto existing = file_util::read_text_file(path);
+  // write_text_file adds a newline.
+  return existing.size() == text.size() + 1 && existing.back() == '\n' &&
+         existing.compare(0, text.size(), text) == 0;
+}
+}  // namespace
+
+OutputWriter::OutputWriter(int num_threads, bool skip_unchanged, size_t max_queued_bytes)
+    : m_skip_unchanged(skip_unchanged), m_max_queued_bytes(max_queued_bytes) {
+  for (int i = 0; i < std::max(1, num_threads); i++) {
+    m_threads.emplace_back([this] { thread_loop(); });
+  }
+}
+
+OutputWriter::~OutputWriter() {
+  stop_threads();
+}
+
+void OutputWriter::write(const fs::path& path, std::string text) {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  // a file bigger than the limit is still written, once nothing else is waiting.
+  m_space_cv.wait(lock, [&] {
+    return m_queued_bytes == 0 || m_queued_bytes + text.size() <= m_max_queued_bytes;
+  });
+  m_queued_bytes += text.size();
+  m_jobs.push_back({path, std::move(text)});
+  m_work_cv.notify_one();
+}
+
+void OutputWriter::finish() {
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_space_cv.wait(lock, [&] { return m_queued_bytes == 0; });
+  }
+  stop_threads();
+  if (m_error) {
+    std::rethrow_exception(m_error);
+  }
+}
+
+void OutputWriter::stop_threads() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_work_cv.notify_all();
+  for (auto& thread : m_threads) {
+    thread.join();
+  }
+  m_threads.clear();
+}
+
+void OutputWriter::thread_loop() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    m_work_cv.wait(lock, [&] { return m_stop || !m_jobs.empty(); });
+    if (m_jobs.empty()) {
+      return;  // stopping, and everything is written.
+    }
+    auto job = std::move(m_jobs.front());
+    m_jobs.pop_front();
+    lock.unlock();
+
+    std::exception_ptr error;
+    try {
+      if (m_skip_unchanged && file_has_text(job.path, job.text)) {
+        m_unchanged++;
+      } else {
+        file_util::write_text_file(job.path, job.text);
+        m_written++;
+      }
+    } catch (...) {
+      error = std::current_exception();
+    }
+
+    lock.lock();
+    if (error && !m_error) {
+      m_error = error;
+    }
+    m_queued_bytes -= job.text.size();
+    m_space_cv.notify_all();
+  }
+}
+
+}  // namespace decompiler
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/util/FileUtil.h"
+
+namespace decompiler {
+
+/*!
+ * Writes text files on a few threads of its own, so the decompiler can move on to the next object
+ * file while the last one is written. The global ThreadPool isn't used: its workers are busy
+ * analyzing object files, so writes would pile up until the end.
+ *
+ * If skip_unchanged is set, files that already have the same text aren't written, so their
+ * modification times don't change.
+ */
+class OutputWriter {
+ public:
+  OutputWriter(int num_threads, bool skip_unchanged, size_t max_queued_bytes = 256 * 1024 * 1024);
+  ~OutputWriter();
+  OutputWriter(const OutputWriter&) = delete;
+  OutputWriter& operator=(const OutputWriter&) = delete;
+
+  /*!
+   * Queue a file to be written, like file_util::write_text_file. Blocks if too much text is
+   * waiting to be written already.
+   */
+  void write(const fs::path& path, std::string text);
+
+  /*!
+   * Wait for all writes to finish. If any failed, the first error is rethrown.
+   */
+  void finish();
+
+  int files_written() const { return m_written; }
+  int files_unchanged() const { return m_unchanged; }
+
+ private:
+  struct Job {
+    fs::path path;
+    std::string text;
+  };
+
+  void thread_loop();
+  void stop_threads();
+
+  bool m_skip_unchanged;
+  size_t m_max_queued_bytes;
+
+  std::mutex m_mutex;
+  std::condition_variable m_work_cv;   // jobs were added, or we're stopping
+  std::condition_variable m_space_cv;  // jobs were finished
+  std::deque<Job> m_jobs;
+  size_t m_queued_bytes = 0;  // text size of jobs that were queued, but aren't done yet
+  bool m_stop = false;
+  std::exception_ptr m_error;
+  std::vector<std::thread> m_threads;
+
+  std::atomic<int> m_written = 0;
+  std::atomic<int> m_unchanged = 0;
+};
+
+}  // namespace decompiler
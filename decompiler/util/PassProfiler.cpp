@@ -0,0 +1,67 @@
+#include "PassProfiler.h"
+
+#include <algorithm>
+
+namespace decompiler {
+
+namespace {
+thread_local const char* t_current_pass = nullptr;
+}
+
+void PassProfiler::enable(int max_outliers_per_pass) {
+  m_enabled = true;
+  m_max_outliers = max_outliers_per_pass;
+}
+
+const char* PassProfiler::current_pass() const {
+  return t_current_pass;
+}
+
+const char* PassProfiler::swap_current_pass(const char* pass_name) {
+  const char* prev = t_current_pass;
+  t_current_pass = pass_name;
+  return prev;
+}
+
+PassProfiler::PassStats& PassProfiler::stats_for(const std::string& pass_name) {
+  auto it = m_pass_idx.find(pass_name);
+  if (it == m_pass_idx.end()) {
+    it = m_pass_idx.insert({pass_name, m_passes.size()}).first;
+    m_passes.emplace_back().name = pass_name;
+  }
+  return m_passes[it->second];
+}
+
+void PassProfiler::add_pass_time(const char* pass_name, double ms) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto& stats = stats_for(pass_name);
+  stats.total_ms += ms;
+  stats.runs++;
+}
+
+void PassProfiler::add_function_time(const std::string& function,
+                                     const std::string& object,
+                                     double ms) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto& stats = stats_for(current_pass());
+  stats.functions++;
+  stats.function_ms += ms;
+
+  // keep only the slowest few, sorted.
+  auto& slowest = stats.slowest;
+  if ((int)slowest.size() < m_max_outliers || (!slowest.empty() && ms > slowest.back().ms)) {
+    auto pos = std::upper_bound(slowest.begin(), slowest.end(), ms,
+                                [](double t, const FunctionTime& x) { return t > x.ms; });
+    slowest.insert(pos, {function, object, ms});
+    if ((int)slowest.size() > m_max_outliers) {
+      slowest.pop_back();
+    }
+  }
+}
+
+std::vector<PassProfiler::PassStats> PassProfiler::stats() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_passes;
+}
+
+}  // namespace decompiler
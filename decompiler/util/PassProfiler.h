@@ -0,0 +1,74 @@
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/util/Timer.h"
+
+namespace decompiler {
+
+/*!
+ * Collects the time spent in each IR2 pass, and the slowest functions in each pass.
+ * Disabled by default, in which case run() just calls the pass.
+ * Passes may run on several threads at once: the current pass is tracked per thread.
+ */
+class PassProfiler {
+ public:
+  struct FunctionTime {
+    std::string function;
+    std::string object;
+    double ms = 0;
+  };
+
+  struct PassStats {
+    std::string name;
+    double total_ms = 0;                // time in the pass, including work outside of functions
+    int runs = 0;                       // times the pass ran (once per object file or segment)
+    int functions = 0;                  // number of functions the pass was run on
+    double function_ms = 0;             // time spent inside functions
+    std::vector<FunctionTime> slowest;  // sorted, slowest first
+  };
+
+  void enable(int max_outliers_per_pass = 10);
+  bool enabled() const { return m_enabled; }
+
+  /*!
+   * Run a pass, adding its time to the totals for pass_name.
+   */
+  template <typename F>
+  void run(const char* pass_name, F&& f) {
+    if (!m_enabled) {
+      f();
+      return;
+    }
+    const char* prev = swap_current_pass(pass_name);
+    Timer timer;
+    f();
+    add_pass_time(pass_name, timer.getMs());
+    swap_current_pass(prev);
+  }
+
+  /*!
+   * Should function times be recorded? True inside of run() when enabled.
+   */
+  bool timing_functions() const { return m_enabled && current_pass(); }
+  void add_function_time(const std::string& function, const std::string& object, double ms);
+
+  std::vector<PassStats> stats() const;
+
+ private:
+  const char* current_pass() const;
+  const char* swap_current_pass(const char* pass_name);
+  void add_pass_time(const char* pass_name, double ms);
+  PassStats& stats_for(const std::string& pass_name);
+
+  bool m_enabled = false;
+  int m_max_outliers = 10;
+  mutable std::mutex m_mutex;
+  std::vector<PassStats> m_passes;  // in the order they first ran
+  std::unordered_map<std::string, size_t> m_pass_idx;
+};
+
+}  // namespace decompiler
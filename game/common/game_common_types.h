@@ -1,5 +1,7 @@
 #pragma once
 
+#include <string>
+
 #include "common/listener_common.h"
 #include "common/versions/versions.h"
 
@@ -20,4 +22,15 @@ struct GameLaunchOptions {
   bool disable_display = false;
   bool disable_debug_vm = true;
   int server_port = DECI2_PORT;
+  bool direct_dgo_loads = true;
+  int listener_print_interval_ms = 0;
+  // run the game without a window or GPU. The DMA chains are only read.
+  bool null_renderer = false;
+  // if not 0, measure the CPU time of this many frames, then exit.
+  int benchmark_frames = 0;
+  int benchmark_warmup_frames = 0;
+  std::string benchmark_csv_path;
+  // record the pad input to a file, or play it back from one.
+  std::string pad_record_path;
+  std::string pad_playback_path;
 };
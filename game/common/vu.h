@@ -288,6 +288,18 @@ struct alignas(16) Vf {
     _mm_store_ps(data, _mm_add_ps(_mm_load_ps(a.data), _mm_load_ps(b.data)));
   }
 
+  REALLY_INLINE void add_xyzw(const Vf& a, float b) {
+    _mm_store_ps(data, _mm_add_ps(_mm_load_ps(a.data), _mm_set1_ps(b)));
+  }
+
+  REALLY_INLINE void sub_xyzw(const Vf& a, const Vf& b) {
+    _mm_store_ps(data, _mm_sub_ps(_mm_load_ps(a.data), _mm_load_ps(b.data)));
+  }
+
+  REALLY_INLINE void sub_xyzw(const Vf& a, float b) {
+    _mm_store_ps(data, _mm_sub_ps(_mm_load_ps(a.data), _mm_set1_ps(b)));
+  }
+
   void add(Mask mask, const Vf& a, float b) {
     for (int i = 0; i < 4; i++) {
       if ((u64)mask & (1 << i)) {
@@ -518,6 +530,13 @@ struct alignas(16) Accumulator {
     _mm_store_ps(dest.data, _mm_add_ps(_mm_mul_ps(a, b), acc));
   }
 
+  REALLY_INLINE void madd_xyzw(Vf& dest, const Vf& _a, const Vf& _b) {
+    auto b = _mm_load_ps(_b.data);
+    auto a = _mm_load_ps(_a.data);
+    auto acc = _mm_load_ps(data);
+    _mm_store_ps(dest.data, _mm_add_ps(_mm_mul_ps(a, b), acc));
+  }
+
   REALLY_INLINE void madd_xyz(Vf& dest, const Vf& _a, float _b) {
     auto b = _mm_set1_ps(_b);
     auto a = _mm_load_ps(_a.data);
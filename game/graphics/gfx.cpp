@@ -21,6 +21,8 @@
 #include "game/kernel/common/kmachine.h"
 #include "game/kernel/common/kscheme.h"
 #include "game/runtime.h"
+#include "game/system/benchmark.h"
+#include "pipelines/null.h"
 #include "pipelines/opengl.h"
 
 namespace Gfx {
@@ -36,6 +38,8 @@ const GfxRendererModule* GetRenderer(GfxPipeline pipeline) {
       return NULL;
     case GfxPipeline::OpenGL:
       return &gRendererOpenGL;
+    case GfxPipeline::Null:
+      return &gRendererNull;
     default:
       lg::error("Requested unknown renderer {}", fmt::underlying(pipeline));
       return NULL;
@@ -114,6 +118,9 @@ void clear_vsync_callback() {
 }
 
 u32 vsync() {
+  PROF_ZONE("ee-vsync");
+  benchmark::end_ee_frame();
+  g_process_stats.end_frame();
   if (GetCurrentRenderer()) {
     // Inform the IOP kernel that we're vsyncing so it can run the vblank handler
     if (vsync_callback != nullptr)
@@ -124,6 +131,7 @@ u32 vsync() {
 }
 
 u32 sync_path() {
+  PROF_ZONE("ee-sync-path");
   if (GetCurrentRenderer()) {
     return GetCurrentRenderer()->sync_path();
   }
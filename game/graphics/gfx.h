@@ -23,7 +23,7 @@ struct GfxGlobalSettings;
 class GfxDisplay;
 
 // enum for rendering pipeline
-enum class GfxPipeline { Invalid = 0, OpenGL };
+enum class GfxPipeline { Invalid = 0, OpenGL, Null };
 
 // module for the different rendering pipelines
 struct GfxRendererModule {
@@ -42,6 +42,7 @@ struct GfxRendererModule {
   std::function<void(const u8*, int, u32)> texture_upload_now;
   std::function<void(u32, u32, u32)> texture_relocate;
   std::function<void(const std::vector<std::string>&)> set_levels;
+  std::function<void(const std::vector<std::string>&)> prefetch_levels;
   std::function<void(float)> set_pmode_alp;
   GfxPipeline pipeline;
   const char* name;
@@ -72,6 +73,15 @@ struct GfxGlobalSettings {
   // lod settings, used by bucket renderers
   int lod_tfrag = 0;
   int lod_tie = 0;
+  // pick the tfrag and tie lod for each part of a level from its size on screen. lod_tfrag and
+  // lod_tie are then the most detailed lod that's used.
+  bool lod_auto = false;
+  // parts with a radius on screen (in pixels) below this use the next lod, and so on at each half.
+  float lod_auto_pixels = 100.f;
+
+  // while the scene behind a menu doesn't change, draw it once and reuse the image, instead of
+  // drawing it every frame. Only used for the menus of games with a progress bucket.
+  bool cache_static_scene = false;
 
   // vsync enable
   bool vsync = true;
@@ -84,6 +94,9 @@ struct GfxGlobalSettings {
   // frame timing things
   bool experimental_accurate_lag = false;
   bool sleep_in_frame_limiter = true;
+  // poll input again right before the game frame starts, instead of only before rendering. Input
+  // that arrives while waiting for vsync makes it into the next game frame.
+  bool sample_input_before_game_frame = true;
 
   // fancy effect things
   bool hack_no_tex = false;
@@ -106,6 +119,8 @@ extern GfxGlobalSettings g_global_settings;
 extern game_settings::DebugSettings g_debug_settings;
 
 const GfxRendererModule* GetCurrentRenderer();
+// use a renderer without Init, for the null renderer that has no display.
+void SetRenderer(GfxPipeline pipeline);
 
 u32 Init(GameVersion version);
 void Loop(std::function<bool()> f);
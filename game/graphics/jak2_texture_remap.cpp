@@ -1,9 +1,12 @@
 #include "jak2_texture_remap.h"
 
+#include <algorithm>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "common/common_types.h"
+
 namespace {
 const std::unordered_map<int, std::vector<std::pair<int, int>>> data = {
     {12, {{46, 1}, {134, 1}, {38, 1}, {201, 1}, {52, 1}, {12, 1}, {187, 1}}},
@@ -1636,17 +1639,54 @@ const std::unordered_map<int, std::vector<std::pair<int, int>>> data = {
     {3454, {{15, 1}, {14, 1}}},
 };
 
+/*!
+ * The data above, flattened so a lookup is a single load: the offsets of tpage p are at
+ * offsets[page_start[p] + texture_idx], up to page_start[p + 1].
+ */
+struct RemapTable {
+  std::vector<u32> page_start;
+  std::vector<u8> offsets;
 };
 
+RemapTable build_remap_table() {
+  RemapTable table;
+  int page_count = 0;
+  for (auto& [tpage, remaps] : data) {
+    page_count = std::max(page_count, tpage + 1);
+  }
+  std::vector<int> page_size(page_count, 0);
+  for (auto& [tpage, remaps] : data) {
+    for (auto& [idx, offset] : remaps) {
+      page_size[tpage] = std::max(page_size[tpage], idx + 1);
+    }
+  }
+  table.page_start.resize(page_count + 1);
+  u32 total = 0;
+  for (int i = 0; i < page_count; i++) {
+    table.page_start[i] = total;
+    total += page_size[i];
+  }
+  table.page_start[page_count] = total;
+  table.offsets.resize(total, 0);
+  for (auto& [tpage, remaps] : data) {
+    for (auto& [idx, offset] : remaps) {
+      table.offsets[table.page_start[tpage] + idx] = offset;
+    }
+  }
+  return table;
+}
+
+const RemapTable table = build_remap_table();
+
+}  // namespace
+
 int lookup_jak2_texture_dest_offset(int tpage, int texture_idx) {
-  auto it = data.find(tpage);
-  if (it == data.end()) {
+  if (tpage < 0 || tpage + 1 >= (int)table.page_start.size() || texture_idx < 0) {
     return 0;
   }
-  for (auto& p : it->second) {
-    if (p.first == texture_idx) {
-      return p.second;
-    }
+  u32 idx = table.page_start[tpage] + texture_idx;
+  if (idx >= table.page_start[tpage + 1]) {
+    return 0;
   }
-  return 0;
+  return table.offsets[idx];
 }
\ No newline at end of file
@@ -97,6 +97,7 @@ void SharedRenderState::reset() {
     x.valid = false;
   }
   load_status_debug.clear();
+  background_camera.valid = false;
 }
 
 RenderMux::RenderMux(const std::string& name,
@@ -124,6 +125,13 @@ void RenderMux::draw_debug_window() {
   m_renderers[m_render_idx]->draw_debug_window();
 }
 
+void RenderMux::set_debug_window_open(bool open) {
+  BucketRenderer::set_debug_window_open(open);
+  for (auto& rend : m_renderers) {
+    rend->set_debug_window_open(open);
+  }
+}
+
 void RenderMux::init_textures(TexturePool& tp, GameVersion version) {
   for (auto& rend : m_renderers) {
     rend->init_textures(tp, version);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstring>
 #include <memory>
 #include <string>
 
@@ -9,13 +10,34 @@
 #include "game/graphics/opengl_renderer/Shader.h"
 #include "game/graphics/opengl_renderer/buckets.h"
 #include "game/graphics/opengl_renderer/loader/Loader.h"
+#include "game/graphics/opengl_renderer/opengl_utils.h"
 #include "game/graphics/texture/TexturePool.h"
 
 struct Fbo;
 
+/*!
+ * The camera used to draw tfrag and tie, in the form their vertex shaders take it.
+ */
+struct BackgroundCamera {
+  bool valid = false;
+  math::Matrix4f camera;
+  math::Vector4f hvdf_offset;
+  float fog_constant = 0;
+};
+
 struct LevelVis {
   bool valid = false;
+  // changes when data does, so the background renderers know when to cull again.
+  u64 version = 0;
   u8 data[2048];
+
+  void update(const u8* new_data) {
+    if (memcmp(data, new_data, sizeof(data))) {
+      memcpy(data, new_data, sizeof(data));
+      version++;
+    }
+    valid = true;
+  }
 };
 
 class EyeRenderer;
@@ -27,11 +49,21 @@ struct SharedRenderState {
   explicit SharedRenderState(std::shared_ptr<TexturePool> _texture_pool,
                              std::shared_ptr<Loader> _loader,
                              GameVersion version)
-      : shaders(version), texture_pool(_texture_pool), loader(_loader) {}
+      : shaders(version, &gl_state),
+        texture_pool(_texture_pool),
+        loader(_loader),
+        stream_buffer(STREAM_BUFFER_SIZE) {}
+  // filters out redundant OpenGL state changes, invalidated before each bucket renderer.
+  GlStateCache gl_state;
   ShaderLibrary shaders;
   std::shared_ptr<TexturePool> texture_pool;
   std::shared_ptr<Loader> loader;
 
+  // ring buffer for per-frame dynamic vertex/index/bone uploads, shared by all renderers.
+  static constexpr u32 STREAM_BUFFER_SIZE = 64 * 1024 * 1024;
+  StreamRingBuffer stream_buffer;
+  DrawModeSamplers draw_mode_samplers;
+
   u32 buckets_base = 0;  // address of buckets array.
   u32 next_bucket = 0;   // address of next bucket that we haven't started rendering in buckets
   u32 default_regs_buffer = 0;  // address of the default regs chain.
@@ -39,11 +71,32 @@ struct SharedRenderState {
   void* ee_main_memory = nullptr;
   u32 offset_of_s7;
 
-  bool use_sky_cpu = true;
+  bool use_sky_cpu = false;
   bool use_occlusion_culling = true;
   math::Vector<u8, 4> fog_color = math::Vector<u8, 4>{0, 0, 0, 0};
   float fog_intensity = 1.f;
   bool no_multidraw = false;
+  // cull tfrag/tie with a compute shader and draw with indirect multidraws. Needs multidraw.
+  bool use_gpu_culling = false;
+  // step tie wind and make the wind instance matrices in a compute shader.
+  bool use_gpu_wind = false;
+  // make all the ocean texture mip levels in one compute dispatch instead of a draw per level.
+  bool use_compute_ocean_mips = true;
+  // also cull tfrag/tie that were hidden in the last frame, with a depth pyramid made from its
+  // depth buffer. Needs use_gpu_culling.
+  bool use_depth_pyramid_culling = false;
+
+  // set by the first background tree culled on the GPU this frame, for the depth pyramid.
+  BackgroundCamera background_camera;
+  // the depth pyramid of the last frame, built by OpenGLRenderer.
+  struct {
+    bool valid = false;
+    GLuint texture = 0;
+    int screen_w = 0;
+    int screen_h = 0;
+    int levels = 0;
+    BackgroundCamera camera;  // what the last frame's background was drawn with
+  } depth_pyramid;
 
   void reset();
   bool has_pc_data = false;
@@ -115,10 +168,34 @@ class BucketRenderer {
   virtual void init_shaders(ShaderLibrary&) {}
   virtual void init_textures(TexturePool&, GameVersion) {}
 
+  /*!
+   * Optional two-phase rendering. A renderer that returns true from supports_prepare() can have its
+   * DMA processing and CPU-side draw building done by prepare(), which may run on a worker thread,
+   * in parallel with the prepare() of other buckets. It must only touch its own state and must not
+   * make any OpenGL calls. Later, submit() is called on the render thread, in bucket order, and
+   * should only do the OpenGL work. The result must be the same as calling render().
+   */
+  virtual bool supports_prepare() const { return false; }
+  virtual void prepare(DmaFollower& /*dma*/, u32 /*next_bucket*/, GameVersion /*version*/) {}
+  virtual void submit(SharedRenderState* /*render_state*/, ScopedProfilerNode& /*prof*/) {}
+
+  /*!
+   * Renderers that don't draw, but set up state used by later buckets (like texture uploads), still
+   * run when OpenGLRenderer reuses a cached image of the buckets they are in.
+   */
+  virtual bool needed_for_later_buckets() const { return false; }
+
+  /*!
+   * Set when this renderer's node in the debug window is open or closed. Stats that are only shown
+   * there don't need to be collected while it's closed.
+   */
+  virtual void set_debug_window_open(bool open) { m_debug_window_open = open; }
+
  protected:
   std::string m_name;
   int m_my_id;
   bool m_enabled = true;
+  bool m_debug_window_open = false;
 };
 
 class RenderMux : public BucketRenderer {
@@ -130,6 +207,7 @@ class RenderMux : public BucketRenderer {
   void draw_debug_window() override;
   void init_shaders(ShaderLibrary&) override;
   void init_textures(TexturePool&, GameVersion) override;
+  void set_debug_window_open(bool open) override;
   void set_idx(u32 i) { m_render_idx = i; };
 
  private:
@@ -1,5 +1,7 @@
 #include "CollideMeshRenderer.h"
 
+#include <algorithm>
+
 #include "game/graphics/opengl_renderer/background/background_common.h"
 
 float material_colors_jak1[23 * 3] = {
@@ -44,6 +46,103 @@ float mode_colors_jak1[3 * 3] = {
     1.0f,  0.1f, 1.0f,  // 2, obstacle
 };
 
+namespace {
+// triangles per leaf of the collision BVH. Small enough to cull well, large enough that the
+// draw list stays short.
+constexpr u32 kCollideBvhLeafTris = 256;
+
+struct TriBounds {
+  math::Vector3f min, max, center;
+};
+
+u32 build_collide_bvh_node(std::vector<CollideBvhNode>& nodes,
+                           std::vector<u32>& tris,
+                           const std::vector<TriBounds>& bounds,
+                           u32 begin,
+                           u32 end) {
+  u32 node_idx = nodes.size();
+  nodes.emplace_back();
+
+  math::Vector3f bmin = bounds[tris[begin]].min;
+  math::Vector3f bmax = bounds[tris[begin]].max;
+  math::Vector3f cmin = bounds[tris[begin]].center;
+  math::Vector3f cmax = cmin;
+  for (u32 i = begin + 1; i < end; i++) {
+    const auto& b = bounds[tris[i]];
+    bmin.min_in_place(b.min);
+    bmax.max_in_place(b.max);
+    cmin.min_in_place(b.center);
+    cmax.max_in_place(b.center);
+  }
+  math::Vector3f center = (bmin + bmax) * 0.5f;
+  nodes[node_idx].bsphere = math::Vector4f(center.x(), center.y(), center.z(),
+                                           (bmax - center).length());
+  nodes[node_idx].first_vertex = begin * 3;
+  nodes[node_idx].vertex_count = (end - begin) * 3;
+
+  if (end - begin <= kCollideBvhLeafTris) {
+    return node_idx;
+  }
+
+  // split at the median along the longest axis of the triangle centers
+  math::Vector3f extent = cmax - cmin;
+  int axis = 0;
+  if (extent.y() > extent[axis]) {
+    axis = 1;
+  }
+  if (extent.z() > extent[axis]) {
+    axis = 2;
+  }
+  u32 mid = begin + (end - begin) / 2;
+  std::nth_element(tris.begin() + begin, tris.begin() + mid, tris.begin() + end,
+                   [&](u32 a, u32 b) { return bounds[a].center[axis] < bounds[b].center[axis]; });
+
+  u32 left = build_collide_bvh_node(nodes, tris, bounds, begin, mid);
+  u32 right = build_collide_bvh_node(nodes, tris, bounds, mid, end);
+  nodes[node_idx].children[0] = left;
+  nodes[node_idx].children[1] = right;
+  return node_idx;
+}
+}  // namespace
+
+void build_collide_bvh(std::vector<tfrag3::CollisionMesh::Vertex>& vertices,
+                       std::vector<CollideBvhNode>& nodes) {
+  nodes.clear();
+  u32 num_tris = vertices.size() / 3;
+  if (num_tris == 0) {
+    return;
+  }
+
+  std::vector<TriBounds> bounds(num_tris);
+  for (u32 i = 0; i < num_tris; i++) {
+    auto& b = bounds[i];
+    for (int j = 0; j < 3; j++) {
+      const auto& v = vertices[i * 3 + j];
+      math::Vector3f pos(v.x, v.y, v.z);
+      if (j == 0) {
+        b.min = pos;
+        b.max = pos;
+      } else {
+        b.min.min_in_place(pos);
+        b.max.max_in_place(pos);
+      }
+    }
+    b.center = (b.min + b.max) * 0.5f;
+  }
+
+  std::vector<u32> tris(num_tris);
+  for (u32 i = 0; i < num_tris; i++) {
+    tris[i] = i;
+  }
+  build_collide_bvh_node(nodes, tris, bounds, 0, num_tris);
+
+  std::vector<tfrag3::CollisionMesh::Vertex> sorted(num_tris * 3);
+  for (u32 i = 0; i < num_tris; i++) {
+    memcpy(&sorted[i * 3], &vertices[tris[i] * 3], 3 * sizeof(tfrag3::CollisionMesh::Vertex));
+  }
+  vertices = std::move(sorted);
+}
+
 CollideMeshRenderer::CollideMeshRenderer(GameVersion version) {
   glGenVertexArrays(1, &m_vao);
   glGenBuffers(1, &m_ubo);
@@ -94,6 +193,41 @@ void CollideMeshRenderer::init_pat_colors(GameVersion version) {
   }
 }
 
+/*!
+ * Find the ranges of the level's collision mesh in view. Adjacent visible leaves are merged into
+ * a single range.
+ */
+void CollideMeshRenderer::build_draw_list(const LevelData& lev, const math::Vector4f* planes) {
+  m_draw_firsts.clear();
+  m_draw_counts.clear();
+  if (lev.collide_bvh.empty()) {
+    return;
+  }
+
+  m_node_stack.clear();
+  m_node_stack.push_back(0);
+  while (!m_node_stack.empty()) {
+    const auto& node = lev.collide_bvh[m_node_stack.back()];
+    m_node_stack.pop_back();
+    if (!sphere_in_view_ref(node.bsphere, planes)) {
+      continue;
+    }
+    if (node.children[0]) {
+      // right first, so the left is drawn first and ranges come out in order.
+      m_node_stack.push_back(node.children[1]);
+      m_node_stack.push_back(node.children[0]);
+      continue;
+    }
+    if (!m_draw_firsts.empty() &&
+        (u32)(m_draw_firsts.back() + m_draw_counts.back()) == node.first_vertex) {
+      m_draw_counts.back() += node.vertex_count;
+    } else {
+      m_draw_firsts.push_back(node.first_vertex);
+      m_draw_counts.push_back(node.vertex_count);
+    }
+  }
+}
+
 void CollideMeshRenderer::render(SharedRenderState* render_state, ScopedProfilerNode& prof) {
   if (!render_state->has_pc_data) {
     return;
@@ -179,20 +313,36 @@ void CollideMeshRenderer::render(SharedRenderState* render_state, ScopedProfiler
     glUniform1ui(glGetUniformLocation(shader, "collision_skip_mask"),
                  Gfx::g_global_settings.collision_skip_mask);
     glUniform1i(glGetUniformLocation(shader, "mode"), Gfx::g_global_settings.collision_mode);
-    glDrawArrays(GL_TRIANGLES, 0, lev->level->collision.vertices.size());
+
+    build_draw_list(*lev, settings.planes);
+    u32 num_verts = 0;
+    for (auto count : m_draw_counts) {
+      num_verts += count;
+    }
+    auto draw = [&]() {
+      if (render_state->no_multidraw) {
+        for (size_t i = 0; i < m_draw_firsts.size(); i++) {
+          glDrawArrays(GL_TRIANGLES, m_draw_firsts[i], m_draw_counts[i]);
+        }
+      } else {
+        glMultiDrawArrays(GL_TRIANGLES, m_draw_firsts.data(), m_draw_counts.data(),
+                          m_draw_firsts.size());
+      }
+    };
+    draw();
 
     if (Gfx::g_global_settings.collision_wireframe) {
       glUniform1i(glGetUniformLocation(shader, "wireframe"), 1);
       glDisable(GL_BLEND);
       glDepthMask(GL_FALSE);
       glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-      glDrawArrays(GL_TRIANGLES, 0, lev->level->collision.vertices.size());
+      draw();
       glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
       glEnable(GL_BLEND);
       glDepthMask(GL_TRUE);
     }
 
-    prof.add_draw_call();
-    prof.add_tri(lev->level->collision.vertices.size() / 3);
+    prof.add_draw_call(m_draw_firsts.size());
+    prof.add_tri(num_verts / 3);
   }
 }
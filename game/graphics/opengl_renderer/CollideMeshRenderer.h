@@ -9,6 +9,12 @@ struct PatColors {
   math::Vector4f pat_event_colors[0x40];
 };
 
+/*!
+ * Reorder the triangles of a collision mesh for the BVH and build its nodes. The root is node 0.
+ */
+void build_collide_bvh(std::vector<tfrag3::CollisionMesh::Vertex>& vertices,
+                       std::vector<CollideBvhNode>& nodes);
+
 class CollideMeshRenderer {
  public:
   CollideMeshRenderer(GameVersion version);
@@ -18,8 +24,15 @@ class CollideMeshRenderer {
  private:
   void init_pat_colors(GameVersion version);
 
+  void build_draw_list(const LevelData& lev, const math::Vector4f* planes);
+
   GLuint m_vao;
   GLuint m_ubo;
 
+  // ranges of the collision mesh to draw for the current level.
+  std::vector<GLint> m_draw_firsts;
+  std::vector<GLsizei> m_draw_counts;
+  std::vector<u32> m_node_stack;
+
   PatColors m_colors;
 };
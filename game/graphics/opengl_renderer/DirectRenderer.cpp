@@ -128,7 +128,7 @@ void DirectRenderer::reset_state() {
   m_prim_gl_state_needs_gl_update = true;
   m_prim_gl_state = PrimGlState();
 
-  for (int i = 0; i < TEXTURE_STATE_COUNT; ++i) {
+  for (int i = 0; i < MAX_TEXTURE_STATES; ++i) {
     m_buffered_tex_state[i] = TextureState();
   }
   m_tex_state_from_reg = {};
@@ -183,6 +183,10 @@ float u32_to_sc(u32 in) {
 }
 
 void DirectRenderer::flush_pending(SharedRenderState* render_state, ScopedProfilerNode& prof) {
+  if (m_prim_buffer.vert_count) {
+    on_flush();
+  }
+
   // update opengl state
   if (m_blend_state_needs_gl_update) {
     update_gl_blend();
@@ -199,7 +203,7 @@ void DirectRenderer::flush_pending(SharedRenderState* render_state, ScopedProfil
     m_test_state_needs_gl_update = false;
   }
 
-  for (int i = 0; i < TEXTURE_STATE_COUNT; i++) {
+  for (int i = 0; i < MAX_TEXTURE_STATES; i++) {
     auto& tex_state = m_buffered_tex_state[i];
     if (tex_state.used) {
       update_gl_texture(render_state, i);
@@ -296,26 +300,18 @@ void DirectRenderer::update_gl_prim(SharedRenderState* render_state) {
       }
     }
 
-    render_state->shaders[ShaderId::DIRECT_BASIC_TEXTURED].activate();
-    glUniform1f(glGetUniformLocation(render_state->shaders[ShaderId::DIRECT_BASIC_TEXTURED].id(),
-                                     "alpha_reject"),
-                alpha_reject);
-    glUniform1f(glGetUniformLocation(render_state->shaders[ShaderId::DIRECT_BASIC_TEXTURED].id(),
-                                     "color_mult"),
-                m_ogl.color_mult);
-    glUniform1f(glGetUniformLocation(render_state->shaders[ShaderId::DIRECT_BASIC_TEXTURED].id(),
-                                     "alpha_mult"),
-                m_ogl.alpha_mult);
-    glUniform4f(glGetUniformLocation(render_state->shaders[ShaderId::DIRECT_BASIC_TEXTURED].id(),
-                                     "fog_color"),
-                render_state->fog_color[0] / 255.f, render_state->fog_color[1] / 255.f,
-                render_state->fog_color[2] / 255.f, render_state->fog_intensity / 255);
-    glUniform1i(glGetUniformLocation(render_state->shaders[ShaderId::DIRECT_BASIC_TEXTURED].id(),
-                                     "offscreen_mode"),
-                m_offscreen_mode);
-    glUniform1f(
-        glGetUniformLocation(render_state->shaders[ShaderId::DIRECT_BASIC_TEXTURED].id(), "ta0"),
-        state.ta0 / 255.f);
+    const auto& shader = render_state->shaders[m_texture_state_count > 1
+                                                   ? ShaderId::DIRECT_BASIC_TEXTURED_MULTI_UNIT
+                                                   : ShaderId::DIRECT_BASIC_TEXTURED];
+    shader.activate();
+    glUniform1f(glGetUniformLocation(shader.id(), "alpha_reject"), alpha_reject);
+    glUniform1f(glGetUniformLocation(shader.id(), "color_mult"), m_ogl.color_mult);
+    glUniform1f(glGetUniformLocation(shader.id(), "alpha_mult"), m_ogl.alpha_mult);
+    glUniform4f(glGetUniformLocation(shader.id(), "fog_color"), render_state->fog_color[0] / 255.f,
+                render_state->fog_color[1] / 255.f, render_state->fog_color[2] / 255.f,
+                render_state->fog_intensity / 255);
+    glUniform1i(glGetUniformLocation(shader.id(), "offscreen_mode"), m_offscreen_mode);
+    glUniform1f(glGetUniformLocation(shader.id(), "ta0"), state.ta0 / 255.f);
 
   } else {
     render_state->shaders[ShaderId::DIRECT_BASIC].activate();
@@ -1111,7 +1107,23 @@ int DirectRenderer::get_texture_unit_for_current_reg(SharedRenderState* render_s
     return m_current_tex_state_idx;
   }
 
-  if (m_next_free_tex_state >= TEXTURE_STATE_COUNT) {
+  // a texture state from earlier in this batch may match. Two states for the same texture with
+  // different clamp or filter settings can't be drawn together, they're set on the texture itself.
+  for (int i = 0; i < m_next_free_tex_state; i++) {
+    auto& state = m_buffered_tex_state[i];
+    if (state.compatible_with(m_tex_state_from_reg)) {
+      m_current_tex_state_idx = i;
+      return i;
+    }
+    if (state.texture_base_ptr == m_tex_state_from_reg.texture_base_ptr &&
+        state.using_mt4hh == m_tex_state_from_reg.using_mt4hh) {
+      m_stats.flush_from_state_exhaust++;
+      flush_pending(render_state, prof);
+      return get_texture_unit_for_current_reg(render_state, prof);
+    }
+  }
+
+  if (m_next_free_tex_state >= m_texture_state_count) {
     m_stats.flush_from_state_exhaust++;
     flush_pending(render_state, prof);
     return get_texture_unit_for_current_reg(render_state, prof);
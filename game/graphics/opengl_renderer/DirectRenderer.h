@@ -113,6 +113,8 @@ class DirectRenderer : public BucketRenderer {
   void update_gl_blend();
   void update_gl_test();
   void update_gl_texture(SharedRenderState* render_state, int unit);
+  // called by flush_pending before drawing the pending vertices, with the state they use.
+  virtual void on_flush() {}
   bool m_offscreen_mode = false;
 
   struct TestState {
@@ -162,7 +164,10 @@ class DirectRenderer : public BucketRenderer {
     u32 ta0 = 0;
   } m_prim_gl_state;
 
-  static constexpr int TEXTURE_STATE_COUNT = 1;
+  // with more than one texture state, the multi-unit shader is used, and changing textures doesn't
+  // flush until all of them are in use. Text switches between font pages a lot.
+  static constexpr int MAX_TEXTURE_STATES = 10;
+  int m_texture_state_count = 1;
 
   struct TextureState {
     GsTex0 current_register;
@@ -189,7 +194,7 @@ class DirectRenderer : public BucketRenderer {
   };
 
   // vertices will reference these texture states
-  TextureState m_buffered_tex_state[TEXTURE_STATE_COUNT];
+  TextureState m_buffered_tex_state[MAX_TEXTURE_STATES];
   int m_next_free_tex_state = 0;
 
   // this texture state mirrors the current GS register.
@@ -17,64 +17,56 @@ DirectRenderer2::DirectRenderer2(u32 max_verts,
   m_vertices.indices.resize(max_inds);
   m_draw_buffer.resize(max_draws);
 
-  // create OpenGL objects
-  glGenBuffers(1, &m_ogl.vertex_buffer);
-  glGenBuffers(1, &m_ogl.index_buffer);
+  // create OpenGL objects. The vertex and index data is streamed through the shared ring buffer,
+  // so the vertex array uses a separate buffer binding that's pointed at the ring before each draw.
   glGenVertexArrays(1, &m_ogl.vao);
 
   // set up the vertex array
   glBindVertexArray(m_ogl.vao);
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ogl.index_buffer);
-  glBufferData(GL_ELEMENT_ARRAY_BUFFER, max_inds * sizeof(u32), nullptr, GL_STREAM_DRAW);
-  glBindBuffer(GL_ARRAY_BUFFER, m_ogl.vertex_buffer);
-  glBufferData(GL_ARRAY_BUFFER, max_verts * sizeof(Vertex), nullptr, GL_STREAM_DRAW);
 
   // xyz
   glEnableVertexAttribArray(0);
-  glVertexAttribPointer(0,                            // location 0 in the shader
-                        3,                            // 3 floats per vert
-                        GL_FLOAT,                     // floats
-                        GL_TRUE,                      // normalized, ignored,
-                        sizeof(Vertex),               //
-                        (void*)offsetof(Vertex, xyz)  // offset in array
+  glVertexAttribFormat(0,                     // location 0 in the shader
+                       3,                     // 3 floats per vert
+                       GL_FLOAT,              // floats
+                       GL_TRUE,               // normalized, ignored,
+                       offsetof(Vertex, xyz)  // offset in vertex
   );
+  glVertexAttribBinding(0, 0);
 
   // rgba
   glEnableVertexAttribArray(1);
-  glVertexAttribPointer(1,                             // location 1 in the shader
-                        4,                             // 4 color components
-                        GL_UNSIGNED_BYTE,              // u8
-                        GL_TRUE,                       // normalized (255 becomes 1)
-                        sizeof(Vertex),                //
-                        (void*)offsetof(Vertex, rgba)  //
+  glVertexAttribFormat(1,                      // location 1 in the shader
+                       4,                      // 4 color components
+                       GL_UNSIGNED_BYTE,       // u8
+                       GL_TRUE,                // normalized (255 becomes 1)
+                       offsetof(Vertex, rgba)  //
   );
+  glVertexAttribBinding(1, 0);
 
   // stq
   glEnableVertexAttribArray(2);
-  glVertexAttribPointer(2,                            // location 2 in the shader
-                        3,                            // 3 floats per vert
-                        GL_FLOAT,                     // floats
-                        GL_FALSE,                     // normalized, ignored
-                        sizeof(Vertex),               //
-                        (void*)offsetof(Vertex, stq)  // offset in array
+  glVertexAttribFormat(2,                     // location 2 in the shader
+                       3,                     // 3 floats per vert
+                       GL_FLOAT,              // floats
+                       GL_FALSE,              // normalized, ignored
+                       offsetof(Vertex, stq)  // offset in vertex
   );
+  glVertexAttribBinding(2, 0);
 
   // byte data
   glEnableVertexAttribArray(3);
-  glVertexAttribIPointer(3,                                 // location 0 in the shader
-                         4,                                 // 3 floats per vert
-                         GL_UNSIGNED_BYTE,                  // u8's
-                         sizeof(Vertex),                    //
-                         (void*)offsetof(Vertex, tex_unit)  // offset in array
+  glVertexAttribIFormat(3,                          // location 3 in the shader
+                        4,                          //
+                        GL_UNSIGNED_BYTE,           // u8's
+                        offsetof(Vertex, tex_unit)  // offset in vertex
   );
+  glVertexAttribBinding(3, 0);
 
-  glBindBuffer(GL_ARRAY_BUFFER, 0);
   glBindVertexArray(0);
 }
 
 DirectRenderer2::~DirectRenderer2() {
-  glDeleteBuffers(1, &m_ogl.vertex_buffer);
-  glDeleteBuffers(1, &m_ogl.index_buffer);
   glDeleteVertexArrays(1, &m_ogl.vao);
 }
 
@@ -127,20 +119,23 @@ void DirectRenderer2::flush_pending(SharedRenderState* render_state, ScopedProfi
 
   // first, upload:
   Timer upload_timer;
+  auto& ring = render_state->stream_buffer;
+  ring.reserve(m_vertices.next_vertex * sizeof(Vertex) + sizeof(Vertex) +
+               m_vertices.next_index * sizeof(u32) + sizeof(u32));
+  u32 vertex_offset = ring.upload(m_vertices.vertices.data(),
+                                  m_vertices.next_vertex * sizeof(Vertex), sizeof(Vertex));
+  m_ogl.index_offset =
+      ring.upload(m_vertices.indices.data(), m_vertices.next_index * sizeof(u32), sizeof(u32));
   glBindVertexArray(m_ogl.vao);
-  glBindBuffer(GL_ARRAY_BUFFER, m_ogl.vertex_buffer);
-  glBufferData(GL_ARRAY_BUFFER, m_vertices.next_vertex * sizeof(Vertex), m_vertices.vertices.data(),
-               GL_STREAM_DRAW);
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ogl.index_buffer);
-  glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_vertices.next_index * sizeof(u32),
-               m_vertices.indices.data(), GL_STREAM_DRAW);
+  glBindVertexBuffer(0, ring.buffer(), vertex_offset, sizeof(Vertex));
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ring.buffer());
   m_stats.upload_wait += upload_timer.getSeconds();
   m_stats.num_uploads++;
   m_stats.upload_bytes +=
       (m_vertices.next_vertex * sizeof(Vertex)) + (m_vertices.next_index * sizeof(u32));
 
   // initial OpenGL setup
-  glEnable(GL_PRIMITIVE_RESTART);
+  render_state->gl_state.enable(GL_PRIMITIVE_RESTART);
   glPrimitiveRestartIndex(UINT32_MAX);
   render_state->shaders[ShaderId::DIRECT2].activate();
 
@@ -163,7 +158,7 @@ void DirectRenderer2::draw_call_loop_simple(SharedRenderState* render_state,
     setup_opengl_for_draw_mode(draw, render_state);
     setup_opengl_tex(0, draw.tbp, draw.mode.get_filt_enable(), draw.mode.get_clamp_s_enable(),
                      draw.mode.get_clamp_t_enable(), render_state);
-    void* offset = (void*)(draw.start_index * sizeof(u32));
+    void* offset = (void*)(m_ogl.index_offset + draw.start_index * sizeof(u32));
     int end_idx;
     if (draw_idx == m_next_free_draw - 1) {
       end_idx = m_vertices.next_index;
@@ -178,7 +173,7 @@ void DirectRenderer2::draw_call_loop_simple(SharedRenderState* render_state,
 
 void DirectRenderer2::draw_call_loop_grouped(SharedRenderState* render_state,
                                              ScopedProfilerNode& prof) {
-  glEnable(GL_PRIMITIVE_RESTART);
+  render_state->gl_state.enable(GL_PRIMITIVE_RESTART);
   glPrimitiveRestartIndex(UINT32_MAX);
   u32 draw_idx = 0;
   while (draw_idx < m_next_free_draw) {
@@ -213,7 +208,7 @@ void DirectRenderer2::draw_call_loop_grouped(SharedRenderState* render_state,
     } else {
       end_idx = m_draw_buffer[end_of_draw_group + 1].start_index;
     }
-    void* offset = (void*)(draw.start_index * sizeof(u32));
+    void* offset = (void*)(m_ogl.index_offset + draw.start_index * sizeof(u32));
     // fmt::print("drawing {:4d} with abe {} tex {} {}", end_idx - draw.start_index,
     // (int)draw.mode.get_ab_enable(), end_of_draw_group - draw_idx, draw.to_single_line_string() );
     // fmt::print("{}\n", draw.mode.to_string());
@@ -245,44 +240,46 @@ void DirectRenderer2::setup_opengl_for_draw_mode(const Draw& draw,
   // setup blending and color mult
   float color_mult = 1.f;
   if (!draw.mode.get_ab_enable()) {
-    glDisable(GL_BLEND);
+    render_state->gl_state.disable(GL_BLEND);
   } else {
-    glEnable(GL_BLEND);
-    glBlendColor(1, 1, 1, 1);
+    render_state->gl_state.enable(GL_BLEND);
+    render_state->gl_state.blend_color(1, 1, 1, 1);
     if (draw.mode.get_alpha_blend() == DrawMode::AlphaBlend::SRC_DST_SRC_DST) {
       // (Cs - Cd) * As + Cd
       // Cs * As  + (1 - As) * Cd
       // s, d
-      glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ZERO);
-      glBlendEquation(GL_FUNC_ADD);
+      render_state->gl_state.blend_func_separate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE,
+                                                 GL_ZERO);
+      render_state->gl_state.blend_equation(GL_FUNC_ADD);
     } else if (draw.mode.get_alpha_blend() == DrawMode::AlphaBlend::SRC_0_SRC_DST) {
       // (Cs - 0) * As + Cd
       // Cs * As + (1) * Cd
       // s, d
       ASSERT(draw.fix == 0);
-      glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE, GL_ONE, GL_ZERO);
-      glBlendEquation(GL_FUNC_ADD);
+      render_state->gl_state.blend_func_separate(GL_SRC_ALPHA, GL_ONE, GL_ONE, GL_ZERO);
+      render_state->gl_state.blend_equation(GL_FUNC_ADD);
     } else if (draw.mode.get_alpha_blend() == DrawMode::AlphaBlend::ZERO_SRC_SRC_DST) {
       // (0 - Cs) * As + Cd
       // Cd - Cs * As
       // s, d
-      glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE, GL_ONE, GL_ZERO);
-      glBlendEquation(GL_FUNC_REVERSE_SUBTRACT);
+      render_state->gl_state.blend_func_separate(GL_SRC_ALPHA, GL_ONE, GL_ONE, GL_ZERO);
+      render_state->gl_state.blend_equation(GL_FUNC_REVERSE_SUBTRACT);
     } else if (draw.mode.get_alpha_blend() == DrawMode::AlphaBlend::SRC_DST_FIX_DST) {
       // (Cs - Cd) * fix + Cd
       // Cs * fix + (1 - fx) * Cd
-      glBlendFuncSeparate(GL_CONSTANT_ALPHA, GL_ONE_MINUS_CONSTANT_ALPHA, GL_ONE, GL_ZERO);
-      glBlendColor(0, 0, 0, draw.fix / 127.f);
-      glBlendEquation(GL_FUNC_ADD);
+      render_state->gl_state.blend_func_separate(GL_CONSTANT_ALPHA, GL_ONE_MINUS_CONSTANT_ALPHA,
+                                                 GL_ONE, GL_ZERO);
+      render_state->gl_state.blend_color(0, 0, 0, draw.fix / 127.f);
+      render_state->gl_state.blend_equation(GL_FUNC_ADD);
     } else if (draw.mode.get_alpha_blend() == DrawMode::AlphaBlend::SRC_SRC_SRC_SRC) {
       // this is very weird...
       // Cs
-      glBlendFuncSeparate(GL_ONE, GL_ZERO, GL_ONE, GL_ZERO);
-      glBlendEquation(GL_FUNC_ADD);
+      render_state->gl_state.blend_func_separate(GL_ONE, GL_ZERO, GL_ONE, GL_ZERO);
+      render_state->gl_state.blend_equation(GL_FUNC_ADD);
     } else if (draw.mode.get_alpha_blend() == DrawMode::AlphaBlend::SRC_0_DST_DST) {
       // (Cs - 0) * Ad + Cd
-      glBlendFuncSeparate(GL_DST_ALPHA, GL_ONE, GL_ONE, GL_ZERO);
-      glBlendEquation(GL_FUNC_ADD);
+      render_state->gl_state.blend_func_separate(GL_DST_ALPHA, GL_ONE, GL_ONE, GL_ZERO);
+      render_state->gl_state.blend_equation(GL_FUNC_ADD);
       color_mult = 0.5;
     } else {
       ASSERT(false);
@@ -291,19 +288,19 @@ void DirectRenderer2::setup_opengl_for_draw_mode(const Draw& draw,
 
   // setup ztest
   if (draw.mode.get_zt_enable()) {
-    glEnable(GL_DEPTH_TEST);
+    render_state->gl_state.enable(GL_DEPTH_TEST);
     switch (draw.mode.get_depth_test()) {
       case GsTest::ZTest::NEVER:
-        glDepthFunc(GL_NEVER);
+        render_state->gl_state.depth_func(GL_NEVER);
         break;
       case GsTest::ZTest::ALWAYS:
-        glDepthFunc(GL_ALWAYS);
+        render_state->gl_state.depth_func(GL_ALWAYS);
         break;
       case GsTest::ZTest::GEQUAL:
-        glDepthFunc(GL_GEQUAL);
+        render_state->gl_state.depth_func(GL_GEQUAL);
         break;
       case GsTest::ZTest::GREATER:
-        glDepthFunc(GL_GREATER);
+        render_state->gl_state.depth_func(GL_GREATER);
         break;
       default:
         ASSERT(false);
@@ -314,9 +311,9 @@ void DirectRenderer2::setup_opengl_for_draw_mode(const Draw& draw,
   }
 
   if (draw.mode.get_depth_write_enable()) {
-    glDepthMask(GL_TRUE);
+    render_state->gl_state.depth_mask(true);
   } else {
-    glDepthMask(GL_FALSE);
+    render_state->gl_state.depth_mask(false);
   }
 
   if (draw.tbp == UINT16_MAX) {
@@ -356,8 +353,8 @@ void DirectRenderer2::setup_opengl_tex(u16 unit,
     tex = render_state->texture_pool->get_placeholder_texture();
   }
 
-  glActiveTexture(GL_TEXTURE0 + unit);
-  glBindTexture(GL_TEXTURE_2D, *tex);
+  render_state->gl_state.active_texture(GL_TEXTURE0 + unit);
+  render_state->gl_state.bind_texture(GL_TEXTURE_2D, *tex);
   if (clamp_s) {
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
   } else {
@@ -97,9 +97,8 @@ class DirectRenderer2 {
   } m_vertices;
 
   struct {
-    GLuint vertex_buffer;
-    GLuint index_buffer;
     GLuint vao;
+    u64 index_offset = 0;  // offset of the pending indices in the stream buffer
     GLuint alpha_reject, color_mult, fog_color;
   } m_ogl;
 
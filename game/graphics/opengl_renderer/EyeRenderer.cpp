@@ -97,12 +97,16 @@ void EyeRenderer::render(DmaFollower& dma,
 
   while (dma.current_tag_offset() != render_state->next_bucket) {
     auto data = dma.read_and_advance();
-    m_debug += fmt::format("dma: {}\n", data.size_bytes);
+    if (m_debug_window_open) {
+      m_debug += fmt::format("dma: {}\n", data.size_bytes);
+    }
   }
 }
 
 void EyeRenderer::draw_debug_window() {
   ImGui::Text("Time: %.3f ms\n", m_average_time_ms);
+  ImGui::Checkbox("Skip unchanged eyes", &m_use_eye_cache);
+  ImGui::Text("Drawn: %d, unchanged: %d\n", m_eyes_drawn, m_eyes_cached);
   ImGui::Text("Debug:\n%s", m_debug.c_str());
 }
 
@@ -454,8 +458,35 @@ int add_draw_to_buffer_64(int idx,
   return idx;
 }
 
+/*!
+ * Store the parameters of this eye in the cache. Returns true if they changed since the eye was
+ * last drawn, meaning that it needs to be drawn again.
+ */
+bool EyeRenderer::update_eye_cache(const SingleEyeDraws& draw, const float* verts) {
+  auto& entry = m_eye_cache[draw.tex_slot()];
+  EyeCacheEntry next;
+  next.valid = true;
+  next.clear_color = draw.clear_color;
+  next.tex[0] = draw.iris_tex;
+  next.tex[1] = draw.pupil_tex;
+  next.tex[2] = draw.lid_tex;
+  next.gl_tex[0] = draw.iris_tex ? draw.iris_gl_tex : 0;
+  next.gl_tex[1] = draw.pupil_tex ? draw.pupil_gl_tex : 0;
+  next.gl_tex[2] = draw.lid_tex ? draw.lid_gl_tex : 0;
+  memcpy(next.verts, verts, sizeof(next.verts));
+
+  bool changed = !m_use_eye_cache || !entry.valid || entry.clear_color != next.clear_color ||
+                 memcmp(entry.tex, next.tex, sizeof(next.tex)) != 0 ||
+                 memcmp(entry.gl_tex, next.gl_tex, sizeof(next.gl_tex)) != 0 ||
+                 memcmp(entry.verts, next.verts, sizeof(next.verts)) != 0;
+  entry = next;
+  return changed;
+}
+
 void EyeRenderer::run_gpu(const std::vector<SingleEyeDraws>& draws,
                           SharedRenderState* render_state) {
+  m_eyes_drawn = 0;
+  m_eyes_cached = 0;
   if (draws.empty()) {
     return;
   }
@@ -485,10 +516,34 @@ void EyeRenderer::run_gpu(const std::vector<SingleEyeDraws>& draws,
   ASSERT(buffer_idx <= VTX_BUFFER_FLOATS);
   int check = buffer_idx;
 
+  // find the eyes that changed. The others still have last frame's result in their texture.
+  constexpr int kFloatsPerEye = 4 * 4 * 3;
+  bool needs_draw[NUM_EYE_PAIRS * 2];
+  for (size_t draw_idx = 0; draw_idx < draws.size(); draw_idx++) {
+    needs_draw[draw_idx] =
+        update_eye_cache(draws[draw_idx], m_gpu_vertex_buffer + draw_idx * kFloatsPerEye);
+    if (needs_draw[draw_idx]) {
+      m_eyes_drawn++;
+    } else {
+      m_eyes_cached++;
+      const auto& out_tex = m_gpu_eye_textures[draws[draw_idx].tex_slot()];
+      render_state->texture_pool->move_existing_to_vram(out_tex.gpu_tex, out_tex.tbp);
+    }
+  }
+  if (m_eyes_drawn == 0) {
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return;
+  }
+
   // maybe buffer sub data.
   glBufferData(GL_ARRAY_BUFFER, buffer_idx * sizeof(float), m_gpu_vertex_buffer, GL_STREAM_DRAW);
 
-  FramebufferTexturePairContext ctxt(m_gpu_eye_textures[draws.front().tex_slot()].fb);
+  size_t first_draw = 0;
+  while (!needs_draw[first_draw]) {
+    first_draw++;
+  }
+  FramebufferTexturePairContext ctxt(m_gpu_eye_textures[draws[first_draw].tex_slot()].fb);
 
   // set up common opengl state
   glDisable(GL_DEPTH_TEST);
@@ -501,10 +556,17 @@ void EyeRenderer::run_gpu(const std::vector<SingleEyeDraws>& draws,
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-  buffer_idx = 0;
-  for (size_t draw_idx = 0; draw_idx < draws.size(); draw_idx++) {
+  buffer_idx = first_draw * kFloatsPerEye;
+  for (size_t draw_idx = first_draw; draw_idx < draws.size(); draw_idx++) {
     const auto& draw = draws[draw_idx];
     const auto& out_tex = m_gpu_eye_textures[draw.tex_slot()];
+    if (!needs_draw[draw_idx]) {
+      buffer_idx += kFloatsPerEye;
+      continue;
+    }
+    if (draw_idx != first_draw) {
+      ctxt.switch_to(m_gpu_eye_textures[draw.tex_slot()].fb);
+    }
 
     // first, the clear
     float clear[4] = {0, 0, 0, 0};
@@ -542,10 +604,6 @@ void EyeRenderer::run_gpu(const std::vector<SingleEyeDraws>& draws,
 
     // finally, give to "vram"
     render_state->texture_pool->move_existing_to_vram(out_tex.gpu_tex, out_tex.tbp);
-
-    if (draw_idx != draws.size() - 1) {
-      ctxt.switch_to(m_gpu_eye_textures[draws[draw_idx + 1].tex_slot()].fb);
-    }
   }
 
   ASSERT(check == buffer_idx);
@@ -83,6 +83,20 @@ class EyeRenderer : public BucketRenderer {
     u64 lid_gl_tex = 0;
   };
 
+  // everything that affects the output of a single eye. If this matches what was last drawn to
+  // the eye's texture, the texture is already correct and we can skip drawing it.
+  struct EyeCacheEntry {
+    bool valid = false;
+    u32 clear_color = 0;
+    GpuTexture* tex[3] = {nullptr, nullptr, nullptr};
+    u64 gl_tex[3] = {0, 0, 0};
+    float verts[4 * 4 * 3];
+  } m_eye_cache[NUM_EYE_PAIRS * 2];
+  bool m_use_eye_cache = true;
+  int m_eyes_drawn = 0;
+  int m_eyes_cached = 0;
+
+  bool update_eye_cache(const SingleEyeDraws& draw, const float* verts);
   std::vector<SingleEyeDraws> get_draws(DmaFollower& dma, SharedRenderState* render_state);
   void run_gpu(const std::vector<SingleEyeDraws>& draws, SharedRenderState* render_state);
 };
@@ -0,0 +1,131 @@
+#include "FrameCapture.h"
+
+#include <algorithm>
+#include <thread>
+
+#include "common/log/log.h"
+#include "common/util/FileUtil.h"
+#include "common/util/compress.h"
+
+#include "game/graphics/texture/TexturePool.h"
+
+#include "third-party/fmt/core.h"
+
+namespace {
+constexpr u32 NO_TEXTURE = UINT32_MAX;
+}
+
+FrameCapture::Frame FrameCapture::load_frame(int idx) const {
+  auto& compressed = compressed_frames.at(idx);
+  auto data = compression::decompress_zstd(compressed.data(), compressed.size());
+  Serializer ser(data.data(), data.size());
+
+  Frame result;
+  ser.from_string_vector(&result.levels);
+  ser.from_ptr(&result.pmode_alp);
+  ser.from_pod_vector(&result.texture_links);
+  ser.from_ptr(&result.dma_start_offset);
+  ser.from_pod_vector(&result.dma_data);
+  return result;
+}
+
+void FrameCaptureRecorder::start(const std::string& path,
+                                 int frame_count,
+                                 GameVersion game_version,
+                                 int game_res_w,
+                                 int game_res_h,
+                                 int msaa_samples) {
+  m_capture = {};
+  m_capture.game_version = game_version;
+  m_capture.game_res_w = game_res_w;
+  m_capture.game_res_h = game_res_h;
+  m_capture.msaa_samples = msaa_samples;
+  m_path = path;
+  m_frames_left = frame_count;
+  m_last_links.clear();
+}
+
+void FrameCaptureRecorder::add_frame(const std::vector<std::string>& levels,
+                                     float pmode_alp,
+                                     const TexturePool& texture_pool,
+                                     FixedChunkDmaCopier& copier) {
+  ASSERT(active());
+  Serializer ser;
+  auto levels_copy = levels;
+  ser.from_string_vector(&levels_copy);
+  ser.save<float>(pmode_alp);
+
+  // the first frame saves every slot, the rest only save the ones that changed.
+  auto& slots = texture_pool.all_textures();
+  m_last_links.resize(slots.size(), NO_TEXTURE);
+  std::vector<FrameCapture::TextureLink> links;
+  for (u32 i = 0; i < slots.size(); i++) {
+    const GpuTexture* source = slots[i].source.load(std::memory_order_acquire);
+    u32 id = source ? (((u32)source->tex_id.page << 16) | source->tex_id.tex) : NO_TEXTURE;
+    if (id != m_last_links[i]) {
+      m_last_links[i] = id;
+      if (id != NO_TEXTURE) {
+        links.push_back({i, id});
+      }
+    }
+  }
+  ser.from_pod_vector(&links);
+  copier.serialize_last_result(ser);
+
+  auto result = ser.get_save_result();
+  // chains are tens of MB, so use more threads to avoid a long hitch.
+  compression::ZstdOptions options;
+  options.workers = std::max(1, (int)std::thread::hardware_concurrency() / 2);
+  m_capture.compressed_frames.push_back(
+      compression::compress_zstd(result.first, result.second, options));
+
+  if (--m_frames_left == 0) {
+    save();
+  }
+}
+
+void FrameCaptureRecorder::save() {
+  Serializer ser;
+  ser.save<u32>(FrameCapture::VERSION);
+  ser.save<GameVersion>(m_capture.game_version);
+  ser.save<s32>(m_capture.game_res_w);
+  ser.save<s32>(m_capture.game_res_h);
+  ser.save<s32>(m_capture.msaa_samples);
+  ser.save<u32>(m_capture.compressed_frames.size());
+  for (auto& frame : m_capture.compressed_frames) {
+    ser.from_pod_vector(&frame);
+  }
+
+  auto result = ser.get_save_result();
+  file_util::create_dir_if_needed_for_file(m_path);
+  file_util::write_binary_file(m_path, result.first, result.second);
+  lg::info("Saved {} frame capture to {}", m_capture.frame_count(), m_path);
+  m_capture = {};
+  m_last_links.clear();
+}
+
+FrameCapture load_frame_capture(const std::string& path) {
+  auto data = file_util::read_binary_file(path);
+  Serializer ser(data.data(), data.size());
+
+  FrameCapture result;
+  u32 version = ser.load<u32>();
+  ASSERT_MSG(version == FrameCapture::VERSION,
+             fmt::format("Frame capture {} has version {}, expected {}", path, version,
+                         FrameCapture::VERSION));
+  result.game_version = ser.load<GameVersion>();
+  result.game_res_w = ser.load<s32>();
+  result.game_res_h = ser.load<s32>();
+  result.msaa_samples = ser.load<s32>();
+  result.compressed_frames.resize(ser.load<u32>());
+  for (auto& frame : result.compressed_frames) {
+    ser.from_pod_vector(&frame);
+  }
+  return result;
+}
+
+void apply_texture_links(TexturePool& texture_pool, const FrameCapture::Frame& frame) {
+  for (auto& link : frame.texture_links) {
+    texture_pool.link_texture(PcTextureId::from_combo_id(link.tex_combo_id), link.slot);
+  }
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+/*!
+ * @file FrameCapture.h
+ * A recording of consecutive frames' DMA chains, saved to a file so they can be replayed through
+ * the renderer without running the game. Used by the render_benchmark tool, for timing and for
+ * comparing the rendered frames to golden images.
+ */
+
+#include <string>
+#include <vector>
+
+#include "common/dma/dma_copy.h"
+#include "common/versions/versions.h"
+
+class TexturePool;
+
+struct FrameCapture {
+  static constexpr u32 VERSION = 2;
+
+  // a texture the game had uploaded to a vram slot. Only the slots that changed since the previous
+  // frame are saved.
+  struct TextureLink {
+    u32 slot = 0;
+    u32 tex_combo_id = 0;  // PcTextureId, page << 16 | tex
+  };
+
+  struct Frame {
+    std::vector<std::string> levels;  // the levels the game wanted loaded on this frame
+    float pmode_alp = 0.f;
+    std::vector<TextureLink> texture_links;
+    u32 dma_start_offset = 0;
+    std::vector<u8> dma_data;
+  };
+
+  GameVersion game_version = GameVersion::Jak1;
+  // the render options of the recording. The replay may override them.
+  int game_res_w = 0;
+  int game_res_h = 0;
+  int msaa_samples = 0;
+
+  // each frame is compressed on its own, so a long recording doesn't have to be unpacked at once.
+  std::vector<std::vector<u8>> compressed_frames;
+
+  int frame_count() const { return compressed_frames.size(); }
+  Frame load_frame(int idx) const;
+};
+
+/*!
+ * Records the next frames rendered, then writes them to a file.
+ */
+class FrameCaptureRecorder {
+ public:
+  void start(const std::string& path,
+             int frame_count,
+             GameVersion game_version,
+             int game_res_w,
+             int game_res_h,
+             int msaa_samples);
+  bool active() const { return m_frames_left > 0; }
+
+  /*!
+   * Add the last result of the DMA copier, which must have run on this frame. The file is written
+   * after the last frame.
+   */
+  void add_frame(const std::vector<std::string>& levels,
+                 float pmode_alp,
+                 const TexturePool& texture_pool,
+                 FixedChunkDmaCopier& copier);
+
+ private:
+  void save();
+
+  FrameCapture m_capture;
+  std::string m_path;
+  int m_frames_left = 0;
+  // the texture in each vram slot as of the last frame, to find the ones that changed.
+  std::vector<u32> m_last_links;
+};
+
+/*!
+ * Load a recording saved by FrameCaptureRecorder.
+ */
+FrameCapture load_frame_capture(const std::string& path);
+
+/*!
+ * Link the textures of a frame into the pool, like the game's uploads did.
+ */
+void apply_texture_links(TexturePool& texture_pool, const FrameCapture::Frame& frame);
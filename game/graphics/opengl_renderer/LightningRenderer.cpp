@@ -15,6 +15,14 @@ void LightningRenderer::render(DmaFollower& dma,
   m_generic.render_in_mode(dma, render_state, prof, Generic2::Mode::LIGHTNING);
 }
 
+void LightningRenderer::prepare(DmaFollower& dma, u32 next_bucket, GameVersion version) {
+  m_generic.prepare_in_mode(dma, next_bucket, version, Generic2::Mode::LIGHTNING);
+}
+
+void LightningRenderer::submit(SharedRenderState* render_state, ScopedProfilerNode& prof) {
+  m_generic.submit(render_state, prof);
+}
+
 void LightningRenderer::init_shaders(ShaderLibrary& shaders) {
   m_generic.init_shaders(shaders);
 }
\ No newline at end of file
@@ -11,6 +11,10 @@ class LightningRenderer : public BucketRenderer {
   void draw_debug_window() override;
   void init_shaders(ShaderLibrary& shaders) override;
 
+  bool supports_prepare() const override { return true; }
+  void prepare(DmaFollower& dma, u32 next_bucket, GameVersion version) override;
+  void submit(SharedRenderState* render_state, ScopedProfilerNode& prof) override;
+
  private:
   Generic2 m_generic;
 };
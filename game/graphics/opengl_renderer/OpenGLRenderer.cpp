@@ -1,5 +1,7 @@
 #include "OpenGLRenderer.h"
 
+#include <cmath>
+
 #include "common/goal_constants.h"
 #include "common/log/log.h"
 #include "common/util/FileUtil.h"
@@ -13,6 +15,7 @@
 #include "game/graphics/opengl_renderer/ShadowRenderer.h"
 #include "game/graphics/opengl_renderer/SkyRenderer.h"
 #include "game/graphics/opengl_renderer/TextureUploadHandler.h"
+#include "game/graphics/opengl_renderer/TextRenderer.h"
 #include "game/graphics/opengl_renderer/VisDataHandler.h"
 #include "game/graphics/opengl_renderer/Warp.h"
 #include "game/graphics/opengl_renderer/background/Shrub.h"
@@ -27,6 +30,7 @@
 #include "game/graphics/pipelines/opengl.h"
 
 #include "third-party/imgui/imgui.h"
+#include "third-party/zstd/lib/common/xxhash.h"
 
 // for the vif callback
 #include "game/kernel/common/kmachine.h"
@@ -75,6 +79,9 @@ OpenGLRenderer::OpenGLRenderer(std::shared_ptr<TexturePool> texture_pool,
   const GLuint gl_error_ignores_api_other[1] = {0x20071};
   glDebugMessageControl(GL_DEBUG_SOURCE_API, GL_DEBUG_TYPE_OTHER, GL_DONT_CARE, 1,
                         &gl_error_ignores_api_other[0], GL_FALSE);
+  // every profiler node is a debug group, don't log them.
+  glDebugMessageControl(GL_DONT_CARE, GL_DEBUG_TYPE_PUSH_GROUP, GL_DONT_CARE, 0, nullptr, GL_FALSE);
+  glDebugMessageControl(GL_DONT_CARE, GL_DEBUG_TYPE_POP_GROUP, GL_DONT_CARE, 0, nullptr, GL_FALSE);
 
   lg::debug("OpenGL context information: {}", (const char*)glGetString(GL_VERSION));
 
@@ -245,8 +252,8 @@ void OpenGLRenderer::init_bucket_renderers_jak2() {
                                          0x1000);
   init_bucket_renderer<DirectRenderer>("screen-filter", BucketCategory::OTHER,
                                        BucketId::SCREEN_FILTER, 256);
-  init_bucket_renderer<DirectRenderer>("subtitle", BucketCategory::OTHER, BucketId::SUBTITLE,
-                                       0x1000);
+  init_bucket_renderer<TextRenderer>("subtitle", BucketCategory::OTHER, BucketId::SUBTITLE,
+                                     0x1000);
   init_bucket_renderer<DirectRenderer>("debug2", BucketCategory::OTHER, BucketId::DEBUG2, 0x8000);
   init_bucket_renderer<DirectRenderer>("debug-no-zbuf2", BucketCategory::OTHER,
                                        BucketId::DEBUG_NO_ZBUF2, 0x8000);
@@ -477,11 +484,11 @@ void OpenGLRenderer::init_bucket_renderers_jak1() {
 
   init_bucket_renderer<Sprite3>("sprite", BucketCategory::SPRITE, BucketId::SPRITE);  // 66
 
-  init_bucket_renderer<DirectRenderer>("debug", BucketCategory::OTHER, BucketId::DEBUG, 0x20000);
+  init_bucket_renderer<TextRenderer>("debug", BucketCategory::OTHER, BucketId::DEBUG, 0x20000);
   init_bucket_renderer<DirectRenderer>("debug-no-zbuf", BucketCategory::OTHER,
                                        BucketId::DEBUG_NO_ZBUF, 0x8000);
   // an extra custom bucket!
-  init_bucket_renderer<DirectRenderer>("subtitle", BucketCategory::OTHER, BucketId::SUBTITLE, 6000);
+  init_bucket_renderer<TextRenderer>("subtitle", BucketCategory::OTHER, BucketId::SUBTITLE, 6000);
 
   // for now, for any unset renderers, just set them to an EmptyBucketRenderer.
   for (size_t i = 0; i < m_bucket_renderers.size(); i++) {
@@ -495,6 +502,9 @@ void OpenGLRenderer::init_bucket_renderers_jak1() {
   }
   sky_cpu_blender->init_textures(*m_render_state.texture_pool, m_version);
   sky_gpu_blender->init_textures(*m_render_state.texture_pool, m_version);
+  if (!sky_gpu_blender->is_supported()) {
+    m_render_state.use_sky_cpu = true;
+  }
   m_render_state.loader->load_common(*m_render_state.texture_pool, "GAME");
 }
 
@@ -519,6 +529,11 @@ Fbo make_fbo(int w, int h, int msaa, bool make_zbuf_and_stencil) {
   } else {
     glBindTexture(GL_TEXTURE_2D, tex);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    // no mipmaps, so it can be sampled by the final post-processing pass.
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
   }
   // make depth and stencil buffers that will hold the... depth and stencil buffers
   if (make_zbuf_and_stencil) {
@@ -651,6 +666,23 @@ void OpenGLRenderer::render(DmaFollower dma, const RenderOptions& settings) {
     dispatch_buckets(dma, prof, settings.gpu_sync);
   }
 
+  // the depth of this frame, for occlusion culling the next one. The window's depth buffer may not
+  // have the same format as ours, so it can't be copied.
+  if (m_render_state.use_gpu_culling && m_render_state.use_depth_pyramid_culling &&
+      !m_fbo_state.render_fbo->is_window) {
+    auto prof = m_profiler.root()->make_scoped_child("depth-pyramid");
+    m_depth_pyramid.build(m_render_state.render_fb, m_render_state.render_fb_x,
+                          m_render_state.render_fb_y, m_render_state.render_fb_w,
+                          m_render_state.render_fb_h, &m_render_state);
+  } else {
+    m_depth_pyramid.invalidate(&m_render_state);
+  }
+
+  // everything uploaded to the stream buffer this frame is now in use by the GPU.
+  m_render_state.stream_buffer.fence();
+  // unbinds the draw mode samplers, so they don't apply to the pcrtc draw or imgui.
+  m_render_state.gl_state.invalidate();
+
   // apply effects done with PCRTC registers
   {
     auto prof = m_profiler.root()->make_scoped_child("pcrtc");
@@ -668,27 +700,31 @@ void OpenGLRenderer::render(DmaFollower dma, const RenderOptions& settings) {
 
   m_last_pmode_alp = settings.pmode_alp_register;
 
-  if (settings.draw_render_debug_window) {
-    auto prof = m_profiler.root()->make_scoped_child("render-window");
-    draw_renderer_selection_window();
-    // add a profile bar for the imgui stuff
-    // vif_interrupt_callback(0);
+  if (settings.draw_render_debug_window || settings.draw_loader_window) {
+    auto prof = m_profiler.root()->make_scoped_child("debug-windows");
+    if (settings.draw_render_debug_window) {
+      draw_renderer_selection_window();
+    }
+    if (settings.draw_loader_window) {
+      m_render_state.loader->draw_debug_window();
+    }
     if (settings.gpu_sync) {
       glFinish();
     }
   }
-
-  if (settings.draw_loader_window) {
-    m_render_state.loader->draw_debug_window();
+  if (!settings.draw_render_debug_window && !settings.debug_ui_skipped) {
+    close_renderer_debug_windows();
   }
 
   m_profiler.finish();
+  update_dynamic_resolution();
   //  if (m_profiler.root_time() > 0.018) {
   //    fmt::print("Slow frame: {:.2f} ms\n", m_profiler.root_time() * 1000);
   //    fmt::print("{}\n", m_profiler.to_string());
   //  }
 
   if (settings.draw_profiler_window) {
+    m_profiler.set_debug_ui_time(settings.debug_ui_cpu_ms, settings.debug_ui_gpu_ms);
     m_profiler.draw();
   }
 
@@ -719,43 +755,78 @@ void OpenGLRenderer::render(DmaFollower dma, const RenderOptions& settings) {
     m_filters_menu.draw_window();
   }
 
+  // screenshots from previous frames that are done on the GPU are sent to the png encoder.
+  m_screenshots.update();
   if (settings.save_screenshot) {
-    Fbo* screenshot_src;
-    int read_buffer;
-
-    // can't screenshot from a multisampled buffer directly -
-    if (m_fbo_state.resources.resolve_buffer.valid) {
-      screenshot_src = &m_fbo_state.resources.resolve_buffer;
-      read_buffer = GL_COLOR_ATTACHMENT0;
-    } else {
-      screenshot_src = m_fbo_state.render_fbo;
-      read_buffer = GL_FRONT;
-    }
-    finish_screenshot(settings.screenshot_path, screenshot_src->width, screenshot_src->height, 0, 0,
-                      screenshot_src->fbo_id, read_buffer);
+    start_screenshot(settings.screenshot_path);
   }
   if (settings.gpu_sync) {
     glFinish();
   }
 }
 
+/*!
+ * Tell the renderers that their debug windows aren't shown, so they stop collecting stats for them.
+ */
+void OpenGLRenderer::close_renderer_debug_windows() {
+  for (auto& renderer : m_bucket_renderers) {
+    if (renderer) {
+      renderer->set_debug_window_open(false);
+    }
+  }
+  if (m_jak2_eye_renderer) {
+    m_jak2_eye_renderer->set_debug_window_open(false);
+  }
+}
+
 /*!
  * Draw the per-renderer debug window
  */
 void OpenGLRenderer::draw_renderer_selection_window() {
-  ImGui::Begin("Renderer Debug");
+  if (!ImGui::Begin("Renderer Debug")) {
+    // collapsed
+    ImGui::End();
+    close_renderer_debug_windows();
+    return;
+  }
 
   ImGui::Checkbox("Use old single-draw", &m_render_state.no_multidraw);
   ImGui::SliderFloat("Fog Adjust", &m_render_state.fog_intensity, 0, 10);
   ImGui::Checkbox("Sky CPU", &m_render_state.use_sky_cpu);
   ImGui::Checkbox("Occlusion Cull", &m_render_state.use_occlusion_culling);
+  ImGui::Checkbox("GPU Culling", &m_render_state.use_gpu_culling);
+  if (m_render_state.use_gpu_culling) {
+    ImGui::Checkbox("Depth Pyramid Occlusion", &m_render_state.use_depth_pyramid_culling);
+  }
+  ImGui::Checkbox("GPU Wind", &m_render_state.use_gpu_wind);
+  ImGui::Checkbox("Compute Ocean Mips", &m_render_state.use_compute_ocean_mips);
+  ImGui::Checkbox("Auto LOD", &Gfx::g_global_settings.lod_auto);
+  if (Gfx::g_global_settings.lod_auto) {
+    ImGui::SliderFloat("LOD size (px)", &Gfx::g_global_settings.lod_auto_pixels, 10.f, 500.f);
+  }
   ImGui::Checkbox("Blackout Loads", &m_enable_fast_blackout_loads);
+  ImGui::Checkbox("Parallel Bucket Prepare", &m_parallel_bucket_prepare);
+  ImGui::Checkbox("Cache Static Scene", &Gfx::g_global_settings.cache_static_scene);
+  if (Gfx::g_global_settings.cache_static_scene) {
+    ImGui::Text("Scene reused for %d frames", m_scene_cache.hit_frames);
+  }
+  ImGui::Checkbox("Dynamic Resolution", &m_dynamic_res.enabled);
+  if (m_dynamic_res.enabled) {
+    ImGui::SliderFloat("Target GPU ms", &m_dynamic_res.target_ms, 4.f, 50.f);
+    ImGui::SliderFloat("Min Scale", &m_dynamic_res.min_scale, 0.25f, 1.f);
+    ImGui::Text("Scale %.2f, GPU %.2f ms", m_dynamic_res.scale, m_dynamic_res.filtered_gpu_ms);
+  }
+  ImGui::Text("Stream buffer: %s, %d waits",
+              m_render_state.stream_buffer.persistent() ? "persistent" : "unsynchronized",
+              m_render_state.stream_buffer.wait_count());
 
   for (size_t i = 0; i < m_bucket_renderers.size(); i++) {
     auto renderer = m_bucket_renderers[i].get();
     if (renderer && !renderer->empty()) {
       ImGui::PushID(i);
-      if (ImGui::TreeNode(renderer->name_and_id().c_str())) {
+      bool open = ImGui::TreeNode(renderer->name_and_id().c_str());
+      renderer->set_debug_window_open(open);
+      if (open) {
         ImGui::Checkbox("Enable", &renderer->enabled());
         renderer->draw_debug_window();
         ImGui::TreePop();
@@ -768,7 +839,9 @@ void OpenGLRenderer::draw_renderer_selection_window() {
     ImGui::TreePop();
   }
   if (m_jak2_eye_renderer) {
-    if (ImGui::TreeNode("Eyes")) {
+    bool open = ImGui::TreeNode("Eyes");
+    m_jak2_eye_renderer->set_debug_window_open(open);
+    if (open) {
       m_jak2_eye_renderer->draw_debug_window();
       ImGui::TreePop();
     }
@@ -776,10 +849,71 @@ void OpenGLRenderer::draw_renderer_selection_window() {
   ImGui::End();
 }
 
+/*!
+ * Pick the resolution scale for the next frame from the GPU time of the whole frame. The GPU
+ * times are a few frames old, so the scale only changes every UPDATE_INTERVAL frames, which also
+ * limits how often the framebuffers are recreated. Steps are rounded to STEP for the same reason.
+ */
+void OpenGLRenderer::update_dynamic_resolution() {
+  constexpr int UPDATE_INTERVAL = 15;
+  // ignore samples from frames rendered before the last change.
+  constexpr int SETTLE_FRAMES = 4;
+  constexpr float STEP = 0.05f;
+  constexpr float MAX_CHANGE = 0.1f;
+  auto& dr = m_dynamic_res;
+  if (!dr.enabled) {
+    dr.scale = 1.f;
+    dr.filtered_gpu_ms = 0;
+    dr.frames_until_update = 0;
+    return;
+  }
+
+  float gpu_ms = m_profiler.root()->stats().gpu_duration * 1000.f;
+  if (gpu_ms <= 0) {
+    // no GPU timing yet.
+    return;
+  }
+  if (dr.frames_until_update > 0) {
+    dr.frames_until_update--;
+    if (dr.frames_until_update >= UPDATE_INTERVAL - SETTLE_FRAMES) {
+      return;
+    }
+  }
+  dr.filtered_gpu_ms =
+      dr.filtered_gpu_ms == 0 ? gpu_ms : dr.filtered_gpu_ms * 0.8f + gpu_ms * 0.2f;
+  if (dr.frames_until_update > 0) {
+    return;
+  }
+
+  // only change when we're over the target, or well under it, to avoid going back and forth.
+  float ratio = dr.target_ms / dr.filtered_gpu_ms;
+  if (ratio > 1.f && ratio < 1.2f) {
+    return;
+  }
+
+  // GPU time is roughly proportional to the pixel count, which goes with scale squared.
+  float wanted = dr.scale * std::sqrt(ratio);
+  wanted = std::clamp(wanted, dr.scale - MAX_CHANGE, dr.scale + MAX_CHANGE);
+  wanted = std::clamp(std::round(wanted / STEP) * STEP, dr.min_scale, 1.f);
+  if (wanted != dr.scale) {
+    dr.scale = wanted;
+    dr.filtered_gpu_ms = 0;
+    dr.frames_until_update = UPDATE_INTERVAL;
+  }
+}
+
 /*!
  * Pre-render frame setup.
  */
 void OpenGLRenderer::setup_frame(const RenderOptions& settings) {
+  // screenshots always use the requested resolution.
+  int game_res_w = settings.game_res_w;
+  int game_res_h = settings.game_res_h;
+  if (m_dynamic_res.enabled && !settings.save_screenshot) {
+    game_res_w = std::max(1, (int)(game_res_w * m_dynamic_res.scale));
+    game_res_h = std::max(1, (int)(game_res_h * m_dynamic_res.scale));
+  }
+
   // SDL controls the window framebuffer, so we just update the size:
   auto& window_fb = m_fbo_state.resources.window;
 
@@ -794,12 +928,14 @@ void OpenGLRenderer::setup_frame(const RenderOptions& settings) {
   window_fb.multisampled = false;
 
   // see if the render FBO is still applicable
-  if (settings.save_screenshot || window_resized || !m_fbo_state.render_fbo ||
-      !m_fbo_state.render_fbo->matches(settings.game_res_w, settings.game_res_h,
-                                       settings.msaa_samples)) {
+  // screenshots need a separate fbo, but one that already matches can be reused. This keeps
+  // sequence captures from recreating the fbos every frame.
+  bool need_screenshot_fbo =
+      settings.save_screenshot && m_fbo_state.render_fbo && m_fbo_state.render_fbo->is_window;
+  if (need_screenshot_fbo || window_resized || !m_fbo_state.render_fbo ||
+      !m_fbo_state.render_fbo->matches(game_res_w, game_res_h, settings.msaa_samples)) {
     // doesn't match, set up a new one for these settings
-    lg::info("FBO Setup: requested {}x{}, msaa {}", settings.game_res_w, settings.game_res_h,
-             settings.msaa_samples);
+    lg::info("FBO Setup: requested {}x{}, msaa {}", game_res_w, game_res_h, settings.msaa_samples);
 
     // clear old framebuffers
     m_fbo_state.resources.render_buffer.clear();
@@ -809,7 +945,7 @@ void OpenGLRenderer::setup_frame(const RenderOptions& settings) {
     // note: we always force a separate fbo on a screenshot so that it won't capture overlays.
     //       as an added bonus it also doesn't break the sprite distort buffer...
     if (!settings.save_screenshot &&
-        window_fb.matches(settings.game_res_w, settings.game_res_h, settings.msaa_samples)) {
+        window_fb.matches(game_res_w, game_res_h, settings.msaa_samples)) {
       // it matches - no need for extra framebuffers.
       lg::info("FBO Setup: rendering directly to window framebuffer");
       m_fbo_state.render_fbo = &m_fbo_state.resources.window;
@@ -818,28 +954,26 @@ void OpenGLRenderer::setup_frame(const RenderOptions& settings) {
 
       // create a fbo to render to, with the desired settings
       m_fbo_state.resources.render_buffer =
-          make_fbo(settings.game_res_w, settings.game_res_h, settings.msaa_samples, true);
+          make_fbo(game_res_w, game_res_h, settings.msaa_samples, true);
       m_fbo_state.render_fbo = &m_fbo_state.resources.render_buffer;
 
       bool msaa_matches = window_fb.multisample_count == settings.msaa_samples;
 
       if (!msaa_matches) {
         lg::info("FBO Setup: using second temporary buffer: res: {}x{} {}x{}", window_fb.width,
-                 window_fb.height, settings.game_res_w, settings.game_res_h);
+                 window_fb.height, game_res_w, game_res_h);
 
         // we'll need a temporary fbo to do the msaa resolve step
         // non-multisampled, and doesn't need z/stencil
-        m_fbo_state.resources.resolve_buffer =
-            make_fbo(settings.game_res_w, settings.game_res_h, 1, false);
+        m_fbo_state.resources.resolve_buffer = make_fbo(game_res_w, game_res_h, 1, false);
       } else {
         lg::info("FBO Setup: not using second temporary buffer");
       }
     }
   }
 
-  ASSERT_MSG(settings.game_res_w > 0 && settings.game_res_h > 0,
-             fmt::format("Bad viewport size from game_res: {}x{}\n", settings.game_res_w,
-                         settings.game_res_h));
+  ASSERT_MSG(game_res_w > 0 && game_res_h > 0,
+             fmt::format("Bad viewport size from game_res: {}x{}\n", game_res_w, game_res_h));
 
   if (!m_fbo_state.render_fbo->is_window) {
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
@@ -891,10 +1025,177 @@ void OpenGLRenderer::setup_frame(const RenderOptions& settings) {
   } else {
     m_render_state.render_fb_x = 0;
     m_render_state.render_fb_y = 0;
-    m_render_state.render_fb_w = settings.game_res_w;
-    m_render_state.render_fb_h = settings.game_res_h;
-    glViewport(0, 0, settings.game_res_w, settings.game_res_h);
+    m_render_state.render_fb_w = game_res_w;
+    m_render_state.render_fb_h = game_res_h;
+    glViewport(0, 0, game_res_w, game_res_h);
+  }
+}
+
+/*!
+ * Read the transfers of every bucket into m_dma_index. Each bucket's chain starts at its entry in
+ * the bucket array and ends at the entry for the next bucket, so the buckets are read in parallel,
+ * and can be followed independently after.
+ */
+void OpenGLRenderer::index_buckets(const void* dma_base, ScopedProfilerNode& prof) {
+  auto p = prof.make_scoped_child("index");
+  m_dma_index.build(dma_base, m_render_state.buckets_base, m_bucket_renderers.size());
+}
+
+/*!
+ * In two-phase mode, run the CPU-side work of all buckets that support it in parallel, before any
+ * OpenGL work is submitted.
+ */
+void OpenGLRenderer::prepare_buckets(ScopedProfilerNode& prof) {
+  m_bucket_prepared.assign(m_bucket_renderers.size(), false);
+  if (!m_parallel_bucket_prepare) {
+    return;
+  }
+
+  auto p = prof.make_scoped_child("prepare");
+  std::vector<size_t> jobs;
+  for (size_t bucket_id = 0; bucket_id < m_bucket_renderers.size(); bucket_id++) {
+    if (m_bucket_renderers[bucket_id]->supports_prepare() &&
+        !skip_bucket_for_scene_cache(bucket_id)) {
+      jobs.push_back(bucket_id);
+    }
+  }
+
+  if (jobs.empty()) {
+    return;
+  }
+
+  m_prepare_threads.run(
+      [&](int job_idx) {
+        auto bucket_id = jobs[job_idx];
+        u32 end = m_dma_index.bucket_start(bucket_id + 1);
+        DmaFollower bucket_dma = m_dma_index.follower(bucket_id);
+        m_bucket_renderers[bucket_id]->prepare(bucket_dma, end, m_version);
+        ASSERT(bucket_dma.current_tag_offset() == end);
+      },
+      jobs.size());
+  m_prepare_threads.join();
+
+  for (auto bucket_id : jobs) {
+    m_bucket_prepared[bucket_id] = true;
+  }
+}
+
+/*!
+ * Render a single bucket. If the bucket was already prepared, just submit it.
+ */
+void OpenGLRenderer::render_bucket(size_t bucket_id, ScopedProfilerNode& prof) {
+  auto& renderer = m_bucket_renderers[bucket_id];
+  // not all renderers go through the state cache, so we can't trust it across buckets.
+  m_render_state.gl_state.invalidate();
+  m_render_state.gl_state.clear_stats();
+  if (m_bucket_prepared[bucket_id]) {
+    renderer->submit(&m_render_state, prof);
+  } else {
+    DmaFollower dma = m_dma_index.follower(bucket_id);
+    renderer->render(dma, &m_render_state, prof);
+    // should have ended at the start of the next chain
+    ASSERT(dma.current_tag_offset() == m_render_state.next_bucket);
+  }
+  prof.add_gl_calls_filtered(m_render_state.gl_state.stats().filtered);
+}
+
+/*!
+ * Decide if this frame can reuse the cached image of the buckets before split_bucket, by hashing
+ * their DMA. Call after index_buckets.
+ */
+void OpenGLRenderer::update_scene_cache(int split_bucket, ScopedProfilerNode& prof) {
+  auto& cache = m_scene_cache;
+  cache.split_bucket = split_bucket;
+  cache.hit = false;
+  cache.save = false;
+  if (!Gfx::g_global_settings.cache_static_scene || split_bucket < 0) {
+    cache.have_hash = false;
+    cache.valid = false;
+    cache.hit_frames = 0;
+    if (cache.fbo.valid) {
+      cache.fbo.clear();
+    }
+    return;
+  }
+
+  auto p = prof.make_scoped_child("scene-cache-hash");
+  // anything else that changes the image of those buckets goes in the seed.
+  const int target[4] = {m_render_state.render_fb_x, m_render_state.render_fb_y,
+                         m_render_state.render_fb_w, m_render_state.render_fb_h};
+  u64 hash = XXH64(target, sizeof(target), Gfx::g_global_settings.collision_enable);
+  for (int bucket = 0; bucket < split_bucket; bucket++) {
+    const auto* transfers = m_dma_index.bucket_transfers(bucket);
+    for (u32 i = 0; i < m_dma_index.bucket_transfer_count(bucket); i++) {
+      const auto& transfer = transfers[i].transfer;
+      hash = XXH64(&transfer.transferred_tag, sizeof(u64), hash);
+      hash = XXH64(transfer.data, transfer.size_bytes, hash);
+    }
+  }
+
+  const bool same = cache.have_hash && hash == cache.last_hash;
+  cache.have_hash = true;
+  cache.last_hash = hash;
+  if (!same) {
+    cache.valid = false;
+    cache.hit_frames = 0;
+    return;
+  }
+  const auto& fbo = *m_fbo_state.render_fbo;
+  if (cache.valid && cache.fbo.matches(m_render_state.render_fb_w, m_render_state.render_fb_h,
+                                       fbo.multisampled ? fbo.multisample_count : 1)) {
+    cache.hit = true;
+    cache.hit_frames++;
+  } else {
+    cache.save = true;
+  }
+}
+
+/*!
+ * Should this bucket be skipped, because the scene cache has its image?
+ */
+bool OpenGLRenderer::skip_bucket_for_scene_cache(size_t bucket_id) const {
+  return m_scene_cache.hit && (int)bucket_id < m_scene_cache.split_bucket &&
+         !m_bucket_renderers[bucket_id]->needed_for_later_buckets();
+}
+
+/*!
+ * Called right before the split bucket is drawn: copy the image of the earlier buckets to or from
+ * the cache. The window framebuffer's depth format may not match, so only color is copied there,
+ * and later buckets see a cleared depth buffer.
+ */
+void OpenGLRenderer::scene_cache_at_split() {
+  auto& cache = m_scene_cache;
+  if (!cache.hit && !cache.save) {
+    return;
+  }
+  const auto& fbo = *m_fbo_state.render_fbo;
+  const int x = m_render_state.render_fb_x;
+  const int y = m_render_state.render_fb_y;
+  const int w = m_render_state.render_fb_w;
+  const int h = m_render_state.render_fb_h;
+  const int msaa = fbo.multisampled ? fbo.multisample_count : 1;
+  GLbitfield mask = GL_COLOR_BUFFER_BIT;
+  if (!fbo.is_window) {
+    mask |= GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT;
   }
+
+  if (cache.save && !cache.fbo.matches(w, h, msaa)) {
+    cache.fbo.clear();
+    cache.fbo = make_fbo(w, h, msaa, true);
+  }
+  // blits are clipped by the scissor.
+  glDisable(GL_SCISSOR_TEST);
+  if (cache.save) {
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo.fbo_id);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, cache.fbo.fbo_id);
+    glBlitFramebuffer(x, y, x + w, y + h, 0, 0, w, h, mask, GL_NEAREST);
+    cache.valid = true;
+  } else {
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, cache.fbo.fbo_id);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fbo.fbo_id);
+    glBlitFramebuffer(0, 0, w, h, x, y, x + w, y + h, mask, GL_NEAREST);
+  }
+  glBindFramebuffer(GL_FRAMEBUFFER, fbo.fbo_id);
 }
 
 void OpenGLRenderer::dispatch_buckets_jak1(DmaFollower dma,
@@ -931,6 +1232,8 @@ void OpenGLRenderer::dispatch_buckets_jak1(DmaFollower dma,
   // now we should point to the first bucket!
   ASSERT(dma.current_tag_offset() == m_render_state.next_bucket);
   m_render_state.next_bucket += 16;
+  index_buckets(dma.base(), prof);
+  prepare_buckets(prof);
 
   // loop over the buckets!
   for (size_t bucket_id = 0; bucket_id < m_bucket_renderers.size(); bucket_id++) {
@@ -938,15 +1241,13 @@ void OpenGLRenderer::dispatch_buckets_jak1(DmaFollower dma,
     auto bucket_prof = prof.make_scoped_child(renderer->name_and_id());
     g_current_render = renderer->name_and_id();
     // lg::info("Render: {} start", g_current_render);
-    renderer->render(dma, &m_render_state, bucket_prof);
+    render_bucket(bucket_id, bucket_prof);
     if (sync_after_buckets) {
       auto pp = scoped_prof("finish");
       glFinish();
     }
 
     // lg::info("Render: {} end", g_current_render);
-    //  should have ended at the start of the next chain
-    ASSERT(dma.current_tag_offset() == m_render_state.next_bucket);
     m_render_state.next_bucket += 16;
     vif_interrupt_callback(bucket_id);
     m_category_times[(int)m_bucket_categories[bucket_id]] += bucket_prof.get_elapsed_time();
@@ -973,28 +1274,38 @@ void OpenGLRenderer::dispatch_buckets_jak2(DmaFollower dma,
   m_render_state.next_bucket = m_render_state.buckets_base + 16;
   m_render_state.bucket_for_vis_copy = (int)jak2::BucketId::BUCKET_2;
   m_render_state.num_vis_to_copy = jak2::LEVEL_MAX;
+  index_buckets(dma.base(), prof);
+  // the pause and progress menus are drawn in the progress bucket, over a scene that is frozen.
+  update_scene_cache((int)jak2::BucketId::PROGRESS, prof);
+  prepare_buckets(prof);
 
   for (size_t bucket_id = 0; bucket_id < m_bucket_renderers.size(); bucket_id++) {
     auto& renderer = m_bucket_renderers[bucket_id];
+    if ((int)bucket_id == m_scene_cache.split_bucket) {
+      scene_cache_at_split();
+    }
+    if (skip_bucket_for_scene_cache(bucket_id)) {
+      m_render_state.next_bucket += 16;
+      vif_interrupt_callback(bucket_id + 1);
+      continue;
+    }
     auto bucket_prof = prof.make_scoped_child(renderer->name_and_id());
     g_current_render = renderer->name_and_id();
     // lg::info("Render: {} start", g_current_render);
-    renderer->render(dma, &m_render_state, bucket_prof);
+    render_bucket(bucket_id, bucket_prof);
     if (sync_after_buckets) {
       auto pp = scoped_prof("finish");
       glFinish();
     }
 
     // lg::info("Render: {} end", g_current_render);
-    //  should have ended at the start of the next chain
-    ASSERT(dma.current_tag_offset() == m_render_state.next_bucket);
     m_render_state.next_bucket += 16;
     vif_interrupt_callback(bucket_id + 1);
     m_category_times[(int)m_bucket_categories[bucket_id]] += bucket_prof.get_elapsed_time();
 
     // hack to draw the collision mesh in the middle the drawing
     if (bucket_id + 1 == (int)jak2::BucketId::TEX_L0_ALPHA &&
-        Gfx::g_global_settings.collision_enable) {
+        Gfx::g_global_settings.collision_enable && !m_scene_cache.hit) {
       auto p = prof.make_scoped_child("collision-draw");
       m_collide_renderer.render(&m_render_state, p);
     }
@@ -1025,63 +1336,75 @@ void OpenGLRenderer::dispatch_buckets(DmaFollower dma,
 }
 
 /*!
- * Take a screenshot!
+ * Take a screenshot! The readback and png encoding finish in a later frame.
  */
-void OpenGLRenderer::finish_screenshot(const std::string& output_name,
-                                       int width,
-                                       int height,
-                                       int x,
-                                       int y,
-                                       GLuint fbo,
-                                       int read_buffer) {
-  std::vector<u32> buffer(width * height);
-  glPixelStorei(GL_PACK_ALIGNMENT, 1);
-  GLint oldbuf;
-  glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &oldbuf);
-  glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
-  glReadBuffer(read_buffer);
-  glReadPixels(x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, buffer.data());
-  // flip upside down in place
-  for (int h = 0; h < height / 2; h++) {
-    for (int w = 0; w < width; w++) {
-      std::swap(buffer[h * width + w], buffer[(height - h - 1) * width + w]);
-    }
-  }
+void OpenGLRenderer::start_screenshot(const std::string& output_name) {
+  Fbo* screenshot_src;
+  int read_buffer;
 
-  // set alpha. For some reason, image viewers do weird stuff with alpha.
-  for (auto& px : buffer) {
-    px |= 0xff000000;
+  // can't screenshot from a multisampled buffer directly -
+  if (m_fbo_state.resources.resolve_buffer.valid) {
+    screenshot_src = &m_fbo_state.resources.resolve_buffer;
+    read_buffer = GL_COLOR_ATTACHMENT0;
+  } else {
+    screenshot_src = m_fbo_state.render_fbo;
+    read_buffer = GL_FRONT;
   }
-  file_util::write_rgba_png(output_name, buffer.data(), width, height);
-  glBindFramebuffer(GL_READ_FRAMEBUFFER, oldbuf);
+  m_screenshots.request(output_name, screenshot_src->width, screenshot_src->height,
+                        screenshot_src->fbo_id, read_buffer);
 }
 
 void OpenGLRenderer::do_pcrtc_effects(float alp,
                                       SharedRenderState* render_state,
                                       ScopedProfilerNode& prof) {
   if (m_fbo_state.render_fbo->is_window) {
-    // nothing to do!
-  } else {
-    Fbo* window_blit_src = nullptr;
-    if (m_fbo_state.resources.resolve_buffer.valid) {
-      glBindFramebuffer(GL_READ_FRAMEBUFFER, m_fbo_state.render_fbo->fbo_id);
-      glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_fbo_state.resources.resolve_buffer.fbo_id);
-      glBlitFramebuffer(0,                                            // srcX0
-                        0,                                            // srcY0
-                        m_fbo_state.render_fbo->width,                // srcX1
-                        m_fbo_state.render_fbo->height,               // srcY1
-                        0,                                            // dstX0
-                        0,                                            // dstY0
-                        m_fbo_state.resources.resolve_buffer.width,   // dstX1
-                        m_fbo_state.resources.resolve_buffer.height,  // dstY1
-                        GL_COLOR_BUFFER_BIT,                          // mask
-                        GL_LINEAR                                     // filter
-      );
-      window_blit_src = &m_fbo_state.resources.resolve_buffer;
-    } else {
-      window_blit_src = &m_fbo_state.resources.render_buffer;
+    // nothing to copy, but the blackout is still blended on top.
+    if (alp < 1) {
+      glDisable(GL_DEPTH_TEST);
+      glEnable(GL_BLEND);
+      glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ZERO);
+      glBlendEquation(GL_FUNC_ADD);
+      glViewport(0, 0, m_fbo_state.resources.window.width, m_fbo_state.resources.window.height);
+
+      m_blackout_renderer.draw(Vector4f(0, 0, 0, 1.f - alp), render_state, prof);
+
+      glEnable(GL_DEPTH_TEST);
     }
+    return;
+  }
+
+  Fbo* window_blit_src = nullptr;
+  if (m_fbo_state.resources.resolve_buffer.valid) {
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, m_fbo_state.render_fbo->fbo_id);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_fbo_state.resources.resolve_buffer.fbo_id);
+    glBlitFramebuffer(0,                                            // srcX0
+                      0,                                            // srcY0
+                      m_fbo_state.render_fbo->width,                // srcX1
+                      m_fbo_state.render_fbo->height,               // srcY1
+                      0,                                            // dstX0
+                      0,                                            // dstY0
+                      m_fbo_state.resources.resolve_buffer.width,   // dstX1
+                      m_fbo_state.resources.resolve_buffer.height,  // dstY1
+                      GL_COLOR_BUFFER_BIT,                          // mask
+                      GL_LINEAR                                     // filter
+    );
+    window_blit_src = &m_fbo_state.resources.resolve_buffer;
+  } else {
+    window_blit_src = &m_fbo_state.resources.render_buffer;
+  }
 
+  if (alp < 1) {
+    // copy to the window and apply the blackout in a single pass, instead of a blit followed by a
+    // blended full screen draw that reads the window again.
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(render_state->draw_offset_x, render_state->draw_offset_y,
+               render_state->draw_region_w, render_state->draw_region_h);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_BLEND);
+    m_blackout_renderer.draw_texture(*window_blit_src->tex_id, alp, render_state, prof);
+    glViewport(0, 0, m_fbo_state.resources.window.width, m_fbo_state.resources.window.height);
+    glEnable(GL_DEPTH_TEST);
+  } else {
     glBindFramebuffer(GL_READ_FRAMEBUFFER, window_blit_src->fbo_id);
     glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
     glBlitFramebuffer(0,                                                          // srcX0
@@ -1095,17 +1418,6 @@ void OpenGLRenderer::do_pcrtc_effects(float alp,
                       GL_COLOR_BUFFER_BIT,                                        // mask
                       GL_LINEAR                                                   // filter
     );
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
-  }
-  if (alp < 1) {
-    glDisable(GL_DEPTH_TEST);
-    glEnable(GL_BLEND);
-    glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ZERO);
-    glBlendEquation(GL_FUNC_ADD);
-    glViewport(0, 0, m_fbo_state.resources.window.width, m_fbo_state.resources.window.height);
-
-    m_blackout_renderer.draw(Vector4f(0, 0, 0, 1.f - alp), render_state, prof);
-
-    glEnable(GL_DEPTH_TEST);
   }
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
@@ -4,11 +4,14 @@
 #include <memory>
 
 #include "common/dma/dma_chain_read.h"
+#include "common/util/SimpleThreadGroup.h"
 
 #include "game/graphics/opengl_renderer/BucketRenderer.h"
 #include "game/graphics/opengl_renderer/CollideMeshRenderer.h"
 #include "game/graphics/opengl_renderer/Profiler.h"
+#include "game/graphics/opengl_renderer/ScreenshotReadback.h"
 #include "game/graphics/opengl_renderer/Shader.h"
+#include "game/graphics/opengl_renderer/background/DepthPyramid.h"
 #include "game/graphics/opengl_renderer/opengl_utils.h"
 #include "game/tools/filter_menu/filter_menu.h"
 #include "game/tools/subtitles/subtitle_editor.h"
@@ -22,6 +25,12 @@ struct RenderOptions {
   bool draw_subtitle_editor_window = false;
   bool draw_subtitle2_editor_window = false;
   bool draw_filters_window = false;
+  // ImGui isn't updated this frame, so the debug windows above aren't drawn, but they haven't
+  // been closed either.
+  bool debug_ui_skipped = false;
+  // the CPU and GPU time of the last ImGui frame, which is drawn outside of the renderer.
+  float debug_ui_cpu_ms = 0;
+  float debug_ui_gpu_ms = 0;
 
   // internal rendering settings - The OpenGLRenderer will internally use this resolution/format.
   int msaa_samples = 2;
@@ -112,24 +121,33 @@ class OpenGLRenderer {
   // the graphics system.
   void render(DmaFollower dma, const RenderOptions& settings);
 
+  // the profile of the last frame.
+  const ProfilerNode& last_frame_profile() { return *m_profiler.root(); }
+
+  // write out screenshots that are still being read back. Must be called before the render
+  // context is deleted.
+  void finish_screenshots() { m_screenshots.shutdown(); }
+
  private:
   void setup_frame(const RenderOptions& settings);
   void dispatch_buckets(DmaFollower dma, ScopedProfilerNode& prof, bool sync_after_buckets);
   void dispatch_buckets_jak1(DmaFollower dma, ScopedProfilerNode& prof, bool sync_after_buckets);
   void dispatch_buckets_jak2(DmaFollower dma, ScopedProfilerNode& prof, bool sync_after_buckets);
+  void index_buckets(const void* dma_base, ScopedProfilerNode& prof);
+  void prepare_buckets(ScopedProfilerNode& prof);
+  void render_bucket(size_t bucket_id, ScopedProfilerNode& prof);
+  void update_scene_cache(int split_bucket, ScopedProfilerNode& prof);
+  bool skip_bucket_for_scene_cache(size_t bucket_id) const;
+  void scene_cache_at_split();
 
   void do_pcrtc_effects(float alp, SharedRenderState* render_state, ScopedProfilerNode& prof);
   void blit_display();
   void init_bucket_renderers_jak1();
   void init_bucket_renderers_jak2();
   void draw_renderer_selection_window();
-  void finish_screenshot(const std::string& output_name,
-                         int px,
-                         int py,
-                         int x,
-                         int y,
-                         GLuint fbo,
-                         int read_buffer);
+  void close_renderer_debug_windows();
+  void update_dynamic_resolution();
+  void start_screenshot(const std::string& output_name);
   template <typename T, typename U, class... Args>
   T* init_bucket_renderer(const std::string& name, BucketCategory cat, U id, Args&&... args) {
     auto renderer = std::make_unique<T>(name, (int)id, std::forward<Args>(args)...);
@@ -152,10 +170,47 @@ class OpenGLRenderer {
   std::array<float, (int)BucketCategory::MAX_CATEGORIES> m_category_times;
   FullScreenDraw m_blackout_renderer;
   CollideMeshRenderer m_collide_renderer;
+  DepthPyramid m_depth_pyramid;
+  ScreenshotReadback m_screenshots;
 
   float m_last_pmode_alp = 1.;
   bool m_enable_fast_blackout_loads = true;
 
+  // every bucket's transfers, read once at the start of the frame.
+  DmaChainIndex m_dma_index;
+
+  // two-phase mode: the CPU work of buckets that support it is done in parallel up front, then the
+  // render thread only submits OpenGL.
+  bool m_parallel_bucket_prepare = false;
+  std::vector<bool> m_bucket_prepared;
+  // the frame is waiting on these, so they go ahead of background work like level loading.
+  SimpleThreadGroup m_prepare_threads{TaskPriority::HIGH};
+
+  // static scene cache: while the DMA of every bucket before split_bucket is the same as the last
+  // frame's, the image those buckets drew is copied back instead of drawing them again. It's saved
+  // on the second frame in a row with the same DMA, so there's no copy while the scene is moving.
+  struct {
+    int split_bucket = -1;
+    bool have_hash = false;
+    u64 last_hash = 0;
+    bool valid = false;  // fbo holds the image for last_hash
+    bool hit = false;    // this frame reuses the image
+    bool save = false;   // this frame saves the image
+    int hit_frames = 0;  // in a row, for the debug window
+    Fbo fbo;
+  } m_scene_cache;
+
+  // dynamic resolution: scales the internal resolution to hold the GPU frame time near the target.
+  // The final blit to the window does the upscale.
+  struct {
+    bool enabled = false;
+    float target_ms = 16.f;
+    float min_scale = 0.5f;
+    float scale = 1.f;  // applied to both width and height
+    float filtered_gpu_ms = 0;
+    int frames_until_update = 0;
+  } m_dynamic_res;
+
   struct FboState {
     struct {
       Fbo window;          // provided by glfw
@@ -5,13 +5,120 @@
 #include "common/log/log.h"
 #include "common/util/colors.h"
 
+#include "game/graphics/pipelines/opengl.h"
+
 #include "third-party/fmt/core.h"
 #include "third-party/imgui/imgui.h"
 
-ProfilerNode::ProfilerNode(const std::string& name) : m_name(name) {}
+GpuTimestamps::~GpuTimestamps() {
+  for (auto& frame : m_frames) {
+    if (!frame.queries.empty()) {
+      glDeleteQueries(frame.queries.size(), frame.queries.data());
+    }
+  }
+}
+
+u32 GpuTimestamps::alloc_query() {
+  auto& frame = m_frames[m_frame_idx];
+  if (frame.next_query == frame.queries.size()) {
+    GLuint query;
+    glGenQueries(1, &query);
+    frame.queries.push_back(query);
+  }
+  return frame.queries[frame.next_query++];
+}
+
+/*!
+ * Start timing the node at the given path. Returns a handle to pass to end().
+ */
+int GpuTimestamps::begin(const std::string& path) {
+  auto& frame = m_frames[m_frame_idx];
+  auto& timer = frame.timers.emplace_back();
+  timer.path = path;
+  timer.start_query = alloc_query();
+  glQueryCounter(timer.start_query, GL_TIMESTAMP);
+  return frame.timers.size() - 1;
+}
+
+void GpuTimestamps::end(int timer) {
+  auto& t = m_frames[m_frame_idx].timers.at(timer);
+  t.end_query = alloc_query();
+  glQueryCounter(t.end_query, GL_TIMESTAMP);
+}
+
+/*!
+ * Start a new frame. The oldest frame's queries are read if the GPU has finished them, otherwise
+ * they are dropped and the previous results are kept.
+ */
+void GpuTimestamps::next_frame() {
+  m_frame_idx = (m_frame_idx + 1) % LATENCY;
+  auto& frame = m_frames[m_frame_idx];
+
+  // queries finish in order, so if the last one is done, they all are.
+  GLuint available = GL_FALSE;
+  if (!frame.timers.empty()) {
+    glGetQueryObjectuiv(frame.queries.at(frame.next_query - 1), GL_QUERY_RESULT_AVAILABLE,
+                        &available);
+  }
+
+  if (available) {
+    m_durations.clear();
+    // to put GPU zones on the event profiler's timeline, move GPU times to the CPU clock.
+    bool gpu_zones = prof().enabled();
+    s64 gpu_to_cpu = 0;
+    if (gpu_zones) {
+      GLint64 gpu_now;
+      glGetInteger64v(GL_TIMESTAMP, &gpu_now);
+      gpu_to_cpu = (s64)GlobalProfiler::timestamp() - gpu_now;
+      if (!m_prof_track) {
+        m_prof_track = prof().add_track(m_track_name);
+      }
+    }
+    for (auto& timer : frame.timers) {
+      if (!timer.end_query) {
+        // never finished, no end time.
+        continue;
+      }
+      GLuint64 start, end;
+      glGetQueryObjectui64v(timer.start_query, GL_QUERY_RESULT, &start);
+      glGetQueryObjectui64v(timer.end_query, GL_QUERY_RESULT, &end);
+      // sum nodes with the same path, like a renderer called several times in one bucket.
+      m_durations[timer.path] += (end - start) * 1e-9f;
+      if (gpu_zones) {
+        auto name = timer.path.substr(timer.path.find_last_of('/') + 1);
+        prof().track_zone(*m_prof_track, name.c_str(), start + gpu_to_cpu, end + gpu_to_cpu);
+      }
+    }
+  }
+
+  frame.timers.clear();
+  frame.next_query = 0;
+}
+
+float GpuTimestamps::get_duration(const std::string& path) const {
+  auto it = m_durations.find(path);
+  if (it == m_durations.end()) {
+    return 0;
+  }
+  return it->second;
+}
+
+ProfilerNode::ProfilerNode(const std::string& name,
+                           GpuTimestamps* gpu,
+                           const std::string& parent_path)
+    : m_name(name), m_path(parent_path + "/" + name), m_gpu(gpu) {
+  if (m_gpu) {
+    m_gpu_timer = m_gpu->begin(m_path);
+    // the root is remade every frame without being finished first, so it's not a group.
+    if (!parent_path.empty() && glPushDebugGroup) {
+      glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0, -1, m_name.c_str());
+      m_debug_group = true;
+    }
+  }
+}
 
 ProfilerNode* ProfilerNode::make_child(const std::string& name) {
-  m_children.emplace_back(name);
+  m_children.emplace_back(name, m_gpu, m_path);
   return &m_children.back();
 }
 
@@ -20,6 +127,12 @@ void ProfilerNode::finish() {
     lg::error("finish() called twice on {}", m_name);
   } else {
     m_stats.duration = m_timer.getSeconds();
+    if (m_gpu) {
+      m_gpu->end(m_gpu_timer);
+    }
+    if (m_debug_group) {
+      glPopDebugGroup();
+    }
     float total_child_time = 0;
     for (const auto& child : m_children) {
       if (!child.finished()) {
@@ -54,6 +167,8 @@ void ProfilerNode::sort(ProfilerSort mode) {
                   return a.m_stats.duration > b.m_stats.duration;
                 case ProfilerSort::TRIANGLES:
                   return a.m_stats.triangles > b.m_stats.triangles;
+                case ProfilerSort::GPU_TIME:
+                  return a.m_stats.gpu_duration > b.m_stats.gpu_duration;
                 default:
                   ASSERT(false);
               }
@@ -67,23 +182,43 @@ ScopedProfilerNode ProfilerNode::make_scoped_child(const std::string& name) {
   return ScopedProfilerNode(make_child(name));
 }
 
-Profiler::Profiler() : m_root("root") {}
+void ProfilerNode::read_gpu_durations(const GpuTimestamps& gpu) {
+  m_stats.gpu_duration = gpu.get_duration(m_path);
+  for (auto& child : m_children) {
+    child.read_gpu_durations(gpu);
+  }
+}
+
+Profiler::Profiler() : m_root("root", &m_gpu) {}
 
 void Profiler::clear() {
-  m_root = ProfilerNode("root");
+  m_gpu.next_frame();
+  m_root = ProfilerNode("root", &m_gpu);
 }
 
 void Profiler::finish() {
   m_root.finish();
+  m_root.read_gpu_durations(m_gpu);
 }
 
 void Profiler::draw() {
-  ImGui::Begin("Profiler");
-  const char* listbox_entries[] = {"None", "Time", "Draw Calls", "Tris"};
-  ImGui::Combo("Sort", &m_mode_selector, listbox_entries, 4);
+  if (!ImGui::Begin("Profiler")) {
+    // collapsed, don't bother sorting.
+    ImGui::End();
+    return;
+  }
+  const char* listbox_entries[] = {"None", "Time", "Draw Calls", "Tris", "GPU Time"};
+  ImGui::Combo("Sort", &m_mode_selector, listbox_entries, 5);
   m_root.sort((ProfilerSort)m_mode_selector);
   ImGui::SameLine();
   bool all = ImGui::Button("Expand All");
+  ImGui::SameLine();
+  if (ImGui::Button("Copy")) {
+    ImGui::SetClipboardText(to_string().c_str());
+  }
+  ImGui::SameLine();
+  ImGui::Text("(GPU times are %d frames old)", m_gpu.latency());
+  ImGui::Text("ImGui, not in root: %.2fms %.2fms gpu", m_debug_ui_cpu_ms, m_debug_ui_gpu_ms);
   ImGui::Dummy(ImVec2(0.0f, 80.0f));
   draw_node(m_root, all, 0, 0.f);
   ImGui::End();
@@ -108,8 +243,9 @@ void Profiler::draw_node(ProfilerNode& node, bool expand, int depth, float start
   bool color_orange = false;
   ImGui::PushStyleColor(ImGuiCol_Text, color);
   auto str =
-      fmt::format("{:20s} {:.2f}ms {:6d} tri {:4d} draw", node.m_name, node.m_stats.duration * 1000,
-                  node.m_stats.triangles, node.m_stats.draw_calls);
+      fmt::format("{:20s} {:.2f}ms {:.2f}ms gpu {:6d} tri {:4d} draw {:4d} skip", node.m_name,
+                  node.m_stats.duration * 1000, node.m_stats.gpu_duration * 1000,
+                  node.m_stats.triangles, node.m_stats.draw_calls, node.m_stats.gl_calls_filtered);
   if (node.m_children.empty()) {
     ImGui::Text("   %s", str.c_str());
     color_orange = ImGui::IsItemHovered();
@@ -149,12 +285,14 @@ std::string Profiler::to_string() {
   m_root.sort(ProfilerSort::TIME);
   std::string str;
   m_root.to_string_helper(str, 0);
+  str += fmt::format("{:.2f} ms {:.2f} ms gpu {:30s}\n", m_debug_ui_cpu_ms, m_debug_ui_gpu_ms,
+                     "imgui (not in root)");
   return str;
 }
 
 void ProfilerNode::to_string_helper(std::string& str, int depth) const {
-  str +=
-      fmt::format("{}{:.2f} ms {:30s}\n", std::string(depth, ' '), m_stats.duration * 1000, m_name);
+  str += fmt::format("{}{:.2f} ms {:.2f} ms gpu {:30s}\n", std::string(depth, ' '),
+                     m_stats.duration * 1000, m_stats.gpu_duration * 1000, m_name);
   for (const auto& child : m_children) {
     child.to_string_helper(str, depth + 1);
   }
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <array>
+#include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "common/common_types.h"
@@ -10,24 +12,74 @@
 
 #include "game/graphics/opengl_renderer/buckets.h"
 
-enum class ProfilerSort { NONE = 0, TIME = 1, DRAW_CALLS = 2, TRIANGLES = 3 };
+enum class ProfilerSort { NONE = 0, TIME = 1, DRAW_CALLS = 2, TRIANGLES = 3, GPU_TIME = 4 };
 
 struct ProfilerStats {
-  float duration = 0;  // seconds
+  float duration = 0;      // seconds
+  float gpu_duration = 0;  // seconds, from a few frames ago. 0 if unknown
   u32 draw_calls = 0;
   u32 triangles = 0;
+  u32 gl_calls_filtered = 0;  // redundant state changes skipped by the GlStateCache
 
   void add_draw_stats(const ProfilerStats& other) {
     draw_calls += other.draw_calls;
     triangles += other.triangles;
+    gl_calls_filtered += other.gl_calls_filtered;
   }
 };
 
+/*!
+ * Asynchronous GPU timing for profiler nodes. A GL_TIMESTAMP query is recorded when a node starts
+ * and when it finishes. The queries are read back LATENCY frames later, so we never wait on the
+ * GPU. Nodes are identified by their path from the root, which is stable across frames.
+ * While the event profiler is recording, the timings are also added to its track_name track.
+ */
+class GpuTimestamps {
+ public:
+  explicit GpuTimestamps(const char* track_name = "GPU") : m_track_name(track_name) {}
+  GpuTimestamps(const GpuTimestamps&) = delete;
+  GpuTimestamps& operator=(const GpuTimestamps&) = delete;
+  ~GpuTimestamps();
+
+  int begin(const std::string& path);
+  void end(int timer);
+  void next_frame();
+  float get_duration(const std::string& path) const;
+  u32 latency() const { return LATENCY; }
+
+ private:
+  static constexpr int LATENCY = 3;
+  struct Timer {
+    std::string path;
+    u32 start_query = 0;
+    u32 end_query = 0;
+  };
+  struct Frame {
+    std::vector<u32> queries;
+    u32 next_query = 0;
+    std::vector<Timer> timers;
+  };
+  u32 alloc_query();
+
+  std::array<Frame, LATENCY> m_frames;
+  u32 m_frame_idx = 0;
+  std::unordered_map<std::string, float> m_durations;
+  const char* m_track_name;
+  std::optional<u32> m_prof_track;  // GPU track in the event profiler
+};
+
 class ScopedProfilerNode;
 
+/*!
+ * A timed section of the frame. Nodes with GPU timing are made on the render thread, and are also
+ * OpenGL debug groups, so graphics debuggers like RenderDoc show the frame organized by bucket and
+ * pass.
+ */
 class ProfilerNode {
  public:
-  ProfilerNode(const std::string& name);
+  ProfilerNode(const std::string& name,
+               GpuTimestamps* gpu = nullptr,
+               const std::string& parent_path = "");
   ProfilerNode* make_child(const std::string& name);
   ScopedProfilerNode make_scoped_child(const std::string& name);
   void sort(ProfilerSort mode);
@@ -35,17 +87,25 @@ class ProfilerNode {
 
   bool finished() const { return m_finished; }
   const std::string& name() const { return m_name; }
+  const std::string& path() const { return m_path; }
+  const std::vector<ProfilerNode>& children() const { return m_children; }
 
   void add_draw_call(int count = 1) { m_stats.draw_calls += count; }
   void add_tri(int count = 1) { m_stats.triangles += count; }
+  void add_gl_calls_filtered(int count) { m_stats.gl_calls_filtered += count; }
   float get_elapsed_time() const { return m_timer.getSeconds(); }
   const ProfilerStats& stats() const { return m_stats; }
 
  private:
   friend class Profiler;
   void to_string_helper(std::string& str, int depth) const;
+  void read_gpu_durations(const GpuTimestamps& gpu);
 
   std::string m_name;
+  std::string m_path;
+  GpuTimestamps* m_gpu = nullptr;
+  int m_gpu_timer = -1;
+  bool m_debug_group = false;
   ProfilerStats m_stats;
   std::vector<ProfilerNode> m_children;
   Timer m_timer;
@@ -66,6 +126,7 @@ class ScopedProfilerNode {
 
   void add_draw_call(int count = 1) { m_node->add_draw_call(count); }
   void add_tri(int count = 1) { m_node->add_tri(count); }
+  void add_gl_calls_filtered(int count) { m_node->add_gl_calls_filtered(count); }
   float get_elapsed_time() const { return m_node->get_elapsed_time(); }
 
  private:
@@ -79,6 +140,11 @@ class Profiler {
   void clear();
   void draw();
   void finish();
+  // ImGui is drawn after the renderer is done, so its time is measured separately.
+  void set_debug_ui_time(float cpu_ms, float gpu_ms) {
+    m_debug_ui_cpu_ms = cpu_ms;
+    m_debug_ui_gpu_ms = gpu_ms;
+  }
 
   float root_time() const { return m_root.m_stats.duration; }
 
@@ -94,6 +160,9 @@ class Profiler {
   };
 
   int m_mode_selector = 0;
+  float m_debug_ui_cpu_ms = 0;
+  float m_debug_ui_gpu_ms = 0;
+  GpuTimestamps m_gpu;
   ProfilerNode m_root;
 };
 
@@ -0,0 +1,72 @@
+#include "RenderDoc.h"
+
+#include "common/common_types.h"
+#include "common/log/log.h"
+
+#ifdef OS_POSIX
+#include <dlfcn.h>
+#else
+#define NOMINMAX
+#include <Windows.h>
+#endif
+
+#ifdef _WIN32
+#define RENDERDOC_CC __cdecl
+#else
+#define RENDERDOC_CC
+#endif
+
+namespace renderdoc {
+namespace {
+
+// from renderdoc_app.h. The API is a struct of function pointers, and newer versions only add to
+// the end, so this only goes up to the ones we use.
+constexpr int API_VERSION_1_1_2 = 10102;
+
+struct Api {
+  // GetAPIVersion through GetCapture
+  void* unused[15];
+  void(RENDERDOC_CC* TriggerCapture)();
+};
+
+using GetApiFn = int(RENDERDOC_CC*)(int version, void** api);
+
+Api* get_api() {
+  static Api* api = []() -> Api* {
+    GetApiFn get_api_fn = nullptr;
+#ifdef OS_POSIX
+    // RTLD_NOLOAD only finds the library if RenderDoc already injected it.
+    if (void* lib = dlopen("librenderdoc.so", RTLD_NOW | RTLD_NOLOAD)) {
+      get_api_fn = (GetApiFn)dlsym(lib, "RENDERDOC_GetAPI");
+    }
+#else
+    if (HMODULE lib = GetModuleHandleA("renderdoc.dll")) {
+      get_api_fn = (GetApiFn)GetProcAddress(lib, "RENDERDOC_GetAPI");
+    }
+#endif
+    Api* result = nullptr;
+    if (get_api_fn && get_api_fn(API_VERSION_1_1_2, (void**)&result) == 1 && result) {
+      lg::info("Running under RenderDoc, frame captures are available.");
+      return result;
+    }
+    return nullptr;
+  }();
+  return api;
+}
+
+}  // namespace
+
+bool available() {
+  return get_api() != nullptr;
+}
+
+void trigger_capture() {
+  if (auto* api = get_api()) {
+    lg::info("Capturing a frame with RenderDoc");
+    api->TriggerCapture();
+  } else {
+    lg::warn("Can't capture a frame: not running under RenderDoc.");
+  }
+}
+
+}  // namespace renderdoc
@@ -0,0 +1,18 @@
+#pragma once
+
+/*!
+ * @file RenderDoc.h
+ * Frame captures through RenderDoc's in-app API. This only works when the game was started from
+ * RenderDoc, because RenderDoc has to hook OpenGL before the context is created, so we never load
+ * RenderDoc ourselves.
+ */
+
+namespace renderdoc {
+
+// true if the game is running under RenderDoc.
+bool available();
+
+// capture the next frame. Does nothing if RenderDoc isn't available.
+void trigger_capture();
+
+}  // namespace renderdoc
@@ -0,0 +1,163 @@
+#include "ScreenshotReadback.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/log/log.h"
+#include "common/util/Assert.h"
+#include "common/util/FileUtil.h"
+
+ScreenshotReadback::ScreenshotReadback() {
+  m_encoder_thread = std::thread(&ScreenshotReadback::encoder_thread, this);
+}
+
+ScreenshotReadback::~ScreenshotReadback() {
+  if (!m_shut_down) {
+    // the render context may already be gone, so the GPU side can't be touched here.
+    if (!m_pending.empty()) {
+      lg::warn("Dropping {} screenshots that were never finished", m_pending.size());
+    }
+    stop_encoder_thread();
+  }
+}
+
+void ScreenshotReadback::shutdown() {
+  if (m_shut_down) {
+    return;
+  }
+  m_shut_down = true;
+  // don't lose screenshots taken right before exiting.
+  while (!m_pending.empty()) {
+    finish_readback(m_pending.front());
+    m_pending.pop_front();
+  }
+  stop_encoder_thread();
+  glDeleteBuffers(m_free_pbos.size(), m_free_pbos.data());
+  m_free_pbos.clear();
+}
+
+/*!
+ * Stop the encoder thread once it has written everything in its queue.
+ */
+void ScreenshotReadback::stop_encoder_thread() {
+  {
+    std::lock_guard<std::mutex> lk(m_encode_mutex);
+    m_want_shutdown = true;
+    m_encode_cv.notify_all();
+  }
+  m_encoder_thread.join();
+}
+
+void ScreenshotReadback::request(const std::string& output_name,
+                                 int width,
+                                 int height,
+                                 GLuint fbo,
+                                 int read_buffer) {
+  ASSERT(!m_shut_down);
+  // if too many are in flight, wait on the oldest one.
+  if ((int)m_pending.size() >= MAX_PENDING_READBACKS) {
+    finish_readback(m_pending.front());
+    m_pending.pop_front();
+  }
+
+  auto& readback = m_pending.emplace_back();
+  if (m_free_pbos.empty()) {
+    glGenBuffers(1, &readback.pbo);
+  } else {
+    readback.pbo = m_free_pbos.back();
+    m_free_pbos.pop_back();
+  }
+  readback.width = width;
+  readback.height = height;
+  readback.output_name = output_name;
+
+  GLint oldbuf;
+  glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &oldbuf);
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+  glReadBuffer(read_buffer);
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pbo);
+  glBufferData(GL_PIXEL_PACK_BUFFER, width * height * sizeof(u32), nullptr, GL_STREAM_READ);
+  // with a pack buffer bound, this only queues the copy.
+  glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, oldbuf);
+  readback.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+void ScreenshotReadback::update() {
+  while (!m_pending.empty()) {
+    auto& readback = m_pending.front();
+    GLenum status = glClientWaitSync(readback.fence, 0, 0);
+    if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+      break;
+    }
+    finish_readback(readback);
+    m_pending.pop_front();
+  }
+}
+
+int ScreenshotReadback::pending_count() const {
+  std::lock_guard<std::mutex> lk(m_encode_mutex);
+  return m_pending.size() + m_encode_queue.size();
+}
+
+/*!
+ * Copy a readback out of its PBO and queue it for encoding. Waits for the GPU if needed.
+ */
+void ScreenshotReadback::finish_readback(Readback& readback) {
+  glClientWaitSync(readback.fence, GL_SYNC_FLUSH_COMMANDS_BIT, UINT64_MAX);
+  glDeleteSync(readback.fence);
+
+  EncodeJob job;
+  job.width = readback.width;
+  job.height = readback.height;
+  job.output_name = std::move(readback.output_name);
+  job.pixels.resize(job.width * job.height);
+
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pbo);
+  const void* data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, job.pixels.size() * sizeof(u32),
+                                      GL_MAP_READ_BIT);
+  if (data) {
+    memcpy(job.pixels.data(), data, job.pixels.size() * sizeof(u32));
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+  } else {
+    lg::error("Failed to map screenshot buffer for {}", job.output_name);
+  }
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  m_free_pbos.push_back(readback.pbo);
+
+  if (data) {
+    std::lock_guard<std::mutex> lk(m_encode_mutex);
+    m_encode_queue.push_back(std::move(job));
+    m_encode_cv.notify_all();
+  }
+}
+
+void ScreenshotReadback::encoder_thread() {
+  while (true) {
+    EncodeJob job;
+    {
+      std::unique_lock<std::mutex> lk(m_encode_mutex);
+      m_encode_cv.wait(lk, [&] { return m_want_shutdown || !m_encode_queue.empty(); });
+      if (m_encode_queue.empty()) {
+        return;  // only exit once everything is written.
+      }
+      job = std::move(m_encode_queue.front());
+      m_encode_queue.pop_front();
+    }
+
+    // flip upside down in place
+    for (int h = 0; h < job.height / 2; h++) {
+      std::swap_ranges(job.pixels.begin() + h * job.width,
+                       job.pixels.begin() + (h + 1) * job.width,
+                       job.pixels.begin() + (job.height - h - 1) * job.width);
+    }
+
+    // set alpha. For some reason, image viewers do weird stuff with alpha.
+    for (auto& px : job.pixels) {
+      px |= 0xff000000;
+    }
+    file_util::write_rgba_png(job.output_name, job.pixels.data(), job.width, job.height);
+  }
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+/*!
+ * @file ScreenshotReadback.h
+ * Asynchronous screenshots. The framebuffer is read into a pixel buffer object, then mapped a few
+ * frames later once its fence has passed, so the render thread never waits for the GPU. PNG
+ * encoding happens on a worker thread.
+ */
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/common_types.h"
+
+#include "game/graphics/pipelines/opengl.h"
+
+class ScreenshotReadback {
+ public:
+  // enough for a few frames of latency, plus a few frames of sequence capture in flight.
+  static constexpr int MAX_PENDING_READBACKS = 6;
+
+  ScreenshotReadback();
+  ~ScreenshotReadback();
+  ScreenshotReadback(const ScreenshotReadback&) = delete;
+  ScreenshotReadback& operator=(const ScreenshotReadback&) = delete;
+
+  /*!
+   * Start reading a region of the framebuffer. The png is written to output_name later.
+   */
+  void request(const std::string& output_name,
+               int width,
+               int height,
+               GLuint fbo,
+               int read_buffer);
+
+  /*!
+   * Pass finished readbacks to the encoder. Call once per frame.
+   */
+  void update();
+
+  int pending_count() const;
+
+  /*!
+   * Finish all pending readbacks, wait for them to be written, and free the buffers. Must be
+   * called while the render context is still current. Nothing can be requested after this.
+   */
+  void shutdown();
+
+ private:
+  struct Readback {
+    GLuint pbo = 0;
+    GLsync fence = nullptr;
+    int width = 0;
+    int height = 0;
+    std::string output_name;
+  };
+
+  struct EncodeJob {
+    std::vector<u32> pixels;
+    int width = 0;
+    int height = 0;
+    std::string output_name;
+  };
+
+  void finish_readback(Readback& readback);
+  void encoder_thread();
+  void stop_encoder_thread();
+
+  // used only by the render thread
+  std::deque<Readback> m_pending;
+  std::vector<GLuint> m_free_pbos;
+
+  // used by render and encoder thread
+  std::thread m_encoder_thread;
+  mutable std::mutex m_encode_mutex;
+  std::condition_variable m_encode_cv;
+  std::deque<EncodeJob> m_encode_queue;
+  bool m_want_shutdown = false;
+
+  bool m_shut_down = false;  // render thread only
+};
@@ -3,10 +3,143 @@
 #include "common/log/log.h"
 #include "common/util/Assert.h"
 #include "common/util/FileUtil.h"
+#include "common/util/crc32.h"
 
+#include "game/graphics/opengl_renderer/opengl_utils.h"
 #include "game/graphics/pipelines/opengl.h"
 
+namespace {
+/*!
+ * Linked programs are cached with glGetProgramBinary, so we can skip compiling on the next launch.
+ * The binaries are only valid for the exact driver that made them, so the cache key includes the
+ * driver vendor/renderer/version, as well as the shader source. If anything doesn't match, or the
+ * driver rejects the binary, we just compile from source and overwrite the cache.
+ */
+struct ProgramCacheHeader {
+  u32 magic = MAGIC;
+  u32 binary_format = 0;
+  u64 key = 0;
+  u32 binary_size = 0;
+  u32 pad = 0;
+  static constexpr u32 MAGIC = 0x48535047;  // GPSH
+};
+
+u64 program_cache_key(const std::string& vert_src, const std::string& frag_src) {
+  std::string driver;
+  for (auto name : {GL_VENDOR, GL_RENDERER, GL_VERSION}) {
+    auto str = (const char*)glGetString(name);
+    driver += str ? str : "";
+    driver += '\n';
+  }
+  std::string src = vert_src + '\n' + frag_src;
+  return ((u64)crc32((const u8*)driver.data(), driver.size()) << 32) |
+         crc32((const u8*)src.data(), src.size());
+}
+
+fs::path program_cache_path(const std::string& shader_name, GameVersion version) {
+  return file_util::get_user_misc_dir(version) / "shader_cache" / (shader_name + ".bin");
+}
+
+bool program_binaries_supported() {
+  GLint num_formats = 0;
+  glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &num_formats);
+  return num_formats > 0;
+}
+
+/*!
+ * Try to load a program from the cache. Returns the program, or 0 if it wasn't usable.
+ */
+u64 load_cached_program(const fs::path& path, u64 key) {
+  if (!fs::exists(path)) {
+    return 0;
+  }
+
+  std::vector<u8> data;
+  try {
+    data = file_util::read_binary_file(path);
+  } catch (std::exception& e) {
+    lg::warn("Failed to read shader cache {}: {}", path.string(), e.what());
+    return 0;
+  }
+
+  ProgramCacheHeader header;
+  if (data.size() < sizeof(header)) {
+    return 0;
+  }
+  memcpy(&header, data.data(), sizeof(header));
+  if (header.magic != ProgramCacheHeader::MAGIC || header.key != key ||
+      header.binary_size != data.size() - sizeof(header)) {
+    return 0;
+  }
+
+  auto program = glCreateProgram();
+  glProgramBinary(program, header.binary_format, data.data() + sizeof(header), header.binary_size);
+  GLint link_ok = 0;
+  glGetProgramiv(program, GL_LINK_STATUS, &link_ok);
+  if (!link_ok) {
+    glDeleteProgram(program);
+    return 0;
+  }
+  return program;
+}
+
+void save_cached_program(const fs::path& path, u64 key, u64 program) {
+  GLint binary_size = 0;
+  glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binary_size);
+  if (binary_size <= 0) {
+    return;
+  }
+
+  ProgramCacheHeader header;
+  header.key = key;
+  std::vector<u8> data(sizeof(header) + binary_size);
+  GLsizei actual_size = 0;
+  GLenum format = 0;
+  glGetProgramBinary(program, binary_size, &actual_size, &format, data.data() + sizeof(header));
+  header.binary_format = format;
+  header.binary_size = actual_size;
+  memcpy(data.data(), &header, sizeof(header));
+  data.resize(sizeof(header) + actual_size);
+
+  try {
+    file_util::create_dir_if_needed_for_file(path);
+    file_util::write_binary_file(path, data.data(), data.size());
+  } catch (std::exception& e) {
+    lg::warn("Failed to write shader cache {}: {}", path.string(), e.what());
+  }
+}
+
+/*!
+ * Compile a single shader stage. Returns 0 on failure.
+ */
+u64 compile_stage(GLenum kind, const std::string& src, const std::string& shader_name) {
+  auto shader = glCreateShader(kind);
+  const char* src_ptr = src.c_str();
+  glShaderSource(shader, 1, &src_ptr, nullptr);
+  glCompileShader(shader);
+
+  constexpr int len = 1024;
+  int compile_ok;
+  char err[len];
+  glGetShaderiv(shader, GL_COMPILE_STATUS, &compile_ok);
+  if (!compile_ok) {
+    glGetShaderInfoLog(shader, len, nullptr, err);
+    lg::error("Failed to compile shader {}:\n{}", shader_name.c_str(), err);
+    glDeleteShader(shader);
+    return 0;
+  }
+  return shader;
+}
+}  // namespace
+
 Shader::Shader(const std::string& shader_name, GameVersion version) : m_name(shader_name) {
+  // compute shaders have a single .comp file instead of .vert/.frag
+  const auto comp_path = file_util::get_file_path({shader_folder, shader_name + ".comp"});
+  if (fs::exists(comp_path)) {
+    init_compute(file_util::read_text_file(comp_path), version);
+    return;
+  }
+
   const std::string height_scale = version == GameVersion::Jak1 ? "1.0" : "0.5";
   const std::string scissor_height = version == GameVersion::Jak1 ? "448.0" : "416.0";
   const std::string scissor_adjust = "512.0 / " + scissor_height;
@@ -21,6 +154,19 @@ Shader::Shader(const std::string& shader_name, GameVersion version) : m_name(sha
   frag_src = std::regex_replace(frag_src, std::regex("SCISSOR_HEIGHT"), scissor_height);
   vert_src = std::regex_replace(vert_src, std::regex("SCISSOR_ADJUST"), "(" + scissor_adjust + ")");
 
+  // try the program binary cache first
+  const bool use_cache = program_binaries_supported();
+  const auto cache_path = program_cache_path(shader_name, version);
+  u64 cache_key = 0;
+  if (use_cache) {
+    cache_key = program_cache_key(vert_src, frag_src);
+    m_program = load_cached_program(cache_path, cache_key);
+    if (m_program) {
+      m_is_okay = true;
+      return;
+    }
+  }
+
   m_vert_shader = glCreateShader(GL_VERTEX_SHADER);
   const char* src = vert_src.c_str();
   glShaderSource(m_vert_shader, 1, &src, nullptr);
@@ -54,6 +200,9 @@ Shader::Shader(const std::string& shader_name, GameVersion version) : m_name(sha
   m_program = glCreateProgram();
   glAttachShader(m_program, m_vert_shader);
   glAttachShader(m_program, m_frag_shader);
+  if (use_cache) {
+    glProgramParameteri(m_program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+  }
   glLinkProgram(m_program);
 
   glGetProgramiv(m_program, GL_LINK_STATUS, &compile_ok);
@@ -66,15 +215,66 @@ Shader::Shader(const std::string& shader_name, GameVersion version) : m_name(sha
 
   glDeleteShader(m_vert_shader);
   glDeleteShader(m_frag_shader);
+  if (use_cache) {
+    save_cached_program(cache_path, cache_key, m_program);
+  }
+  m_is_okay = true;
+}
+
+void Shader::init_compute(const std::string& comp_src, GameVersion version) {
+  const bool use_cache = program_binaries_supported();
+  const auto cache_path = program_cache_path(m_name, version);
+  u64 cache_key = 0;
+  if (use_cache) {
+    cache_key = program_cache_key(comp_src, "");
+    m_program = load_cached_program(cache_path, cache_key);
+    if (m_program) {
+      m_is_okay = true;
+      return;
+    }
+  }
+
+  auto comp_shader = compile_stage(GL_COMPUTE_SHADER, comp_src, m_name);
+  if (!comp_shader) {
+    m_is_okay = false;
+    return;
+  }
+
+  m_program = glCreateProgram();
+  glAttachShader(m_program, comp_shader);
+  if (use_cache) {
+    glProgramParameteri(m_program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+  }
+  glLinkProgram(m_program);
+  glDeleteShader(comp_shader);
+
+  int link_ok;
+  glGetProgramiv(m_program, GL_LINK_STATUS, &link_ok);
+  if (!link_ok) {
+    constexpr int len = 1024;
+    char err[len];
+    glGetProgramInfoLog(m_program, len, nullptr, err);
+    lg::error("Failed to link shader {}:\n{}", m_name.c_str(), err);
+    m_is_okay = false;
+    return;
+  }
+
+  if (use_cache) {
+    save_cached_program(cache_path, cache_key, m_program);
+  }
   m_is_okay = true;
 }
 
 void Shader::activate() const {
   ASSERT(m_is_okay);
-  glUseProgram(m_program);
+  if (m_state) {
+    m_state->use_program(m_program);
+  } else {
+    glUseProgram(m_program);
+  }
 }
 
-ShaderLibrary::ShaderLibrary(GameVersion version) {
+ShaderLibrary::ShaderLibrary(GameVersion version, GlStateCache* state) {
   at(ShaderId::SOLID_COLOR) = {"solid_color", version};
   at(ShaderId::DIRECT_BASIC) = {"direct_basic", version};
   at(ShaderId::DIRECT_BASIC_TEXTURED) = {"direct_basic_textured", version};
@@ -109,8 +309,14 @@ ShaderLibrary::ShaderLibrary(GameVersion version) {
   at(ShaderId::ETIE_BASE) = {"etie_base", version};
   at(ShaderId::ETIE) = {"etie", version};
   at(ShaderId::SHADOW2) = {"shadow2", version};
+  at(ShaderId::BACKGROUND_CULL) = {"background_cull", version};
+  at(ShaderId::TIE_WIND) = {"tie_wind", version};
+  at(ShaderId::OCEAN_MIPMAP) = {"ocean_mipmap", version};
+  at(ShaderId::DEPTH_PYRAMID) = {"depth_pyramid", version};
 
   for (auto& shader : m_shaders) {
     ASSERT_MSG(shader.okay(), "error compiling shader");
+    shader.set_state_cache(state);
+    gl_label(GL_PROGRAM, shader.id(), shader.name());
   }
 }
@@ -5,6 +5,8 @@
 #include "common/common_types.h"
 #include "common/versions/versions.h"
 
+class GlStateCache;
+
 class Shader {
  public:
   static constexpr char shader_folder[] = "game/graphics/opengl_renderer/shaders/";
@@ -13,13 +15,18 @@ class Shader {
   void activate() const;
   bool okay() const { return m_is_okay; }
   u64 id() const { return m_program; }
+  const std::string& name() const { return m_name; }
+  void set_state_cache(GlStateCache* state) { m_state = state; }
 
  private:
+  void init_compute(const std::string& comp_src, GameVersion version);
+
   std::string m_name;
   u64 m_frag_shader = 0;
   u64 m_vert_shader = 0;
   u64 m_program = 0;
   bool m_is_okay = false;
+  GlStateCache* m_state = nullptr;
 };
 
 // note: update the constructor in Shader.cpp
@@ -58,12 +65,16 @@ enum class ShaderId {
   ETIE = 31,
   SHADOW2 = 32,
   DIRECT_BASIC_TEXTURED_MULTI_UNIT = 33,
+  BACKGROUND_CULL = 34,
+  TIE_WIND = 35,
+  OCEAN_MIPMAP = 36,
+  DEPTH_PYRAMID = 37,
   MAX_SHADERS
 };
 
 class ShaderLibrary {
  public:
-  ShaderLibrary(GameVersion version);
+  ShaderLibrary(GameVersion version, GlStateCache* state = nullptr);
   Shader& operator[](ShaderId id) { return m_shaders[(int)id]; }
   Shader& at(ShaderId id) { return m_shaders[(int)id]; }
 
@@ -2,6 +2,8 @@
 
 #include <cfloat>
 
+#include "common/dma/vif_unpack.h"
+
 #include "third-party/imgui/imgui.h"
 
 ShadowRenderer::ShadowRenderer(const std::string& name, int my_id) : BucketRenderer(name, my_id) {
@@ -281,13 +283,7 @@ void ShadowRenderer::render(DmaFollower& dma,
       u16 addr = up.addr_qw;
       ASSERT(addr + v1.num <= 1024);
 
-      u32 temp[4];
-      for (u32 i = 0; i < v1.num; i++) {
-        for (u32 j = 0; j < 4; j++) {
-          temp[j] = next.data[4 * i + j];
-        }
-        memcpy(m_vu_data + addr + i, temp, 16);
-      }
+      vif_unpack(m_vu_data + addr, next.data, v1.kind, v1.num, up.is_unsigned);
 
       u32 offset = 4 * v1.num;
       ASSERT(offset + 16 == next.size_bytes);
@@ -95,6 +95,9 @@ SkyBlendStats SkyBlendCPU::do_sky_blends(DmaFollower& dma,
                                          SharedRenderState* render_state,
                                          ScopedProfilerNode& /*prof*/) {
   SkyBlendStats stats;
+  for (auto& ops : m_ops) {
+    ops.clear();
+  }
 
   while (dma.current_tag().qwc == 6) {
     // assuming that the vif and gif-tag is correct
@@ -155,12 +158,9 @@ SkyBlendStats SkyBlendCPU::do_sky_blends(DmaFollower& dma,
     if (tex->get_data_ptr()) {
       if (m_texture_data[buffer_idx].size() == tex->data_size()) {
         if (is_first_draw) {
-          blend_sky_initial_fast(intensity, m_texture_data[buffer_idx].data(), tex->get_data_ptr(),
-                                 m_texture_data[buffer_idx].size());
-        } else {
-          blend_sky_fast(intensity, m_texture_data[buffer_idx].data(), tex->get_data_ptr(),
-                         m_texture_data[buffer_idx].size());
+          m_ops[buffer_idx].clear();
         }
+        m_ops[buffer_idx].push_back({tex->get_data_ptr(), intensity, is_first_draw});
       }
 
       if (buffer_idx == 0) {
@@ -176,15 +176,30 @@ SkyBlendStats SkyBlendCPU::do_sky_blends(DmaFollower& dma,
           stats.cloud_blends++;
         }
       }
-      glBindTexture(GL_TEXTURE_2D, m_textures[buffer_idx].gl);
-      glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_sizes[buffer_idx], m_sizes[buffer_idx], 0, GL_RGBA,
-                   GL_UNSIGNED_INT_8_8_8_8_REV, m_texture_data[buffer_idx].data());
-
       render_state->texture_pool->move_existing_to_vram(m_textures[buffer_idx].tex,
                                                         m_textures[buffer_idx].tbp);
     }
   }
 
+  for (int i = 0; i < 2; i++) {
+    // without an initial draw, the blends add to last frame's result, so it will change.
+    if (m_ops[i].empty() || (m_ops[i][0].first && m_ops[i] == m_last_ops[i])) {
+      continue;
+    }
+    auto& data = m_texture_data[i];
+    for (auto& op : m_ops[i]) {
+      if (op.first) {
+        blend_sky_initial_fast(op.intensity, data.data(), op.src, data.size());
+      } else {
+        blend_sky_fast(op.intensity, data.data(), op.src, data.size());
+      }
+    }
+    glBindTexture(GL_TEXTURE_2D, m_textures[i].gl);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, m_sizes[i], m_sizes[i], GL_RGBA,
+                    GL_UNSIGNED_INT_8_8_8_8_REV, data.data());
+    std::swap(m_ops[i], m_last_ops[i]);
+  }
+
   return stats;
 }
 
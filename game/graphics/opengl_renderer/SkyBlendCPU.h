@@ -20,6 +20,19 @@ class SkyBlendCPU {
   static constexpr int m_sizes[2] = {32, 64};
   std::vector<u8> m_texture_data[2];
 
+  // a single draw into one of the textures. The sky blend only changes a few times per second,
+  // so if a texture gets the same draws as last frame, we can skip blending and uploading it.
+  struct BlendOp {
+    const u8* src = nullptr;
+    u32 intensity = 0;
+    bool first = false;  // overwrites instead of adding
+    bool operator==(const BlendOp& other) const {
+      return src == other.src && intensity == other.intensity && first == other.first;
+    }
+  };
+  std::vector<BlendOp> m_ops[2];
+  std::vector<BlendOp> m_last_ops[2];
+
   struct TexInfo {
     GLuint gl;
     u32 tbp;
@@ -24,7 +24,8 @@ SkyBlendGPU::SkyBlendGPU() {
     GLenum draw_buffers[1] = {GL_COLOR_ATTACHMENT0};
     glDrawBuffers(1, draw_buffers);
     if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
-      lg::error("SkyTextureHandler setup failed.");
+      lg::error("SkyTextureHandler setup failed, falling back to CPU sky blending.");
+      m_supported = false;
     }
   }
   glBindFramebuffer(GL_FRAMEBUFFER, 0);
@@ -13,8 +13,11 @@ class SkyBlendGPU {
   SkyBlendStats do_sky_blends(DmaFollower& dma,
                               SharedRenderState* render_state,
                               ScopedProfilerNode& prof);
+  // false if the driver couldn't make the render-to-texture framebuffers. Use SkyBlendCPU.
+  bool is_supported() const { return m_supported; }
 
  private:
+  bool m_supported = true;
   GLuint m_framebuffers[2];  // sky, clouds
   GLuint m_textures[2];      // sky, clouds
   int m_sizes[2] = {32, 64};
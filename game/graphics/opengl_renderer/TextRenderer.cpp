@@ -0,0 +1,111 @@
+#include "TextRenderer.h"
+
+#include "common/util/crc32.h"
+
+#include "third-party/imgui/imgui.h"
+
+TextRenderer::TextRenderer(const std::string& name, int my_id, int batch_size)
+    : DirectRenderer(name, my_id, batch_size) {
+  m_texture_state_count = MAX_TEXTURE_STATES;
+}
+
+void TextRenderer::render(DmaFollower& dma,
+                          SharedRenderState* render_state,
+                          ScopedProfilerNode& prof) {
+  if (!m_enabled || !m_cache.enable) {
+    m_cache.valid = false;
+    DirectRenderer::render(dma, render_state, prof);
+    return;
+  }
+
+  u32 hash = hash_bucket(dma, render_state->next_bucket);
+  if (m_cache.valid && hash == m_cache.hash) {
+    m_cache.hits++;
+    while (dma.current_tag_offset() != render_state->next_bucket) {
+      dma.read_and_advance();
+    }
+    replay(render_state, prof);
+    return;
+  }
+
+  m_cache.misses++;
+  m_cache.hash = hash;
+  m_cache.batches.clear();
+  m_cache.vertices.clear();
+  m_cache.recording = true;
+  DirectRenderer::render(dma, render_state, prof);
+  m_cache.recording = false;
+  m_cache.scissor_after = m_scissor;
+  m_cache.valid = true;
+}
+
+/*!
+ * Hash everything the bucket renders from, to find out if it's the same as last frame.
+ */
+u32 TextRenderer::hash_bucket(DmaFollower dma, u32 next_bucket) const {
+  u32 hash = 0;
+  while (dma.current_tag_offset() != next_bucket) {
+    auto data = dma.read_and_advance();
+    u32 header[3] = {data.vif0(), data.vif1(), data.size_bytes};
+    hash = crc32((const u8*)header, sizeof(header)) ^ (hash * 31);
+    if (data.size_bytes) {
+      hash = crc32(data.data, data.size_bytes) ^ (hash * 31);
+    }
+  }
+  return hash;
+}
+
+void TextRenderer::on_flush() {
+  if (!m_cache.recording) {
+    return;
+  }
+  auto& batch = m_cache.batches.emplace_back();
+  batch.test_state = m_test_state;
+  batch.blend_state = m_blend_state;
+  batch.prim_gl_state = m_prim_gl_state;
+  for (int i = 0; i < MAX_TEXTURE_STATES; i++) {
+    batch.textures[i] = m_buffered_tex_state[i];
+  }
+  batch.scissor_enable = m_scissor_enable;
+  batch.first_vertex = m_cache.vertices.size();
+  batch.vertex_count = m_prim_buffer.vert_count;
+  m_cache.vertices.insert(m_cache.vertices.end(), m_prim_buffer.vertices.begin(),
+                          m_prim_buffer.vertices.begin() + m_prim_buffer.vert_count);
+}
+
+/*!
+ * Draw the batches recorded the last time the DMA data changed. The GL state is set up from scratch
+ * for each batch, since other renderers ran in between.
+ */
+void TextRenderer::replay(SharedRenderState* render_state, ScopedProfilerNode& prof) {
+  pre_render();
+  reset_state();
+  setup_common_state(render_state);
+  for (const auto& batch : m_cache.batches) {
+    m_test_state = batch.test_state;
+    m_blend_state = batch.blend_state;
+    m_prim_gl_state = batch.prim_gl_state;
+    for (int i = 0; i < MAX_TEXTURE_STATES; i++) {
+      m_buffered_tex_state[i] = batch.textures[i];
+    }
+    m_scissor_enable = batch.scissor_enable;
+    m_test_state_needs_gl_update = true;
+    m_blend_state_needs_gl_update = true;
+    m_prim_gl_state_needs_gl_update = true;
+    std::copy(m_cache.vertices.begin() + batch.first_vertex,
+              m_cache.vertices.begin() + batch.first_vertex + batch.vertex_count,
+              m_prim_buffer.vertices.begin());
+    m_prim_buffer.vert_count = batch.vertex_count;
+    flush_pending(render_state, prof);
+  }
+  m_scissor = m_cache.scissor_after;
+  post_render();
+  glColorMaski(0, GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+}
+
+void TextRenderer::draw_debug_window() {
+  ImGui::Checkbox("Reuse unchanged frames", &m_cache.enable);
+  ImGui::Text("Reused %d, rebuilt %d, %d batches", m_cache.hits, m_cache.misses,
+              (int)m_cache.batches.size());
+  DirectRenderer::draw_debug_window();
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <vector>
+
+#include "game/graphics/opengl_renderer/DirectRenderer.h"
+
+/*!
+ * Renderer for buckets that are mostly font text: the HUD, menus and subtitles.
+ * The game draws each glyph as a textured sprite, switching between font texture pages as it goes,
+ * so glyphs from up to MAX_TEXTURE_STATES textures are batched together.
+ * Text is often the same for many frames in a row. If the bucket's DMA data is the same as last
+ * frame, the batches recorded last frame are drawn again without processing the DMA.
+ */
+class TextRenderer : public DirectRenderer {
+ public:
+  TextRenderer(const std::string& name, int my_id, int batch_size);
+  void render(DmaFollower& dma, SharedRenderState* render_state, ScopedProfilerNode& prof) override;
+  void draw_debug_window() override;
+
+ protected:
+  void on_flush() override;
+
+ private:
+  u32 hash_bucket(DmaFollower dma, u32 next_bucket) const;
+  void replay(SharedRenderState* render_state, ScopedProfilerNode& prof);
+
+  struct Batch {
+    TestState test_state;
+    BlendState blend_state;
+    PrimGlState prim_gl_state;
+    TextureState textures[MAX_TEXTURE_STATES];
+    bool scissor_enable = false;
+    u32 first_vertex = 0;
+    u32 vertex_count = 0;
+  };
+
+  struct {
+    bool enable = true;
+    bool valid = false;
+    bool recording = false;
+    u32 hash = 0;
+    std::vector<Batch> batches;
+    std::vector<Vertex> vertices;
+    // the scissor is shared with later buckets, so it's left the way the DMA left it.
+    ScissorState scissor_after;
+    u32 hits = 0;
+    u32 misses = 0;
+  } m_cache;
+};
@@ -58,7 +58,8 @@ void TextureUploadHandler::render(DmaFollower& dma,
 
 void TextureUploadHandler::flush_uploads(std::vector<TextureUpload>& uploads,
                                          SharedRenderState* render_state) {
-  if (m_fake_uploads) {
+  if (m_fake_uploads || !render_state->ee_main_memory) {
+    // no game memory when replaying a frame capture, the textures come from the fr3 files.
     uploads.clear();
   } else {
     m_upload_count += uploads.size();
@@ -13,6 +13,7 @@ class TextureUploadHandler : public BucketRenderer {
   TextureUploadHandler(const std::string& name, int my_id);
   void render(DmaFollower& dma, SharedRenderState* render_state, ScopedProfilerNode& prof) override;
   void draw_debug_window() override;
+  bool needed_for_later_buckets() const override { return true; }
 
  private:
   struct TextureUpload {
@@ -58,8 +58,7 @@ void VisDataHandler::render(DmaFollower& dma,
       break;
     }
     if (vis_data.size_bytes == 128 * 16 && render_state->use_occlusion_culling) {
-      memcpy(render_state->occlusion_vis[i].data, vis_data.data, 128 * 16);
-      render_state->occlusion_vis[i].valid = true;
+      render_state->occlusion_vis[i].update(vis_data.data);
       m_stats[i].has_vis = true;
       if (m_count_vis) {
         m_stats[i].num_visible = bitcount(render_state->occlusion_vis[i].data);
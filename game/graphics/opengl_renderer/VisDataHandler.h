@@ -11,6 +11,7 @@ class VisDataHandler : public BucketRenderer {
   VisDataHandler(const std::string& name, int my_id);
   void render(DmaFollower& dma, SharedRenderState* render_state, ScopedProfilerNode& prof) override;
   void draw_debug_window() override;
+  bool needed_for_later_buckets() const override { return true; }
 
  private:
   struct LevelStats {
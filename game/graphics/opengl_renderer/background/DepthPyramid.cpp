@@ -0,0 +1,118 @@
+#include "DepthPyramid.h"
+
+#include <algorithm>
+
+namespace {
+int round_up_to_power_of_two(int x) {
+  int result = 1;
+  while (result < x) {
+    result *= 2;
+  }
+  return result;
+}
+}  // namespace
+
+DepthPyramid::~DepthPyramid() {
+  destroy();
+}
+
+void DepthPyramid::destroy() {
+  if (m_depth_fbo) {
+    glDeleteFramebuffers(1, &m_depth_fbo);
+    glDeleteTextures(1, &m_depth_texture);
+    glDeleteTextures(1, &m_pyramid_texture);
+  }
+  m_depth_fbo = m_depth_texture = m_pyramid_texture = 0;
+  m_screen_w = m_screen_h = 0;
+}
+
+/*!
+ * Make the depth copy and pyramid textures for a depth buffer of this size. The copy has the same
+ * format as the render buffer's depth, so it can be blitted.
+ */
+void DepthPyramid::resize(int w, int h) {
+  destroy();
+  m_screen_w = w;
+  m_screen_h = h;
+
+  glGenTextures(1, &m_depth_texture);
+  glBindTexture(GL_TEXTURE_2D, m_depth_texture);
+  glTexStorage2D(GL_TEXTURE_2D, 1, GL_DEPTH24_STENCIL8, w, h);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D, GL_DEPTH_STENCIL_TEXTURE_MODE, GL_DEPTH_COMPONENT);
+
+  glGenFramebuffers(1, &m_depth_fbo);
+  glBindFramebuffer(GL_FRAMEBUFFER, m_depth_fbo);
+  glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D,
+                         m_depth_texture, 0);
+  glDrawBuffer(GL_NONE);
+  glReadBuffer(GL_NONE);
+
+  m_w = round_up_to_power_of_two((w + 1) / 2);
+  m_h = round_up_to_power_of_two((h + 1) / 2);
+  m_levels = 1;
+  while ((std::max(m_w, m_h) >> (m_levels - 1)) > 1) {
+    m_levels++;
+  }
+  glGenTextures(1, &m_pyramid_texture);
+  glBindTexture(GL_TEXTURE_2D, m_pyramid_texture);
+  glTexStorage2D(GL_TEXTURE_2D, m_levels, GL_R32F, m_w, m_h);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void DepthPyramid::invalidate(SharedRenderState* render_state) {
+  render_state->depth_pyramid.valid = false;
+}
+
+void DepthPyramid::build(GLuint fbo,
+                         int x,
+                         int y,
+                         int w,
+                         int h,
+                         SharedRenderState* render_state) {
+  // without the camera the depth was drawn with, the pyramid can't be used.
+  if (!render_state->background_camera.valid || w <= 0 || h <= 0) {
+    invalidate(render_state);
+    return;
+  }
+  if (w != m_screen_w || h != m_screen_h) {
+    resize(w, h);
+  }
+
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+  glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_depth_fbo);
+  glBlitFramebuffer(x, y, x + w, y + h, 0, 0, w, h, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+  glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+
+  auto& shader = render_state->shaders[ShaderId::DEPTH_PYRAMID];
+  shader.activate();
+  glUniform1i(0, 0);
+  glActiveTexture(GL_TEXTURE0);
+  for (int level = 0; level < m_levels; level++) {
+    if (level == 0) {
+      glBindTexture(GL_TEXTURE_2D, m_depth_texture);
+      glUniform1i(1, 0);
+    } else {
+      glBindTexture(GL_TEXTURE_2D, m_pyramid_texture);
+      glUniform1i(1, level - 1);
+    }
+    glBindImageTexture(0, m_pyramid_texture, level, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+    int level_w = std::max(1, m_w >> level);
+    int level_h = std::max(1, m_h >> level);
+    glDispatchCompute((level_w + 7) / 8, (level_h + 7) / 8, 1);
+    // the next level reads this one.
+    glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+  }
+  glBindTexture(GL_TEXTURE_2D, 0);
+
+  auto& result = render_state->depth_pyramid;
+  result.valid = true;
+  result.texture = m_pyramid_texture;
+  result.screen_w = m_screen_w;
+  result.screen_h = m_screen_h;
+  result.levels = m_levels;
+  result.camera = render_state->background_camera;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "game/graphics/opengl_renderer/BucketRenderer.h"
+#include "game/graphics/pipelines/opengl.h"
+
+/*!
+ * A min-depth mip chain of the frame's depth buffer, for occlusion culling tfrag and tie in the
+ * background_cull shader on the next frame. Level 0 is half the size of the depth buffer, rounded
+ * up to powers of two, and each level holds the farthest depth of the texels under it.
+ */
+class DepthPyramid {
+ public:
+  DepthPyramid() = default;
+  ~DepthPyramid();
+
+  /*!
+   * Copy the depth of the region of fbo and build the pyramid. The result is stored in
+   * render_state->depth_pyramid, with the background camera of this frame.
+   */
+  void build(GLuint fbo, int x, int y, int w, int h, SharedRenderState* render_state);
+  void invalidate(SharedRenderState* render_state);
+
+ private:
+  void resize(int w, int h);
+  void destroy();
+
+  GLuint m_depth_fbo = 0;
+  GLuint m_depth_texture = 0;  // copy of the depth buffer
+  GLuint m_pyramid_texture = 0;
+  int m_screen_w = 0;
+  int m_screen_h = 0;
+  int m_w = 0;  // of level 0
+  int m_h = 0;
+  int m_levels = 0;
+};
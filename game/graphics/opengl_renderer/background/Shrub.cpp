@@ -70,86 +70,85 @@ void Shrub::render(DmaFollower& dma, SharedRenderState* render_state, ScopedProf
   render_all_trees(settings, render_state, prof);
 }
 
-void Shrub::update_load(const LevelData* loader_data) {
+void Shrub::update_load(const LevelData* loader_data, SharedRenderState* render_state) {
   const tfrag3::Level* lev_data = loader_data->level.get();
   // We changed level!
   discard_tree_cache();
   m_trees.resize(lev_data->shrub_trees.size());
 
-  size_t max_draws = 0;
   size_t time_of_day_count = 0;
-  size_t max_num_grps = 0;
-  size_t max_inds = 0;
 
   for (u32 l_tree = 0; l_tree < lev_data->shrub_trees.size(); l_tree++) {
-    size_t num_grps = 0;
-
     const auto& tree = lev_data->shrub_trees[l_tree];
-    max_draws = std::max(tree.static_draws.size(), max_draws);
-    for (auto& draw : tree.static_draws) {
-      (void)draw;
-      // num_grps += draw.vis_groups.size(); TODO
-      max_num_grps += 1;
-    }
-    max_num_grps = std::max(max_num_grps, num_grps);
-
+    const auto& gl_data = loader_data->shrub_data[l_tree];
     time_of_day_count = std::max(tree.time_of_day_colors.size(), time_of_day_count);
-    max_inds = std::max(tree.indices.size(), max_inds);
-    u32 verts = tree.unpacked.vertices.size();
     glGenVertexArrays(1, &m_trees[l_tree].vao);
     glBindVertexArray(m_trees[l_tree].vao);
-    m_trees[l_tree].vertex_buffer = loader_data->shrub_vertex_data[l_tree];
-    m_trees[l_tree].vert_count = verts;
+    m_trees[l_tree].vertex_buffer = gl_data.vertex_buffer;
+    m_trees[l_tree].instance_buffer = gl_data.instance_buffer;
+    m_trees[l_tree].index_buffer = gl_data.index_buffer;
+    m_trees[l_tree].command_buffer = gl_data.command_buffer;
+    m_trees[l_tree].vert_count = tree.instanced.vertices.size();
     m_trees[l_tree].draws = &tree.static_draws;
     m_trees[l_tree].colors = &tree.time_of_day_colors;
-    m_trees[l_tree].index_data = tree.indices.data();
+    m_trees[l_tree].commands = &tree.instanced.commands;
+    m_trees[l_tree].draw_commands = &tree.instanced.draw_commands;
     m_trees[l_tree].tod_cache = swizzle_time_of_day(tree.time_of_day_colors);
+    m_trees[l_tree].tod_dirty.invalidate();
+
+    // prototype vertices
     glBindBuffer(GL_ARRAY_BUFFER, m_trees[l_tree].vertex_buffer);
     glEnableVertexAttribArray(0);
     glEnableVertexAttribArray(1);
     glEnableVertexAttribArray(2);
-    glEnableVertexAttribArray(3);
 
-    glVertexAttribPointer(0,                                          // location 0 in the shader
-                          3,                                          // 3 values per vert
-                          GL_FLOAT,                                   // floats
-                          GL_FALSE,                                   // normalized
-                          sizeof(tfrag3::ShrubGpuVertex),             // stride
-                          (void*)offsetof(tfrag3::ShrubGpuVertex, x)  // offset (0)
+    glVertexAttribPointer(0,                                    // location 0 in the shader
+                          3,                                    // 3 values per vert
+                          GL_FLOAT,                             // floats
+                          GL_FALSE,                             // normalized
+                          sizeof(tfrag3::ShrubProtoGpuVertex),  // stride
+                          (void*)offsetof(tfrag3::ShrubProtoGpuVertex, x)  // offset (0)
     );
 
-    glVertexAttribPointer(1,                                          // location 1 in the shader
-                          2,                                          // 3 values per vert
-                          GL_FLOAT,                                   // floats
-                          GL_FALSE,                                   // normalized
-                          sizeof(tfrag3::ShrubGpuVertex),             // stride
-                          (void*)offsetof(tfrag3::ShrubGpuVertex, s)  // offset (0)
+    glVertexAttribPointer(1,                                    // location 1 in the shader
+                          2,                                    // 2 values per vert
+                          GL_FLOAT,                             // floats
+                          GL_FALSE,                             // normalized
+                          sizeof(tfrag3::ShrubProtoGpuVertex),  // stride
+                          (void*)offsetof(tfrag3::ShrubProtoGpuVertex, s)  // offset
     );
 
-    glVertexAttribPointer(2,                               // location 1 in the shader
-                          3,                               // 4 color components
-                          GL_UNSIGNED_BYTE,                // u8
-                          GL_TRUE,                         // normalized (255 becomes 1)
-                          sizeof(tfrag3::ShrubGpuVertex),  //
-                          (void*)offsetof(tfrag3::ShrubGpuVertex, rgba_base)  //
+    glVertexAttribPointer(2,                                    // location 2 in the shader
+                          3,                                    // 3 color components
+                          GL_UNSIGNED_BYTE,                     // u8
+                          GL_TRUE,                              // normalized (255 becomes 1)
+                          sizeof(tfrag3::ShrubProtoGpuVertex),  //
+                          (void*)offsetof(tfrag3::ShrubProtoGpuVertex, rgba_base)  //
     );
 
-    glVertexAttribIPointer(3,                               // location 2 in the shader
-                           1,                               // 1 values per vert
-                           GL_UNSIGNED_SHORT,               // u16
-                           sizeof(tfrag3::ShrubGpuVertex),  // stride
-                           (void*)offsetof(tfrag3::ShrubGpuVertex, color_index)  // offset (0)
+    // per-instance time of day index and matrix
+    glBindBuffer(GL_ARRAY_BUFFER, m_trees[l_tree].instance_buffer);
+    glEnableVertexAttribArray(3);
+    glVertexAttribIPointer(3,                                 // location 3 in the shader
+                           1,                                 // 1 value per instance
+                           GL_UNSIGNED_INT,                   // u32
+                           sizeof(tfrag3::ShrubGpuInstance),  // stride
+                           (void*)offsetof(tfrag3::ShrubGpuInstance, color_index)  // offset
     );
+    glVertexAttribDivisor(3, 1);
+    for (int col = 0; col < 4; col++) {
+      glEnableVertexAttribArray(4 + col);
+      glVertexAttribPointer(4 + col, 4, GL_FLOAT, GL_FALSE, sizeof(tfrag3::ShrubGpuInstance),
+                            (void*)(offsetof(tfrag3::ShrubGpuInstance, mat) +
+                                    col * sizeof(math::Vector4f)));
+      glVertexAttribDivisor(4 + col, 1);
+    }
 
-    glGenBuffers(1, &m_trees[l_tree].single_draw_index_buffer);
-    glGenBuffers(1, &m_trees[l_tree].index_buffer);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_trees[l_tree].index_buffer);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, tree.indices.size() * sizeof(u32), tree.indices.data(),
-                 GL_STATIC_DRAW);
 
-    glActiveTexture(GL_TEXTURE10);
+    render_state->gl_state.active_texture(GL_TEXTURE10);
     glGenTextures(1, &m_trees[l_tree].time_of_day_texture);
-    glBindTexture(GL_TEXTURE_1D, m_trees[l_tree].time_of_day_texture);
+    render_state->gl_state.bind_texture(GL_TEXTURE_1D, m_trees[l_tree].time_of_day_texture);
     glTexImage1D(GL_TEXTURE_1D, 0, GL_RGBA, TIME_OF_DAY_COLOR_COUNT, 0, GL_RGBA,
                  GL_UNSIGNED_INT_8_8_8_8, nullptr);
     glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
@@ -158,11 +157,6 @@ void Shrub::update_load(const LevelData* loader_data) {
     glBindVertexArray(0);
   }
 
-  m_cache.multidraw_offset_per_stripdraw.resize(max_draws);
-  m_cache.multidraw_count_buffer.resize(max_num_grps);
-  m_cache.multidraw_index_offset_buffer.resize(max_num_grps);
-  m_cache.draw_idx_temp.resize(max_draws);
-  m_cache.index_temp.resize(max_inds);
   ASSERT(time_of_day_count <= TIME_OF_DAY_COLOR_COUNT);
 }
 
@@ -192,7 +186,7 @@ bool Shrub::setup_for_level(const std::string& level, SharedRenderState* render_
   m_load_id = lev_data->load_id;
 
   if (m_level_name != level) {
-    update_load(lev_data);
+    update_load(lev_data, render_state);
     m_has_level = true;
     m_level_name = level;
   } else {
@@ -210,8 +204,6 @@ void Shrub::discard_tree_cache() {
   for (auto& tree : m_trees) {
     glBindTexture(GL_TEXTURE_1D, tree.time_of_day_texture);
     glDeleteTextures(1, &tree.time_of_day_texture);
-    glDeleteBuffers(1, &tree.index_buffer);
-    glDeleteBuffers(1, &tree.single_draw_index_buffer);
     glDeleteVertexArrays(1, &tree.vao);
   }
 
@@ -233,72 +225,69 @@ void Shrub::render_tree(int idx,
   Timer tree_timer;
   auto& tree = m_trees.at(idx);
   tree.perf.draws = 0;
-  tree.perf.wind_draws = 0;
+  tree.perf.instances = 0;
   if (!m_has_level) {
     return;
   }
 
-  if (m_color_result.size() < tree.colors->size()) {
-    m_color_result.resize(tree.colors->size());
-  }
-
   Timer interp_timer;
-  interp_time_of_day_fast(settings.itimes, tree.tod_cache, m_color_result.data());
+  bool tod_changed = tree.tod_dirty.needs_update(settings.itimes, true);
+  if (tod_changed) {
+    if (m_color_result.size() < tree.colors->size()) {
+      m_color_result.resize(tree.colors->size());
+    }
+    interp_time_of_day_fast(settings.itimes, tree.tod_cache, m_color_result.data());
+  }
   tree.perf.tod_time.add(interp_timer.getSeconds());
 
   Timer setup_timer;
-  glActiveTexture(GL_TEXTURE10);
-  glBindTexture(GL_TEXTURE_1D, tree.time_of_day_texture);
-  glTexSubImage1D(GL_TEXTURE_1D, 0, 0, tree.colors->size(), GL_RGBA, GL_UNSIGNED_INT_8_8_8_8_REV,
-                  m_color_result.data());
+  render_state->gl_state.active_texture(GL_TEXTURE10);
+  render_state->gl_state.bind_texture(GL_TEXTURE_1D, tree.time_of_day_texture);
+  if (tod_changed) {
+    glTexSubImage1D(GL_TEXTURE_1D, 0, 0, tree.colors->size(), GL_RGBA,
+                    GL_UNSIGNED_INT_8_8_8_8_REV, m_color_result.data());
+  }
 
   first_tfrag_draw_setup(settings, render_state, ShaderId::SHRUB);
 
   glBindVertexArray(tree.vao);
-  glBindBuffer(GL_ARRAY_BUFFER, tree.vertex_buffer);
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER,
-               render_state->no_multidraw ? tree.single_draw_index_buffer : tree.index_buffer);
-  glActiveTexture(GL_TEXTURE0);
-  glEnable(GL_PRIMITIVE_RESTART);
+  glBindBuffer(GL_DRAW_INDIRECT_BUFFER, tree.command_buffer);
+  render_state->gl_state.active_texture(GL_TEXTURE0);
+  render_state->gl_state.enable(GL_PRIMITIVE_RESTART);
   glPrimitiveRestartIndex(UINT32_MAX);
   tree.perf.tod_time.add(setup_timer.getSeconds());
 
   int last_texture = -1;
 
-  tree.perf.cull_time.add(0);
-  Timer index_timer;
-  if (render_state->no_multidraw) {
-    u32 idx_buffer_size = make_all_visible_index_list(
-        m_cache.draw_idx_temp.data(), m_cache.index_temp.data(), *tree.draws, tree.index_data);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, idx_buffer_size * sizeof(u32), m_cache.index_temp.data(),
-                 GL_STREAM_DRAW);
-  } else {
-    make_all_visible_multidraws(m_cache.multidraw_offset_per_stripdraw.data(),
-                                m_cache.multidraw_count_buffer.data(),
-                                m_cache.multidraw_index_offset_buffer.data(), *tree.draws);
-  }
-
-  tree.perf.index_time.add(index_timer.getSeconds());
-
   Timer draw_timer;
 
-  for (size_t draw_idx = 0; draw_idx < tree.draws->size(); draw_idx++) {
-    const auto& draw = tree.draws->operator[](draw_idx);
-    const auto& multidraw_indices = m_cache.multidraw_offset_per_stripdraw[draw_idx];
-    const auto& singledraw_indices = m_cache.draw_idx_temp[draw_idx];
-
+  // every instance that uses the same prototype strips is drawn with a single indirect command.
+  auto draw_instances = [&](u32 first_cmd, u32 num_cmds) {
     if (render_state->no_multidraw) {
-      if (singledraw_indices.second == 0) {
-        continue;
+      for (u32 i = 0; i < num_cmds; i++) {
+        const auto& cmd = tree.commands->at(first_cmd + i);
+        glDrawElementsInstancedBaseInstance(GL_TRIANGLE_STRIP, cmd.count, GL_UNSIGNED_INT,
+                                            (void*)(cmd.first_index * sizeof(u32)),
+                                            cmd.instance_count, cmd.base_instance);
       }
+      prof.add_draw_call(num_cmds);
     } else {
-      if (multidraw_indices.second == 0) {
-        continue;
-      }
+      glMultiDrawElementsIndirect(
+          GL_TRIANGLE_STRIP, GL_UNSIGNED_INT,
+          (void*)(first_cmd * sizeof(tfrag3::DrawElementsIndirectCommand)), num_cmds, 0);
+      prof.add_draw_call();
+    }
+  };
+
+  for (size_t draw_idx = 0; draw_idx < tree.draws->size(); draw_idx++) {
+    const auto& draw = tree.draws->operator[](draw_idx);
+    const auto& [first_cmd, num_cmds] = tree.draw_commands->at(draw_idx);
+    if (num_cmds == 0) {
+      continue;
     }
 
     if ((int)draw.tree_tex_id != last_texture) {
-      glBindTexture(GL_TEXTURE_2D, m_textures->at(draw.tree_tex_id));
+      render_state->gl_state.bind_texture(GL_TEXTURE_2D, m_textures->at(draw.tree_tex_id));
       last_texture = draw.tree_tex_id;
     }
 
@@ -306,47 +295,33 @@ void Shrub::render_tree(int idx,
 
     auto double_draw = setup_tfrag_shader(render_state, draw.mode, ShaderId::SHRUB);
 
-    prof.add_draw_call();
     prof.add_tri(draw.num_triangles);
 
     tree.perf.draws++;
-
-    if (render_state->no_multidraw) {
-      glDrawElements(GL_TRIANGLE_STRIP, singledraw_indices.second, GL_UNSIGNED_INT,
-                     (void*)(singledraw_indices.first * sizeof(u32)));
-    } else {
-      glMultiDrawElements(GL_TRIANGLE_STRIP,
-                          &m_cache.multidraw_count_buffer[multidraw_indices.first], GL_UNSIGNED_INT,
-                          &m_cache.multidraw_index_offset_buffer[multidraw_indices.first],
-                          multidraw_indices.second);
+    for (u32 i = 0; i < num_cmds; i++) {
+      tree.perf.instances += tree.commands->at(first_cmd + i).instance_count;
     }
 
+    draw_instances(first_cmd, num_cmds);
+
     switch (double_draw.kind) {
       case DoubleDrawKind::NONE:
         break;
       case DoubleDrawKind::AFAIL_NO_DEPTH_WRITE:
         tree.perf.draws++;
-        prof.add_draw_call();
         glUniform1f(glGetUniformLocation(render_state->shaders[ShaderId::SHRUB].id(), "alpha_min"),
                     -10.f);
         glUniform1f(glGetUniformLocation(render_state->shaders[ShaderId::SHRUB].id(), "alpha_max"),
                     double_draw.aref_second);
-        glDepthMask(GL_FALSE);
-        if (render_state->no_multidraw) {
-          glDrawElements(GL_TRIANGLE_STRIP, singledraw_indices.second, GL_UNSIGNED_INT,
-                         (void*)(singledraw_indices.first * sizeof(u32)));
-        } else {
-          glMultiDrawElements(
-              GL_TRIANGLE_STRIP, &m_cache.multidraw_count_buffer[multidraw_indices.first],
-              GL_UNSIGNED_INT, &m_cache.multidraw_index_offset_buffer[multidraw_indices.first],
-              multidraw_indices.second);
-        }
+        render_state->gl_state.depth_mask(false);
+        draw_instances(first_cmd, num_cmds);
         break;
       default:
         ASSERT(false);
     }
   }
 
+  glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
   glBindVertexArray(0);
   tree.perf.draw_time.add(draw_timer.getSeconds());
   tree.perf.tree_time.add(tree_timer.getSeconds());
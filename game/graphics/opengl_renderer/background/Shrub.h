@@ -27,27 +27,27 @@ class Shrub : public BucketRenderer {
   void draw_debug_window() override;
 
  private:
-  void update_load(const LevelData* loader_data);
+  void update_load(const LevelData* loader_data, SharedRenderState* render_state);
   void discard_tree_cache();
 
   struct Tree {
     GLuint vertex_buffer;
+    GLuint instance_buffer;
     GLuint index_buffer;
-    GLuint single_draw_index_buffer;
+    GLuint command_buffer;
     GLuint time_of_day_texture;
     GLuint vao;
     u32 vert_count;
     const std::vector<tfrag3::ShrubDraw>* draws = nullptr;
-    const std::vector<tfrag3::TieWindInstance>* instance_info = nullptr;
     const std::vector<tfrag3::TimeOfDayColor>* colors = nullptr;
-    const u32* index_data = nullptr;
+    const std::vector<tfrag3::DrawElementsIndirectCommand>* commands = nullptr;
+    const std::vector<std::pair<u32, u32>>* draw_commands = nullptr;
     SwizzledTimeOfDay tod_cache;
+    TimeOfDayDirtyCheck tod_dirty;
 
     struct {
       u32 draws = 0;
-      u32 wind_draws = 0;
-      Filtered<float> cull_time;
-      Filtered<float> index_time;
+      u32 instances = 0;
       Filtered<float> tod_time;
       Filtered<float> setup_time;
       Filtered<float> draw_time;
@@ -69,12 +69,5 @@ class Shrub : public BucketRenderer {
   static constexpr int TIME_OF_DAY_COLOR_COUNT = 8192;
   bool m_has_level = false;
 
-  struct Cache {
-    std::vector<std::pair<int, int>> draw_idx_temp;
-    std::vector<u32> index_temp;
-    std::vector<std::pair<int, int>> multidraw_offset_per_stripdraw;
-    std::vector<GLsizei> multidraw_count_buffer;
-    std::vector<void*> multidraw_index_offset_buffer;
-  } m_cache;
   TfragPcPortData m_pc_port_data;
 };
@@ -73,8 +73,7 @@ void TFragment::render(DmaFollower& dma,
     for (int i = 0; i < render_state->num_vis_to_copy; i++) {
       if (transfers[i].size_bytes == 128 * 16) {
         if (render_state->use_occlusion_culling) {
-          render_state->occlusion_vis[i].valid = true;
-          memcpy(render_state->occlusion_vis[i].data, transfers[i].data, 128 * 16);
+          render_state->occlusion_vis[i].update(transfers[i].data);
         }
       } else {
         ASSERT(transfers[i].size_bytes == 16);
@@ -122,6 +121,7 @@ void TFragment::render(DmaFollower& dma,
     settings.tree_idx = 0;
     if (render_state->occlusion_vis[m_level_id].valid) {
       settings.occlusion_culling = render_state->occlusion_vis[m_level_id].data;
+      settings.occlusion_culling_version = render_state->occlusion_vis[m_level_id].version;
     }
 
     update_render_state_from_pc_settings(render_state, m_pc_port_data);
@@ -45,7 +45,8 @@ void Tfrag3::init_shaders(ShaderLibrary& shaders) {
 }
 
 void Tfrag3::update_load(const std::vector<tfrag3::TFragmentTreeKind>& tree_kinds,
-                         const LevelData* loader_data) {
+                         const LevelData* loader_data,
+                         SharedRenderState* render_state) {
   const auto* lev_data = loader_data->level.get();
   discard_tree_cache();
   for (int geom = 0; geom < GEOM_MAX; ++geom) {
@@ -54,8 +55,6 @@ void Tfrag3::update_load(const std::vector<tfrag3::TFragmentTreeKind>& tree_kind
 
   size_t time_of_day_count = 0;
   size_t vis_temp_len = 0;
-  size_t max_draws = 0;
-  size_t max_num_grps = 0;
   size_t max_inds = 0;
 
   for (int geom = 0; geom < GEOM_MAX; ++geom) {
@@ -65,12 +64,14 @@ void Tfrag3::update_load(const std::vector<tfrag3::TFragmentTreeKind>& tree_kind
       if (std::find(tree_kinds.begin(), tree_kinds.end(), tree.kind) != tree_kinds.end()) {
         auto& tree_cache = m_cached_trees[geom].emplace_back();
         tree_cache.kind = tree.kind;
-        max_draws = std::max(tree.draws.size(), max_draws);
         size_t num_grps = 0;
         for (auto& draw : tree.draws) {
           num_grps += draw.vis_groups.size();
         }
-        max_num_grps = std::max(max_num_grps, num_grps);
+        tree_cache.draw_idx_temp.resize(tree.draws.size());
+        tree_cache.multidraw_offset_per_stripdraw.resize(tree.draws.size());
+        tree_cache.multidraw_count_buffer.resize(num_grps);
+        tree_cache.multidraw_index_offset_buffer.resize(num_grps);
         max_inds = std::max(tree.unpacked.indices.size(), max_inds);
         time_of_day_count = std::max(tree.colors.size(), time_of_day_count);
         u32 verts = tree.packed_vertices.vertices.size();
@@ -82,6 +83,8 @@ void Tfrag3::update_load(const std::vector<tfrag3::TFragmentTreeKind>& tree_kind
         tree_cache.draws = &tree.draws;  // todo - should we just copy this?
         tree_cache.colors = &tree.colors;
         tree_cache.vis = &tree.bvh;
+        tree_cache.vis_soa = make_vis_nodes_soa(tree.bvh.vis_nodes);
+        tree_cache.gpu_cull = make_gpu_cull_data(tree.draws, tree.bvh.vis_nodes);
         tree_cache.index_data = tree.unpacked.indices.data();
         tree_cache.tod_cache = swizzle_time_of_day(tree.colors);
         tree_cache.draw_mode = tree.use_strips ? GL_TRIANGLE_STRIP : GL_TRIANGLES;
@@ -123,7 +126,7 @@ void Tfrag3::update_load(const std::vector<tfrag3::TFragmentTreeKind>& tree_kind
                      tree.unpacked.indices.data(), GL_STREAM_DRAW);
 
         glGenTextures(1, &tree_cache.time_of_day_texture);
-        glBindTexture(GL_TEXTURE_1D, tree_cache.time_of_day_texture);
+        render_state->gl_state.bind_texture(GL_TEXTURE_1D, tree_cache.time_of_day_texture);
         glTexImage1D(GL_TEXTURE_1D, 0, GL_RGBA, TIME_OF_DAY_COLOR_COUNT, 0, GL_RGBA,
                      GL_UNSIGNED_INT_8_8_8_8, nullptr);
         glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
@@ -134,10 +137,8 @@ void Tfrag3::update_load(const std::vector<tfrag3::TFragmentTreeKind>& tree_kind
   }
 
   m_cache.vis_temp.resize(vis_temp_len);
-  m_cache.multidraw_offset_per_stripdraw.resize(max_draws);
-  m_cache.multidraw_count_buffer.resize(max_num_grps);
-  m_cache.multidraw_index_offset_buffer.resize(max_num_grps);
-  m_cache.draw_idx_temp.resize(max_draws);
+  // every geom has the same trees, with the same BVH.
+  m_tree_lods.assign(m_cached_trees[0].size(), LodSelection());
   m_cache.index_temp.resize(max_inds);
   ASSERT(time_of_day_count <= TIME_OF_DAY_COLOR_COUNT);
 }
@@ -169,7 +170,7 @@ bool Tfrag3::setup_for_level(const std::vector<tfrag3::TFragmentTreeKind>& tree_
   m_load_id = lev_data->load_id;
 
   if (m_level_name != level) {
-    update_load(tree_kinds, lev_data);
+    update_load(tree_kinds, lev_data, render_state);
     m_has_level = true;
     m_textures = &lev_data->textures;
     m_level_name = level;
@@ -187,7 +188,8 @@ bool Tfrag3::setup_for_level(const std::vector<tfrag3::TFragmentTreeKind>& tree_
 void Tfrag3::render_tree(int geom,
                          const TfragRenderSettings& settings,
                          SharedRenderState* render_state,
-                         ScopedProfilerNode& prof) {
+                         ScopedProfilerNode& prof,
+                         const LodSelection* lods) {
   if (!m_has_level) {
     return;
   }
@@ -204,18 +206,28 @@ void Tfrag3::render_tree(int geom,
 
   ASSERT(tree.kind != tfrag3::TFragmentTreeKind::INVALID);
 
-  if (m_color_result.size() < tree.colors->size()) {
-    m_color_result.resize(tree.colors->size());
+  render_state->gl_state.active_texture(GL_TEXTURE10);
+  render_state->gl_state.bind_texture(GL_TEXTURE_1D, tree.time_of_day_texture);
+  if (tree.tod_dirty.needs_update(itimes, m_use_fast_time_of_day)) {
+    if (m_color_result.size() < tree.colors->size()) {
+      m_color_result.resize(tree.colors->size());
+    }
+    if (m_use_fast_time_of_day) {
+      interp_time_of_day_fast(itimes, tree.tod_cache, m_color_result.data());
+    } else {
+      interp_time_of_day_slow(itimes, *tree.colors, m_color_result.data());
+    }
+    glTexSubImage1D(GL_TEXTURE_1D, 0, 0, tree.colors->size(), GL_RGBA,
+                    GL_UNSIGNED_INT_8_8_8_8_REV, m_color_result.data());
   }
-  if (m_use_fast_time_of_day) {
-    interp_time_of_day_fast(itimes, tree.tod_cache, m_color_result.data());
-  } else {
-    interp_time_of_day_slow(itimes, *tree.colors, m_color_result.data());
+
+  // the culling shader runs first, it replaces the program set up for drawing.
+  // the culling shader doesn't know about lods.
+  const bool gpu_culling = render_state->use_gpu_culling && !render_state->no_multidraw &&
+                           tree.gpu_cull.valid() && !lods;
+  if (gpu_culling) {
+    gpu_cull(tree.gpu_cull, render_state, settings, nullptr, false);
   }
-  glActiveTexture(GL_TEXTURE10);
-  glBindTexture(GL_TEXTURE_1D, tree.time_of_day_texture);
-  glTexSubImage1D(GL_TEXTURE_1D, 0, 0, tree.colors->size(), GL_RGBA, GL_UNSIGNED_INT_8_8_8_8_REV,
-                  m_color_result.data());
 
   first_tfrag_draw_setup(settings, render_state, ShaderId::TFRAG3);
 
@@ -223,34 +235,52 @@ void Tfrag3::render_tree(int geom,
   glBindBuffer(GL_ARRAY_BUFFER, tree.vertex_buffer);
   glBindBuffer(GL_ELEMENT_ARRAY_BUFFER,
                render_state->no_multidraw ? tree.single_draw_index_buffer : tree.index_buffer);
-  glActiveTexture(GL_TEXTURE0);
-  glEnable(GL_PRIMITIVE_RESTART);
+  render_state->gl_state.active_texture(GL_TEXTURE0);
+  render_state->gl_state.enable(GL_PRIMITIVE_RESTART);
   glPrimitiveRestartIndex(UINT32_MAX);
 
-  cull_check_all_slow(settings.planes, tree.vis->vis_nodes, settings.occlusion_culling,
-                      m_cache.vis_temp.data());
-
-  u32 total_tris;
-  if (render_state->no_multidraw) {
-    u32 idx_buffer_size = make_index_list_from_vis_string(
-        m_cache.draw_idx_temp.data(), m_cache.index_temp.data(), *tree.draws, m_cache.vis_temp,
-        tree.index_data, &total_tris);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, idx_buffer_size * sizeof(u32), m_cache.index_temp.data(),
-                 GL_STREAM_DRAW);
+  // the triangle count isn't known on the CPU when culling on the GPU.
+  u32 total_tris = 0;
+  if (gpu_culling) {
+    tree.culled_with = CullingKey();
   } else {
-    total_tris = make_multidraws_from_vis_string(
-        m_cache.multidraw_offset_per_stripdraw.data(), m_cache.multidraw_count_buffer.data(),
-        m_cache.multidraw_index_offset_buffer.data(), *tree.draws, m_cache.vis_temp);
+    // if nothing that affects culling has changed, the draw lists (and the index buffer) from last
+    // time are still good.
+    CullingKey key(settings, !render_state->no_multidraw, 0, lods ? lods->version : 0);
+    if (key != tree.culled_with) {
+      cull_check_all_fast(settings.planes, tree.vis_soa, settings.occlusion_culling,
+                          m_cache.vis_temp.data());
+      if (lods) {
+        mask_vis_by_lod(m_cache.vis_temp.data(), *lods, geom);
+      }
+      if (render_state->no_multidraw) {
+        u32 idx_buffer_size = make_index_list_from_vis_string(
+            tree.draw_idx_temp.data(), m_cache.index_temp.data(), *tree.draws, m_cache.vis_temp,
+            tree.index_data, &tree.culled_tris);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, idx_buffer_size * sizeof(u32),
+                     m_cache.index_temp.data(), GL_STREAM_DRAW);
+      } else {
+        tree.culled_tris = make_multidraws_from_vis_string(
+            tree.multidraw_offset_per_stripdraw.data(), tree.multidraw_count_buffer.data(),
+            tree.multidraw_index_offset_buffer.data(), *tree.draws, m_cache.vis_temp);
+      }
+      tree.culled_with = key;
+    }
+    total_tris = tree.culled_tris;
   }
 
   prof.add_tri(total_tris);
 
   for (size_t draw_idx = 0; draw_idx < tree.draws->size(); draw_idx++) {
     const auto& draw = tree.draws->operator[](draw_idx);
-    const auto& multidraw_indices = m_cache.multidraw_offset_per_stripdraw[draw_idx];
-    const auto& singledraw_indices = m_cache.draw_idx_temp[draw_idx];
+    const auto& multidraw_indices = tree.multidraw_offset_per_stripdraw[draw_idx];
+    const auto& singledraw_indices = tree.draw_idx_temp[draw_idx];
 
-    if (render_state->no_multidraw) {
+    if (gpu_culling) {
+      if (tree.gpu_cull.commands_per_draw[draw_idx].second == 0) {
+        continue;
+      }
+    } else if (render_state->no_multidraw) {
       if (singledraw_indices.second == 0) {
         continue;
       }
@@ -261,20 +291,22 @@ void Tfrag3::render_tree(int geom,
     }
 
     ASSERT(m_textures);
-    glBindTexture(GL_TEXTURE_2D, m_textures->at(draw.tree_tex_id));
+    render_state->gl_state.bind_texture(GL_TEXTURE_2D, m_textures->at(draw.tree_tex_id));
     auto double_draw = setup_tfrag_shader(render_state, draw.mode, ShaderId::TFRAG3);
     glUniform1i(m_uniforms.decal, draw.mode.get_decal() ? 1 : 0);
     tree.tris_this_frame += draw.num_triangles;
     tree.draws_this_frame++;
 
     prof.add_draw_call();
-    if (render_state->no_multidraw) {
+    if (gpu_culling) {
+      multidraw_gpu_culled(tree.draw_mode, tree.gpu_cull, draw_idx);
+    } else if (render_state->no_multidraw) {
       glDrawElements(tree.draw_mode, singledraw_indices.second, GL_UNSIGNED_INT,
                      (void*)(singledraw_indices.first * sizeof(u32)));
     } else {
-      glMultiDrawElements(tree.draw_mode, &m_cache.multidraw_count_buffer[multidraw_indices.first],
+      glMultiDrawElements(tree.draw_mode, &tree.multidraw_count_buffer[multidraw_indices.first],
                           GL_UNSIGNED_INT,
-                          &m_cache.multidraw_index_offset_buffer[multidraw_indices.first],
+                          &tree.multidraw_index_offset_buffer[multidraw_indices.first],
                           multidraw_indices.second);
     }
 
@@ -287,14 +319,16 @@ void Tfrag3::render_tree(int geom,
                     -10.f);
         glUniform1f(glGetUniformLocation(render_state->shaders[ShaderId::TFRAG3].id(), "alpha_max"),
                     double_draw.aref_second);
-        glDepthMask(GL_FALSE);
-        if (render_state->no_multidraw) {
+        render_state->gl_state.depth_mask(false);
+        if (gpu_culling) {
+          multidraw_gpu_culled(tree.draw_mode, tree.gpu_cull, draw_idx);
+        } else if (render_state->no_multidraw) {
           glDrawElements(tree.draw_mode, singledraw_indices.second, GL_UNSIGNED_INT,
                          (void*)(singledraw_indices.first * sizeof(u32)));
         } else {
           glMultiDrawElements(
-              tree.draw_mode, &m_cache.multidraw_count_buffer[multidraw_indices.first],
-              GL_UNSIGNED_INT, &m_cache.multidraw_index_offset_buffer[multidraw_indices.first],
+              tree.draw_mode, &tree.multidraw_count_buffer[multidraw_indices.first],
+              GL_UNSIGNED_INT, &tree.multidraw_index_offset_buffer[multidraw_indices.first],
               multidraw_indices.second);
         }
         break;
@@ -329,6 +363,11 @@ void Tfrag3::render_matching_trees(int geom,
                                    SharedRenderState* render_state,
                                    ScopedProfilerNode& prof) {
   TfragRenderSettings settings_copy = settings;
+  // with the automatic lod, each part of a tree is drawn with geom or one of the lower detail
+  // geoms after it.
+  const bool auto_lod = Gfx::g_global_settings.lod_auto;
+  const float focal_length =
+      auto_lod ? camera_focal_length_pixels(settings.planes, render_state->draw_region_h) : 0.f;
   for (size_t i = 0; i < m_cached_trees[geom].size(); i++) {
     auto& tree = m_cached_trees[geom][i];
     tree.reset_stats();
@@ -338,7 +377,16 @@ void Tfrag3::render_matching_trees(int geom,
     if (std::find(trees.begin(), trees.end(), tree.kind) != trees.end() || tree.forced) {
       tree.rendered_this_frame = true;
       settings_copy.tree_idx = i;
-      render_tree(geom, settings_copy, render_state, prof);
+      if (auto_lod) {
+        auto& lods = m_tree_lods.at(i);
+        select_lods(&lods, tree.vis_soa, render_state->camera_pos, focal_length,
+                    Gfx::g_global_settings.lod_auto_pixels, geom, GEOM_MAX - 1);
+        for (int lod_geom = geom; lod_geom < GEOM_MAX; lod_geom++) {
+          render_tree(lod_geom, settings_copy, render_state, prof, &lods);
+        }
+      } else {
+        render_tree(geom, settings_copy, render_state, prof);
+      }
       if (tree.cull_debug) {
         render_tree_cull_debug(settings_copy, render_state, prof);
       }
@@ -382,6 +430,7 @@ void Tfrag3::discard_tree_cache() {
         glDeleteBuffers(1, &tree.single_draw_index_buffer);
         glDeleteBuffers(1, &tree.index_buffer);
         glDeleteVertexArrays(1, &tree.vao);
+        free_gpu_cull_data(tree.gpu_cull);
       }
     }
     m_cached_trees[geom].clear();
@@ -489,11 +538,11 @@ void Tfrag3::render_tree_cull_debug(const TfragRenderSettings& settings,
       glGetUniformLocation(render_state->shaders[ShaderId::TFRAG3_NO_TEX].id(), "fog_constant"),
       settings.fog.x());
   // glDisable(GL_DEPTH_TEST);
-  glEnable(GL_DEPTH_TEST);
-  glDepthFunc(GL_GEQUAL);
-  glEnable(GL_BLEND);
-  glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);  // ?
-  glDepthMask(GL_FALSE);
+  render_state->gl_state.enable(GL_DEPTH_TEST);
+  render_state->gl_state.depth_func(GL_GEQUAL);
+  render_state->gl_state.enable(GL_BLEND);
+  render_state->gl_state.blend_func(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);  // ?
+  render_state->gl_state.depth_mask(false);
 
   glBindVertexArray(m_debug_vao);
   glBindBuffer(GL_ARRAY_BUFFER, m_debug_verts);
@@ -25,10 +25,12 @@ class Tfrag3 {
                              SharedRenderState* render_state,
                              ScopedProfilerNode& prof);
 
+  // if lods is set, only the parts of the tree that use this geom are drawn.
   void render_tree(int geom,
                    const TfragRenderSettings& settings,
                    SharedRenderState* render_state,
-                   ScopedProfilerNode& prof);
+                   ScopedProfilerNode& prof,
+                   const LodSelection* lods = nullptr);
 
   bool setup_for_level(const std::vector<tfrag3::TFragmentTreeKind>& tree_kinds,
                        const std::string& level,
@@ -46,7 +48,8 @@ class Tfrag3 {
   };
 
   void update_load(const std::vector<tfrag3::TFragmentTreeKind>& tree_kinds,
-                   const LevelData* loader_data);
+                   const LevelData* loader_data,
+                   SharedRenderState* render_state);
 
   int lod() const { return Gfx::g_global_settings.lod_tfrag; }
 
@@ -64,10 +67,21 @@ class Tfrag3 {
     const std::vector<tfrag3::StripDraw>* draws = nullptr;
     const std::vector<tfrag3::TimeOfDayColor>* colors = nullptr;
     const tfrag3::BVH* vis = nullptr;
+    VisNodesSoA vis_soa;
+    GpuCullData gpu_cull;
     const u32* index_data = nullptr;
     SwizzledTimeOfDay tod_cache;
+    TimeOfDayDirtyCheck tod_dirty;
     u64 draw_mode = 0;
 
+    // the draw lists from the last time this tree was culled on the CPU, and what they depend on.
+    std::vector<std::pair<int, int>> draw_idx_temp;
+    std::vector<std::pair<int, int>> multidraw_offset_per_stripdraw;
+    std::vector<GLsizei> multidraw_count_buffer;
+    std::vector<void*> multidraw_index_offset_buffer;
+    CullingKey culled_with;
+    u32 culled_tris = 0;
+
     void reset_stats() {
       rendered_this_frame = false;
       tris_this_frame = 0;
@@ -90,17 +104,15 @@ class Tfrag3 {
 
   struct Cache {
     std::vector<u8> vis_temp;
-    std::vector<std::pair<int, int>> draw_idx_temp;
     std::vector<u32> index_temp;
-    std::vector<std::pair<int, int>> multidraw_offset_per_stripdraw;
-    std::vector<GLsizei> multidraw_count_buffer;
-    std::vector<void*> multidraw_index_offset_buffer;
   } m_cache;
 
   std::string m_level_name;
 
   const std::vector<GLuint>* m_textures = nullptr;
   std::array<std::vector<TreeCache>, GEOM_MAX> m_cached_trees;
+  // for each tree, the geom of each node when the lod is picked automatically.
+  std::vector<LodSelection> m_tree_lods;
 
   std::vector<math::Vector<u8, 4>> m_color_result;
 
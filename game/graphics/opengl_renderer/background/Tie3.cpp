@@ -1,11 +1,24 @@
 #include "Tie3.h"
 
+#include <algorithm>
+
 #include "common/global_profiler/GlobalProfiler.h"
 #include "common/log/log.h"
 #include "common/util/Assert.h"
 
 #include "third-party/imgui/imgui.h"
 
+namespace {
+// layout must match tie_wind.comp
+struct GpuWindInstance {
+  math::Vector4f matrix[4];
+  u32 wind_idx;
+  float stiffness;
+  u32 pad[2];
+};
+static_assert(sizeof(GpuWindInstance) == 80);
+}  // namespace
+
 Tie3::Tie3(const std::string& name, int my_id, int level_id, tfrag3::TieCategory category)
     : BucketRenderer(name, my_id), m_level_id(level_id), m_default_category(category) {
   // regardless of how many we use some fixed max
@@ -31,6 +44,9 @@ Tie3::~Tie3() {
 
 void Tie3::init_shaders(ShaderLibrary& shaders) {
   m_uniforms.decal = glGetUniformLocation(shaders[ShaderId::TFRAG3].id(), "decal");
+  m_uniforms.use_wind_camera =
+      glGetUniformLocation(shaders[ShaderId::TFRAG3].id(), "use_wind_camera");
+  m_uniforms.wind_instance = glGetUniformLocation(shaders[ShaderId::TFRAG3].id(), "wind_instance");
 
   m_etie_uniforms.persp0 = glGetUniformLocation(shaders[ShaderId::ETIE].id(), "persp0");
   m_etie_uniforms.persp1 = glGetUniformLocation(shaders[ShaderId::ETIE].id(), "persp1");
@@ -50,7 +66,7 @@ void Tie3::init_shaders(ShaderLibrary& shaders) {
  * This often causes stutters, so as much as possible, we move stuff to the loader,
  * and this function just updates things to reference loader data.
  */
-void Tie3::load_from_fr3_data(const LevelData* loader_data) {
+void Tie3::load_from_fr3_data(const LevelData* loader_data, SharedRenderState* render_state) {
   auto ul = scoped_prof("update-load");
   const tfrag3::Level* lev_data = loader_data->level.get();
   m_wind_vectors.clear();
@@ -62,8 +78,12 @@ void Tie3::load_from_fr3_data(const LevelData* loader_data) {
   for (int geo = 0; geo < 4; ++geo) {
     m_trees[geo].resize(lev_data->tie_trees[geo].size());
   }
+  // every geom has the same trees, with the same BVH.
+  m_tree_lods.assign(lev_data->tie_trees[0].size(), LodSelection());
 
   u16 max_wind_idx = 0;
+  // wind on the GPU does all instances of a tree at once, so they can't share wind vectors.
+  bool gpu_wind_ok = true;
   // loop over all "geos" (level of details)
   for (u32 l_geo = 0; l_geo < tfrag3::TIE_GEOS; l_geo++) {
     // loop over all trees
@@ -100,6 +120,8 @@ void Tie3::load_from_fr3_data(const LevelData* loader_data) {
       lod_tree[l_tree].colors = &tree.colors;
       // visibility BVH from FR3
       lod_tree[l_tree].vis = &tree.bvh;
+      lod_tree[l_tree].vis_soa = make_vis_nodes_soa(tree.bvh.vis_nodes);
+      lod_tree[l_tree].gpu_cull = make_gpu_cull_data(tree.static_draws, tree.bvh.vis_nodes);
       // indices from FR3 (needed on CPU for culling)
       lod_tree[l_tree].index_data = tree.unpacked.indices.data();
       // wind metadata
@@ -107,6 +129,7 @@ void Tie3::load_from_fr3_data(const LevelData* loader_data) {
       lod_tree[l_tree].wind_draws = &tree.instanced_wind_draws;
       // preprocess colors for faster interpolation (TODO: move to loader)
       lod_tree[l_tree].tod_cache = swizzle_time_of_day(tree.colors);
+      lod_tree[l_tree].tod_dirty.invalidate();
       // OpenGL index buffer (fixed index buffer for multidraw system)
       lod_tree[l_tree].index_buffer = loader_data->tie_data[l_geo][l_tree].index_buffer;
       lod_tree[l_tree].category_draw_indices = tree.category_draw_indices;
@@ -171,6 +194,36 @@ void Tie3::load_from_fr3_data(const LevelData* loader_data) {
           lod_tree[l_tree].wind_vertex_index_offsets.push_back(off);
           off += draw.vertex_index_stream.size();
         }
+
+        std::vector<GpuWindInstance> gpu_instances(tree.wind_instance_info.size());
+        std::vector<u16> wind_indices;
+        for (size_t i = 0; i < gpu_instances.size(); i++) {
+          const auto& info = tree.wind_instance_info[i];
+          for (int j = 0; j < 4; j++) {
+            gpu_instances[i].matrix[j] = info.matrix[j];
+          }
+          gpu_instances[i].wind_idx = info.wind_idx;
+          gpu_instances[i].stiffness = info.stiffness;
+          wind_indices.push_back(info.wind_idx);
+        }
+        std::sort(wind_indices.begin(), wind_indices.end());
+        if (std::adjacent_find(wind_indices.begin(), wind_indices.end()) != wind_indices.end()) {
+          gpu_wind_ok = false;
+        }
+        auto& gpu_tree = lod_tree[l_tree];
+        glGenBuffers(1, &gpu_tree.wind_instance_buffer);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, gpu_tree.wind_instance_buffer);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, gpu_instances.size() * sizeof(GpuWindInstance),
+                     gpu_instances.data(), GL_STATIC_DRAW);
+        gl_label(GL_BUFFER, gpu_tree.wind_instance_buffer,
+                 fmt::format("{}-tie-wind-instances-{}-{}", lev_data->level_name, l_geo, l_tree));
+        glGenBuffers(1, &gpu_tree.wind_camera_buffer);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, gpu_tree.wind_camera_buffer);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, gpu_instances.size() * sizeof(float) * 16, nullptr,
+                     GL_DYNAMIC_COPY);
+        gl_label(GL_BUFFER, gpu_tree.wind_camera_buffer,
+                 fmt::format("{}-tie-wind-cameras-{}-{}", lev_data->level_name, l_geo, l_tree));
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
       }
 
       // set up per-proto visibility. Jak 2 needs to enable/disable individual protos.
@@ -180,9 +233,9 @@ void Tie3::load_from_fr3_data(const LevelData* loader_data) {
       }
 
       // set up time of day texture.
-      glActiveTexture(GL_TEXTURE10);
+      render_state->gl_state.active_texture(GL_TEXTURE10);
       glGenTextures(1, &lod_tree[l_tree].time_of_day_texture);
-      glBindTexture(GL_TEXTURE_1D, lod_tree[l_tree].time_of_day_texture);
+      render_state->gl_state.bind_texture(GL_TEXTURE_1D, lod_tree[l_tree].time_of_day_texture);
       glTexImage1D(GL_TEXTURE_1D, 0, GL_RGBA, TIME_OF_DAY_COLOR_COUNT, 0, GL_RGBA,
                    GL_UNSIGNED_INT_8_8_8_8, nullptr);
       glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
@@ -203,6 +256,14 @@ void Tie3::load_from_fr3_data(const LevelData* loader_data) {
   // set up temporary caches. These are just temporary, so they don't need per-tree versions.
 
   m_wind_vectors.resize(4 * max_wind_idx + 4);  // 4x u32's per wind.
+  if (gpu_wind_ok) {
+    glGenBuffers(1, &m_wind_state_buffer);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_wind_state_buffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, m_wind_vectors.size() * sizeof(float),
+                 m_wind_vectors.data(), GL_DYNAMIC_COPY);
+    gl_label(GL_BUFFER, m_wind_state_buffer, lev_data->level_name + "-tie-wind-state");
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+  }
 
   // ASSERT(time_of_day_count <= TIME_OF_DAY_COLOR_COUNT);
 }
@@ -239,7 +300,7 @@ bool Tie3::try_loading_level(const std::string& level, SharedRenderState* render
   // see if this is the first time we've gotten the level
   if (m_level_name != level) {
     // it is! do the one time load.
-    load_from_fr3_data(lev_data);
+    load_from_fr3_data(lev_data, render_state);
     m_has_level = true;
     m_level_name = level;
   } else {
@@ -261,10 +322,20 @@ void Tie3::discard_tree_cache() {
       // glDeleteBuffers(1, &tree.index_buffer);
       glDeleteBuffers(1, &tree.single_draw_index_buffer);
       glDeleteVertexArrays(1, &tree.vao);
+      free_gpu_cull_data(tree.gpu_cull);
+      if (tree.wind_instance_buffer) {
+        glDeleteBuffers(1, &tree.wind_instance_buffer);
+        glDeleteBuffers(1, &tree.wind_camera_buffer);
+      }
     }
 
     m_trees[geo].clear();
   }
+  if (m_wind_state_buffer) {
+    glDeleteBuffers(1, &m_wind_state_buffer);
+    m_wind_state_buffer = 0;
+  }
+  m_wind_state_on_gpu = false;
 }
 
 bool Tie3::set_up_common_data_from_dma(DmaFollower& dma, SharedRenderState* render_state) {
@@ -350,6 +421,8 @@ bool Tie3::set_up_common_data_from_dma(DmaFollower& dma, SharedRenderState* rend
 
   if (render_state->occlusion_vis[m_level_id].valid) {
     m_common_data.settings.occlusion_culling = render_state->occlusion_vis[m_level_id].data;
+    m_common_data.settings.occlusion_culling_version =
+        render_state->occlusion_vis[m_level_id].version;
   } else {
     m_common_data.settings.occlusion_culling = 0;
   }
@@ -378,7 +451,8 @@ void Tie3::render(DmaFollower& dma, SharedRenderState* render_state, ScopedProfi
 
   if (set_up_common_data_from_dma(dma, render_state)) {
     setup_all_trees(lod(), m_common_data.settings, m_common_data.proto_vis_data,
-                    m_common_data.proto_vis_data_size, !render_state->no_multidraw, prof);
+                    m_common_data.proto_vis_data_size, !render_state->no_multidraw, render_state,
+                    prof);
 
     draw_matching_draws_for_all_trees(lod(), m_common_data.settings, render_state, prof,
                                       m_default_category);
@@ -399,8 +473,10 @@ void Tie3::draw_matching_draws_for_all_trees(int geom,
                                              SharedRenderState* render_state,
                                              ScopedProfilerNode& prof,
                                              tfrag3::TieCategory category) {
-  for (u32 i = 0; i < m_trees[geom].size(); i++) {
-    draw_matching_draws_for_tree(i, geom, settings, render_state, prof, category);
+  for (int lod_geom = geom; lod_geom <= m_last_geom; lod_geom++) {
+    for (u32 i = 0; i < m_trees[lod_geom].size(); i++) {
+      draw_matching_draws_for_tree(i, lod_geom, settings, render_state, prof, category);
+    }
   }
 }
 
@@ -409,9 +485,25 @@ void Tie3::setup_all_trees(int geom,
                            const u8* proto_vis_data,
                            size_t proto_vis_data_size,
                            bool use_multidraw,
+                           SharedRenderState* render_state,
                            ScopedProfilerNode& prof) {
-  for (u32 i = 0; i < m_trees[geom].size(); i++) {
-    setup_tree(i, geom, settings, proto_vis_data, proto_vis_data_size, use_multidraw, prof);
+  // with the automatic lod, each instance is drawn with geom or one of the lower detail geoms after
+  // it.
+  m_auto_lod = Gfx::g_global_settings.lod_auto && !m_debug_all_visible;
+  m_last_geom = m_auto_lod ? (int)m_trees.size() - 1 : geom;
+  if (m_auto_lod) {
+    float focal_length = camera_focal_length_pixels(settings.planes, render_state->draw_region_h);
+    for (u32 i = 0; i < m_trees[geom].size(); i++) {
+      select_lods(&m_tree_lods.at(i), m_trees[geom][i].vis_soa, render_state->camera_pos,
+                  focal_length, Gfx::g_global_settings.lod_auto_pixels, geom, m_last_geom);
+    }
+  }
+
+  for (int lod_geom = geom; lod_geom <= m_last_geom; lod_geom++) {
+    for (u32 i = 0; i < m_trees[lod_geom].size(); i++) {
+      setup_tree(i, lod_geom, settings, proto_vis_data, proto_vis_data_size, use_multidraw,
+                 render_state, prof);
+    }
   }
 }
 
@@ -421,6 +513,7 @@ void Tie3::setup_tree(int idx,
                       const u8* proto_vis_data,
                       size_t proto_vis_data_size,
                       bool use_multidraw,
+                      SharedRenderState* render_state,
                       ScopedProfilerNode& prof) {
   // reset perf
   auto& tree = m_trees.at(geom).at(idx);
@@ -429,33 +522,72 @@ void Tie3::setup_tree(int idx,
     return;
   }
 
-  // update time of day
-  if (m_color_result.size() < tree.colors->size()) {
-    m_color_result.resize(tree.colors->size());
-  }
+  // update time of day, if the weights changed since the last upload.
+  render_state->gl_state.active_texture(GL_TEXTURE10);
+  render_state->gl_state.bind_texture(GL_TEXTURE_1D, tree.time_of_day_texture);
+  if (tree.tod_dirty.needs_update(settings.itimes, m_use_fast_time_of_day)) {
+    if (m_color_result.size() < tree.colors->size()) {
+      m_color_result.resize(tree.colors->size());
+    }
 
-  if (m_use_fast_time_of_day) {
-    interp_time_of_day_fast(settings.itimes, tree.tod_cache, m_color_result.data());
-  } else {
-    interp_time_of_day_slow(settings.itimes, *tree.colors, m_color_result.data());
-  }
+    if (m_use_fast_time_of_day) {
+      interp_time_of_day_fast(settings.itimes, tree.tod_cache, m_color_result.data());
+    } else {
+      interp_time_of_day_slow(settings.itimes, *tree.colors, m_color_result.data());
+    }
 
-  glActiveTexture(GL_TEXTURE10);
-  glBindTexture(GL_TEXTURE_1D, tree.time_of_day_texture);
-  glTexSubImage1D(GL_TEXTURE_1D, 0, 0, tree.colors->size(), GL_RGBA, GL_UNSIGNED_INT_8_8_8_8_REV,
-                  m_color_result.data());
+    glTexSubImage1D(GL_TEXTURE_1D, 0, 0, tree.colors->size(), GL_RGBA,
+                    GL_UNSIGNED_INT_8_8_8_8_REV, m_color_result.data());
+  }
 
   // update proto vis mask
   if (proto_vis_data) {
     tree.proto_visibility.update(proto_vis_data, proto_vis_data_size);
   }
 
+  // the culling shader doesn't know about lods.
+  tree.gpu_culled =
+      use_multidraw && render_state->use_gpu_culling && tree.gpu_cull.valid() && !m_auto_lod;
+  if (tree.gpu_culled || m_debug_all_visible) {
+    tree.culled_with = CullingKey();
+  }
+  if (tree.gpu_culled) {
+    gpu_cull(tree.gpu_cull, render_state, settings,
+             tree.has_proto_visibility ? &tree.proto_visibility.vis_flags : nullptr,
+             m_debug_all_visible);
+    // wind draws are still culled on the CPU. The triangle count isn't known on the CPU.
+    if (!m_debug_all_visible && !tree.wind_draws->empty()) {
+      cull_check_all_fast(settings.planes, tree.vis_soa, settings.occlusion_culling,
+                          tree.vis_temp.data());
+    }
+    return;
+  }
+
+  // if nothing that affects culling has changed, the draw lists (and the index buffer) from last
+  // time are still good.
+  CullingKey key(settings, use_multidraw,
+                 tree.has_proto_visibility ? tree.proto_visibility.version : 0,
+                 m_auto_lod ? m_tree_lods.at(idx).version : 0);
+  if (!m_debug_all_visible && key == tree.culled_with) {
+    prof.add_tri(tree.culled_tris);
+    return;
+  }
+
   if (!m_debug_all_visible) {
     // need culling data
-    cull_check_all_slow(settings.planes, tree.vis->vis_nodes, settings.occlusion_culling,
+    cull_check_all_fast(settings.planes, tree.vis_soa, settings.occlusion_culling,
                         tree.vis_temp.data());
   }
 
+  // the static draws only draw the nodes that use this geom. Wind instances are drawn with the
+  // first geom only, because drawing them steps the wind, so they use the unmasked visibility.
+  const std::vector<u8>* vis = &tree.vis_temp;
+  if (m_auto_lod) {
+    m_lod_vis_temp.assign(tree.vis_temp.begin(), tree.vis_temp.end());
+    mask_vis_by_lod(m_lod_vis_temp.data(), m_tree_lods.at(idx), geom);
+    vis = &m_lod_vis_temp;
+  }
+
   u32 num_tris = 0;
   if (use_multidraw) {
     if (m_debug_all_visible) {
@@ -467,12 +599,12 @@ void Tie3::setup_tree(int idx,
       if (tree.has_proto_visibility) {
         num_tris = make_multidraws_from_vis_and_proto_string(
             tree.multidraw_offset_per_stripdraw.data(), tree.multidraw_count_buffer.data(),
-            tree.multidraw_index_offset_buffer.data(), *tree.draws, tree.vis_temp,
+            tree.multidraw_index_offset_buffer.data(), *tree.draws, *vis,
             tree.proto_visibility.vis_flags);
       } else {
         num_tris = make_multidraws_from_vis_string(
             tree.multidraw_offset_per_stripdraw.data(), tree.multidraw_count_buffer.data(),
-            tree.multidraw_index_offset_buffer.data(), *tree.draws, tree.vis_temp);
+            tree.multidraw_index_offset_buffer.data(), *tree.draws, *vis);
       }
     }
   } else {
@@ -484,12 +616,12 @@ void Tie3::setup_tree(int idx,
     } else {
       if (tree.has_proto_visibility) {
         idx_buffer_size = make_index_list_from_vis_and_proto_string(
-            tree.draw_idx_temp.data(), tree.index_temp.data(), *tree.draws, tree.vis_temp,
+            tree.draw_idx_temp.data(), tree.index_temp.data(), *tree.draws, *vis,
             tree.proto_visibility.vis_flags, tree.index_data, &num_tris);
       } else {
         idx_buffer_size =
             make_index_list_from_vis_string(tree.draw_idx_temp.data(), tree.index_temp.data(),
-                                            *tree.draws, tree.vis_temp, tree.index_data, &num_tris);
+                                            *tree.draws, *vis, tree.index_data, &num_tris);
       }
     }
 
@@ -498,6 +630,10 @@ void Tie3::setup_tree(int idx,
                  GL_STREAM_DRAW);
   }
 
+  if (!m_debug_all_visible) {
+    tree.culled_with = key;
+    tree.culled_tris = num_tris;
+  }
   prof.add_tri(num_tris);
 }
 
@@ -561,11 +697,11 @@ void Tie3::draw_matching_draws_for_tree(int idx,
   glBindBuffer(GL_ELEMENT_ARRAY_BUFFER,
                render_state->no_multidraw ? tree.single_draw_index_buffer : tree.index_buffer);
 
-  glActiveTexture(GL_TEXTURE10);
-  glBindTexture(GL_TEXTURE_1D, tree.time_of_day_texture);
+  render_state->gl_state.active_texture(GL_TEXTURE10);
+  render_state->gl_state.bind_texture(GL_TEXTURE_1D, tree.time_of_day_texture);
 
-  glActiveTexture(GL_TEXTURE0);
-  glEnable(GL_PRIMITIVE_RESTART);
+  render_state->gl_state.active_texture(GL_TEXTURE0);
+  render_state->gl_state.enable(GL_PRIMITIVE_RESTART);
   glPrimitiveRestartIndex(UINT32_MAX);
 
   int last_texture = -1;
@@ -575,7 +711,11 @@ void Tie3::draw_matching_draws_for_tree(int idx,
     const auto& multidraw_indices = tree.multidraw_offset_per_stripdraw[draw_idx];
     const auto& singledraw_indices = tree.draw_idx_temp[draw_idx];
 
-    if (render_state->no_multidraw) {
+    if (tree.gpu_culled) {
+      if (tree.gpu_cull.commands_per_draw[draw_idx].second == 0) {
+        continue;
+      }
+    } else if (render_state->no_multidraw) {
       if (singledraw_indices.second == 0) {
         continue;
       }
@@ -586,7 +726,7 @@ void Tie3::draw_matching_draws_for_tree(int idx,
     }
 
     if ((int)draw.tree_tex_id != last_texture) {
-      glBindTexture(GL_TEXTURE_2D, m_textures->at(draw.tree_tex_id));
+      render_state->gl_state.bind_texture(GL_TEXTURE_2D, m_textures->at(draw.tree_tex_id));
       last_texture = draw.tree_tex_id;
     }
 
@@ -598,7 +738,9 @@ void Tie3::draw_matching_draws_for_tree(int idx,
 
     prof.add_draw_call();
 
-    if (render_state->no_multidraw) {
+    if (tree.gpu_culled) {
+      multidraw_gpu_culled(GL_TRIANGLE_STRIP, tree.gpu_cull, draw_idx);
+    } else if (render_state->no_multidraw) {
       glDrawElements(GL_TRIANGLE_STRIP, singledraw_indices.second, GL_UNSIGNED_INT,
                      (void*)(singledraw_indices.first * sizeof(u32)));
     } else {
@@ -617,8 +759,10 @@ void Tie3::draw_matching_draws_for_tree(int idx,
                     -10.f);
         glUniform1f(glGetUniformLocation(render_state->shaders[ShaderId::TFRAG3].id(), "alpha_max"),
                     double_draw.aref_second);
-        glDepthMask(GL_FALSE);
-        if (render_state->no_multidraw) {
+        render_state->gl_state.depth_mask(false);
+        if (tree.gpu_culled) {
+          multidraw_gpu_culled(GL_TRIANGLE_STRIP, tree.gpu_cull, draw_idx);
+        } else if (render_state->no_multidraw) {
           glDrawElements(GL_TRIANGLE_STRIP, singledraw_indices.second, GL_UNSIGNED_INT,
                          (void*)(singledraw_indices.first * sizeof(u32)));
         } else {
@@ -633,7 +777,7 @@ void Tie3::draw_matching_draws_for_tree(int idx,
     }
   }
 
-  if (!m_hide_wind && category == tfrag3::TieCategory::NORMAL) {
+  if (!m_hide_wind && category == tfrag3::TieCategory::NORMAL && geom == lod()) {
     auto wind_prof = prof.make_scoped_child("wind");
     render_tree_wind(idx, geom, settings, render_state, wind_prof);
   }
@@ -667,7 +811,11 @@ void Tie3::envmap_second_pass_draw(const Tree& tree,
     const auto& multidraw_indices = tree.multidraw_offset_per_stripdraw[draw_idx];
     const auto& singledraw_indices = tree.draw_idx_temp[draw_idx];
 
-    if (render_state->no_multidraw) {
+    if (tree.gpu_culled) {
+      if (tree.gpu_cull.commands_per_draw[draw_idx].second == 0) {
+        continue;
+      }
+    } else if (render_state->no_multidraw) {
       if (singledraw_indices.second == 0) {
         continue;
       }
@@ -678,7 +826,7 @@ void Tie3::envmap_second_pass_draw(const Tree& tree,
     }
 
     if ((int)draw.tree_tex_id != last_texture) {
-      glBindTexture(GL_TEXTURE_2D, m_textures->at(draw.tree_tex_id));
+      render_state->gl_state.bind_texture(GL_TEXTURE_2D, m_textures->at(draw.tree_tex_id));
       last_texture = draw.tree_tex_id;
     }
 
@@ -686,7 +834,9 @@ void Tie3::envmap_second_pass_draw(const Tree& tree,
 
     prof.add_draw_call();
 
-    if (render_state->no_multidraw) {
+    if (tree.gpu_culled) {
+      multidraw_gpu_culled(GL_TRIANGLE_STRIP, tree.gpu_cull, draw_idx);
+    } else if (render_state->no_multidraw) {
       glDrawElements(GL_TRIANGLE_STRIP, singledraw_indices.second, GL_UNSIGNED_INT,
                      (void*)(singledraw_indices.first * sizeof(u32)));
     } else {
@@ -721,6 +871,8 @@ void TieProtoVisibility::init(const std::vector<std::string>& names) {
     x = 1;
   }
   all_visible = true;
+  version++;
+  last_data.clear();
   name_to_idx.clear();
   size_t i = 0;
   for (auto& name : names) {
@@ -731,6 +883,12 @@ void TieProtoVisibility::init(const std::vector<std::string>& names) {
 void TieProtoVisibility::update(const u8* data, size_t size) {
   char name_buffer[256];  // ??
 
+  if (last_data.size() == size && !memcmp(last_data.data(), data, size)) {
+    return;
+  }
+  last_data.assign(data, data + size);
+  version++;
+
   if (!all_visible) {
     for (auto& x : vis_flags) {
       x = 1;
@@ -887,9 +1045,18 @@ void Tie3::render_tree_wind(int idx,
     return;
   }
 
+  const bool gpu_wind = render_state->use_gpu_wind && m_wind_state_buffer;
+  move_wind_state(gpu_wind);
+  if (gpu_wind) {
+    run_gpu_wind(tree, settings, render_state);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, tree.wind_camera_buffer);
+  }
+
   // note: this isn't the most efficient because we might compute wind matrices for invisible
   // instances. TODO: add vis ids to the instance info to avoid this
-  memset(tree.wind_matrix_cache.data(), 0, sizeof(float) * 16 * tree.wind_matrix_cache.size());
+  if (!gpu_wind) {
+    memset(tree.wind_matrix_cache.data(), 0, sizeof(float) * 16 * tree.wind_matrix_cache.size());
+  }
   auto& cam_bad = settings.math_camera;
   std::array<math::Vector4f, 4> cam;
   for (int i = 0; i < 4; i++) {
@@ -898,7 +1065,7 @@ void Tie3::render_tree_wind(int idx,
     }
   }
 
-  for (size_t inst_id = 0; inst_id < tree.instance_info->size(); inst_id++) {
+  for (size_t inst_id = 0; !gpu_wind && inst_id < tree.instance_info->size(); inst_id++) {
     auto& info = tree.instance_info->operator[](inst_id);
     auto& out = tree.wind_matrix_cache[inst_id];
     // auto& mat = tree.instance_info->operator[](inst_id).matrix;
@@ -937,10 +1104,11 @@ void Tie3::render_tree_wind(int idx,
     const auto& draw = tree.wind_draws->operator[](draw_idx);
 
     if ((int)draw.tree_tex_id != last_texture) {
-      glBindTexture(GL_TEXTURE_2D, m_textures->at(draw.tree_tex_id));
+      render_state->gl_state.bind_texture(GL_TEXTURE_2D, m_textures->at(draw.tree_tex_id));
       last_texture = draw.tree_tex_id;
     }
     auto double_draw = setup_tfrag_shader(render_state, draw.mode, ShaderId::TFRAG3);
+    glUniform1i(m_uniforms.use_wind_camera, gpu_wind);
 
     int off = 0;
     for (auto& grp : draw.instance_groups) {
@@ -949,9 +1117,13 @@ void Tie3::render_tree_wind(int idx,
         continue;  // invisible, skip.
       }
 
-      glUniformMatrix4fv(
-          glGetUniformLocation(render_state->shaders[ShaderId::TFRAG3].id(), "camera"), 1, GL_FALSE,
-          tree.wind_matrix_cache.at(grp.instance_idx)[0].data());
+      if (gpu_wind) {
+        glUniform1i(m_uniforms.wind_instance, grp.instance_idx);
+      } else {
+        glUniformMatrix4fv(
+            glGetUniformLocation(render_state->shaders[ShaderId::TFRAG3].id(), "camera"), 1,
+            GL_FALSE, tree.wind_matrix_cache.at(grp.instance_idx)[0].data());
+      }
 
       prof.add_draw_call();
       prof.add_tri(grp.num);
@@ -972,7 +1144,7 @@ void Tie3::render_tree_wind(int idx,
           glUniform1f(
               glGetUniformLocation(render_state->shaders[ShaderId::TFRAG3].id(), "alpha_max"),
               double_draw.aref_second);
-          glDepthMask(GL_FALSE);
+          render_state->gl_state.depth_mask(false);
           glDrawElements(GL_TRIANGLE_STRIP, draw.vertex_index_stream.size(), GL_UNSIGNED_INT,
                          (void*)0);
           break;
@@ -981,6 +1153,56 @@ void Tie3::render_tree_wind(int idx,
       }
     }
   }
+
+  // the other tfrag3 draws use the camera uniform.
+  glUniform1i(m_uniforms.use_wind_camera, 0);
+}
+
+/*!
+ * Step the wind of every instance in the tree and make their camera matrices, in the tie_wind
+ * compute shader. Only the wind parameters for this frame are uploaded.
+ */
+void Tie3::run_gpu_wind(const Tree& tree,
+                        const TfragRenderSettings& settings,
+                        SharedRenderState* render_state) {
+  u32 count = tree.instance_info->size();
+  if (!count) {
+    return;
+  }
+  render_state->shaders[ShaderId::TIE_WIND].activate();
+  glUniformMatrix4fv(0, 1, GL_FALSE, settings.math_camera.data());
+  glUniform1ui(4, count);
+  glUniform1f(5, m_wind_multiplier);
+  glUniform1ui(6, m_wind_data.wind_time);
+  glUniform1ui(7, m_wind_data.paused);
+  glUniform4fv(8, 64, m_wind_data.wind_array[0].data());
+  glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, tree.wind_instance_buffer);
+  glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, m_wind_state_buffer);
+  glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, tree.wind_camera_buffer);
+  glDispatchCompute((count + 63) / 64, 1, 1);
+  // the next tree may step the same wind vectors, and the draws read the matrices.
+  glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+}
+
+/*!
+ * The wind vectors are updated every frame, by the CPU or the GPU. When switching, copy them over
+ * so the wind doesn't jump.
+ */
+void Tie3::move_wind_state(bool to_gpu) {
+  if (to_gpu == m_wind_state_on_gpu || !m_wind_state_buffer) {
+    return;
+  }
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_wind_state_buffer);
+  if (to_gpu) {
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, m_wind_vectors.size() * sizeof(float),
+                    m_wind_vectors.data());
+  } else {
+    glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, m_wind_vectors.size() * sizeof(float),
+                       m_wind_vectors.data());
+  }
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+  m_wind_state_on_gpu = to_gpu;
 }
 
 Tie3AnotherCategory::Tie3AnotherCategory(const std::string& name,
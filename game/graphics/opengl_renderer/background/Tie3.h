@@ -17,6 +17,9 @@ struct TieProtoVisibility {
   std::unordered_map<std::string, std::vector<u32>> name_to_idx;
 
   bool all_visible = true;
+  // changes when vis_flags might have. The game sends the same data most frames.
+  u64 version = 0;
+  std::vector<u8> last_data;
 };
 
 struct EtieUniforms {
@@ -43,6 +46,7 @@ class Tie3 : public BucketRenderer {
                        const u8* proto_vis_data,
                        size_t proto_vis_data_size,
                        bool use_multidraw,
+                       SharedRenderState* render_state,
                        ScopedProfilerNode& prof);
 
   void setup_tree(int idx,
@@ -51,6 +55,7 @@ class Tie3 : public BucketRenderer {
                   const u8* proto_vis_data,
                   size_t proto_vis_data_size,
                   bool use_multidraw,
+                  SharedRenderState* render_state,
                   ScopedProfilerNode& prof);
 
   void draw_matching_draws_for_all_trees(int geom,
@@ -86,7 +91,7 @@ class Tie3 : public BucketRenderer {
   int lod() const { return Gfx::g_global_settings.lod_tie; }
 
  private:
-  void load_from_fr3_data(const LevelData* loader_data);
+  void load_from_fr3_data(const LevelData* loader_data, SharedRenderState* render_state);
   void discard_tree_cache();
   void render_tree_wind(int idx,
                         int geom,
@@ -117,9 +122,16 @@ class Tie3 : public BucketRenderer {
     const std::vector<tfrag3::TieWindInstance>* instance_info = nullptr;
     const std::vector<tfrag3::TimeOfDayColor>* colors = nullptr;
     const tfrag3::BVH* vis = nullptr;
+    VisNodesSoA vis_soa;
+    GpuCullData gpu_cull;
+    bool gpu_culled = false;  // if the draws for this frame were culled by gpu_cull
     const u32* index_data = nullptr;
     SwizzledTimeOfDay tod_cache;
+    TimeOfDayDirtyCheck tod_dirty;
     std::vector<std::array<math::Vector4f, 4>> wind_matrix_cache;
+    // for wind on the GPU: the instances, and the camera matrix of each instance.
+    GLuint wind_instance_buffer = 0;
+    GLuint wind_camera_buffer = 0;
     GLuint wind_vertex_index_buffer;
     std::vector<u32> wind_vertex_index_offsets;
     bool has_proto_visibility = false;
@@ -131,6 +143,9 @@ class Tie3 : public BucketRenderer {
     std::vector<std::pair<int, int>> multidraw_offset_per_stripdraw;
     std::vector<GLsizei> multidraw_count_buffer;
     std::vector<void*> multidraw_index_offset_buffer;
+    // what the draw lists above were made with, to skip culling when it hasn't changed.
+    CullingKey culled_with;
+    u32 culled_tris = 0;
   };
 
   void envmap_second_pass_draw(const Tree& tree,
@@ -140,6 +155,12 @@ class Tie3 : public BucketRenderer {
                                tfrag3::TieCategory category);
 
   std::array<std::vector<Tree>, 4> m_trees;  // includes 4 lods!
+  // for each tree, the geom of each node when the lod is picked automatically.
+  std::vector<LodSelection> m_tree_lods;
+  bool m_auto_lod = false;
+  // the trees are drawn with every geom from lod() to this one.
+  int m_last_geom = 0;
+  std::vector<u8> m_lod_vis_temp;
   std::string m_level_name;
   const std::vector<GLuint>* m_textures;
   u64 m_load_id = -1;
@@ -156,7 +177,15 @@ class Tie3 : public BucketRenderer {
 
   TfragPcPortData m_pc_port_data;
 
+  void run_gpu_wind(const Tree& tree,
+                    const TfragRenderSettings& settings,
+                    SharedRenderState* render_state);
+  void move_wind_state(bool to_gpu);
+
   std::vector<float> m_wind_vectors;  // note: I suspect these are shared with shrub.
+  // m_wind_vectors, for wind on the GPU. It's only there if no tree uses a wind vector twice.
+  GLuint m_wind_state_buffer = 0;
+  bool m_wind_state_on_gpu = false;
 
   float m_wind_multiplier = 1.f;
 
@@ -166,6 +195,8 @@ class Tie3 : public BucketRenderer {
 
   struct {
     GLuint decal;
+    GLuint use_wind_camera;
+    GLuint wind_instance;
   } m_uniforms;
 
   EtieUniforms m_etie_uniforms, m_etie_base_uniforms;
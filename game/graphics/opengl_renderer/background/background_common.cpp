@@ -2,6 +2,8 @@
 
 #include "background_common.h"
 
+#include <algorithm>
+#include <cmath>
 #include <immintrin.h>
 
 #include "common/util/os.h"
@@ -9,29 +11,32 @@
 #include "game/graphics/opengl_renderer/BucketRenderer.h"
 #include "game/graphics/pipelines/opengl.h"
 
-DoubleDraw setup_opengl_from_draw_mode(DrawMode mode, u32 tex_unit, bool mipmap) {
-  glActiveTexture(tex_unit);
+DoubleDraw setup_opengl_from_draw_mode(SharedRenderState* render_state,
+                                       DrawMode mode,
+                                       u32 tex_unit,
+                                       bool mipmap) {
+  render_state->gl_state.active_texture(tex_unit);
 
   if (mode.get_zt_enable()) {
-    glEnable(GL_DEPTH_TEST);
+    render_state->gl_state.enable(GL_DEPTH_TEST);
     switch (mode.get_depth_test()) {
       case GsTest::ZTest::NEVER:
-        glDepthFunc(GL_NEVER);
+        render_state->gl_state.depth_func(GL_NEVER);
         break;
       case GsTest::ZTest::ALWAYS:
-        glDepthFunc(GL_ALWAYS);
+        render_state->gl_state.depth_func(GL_ALWAYS);
         break;
       case GsTest::ZTest::GEQUAL:
-        glDepthFunc(GL_GEQUAL);
+        render_state->gl_state.depth_func(GL_GEQUAL);
         break;
       case GsTest::ZTest::GREATER:
-        glDepthFunc(GL_GREATER);
+        render_state->gl_state.depth_func(GL_GREATER);
         break;
       default:
         ASSERT(false);
     }
   } else {
-    glDisable(GL_DEPTH_TEST);
+    render_state->gl_state.disable(GL_DEPTH_TEST);
   }
 
   DoubleDraw double_draw;
@@ -45,32 +50,34 @@ DoubleDraw setup_opengl_from_draw_mode(DrawMode mode, u32 tex_unit, bool mipmap)
         // (SRC - SRC) * alpha + SRC = SRC, no blend.
         break;
       case DrawMode::AlphaBlend::SRC_DST_SRC_DST:
-        glBlendEquation(GL_FUNC_ADD);
-        glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ZERO);
+        render_state->gl_state.blend_equation(GL_FUNC_ADD);
+        render_state->gl_state.blend_func_separate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE,
+                                                   GL_ZERO);
         break;
       case DrawMode::AlphaBlend::SRC_0_SRC_DST:
-        glBlendEquation(GL_FUNC_ADD);
-        glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE, GL_ONE, GL_ZERO);
+        render_state->gl_state.blend_equation(GL_FUNC_ADD);
+        render_state->gl_state.blend_func_separate(GL_SRC_ALPHA, GL_ONE, GL_ONE, GL_ZERO);
         break;
       case DrawMode::AlphaBlend::SRC_0_FIX_DST:
-        glBlendEquation(GL_FUNC_ADD);
-        glBlendFuncSeparate(GL_ONE, GL_ONE, GL_ONE, GL_ZERO);
+        render_state->gl_state.blend_equation(GL_FUNC_ADD);
+        render_state->gl_state.blend_func_separate(GL_ONE, GL_ONE, GL_ONE, GL_ZERO);
         break;
       case DrawMode::AlphaBlend::SRC_DST_FIX_DST:
         // Cv = (Cs - Cd) * FIX + Cd
         // Cs * FIX * 0.5
         // Cd * FIX * 0.5
-        glBlendEquation(GL_FUNC_ADD);
-        glBlendFuncSeparate(GL_CONSTANT_COLOR, GL_CONSTANT_COLOR, GL_ONE, GL_ZERO);
-        glBlendColor(0.5, 0.5, 0.5, 0.5);
+        render_state->gl_state.blend_equation(GL_FUNC_ADD);
+        render_state->gl_state.blend_func_separate(GL_CONSTANT_COLOR, GL_CONSTANT_COLOR, GL_ONE,
+                                                   GL_ZERO);
+        render_state->gl_state.blend_color(0.5, 0.5, 0.5, 0.5);
         break;
       case DrawMode::AlphaBlend::ZERO_SRC_SRC_DST:
-        glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE, GL_ONE, GL_ZERO);
-        glBlendEquation(GL_FUNC_REVERSE_SUBTRACT);
+        render_state->gl_state.blend_func_separate(GL_SRC_ALPHA, GL_ONE, GL_ONE, GL_ZERO);
+        render_state->gl_state.blend_equation(GL_FUNC_REVERSE_SUBTRACT);
         break;
       case DrawMode::AlphaBlend::SRC_0_DST_DST:
-        glBlendFunc(GL_DST_ALPHA, GL_ONE);
-        glBlendEquation(GL_FUNC_ADD);
+        render_state->gl_state.blend_func(GL_DST_ALPHA, GL_ONE);
+        render_state->gl_state.blend_equation(GL_FUNC_ADD);
         double_draw.color_mult = 0.5f;
         break;
       default:
@@ -81,31 +88,17 @@ DoubleDraw setup_opengl_from_draw_mode(DrawMode mode, u32 tex_unit, bool mipmap)
   }
 
   if (should_enable_blend) {
-    glEnable(GL_BLEND);
+    render_state->gl_state.enable(GL_BLEND);
   } else {
-    glDisable(GL_BLEND);
+    render_state->gl_state.disable(GL_BLEND);
   }
 
-  if (mode.get_clamp_s_enable()) {
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-  } else {
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-  }
-
-  if (mode.get_clamp_t_enable()) {
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-  } else {
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-  }
-
-  if (mode.get_filt_enable()) {
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
-                    mipmap ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-  } else {
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-  }
+  // the sampler stays bound until the state cache is invalidated, so it applies to anything bound
+  // on this unit afterward, not just the current texture.
+  render_state->gl_state.bind_sampler(
+      tex_unit - GL_TEXTURE0,
+      render_state->draw_mode_samplers.get(mode.get_clamp_s_enable(), mode.get_clamp_t_enable(),
+                                           mode.get_filt_enable(), mipmap));
 
   // for some reason, they set atest NEVER + FB_ONLY to disable depth writes
   bool alpha_hack_to_disable_z_write = false;
@@ -147,16 +140,16 @@ DoubleDraw setup_opengl_from_draw_mode(DrawMode mode, u32 tex_unit, bool mipmap)
   }
 
   if (mode.get_depth_write_enable() && !alpha_hack_to_disable_z_write) {
-    glDepthMask(GL_TRUE);
+    render_state->gl_state.depth_mask(true);
   } else {
-    glDepthMask(GL_FALSE);
+    render_state->gl_state.depth_mask(false);
   }
   double_draw.aref_first = alpha_min;
   return double_draw;
 }
 
 DoubleDraw setup_tfrag_shader(SharedRenderState* render_state, DrawMode mode, ShaderId shader) {
-  auto draw_settings = setup_opengl_from_draw_mode(mode, GL_TEXTURE0, true);
+  auto draw_settings = setup_opengl_from_draw_mode(render_state, mode, GL_TEXTURE0, true);
   auto sh_id = render_state->shaders[shader].id();
   if (auto u_id = glGetUniformLocation(sh_id, "alpha_min"); u_id != -1) {
     glUniform1f(u_id, draw_settings.aref_first);
@@ -430,6 +423,16 @@ void interp_time_of_day_fast(const math::Vector<s32, 4> itimes[4],
   }
 }
 
+bool TimeOfDayDirtyCheck::needs_update(const math::Vector<s32, 4> new_itimes[4], bool use_fast) {
+  if (valid && fast == use_fast && !memcmp(itimes, new_itimes, sizeof(itimes))) {
+    return false;
+  }
+  valid = true;
+  fast = use_fast;
+  memcpy(itimes, new_itimes, sizeof(itimes));
+  return true;
+}
+
 bool sphere_in_view_ref(const math::Vector4f& sphere, const math::Vector4f* planes) {
   math::Vector4f acc =
       planes[0] * sphere.x() + planes[1] * sphere.y() + planes[2] * sphere.z() - planes[3];
@@ -457,6 +460,144 @@ void cull_check_all_slow(const math::Vector4f* planes,
   }
 }
 
+VisNodesSoA make_vis_nodes_soa(const std::vector<tfrag3::VisNode>& nodes) {
+  VisNodesSoA result;
+  result.node_count = nodes.size();
+  u32 padded_count = (nodes.size() + 7) & ~7;
+  // the padding lets us always load 8 nodes at a time. The results for padding are ignored.
+  result.x.resize(padded_count, 0);
+  result.y.resize(padded_count, 0);
+  result.z.resize(padded_count, 0);
+  result.neg_r.resize(padded_count, 0);
+  result.my_id.resize(padded_count, 0xffff);
+  for (size_t i = 0; i < nodes.size(); i++) {
+    result.x[i] = nodes[i].bsphere.x();
+    result.y[i] = nodes[i].bsphere.y();
+    result.z[i] = nodes[i].bsphere.z();
+    result.neg_r[i] = -nodes[i].bsphere.w();
+    result.my_id[i] = nodes[i].my_id;
+  }
+  return result;
+}
+
+/*!
+ * Same as cull_check_all_slow, but checks 8 nodes against all 4 planes at once.
+ * The math is done in the same order as sphere_in_view_ref, so the results are identical.
+ */
+void cull_check_all_fast(const math::Vector4f* planes,
+                         const VisNodesSoA& nodes,
+                         const u8* level_occlusion_string,
+                         u8* out) {
+  __m256 plane_x[4], plane_y[4], plane_z[4], plane_w[4];
+  for (int i = 0; i < 4; i++) {
+    plane_x[i] = _mm256_set1_ps(planes[0][i]);
+    plane_y[i] = _mm256_set1_ps(planes[1][i]);
+    plane_z[i] = _mm256_set1_ps(planes[2][i]);
+    plane_w[i] = _mm256_set1_ps(planes[3][i]);
+  }
+
+  for (u32 base = 0; base < nodes.node_count; base += 8) {
+    const __m256 x = _mm256_loadu_ps(nodes.x.data() + base);
+    const __m256 y = _mm256_loadu_ps(nodes.y.data() + base);
+    const __m256 z = _mm256_loadu_ps(nodes.z.data() + base);
+    const __m256 neg_r = _mm256_loadu_ps(nodes.neg_r.data() + base);
+
+    __m256 in_view = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+    for (int i = 0; i < 4; i++) {
+      __m256 acc = _mm256_mul_ps(plane_x[i], x);
+      acc = _mm256_add_ps(acc, _mm256_mul_ps(plane_y[i], y));
+      acc = _mm256_add_ps(acc, _mm256_mul_ps(plane_z[i], z));
+      acc = _mm256_sub_ps(acc, plane_w[i]);
+      in_view = _mm256_and_ps(in_view, _mm256_cmp_ps(acc, neg_r, _CMP_GT_OQ));
+    }
+    u32 mask = _mm256_movemask_ps(in_view);
+
+    u32 end = std::min(base + 8, nodes.node_count);
+    if (level_occlusion_string) {
+      for (u32 i = base; i < end; i++) {
+        u16 my_id = nodes.my_id[i];
+        bool not_occluded =
+            my_id != 0xffff && level_occlusion_string[my_id / 8] & (1 << (7 - (my_id & 7)));
+        out[i] = not_occluded && (mask & 1);
+        mask >>= 1;
+      }
+    } else {
+      for (u32 i = base; i < end; i++) {
+        out[i] = mask & 1;
+        mask >>= 1;
+      }
+    }
+  }
+}
+
+float camera_focal_length_pixels(const math::Vector4f* planes, float screen_height) {
+  // the planes are transposed, like the culling uses them.
+  auto normal = [&](int i) {
+    return math::Vector3f(planes[0][i], planes[1][i], planes[2][i]).normalized();
+  };
+  // opposite planes meet at the camera, at 180 degrees minus the field of view. The narrower of
+  // the two is the vertical field of view, on a screen that's wider than it is tall.
+  auto fov = [&](int a, int b) {
+    return std::acos(std::clamp(-normal(a).dot(normal(b)), -1.f, 1.f));
+  };
+  float vertical_fov = std::min(fov(0, 1), fov(2, 3));
+  return screen_height / (2.f * std::tan(vertical_fov / 2.f));
+}
+
+void select_lods(LodSelection* lods,
+                 const VisNodesSoA& nodes,
+                 const math::Vector4f& camera_pos,
+                 float focal_length_pixels,
+                 float threshold_pixels,
+                 int min_geom,
+                 int max_geom) {
+  constexpr float kMargin = 1.15f;
+  if (lods->node_geom.size() != nodes.node_count) {
+    lods->node_geom.assign(nodes.node_count, UINT8_MAX);
+  }
+  // the geom for a node that is this big on screen.
+  auto geom_for_size = [&](float pixels) {
+    int geom = min_geom;
+    float threshold = threshold_pixels;
+    while (geom < max_geom && pixels < threshold) {
+      geom++;
+      threshold *= 0.5f;
+    }
+    return geom;
+  };
+
+  bool changed = false;
+  for (u32 i = 0; i < nodes.node_count; i++) {
+    float dx = nodes.x[i] - camera_pos.x();
+    float dy = nodes.y[i] - camera_pos.y();
+    float dz = nodes.z[i] - camera_pos.z();
+    float radius = -nodes.neg_r[i];
+    float dist = std::sqrt(dx * dx + dy * dy + dz * dz);
+    // inside the sphere, it covers the whole screen.
+    float pixels = dist > radius ? radius * focal_length_pixels / dist : 1e30f;
+
+    // the current geom is kept as long as it's right for a size within the margin.
+    u8& geom = lods->node_geom[i];
+    int finest = geom_for_size(pixels * kMargin);
+    int coarsest = geom_for_size(pixels / kMargin);
+    if (geom < finest || geom > coarsest) {
+      geom = geom_for_size(pixels);
+      changed = true;
+    }
+  }
+  if (changed) {
+    lods->version++;
+  }
+}
+
+void mask_vis_by_lod(u8* vis, const LodSelection& lods, int geom) {
+  for (size_t i = 0; i < lods.node_geom.size(); i++) {
+    if (lods.node_geom[i] != geom) {
+      vis[i] = 0;
+    }
+  }
+}
+
 void make_all_visible_multidraws(std::pair<int, int>* draw_ptrs_out,
                                  GLsizei* counts_out,
                                  void** index_offsets_out,
@@ -518,6 +659,30 @@ u32 make_all_visible_index_list(std::pair<int, int>* group_out,
   return idx_buffer_ptr;
 }
 
+CullingKey::CullingKey(const TfragRenderSettings& settings,
+                       bool multidraw,
+                       u64 proto_vis_version,
+                       u64 lod_version)
+    : occlusion_culling(settings.occlusion_culling),
+      occlusion_culling_version(settings.occlusion_culling_version),
+      proto_vis_version(proto_vis_version),
+      lod_version(lod_version),
+      multidraw(multidraw),
+      valid(true) {
+  for (int i = 0; i < 4; i++) {
+    planes[i] = settings.planes[i];
+  }
+}
+
+bool CullingKey::operator==(const CullingKey& other) const {
+  // the planes are compared bit for bit. The culling gives the same result if they're the same.
+  return valid && other.valid && !memcmp(planes, other.planes, sizeof(planes)) &&
+         occlusion_culling == other.occlusion_culling &&
+         occlusion_culling_version == other.occlusion_culling_version &&
+         proto_vis_version == other.proto_vis_version && lod_version == other.lod_version &&
+         multidraw == other.multidraw;
+}
+
 u32 make_multidraws_from_vis_string(std::pair<int, int>* draw_ptrs_out,
                                     GLsizei* counts_out,
                                     void** index_offsets_out,
@@ -782,3 +947,159 @@ void update_render_state_from_pc_settings(SharedRenderState* state, const TfragP
     state->has_pc_data = true;
   }
 }
+
+namespace {
+// layouts must match background_cull.comp
+struct GpuVisNode {
+  math::Vector4f bsphere;
+  u32 my_id;
+  u32 pad[3];
+};
+static_assert(sizeof(GpuVisNode) == 32);
+
+struct GpuVisGroup {
+  u32 first_index;
+  u32 num_inds;
+  u32 vis_idx;
+  u32 proto_idx;
+};
+static_assert(sizeof(GpuVisGroup) == 16);
+
+constexpr u32 kIndirectCommandSize = 5 * sizeof(u32);
+
+GLuint make_static_ssbo(const void* data, u32 size_bytes) {
+  GLuint buffer;
+  glGenBuffers(1, &buffer);
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);
+  glBufferData(GL_SHADER_STORAGE_BUFFER, std::max(size_bytes, 16u), data, GL_STATIC_DRAW);
+  return buffer;
+}
+}  // namespace
+
+GpuCullData make_gpu_cull_data(const std::vector<tfrag3::StripDraw>& draws,
+                               const std::vector<tfrag3::VisNode>& vis_nodes) {
+  GpuCullData result;
+
+  std::vector<GpuVisNode> nodes(vis_nodes.size());
+  u32 max_id = 0;
+  for (size_t i = 0; i < vis_nodes.size(); i++) {
+    nodes[i].bsphere = vis_nodes[i].bsphere;
+    nodes[i].my_id = vis_nodes[i].my_id;
+    nodes[i].pad[0] = nodes[i].pad[1] = nodes[i].pad[2] = 0;
+    if (vis_nodes[i].my_id != 0xffff) {
+      max_id = std::max(max_id, (u32)vis_nodes[i].my_id);
+    }
+  }
+  result.occlusion_bytes = std::min(((max_id / 8 + 1) + 3) & ~3u, (u32)sizeof(LevelVis::data));
+
+  std::vector<GpuVisGroup> groups;
+  for (auto& draw : draws) {
+    result.commands_per_draw.emplace_back(groups.size(), draw.vis_groups.size());
+    u32 iidx = draw.unpacked.idx_of_first_idx_in_full_buffer;
+    for (auto& grp : draw.vis_groups) {
+      groups.push_back({iidx, grp.num_inds, grp.vis_idx_in_pc_bvh, grp.tie_proto_idx});
+      iidx += grp.num_inds;
+    }
+  }
+  result.group_count = groups.size();
+
+  GLint alignment;
+  glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+  result.ssbo_alignment = std::max(alignment, 16);
+
+  result.vis_node_buffer = make_static_ssbo(nodes.data(), nodes.size() * sizeof(GpuVisNode));
+  result.group_buffer = make_static_ssbo(groups.data(), groups.size() * sizeof(GpuVisGroup));
+  glGenBuffers(1, &result.command_buffer);
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, result.command_buffer);
+  glBufferData(GL_SHADER_STORAGE_BUFFER, std::max(result.group_count, 1u) * kIndirectCommandSize,
+               nullptr, GL_DYNAMIC_COPY);
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+  return result;
+}
+
+void free_gpu_cull_data(GpuCullData& data) {
+  if (data.valid()) {
+    glDeleteBuffers(1, &data.vis_node_buffer);
+    glDeleteBuffers(1, &data.group_buffer);
+    glDeleteBuffers(1, &data.command_buffer);
+  }
+  data = GpuCullData();
+}
+
+void gpu_cull(const GpuCullData& data,
+              SharedRenderState* render_state,
+              const TfragRenderSettings& settings,
+              const std::vector<u8>* proto_vis,
+              bool all_visible) {
+  if (!render_state->background_camera.valid) {
+    auto& cam = render_state->background_camera;
+    cam.valid = true;
+    cam.camera = settings.math_camera;
+    cam.hvdf_offset = settings.hvdf_offset;
+    cam.fog_constant = settings.fog.x();
+  }
+  if (!data.group_count) {
+    return;
+  }
+  const u8* occlusion_string = settings.occlusion_culling;
+  render_state->shaders[ShaderId::BACKGROUND_CULL].activate();
+  glUniform4fv(0, 4, settings.planes[0].data());
+  glUniform1ui(4, data.group_count);
+  glUniform1ui(5, occlusion_string != nullptr);
+  glUniform1ui(6, proto_vis != nullptr);
+  glUniform1ui(7, all_visible);
+
+  const auto& pyramid = render_state->depth_pyramid;
+  const bool use_pyramid = render_state->use_depth_pyramid_culling && pyramid.valid;
+  glUniform1ui(8, use_pyramid);
+  if (use_pyramid) {
+    // same as SCISSOR_ADJUST * HEIGHT_SCALE in tfrag3.vert
+    const float y_scale = render_state->version == GameVersion::Jak1 ? 512.f / 448.f
+                                                                     : 512.f / 416.f * 0.5f;
+    glUniformMatrix4fv(9, 1, GL_FALSE, pyramid.camera.camera.data());
+    glUniform4fv(13, 1, pyramid.camera.hvdf_offset.data());
+    glUniform1f(14, pyramid.camera.fog_constant);
+    glUniform1f(15, y_scale);
+    glUniform2i(16, pyramid.screen_w, pyramid.screen_h);
+    glUniform1i(17, pyramid.levels);
+    render_state->gl_state.active_texture(GL_TEXTURE12);
+    render_state->gl_state.bind_texture(GL_TEXTURE_2D, pyramid.texture);
+    render_state->gl_state.active_texture(GL_TEXTURE0);
+  }
+
+  // the shader reads these as u32's, so pad them to a multiple of 4 bytes.
+  static const u8 kZeros[4] = {0, 0, 0, 0};
+  auto& ring = render_state->stream_buffer;
+  u32 proto_vis_size = proto_vis ? (proto_vis->size() + 3) & ~3 : 0;
+  ring.reserve((occlusion_string ? data.occlusion_bytes : 4) + std::max(proto_vis_size, 4u) +
+               2 * data.ssbo_alignment);
+  if (occlusion_string) {
+    u32 offset = ring.upload(occlusion_string, data.occlusion_bytes, data.ssbo_alignment);
+    glBindBufferRange(GL_SHADER_STORAGE_BUFFER, 2, ring.buffer(), offset, data.occlusion_bytes);
+  } else {
+    u32 offset = ring.upload(kZeros, 4, data.ssbo_alignment);
+    glBindBufferRange(GL_SHADER_STORAGE_BUFFER, 2, ring.buffer(), offset, 4);
+  }
+  if (proto_vis && !proto_vis->empty()) {
+    u32 offset =
+        ring.upload(proto_vis->data(), proto_vis->size(), data.ssbo_alignment, proto_vis_size);
+    glBindBufferRange(GL_SHADER_STORAGE_BUFFER, 3, ring.buffer(), offset, proto_vis_size);
+  } else {
+    u32 offset = ring.upload(kZeros, 4, data.ssbo_alignment);
+    glBindBufferRange(GL_SHADER_STORAGE_BUFFER, 3, ring.buffer(), offset, 4);
+  }
+
+  glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, data.vis_node_buffer);
+  glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, data.group_buffer);
+  glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, data.command_buffer);
+  glDispatchCompute((data.group_count + 63) / 64, 1, 1);
+  glMemoryBarrier(GL_COMMAND_BARRIER_BIT);
+}
+
+void multidraw_gpu_culled(GLenum mode, const GpuCullData& data, size_t draw_idx) {
+  const auto& cmds = data.commands_per_draw[draw_idx];
+  glBindBuffer(GL_DRAW_INDIRECT_BUFFER, data.command_buffer);
+  glMultiDrawElementsIndirect(mode, GL_UNSIGNED_INT,
+                              (void*)(size_t)(cmds.first * kIndirectCommandSize), cmds.second,
+                              0);
+}
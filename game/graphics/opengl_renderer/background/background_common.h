@@ -31,6 +31,30 @@ struct TfragRenderSettings {
   math::Vector4f planes[4];
   bool debug_culling = false;
   const u8* occlusion_culling = nullptr;
+  // changes when the occlusion_culling data does.
+  u64 occlusion_culling_version = 0;
+};
+
+/*!
+ * Everything a tree's culling on the CPU depends on. When it's the same as the last time the tree
+ * was culled, the draw lists from then are still right.
+ */
+struct CullingKey {
+  math::Vector4f planes[4];
+  const u8* occlusion_culling = nullptr;
+  u64 occlusion_culling_version = 0;
+  u64 proto_vis_version = 0;
+  u64 lod_version = 0;
+  bool multidraw = false;
+  bool valid = false;
+
+  CullingKey() = default;
+  CullingKey(const TfragRenderSettings& settings,
+             bool multidraw,
+             u64 proto_vis_version = 0,
+             u64 lod_version = 0);
+  bool operator==(const CullingKey& other) const;
+  bool operator!=(const CullingKey& other) const { return !(*this == other); }
 };
 
 enum class DoubleDrawKind { NONE, AFAIL_NO_DEPTH_WRITE };
@@ -43,7 +67,10 @@ struct DoubleDraw {
 };
 
 DoubleDraw setup_tfrag_shader(SharedRenderState* render_state, DrawMode mode, ShaderId shader);
-DoubleDraw setup_opengl_from_draw_mode(DrawMode mode, u32 tex_unit, bool mipmap);
+DoubleDraw setup_opengl_from_draw_mode(SharedRenderState* render_state,
+                                       DrawMode mode,
+                                       u32 tex_unit,
+                                       bool mipmap);
 
 void first_tfrag_draw_setup(const TfragRenderSettings& settings,
                             SharedRenderState* render_state,
@@ -64,12 +91,69 @@ void interp_time_of_day_fast(const math::Vector<s32, 4> itimes[4],
                              const SwizzledTimeOfDay& swizzled_colors,
                              math::Vector<u8, 4>* out);
 
+/*!
+ * The interpolated time of day palette only depends on the (integer) weights, so a tree can skip
+ * interpolation and texture upload if the weights are the same as the last time it was uploaded.
+ */
+struct TimeOfDayDirtyCheck {
+  bool valid = false;
+  bool fast = false;
+  math::Vector<s32, 4> itimes[4];
+
+  // returns true if the palette must be recomputed, and remembers these weights.
+  bool needs_update(const math::Vector<s32, 4> new_itimes[4], bool use_fast);
+  void invalidate() { valid = false; }
+};
+
 void cull_check_all_slow(const math::Vector4f* planes,
                          const std::vector<tfrag3::VisNode>& nodes,
                          const u8* level_occlusion_string,
                          u8* out);
 bool sphere_in_view_ref(const math::Vector4f& sphere, const math::Vector4f* planes);
 
+// structure-of-arrays copy of the BVH nodes, padded to a multiple of 8 nodes, for SIMD culling.
+struct VisNodesSoA {
+  std::vector<float> x, y, z, neg_r;
+  std::vector<u16> my_id;
+  u32 node_count = 0;
+};
+
+VisNodesSoA make_vis_nodes_soa(const std::vector<tfrag3::VisNode>& nodes);
+
+void cull_check_all_fast(const math::Vector4f* planes,
+                         const VisNodesSoA& nodes,
+                         const u8* level_occlusion_string,
+                         u8* out);
+
+/*!
+ * The automatic level of detail for a tree: the geom each BVH node is drawn with, picked from the
+ * node's size on screen. All geoms of a tree share the same BVH, so one selection covers them all.
+ */
+struct LodSelection {
+  std::vector<u8> node_geom;
+  u64 version = 0;  // changes when node_geom does.
+};
+
+// the distance from the camera to the screen, in pixels of a screen this tall.
+float camera_focal_length_pixels(const math::Vector4f* planes, float screen_height);
+
+/*!
+ * Pick a geom between min_geom and max_geom for each node. Nodes with a radius on screen of at
+ * least threshold_pixels use min_geom, and each lower detail geom is used below half the size of
+ * the one before it. A node only changes geom when its size is past a threshold by more than a
+ * small margin, so nodes near a threshold don't pop back and forth as the camera moves.
+ */
+void select_lods(LodSelection* lods,
+                 const VisNodesSoA& nodes,
+                 const math::Vector4f& camera_pos,
+                 float focal_length_pixels,
+                 float threshold_pixels,
+                 int min_geom,
+                 int max_geom);
+
+// clear the visibility of nodes that aren't drawn with this geom.
+void mask_vis_by_lod(u8* vis, const LodSelection& lods, int geom);
+
 void update_render_state_from_pc_settings(SharedRenderState* state, const TfragPcPortData& data);
 
 void make_all_visible_multidraws(std::pair<int, int>* draw_ptrs_out,
@@ -119,4 +203,38 @@ u32 make_index_list_from_vis_and_proto_string(std::pair<int, int>* group_out,
                                               const std::vector<u8>& vis_data,
                                               const std::vector<u8>& proto_vis_data,
                                               const u32* idx_in,
-                                              u32* num_tris_out);
\ No newline at end of file
+                                              u32* num_tris_out);
+/*!
+ * GPU copies of a tree's BVH and vis groups, for culling with the background_cull compute shader.
+ * The shader writes one indirect draw command per vis group, and the groups of each StripDraw are
+ * consecutive, so each StripDraw is a single glMultiDrawElementsIndirect.
+ */
+struct GpuCullData {
+  GLuint vis_node_buffer = 0;
+  GLuint group_buffer = 0;
+  GLuint command_buffer = 0;
+  u32 group_count = 0;
+  u32 occlusion_bytes = 0;  // size of the part of the occlusion string used by this tree
+  u32 ssbo_alignment = 16;
+  // for each StripDraw, the (first, count) of its commands.
+  std::vector<std::pair<u32, u32>> commands_per_draw;
+
+  bool valid() const { return command_buffer != 0; }
+};
+
+GpuCullData make_gpu_cull_data(const std::vector<tfrag3::StripDraw>& draws,
+                               const std::vector<tfrag3::VisNode>& vis_nodes);
+void free_gpu_cull_data(GpuCullData& data);
+
+/*!
+ * Run the culling shader for a tree. This changes the active program, so the draw shader must be
+ * set up after. proto_vis may be null. If the render state has a depth pyramid from the last frame,
+ * and use_depth_pyramid_culling is set, it's also used.
+ */
+void gpu_cull(const GpuCullData& data,
+              SharedRenderState* render_state,
+              const TfragRenderSettings& settings,
+              const std::vector<u8>* proto_vis,
+              bool all_visible);
+
+void multidraw_gpu_culled(GLenum mode, const GpuCullData& data, size_t draw_idx);
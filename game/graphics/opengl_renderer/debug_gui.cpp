@@ -6,6 +6,11 @@
 #include "common/global_profiler/GlobalProfiler.h"
 
 #include "game/graphics/gfx.h"
+#include "game/graphics/opengl_renderer/RenderDoc.h"
+#include "game/kernel/common/kmalloc.h"
+#include "game/kernel/common/kscheme.h"
+#include "game/mips2c/mips2c_table.h"
+#include "game/mips2c/native_mode.h"
 
 #include "third-party/imgui/imgui.h"
 #include "third-party/imgui/imgui_style.h"
@@ -21,9 +26,18 @@ void FrameTimeRecorder::start_frame() {
   m_compute_timer.start();
   float frame_time = m_fps_timer.getSeconds();
   m_last_frame_time = (0.9 * m_last_frame_time) + (0.1 * frame_time);
+  PROF_PLOT("frame-ms", frame_time * 1000);
   m_fps_timer.start();
 }
 
+void FrameTimeRecorder::record_input_latency(float ms) {
+  m_input_latencies[m_input_latency_idx++] = ms;
+  if (m_input_latency_idx == SIZE) {
+    m_input_latency_idx = 0;
+  }
+  m_input_latency_count = std::min(m_input_latency_count + 1, SIZE);
+}
+
 void FrameTimeRecorder::draw_window(const DmaStats& /*dma_stats*/) {
   auto* p_open = &m_open;
   ImGuiWindowFlags window_flags = ImGuiWindowFlags_NoDecoration |
@@ -66,6 +80,16 @@ void FrameTimeRecorder::draw_window(const DmaStats& /*dma_stats*/) {
     ImGui::SameLine();
     ImGui::Text("fps-avg: %.1f", 1.f / m_last_frame_time);
 
+    if (m_input_latency_count) {
+      float input_worst = 0, input_total = 0;
+      for (int i = 0; i < m_input_latency_count; i++) {
+        input_worst = std::max(m_input_latencies[i], input_worst);
+        input_total += m_input_latencies[i];
+      }
+      ImGui::Text("input latency avg: %.1f worst: %.1f", input_total / m_input_latency_count,
+                  input_worst);
+    }
+
     ImGui::Separator();
     ImGui::PlotLines(
         "0-20ms",
@@ -94,6 +118,21 @@ void OpenGlDebugGui::finish_frame() {
   m_frame_timer.finish_frame();
 }
 
+/*!
+ * Decide if ImGui is updated this frame. If it isn't, the last frame's ImGui output is drawn again
+ * and nothing may use ImGui, so the should_draw functions return false.
+ */
+bool OpenGlDebugGui::start_imgui_frame() {
+  m_frames_since_imgui_update++;
+  // when the menu is hidden, always update so it shows up as soon as it's turned on.
+  m_imgui_frame_started =
+      !master_enable || m_frames_since_imgui_update >= std::max(1, imgui_update_interval);
+  if (m_imgui_frame_started) {
+    m_frames_since_imgui_update = 0;
+  }
+  return m_imgui_frame_started;
+}
+
 void OpenGlDebugGui::draw(const DmaStats& dma_stats) {
   if (ImGui::BeginMainMenuBar()) {
     if (ImGui::BeginMenu("Debugging")) {
@@ -101,7 +140,16 @@ void OpenGlDebugGui::draw(const DmaStats& dma_stats) {
       ImGui::MenuItem("Render Debug", nullptr, &m_draw_debug);
       ImGui::MenuItem("Profiler", nullptr, &m_draw_profiler);
       ImGui::MenuItem("Small Profiler", nullptr, &small_profiler);
+      ImGui::MenuItem("MIPS2C Profiler", nullptr, &m_draw_mips2c_profiler);
+      ImGui::MenuItem("Kmalloc Stats", nullptr, &m_draw_kmalloc_stats);
+      ImGui::MenuItem("Process Stats", nullptr, &m_draw_process_stats);
       ImGui::MenuItem("Loader", nullptr, &m_draw_loader);
+      ImGui::MenuItem("Capture DMA Next Frame", nullptr, &m_want_frame_capture);
+      ImGui::MenuItem("Capture DMA Frames", nullptr, &m_want_frame_capture_sequence);
+      ImGui::InputInt("Capture Frames", &frame_capture_frames);
+      ImGui::MenuItem("Capture RenderDoc Frame", "F3", &m_want_renderdoc_capture,
+                      renderdoc::available());
+      ImGui::MenuItem("Pipelined DMA", nullptr, &pipelined_dma);
       ImGui::EndMenu();
     }
 
@@ -119,6 +167,9 @@ void OpenGlDebugGui::draw(const DmaStats& dma_stats) {
         ImGui::InputInt("Height", &screenshot_height);
         ImGui::InputInt("MSAA", &screenshot_samples);
         ImGui::Checkbox("Screenshot on f2", &screenshot_hotkey_enabled);
+        ImGui::Separator();
+        ImGui::MenuItem("Record Sequence!", nullptr, &m_want_sequence);
+        ImGui::InputInt("Sequence Frames", &sequence_frames);
         ImGui::EndMenu();
       }
       ImGui::MenuItem("Subtitle Editor", nullptr, &m_subtitle_editor);
@@ -139,6 +190,8 @@ void OpenGlDebugGui::draw(const DmaStats& dma_stats) {
         ImGui::TreePop();
       }
       ImGui::Checkbox("Ignore Hide ImGui Bind", &Gfx::g_debug_settings.ignore_hide_imgui);
+      ImGui::SliderInt("ImGui Update Interval", &imgui_update_interval, 1, 8);
+      ImGui::Text("ImGui: %.2f ms cpu, %.2f ms gpu", imgui_cpu_ms, imgui_gpu_ms);
       if (ImGui::BeginMenu("Frame Rate")) {
         ImGui::Checkbox("Framelimiter", &Gfx::g_global_settings.framelimiter);
         ImGui::InputFloat("Target FPS", &target_fps_input);
@@ -148,6 +201,13 @@ void OpenGlDebugGui::draw(const DmaStats& dma_stats) {
         ImGui::Separator();
         ImGui::Checkbox("Accurate Lag Mode", &Gfx::g_global_settings.experimental_accurate_lag);
         ImGui::Checkbox("Sleep in Frame Limiter", &Gfx::g_global_settings.sleep_in_frame_limiter);
+        ImGui::Checkbox("Sample Input Before Game Frame",
+                        &Gfx::g_global_settings.sample_input_before_game_frame);
+        ImGui::Separator();
+        ImGui::Text("Frame avg: %.2f ms, jitter: %.2f ms, worst: %.2f ms", frame_pacing.avg_ms,
+                    frame_pacing.jitter_ms, frame_pacing.worst_ms);
+        ImGui::Text("Missed deadlines: %d, sleep margin: %.2f ms", frame_pacing.missed_deadlines,
+                    frame_pacing.sleep_margin_ms);
         ImGui::EndMenu();
       }
       ImGui::MenuItem("Filters", nullptr, &m_filters_menu);
@@ -159,6 +219,7 @@ void OpenGlDebugGui::draw(const DmaStats& dma_stats) {
         prof().set_enable(record_events);
       }
       ImGui::MenuItem("Dump to file", nullptr, &dump_events);
+      ImGui::MenuItem("Stream to file", nullptr, &stream_events);
       ImGui::EndMenu();
     }
 
@@ -174,4 +235,214 @@ void OpenGlDebugGui::draw(const DmaStats& dma_stats) {
   if (m_draw_frame_time) {
     m_frame_timer.draw_window(dma_stats);
   }
+
+  if (m_draw_mips2c_profiler) {
+    draw_mips2c_profiler();
+  }
+
+  if (m_draw_kmalloc_stats) {
+    draw_kmalloc_stats();
+  }
+  if (m_draw_process_stats) {
+    draw_process_stats();
+  }
+}
+
+void OpenGlDebugGui::draw_mips2c_profiler() {
+  auto& table = Mips2C::gLinkedFunctionTable;
+  if (ImGui::Begin("MIPS2C Profiler", &m_draw_mips2c_profiler)) {
+    bool enable = table.profiling();
+    if (ImGui::Checkbox("Enable", &enable)) {
+      table.set_profiling(enable);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Reset")) {
+      table.reset_stats();
+    }
+
+    if (ImGui::CollapsingHeader("Native Versions")) {
+      // CHECK asserts on the first mismatch, so it's for debugging, not for playing.
+      const char* mode_names = "Native\0MIPS2C\0Check\0";
+      for (int i = 0; i < (int)Mips2C::NativeGroup::COUNT; i++) {
+        auto& mode = Mips2C::native_mode((Mips2C::NativeGroup)i);
+        int selected = (int)mode.load();
+        ImGui::SetNextItemWidth(120);
+        if (ImGui::Combo(Mips2C::native_group_names[i], &selected, mode_names)) {
+          mode = (Mips2C::NativeMode)selected;
+        }
+      }
+    }
+
+    if (ImGui::BeginTable("mips2c-stats", 4,
+                          ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg |
+                              ImGuiTableFlags_ScrollY)) {
+      ImGui::TableSetupScrollFreeze(0, 1);
+      ImGui::TableSetupColumn("Function");
+      ImGui::TableSetupColumn("Calls");
+      ImGui::TableSetupColumn("Mcycles");
+      ImGui::TableSetupColumn("Cycles/Call");
+      ImGui::TableHeadersRow();
+      const auto all_stats = table.get_stats();
+      // only the visible rows are drawn.
+      ImGuiListClipper clipper;
+      clipper.Begin(all_stats.size());
+      while (clipper.Step()) {
+        for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++) {
+          auto& stat = all_stats[i];
+          ImGui::TableNextRow();
+          ImGui::TableNextColumn();
+          ImGui::TextUnformatted(stat.name.c_str());
+          ImGui::TableNextColumn();
+          ImGui::Text("%lld", (long long)stat.calls);
+          ImGui::TableNextColumn();
+          ImGui::Text("%.2f", stat.cycles / 1e6);
+          ImGui::TableNextColumn();
+          ImGui::Text("%lld", (long long)(stat.cycles / stat.calls));
+        }
+      }
+      ImGui::EndTable();
+    }
+  }
+  ImGui::End();
+}
+
+void OpenGlDebugGui::draw_kmalloc_stats() {
+  auto& stats = g_kmalloc_stats;
+  if (ImGui::Begin("Kmalloc Stats", &m_draw_kmalloc_stats)) {
+    bool enable = stats.enabled();
+    if (ImGui::Checkbox("Enable", &enable)) {
+      stats.set_enabled(enable);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Reset")) {
+      stats.reset();
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Save JSON")) {
+      stats.snapshot();
+    }
+
+    if (ImGui::CollapsingHeader("Sizes") &&
+        ImGui::BeginTable("kmalloc-sizes", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+      ImGui::TableSetupColumn("Heap");
+      ImGui::TableSetupColumn("Up to bytes");
+      ImGui::TableSetupColumn("Allocs");
+      ImGui::TableSetupColumn("KB");
+      ImGui::TableHeadersRow();
+      for (auto& heap : stats.get_heap_stats()) {
+        auto name = KmallocStats::heap_name(heap.heap);
+        for (int i = 0; i < KmallocStats::SIZE_BUCKETS; i++) {
+          if (!heap.size_counts[i]) {
+            continue;
+          }
+          ImGui::TableNextRow();
+          ImGui::TableNextColumn();
+          ImGui::TextUnformatted(name.c_str());
+          ImGui::TableNextColumn();
+          if (i == KmallocStats::SIZE_BUCKETS - 1) {
+            ImGui::TextUnformatted("larger");
+          } else {
+            ImGui::Text("%d", 16 << i);
+          }
+          ImGui::TableNextColumn();
+          ImGui::Text("%lld", (long long)heap.size_counts[i]);
+          ImGui::TableNextColumn();
+          ImGui::Text("%.1f", heap.size_bytes[i] / 1024.);
+        }
+      }
+      ImGui::EndTable();
+    }
+
+    if (ImGui::BeginTable("kmalloc-stats", 6,
+                          ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg |
+                              ImGuiTableFlags_ScrollY)) {
+      ImGui::TableSetupScrollFreeze(0, 1);
+      ImGui::TableSetupColumn("Heap");
+      ImGui::TableSetupColumn("Name");
+      ImGui::TableSetupColumn("Allocs");
+      ImGui::TableSetupColumn("KB");
+      ImGui::TableSetupColumn("Padding KB");
+      ImGui::TableSetupColumn("Failed");
+      ImGui::TableHeadersRow();
+      const auto all_stats = stats.get_stats();
+      ImGuiListClipper clipper;
+      clipper.Begin(all_stats.size());
+      while (clipper.Step()) {
+        for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++) {
+          auto& stat = all_stats[i];
+          ImGui::TableNextRow();
+          ImGui::TableNextColumn();
+          ImGui::TextUnformatted(KmallocStats::heap_name(stat.heap).c_str());
+          ImGui::TableNextColumn();
+          ImGui::TextUnformatted(stat.name.c_str());
+          ImGui::TableNextColumn();
+          ImGui::Text("%lld", (long long)stat.count);
+          ImGui::TableNextColumn();
+          ImGui::Text("%.1f", stat.bytes / 1024.);
+          ImGui::TableNextColumn();
+          ImGui::Text("%.1f", stat.padding / 1024.);
+          ImGui::TableNextColumn();
+          ImGui::Text("%lld", (long long)stat.failed);
+        }
+      }
+      ImGui::EndTable();
+    }
+  }
+  ImGui::End();
+}
+
+void OpenGlDebugGui::draw_process_stats() {
+  auto& stats = g_process_stats;
+  if (ImGui::Begin("Process Stats", &m_draw_process_stats)) {
+    bool enable = stats.enabled();
+    if (ImGui::Checkbox("Enable", &enable)) {
+      stats.set_enabled(enable);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Reset")) {
+      stats.reset();
+    }
+
+    auto all_stats = stats.get_stats();
+    double total_ms = 0;
+    for (auto& stat : all_stats) {
+      total_ms += stat.avg_ms;
+    }
+    ImGui::Text("Total: %.3f ms per frame", total_ms);
+
+    if (ImGui::BeginTable("process-stats", 6,
+                          ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg |
+                              ImGuiTableFlags_ScrollY)) {
+      ImGui::TableSetupScrollFreeze(0, 1);
+      ImGui::TableSetupColumn("Process");
+      ImGui::TableSetupColumn("State");
+      ImGui::TableSetupColumn("Avg ms");
+      ImGui::TableSetupColumn("Last ms");
+      ImGui::TableSetupColumn("Max ms");
+      ImGui::TableSetupColumn("Runs");
+      ImGui::TableHeadersRow();
+      ImGuiListClipper clipper;
+      clipper.Begin(all_stats.size());
+      while (clipper.Step()) {
+        for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++) {
+          auto& stat = all_stats[i];
+          ImGui::TableNextRow();
+          ImGui::TableNextColumn();
+          ImGui::TextUnformatted(stat.name.c_str());
+          ImGui::TableNextColumn();
+          ImGui::TextUnformatted(stat.state.c_str());
+          ImGui::TableNextColumn();
+          ImGui::Text("%.3f", stat.avg_ms);
+          ImGui::TableNextColumn();
+          ImGui::Text("%.3f", stat.last_ms);
+          ImGui::TableNextColumn();
+          ImGui::Text("%.3f", stat.max_ms);
+          ImGui::TableNextColumn();
+          ImGui::Text("%.1f", stat.avg_calls);
+        }
+      }
+      ImGui::EndTable();
+    }
+  }
+  ImGui::End();
 }
@@ -5,7 +5,10 @@
  * The debug menu-bar and frame timing window
  */
 
+#include <algorithm>
+
 #include "common/dma/dma.h"
+#include "common/util/FrameLimiter.h"
 #include "common/util/Timer.h"
 #include "common/versions/versions.h"
 
@@ -16,6 +19,7 @@ class FrameTimeRecorder {
   void finish_frame();
   void start_frame();
   void draw_window(const DmaStats& dma_stats);
+  void record_input_latency(float ms);
   bool should_advance_frame() {
     if (m_single_frame) {
       m_single_frame = false;
@@ -30,6 +34,9 @@ class FrameTimeRecorder {
   float m_frame_times[SIZE] = {0};
   float m_last_frame_time = 0;
   int m_idx = 0;
+  float m_input_latencies[SIZE] = {0};
+  int m_input_latency_idx = 0;
+  int m_input_latency_count = 0;
   Timer m_compute_timer;
   Timer m_fps_timer;
   bool m_open = true;
@@ -44,13 +51,17 @@ class OpenGlDebugGui {
 
   void start_frame();
   void finish_frame();
+  void record_input_latency(float ms) { m_frame_timer.record_input_latency(ms); }
   void draw(const DmaStats& dma_stats);
-  bool should_draw_render_debug() const { return master_enable && m_draw_debug; }
-  bool should_draw_profiler() const { return master_enable && m_draw_profiler; }
-  bool should_draw_subtitle_editor() const { return master_enable && m_subtitle_editor; }
-  bool should_draw_subtitle2_editor() const { return master_enable && m_subtitle2_editor; }
-  bool should_draw_filters_menu() const { return master_enable && m_filters_menu; }
-  bool should_draw_loader_menu() const { return master_enable && m_draw_loader; }
+  bool start_imgui_frame();
+  bool imgui_frame_started() const { return m_imgui_frame_started; }
+  bool should_draw_render_debug() const { return windows_enabled() && m_draw_debug; }
+  bool should_draw_profiler() const { return windows_enabled() && m_draw_profiler; }
+  bool should_draw_small_profiler() const { return windows_enabled() && small_profiler; }
+  bool should_draw_subtitle_editor() const { return windows_enabled() && m_subtitle_editor; }
+  bool should_draw_subtitle2_editor() const { return windows_enabled() && m_subtitle2_editor; }
+  bool should_draw_filters_menu() const { return windows_enabled() && m_filters_menu; }
+  bool should_draw_loader_menu() const { return windows_enabled() && m_draw_loader; }
   const char* screenshot_name() const { return m_screenshot_save_name; }
 
   bool should_advance_frame() { return m_frame_timer.should_advance_frame(); }
@@ -64,21 +75,70 @@ class OpenGlDebugGui {
     return false;
   }
 
+  // screenshots of the next sequence_frames frames, at the game resolution.
+  bool get_sequence_flag() {
+    if (m_want_sequence) {
+      m_want_sequence = false;
+      return true;
+    }
+    return false;
+  }
+
+  // the number of frames to record to a frame capture, or 0.
+  int get_frame_capture_count() {
+    int result = 0;
+    if (m_want_frame_capture_sequence) {
+      result = std::max(1, frame_capture_frames);
+    } else if (m_want_frame_capture) {
+      result = 1;
+    }
+    m_want_frame_capture = false;
+    m_want_frame_capture_sequence = false;
+    return result;
+  }
+
+  bool get_renderdoc_capture_flag() {
+    if (m_want_renderdoc_capture) {
+      m_want_renderdoc_capture = false;
+      return true;
+    }
+    return false;
+  }
+
   bool small_profiler = false;
   bool record_events = false;
   bool dump_events = false;
+  bool stream_events = false;
   bool want_reboot_in_debug = false;
+  bool pipelined_dma = false;
+  FrameLimiter::Stats frame_pacing;
 
   int screenshot_width = 1920;
   int screenshot_height = 1080;
   int screenshot_samples = 16;
   bool screenshot_hotkey_enabled = true;
+  int sequence_frames = 60;
+  int frame_capture_frames = 300;
 
   bool master_enable = false;
+  // while the debug menu is up, ImGui is only updated every this many frames, and the last update
+  // is drawn again in between.
+  int imgui_update_interval = 1;
+  // the cost of the last ImGui update and draw, which happen outside of the renderer's profiler.
+  float imgui_cpu_ms = 0;
+  float imgui_gpu_ms = 0;
 
  private:
+  bool windows_enabled() const { return master_enable && m_imgui_frame_started; }
+  void draw_mips2c_profiler();
+  void draw_kmalloc_stats();
+  void draw_process_stats();
+
   FrameTimeRecorder m_frame_timer;
   bool m_draw_frame_time = false;
+  bool m_draw_mips2c_profiler = false;
+  bool m_draw_kmalloc_stats = false;
+  bool m_draw_process_stats = false;
   bool m_draw_profiler = false;
   bool m_draw_debug = false;
   bool m_draw_loader = false;
@@ -86,8 +146,14 @@ class OpenGlDebugGui {
   bool m_subtitle2_editor = false;
   bool m_filters_menu = false;
   bool m_want_screenshot = false;
+  bool m_want_sequence = false;
+  bool m_want_frame_capture = false;
+  bool m_want_frame_capture_sequence = false;
+  bool m_want_renderdoc_capture = false;
   char m_screenshot_save_name[256] = "screenshot.png";
   float target_fps_input = 60.f;
+  bool m_imgui_frame_started = true;
+  int m_frames_since_imgui_update = 0;
 
   GameVersion m_version;
 };
@@ -1,5 +1,8 @@
 #include "dma_helpers.h"
 
+#include <algorithm>
+
+#include "common/dma/vif_unpack.h"
 #include "common/log/log.h"
 
 #include "third-party/fmt/format.h"
@@ -16,8 +19,9 @@ bool verify_unpack_with_stcycl(const DmaTransfer& transfer,
                                u32 addr,
                                bool usn,
                                bool flg) {
-  if (transfer.size_bytes != qwc * 16) {
-    lg::error("verify_unpack: bad size {} vs {}", transfer.size_bytes, qwc * 16);
+  if (transfer.size_bytes != vif_unpack_src_bytes(unpack_kind, qwc)) {
+    lg::error("verify_unpack: bad size {} vs {}", transfer.size_bytes,
+              vif_unpack_src_bytes(unpack_kind, qwc));
     return false;
   }
 
@@ -66,11 +70,13 @@ void unpack_to_stcycl(void* dst,
                       u32 addr,
                       bool usn,
                       bool flg) {
-  bool ok =
-      verify_unpack_with_stcycl(transfer, unpack_kind, cl, wl, size_bytes / 16, addr, usn, flg);
-  ASSERT(ok);
   ASSERT((size_bytes & 0xf) == 0);
-  memcpy(dst, transfer.data, size_bytes);
+  // with a write cycle that skips, the vectors only fill wl out of every cl quadwords.
+  u32 dst_qwc = size_bytes / 16;
+  u32 num = wl < cl ? wl * (dst_qwc / cl) + std::min((u32)wl, dst_qwc % cl) : dst_qwc;
+  bool ok = verify_unpack_with_stcycl(transfer, unpack_kind, cl, wl, num, addr, usn, flg);
+  ASSERT(ok);
+  vif_unpack(dst, transfer.data, unpack_kind, num, usn, cl, wl);
 }
 
 /*!
@@ -83,8 +89,9 @@ bool verify_unpack_no_stcycl(const DmaTransfer& transfer,
                              u32 addr,
                              bool usn,
                              bool flg) {
-  if (transfer.size_bytes != qwc * 16) {
-    lg::error("verify_unpack: bad size {} vs {}", transfer.size_bytes, qwc * 16);
+  if (transfer.size_bytes != vif_unpack_src_bytes(unpack_kind, qwc)) {
+    lg::error("verify_unpack: bad size {} vs {}", transfer.size_bytes,
+              vif_unpack_src_bytes(unpack_kind, qwc));
     return false;
   }
 
@@ -128,7 +135,7 @@ void unpack_to_no_stcycl(void* dst,
   bool ok = verify_unpack_no_stcycl(transfer, unpack_kind, size_bytes / 16, addr, usn, flg);
   ASSERT(ok);
   ASSERT((size_bytes & 0xf) == 0);
-  memcpy(dst, transfer.data, size_bytes);
+  vif_unpack(dst, transfer.data, unpack_kind, size_bytes / 16, usn);
 }
 
 void verify_mscal(const DmaTransfer& transfer, int address) {
@@ -24,7 +24,7 @@ bool verify_unpack_no_stcycl(const DmaTransfer& transfer,
 
 /*!
  * Verify the DMA transfer is a VIF unpack (with no STCYCL tag).
- * Then, unpack the data to dst.
+ * Then, unpack the data to dst, which is size_bytes of VU memory.
  */
 void unpack_to_no_stcycl(void* dst,
                          const DmaTransfer& transfer,
@@ -36,7 +36,7 @@ void unpack_to_no_stcycl(void* dst,
 
 /*!
  * Verify the DMA transfer is a VIF unpack (with STCYCL tag).
- * Then, unpack the data to dst.
+ * Then, unpack the data to dst, which is size_bytes of VU memory.
  */
 void unpack_to_stcycl(void* dst,
                       const DmaTransfer& transfer,
@@ -33,6 +33,10 @@ void Generic2::draw_debug_window() {
   ImGui::Checkbox("Alpha 6", &m_alpha_draw_enable[5]);
   ImGui::Checkbox("Alpha 7", &m_alpha_draw_enable[6]);
 
+  ImGui::Checkbox("Reuse Layout", &m_layout_cache.enable);
+  ImGui::Checkbox("Parallel Vertex Build", &m_parallel_vertex_build);
+  ImGui::Text("Layout reused %d, rebuilt %d", m_layout_cache.hits, m_layout_cache.misses);
+
   ImGui::Text("Max Seen:");
   ImGui::Text(" frag: %d/%d %.1f%%", m_max_frags_seen, (int)m_fragments.size(),
               100.f * m_max_frags_seen / (float)m_fragments.size());
@@ -92,6 +96,7 @@ void Generic2::render_in_mode(DmaFollower& dma,
       default:
         ASSERT_NOT_REACHED();
     }
+    unpack_vertices();
   }
 
   {
@@ -115,4 +120,52 @@ void Generic2::render_in_mode(DmaFollower& dma,
     auto p = prof.make_scoped_child("drawing");
     do_draws(render_state, p);
   }
+}
+
+/*!
+ * CPU-only part of rendering: DMA processing and draw setup. Doesn't touch OpenGL or
+ * the shared render state, so this is safe to run on a worker thread.
+ */
+void Generic2::prepare(DmaFollower& dma, u32 next_bucket, GameVersion version) {
+  prepare_in_mode(dma, next_bucket, version, Mode::NORMAL);
+}
+
+void Generic2::prepare_in_mode(DmaFollower& dma, u32 next_bucket, GameVersion version, Mode mode) {
+  m_debug.clear();
+  m_stats = Stats();
+
+  if (!m_enabled) {
+    while (dma.current_tag_offset() != next_bucket) {
+      dma.read_and_advance();
+    }
+    return;
+  }
+
+  switch (mode) {
+    case Mode::NORMAL:
+      if (version == GameVersion::Jak1) {
+        process_dma_jak1(dma, next_bucket);
+      } else {
+        process_dma_jak2(dma, next_bucket);
+      }
+      break;
+    case Mode::LIGHTNING:
+      process_dma_lightning(dma, next_bucket);
+      break;
+    default:
+      ASSERT_NOT_REACHED();
+  }
+  unpack_vertices();
+  setup_draws(mode == Mode::NORMAL);
+}
+
+/*!
+ * OpenGL part of rendering, after prepare().
+ */
+void Generic2::submit(SharedRenderState* render_state, ScopedProfilerNode& prof) {
+  if (!m_enabled) {
+    return;
+  }
+  auto p = prof.make_scoped_child("drawing");
+  do_draws(render_state, p);
 }
\ No newline at end of file
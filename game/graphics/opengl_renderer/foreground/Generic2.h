@@ -23,6 +23,11 @@ class Generic2 : public BucketRenderer {
   void draw_debug_window() override;
   void init_shaders(ShaderLibrary& shaders) override;
 
+  bool supports_prepare() const override { return true; }
+  void prepare(DmaFollower& dma, u32 next_bucket, GameVersion version) override;
+  void prepare_in_mode(DmaFollower& dma, u32 next_bucket, GameVersion version, Mode mode);
+  void submit(SharedRenderState* render_state, ScopedProfilerNode& prof) override;
+
   struct Vertex {
     math::Vector<float, 3> xyz;
     math::Vector<u8, 4> rgba;
@@ -40,6 +45,7 @@ class Generic2 : public BucketRenderer {
   void build_index_buffer();
   void link_adgifs_back_to_frags();
   void draws_to_buckets();
+  bool try_reuse_layout(bool enable_at);
   void reset_buffers();
   void process_matrices();
   void process_dma_jak1(DmaFollower& dma, u32 next_bucket);
@@ -53,6 +59,7 @@ class Generic2 : public BucketRenderer {
                           bool hud);
   void do_hud_draws(SharedRenderState* render_state, ScopedProfilerNode& prof);
   bool check_for_end_of_generic_data(DmaFollower& dma, u32 next_bucket);
+  void unpack_vertices();
   void final_vertex_update();
   bool handle_bucket_setup_dma(DmaFollower& dma, u32 next_bucket);
 
@@ -193,18 +200,65 @@ class Generic2 : public BucketRenderer {
     ASSERT(m_next_free_vert < m_verts.size());
   }
 
+  // vertex data found in the DMA, unpacked into m_verts after all of it has been read.
+  struct VertexUnpack {
+    enum class Kind : u8 { POSITIONS, COLORS, TCS, LIGHTNING } kind;
+    u32 vtx_idx;
+    u32 count;
+    const u8* data;
+  };
+  std::vector<VertexUnpack> m_vertex_unpacks;
+  u32 queue_unpack(VertexUnpack::Kind kind, u32 vtx_idx, const u8* data, u32 count);
+
+  // below this many vertices, the thread pool costs more than it saves.
+  static constexpr u32 PARALLEL_MIN_VERTS = 4096;
+  bool m_parallel_vertex_build = true;
+
   std::string m_debug;
 
   struct Stats {
     u32 dma_tags = 0;
   } m_stats;
 
+  /*!
+   * The buckets, index buffer and per-adgif draw settings only depend on the adgifs, fragment
+   * headers and the vertices' adc bits, which are usually the same as the last frame. If they are,
+   * the last frame's layout is reused, and only the vertices need to be uploaded again.
+   */
+  struct LayoutKey {
+    u32 frags = 0;
+    u32 adgifs = 0;
+    u32 verts = 0;
+    u32 layout_hash = 0;
+    u32 adc_hash = 0;
+    bool enable_at = false;
+    bool zmsk = false;
+
+    bool operator==(const LayoutKey& other) const {
+      return frags == other.frags && adgifs == other.adgifs && verts == other.verts &&
+             layout_hash == other.layout_hash && adc_hash == other.adc_hash &&
+             enable_at == other.enable_at && zmsk == other.zmsk;
+    }
+  };
+  LayoutKey compute_layout_key(bool enable_at) const;
+
+  struct {
+    LayoutKey key;
+    bool valid = false;
+    u32 buckets = 0;
+    u32 indices = 0;
+    bool enable = true;
+    // the index buffer changed, and needs to be uploaded.
+    bool indices_dirty = true;
+    u32 hits = 0;
+    u32 misses = 0;
+  } m_layout_cache;
+
   static constexpr int ALPHA_MODE_COUNT = 7;
   bool m_alpha_draw_enable[ALPHA_MODE_COUNT] = {true, true, true, true, true, true, true};
 
   struct {
     GLuint vao;
-    GLuint vertex_buffer;
     GLuint index_buffer;
     GLuint alpha_reject, color_mult, fog_color, scale, mat_23, mat_32, mat_33, fog_consts,
         hvdf_offset;
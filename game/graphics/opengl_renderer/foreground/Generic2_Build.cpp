@@ -1,5 +1,8 @@
 #include "Generic2.h"
 
+#include "common/util/ThreadPool.h"
+#include "common/util/crc32.h"
+
 /*!
  * Main function to set up Generic2 draw lists.
  * This function figures out which vertices belong to which draw settings.
@@ -9,12 +12,83 @@ void Generic2::setup_draws(bool enable_at) {
     return;
   }
   m_gs = GsState();
-  link_adgifs_back_to_frags();
   process_matrices();
+  if (try_reuse_layout(enable_at)) {
+    final_vertex_update();
+    return;
+  }
+  link_adgifs_back_to_frags();
   determine_draw_modes(enable_at);
   draws_to_buckets();
   final_vertex_update();
   build_index_buffer();
+
+  m_layout_cache.valid = true;
+  m_layout_cache.buckets = m_next_free_bucket;
+  m_layout_cache.indices = m_next_free_idx;
+  m_layout_cache.indices_dirty = true;
+}
+
+/*!
+ * Hash everything that the draw layout is built from. The fragment headers start with the
+ * projection matrix, which changes every frame, so only the giftag and extra adgif data after it
+ * are used. Call after process_matrices, which decides which fragments use the hud.
+ */
+Generic2::LayoutKey Generic2::compute_layout_key(bool enable_at) const {
+  constexpr u32 HEADER_LAYOUT_START = 4 * 16;
+  LayoutKey key;
+  key.frags = m_next_free_frag;
+  key.adgifs = m_next_free_adgif;
+  key.verts = m_next_free_vert;
+  key.enable_at = enable_at;
+  key.zmsk = m_drawing_config.zmsk;
+
+  u32 hash = 0;
+  for (u32 i = 0; i < m_next_free_frag; i++) {
+    const auto& frag = m_fragments[i];
+    u32 fields[5] = {frag.adgif_idx, frag.adgif_count, frag.vtx_idx, frag.vtx_count,
+                     frag.uses_hud};
+    hash ^= crc32(frag.header + HEADER_LAYOUT_START, FRAG_HEADER_SIZE - HEADER_LAYOUT_START);
+    hash = crc32((const u8*)fields, sizeof(fields)) ^ (hash * 31);
+  }
+  for (u32 i = 0; i < m_next_free_adgif; i++) {
+    hash = crc32((const u8*)&m_adgifs[i].data, sizeof(AdGifData)) ^ (hash * 31);
+  }
+  key.layout_hash = hash;
+
+  // pack the adc bits to hash them 64 at a time.
+  hash = 0;
+  u64 bits = 0;
+  for (u32 i = 0; i < m_next_free_vert; i++) {
+    bits |= (u64)(m_verts[i].adc != 0) << (i & 63);
+    if ((i & 63) == 63) {
+      hash = crc32((const u8*)&bits, sizeof(bits)) ^ (hash * 31);
+      bits = 0;
+    }
+  }
+  key.adc_hash = crc32((const u8*)&bits, sizeof(bits)) ^ (hash * 31);
+  return key;
+}
+
+/*!
+ * If the layout is the same as last frame's, reuse the buckets, indices and per-adgif draw settings
+ * that are still in our buffers.
+ */
+bool Generic2::try_reuse_layout(bool enable_at) {
+  if (!m_layout_cache.enable) {
+    m_layout_cache.valid = false;
+    return false;
+  }
+  auto key = compute_layout_key(enable_at);
+  if (m_layout_cache.valid && key == m_layout_cache.key) {
+    m_next_free_bucket = m_layout_cache.buckets;
+    m_next_free_idx = m_layout_cache.indices;
+    m_layout_cache.hits++;
+    return true;
+  }
+  m_layout_cache.key = key;
+  m_layout_cache.misses++;
+  return false;
 }
 
 /*!
@@ -195,7 +269,11 @@ void Generic2::determine_draw_modes(bool enable_at) {
     m_adgifs[i].mode = current_mode;
     m_adgifs[i].vtx_flags = m_gs.vertex_flags;
     m_adgifs[i].tbp = tbp;
-    m_adgifs[i].fix = m_gs.gs_alpha.fix();
+    // fix only matters to the one blend mode that uses it. Lightning sets it to 0x80 on some of
+    // its adgifs, and keeping it anyway would split draws that are otherwise the same.
+    const bool uses_fix = current_mode.get_ab_enable() &&
+                          current_mode.get_alpha_blend() == DrawMode::AlphaBlend::SRC_DST_FIX_DST;
+    m_adgifs[i].fix = uses_fix ? m_gs.gs_alpha.fix() : 0;
   }
 }
 
@@ -326,12 +404,24 @@ void Generic2::process_matrices() {
  * TODO: fill out texture units
  */
 void Generic2::final_vertex_update() {
-  for (u32 i = 0; i < m_next_free_adgif; i++) {
+  auto update = [&](int i) {
     auto& ad = m_adgifs[i];
     for (u32 j = 0; j < ad.vtx_count; j++) {
       m_verts[ad.vtx_idx + j].flags = ad.vtx_flags;
     }
+  };
+
+  if (!m_parallel_vertex_build || m_next_free_vert < PARALLEL_MIN_VERTS) {
+    for (u32 i = 0; i < m_next_free_adgif; i++) {
+      update(i);
+    }
+    return;
   }
+  // adgifs have their own vertices.
+  ParallelForOptions options;
+  options.priority = TaskPriority::HIGH;
+  options.grain = 64;
+  parallel_for(m_next_free_adgif, update, options);
 }
 
 /*!
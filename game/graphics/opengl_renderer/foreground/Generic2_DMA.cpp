@@ -1,4 +1,7 @@
 #include "Generic2.h"
+
+#include "common/util/ThreadPool.h"
+
 #include "game/graphics/opengl_renderer/AdgifHandler.h"
 
 /*!
@@ -111,6 +114,26 @@ void Generic2::reset_buffers() {
   m_next_free_adgif = 0;
   m_next_free_bucket = 0;
   m_next_free_idx = 0;
+  m_vertex_unpacks.clear();
+}
+
+/*!
+ * Remember to unpack vertex data into m_verts later, in unpack_vertices. The DMA data stays around
+ * until the end of the frame. Returns the number of bytes of data that will be used.
+ */
+u32 Generic2::queue_unpack(VertexUnpack::Kind kind, u32 vtx_idx, const u8* data, u32 count) {
+  m_vertex_unpacks.push_back({kind, vtx_idx, count, data});
+  switch (kind) {
+    case VertexUnpack::Kind::POSITIONS:
+      return count * 12;
+    case VertexUnpack::Kind::COLORS:
+    case VertexUnpack::Kind::TCS:
+      return count * 4;
+    case VertexUnpack::Kind::LIGHTNING:
+      return count * 16 * 3;
+    default:
+      ASSERT_NOT_REACHED();
+  }
 }
 
 bool is_nop_vif(const u8* data) {
@@ -215,7 +238,7 @@ u32 Generic2::handle_fragments_after_unpack_v4_32(const u8* data,
     frag->vtx_count = vtx_pos_unpack_tag.num;
     alloc_vtx(frag->vtx_count);
 
-    off += unpack_vtx_positions(&m_verts[frag->vtx_idx], data + off, frag->vtx_count);
+    off += queue_unpack(VertexUnpack::Kind::POSITIONS, frag->vtx_idx, data + off, frag->vtx_count);
 
     ASSERT(off < end_of_vif);
     while (is_nop_vif(data + off) && off < end_of_vif) {
@@ -234,7 +257,7 @@ u32 Generic2::handle_fragments_after_unpack_v4_32(const u8* data,
     frag->vtx_idx = m_next_free_vert;
     frag->vtx_count = unpack_vtx_color_tag.num;
     alloc_vtx(frag->vtx_count);
-    off += unpack_vertex_colors(&m_verts[frag->vtx_idx], data + off, frag->vtx_count);
+    off += queue_unpack(VertexUnpack::Kind::COLORS, frag->vtx_idx, data + off, frag->vtx_count);
   } else {
     // next, vertex colors
     u32 unpack_vtx_color_tag_data;
@@ -243,7 +266,7 @@ u32 Generic2::handle_fragments_after_unpack_v4_32(const u8* data,
     VifCode unpack_vtx_color_tag(unpack_vtx_color_tag_data);
     ASSERT(unpack_vtx_color_tag.kind == VifCode::Kind::UNPACK_V4_8);
     ASSERT(unpack_vtx_color_tag.num == frag->vtx_count);
-    off += unpack_vertex_colors(&m_verts[frag->vtx_idx], data + off, frag->vtx_count);
+    off += queue_unpack(VertexUnpack::Kind::COLORS, frag->vtx_idx, data + off, frag->vtx_count);
   }
 
   ASSERT(off < end_of_vif);
@@ -259,7 +282,7 @@ u32 Generic2::handle_fragments_after_unpack_v4_32(const u8* data,
   VifCode unpack_vtx_tc_tag(unpack_vtx_tc_tag_data);
   ASSERT(unpack_vtx_tc_tag.kind == VifCode::Kind::UNPACK_V2_16);
   ASSERT(unpack_vtx_tc_tag.num == frag->vtx_count);
-  off += unpack_vtx_tcs(&m_verts[frag->vtx_idx], data + off, frag->vtx_count);
+  off += queue_unpack(VertexUnpack::Kind::TCS, frag->vtx_idx, data + off, frag->vtx_count);
 
   if (off == end_of_vif) {
     return off;
@@ -333,8 +356,8 @@ void Generic2::process_dma_jak1(DmaFollower& dma, u32 next_bucket) {
       ASSERT(up.kind == VifCode::Kind::UNPACK_V3_32);
       ASSERT(continue_vif_transfer.size_bytes * 4 / 48 == up.num);
       ASSERT(up.num == continued_fragment->vtx_count);
-      unpack_vtx_positions(&m_verts[continued_fragment->vtx_idx], continue_vif_transfer.data,
-                           continued_fragment->vtx_count);
+      queue_unpack(VertexUnpack::Kind::POSITIONS, continued_fragment->vtx_idx,
+                   continue_vif_transfer.data, continued_fragment->vtx_count);
       continued_fragment = nullptr;
       auto call = dma.read_and_advance();
       ASSERT(call.size_bytes == 0);
@@ -458,8 +481,8 @@ void Generic2::process_dma_jak2(DmaFollower& dma, u32 next_bucket) {
       ASSERT(up.kind == VifCode::Kind::UNPACK_V3_32);
       ASSERT(vif_transfer.size_bytes * 4 / 48 == up.num);
       ASSERT(up.num == continued_fragment->vtx_count);
-      unpack_vtx_positions(&m_verts[continued_fragment->vtx_idx], vif_transfer.data,
-                           continued_fragment->vtx_count);
+      queue_unpack(VertexUnpack::Kind::POSITIONS, continued_fragment->vtx_idx, vif_transfer.data,
+                   continued_fragment->vtx_count);
       continued_fragment = nullptr;
       auto call = dma.read_and_advance();
       ASSERT(call.size_bytes == 0);
@@ -626,7 +649,7 @@ void Generic2::process_dma_lightning(DmaFollower& dma, u32 next_bucket) {
     frag->vtx_count = num_vtx;
     frag->vtx_idx = m_next_free_vert;
     alloc_vtx(num_vtx);
-    unpack_vertex(&m_verts[frag->vtx_idx], second_upload.data, num_vtx);
+    queue_unpack(VertexUnpack::Kind::LIGHTNING, frag->vtx_idx, second_upload.data, num_vtx);
 
     // run
     //  192: NOP UNPACK-V4-32: 12 addr: 837 us: false tops: false
@@ -645,4 +668,42 @@ void Generic2::process_dma_lightning(DmaFollower& dma, u32 next_bucket) {
   auto end = dma.read_and_advance();
   (void)end;
   ASSERT(next_bucket == dma.current_tag_offset());
-}
\ No newline at end of file
+}
+
+/*!
+ * Unpack all the vertex data found by process_dma. Each unpack writes its own range of m_verts (or
+ * its own fields of it), so they can be spread across the thread pool. Finding them can't be,
+ * because where a fragment's vertices go depends on all the fragments before it.
+ */
+void Generic2::unpack_vertices() {
+  auto run = [&](const VertexUnpack& up) {
+    auto* vtx = &m_verts[up.vtx_idx];
+    switch (up.kind) {
+      case VertexUnpack::Kind::POSITIONS:
+        unpack_vtx_positions(vtx, up.data, up.count);
+        break;
+      case VertexUnpack::Kind::COLORS:
+        unpack_vertex_colors(vtx, up.data, up.count);
+        break;
+      case VertexUnpack::Kind::TCS:
+        unpack_vtx_tcs(vtx, up.data, up.count);
+        break;
+      case VertexUnpack::Kind::LIGHTNING:
+        unpack_vertex(vtx, up.data, up.count);
+        break;
+      default:
+        ASSERT_NOT_REACHED();
+    }
+  };
+
+  if (!m_parallel_vertex_build || m_next_free_vert < PARALLEL_MIN_VERTS) {
+    for (const auto& up : m_vertex_unpacks) {
+      run(up);
+    }
+    return;
+  }
+  ParallelForOptions options;
+  options.priority = TaskPriority::HIGH;
+  options.grain = 32;
+  parallel_for(m_vertex_unpacks.size(), [&](int i) { run(m_vertex_unpacks[i]); }, options);
+}
@@ -3,65 +3,61 @@
 #include "Generic2.h"
 
 void Generic2::opengl_setup() {
-  // create OpenGL objects
-  glGenBuffers(1, &m_ogl.vertex_buffer);
-  glGenBuffers(1, &m_ogl.index_buffer);
+  // create OpenGL objects. The vertex data is streamed through the shared ring buffer, so the
+  // vertex array uses a separate buffer binding that's pointed at the ring before each draw.
+  // The indices are often the same as last frame, so they have their own buffer.
   glGenVertexArrays(1, &m_ogl.vao);
+  glGenBuffers(1, &m_ogl.index_buffer);
 
   // set up the vertex array
   glBindVertexArray(m_ogl.vao);
   glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ogl.index_buffer);
-  glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_indices.size() * sizeof(u32), nullptr, GL_STREAM_DRAW);
-  glBindBuffer(GL_ARRAY_BUFFER, m_ogl.vertex_buffer);
-  glBufferData(GL_ARRAY_BUFFER, m_verts.size() * sizeof(Vertex), nullptr, GL_STREAM_DRAW);
 
   // xyz
   glEnableVertexAttribArray(0);
-  glVertexAttribPointer(0,                            // location 0 in the shader
-                        3,                            // 3 floats per vert
-                        GL_FLOAT,                     // floats
-                        GL_TRUE,                      // normalized, ignored,
-                        sizeof(Vertex),               //
-                        (void*)offsetof(Vertex, xyz)  // offset in array
+  glVertexAttribFormat(0,                     // location 0 in the shader
+                       3,                     // 3 floats per vert
+                       GL_FLOAT,              // floats
+                       GL_TRUE,               // normalized, ignored,
+                       offsetof(Vertex, xyz)  // offset in vertex
   );
+  glVertexAttribBinding(0, 0);
 
   // rgba
   glEnableVertexAttribArray(1);
-  glVertexAttribPointer(1,                             // location 1 in the shader
-                        4,                             // 4 color components
-                        GL_UNSIGNED_BYTE,              // u8
-                        GL_TRUE,                       // normalized (255 becomes 1)
-                        sizeof(Vertex),                //
-                        (void*)offsetof(Vertex, rgba)  //
+  glVertexAttribFormat(1,                      // location 1 in the shader
+                       4,                      // 4 color components
+                       GL_UNSIGNED_BYTE,       // u8
+                       GL_TRUE,                // normalized (255 becomes 1)
+                       offsetof(Vertex, rgba)  //
   );
+  glVertexAttribBinding(1, 0);
 
   // stq
   glEnableVertexAttribArray(2);
-  glVertexAttribPointer(2,                           // location 2 in the shader
-                        2,                           // 2 floats per vert
-                        GL_FLOAT,                    // floats
-                        GL_FALSE,                    // normalized, ignored
-                        sizeof(Vertex),              //
-                        (void*)offsetof(Vertex, st)  // offset in array
+  glVertexAttribFormat(2,                    // location 2 in the shader
+                       2,                    // 2 floats per vert
+                       GL_FLOAT,             // floats
+                       GL_FALSE,             // normalized, ignored
+                       offsetof(Vertex, st)  // offset in vertex
   );
+  glVertexAttribBinding(2, 0);
 
   // byte data
   glEnableVertexAttribArray(3);
-  glVertexAttribIPointer(3,                                 // location 3 in the shader
-                         4,                                 //
-                         GL_UNSIGNED_BYTE,                  // u8's
-                         sizeof(Vertex),                    //
-                         (void*)offsetof(Vertex, tex_unit)  // offset in array
+  glVertexAttribIFormat(3,                          // location 3 in the shader
+                        4,                          //
+                        GL_UNSIGNED_BYTE,           // u8's
+                        offsetof(Vertex, tex_unit)  // offset in vertex
   );
+  glVertexAttribBinding(3, 0);
 
-  glBindBuffer(GL_ARRAY_BUFFER, 0);
   glBindVertexArray(0);
 }
 
 void Generic2::opengl_cleanup() {
-  glDeleteBuffers(1, &m_ogl.vertex_buffer);
-  glDeleteBuffers(1, &m_ogl.index_buffer);
   glDeleteVertexArrays(1, &m_ogl.vao);
+  glDeleteBuffers(1, &m_ogl.index_buffer);
 }
 
 void Generic2::init_shaders(ShaderLibrary& shaders) {
@@ -122,48 +118,49 @@ void Generic2::setup_opengl_for_draw_mode(const DrawMode& draw_mode,
   // setup blending and color mult
   float color_mult = 1.f;
   if (!draw_mode.get_ab_enable()) {
-    glDisable(GL_BLEND);
+    render_state->gl_state.disable(GL_BLEND);
   } else {
-    glEnable(GL_BLEND);
-    glBlendColor(1, 1, 1, 1);
+    render_state->gl_state.enable(GL_BLEND);
+    render_state->gl_state.blend_color(1, 1, 1, 1);
     if (draw_mode.get_alpha_blend() == DrawMode::AlphaBlend::SRC_DST_SRC_DST) {
       // (Cs - Cd) * As + Cd
       // Cs * As  + (1 - As) * Cd
       // s, d
-      glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ZERO);
-      glBlendEquation(GL_FUNC_ADD);
+      render_state->gl_state.blend_func_separate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE,
+                                                 GL_ZERO);
+      render_state->gl_state.blend_equation(GL_FUNC_ADD);
     } else if (draw_mode.get_alpha_blend() == DrawMode::AlphaBlend::SRC_0_SRC_DST) {
       // (Cs - 0) * As + Cd
       // Cs * As + (1) * Cd
       // s, d
       // fix is ignored. it's usually 0, except for lightning, which sets it to 0x80.
-      glBlendFunc(GL_SRC_ALPHA, GL_ONE);
-      glBlendEquation(GL_FUNC_ADD);
+      render_state->gl_state.blend_func(GL_SRC_ALPHA, GL_ONE);
+      render_state->gl_state.blend_equation(GL_FUNC_ADD);
     } else if (draw_mode.get_alpha_blend() == DrawMode::AlphaBlend::ZERO_SRC_SRC_DST) {
       // (0 - Cs) * As + Cd
       // Cd - Cs * As
       // s, d
-      glBlendFunc(GL_SRC_ALPHA, GL_ONE);
-      glBlendEquation(GL_FUNC_REVERSE_SUBTRACT);
+      render_state->gl_state.blend_func(GL_SRC_ALPHA, GL_ONE);
+      render_state->gl_state.blend_equation(GL_FUNC_REVERSE_SUBTRACT);
     } else if (draw_mode.get_alpha_blend() == DrawMode::AlphaBlend::SRC_DST_FIX_DST) {
       // (Cs - Cd) * fix + Cd
       // Cs * fix + (1 - fx) * Cd
-      glBlendFunc(GL_CONSTANT_ALPHA, GL_ONE_MINUS_CONSTANT_ALPHA);
-      glBlendColor(0, 0, 0, fix / 127.f);
-      glBlendEquation(GL_FUNC_ADD);
+      render_state->gl_state.blend_func(GL_CONSTANT_ALPHA, GL_ONE_MINUS_CONSTANT_ALPHA);
+      render_state->gl_state.blend_color(0, 0, 0, fix / 127.f);
+      render_state->gl_state.blend_equation(GL_FUNC_ADD);
     } else if (draw_mode.get_alpha_blend() == DrawMode::AlphaBlend::SRC_SRC_SRC_SRC) {
       // this is very weird...
       // Cs
-      glBlendFunc(GL_ONE, GL_ZERO);
-      glBlendEquation(GL_FUNC_ADD);
+      render_state->gl_state.blend_func(GL_ONE, GL_ZERO);
+      render_state->gl_state.blend_equation(GL_FUNC_ADD);
     } else if (draw_mode.get_alpha_blend() == DrawMode::AlphaBlend::SRC_0_DST_DST) {
       // (Cs - 0) * Ad + Cd
-      glBlendFunc(GL_DST_ALPHA, GL_ONE);
-      glBlendEquation(GL_FUNC_ADD);
+      render_state->gl_state.blend_func(GL_DST_ALPHA, GL_ONE);
+      render_state->gl_state.blend_equation(GL_FUNC_ADD);
       color_mult = 1.0f;
     } else if (draw_mode.get_alpha_blend() == DrawMode::AlphaBlend::SRC_0_FIX_DST) {
-      glBlendEquation(GL_FUNC_ADD);
-      glBlendFuncSeparate(GL_ONE, GL_ONE, GL_ONE, GL_ZERO);
+      render_state->gl_state.blend_equation(GL_FUNC_ADD);
+      render_state->gl_state.blend_func_separate(GL_ONE, GL_ONE, GL_ONE, GL_ZERO);
     } else {
       ASSERT(false);
     }
@@ -171,19 +168,19 @@ void Generic2::setup_opengl_for_draw_mode(const DrawMode& draw_mode,
 
   // setup ztest
   if (draw_mode.get_zt_enable()) {
-    glEnable(GL_DEPTH_TEST);
+    render_state->gl_state.enable(GL_DEPTH_TEST);
     switch (draw_mode.get_depth_test()) {
       case GsTest::ZTest::NEVER:
-        glDepthFunc(GL_NEVER);
+        render_state->gl_state.depth_func(GL_NEVER);
         break;
       case GsTest::ZTest::ALWAYS:
-        glDepthFunc(GL_ALWAYS);
+        render_state->gl_state.depth_func(GL_ALWAYS);
         break;
       case GsTest::ZTest::GEQUAL:
-        glDepthFunc(GL_GEQUAL);
+        render_state->gl_state.depth_func(GL_GEQUAL);
         break;
       case GsTest::ZTest::GREATER:
-        glDepthFunc(GL_GREATER);
+        render_state->gl_state.depth_func(GL_GREATER);
         break;
       default:
         ASSERT(false);
@@ -194,9 +191,9 @@ void Generic2::setup_opengl_for_draw_mode(const DrawMode& draw_mode,
   }
 
   if (draw_mode.get_depth_write_enable()) {
-    glDepthMask(GL_TRUE);
+    render_state->gl_state.depth_mask(true);
   } else {
-    glDepthMask(GL_FALSE);
+    render_state->gl_state.depth_mask(false);
   }
 
   glUniform1f(m_ogl.alpha_reject, alpha_reject);
@@ -229,8 +226,8 @@ void Generic2::setup_opengl_tex(u16 unit,
     tex = render_state->texture_pool->get_placeholder_texture();
   }
 
-  glActiveTexture(GL_TEXTURE0 + unit);
-  glBindTexture(GL_TEXTURE_2D, *tex);
+  render_state->gl_state.active_texture(GL_TEXTURE0 + unit);
+  render_state->gl_state.bind_texture(GL_TEXTURE_2D, *tex);
   if (clamp_s) {
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
   } else {
@@ -298,14 +295,20 @@ void Generic2::do_hud_draws(SharedRenderState* render_state, ScopedProfilerNode&
 }
 
 void Generic2::do_draws(SharedRenderState* render_state, ScopedProfilerNode& prof) {
+  auto& ring = render_state->stream_buffer;
+  u32 vertex_offset =
+      ring.upload(m_verts.data(), m_next_free_vert * sizeof(Vertex), sizeof(Vertex));
+
   glBindVertexArray(m_ogl.vao);
-  glBindBuffer(GL_ARRAY_BUFFER, m_ogl.vertex_buffer);
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ogl.index_buffer);
-  glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_next_free_idx * sizeof(u32), m_indices.data(),
-               GL_STREAM_DRAW);
-  glBufferData(GL_ARRAY_BUFFER, m_next_free_vert * sizeof(Vertex), m_verts.data(), GL_STREAM_DRAW);
+  glBindVertexBuffer(0, ring.buffer(), vertex_offset, sizeof(Vertex));
+  if (m_layout_cache.indices_dirty) {
+    // the vertex array has the index buffer bound.
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_next_free_idx * sizeof(u32), m_indices.data(),
+                 GL_STREAM_DRAW);
+    m_layout_cache.indices_dirty = false;
+  }
 
-  glEnable(GL_PRIMITIVE_RESTART);
+  render_state->gl_state.enable(GL_PRIMITIVE_RESTART);
   glPrimitiveRestartIndex(UINT32_MAX);
 
   opengl_bind_and_setup_proj(render_state);
@@ -1,11 +1,13 @@
 #include "Merc2.h"
 
-#include <xmmintrin.h>
+#include <immintrin.h>
 
 #include "common/global_profiler/GlobalProfiler.h"
+#include "common/util/os.h"
 
 #include "game/graphics/opengl_renderer/EyeRenderer.h"
 #include "game/graphics/opengl_renderer/background/background_common.h"
+#include "game/graphics/opengl_renderer/foreground/merc_blerc.h"
 
 #include "third-party/imgui/imgui.h"
 
@@ -15,7 +17,8 @@
 
  The PC format renderer does the usual tricks of buffering stuff head of time as much as possible.
  The main trick here is to buffer up draws and upload "bones" (skinning matrix) for many draws all
- at once.
+ at once. The bones are bound once per flush as a shader storage buffer, and each draw picks its
+ bones with the base instance of an instanced draw, so there are no per-draw buffer binds.
 
  The other tricky part is "mod vertices", which may be modified by the game.
  We know ahead of time which vertices could be modified, and have a way to upload only those
@@ -41,7 +44,6 @@
  * - port blerc to C++, do it in the rendering thread and avoid the lock.
  * - combine envmap draws per effect (might require some funky indexing stuff, or multidraw)
  * - smaller vertex formats for mod-vertex
- * - AVX version of vertex conversion math
  * - eliminate the "copy" step of vertex modification
  * - batch uploading the vertex modification data
  */
@@ -54,31 +56,25 @@ Merc2::Merc2(const std::string& name, int my_id) : BucketRenderer(name, my_id) {
   glGenVertexArrays(1, &m_vao);
   glBindVertexArray(m_vao);
 
-  // Bone buffer to store skinning matrices for multiple draws
-  glGenBuffers(1, &m_bones_buffer);
-  glBindBuffer(GL_UNIFORM_BUFFER, m_bones_buffer);
+  // Skinning matrices for multiple draws are uploaded to the shared stream buffer on each flush.
 
-  // zero initialize the bone buffer.
-  std::vector<u8> temp(MAX_SHADER_BONE_VECTORS * sizeof(math::Vector4f));
-  glBufferData(GL_UNIFORM_BUFFER, MAX_SHADER_BONE_VECTORS * sizeof(math::Vector4f), temp.data(),
-               GL_DYNAMIC_DRAW);
-  glBindBuffer(GL_UNIFORM_BUFFER, 0);
-
-  // annoyingly, glBindBufferRange can have alignment restrictions that vary per platform.
-  // the GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT gives us the minimum alignment for views into the bone
-  // buffer. The bone buffer stores things per-16-byte "quadword".
+  // glBindBufferRange has an alignment restriction that varies per platform. It only applies to
+  // the start of the bone buffer, bones within the buffer are tightly packed.
   GLint val;
-  glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &val);
-  if (val <= 16) {
-    // somehow doubt this can happen, but just in case
-    m_opengl_buffer_alignment = 1;
-  } else {
-    m_opengl_buffer_alignment = val / 16;  // number of bone vectors
-    if (m_opengl_buffer_alignment * 16 != (u32)val) {
-      ASSERT_MSG(false,
-                 fmt::format("opengl uniform buffer alignment is {}, which is strange\n", val));
-    }
+  glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &val);
+  m_opengl_buffer_alignment = std::max(val, 16);
+
+  // The vertex shader finds the bones for a draw with a per-instance attribute. Each draw is a
+  // single instance, with the base instance set to the index of its first bone.
+  std::vector<u32> bone_indices(MAX_SHADER_BONE_VECTORS / 8);
+  for (size_t i = 0; i < bone_indices.size(); i++) {
+    bone_indices[i] = i;
   }
+  glGenBuffers(1, &m_bone_index_buffer);
+  glBindBuffer(GL_ARRAY_BUFFER, m_bone_index_buffer);
+  glBufferData(GL_ARRAY_BUFFER, bone_indices.size() * sizeof(u32), bone_indices.data(),
+               GL_STATIC_DRAW);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
 
   // initialize draw buffers, these will store lists of draws to flush.
   for (int i = 0; i < MAX_LEVELS; i++) {
@@ -101,61 +97,56 @@ Merc2::~Merc2() {
     glDeleteVertexArrays(1, &x.vao);
   }
 
-  glDeleteBuffers(1, &m_bones_buffer);
   glDeleteVertexArrays(1, &m_vao);
+  glDeleteBuffers(1, &m_bone_index_buffer);
 }
 
+namespace {
 /*!
- * Modify vertices for blerc.
+ * Unpack a single mod vertex from VU1 lump data, using the same float tricks as the VU program.
+ * The 3 quadwords of the vertex have the position in the w bytes, the normal in the z bytes, and
+ * the texture coordinates in the x/y bytes of the last quadword.
  */
-void blerc_avx(const u32* i_data,
-               const u32* i_data_end,
-               const tfrag3::BlercFloatData* floats,
-               const float* weights,
-               tfrag3::MercVertex* out,
-               float multiplier) {
-  // store a table of weights. It's faster to load the 16-bytes of weights than load and broadcast
-  // the float.
-  __m128 weights_table[Merc2::kMaxBlerc];
-  for (int i = 0; i < Merc2::kMaxBlerc; i++) {
-    weights_table[i] = _mm_set1_ps(weights[i] * multiplier);
-  }
-
-  // loop over vertices
-  while (i_data != i_data_end) {
-    // load the base position
-    __m128 pos = _mm_load_ps(floats->v);
-    __m128 nrm = _mm_load_ps(floats->v + 4);
-    floats++;
-
-    // loop over targets
-    while (*i_data != tfrag3::Blerc::kTargetIdxTerminator) {
-      // get the weights for this target, from the game data.
-      __m128 weight_multiplier = weights_table[*i_data];
-      // get the pos/normal offset for this target.
-      __m128 posm = _mm_load_ps(floats->v);
-      __m128 nrmm = _mm_load_ps(floats->v + 4);
-      floats++;
-
-      // apply weights and add
-      posm = _mm_mul_ps(posm, weight_multiplier);
-      nrmm = _mm_mul_ps(nrmm, weight_multiplier);
-      pos = _mm_add_ps(pos, posm);
-      nrm = _mm_add_ps(nrm, nrmm);
-
-      i_data++;
-    }
-    i_data++;
-
-    // store final position/normal.
-    _mm_store_ps(out[*i_data].pos, pos);
-    _mm_store_ps(out[*i_data].normal, nrm);
-    i_data++;
-  }
+void unpack_mod_vertex_sse(const u8* vtx_data,
+                           __m128 float_offsets,
+                           __m128 xyz_scale,
+                           __m128i st_vif_add,
+                           __m128 st_magic,
+                           float* pos_out,
+                           float* nrm_out,
+                           float* uv_out) {
+  u8 raw_bytes[16] = {0};
+  memcpy(raw_bytes, vtx_data, 12);
+  __m128i raw = _mm_loadu_si128((const __m128i*)raw_bytes);
+
+  // gather bytes into the low byte of each 32-bit lane. The last lane (or last two for st) is 0.
+  const __m128i pos_shuffle = _mm_setr_epi8(3, -1, -1, -1, 7, -1, -1, -1, 11, -1, -1, -1, -1, -1,
+                                            -1, -1);
+  const __m128i nrm_shuffle = _mm_setr_epi8(2, -1, -1, -1, 6, -1, -1, -1, 10, -1, -1, -1, -1, -1,
+                                            -1, -1);
+  const __m128i uv_shuffle = _mm_setr_epi8(8, -1, -1, -1, 9, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                           -1, -1);
+
+  // positions: (0x4b010000 + byte) as a float, then offset and scale.
+  __m128i pos_i = _mm_add_epi32(_mm_shuffle_epi8(raw, pos_shuffle),
+                                _mm_setr_epi32(0x4b010000, 0x4b010000, 0x4b010000, 0));
+  __m128 pos = _mm_mul_ps(_mm_add_ps(_mm_castsi128_ps(pos_i), float_offsets), xyz_scale);
+  _mm_storeu_ps(pos_out, pos);
+
+  // normals: (0x47800000 + byte) as a float, minus 65537.
+  __m128i nrm_i = _mm_add_epi32(_mm_shuffle_epi8(raw, nrm_shuffle),
+                                _mm_setr_epi32(0x47800000, 0x47800000, 0x47800000, 0));
+  __m128 nrm = _mm_add_ps(_mm_castsi128_ps(nrm_i), _mm_setr_ps(-65537, -65537, -65537, 0));
+  _mm_storeu_ps(nrm_out, nrm);
+
+  // uvs: (st_vif_add + byte) as a float, plus st_magic.
+  __m128i uv_i = _mm_add_epi32(_mm_shuffle_epi8(raw, uv_shuffle), st_vif_add);
+  __m128 uv = _mm_add_ps(_mm_castsi128_ps(uv_i), st_magic);
+  _mm_storel_pi((__m64*)uv_out, uv);
 }
-namespace {
+
 float blerc_multiplier = 1.f;
-}
+}  // namespace
 
 void Merc2::model_mod_blerc_draws(int num_effects,
                                   const tfrag3::MercModel* model,
@@ -189,7 +180,7 @@ void Merc2::model_mod_blerc_draws(int num_effects,
     const auto* f_data = effect.mod.blerc.float_data.data();
     const u32* i_data = effect.mod.blerc.int_data.data();
     const u32* i_data_end = i_data + effect.mod.blerc.int_data.size();
-    blerc_avx(i_data, i_data_end, f_data, blerc_weights, m_mod_vtx_temp.data(), blerc_multiplier);
+    blerc(i_data, i_data_end, f_data, blerc_weights, m_mod_vtx_temp.data(), blerc_multiplier);
 
     // and upload to GPU
     m_stats.num_uploads++;
@@ -263,8 +254,9 @@ void Merc2::model_mod_draws(int num_effects,
 
     // loop over frags
     u32 vidx = 0;
-    // u32 st_vif_add = model->st_vif_add;
-    float xyz_scale = model->xyz_scale;
+    const __m128 xyz_scale = _mm_set1_ps(model->xyz_scale);
+    const __m128i st_vif_add = _mm_set1_epi32(model->st_vif_add);
+    const __m128 st_magic = _mm_set1_ps(model->st_magic);
     prof().end_event();
     {
       // we're going to look at data that the game may be modifying.
@@ -289,52 +281,17 @@ void Merc2::model_mod_draws(int num_effects,
           u8 unsigned_four_count = frag_ctrl[0];
           u8 lump_four_count = frag_ctrl[1];
           u32 mm_qwc_off = frag[10];
-          float float_offsets[3];
+          float float_offsets[4] = {0, 0, 0, 0};
           memcpy(float_offsets, &frag[mm_qwc_off * 16], 12);
+          const __m128 float_offsets_vec = _mm_loadu_ps(float_offsets);
           u32 my_u4_count = ((unsigned_four_count + 3) / 4) * 16;
           u32 my_l4_count = my_u4_count + ((lump_four_count + 3) / 4) * 16;
 
           // loop over vertices in the fragment and unpack
           for (u32 w = my_u4_count / 4; w < (my_l4_count / 4) - 2; w += 3) {
-            // positions
-            u32 q0w = 0x4b010000 + frag[w * 4 + (0 * 4) + 3];
-            u32 q1w = 0x4b010000 + frag[w * 4 + (1 * 4) + 3];
-            u32 q2w = 0x4b010000 + frag[w * 4 + (2 * 4) + 3];
-
-            // normals
-            u32 q0z = 0x47800000 + frag[w * 4 + (0 * 4) + 2];
-            u32 q1z = 0x47800000 + frag[w * 4 + (1 * 4) + 2];
-            u32 q2z = 0x47800000 + frag[w * 4 + (2 * 4) + 2];
-
-            // uvs
-            u32 q2x = model->st_vif_add + frag[w * 4 + (2 * 4) + 0];
-            u32 q2y = model->st_vif_add + frag[w * 4 + (2 * 4) + 1];
-
-            auto* pos_array = m_mod_vtx_unpack_temp[vidx].pos;
-            memcpy(&pos_array[0], &q0w, 4);
-            memcpy(&pos_array[1], &q1w, 4);
-            memcpy(&pos_array[2], &q2w, 4);
-            pos_array[0] += float_offsets[0];
-            pos_array[1] += float_offsets[1];
-            pos_array[2] += float_offsets[2];
-            pos_array[0] *= xyz_scale;
-            pos_array[1] *= xyz_scale;
-            pos_array[2] *= xyz_scale;
-
-            auto* nrm_array = m_mod_vtx_unpack_temp[vidx].nrm;
-            memcpy(&nrm_array[0], &q0z, 4);
-            memcpy(&nrm_array[1], &q1z, 4);
-            memcpy(&nrm_array[2], &q2z, 4);
-            nrm_array[0] += -65537;
-            nrm_array[1] += -65537;
-            nrm_array[2] += -65537;
-
-            auto* uv_array = m_mod_vtx_unpack_temp[vidx].uv;
-            memcpy(&uv_array[0], &q2x, 4);
-            memcpy(&uv_array[1], &q2y, 4);
-            uv_array[0] += model->st_magic;
-            uv_array[1] += model->st_magic;
-
+            auto& vtx = m_mod_vtx_unpack_temp[vidx];
+            unpack_mod_vertex_sse(frag + w * 4, float_offsets_vec, xyz_scale, st_vif_add,
+                                  st_magic, vtx.pos, vtx.nrm, vtx.uv);
             vidx++;
           }
         }
@@ -425,14 +382,13 @@ void Merc2::handle_pc_model(const DmaTransfer& setup,
 
   // models use many bones. First check if we need to flush:
   int bone_count = model->max_bones + 1;
-  if (m_next_free_bone_vector + m_opengl_buffer_alignment + bone_count * 8 >
-      MAX_SHADER_BONE_VECTORS) {
+  if (m_next_free_bone_vector + bone_count * 8 > MAX_SHADER_BONE_VECTORS) {
     fmt::print("MERC2 out of bones, consider increasing MAX_SHADER_BONE_VECTORS\n");
     flush_draw_buckets(render_state, proff);
   }
 
   // also sanity check that we have enough to draw the model
-  if (m_opengl_buffer_alignment + bone_count * 8 > MAX_SHADER_BONE_VECTORS) {
+  if (bone_count * 8 > MAX_SHADER_BONE_VECTORS) {
     fmt::print(
         "MERC2 doesn't have enough bones to draw a model, increase MAX_SHADER_BONE_VECTORS\n");
     ASSERT_NOT_REACHED();
@@ -555,20 +511,22 @@ void Merc2::handle_pc_model(const DmaTransfer& setup,
     model_mod_draws(num_effects, model, lev, input_data, setup, mod_opengl_buffers);
   }
 
-  // stats
+  // stats, only shown in the debug window. This loops over every draw, so skip it when closed.
   m_stats.num_models++;
-  for (const auto& effect : model_ref->model->effects) {
-    bool envmap = effect.has_envmap;
-    m_stats.num_effects++;
-    m_stats.num_predicted_draws += effect.all_draws.size();
-    if (envmap) {
-      m_stats.num_envmap_effects++;
+  if (m_debug_window_open) {
+    for (const auto& effect : model_ref->model->effects) {
+      bool envmap = effect.has_envmap;
+      m_stats.num_effects++;
       m_stats.num_predicted_draws += effect.all_draws.size();
-    }
-    for (const auto& draw : effect.all_draws) {
-      m_stats.num_predicted_tris += draw.num_triangles;
       if (envmap) {
+        m_stats.num_envmap_effects++;
+        m_stats.num_predicted_draws += effect.all_draws.size();
+      }
+      for (const auto& draw : effect.all_draws) {
         m_stats.num_predicted_tris += draw.num_triangles;
+        if (envmap) {
+          m_stats.num_predicted_tris += draw.num_triangles;
+        }
       }
     }
   }
@@ -618,9 +576,10 @@ void Merc2::handle_pc_model(const DmaTransfer& setup,
 
       // do fixed draws:
       for (auto& fdraw : effect.mod.fix_draw) {
-        alloc_normal_draw(fdraw, ignore_alpha, lev_bucket, first_bone, lights, uses_water,
-                          model_disables_fog);
-        if (should_envmap) {
+        auto n = alloc_normal_draw(fdraw, ignore_alpha, lev_bucket, first_bone, lights, uses_water,
+                                   model_disables_fog);
+        if (should_envmap && !try_combine_envmap(n, effect.envmap_mode, effect.envmap_texture,
+                                                 fade_buffer + 4 * ei)) {
           try_alloc_envmap_draw(fdraw, effect.envmap_mode, effect.envmap_texture, lev_bucket,
                                 fade_buffer + 4 * ei, first_bone, lights, uses_water);
         }
@@ -633,7 +592,8 @@ void Merc2::handle_pc_model(const DmaTransfer& setup,
         // modify the draw, set the mod flag and point it to the opengl buffer
         n->flags |= MOD_VTX;
         n->mod_vtx_buffer = mod_opengl_buffers[ei];
-        if (should_envmap) {
+        if (should_envmap && !try_combine_envmap(n, effect.envmap_mode, effect.envmap_texture,
+                                                 fade_buffer + 4 * ei)) {
           auto e =
               try_alloc_envmap_draw(mdraw, effect.envmap_mode, effect.envmap_texture, lev_bucket,
                                     fade_buffer + 4 * ei, first_bone, lights, uses_water);
@@ -646,12 +606,13 @@ void Merc2::handle_pc_model(const DmaTransfer& setup,
     } else {
       // no mod, just do all_draws
       for (auto& draw : effect.all_draws) {
-        if (should_envmap) {
+        auto n = alloc_normal_draw(draw, ignore_alpha, lev_bucket, first_bone, lights, uses_water,
+                                   model_disables_fog);
+        if (should_envmap && !try_combine_envmap(n, effect.envmap_mode, effect.envmap_texture,
+                                                 fade_buffer + 4 * ei)) {
           try_alloc_envmap_draw(draw, effect.envmap_mode, effect.envmap_texture, lev_bucket,
                                 fade_buffer + 4 * ei, first_bone, lights, uses_water);
         }
-        alloc_normal_draw(draw, ignore_alpha, lev_bucket, first_bone, lights, uses_water,
-                          model_disables_fog);
       }
     }
   }
@@ -668,6 +629,8 @@ void Merc2::draw_debug_window() {
 
   ImGui::Text("EEffects : %d", m_stats.num_envmap_effects);
   ImGui::Text("ETris    : %d", m_stats.num_envmap_tris);
+  ImGui::Text("ECombine : %d", m_stats.num_combined_envmap_draws);
+  ImGui::Checkbox("Combine envmap draws", &m_combine_envmap);
 
   ImGui::Text("Uploads  : %d", m_stats.num_uploads);
   ImGui::Text("Upload kB: %d", m_stats.num_upload_bytes / 1024);
@@ -698,6 +661,8 @@ void Merc2::draw_debug_window() {
 
 void Merc2::init_shaders(ShaderLibrary& shaders) {
   init_shader_common(shaders[ShaderId::MERC2], &m_merc_uniforms, true);
+  m_merc_uniforms.fade = glGetUniformLocation(shaders[ShaderId::MERC2].id(), "fade");
+  m_merc_uniforms.envmap = glGetUniformLocation(shaders[ShaderId::MERC2].id(), "envmap");
   init_shader_common(shaders[ShaderId::EMERC], &m_emerc_uniforms, false);
   m_emerc_uniforms.fade = glGetUniformLocation(shaders[ShaderId::EMERC].id(), "fade");
 }
@@ -1000,12 +965,6 @@ u32 Merc2::alloc_bones(int count, ShaderMercMat* data) {
     m_next_free_bone_vector += 8;
   }
 
-  auto b0 = m_next_free_bone_vector;
-  m_next_free_bone_vector += m_opengl_buffer_alignment - 1;
-  m_next_free_bone_vector /= m_opengl_buffer_alignment;
-  m_next_free_bone_vector *= m_opengl_buffer_alignment;
-  ASSERT(b0 <= m_next_free_bone_vector);
-  ASSERT(first_bone_vector + count * 8 <= m_next_free_bone_vector);
   return first_bone_vector;
 }
 
@@ -1024,6 +983,55 @@ Merc2::ModBuffers Merc2::alloc_mod_vtx_buffer(const LevelData* lev) {
   return m_mod_vtx_buffers[m_next_mod_vtx_buffer++];
 }
 
+namespace {
+/*!
+ * The envmap draw is added on top of the base draw with the base's alpha: (Cs - 0) * Ad + Cd.
+ * If the base isn't blended and writes depth, and the envmap passes the depth test on the base's
+ * own depth, the merc2 shader can add it in the same draw and get the same result.
+ */
+bool can_combine_envmap(const DrawMode& base, const DrawMode& envmap) {
+  bool base_blended =
+      base.get_ab_enable() && base.get_alpha_blend() != DrawMode::AlphaBlend::DISABLED;
+  // atest NEVER + FB_ONLY is used to disable depth writes.
+  bool base_writes_depth =
+      base.get_depth_write_enable() &&
+      !(base.get_at_enable() && base.get_alpha_test() == DrawMode::AlphaTest::NEVER);
+  bool envmap_passes_on_base = !envmap.get_zt_enable() ||
+                               envmap.get_depth_test() == GsTest::ZTest::GEQUAL ||
+                               envmap.get_depth_test() == GsTest::ZTest::ALWAYS;
+  return !base_blended && base_writes_depth && envmap_passes_on_base && envmap.get_ab_enable() &&
+         envmap.get_alpha_blend() == DrawMode::AlphaBlend::SRC_0_DST_DST;
+}
+}  // namespace
+
+/*!
+ * Add the envmap to a normal draw, so it doesn't need a second draw. Returns false if it can't be,
+ * and the envmap needs its own draw.
+ */
+bool Merc2::try_combine_envmap(Draw* draw,
+                               const DrawMode& envmap_mode,
+                               u32 envmap_texture,
+                               const u8* fade) {
+  if (!m_combine_envmap || !can_combine_envmap(draw->mode, envmap_mode)) {
+    return false;
+  }
+  bool nonzero_fade = false;
+  for (int i = 0; i < 4; i++) {
+    draw->fade[i] = fade[i];
+    if (fade[i]) {
+      nonzero_fade = true;
+    }
+  }
+  // with no fade, there's no envmap to draw at all.
+  if (nonzero_fade) {
+    draw->flags |= ENVMAP;
+    draw->envmap_texture = envmap_texture;
+    draw->envmap_mode = envmap_mode;
+    m_stats.num_combined_envmap_draws++;
+  }
+  return true;
+}
+
 Merc2::Draw* Merc2::try_alloc_envmap_draw(const tfrag3::MercDraw& mdraw,
                                           const DrawMode& envmap_mode,
                                           u32 envmap_texture,
@@ -1098,16 +1106,12 @@ Merc2::Draw* Merc2::alloc_normal_draw(const tfrag3::MercDraw& mdraw,
 }
 
 void Merc2::setup_merc_vao() {
-  glEnable(GL_PRIMITIVE_RESTART);
-  glPrimitiveRestartIndex(UINT32_MAX);
   glEnableVertexAttribArray(0);
   glEnableVertexAttribArray(1);
   glEnableVertexAttribArray(2);
   glEnableVertexAttribArray(3);
   glEnableVertexAttribArray(4);
   glEnableVertexAttribArray(5);
-  glEnable(GL_DEPTH_TEST);
-  glDepthFunc(GL_GEQUAL);
 
   glVertexAttribPointer(0,                                        // location 0 in the shader
                         3,                                        // 3 values per vert
@@ -1155,10 +1159,33 @@ void Merc2::setup_merc_vao() {
                          sizeof(tfrag3::MercVertex),                   //
                          (void*)offsetof(tfrag3::MercVertex, mats[0])  // offset in array
   );
+
+  // first bone of the draw, from the base instance.
+  GLint vertex_buffer;
+  glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &vertex_buffer);
+  glBindBuffer(GL_ARRAY_BUFFER, m_bone_index_buffer);
+  glEnableVertexAttribArray(6);
+  glVertexAttribIPointer(6, 1, GL_UNSIGNED_INT, sizeof(u32), (void*)0);
+  glVertexAttribDivisor(6, 1);
+  glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer);
 }
 
 void Merc2::flush_draw_buckets(SharedRenderState* render_state, ScopedProfilerNode& prof) {
   m_stats.num_draw_flush++;
+
+  // the bones are shared by all levels, so only upload and bind them once.
+  m_stats.num_bones_uploaded += m_next_free_bone_vector;
+  u32 bones_bytes = std::max(m_next_free_bone_vector, 8u) * sizeof(math::Vector4f);
+  u32 bones_offset = render_state->stream_buffer.upload(
+      m_shader_bone_vector_buffer, bones_bytes, m_opengl_buffer_alignment);
+  glBindBufferRange(GL_SHADER_STORAGE_BUFFER, 1, render_state->stream_buffer.buffer(),
+                    bones_offset, bones_bytes);
+
+  render_state->gl_state.enable(GL_PRIMITIVE_RESTART);
+  glPrimitiveRestartIndex(UINT32_MAX);
+  render_state->gl_state.enable(GL_DEPTH_TEST);
+  render_state->gl_state.depth_func(GL_GEQUAL);
+
   for (u32 li = 0; li < m_next_free_level_bucket; li++) {
     const auto& lev_bucket = m_level_draw_buckets[li];
     const auto* lev = lev_bucket.level;
@@ -1166,12 +1193,6 @@ void Merc2::flush_draw_buckets(SharedRenderState* render_state, ScopedProfilerNo
     glBindBuffer(GL_ARRAY_BUFFER, lev->merc_vertices);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, lev->merc_indices);
     setup_merc_vao();
-    m_stats.num_bones_uploaded += m_next_free_bone_vector;
-
-    glBindBuffer(GL_UNIFORM_BUFFER, m_bones_buffer);
-    glBufferSubData(GL_UNIFORM_BUFFER, 0, m_next_free_bone_vector * sizeof(math::Vector4f),
-                    m_shader_bone_vector_buffer);
-    glBindBuffer(GL_UNIFORM_BUFFER, 0);
 
     switch_to_merc2(render_state);
     do_draws(lev_bucket.draws.data(), lev, lev_bucket.next_free_draw, m_merc_uniforms, prof, false,
@@ -1202,6 +1223,11 @@ void Merc2::do_draws(const Draw* draw_array,
   bool normal_vtx_buffer_bound = true;
 
   bool fog_on = true;
+  // only the merc2 shader can add an envmap to the draw.
+  bool envmap_on = false;
+  if (!set_fade) {
+    glUniform1i(uniforms.envmap, 0);
+  }
 
   for (u32 di = 0; di < num_draws; di++) {
     auto& draw = draw_array[di];
@@ -1234,11 +1260,11 @@ void Merc2::do_draws(const Draw* draw_array,
     bool use_mipmaps_for_filtering = true;
     if ((int)draw.texture != last_tex) {
       if (draw.texture < lev->textures.size()) {
-        glBindTexture(GL_TEXTURE_2D, lev->textures.at(draw.texture));
+        render_state->gl_state.bind_texture(GL_TEXTURE_2D, lev->textures.at(draw.texture));
       } else if ((draw.texture & 0xffffff00) == 0xffffff00) {
         auto maybe_eye = render_state->eye_renderer->lookup_eye_texture(draw.texture & 0xff);
         if (maybe_eye) {
-          glBindTexture(GL_TEXTURE_2D, *maybe_eye);
+          render_state->gl_state.bind_texture(GL_TEXTURE_2D, *maybe_eye);
         }
         use_mipmaps_for_filtering = false;
       } else {
@@ -1257,7 +1283,29 @@ void Merc2::do_draws(const Draw* draw_array,
       set_uniform(uniforms.light_ambient, m_lights_buffer[draw.light_idx].ambient);
       last_light = draw.light_idx;
     }
-    setup_opengl_from_draw_mode(draw.mode, GL_TEXTURE0, use_mipmaps_for_filtering);
+    if (!set_fade) {
+      bool envmap = draw.flags & ENVMAP;
+      if (envmap != envmap_on) {
+        glUniform1i(uniforms.envmap, envmap);
+        envmap_on = envmap;
+      }
+      if (envmap) {
+        math::Vector4f fade =
+            math::Vector4f(draw.fade[0], draw.fade[1], draw.fade[2], draw.fade[3]) / 255.f;
+        set_uniform(uniforms.fade, fade);
+        auto& gl_state = render_state->gl_state;
+        gl_state.active_texture(GL_TEXTURE1);
+        if (draw.envmap_texture < lev->textures.size()) {
+          gl_state.bind_texture(GL_TEXTURE_2D, lev->textures.at(draw.envmap_texture));
+        }
+        gl_state.bind_sampler(1, render_state->draw_mode_samplers.get(
+                                     draw.envmap_mode.get_clamp_s_enable(),
+                                     draw.envmap_mode.get_clamp_t_enable(),
+                                     draw.envmap_mode.get_filt_enable(), true));
+        gl_state.active_texture(GL_TEXTURE0);
+      }
+    }
+    setup_opengl_from_draw_mode(render_state, draw.mode, GL_TEXTURE0, use_mipmaps_for_filtering);
 
     glUniform1i(uniforms.decal, draw.mode.get_decal());
 
@@ -1271,10 +1319,9 @@ void Merc2::do_draws(const Draw* draw_array,
 
     prof.add_draw_call();
     prof.add_tri(draw.num_triangles);
-    glBindBufferRange(GL_UNIFORM_BUFFER, 1, m_bones_buffer,
-                      sizeof(math::Vector4f) * draw.first_bone, 128 * sizeof(ShaderMercMat));
-    glDrawElements(GL_TRIANGLE_STRIP, draw.index_count, GL_UNSIGNED_INT,
-                   (void*)(sizeof(u32) * draw.first_index));
+    glDrawElementsInstancedBaseInstance(GL_TRIANGLE_STRIP, draw.index_count, GL_UNSIGNED_INT,
+                                        (void*)(sizeof(u32) * draw.first_index), 1,
+                                        draw.first_bone / 8);
   }
 
   if (!normal_vtx_buffer_bound) {
@@ -1,5 +1,6 @@
 #pragma once
 #include "game/graphics/opengl_renderer/BucketRenderer.h"
+#include "game/graphics/opengl_renderer/foreground/merc_blerc.h"
 
 class Merc2 : public BucketRenderer {
  public:
@@ -8,10 +9,11 @@ class Merc2 : public BucketRenderer {
   void draw_debug_window() override;
   void init_shaders(ShaderLibrary& shaders) override;
   void render(DmaFollower& dma, SharedRenderState* render_state, ScopedProfilerNode& prof) override;
-  static constexpr int kMaxBlerc = 40;
+  static constexpr int kMaxBlerc = kMaxBlercTargets;
 
  private:
   bool m_debug_mode = false;
+  bool m_combine_envmap = true;
   struct DrawDebug {
     DrawMode mode;
     int num_tris;
@@ -112,6 +114,7 @@ class Merc2 : public BucketRenderer {
     GLuint gfx_hack_no_tex;
 
     GLuint fade;
+    GLuint envmap;
   };
 
   Uniforms m_merc_uniforms, m_emerc_uniforms;
@@ -145,8 +148,6 @@ class Merc2 : public BucketRenderer {
 
   ModBuffers alloc_mod_vtx_buffer(const LevelData* lev);
 
-  GLuint m_bones_buffer;
-
   struct Stats {
     int num_models = 0;
     int num_missing_models = 0;
@@ -160,6 +161,7 @@ class Merc2 : public BucketRenderer {
 
     int num_envmap_effects = 0;
     int num_envmap_tris = 0;
+    int num_combined_envmap_draws = 0;
 
     int num_upload_bytes = 0;
     int num_uploads = 0;
@@ -168,6 +170,7 @@ class Merc2 : public BucketRenderer {
   enum DrawFlags {
     IGNORE_ALPHA = 1,
     MOD_VTX = 2,
+    ENVMAP = 4,  // the envmap is drawn in the same draw, see try_combine_envmap
   };
 
   struct Draw {
@@ -181,6 +184,9 @@ class Merc2 : public BucketRenderer {
     u8 flags;
     ModBuffers mod_vtx_buffer;
     u8 fade[4];
+    // only for draws with the ENVMAP flag
+    u32 envmap_texture;
+    DrawMode envmap_mode;
   };
 
   struct LevelDrawBucket {
@@ -204,6 +210,11 @@ class Merc2 : public BucketRenderer {
                           bool jak1_water_mode,
                           bool disable_fog);
 
+  bool try_combine_envmap(Draw* draw,
+                          const DrawMode& envmap_mode,
+                          u32 envmap_texture,
+                          const u8* fade);
+
   Draw* try_alloc_envmap_draw(const tfrag3::MercDraw& mdraw,
                               const DrawMode& envmap_mode,
                               u32 envmap_texture,
@@ -228,7 +239,8 @@ class Merc2 : public BucketRenderer {
   std::vector<LevelDrawBucket> m_level_draw_buckets;
   u32 m_next_free_level_bucket = 0;
   u32 m_next_free_bone_vector = 0;
-  size_t m_opengl_buffer_alignment = 0;
+  size_t m_opengl_buffer_alignment = 0;  // bytes, for the start of the bone buffer
+  GLuint m_bone_index_buffer = 0;        // 0, 1, 2, ... read per-instance to find the bones
 
   void flush_draw_buckets(SharedRenderState* render_state, ScopedProfilerNode& prof);
   void model_mod_draws(int num_effects,
@@ -139,10 +139,10 @@ void Shadow2::render(DmaFollower& dma, SharedRenderState* render_state, ScopedPr
       int addr = vif1.immediate;
       switch (addr) {
         case kTopVertexDataAddr:
-          current_input.top_vertex_data = transfer.data;
+          current_input.top_vertices = {transfer.data, (int)vif1.num, -1};
           break;
         case kBottomVertexDataAddr:
-          current_input.bottom_vertex_data = transfer.data;
+          current_input.bottom_vertices = {transfer.data, (int)vif1.num, -1};
           break;
         default:
           ASSERT_NOT_REACHED_MSG(fmt::format("Unknown address for transfer: {}\n", addr));
@@ -221,22 +221,22 @@ void Shadow2::render(DmaFollower& dma, SharedRenderState* render_state, ScopedPr
   ASSERT(transfers < 7);
 }
 
-void Shadow2::buffer_from_mscal2(const InputData& in) {
+void Shadow2::buffer_from_mscal2(InputData& in) {
   // draw top caps.
-  add_cap_tris(in.cap_index_data, in.top_vertex_data, false);
+  add_cap_tris(in.cap_index_data, in.top_vertices, false);
 
   // draw bottom caps.
-  add_cap_tris(in.cap_index_data, in.bottom_vertex_data, true);
+  add_cap_tris(in.cap_index_data, in.bottom_vertices, true);
 }
 
-void Shadow2::buffer_from_mscal4(const InputData& in) {
-  add_wall_quads(in.wall_index_data, in.top_vertex_data, in.bottom_vertex_data);
+void Shadow2::buffer_from_mscal4(InputData& in) {
+  add_wall_quads(in.wall_index_data, in.top_vertices, in.bottom_vertices);
 }
 
-void Shadow2::buffer_from_mscal6(const InputData& in) {
+void Shadow2::buffer_from_mscal6(InputData& in) {
   // draw top caps.
-  add_flippable_tris(in.cap_index_data, in.top_vertex_data, false);
-  add_flippable_tris(in.cap_index_data, in.bottom_vertex_data, true);
+  add_flippable_tris(in.cap_index_data, in.top_vertices, false);
+  add_flippable_tris(in.cap_index_data, in.bottom_vertices, true);
 }
 
 Shadow2::ShadowVertex* Shadow2::alloc_verts(int n) {
@@ -260,7 +260,48 @@ u32* Shadow2::alloc_inds(int n, bool front) {
   }
 }
 
-const u8* Shadow2::add_cap_tris(const u8* byte_data, const u8* vertex_data, bool flip) {
+/*!
+ * Get the index of the first of these vertices in the vertex buffer, copying them if needed.
+ */
+u32 Shadow2::vertex_base(InputVertices& vertices) {
+  if (vertices.base < 0) {
+    ASSERT(vertices.data);
+    vertices.base = m_vertex_buffer_used;
+    auto* dst = alloc_verts(vertices.count);
+    for (int i = 0; i < vertices.count; i++) {
+      memcpy(dst[i].pos.data(), vertices.data + 16 * i, 12);
+    }
+  }
+  return vertices.base;
+}
+
+/*!
+ * Add a triangle (3 verts) or quad (4 verts, in fan order) to the front or back index buffer,
+ * depending on which way it faces.
+ */
+void Shadow2::add_face(const u32* vertex_idx, int num_verts) {
+  const auto& v0 = m_vertex_buffer[vertex_idx[0]].pos;
+  const math::Vector3f v1_v0_rt_camera = m_vertex_buffer[vertex_idx[1]].pos - v0;
+  const math::Vector3f v2_v0_rt_camera = m_vertex_buffer[vertex_idx[2]].pos - v0;
+  const math::Vector3f tri_normal = v1_v0_rt_camera.cross(v2_v0_rt_camera);
+  const float normal_dot_eye = tri_normal.dot(v0);
+  if (num_verts == 3) {
+    auto* idx_buffer = alloc_inds(4, normal_dot_eye > 0);
+    for (int j = 0; j < 3; j++) {
+      idx_buffer[j] = vertex_idx[j];
+    }
+    idx_buffer[3] = UINT32_MAX;
+  } else {
+    auto* idx_buffer = alloc_inds(5, normal_dot_eye > 0);
+    idx_buffer[0] = vertex_idx[1];
+    idx_buffer[1] = vertex_idx[0];
+    idx_buffer[2] = vertex_idx[2];
+    idx_buffer[3] = vertex_idx[3];
+    idx_buffer[4] = UINT32_MAX;
+  }
+}
+
+const u8* Shadow2::add_cap_tris(const u8* byte_data, InputVertices& vertices, bool flip) {
   const int num_single_tris = *byte_data++;
   for (int i = 0; i < 3; i++) {
     int v = *byte_data++;
@@ -280,33 +321,22 @@ const u8* Shadow2::add_cap_tris(const u8* byte_data, const u8* vertex_data, bool
       continue;
     }
 
-    // load vertices (to vf17, vf18, vf19)
-    const int opengl_vertex_idx = m_vertex_buffer_used;
-    auto* vertex_rt_camera = alloc_verts(3);
-    if (flip) {
-      memcpy(vertex_rt_camera[0].pos.data(), vertex_data + 16 * vertex_addrs[0], 12);
-      memcpy(vertex_rt_camera[1].pos.data(), vertex_data + 16 * vertex_addrs[2], 12);
-      memcpy(vertex_rt_camera[2].pos.data(), vertex_data + 16 * vertex_addrs[1], 12);
-    } else {
-      for (int j = 0; j < 3; j++) {
-        memcpy(vertex_rt_camera[j].pos.data(), vertex_data + 16 * vertex_addrs[j], 12);
-      }
-    }
-
-    const math::Vector3f v1_v0_rt_camera = vertex_rt_camera[1].pos - vertex_rt_camera[0].pos;
-    const math::Vector3f v2_v0_rt_camera = vertex_rt_camera[2].pos - vertex_rt_camera[0].pos;
-    const math::Vector3f tri_normal = v1_v0_rt_camera.cross(v2_v0_rt_camera);
-    const float normal_dot_eye = tri_normal.dot(vertex_rt_camera[0].pos);
-    auto* idx_buffer = alloc_inds(4, normal_dot_eye > 0);
+    // vertices (vf17, vf18, vf19)
+    const u32 base = vertex_base(vertices);
+    u32 idx[3];
     for (int j = 0; j < 3; j++) {
-      idx_buffer[j] = opengl_vertex_idx + j;
+      ASSERT(vertex_addrs[j] < vertices.count);
+      idx[j] = base + vertex_addrs[j];
     }
-    idx_buffer[3] = UINT32_MAX;
+    if (flip) {
+      std::swap(idx[1], idx[2]);
+    }
+    add_face(idx, 3);
   }
   return byte_data;
 }
 
-const u8* Shadow2::add_flippable_tris(const u8* byte_data, const u8* vertex_data, bool flip) {
+const u8* Shadow2::add_flippable_tris(const u8* byte_data, InputVertices& vertices, bool flip) {
   const int num_single_tris = *byte_data++;
   for (int i = 0; i < 3; i++) {
     int v = *byte_data++;
@@ -325,36 +355,24 @@ const u8* Shadow2::add_flippable_tris(const u8* byte_data, const u8* vertex_data
       continue;
     }
 
-    // load vertices (to vf17, vf18, vf19)
-    const int opengl_vertex_idx = m_vertex_buffer_used;
-    auto* vertex_rt_camera = alloc_verts(3);
-    if ((flip ^ flip_flag) == 0) {
-      memcpy(vertex_rt_camera[0].pos.data(), vertex_data + 16 * vertex_addrs[0], 12);
-      memcpy(vertex_rt_camera[1].pos.data(), vertex_data + 16 * vertex_addrs[2], 12);
-      memcpy(vertex_rt_camera[2].pos.data(), vertex_data + 16 * vertex_addrs[1], 12);
-
-    } else {
-      for (int j = 0; j < 3; j++) {
-        memcpy(vertex_rt_camera[j].pos.data(), vertex_data + 16 * vertex_addrs[j], 12);
-      }
-    }
-
-    const math::Vector3f v1_v0_rt_camera = vertex_rt_camera[1].pos - vertex_rt_camera[0].pos;
-    const math::Vector3f v2_v0_rt_camera = vertex_rt_camera[2].pos - vertex_rt_camera[0].pos;
-    const math::Vector3f tri_normal = v1_v0_rt_camera.cross(v2_v0_rt_camera);
-    const float normal_dot_eye = tri_normal.dot(vertex_rt_camera[0].pos);
-    auto* idx_buffer = alloc_inds(4, normal_dot_eye > 0);
+    // vertices (vf17, vf18, vf19)
+    const u32 base = vertex_base(vertices);
+    u32 idx[3];
     for (int j = 0; j < 3; j++) {
-      idx_buffer[j] = opengl_vertex_idx + j;
+      ASSERT(vertex_addrs[j] < vertices.count);
+      idx[j] = base + vertex_addrs[j];
     }
-    idx_buffer[3] = UINT32_MAX;
+    if ((flip ^ flip_flag) == 0) {
+      std::swap(idx[1], idx[2]);
+    }
+    add_face(idx, 3);
   }
   return byte_data;
 }
 
 const u8* Shadow2::add_wall_quads(const u8* byte_data,
-                                  const u8* vertex_data_0,
-                                  const u8* vertex_data_1) {
+                                  InputVertices& vertices_0,
+                                  InputVertices& vertices_1) {
   const int num_quads = *byte_data++;
   for (int i = 0; i < 3; i++) {
     int v = *byte_data++;
@@ -376,31 +394,23 @@ const u8* Shadow2::add_wall_quads(const u8* byte_data,
       continue;
     }
 
-    const int opengl_vertex_idx = m_vertex_buffer_used;
-    auto* vertex_rt_camera = alloc_verts(4);
-
+    ASSERT(vertex_addrs[0] < vertices_0.count && vertex_addrs[1] < vertices_0.count);
+    ASSERT(vertex_addrs[0] < vertices_1.count && vertex_addrs[1] < vertices_1.count);
+    const u32 base_0 = vertex_base(vertices_0);
+    const u32 base_1 = vertex_base(vertices_1);
+    u32 idx[4];
     if (side_control == 0) {
-      memcpy(vertex_rt_camera[0].pos.data(), vertex_data_0 + 16 * vertex_addrs[1], 12);
-      memcpy(vertex_rt_camera[1].pos.data(), vertex_data_0 + 16 * vertex_addrs[0], 12);
-      memcpy(vertex_rt_camera[2].pos.data(), vertex_data_1 + 16 * vertex_addrs[0], 12);
-      memcpy(vertex_rt_camera[3].pos.data(), vertex_data_1 + 16 * vertex_addrs[1], 12);
+      idx[0] = base_0 + vertex_addrs[1];
+      idx[1] = base_0 + vertex_addrs[0];
+      idx[2] = base_1 + vertex_addrs[0];
+      idx[3] = base_1 + vertex_addrs[1];
     } else {
-      memcpy(vertex_rt_camera[0].pos.data(), vertex_data_0 + 16 * vertex_addrs[0], 12);
-      memcpy(vertex_rt_camera[1].pos.data(), vertex_data_0 + 16 * vertex_addrs[1], 12);
-      memcpy(vertex_rt_camera[2].pos.data(), vertex_data_1 + 16 * vertex_addrs[1], 12);
-      memcpy(vertex_rt_camera[3].pos.data(), vertex_data_1 + 16 * vertex_addrs[0], 12);
+      idx[0] = base_0 + vertex_addrs[0];
+      idx[1] = base_0 + vertex_addrs[1];
+      idx[2] = base_1 + vertex_addrs[1];
+      idx[3] = base_1 + vertex_addrs[0];
     }
-
-    const math::Vector3f v1_v0_rt_camera = vertex_rt_camera[1].pos - vertex_rt_camera[0].pos;
-    const math::Vector3f v2_v0_rt_camera = vertex_rt_camera[2].pos - vertex_rt_camera[0].pos;
-    const math::Vector3f tri_normal = v1_v0_rt_camera.cross(v2_v0_rt_camera);
-    const float normal_dot_eye = tri_normal.dot(vertex_rt_camera[0].pos);
-    auto* idx_buffer = alloc_inds(5, normal_dot_eye > 0);
-    idx_buffer[0] = opengl_vertex_idx + 1;
-    idx_buffer[1] = opengl_vertex_idx + 0;
-    idx_buffer[2] = opengl_vertex_idx + 2;
-    idx_buffer[3] = opengl_vertex_idx + 3;
-    idx_buffer[4] = UINT32_MAX;
+    add_face(idx, 4);
   }
   return byte_data;
 }
@@ -45,9 +45,17 @@ class Shadow2 : public BucketRenderer {
   static constexpr int kCapIndexDataAddr = 344;
   static constexpr int kWallIndexDataAddr = 600;
 
+  // vertices of the current top/bottom upload, copied into the vertex buffer the first time a
+  // program uses them. Triangles index into these instead of getting their own copies.
+  struct InputVertices {
+    const u8* data = nullptr;  // always 115
+    int count = 0;
+    int base = -1;  // index of the first vertex in the vertex buffer, or -1 if not copied yet.
+  };
+
   struct InputData {
-    const u8* top_vertex_data = nullptr;     // always 115
-    const u8* bottom_vertex_data = nullptr;  // always 115
+    InputVertices top_vertices;
+    InputVertices bottom_vertices;
     const u8* cap_index_data = nullptr;
     size_t cap_index_data_size = 0;
     const u8* wall_index_data = nullptr;
@@ -82,12 +90,16 @@ class Shadow2 : public BucketRenderer {
   bool m_debug_draw_volume = false;
 
   void reset_buffers();
-  void buffer_from_mscal2(const InputData& input);
-  void buffer_from_mscal4(const InputData& input);
-  void buffer_from_mscal6(const InputData& input);
-  const u8* add_cap_tris(const u8* byte_data, const u8* vertex_data, bool flip);
-  const u8* add_wall_quads(const u8* byte_data, const u8* vertex_data_0, const u8* vertex_data_1);
-  const u8* add_flippable_tris(const u8* byte_data, const u8* vertex_data, bool flip);
+  void buffer_from_mscal2(InputData& input);
+  void buffer_from_mscal4(InputData& input);
+  void buffer_from_mscal6(InputData& input);
+  const u8* add_cap_tris(const u8* byte_data, InputVertices& vertices, bool flip);
+  const u8* add_wall_quads(const u8* byte_data,
+                           InputVertices& vertices_0,
+                           InputVertices& vertices_1);
+  const u8* add_flippable_tris(const u8* byte_data, InputVertices& vertices, bool flip);
+  u32 vertex_base(InputVertices& vertices);
+  void add_face(const u32* vertex_idx, int num_verts);
   ShadowVertex* alloc_verts(int n);
   u32* alloc_inds(int n, bool front);
   void draw_buffers(SharedRenderState* render_state,
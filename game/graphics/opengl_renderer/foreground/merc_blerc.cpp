@@ -0,0 +1,90 @@
+#include "merc_blerc.h"
+
+#include <immintrin.h>
+
+#include "common/util/os.h"
+
+/*!
+ * Modify vertices for blerc.
+ * The position and normal are next to each other in both BlercFloatData and MercVertex, so they
+ * fit in a single 256-bit register. This only needs AVX, which the game requires.
+ */
+void blerc_avx(const u32* i_data,
+               const u32* i_data_end,
+               const tfrag3::BlercFloatData* floats,
+               const float* weights,
+               tfrag3::MercVertex* out,
+               float multiplier) {
+  // store a table of weights. It's faster to load the 32-bytes of weights than load and broadcast
+  // the float.
+  __m256 weights_table[kMaxBlercTargets];
+  for (int i = 0; i < kMaxBlercTargets; i++) {
+    weights_table[i] = _mm256_set1_ps(weights[i] * multiplier);
+  }
+
+  // loop over vertices
+  while (i_data != i_data_end) {
+    // load the base position and normal
+    __m256 pos_nrm = _mm256_load_ps(floats->v);
+    floats++;
+
+    // loop over targets
+    while (*i_data != tfrag3::Blerc::kTargetIdxTerminator) {
+      // apply the weight for this target, from the game data, to the pos/normal offset.
+      __m256 offset = _mm256_mul_ps(_mm256_load_ps(floats->v), weights_table[*i_data]);
+      pos_nrm = _mm256_add_ps(pos_nrm, offset);
+      floats++;
+      i_data++;
+    }
+    i_data++;
+
+    // store final position/normal.
+    _mm256_store_ps(out[*i_data].pos, pos_nrm);
+    i_data++;
+  }
+}
+
+#ifdef __AVX2__
+/*!
+ * Same as blerc_avx, but with FMA. Only used if the CPU has both AVX2 and FMA.
+ */
+void blerc_avx2(const u32* i_data,
+                const u32* i_data_end,
+                const tfrag3::BlercFloatData* floats,
+                const float* weights,
+                tfrag3::MercVertex* out,
+                float multiplier) {
+  __m256 weights_table[kMaxBlercTargets];
+  for (int i = 0; i < kMaxBlercTargets; i++) {
+    weights_table[i] = _mm256_set1_ps(weights[i] * multiplier);
+  }
+
+  while (i_data != i_data_end) {
+    __m256 pos_nrm = _mm256_load_ps(floats->v);
+    floats++;
+    while (*i_data != tfrag3::Blerc::kTargetIdxTerminator) {
+      pos_nrm = _mm256_fmadd_ps(_mm256_load_ps(floats->v), weights_table[*i_data], pos_nrm);
+      floats++;
+      i_data++;
+    }
+    i_data++;
+    _mm256_store_ps(out[*i_data].pos, pos_nrm);
+    i_data++;
+  }
+}
+#endif
+
+void blerc(const u32* i_data,
+           const u32* i_data_end,
+           const tfrag3::BlercFloatData* floats,
+           const float* weights,
+           tfrag3::MercVertex* out,
+           float multiplier) {
+#ifdef __AVX2__
+  if (get_cpu_info().has_avx2 && get_cpu_info().has_fma) {
+    blerc_avx2(i_data, i_data_end, floats, weights, out, multiplier);
+    return;
+  }
+#endif
+  blerc_avx(i_data, i_data_end, floats, weights, out, multiplier);
+}
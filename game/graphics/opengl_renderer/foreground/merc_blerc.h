@@ -0,0 +1,31 @@
+#pragma once
+
+#include "common/custom_data/Tfrag3Data.h"
+
+// Blend shape ("blerc") vertex modification for the Merc2 renderer.
+
+constexpr int kMaxBlercTargets = 40;
+
+void blerc_avx(const u32* i_data,
+               const u32* i_data_end,
+               const tfrag3::BlercFloatData* floats,
+               const float* weights,
+               tfrag3::MercVertex* out,
+               float multiplier);
+
+#ifdef __AVX2__
+void blerc_avx2(const u32* i_data,
+                const u32* i_data_end,
+                const tfrag3::BlercFloatData* floats,
+                const float* weights,
+                tfrag3::MercVertex* out,
+                float multiplier);
+#endif
+
+// Picks the fastest version supported by both the build and the CPU.
+void blerc(const u32* i_data,
+           const u32* i_data_end,
+           const tfrag3::BlercFloatData* floats,
+           const float* weights,
+           tfrag3::MercVertex* out,
+           float multiplier);
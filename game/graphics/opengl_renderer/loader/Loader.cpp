@@ -1,10 +1,13 @@
 #include "Loader.h"
 
 #include "common/global_profiler/GlobalProfiler.h"
+#include "common/log/log.h"
 #include "common/util/FileUtil.h"
+#include "common/util/SimpleThreadGroup.h"
 #include "common/util/Timer.h"
 #include "common/util/compress.h"
 
+#include "game/graphics/opengl_renderer/CollideMeshRenderer.h"
 #include "game/graphics/opengl_renderer/loader/LoaderStages.h"
 
 #include "third-party/imgui/imgui.h"
@@ -17,6 +20,91 @@ std::string uppercase_string(const std::string& s) {
   }
   return result;
 }
+
+u64 gl_buffer_size(GLuint buffer) {
+  GLint64 size = 0;
+  glBindBuffer(GL_ARRAY_BUFFER, buffer);
+  glGetBufferParameteri64v(GL_ARRAY_BUFFER, GL_BUFFER_SIZE, &size);
+  return size;
+}
+
+/*!
+ * Hash the textures and merc models of a fully loaded level, so they can be shared with others.
+ */
+void compute_level_hashes(LevelData& lev) {
+  lev.texture_hashes.resize(lev.level->textures.size());
+  compute_texture_hashes(lev, 0, lev.level->textures.size());
+  compute_merc_model_hashes(lev);
+}
+
+template <typename T>
+u64 vector_bytes(const std::vector<T>& vec) {
+  return vec.capacity() * sizeof(T);
+}
+
+/*!
+ * Figure out how much memory a fully loaded level is using.
+ * The CPU side is the level data, plus the unpacked vertices that are kept around after upload.
+ * The GPU side is the size of all buffers, plus textures (with a full mip chain, if uncompressed).
+ */
+void update_level_memory_usage(LevelData& lev) {
+  tfrag3::MemoryUsageTracker tracker;
+  lev.level->memory_usage(&tracker);
+  u64 cpu = 0;
+  for (auto x : tracker.data) {
+    cpu += x;
+  }
+  for (auto& geo : lev.level->tfrag_trees) {
+    for (auto& tree : geo) {
+      cpu += vector_bytes(tree.unpacked.vertices) + vector_bytes(tree.unpacked.indices);
+    }
+  }
+  for (auto& geo : lev.level->tie_trees) {
+    for (auto& tree : geo) {
+      cpu += vector_bytes(tree.unpacked.vertices) + vector_bytes(tree.unpacked.indices);
+    }
+  }
+  for (auto& tree : lev.level->shrub_trees) {
+    cpu += vector_bytes(tree.instanced.vertices) + vector_bytes(tree.instanced.instances) +
+           vector_bytes(tree.instanced.indices) + vector_bytes(tree.instanced.commands);
+  }
+  lev.cpu_bytes = cpu;
+
+  u64 gpu = 0;
+  for (auto& tex : lev.level->textures) {
+    if (tex.compression != tfrag3::TextureCompression::NONE) {
+      gpu += tex.compressed_size_bytes();
+    } else {
+      gpu += (u64)tex.w * tex.h * 4 * 4 / 3;
+    }
+  }
+  for (auto& geo : lev.tie_data) {
+    for (auto& tree : geo) {
+      gpu += gl_buffer_size(tree.vertex_buffer) + gl_buffer_size(tree.index_buffer);
+      if (tree.has_wind) {
+        gpu += gl_buffer_size(tree.wind_indices);
+      }
+    }
+  }
+  for (auto& geo : lev.tfrag_vertex_data) {
+    for (auto buffer : geo) {
+      gpu += gl_buffer_size(buffer);
+    }
+  }
+  for (auto& tree : lev.shrub_data) {
+    gpu += gl_buffer_size(tree.vertex_buffer) + gl_buffer_size(tree.instance_buffer) +
+           gl_buffer_size(tree.index_buffer) + gl_buffer_size(tree.command_buffer);
+  }
+  gpu += gl_buffer_size(lev.collide_vertices);
+  gpu += gl_buffer_size(lev.merc_vertices);
+  gpu += gl_buffer_size(lev.merc_indices);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  lev.gpu_bytes = gpu;
+}
+
+float to_mb(u64 bytes) {
+  return bytes / (1024.f * 1024.f);
+}
 }  // namespace
 
 Loader::Loader(const fs::path& base_path, int max_levels)
@@ -34,6 +122,113 @@ Loader::~Loader() {
   m_loader_thread.join();
 }
 
+bool Loader::start_upload_thread(SDL_Window* window) {
+  SDL_GLContext render_context = SDL_GL_GetCurrentContext();
+  SDL_GL_SetAttribute(SDL_GL_SHARE_WITH_CURRENT_CONTEXT, 1);
+  m_upload_context = SDL_GL_CreateContext(window);
+  SDL_GL_SetAttribute(SDL_GL_SHARE_WITH_CURRENT_CONTEXT, 0);
+  // creating a context makes it current, give the render thread its context back.
+  SDL_GL_MakeCurrent(window, render_context);
+  if (!m_upload_context) {
+    lg::warn("Couldn't create a shared OpenGL context, levels will be uploaded on the render "
+             "thread: {}",
+             SDL_GetError());
+    return false;
+  }
+  m_upload_shutdown = false;
+  m_upload_thread = std::thread(&Loader::upload_thread, this, window);
+  return true;
+}
+
+void Loader::stop_upload_thread() {
+  if (!m_upload_thread.joinable()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lk(m_upload_mutex);
+    m_upload_shutdown = true;
+    m_upload_cv.notify_all();
+  }
+  m_upload_thread.join();
+  if (m_upload_fence) {
+    glDeleteSync(m_upload_fence);
+    m_upload_fence = nullptr;
+  }
+  // a level that wasn't finished will finish its uploads on the render thread.
+  m_upload_level = nullptr;
+  SDL_GL_DeleteContext(m_upload_context);
+  m_upload_context = nullptr;
+}
+
+/*!
+ * Runs the uploads_only stages for the level the render thread hands over, then leaves a fence for
+ * the render thread to wait on.
+ */
+void Loader::upload_thread(SDL_Window* window) {
+  SDL_GL_MakeCurrent(window, m_upload_context);
+  // core profile contexts have no default vertex array, which the index buffer binding is part of.
+  GLuint vao;
+  glGenVertexArrays(1, &vao);
+  glBindVertexArray(vao);
+
+  std::unique_lock<std::mutex> lk(m_upload_mutex);
+  while (!m_upload_shutdown) {
+    if (!m_upload_level || m_upload_fence) {
+      m_upload_cv.wait(lk);
+      continue;
+    }
+    LoaderInput input = {};
+    input.lev_data = m_upload_level;
+    lk.unlock();
+
+    Timer timer;
+    bool done = true;
+    for (auto& stage : m_loader_stages) {
+      if (stage->uploads_only() && !stage->run(timer, input)) {
+        done = false;
+        break;
+      }
+    }
+
+    lk.lock();
+    if (done) {
+      m_upload_fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+      glFlush();
+    } else if (timer.getMs() < 1.f) {
+      // no budget was used up, so a stage is waiting for the loader thread to unpack a section.
+      m_upload_cv.wait_for(lk, std::chrono::milliseconds(1));
+    }
+  }
+  lk.unlock();
+
+  glDeleteVertexArrays(1, &vao);
+  SDL_GL_MakeCurrent(window, nullptr);
+}
+
+/*!
+ * Give the level to the upload thread, if it isn't working on it already. Returns true once all of
+ * its uploads are done and visible to the render thread.
+ */
+bool Loader::poll_upload_thread(LevelData* lev) {
+  std::lock_guard<std::mutex> lk(m_upload_mutex);
+  if (m_upload_level != lev) {
+    m_upload_level = lev;
+    m_upload_cv.notify_all();
+    return false;
+  }
+  if (!m_upload_fence) {
+    return false;
+  }
+  GLenum status = glClientWaitSync(m_upload_fence, 0, 0);
+  if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+    return false;
+  }
+  glDeleteSync(m_upload_fence);
+  m_upload_fence = nullptr;
+  m_upload_level = nullptr;
+  return true;
+}
+
 /*!
  * Try to get a loaded level by name. It may fail and return nullptr.
  * Getting a level will reset the counter for the level and prevent it from being kicked out
@@ -48,10 +243,16 @@ const LevelData* Loader::get_tfrag3_level(const std::string& level_name) {
     return nullptr;
   } else {
     existing->second->frames_since_last_used = 0;
+    existing->second->prefetched = false;
     return existing->second.get();
   }
 }
 
+std::vector<std::string> Loader::get_want_levels() {
+  std::unique_lock<std::mutex> lk(m_loader_mutex);
+  return m_desired_levels;
+}
+
 /*!
  * The game calls this to give the loader a hint on which levels we want.
  * If the loader is not busy, it will begin loading the level.
@@ -76,11 +277,88 @@ void Loader::set_want_levels(const std::vector<std::string>& levels) {
     if (it == m_loaded_tfrag3_levels.end()) {
       // we haven't loaded it yet. Request this level to load and wake up the thread.
       m_level_to_load = lev;
+      m_level_to_load_is_prefetch = false;
       lk.unlock();
       m_loader_cv.notify_all();
       return;
     }
   }
+
+  // all requested levels are loaded, use the spare time to prefetch.
+  if (start_prefetch()) {
+    lk.unlock();
+    m_loader_cv.notify_all();
+  }
+}
+
+/*!
+ * The game calls this to give the loader a hint on which levels it will probably want soon.
+ * These are loaded only when the loader has nothing else to do and there's a free level slot.
+ * Prefetched levels aren't "in use" until the game actually asks for them. They won't evict a
+ * loaded level, and will be the first to go if a slot is needed for a level the game wants.
+ * This should be called on every frame, after set_want_levels.
+ */
+void Loader::set_prefetch_levels(const std::vector<std::string>& levels) {
+  std::unique_lock<std::mutex> lk(m_loader_mutex);
+  m_prefetch_levels = levels;
+  remove_missing_prefetch_levels();
+  if (start_prefetch()) {
+    lk.unlock();
+    m_loader_cv.notify_all();
+  }
+}
+
+/*!
+ * Drop prefetch hints for levels that have no FR3 file. Must hold the loader mutex.
+ */
+void Loader::remove_missing_prefetch_levels() {
+  m_prefetch_levels.erase(std::remove_if(m_prefetch_levels.begin(), m_prefetch_levels.end(),
+                                         [&](const std::string& lev) {
+                                           return m_missing_prefetch_levels.count(lev) > 0;
+                                         }),
+                          m_prefetch_levels.end());
+}
+
+/*!
+ * If idle, pick a level to prefetch. Must hold the loader mutex.
+ * Returns true if the loader thread should be woken up.
+ */
+bool Loader::start_prefetch() {
+  if (!m_level_to_load.empty() || !m_initializing_tfrag3_levels.empty()) {
+    return false;
+  }
+
+  // don't prefetch if it would compete with a level the game actually wants.
+  for (auto& lev : m_desired_levels) {
+    if (m_loaded_tfrag3_levels.find(lev) == m_loaded_tfrag3_levels.end()) {
+      return false;
+    }
+  }
+
+  if ((int)m_loaded_tfrag3_levels.size() >= m_max_levels) {
+    return false;
+  }
+
+  // prefetched levels are the first to be evicted when over budget, so prefetching past the
+  // budget would just load and evict the same level over and over.
+  if (over_memory_budget()) {
+    return false;
+  }
+
+  for (auto& lev : m_prefetch_levels) {
+    if (m_loaded_tfrag3_levels.find(lev) == m_loaded_tfrag3_levels.end()) {
+      // if we've had this level before, we know how big it is.
+      const auto& size = m_unloaded_level_sizes.find(lev);
+      if (size != m_unloaded_level_sizes.end() &&
+          over_memory_budget(size->second.cpu_bytes, size->second.gpu_bytes)) {
+        continue;
+      }
+      m_level_to_load = lev;
+      m_level_to_load_is_prefetch = true;
+      return true;
+    }
+  }
+  return false;
 }
 
 /*!
@@ -91,7 +369,7 @@ std::vector<LevelData*> Loader::get_in_use_levels() {
   std::unique_lock<std::mutex> lk(m_loader_mutex);
 
   for (auto& lev : m_loaded_tfrag3_levels) {
-    if (lev.second->frames_since_last_used < 5) {
+    if (lev.second->frames_since_last_used < 5 && !lev.second->prefetched) {
       result.push_back(lev.second.get());
     }
   }
@@ -99,7 +377,11 @@ std::vector<LevelData*> Loader::get_in_use_levels() {
 }
 
 void Loader::draw_debug_window() {
-  ImGui::Begin("Loader");
+  if (!ImGui::Begin("Loader")) {
+    // collapsed, don't wait on the loader thread's lock.
+    ImGui::End();
+    return;
+  }
   std::unique_lock<std::mutex> lk(m_loader_mutex);
   ImVec4 blue(0.3, 0.3, 0.8, 1.0);
   ImVec4 red(0.8, 0.3, 0.3, 1.0);
@@ -122,6 +404,23 @@ void Loader::draw_debug_window() {
     ImGui::Separator();
   }
 
+  if (!m_prefetch_levels.empty()) {
+    ImGui::Text("prefetch levels");
+    for (auto& lev : m_prefetch_levels) {
+      auto lev_color = red;
+      if (m_initializing_tfrag3_levels.find(lev) != m_initializing_tfrag3_levels.end()) {
+        lev_color = blue;
+      }
+      if (m_loaded_tfrag3_levels.find(lev) != m_loaded_tfrag3_levels.end()) {
+        lev_color = green;
+      }
+      ImGui::TextColored(lev_color, "%s", lev.c_str());
+      ImGui::SameLine();
+    }
+    ImGui::NewLine();
+    ImGui::Separator();
+  }
+
   if (!m_initializing_tfrag3_levels.empty()) {
     ImGui::Text("init levels");
     for (auto& lev : m_initializing_tfrag3_levels) {
@@ -132,6 +431,26 @@ void Loader::draw_debug_window() {
     ImGui::Separator();
   }
 
+  u64 total_cpu = 0, total_gpu = 0;
+  for (auto& lev : m_loaded_tfrag3_levels) {
+    total_cpu += lev.second->cpu_bytes;
+    total_gpu += lev.second->gpu_bytes;
+  }
+  ImGui::Text("memory: CPU %.1f MB, GPU %.1f MB", to_mb(total_cpu), to_mb(total_gpu));
+  ImGui::InputInt("CPU budget (MB, 0 = none)", &m_cpu_budget_mb);
+  ImGui::InputInt("GPU budget (MB, 0 = none)", &m_gpu_budget_mb);
+  ImGui::Text("budget evictions: %d", m_budget_evictions);
+  ImGui::Text("upload thread: %s", m_upload_thread.joinable() ? "running" : "off");
+  int shared_mercs = 0;
+  for (auto& [model_name, variants] : m_shared_merc_models) {
+    for (auto& variant : variants) {
+      shared_mercs += variant.ref_count - 1;
+    }
+  }
+  ImGui::Text("shared: %d textures, %d merc models deduplicated", (int)m_shared_textures.size(),
+              shared_mercs);
+  ImGui::Separator();
+
   if (!m_loaded_tfrag3_levels.empty()) {
     ImGui::Text("loaded levels");
     for (auto& lev : m_loaded_tfrag3_levels) {
@@ -142,10 +461,13 @@ void Loader::draw_debug_window() {
       if (lev.second->frames_since_last_used > 180) {
         lev_color = red;
       }
-      ImGui::TextColored(lev_color, "%20s : %3d", lev.first.c_str(),
-                         lev.second->frames_since_last_used);
+      ImGui::TextColored(lev_color, "%20s : %3d%s", lev.first.c_str(),
+                         lev.second->frames_since_last_used,
+                         lev.second->prefetched ? " (prefetched)" : "");
       ImGui::Text("  %d textures", (int)lev.second->textures.size());
       ImGui::Text("  %d merc", (int)lev.second->merc_model_lookup.size());
+      ImGui::Text("  CPU %.1f MB, GPU %.1f MB", to_mb(lev.second->cpu_bytes),
+                  to_mb(lev.second->gpu_bytes));
     }
     ImGui::NewLine();
     ImGui::Separator();
@@ -159,6 +481,7 @@ void Loader::draw_debug_window() {
  * This is used for file I/O and unpacking.
  */
 void Loader::loader_thread() {
+  PROF_THREAD_NAME("Loader");
   try {
     while (!m_want_shutdown) {
       std::unique_lock<std::mutex> lk(m_loader_mutex);
@@ -169,27 +492,40 @@ void Loader::loader_thread() {
         return;
       }
       std::string lev = m_level_to_load;
+      bool prefetch = m_level_to_load_is_prefetch;
       // don't hold the lock while reading the file.
       lk.unlock();
+      PROF_ZONE(prefetch ? "prefetch-level" : "load-level");
 
       // simulate slower hard drive (so that the loader thread can lose to the game loads)
       // std::this_thread::sleep_for(std::chrono::milliseconds(1500));
 
-      // load the fr3 file
-      Timer disk_timer;
-      auto data =
-          file_util::read_binary_file(m_base_path / fmt::format("{}.fr3", uppercase_string(lev)));
-      double disk_load_time = disk_timer.getSeconds();
+      auto path = m_base_path / fmt::format("{}.fr3", uppercase_string(lev));
+      // a prefetch is only a hint from the game, so a level that was never extracted is skipped.
+      if (prefetch && !fs::exists(path)) {
+        lg::warn("Not prefetching level {}, {} doesn't exist", lev, path.string());
+        lk.lock();
+        m_missing_prefetch_levels.insert(lev);
+        remove_missing_prefetch_levels();
+        m_level_to_load = "";
+        m_file_load_done_cv.notify_all();
+        continue;
+      }
+      file_util::MappedFile file(path);
+      if (tfrag3::is_chunked_fr3(file.data(), file.size())) {
+        load_chunked_level(lev, file, prefetch);
+        continue;
+      }
 
-      // the FR3 files are compressed
+      // the old FR3 files are a single compressed frame
       Timer decomp_timer;
-      auto decomp_data = compression::decompress_zstd(data.data(), data.size());
+      auto decomp_data = compression::decompress_zstd(file.data(), file.size());
       double decomp_time = decomp_timer.getSeconds();
 
       // Read back into the tfrag3::Level structure
       Timer import_timer;
       auto result = std::make_unique<tfrag3::Level>();
-      Serializer ser(decomp_data.data(), decomp_data.size());
+      Serializer ser(std::move(decomp_data), false);
       result->serialize(ser);
       double import_time = import_timer.getSeconds();
 
@@ -207,17 +543,23 @@ void Loader::loader_thread() {
       }
 
       for (auto& shrub_tree : result->shrub_trees) {
-        shrub_tree.unpack();
+        shrub_tree.unpack_instanced();
       }
-      fmt::print(
-          "------------> Load from file: {:.3f}s, import {:.3f}s, decomp {:.3f}s unpack {:.3f}s\n",
-          disk_load_time, import_time, decomp_time, unpack_timer.getSeconds());
+      auto lev_data = std::make_unique<LevelData>();
+      lev_data->level = std::move(result);
+      build_collide_bvh(lev_data->level->collision.vertices, lev_data->collide_bvh);
+      fmt::print("------------> Load from file: import {:.3f}s, decomp {:.3f}s unpack {:.3f}s\n",
+                 import_time, decomp_time, unpack_timer.getSeconds());
+
+      // hashing reads the whole level, so do it before taking the lock the render thread needs.
+      compute_level_hashes(*lev_data);
+      lev_data->set_all_sections_loaded();
+      lev_data->prefetched = prefetch;
 
       // grab the lock again
       lk.lock();
       // move this level to "initializing" state.
-      m_initializing_tfrag3_levels[lev] = std::make_unique<LevelData>();  // reset load state
-      m_initializing_tfrag3_levels[lev]->level = std::move(result);
+      m_initializing_tfrag3_levels[lev] = std::move(lev_data);
       m_level_to_load = "";
       m_file_load_done_cv.notify_all();
     }
@@ -226,17 +568,109 @@ void Loader::loader_thread() {
   }
 }
 
+/*!
+ * Load a level from a chunked FR3 file. Runs in the loader thread.
+ * The level is moved to "initializing" as soon as the header chunk is loaded, and the remaining
+ * chunks are decompressed in parallel while the loader stages run. Each stage waits for its
+ * section to finish loading.
+ * Prefetches use a single thread, to stay out of the way of the game.
+ */
+void Loader::load_chunked_level(const std::string& lev,
+                                const file_util::MappedFile& file,
+                                bool prefetch) {
+  Timer load_timer;
+  auto chunks = tfrag3::read_fr3_chunk_table(file.data(), file.size());
+  auto lev_data = std::make_unique<LevelData>();
+  LevelData* lev_data_ptr = lev_data.get();
+  lev_data->level = std::make_unique<tfrag3::Level>();
+  lev_data->prefetched = prefetch;
+  tfrag3::Level* level = lev_data->level.get();
+  tfrag3::load_fr3_chunk(file.data(), chunks.front(), level);
+  lev_data->texture_hashes.resize(level->textures.size());
+
+  std::array<std::atomic<int>, tfrag3::FR3_SECTION_COUNT> chunks_remaining = {};
+  for (size_t i = 1; i < chunks.size(); i++) {
+    chunks_remaining[(int)chunks[i].section]++;
+  }
+  for (int i = 0; i < tfrag3::FR3_SECTION_COUNT; i++) {
+    // merc is marked as loaded once all textures are loaded and the models can be hashed.
+    if (chunks_remaining[i] == 0 && i != (int)tfrag3::Fr3Section::MERC) {
+      lev_data->section_loaded[i] = true;
+    }
+  }
+
+  // the header has the size of all arrays, so the level can be given to the stages now.
+  {
+    std::unique_lock<std::mutex> lk(m_loader_mutex);
+    m_initializing_tfrag3_levels[lev] = std::move(lev_data);
+    m_level_to_load = "";
+    m_file_load_done_cv.notify_all();
+  }
+
+  // chunks are sorted in the order the stages use them, so hand them out in order.
+  std::atomic<size_t> next_chunk = 1;
+  int num_workers = 1;
+  if (!prefetch) {
+    num_workers =
+        std::clamp((int)std::thread::hardware_concurrency() - 1, 1, MAX_CHUNK_LOAD_THREADS);
+  }
+  SimpleThreadGroup threads(prefetch ? TaskPriority::LOW : TaskPriority::NORMAL);
+  threads.run(
+      [&](int) {
+        size_t idx;
+        while ((idx = next_chunk++) < chunks.size()) {
+          const auto& chunk = chunks[idx];
+          tfrag3::load_fr3_chunk(file.data(), chunk, level);
+          switch (chunk.section) {
+            case tfrag3::Fr3Section::TIE:
+              level->tie_trees[chunk.geo][chunk.first].unpack();
+              break;
+            case tfrag3::Fr3Section::TFRAG:
+              level->tfrag_trees[chunk.geo][chunk.first].unpack();
+              break;
+            case tfrag3::Fr3Section::SHRUB:
+              level->shrub_trees[chunk.first].unpack_instanced();
+              break;
+            case tfrag3::Fr3Section::TEXTURE:
+              compute_texture_hashes(*lev_data_ptr, chunk.first, chunk.count);
+              break;
+            default:
+              break;
+          }
+          // the level may be finished and moved to loaded after this, don't touch it again.
+          if (--chunks_remaining[(int)chunk.section] == 0 &&
+              chunk.section != tfrag3::Fr3Section::MERC) {
+            if (chunk.section == tfrag3::Fr3Section::COLLISION) {
+              // this reorders the vertices, so it has to finish before the stage uploads them.
+              build_collide_bvh(level->collision.vertices, lev_data_ptr->collide_bvh);
+            }
+            lev_data_ptr->section_loaded[(int)chunk.section].store(true,
+                                                                   std::memory_order_release);
+          }
+        }
+      },
+      num_workers, num_workers);
+  threads.join();
+
+  // the merc stage can't finish until this is set, so the level is still initializing.
+  compute_merc_model_hashes(*lev_data_ptr);
+  lev_data_ptr->section_loaded[(int)tfrag3::Fr3Section::MERC].store(true,
+                                                                   std::memory_order_release);
+
+  fmt::print("------------> Load chunked file: {} chunks in {:.3f}s on {} threads\n", chunks.size(),
+             load_timer.getSeconds(), num_workers);
+}
+
 /*!
  * Load a "common" FR3 file that has non-level textures.
  * This should be called during initialization, before any threaded loading goes on.
  */
 void Loader::load_common(TexturePool& tex_pool, const std::string& name) {
-  auto data = file_util::read_binary_file(m_base_path / fmt::format("{}.fr3", name));
-
-  auto decomp_data = compression::decompress_zstd(data.data(), data.size());
-  Serializer ser(decomp_data.data(), decomp_data.size());
+  file_util::MappedFile file(m_base_path / fmt::format("{}.fr3", name));
   m_common_level.level = std::make_unique<tfrag3::Level>();
-  m_common_level.level->serialize(ser);
+  tfrag3::load_fr3(file.data(), file.size(), m_common_level.level.get());
+  compute_level_hashes(m_common_level);
+  m_common_level.set_all_sections_loaded();
   for (auto& tex : m_common_level.level->textures) {
     m_common_level.textures.push_back(add_texture(tex_pool, tex, true));
   }
@@ -246,6 +680,8 @@ void Loader::load_common(TexturePool& tex_pool, const std::string& name) {
   LoaderInput input;
   input.tex_pool = &tex_pool;
   input.mercs = &m_all_merc_models;
+  input.shared_mercs = &m_shared_merc_models;
+  input.shared_textures = &m_shared_textures;
   input.lev_data = &m_common_level;
   bool done = false;
   while (!done) {
@@ -262,11 +698,10 @@ bool Loader::upload_textures(Timer& timer, LevelData& data, TexturePool& texture
   int bytes_this_run = 0;
   int tex_this_run = 0;
   if (data.textures.size() < data.level->textures.size()) {
-    std::unique_lock<std::mutex> tpool_lock(texture_pool.mutex());
     while (data.textures.size() < data.level->textures.size()) {
       auto& tex = data.level->textures[data.textures.size()];
       data.textures.push_back(add_texture(texture_pool, tex, false));
-      bytes_this_run += tex.w * tex.h * 4;
+      bytes_this_run += texture_upload_bytes(tex);
       tex_this_run++;
       if (tex_this_run > 20) {
         break;
@@ -336,22 +771,279 @@ void Loader::update_blocking(TexturePool& tex_pool) {
 }
 
 const std::string* Loader::get_most_unloadable_level() {
+  auto is_desired = [&](const std::string& name) {
+    return std::find(m_desired_levels.begin(), m_desired_levels.end(), name) !=
+           m_desired_levels.end();
+  };
+
+  // prefetched levels that the game hasn't used, and doesn't want anymore, go first.
+  for (const auto& [name, lev] : m_loaded_tfrag3_levels) {
+    if (lev->prefetched && !is_desired(name) &&
+        std::find(m_prefetch_levels.begin(), m_prefetch_levels.end(), name) ==
+            m_prefetch_levels.end()) {
+      return &name;
+    }
+  }
+
+  for (const auto& [name, lev] : m_loaded_tfrag3_levels) {
+    if (lev->frames_since_last_used > 180 && !lev->prefetched && !is_desired(name)) {
+      return &name;
+    }
+  }
+
+  // if a level the game wants needs the slot, give up on the prefetch.
+  bool desired_level_missing = false;
+  for (auto& des : m_desired_levels) {
+    if (m_loaded_tfrag3_levels.find(des) == m_loaded_tfrag3_levels.end()) {
+      desired_level_missing = true;
+    }
+  }
   for (const auto& [name, lev] : m_loaded_tfrag3_levels) {
-    if (lev->frames_since_last_used > 180 &&
-        std::find(m_desired_levels.begin(), m_desired_levels.end(), name) ==
-            m_desired_levels.end()) {
+    if (lev->prefetched && !is_desired(name) &&
+        (desired_level_missing || (int)m_loaded_tfrag3_levels.size() > m_max_levels)) {
       return &name;
     }
   }
 
   for (const auto& [name, lev] : m_loaded_tfrag3_levels) {
-    if (lev->frames_since_last_used > 180) {
+    if (lev->frames_since_last_used > 180 && !lev->prefetched) {
       return &name;
     }
   }
   return nullptr;
 }
 
+/*!
+ * Remove a loaded level from the GPU and free its data.
+ */
+void Loader::unload_level(const std::string& level_name, TexturePool& texture_pool) {
+  // copy the name, it may be owned by the map entry we're about to erase.
+  std::string name = level_name;
+  auto& lev = m_loaded_tfrag3_levels.at(name);
+  fmt::print("------------------------- PC unloading {}\n", name);
+  {
+    // start_prefetch reads this from the game thread.
+    std::unique_lock<std::mutex> lk(m_loader_mutex);
+    m_unloaded_level_sizes[name] = {lev->cpu_bytes, lev->gpu_bytes};
+  }
+  for (size_t i = 0; i < lev->level->textures.size(); i++) {
+    auto& tex = lev->level->textures[i];
+    if (tex.load_to_pool) {
+      texture_pool.unload_texture(PcTextureId::from_combo_id(tex.combo_id),
+                                  lev->textures.at(i));
+    }
+  }
+  for (size_t i = 0; i < lev->textures.size(); i++) {
+    auto tex = lev->textures[i];
+    if (!lev->level->textures.at(i).load_to_pool &&
+        !m_shared_textures.remove_ref(lev->texture_hashes.at(i))) {
+      // another level is still using this texture.
+      continue;
+    }
+    if (EXTRA_TEX_DEBUG) {
+      for (auto& slot : texture_pool.all_textures()) {
+        if (slot.source) {
+          ASSERT(slot.gpu_texture != tex);
+        } else {
+          ASSERT(slot.gpu_texture != tex);
+        }
+      }
+    }
+
+    glBindTexture(GL_TEXTURE_2D, tex);
+    glDeleteTextures(1, &tex);
+  }
+
+  for (auto& tie_geo : lev->tie_data) {
+    for (auto& tie_tree : tie_geo) {
+      glDeleteBuffers(1, &tie_tree.vertex_buffer);
+      if (tie_tree.has_wind) {
+        glDeleteBuffers(1, &tie_tree.wind_indices);
+      }
+      glDeleteBuffers(1, &tie_tree.index_buffer);
+    }
+  }
+
+  for (auto& tfrag_geo : lev->tfrag_vertex_data) {
+    for (auto& tfrag_buff : tfrag_geo) {
+      glDeleteBuffers(1, &tfrag_buff);
+    }
+  }
+
+  for (auto& shrub : lev->shrub_data) {
+    glDeleteBuffers(1, &shrub.vertex_buffer);
+    glDeleteBuffers(1, &shrub.instance_buffer);
+    glDeleteBuffers(1, &shrub.index_buffer);
+    glDeleteBuffers(1, &shrub.command_buffer);
+  }
+
+  glDeleteBuffers(1, &lev->collide_vertices);
+  glDeleteBuffers(1, &lev->merc_vertices);
+  glDeleteBuffers(1, &lev->merc_indices);
+
+  auto& models = lev->level->merc_data.models;
+  for (size_t i = 0; i < models.size(); i++) {
+    auto& model = models[i];
+    if (!lev->merc_model_uploaded.at(i)) {
+      continue;
+    }
+    auto& mercs = m_all_merc_models.at(model.name);
+    MercRef ref{&model, lev->load_id};
+    auto it = std::find(mercs.begin(), mercs.end(), ref);
+    ASSERT_MSG(it != mercs.end(), fmt::format("missing merc: {}\n", model.name));
+    mercs.erase(it);
+  }
+
+  release_shared_merc_models(*lev);
+  m_loaded_tfrag3_levels.erase(name);
+}
+
+/*!
+ * Drop the references a level holds on shared merc models. If the level owned a model that
+ * other levels still use, one of them takes over ownership and uploads its own copy.
+ */
+void Loader::release_shared_merc_models(LevelData& lev) {
+  auto& models = lev.level->merc_data.models;
+  for (size_t i = 0; i < models.size(); i++) {
+    for (auto& variant : m_shared_merc_models.at(models[i].name)) {
+      if (variant.hash == lev.merc_model_hashes.at(i)) {
+        variant.ref_count--;
+        break;
+      }
+    }
+  }
+
+  std::vector<LevelData*> to_rebuild;
+  for (size_t i = 0; i < models.size(); i++) {
+    auto variants_it = m_shared_merc_models.find(models[i].name);
+    if (variants_it == m_shared_merc_models.end()) {
+      continue;  // already handled, the level has multiple models with this name.
+    }
+    auto& variants = variants_it->second;
+    for (auto it = variants.begin(); it != variants.end();) {
+      if (it->ref_count == 0) {
+        it = variants.erase(it);
+        continue;
+      }
+      if (it->owner == &lev) {
+        LevelData* new_owner = find_merc_model_owner(lev, models[i].name, it->hash);
+        ASSERT_MSG(new_owner, fmt::format("no level to take over merc model {}", models[i].name));
+        it->owner = new_owner;
+        if (std::find(to_rebuild.begin(), to_rebuild.end(), new_owner) == to_rebuild.end()) {
+          to_rebuild.push_back(new_owner);
+        }
+      }
+      ++it;
+    }
+    if (variants.empty()) {
+      m_shared_merc_models.erase(variants_it);
+    }
+  }
+
+  for (auto* other : to_rebuild) {
+    rebuild_merc_buffers(*other);
+  }
+}
+
+/*!
+ * Find a loaded level (other than old_owner) that draws a shared merc model from another level,
+ * and make it upload the model itself.
+ */
+LevelData* Loader::find_merc_model_owner(const LevelData& old_owner,
+                                         const std::string& name,
+                                         u64 hash) {
+  for (auto& [other_name, other] : m_loaded_tfrag3_levels) {
+    if (other.get() == &old_owner) {
+      continue;
+    }
+    auto& other_models = other->level->merc_data.models;
+    bool found = false;
+    for (size_t j = 0; j < other_models.size(); j++) {
+      if (!other->merc_model_uploaded[j] && other_models[j].name == name &&
+          other->merc_model_hashes[j] == hash) {
+        other->merc_model_uploaded[j] = true;
+        found = true;
+      }
+    }
+    if (found) {
+      return other.get();
+    }
+  }
+  return nullptr;
+}
+
+/*!
+ * Re-upload the merc buffers of a loaded level after it took ownership of more models.
+ */
+void Loader::rebuild_merc_buffers(LevelData& lev) {
+  auto& models = lev.level->merc_data.models;
+  // remove the old references, the draws are about to change.
+  for (auto& model : models) {
+    auto& mercs = m_all_merc_models[model.name];
+    MercRef ref{&model, lev.load_id};
+    auto it = std::find(mercs.begin(), mercs.end(), ref);
+    if (it != mercs.end()) {
+      mercs.erase(it);
+    }
+  }
+
+  std::vector<tfrag3::MercVertex> vertices;
+  std::vector<u32> indices;
+  build_merc_buffers(lev, &vertices, &indices);
+  glDeleteBuffers(1, &lev.merc_vertices);
+  glDeleteBuffers(1, &lev.merc_indices);
+
+  glGenBuffers(1, &lev.merc_indices);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, lev.merc_indices);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(u32), indices.data(),
+               GL_STATIC_DRAW);
+  glGenBuffers(1, &lev.merc_vertices);
+  glBindBuffer(GL_ARRAY_BUFFER, lev.merc_vertices);
+  glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(tfrag3::MercVertex), vertices.data(),
+               GL_STATIC_DRAW);
+
+  for (size_t i = 0; i < models.size(); i++) {
+    if (lev.merc_model_uploaded[i]) {
+      m_all_merc_models[models[i].name].push_back({&models[i], lev.load_id, &lev});
+    }
+  }
+  update_level_memory_usage(lev);
+}
+
+/*!
+ * Are the loaded levels, plus extra bytes, over the memory budget?
+ */
+bool Loader::over_memory_budget(u64 extra_cpu_bytes, u64 extra_gpu_bytes) const {
+  u64 total_cpu = extra_cpu_bytes, total_gpu = extra_gpu_bytes;
+  for (auto& lev : m_loaded_tfrag3_levels) {
+    total_cpu += lev.second->cpu_bytes;
+    total_gpu += lev.second->gpu_bytes;
+  }
+  return (m_cpu_budget_mb > 0 && total_cpu > (u64)m_cpu_budget_mb * 1024 * 1024) ||
+         (m_gpu_budget_mb > 0 && total_gpu > (u64)m_gpu_budget_mb * 1024 * 1024);
+}
+
+/*!
+ * Find the level that was used longest ago, ignoring anything the game is using or wants.
+ */
+const std::string* Loader::get_least_recently_used_level() {
+  const std::string* result = nullptr;
+  int oldest = MIN_FRAMES_BEFORE_EVICT;
+  for (const auto& [name, lev] : m_loaded_tfrag3_levels) {
+    if (std::find(m_desired_levels.begin(), m_desired_levels.end(), name) !=
+        m_desired_levels.end()) {
+      continue;
+    }
+    // prefetched levels haven't been used yet, treat them as the oldest.
+    int age = lev->prefetched ? INT32_MAX : lev->frames_since_last_used;
+    if (age > oldest) {
+      oldest = age;
+      result = &name;
+    }
+  }
+  return result;
+}
+
 void Loader::update(TexturePool& texture_pool) {
   Timer loader_timer;
 
@@ -383,8 +1075,16 @@ void Loader::update(TexturePool& texture_pool) {
       loader_input.lev_data = lev.get();
       loader_input.mercs = &m_all_merc_models;
       loader_input.tex_pool = &texture_pool;
+      loader_input.shared_mercs = &m_shared_merc_models;
+      loader_input.shared_textures = &m_shared_textures;
 
+      // with an upload thread, it runs the uploads_only stages and we run the rest.
+      bool background = m_upload_thread.joinable();
+      bool uploads_done = !background || poll_upload_thread(lev.get());
       for (auto& stage : m_loader_stages) {
+        if (background && stage->uploads_only()) {
+          continue;
+        }
         auto evt = scoped_prof(fmt::format("stage-{}", stage->name()).c_str());
         Timer stage_timer;
         done = stage->run(loader_timer, loader_input);
@@ -396,8 +1096,9 @@ void Loader::update(TexturePool& texture_pool) {
         }
       }
 
-      if (done) {
+      if (done && uploads_done) {
         auto evt = scoped_prof("finish-stages");
+        update_level_memory_usage(*lev);
         lk.lock();
         m_loaded_tfrag3_levels[name] = std::move(lev);
         m_initializing_tfrag3_levels.erase(it);
@@ -413,66 +1114,18 @@ void Loader::update(TexturePool& texture_pool) {
     auto evt = scoped_prof("gpu-unload");
     // try to remove levels.
     Timer unload_timer;
+    const std::string* to_unload = nullptr;
     if ((int)m_loaded_tfrag3_levels.size() >= m_max_levels) {
-      auto to_unload = get_most_unloadable_level();
+      to_unload = get_most_unloadable_level();
+    } else if (over_memory_budget()) {
+      to_unload = get_least_recently_used_level();
       if (to_unload) {
-        auto& lev = m_loaded_tfrag3_levels.at(*to_unload);
-        std::unique_lock<std::mutex> lk(texture_pool.mutex());
-        fmt::print("------------------------- PC unloading {}\n", *to_unload);
-        for (size_t i = 0; i < lev->level->textures.size(); i++) {
-          auto& tex = lev->level->textures[i];
-          if (tex.load_to_pool) {
-            texture_pool.unload_texture(PcTextureId::from_combo_id(tex.combo_id),
-                                        lev->textures.at(i));
-          }
-        }
-        lk.unlock();
-        for (auto tex : lev->textures) {
-          if (EXTRA_TEX_DEBUG) {
-            for (auto& slot : texture_pool.all_textures()) {
-              if (slot.source) {
-                ASSERT(slot.gpu_texture != tex);
-              } else {
-                ASSERT(slot.gpu_texture != tex);
-              }
-            }
-          }
-
-          glBindTexture(GL_TEXTURE_2D, tex);
-          glDeleteTextures(1, &tex);
-        }
-
-        for (auto& tie_geo : lev->tie_data) {
-          for (auto& tie_tree : tie_geo) {
-            glDeleteBuffers(1, &tie_tree.vertex_buffer);
-            if (tie_tree.has_wind) {
-              glDeleteBuffers(1, &tie_tree.wind_indices);
-            }
-            glDeleteBuffers(1, &tie_tree.index_buffer);
-          }
-        }
-
-        for (auto& tfrag_geo : lev->tfrag_vertex_data) {
-          for (auto& tfrag_buff : tfrag_geo) {
-            glDeleteBuffers(1, &tfrag_buff);
-          }
-        }
-
-        glDeleteBuffers(1, &lev->collide_vertices);
-        glDeleteBuffers(1, &lev->merc_vertices);
-        glDeleteBuffers(1, &lev->merc_indices);
-
-        for (auto& model : lev->level->merc_data.models) {
-          auto& mercs = m_all_merc_models.at(model.name);
-          MercRef ref{&model, lev->load_id};
-          auto it = std::find(mercs.begin(), mercs.end(), ref);
-          ASSERT_MSG(it != mercs.end(), fmt::format("missing merc: {}\n", model.name));
-          mercs.erase(it);
-        }
-
-        m_loaded_tfrag3_levels.erase(*to_unload);
+        m_budget_evictions++;
       }
     }
+    if (to_unload) {
+      unload_level(*to_unload, texture_pool);
+    }
 
     if (unload_timer.getMs() > 5.f) {
       fmt::print("Unload took {:.2f}\n", unload_timer.getMs());
@@ -3,9 +3,11 @@
 #include <condition_variable>
 #include <mutex>
 #include <thread>
+#include <unordered_set>
 
 #include "common/custom_data/Tfrag3Data.h"
 #include "common/util/FileUtil.h"
+#include "common/util/MappedFile.h"
 #include "common/util/Timer.h"
 
 #include "game/graphics/opengl_renderer/loader/common.h"
@@ -16,6 +18,9 @@ class Loader {
  public:
   static constexpr float TIE_LOAD_BUDGET = 1.5f;
   static constexpr float SHARED_TEXTURE_LOAD_BUDGET = 3.f;
+  static constexpr int MAX_CHUNK_LOAD_THREADS = 4;
+  // levels used within this many frames won't be evicted to stay under the memory budget.
+  static constexpr int MIN_FRAMES_BEFORE_EVICT = 30;
   Loader(const fs::path& base_path, int max_levels);
   ~Loader();
   void update(TexturePool& tex_pool);
@@ -24,14 +29,40 @@ class Loader {
   std::optional<MercRef> get_merc_model(const char* model_name);
   void load_common(TexturePool& tex_pool, const std::string& name);
   void set_want_levels(const std::vector<std::string>& levels);
+  std::vector<std::string> get_want_levels();
+  void set_prefetch_levels(const std::vector<std::string>& levels);
   std::vector<LevelData*> get_in_use_levels();
   void draw_debug_window();
 
+  /*!
+   * Start a thread that runs the stages that only upload a level's own buffers (tie, tfrag, shrub,
+   * collide) on an OpenGL context shared with the current one, so those uploads don't take time
+   * from rendering frames. Call from the render thread, with its context current. Returns false
+   * if a shared context can't be made, and all stages keep running in update().
+   */
+  bool start_upload_thread(SDL_Window* window);
+
+  /*!
+   * Stop the upload thread, if there is one. Must be called before the render context is deleted.
+   */
+  void stop_upload_thread();
+
  private:
   void loader_thread();
+  void load_chunked_level(const std::string& lev, const file_util::MappedFile& file, bool prefetch);
+  bool start_prefetch();
+  void remove_missing_prefetch_levels();
   bool upload_textures(Timer& timer, LevelData& data, TexturePool& texture_pool);
+  void upload_thread(SDL_Window* window);
+  bool poll_upload_thread(LevelData* lev);
 
   const std::string* get_most_unloadable_level();
+  const std::string* get_least_recently_used_level();
+  bool over_memory_budget(u64 extra_cpu_bytes = 0, u64 extra_gpu_bytes = 0) const;
+  void unload_level(const std::string& level_name, TexturePool& texture_pool);
+  void release_shared_merc_models(LevelData& lev);
+  LevelData* find_merc_model_owner(const LevelData& old_owner, const std::string& name, u64 hash);
+  void rebuild_merc_buffers(LevelData& lev);
 
   // used by game and loader thread
   std::unordered_map<std::string, std::unique_ptr<LevelData>> m_initializing_tfrag3_levels;
@@ -39,6 +70,7 @@ class Loader {
   LevelData m_common_level;
 
   std::string m_level_to_load;
+  bool m_level_to_load_is_prefetch = false;
 
   std::thread m_loader_thread;
   std::mutex m_loader_mutex;
@@ -47,14 +79,39 @@ class Loader {
   bool m_want_shutdown = false;
   uint64_t m_id = 0;
 
+  // used by game and upload thread
+  std::thread m_upload_thread;
+  SDL_GLContext m_upload_context = nullptr;
+  std::mutex m_upload_mutex;
+  std::condition_variable m_upload_cv;
+  LevelData* m_upload_level = nullptr;  // the level the upload thread is working on
+  GLsync m_upload_fence = nullptr;      // set once all of its uploads have been submitted
+  bool m_upload_shutdown = false;
+
   // used only by game thread
   std::unordered_map<std::string, std::unique_ptr<LevelData>> m_loaded_tfrag3_levels;
 
   std::unordered_map<std::string, std::vector<MercRef>> m_all_merc_models;
+  // merc models and textures with identical content are only uploaded once.
+  std::unordered_map<std::string, std::vector<SharedMercModel>> m_shared_merc_models;
+  SharedTextureCache m_shared_textures;
 
   std::vector<std::string> m_desired_levels;
+  std::vector<std::string> m_prefetch_levels;
+  // prefetch hints for levels without an FR3 file. These are ignored from then on.
+  std::unordered_set<std::string> m_missing_prefetch_levels;
   std::vector<std::unique_ptr<LoaderStage>> m_loader_stages;
 
   fs::path m_base_path;
   int m_max_levels = 0;
+  // set from the debug window, 0 means no limit.
+  int m_cpu_budget_mb = 0;
+  int m_gpu_budget_mb = 0;
+  int m_budget_evictions = 0;
+  // memory used by levels when they were unloaded, to avoid prefetching them over the budget.
+  struct LevelMemoryUsage {
+    u64 cpu_bytes = 0;
+    u64 gpu_bytes = 0;
+  };
+  std::unordered_map<std::string, LevelMemoryUsage> m_unloaded_level_sizes;
 };
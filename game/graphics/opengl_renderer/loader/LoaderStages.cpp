@@ -2,23 +2,82 @@
 
 #include "Loader.h"
 
+#include <map>
+
 #include "common/global_profiler/GlobalProfiler.h"
+#include "common/texture/texture_compression.h"
+
+#include "game/graphics/opengl_renderer/opengl_utils.h"
+
+#include "third-party/fmt/core.h"
 
 constexpr float LOAD_BUDGET = 2.5f;
 
+namespace {
+// S3TC formats aren't in our GL loader, but are supported by basically every desktop driver.
+constexpr GLenum GL_COMPRESSED_RGBA_S3TC_DXT1 = 0x83F1;
+constexpr GLenum GL_COMPRESSED_RGBA_S3TC_DXT5 = 0x83F3;
+
+bool s3tc_supported() {
+  static bool supported = SDL_GL_ExtensionSupported("GL_EXT_texture_compression_s3tc");
+  return supported;
+}
+
 /*!
- * Upload a texture to the GPU, and give it to the pool.
+ * Upload all mip levels of a BC1/BC3 texture.
+ */
+void upload_compressed_texture(const tfrag3::Texture& tex) {
+  GLenum format = tex.compression == tfrag3::TextureCompression::BC1
+                      ? GL_COMPRESSED_RGBA_S3TC_DXT1
+                      : GL_COMPRESSED_RGBA_S3TC_DXT5;
+  const u8* data = tex.compressed_bytes();
+  int w = tex.w;
+  int h = tex.h;
+  for (int mip = 0; mip < tex.num_mips; mip++) {
+    u32 size = texture_compression::level_size(tex.compression, w, h);
+    glCompressedTexImage2D(GL_TEXTURE_2D, mip, format, w, h, 0, size, data);
+    data += size;
+    w = std::max(1, w / 2);
+    h = std::max(1, h / 2);
+  }
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, tex.num_mips - 1);
+}
+}  // namespace
+
+/*!
+ * Size of the data uploaded for a texture, used to limit how much we upload per frame.
+ */
+int texture_upload_bytes(const tfrag3::Texture& tex) {
+  if (tex.compression != tfrag3::TextureCompression::NONE && s3tc_supported()) {
+    return tex.compressed_size_bytes();
+  }
+  return tex.w * tex.h * 4;
+}
+
+/*!
+ * Upload a texture to the GPU, and give it to the pool. The pool is only locked to link the
+ * texture, not during the upload.
  */
 u64 add_texture(TexturePool& pool, const tfrag3::Texture& tex, bool is_common) {
   GLuint gl_tex;
   glGenTextures(1, &gl_tex);
-  glBindTexture(GL_TEXTURE_2D, gl_tex);
-  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, tex.w, tex.h, 0, GL_RGBA, GL_UNSIGNED_INT_8_8_8_8_REV,
-               tex.data.data());
-  glBindTexture(GL_TEXTURE_2D, 0);
   glActiveTexture(GL_TEXTURE0);
   glBindTexture(GL_TEXTURE_2D, gl_tex);
-  glGenerateMipmap(GL_TEXTURE_2D);
+  gl_label(GL_TEXTURE, gl_tex, tex.debug_name);
+  if (tex.compression == tfrag3::TextureCompression::NONE) {
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, tex.w, tex.h, 0, GL_RGBA, GL_UNSIGNED_INT_8_8_8_8_REV,
+                 tex.rgba_bytes());
+    glGenerateMipmap(GL_TEXTURE_2D);
+  } else if (s3tc_supported()) {
+    upload_compressed_texture(tex);
+  } else {
+    // no driver support, decompress on the CPU.
+    auto rgba = texture_compression::texture_rgba(tex);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, tex.w, tex.h, 0, GL_RGBA, GL_UNSIGNED_INT_8_8_8_8_REV,
+                 rgba.data());
+    glGenerateMipmap(GL_TEXTURE_2D);
+  }
   float aniso = 0.0f;
   glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &aniso);
   glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY, aniso);
@@ -31,7 +90,7 @@ u64 add_texture(TexturePool& pool, const tfrag3::Texture& tex, bool is_common) {
     in.gpu_texture = gl_tex;
     in.common = is_common;
     in.id = PcTextureId::from_combo_id(tex.combo_id);
-    in.src_data = (const u8*)tex.data.data();
+    in.src_data = tex.rgba_bytes();
     pool.give_texture(in);
   }
 
@@ -42,16 +101,32 @@ class TextureLoaderStage : public LoaderStage {
  public:
   TextureLoaderStage() : LoaderStage("texture") {}
   bool run(Timer& timer, LoaderInput& data) override {
+    if (!data.lev_data->is_section_loaded(tfrag3::Fr3Section::TEXTURE)) {
+      return false;
+    }
+
     constexpr int MAX_TEX_BYTES_PER_FRAME = 1024 * 512;
 
     int bytes_this_run = 0;
     int tex_this_run = 0;
     if (data.lev_data->textures.size() < data.lev_data->level->textures.size()) {
-      std::unique_lock<std::mutex> tpool_lock(data.tex_pool->mutex());
       while (data.lev_data->textures.size() < data.lev_data->level->textures.size()) {
-        auto& tex = data.lev_data->level->textures[data.lev_data->textures.size()];
-        data.lev_data->textures.push_back(add_texture(*data.tex_pool, tex, false));
-        bytes_this_run += tex.w * tex.h * 4;
+        size_t tex_idx = data.lev_data->textures.size();
+        auto& tex = data.lev_data->level->textures[tex_idx];
+        // textures in the pool are shared by the pool, others by our cache.
+        if (!tex.load_to_pool) {
+          u64 hash = data.lev_data->texture_hashes.at(tex_idx);
+          GLuint existing = data.shared_textures->add_ref(hash);
+          if (existing) {
+            data.lev_data->textures.push_back(existing);
+            continue;
+          }
+          data.lev_data->textures.push_back(add_texture(*data.tex_pool, tex, false));
+          data.shared_textures->add(hash, data.lev_data->textures.back());
+        } else {
+          data.lev_data->textures.push_back(add_texture(*data.tex_pool, tex, false));
+        }
+        bytes_this_run += texture_upload_bytes(tex);
         tex_this_run++;
         if (tex_this_run > 20) {
           break;
@@ -69,11 +144,16 @@ class TextureLoaderStage : public LoaderStage {
 class TfragLoadStage : public LoaderStage {
  public:
   TfragLoadStage() : LoaderStage("tfrag") {}
+  bool uploads_only() const override { return true; }
   bool run(Timer& timer, LoaderInput& data) override {
     if (m_done) {
       return true;
     }
 
+    if (!data.lev_data->is_section_loaded(tfrag3::Fr3Section::TFRAG)) {
+      return false;
+    }
+
     if (data.lev_data->level->tfrag_trees.front().empty()) {
       m_done = true;
       return true;
@@ -86,6 +166,9 @@ class TfragLoadStage : public LoaderStage {
           GLuint& tree_out = data.lev_data->tfrag_vertex_data[geo].emplace_back();
           glGenBuffers(1, &tree_out);
           glBindBuffer(GL_ARRAY_BUFFER, tree_out);
+          gl_label(GL_BUFFER, tree_out,
+                   fmt::format("{}-tfrag-vertices-{}-{}", data.lev_data->level->level_name, geo,
+                               data.lev_data->tfrag_vertex_data[geo].size() - 1));
 
           glBufferData(GL_ARRAY_BUFFER,
                        in_tree.unpacked.vertices.size() * sizeof(tfrag3::PreloadedVertex), nullptr,
@@ -180,70 +263,53 @@ class TfragLoadStage : public LoaderStage {
 class ShrubLoadStage : public LoaderStage {
  public:
   ShrubLoadStage() : LoaderStage("shrub") {}
+  bool uploads_only() const override { return true; }
   bool run(Timer& timer, LoaderInput& data) override {
     if (m_done) {
       return true;
     }
 
+    if (!data.lev_data->is_section_loaded(tfrag3::Fr3Section::SHRUB)) {
+      return false;
+    }
+
     if (data.lev_data->level->shrub_trees.empty()) {
       m_done = true;
       return true;
     }
 
-    if (!m_opengl_created) {
-      for (auto& in_tree : data.lev_data->level->shrub_trees) {
-        GLuint& tree_out = data.lev_data->shrub_vertex_data.emplace_back();
-        glGenBuffers(1, &tree_out);
-        glBindBuffer(GL_ARRAY_BUFFER, tree_out);
-        glBufferData(GL_ARRAY_BUFFER,
-                     in_tree.unpacked.vertices.size() * sizeof(tfrag3::ShrubGpuVertex), nullptr,
-                     GL_STATIC_DRAW);
-      }
-      m_opengl_created = true;
-      return false;
-    }
-
-    constexpr u32 CHUNK_SIZE = 32768;
     u32 uploaded_bytes = 0;
-
     while (true) {
-      const auto& tree = data.lev_data->level->shrub_trees[m_next_tree];
-      u32 end_vert_in_tree = tree.unpacked.vertices.size();
-      // the number of vertices we'd need to finish the tree right now
-      size_t num_verts_left_in_tree = end_vert_in_tree - m_next_vert;
-      size_t start_vert_for_chunk;
-      size_t end_vert_for_chunk;
-
-      bool complete_tree;
-
-      if (num_verts_left_in_tree > CHUNK_SIZE) {
-        complete_tree = false;
-        // should only do partial
-        start_vert_for_chunk = m_next_vert;
-        end_vert_for_chunk = start_vert_for_chunk + CHUNK_SIZE;
-        m_next_vert += CHUNK_SIZE;
-      } else {
-        // should do all!
-        start_vert_for_chunk = m_next_vert;
-        end_vert_for_chunk = end_vert_in_tree;
-        complete_tree = true;
-      }
-
-      glBindBuffer(GL_ARRAY_BUFFER, data.lev_data->shrub_vertex_data[m_next_tree]);
-      u32 upload_size =
-          (end_vert_for_chunk - start_vert_for_chunk) * sizeof(tfrag3::ShrubGpuVertex);
-      glBufferSubData(GL_ARRAY_BUFFER, start_vert_for_chunk * sizeof(tfrag3::ShrubGpuVertex),
-                      upload_size, tree.unpacked.vertices.data() + start_vert_for_chunk);
-      uploaded_bytes += upload_size;
-
-      if (complete_tree) {
-        // and move on to next tree
-        m_next_vert = 0;
-        m_next_tree++;
-        if (m_next_tree >= data.lev_data->level->shrub_trees.size()) {
-          m_done = true;
-          return true;
-        }
+      // the instanced data is small compared to the old unpacked vertices, so upload a whole
+      // tree at a time.
+      const auto& tree = data.lev_data->level->shrub_trees[m_next_tree].instanced;
+      auto& tree_out = data.lev_data->shrub_data.emplace_back();
+      glGenBuffers(1, &tree_out.vertex_buffer);
+      glBindBuffer(GL_ARRAY_BUFFER, tree_out.vertex_buffer);
+      glBufferData(GL_ARRAY_BUFFER, tree.vertices.size() * sizeof(tfrag3::ShrubProtoGpuVertex),
+                   tree.vertices.data(), GL_STATIC_DRAW);
+      glGenBuffers(1, &tree_out.instance_buffer);
+      glBindBuffer(GL_ARRAY_BUFFER, tree_out.instance_buffer);
+      glBufferData(GL_ARRAY_BUFFER, tree.instances.size() * sizeof(tfrag3::ShrubGpuInstance),
+                   tree.instances.data(), GL_STATIC_DRAW);
+      glGenBuffers(1, &tree_out.index_buffer);
+      glBindBuffer(GL_ARRAY_BUFFER, tree_out.index_buffer);
+      glBufferData(GL_ARRAY_BUFFER, tree.indices.size() * sizeof(u32), tree.indices.data(),
+                   GL_STATIC_DRAW);
+      glGenBuffers(1, &tree_out.command_buffer);
+      glBindBuffer(GL_ARRAY_BUFFER, tree_out.command_buffer);
+      glBufferData(GL_ARRAY_BUFFER,
+                   tree.commands.size() * sizeof(tfrag3::DrawElementsIndirectCommand),
+                   tree.commands.data(), GL_STATIC_DRAW);
+      glBindBuffer(GL_ARRAY_BUFFER, 0);
+      uploaded_bytes += tree.vertices.size() * sizeof(tfrag3::ShrubProtoGpuVertex) +
+                        tree.instances.size() * sizeof(tfrag3::ShrubGpuInstance) +
+                        tree.indices.size() * sizeof(u32);
+
+      m_next_tree++;
+      if (m_next_tree >= data.lev_data->level->shrub_trees.size()) {
+        m_done = true;
+        return true;
       }
 
       if (timer.getMs() > LOAD_BUDGET || (uploaded_bytes / 128) > 2048) {
@@ -254,26 +320,27 @@ class ShrubLoadStage : public LoaderStage {
 
   void reset() override {
     m_done = false;
-    m_opengl_created = false;
     m_next_tree = 0;
-    m_next_vert = 0;
   }
 
  private:
   bool m_done = false;
-  bool m_opengl_created = false;
   u32 m_next_tree = 0;
-  u32 m_next_vert = 0;
 };
 
 class TieLoadStage : public LoaderStage {
  public:
   TieLoadStage() : LoaderStage("tie") {}
+  bool uploads_only() const override { return true; }
   bool run(Timer& timer, LoaderInput& data) override {
     if (m_done) {
       return true;
     }
 
+    if (!data.lev_data->is_section_loaded(tfrag3::Fr3Section::TIE)) {
+      return false;
+    }
+
     if (data.lev_data->level->tie_trees.front().empty()) {
       m_done = true;
       return true;
@@ -285,14 +352,18 @@ class TieLoadStage : public LoaderStage {
         auto& in_trees = data.lev_data->level->tie_trees[geo];
         for (auto& in_tree : in_trees) {
           LevelData::TieOpenGL& tree_out = data.lev_data->tie_data[geo].emplace_back();
+          auto label = fmt::format("{}-tie-{}-{}", data.lev_data->level->level_name, geo,
+                                   data.lev_data->tie_data[geo].size() - 1);
           glGenBuffers(1, &tree_out.vertex_buffer);
           glBindBuffer(GL_ARRAY_BUFFER, tree_out.vertex_buffer);
+          gl_label(GL_BUFFER, tree_out.vertex_buffer, label + "-vertices");
           glBufferData(GL_ARRAY_BUFFER,
                        in_tree.unpacked.vertices.size() * sizeof(tfrag3::PreloadedVertex), nullptr,
                        GL_STATIC_DRAW);
 
           glGenBuffers(1, &tree_out.index_buffer);
           glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, tree_out.index_buffer);
+          gl_label(GL_BUFFER, tree_out.index_buffer, label + "-indices");
           glBufferData(GL_ELEMENT_ARRAY_BUFFER, in_tree.unpacked.indices.size() * sizeof(u32),
                        nullptr, GL_STATIC_DRAW);
         }
@@ -497,11 +568,18 @@ class TieLoadStage : public LoaderStage {
 class CollideLoaderStage : public LoaderStage {
  public:
   CollideLoaderStage() : LoaderStage("collide") {}
+  bool uploads_only() const override { return true; }
   bool run(Timer& /*timer*/, LoaderInput& data) override {
     if (m_done) {
       return true;
     }
+
+    if (!data.lev_data->is_section_loaded(tfrag3::Fr3Section::COLLISION)) {
+      return false;
+    }
+
     if (!m_opengl_created) {
+      // the loader thread already sorted the vertices and built the bvh.
       glGenBuffers(1, &data.lev_data->collide_vertices);
       glBindBuffer(GL_ARRAY_BUFFER, data.lev_data->collide_vertices);
       glBufferData(
@@ -556,12 +634,234 @@ class StallLoaderStage : public LoaderStage {
   int m_count = 0;
 };
 
+namespace {
+/*!
+ * 64-bit FNV-1a hash.
+ */
+u64 hash_bytes(const void* data, size_t size, u64 hash = 14695981039346656037ull) {
+  const u8* bytes = (const u8*)data;
+  for (size_t i = 0; i < size; i++) {
+    hash ^= bytes[i];
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+template <typename T>
+u64 hash_pod(const T& thing, u64 hash) {
+  return hash_bytes(&thing, sizeof(T), hash);
+}
+
+template <typename T>
+u64 hash_vector(const std::vector<T>& vec, u64 hash) {
+  hash = hash_pod(vec.size(), hash);
+  return hash_bytes(vec.data(), vec.size() * sizeof(T), hash);
+}
+
+/*!
+ * Call f(draw, uses_main_vertices) on every draw of a model, in a fixed order.
+ * Mod draws index into the effect's own mod vertices, not the level's merc vertex buffer.
+ */
+template <typename T, typename F>
+void for_each_merc_draw(T& model, F&& f) {
+  for (auto& effect : model.effects) {
+    for (auto& draw : effect.all_draws) {
+      f(draw, true);
+    }
+    for (auto& draw : effect.mod.fix_draw) {
+      f(draw, true);
+    }
+    for (auto& draw : effect.mod.mod_draw) {
+      f(draw, false);
+    }
+  }
+}
+
+/*!
+ * Range of vertices in the level's merc vertex buffer used by a model, as [min, max).
+ * The first_index values of draws are looked up in the original (not compacted) list.
+ */
+std::pair<u32, u32> merc_model_vertex_range(const tfrag3::MercModelGroup& merc,
+                                            const tfrag3::MercModel& model,
+                                            const u32* original_first_index) {
+  u32 vmin = UINT32_MAX;
+  u32 vmax = 0;
+  int draw_idx = 0;
+  for_each_merc_draw(model, [&](const tfrag3::MercDraw& draw, bool main_vertices) {
+    u32 first = original_first_index[draw_idx++];
+    if (!main_vertices) {
+      return;
+    }
+    for (u32 i = first; i < first + draw.index_count; i++) {
+      u32 idx = merc.indices[i];
+      if (idx != UINT32_MAX) {
+        vmin = std::min(vmin, idx);
+        vmax = std::max(vmax, idx + 1);
+      }
+    }
+  });
+  if (vmin == UINT32_MAX) {
+    return {0, 0};
+  }
+  return {vmin, vmax};
+}
+
+u32 merc_model_draw_count(const tfrag3::MercModel& model) {
+  u32 count = 0;
+  for_each_merc_draw(model, [&](const tfrag3::MercDraw&, bool) { count++; });
+  return count;
+}
+}  // namespace
+
+u64 texture_hash(const tfrag3::Texture& tex) {
+  u64 hash = hash_pod(tex.w, hash_pod(tex.h, hash_pod(tex.compression, 14695981039346656037ull)));
+  hash = hash_pod(tex.rgba_size_bytes(), hash);
+  hash = hash_bytes(tex.rgba_bytes(), tex.rgba_size_bytes(), hash);
+  hash = hash_pod(tex.compressed_size_bytes(), hash);
+  return hash_bytes(tex.compressed_bytes(), tex.compressed_size_bytes(), hash);
+}
+
+/*!
+ * Compute hashes used to share data between levels. This is done by the loader thread.
+ * The texture_hashes vector must already be sized, chunks may be hashed in parallel.
+ */
+void compute_texture_hashes(LevelData& lev, u32 first, u32 count) {
+  for (u32 i = first; i < first + count; i++) {
+    lev.texture_hashes[i] = texture_hash(lev.level->textures[i]);
+  }
+}
+
+/*!
+ * Must be called after all textures are hashed.
+ */
+void compute_merc_model_hashes(LevelData& lev) {
+  auto& merc = lev.level->merc_data;
+
+  // remember the first_index of each draw, we'll modify them when compacting the buffers.
+  lev.merc_original_first_index.clear();
+  for (auto& model : merc.models) {
+    for_each_merc_draw(model, [&](const tfrag3::MercDraw& draw, bool) {
+      lev.merc_original_first_index.push_back(draw.first_index);
+    });
+  }
+
+  lev.merc_model_hashes.clear();
+  const u32* original_first = lev.merc_original_first_index.data();
+  for (auto& model : merc.models) {
+    auto [vmin, vmax] = merc_model_vertex_range(merc, model, original_first);
+    u64 hash = hash_bytes(model.name.data(), model.name.size());
+    hash = hash_pod(model.max_bones, hash_pod(model.max_draws, hash));
+    hash = hash_pod(model.xyz_scale, hash_pod(model.st_magic, hash_pod(model.st_vif_add, hash)));
+    hash = hash_bytes(merc.vertices.data() + vmin, (vmax - vmin) * sizeof(tfrag3::MercVertex),
+                      hash);
+    for (auto& effect : model.effects) {
+      hash = hash_pod(effect.has_envmap, hash_pod(effect.has_mod_draw, hash));
+      hash = hash_pod(effect.envmap_mode, hash);
+      if (effect.has_envmap) {
+        hash = hash_pod(lev.texture_hashes.at(effect.envmap_texture), hash);
+      }
+      hash = hash_vector(effect.mod.vertices, hash);
+      hash = hash_vector(effect.mod.vertex_lump4_addr, hash);
+      hash = hash_vector(effect.mod.blerc.float_data, hash);
+      hash = hash_vector(effect.mod.blerc.int_data, hash);
+    }
+
+    int draw_idx = 0;
+    for_each_merc_draw(model, [&](const tfrag3::MercDraw& draw, bool main_vertices) {
+      u32 first = original_first[draw_idx++];
+      hash = hash_pod(draw.mode, hash_pod(draw.eye_id, hash_pod(draw.index_count, hash)));
+      hash = hash_pod(lev.texture_hashes.at(draw.tree_tex_id), hash);
+      for (u32 i = first; i < first + draw.index_count; i++) {
+        u32 idx = merc.indices[i];
+        if (main_vertices && idx != UINT32_MAX) {
+          idx -= vmin;
+        }
+        hash = hash_pod(idx, hash);
+      }
+    });
+    original_first += merc_model_draw_count(model);
+    lev.merc_model_hashes.push_back(hash);
+  }
+}
+
+/*!
+ * Build merc vertex and index buffers containing only the models that this level uploads.
+ * The draws of these models are updated to point into the new index buffer.
+ */
+void build_merc_buffers(LevelData& lev,
+                        std::vector<tfrag3::MercVertex>* vertices,
+                        std::vector<u32>* indices) {
+  auto& merc = lev.level->merc_data;
+  vertices->clear();
+  indices->clear();
+  const u32* original_first = lev.merc_original_first_index.data();
+  for (size_t mi = 0; mi < merc.models.size(); mi++) {
+    auto& model = merc.models[mi];
+    u32 num_draws = merc_model_draw_count(model);
+    if (!lev.merc_model_uploaded.at(mi)) {
+      original_first += num_draws;
+      continue;
+    }
+
+    auto [vmin, vmax] = merc_model_vertex_range(merc, model, original_first);
+    u32 vertex_base = vertices->size();
+    vertices->insert(vertices->end(), merc.vertices.begin() + vmin, merc.vertices.begin() + vmax);
+
+    // draws may share indices, only copy them once.
+    std::map<std::pair<u32, u32>, u32> copied_indices;
+    int draw_idx = 0;
+    for_each_merc_draw(model, [&](tfrag3::MercDraw& draw, bool main_vertices) {
+      u32 first = original_first[draw_idx++];
+      auto key = std::make_pair(first, draw.index_count);
+      const auto& existing = copied_indices.find(key);
+      if (existing != copied_indices.end()) {
+        draw.first_index = existing->second;
+        return;
+      }
+      draw.first_index = indices->size();
+      copied_indices[key] = draw.first_index;
+      for (u32 i = first; i < first + draw.index_count; i++) {
+        u32 idx = merc.indices[i];
+        if (main_vertices && idx != UINT32_MAX) {
+          idx = idx - vmin + vertex_base;
+        }
+        indices->push_back(idx);
+      }
+    });
+    original_first += num_draws;
+  }
+}
+
+/*!
+ * Decide which merc models this level will upload. Models that a loaded level already has are
+ * drawn from that level's copy.
+ */
+void claim_merc_models(LevelData& lev,
+                       std::unordered_map<std::string, std::vector<SharedMercModel>>& shared) {
+  auto& models = lev.level->merc_data.models;
+  lev.merc_model_uploaded.assign(models.size(), true);
+  for (size_t i = 0; i < models.size(); i++) {
+    auto& variants = shared[models[i].name];
+    auto it = std::find_if(variants.begin(), variants.end(), [&](const SharedMercModel& m) {
+      return m.hash == lev.merc_model_hashes.at(i);
+    });
+    if (it != variants.end()) {
+      it->ref_count++;
+      lev.merc_model_uploaded[i] = false;
+    } else {
+      variants.push_back({lev.merc_model_hashes.at(i), &lev, 1});
+    }
+  }
+}
+
 MercLoaderStage::MercLoaderStage() : LoaderStage("merc") {}
 void MercLoaderStage::reset() {
   m_done = false;
   m_opengl = false;
   m_vtx_uploaded = false;
   m_idx = 0;
+  m_vertices = {};
+  m_indices = {};
 }
 
 bool MercLoaderStage::run(Timer& /*timer*/, LoaderInput& data) {
@@ -569,28 +869,36 @@ bool MercLoaderStage::run(Timer& /*timer*/, LoaderInput& data) {
     return true;
   }
 
+  if (!data.lev_data->is_section_loaded(tfrag3::Fr3Section::MERC)) {
+    return false;
+  }
+
   if (!m_opengl) {
+    claim_merc_models(*data.lev_data, *data.shared_mercs);
+    build_merc_buffers(*data.lev_data, &m_vertices, &m_indices);
+
     glGenBuffers(1, &data.lev_data->merc_indices);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, data.lev_data->merc_indices);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER,
-                 data.lev_data->level->merc_data.indices.size() * sizeof(u32), nullptr,
-                 GL_STATIC_DRAW);
+    gl_label(GL_BUFFER, data.lev_data->merc_indices,
+             data.lev_data->level->level_name + "-merc-indices");
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_indices.size() * sizeof(u32), nullptr, GL_STATIC_DRAW);
 
     glGenBuffers(1, &data.lev_data->merc_vertices);
     glBindBuffer(GL_ARRAY_BUFFER, data.lev_data->merc_vertices);
-    glBufferData(GL_ARRAY_BUFFER,
-                 data.lev_data->level->merc_data.vertices.size() * sizeof(tfrag3::MercVertex),
-                 nullptr, GL_STATIC_DRAW);
+    gl_label(GL_BUFFER, data.lev_data->merc_vertices,
+             data.lev_data->level->level_name + "-merc-vertices");
+    glBufferData(GL_ARRAY_BUFFER, m_vertices.size() * sizeof(tfrag3::MercVertex), nullptr,
+                 GL_STATIC_DRAW);
     m_opengl = true;
   }
 
   if (!m_vtx_uploaded) {
     u32 start = m_idx;
-    m_idx = std::min(start + 32768, (u32)data.lev_data->level->merc_data.indices.size());
+    m_idx = std::min(start + 32768, (u32)m_indices.size());
     glBindBuffer(GL_ARRAY_BUFFER, data.lev_data->merc_indices);
     glBufferSubData(GL_ARRAY_BUFFER, start * sizeof(u32), (m_idx - start) * sizeof(u32),
-                    data.lev_data->level->merc_data.indices.data() + start);
-    if (m_idx != data.lev_data->level->merc_data.indices.size()) {
+                    m_indices.data() + start);
+    if (m_idx != m_indices.size()) {
       return false;
     } else {
       m_idx = 0;
@@ -599,19 +907,24 @@ bool MercLoaderStage::run(Timer& /*timer*/, LoaderInput& data) {
   }
 
   u32 start = m_idx;
-  m_idx = std::min(start + 32768, (u32)data.lev_data->level->merc_data.vertices.size());
+  m_idx = std::min(start + 32768, (u32)m_vertices.size());
   glBindBuffer(GL_ARRAY_BUFFER, data.lev_data->merc_vertices);
   glBufferSubData(GL_ARRAY_BUFFER, start * sizeof(tfrag3::MercVertex),
-                  (m_idx - start) * sizeof(tfrag3::MercVertex),
-                  data.lev_data->level->merc_data.vertices.data() + start);
+                  (m_idx - start) * sizeof(tfrag3::MercVertex), m_vertices.data() + start);
 
-  if (m_idx != data.lev_data->level->merc_data.vertices.size()) {
+  if (m_idx != m_vertices.size()) {
     return false;
   } else {
     m_done = true;
-    for (auto& model : data.lev_data->level->merc_data.models) {
+    m_vertices = {};
+    m_indices = {};
+    auto& models = data.lev_data->level->merc_data.models;
+    for (size_t i = 0; i < models.size(); i++) {
+      auto& model = models[i];
       data.lev_data->merc_model_lookup[model.name] = &model;
-      (*data.mercs)[model.name].push_back({&model, data.lev_data->load_id, data.lev_data});
+      if (data.lev_data->merc_model_uploaded[i]) {
+        (*data.mercs)[model.name].push_back({&model, data.lev_data->load_id, data.lev_data});
+      }
     }
     return true;
   }
@@ -4,6 +4,13 @@
 
 std::vector<std::unique_ptr<LoaderStage>> make_loader_stages();
 u64 add_texture(TexturePool& pool, const tfrag3::Texture& tex, bool is_common);
+int texture_upload_bytes(const tfrag3::Texture& tex);
+u64 texture_hash(const tfrag3::Texture& tex);
+void compute_texture_hashes(LevelData& lev, u32 first, u32 count);
+void compute_merc_model_hashes(LevelData& lev);
+void build_merc_buffers(LevelData& lev,
+                        std::vector<tfrag3::MercVertex>* vertices,
+                        std::vector<u32>* indices);
 
 class MercLoaderStage : public LoaderStage {
  public:
@@ -16,4 +23,6 @@ class MercLoaderStage : public LoaderStage {
   bool m_opengl = false;
   bool m_vtx_uploaded = false;
   u32 m_idx = 0;
+  std::vector<tfrag3::MercVertex> m_vertices;
+  std::vector<u32> m_indices;
 };
\ No newline at end of file
@@ -1,13 +1,27 @@
 #pragma once
 
+#include <atomic>
+
 #include "common/common_types.h"
 #include "common/custom_data/Tfrag3Data.h"
+#include "common/custom_data/chunked_fr3.h"
 #include "common/util/Timer.h"
 
 #include "game/graphics/texture/TexturePool.h"
 
 #include "third-party/glad/include/glad/glad.h"
 
+/*!
+ * Node of the bounding volume hierarchy over a level's collision triangles. The collision vertices
+ * are reordered so each node's triangles are contiguous.
+ */
+struct CollideBvhNode {
+  math::Vector4f bsphere;  // w is radius
+  u32 first_vertex = 0;
+  u32 vertex_count = 0;
+  u32 children[2] = {0, 0};  // 0 for a leaf.
+};
+
 struct LevelData {
   std::unique_ptr<tfrag3::Level> level;
   std::vector<GLuint> textures;
@@ -21,14 +35,47 @@ struct LevelData {
   };
   std::array<std::vector<TieOpenGL>, tfrag3::TIE_GEOS> tie_data;
   std::array<std::vector<GLuint>, tfrag3::TIE_GEOS> tfrag_vertex_data;
-  std::vector<GLuint> shrub_vertex_data;
+  // content hash of each texture, used to share identical textures between levels.
+  std::vector<u64> texture_hashes;
+  struct ShrubOpenGL {
+    GLuint vertex_buffer;    // prototype vertices
+    GLuint instance_buffer;  // per-instance matrix and time of day index
+    GLuint index_buffer;
+    GLuint command_buffer;  // indirect draw commands
+  };
+  std::vector<ShrubOpenGL> shrub_data;
   GLuint collide_vertices;
+  std::vector<CollideBvhNode> collide_bvh;
 
   GLuint merc_vertices;
   GLuint merc_indices;
   std::unordered_map<std::string, const tfrag3::MercModel*> merc_model_lookup;
+  // content hash of each merc model, and if it is in this level's merc buffers. Models that
+  // another level already has are drawn using that level's copy instead.
+  std::vector<u64> merc_model_hashes;
+  std::vector<bool> merc_model_uploaded;
+  // the first_index of each merc draw in the fr3 data, before merc buffers were compacted.
+  std::vector<u32> merc_original_first_index;
 
   int frames_since_last_used = 0;
+  // loaded because of a prefetch, and not used by the game yet.
+  bool prefetched = false;
+
+  // memory used once fully loaded, for the loader's memory budget.
+  u64 cpu_bytes = 0;
+  u64 gpu_bytes = 0;
+
+  // Levels from chunked fr3 files are given to the loader stages before they are fully loaded.
+  // The loader thread sets these once every chunk in a section is loaded and unpacked.
+  std::array<std::atomic<bool>, tfrag3::FR3_SECTION_COUNT> section_loaded = {};
+  bool is_section_loaded(tfrag3::Fr3Section section) const {
+    return section_loaded[(int)section].load(std::memory_order_acquire);
+  }
+  void set_all_sections_loaded() {
+    for (auto& sec : section_loaded) {
+      sec.store(true, std::memory_order_release);
+    }
+  }
 };
 
 struct MercRef {
@@ -40,10 +87,62 @@ struct MercRef {
   }
 };
 
+/*!
+ * Textures that don't go in the texture pool are shared between levels if their contents are
+ * identical. Each level holds a reference, and the texture is deleted when the last one unloads.
+ */
+class SharedTextureCache {
+ public:
+  // Get a texture with this hash and add a reference, or 0 if there isn't one.
+  GLuint add_ref(u64 hash) {
+    auto it = m_textures.find(hash);
+    if (it == m_textures.end()) {
+      return 0;
+    }
+    it->second.refs++;
+    return it->second.texture;
+  }
+
+  void add(u64 hash, GLuint texture) { m_textures[hash] = {texture, 1}; }
+
+  // Remove a reference. Returns true if the texture isn't used anymore and should be deleted.
+  bool remove_ref(u64 hash) {
+    auto it = m_textures.find(hash);
+    ASSERT(it != m_textures.end());
+    if (--it->second.refs == 0) {
+      m_textures.erase(it);
+      return true;
+    }
+    return false;
+  }
+
+  int size() const { return m_textures.size(); }
+
+ private:
+  struct Entry {
+    GLuint texture;
+    int refs;
+  };
+  std::unordered_map<u64, Entry> m_textures;
+};
+
+/*!
+ * Merc models that are identical between levels (Jak, Daxter, common enemies) are only uploaded
+ * by one level, the owner. The others draw the owner's copy. ref_count is the number of loaded
+ * levels that have this model.
+ */
+struct SharedMercModel {
+  u64 hash = 0;
+  LevelData* owner = nullptr;
+  int ref_count = 0;
+};
+
 struct LoaderInput {
   LevelData* lev_data;
   TexturePool* tex_pool;
   std::unordered_map<std::string, std::vector<MercRef>>* mercs;
+  std::unordered_map<std::string, std::vector<SharedMercModel>>* shared_mercs;
+  SharedTextureCache* shared_textures;
 };
 
 class LoaderStage {
@@ -53,6 +152,9 @@ class LoaderStage {
   virtual void reset() = 0;
   virtual ~LoaderStage() = default;
   const std::string& name() const { return m_name; }
+  // true if the stage only touches the level's own data and buffers, so it can run on the upload
+  // thread while the render thread runs the others.
+  virtual bool uploads_only() const { return false; }
 
  protected:
   std::string m_name;
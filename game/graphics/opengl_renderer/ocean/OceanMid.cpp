@@ -1,5 +1,6 @@
 #include "OceanMid.h"
 
+#include "common/dma/vif_unpack.h"
 #include "common/log/log.h"
 
 static bool is_end_tag(const DmaTag& tag, const VifCode& v0, const VifCode& v1) {
@@ -69,13 +70,7 @@ void OceanMid::run(DmaFollower& dma, SharedRenderState* render_state, ScopedProf
       u16 addr = up.addr_qw + get_upload_buffer();
       ASSERT(addr + v1.num <= 1024);
 
-      u32 temp[4];
-      for (u32 i = 0; i < v1.num; i++) {
-        for (u32 j = 0; j < 4; j++) {
-          temp[j] = data.data[4 * i + j];
-        }
-        memcpy(m_vu_data + addr + i, temp, 16);
-      }
+      vif_unpack(m_vu_data + addr, data.data, v1.kind, v1.num, up.is_unsigned);
       ASSERT(4 * v1.num == data.size_bytes);
 
     } else if (v0.kind == VifCode::Kind::STCYCL && v0.immediate == 0x204 &&
@@ -86,16 +81,8 @@ void OceanMid::run(DmaFollower& dma, SharedRenderState* render_state, ScopedProf
       u16 addr = up.addr_qw + get_upload_buffer();
       ASSERT(addr + v1.num <= 1024);
 
-      u32 temp[4];
-      for (u32 i = 0; i < v1.num; i++) {
-        for (u32 j = 0; j < 4; j++) {
-          temp[j] = data.data[4 * i + j];
-        }
-        // cl = 4
-        // wl = 2
-        u32 addr_off = 4 * (i / 2) + i % 2;
-        memcpy(m_vu_data + addr + addr_off, temp, 16);
-      }
+      // cl = 4, wl = 2
+      vif_unpack(m_vu_data + addr, data.data, v1.kind, v1.num, up.is_unsigned, 4, 2);
       ASSERT(8 * v1.num == data.size_bytes);
     } else if (v0.kind == VifCode::Kind::STCYCL && v0.immediate == 0x404 &&
                v1.kind == VifCode::Kind::MSCALF) {
@@ -190,13 +177,7 @@ void OceanMid::run_jak2(DmaFollower& dma,
       u16 addr = up.addr_qw + get_upload_buffer();
       ASSERT(addr + v1.num <= 1024);
 
-      u32 temp[4];
-      for (u32 i = 0; i < v1.num; i++) {
-        for (u32 j = 0; j < 4; j++) {
-          temp[j] = data.data[4 * i + j];
-        }
-        memcpy(m_vu_data + addr + i, temp, 16);
-      }
+      vif_unpack(m_vu_data + addr, data.data, v1.kind, v1.num, up.is_unsigned);
       ASSERT(4 * v1.num == data.size_bytes);
 
     } else if (v0.kind == VifCode::Kind::STCYCL && v0.immediate == 0x204 &&
@@ -207,16 +188,8 @@ void OceanMid::run_jak2(DmaFollower& dma,
       u16 addr = up.addr_qw + get_upload_buffer();
       ASSERT(addr + v1.num <= 1024);
 
-      u32 temp[4];
-      for (u32 i = 0; i < v1.num; i++) {
-        for (u32 j = 0; j < 4; j++) {
-          temp[j] = data.data[4 * i + j];
-        }
-        // cl = 4
-        // wl = 2
-        u32 addr_off = 4 * (i / 2) + i % 2;
-        memcpy(m_vu_data + addr + addr_off, temp, 16);
-      }
+      // cl = 4, wl = 2
+      vif_unpack(m_vu_data + addr, data.data, v1.kind, v1.num, up.is_unsigned, 4, 2);
       ASSERT(8 * v1.num == data.size_bytes);
     } else if (v0.kind == VifCode::Kind::STCYCL && v0.immediate == 0x404 &&
                v1.kind == VifCode::Kind::MSCALF) {
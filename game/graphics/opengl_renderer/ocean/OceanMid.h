@@ -120,6 +120,11 @@ class OceanMid {
 
   Vf m_vu_data[1024];
 
+  void sq_buffer_xyzw(const Vf& val, u16 addr) {
+    ASSERT(addr < 1024);
+    copy_vector(m_vu_data[addr].data, val.data);
+  }
+
   void sq_buffer(Mask mask, const Vf& val, u16 addr) {
     ASSERT(addr < 1024);
     for (int i = 0; i < 4; i++) {
@@ -170,6 +175,11 @@ class OceanMid {
     }
   }
 
+  void lq_buffer_xyzw(Vf& dest, u16 addr) {
+    ASSERT(addr < 1024);
+    copy_vector(dest.data, m_vu_data[addr].data);
+  }
+
   void lq_buffer(Mask mask, Vf& dest, u16 addr) {
     ASSERT(addr < 1024);
     for (int i = 0; i < 4; i++) {
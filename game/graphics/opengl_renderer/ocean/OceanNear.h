@@ -59,6 +59,11 @@ class OceanNear : public BucketRenderer {
     }
   }
 
+  void lq_buffer_xyzw(Vf& dest, u16 addr) {
+    ASSERT(addr < 1024);
+    copy_vector(dest.data, m_vu_data[addr].data);
+  }
+
   void lq_buffer(Mask mask, Vf& dest, u16 addr) {
     ASSERT(addr < 1024);
     for (int i = 0; i < 4; i++) {
@@ -68,6 +73,11 @@ class OceanNear : public BucketRenderer {
     }
   }
 
+  void sq_buffer_xyzw(const Vf& val, u16 addr) {
+    ASSERT(addr < 1024);
+    copy_vector(m_vu_data[addr].data, val.data);
+  }
+
   void sq_buffer(Mask mask, const Vf& val, u16 addr) {
     ASSERT(addr < 1024);
     for (int i = 0; i < 4; i++) {
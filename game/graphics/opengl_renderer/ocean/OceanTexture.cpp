@@ -406,6 +406,10 @@ void OceanTexture::handle_ocean_texture_jak2(DmaFollower& dma,
  */
 void OceanTexture::make_texture_with_mipmaps(SharedRenderState* render_state,
                                              ScopedProfilerNode& prof) {
+  if (render_state->use_compute_ocean_mips) {
+    make_mipmaps_compute(render_state);
+    return;
+  }
   glBindVertexArray(m_mipmap.vao);
   render_state->shaders[ShaderId::OCEAN_TEXTURE_MIPMAP].activate();
   glUniform1f(glGetUniformLocation(render_state->shaders[ShaderId::OCEAN_TEXTURE_MIPMAP].id(),
@@ -436,3 +440,23 @@ void OceanTexture::make_texture_with_mipmaps(SharedRenderState* render_state,
   }
   glBindVertexArray(0);
 }
+
+/*!
+ * Generate all the mipmaps in a single dispatch of the ocean_mipmap compute shader. This is the
+ * same sampling and alpha fade as the draws in make_texture_with_mipmaps, without binding a
+ * framebuffer for each level.
+ */
+void OceanTexture::make_mipmaps_compute(SharedRenderState* render_state) {
+  render_state->shaders[ShaderId::OCEAN_MIPMAP].activate();
+  glActiveTexture(GL_TEXTURE0);
+  glBindTexture(GL_TEXTURE_2D, m_temp_texture.texture());
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  glUniform1i(0, 0);
+  for (int i = 0; i < NUM_MIPS; i++) {
+    glBindImageTexture(i, m_result_texture.texture(), i, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA8);
+  }
+  glDispatchCompute(TEX0_SIZE / 8, TEX0_SIZE / 8, NUM_MIPS);
+  // the ocean renderers sample the result.
+  glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+}
@@ -36,6 +36,7 @@ class OceanTexture {
   void destroy_pc();
 
   void make_texture_with_mipmaps(SharedRenderState* render_state, ScopedProfilerNode& prof);
+  void make_mipmaps_compute(SharedRenderState* render_state);
 
   bool m_generate_mipmaps;
 
@@ -3,10 +3,17 @@
 #include <array>
 #include <cstdio>
 
+#include "common/log/log.h"
 #include "common/util/Assert.h"
 
 #include "game/graphics/opengl_renderer/BucketRenderer.h"
 
+void gl_label(GLenum identifier, GLuint object, const std::string& label) {
+  if (glObjectLabel) {
+    glObjectLabel(identifier, object, label.size(), label.c_str());
+  }
+}
+
 FramebufferTexturePair::FramebufferTexturePair(int w, int h, u64 texture_format, int num_levels)
     : m_w(w), m_h(h) {
   m_framebuffers.resize(num_levels);
@@ -150,6 +157,23 @@ void FullScreenDraw::draw(const math::Vector4f& color,
   glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
 }
 
+void FullScreenDraw::draw_texture(GLuint texture,
+                                  float intensity,
+                                  SharedRenderState* render_state,
+                                  ScopedProfilerNode& prof) {
+  glBindVertexArray(m_vao);
+  glBindBuffer(GL_ARRAY_BUFFER, m_vertex_buffer);
+  auto& shader = render_state->shaders[ShaderId::POST_PROCESSING];
+  shader.activate();
+  glUniform4f(glGetUniformLocation(shader.id(), "fragment_color"), 1.f, 1.f, 1.f, intensity);
+  render_state->gl_state.active_texture(GL_TEXTURE0);
+  render_state->gl_state.bind_texture(GL_TEXTURE_2D, texture);
+
+  prof.add_tri(2);
+  prof.add_draw_call();
+  glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+}
+
 FramebufferCopier::FramebufferCopier() {
   glGenFramebuffers(1, &m_fbo);
   glBindFramebuffer(GL_FRAMEBUFFER, m_fbo);
@@ -210,4 +234,316 @@ void FramebufferCopier::copy_now(int render_fb_w,
   );
 
   glBindFramebuffer(GL_FRAMEBUFFER, render_fb);
-}
\ No newline at end of file
+}
+
+namespace {
+// not in our glad loader, which is generated for 4.3 core.
+constexpr GLbitfield kMapPersistentBit = 0x0040;
+constexpr GLbitfield kMapCoherentBit = 0x0080;
+using BufferStorageProc = void(APIENTRYP)(GLenum target,
+                                          GLsizeiptr size,
+                                          const void* data,
+                                          GLbitfield flags);
+u32 align_up(u32 val, u32 alignment) {
+  return ((val + alignment - 1) / alignment) * alignment;
+}
+}  // namespace
+
+DrawModeSamplers::DrawModeSamplers() {
+  glGenSamplers(16, m_samplers);
+  float aniso = 0.0f;
+  glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &aniso);
+  for (int i = 0; i < 16; i++) {
+    bool clamp_s = i & 1;
+    bool clamp_t = i & 2;
+    bool filter = i & 4;
+    bool mipmap = i & 8;
+    GLuint sampler = m_samplers[i];
+    glSamplerParameteri(sampler, GL_TEXTURE_WRAP_S, clamp_s ? GL_CLAMP_TO_EDGE : GL_REPEAT);
+    glSamplerParameteri(sampler, GL_TEXTURE_WRAP_T, clamp_t ? GL_CLAMP_TO_EDGE : GL_REPEAT);
+    if (filter) {
+      glSamplerParameteri(sampler, GL_TEXTURE_MIN_FILTER,
+                          mipmap ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+      glSamplerParameteri(sampler, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    } else {
+      glSamplerParameteri(sampler, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+      glSamplerParameteri(sampler, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    }
+    // the sampler overrides the anisotropy that the pool and loader set on mipmapped textures.
+    if (filter && mipmap) {
+      glSamplerParameterf(sampler, GL_TEXTURE_MAX_ANISOTROPY, aniso);
+    }
+  }
+}
+
+DrawModeSamplers::~DrawModeSamplers() {
+  glDeleteSamplers(16, m_samplers);
+}
+
+StreamRingBuffer::StreamRingBuffer(u32 size_bytes) : m_size(size_bytes) {
+  glGenBuffers(1, &m_buffer);
+  glBindBuffer(GL_COPY_WRITE_BUFFER, m_buffer);
+
+  BufferStorageProc buffer_storage = nullptr;
+  if ((GLVersion.major == 4 && GLVersion.minor >= 4) || GLVersion.major > 4 ||
+      SDL_GL_ExtensionSupported("GL_ARB_buffer_storage")) {
+    buffer_storage = (BufferStorageProc)SDL_GL_GetProcAddress("glBufferStorage");
+  }
+
+  if (buffer_storage) {
+    const GLbitfield flags = GL_MAP_WRITE_BIT | kMapPersistentBit | kMapCoherentBit;
+    buffer_storage(GL_COPY_WRITE_BUFFER, m_size, nullptr, flags);
+    m_mapped = (u8*)glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, m_size, flags);
+  }
+
+  if (!m_mapped) {
+    if (!buffer_storage) {
+      glBufferData(GL_COPY_WRITE_BUFFER, m_size, nullptr, GL_STREAM_DRAW);
+    }
+    lg::info("StreamRingBuffer: persistent mapping not available, using unsynchronized maps");
+  }
+  glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+StreamRingBuffer::~StreamRingBuffer() {
+  for (auto& range : m_in_flight) {
+    glDeleteSync(range.fence);
+  }
+  if (m_mapped) {
+    glBindBuffer(GL_COPY_WRITE_BUFFER, m_buffer);
+    glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+  }
+  glDeleteBuffers(1, &m_buffer);
+}
+
+/*!
+ * Wait for the GPU to finish with any in-flight range that overlaps [begin, end).
+ * The GPU finishes fences in order, so all older ranges are freed too.
+ */
+void StreamRingBuffer::wait_for_range(u32 begin, u32 end) {
+  int last_overlap = -1;
+  for (int i = 0; i < (int)m_in_flight.size(); i++) {
+    const auto& range = m_in_flight[i];
+    if (range.begin < end && begin < range.end) {
+      last_overlap = i;
+    }
+  }
+
+  if (last_overlap < 0) {
+    return;
+  }
+
+  m_wait_count++;
+  auto fence = m_in_flight[last_overlap].fence;
+  while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000) == GL_TIMEOUT_EXPIRED) {
+  }
+
+  for (int i = 0; i <= last_overlap; i++) {
+    glDeleteSync(m_in_flight.front().fence);
+    m_in_flight.pop_front();
+  }
+}
+
+u32 StreamRingBuffer::upload(const void* data, u32 size_bytes, u32 alignment, u32 reserve_bytes) {
+  u32 alloc_size = std::max(size_bytes, reserve_bytes);
+  ASSERT_MSG(alloc_size <= m_size, "StreamRingBuffer upload is larger than the whole buffer");
+
+  u32 offset = align_up(m_head, alignment);
+  if (offset + alloc_size > m_size) {
+    wrap();
+    offset = 0;
+  }
+
+  wait_for_range(offset, offset + alloc_size);
+
+  if (size_bytes) {
+    if (m_mapped) {
+      memcpy(m_mapped + offset, data, size_bytes);
+    } else {
+      glBindBuffer(GL_COPY_WRITE_BUFFER, m_buffer);
+      void* dst = glMapBufferRange(
+          GL_COPY_WRITE_BUFFER, offset, size_bytes,
+          GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+      memcpy(dst, data, size_bytes);
+      glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+      glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    }
+  }
+
+  m_head = offset + alloc_size;
+  return offset;
+}
+
+void StreamRingBuffer::reserve(u32 size_bytes) {
+  ASSERT_MSG(size_bytes <= m_size, "StreamRingBuffer reservation is larger than the whole buffer");
+  if (m_head + size_bytes > m_size) {
+    wrap();
+  }
+}
+
+/*!
+ * Go back to the start of the buffer. The data already written this frame must be fenced, in case
+ * we wrap all the way back to it.
+ */
+void StreamRingBuffer::wrap() {
+  fence();
+  m_head = 0;
+  m_pending_begin = 0;
+}
+
+void StreamRingBuffer::fence() {
+  if (m_head == m_pending_begin) {
+    return;
+  }
+  m_in_flight.push_back({m_pending_begin, m_head, glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0)});
+  m_pending_begin = m_head;
+}
+
+void GlStateCache::invalidate() {
+  for (auto& cap : m_caps) {
+    cap = -1;
+  }
+  m_program = kUnknown;
+  m_active_texture = kUnknown;
+  for (auto& tex : m_textures) {
+    tex = kUnknown;
+  }
+  for (auto& func : m_blend_func) {
+    func = kUnknown;
+  }
+  m_blend_equation = kUnknown;
+  m_blend_color_valid = false;
+  m_depth_func = kUnknown;
+  m_depth_mask = -1;
+  for (u32 unit = 0; unit < kMaxTextureUnits; unit++) {
+    if (m_samplers[unit]) {
+      glBindSampler(unit, 0);
+      m_samplers[unit] = 0;
+    }
+  }
+}
+
+int GlStateCache::cap_index(GLenum cap) {
+  switch (cap) {
+    case GL_BLEND:
+      return BLEND;
+    case GL_DEPTH_TEST:
+      return DEPTH_TEST;
+    case GL_CULL_FACE:
+      return CULL_FACE;
+    case GL_SCISSOR_TEST:
+      return SCISSOR_TEST;
+    case GL_STENCIL_TEST:
+      return STENCIL_TEST;
+    case GL_PRIMITIVE_RESTART:
+      return PRIMITIVE_RESTART;
+    default:
+      return -1;
+  }
+}
+
+void GlStateCache::set_enabled(GLenum cap, bool enabled) {
+  int idx = cap_index(cap);
+  if (idx >= 0 && filter(m_caps[idx] == (s8)enabled)) {
+    return;
+  }
+  if (idx >= 0) {
+    m_caps[idx] = enabled;
+  }
+  if (enabled) {
+    glEnable(cap);
+  } else {
+    glDisable(cap);
+  }
+}
+
+void GlStateCache::use_program(GLuint program) {
+  if (filter(m_program == program)) {
+    return;
+  }
+  m_program = program;
+  glUseProgram(program);
+}
+
+void GlStateCache::active_texture(GLenum unit) {
+  if (filter(m_active_texture == unit)) {
+    return;
+  }
+  m_active_texture = unit;
+  glActiveTexture(unit);
+}
+
+void GlStateCache::bind_texture(GLenum target, GLuint texture) {
+  u32 unit = m_active_texture - GL_TEXTURE0;
+  if (target != GL_TEXTURE_2D || unit >= kMaxTextureUnits) {
+    glBindTexture(target, texture);
+    return;
+  }
+  if (filter(m_textures[unit] == texture)) {
+    return;
+  }
+  m_textures[unit] = texture;
+  glBindTexture(target, texture);
+}
+
+void GlStateCache::bind_sampler(u32 unit, GLuint sampler) {
+  ASSERT(unit < kMaxTextureUnits);
+  if (filter(m_samplers[unit] == sampler)) {
+    return;
+  }
+  m_samplers[unit] = sampler;
+  glBindSampler(unit, sampler);
+}
+
+void GlStateCache::blend_func_separate(GLenum src_rgb,
+                                       GLenum dst_rgb,
+                                       GLenum src_alpha,
+                                       GLenum dst_alpha) {
+  if (filter(m_blend_func[0] == src_rgb && m_blend_func[1] == dst_rgb &&
+             m_blend_func[2] == src_alpha && m_blend_func[3] == dst_alpha)) {
+    return;
+  }
+  m_blend_func[0] = src_rgb;
+  m_blend_func[1] = dst_rgb;
+  m_blend_func[2] = src_alpha;
+  m_blend_func[3] = dst_alpha;
+  glBlendFuncSeparate(src_rgb, dst_rgb, src_alpha, dst_alpha);
+}
+
+void GlStateCache::blend_equation(GLenum mode) {
+  if (filter(m_blend_equation == mode)) {
+    return;
+  }
+  m_blend_equation = mode;
+  glBlendEquation(mode);
+}
+
+void GlStateCache::blend_color(float r, float g, float b, float a) {
+  if (filter(m_blend_color_valid && m_blend_color[0] == r && m_blend_color[1] == g &&
+             m_blend_color[2] == b && m_blend_color[3] == a)) {
+    return;
+  }
+  m_blend_color_valid = true;
+  m_blend_color[0] = r;
+  m_blend_color[1] = g;
+  m_blend_color[2] = b;
+  m_blend_color[3] = a;
+  glBlendColor(r, g, b, a);
+}
+
+void GlStateCache::depth_func(GLenum func) {
+  if (filter(m_depth_func == func)) {
+    return;
+  }
+  m_depth_func = func;
+  glDepthFunc(func);
+}
+
+void GlStateCache::depth_mask(bool enabled) {
+  if (filter(m_depth_mask == (s8)enabled)) {
+    return;
+  }
+  m_depth_mask = enabled;
+  glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+}
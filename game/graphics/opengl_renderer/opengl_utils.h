@@ -1,5 +1,8 @@
 #pragma once
 
+#include <deque>
+#include <string>
+
 #include "common/math/Vector.h"
 
 #include "game/graphics/pipelines/opengl.h"
@@ -7,6 +10,12 @@
 struct SharedRenderState;
 class ScopedProfilerNode;
 
+/*!
+ * Name an OpenGL object, so graphics debuggers like RenderDoc show the name instead of a number.
+ * Does nothing if the driver doesn't have KHR_debug.
+ */
+void gl_label(GLenum identifier, GLuint object, const std::string& label);
+
 /*!
  * This is a wrapper around a framebuffer and texture to make it easier to render to a texture.
  */
@@ -52,6 +61,11 @@ class FullScreenDraw {
   FullScreenDraw(const FullScreenDraw&) = delete;
   FullScreenDraw& operator=(const FullScreenDraw&) = delete;
   void draw(const math::Vector4f& color, SharedRenderState* render_state, ScopedProfilerNode& prof);
+  // draw a texture over the whole viewport, with its color scaled by intensity.
+  void draw_texture(GLuint texture,
+                    float intensity,
+                    SharedRenderState* render_state,
+                    ScopedProfilerNode& prof);
 
  private:
   GLuint m_vao;
@@ -74,4 +88,153 @@ class FramebufferCopier {
  private:
   GLuint m_fbo = 0, m_fbo_texture = 0;
   int m_fbo_width = 640, m_fbo_height = 480;
-};
\ No newline at end of file
+};
+
+/*!
+ * Sampler objects for every combination of the wrap and filter settings a DrawMode can ask for.
+ * Binding one of these replaces the 4 glTexParameteri calls we used to make on every draw, and
+ * keeps the wrap/filter state out of the texture itself.
+ */
+class DrawModeSamplers {
+ public:
+  DrawModeSamplers();
+  ~DrawModeSamplers();
+  DrawModeSamplers(const DrawModeSamplers&) = delete;
+  DrawModeSamplers& operator=(const DrawModeSamplers&) = delete;
+
+  GLuint get(bool clamp_s, bool clamp_t, bool filter, bool mipmap) const {
+    return m_samplers[(clamp_s ? 1 : 0) | (clamp_t ? 2 : 0) | (filter ? 4 : 0) |
+                      (mipmap ? 8 : 0)];
+  }
+
+ private:
+  GLuint m_samplers[16];
+};
+
+/*!
+ * Ring buffer for streaming dynamic vertex, index, and uniform data to the GPU.
+ * If the driver supports persistent mapping (GL 4.4 or ARB_buffer_storage), the buffer is mapped
+ * once and written directly. Otherwise, each upload maps its range unsynchronized.
+ * In both cases, fences track the ranges that the GPU may still be reading, and we only wait if we
+ * wrap around into one of those.
+ *
+ * A fence only covers draws that were issued before it. If several uploads are used by the same
+ * draw, reserve them together first, so the ring can't wrap between them and overwrite the earlier
+ * ones before the draw is issued.
+ */
+class StreamRingBuffer {
+ public:
+  explicit StreamRingBuffer(u32 size_bytes);
+  ~StreamRingBuffer();
+  StreamRingBuffer(const StreamRingBuffer&) = delete;
+  StreamRingBuffer& operator=(const StreamRingBuffer&) = delete;
+
+  /*!
+   * Copy size_bytes of data to the ring and return its offset in buffer(). At least reserve_bytes
+   * are kept valid after the offset, for users that bind a fixed-size range.
+   */
+  u32 upload(const void* data, u32 size_bytes, u32 alignment, u32 reserve_bytes = 0);
+
+  /*!
+   * Make the next uploads contiguous, up to size_bytes in total. Each upload can add up to its
+   * alignment in padding, which must be included.
+   */
+  void reserve(u32 size_bytes);
+
+  /*!
+   * Mark all data uploaded so far as in use by the GPU. Call once per frame, after all draws.
+   */
+  void fence();
+
+  GLuint buffer() const { return m_buffer; }
+  bool persistent() const { return m_mapped != nullptr; }
+  u32 wait_count() const { return m_wait_count; }
+
+ private:
+  void wait_for_range(u32 begin, u32 end);
+  void wrap();
+
+  struct InFlightRange {
+    u32 begin, end;
+    GLsync fence;
+  };
+
+  GLuint m_buffer = 0;
+  u8* m_mapped = nullptr;
+  u32 m_size = 0;
+  u32 m_head = 0;
+  u32 m_pending_begin = 0;
+  u32 m_wait_count = 0;
+  std::deque<InFlightRange> m_in_flight;
+};
+
+/*!
+ * Cache of OpenGL state that skips calls that wouldn't change anything.
+ * Only renderers that go through the cache keep it up to date, so it's invalidated before every
+ * bucket renderer runs, and must be invalidated after calling code that sets state directly.
+ * Invalidating also unbinds samplers, so code that sets texture parameters directly still works.
+ * Caps and texture targets that aren't tracked are passed through to OpenGL.
+ */
+class GlStateCache {
+ public:
+  GlStateCache() { invalidate(); }
+  void invalidate();
+
+  void enable(GLenum cap) { set_enabled(cap, true); }
+  void disable(GLenum cap) { set_enabled(cap, false); }
+  void set_enabled(GLenum cap, bool enabled);
+  void use_program(GLuint program);
+  void active_texture(GLenum unit);
+  void bind_texture(GLenum target, GLuint texture);
+  void bind_sampler(u32 unit, GLuint sampler);
+  void blend_func(GLenum src, GLenum dst) { blend_func_separate(src, dst, src, dst); }
+  void blend_func_separate(GLenum src_rgb, GLenum dst_rgb, GLenum src_alpha, GLenum dst_alpha);
+  void blend_equation(GLenum mode);
+  void blend_color(float r, float g, float b, float a);
+  void depth_func(GLenum func);
+  void depth_mask(bool enabled);
+
+  struct Stats {
+    u32 calls = 0;
+    u32 filtered = 0;
+  };
+  const Stats& stats() const { return m_stats; }
+  void clear_stats() { m_stats = {}; }
+
+ private:
+  static constexpr int kMaxTextureUnits = 16;
+  static constexpr GLenum kUnknown = 0xffffffff;
+  bool filter(bool redundant) {
+    m_stats.calls++;
+    if (redundant) {
+      m_stats.filtered++;
+    }
+    return redundant;
+  }
+
+  enum Cap {
+    BLEND,
+    DEPTH_TEST,
+    CULL_FACE,
+    SCISSOR_TEST,
+    STENCIL_TEST,
+    PRIMITIVE_RESTART,
+    NUM_CAPS
+  };
+  static int cap_index(GLenum cap);
+
+  // -1 if unknown
+  s8 m_caps[NUM_CAPS];
+  GLuint m_program;
+  GLenum m_active_texture;
+  GLuint m_textures[kMaxTextureUnits];
+  // samplers are only bound through the cache, so these are always known.
+  GLuint m_samplers[kMaxTextureUnits] = {};
+  GLenum m_blend_func[4];
+  GLenum m_blend_equation;
+  float m_blend_color[4];
+  bool m_blend_color_valid;
+  GLenum m_depth_func;
+  s8 m_depth_mask;
+  Stats m_stats;
+};
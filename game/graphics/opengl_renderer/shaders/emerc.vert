@@ -7,6 +7,7 @@ layout (location = 2) in vec3 weights_in;
 layout (location = 3) in vec2 st_in;
 layout (location = 4) in vec3 rgba;
 layout (location = 5) in uvec3 mats;
+layout (location = 6) in uint first_bone;  // per-instance: base instance of the draw
 
 // camera control
 uniform vec4 hvdf_offset;
@@ -28,8 +29,9 @@ struct MercMatrixData {
   vec4 pad;
 };
 
-layout (std140, binding = 1) uniform ub_bones {
-  MercMatrixData bones[128];
+// bones for all draws in this flush
+layout (std430, binding = 1) readonly buffer ssbo_bones {
+  MercMatrixData bones[];
 };
 
 
@@ -37,17 +39,17 @@ void main() {
 
 
   vec4 p = vec4(position_in, 1);
-  vec4 vtx_pos = -bones[mats[0]].X * p * weights_in[0];
-  vec3 rotated_nrm = bones[mats[0]].R * normal_in * weights_in[0];
+  vec4 vtx_pos = -bones[first_bone + mats[0]].X * p * weights_in[0];
+  vec3 rotated_nrm = bones[first_bone + mats[0]].R * normal_in * weights_in[0];
 
   // game may send garbage bones if the weight is 0, don't let NaNs sneak in.
   if (weights_in[1] > 0) {
-    vtx_pos += -bones[mats[1]].X * p * weights_in[1];
-    rotated_nrm += bones[mats[1]].R * normal_in * weights_in[1];
+    vtx_pos += -bones[first_bone + mats[1]].X * p * weights_in[1];
+    rotated_nrm += bones[first_bone + mats[1]].R * normal_in * weights_in[1];
   }
   if (weights_in[2] > 0) {
-    vtx_pos += -bones[mats[2]].X * p * weights_in[2];
-    rotated_nrm += bones[mats[2]].R * normal_in * weights_in[2];
+    vtx_pos += -bones[first_bone + mats[2]].X * p * weights_in[2];
+    rotated_nrm += bones[first_bone + mats[2]].R * normal_in * weights_in[2];
   }
 
   vec4 transformed = perspective_matrix * vtx_pos;
@@ -4,6 +4,7 @@ out vec4 color;
 in vec4 vtx_color;
 in vec2 vtx_st;
 in float fog;
+in vec2 env_st;
 
 
 uniform sampler2D tex_T0;
@@ -15,6 +16,11 @@ uniform int decal_enable;
 
 uniform int gfx_hack_no_tex;
 
+// envmap added in the same draw, see emerc.frag
+uniform int envmap;
+uniform vec4 fade;
+layout (binding = 1) uniform sampler2D tex_T1;
+
 void main() {
   if (gfx_hack_no_tex == 0) {
     vec4 T0 = texture(tex_T0, vtx_st);
@@ -37,4 +43,16 @@ void main() {
   }
 
    color.xyz = mix(color.xyz, fog_color.rgb, clamp(fog_color.a * fog, 0, 1));
+
+  if (envmap == 1) {
+    vec4 env = vec4(fade.rgb, 1);
+    if (gfx_hack_no_tex == 0) {
+      env *= texture(tex_T1, env_st) * 2;
+    }
+    // the second pass blends with (Cs - 0) * Ad + Cd, on top of this draw's clamped output.
+    env = clamp(env, 0, 1);
+    float base_alpha = clamp(color.a, 0, 1);
+    color.rgb = clamp(color.rgb, 0, 1) + env.rgb * base_alpha;
+    color.a = base_alpha + env.a * base_alpha;
+  }
 }
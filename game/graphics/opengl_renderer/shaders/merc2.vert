@@ -7,6 +7,7 @@ layout (location = 2) in vec3 weights_in;
 layout (location = 3) in vec2 st_in;
 layout (location = 4) in vec4 rgba;
 layout (location = 5) in uvec3 mats;
+layout (location = 6) in uint first_bone;  // per-instance: base instance of the draw
 
 // light control
 uniform vec3 light_dir0;
@@ -23,9 +24,13 @@ uniform vec4 fog_constants;
 
 uniform mat4 perspective_matrix;
 
+// envmap added in the same draw, see emerc.vert
+uniform int envmap;
+
 // output
 out vec4 vtx_color;
 out vec2 vtx_st;
+out vec2 env_st;
 
 out float fog;
 
@@ -35,8 +40,9 @@ struct MercMatrixData {
   vec4 pad;
 };
 
-layout (std140, binding = 1) uniform ub_bones {
-  MercMatrixData bones[128];
+// bones for all draws in this flush
+layout (std430, binding = 1) readonly buffer ssbo_bones {
+  MercMatrixData bones[];
 };
 
 
@@ -68,17 +74,17 @@ void main() {
   //  transformed += -hmat2 * position_in.z;
 
   vec4 p = vec4(position_in, 1);
-  vec4 vtx_pos = -bones[mats[0]].X * p * weights_in[0];
-  vec3 rotated_nrm = bones[mats[0]].R * normal_in * weights_in[0];
+  vec4 vtx_pos = -bones[first_bone + mats[0]].X * p * weights_in[0];
+  vec3 rotated_nrm = bones[first_bone + mats[0]].R * normal_in * weights_in[0];
 
   // game may send garbage bones if the weight is 0, don't let NaNs sneak in.
   if (weights_in[1] > 0) {
-    vtx_pos += -bones[mats[1]].X * p * weights_in[1];
-    rotated_nrm += bones[mats[1]].R * normal_in * weights_in[1];
+    vtx_pos += -bones[first_bone + mats[1]].X * p * weights_in[1];
+    rotated_nrm += bones[first_bone + mats[1]].R * normal_in * weights_in[1];
   }
   if (weights_in[2] > 0) {
-    vtx_pos += -bones[mats[2]].X * p * weights_in[2];
-    rotated_nrm += bones[mats[2]].R * normal_in * weights_in[2];
+    vtx_pos += -bones[first_bone + mats[2]].X * p * weights_in[2];
+    rotated_nrm += bones[first_bone + mats[2]].R * normal_in * weights_in[2];
   }
 
   vec4 transformed = perspective_matrix * vtx_pos;
@@ -97,6 +103,24 @@ void main() {
   float Q = fog_constants.x / transformed[3];
   fog = 255 - clamp(-transformed.w + hvdf_offset.w, fog_constants.y, fog_constants.z);
 
+  env_st = vec2(0);
+  if (envmap == 1) {
+    // same as emerc.vert
+    vec4 unperspect = vec4(1. / perspective_matrix[0][0],
+                           1. / perspective_matrix[1][1],
+                           0.5,
+                           1. / perspective_matrix[2][3]);
+    vec4 nrm = vec4(rotated_nrm, 1);
+    nrm.z -= 1;
+    vec4 view = transformed * unperspect;
+    view.z = view.w;
+    float q = dot(view.xyz, nrm.xyz) / nrm.z;
+    nrm = view + nrm * q;
+    nrm = vec4(unperspect.z, unperspect.z, unperspect.z, unperspect.z + 1.)
+        + nrm * (unperspect.z / length(nrm.xyz));
+    env_st = vec2(1) - nrm.xy;
+  }
+
   transformed.xyz *= Q;
   transformed.xyz += hvdf_offset.xyz;
   transformed.xy -= (2048.);
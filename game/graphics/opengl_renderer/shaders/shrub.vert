@@ -4,6 +4,8 @@ layout (location = 0) in vec3 position_in;
 layout (location = 1) in vec3 tex_coord_in;
 layout (location = 2) in vec3 rgba_base;
 layout (location = 3) in int time_of_day_index;
+// per-instance transform from the prototype to the world
+layout (location = 4) in mat4 instance_matrix;
 
 uniform vec4 hvdf_offset;
 uniform mat4 camera;
@@ -31,12 +33,15 @@ void main() {
   // gs is 12.4 fixed point, set up with 2048.0 as the center.
 
   // the itof0 is done in the preprocessing step.  now we have floats.
-  
+
+  // instance transform. This used to be done when unpacking the level.
+  vec3 world_pos = (instance_matrix * vec4(position_in, 1)).xyz;
+
   // Step 3, the camera transform
   vec4 transformed = -camera[3];
-  transformed -= camera[0] * position_in.x;
-  transformed -= camera[1] * position_in.y;
-  transformed -= camera[2] * position_in.z;
+  transformed -= camera[0] * world_pos.x;
+  transformed -= camera[1] * world_pos.y;
+  transformed -= camera[2] * world_pos.z;
 
   // compute Q
   float Q = fog_constant / transformed.w;
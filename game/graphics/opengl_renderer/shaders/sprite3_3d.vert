@@ -72,7 +72,9 @@ void main() {
   float sx = xyz_sx.w;
   float sy = quat_sy.w;
   fragment_color = rgba;
-  uint vert_id = tex_info_in.z;
+  // each sprite is an instance, drawn as a 4 vertex strip.
+  const uint corner_for_vertex[4] = uint[4](0u, 1u, 3u, 2u);
+  uint vert_id = corner_for_vertex[gl_VertexID];
   uint rendermode = tex_info_in.w; // 2D, HUD, 3D
   vec3 quat = quat_sy.xyz;
   uint matrix = flags_matrix.y;
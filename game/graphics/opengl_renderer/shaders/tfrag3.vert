@@ -6,6 +6,10 @@ layout (location = 2) in int time_of_day_index;
 
 uniform vec4 hvdf_offset;
 uniform mat4 camera;
+// tie wind on the GPU: the camera matrix comes from the tie_wind compute shader instead.
+uniform int use_wind_camera;
+uniform int wind_instance;
+layout (std430, binding = 5) readonly buffer ssbo_wind_cameras { mat4 wind_cameras[]; };
 uniform float fog_constant;
 uniform float fog_min;
 uniform float fog_max;
@@ -33,10 +37,14 @@ void main() {
   // the itof0 is done in the preprocessing step.  now we have floats.
 
   // Step 3, the camera transform
-  vec4 transformed = -camera[3];
-  transformed -= camera[0] * position_in.x;
-  transformed -= camera[1] * position_in.y;
-  transformed -= camera[2] * position_in.z;
+  mat4 cam = camera;
+  if (use_wind_camera != 0) {
+    cam = wind_cameras[wind_instance];
+  }
+  vec4 transformed = -cam[3];
+  transformed -= cam[0] * position_in.x;
+  transformed -= cam[1] * position_in.y;
+  transformed -= cam[2] * position_in.z;
 
   // compute Q
   float Q = fog_constant / transformed.w;
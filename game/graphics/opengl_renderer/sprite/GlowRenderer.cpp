@@ -1,5 +1,7 @@
 #include "GlowRenderer.h"
 
+#include <algorithm>
+
 #include "third-party/imgui/imgui.h"
 
 /*
@@ -34,8 +36,10 @@
  *   draw. But the alpha of the entire first draw is constant, and we can figure it out in the
  *   vertex shader, so there's no need to do this approach.
  *
+ * - The final draws are additive with no depth test, so their order doesn't matter. They are
+ *   sorted by texture and draw mode, and each group is drawn with a single draw call.
+ *
  * there are a few remaining improvements that could be made:
- *   - The final draws could be bucketed, this would reduce draw calls by a lot.
  *   - The depth buffer copy could likely be eliminated.
  *   - There's a possibility that overlapping probes do the "wrong" thing. This could be solved by
  *     copying from the depth buffer to the grid, then drawing probes on the grid. Currently the
@@ -46,7 +50,8 @@
 GlowRenderer::GlowRenderer() {
   m_vertex_buffer.resize(kMaxVertices);
   m_sprite_data_buffer.resize(kMaxSprites);
-  m_index_buffer.resize(kMaxIndices);
+  // extra room for the sorted copy of the final draw indices
+  m_index_buffer.resize(kMaxIndices + kMaxSprites * 5);
 
   // dynamic buffer: this will hold vertices that are generated by the game and updated each frame.
   // the most important optimization here is to have as few uploads as possible. The size of the
@@ -98,7 +103,8 @@ GlowRenderer::GlowRenderer() {
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glGenBuffers(1, &m_ogl.index_buffer);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ogl.index_buffer);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, kMaxIndices * sizeof(u32), nullptr, GL_STREAM_DRAW);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_index_buffer.size() * sizeof(u32), nullptr,
+                 GL_STREAM_DRAW);
     glBindVertexArray(0);
   }
 
@@ -494,6 +500,7 @@ void GlowRenderer::draw_debug_window() {
   ImGui::Checkbox("Show Copy", &m_debug.show_probe_copies);
   ImGui::SliderFloat("Boost Glow", &m_debug.glow_boost, 0, 10);
   ImGui::Text("Count: %d", m_debug.num_sprites);
+  ImGui::Text("Batches: %d", (int)m_sprite_batches.size());
 }
 
 /*!
@@ -645,6 +652,7 @@ void GlowRenderer::flush(SharedRenderState* render_state, ScopedProfilerNode& pr
   for (u32 sidx = 0; sidx < m_next_sprite; sidx++) {
     add_sprite_pass_3(m_sprite_data_buffer[sidx], sidx);
   }
+  build_sprite_batches();
 
   // draw probes
   draw_probes(render_state, prof, probe_idx_start, copy_idx_start);
@@ -669,6 +677,36 @@ void GlowRenderer::flush(SharedRenderState* render_state, ScopedProfilerNode& pr
   glBindFramebuffer(GL_FRAMEBUFFER, render_state->render_fb);
 }
 
+/*!
+ * Sort the final draws by texture and draw mode, and copy their indices so each group is
+ * contiguous. Must be called before the index buffer is uploaded.
+ */
+void GlowRenderer::build_sprite_batches() {
+  m_sprite_batches.clear();
+  for (u32 i = 0; i < m_next_sprite; i++) {
+    m_sprite_order[i] = i;
+  }
+  std::sort(m_sprite_order.begin(), m_sprite_order.begin() + m_next_sprite, [&](u32 a, u32 b) {
+    const auto& ra = m_sprite_records[a];
+    const auto& rb = m_sprite_records[b];
+    if (ra.tbp != rb.tbp) {
+      return ra.tbp < rb.tbp;
+    }
+    return ra.draw_mode.as_int() < rb.draw_mode.as_int();
+  });
+
+  for (u32 i = 0; i < m_next_sprite; i++) {
+    const auto& record = m_sprite_records[m_sprite_order[i]];
+    if (m_sprite_batches.empty() || m_sprite_batches.back().tbp != record.tbp ||
+        m_sprite_batches.back().draw_mode.as_int() != record.draw_mode.as_int()) {
+      m_sprite_batches.push_back({record.tbp, record.draw_mode, m_next_index, 0});
+    }
+    m_sprite_batches.back().num_sprites++;
+    u32* idx = alloc_index(5);
+    memcpy(idx, &m_index_buffer[record.idx], 5 * sizeof(u32));
+  }
+}
+
 /*!
  * Final drawing of sprites.
  */
@@ -700,8 +738,7 @@ void GlowRenderer::draw_sprites(SharedRenderState* render_state, ScopedProfilerN
 
   glDepthMask(GL_FALSE);
 
-  for (u32 i = 0; i < m_next_sprite; i++) {
-    const auto& record = m_sprite_records[i];
+  for (const auto& record : m_sprite_batches) {
     auto tex = render_state->texture_pool->lookup(record.tbp);
     if (!tex) {
       fmt::print("Failed to find texture at {}, using random (glow)", record.tbp);
@@ -730,8 +767,9 @@ void GlowRenderer::draw_sprites(SharedRenderState* render_state, ScopedProfilerN
     }
 
     prof.add_draw_call();
-    prof.add_tri(2);
-    glDrawElements(GL_TRIANGLE_STRIP, 5, GL_UNSIGNED_INT, (void*)(record.idx * sizeof(u32)));
+    prof.add_tri(2 * record.num_sprites);
+    glDrawElements(GL_TRIANGLE_STRIP, 5 * record.num_sprites, GL_UNSIGNED_INT,
+                   (void*)(record.idx * sizeof(u32)));
   }
   glEnable(GL_DEPTH_TEST);
 }
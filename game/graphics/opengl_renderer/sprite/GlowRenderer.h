@@ -55,6 +55,7 @@ class GlowRenderer {
                                u32 idx_end);
   void downsample_chain(SharedRenderState* render_state, ScopedProfilerNode& prof, u32 num_sprites);
 
+  void build_sprite_batches();
   void draw_sprites(SharedRenderState* render_state, ScopedProfilerNode& prof);
 
   std::vector<Vertex> m_vertex_buffer;
@@ -113,4 +114,14 @@ class GlowRenderer {
   };
 
   std::array<SpriteRecord, kMaxSprites> m_sprite_records;
+
+  // final draws of sprites that share a texture and draw mode.
+  struct SpriteBatch {
+    u32 tbp;
+    DrawMode draw_mode;
+    u32 idx;
+    u32 num_sprites;
+  };
+  std::vector<SpriteBatch> m_sprite_batches;
+  std::array<u32, kMaxSprites> m_sprite_order;
 };
@@ -55,8 +55,8 @@ void Sprite3::opengl_setup_normal() {
   glGenVertexArrays(1, &m_ogl.vao);
   glBindVertexArray(m_ogl.vao);
   glBindBuffer(GL_ARRAY_BUFFER, m_ogl.vertex_buffer);
-  auto verts = SPRITE_RENDERER_MAX_SPRITES * 4;
-  auto bytes = verts * sizeof(SpriteVertex3D);
+  // there's one instance per sprite, and the vertex shader expands it to a quad.
+  auto bytes = SPRITE_RENDERER_MAX_SPRITES * sizeof(SpriteVertex3D);
   glBufferData(GL_ARRAY_BUFFER, bytes, nullptr, GL_STREAM_DRAW);
   glEnableVertexAttribArray(0);
   glVertexAttribPointer(
@@ -105,17 +105,14 @@ void Sprite3::opengl_setup_normal() {
       sizeof(SpriteVertex3D),                //
       (void*)offsetof(SpriteVertex3D, info)  // offset in array (why is this a pointer...)
   );
+  for (int i = 0; i < 5; i++) {
+    glVertexAttribDivisor(i, 1);
+  }
   glBindBuffer(GL_ARRAY_BUFFER, 0);
 
-  u32 idx_buffer_len = SPRITE_RENDERER_MAX_SPRITES * 5;
-  glGenBuffers(1, &m_ogl.index_buffer);
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ogl.index_buffer);
-  glBufferData(GL_ELEMENT_ARRAY_BUFFER, idx_buffer_len * sizeof(u32), nullptr, GL_STREAM_DRAW);
-
   glBindVertexArray(0);
 
-  m_vertices_3d.resize(verts);
-  m_index_buffer_data.resize(idx_buffer_len);
+  m_vertices_3d.resize(SPRITE_RENDERER_MAX_SPRITES);
 
   m_default_mode.disable_depth_write();
   m_default_mode.set_depth_test(GsTest::ZTest::GEQUAL);
@@ -302,6 +299,8 @@ bool Sprite3::render_direct(DmaFollower& dma,
                         direct_data.size_bytes, render_state, prof);
   }
   m_direct.flush_pending(render_state, prof);
+  // the direct renderer doesn't use the state cache.
+  render_state->gl_state.invalidate();
 
   // if sprites are off, after all the directrenderer dma, there is nothing left and we must exit
   if (dma.current_tag_offset() == render_state->next_bucket) {
@@ -453,9 +452,9 @@ void Sprite3::render_jak2(DmaFollower& dma,
     ASSERT(nop_flushe.vifcode1().kind == VifCode::Kind::FLUSHE);
   }
 
-  glEnable(GL_BLEND);
-  glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-  glBlendEquation(GL_FUNC_ADD);
+  render_state->gl_state.enable(GL_BLEND);
+  render_state->gl_state.blend_func(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  render_state->gl_state.blend_equation(GL_FUNC_ADD);
 
   {
     auto p = prof.make_scoped_child("glow");
@@ -531,9 +530,9 @@ void Sprite3::render_jak1(DmaFollower& dma,
     flush_sprites(render_state, prof, true);
   }
 
-  glEnable(GL_BLEND);
-  glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-  glBlendEquation(GL_FUNC_ADD);
+  render_state->gl_state.enable(GL_BLEND);
+  render_state->gl_state.blend_func(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  render_state->gl_state.blend_equation(GL_FUNC_ADD);
 
   // TODO finish this up.
   // fmt::print("next bucket is 0x{}\n", render_state->next_bucket);
@@ -575,25 +574,19 @@ void Sprite3::flush_sprites(SharedRenderState* render_state,
                             bool double_draw) {
   glBindVertexArray(m_ogl.vao);
 
-  glEnable(GL_PRIMITIVE_RESTART);
-  glPrimitiveRestartIndex(UINT32_MAX);
-
-  // upload vertex buffer
-  glBindBuffer(GL_ARRAY_BUFFER, m_ogl.vertex_buffer);
-  glBufferData(GL_ARRAY_BUFFER, m_sprite_idx * sizeof(SpriteVertex3D) * 4, m_vertices_3d.data(),
-               GL_STREAM_DRAW);
-
-  // two passes through the buckets. first to build the index buffer
-  u32 idx_offset = 0;
+  // two passes through the buckets. first to sort the sprites by bucket, so each bucket is a
+  // contiguous range of instances.
+  u32 instance_offset = 0;
   for (const auto bucket : m_bucket_list) {
-    memcpy(&m_index_buffer_data[idx_offset], bucket->ids.data(), bucket->ids.size() * sizeof(u32));
-    bucket->offset_in_idx_buffer = idx_offset;
-    idx_offset += bucket->ids.size();
+    memcpy(&m_vertices_3d[instance_offset], bucket->sprites.data(),
+           bucket->sprites.size() * sizeof(SpriteVertex3D));
+    bucket->first_instance = instance_offset;
+    instance_offset += bucket->sprites.size();
   }
 
   // now upload it
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ogl.index_buffer);
-  glBufferData(GL_ELEMENT_ARRAY_BUFFER, idx_offset * sizeof(u32), m_index_buffer_data.data(),
+  glBindBuffer(GL_ARRAY_BUFFER, m_ogl.vertex_buffer);
+  glBufferData(GL_ARRAY_BUFFER, instance_offset * sizeof(SpriteVertex3D), m_vertices_3d.data(),
                GL_STREAM_DRAW);
 
   // now do draws!
@@ -611,10 +604,10 @@ void Sprite3::flush_sprites(SharedRenderState* render_state,
     }
     ASSERT(tex);
 
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, *tex);
+    render_state->gl_state.active_texture(GL_TEXTURE0);
+    render_state->gl_state.bind_texture(GL_TEXTURE_2D, *tex);
 
-    auto settings = setup_opengl_from_draw_mode(mode, GL_TEXTURE0, false);
+    auto settings = setup_opengl_from_draw_mode(render_state, mode, GL_TEXTURE0, false);
 
     glUniform1f(glGetUniformLocation(render_state->shaders[ShaderId::SPRITE3].id(), "alpha_min"),
                 double_draw ? settings.aref_first : 0.016);
@@ -623,10 +616,10 @@ void Sprite3::flush_sprites(SharedRenderState* render_state,
     glUniform1i(glGetUniformLocation(render_state->shaders[ShaderId::SPRITE3].id(), "tex_T0"), 0);
 
     prof.add_draw_call();
-    prof.add_tri(2 * (bucket->ids.size() / 5));
+    prof.add_tri(2 * bucket->sprites.size());
 
-    glDrawElements(GL_TRIANGLE_STRIP, bucket->ids.size(), GL_UNSIGNED_INT,
-                   (void*)(bucket->offset_in_idx_buffer * sizeof(u32)));
+    glDrawArraysInstancedBaseInstance(GL_TRIANGLE_STRIP, 0, 4, bucket->sprites.size(),
+                                      bucket->first_instance);
 
     if (double_draw) {
       switch (settings.kind) {
@@ -634,16 +627,16 @@ void Sprite3::flush_sprites(SharedRenderState* render_state,
           break;
         case DoubleDrawKind::AFAIL_NO_DEPTH_WRITE:
           prof.add_draw_call();
-          prof.add_tri(2 * (bucket->ids.size() / 5));
+          prof.add_tri(2 * bucket->sprites.size());
           glUniform1f(
               glGetUniformLocation(render_state->shaders[ShaderId::SPRITE3].id(), "alpha_min"),
               -10.f);
           glUniform1f(
               glGetUniformLocation(render_state->shaders[ShaderId::SPRITE3].id(), "alpha_max"),
               settings.aref_second);
-          glDepthMask(GL_FALSE);
-          glDrawElements(GL_TRIANGLE_STRIP, bucket->ids.size(), GL_UNSIGNED_INT,
-                         (void*)(bucket->offset_in_idx_buffer * sizeof(u32)));
+          render_state->gl_state.depth_mask(false);
+          glDrawArraysInstancedBaseInstance(GL_TRIANGLE_STRIP, 0, 4, bucket->sprites.size(),
+                                            bucket->first_instance);
           break;
         default:
           ASSERT(false);
@@ -820,15 +813,7 @@ void Sprite3::do_block_common(SpriteMode mode,
         bucket = &it->second;
       }
     }
-    u32 start_vtx_id = m_sprite_idx * 4;
-    bucket->ids.push_back(start_vtx_id);
-    bucket->ids.push_back(start_vtx_id + 1);
-    bucket->ids.push_back(start_vtx_id + 2);
-    bucket->ids.push_back(start_vtx_id + 3);
-    bucket->ids.push_back(UINT32_MAX);
-
-    auto& vert1 = m_vertices_3d.at(start_vtx_id + 0);
-
+    auto& vert1 = bucket->sprites.emplace_back();
     vert1.xyz_sx = m_vec_data_2d[sprite_idx].xyz_sx;
     vert1.quat_sy = m_vec_data_2d[sprite_idx].flag_rot_sy;
     vert1.rgba = m_vec_data_2d[sprite_idx].rgba / 255;
@@ -836,17 +821,9 @@ void Sprite3::do_block_common(SpriteMode mode,
     vert1.flags_matrix[1] = m_vec_data_2d[sprite_idx].matrix();
     vert1.info[0] = 0;  // hack
     vert1.info[1] = m_current_mode.get_tcc_enable();
-    vert1.info[2] = 0;
+    vert1.info[2] = 0;  // corner, set by the vertex shader
     vert1.info[3] = mode;
 
-    m_vertices_3d.at(start_vtx_id + 1) = vert1;
-    m_vertices_3d.at(start_vtx_id + 2) = vert1;
-    m_vertices_3d.at(start_vtx_id + 3) = vert1;
-
-    m_vertices_3d.at(start_vtx_id + 1).info[2] = 1;
-    m_vertices_3d.at(start_vtx_id + 2).info[2] = 3;
-    m_vertices_3d.at(start_vtx_id + 3).info[2] = 2;
-
     ++m_sprite_idx;
   }
 }
@@ -184,20 +184,19 @@ class Sprite3 : public BucketRenderer {
   };
   static_assert(sizeof(SpriteVertex3D) == 64);
 
-  std::vector<SpriteVertex3D> m_vertices_3d;
+  std::vector<SpriteVertex3D> m_vertices_3d;  // one per sprite, sorted by bucket
 
   struct {
     GLuint vertex_buffer;
     GLuint vao;
-    GLuint index_buffer;
   } m_ogl;
 
   DrawMode m_current_mode, m_default_mode;
   u32 m_current_tbp = 0;
 
   struct Bucket {
-    std::vector<u32> ids;
-    u32 offset_in_idx_buffer = 0;
+    std::vector<SpriteVertex3D> sprites;
+    u32 first_instance = 0;
     u64 key = -1;
   };
 
@@ -208,6 +207,4 @@ class Sprite3 : public BucketRenderer {
   Bucket* m_last_bucket = nullptr;
 
   u64 m_sprite_idx = 0;
-
-  std::vector<u32> m_index_buffer_data;
 };
@@ -498,7 +498,7 @@ void Sprite3::distort_draw(SharedRenderState* render_state, ScopedProfilerNode&
   glBindVertexArray(m_distort_ogl.vao);
 
   // Enable prim restart, we need this to break up the triangle strips
-  glEnable(GL_PRIMITIVE_RESTART);
+  render_state->gl_state.enable(GL_PRIMITIVE_RESTART);
   glPrimitiveRestartIndex(UINT32_MAX);
 
   // Upload vertex data
@@ -611,13 +611,13 @@ void Sprite3::distort_draw_common(SharedRenderState* render_state, ScopedProfile
 
   // Set up OpenGL state
   m_current_mode.set_depth_write_enable(!m_sprite_distorter_setup.zbuf.zmsk());  // zbuf
-  glBindTexture(GL_TEXTURE_2D, m_distort_ogl.fbo_texture);                       // tex0
+  render_state->gl_state.bind_texture(GL_TEXTURE_2D, m_distort_ogl.fbo_texture);  // tex0
   m_current_mode.set_filt_enable(m_sprite_distorter_setup.tex1.mmag());          // tex1
   update_mode_from_alpha1(m_sprite_distorter_setup.alpha.data, m_current_mode);  // alpha1
   // note: clamp and miptbp are skipped since that is set up ahead of time with the distort
   // framebuffer texture
 
-  setup_opengl_from_draw_mode(m_current_mode, GL_TEXTURE0, false);
+  setup_opengl_from_draw_mode(render_state, m_current_mode, GL_TEXTURE0, false);
 }
 
 void Sprite3::distort_setup_framebuffer_dims(SharedRenderState* render_state) {
@@ -627,11 +627,11 @@ void Sprite3::distort_setup_framebuffer_dims(SharedRenderState* render_state) {
     m_distort_ogl.fbo_width = render_state->render_fb_w;
     m_distort_ogl.fbo_height = render_state->render_fb_h;
 
-    glBindTexture(GL_TEXTURE_2D, m_distort_ogl.fbo_texture);
+    render_state->gl_state.bind_texture(GL_TEXTURE_2D, m_distort_ogl.fbo_texture);
 
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, m_distort_ogl.fbo_width, m_distort_ogl.fbo_height, 0,
                  GL_RGB, GL_UNSIGNED_BYTE, NULL);
 
-    glBindTexture(GL_TEXTURE_2D, 0);
+    render_state->gl_state.bind_texture(GL_TEXTURE_2D, 0);
   }
 }
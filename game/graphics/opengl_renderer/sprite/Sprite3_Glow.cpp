@@ -228,4 +228,6 @@ void Sprite3::glow_dma_and_draw(DmaFollower& dma,
   }
 
   m_glow_renderer.flush(render_state, prof);
+  // the glow renderer doesn't use the state cache.
+  render_state->gl_state.invalidate();
 }
@@ -0,0 +1,65 @@
+#include "null.h"
+
+#include "common/dma/dma_chain_read.h"
+
+#include "game/system/benchmark.h"
+
+namespace {
+
+u32 g_frame_idx = 0;
+
+int null_init(GfxGlobalSettings&) {
+  g_frame_idx = 0;
+  return 0;
+}
+
+std::shared_ptr<GfxDisplay> null_make_display(int,
+                                              int,
+                                              const char*,
+                                              GfxGlobalSettings&,
+                                              GameVersion,
+                                              bool) {
+  return nullptr;
+}
+
+void null_exit() {}
+
+u32 null_vsync() {
+  return g_frame_idx++ & 1;
+}
+
+u32 null_sync_path() {
+  return 0;
+}
+
+void null_send_chain(const void* data, u32 offset) {
+  // this runs on the EE thread, but counts as render time.
+  benchmark::ScopedCpuTime cpu_time(benchmark::Counter::RENDER_ON_EE);
+  DmaFollower dma(data, offset);
+  while (!dma.ended()) {
+    dma.read_and_advance();
+  }
+}
+
+void null_texture_upload_now(const u8*, int, u32) {}
+void null_texture_relocate(u32, u32, u32) {}
+void null_set_levels(const std::vector<std::string>&) {}
+void null_set_pmode_alp(float) {}
+
+}  // namespace
+
+const GfxRendererModule gRendererNull = {
+    null_init,                // init
+    null_make_display,        // make_display
+    null_exit,                // exit
+    null_vsync,               // vsync
+    null_sync_path,           // sync_path
+    null_send_chain,          // send_chain
+    null_texture_upload_now,  // texture_upload_now
+    null_texture_relocate,    // texture_relocate
+    null_set_levels,          // set_levels
+    null_set_levels,          // prefetch_levels
+    null_set_pmode_alp,       // set_pmode_alp
+    GfxPipeline::Null,        // pipeline
+    "Null"                    // name
+};
@@ -0,0 +1,11 @@
+#pragma once
+
+/*!
+ * @file null.h
+ * A renderer that draws nothing, for running the game without a GPU. The DMA chain is still read
+ * from start to end each frame, and the game never waits for vsync.
+ */
+
+#include "game/graphics/gfx.h"
+
+extern const GfxRendererModule gRendererNull;
@@ -5,6 +5,7 @@
 
 #include "opengl.h"
 
+#include <atomic>
 #include <condition_variable>
 #include <memory>
 #include <mutex>
@@ -21,11 +22,14 @@
 
 #include "game/graphics/display.h"
 #include "game/graphics/gfx.h"
+#include "game/graphics/opengl_renderer/FrameCapture.h"
 #include "game/graphics/opengl_renderer/OpenGLRenderer.h"
+#include "game/graphics/opengl_renderer/RenderDoc.h"
 #include "game/graphics/opengl_renderer/debug_gui.h"
 #include "game/graphics/texture/TexturePool.h"
 #include "game/runtime.h"
 #include "game/sce/libscf.h"
+#include "game/system/benchmark.h"
 #include "game/system/hid/input_manager.h"
 #include "game/system/hid/sdl_util.h"
 
@@ -57,6 +61,18 @@ struct GraphicsData {
   bool has_data_to_render = false;
   FixedChunkDmaCopier dma_copier;
 
+  // pipelined dma transfer: the game copies the chain and doesn't wait for it to be rendered, so it
+  // can run the next frame while this one renders. Set from the debug menu by the render thread.
+  std::atomic<bool> pipelined_dma = false;
+  TripleBufferedDmaCopier pipelined_dma_copier;
+  bool last_chain_was_pipelined = false;
+
+  // input latency: the SDL timestamp of the newest input the game saw when its frame started, and
+  // of the one in the frame being rendered. A frame is only measured if it has new input.
+  u32 input_ticks_of_game_frame = 0;
+  u32 input_ticks_of_rendered_frame = 0;
+  u32 last_measured_input_ticks = 0;
+
   // texture pool
   std::shared_ptr<TexturePool> texture_pool;
 
@@ -66,17 +82,28 @@ struct GraphicsData {
   OpenGLRenderer ogl_renderer;
 
   OpenGlDebugGui debug_gui;
+  // GPU time of drawing ImGui, which is after the renderer's profiler is done.
+  GpuTimestamps imgui_gpu_timer{"GPU ImGui"};
 
   FrameLimiter frame_limiter;
   Timer engine_timer;
   double last_engine_time = 1. / 60.;
   float pmode_alp = 0.f;
 
+  // recording frames to replay with render_benchmark
+  FrameCaptureRecorder frame_capture;
+
+  // screenshot sequence capture
+  int sequence_frames_left = 0;
+  int sequence_frame_idx = 0;
+  std::string sequence_base_path;
+
   std::string imgui_log_filename, imgui_filename;
   GameVersion version;
 
   GraphicsData(GameVersion version)
       : dma_copier(EE_MAIN_MEM_SIZE),
+        pipelined_dma_copier(EE_MAIN_MEM_SIZE),
         texture_pool(std::make_shared<TexturePool>(version)),
         loader(std::make_shared<Loader>(
             file_util::get_jak_project_dir() / "out" / game_version_names[version] / "fr3",
@@ -249,6 +276,10 @@ static std::shared_ptr<GfxDisplay> gl_make_display(int width,
       auto p = scoped_prof("startup::sdl::gfx_data_init");
       g_gfx_data = std::make_unique<GraphicsData>(game_version);
     }
+    if (is_main) {
+      auto p = scoped_prof("startup::sdl::upload_thread_init");
+      g_gfx_data->loader->start_upload_thread(window);
+    }
     gl_inited = true;
     const char* gl_version = (const char*)glGetString(GL_VERSION);
     lg::info("OpenGL initialized - v{}.{} | Renderer: {}", GLVersion.major, GLVersion.minor,
@@ -308,6 +339,9 @@ GLDisplay::GLDisplay(SDL_Window* window, SDL_GLContext gl_context, bool is_main)
   m_input_manager->register_command(
       CommandBinding::Source::KEYBOARD,
       CommandBinding(SDLK_F2, [&]() { m_take_screenshot_next_frame = true; }));
+  m_input_manager->register_command(
+      CommandBinding::Source::KEYBOARD,
+      CommandBinding(SDLK_F3, [&]() { m_renderdoc_capture_next_frame = true; }));
 }
 
 GLDisplay::~GLDisplay() {
@@ -318,6 +352,10 @@ GLDisplay::~GLDisplay() {
   ImGui_ImplOpenGL3_Shutdown();
   ImGui_ImplSDL2_Shutdown();
   ImGui::DestroyContext();
+  if (m_main && g_gfx_data) {
+    g_gfx_data->loader->stop_upload_thread();
+    g_gfx_data->ogl_renderer.finish_screenshots();
+  }
   // Cleanup SDL
   SDL_GL_DeleteContext(m_gl_context);
   SDL_DestroyWindow(m_window);
@@ -337,17 +375,26 @@ void render_game_frame(int game_width,
                        bool take_screenshot) {
   // wait for a copied chain.
   bool got_chain = false;
+  bool pipelined = false;
   {
     auto p = scoped_prof("wait-for-dma");
     std::unique_lock<std::mutex> lock(g_gfx_data->dma_mutex);
     // note: there's a timeout here. If the engine is messed up and not sending us frames,
     // we still want to run the glfw loop.
-    got_chain = g_gfx_data->dma_cv.wait_for(lock, std::chrono::milliseconds(50),
-                                            [=] { return g_gfx_data->has_data_to_render; });
+    // the game may have sent a chain in either mode if the mode was just changed.
+    got_chain = g_gfx_data->dma_cv.wait_for(lock, std::chrono::milliseconds(50), [=] {
+      return g_gfx_data->has_data_to_render || g_gfx_data->pipelined_dma_copier.has_new_chain();
+    });
+    if (got_chain && !g_gfx_data->has_data_to_render) {
+      pipelined = g_gfx_data->pipelined_dma_copier.acquire();
+    }
   }
   // render that chain.
   if (got_chain) {
+    g_gfx_data->last_chain_was_pipelined = pipelined;
     g_gfx_data->frame_idx_of_input_data = g_gfx_data->frame_idx;
+    // with pipelined dma, this chain may be from the frame before, so the latency is a frame low.
+    g_gfx_data->input_ticks_of_rendered_frame = g_gfx_data->input_ticks_of_game_frame;
     RenderOptions options;
     options.game_res_w = game_width;
     options.game_res_h = game_height;
@@ -362,6 +409,9 @@ void render_game_frame(int game_width,
     options.draw_subtitle_editor_window = g_gfx_data->debug_gui.should_draw_subtitle_editor();
     options.draw_subtitle2_editor_window = g_gfx_data->debug_gui.should_draw_subtitle2_editor();
     options.draw_filters_window = g_gfx_data->debug_gui.should_draw_filters_menu();
+    options.debug_ui_skipped = !g_gfx_data->debug_gui.imgui_frame_started();
+    options.debug_ui_cpu_ms = g_gfx_data->debug_gui.imgui_cpu_ms;
+    options.debug_ui_gpu_ms = g_gfx_data->debug_gui.imgui_gpu_ms;
     options.save_screenshot = false;
     options.gpu_sync = g_gfx_data->debug_gui.should_gl_finish();
 
@@ -379,9 +429,20 @@ void render_game_frame(int game_width,
       options.screenshot_path = file_util::make_screenshot_filepath(
           g_game_version, g_gfx_data->debug_gui.screenshot_name());
     }
+    if (g_gfx_data->debug_gui.get_sequence_flag()) {
+      auto path = file_util::make_screenshot_filepath(g_game_version, "sequence");
+      g_gfx_data->sequence_base_path = path.substr(0, path.size() - 4);  // remove .png
+      g_gfx_data->sequence_frames_left = g_gfx_data->debug_gui.sequence_frames;
+      g_gfx_data->sequence_frame_idx = 0;
+    }
+    if (g_gfx_data->sequence_frames_left > 0) {
+      options.save_screenshot = true;
+      options.screenshot_path = fmt::format("{}_{:04d}.png", g_gfx_data->sequence_base_path,
+                                            g_gfx_data->sequence_frame_idx++);
+      g_gfx_data->sequence_frames_left--;
+    }
 
-    options.draw_small_profiler_window =
-        g_gfx_data->debug_gui.master_enable && g_gfx_data->debug_gui.small_profiler;
+    options.draw_small_profiler_window = g_gfx_data->debug_gui.should_draw_small_profiler();
     options.pmode_alp_register = g_gfx_data->pmode_alp;
 
     GLint msaa_max;
@@ -390,7 +451,32 @@ void render_game_frame(int game_width,
       options.msaa_samples = msaa_max;
     }
 
-    if constexpr (run_dma_copy) {
+    if (int frames = g_gfx_data->debug_gui.get_frame_capture_count();
+        frames > 0 && !g_gfx_data->frame_capture.active()) {
+      auto path = file_util::get_file_path(
+          {"captures", fmt::format("{}_{}.dma", version_to_game_name(g_game_version),
+                                   str_util::current_local_timestamp_no_colons())});
+      g_gfx_data->frame_capture.start(path, frames, g_game_version, options.game_res_w,
+                                      options.game_res_h, options.msaa_samples);
+    }
+    if (g_gfx_data->frame_capture.active()) {
+      // the game is waiting on us, so it's safe to copy the chain out of game memory.
+      // pipelined chains are already copied.
+      if (!run_dma_copy && !pipelined) {
+        g_gfx_data->dma_copier.run(g_gfx_data->dma_copier.get_last_input_data(),
+                                   g_gfx_data->dma_copier.get_last_input_offset());
+      }
+      g_gfx_data->frame_capture.add_frame(
+          g_gfx_data->loader->get_want_levels(), g_gfx_data->pmode_alp, *g_gfx_data->texture_pool,
+          pipelined ? g_gfx_data->pipelined_dma_copier.front() : g_gfx_data->dma_copier);
+    }
+
+    benchmark::ScopedCpuTime render_cpu_time(benchmark::Counter::RENDER);
+    if (pipelined) {
+      auto p = scoped_prof("ogl-render");
+      auto& chain = g_gfx_data->pipelined_dma_copier.front().get_last_result();
+      g_gfx_data->ogl_renderer.render(DmaFollower(chain.data.data(), chain.start_offset), options);
+    } else if constexpr (run_dma_copy) {
       auto& chain = g_gfx_data->dma_copier.get_last_result();
       g_gfx_data->ogl_renderer.render(DmaFollower(chain.data.data(), chain.start_offset), options);
     } else {
@@ -427,6 +513,21 @@ void update_global_profiler() {
     file_util::create_dir_if_needed_for_file(file_path);
     prof().dump_to_json(file_path.string());
   }
+
+  auto& debug_gui = g_gfx_data->debug_gui;
+  if (debug_gui.stream_events && !prof().streaming()) {
+    auto file_path =
+        file_util::get_jak_project_dir() / "profile_data" /
+        fmt::format("prof-stream-{}.json", str_util::current_local_timestamp_no_colons());
+    if (prof().start_streaming(file_path.string())) {
+      debug_gui.record_events = true;
+      prof().set_enable(true);
+    } else {
+      debug_gui.stream_events = false;
+    }
+  } else if (!debug_gui.stream_events && prof().streaming()) {
+    prof().stop_streaming();
+  }
 }
 
 void GLDisplay::process_sdl_events() {
@@ -466,20 +567,29 @@ void GLDisplay::render() {
   // Process SDL Events
   process_sdl_events();
 
-  // imgui start of frame
-  {
+  // imgui start of frame. If it's not updated this frame, the last frame's output is drawn again.
+  Timer imgui_timer;
+  float imgui_cpu_ms = 0;
+  g_gfx_data->debug_gui.master_enable = is_imgui_visible();
+  const bool imgui_update = g_gfx_data->debug_gui.start_imgui_frame();
+  if (imgui_update) {
     auto p = scoped_prof("imgui-new-frame");
     ImGui_ImplOpenGL3_NewFrame();
     ImGui_ImplSDL2_NewFrame();
     ImGui::NewFrame();
   }
+  imgui_cpu_ms += imgui_timer.getMs();
 
   // framebuffer size
   int fbuf_w, fbuf_h;
   SDL_GL_GetDrawableSize(m_window, &fbuf_w, &fbuf_h);
 
+  if (m_renderdoc_capture_next_frame || g_gfx_data->debug_gui.get_renderdoc_capture_flag()) {
+    m_renderdoc_capture_next_frame = false;
+    renderdoc::trigger_capture();
+  }
+
   // render game!
-  g_gfx_data->debug_gui.master_enable = is_imgui_visible();
   if (g_gfx_data->debug_gui.should_advance_frame()) {
     auto p = scoped_prof("game-render");
     int game_res_w = Gfx::g_global_settings.game_res_w;
@@ -501,19 +611,36 @@ void GLDisplay::render() {
   }
 
   // render debug
-  if (is_imgui_visible()) {
+  imgui_timer.start();
+  if (is_imgui_visible() && imgui_update) {
     auto p = scoped_prof("debug-gui");
-    g_gfx_data->debug_gui.draw(g_gfx_data->dma_copier.get_last_result().stats);
+    auto& copier = g_gfx_data->last_chain_was_pipelined ? g_gfx_data->pipelined_dma_copier.front()
+                                                        : g_gfx_data->dma_copier;
+    g_gfx_data->debug_gui.frame_pacing = g_gfx_data->frame_limiter.stats();
+    g_gfx_data->debug_gui.draw(copier.get_last_result().stats);
+    g_gfx_data->pipelined_dma = g_gfx_data->debug_gui.pipelined_dma;
   }
   {
     auto p = scoped_prof("imgui-render");
-    ImGui::Render();
-    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    auto& gpu_timer = g_gfx_data->imgui_gpu_timer;
+    int gpu_timer_idx = gpu_timer.begin("/imgui");
+    if (imgui_update) {
+      ImGui::Render();
+    }
+    ImDrawData* draw_data = ImGui::GetDrawData();
+    if (draw_data) {
+      ImGui_ImplOpenGL3_RenderDrawData(draw_data);
+    }
+    gpu_timer.end(gpu_timer_idx);
+    gpu_timer.next_frame();
+    g_gfx_data->debug_gui.imgui_gpu_ms = gpu_timer.get_duration("/imgui") * 1000;
   }
+  g_gfx_data->debug_gui.imgui_cpu_ms = imgui_cpu_ms + imgui_timer.getMs();
 
   // actual vsync
   g_gfx_data->debug_gui.finish_frame();
-  if (Gfx::g_global_settings.framelimiter) {
+  // benchmarks run as fast as they can.
+  if (Gfx::g_global_settings.framelimiter && !benchmark::active()) {
     auto p = scoped_prof("frame-limiter");
     g_gfx_data->frame_limiter.run(
         Gfx::g_global_settings.target_fps, Gfx::g_global_settings.experimental_accurate_lag,
@@ -529,20 +656,41 @@ void GLDisplay::render() {
   if (g_gfx_data->debug_gui.should_gl_finish()) {
     glFinish();
   }
+  g_gfx_data->frame_limiter.frame_presented();
+
+  // input-to-photon latency, as far as we can see it: from SDL getting the input to the swap of
+  // the first frame that used it. Without GLFinish, the driver may still be queueing the frame.
+  u32 input_ticks = g_gfx_data->input_ticks_of_rendered_frame;
+  if (input_ticks && input_ticks != g_gfx_data->last_measured_input_ticks) {
+    g_gfx_data->last_measured_input_ticks = input_ticks;
+    float latency_ms = SDL_GetTicks() - input_ticks;
+    PROF_PLOT("input-latency-ms", latency_ms);
+    g_gfx_data->debug_gui.record_input_latency(latency_ms);
+  }
 
   // switch vsync modes, if requested
-  if (Gfx::g_global_settings.vsync != Gfx::g_global_settings.old_vsync) {
-    Gfx::g_global_settings.old_vsync = Gfx::g_global_settings.vsync;
+  const bool vsync = Gfx::g_global_settings.vsync && !benchmark::active();
+  if (vsync != Gfx::g_global_settings.old_vsync) {
+    Gfx::g_global_settings.old_vsync = vsync;
     // NOTE - -1 can be used for adaptive vsync, maybe useful for Jak 2+?
     // https://wiki.libsdl.org/SDL2/SDL_GL_SetSwapInterval
-    SDL_GL_SetSwapInterval(Gfx::g_global_settings.vsync);
+    SDL_GL_SetSwapInterval(vsync);
   }
 
   // Start timing for the next frame.
   g_gfx_data->debug_gui.start_frame();
   prof().instant_event("ROOT");
+  PROF_FRAME_MARK("frame");
   update_global_profiler();
 
+  // get input that came in during the frame limiter and vsync, so the game frame starting now can
+  // use it. Otherwise it waits for the next frame.
+  if (Gfx::g_global_settings.sample_input_before_game_frame) {
+    auto p = scoped_prof("late-input-sample");
+    process_sdl_events();
+  }
+  g_gfx_data->input_ticks_of_game_frame = m_input_manager->get_last_input_ticks();
+
   // toggle even odd and wake up engine waiting on vsync.
   // TODO: we could play with moving this earlier, right after the final bucket renderer.
   //       it breaks the VIF-interrupt profiling though.
@@ -592,6 +740,7 @@ u32 gl_sync_path() {
   }
   std::unique_lock<std::mutex> lock(g_gfx_data->sync_mutex);
   g_gfx_data->last_engine_time = g_gfx_data->engine_timer.getSeconds();
+  // pipelined chains are never waited on.
   if (!g_gfx_data->has_data_to_render) {
     return 0;
   }
@@ -604,7 +753,13 @@ u32 gl_sync_path() {
  * Called from the game thread, on a GOAL stack.
  */
 void gl_send_chain(const void* data, u32 offset) {
-  if (g_gfx_data) {
+  if (g_gfx_data && g_gfx_data->pipelined_dma) {
+    // copy on the game thread, then hand it off. If the renderer hasn't picked up the previous
+    // chain yet, it is replaced. The lock is only for waking up the renderer.
+    g_gfx_data->pipelined_dma_copier.submit(data, offset);
+    std::unique_lock<std::mutex> lock(g_gfx_data->dma_mutex);
+    g_gfx_data->dma_cv.notify_all();
+  } else if (g_gfx_data) {
     std::unique_lock<std::mutex> lock(g_gfx_data->dma_mutex);
     if (g_gfx_data->has_data_to_render) {
       lg::error(
@@ -662,6 +817,10 @@ void gl_set_levels(const std::vector<std::string>& levels) {
   g_gfx_data->loader->set_want_levels(levels);
 }
 
+void gl_prefetch_levels(const std::vector<std::string>& levels) {
+  g_gfx_data->loader->set_prefetch_levels(levels);
+}
+
 void gl_set_pmode_alp(float val) {
   g_gfx_data->pmode_alp = val;
 }
@@ -676,6 +835,7 @@ const GfxRendererModule gRendererOpenGL = {
     gl_texture_upload_now,  // texture_upload_now
     gl_texture_relocate,    // texture_relocate
     gl_set_levels,          // set_levels
+    gl_prefetch_levels,     // prefetch_levels
     gl_set_pmode_alp,       // set_pmode_alp
     GfxPipeline::OpenGL,    // pipeline
     "OpenGL 4.3"            // name
@@ -34,6 +34,7 @@ class GLDisplay : public GfxDisplay {
 
   bool m_should_quit = false;
   bool m_take_screenshot_next_frame = false;
+  bool m_renderdoc_capture_next_frame = false;
   void process_sdl_events();
 
   struct DisplayState {
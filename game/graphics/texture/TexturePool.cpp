@@ -6,6 +6,7 @@
 #include "common/log/log.h"
 #include "common/util/Assert.h"
 #include "common/util/Timer.h"
+#include "common/util/crc32.h"
 
 #include "game/graphics/pipelines/opengl.h"
 #include "game/graphics/texture/jak1_tpage_dir.h"
@@ -53,6 +54,7 @@ u64 upload_to_gpu(const u8* data, u16 w, u16 h) {
 }
 
 GpuTexture* TexturePool::give_texture(const TextureInput& in) {
+  std::unique_lock<std::mutex> lk(m_mutex);
   // const auto& it = m_loaded_textures.find(in.name);
   const auto existing = m_loaded_textures.lookup_or_insert(in.id);
   if (!existing.second) {
@@ -96,18 +98,24 @@ void TexturePool::move_existing_to_vram(GpuTexture* tex, u32 slot_addr) {
   if (std::find(tex->slots.begin(), tex->slots.end(), slot_addr) == tex->slots.end()) {
     tex->slots.push_back(slot_addr);
   }
-  if (slot.source) {
-    if (slot.source == tex) {
-      // we already have it, no need to do anything
-    } else {
-      slot.source->remove_slot(slot_addr);
-      slot.source = tex;
-      slot.gpu_texture = tex->gpu_textures.front().gl;
-    }
-  } else {
-    slot.source = tex;
-    slot.gpu_texture = tex->gpu_textures.front().gl;
+  GpuTexture* old_source = slot.source.load(std::memory_order_relaxed);
+  if (old_source == tex) {
+    // we already have it, no need to do anything
+    return;
   }
+  if (old_source) {
+    old_source->remove_slot(slot_addr);
+  }
+  set_slot(slot, tex, tex->gpu_textures.front().gl);
+}
+
+/*!
+ * Point a VRAM slot at a texture. The texture is stored first, so lookups that see the new source
+ * also see its texture.
+ */
+void TexturePool::set_slot(TextureVRAMReference& slot, GpuTexture* source, GLuint gpu_texture) {
+  slot.gpu_texture.store(gpu_texture, std::memory_order_relaxed);
+  slot.source.store(source, std::memory_order_release);
 }
 
 void TexturePool::refresh_links(GpuTexture& texture) {
@@ -120,8 +128,15 @@ void TexturePool::refresh_links(GpuTexture& texture) {
     t.gpu_texture = tex_to_use;
   }
 
+  int mt4hh_count = m_mt4hh_count.load(std::memory_order_relaxed);
   for (auto slot : texture.mt4hh_slots) {
-    for (auto& tex : m_mt4hh_textures) {
+    for (int i = 0; i < mt4hh_count; i++) {
+      auto& tex = m_mt4hh_textures[i];
+      if (tex.slot == slot) {
+        tex.ref.gpu_texture = tex_to_use;
+      }
+    }
+    for (auto& tex : m_mt4hh_overflow) {
       if (tex.slot == slot) {
         tex.ref.gpu_texture = tex_to_use;
       }
@@ -130,6 +145,7 @@ void TexturePool::refresh_links(GpuTexture& texture) {
 }
 
 void TexturePool::unload_texture(PcTextureId tex_id, u64 gpu_id) {
+  std::unique_lock<std::mutex> lk(m_mutex);
   auto* tex = m_loaded_textures.lookup_existing(tex_id);
   ASSERT(tex);
   if (tex->is_common) {
@@ -197,6 +213,22 @@ void TexturePool::handle_upload_now(const u8* tpage, int mode, const u8* memory_
     return;
   }
 
+  // the header has the page id and destinations, and is followed by the texture pointers. The
+  // texture descriptions themselves don't change while the tpage is loaded.
+  u32 hash = crc32(tpage, sizeof(GoalTexturePage) + 4 * std::max(0, texture_page.length));
+  auto& cached = m_upload_cache[tpage - memory_base];
+  if (cached.hash == hash && cached.mode == mode && !cached.links.empty()) {
+    m_upload_cache_hits++;
+    for (auto& [id, slot] : cached.links) {
+      link_uploaded_texture(id, slot);
+    }
+    return;
+  }
+  m_upload_cache_misses++;
+  cached.hash = hash;
+  cached.mode = mode;
+  cached.links.clear();
+
   // loop over all texture in the tpage and download them.
   for (int tex_idx = 0; tex_idx < texture_page.length; tex_idx++) {
     GoalTexture tex;
@@ -211,21 +243,8 @@ void TexturePool::handle_upload_now(const u8* tpage, int mode, const u8* memory_
             *m_id_to_name.lookup_or_insert(current_id).first = name;
             m_name_to_id[name] = current_id;
           }
-
-          auto& slot = m_textures[tex.dest[mip_idx]];
-
-          if (slot.source) {
-            if (slot.source->tex_id == current_id) {
-              // we already have it, no need to do anything
-            } else {
-              slot.source->remove_slot(tex.dest[mip_idx]);
-              slot.source = get_gpu_texture_for_slot(current_id, tex.dest[mip_idx]);
-              ASSERT(slot.gpu_texture != (GLuint)-1);
-            }
-          } else {
-            slot.source = get_gpu_texture_for_slot(current_id, tex.dest[mip_idx]);
-            ASSERT(slot.gpu_texture != (GLuint)-1);
-          }
+          link_uploaded_texture(current_id, tex.dest[mip_idx]);
+          cached.links.emplace_back(current_id, tex.dest[mip_idx]);
         }
       }
     } else {
@@ -234,16 +253,68 @@ void TexturePool::handle_upload_now(const u8* tpage, int mode, const u8* memory_
   }
 }
 
+/*!
+ * Point a VRAM slot at the texture uploaded there by handle_upload_now.
+ */
+void TexturePool::link_uploaded_texture(PcTextureId id, u32 slot_addr) {
+  auto& slot = m_textures[slot_addr];
+  GpuTexture* old_source = slot.source.load(std::memory_order_relaxed);
+
+  if (old_source) {
+    if (old_source->tex_id == id) {
+      // we already have it, no need to do anything
+      return;
+    }
+    old_source->remove_slot(slot_addr);
+  }
+  // this sets the slot's texture, so it's ready before the source is published.
+  GpuTexture* source = get_gpu_texture_for_slot(id, slot_addr);
+  ASSERT(slot.gpu_texture != (GLuint)-1);
+  slot.source.store(source, std::memory_order_release);
+}
+
+void TexturePool::link_texture(PcTextureId id, u32 slot) {
+  std::unique_lock<std::mutex> lk(m_mutex);
+  link_uploaded_texture(id, slot);
+}
+
 void TexturePool::relocate(u32 destination, u32 source, u32 format) {
   std::unique_lock<std::mutex> lk(m_mutex);
   GpuTexture* src = lookup_gpu_texture(source);
   ASSERT(src);
   if (format == 44) {
-    m_mt4hh_textures.emplace_back();
-    m_mt4hh_textures.back().slot = destination;
-    m_mt4hh_textures.back().ref.source = src;
-    m_mt4hh_textures.back().ref.gpu_texture = src->gpu_textures.at(0).gl;
-    src->mt4hh_slots.push_back(destination);
+    int count = m_mt4hh_count.load(std::memory_order_relaxed);
+    int idx = 0;
+    while (idx < count && m_mt4hh_textures[idx].slot != destination) {
+      idx++;
+    }
+    if (idx < count) {
+      set_slot(m_mt4hh_textures[idx].ref, src, src->gpu_textures.at(0).gl);
+    } else if (count < MAX_MT4HH_TEXTURES) {
+      auto& tex = m_mt4hh_textures[count];
+      tex.slot = destination;
+      set_slot(tex.ref, src, src->gpu_textures.at(0).gl);
+      // lookups only read up to the count, so the entry is filled in before it's counted.
+      m_mt4hh_count.store(count + 1, std::memory_order_release);
+    } else {
+      auto it = std::find_if(m_mt4hh_overflow.begin(), m_mt4hh_overflow.end(),
+                             [&](const Mt4hhTexture& t) { return t.slot == destination; });
+      Mt4hhTexture* tex = it == m_mt4hh_overflow.end() ? nullptr : &*it;
+      if (!tex) {
+        if (m_mt4hh_overflow.empty()) {
+          lg::warn("More than {} mt4hh textures, the rest will be looked up with a lock",
+                   MAX_MT4HH_TEXTURES);
+        }
+        tex = &m_mt4hh_overflow.emplace_back();
+        tex->slot = destination;
+      }
+      set_slot(tex->ref, src, src->gpu_textures.at(0).gl);
+      m_mt4hh_overflowed.store(true, std::memory_order_release);
+    }
+    if (std::find(src->mt4hh_slots.begin(), src->mt4hh_slots.end(), destination) ==
+        src->mt4hh_slots.end()) {
+      src->mt4hh_slots.push_back(destination);
+    }
   } else {
     move_existing_to_vram(src, destination);
   }
@@ -270,10 +341,21 @@ GpuTexture* TexturePool::get_gpu_texture_for_slot(PcTextureId id, u32 slot) {
 }
 
 std::optional<u64> TexturePool::lookup_mt4hh(u32 location) {
-  for (auto& t : m_mt4hh_textures) {
+  int count = m_mt4hh_count.load(std::memory_order_acquire);
+  for (int i = 0; i < count; i++) {
+    auto& t = m_mt4hh_textures[i];
     if (t.slot == location) {
-      if (t.ref.source) {
-        return t.ref.gpu_texture;
+      if (t.ref.source.load(std::memory_order_acquire)) {
+        return t.ref.gpu_texture.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  if (m_mt4hh_overflowed.load(std::memory_order_acquire)) {
+    std::unique_lock<std::mutex> lk(m_mutex);
+    for (auto& t : m_mt4hh_overflow) {
+      if (t.slot == location && t.ref.source.load(std::memory_order_relaxed)) {
+        return t.ref.gpu_texture.load(std::memory_order_relaxed);
       }
     }
   }
@@ -316,21 +398,25 @@ void TexturePool::draw_debug_window() {
   int total_uploaded_textures = 0;
   ImGui::InputText("texture search", m_regex_input, sizeof(m_regex_input));
   bool use_regex = m_regex_input[0];
-  std::regex regex(use_regex ? m_regex_input : ".*");
+  // only compile the regex if there is a search, this runs every frame the window is open.
+  std::regex regex;
+  if (use_regex) {
+    regex = std::regex(m_regex_input);
+  }
 
   for (size_t i = 0; i < m_textures.size(); i++) {
-    auto& record = m_textures[i];
+    GpuTexture* source = m_textures[i].source;
     total_textures++;
-    if (record.source) {
-      if (!use_regex || std::regex_search(get_debug_texture_name(record.source->tex_id), regex)) {
+    if (source) {
+      auto name = get_debug_texture_name(source->tex_id);
+      if (!use_regex || std::regex_search(name, regex)) {
         ImGui::PushID(id++);
-        draw_debug_for_tex(get_debug_texture_name(record.source->tex_id), record.source, i);
+        draw_debug_for_tex(name, source, i);
         ImGui::PopID();
         total_displayed_textures++;
       }
-      if (!record.source->gpu_textures.empty()) {
-        total_vram_bytes +=
-            record.source->w * record.source->h * 4;  // todo, if we support other formats
+      if (!source->gpu_textures.empty()) {
+        total_vram_bytes += source->w * source->h * 4;  // todo, if we support other formats
       }
 
       total_uploaded_textures++;
@@ -341,6 +427,7 @@ void TexturePool::draw_debug_window() {
   ImGui::Text("Total Textures: %d Uploaded: %d Shown: %d VRAM: %.3f MB", total_textures,
               total_uploaded_textures, total_displayed_textures,
               (float)total_vram_bytes / (1024 * 1024));
+  ImGui::Text("Upload cache: %d hits, %d misses", m_upload_cache_hits, m_upload_cache_misses);
 }
 
 void TexturePool::draw_debug_for_tex(const std::string& name, GpuTexture* tex, u32 slot) {
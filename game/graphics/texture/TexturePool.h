@@ -1,6 +1,8 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -195,10 +197,13 @@ struct GpuTexture {
  * If the source is nullptr, the game has not loaded anything to this address.
  * If the game has loaded something, but the loader hasn't loaded the converted texture, the
  * source will be non-null and the gpu_texture will be a placeholder that is safe to use.
+ *
+ * These are read by the renderers without locking, while the game thread changes them. Writers
+ * set gpu_texture before source, so a reader that sees a source also sees its texture.
  */
 struct TextureVRAMReference {
-  GLuint gpu_texture = -1;  // the OpenGL texture to use when rendering.
-  GpuTexture* source = nullptr;
+  std::atomic<GLuint> gpu_texture = -1;  // the OpenGL texture to use when rendering.
+  std::atomic<GpuTexture*> source = nullptr;
 };
 
 /*!
@@ -289,9 +294,10 @@ struct GoalTexturePage {
  * Moving textures around should be done with locking. (the game EE thread and the loader run
  * simultaneously)
  *
- * Lookups can be done without locking.
+ * Lookups can be done without locking, and never wait for the game to finish an upload.
  * It is safe for renderers to use textures without worrying about locking - OpenGL textures
- * themselves are only removed from the rendering thread.
+ * themselves are only removed from the rendering thread. The loader only takes the lock to link
+ * textures that it has already uploaded to the GPU.
  *
  * There could be races with the game doing texture uploads and doing texture lookups, but these
  * races are harmless. If there's an actual in-game race condition, the exact texture you get may be
@@ -314,14 +320,16 @@ class TexturePool {
    */
   std::optional<u64> lookup(u32 location) {
     auto& t = m_textures[location];
-    if (t.source) {
+    GpuTexture* source = t.source.load(std::memory_order_acquire);
+    if (source) {
+      GLuint gpu_texture = t.gpu_texture.load(std::memory_order_relaxed);
       if constexpr (EXTRA_TEX_DEBUG) {
-        if (t.source->is_placeholder) {
-          ASSERT(t.gpu_texture == m_placeholder_texture_id);
+        if (source->is_placeholder) {
+          ASSERT(gpu_texture == m_placeholder_texture_id);
         } else {
           bool fnd = false;
-          for (auto& tt : t.source->gpu_textures) {
-            if (tt.gl == t.gpu_texture) {
+          for (auto& tt : source->gpu_textures) {
+            if (tt.gl == gpu_texture) {
               fnd = true;
               break;
             }
@@ -329,7 +337,7 @@ class TexturePool {
           ASSERT(fnd);
         }
       }
-      return t.gpu_texture;
+      return gpu_texture;
     } else {
       return {};
     }
@@ -342,18 +350,23 @@ class TexturePool {
    * You should probably not use this to lookup textures that could be uploaded with
    * handle_upload_now.
    */
-  GpuTexture* lookup_gpu_texture(u32 location) { return m_textures[location].source; }
+  GpuTexture* lookup_gpu_texture(u32 location) {
+    return m_textures[location].source.load(std::memory_order_acquire);
+  }
   std::optional<u64> lookup_mt4hh(u32 location);
   u64 get_placeholder_texture() { return m_placeholder_texture_id; }
   void draw_debug_window();
   void relocate(u32 destination, u32 source, u32 format);
+  /*!
+   * Put a texture in a vram slot, like an upload would. Used to replay frame captures.
+   */
+  void link_texture(PcTextureId id, u32 slot);
   void draw_debug_for_tex(const std::string& name, GpuTexture* tex, u32 slot);
   const std::array<TextureVRAMReference, 1024 * 1024 * 4 / 256>& all_textures() const {
     return m_textures;
   }
   void move_existing_to_vram(GpuTexture* tex, u32 slot_addr);
 
-  std::mutex& mutex() { return m_mutex; }
   PcTextureId allocate_pc_port_texture(GameVersion version);
 
   std::string get_debug_texture_name(PcTextureId id);
@@ -361,14 +374,23 @@ class TexturePool {
  private:
   void refresh_links(GpuTexture& texture);
   GpuTexture* get_gpu_texture_for_slot(PcTextureId id, u32 slot);
+  void link_uploaded_texture(PcTextureId id, u32 slot);
+  void set_slot(TextureVRAMReference& slot, GpuTexture* source, GLuint gpu_texture);
 
   char m_regex_input[256] = "";
   std::array<TextureVRAMReference, 1024 * 1024 * 4 / 256> m_textures;
+  // textures relocated to mt4hh format. These are only ever added, so lookups can read the first
+  // m_mt4hh_count without locking. There are usually only a few of these, any more than fit in the
+  // array go in the overflow list, which is only used with the mutex held.
   struct Mt4hhTexture {
     TextureVRAMReference ref;
-    u32 slot;
+    std::atomic<u32> slot = 0;
   };
-  std::vector<Mt4hhTexture> m_mt4hh_textures;
+  static constexpr int MAX_MT4HH_TEXTURES = 64;
+  std::array<Mt4hhTexture, MAX_MT4HH_TEXTURES> m_mt4hh_textures;
+  std::atomic<int> m_mt4hh_count = 0;
+  std::deque<Mt4hhTexture> m_mt4hh_overflow;
+  std::atomic<bool> m_mt4hh_overflowed = false;
 
   std::vector<u32> m_placeholder_data;
   u64 m_placeholder_texture_id = 0;
@@ -383,5 +405,18 @@ class TexturePool {
   u32 m_next_pc_texture_to_allocate = 0;
   u32 m_tpage_dir_size = 0;
 
+  // The textures each handle_upload_now linked, by tpage address. The game uploads the same
+  // tpages over and over, so if the tpage header and texture list hash the same, we can relink
+  // the slots from here instead of reading every texture description again.
+  struct UploadCacheEntry {
+    u32 hash = 0;
+    int mode = 0;
+    std::vector<std::pair<PcTextureId, u32>> links;  // texture, vram slot
+  };
+  std::unordered_map<u32, UploadCacheEntry> m_upload_cache;
+  u32 m_upload_cache_hits = 0;
+  u32 m_upload_cache_misses = 0;
+
+  // held while the pool is changed. Lookups don't take it.
   std::mutex m_mutex;
 };
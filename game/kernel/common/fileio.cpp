@@ -4,6 +4,8 @@
 
 #include "common/common_types.h"
 #include "common/util/Assert.h"
+#include "common/util/FileUtil.h"
+#include "common/util/compress.h"
 
 #include "game/kernel/common/Ptr.h"
 #include "game/kernel/common/kmalloc.h"
@@ -272,6 +274,40 @@ s32 FileLength(char* filename) {
   }
 }
 
+/*!
+ * Like FileLoad, but for a file compressed with compression::compress_zstd. It's decompressed
+ * straight into the memory. Added in the PC port.
+ */
+static Ptr<u8> FileLoadCompressed(const char* name,
+                                  const fs::path& path,
+                                  Ptr<kheapinfo> heap,
+                                  Ptr<u8> memory,
+                                  u32 malloc_flags,
+                                  s32* size_out) {
+  auto data = file_util::read_binary_file(path);
+  s32 size = compression::zstd_decompressed_size(data.data(), data.size());
+  if (size <= 0) {
+    return Ptr<u8>(0);
+  }
+
+  if (memory.offset == 0) {
+    memory = kmalloc(heap, size + 0x40, malloc_flags, name);
+  }
+  if (memory.offset == 0) {
+    MsgErr("dkernel: mem full for file read: '%s' (%d bytes)\n", name, size);
+    return Ptr<u8>(0xfffffffd);
+  }
+
+  if (!compression::decompress_zstd_into(data.data(), data.size(), memory.c(), size)) {
+    MsgErr("dkernel: can't decompress file: '%s'\n", name);
+    return Ptr<u8>(0xfffffffb);
+  }
+  if (size_out) {
+    *size_out = size;
+  }
+  return memory;
+}
+
 /*!
  * Load a file into memory
  * @param name : file name
@@ -283,6 +319,12 @@ s32 FileLength(char* filename) {
  * DONE, EXACT
  */
 Ptr<u8> FileLoad(char* name, Ptr<kheapinfo> heap, Ptr<u8> memory, u32 malloc_flags, s32* size_out) {
+  // added: use a zstd compressed copy of the file, if there is one.
+  auto compressed_path = file_util::get_file_path({std::string(name) + ".zst"});
+  if (fs::exists(compressed_path)) {
+    return FileLoadCompressed(name, compressed_path, heap, memory, malloc_flags, size_out);
+  }
+
   s32 fd = sceOpen(name, SCE_RDONLY);
   if (fd < 0) {
     MsgErr("dkernel: file read !open \'%s\' (%d)\n", name, fd);
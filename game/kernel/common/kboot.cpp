@@ -1,6 +1,11 @@
 #include "kboot.h"
 
+#include <algorithm>
 #include <cstring>
+#include <vector>
+
+#include "common/global_profiler/GlobalProfiler.h"
+#include "common/log/log.h"
 
 // Set to 1 to kill GOAL kernel
 RuntimeExitStatus MasterExit;
@@ -25,6 +30,18 @@ char DebugBootMessage[64];
 // game configuration
 MasterConfig masterConfig;
 
+namespace {
+struct BootPhaseTime {
+  std::string name;
+  int depth = 0;
+  double ms = 0;
+};
+std::vector<BootPhaseTime> boot_phases;
+std::vector<BootPhaseTime> boot_objects;
+int boot_phase_depth = 0;
+bool boot_phases_logged = false;
+}  // namespace
+
 void kboot_init_globals_common() {
   MasterExit = RuntimeExitStatus::RUNNING;
   DiskBoot = 0;
@@ -34,4 +51,57 @@ void kboot_init_globals_common() {
   strcpy(DebugBootLevel, "#f");      // no specified level
   strcpy(DebugBootMessage, "play");  // play mode, the default retail mode
   memset(&masterConfig, 0, sizeof(MasterConfig));
+  boot_phases.clear();
+  boot_objects.clear();
+  boot_phase_depth = 0;
+  boot_phases_logged = false;
+}
+
+BootPhase::BootPhase(const char* name, bool object) : m_object(object) {
+  prof().begin_event(name);
+  if (boot_phases_logged) {
+    return;
+  }
+  // phases are listed in the order they start, so the slot is added now.
+  auto& list = object ? boot_objects : boot_phases;
+  m_index = list.size();
+  list.push_back({name, boot_phase_depth, 0});
+  if (!object) {
+    boot_phase_depth++;
+  }
+}
+
+BootPhase::~BootPhase() {
+  prof().end_event();
+  if (m_index < 0 || boot_phases_logged) {
+    return;
+  }
+  (m_object ? boot_objects : boot_phases).at(m_index).ms = m_timer.getMs();
+  if (!m_object) {
+    boot_phase_depth--;
+  }
+}
+
+void log_boot_phases() {
+  lg::info("Boot phases:");
+  for (auto& phase : boot_phases) {
+    lg::info("  {:<40} {:8.2f} ms", std::string(2 * phase.depth, ' ') + phase.name, phase.ms);
+  }
+
+  if (!boot_objects.empty()) {
+    double total_ms = 0;
+    for (auto& obj : boot_objects) {
+      total_ms += obj.ms;
+    }
+    lg::info("  {} objects linked in {:.2f} ms. Slowest:", boot_objects.size(), total_ms);
+    std::sort(boot_objects.begin(), boot_objects.end(),
+              [](const BootPhaseTime& a, const BootPhaseTime& b) { return a.ms > b.ms; });
+    for (size_t i = 0; i < std::min(boot_objects.size(), (size_t)10); i++) {
+      lg::info("    {:<38} {:8.2f} ms", boot_objects[i].name, boot_objects[i].ms);
+    }
+  }
+
+  boot_phases.clear();
+  boot_objects.clear();
+  boot_phases_logged = true;
 }
\ No newline at end of file
@@ -1,5 +1,8 @@
 #pragma once
+#include <string>
+
 #include "common/common_types.h"
+#include "common/util/Timer.h"
 
 #define GAME_TERRITORY_SCEA 0  // sony america
 #define GAME_TERRITORY_SCEE 1  // sony europe
@@ -57,4 +60,27 @@ extern MasterConfig masterConfig;
 /*!
  * Initialize global variables for kboot
  */
-void kboot_init_globals_common();
\ No newline at end of file
+void kboot_init_globals_common();
+
+/*!
+ * Times a step of starting the runtime. Each one is a GlobalProfiler event. Until log_boot_phases
+ * is called, the durations are also kept for the summary it prints. Objects are listed separately,
+ * because there are hundreds of them.
+ */
+class BootPhase {
+ public:
+  explicit BootPhase(const char* name, bool object = false);
+  ~BootPhase();
+  BootPhase(const BootPhase&) = delete;
+  BootPhase& operator=(const BootPhase&) = delete;
+
+ private:
+  s64 m_index = -1;
+  bool m_object = false;
+  Timer m_timer;
+};
+
+/*!
+ * Print the times of the boot phases so far, and stop recording them.
+ */
+void log_boot_phases();
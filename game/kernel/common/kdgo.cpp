@@ -1,8 +1,16 @@
 #include "kdgo.h"
 
+#include <atomic>
+#include <condition_variable>
 #include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
 
+#include "common/goal_constants.h"
+#include "common/link_types.h"
 #include "common/log/log.h"
+#include "common/util/FileUtil.h"
 
 #include "game/common/dgo_rpc_types.h"
 #include "game/common/loader_rpc_types.h"
@@ -12,6 +20,7 @@
 #include "game/common/str_rpc_types.h"
 #include "game/kernel/common/Ptr.h"
 #include "game/kernel/common/kprint.h"
+#include "game/runtime.h"
 #include "game/sce/sif_ee.h"
 
 ee::sceSifClientData cd[6];  //! client data for each IOP Remove Procedure Call.
@@ -20,6 +29,255 @@ u16 x[8];                    //! stupid temporary for storing a message
 u32 sMsgNum;                 //! Toggle for double buffered message sending.
 RPC_Dgo_Cmd* sLastMsg;       //! Last DGO command sent to IOP
 RPC_Dgo_Cmd sMsg[2];         //! DGO message buffers
+bool g_direct_dgo_loads = true;
+
+namespace {
+/*!
+ * Serves the DGO RPC on the EE side, instead of sending it to the overlord. The overlord reads the
+ * DGO through the emulated ISO thread and copies it in small buffers. This reads each object from
+ * the file straight into EE memory, on a worker thread.
+ *
+ * The replies are the same as the overlord's. The first object goes to buffer1, and the objects
+ * after it alternate between buffer2 and buffer1. Each one is read ahead while the EE links the
+ * previous one. The last object goes to the heap top given by the final load-next. If the two
+ * buffers are the same (jak 2's single buffer loads), nothing is read ahead.
+ */
+class DirectDgoLoader {
+ public:
+  ~DirectDgoLoader() {
+    if (m_thread.joinable()) {
+      {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        m_quit = true;
+      }
+      m_cv.notify_all();
+      m_thread.join();
+    }
+    close();
+  }
+
+  /*!
+   * Start an RPC call. The reply is written to recv when busy() goes false.
+   */
+  void call(u32 fno, const void* send, s32 send_size, void* recv) {
+    Call c;
+    c.fno = fno;
+    memset(&c.cmd, 0, sizeof(c.cmd));
+    memcpy(&c.cmd, send, std::min(send_size, (s32)sizeof(c.cmd)));
+    c.recv = recv;
+
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (!m_thread.joinable()) {
+      m_thread = std::thread([this]() { worker(); });
+    }
+    m_pending++;
+    m_calls.push_back(c);
+    m_cv.notify_all();
+  }
+
+  bool busy() const { return m_pending.load(std::memory_order_acquire) != 0; }
+
+  /*!
+   * Wait for any reads, and forget about the current DGO.
+   */
+  void reset() {
+    std::unique_lock<std::mutex> lk(m_mutex);
+    m_cv.wait(lk, [&]() { return m_calls.empty() && !m_working; });
+    close();
+  }
+
+ private:
+  struct Call {
+    u32 fno;
+    RPC_Dgo_Cmd cmd;
+    void* recv;
+  };
+
+  void worker() {
+    std::unique_lock<std::mutex> lk(m_mutex);
+    while (true) {
+      m_cv.wait(lk, [&]() { return m_quit || !m_calls.empty(); });
+      if (m_quit) {
+        return;
+      }
+      Call c = m_calls.front();
+      m_calls.pop_front();
+      m_working = true;
+      lk.unlock();
+      run(c);
+      lk.lock();
+      m_working = false;
+      m_cv.notify_all();
+    }
+  }
+
+  void run(Call& c) {
+    bool read_ahead = false;
+    switch (c.fno) {
+      case DGO_RPC_LOAD_FNO:
+        read_ahead = load(&c.cmd);
+        break;
+      case DGO_RPC_LOAD_NEXT_FNO:
+        read_ahead = load_next(&c.cmd);
+        break;
+      case DGO_RPC_CANCEL_FNO:
+        // like the overlord, the result is only set if there was something to cancel.
+        if (m_file) {
+          close();
+          c.cmd.result = DGO_RPC_RESULT_ABORTED;
+        }
+        break;
+      default:
+        c.cmd.result = DGO_RPC_RESULT_ERROR;
+        break;
+    }
+    memcpy(c.recv, &c.cmd, sizeof(c.cmd));
+    m_pending.fetch_sub(1, std::memory_order_release);
+
+    // the EE can link the object we just returned while we read the next one.
+    if (read_ahead) {
+      m_read_ahead_buffer = next_buffer();
+      m_read_ahead = read_object(m_read_ahead_buffer);
+      if (!m_read_ahead) {
+        lg::error("[Direct DGO] failed to read object {} of {}", m_objects_read, m_file_name);
+        close();
+      }
+    }
+  }
+
+  bool load(RPC_Dgo_Cmd* cmd) {
+    // a new load cancels the old one.
+    close();
+    m_file_name = cmd->name;
+    for (auto& ch : m_file_name) {
+      ch = toupper(ch);
+    }
+    auto path = file_util::get_jak_project_dir() / "out" / game_version_names[g_game_version] /
+                "iso" / m_file_name;
+    m_file = file_util::open_file(path, "rb");
+    DgoHeader header;
+    if (!m_file || fread(&header, sizeof(header), 1, m_file) != 1 || !header.object_count) {
+      lg::error("[Direct DGO] couldn't load dgo: {}", m_file_name);
+      cmd->result = DGO_RPC_RESULT_ERROR;
+      close();
+      return false;
+    }
+    lg::info("[Direct DGO] Got DGO file header for {} with {} objects", header.name,
+             header.object_count);
+    m_object_count = header.object_count;
+    m_objects_read = 0;
+    m_read_ahead = false;
+    m_buffer1 = cmd->buffer1;
+    m_buffer2 = cmd->buffer2;
+
+    if (m_object_count == 1) {
+      return finish(cmd, read_object(cmd->buffer_heap_top));
+    }
+    if (!read_object(m_buffer1)) {
+      return finish(cmd, false);
+    }
+    cmd->result = DGO_RPC_RESULT_MORE;
+    return can_read_ahead();
+  }
+
+  bool load_next(RPC_Dgo_Cmd* cmd) {
+    if (!m_file) {
+      cmd->result = DGO_RPC_RESULT_ERROR;
+      return false;
+    }
+    // jak 1's overlord ignores new buffers here.
+    if (g_game_version != GameVersion::Jak1) {
+      m_buffer1 = cmd->buffer1;
+      m_buffer2 = cmd->buffer2;
+    }
+
+    if (m_read_ahead) {
+      m_read_ahead = false;
+      cmd->buffer1 = m_read_ahead_buffer;
+    } else if (m_objects_read + 1 == m_object_count) {
+      return finish(cmd, read_object(cmd->buffer_heap_top));
+    } else {
+      u32 buffer = next_buffer();
+      if (!read_object(buffer)) {
+        return finish(cmd, false);
+      }
+      cmd->buffer1 = buffer;
+    }
+    cmd->result = DGO_RPC_RESULT_MORE;
+    return can_read_ahead();
+  }
+
+  /*!
+   * Reply for the last object, which was loaded to the heap top.
+   */
+  bool finish(RPC_Dgo_Cmd* cmd, bool ok) {
+    if (ok) {
+      cmd->result = DGO_RPC_RESULT_DONE;
+      cmd->buffer1 = cmd->buffer_heap_top;
+    } else {
+      lg::error("[Direct DGO] failed to read object {} of {}", m_objects_read, m_file_name);
+      cmd->result = DGO_RPC_RESULT_ERROR;
+    }
+    close();
+    return false;
+  }
+
+  // the last object waits for the heap top from the next load-next.
+  bool can_read_ahead() const {
+    return m_buffer1 != m_buffer2 && m_objects_read + 1 < m_object_count;
+  }
+
+  u32 next_buffer() const { return (m_objects_read & 1) ? m_buffer2 : m_buffer1; }
+
+  /*!
+   * Read the next object header and data to dest. The size is rounded up to 16 bytes, like the
+   * overlord.
+   */
+  bool read_object(u32 dest) {
+    ObjectHeader header;
+    if (fread(&header, sizeof(header), 1, m_file) != 1) {
+      return false;
+    }
+    u32 size = (header.size + 0xf) & ~0xf;
+    ASSERT((u64)dest + sizeof(header) + size <= EE_MAIN_MEM_SIZE);
+    memcpy(g_ee_main_mem + dest, &header, sizeof(header));
+    size_t got = fread(g_ee_main_mem + dest + sizeof(header), 1, size, m_file);
+    if (got < header.size) {
+      return false;
+    }
+    m_objects_read++;
+    return true;
+  }
+
+  void close() {
+    if (m_file) {
+      fclose(m_file);
+      m_file = nullptr;
+    }
+    m_read_ahead = false;
+  }
+
+  std::thread m_thread;
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::deque<Call> m_calls;
+  std::atomic<int> m_pending = 0;
+  bool m_working = false;
+  bool m_quit = false;
+
+  // only used by the worker (or when idle)
+  FILE* m_file = nullptr;
+  std::string m_file_name;
+  u32 m_object_count = 0;
+  u32 m_objects_read = 0;
+  u32 m_buffer1 = 0;
+  u32 m_buffer2 = 0;
+  bool m_read_ahead = false;
+  u32 m_read_ahead_buffer = 0;
+};
+
+DirectDgoLoader sDirectDgo;
+}  // namespace
 
 void kdgo_init_globals() {
   memset(x, 0, sizeof(x));
@@ -27,10 +285,12 @@ void kdgo_init_globals() {
   sShowStallMsg = 1;
   sLastMsg = nullptr;
   memset(sMsg, 0, sizeof(sMsg));
+  sDirectDgo.reset();
 }
 
 /*!
  * Call the given RPC with the given function number and buffers.
+ * DGO RPCs are served by the DirectDgoLoader if g_direct_dgo_loads is set.
  */
 s32 RpcCall(s32 rpcChannel,
             u32 fno,
@@ -39,6 +299,10 @@ s32 RpcCall(s32 rpcChannel,
             s32 sendSize,
             void* recvBuff,
             s32 recvSize) {
+  if (rpcChannel == DGO_RPC_CHANNEL && g_direct_dgo_loads) {
+    sDirectDgo.call(fno, sendBuff, sendSize, recvBuff);
+    return 0;
+  }
   return sceSifCallRpc(&cd[rpcChannel], fno, async, sendBuff, sendSize, recvBuff, recvSize, nullptr,
                        nullptr);
 }
@@ -68,14 +332,17 @@ u64 RpcCall_wrapper(void* _args) {
   auto send_size = args->get_as<s32>(4);
   auto recv_buff = args->get_as<u64>(5);
   auto recv_size = args->get_as<s32>(6);
-  return sceSifCallRpc(&cd[rpcChannel], fno, async, Ptr<u8>(send_buff).c(), send_size,
-                       Ptr<u8>(recv_buff).c(), recv_size, nullptr, nullptr);
+  return RpcCall(rpcChannel, fno, async, Ptr<u8>(send_buff).c(), send_size,
+                 Ptr<u8>(recv_buff).c(), recv_size);
 }
 
 /*!
  * Check if the given RPC is busy, by channel.
  */
 u32 RpcBusy(s32 channel) {
+  if (channel == DGO_RPC_CHANNEL && g_direct_dgo_loads) {
+    return sDirectDgo.busy();
+  }
   return sceSifCheckStatRpc(&cd[channel].rpcd);
 }
 
@@ -25,4 +25,6 @@ void StopIOP();
 
 extern u32 sShowStallMsg;
 extern RPC_Dgo_Cmd sMsg[2];
-extern RPC_Dgo_Cmd* sLastMsg;
\ No newline at end of file
+extern RPC_Dgo_Cmd* sLastMsg;
+// load DGOs on the EE instead of through the overlord.
+extern bool g_direct_dgo_loads;
\ No newline at end of file
@@ -15,6 +15,10 @@ constexpr int LINK_FLAG_PRINT_LOGIN = 0x8;  //! Note, doesn't actually do anythi
 constexpr int LINK_FLAG_FORCE_DEBUG = 0x10;
 constexpr int LINK_FLAG_FORCE_FAST_LINK = 0x20;
 
+// how long a single call to work may spend linking before it returns, so a streamed object
+// can't hitch a frame. The original game checked for 150000 cycles, which is 0.5 ms.
+constexpr double LINK_WORK_BUDGET_MS = 0.5;
+
 // only used in OpenGOAL
 struct SegmentInfo {
   uint32_t offset;
@@ -1,11 +1,14 @@
 #include "klisten.h"
 
+#include <cstdint>
 #include <cstdio>
 #include <cstring>
 
 #include "common/listener_common.h"
+#include "common/util/compress.h"
 
 #include "game/kernel/common/kdsnetm.h"
+#include "game/kernel/common/kmalloc.h"
 #include "game/kernel/common/kprint.h"
 #include "game/kernel/common/ksocket.h"
 
@@ -27,7 +30,7 @@ void ClearPending() {
     if (PrintPending.offset != 0) {
       auto size = strlen(PrintBufArea.cast<char>().c() + sizeof(ListenerMessageHeader));
       if (size > 0) {
-        printf("%s", PrintBufArea.cast<char>().c() + sizeof(ListenerMessageHeader));
+        g_stdout_writer.write(PrintBufArea.cast<char>().c() + sizeof(ListenerMessageHeader), size);
       }
       clear_print();
     }
@@ -84,3 +87,30 @@ void SendAck() {
                     strlen(AckBufArea + sizeof(ListenerMessageHeader)));
   }
 }
+
+/*!
+ * Copy the object file in a LTT_MSG_CODE message to a new block on the debug heap, so it can be
+ * linked. If the message is LTT_MSG_CODE_ZSTD, it's decompressed first. Returns a null pointer if
+ * that fails.
+ */
+Ptr<u8> CopyListenerCode(Ptr<char> msg, bool compressed) {
+  if (!compressed) {
+    auto buffer = kmalloc(kdebugheap, MessCount, 0, "listener-link-block");
+    memcpy(buffer.c(), msg.c(), MessCount);
+    return buffer;
+  }
+
+  size_t size = compression::zstd_decompressed_size(msg.c(), MessCount);
+  if (size == 0 || size > INT32_MAX) {
+    return Ptr<u8>(0);
+  }
+  auto buffer = kmalloc(kdebugheap, size, 0, "listener-link-block");
+  if (!buffer.offset) {
+    return buffer;
+  }
+  if (!compression::decompress_zstd_into(msg.c(), MessCount, buffer.c(), size)) {
+    kfree(buffer);
+    return Ptr<u8>(0);
+  }
+  return buffer;
+}
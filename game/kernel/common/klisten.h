@@ -9,4 +9,5 @@ extern u32 ListenerStatus;
 
 void klisten_init_globals();
 void ClearPending();
-void SendAck();
\ No newline at end of file
+void SendAck();
+Ptr<u8> CopyListenerCode(Ptr<char> msg, bool compressed);
\ No newline at end of file
@@ -21,6 +21,7 @@
 #include "game/graphics/gfx.h"
 #include "game/kernel/common/Ptr.h"
 #include "game/kernel/common/kernel_types.h"
+#include "game/kernel/common/kmalloc.h"
 #include "game/kernel/common/kprint.h"
 #include "game/kernel/common/kscheme.h"
 #include "game/mips2c/mips2c_table.h"
@@ -884,6 +885,22 @@ void pc_prof(u32 name, ProfNode::Kind kind) {
   prof().event(Ptr<String>(name).c()->data(), kind);
 }
 
+void pc_process_stats_begin(u32 name, u32 state) {
+  g_process_stats.begin(Ptr<String>(name).c()->data(), Ptr<String>(state).c()->data());
+}
+
+void pc_process_stats_end() {
+  g_process_stats.end();
+}
+
+void pc_kmalloc_stats_enable(u32 symptr) {
+  g_kmalloc_stats.set_enabled(symbol_to_bool(symptr));
+}
+
+void pc_kmalloc_stats_snapshot() {
+  g_kmalloc_stats.snapshot();
+}
+
 std::mt19937 extra_random_generator;
 u32 pc_rand() {
   return (u32)extra_random_generator();
@@ -980,6 +997,12 @@ void init_common_pc_port_functions(
 
   // profiler
   make_func_symbol_func("pc-prof", (void*)pc_prof);
+  // CPU time of each process and state, called by the process dispatch.
+  make_func_symbol_func("pc-process-stats-begin", (void*)pc_process_stats_begin);
+  make_func_symbol_func("pc-process-stats-end", (void*)pc_process_stats_end);
+  // kmalloc and process heap allocation stats, see KmallocStats.
+  make_func_symbol_func("pc-kmalloc-stats-enable", (void*)pc_kmalloc_stats_enable);
+  make_func_symbol_func("pc-kmalloc-stats-snapshot", (void*)pc_kmalloc_stats_snapshot);
 
   // RNG
   make_func_symbol_func("pc-rand", (void*)pc_rand);
@@ -1,22 +1,181 @@
 #include "kmalloc.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
 
 #include "common/goal_constants.h"
+#include "common/log/log.h"
+#include "common/util/FileUtil.h"
+#include "common/util/string_util.h"
 
 #include "game/kernel/common/kprint.h"
 #include "game/kernel/common/kscheme.h"
 #include "game/kernel/common/memory_layout.h"
 
+#include "third-party/fmt/core.h"
+#include "third-party/json.hpp"
+
 // global and debug kernel heaps
 Ptr<kheapinfo> kglobalheap;
 Ptr<kheapinfo> kdebugheap;
 
+KmallocStats g_kmalloc_stats;
+
 void kmalloc_init_globals_common() {
   // _globalheap and _debugheap
   kglobalheap.offset = GLOBAL_HEAP_INFO_ADDR;
   kdebugheap.offset = DEBUG_HEAP_INFO_ADDR;
+  g_kmalloc_stats.reset();
+}
+
+void KmallocStats::record(u32 heap, const char* name, s32 size, u32 padding, bool failed) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto& stats = m_stats[{heap, name ? name : "(null)"}];
+  auto& heap_stats = m_heap_stats[heap];
+  if (failed) {
+    stats.failed++;
+    heap_stats.largest_failed = std::max(heap_stats.largest_failed, (u64)size);
+  } else {
+    stats.count++;
+    stats.bytes += size;
+    stats.padding += padding;
+    int bucket = size_bucket(size);
+    heap_stats.size_counts[bucket]++;
+    heap_stats.size_bytes[bucket] += size;
+    heap_stats.largest = std::max(heap_stats.largest, (u64)size);
+  }
+}
+
+void KmallocStats::reset() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_stats.clear();
+  m_heap_stats.clear();
+}
+
+void KmallocStats::reset_heap(u32 heap) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (auto it = m_stats.begin(); it != m_stats.end();) {
+    if (it->first.first == heap) {
+      it = m_stats.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  m_heap_stats.erase(heap);
+}
+
+std::vector<KmallocStats::NameStats> KmallocStats::get_stats(u32 heap) const {
+  std::vector<NameStats> result;
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (auto& [key, stats] : m_stats) {
+    if (!heap || key.first == heap) {
+      result.push_back(stats);
+      result.back().heap = key.first;
+      result.back().name = key.second;
+    }
+  }
+  std::sort(result.begin(), result.end(),
+            [](const NameStats& a, const NameStats& b) { return a.bytes > b.bytes; });
+  return result;
+}
+
+std::vector<KmallocStats::HeapStats> KmallocStats::get_heap_stats() const {
+  std::vector<HeapStats> result;
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (auto& [heap, stats] : m_heap_stats) {
+    result.push_back(stats);
+    result.back().heap = heap;
+  }
+  return result;
+}
+
+void KmallocStats::dump_to_json(const std::string& path) const {
+  auto names = get_stats();
+  auto heaps = get_heap_stats();
+  // the kernel heaps are always included, to show how full they are.
+  for (u32 kheap : {kglobalheap.offset, kdebugheap.offset}) {
+    if (std::none_of(heaps.begin(), heaps.end(),
+                     [&](const HeapStats& stats) { return stats.heap == kheap; })) {
+      heaps.emplace_back().heap = kheap;
+    }
+  }
+
+  nlohmann::json json;
+  auto& json_heaps = json["heaps"];
+  json_heaps = nlohmann::json::array();
+  for (auto& heap : heaps) {
+    nlohmann::json json_heap;
+    json_heap["name"] = heap_name(heap.heap);
+    json_heap["largest"] = heap.largest;
+    json_heap["largest_failed"] = heap.largest_failed;
+    if (heap.heap != PROCESS_HEAPS) {
+      Ptr<kheapinfo> info(heap.heap);
+      json_heap["address"] = heap.heap;
+      json_heap["size"] = info->top_base - info->base;
+      json_heap["used_bottom"] = info->current - info->base;
+      json_heap["used_top"] = info->top_base - info->top;
+      json_heap["free"] = info->top - info->current;
+    }
+
+    auto& sizes = json_heap["sizes"];
+    sizes = nlohmann::json::array();
+    for (int i = 0; i < SIZE_BUCKETS; i++) {
+      if (heap.size_counts[i]) {
+        nlohmann::json bucket;
+        bucket["up_to"] = i == SIZE_BUCKETS - 1 ? nlohmann::json() : nlohmann::json(16u << i);
+        bucket["count"] = heap.size_counts[i];
+        bucket["bytes"] = heap.size_bytes[i];
+        sizes.push_back(bucket);
+      }
+    }
+
+    auto& json_names = json_heap["names"];
+    json_names = nlohmann::json::array();
+    for (auto& name : names) {
+      if (name.heap == heap.heap) {
+        nlohmann::json json_name;
+        json_name["name"] = name.name;
+        json_name["count"] = name.count;
+        json_name["bytes"] = name.bytes;
+        json_name["padding"] = name.padding;
+        json_name["failed"] = name.failed;
+        json_names.push_back(json_name);
+      }
+    }
+    json_heaps.push_back(json_heap);
+  }
+
+  file_util::create_dir_if_needed_for_file(path);
+  file_util::write_text_file(path, json.dump(2));
+}
+
+std::string KmallocStats::snapshot() const {
+  auto path = file_util::get_jak_project_dir() / "profile_data" /
+              fmt::format("kmalloc-{}.json", str_util::current_local_timestamp_no_colons());
+  dump_to_json(path.string());
+  lg::info("Saved kmalloc stats to {}", path.string());
+  return path.string();
+}
+
+int KmallocStats::size_bucket(s32 size) {
+  int bucket = 0;
+  while (bucket < SIZE_BUCKETS - 1 && (16 << bucket) < size) {
+    bucket++;
+  }
+  return bucket;
+}
+
+std::string KmallocStats::heap_name(u32 heap) {
+  if (heap == kglobalheap.offset) {
+    return "global";
+  } else if (heap == kdebugheap.offset) {
+    return "debug";
+  } else if (heap == PROCESS_HEAPS) {
+    return "process";
+  } else {
+    return fmt::format("#x{:x}", heap);
+  }
 }
 
 /*!
@@ -75,6 +234,16 @@ Ptr<kheapinfo> kheapstatus(Ptr<kheapinfo> heap) {
     Msg(6, "\t %d bytes before stack\n", GLOBAL_HEAP_END - heap->current.offset);
   }
 
+  // added: the largest users of the heap, if kmalloc is recording them.
+  if (g_kmalloc_stats.enabled()) {
+    auto stats = g_kmalloc_stats.get_stats(heap.offset);
+    for (size_t i = 0; i < std::min(stats.size(), (size_t)10); i++) {
+      auto& s = stats[i];
+      Msg(6, "\t %-24s %8d bytes in %d allocs (%d padding, %d failed)\n", s.name.c_str(),
+          (s32)s.bytes, (s32)s.count, (s32)s.padding, (s32)s.failed);
+    }
+  }
+
   // might not have returned heap in jak 1
   return heap;
 }
@@ -89,6 +258,7 @@ Ptr<kheapinfo> kinitheap(Ptr<kheapinfo> heap, Ptr<u8> mem, s32 size) {
   heap->top = mem + size;
   heap->top_base = heap->top;
   std::memset(mem.c(), 0, size);
+  g_kmalloc_stats.reset_heap(heap.offset);
   return heap;
 }
 
@@ -139,11 +309,17 @@ Ptr<u8> kmalloc(Ptr<kheapinfo> heap, s32 size, u32 flags, char const* name) {
     uint32_t memend = memstart + size;
 
     if (heap->top.offset < memend) {
+      if (g_kmalloc_stats.enabled()) {
+        g_kmalloc_stats.record(heap.offset, name, size, 0, true);
+      }
       kheapstatus(heap);
       Msg(6, "kmalloc: !alloc mem %s (%d bytes) heap %x\n", name, size, heap.offset);
       return Ptr<u8>(0);
     }
 
+    if (g_kmalloc_stats.enabled()) {
+      g_kmalloc_stats.record(heap.offset, name, size, memstart - heap->current.offset, false);
+    }
     heap->current.offset = memend;
     if (flags & KMALLOC_MEMSET)
       std::memset(Ptr<u8>(memstart).c(), 0, (size_t)size);
@@ -162,11 +338,17 @@ Ptr<u8> kmalloc(Ptr<kheapinfo> heap, s32 size, u32 flags, char const* name) {
     }
 
     if (heap->current.offset >= memstart) {
+      if (g_kmalloc_stats.enabled()) {
+        g_kmalloc_stats.record(heap.offset, name, size, 0, true);
+      }
       Msg(6, "kmalloc: !alloc mem from top %s (%d bytes) heap %x\n", name, size, heap.offset);
       kheapstatus(heap);
       return Ptr<u8>(0);
     }
 
+    if (g_kmalloc_stats.enabled()) {
+      g_kmalloc_stats.record(heap.offset, name, size, heap->top.offset - size - memstart, false);
+    }
     heap->top.offset = memstart;
 
     if (flags & KMALLOC_MEMSET)
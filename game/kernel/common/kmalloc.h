@@ -1,5 +1,13 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "common/common_types.h"
 
 #include "game/kernel/common/Ptr.h"
@@ -25,6 +33,68 @@ constexpr u32 KMALLOC_ALIGN_256 = 0x100;
 constexpr u32 KMALLOC_ALIGN_64 = 0x40;
 constexpr u32 KMALLOC_ALIGN_16 = 0x10;
 
+/*!
+ * Totals of kmalloc calls by heap and allocation name, for finding out what fills up a heap. GOAL
+ * objects allocated on a kheap are named by their type. kmalloc only records these while enabled,
+ * and nothing is ever freed from a kheap, so the totals include memory the game has since reset.
+ * Allocations on process heaps are recorded too, all together as PROCESS_HEAPS.
+ */
+class KmallocStats {
+ public:
+  // heap used for allocations on any process heap. kheaps are never at address 1.
+  static constexpr u32 PROCESS_HEAPS = 1;
+  // bucket i counts allocations of up to 16 << i bytes. The last bucket has everything larger.
+  static constexpr int SIZE_BUCKETS = 24;
+
+  struct NameStats {
+    u32 heap = 0;
+    std::string name;
+    u64 count = 0;
+    u64 bytes = 0;
+    // bytes skipped to align the allocations
+    u64 padding = 0;
+    u64 failed = 0;
+  };
+
+  struct HeapStats {
+    u32 heap = 0;
+    std::array<u64, SIZE_BUCKETS> size_counts = {};
+    std::array<u64, SIZE_BUCKETS> size_bytes = {};
+    u64 largest = 0;
+    u64 largest_failed = 0;
+  };
+
+  void set_enabled(bool enable) { m_enabled = enable; }
+  bool enabled() const { return m_enabled.load(std::memory_order_relaxed); }
+  void record(u32 heap, const char* name, s32 size, u32 padding, bool failed);
+  void reset();
+  void reset_heap(u32 heap);
+  // sorted by bytes, largest first. heap 0 returns all heaps.
+  std::vector<NameStats> get_stats(u32 heap = 0) const;
+  // sorted by heap address.
+  std::vector<HeapStats> get_heap_stats() const;
+  /*!
+   * Write the stats of every heap, with the current use of each kheap, to a JSON file.
+   */
+  void dump_to_json(const std::string& path) const;
+  /*!
+   * dump_to_json to a new file in profile_data. Returns the path.
+   */
+  std::string snapshot() const;
+
+  static int size_bucket(s32 size);
+  static std::string heap_name(u32 heap);
+
+ private:
+  // the debug gui reads the stats while the game allocates.
+  mutable std::mutex m_mutex;
+  std::map<std::pair<u32, std::string>, NameStats> m_stats;
+  std::map<u32, HeapStats> m_heap_stats;
+  std::atomic<bool> m_enabled = false;
+};
+
+extern KmallocStats g_kmalloc_stats;
+
 void kmalloc_init_globals_common();
 
 Ptr<u8> ksmalloc(Ptr<kheapinfo> heap, s32 size, u32 flags, char const* name);
@@ -1,7 +1,7 @@
 /*!
  * @file kmemcard.cpp
  * Memory card interface. Very messy code. Most of it is commented out now, as we've switched away
- * from memory cards to just raw saves.
+ * from memory cards to just raw saves. Saves and loads run on a background thread (see McWorker).
  *
  * Not checked carefully for differences in jak 2.
  */
@@ -9,8 +9,11 @@
 #include "kmemcard.h"
 
 #include <array>
+#include <atomic>
 #include <cstdio>
 #include <cstring>
+#include <functional>
+#include <thread>
 
 #include "common/util/Assert.h"
 #include "common/util/FileUtil.h"
@@ -55,6 +58,42 @@ static McHeader header;
 static s32 p1, p2, p3, p4;
 using namespace ee;
 
+/*!
+ * Runs a save or load on its own thread, so slow storage doesn't stall the frame. While it's busy,
+ * the worker owns op, mc_files and mc_last_file: MC_check_result reports BUSY, new operations
+ * aren't accepted, and MC_get_status reports the files as they were before the operation.
+ */
+class McWorker {
+ public:
+  ~McWorker() { wait(); }
+
+  void start(std::function<void()> func) {
+    wait();
+    m_busy.store(true, std::memory_order_relaxed);
+    m_thread = std::thread([this, func]() {
+      func();
+      m_busy.store(false, std::memory_order_release);
+    });
+  }
+
+  bool busy() const { return m_busy.load(std::memory_order_acquire); }
+
+  void wait() {
+    if (m_thread.joinable()) {
+      m_thread.join();
+    }
+  }
+
+ private:
+  std::thread m_thread;
+  std::atomic<bool> m_busy = false;
+};
+
+static McWorker mc_worker;
+// what MC_get_status reports while the worker is busy.
+static MemoryCardFile mc_files_status[4];
+static int mc_last_file_status = -1;
+
 template <typename... Args>
 void mc_print(const std::string& str, Args&&... args) {
   if (memcard_debug) {
@@ -105,6 +144,7 @@ int mc_get_total_bank_size(GameVersion) {
 }
 
 void kmemcard_init_globals() {
+  mc_worker.wait();
   // next = 0;
   language = 0;
   op = {};
@@ -114,6 +154,10 @@ void kmemcard_init_globals() {
   mc_files[1] = {};
   mc_files[2] = {};
   mc_files[3] = {};
+  for (auto& file : mc_files_status) {
+    file = {};
+  }
+  mc_last_file_status = -1;
   callback = nullptr;
   p1 = 0;
   p2 = 0;
@@ -168,6 +212,19 @@ bool file_is_present(int id, int bank = 0) {
   */
 }
 
+/*!
+ * Read just the header at the start of a bank file. Returns false if it can't be read.
+ */
+bool read_bank_header(const fs::path& path, McHeader* out) {
+  auto fp = file_util::open_file(path, "rb");
+  if (!fp) {
+    return false;
+  }
+  bool ok = fread(out, sizeof(McHeader), 1, fp) == 1;
+  fclose(fp);
+  return ok;
+}
+
 /*!
  * PC port function to set memcard info. We don't use a memory card, instead just the raw savefiles.
  */
@@ -177,13 +234,17 @@ void pc_update_card() {
   for (s32 file = 0; file < 4; file++) {
     auto bankname = mc_get_filename(g_game_version, 4 + file * 2);
     mc_files[file].present = file_is_present(file);
+    McHeader bank_header1;
+    if (mc_files[file].present && !read_bank_header(bankname, &bank_header1)) {
+      mc_files[file].present = false;
+    }
     if (mc_files[file].present) {
-      auto bankdata = file_util::read_binary_file(bankname.string());
-      auto header1 = reinterpret_cast<McHeader*>(bankdata.data());
-      if (file_is_present(file, 1)) {
-        auto bankname2 = mc_get_filename(g_game_version, 1 + 4 + file * 2);
-        auto bankdata2 = file_util::read_binary_file(bankname2.string());
-        auto header2 = reinterpret_cast<McHeader*>(bankdata2.data());
+      // only the header is needed, so the rest of the bank isn't read.
+      auto header1 = &bank_header1;
+      McHeader bank_header2;
+      auto bankname2 = mc_get_filename(g_game_version, 1 + 4 + file * 2);
+      if (file_is_present(file, 1) && read_bank_header(bankname2, &bank_header2)) {
+        auto header2 = &bank_header2;
 
         if (header2->save_count > header1->save_count) {
           // use most recent bank here.
@@ -212,7 +273,7 @@ void pc_update_card() {
 }
 
 /*!
- * PC port function to save a file. This does the whole saving at once, synchronously.
+ * PC port function to save a file. This does the whole saving at once, on the McWorker thread.
  */
 void pc_game_save_synch() {
   Timer mc_timer;
@@ -242,7 +303,11 @@ void pc_game_save_synch() {
   mc_print("open {} for saving", mc_get_filename_no_dir(g_game_version, op.param2 * 2 + 4 + p4));
   auto save_path = mc_get_filename(g_game_version, op.param2 * 2 + 4 + p4);
   file_util::create_dir_if_needed_for_file(save_path.string());
-  auto fd = file_util::open_file(save_path.string().c_str(), "wb");
+  // written to a temporary file which replaces the bank at the end, so a save that's interrupted
+  // doesn't leave a broken bank.
+  auto temp_path = save_path;
+  temp_path += ".tmp";
+  auto fd = file_util::open_file(temp_path.string().c_str(), "wb");
   mc_print("synchronous save file open took {:.2f}ms\n", mc_timer.getMs());
   if (fd) {
     // cb_openedsave //
@@ -261,7 +326,12 @@ void pc_game_save_synch() {
         mc_print("save file writing footer");
         if (fwrite(&header, sizeof(McHeader), 1, fd) == 1) {
           // cb_savedfooter //
-          if (fclose(fd) == 0) {
+          std::error_code rename_error;
+          bool closed = fclose(fd) == 0;
+          if (closed) {
+            fs::rename(temp_path, save_path, rename_error);
+          }
+          if (closed && !rename_error) {
             // cb_closedsave //
             mc_print("All done with saving!!");
             op.operation = MemoryCardOperationKind::NO_OP;
@@ -272,6 +342,7 @@ void pc_game_save_synch() {
             memcpy(mc_files[op.param2].data, op.data_ptr2.c(), 64);
             mc_last_file = op.param2;
           } else {
+            fs::remove(temp_path, rename_error);
             op.operation = MemoryCardOperationKind::NO_OP;
             op.result = McStatusCode::INTERNAL_ERROR;
           }
@@ -423,7 +494,7 @@ void pc_game_load_open_file(FILE* fd) {
 }
 
 /*!
- * PC port function to load a file. This does the whole loading at once, synchronously.
+ * PC port function to load a file. This does the whole loading at once, on the McWorker thread.
  */
 void pc_game_load_synch() {
   Timer mc_timer;
@@ -444,13 +515,17 @@ void pc_game_load_synch() {
 /*!
  * Run the Memory Card state machine.  This is called once per frame in GOAL.
  * It:
- *  - does nothing if there is an in-progress memory card operation
+ *  - does nothing if there is an in-progress memory card operation, or the McWorker is busy
  *  - if async memory card functions are done, runs their callbacks
  *  - if there is a requested operation, starts running sony functions.
  *  - if there is none of the above, and unknown cards, finds out about them.
  *  - every now and then, recheck cards.
  */
 void MC_run() {
+  if (mc_worker.busy()) {
+    return;
+  }
+
   // if we have an in-progress operation, it will have set a callback.
   if (callback) {
     s32 sony_cmd, sony_status;
@@ -493,28 +568,32 @@ void MC_run() {
   } else if (op.operation == MemoryCardOperationKind::SAVE) {
     // write game save.
     // there's no cards, keep in mind.
-    pc_game_save_synch();
-    // allow some number of errors.
-    op.retry_count--;
-    if (op.retry_count == 0) {
-      op.operation = MemoryCardOperationKind::NO_OP;
-      op.result = McStatusCode::INTERNAL_ERROR;
-    }
-  } else if (op.operation == MemoryCardOperationKind::LOAD) {
-    // load game save.
-    // potato.
-    if (!file_is_present(op.param2)) {
-      // tried to load, but there's no save data in the file.
-      op.operation = MemoryCardOperationKind::NO_OP;
-      op.result = McStatusCode::NO_MEMORY;
-    } else {
-      pc_game_load_synch();
+    mc_worker.start([]() {
+      pc_game_save_synch();
+      // allow some number of errors.
       op.retry_count--;
       if (op.retry_count == 0) {
         op.operation = MemoryCardOperationKind::NO_OP;
         op.result = McStatusCode::INTERNAL_ERROR;
       }
-    }
+    });
+  } else if (op.operation == MemoryCardOperationKind::LOAD) {
+    // load game save.
+    // potato.
+    mc_worker.start([]() {
+      if (!file_is_present(op.param2)) {
+        // tried to load, but there's no save data in the file.
+        op.operation = MemoryCardOperationKind::NO_OP;
+        op.result = McStatusCode::NO_MEMORY;
+      } else {
+        pc_game_load_synch();
+        op.retry_count--;
+        if (op.retry_count == 0) {
+          op.operation = MemoryCardOperationKind::NO_OP;
+          op.result = McStatusCode::INTERNAL_ERROR;
+        }
+      }
+    });
   }
 }
 
@@ -591,11 +670,10 @@ u64 MC_createfile(s32 /*param*/, Ptr<u8> /*data*/) {
 /*!
  * Set the current operation to SAVE.
  * The "summary data" is data that will be used when previewing save files (number of orbs etc)
- * TODO put synchronous call here
  */
 u64 MC_save(s32 card_idx, s32 file_idx, Ptr<u8> save_data, Ptr<u8> save_summary_data) {
   mc_print("requested save");
-  u64 can_add = op.operation == MemoryCardOperationKind::NO_OP;
+  u64 can_add = !mc_worker.busy() && op.operation == MemoryCardOperationKind::NO_OP;
   if (can_add) {
     mc_print("setting op to save");
     op.operation = MemoryCardOperationKind::SAVE;
@@ -611,11 +689,10 @@ u64 MC_save(s32 card_idx, s32 file_idx, Ptr<u8> save_data, Ptr<u8> save_summary_
 
 /*!
  * Set the current operation to LOAD.
- * TODO put synchronous call here
  */
 u64 MC_load(s32 card_idx, s32 file_idx, Ptr<u8> data) {
   mc_print("requested load");
-  u64 can_add = op.operation == MemoryCardOperationKind::NO_OP;
+  u64 can_add = !mc_worker.busy() && op.operation == MemoryCardOperationKind::NO_OP;
   if (can_add) {
     mc_print("setting op to load");
     op.operation = MemoryCardOperationKind::LOAD;
@@ -666,6 +743,9 @@ void MC_makefile(s32 port, s32 size) {
  * Get the result of the currently executing (or most recently executed) command
  */
 u32 MC_check_result() {
+  if (mc_worker.busy()) {
+    return (u32)McStatusCode::BUSY;
+  }
   return (u32)op.result;
 }
 
@@ -688,7 +768,11 @@ void MC_get_status(s32 /*slot*/, Ptr<mc_slot_info> info) {
   info->mem_required = SAVE_SIZE[g_game_version];
   info->mem_actual = 0;
 
-  pc_update_card();
+  if (!mc_worker.busy()) {
+    pc_update_card();
+    memcpy(mc_files_status, mc_files, sizeof(mc_files));
+    mc_last_file_status = mc_last_file;
+  }
   info->known = 1;
   info->handle = PC_MEM_CARD_HANDLE;
   info->formatted = 1;
@@ -696,10 +780,10 @@ void MC_get_status(s32 /*slot*/, Ptr<mc_slot_info> info) {
   info->initted = 1;
   // copy over the preview data.
   for (s32 file = 0; file < 4; file++) {
-    info->files[file].present = mc_files[file].present;
+    info->files[file].present = mc_files_status[file].present;
     for (s32 i = 0; i < 64; i++) {  // actually a loop over u32's
-      info->files[file].data[i] = mc_files[file].data[i];
+      info->files[file].data[i] = mc_files_status[file].data[i];
     }
   }
-  info->last_file = mc_last_file;
+  info->last_file = mc_last_file_status;
 }
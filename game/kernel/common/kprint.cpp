@@ -1,5 +1,7 @@
 #include "kprint.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <cstdarg>
 #include <cstdio>
@@ -38,6 +40,72 @@ char ConvertTable[16];
 // buffer for sending an "acknowledge" message to the compiler
 char AckBufArea[40];
 
+StdoutWriter g_stdout_writer;
+
+StdoutWriter::~StdoutWriter() {
+  if (m_thread.joinable()) {
+    m_quit = true;
+    m_cv.notify_one();
+    m_thread.join();
+  }
+}
+
+void StdoutWriter::write(const char* data, size_t size) {
+  if (!m_thread.joinable()) {
+    m_buffer = std::make_unique<char[]>(SIZE);
+    m_thread = std::thread([this]() { run(); });
+  }
+
+  while (size) {
+    size_t write = m_write.load(std::memory_order_relaxed);
+    size_t space = SIZE - (write - m_read.load(std::memory_order_acquire));
+    if (!space) {
+      m_cv.notify_one();
+      std::this_thread::yield();
+      continue;
+    }
+    size_t count = std::min({size, space, SIZE - write % SIZE});
+    memcpy(m_buffer.get() + write % SIZE, data, count);
+    m_write.store(write + count, std::memory_order_release);
+    data += count;
+    size -= count;
+  }
+  m_cv.notify_one();
+}
+
+void StdoutWriter::flush() {
+  while (m_read.load(std::memory_order_acquire) != m_write.load(std::memory_order_relaxed)) {
+    m_cv.notify_one();
+    std::this_thread::yield();
+  }
+}
+
+void StdoutWriter::run() {
+  while (true) {
+    size_t read = m_read.load(std::memory_order_relaxed);
+    size_t write = m_write.load(std::memory_order_acquire);
+    if (read == write) {
+      if (m_quit) {
+        return;
+      }
+      // write() doesn't lock, so a notify can be missed. The timeout limits how late that makes
+      // the output.
+      std::unique_lock<std::mutex> lk(m_mutex);
+      m_cv.wait_for(lk, std::chrono::milliseconds(10), [&]() {
+        return m_quit || m_write.load(std::memory_order_acquire) != read;
+      });
+      continue;
+    }
+
+    size_t count = std::min(write - read, SIZE - read % SIZE);
+    fwrite(m_buffer.get() + read % SIZE, 1, count, stdout);
+    if (read + count == m_write.load(std::memory_order_acquire)) {
+      fflush(stdout);
+    }
+    m_read.store(read + count, std::memory_order_release);
+  }
+}
+
 /*!
  * Initialize global variables for kprint
  */
@@ -187,6 +255,7 @@ void cprintf(const char* format, ...) {
  */
 void Msg(s32 k, const char* format, ...) {
   (void)k;
+  g_stdout_writer.flush();
   va_list args;
   va_start(args, format);
   vprintf(format, args);
@@ -199,6 +268,7 @@ void Msg(s32 k, const char* format, ...) {
  * DONE, EXACT
  */
 void MsgWarn(const char* format, ...) {
+  g_stdout_writer.flush();
   va_list args;
   va_start(args, format);
   vprintf(format, args);
@@ -211,6 +281,7 @@ void MsgWarn(const char* format, ...) {
  * DONE, EXACT
  */
 void MsgErr(const char* format, ...) {
+  g_stdout_writer.flush();
   va_list args;
   va_start(args, format);
   vprintf(format, args);
@@ -1,5 +1,11 @@
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 #include "common/common_types.h"
 
 #include "game/kernel/common/Ptr.h"
@@ -31,6 +37,38 @@ struct format_struct {
 
 void kprint_init_globals_common();
 
+/*!
+ * Writes the print buffer to stdout from a background thread, so the EE thread doesn't wait on the
+ * console when a frame prints a lot. Only the EE thread writes to it. The buffer is a single
+ * producer, single consumer ring, and the EE thread only waits when it's full.
+ */
+class StdoutWriter {
+ public:
+  ~StdoutWriter();
+  void write(const char* data, size_t size);
+  /*!
+   * Wait until everything written so far has been passed to stdout. Done before the EE thread
+   * prints to stdout itself, to keep the output in order.
+   */
+  void flush();
+
+ private:
+  void run();
+
+  static constexpr size_t SIZE = 1 << 20;
+  std::unique_ptr<char[]> m_buffer;
+  // total bytes written and read. Only the EE thread changes m_write, and only the writer thread
+  // changes m_read.
+  std::atomic<size_t> m_write = 0;
+  std::atomic<size_t> m_read = 0;
+  std::atomic<bool> m_quit = false;
+  std::thread m_thread;
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+};
+
+extern StdoutWriter g_stdout_writer;
+
 /*!
  * Initialize GOAL Kernel printing/messaging system.
  * Allocates buffers.
@@ -1,5 +1,9 @@
 #include "kscheme.h"
 
+#include <algorithm>
+
+#include "common/log/log.h"
+
 #include "game/kernel/common/fileio.h"
 #include "game/kernel/common/kmalloc.h"
 #include "game/kernel/common/kprint.h"
@@ -13,6 +17,9 @@ Ptr<u32> s7;
 // used for crc32 calculation
 u32 crc_table[0x100];
 
+// added: crc_slice_table[k][i] is i * x^(40 + 8k) mod CRC_POLY, for crc32 to do 8 bytes at a time.
+u32 crc_slice_table[7][0x100];
+
 // pointer to the "second" symbol table
 Ptr<u32> SymbolTable2;
 
@@ -28,6 +35,9 @@ u32 FastLink;
 // but is enabled when loading the engine.
 Ptr<u32> EnableMethodSet;
 
+SymbolIndex g_symbol_index;
+ProcessStats g_process_stats;
+
 void kscheme_init_globals_common() {
   SymbolTable2.offset = 0;
   LastSymbol.offset = 0;
@@ -38,6 +48,98 @@ void kscheme_init_globals_common() {
   }
   EnableMethodSet.offset = 0;
   FastLink = 0;
+  g_symbol_index.clear();
+}
+
+void ProcessStats::begin(const char* name, const char* state) {
+  if (!enabled()) {
+    return;
+  }
+  auto key = std::make_pair(std::string(name), std::string(state));
+  auto it = m_counters.find(key);
+  if (it == m_counters.end()) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    it = m_counters.emplace(key, Counter()).first;
+    it->second.name = key.first;
+    it->second.state = key.second;
+  }
+  m_running.push_back({&it->second, m_timer.getNs(), 0});
+}
+
+void ProcessStats::end() {
+  // the stats may have been enabled after this process started.
+  if (m_running.empty()) {
+    return;
+  }
+  auto run = m_running.back();
+  m_running.pop_back();
+  s64 elapsed = m_timer.getNs() - run.start_ns;
+  run.counter->frame_ns += elapsed - run.child_ns;
+  run.counter->frame_calls++;
+  if (!m_running.empty()) {
+    m_running.back().child_ns += elapsed;
+  }
+}
+
+void ProcessStats::end_frame() {
+  // no process is running during vsync, so this is the only place the counters can be removed.
+  m_running.clear();
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_want_reset.exchange(false)) {
+    m_counters.clear();
+    m_frames = 0;
+    return;
+  }
+  if (!enabled()) {
+    return;
+  }
+  m_frames++;
+  for (auto& [key, counter] : m_counters) {
+    counter.total_ns += counter.frame_ns;
+    counter.total_calls += counter.frame_calls;
+    counter.last_ns = counter.frame_ns;
+    counter.max_ns = std::max(counter.max_ns, counter.frame_ns);
+    counter.frame_ns = 0;
+    counter.frame_calls = 0;
+  }
+}
+
+std::vector<ProcessStats::Stats> ProcessStats::get_stats() const {
+  std::vector<Stats> result;
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (!m_frames) {
+    return result;
+  }
+  for (auto& [key, counter] : m_counters) {
+    auto& stats = result.emplace_back();
+    stats.name = counter.name;
+    stats.state = counter.state;
+    stats.avg_ms = counter.total_ns / 1.e6 / m_frames;
+    stats.last_ms = counter.last_ns / 1.e6;
+    stats.max_ms = counter.max_ns / 1.e6;
+    stats.avg_calls = (double)counter.total_calls / m_frames;
+  }
+  std::sort(result.begin(), result.end(),
+            [](const Stats& a, const Stats& b) { return a.avg_ms > b.avg_ms; });
+  return result;
+}
+
+void SymbolIndex::clear() {
+  m_symbols.clear();
+  m_hits = 0;
+  m_probes = 0;
+  m_probe_ns = 0;
+}
+
+/*!
+ * Print how many lookups the index served. The time saved is a guess, from the average time of the
+ * lookups that had to probe the table.
+ */
+void SymbolIndex::log_stats() const {
+  double probe_ms = m_probe_ns / 1.e6;
+  double saved_ms = m_probes ? probe_ms * m_hits / m_probes : 0;
+  lg::info("Symbol index: {} symbols, {} lookups indexed, {} probed in {:.2} ms, saved ~{:.2} ms",
+           m_symbols.size(), m_hits, m_probes, probe_ms, saved_ms);
 }
 
 /*!
@@ -51,6 +153,15 @@ void init_crc() {
     }
     crc_table[i] = n;
   }
+
+  // added: crc_table[i] is i * x^32, each slice table is the previous times x^8.
+  for (u32 i = 0; i < 0x100; i++) {
+    u32 n = crc_table[i];
+    for (auto& table : crc_slice_table) {
+      n = (n << 8) ^ crc_table[n >> 24];
+      table[i] = n;
+    }
+  }
 }
 
 /*!
@@ -58,6 +169,20 @@ void init_crc() {
  */
 u32 crc32(const u8* data, s32 size) {
   uint32_t crc = 0;
+
+  // added: the loop below divides the data by CRC_POLY, one byte at a time. This does the same 8
+  // bytes at a time: crc * x^64 and the first 4 bytes * x^32 are looked up one byte each, then the
+  // last 4 bytes are added. Symbol names are hashed on every intern, so this speeds up linking.
+  while (size >= 8) {
+    u32 last = ((u32)data[4] << 24) | ((u32)data[5] << 16) | ((u32)data[6] << 8) | data[7];
+    crc = crc_slice_table[6][crc >> 24] ^ crc_slice_table[5][(crc >> 16) & 0xff] ^
+          crc_slice_table[4][(crc >> 8) & 0xff] ^ crc_slice_table[3][crc & 0xff] ^
+          crc_slice_table[2][data[0]] ^ crc_slice_table[1][data[1]] ^
+          crc_slice_table[0][data[2]] ^ crc_table[data[3]] ^ last;
+    data += 8;
+    size -= 8;
+  }
+
   for (int i = size; i != 0; i--, data++) {
     crc = crc_table[crc >> 24] ^ ((crc << 8) | *data);
   }
@@ -1,6 +1,16 @@
 #pragma once
 
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include "common/common_types.h"
+#include "common/util/Timer.h"
 
 #include "game/kernel/common/Ptr.h"
 
@@ -13,6 +23,101 @@ extern Ptr<u32> EnableMethodSet;
 
 void kscheme_init_globals_common();
 
+/*!
+ * Index of the symbol table by name, so find_symbol_from_c can skip the crc32 and the probe for
+ * symbols it has found before. Symbols never move or get renamed once they're in the table, so a
+ * symbol is added the first time a probe finds it. Missing symbols aren't stored, because the probe
+ * is still needed to find their slot. The keys point to the symbol's name string in the GOAL heap,
+ * so this must be cleared when the symbol table is rebuilt.
+ */
+class SymbolIndex {
+ public:
+  u32 find(const char* name) {
+    auto it = m_symbols.find(name);
+    if (it == m_symbols.end()) {
+      return 0;
+    }
+    m_hits++;
+    return it->second;
+  }
+
+  void add(const char* goal_name, u32 sym) { m_symbols[goal_name] = sym; }
+  void add_probe_time(s64 ns) {
+    m_probes++;
+    m_probe_ns += ns;
+  }
+
+  void clear();
+  void log_stats() const;
+
+ private:
+  std::unordered_map<std::string_view, u32> m_symbols;
+  u64 m_hits = 0;
+  u64 m_probes = 0;
+  s64 m_probe_ns = 0;
+};
+
+extern SymbolIndex g_symbol_index;
+
+/*!
+ * CPU time of each GOAL process, by process name and state, for finding the expensive actors in a
+ * scene. The GOAL kernel's process dispatch calls begin and end around each process it runs. A
+ * process run inside another one, like a child's init, only counts for the inner one. Only records
+ * while enabled. Used by the EE thread, except for get_stats.
+ */
+class ProcessStats {
+ public:
+  struct Stats {
+    std::string name;
+    std::string state;
+    double avg_ms = 0;     // per frame, over all frames since the reset
+    double last_ms = 0;    // on the last frame
+    double max_ms = 0;     // the most on any one frame
+    double avg_calls = 0;  // per frame
+  };
+
+  void set_enabled(bool enable) { m_enabled = enable; }
+  bool enabled() const { return m_enabled.load(std::memory_order_relaxed); }
+  void begin(const char* name, const char* state);
+  void end();
+  // once per frame, on vsync.
+  void end_frame();
+  void reset() { m_want_reset = true; }
+  // sorted by average time, largest first.
+  std::vector<Stats> get_stats() const;
+
+ private:
+  struct Counter {
+    std::string name;
+    std::string state;
+    // this frame, only used by the EE
+    s64 frame_ns = 0;
+    u32 frame_calls = 0;
+    // totals, updated at the end of each frame
+    s64 total_ns = 0;
+    u64 total_calls = 0;
+    s64 last_ns = 0;
+    s64 max_ns = 0;
+  };
+
+  struct Running {
+    Counter* counter = nullptr;
+    s64 start_ns = 0;
+    s64 child_ns = 0;  // time of processes run inside this one
+  };
+
+  // the debug gui reads the stats while the game adds to them.
+  mutable std::mutex m_mutex;
+  std::map<std::pair<std::string, std::string>, Counter> m_counters;
+  std::vector<Running> m_running;
+  Timer m_timer;
+  u64 m_frames = 0;
+  std::atomic<bool> m_enabled = false;
+  std::atomic<bool> m_want_reset = false;
+};
+
+extern ProcessStats g_process_stats;
+
 constexpr u32 CRC_POLY = 0x04c11db7;
 constexpr u32 EMPTY_HASH = 0x8454B6E6;
 constexpr u32 OFFSET_MASK = 7;
@@ -6,6 +6,7 @@
 #include "game/common/dgo_rpc_types.h"
 #include "game/kernel/common/Ptr.h"
 #include "game/kernel/common/fileio.h"
+#include "game/kernel/common/kboot.h"
 #include "game/kernel/common/kdgo.h"
 #include "game/kernel/common/kmalloc.h"
 #include "game/kernel/jak1/klink.h"
@@ -74,6 +75,8 @@ void load_and_link_dgo_from_c(const char* name,
     strcat(fileName, ".CGO");
   }
 
+  BootPhase dgo_phase(fileName);
+
   // no stall messages, as this is a blocking load and when spending 100% CPU time on linking,
   // the linker can beat the DVD drive.
   sShowStallMsg = 0;
@@ -107,7 +110,10 @@ void load_and_link_dgo_from_c(const char* name,
     lg::debug("[link and exec] {:18s} {} {:6d} heap-use {:8d} {:8d}: 0x{:x}", objName,
               lastObjectLoaded, objSize, kheapused(kglobalheap),
               kdebugheap.offset ? kheapused(kdebugheap) : 0, kglobalheap->current.offset);
-    link_and_exec(obj, objName, objSize, heap, linkFlag, jump_from_c_to_goal);  // link now!
+    {
+      BootPhase phase(objName, true);
+      link_and_exec(obj, objName, objSize, heap, linkFlag, jump_from_c_to_goal);  // link now!
+    }
 
     // inform IOP we are done
     if (!lastObjectLoaded) {
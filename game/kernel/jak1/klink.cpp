@@ -2,6 +2,7 @@
 
 #include "common/log/log.h"
 #include "common/symbols.h"
+#include "common/util/Timer.h"
 
 #include "game/kernel/common/fileio.h"
 #include "game/kernel/common/klink.h"
@@ -175,10 +176,11 @@ uint32_t symlink_v3(Ptr<uint8_t> link, Ptr<uint8_t> data) {
 
 }  // namespace
 /*!
- * Run the linker. For now, all linking is done in two runs.  If this turns out to be too slow,
- * this should be modified to do incremental linking over multiple runs.
+ * Run the linker. The segments are all copied in the first run, then each run links a segment,
+ * and returns early if it goes over LINK_WORK_BUDGET_MS.
  */
 uint32_t link_control::jak1_work_v3() {
+  Timer work_timer;
   ObjectFileHeader* ofh = m_link_block_ptr.cast<ObjectFileHeader>().c();
   if (m_state == 0) {
     // state 0 <- copying data.
@@ -251,14 +253,17 @@ uint32_t link_control::jak1_work_v3() {
 
     m_state = 1;
     m_segment_process = 0;
+    m_reloc_ptr.offset = 0;
     return 0;
   } else if (m_state == 1) {
-    // state 1: linking. For now all links are done at once. This is probably going to be fine on a
-    // modern computer.  But the game broke this into multiple steps.
+    // state 1: linking. Each call links at most one segment, and stops partway through if it runs
+    // out of time. m_reloc_ptr remembers where to pick up the segment's link table.
     if (m_segment_process < ofh->segment_count) {
       if (ofh->code_infos[m_segment_process].offset) {
-        Ptr<u8> lp(ofh->link_infos[m_segment_process].offset);
+        Ptr<u8> lp = m_reloc_ptr.offset ? m_reloc_ptr
+                                        : Ptr<u8>(ofh->link_infos[m_segment_process].offset);
 
+        u32 link_counter = 0x40;
         while (*lp) {
           switch (*lp) {
             case LINK_TABLE_END:
@@ -287,9 +292,19 @@ uint32_t link_control::jak1_work_v3() {
               ASSERT_MSG(false, fmt::format("unknown link table thing {}", *lp));
               break;
           }
+
+          link_counter--;
+          if (link_counter == 0) {
+            if (*lp && work_timer.getMs() > LINK_WORK_BUDGET_MS) {
+              m_reloc_ptr = lp;
+              return 0;
+            }
+            link_counter = 0x40;
+          }
         }
       }
 
+      m_reloc_ptr.offset = 0;
       m_segment_process++;
     } else {
       // all done, can set the entry point to the top-level.
@@ -313,7 +328,7 @@ uint32_t link_control::jak1_work_v3() {
 #define OBJ_V2_MAX_TRANSFER 0x80000
 
 uint32_t link_control::jak1_work_v2() {
-  //  u32 startCycle = kernel.read_clock(); todo
+  Timer work_timer;
 
   if (m_state == LINK_V2_STATE_INIT_COPY) {  // initialization and copying to heap
     // we move the data segment to eliminate gaps
@@ -403,8 +418,8 @@ uint32_t link_control::jak1_work_v2() {
     //  a very stupid
     // method of encoding values which requires O(n) bytes to store the value n.
 
-    // to avoid dropping a frame, we check every 0x400 relocations to see if 0.5 milliseconds have
-    // elapsed.
+    // to avoid dropping a frame, we check every 0x400 relocations to see if we're over the time
+    // budget. Everything needed to resume is in the link_control.
     u32 relocCounter = 0x400;
     while (true) {    // loop over entire table
       while (true) {  // loop over current mode
@@ -446,10 +461,9 @@ uint32_t link_control::jak1_work_v2() {
       }
       relocCounter--;
       if (relocCounter == 0) {
-        //        u32 clock_value = kernel.read_clock();
-        //        if(clock_value - startCycle > 150000) { // 0.5 milliseconds
-        //          return 0;
-        //        }
+        if (work_timer.getMs() > LINK_WORK_BUDGET_MS) {
+          return 0;
+        }
         relocCounter = 0x400;
       }
     }
@@ -497,10 +511,9 @@ uint32_t link_control::jak1_work_v2() {
         if (*m_reloc_ptr == 0) {
           break;  // done
         }
-        //        u32 currentCycle = kernel.read_clock();
-        //        if(currentCycle - startCycle > 150000) {
-        //          return 0;
-        //        }
+        if (work_timer.getMs() > LINK_WORK_BUDGET_MS) {
+          return 0;
+        }
       }
       m_state = 3;
       m_segment_process = 0;
@@ -76,9 +76,13 @@ void ProcessListenerMessage(Ptr<char> msg) {
     case LTT_MSG_SHUTDOWN:
       MasterExit = RuntimeExitStatus::EXIT;
       break;
-    case LTT_MSG_CODE: {
-      auto buffer = kmalloc(kdebugheap, MessCount, 0, "listener-link-block");
-      memcpy(buffer.c(), msg.c(), MessCount);
+    case LTT_MSG_CODE:
+    case LTT_MSG_CODE_ZSTD: {
+      auto buffer = CopyListenerCode(msg, protoBlock.msg_kind == LTT_MSG_CODE_ZSTD);
+      if (!buffer.offset) {
+        MsgErr("dkernel: couldn't load code message of %d bytes\n", MessCount);
+        break;
+      }
       ListenerLinkBlock->value = buffer.offset + 4;
       // note - this will stash the linked code in the top level and free it.
       // it will then be used-after-free, but this is OK because nobody else will allocate.
@@ -322,12 +322,18 @@ int InitMachine() {
     kdebugheap.offset = 0;
   }
 
-  init_output();    // GOAL input/output buffer setup
-  jak1::InitIOP();  // start IOP/OVERLORD, loading our legal splash screen
+  init_output();  // GOAL input/output buffer setup
+  {
+    BootPhase phase("InitIOP");
+    jak1::InitIOP();  // start IOP/OVERLORD, loading our legal splash screen
+  }
 
   // sceGsResetPath(); // reset VIF1, VU1, GIF
 
-  InitVideo();  // display legal splash screen
+  {
+    BootPhase phase("InitVideo");
+    InitVideo();  // display legal splash screen
+  }
 
   // FlushCache(WRITEBACK_DCACHE);
   // FlushCache(INVALIDATE_ICACHE);
@@ -338,6 +344,7 @@ int InitMachine() {
   // }
 
   if (MasterDebug) {  // connect to GOAL compiler
+    BootPhase phase("InitGoalProto");
     InitGoalProto();
   } else {
     // shut down the deci2 stuff, we don't need it.
@@ -345,13 +352,23 @@ int InitMachine() {
   }
 
   lg::info("InitSound");
-  InitSound();  // do nothing!
+  {
+    BootPhase phase("InitSound");
+    InitSound();  // do nothing!
+  }
   lg::info("InitRPC");
-  InitRPC();       // connect to IOP
+  {
+    BootPhase phase("InitRPC");
+    InitRPC();  // connect to IOP
+  }
   reset_output();  // reset output buffers
   clear_print();
 
-  s32 goal_status = InitHeapAndSymbol();  // init GOAL runtime, load kernel and engine
+  s32 goal_status;
+  {
+    BootPhase phase("InitHeapAndSymbol");
+    goal_status = InitHeapAndSymbol();  // init GOAL runtime, load kernel and engine
+  }
   if (goal_status < 0) {
     return goal_status;
   }
@@ -361,10 +378,14 @@ int InitMachine() {
       (u64)g_ee_main_mem + intern_from_c("*autosplit-info-jak1*")->value;
 
   lg::info("InitListenerConnect");
-  InitListenerConnect();
+  {
+    BootPhase phase("InitListenerConnect");
+    InitListenerConnect();
+  }
   lg::info("InitCheckListener");
   InitCheckListener();
   Msg(6, "kernel: machine started\n");
+  log_boot_phases();
   return 0;
 }
 
@@ -542,6 +563,20 @@ void pc_set_levels(u32 l0, u32 l1) {
   Gfx::GetCurrentRenderer()->set_levels(levels);
 }
 
+void pc_prefetch_level(u32 lev) {
+  if (!Gfx::GetCurrentRenderer()) {
+    return;
+  }
+  std::string ls = Ptr<String>(lev).c()->data();
+
+  std::vector<std::string> levels;
+  if (ls != "none" && ls != "#f") {
+    levels.push_back(ls);
+  }
+
+  Gfx::GetCurrentRenderer()->prefetch_levels(levels);
+}
+
 void InitMachine_PCPort() {
   // PC Port added functions
   init_common_pc_port_functions(
@@ -558,6 +593,8 @@ void InitMachine_PCPort() {
   // Called from the game thread at each frame to tell the PC rendering code which levels to start
   // loading. The loader internally handles locking.
   make_function_symbol_from_c("__pc-set-levels", (void*)pc_set_levels);
+  // Called from the game thread at each frame with a level that will probably be loaded soon.
+  make_function_symbol_from_c("__pc-prefetch-level", (void*)pc_prefetch_level);
 
   make_function_symbol_from_c("pc-discord-rpc-update", (void*)update_discord_rpc);
 
@@ -612,7 +649,10 @@ void InitMachineScheme() {
   make_function_symbol_from_c("aybabtu", (void*)sceCdMmode);                    // used
 
 
-  InitMachine_PCPort();
+  {
+    BootPhase phase("InitMachine_PCPort");
+    InitMachine_PCPort();
+  }
   InitSoundScheme();
   intern_from_c("*stack-top*")->value = 0x07ffc000;
   intern_from_c("*stack-base*")->value = 0x07ffffff;
@@ -643,6 +683,7 @@ void InitMachineScheme() {
                  make_string_from_c("common"), kernel_packages->value);
 
     lg::info("calling play");
+    BootPhase phase("play");
     call_goal_function_by_name("play");
   }
 }
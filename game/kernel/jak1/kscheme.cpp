@@ -44,6 +44,27 @@ u64 new_illegal(u32 allocation, u32 type) {
   return s7.offset;
 }
 
+/*!
+ * The name of an allocation of a type, for kmalloc. Untyped memory and types without a name are
+ * called global-object.
+ */
+const char* alloc_name(u32 type) {
+  if (!type) {
+    return "global-object";
+  }
+
+  Ptr<Type> typ(type);
+  if (!typ->symbol.offset) {
+    return "global-object";
+  }
+
+  Ptr<String> gstr = info(typ->symbol)->str;
+  if (!gstr->len) {
+    return "global-object";
+  }
+  return gstr->data();
+}
+
 /*!
  * Allocate memory from the specified heap. If symbol is 'process, does a process allocation.
  * If symbol is 'scratch, does a scratch allocation (this is not used).
@@ -74,25 +95,8 @@ u64 alloc_from_heap(u32 heapSymbol, u32 type, s32 size, u32 pp) {
   if (heapOffset == FIX_SYM_GLOBAL_HEAP || heapOffset == FIX_SYM_DEBUG_HEAP ||
       heapOffset == FIX_SYM_PROCESS_LEVEL_HEAP || heapOffset == FIX_SYM_LOADING_LEVEL) {
     // it's a kheap, so just kmalloc.
-
-    if (!type) {  // no type given, just call it a global-object
-      return kmalloc(*Ptr<Ptr<kheapinfo>>(heapSymbol), size, KMALLOC_MEMSET, "global-object")
-          .offset;
-    }
-
-    Ptr<Type> typ(type);
-    if (!typ->symbol.offset) {  // type doesn't have a symbol, just call it a global-object
-      return kmalloc(*Ptr<Ptr<kheapinfo>>(heapSymbol), size, KMALLOC_MEMSET, "global-object")
-          .offset;
-    }
-
-    Ptr<String> gstr = info(typ->symbol)->str;
-    if (!gstr->len) {  // string has nothing in it.
-      return kmalloc(*Ptr<Ptr<kheapinfo>>(heapSymbol), size, KMALLOC_MEMSET, "global-object")
-          .offset;
-    }
-
-    return kmalloc(*Ptr<Ptr<kheapinfo>>(heapSymbol), size, KMALLOC_MEMSET, gstr->data()).offset;
+    return kmalloc(*Ptr<Ptr<kheapinfo>>(heapSymbol), size, KMALLOC_MEMSET, alloc_name(type))
+        .offset;
   } else if (heapOffset == FIX_SYM_PROCESS_TYPE) {
     if (pp == UNKNOWN_PP) {
       // added
@@ -115,10 +119,18 @@ u64 alloc_from_heap(u32 heapSymbol, u32 type, s32 size, u32 pp) {
 
     // there's room, bump allocate
     if (allocEnd < heapEnd) {
+      if (g_kmalloc_stats.enabled()) {
+        g_kmalloc_stats.record(KmallocStats::PROCESS_HEAPS, alloc_name(type), alignedSize, 0,
+                               false);
+      }
       *Ptr<u32>(pp + 0x4c + 8) = allocEnd;
       memset(Ptr<u8>(start).c(), 0, (size_t)alignedSize);
       return start;
     } else {
+      if (g_kmalloc_stats.enabled()) {
+        g_kmalloc_stats.record(KmallocStats::PROCESS_HEAPS, alloc_name(type), alignedSize, 0,
+                               true);
+      }
       MsgErr("kmalloc: !alloc mem in heap for #<process @ #x%x> (%d bytes)\n", pp, alignedSize);
       return 0;
     }
@@ -619,13 +631,9 @@ Ptr<Symbol> find_symbol_in_area(u32 hash, const char* name, u32 start, u32 end)
 }
 
 /*!
- * Searches the table for a symbol.  If the symbol is found, returns it.
- * If not, returns 0, but symbol_slot will contain the slot for the symbol.
- * If both are 0, the symbol table is full and you are sad.
- * Also allows you to find the empty pair by searching for _empty_
+ * Probe the hash table for a symbol, see find_symbol_from_c.
  */
-Ptr<Symbol> find_symbol_from_c(const char* name) {
-  symbol_slot = 0;  // nowhere to put the symbol yet, clear any old symbol_slot result.
+Ptr<Symbol> probe_symbol_table(const char* name) {
   u32 hash = crc32((const u8*)name, (int)strlen(name));
 
   // check if we've got the empty pair.
@@ -677,6 +685,30 @@ Ptr<Symbol> find_symbol_from_c(const char* name) {
   }
 }
 
+/*!
+ * Searches the table for a symbol.  If the symbol is found, returns it.
+ * If not, returns 0, but symbol_slot will contain the slot for the symbol.
+ * If both are 0, the symbol table is full and you are sad.
+ * Also allows you to find the empty pair by searching for _empty_
+ * Symbols that have been found before come from g_symbol_index.
+ */
+Ptr<Symbol> find_symbol_from_c(const char* name) {
+  symbol_slot = 0;  // nowhere to put the symbol yet, clear any old symbol_slot result.
+  u32 indexed = g_symbol_index.find(name);
+  if (indexed) {
+    return Ptr<Symbol>(indexed);
+  }
+
+  Timer probe_timer;
+  auto sym = probe_symbol_table(name);
+  g_symbol_index.add_probe_time(probe_timer.getNs());
+  // the empty pair isn't a symbol, and has no name string.
+  if (sym.offset && sym.offset != s7.offset + FIX_SYM_EMPTY_PAIR) {
+    g_symbol_index.add(info(sym)->str->data(), sym.offset);
+  }
+  return sym;
+}
+
 /*!
  * Returns a symbol with the given name.  If this is the first time, make a new symbol, otherwise it
  * returns the old one. Basically a LISP symbol intern
@@ -1407,7 +1439,7 @@ s32 test_function(s32 arg0, s32 arg1, s32 arg2, s32 arg3) {
 s32 InitHeapAndSymbol() {
   Timer heap_init_timer;
   // reset all mips2c functions
-  Mips2C::gLinkedFunctionTable = {};
+  Mips2C::gLinkedFunctionTable.clear();
   // allocate memory for the symbol table
   auto symbol_table =
       kmalloc(kglobalheap, jak1::SYM_TABLE_MEM_SIZE, KMALLOC_MEMSET, "symbol-table").cast<u32>();
@@ -1419,6 +1451,7 @@ s32 InitHeapAndSymbol() {
   // the last symbol we will ever access.
   LastSymbol = symbol_table + SYM_TABLE_END * 8;
   NumSymbols = 0;
+  g_symbol_index.clear();
   // inform compiler the symbol table is reset, and where it is.
   reset_output();
 
@@ -1737,6 +1770,7 @@ s32 InitHeapAndSymbol() {
   // testing stuff:
   make_function_symbol_from_c("test-function", (void*)test_function);
 
+  g_symbol_index.log_stats();
   return 0;
 }
 
@@ -379,9 +379,15 @@ int InitMachine() {
     kinitheap(kdebugheap, Ptr<u8>(DEBUG_HEAP_START), jak2::DEBUG_HEAP_SIZE);
   }
   init_output();
-  InitIOP();
+  {
+    BootPhase phase("InitIOP");
+    InitIOP();
+  }
   // sceGsResetPath();
-  InitVideo();
+  {
+    BootPhase phase("InitVideo");
+    InitVideo();
+  }
   // FlushCache(0);
   // FlushCache(2);
   // sceGsSyncV(0);
@@ -389,22 +395,37 @@ int InitMachine() {
   //   MsgErr("dkernel: !init pad\n");
   // }
   if (MasterDebug) {
+    BootPhase phase("InitGoalProto");
     InitGoalProto();
   }
 
   printf("InitSound\n");
-  InitSound();
+  {
+    BootPhase phase("InitSound");
+    InitSound();
+  }
   printf("InitRPC\n");
-  InitRPC();
+  {
+    BootPhase phase("InitRPC");
+    InitRPC();
+  }
   reset_output();
   clear_print();
-  auto status = InitHeapAndSymbol();
+  int status;
+  {
+    BootPhase phase("InitHeapAndSymbol");
+    status = InitHeapAndSymbol();
+  }
   if (status >= 0) {
     printf("InitListenerConnect\n");
-    InitListenerConnect();
+    {
+      BootPhase phase("InitListenerConnect");
+      InitListenerConnect();
+    }
     printf("InitCheckListener\n");
     InitCheckListener();
     Msg(6, "kernel: machine started\n");
+    log_boot_phases();
     return 0;
   } else {
     return status;
@@ -595,6 +616,20 @@ void pc_set_levels(u32 lev_list) {
   Gfx::GetCurrentRenderer()->set_levels(levels);
 }
 
+void pc_prefetch_level(u32 lev) {
+  if (!Gfx::GetCurrentRenderer()) {
+    return;
+  }
+  std::string ls = Ptr<String>(lev).c()->data();
+
+  std::vector<std::string> levels;
+  if (ls != "none" && ls != "#f" && ls != "") {
+    levels.push_back(ls);
+  }
+
+  Gfx::GetCurrentRenderer()->prefetch_levels(levels);
+}
+
 void init_autosplit_struct() {
   gAutoSplitterBlock.pointer_to_symbol =
       (u64)g_ee_main_mem + (u64)intern_from_c("*autosplit-info-jak2*")->value();
@@ -635,6 +670,7 @@ void InitMachine_PCPort() {
       make_string_from_c);
 
   make_function_symbol_from_c("__pc-set-levels", (void*)pc_set_levels);
+  make_function_symbol_from_c("__pc-prefetch-level", (void*)pc_prefetch_level);
   make_function_symbol_from_c("__pc-get-tex-remap", (void*)lookup_jak2_texture_dest_offset);
   make_function_symbol_from_c("pc-init-autosplitter-struct", (void*)init_autosplit_struct);
 
@@ -716,7 +752,10 @@ void InitMachineScheme() {
   make_function_symbol_from_c("kernel-shutdown", (void*)KernelShutdown);
   make_function_symbol_from_c("aybabtu", (void*)aybabtu);  // was nothing function
 
-  InitMachine_PCPort();
+  {
+    BootPhase phase("InitMachine_PCPort");
+    InitMachine_PCPort();
+  }
 
   InitSoundScheme();
   intern_from_c("*stack-top*")->value() = 0x7f00000;
@@ -746,6 +785,7 @@ void InitMachineScheme() {
         new_pair(s7.offset + FIX_SYM_GLOBAL_HEAP, *((s7 + FIX_SYM_PAIR_TYPE - 1).cast<u32>()),
                  make_string_from_c("common"), kernel_packages->value());
     printf("calling play-boot!\n");
+    BootPhase phase("play-boot");
     call_goal_function_by_name("play-boot");  // new function for jak2!
   }
 }
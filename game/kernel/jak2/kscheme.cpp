@@ -8,6 +8,7 @@
 #include "common/goal_constants.h"
 #include "common/log/log.h"
 #include "common/symbols.h"
+#include "common/util/Timer.h"
 
 #include "game/kernel/common/fileio.h"
 #include "game/kernel/common/kdsnetm.h"
@@ -75,6 +76,27 @@ void fixed_sym_set(u32 offset, u32 value) {
   Ptr<Symbol4<u32>>(s7.offset + offset)->value() = value;
 }
 
+/*!
+ * The name of an allocation of a type, for kmalloc. Untyped memory and types without a name are
+ * called global-object.
+ */
+const char* alloc_name(u32 type) {
+  if (!type) {
+    return "global-object";
+  }
+
+  Ptr<Type> typ(type);
+  if (!typ->symbol.offset) {
+    return "global-object";
+  }
+
+  Ptr<String> gstr = sym_to_string(typ->symbol);
+  if (!gstr->len) {
+    return "global-object";
+  }
+  return gstr->data();
+}
+
 u64 alloc_from_heap(u32 heap_symbol, u32 type, s32 size, u32 pp) {
   using namespace jak2_symbols;
   auto heap_ptr = Ptr<Symbol4<Ptr<kheapinfo>>>(heap_symbol)->value();
@@ -84,31 +106,25 @@ u64 alloc_from_heap(u32 heap_symbol, u32 type, s32 size, u32 pp) {
       (heap_symbol == s7.offset + FIX_SYM_DEBUG) ||
       (heap_symbol == s7.offset + FIX_SYM_LOADING_LEVEL) ||
       (heap_symbol == s7.offset + FIX_SYM_PROCESS_LEVEL_HEAP)) {
-    if (!type) {  // no type given, just call it a global-object
-      return kmalloc(heap_ptr, size, KMALLOC_MEMSET, "global-object").offset;
-    }
-
-    Ptr<Type> typ(type);
-    if (!typ->symbol.offset) {  // type doesn't have a symbol, just call it a global-object
-      return kmalloc(heap_ptr, size, KMALLOC_MEMSET, "global-object").offset;
-    }
-
-    Ptr<String> gstr = sym_to_string(typ->symbol);
-    if (!gstr->len) {  // string has nothing in it.
-      return kmalloc(heap_ptr, size, KMALLOC_MEMSET, "global-object").offset;
-    }
-
-    return kmalloc(heap_ptr, size, KMALLOC_MEMSET, gstr->data()).offset;
+    return kmalloc(heap_ptr, size, KMALLOC_MEMSET, alloc_name(type)).offset;
   } else if (heap_symbol == s7.offset + FIX_SYM_PROCESS_TYPE) {
     u32 start = *Ptr<u32>(pp + 0x64);
     u32 heapEnd = *Ptr<u32>(pp + 0x60);
     u32 allocEnd = start + aligned_size;
 
     if (allocEnd < heapEnd) {
+      if (g_kmalloc_stats.enabled()) {
+        g_kmalloc_stats.record(KmallocStats::PROCESS_HEAPS, alloc_name(type), aligned_size, 0,
+                               false);
+      }
       *Ptr<u32>(pp + 0x64) = allocEnd;
       memset(Ptr<u8>(start).c(), 0, aligned_size);
       return start;
     } else {
+      if (g_kmalloc_stats.enabled()) {
+        g_kmalloc_stats.record(KmallocStats::PROCESS_HEAPS, alloc_name(type), aligned_size, 0,
+                               true);
+      }
       MsgErr("kmalloc: !alloc mem in heap for #<process @ #x%x> (%d bytes)\n", pp, aligned_size);
       return 0;
     }
@@ -622,13 +638,9 @@ Ptr<Symbol4<u32>> find_symbol_in_area(u32 hash, const char* name, u32 start, u32
 }
 
 /*!
- * Searches the table for a symbol.  If the symbol is found, returns it.
- * If not, returns 0, but symbol_slot will contain the slot for the symbol.
- * If both are 0, the symbol table is full and you are sad.
- * Also allows you to find the empty pair by searching for _empty_
+ * Probe the hash table for a symbol, see find_symbol_from_c.
  */
-Ptr<Symbol4<u32>> find_symbol_from_c(const char* name) {
-  symbol_slot = 0;  // nowhere to put the symbol yet, clear any old symbol_slot result.
+Ptr<Symbol4<u32>> probe_symbol_table(const char* name) {
   u32 hash = crc32((const u8*)name, (int)strlen(name));
 
   // check if we've got the empty pair.
@@ -679,6 +691,30 @@ Ptr<Symbol4<u32>> find_symbol_from_c(const char* name) {
   }
 }
 
+/*!
+ * Searches the table for a symbol.  If the symbol is found, returns it.
+ * If not, returns 0, but symbol_slot will contain the slot for the symbol.
+ * If both are 0, the symbol table is full and you are sad.
+ * Also allows you to find the empty pair by searching for _empty_
+ * Symbols that have been found before come from g_symbol_index.
+ */
+Ptr<Symbol4<u32>> find_symbol_from_c(const char* name) {
+  symbol_slot = 0;  // nowhere to put the symbol yet, clear any old symbol_slot result.
+  u32 indexed = g_symbol_index.find(name);
+  if (indexed) {
+    return Ptr<Symbol4<u32>>(indexed);
+  }
+
+  Timer probe_timer;
+  auto sym = probe_symbol_table(name);
+  g_symbol_index.add_probe_time(probe_timer.getNs());
+  // the empty pair isn't a symbol, and has no name string.
+  if (sym.offset && sym.offset != s7.offset + S7_OFF_FIX_SYM_EMPTY_PAIR) {
+    g_symbol_index.add(sym_to_string(sym)->data(), sym.offset);
+  }
+  return sym;
+}
+
 /*!
  * Returns a symbol with the given name.  If this is the first time, make a new symbol, otherwise it
  * returns the old one. Basically a LISP symbol intern
@@ -1452,6 +1488,7 @@ int InitHeapAndSymbol() {
   SymbolTable2 = symbol_table + 5;
   s7 = symbol_table + 0x8001;
   NumSymbols = 0;
+  g_symbol_index.clear();
 
   // inform compiler of s7
   reset_output();
@@ -1749,6 +1786,7 @@ int InitHeapAndSymbol() {
   // Do final initialization, including loading and initializing the engine.
   InitMachineScheme();
   kmemclose();
+  g_symbol_index.log_stats();
   return 0;
 }
 
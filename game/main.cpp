@@ -43,6 +43,8 @@ void setup_logging(bool verbose) {
     lg::set_flush_level(lg::level::warn);
   }
   lg::initialize();
+  // the overlord and loader threads log in places that shouldn't wait on a slow console.
+  lg::start_async();
 }
 
 std::string game_arg_documentation() {
@@ -90,6 +92,14 @@ int main(int argc, char** argv) {
   bool disable_display = false;
   bool enable_debug_vm = false;
   bool enable_profiling = false;
+  bool iop_dgo_loads = false;
+  int print_interval_ms = 0;
+  bool null_renderer = false;
+  int benchmark_frames = 0;
+  int benchmark_warmup_frames = 0;
+  std::string benchmark_csv_path;
+  std::string pad_record_path;
+  std::string pad_playback_path;
   int port_number = -1;
   fs::path project_path_override;
   std::vector<std::string> game_args;
@@ -104,8 +114,23 @@ int main(int argc, char** argv) {
   app.add_flag("--no-display", disable_display, "Disable video display");
   app.add_flag("--vm", enable_debug_vm, "Enable debug PS2 VM (defaulted to off)");
   app.add_flag("--profile", enable_profiling, "Enables profiling immediately from startup");
+  app.add_flag("--iop-dgo", iop_dgo_loads, "Load DGOs through the emulated overlord");
+  app.add_option("--print-interval", print_interval_ms,
+                 "Milliseconds to hold prints sent to the listener so they can be batched");
   app.add_option("--proj-path", project_path_override,
                  "Specify the location of the 'data/' folder");
+  app.add_flag("--null-renderer", null_renderer,
+               "Run without a window or GPU, only reading the DMA chains");
+  app.add_option("--benchmark-frames", benchmark_frames,
+                 "Print the EE, IOP and render CPU time of this many frames, then exit. The frame "
+                 "rate isn't limited");
+  app.add_option("--benchmark-warmup", benchmark_warmup_frames,
+                 "Frames to run before the benchmark frames");
+  app.add_option("--benchmark-csv", benchmark_csv_path,
+                 "Also write the time of each benchmark frame to this csv file");
+  app.add_option("--record-pad", pad_record_path, "Record the pad input to this file");
+  app.add_option("--play-pad", pad_playback_path,
+                 "Play back pad input from --record-pad instead of the real input");
   app.footer(game_arg_documentation());
   app.add_option("Game Args", game_args,
                  "Remaining arguments (after '--') that are passed-through to the game itself");
@@ -123,6 +148,14 @@ int main(int argc, char** argv) {
   GameLaunchOptions game_options;
   game_options.disable_debug_vm = !enable_debug_vm;
   game_options.disable_display = disable_display;
+  game_options.direct_dgo_loads = !iop_dgo_loads;
+  game_options.listener_print_interval_ms = print_interval_ms;
+  game_options.null_renderer = null_renderer;
+  game_options.benchmark_frames = benchmark_frames;
+  game_options.benchmark_warmup_frames = benchmark_warmup_frames;
+  game_options.benchmark_csv_path = benchmark_csv_path;
+  game_options.pad_record_path = pad_record_path;
+  game_options.pad_playback_path = pad_playback_path;
   game_options.game_version = game_name_to_version(game_name);
   game_options.server_port =
       port_number == -1 ? DECI2_PORT - 1 + (int)game_options.game_version : port_number;
@@ -0,0 +1,108 @@
+#pragma once
+
+/*!
+ * @file bones_native.h
+ * Hand-written version of bones-mtx-calc, which computes the skinning matrices that merc uses for
+ * every bone of every foreground object. The original streams the joints and bones through the
+ * scratchpad in batches of 16 and does the math in a VU0 micro program. This reads them from main
+ * memory and writes the matrices straight to the matrix area. The only difference between jak 1 and
+ * jak 2 is the size of a bone.
+ */
+
+#include <immintrin.h>
+
+#include "common/common_types.h"
+
+#include "game/mips2c/native_mode.h"
+
+namespace Mips2C::bones_native {
+
+inline std::atomic<NativeMode>& g_mode = native_mode(NativeGroup::BONES);
+
+// the output for one bone, in the matrix area.
+struct SkinningMatrix {
+  float matrix[4][4];
+  // the inverse transpose of the matrix, for normals. Only the rotation part.
+  float normal[3][4];
+  float pad[4];
+};
+static_assert(sizeof(SkinningMatrix) == 128);
+
+// the bind pose matrix of a joint, from its GOAL pointer.
+constexpr u32 JOINT_BIND_POSE_OFFSET = 12;
+constexpr u32 JOINT_STRIDE = 80;
+// bone, which is 16 bytes smaller in jak 2.
+constexpr u32 JAK1_BONE_STRIDE = 96;
+constexpr u32 JAK2_BONE_STRIDE = 80;
+
+/*!
+ * acc = rows[0] * v.x + rows[1] * v.y + rows[2] * v.z (+ rows[3] * v.w), in the VU's order.
+ */
+inline __m128 transform3(const __m128* rows, const float* v) {
+  __m128 acc = _mm_mul_ps(rows[0], _mm_set1_ps(v[0]));
+  acc = _mm_add_ps(acc, _mm_mul_ps(rows[1], _mm_set1_ps(v[1])));
+  return _mm_add_ps(acc, _mm_mul_ps(rows[2], _mm_set1_ps(v[2])));
+}
+
+inline __m128 transform4(const __m128* rows, const float* v) {
+  return _mm_add_ps(transform3(rows, v), _mm_mul_ps(rows[3], _mm_set1_ps(v[3])));
+}
+
+/*!
+ * a x b, done like opmula/opmsub: a.yzx * b.zxy - b.yzx * a.zxy.
+ */
+inline void cross(float* out, const float* a, const float* b) {
+  out[0] = a[1] * b[2] - b[1] * a[2];
+  out[1] = a[2] * b[0] - b[2] * a[0];
+  out[2] = a[0] * b[1] - b[0] * a[1];
+}
+
+/*!
+ * bones-mtx-calc: for each bone, the skinning matrix is bind pose * bone transform * camera, and
+ * the normal matrix is the inverse transpose of the rotation, times the rotation of the camera.
+ * Bone i uses the bind pose of (-> joints (+ i -1)), and the bones are bone_stride bytes apart.
+ */
+inline void bones_mtx_calc(u32 matrix_area,
+                           u32 joints,
+                           u32 bones,
+                           s64 count,
+                           u32 camera,
+                           u32 bone_stride) {
+  const auto* cam = ee_ptr<float>(camera);
+  const __m128 cam_rows[4] = {_mm_loadu_ps(cam), _mm_loadu_ps(cam + 4), _mm_loadu_ps(cam + 8),
+                              _mm_loadu_ps(cam + 12)};
+  // the original masks off the uncached bit before DMAing.
+  const u32 joint_addr = (joints & 0x7fffffff) + JOINT_BIND_POSE_OFFSET - JOINT_STRIDE;
+  const u32 bone_addr = bones & 0x7fffffff;
+  auto* out = ee_ptr<SkinningMatrix>(matrix_area);
+
+  for (s64 i = 0; i < count; i++) {
+    const auto* bind_pose = ee_ptr<float>(joint_addr + JOINT_STRIDE * i);
+    const auto* bone = ee_ptr<float>(bone_addr + bone_stride * i);
+    const __m128 bone_rows[4] = {_mm_loadu_ps(bone), _mm_loadu_ps(bone + 4),
+                                 _mm_loadu_ps(bone + 8), _mm_loadu_ps(bone + 12)};
+
+    alignas(16) float m[4][4];
+    for (int r = 0; r < 4; r++) {
+      _mm_store_ps(m[r], transform4(bone_rows, bind_pose + 4 * r));
+    }
+
+    alignas(16) float n[3][4];
+    cross(n[0], m[1], m[2]);
+    cross(n[1], m[2], m[0]);
+    cross(n[2], m[0], m[1]);
+    const float det = (m[0][0] * n[0][0] + m[0][1] * n[0][1]) + m[0][2] * n[0][2];
+    const float inv_det = 1.f / det;
+
+    for (int r = 0; r < 4; r++) {
+      _mm_storeu_ps(out[i].matrix[r], transform4(cam_rows, m[r]));
+    }
+    for (int r = 0; r < 3; r++) {
+      float scaled[3] = {n[r][0] * inv_det, n[r][1] * inv_det, n[r][2] * inv_det};
+      _mm_storeu_ps(out[i].normal[r], transform3(cam_rows, scaled));
+    }
+    _mm_storeu_ps(out[i].pad, _mm_setzero_ps());
+  }
+}
+
+}  // namespace Mips2C::bones_native
@@ -0,0 +1,227 @@
+#pragma once
+
+/*!
+ * @file collide_native.h
+ * Hand-written versions of some of the collide cache and collide mesh mips2c functions. These are
+ * called many times per frame, and the translated versions run one VU0 instruction at a time
+ * through the ExecutionContext. The native versions work on the GOAL structures directly.
+ */
+
+#include <immintrin.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+#include "common/common_types.h"
+#include "common/util/Assert.h"
+
+#include "game/mips2c/native_mode.h"
+
+namespace Mips2C::collide_native {
+
+inline std::atomic<NativeMode>& g_mode = native_mode(NativeGroup::COLLIDE);
+
+// collide-puss-sphere
+struct PussSphere {
+  float bsphere[4];
+  s32 bbox_min[4];
+  s32 bbox_max[4];
+};
+static_assert(sizeof(PussSphere) == 48);
+
+// collide-puss-work. The layout is the same in jak 1 and jak 2.
+struct PussWork {
+  float closest_pt[4];
+  float tri_normal[4];
+  s32 tri_bbox_min[4];
+  s32 tri_bbox_max[4];
+  s32 spheres_bbox_min[4];
+  s32 spheres_bbox_max[4];
+  PussSphere spheres[64];
+};
+static_assert(sizeof(PussWork) == 0xc60);
+
+/*!
+ * (method 10 collide-puss-work): does the sphere overlap any of the first sphere_count spheres?
+ */
+inline bool puss_spheres_overlap(const PussWork* work, const float* sphere, u32 sphere_count) {
+  if (sphere_count == 0) {
+    return false;
+  }
+
+  // reject with the bounding box of all the spheres first. w isn't compared.
+  for (int i = 0; i < 3; i++) {
+    s32 sphere_min = sphere[i] - sphere[3];
+    s32 sphere_max = sphere[i] + sphere[3];
+    if (work->spheres_bbox_min[i] > sphere_max || sphere_min > work->spheres_bbox_max[i]) {
+      return false;
+    }
+  }
+
+  // the original subtracts the radius from vf0.w (1.0) rather than 0, so w is really compared
+  // against (r + s.w - 1). Keep that, it's what the game was tuned with.
+  const __m128 center = _mm_setr_ps(sphere[0], sphere[1], sphere[2], 1.f - sphere[3]);
+  for (u32 i = 0; i < sphere_count; i++) {
+    __m128 diff = _mm_sub_ps(_mm_loadu_ps(work->spheres[i].bsphere), center);
+    alignas(16) float sq[4];
+    _mm_store_ps(sq, _mm_mul_ps(diff, diff));
+    float dist = ((sq[0] + sq[1]) + sq[2]) - sq[3];
+    // the original checks the x and y lanes, which are equal, as a single 64-bit integer.
+    u32 bits;
+    memcpy(&bits, &dist, 4);
+    if ((s64)(((u64)bits << 32) | bits) <= 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/*!
+ * The number of vertices written by transform_frag_vertices. They're done in groups of 4, and
+ * there's always at least one group.
+ */
+inline u32 frag_vertices_written(u32 vertex_count) {
+  return vertex_count <= 4 ? 4 : (vertex_count + 3) & ~3u;
+}
+
+/*!
+ * (method 29 collide-cache): transform unpacked collide-frag vertices by the inverse matrix in
+ * collide-work and convert them to integers. Vertex i is read from spad + 16 + 32 * i and written
+ * to spad + 4096 + 32 * i.
+ */
+inline void transform_frag_vertices(const float* inv_mat, u8* spad, u32 vertex_count) {
+  const __m128 m0 = _mm_loadu_ps(inv_mat);
+  const __m128 m1 = _mm_loadu_ps(inv_mat + 4);
+  const __m128 m2 = _mm_loadu_ps(inv_mat + 8);
+  // multiplied by vf0.w = 1.0 on VU0.
+  const __m128 m3 = _mm_mul_ps(_mm_loadu_ps(inv_mat + 12), _mm_set1_ps(1.f));
+  u32 count = frag_vertices_written(vertex_count);
+  for (u32 i = 0; i < count; i++) {
+    const float* in = (const float*)(spad + 16 + 32 * i);
+    __m128 acc = _mm_add_ps(m3, _mm_mul_ps(m0, _mm_set1_ps(in[0])));
+    acc = _mm_add_ps(acc, _mm_mul_ps(m1, _mm_set1_ps(in[1])));
+    acc = _mm_add_ps(acc, _mm_mul_ps(m2, _mm_set1_ps(in[2])));
+    _mm_storeu_si128((__m128i*)(spad + 4096 + 32 * i), _mm_cvttps_epi32(acc));
+  }
+}
+
+// collide-mesh-cache-tri
+struct MeshCacheTri {
+  float vertex[3][4];
+  float normal[4];
+  s32 bbox_min[4];
+  s32 bbox_max[4];
+};
+static_assert(sizeof(MeshCacheTri) == 96);
+
+// collide-tri-result
+struct TriResult {
+  float vertex[3][4];
+  float intersect[4];
+  float normal[4];
+  u32 pat;
+};
+
+// the pat of a mesh cache tri is in the w of its normal.
+inline u32 mesh_tri_pat(const MeshCacheTri* tri) {
+  u32 pat;
+  memcpy(&pat, &tri->normal[3], 4);
+  return pat;
+}
+
+/*!
+ * (method 11 collide-mesh), should-push-away-test, and (method 12 collide-mesh),
+ * sphere-on-platform-test: find the triangle closest to the sphere that faces it, with the distance
+ * from the surface to the sphere in range, and store it in result. best is the distance to beat,
+ * and the new best is returned.
+ *
+ * The platform test also finds triangles up to 122.88 above the sphere, and only the ones with the
+ * pat mode set to ground or obstacle (0 or 16). The push away test only finds triangles the sphere
+ * is inside.
+ *
+ * The closest point is found with the GOAL closest-pt-in-triangle, through
+ * calls.closest_pt(out, point, tri, normal). out is scratch memory for one vector.
+ */
+template <bool PLATFORM, typename Calls>
+u64 mesh_sphere_test(u32 tri_count,
+                     u32 tris,
+                     TriResult* result,
+                     u32 sphere_addr,
+                     u64 best,
+                     u32 scratch,
+                     Calls& calls) {
+  const float* sphere = ee_ptr<float>(sphere_addr);
+  const float* closest = ee_ptr<float>(scratch);
+  float box_radius = sphere[3];
+  if constexpr (PLATFORM) {
+    box_radius = box_radius + 122.88f;
+  }
+  const __m128 center = _mm_loadu_ps(sphere);
+  const __m128i box_min = _mm_cvttps_epi32(_mm_sub_ps(center, _mm_set1_ps(box_radius)));
+  const __m128i box_max = _mm_cvttps_epi32(_mm_add_ps(center, _mm_set1_ps(box_radius)));
+
+  for (u32 i = 0; i < tri_count; i++) {
+    const u32 tri_addr = tris + sizeof(MeshCacheTri) * i;
+    const auto* tri = ee_ptr<MeshCacheTri>(tri_addr);
+    if constexpr (PLATFORM) {
+      u32 mode = mesh_tri_pat(tri) & 56;
+      if (mode != 0 && mode != 16) {
+        continue;
+      }
+    }
+
+    // reject with the bounding boxes. w isn't compared.
+    __m128i outside = _mm_or_si128(
+        _mm_cmpgt_epi32(_mm_loadu_si128((const __m128i*)tri->bbox_min), box_max),
+        _mm_cmpgt_epi32(box_min, _mm_loadu_si128((const __m128i*)tri->bbox_max)));
+    if (_mm_movemask_ps(_mm_castsi128_ps(outside)) & 0b111) {
+      continue;
+    }
+
+    calls.closest_pt(scratch, sphere_addr, tri_addr, tri_addr + offsetof(MeshCacheTri, normal));
+    const float* normal = tri->normal;
+    float diff[3];
+    for (int j = 0; j < 3; j++) {
+      diff[j] = sphere[j] - closest[j];
+    }
+    float dot = (diff[1] * normal[1] + diff[0] * normal[0]) + diff[2] * normal[2];
+    float len = std::sqrt(std::abs((diff[0] * diff[0] + diff[1] * diff[1]) + diff[2] * diff[2]));
+    float inv_len = 1.f / len;
+    // behind the triangle (including -0) counts as inside.
+    float dist = (std::signbit(dot) ? 0.f - len : len) - sphere[3];
+
+    float best_dist;
+    u32 best_bits = best;
+    memcpy(&best_dist, &best_bits, 4);
+    if (best_dist < dist) {
+      continue;
+    }
+    if constexpr (PLATFORM) {
+      if (122.88f <= dist || dist <= -1024.f) {
+        continue;
+      }
+    } else {
+      if (0.f <= dist) {
+        continue;
+      }
+    }
+    float facing = (diff[0] * inv_len * normal[0] + diff[1] * inv_len * normal[1]) +
+                   diff[2] * inv_len * normal[2];
+    if (facing < 0.707f) {
+      continue;
+    }
+
+    u32 dist_bits;
+    memcpy(&dist_bits, &dist, 4);
+    best = (s64)(s32)dist_bits;
+    memcpy(result->vertex, tri->vertex, sizeof(result->vertex));
+    memcpy(result->intersect, closest, 16);
+    memcpy(result->normal, normal, 12);
+    result->normal[3] = 1.f;
+    result->pat = mesh_tri_pat(tri);
+  }
+  return best;
+}
+
+}  // namespace Mips2C::collide_native
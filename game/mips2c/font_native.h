@@ -0,0 +1,211 @@
+#pragma once
+
+/*!
+ * @file font_native.h
+ * A hand-written version of jak 2's get-string-length. The menus and the text box code call it
+ * many times per string to lay out and wrap text, and the translated version runs the whole string
+ * parser one instruction at a time. This one reads the string and font-work directly, and leaves
+ * font-work the same way the original does.
+ */
+
+#include <cstring>
+
+#include "common/common_types.h"
+
+#include "game/mips2c/native_mode.h"
+
+namespace Mips2C::font_native {
+
+inline std::atomic<NativeMode>& g_mode = native_mode(NativeGroup::FONT);
+
+// font-flags
+constexpr u32 FONT_FLAG_KERNING = 2;
+constexpr u32 FONT_FLAG_LARGE = 32;
+// set while drawing a glyph from the extra pages (a 1, 2 or 3 byte before the character).
+constexpr u32 FONT_FLAG_PAGE = 64;
+
+// offsets in font-work
+constexpr u32 FONT_WORK_SIZE1_SMALL = 208;
+constexpr u32 FONT_WORK_SIZE2_SMALL = 224;
+constexpr u32 FONT_WORK_SIZE1_LARGE = 256;
+constexpr u32 FONT_WORK_SIZE2_LARGE = 272;
+constexpr u32 FONT_WORK_SIZE2 = 352;
+constexpr u32 FONT_WORK_SAVE = 464;
+constexpr u32 FONT_WORK_STR_PTR = 2876;
+constexpr u32 FONT_WORK_FLAGS = 2880;
+
+inline float load_float(const u8* src) {
+  float result;
+  memcpy(&result, src, 4);
+  return result;
+}
+
+/*!
+ * get-string-length: the width of the string, as drawn with the font-context's flags and scale.
+ * The ~ codes in the string are parsed like draw-string does, so font changes (~Nn), kerning (~Nk)
+ * and moves (~Nh, ~+Nh, ~-Nh) are included, and a newline restarts the width. Returns the same 64
+ * bits as the original: the width, and the y change from ~y/~z above it.
+ *
+ * The original's quirks are kept: a 0 digit after the first ends the code, and the byte after a
+ * 1, 2 or 3 is drawn even if it's the terminator.
+ */
+inline u64 get_string_length(u32 str,
+                             u32 context,
+                             u8* font_work,
+                             u32 font12_table,
+                             u32 font24_table,
+                             float relative_x_scale) {
+  const u8* ctx = ee_ptr<u8>(context);
+  // the origin is at 12, and the flags at 64.
+  float origin[4];
+  memcpy(origin, ctx + 12, 16);
+  float pos[4];
+  memcpy(pos, origin, 16);
+  u32 flags;
+  memcpy(&flags, ctx + 64, 4);
+  memcpy(font_work + FONT_WORK_STR_PTR, &str, 4);
+  memcpy(font_work + FONT_WORK_FLAGS, &flags, 4);
+
+  u32 table = 0;
+  float glyph_scale = 0;
+  auto set_font = [&](bool large) {
+    if (large) {
+      table = font24_table;
+      glyph_scale = load_float(font_work + FONT_WORK_SIZE1_LARGE + 12);
+      memmove(font_work + FONT_WORK_SIZE2, font_work + FONT_WORK_SIZE2_LARGE, 64);
+    } else {
+      table = font12_table;
+      glyph_scale = load_float(font_work + FONT_WORK_SIZE1_SMALL + 12);
+      for (int i = 0; i < 4; i++) {
+        memmove(font_work + FONT_WORK_SIZE2 + 16 * i, font_work + FONT_WORK_SIZE2_SMALL, 16);
+      }
+    }
+  };
+  set_font(flags & FONT_FLAG_LARGE);
+
+  const u8* chars = ee_ptr<u8>(str + 4);
+  auto add_glyph = [&](u8 c, u32 size2) {
+    float fixed_width = load_float(font_work + size2 + 12);
+    if ((flags & FONT_FLAG_KERNING) && !(flags & FONT_FLAG_PAGE)) {
+      pos[0] += load_float(ee_ptr<u8>(table + 16 * c) - 96 + 12) * glyph_scale;
+    } else {
+      pos[0] += fixed_width;
+    }
+  };
+
+  // returns the character to draw, or -1 if the code didn't draw anything. chars is left after the
+  // code, or on the terminator if the string ended.
+  auto parse_code = [&]() -> int {
+    u8 c = *chars;
+    if (c == 0) {
+      return -1;
+    }
+    chars++;
+    const u8 sign = (c == '+' || c == '-') ? c : 0;
+    s64 num = 0;
+    if (!sign) {
+      switch (c) {
+        case 'y':
+        case 'Y':
+          memcpy(font_work + FONT_WORK_SAVE, pos, 16);
+          return -1;
+        case 'z':
+        case 'Z':
+          memcpy(pos, font_work + FONT_WORK_SAVE, 16);
+          return -1;
+      }
+      if (c < '0' || c > '9') {
+        return c;
+      }
+      num = c - '0';
+    }
+
+    while (true) {
+      c = *chars;
+      if (c == 0) {
+        return -1;
+      }
+      chars++;
+      switch (c) {
+        case 'n':
+        case 'N':
+          set_font(num != 0);
+          flags = num ? (flags | FONT_FLAG_LARGE) : (flags & ~FONT_FLAG_LARGE);
+          return -1;
+        case 'k':
+        case 'K':
+          flags = num ? (flags | FONT_FLAG_KERNING) : (flags & ~FONT_FLAG_KERNING);
+          return -1;
+        case 'h':
+        case 'H': {
+          float offset = (s32)num;
+          if (!sign) {
+            pos[0] = 0.f + offset;
+          } else if (sign == '-') {
+            pos[0] -= offset;
+          } else {
+            pos[0] += offset;
+          }
+          return -1;
+        }
+        case 'l':
+        case 'L':
+        case 'w':
+        case 'W':
+        case 'j':
+        case 'J':
+        case 'v':
+        case 'V':
+        case 'u':
+        case 'U':
+        case '0':
+          return -1;
+      }
+      if (c < '0' || c > '9') {
+        return c;
+      }
+      // done with 32-bit shifts, like the original.
+      s64 num5 = num + (s32)((u32)num << 2);
+      num = (s32)((u32)num5 << 1) + (c - '0');
+    }
+  };
+
+  while (true) {
+    u8 c = *chars;
+    if (c == 0) {
+      break;
+    }
+    chars++;
+
+    if (c <= 3) {
+      flags |= FONT_FLAG_PAGE;
+      u32 size2 = FONT_WORK_SIZE2 + 16 * c;
+      add_glyph(*chars++, size2);
+      continue;
+    }
+
+    if (c == '~') {
+      int code_char = parse_code();
+      if (code_char < 0) {
+        continue;
+      }
+      c = code_char;
+    }
+
+    flags &= ~FONT_FLAG_PAGE;
+    if (c == '\n' || c == '\r') {
+      pos[0] = 0.f + origin[0];
+    } else {
+      add_glyph(c, FONT_WORK_SIZE2);
+    }
+  }
+
+  float width = ((pos[0] - origin[0]) * relative_x_scale) * load_float(ctx + 56);
+  float dy = pos[1] - origin[1];
+  u32 width_bits, dy_bits;
+  memcpy(&width_bits, &width, 4);
+  memcpy(&dy_bits, &dy, 4);
+  return ((u64)dy_bits << 32) | width_bits;
+}
+
+}  // namespace Mips2C::font_native
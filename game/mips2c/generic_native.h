@@ -0,0 +1,147 @@
+#pragma once
+
+/*!
+ * @file generic_native.h
+ * Hand-written versions of the generic effect mips2c functions. generic-light-proc runs on every
+ * vertex of merc models drawn with generic (envmapped, warped, ...), and the translated version
+ * does each group of 4 vertices one PS2 instruction at a time. The layouts are the same in jak 1
+ * and jak 2, but jak 1's generic-work starts 16 bytes into the scratchpad.
+ */
+
+#include <immintrin.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/common_types.h"
+
+#include "game/mips2c/native_mode.h"
+
+namespace Mips2C::generic_native {
+
+inline std::atomic<NativeMode>& g_mode = native_mode(NativeGroup::GENERIC);
+
+// the start of generic-saves
+struct GenericSaves {
+  u32 ptr_dma;
+  u32 ptr_vtxs;
+  u32 ptr_clrs;
+  u32 ptr_texs;
+  u32 ptr_env_clrs;
+  u32 ptr_env_texs;
+  u32 cur_outbuf;
+  u32 ptr_fx_buf;
+  u32 xor_outbufs;
+  s32 num_dps;
+  u32 qwc;
+  u32 gsf_buf;
+};
+
+// gsf-info, at the start of the gsf-buffer
+struct GsfInfo {
+  u32 ptr_iks;
+  u32 ptr_verts;
+};
+
+// gsf-vertex
+struct GsfVertex {
+  float pos[3];
+  u32 tex;
+  float nrm[3];
+  u8 clr[4];
+};
+static_assert(sizeof(GsfVertex) == 32);
+
+// vu-lights
+struct VuLights {
+  float direction[3][4];
+  float color[3][4];
+  float ambient[4];
+};
+
+// where generic-light-proc finds the lights and the color limit, relative to the scratchpad.
+constexpr u32 GENERIC_LIGHTS_OFFSET = 12688;
+constexpr u32 GENERIC_LIGHT_CONSTS_OFFSET = 12144;
+
+/*!
+ * The number of groups of 4 vertices written by light_vertices. There's always at least one.
+ */
+inline u32 light_groups(const GenericSaves* saves) {
+  return std::max(1, (saves->num_dps + 3) / 4);
+}
+
+// vu_min, which orders negative floats by their integer bits like VU0 does.
+inline __m128 vu_min(__m128 a, __m128 b) {
+  __m128i ai = _mm_castps_si128(a);
+  __m128i bi = _mm_castps_si128(b);
+  __m128i greater = _mm_cmpgt_epi32(ai, bi);
+  __m128i both_negative = _mm_srai_epi32(_mm_and_si128(ai, bi), 31);
+  // a if (a > b) == (both negative)
+  __m128i pick_b = _mm_xor_si128(greater, both_negative);
+  return _mm_blendv_ps(a, b, _mm_castsi128_ps(pick_b));
+}
+
+/*!
+ * generic-light-proc: for each vertex in the iks list, copy its position and tex to ptr-vtxs and
+ * ptr-texs, and light its color into ptr-clrs. Bit 8 of the ik goes in the low bit of tex. Vertices
+ * are done in groups of 4, and all 4 of the last group are written.
+ */
+inline void light_vertices(const GenericSaves* saves, const VuLights* lights, float max_color) {
+  const auto* gsf = ee_ptr<GsfInfo>(saves->gsf_buf);
+  const u8* iks = ee_ptr<u8>(gsf->ptr_iks);
+  u8* vtxs = ee_ptr<u8>(saves->ptr_vtxs);
+  u32* texs = ee_ptr<u32>(saves->ptr_texs);
+  u8* clrs = ee_ptr<u8>(saves->ptr_clrs);
+
+  const __m128 dir0 = _mm_loadu_ps(lights->direction[0]);
+  const __m128 dir1 = _mm_loadu_ps(lights->direction[1]);
+  const __m128 dir2 = _mm_loadu_ps(lights->direction[2]);
+  const __m128 color0 = _mm_loadu_ps(lights->color[0]);
+  const __m128 color1 = _mm_loadu_ps(lights->color[1]);
+  const __m128 color2 = _mm_loadu_ps(lights->color[2]);
+  // multiplied by vf0.w = 1.0 on VU0.
+  const __m128 ambient = _mm_mul_ps(_mm_loadu_ps(lights->ambient), _mm_set1_ps(1.f));
+  const __m128 limit = _mm_set1_ps(max_color);
+
+  u32 groups = light_groups(saves);
+  for (u32 g = 0; g < groups; g++) {
+    u16 ik[4];
+    memcpy(ik, iks + 8 * g, 8);
+    for (int i = 0; i < 4; i++) {
+      u32 addr = gsf->ptr_verts + 32 * (ik[i] & 0xff);
+      // loaded with lq, which ignores the low 4 bits.
+      GsfVertex vtx;
+      memcpy(&vtx, ee_ptr<u8>(addr & ~15), 16);
+      memcpy(vtx.nrm, ee_ptr<u8>((addr + 16) & ~15), 16);
+
+      memcpy(vtxs + 12 * i, vtx.pos, 12);
+      texs[i] = (vtx.tex & 0xfffefffe) | ((ik[i] >> 8) & 1);
+
+      __m128 light = _mm_add_ps(_mm_mul_ps(dir0, _mm_set1_ps(vtx.nrm[0])),
+                                _mm_mul_ps(dir1, _mm_set1_ps(vtx.nrm[1])));
+      light = _mm_add_ps(light, _mm_mul_ps(dir2, _mm_set1_ps(vtx.nrm[2])));
+      light = _mm_max_ps(light, _mm_setzero_ps());
+      alignas(16) float dot[4];
+      _mm_store_ps(dot, light);
+      __m128 rgba = _mm_add_ps(ambient, _mm_mul_ps(color0, _mm_set1_ps(dot[0])));
+      rgba = _mm_add_ps(rgba, _mm_mul_ps(color1, _mm_set1_ps(dot[1])));
+      rgba = _mm_add_ps(rgba, _mm_mul_ps(color2, _mm_set1_ps(dot[2])));
+
+      u32 clr_bits;
+      memcpy(&clr_bits, vtx.clr, 4);
+      __m128 clr = _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(clr_bits)));
+      clr = vu_min(_mm_mul_ps(clr, rgba), limit);
+      // ftoi0, then the low byte of each.
+      __m128i clr_int = _mm_cvttps_epi32(clr);
+      clr_int = _mm_shuffle_epi8(clr_int, _mm_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1,
+                                                        -1, -1, -1, -1, -1));
+      clr_bits = _mm_cvtsi128_si32(clr_int);
+      memcpy(clrs + 4 * i, &clr_bits, 4);
+    }
+    vtxs += 48;
+    texs += 4;
+    clrs += 16;
+  }
+}
+
+}  // namespace Mips2C::generic_native
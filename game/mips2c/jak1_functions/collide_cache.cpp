@@ -2,6 +2,7 @@
 #include "common/dma/gs.h"
 
 #include "game/kernel/jak1/kscheme.h"
+#include "game/mips2c/collide_native.h"
 #include "game/mips2c/mips2c_private.h"
 using namespace jak1;
 
@@ -1380,7 +1381,7 @@ struct Cache {
   void* fake_scratchpad_data;
 } cache;
 
-u64 execute(void* ctxt) {
+u64 execute_mips2c(void* ctxt) {
   auto* c = (ExecutionContext*)ctxt;
   bool bc = false;
   // u32 call_addr = 0;
@@ -1550,6 +1551,37 @@ u64 execute(void* ctxt) {
   return c->gprs[v0].du64[0];
 }
 
+// clang-format on
+u64 execute(void* ctxt) {
+  auto* c = (ExecutionContext*)ctxt;
+  const NativeMode mode = collide_native::g_mode;
+  if (mode == NativeMode::MIPS2C) {
+    return execute_mips2c(ctxt);
+  }
+  u32 work_addr, spad_addr;
+  memcpy(&work_addr, cache.collide_work, 4);
+  memcpy(&spad_addr, cache.fake_scratchpad_data, 4);
+  const auto* inv_mat = (const float*)(g_ee_main_mem + work_addr + 48);
+  u8* spad = g_ee_main_mem + spad_addr;
+  u32 vertex_count = g_ee_main_mem[c->gpr_addr(a1) + 24];
+  collide_native::transform_frag_vertices(inv_mat, spad, vertex_count);
+
+  if (mode == NativeMode::CHECK) {
+    u32 count = collide_native::frag_vertices_written(vertex_count);
+    std::vector<u128> native(count);
+    for (u32 i = 0; i < count; i++) {
+      memcpy(&native[i], spad + 4096 + 32 * i, 16);
+    }
+    execute_mips2c(ctxt);
+    for (u32 i = 0; i < count; i++) {
+      ASSERT_MSG(!memcmp(&native[i], spad + 4096 + 32 * i, 16),
+                 fmt::format("collide-cache method 29 mismatch on vertex {}", i));
+    }
+  }
+  return 0;
+}
+// clang-format off
+
 void link() {
   cache.collide_work = intern_from_c("*collide-work*").c();
   cache.fake_scratchpad_data = intern_from_c("*fake-scratchpad-data*").c();
@@ -2908,7 +2940,7 @@ void link() {
 
 namespace Mips2C::jak1 {
 namespace method_10_collide_puss_work {
-u64 execute(void* ctxt) {
+u64 execute_mips2c(void* ctxt) {
   auto* c = (ExecutionContext*)ctxt;
   bool bc = false;
   // u32 call_addr = 0;
@@ -3065,8 +3097,29 @@ u64 execute(void* ctxt) {
   return c->gprs[v0].du64[0];
 }
 
+// clang-format on
+u64 execute(u64 arg0, u64 arg1, u64 arg2, u64 arg3) {
+  const NativeMode mode = collide_native::g_mode;
+  if (mode == NativeMode::MIPS2C) {
+    return ArgsContext(arg0, arg1, arg2, arg3).run(execute_mips2c);
+  }
+  const auto* work = (const collide_native::PussWork*)(g_ee_main_mem + (u32)arg0);
+  const auto* sphere = (const float*)(g_ee_main_mem + (u32)arg1);
+  u32 sphere_count;
+  memcpy(&sphere_count, g_ee_main_mem + (u32)arg2 + 4, 4);
+  bool result = collide_native::puss_spheres_overlap(work, sphere, sphere_count);
+  u64 symbol_result = result ? ::s7.offset + 8 : ::s7.offset;
+
+  if (mode == NativeMode::CHECK) {
+    ASSERT_MSG(ArgsContext(arg0, arg1, arg2, arg3).run(execute_mips2c) == symbol_result,
+               "collide-puss-work method 10 mismatch");
+  }
+  return symbol_result;
+}
+// clang-format off
+
 void link() {
-  gLinkedFunctionTable.reg("(method 10 collide-puss-work)", execute, 128);
+  gLinkedFunctionTable.reg_args("(method 10 collide-puss-work)", execute);
 }
 
 } // namespace method_10_collide_puss_work
@@ -1,6 +1,7 @@
 //--------------------------MIPS2C---------------------
 
 #include "game/kernel/jak1/kscheme.h"
+#include "game/mips2c/collide_native.h"
 #include "game/mips2c/mips2c_private.h"
 using namespace jak1;
 // clang-format off
@@ -10,7 +11,7 @@ struct Cache {
   void* closest_pt_in_triangle; // closest-pt-in-triangle
 } cache;
 
-u64 execute(void* ctxt) {
+u64 execute_mips2c(void* ctxt) {
   auto* c = (ExecutionContext*)ctxt;
   bool bc = false;
   u32 call_addr = 0;
@@ -192,6 +193,46 @@ u64 execute(void* ctxt) {
   return c->gprs[v0].du64[0];
 }
 
+// clang-format on
+struct GoalCalls {
+  ExecutionContext* c;
+
+  void closest_pt(u32 out, u32 point, u32 tri, u32 normal) {
+    c->gprs[a0].du64[0] = out;
+    c->gprs[a1].du64[0] = point;
+    c->gprs[a2].du64[0] = tri;
+    c->gprs[a3].du64[0] = normal;
+    c->jalr(*(u32*)cache.closest_pt_in_triangle);
+  }
+};
+
+u64 execute(void* ctxt) {
+  auto* c = (ExecutionContext*)ctxt;
+  const NativeMode mode = collide_native::g_mode;
+  if (mode == NativeMode::MIPS2C) {
+    return execute_mips2c(ctxt);
+  }
+  u32 tri_count = *(u32*)(g_ee_main_mem + c->gpr_addr(a0) + 4);
+  u32 tris = c->gprs[a1].du32[0];
+  auto* result = (collide_native::TriResult*)(g_ee_main_mem + c->gpr_addr(a2));
+  u32 sphere = c->gprs[a3].du32[0];
+  u64 best = c->sgpr64(t0);
+  // the same scratch vector as the mips2c version, in its stack frame.
+  u32 scratch = c->gprs[sp].du32[0] - 160 + 16;
+  auto native = [&]() {
+    GoalCalls calls{c};
+    return collide_native::mesh_sphere_test<true>(tri_count, tris, result, sphere, best,
+                                                  scratch, calls);
+  };
+  if (mode == NativeMode::CHECK) {
+    return check_native("(method 12 collide-mesh)",
+                        {{result, sizeof(collide_native::TriResult)}}, native,
+                        [&]() { return execute_mips2c(ctxt); });
+  }
+  return native();
+}
+// clang-format off
+
 void link() {
   cache.closest_pt_in_triangle = intern_from_c("closest-pt-in-triangle").c();
   gLinkedFunctionTable.reg("(method 12 collide-mesh)", execute, 256);
@@ -210,7 +251,7 @@ struct Cache {
   void* closest_pt_in_triangle; // closest-pt-in-triangle
 } cache;
 
-u64 execute(void* ctxt) {
+u64 execute_mips2c(void* ctxt) {
   auto* c = (ExecutionContext*)ctxt;
   bool bc = false;
   u32 call_addr = 0;
@@ -368,6 +409,46 @@ u64 execute(void* ctxt) {
   return c->gprs[v0].du64[0];
 }
 
+// clang-format on
+struct GoalCalls {
+  ExecutionContext* c;
+
+  void closest_pt(u32 out, u32 point, u32 tri, u32 normal) {
+    c->gprs[a0].du64[0] = out;
+    c->gprs[a1].du64[0] = point;
+    c->gprs[a2].du64[0] = tri;
+    c->gprs[a3].du64[0] = normal;
+    c->jalr(*(u32*)cache.closest_pt_in_triangle);
+  }
+};
+
+u64 execute(void* ctxt) {
+  auto* c = (ExecutionContext*)ctxt;
+  const NativeMode mode = collide_native::g_mode;
+  if (mode == NativeMode::MIPS2C) {
+    return execute_mips2c(ctxt);
+  }
+  u32 tri_count = *(u32*)(g_ee_main_mem + c->gpr_addr(a0) + 4);
+  u32 tris = c->gprs[a1].du32[0];
+  auto* result = (collide_native::TriResult*)(g_ee_main_mem + c->gpr_addr(a2));
+  u32 sphere = c->gprs[a3].du32[0];
+  u64 best = c->sgpr64(t0);
+  // the same scratch vector as the mips2c version, in its stack frame.
+  u32 scratch = c->gprs[sp].du32[0] - 160 + 16;
+  auto native = [&]() {
+    GoalCalls calls{c};
+    return collide_native::mesh_sphere_test<false>(tri_count, tris, result, sphere, best,
+                                                   scratch, calls);
+  };
+  if (mode == NativeMode::CHECK) {
+    return check_native("(method 11 collide-mesh)",
+                        {{result, sizeof(collide_native::TriResult)}}, native,
+                        [&]() { return execute_mips2c(ctxt); });
+  }
+  return native();
+}
+// clang-format off
+
 void link() {
   cache.closest_pt_in_triangle = intern_from_c("closest-pt-in-triangle").c();
   gLinkedFunctionTable.reg("(method 11 collide-mesh)", execute, 512);
@@ -1,5 +1,6 @@
 //--------------------------MIPS2C---------------------
 #include "game/kernel/jak1/kscheme.h"
+#include "game/mips2c/joint_native.h"
 #include "game/mips2c/mips2c_private.h"
 using namespace jak1;
 // clang-format off
@@ -2038,7 +2039,7 @@ u32 jump_table_vals[16] = {
 
 namespace Mips2C::jak1 {
 namespace normalize_frame_quaternions {
-u64 execute(void* ctxt) {
+u64 execute_mips2c(void* ctxt) {
   auto* c = (ExecutionContext*)ctxt;
   bool bc = false;
   c->daddiu(sp, sp, -16);                           // daddiu sp, sp, -16
@@ -2084,6 +2085,35 @@ u64 execute(void* ctxt) {
   return c->gprs[v0].du64[0];
 }
 
+// clang-format on
+u64 execute(void* ctxt) {
+  auto* c = (ExecutionContext*)ctxt;
+  const NativeMode mode = joint_native::g_mode;
+  if (mode == NativeMode::MIPS2C) {
+    return execute_mips2c(ctxt);
+  }
+  u8* frame = g_ee_main_mem + c->gpr_addr(a0);
+  s64 joint_count = c->sgpr64(s2);
+  u32 size = joint_native::frame_accumulator_size(joint_count);
+  std::vector<u8> input;
+  std::vector<u8> reference;
+  if (mode == NativeMode::CHECK) {
+    input.assign(frame, frame + size);
+    execute_mips2c(ctxt);
+    reference.assign(frame, frame + size);
+    memcpy(frame, input.data(), size);
+  }
+  joint_native::normalize_frame_quaternions(frame, joint_count);
+  // the original counts s2 down to 0, and the caller shares our context.
+  c->gprs[s2].du64[0] = 0;
+  if (mode == NativeMode::CHECK) {
+    ASSERT_MSG(same_floats((const float*)frame, (const float*)reference.data(), size / 4),
+               "normalize-frame-quaternions mismatch");
+  }
+  return c->gprs[v0].du64[0];
+}
+// clang-format off
+
 } // namespace normalize_frame_quaternions
 } // namespace Mips2C
 
@@ -2092,7 +2122,7 @@ u64 execute(void* ctxt) {
 
 namespace Mips2C::jak1 {
 namespace clear_frame_accumulator {
-u64 execute(void* ctxt) {
+u64 execute_mips2c(void* ctxt) {
   auto* c = (ExecutionContext*)ctxt;
   bool bc = false;
   c->daddiu(sp, sp, -16);                           // daddiu sp, sp, -16
@@ -2143,6 +2173,34 @@ u64 execute(void* ctxt) {
   end_of_function:
   return c->gprs[v0].du64[0];
 }
+
+// clang-format on
+u64 execute(void* ctxt) {
+  auto* c = (ExecutionContext*)ctxt;
+  const NativeMode mode = joint_native::g_mode;
+  if (mode == NativeMode::MIPS2C) {
+    return execute_mips2c(ctxt);
+  }
+  u8* frame = g_ee_main_mem + c->gpr_addr(a0);
+  s64 joint_count = c->sgpr64(s2);
+  u32 size = joint_native::frame_accumulator_size(joint_count);
+  std::vector<u8> input;
+  std::vector<u8> reference;
+  if (mode == NativeMode::CHECK) {
+    input.assign(frame, frame + size);
+    execute_mips2c(ctxt);
+    reference.assign(frame, frame + size);
+    memcpy(frame, input.data(), size);
+  }
+  joint_native::clear_frame_accumulator(frame, joint_count);
+  // the original counts s2 down to 0, and the caller shares our context.
+  c->gprs[s2].du64[0] = 0;
+  if (mode == NativeMode::CHECK) {
+    ASSERT_MSG(!memcmp(frame, reference.data(), size), "clear-frame-accumulator mismatch");
+  }
+  return c->gprs[v0].du64[0];
+}
+// clang-format off
 } // namespace clear_frame_accumulator
 } // namespace Mips2C
 
@@ -2398,7 +2456,7 @@ void link() {
 
 namespace Mips2C::jak1 {
 namespace cspace_parented_transformq_joint {
-u64 execute(void* ctxt) {
+u64 execute_mips2c(void* ctxt) {
   auto* c = (ExecutionContext*)ctxt;
   bool bc = false;
   // nop                                            // sll r0, r0, 0
@@ -2524,6 +2582,33 @@ u64 execute(void* ctxt) {
   return c->gprs[v0].du64[0];
 }
 
+// clang-format on
+u64 execute(void* ctxt) {
+  auto* c = (ExecutionContext*)ctxt;
+  const NativeMode mode = joint_native::g_mode;
+  if (mode == NativeMode::MIPS2C) {
+    return execute_mips2c(ctxt);
+  }
+  u32 cspace = c->gpr_addr(a0);
+  u32 parent_cspace, parent_bone, bone;
+  memcpy(&parent_cspace, g_ee_main_mem + cspace, 4);
+  memcpy(&parent_bone, g_ee_main_mem + parent_cspace + 16, 4);
+  memcpy(&bone, g_ee_main_mem + cspace + 16, 4);
+  auto* out = (joint_native::Bone*)(g_ee_main_mem + bone);
+  joint_native::parented_transformq((const joint_native::Bone*)(g_ee_main_mem + parent_bone),
+                                    (const joint_native::TransformQ*)(g_ee_main_mem +
+                                                                      c->gpr_addr(a1)),
+                                    out, false);
+  if (mode == NativeMode::CHECK) {
+    joint_native::Bone native = *out;
+    execute_mips2c(ctxt);
+    ASSERT_MSG(same_floats(&native.transform[0][0], &out->transform[0][0], 20),
+               "cspace<-parented-transformq-joint! mismatch");
+  }
+  return c->gprs[v0].du64[0];
+}
+// clang-format off
+
 void link() {
   gLinkedFunctionTable.reg("cspace<-parented-transformq-joint!", execute, 128);
 }
@@ -1,6 +1,7 @@
 // clang-format off
 //--------------------------MIPS2C---------------------
 #include "game/mips2c/mips2c_private.h"
+#include "game/mips2c/ocean_native.h"
 #include "game/kernel/jak1/kscheme.h"
 using namespace jak1;
 namespace Mips2C::jak1 {
@@ -10,7 +11,7 @@ struct Cache {
   void* ocean_work; // *ocean-work*
 } cache;
 
-u64 execute(void* ctxt) {
+u64 execute_mips2c(void* ctxt) {
   auto* c = (ExecutionContext*)ctxt;
   bool bc = false;
   c->daddiu(sp, sp, -16);                           // daddiu sp, sp, -16
@@ -191,10 +192,46 @@ u64 execute(void* ctxt) {
   return c->gprs[v0].du64[0];
 }
 
+// clang-format on
+u64 execute(u64 arg0, u64 arg1, u64 arg2, u64 arg3) {
+  u32 frames, work;
+  memcpy(&frames, cache.ocean_wave_frames, 4);
+  memcpy(&work, cache.ocean_work, 4);
+  // (-> *ocean-work* interp), from the GOAL pointer.
+  auto* interp = ee_ptr<float>(work + 60);
+  auto* out = ee_ptr<float>(arg0);
+  auto native = [&]() {
+    constexpr u32 frame_mask = ocean_native::WAVE_FRAME_COUNT - 1;
+    constexpr u32 frame_size = ocean_native::WAVE_HEIGHT_COUNT;
+    s64 frame = (s64)arg1 >> 5;
+    interp[1] = 0.03125f * (float)(s32)(arg1 & 31);
+    interp[0] = 1.f - interp[1];
+    interp[0] = 0.333f * interp[0];
+    interp[1] = 0.333f * interp[1];
+    ocean_native::interp_wave(out, ee_ptr<s8>(frames + (frame & frame_mask) * frame_size),
+                              ee_ptr<s8>(frames + ((frame + 1) & frame_mask) * frame_size),
+                              interp[0], interp[1]);
+    return (u64)0;
+  };
+  auto mips2c = [&]() { return ArgsContext(arg0, arg1, arg2, arg3).run(execute_mips2c); };
+  switch (ocean_native::g_mode) {
+    case NativeMode::MIPS2C:
+      return mips2c();
+    case NativeMode::CHECK:
+      return check_native("ocean-interp-wave",
+                          {{out, ocean_native::WAVE_HEIGHT_COUNT * sizeof(float)},
+                           {interp, 2 * sizeof(float)}},
+                          native, mips2c);
+    default:
+      return native();
+  }
+}
+// clang-format off
+
 void link() {
   cache.ocean_wave_frames = intern_from_c("*ocean-wave-frames*").c();
   cache.ocean_work = intern_from_c("*ocean-work*").c();
-  gLinkedFunctionTable.reg("ocean-interp-wave", execute, 256);
+  gLinkedFunctionTable.reg_args("ocean-interp-wave", execute);
 }
 
 } // namespace ocean_interp_wave
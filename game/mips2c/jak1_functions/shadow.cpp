@@ -2,6 +2,8 @@
 #include "game/kernel/jak1/kscheme.h"
 #include "game/mips2c/mips2c_private.h"
 using namespace jak1;
+#include "game/mips2c/shadow_native.h"
+using namespace Mips2C::shadow_native;
 namespace Mips2C::jak1 {
 // clang-format off
 namespace {
@@ -213,7 +215,7 @@ struct Cache {
   void* fake_scratchpad_data; // *fake-scratchpad-data*
 } cache;
 
-u64 execute(void* ctxt) {
+u64 execute_mips2c(void* ctxt) {
   auto* c = (ExecutionContext*)ctxt;
   bool bc = false;
   // nop                                            // sll r0, r0, 0
@@ -364,6 +366,39 @@ u64 execute(void* ctxt) {
   return c->gprs[v0].du64[0];
 }
 
+// clang-format on
+u64 execute(void* ctxt) {
+  auto* c = (ExecutionContext*)ctxt;
+  const NativeMode mode = shadow_native::g_mode;
+  if (mode == NativeMode::MIPS2C) {
+    return execute_mips2c(ctxt);
+  }
+  u32 frag_addr = c->gpr_addr(a0);
+  u32 dcache_addr = c->gpr_addr(a1);
+  auto* frag = ee_ptr<ShadowFragHeader>(frag_addr);
+  auto* dcache = ee_ptr<ShadowDcacheHeader>(dcache_addr);
+  u32 matrices = frag_addr + 16 * frag->qwc_data + SHADOW_MATRIX_OFFSET;
+  u8* verts = ee_ptr<u8>(frag_addr + frag->ofs_verts);
+  u32 size = 16 * frag->num_verts;
+  std::vector<u8> input;
+  std::vector<u8> reference;
+  if (mode == NativeMode::CHECK) {
+    input.assign(verts, verts + size);
+    execute_mips2c(ctxt);
+    reference.assign(verts, verts + size);
+    memcpy(verts, input.data(), size);
+  }
+  dcache->vtx_table = frag_addr + frag->ofs_verts;
+  xform_verts(frag, frag_addr, matrices);
+  if (mode == NativeMode::CHECK) {
+    ASSERT_MSG(same_floats((const float*)verts, (const float*)reference.data(), size / 4),
+               "shadow-xform-verts mismatch");
+  }
+  c->gprs[v0].du64[0] = 0;
+  return 0;
+}
+// clang-format off
+
 void link() {
   cache.fake_scratchpad_data = intern_from_c("*fake-scratchpad-data*").c();
   gLinkedFunctionTable.reg("shadow-xform-verts", execute, 128);
@@ -376,9 +411,11 @@ void link() {
 //--------------------------MIPS2C---------------------
 #include "game/mips2c/mips2c_private.h"
 
+#include "game/mips2c/shadow_native.h"
+using namespace Mips2C::shadow_native;
 namespace Mips2C::jak1 {
 namespace shadow_calc_dual_verts {
-u64 execute(void* ctxt) {
+u64 execute_mips2c(void* ctxt) {
   auto* c = (ExecutionContext*)ctxt;
   bool bc = false;
   // nop                                            // sll r0, r0, 0
@@ -572,6 +609,44 @@ u64 execute(void* ctxt) {
   return c->gprs[v0].du64[0];
 }
 
+// clang-format on
+u64 execute(void* ctxt) {
+  auto* c = (ExecutionContext*)ctxt;
+  const NativeMode mode = shadow_native::g_mode;
+  if (mode == NativeMode::MIPS2C) {
+    return execute_mips2c(ctxt);
+  }
+  u32 dcache_addr = c->gpr_addr(a1);
+  auto* dcache = ee_ptr<ShadowDcacheHeader>(dcache_addr);
+  u32 count = ee_ptr<ShadowFragHeader>(c->gpr_addr(a0))->num_verts;
+  u32 out_addr = (dcache->dcache_top + 15) & ~15;
+  u8* out = ee_ptr<u8>(out_addr);
+  u32 size = 16 * count;
+  ShadowDcacheHeader header_before, header_reference;
+  std::vector<u8> reference;
+  if (mode == NativeMode::CHECK) {
+    header_before = *dcache;
+    execute_mips2c(ctxt);
+    header_reference = *dcache;
+    reference.assign(out, out + size);
+    *dcache = header_before;
+  }
+  dcache->ptr_dual_verts = out_addr;
+  // center and plane
+  calc_dual_verts(ee_ptr<float>(dcache->vtx_table & ~15), count,
+                  ee_ptr<float>(dcache_addr + 64), ee_ptr<float>(dcache_addr + 80),
+                  (float*)out);
+  dcache->dcache_top = out_addr + size;
+  if (mode == NativeMode::CHECK) {
+    ASSERT_MSG(!memcmp(dcache, &header_reference, sizeof(ShadowDcacheHeader)) &&
+                   same_floats((const float*)out, (const float*)reference.data(), size / 4),
+               "shadow-calc-dual-verts mismatch");
+  }
+  c->gprs[v0].du64[0] = 0;
+  return 0;
+}
+// clang-format off
+
 void link() {
   gLinkedFunctionTable.reg("shadow-calc-dual-verts", execute, 128);
 }
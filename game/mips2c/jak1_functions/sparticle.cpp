@@ -1,6 +1,7 @@
 // clang-format off
 //--------------------------MIPS2C---------------------
 #include "game/mips2c/mips2c_private.h"
+#include "game/mips2c/sparticle_native.h"
 #include "game/kernel/jak1/kscheme.h"
 using namespace jak1;
 namespace Mips2C::jak1 {
@@ -12,7 +13,7 @@ struct Cache {
   void* sp_relaunch_particle_3d; // sp-relaunch-particle-3d
 } cache;
 
-u64 execute(void* ctxt) {
+u64 execute_mips2c(void* ctxt) {
   auto* c = (ExecutionContext*)ctxt;
   bool bc = false;
   u32 call_addr = 0;
@@ -357,6 +358,61 @@ u64 execute(void* ctxt) {
   return c->gprs[v0].du64[0];
 }
 
+// clang-format on
+/*!
+ * Calls from the native version back to GOAL.
+ */
+struct GoalCalls {
+  ExecutionContext* c;
+  u32 system;
+
+  void call(u32 func, u64 arg0, u64 arg1, u64 arg2, u64 arg3) {
+    c->gprs[a0].du64[0] = arg0;
+    c->gprs[a1].du64[0] = arg1;
+    c->gprs[a2].du64[0] = arg2;
+    c->gprs[a3].du64[0] = arg3;
+    c->jalr(func);
+  }
+  u32 symbol_func(void* sym) { return *(u32*)sym; }
+
+  void func(u32 cpuinfo, u32 sprite, u32 f) { call(f, system, cpuinfo, sprite, 0); }
+  void relaunch(u32 launcher, u32 cpuinfo, u32 sprite) {
+    call(symbol_func(cache.sp_relaunch_particle_3d), system, launcher, cpuinfo, sprite);
+  }
+  void free(u32 index, u32 cpuinfo, u32 sprite) {
+    call(symbol_func(cache.sp_free_particle), system, index, cpuinfo, sprite);
+  }
+};
+
+u64 execute(void* ctxt) {
+  auto* c = (ExecutionContext*)ctxt;
+  const NativeMode mode = sparticle_native::g_mode;
+  if (mode == NativeMode::MIPS2C) {
+    return execute_mips2c(ctxt);
+  }
+  c->load_symbol(v1, cache.sp_frame_time);
+  float frame[4];
+  memcpy(frame, g_ee_main_mem + c->gpr_addr(v1), 16);
+  const u32 cpuinfo = c->gprs[a1].du32[0];
+  const u32 sprite = c->gprs[a2].du32[0];
+  const u32 index = c->gprs[a3].du32[0];
+  const u32 count = c->gprs[t0].du32[0];
+  const bool paused = c->sgpr64(t1) != c->sgpr64(s7);
+  const u32 false_symbol = c->gprs[s7].du32[0];
+  auto native = [&](auto& calls) {
+    return sparticle_native::process_block_3d(cpuinfo, sprite, index, count, paused,
+                                              false_symbol, frame, calls);
+  };
+  if (mode == NativeMode::CHECK) {
+    return sparticle_native::check_process_block("sp-process-block-3d", cpuinfo, sprite, count,
+                                                 false_symbol, native,
+                                                 [&]() { return (u32)execute_mips2c(ctxt); });
+  }
+  GoalCalls calls{c, c->gprs[a0].du32[0]};
+  return native(calls);
+}
+// clang-format off
+
 void link() {
   cache.sp_frame_time = intern_from_c("*sp-frame-time*").c();
   cache.quaternion = intern_from_c("quaternion*!").c();
@@ -380,7 +436,7 @@ struct Cache {
   void* sp_relaunch_particle_2d; // sp-relaunch-particle-2d
 } cache;
 
-u64 execute(void* ctxt) {
+u64 execute_mips2c(void* ctxt) {
   auto* c = (ExecutionContext*)ctxt;
   bool bc = false;
   u32 call_addr = 0;
@@ -678,6 +734,64 @@ u64 execute(void* ctxt) {
   return c->gprs[v0].du64[0];
 }
 
+// clang-format on
+/*!
+ * Calls from the native version back to GOAL.
+ */
+struct GoalCalls {
+  ExecutionContext* c;
+  u32 system;
+
+  void call(u32 func, u64 arg0, u64 arg1, u64 arg2, u64 arg3) {
+    c->gprs[a0].du64[0] = arg0;
+    c->gprs[a1].du64[0] = arg1;
+    c->gprs[a2].du64[0] = arg2;
+    c->gprs[a3].du64[0] = arg3;
+    c->jalr(func);
+  }
+  u32 symbol_func(void* sym) { return *(u32*)sym; }
+
+  void func(u32 cpuinfo, u32 sprite, u32 f) { call(f, system, cpuinfo, sprite, 0); }
+  void relaunch(u32 launcher, u32 cpuinfo, u32 sprite) {
+    call(symbol_func(cache.sp_relaunch_particle_2d), system, launcher, cpuinfo, sprite);
+  }
+  void orbiter(u32 cpuinfo, u32 sprite) {
+    call(symbol_func(cache.sp_orbiter), system, cpuinfo, sprite, 0);
+  }
+  void free(u32 index, u32 cpuinfo, u32 sprite) {
+    call(symbol_func(cache.sp_free_particle), system, index, cpuinfo, sprite);
+  }
+};
+
+u64 execute(void* ctxt) {
+  auto* c = (ExecutionContext*)ctxt;
+  const NativeMode mode = sparticle_native::g_mode;
+  if (mode == NativeMode::MIPS2C) {
+    return execute_mips2c(ctxt);
+  }
+  c->load_symbol(v1, cache.sp_frame_time);
+  float frame[4];
+  memcpy(frame, g_ee_main_mem + c->gpr_addr(v1), 16);
+  const u32 cpuinfo = c->gprs[a1].du32[0];
+  const u32 sprite = c->gprs[a2].du32[0];
+  const u32 index = c->gprs[a3].du32[0];
+  const u32 count = c->gprs[t0].du32[0];
+  const bool paused = c->sgpr64(t1) != c->sgpr64(s7);
+  const u32 false_symbol = c->gprs[s7].du32[0];
+  auto native = [&](auto& calls) {
+    return sparticle_native::process_block_2d(cpuinfo, sprite, index, count, paused,
+                                              false_symbol, frame, calls);
+  };
+  if (mode == NativeMode::CHECK) {
+    return sparticle_native::check_process_block("sp-process-block-2d", cpuinfo, sprite, count,
+                                                 false_symbol, native,
+                                                 [&]() { return (u32)execute_mips2c(ctxt); });
+  }
+  GoalCalls calls{c, c->gprs[a0].du32[0]};
+  return native(calls);
+}
+// clang-format off
+
 void link() {
   cache.sp_frame_time = intern_from_c("*sp-frame-time*").c();
   cache.sp_free_particle = intern_from_c("sp-free-particle").c();
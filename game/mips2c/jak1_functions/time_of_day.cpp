@@ -3,6 +3,7 @@
 
 #include "game/kernel/jak1/kscheme.h"
 #include "game/mips2c/mips2c_private.h"
+#include "game/mips2c/time_of_day_native.h"
 using namespace jak1;
 
 // clang-format off
@@ -13,7 +14,7 @@ struct Cache {
   void* fake_scratchpad_data;  // *fake-scratchpad-data*
 } cache;
 
-u64 execute(void* ctxt) {
+u64 execute_mips2c(void* ctxt) {
   auto* c = (ExecutionContext*)ctxt;
   bool bc = false;
   c->daddiu(sp, sp, -16);                           // daddiu sp, sp, -16
@@ -262,6 +263,31 @@ u64 execute(void* ctxt) {
   return c->gprs[v0].du64[0];
 }
 
+// clang-format on
+u64 execute(void* ctxt) {
+  auto* c = (ExecutionContext*)ctxt;
+  const NativeMode mode = time_of_day_native::g_mode;
+  if (mode == NativeMode::MIPS2C) {
+    return execute_mips2c(ctxt);
+  }
+  u32 palette = c->gprs[a1].du32[0];
+  s32 height = *(s32*)(g_ee_main_mem + palette + time_of_day_native::PALETTE_HEIGHT_OFFSET);
+  s32 count = time_of_day_native::interp_color_count(height);
+  auto* out = (u32*)(g_ee_main_mem + c->gpr_addr(a0));
+  auto native = [&]() {
+    time_of_day_native::interp_colors(
+        out, g_ee_main_mem + palette + time_of_day_native::PALETTE_DATA_OFFSET,
+        g_ee_main_mem + c->gpr_addr(a2) + time_of_day_native::MOOD_ITIMES_OFFSET, count);
+    return 0;
+  };
+  if (mode == NativeMode::CHECK) {
+    return check_native("time-of-day-interp-colors-scratch", {{out, count * sizeof(u32)}}, native,
+                        [&]() { return execute_mips2c(ctxt); });
+  }
+  return native();
+}
+// clang-format off
+
 void link() {
   cache.fake_scratchpad_data = intern_from_c("*fake-scratchpad-data*").c();
   gLinkedFunctionTable.reg("time-of-day-interp-colors-scratch", execute, 512);
@@ -1,6 +1,7 @@
 
 //--------------------------MIPS2C---------------------
 // clang-format off
+#include "game/mips2c/bones_native.h"
 #include "game/mips2c/mips2c_private.h"
 #include "game/kernel/jak2/kscheme.h"
 using namespace jak2;
@@ -131,7 +132,7 @@ struct Cache {
   void* fake_scratchpad_data; // *fake-scratchpad-data*
 } cache;
 
-u64 execute(void* ctxt) {
+u64 execute_mips2c(void* ctxt) {
   auto* c = (ExecutionContext*)ctxt;
   bool bc = false;
   u32 madr, sadr, qwc;
@@ -666,6 +667,32 @@ u64 execute(void* ctxt) {
   return c->gprs[v0].du64[0];
 }
 
+// clang-format on
+u64 execute(void* ctxt) {
+  auto* c = (ExecutionContext*)ctxt;
+  const NativeMode mode = bones_native::g_mode;
+  if (mode == NativeMode::MIPS2C) {
+    return execute_mips2c(ctxt);
+  }
+  u32 matrix_area = c->gprs[a0].du32[0];
+  u32 joints = c->gprs[a1].du32[0];
+  u32 bones = c->gprs[a2].du32[0];
+  s64 count = c->sgpr64(a3);
+  u32 camera = c->gprs[t0].du32[0];
+  auto native = [&]() {
+    bones_native::bones_mtx_calc(matrix_area, joints, bones, count, camera,
+                                 bones_native::JAK2_BONE_STRIDE);
+    return 0;
+  };
+  if (mode == NativeMode::CHECK) {
+    u32 size = count > 0 ? count * sizeof(bones_native::SkinningMatrix) : 0;
+    return check_native("bones-mtx-calc", {{g_ee_main_mem + matrix_area, size}}, native,
+                        [&]() { return execute_mips2c(ctxt); });
+  }
+  return native();
+}
+// clang-format off
+
 void link() {
   cache.fake_scratchpad_data = intern_from_c("*fake-scratchpad-data*").c();
   gLinkedFunctionTable.reg("bones-mtx-calc", execute, 128);
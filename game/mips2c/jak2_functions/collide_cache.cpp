@@ -1694,12 +1694,13 @@ void link() {
 
 //--------------------------MIPS2C---------------------
 // clang-format off
+#include "game/mips2c/collide_native.h"
 #include "game/mips2c/mips2c_private.h"
 #include "game/kernel/jak2/kscheme.h"
 using ::jak2::intern_from_c;
 namespace Mips2C::jak2 {
 namespace method_10_collide_puss_work {
-u64 execute(void* ctxt) {
+u64 execute_mips2c(void* ctxt) {
   auto* c = (ExecutionContext*)ctxt;
   bool bc = false;
   // nop                                            // sll r0, r0, 0
@@ -1855,8 +1856,29 @@ u64 execute(void* ctxt) {
   return c->gprs[v0].du64[0];
 }
 
+// clang-format on
+u64 execute(u64 arg0, u64 arg1, u64 arg2, u64 arg3) {
+  const NativeMode mode = collide_native::g_mode;
+  if (mode == NativeMode::MIPS2C) {
+    return ArgsContext(arg0, arg1, arg2, arg3).run(execute_mips2c);
+  }
+  const auto* work = (const collide_native::PussWork*)(g_ee_main_mem + (u32)arg0);
+  const auto* sphere = (const float*)(g_ee_main_mem + (u32)arg1);
+  u32 sphere_count;
+  memcpy(&sphere_count, g_ee_main_mem + (u32)arg2 + 116, 4);
+  bool result = collide_native::puss_spheres_overlap(work, sphere, sphere_count);
+  u64 symbol_result = result ? ::s7.offset + 4 : ::s7.offset;
+
+  if (mode == NativeMode::CHECK) {
+    ASSERT_MSG(ArgsContext(arg0, arg1, arg2, arg3).run(execute_mips2c) == symbol_result,
+               "collide-puss-work method 10 mismatch");
+  }
+  return symbol_result;
+}
+// clang-format off
+
 void link() {
-  gLinkedFunctionTable.reg("(method 10 collide-puss-work)", execute, 256);
+  gLinkedFunctionTable.reg_args("(method 10 collide-puss-work)", execute);
 }
 
 } // namespace method_10_collide_puss_work
@@ -211,8 +211,10 @@ void link() {
 //--------------------------MIPS2C---------------------
 // clang-format off
 #include "game/mips2c/mips2c_private.h"
+#include "game/mips2c/font_native.h"
 #include "game/kernel/jak2/kscheme.h"
 using ::jak2::intern_from_c;
+using namespace Mips2C::font_native;
 namespace Mips2C::jak2 {
 namespace get_string_length {
 struct Cache {
@@ -222,7 +224,7 @@ struct Cache {
   void* video_params; // *video-params*
 } cache;
 
-u64 execute(void* ctxt) {
+u64 execute_mips2c(void* ctxt) {
   auto* c = (ExecutionContext*)ctxt;
   bool bc = false;
   // u32 call_addr = 0;
@@ -631,12 +633,42 @@ u64 execute(void* ctxt) {
   return c->gprs[v0].du64[0];
 }
 
+// clang-format on
+// the value of a cached symbol, like load_symbol2.
+u32 symbol_value(void* sym) {
+  u32 val;
+  memcpy(&val, (u8*)sym - 1, 4);
+  return val;
+}
+
+u64 execute(u64 arg0, u64 arg1, u64 arg2, u64 arg3) {
+  u8* font_work = ee_ptr<u8>(symbol_value(cache.font_work));
+  auto native = [&]() {
+    return font_native::get_string_length(
+        arg0, arg1, font_work, symbol_value(cache.font12_table), symbol_value(cache.font24_table),
+        *ee_ptr<float>(symbol_value(cache.video_params) + 16));
+  };
+  auto mips2c = [&]() { return ArgsContext(arg0, arg1, arg2, arg3).run(execute_mips2c); };
+  switch (font_native::g_mode) {
+    case NativeMode::MIPS2C:
+      return mips2c();
+    case NativeMode::CHECK:
+      return check_native("get-string-length",
+                          {{font_work + FONT_WORK_SIZE2, FONT_WORK_SAVE + 16 - FONT_WORK_SIZE2},
+                           {font_work + FONT_WORK_STR_PTR, 8}},
+                          native, mips2c);
+    default:
+      return native();
+  }
+}
+// clang-format off
+
 void link() {
   cache.font_work = intern_from_c("*font-work*").c();
   cache.font12_table = intern_from_c("*font12-table*").c();
   cache.font24_table = intern_from_c("*font24-table*").c();
   cache.video_params = intern_from_c("*video-params*").c();
-  gLinkedFunctionTable.reg("get-string-length", execute, 512);
+  gLinkedFunctionTable.reg_args("get-string-length", execute);
 }
 
 } // namespace get_string_length
@@ -4,6 +4,8 @@
 #include "game/mips2c/mips2c_private.h"
 #include "game/kernel/jak2/kscheme.h"
 using ::jak2::intern_from_c;
+#include "game/mips2c/generic_native.h"
+using namespace Mips2C::generic_native;
 namespace Mips2C::jak2 {
 namespace generic_light_proc {
 struct Cache {
@@ -115,7 +117,7 @@ void vcallms0(ExecutionContext* c) {
 }
 
 
-u64 execute(void* ctxt) {
+u64 execute_mips2c(void* ctxt) {
   auto* c = (ExecutionContext*)ctxt;
   bool bc = false;
   c->daddiu(sp, sp, -96);                           // daddiu sp, sp, -96
@@ -409,6 +411,35 @@ u64 execute(void* ctxt) {
   return c->gprs[v0].du64[0];
 }
 
+// clang-format on
+u64 execute(void* ctxt) {
+  auto* c = (ExecutionContext*)ctxt;
+  get_fake_spad_addr2(at, cache.fake_scratchpad_data, 0, c);
+  u32 spad = c->gpr_addr(at);
+  auto* saves = ee_ptr<GenericSaves>(spad);
+  auto native = [&]() {
+    light_vertices(saves, ee_ptr<VuLights>(spad + GENERIC_LIGHTS_OFFSET),
+                   *ee_ptr<float>(spad + GENERIC_LIGHT_CONSTS_OFFSET));
+    c->gprs[v0].du64[0] = 0;
+    return (u64)0;
+  };
+  switch (generic_native::g_mode) {
+    case NativeMode::MIPS2C:
+      return execute_mips2c(ctxt);
+    case NativeMode::CHECK: {
+      u32 groups = light_groups(saves);
+      return check_native("generic-light-proc",
+                          {{ee_ptr<u8>(saves->ptr_vtxs), 48 * groups},
+                           {ee_ptr<u8>(saves->ptr_texs), 16 * groups},
+                           {ee_ptr<u8>(saves->ptr_clrs), 16 * groups}},
+                          native, [&]() { return execute_mips2c(ctxt); });
+    }
+    default:
+      return native();
+  }
+}
+// clang-format off
+
 void link() {
   cache.fake_scratchpad_data = intern_from_c("*fake-scratchpad-data*").c();
   gLinkedFunctionTable.reg("generic-light-proc", execute, 128);
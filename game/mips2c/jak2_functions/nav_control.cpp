@@ -1,11 +1,13 @@
 //--------------------------MIPS2C---------------------
 // clang-format off
 #include "game/mips2c/mips2c_private.h"
+#include "game/mips2c/nav_native.h"
 #include "game/kernel/jak2/kscheme.h"
 using ::jak2::intern_from_c;
+using namespace Mips2C::nav_native;
 namespace Mips2C::jak2 {
 namespace method_39_nav_state {
-u64 execute(void* ctxt) {
+u64 execute_mips2c(void* ctxt) {
   auto* c = (ExecutionContext*)ctxt;
   bool bc = false;
   bool cop1_bc = false;
@@ -266,8 +268,24 @@ end_of_function:
   return c->gprs[v0].du64[0];
 }
 
+// clang-format on
+u64 execute(u64 arg0, u64 arg1, u64 arg2, u64 arg3) {
+  auto* state = ee_ptr<NavState>(arg0);
+  auto native = [&]() { return (u64)(limit_rotation(state) ? ::s7.offset + 4 : ::s7.offset); };
+  auto mips2c = [&]() { return ArgsContext(arg0, arg1, arg2, arg3).run(execute_mips2c); };
+  switch (nav_native::g_mode) {
+    case NativeMode::MIPS2C:
+      return mips2c();
+    case NativeMode::CHECK:
+      return check_native("(method 39 nav-state)", {{state->travel, 16}}, native, mips2c);
+    default:
+      return native();
+  }
+}
+// clang-format off
+
 void link() {
-  gLinkedFunctionTable.reg("(method 39 nav-state)", execute, 96);
+  gLinkedFunctionTable.reg_args("(method 39 nav-state)", execute);
 }
 
 } // namespace method_39_nav_state
@@ -1,11 +1,13 @@
 //--------------------------MIPS2C---------------------
 // clang-format off
 #include "game/mips2c/mips2c_private.h"
+#include "game/mips2c/nav_native.h"
 #include "game/kernel/jak2/kscheme.h"
 using ::jak2::intern_from_c;
+using namespace Mips2C::nav_native;
 namespace Mips2C::jak2 {
 namespace nav_state_patch_pointers {
-u64 execute(void* ctxt) {
+u64 execute_mips2c(void* ctxt) {
   auto* c = (ExecutionContext*)ctxt;
   c->lw(v1, 16, a0);                                // lw v1, 16(a0)
   c->daddu(a2, v1, a1);                             // daddu a2, v1, a1
@@ -42,8 +44,27 @@ u64 execute(void* ctxt) {
   return c->gprs[v0].du64[0];
 }
 
+// clang-format on
+u64 execute(u64 arg0, u64 arg1, u64 arg2, u64 arg3) {
+  auto* state = ee_ptr<NavState>(arg0);
+  auto native = [&]() {
+    patch_pointers(state, arg1, ::s7.offset);
+    return 0;
+  };
+  auto mips2c = [&]() { return ArgsContext(arg0, arg1, arg2, arg3).run(execute_mips2c); };
+  switch (nav_native::g_mode) {
+    case NativeMode::MIPS2C:
+      return mips2c();
+    case NativeMode::CHECK:
+      return check_native("nav-state-patch-pointers", {{state, sizeof(NavState)}}, native, mips2c);
+    default:
+      return native();
+  }
+}
+// clang-format off
+
 void link() {
-  gLinkedFunctionTable.reg("nav-state-patch-pointers", execute, 0);
+  gLinkedFunctionTable.reg_args("nav-state-patch-pointers", execute);
 }
 
 } // namespace nav_state_patch_pointers
@@ -174,7 +195,7 @@ void link() {
 } // namespace method_45_nav_mesh
 
 namespace method_20_nav_engine {
-u64 execute(void* ctxt) {
+u64 execute_mips2c(void* ctxt) {
   auto* c = (ExecutionContext*)ctxt;
   bool bc = false;
   c->lwu(v1, 8, a0);                                // lwu v1, 8(a0)
@@ -274,8 +295,30 @@ end_of_function:
   return c->gprs[v0].du64[0];
 }
 
+// clang-format on
+u64 execute(u64 arg0, u64 arg1, u64 arg2, u64 arg3) {
+  auto* engine = ee_ptr<NavEngine>(arg0);
+  auto* buf = ee_ptr<NavEngineSprBuffer>(arg1);
+  auto native = [&]() {
+    reloc_ptrs_to_spad(engine, buf, ::s7.offset);
+    return 0;
+  };
+  auto mips2c = [&]() { return ArgsContext(arg0, arg1, arg2, arg3).run(execute_mips2c); };
+  switch (nav_native::g_mode) {
+    case NativeMode::MIPS2C:
+      return mips2c();
+    case NativeMode::CHECK:
+      return check_native("(method 20 nav-engine)",
+                          {{ee_ptr<u8>(buf->spr_addr), sizeof(NavControl) * buf->nav_count}},
+                          native, mips2c);
+    default:
+      return native();
+  }
+}
+// clang-format off
+
 void link() {
-  gLinkedFunctionTable.reg("(method 20 nav-engine)", execute, 0);
+  gLinkedFunctionTable.reg_args("(method 20 nav-engine)", execute);
 }
 
 } // namespace method_20_nav_engine
@@ -839,7 +882,7 @@ void link() {
 } // namespace method_18_nav_engine
 
 namespace method_21_nav_engine {
-u64 execute(void* ctxt) {
+u64 execute_mips2c(void* ctxt) {
   auto* c = (ExecutionContext*)ctxt;
   bool bc = false;
   c->lwu(v1, 80, a0);                               // lwu v1, 80(a0)
@@ -931,8 +974,30 @@ end_of_function:
   return c->gprs[v0].du64[0];
 }
 
+// clang-format on
+u64 execute(u64 arg0, u64 arg1, u64 arg2, u64 arg3) {
+  auto* engine = ee_ptr<NavEngine>(arg0);
+  auto* buf = ee_ptr<NavEngineSprBuffer>(arg1);
+  auto native = [&]() {
+    reloc_ptrs_to_mem(engine, buf, ::s7.offset);
+    return 0;
+  };
+  auto mips2c = [&]() { return ArgsContext(arg0, arg1, arg2, arg3).run(execute_mips2c); };
+  switch (nav_native::g_mode) {
+    case NativeMode::MIPS2C:
+      return mips2c();
+    case NativeMode::CHECK:
+      return check_native("(method 21 nav-engine)",
+                          {{ee_ptr<u8>(buf->spr_addr), sizeof(NavControl) * buf->nav_count}},
+                          native, mips2c);
+    default:
+      return native();
+  }
+}
+// clang-format off
+
 void link() {
-  gLinkedFunctionTable.reg("(method 21 nav-engine)", execute, 0);
+  gLinkedFunctionTable.reg_args("(method 21 nav-engine)", execute);
 }
 
 } // namespace method_21_nav_engine
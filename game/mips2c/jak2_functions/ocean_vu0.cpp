@@ -1,6 +1,7 @@
 //--------------------------MIPS2C---------------------
 // clang-format off
 #include "game/mips2c/mips2c_private.h"
+#include "game/mips2c/ocean_native.h"
 #include "game/kernel/jak2/kscheme.h"
 using ::jak2::intern_from_c;
 namespace Mips2C::jak2 {
@@ -9,7 +10,7 @@ struct Cache {
   void* ocean_wave_frames; // *ocean-wave-frames*
 } cache;
 
-u64 execute(void* ctxt) {
+u64 execute_mips2c(void* ctxt) {
   auto* c = (ExecutionContext*)ctxt;
   bool bc = false;
   c->mtc1(f0, a2);                                  // mtc1 f0, a2
@@ -179,9 +180,48 @@ end_of_function:
   return c->gprs[v0].du64[0];
 }
 
+// clang-format on
+u64 execute(u64 arg0, u64 arg1, u64 arg2, u64 arg3) {
+  u32 frames;
+  memcpy(&frames, (u8*)cache.ocean_wave_frames - 1, 4);
+  // (-> ocean interp-wave)
+  auto* interp = ee_ptr<float>(arg0 + 144);
+  auto* out = ee_ptr<float>(arg1);
+  float frame_num, scale;
+  memcpy(&frame_num, &arg2, 4);
+  memcpy(&scale, &arg3, 4);
+  auto native = [&]() {
+    constexpr u32 frame_mask = ocean_native::WAVE_FRAME_COUNT - 1;
+    constexpr u32 frame_size = ocean_native::WAVE_HEIGHT_COUNT;
+    // frame-num is always below 64, so the original doesn't wrap the first frame.
+    s32 frame = (s32)frame_num;
+    interp[1] = frame_num - (float)frame;
+    interp[0] = 1.f - interp[1];
+    interp[0] = interp[0] * scale;
+    interp[1] = interp[1] * scale;
+    ocean_native::interp_wave(out, ee_ptr<s8>(frames + (s64)frame * frame_size),
+                              ee_ptr<s8>(frames + ((frame + 1) & frame_mask) * frame_size),
+                              interp[0], interp[1]);
+    return (u64)0;
+  };
+  auto mips2c = [&]() { return ArgsContext(arg0, arg1, arg2, arg3).run(execute_mips2c); };
+  switch (ocean_native::g_mode) {
+    case NativeMode::MIPS2C:
+      return mips2c();
+    case NativeMode::CHECK:
+      return check_native("(method 14 ocean)",
+                          {{out, ocean_native::WAVE_HEIGHT_COUNT * sizeof(float)},
+                           {interp, 2 * sizeof(float)}},
+                          native, mips2c);
+    default:
+      return native();
+  }
+}
+// clang-format off
+
 void link() {
   cache.ocean_wave_frames = intern_from_c("*ocean-wave-frames*").c();
-  gLinkedFunctionTable.reg("(method 14 ocean)", execute, 256);
+  gLinkedFunctionTable.reg_args("(method 14 ocean)", execute);
 }
 
 } // namespace method_14_ocean
@@ -194,7 +234,7 @@ void link() {
 using ::jak2::intern_from_c;
 namespace Mips2C::jak2 {
 namespace method_15_ocean {
-u64 execute(void* ctxt) {
+u64 execute_mips2c(void* ctxt) {
   auto* c = (ExecutionContext*)ctxt;
   bool bc = false;
   // nop                                            // sll r0, r0, 0
@@ -250,8 +290,28 @@ end_of_function:
   return c->gprs[v0].du64[0];
 }
 
+// clang-format on
+u64 execute(u64 arg0, u64 arg1, u64 arg2, u64 arg3) {
+  auto* dst = ee_ptr<float>(arg1);
+  auto native = [&]() {
+    ocean_native::add_waves(dst, ee_ptr<float>(arg2));
+    return (u64)0;
+  };
+  auto mips2c = [&]() { return ArgsContext(arg0, arg1, arg2, arg3).run(execute_mips2c); };
+  switch (ocean_native::g_mode) {
+    case NativeMode::MIPS2C:
+      return mips2c();
+    case NativeMode::CHECK:
+      return check_native("(method 15 ocean)",
+                          {{dst, ocean_native::WAVE_HEIGHT_COUNT * sizeof(float)}}, native, mips2c);
+    default:
+      return native();
+  }
+}
+// clang-format off
+
 void link() {
-  gLinkedFunctionTable.reg("(method 15 ocean)", execute, 128);
+  gLinkedFunctionTable.reg_args("(method 15 ocean)", execute);
 }
 
 } // namespace method_15_ocean
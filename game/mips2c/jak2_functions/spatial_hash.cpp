@@ -1,11 +1,13 @@
 //--------------------------MIPS2C---------------------
 // clang-format off
 #include "game/mips2c/mips2c_private.h"
+#include "game/mips2c/spatial_hash_native.h"
 #include "game/kernel/jak2/kscheme.h"
 using ::jak2::intern_from_c;
+using namespace Mips2C::spatial_hash_native;
 namespace Mips2C::jak2 {
 namespace method_18_grid_hash {
-u64 execute(void* ctxt) {
+u64 execute_mips2c(void* ctxt) {
   auto* c = (ExecutionContext*)ctxt;
   bool bc = false;
   c->lh(v1, 10, a0);                                // lh v1, 10(a0)
@@ -98,8 +100,29 @@ u64 execute(void* ctxt) {
   return c->gprs[v0].du64[0];
 }
 
+// clang-format on
+u64 execute(u64 arg0, u64 arg1, u64 arg2, u64 arg3) {
+  auto* grid = ee_ptr<GridHash>(arg0);
+  auto* box = ee_ptr<GridHashBox>(arg1);
+  s64 id = arg2;
+  auto native = [&]() {
+    set_id_in_box(grid, box, id);
+    return 0;
+  };
+  auto mips2c = [&]() { return ArgsContext(arg0, arg1, arg2, arg3).run(execute_mips2c); };
+  switch (spatial_hash_native::g_mode) {
+    case NativeMode::MIPS2C:
+      return mips2c();
+    case NativeMode::CHECK:
+      return check_native("(method 18 grid-hash)", {bucket_memory(grid)}, native, mips2c);
+    default:
+      return native();
+  }
+}
+// clang-format off
+
 void link() {
-  gLinkedFunctionTable.reg("(method 18 grid-hash)", execute, 128);
+  gLinkedFunctionTable.reg_args("(method 18 grid-hash)", execute);
 }
 
 } // namespace method_18_grid_hash
@@ -108,11 +131,13 @@ void link() {
 //--------------------------MIPS2C---------------------
 // clang-format off
 #include "game/mips2c/mips2c_private.h"
+#include "game/mips2c/spatial_hash_native.h"
 #include "game/kernel/jak2/kscheme.h"
 using ::jak2::intern_from_c;
+using namespace Mips2C::spatial_hash_native;
 namespace Mips2C::jak2 {
 namespace method_19_grid_hash {
-u64 execute(void* ctxt) {
+u64 execute_mips2c(void* ctxt) {
   auto* c = (ExecutionContext*)ctxt;
   bool bc = false;
   c->lh(v1, 10, a0);                                // lh v1, 10(a0)
@@ -205,8 +230,29 @@ u64 execute(void* ctxt) {
   return c->gprs[v0].du64[0];
 }
 
+// clang-format on
+u64 execute(u64 arg0, u64 arg1, u64 arg2, u64 arg3) {
+  auto* grid = ee_ptr<GridHash>(arg0);
+  auto* box = ee_ptr<GridHashBox>(arg1);
+  s64 id = arg2;
+  auto native = [&]() {
+    clear_id_in_box(grid, box, id);
+    return 0;
+  };
+  auto mips2c = [&]() { return ArgsContext(arg0, arg1, arg2, arg3).run(execute_mips2c); };
+  switch (spatial_hash_native::g_mode) {
+    case NativeMode::MIPS2C:
+      return mips2c();
+    case NativeMode::CHECK:
+      return check_native("(method 19 grid-hash)", {bucket_memory(grid)}, native, mips2c);
+    default:
+      return native();
+  }
+}
+// clang-format off
+
 void link() {
-  gLinkedFunctionTable.reg("(method 19 grid-hash)", execute, 128);
+  gLinkedFunctionTable.reg_args("(method 19 grid-hash)", execute);
 }
 
 } // namespace method_19_grid_hash
@@ -215,11 +261,13 @@ void link() {
 //--------------------------MIPS2C---------------------
 // clang-format off
 #include "game/mips2c/mips2c_private.h"
+#include "game/mips2c/spatial_hash_native.h"
 #include "game/kernel/jak2/kscheme.h"
 using ::jak2::intern_from_c;
+using namespace Mips2C::spatial_hash_native;
 namespace Mips2C::jak2 {
 namespace method_20_grid_hash {
-u64 execute(void* ctxt) {
+u64 execute_mips2c(void* ctxt) {
   auto* c = (ExecutionContext*)ctxt;
   bool bc = false;
   c->daddiu(sp, sp, -48);                           // daddiu sp, sp, -48
@@ -335,8 +383,30 @@ u64 execute(void* ctxt) {
   return c->gprs[v0].du64[0];
 }
 
+// clang-format on
+u64 execute(u64 arg0, u64 arg1, u64 arg2, u64 arg3) {
+  auto* grid = ee_ptr<GridHash>(arg0);
+  auto* box = ee_ptr<GridHashBox>(arg1);
+  u32 result = arg2;
+  auto native = [&]() {
+    search_box(grid, box, ee_ptr<u8>(result));
+    return (u64)result;
+  };
+  auto mips2c = [&]() { return ArgsContext(arg0, arg1, arg2, arg3).run(execute_mips2c); };
+  switch (spatial_hash_native::g_mode) {
+    case NativeMode::MIPS2C:
+      return mips2c();
+    case NativeMode::CHECK:
+      return check_native("(method 20 grid-hash)",
+                          {{ee_ptr<u8>(result), search_result_size(grid)}}, native, mips2c);
+    default:
+      return native();
+  }
+}
+// clang-format off
+
 void link() {
-  gLinkedFunctionTable.reg("(method 20 grid-hash)", execute, 128);
+  gLinkedFunctionTable.reg_args("(method 20 grid-hash)", execute);
 }
 
 } // namespace method_20_grid_hash
@@ -346,11 +416,13 @@ void link() {
 //--------------------------MIPS2C---------------------
 // clang-format off
 #include "game/mips2c/mips2c_private.h"
+#include "game/mips2c/spatial_hash_native.h"
 #include "game/kernel/jak2/kscheme.h"
 using ::jak2::intern_from_c;
+using namespace Mips2C::spatial_hash_native;
 namespace Mips2C::jak2 {
 namespace method_22_grid_hash {
-u64 execute(void* ctxt) {
+u64 execute_mips2c(void* ctxt) {
   auto* c = (ExecutionContext*)ctxt;
   // nop                                            // sll r0, r0, 0
   // nop                                            // sll r0, r0, 0
@@ -409,8 +481,29 @@ u64 execute(void* ctxt) {
   return c->gprs[v0].du64[0];
 }
 
+// clang-format on
+u64 execute(u64 arg0, u64 arg1, u64 arg2, u64 arg3) {
+  auto* grid = ee_ptr<GridHash>(arg0);
+  auto* box = ee_ptr<GridHashBox>(arg1);
+  auto* sphere = ee_ptr<float>(arg2);
+  auto native = [&]() {
+    sphere_to_grid_box(grid, box, sphere);
+    return 0;
+  };
+  auto mips2c = [&]() { return ArgsContext(arg0, arg1, arg2, arg3).run(execute_mips2c); };
+  switch (spatial_hash_native::g_mode) {
+    case NativeMode::MIPS2C:
+      return mips2c();
+    case NativeMode::CHECK:
+      return check_native("(method 22 grid-hash)", {{box, 8}}, native, mips2c);
+    default:
+      return native();
+  }
+}
+// clang-format off
+
 void link() {
-  gLinkedFunctionTable.reg("(method 22 grid-hash)", execute, 128);
+  gLinkedFunctionTable.reg_args("(method 22 grid-hash)", execute);
 }
 
 } // namespace method_22_grid_hash
@@ -573,11 +666,13 @@ void link() {
 //--------------------------MIPS2C---------------------
 // clang-format off
 #include "game/mips2c/mips2c_private.h"
+#include "game/mips2c/spatial_hash_native.h"
 #include "game/kernel/jak2/kscheme.h"
 using ::jak2::intern_from_c;
+using namespace Mips2C::spatial_hash_native;
 namespace Mips2C::jak2 {
 namespace method_33_sphere_hash {
-u64 execute(void* ctxt) {
+u64 execute_mips2c(void* ctxt) {
   auto* c = (ExecutionContext*)ctxt;
   bool bc = false;
   u32 call_addr = 0;
@@ -694,6 +789,30 @@ u64 execute(void* ctxt) {
   return c->gprs[v0].du64[0];
 }
 
+// clang-format on
+u64 execute(void* ctxt) {
+  auto* c = (ExecutionContext*)ctxt;
+  auto* hash = ee_ptr<SphereHash>(c->gpr_addr(a0));
+  auto* sphere = ee_ptr<float>(c->gpr_addr(a1));
+  s64 id = c->sgpr64(a2);
+  auto native = [&]() {
+    remove_by_id(hash, sphere, id);
+    return 0;
+  };
+  switch (spatial_hash_native::g_mode) {
+    case NativeMode::MIPS2C:
+      return execute_mips2c(ctxt);
+    case NativeMode::CHECK:
+      return check_native("(method 33 sphere-hash)",
+                          {{ee_ptr<u8>(c->gpr_addr(a0) + 4), 8},
+                           bucket_memory(&hash->grid)},
+                          native, [&]() { return execute_mips2c(ctxt); });
+    default:
+      return native();
+  }
+}
+// clang-format off
+
 void link() {
   gLinkedFunctionTable.reg("(method 33 sphere-hash)", execute, 128);
 }
@@ -704,15 +823,17 @@ void link() {
 //--------------------------MIPS2C---------------------
 // clang-format off
 #include "game/mips2c/mips2c_private.h"
+#include "game/mips2c/spatial_hash_native.h"
 #include "game/kernel/jak2/kscheme.h"
 using ::jak2::intern_from_c;
+using namespace Mips2C::spatial_hash_native;
 namespace Mips2C::jak2 {
 namespace method_29_sphere_hash {
 struct Cache {
   void* perf_stats; // *perf-stats*
 } cache;
 
-u64 execute(void* ctxt) {
+u64 execute_mips2c(void* ctxt) {
   auto* c = (ExecutionContext*)ctxt;
   bool bc = false;
   u32 call_addr = 0;
@@ -909,6 +1030,38 @@ u64 execute(void* ctxt) {
   return c->gprs[v0].du64[0];
 }
 
+// clang-format on
+u64 execute(void* ctxt) {
+  auto* c = (ExecutionContext*)ctxt;
+  auto* hash = ee_ptr<SphereHash>(c->gpr_addr(a0));
+  auto* sphere = ee_ptr<float>(c->gpr_addr(a1));
+  u64 mask = c->sgpr64(a2);
+  u8* out = ee_ptr<u8>(c->gpr_addr(a3));
+  s64 max_count = c->sgpr64(t0);
+  c->load_symbol2(v1, cache.perf_stats);
+  u8* perf_stat = ee_ptr<u8>(c->gpr_addr(v1) + 116);
+  auto native = [&]() {
+    perf_stat_begin(perf_stat);
+    s64 count = find_spheres_xz(hash, sphere, mask, out, max_count);
+    perf_stat_end(perf_stat);
+    return (u64)count;
+  };
+  switch (spatial_hash_native::g_mode) {
+    case NativeMode::MIPS2C:
+      return execute_mips2c(ctxt);
+    case NativeMode::CHECK:
+      return check_native("(method 29 sphere-hash)",
+                          {{ee_ptr<u8>(c->gpr_addr(a0) + 4), 8},
+                           {ee_ptr<u8>(hash->grid.work + 12), 32},
+                           {perf_stat, 40},
+                           {out, (size_t)std::max<s64>(0, max_count)}},
+                          native, [&]() { return execute_mips2c(ctxt); });
+    default:
+      return native();
+  }
+}
+// clang-format off
+
 void link() {
   cache.perf_stats = intern_from_c("*perf-stats*").c();
   gLinkedFunctionTable.reg("(method 29 sphere-hash)", execute, 256);
@@ -919,15 +1072,17 @@ void link() {
 //--------------------------MIPS2C---------------------
 // clang-format off
 #include "game/mips2c/mips2c_private.h"
+#include "game/mips2c/spatial_hash_native.h"
 #include "game/kernel/jak2/kscheme.h"
 using ::jak2::intern_from_c;
+using namespace Mips2C::spatial_hash_native;
 namespace Mips2C::jak2 {
 namespace method_30_sphere_hash {
 struct Cache {
   void* perf_stats; // *perf-stats*
 } cache;
 
-u64 execute(void* ctxt) {
+u64 execute_mips2c(void* ctxt) {
   auto* c = (ExecutionContext*)ctxt;
   bool bc = false;
   u32 call_addr = 0;
@@ -1120,6 +1275,36 @@ u64 execute(void* ctxt) {
   return c->gprs[v0].du64[0];
 }
 
+// clang-format on
+u64 execute(void* ctxt) {
+  auto* c = (ExecutionContext*)ctxt;
+  auto* hash = ee_ptr<SphereHash>(c->gpr_addr(a0));
+  auto* params = ee_ptr<FindNavSphereIdsParams>(c->gpr_addr(a1));
+  c->load_symbol2(v1, cache.perf_stats);
+  u8* perf_stat = ee_ptr<u8>(c->gpr_addr(v1) + 116);
+  auto native = [&]() {
+    perf_stat_begin(perf_stat);
+    find_nav_sphere_ids(hash, params);
+    perf_stat_end(perf_stat);
+    return 0;
+  };
+  switch (spatial_hash_native::g_mode) {
+    case NativeMode::MIPS2C:
+      return execute_mips2c(ctxt);
+    case NativeMode::CHECK:
+      return check_native("(method 30 sphere-hash)",
+                          {{ee_ptr<u8>(c->gpr_addr(a0) + 4), 8},
+                           {ee_ptr<u8>(hash->grid.work + 12), 32},
+                           {perf_stat, 40},
+                           {params, sizeof(*params)},
+                           {ee_ptr<u8>(params->array), (size_t)std::max<s16>(0, params->max_len)}},
+                          native, [&]() { return execute_mips2c(ctxt); });
+    default:
+      return native();
+  }
+}
+// clang-format off
+
 void link() {
   cache.perf_stats = intern_from_c("*perf-stats*").c();
   gLinkedFunctionTable.reg("(method 30 sphere-hash)", execute, 128);
@@ -1967,15 +2152,17 @@ void link() {
 //--------------------------MIPS2C---------------------
 // clang-format off
 #include "game/mips2c/mips2c_private.h"
+#include "game/mips2c/spatial_hash_native.h"
 #include "game/kernel/jak2/kscheme.h"
 using ::jak2::intern_from_c;
+using namespace Mips2C::spatial_hash_native;
 namespace Mips2C::jak2 {
 namespace method_36_spatial_hash {
 struct Cache {
   void* perf_stats; // *perf-stats*
 } cache;
 
-u64 execute(void* ctxt) {
+u64 execute_mips2c(void* ctxt) {
   auto* c = (ExecutionContext*)ctxt;
   bool bc = false;
   u32 call_addr = 0;
@@ -2161,6 +2348,37 @@ u64 execute(void* ctxt) {
   return c->gprs[v0].du64[0];
 }
 
+// clang-format on
+u64 execute(void* ctxt) {
+  auto* c = (ExecutionContext*)ctxt;
+  auto* hash = ee_ptr<SpatialHash>(c->gpr_addr(a0));
+  auto* sphere = ee_ptr<float>(c->gpr_addr(a1));
+  u32* out = ee_ptr<u32>(c->gpr_addr(a2));
+  s64 max_count = c->sgpr64(a3);
+  c->load_symbol2(v1, cache.perf_stats);
+  u8* perf_stat = ee_ptr<u8>(c->gpr_addr(v1) + 116);
+  auto native = [&]() {
+    perf_stat_begin(perf_stat);
+    s64 count = fill_actor_list_for_sphere(hash, sphere, out, max_count);
+    perf_stat_end(perf_stat);
+    return (u64)count;
+  };
+  switch (spatial_hash_native::g_mode) {
+    case NativeMode::MIPS2C:
+      return execute_mips2c(ctxt);
+    case NativeMode::CHECK:
+      return check_native("(method 36 spatial-hash)",
+                          {{ee_ptr<u8>(c->gpr_addr(a0) + 4), 8},
+                           {ee_ptr<u8>(hash->sphere.grid.work + 12), 32},
+                           {perf_stat, 40},
+                           {out, 4 * (size_t)std::max<s64>(0, max_count)}},
+                          native, [&]() { return execute_mips2c(ctxt); });
+    default:
+      return native();
+  }
+}
+// clang-format off
+
 void link() {
   cache.perf_stats = intern_from_c("*perf-stats*").c();
   gLinkedFunctionTable.reg("(method 36 spatial-hash)", execute, 256);
@@ -0,0 +1,178 @@
+#pragma once
+
+/*!
+ * @file joint_native.h
+ * Hand-written versions of the joint mips2c functions that run once per joint: building a bone
+ * matrix from its parent and a transformq, and clearing/normalizing the frame accumulator used by
+ * calc-animation-from-spr. The layouts are the same in jak 1 and jak 2.
+ */
+
+#include <immintrin.h>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "common/common_types.h"
+#include "common/util/Assert.h"
+
+#include "game/mips2c/native_mode.h"
+
+namespace Mips2C::joint_native {
+
+inline std::atomic<NativeMode>& g_mode = native_mode(NativeGroup::JOINT);
+
+// a joint in the frame accumulator, after the 128 byte header.
+struct AccumulatorJoint {
+  float trans[4];
+  float quat[4];
+  float scale[4];
+};
+static_assert(sizeof(AccumulatorJoint) == 48);
+
+// bone
+struct Bone {
+  float transform[4][4];
+  float scale[4];
+};
+
+// transformq
+struct TransformQ {
+  float trans[4];
+  float quat[4];
+  float scale[4];
+};
+
+/*!
+ * The number of bytes of the frame accumulator used by joint_count joints. The first two "joints"
+ * are the 128 byte header.
+ */
+inline u32 frame_accumulator_size(s64 joint_count) {
+  return 128 + (joint_count - 2) * sizeof(AccumulatorJoint);
+}
+
+/*!
+ * clear-frame-accumulator
+ */
+inline void clear_frame_accumulator(u8* frame, s64 joint_count) {
+  // the original loop always does one joint, and never ends if there isn't one.
+  ASSERT(joint_count > 2);
+  memset(frame, 0, frame_accumulator_size(joint_count));
+}
+
+/*!
+ * normalize-frame-quaternions: set w of trans and scale to 1 and normalize the quaternion.
+ */
+inline void normalize_frame_quaternions(u8* frame, s64 joint_count) {
+  ASSERT(joint_count > 2);
+  auto* joints = (AccumulatorJoint*)(frame + 128);
+  for (s64 i = 0; i < joint_count - 2; i++) {
+    auto& joint = joints[i];
+    joint.trans[3] = 1.f;
+    joint.scale[3] = 1.f;
+    __m128 quat = _mm_loadu_ps(joint.quat);
+    alignas(16) float sq[4];
+    _mm_store_ps(sq, _mm_mul_ps(quat, quat));
+    // summed in w, z, y, x order by the accumulator.
+    float len_sq = ((sq[3] + sq[2]) + sq[1]) + sq[0];
+    float q = 1.f / std::sqrt(std::abs(len_sq));
+    _mm_storeu_ps(joint.quat, _mm_mul_ps(quat, _mm_set1_ps(q)));
+  }
+}
+
+// div.s, as done by divs_accurate.
+inline float ps2_div(float a, float b) {
+  if (b == 0) {
+    return a < 0 ? -std::numeric_limits<float>::max() : std::numeric_limits<float>::max();
+  }
+  return a / b;
+}
+
+/*!
+ * cspace<-parented-transformq-joint!: bone = parent * matrix(xform). If the parent's scale.w is
+ * nonzero, the parent's scale is divided out of the rotation.
+ *
+ * When dividing out the scale, the original also multiplies w of each rotation row by the sign
+ * bits of 1 / parent scale z. On x86 that's a NaN if the scale is negative, and it ends up in w
+ * of the bone matrix. jak 2 patched this to 0, so the caller says which behavior it wants.
+ */
+inline void parented_transformq(const Bone* parent,
+                                const TransformQ* xform,
+                                Bone* bone,
+                                bool clear_negative_scale_nan) {
+  const float* q = xform->quat;
+  const float q2[3] = {q[0] + q[0], q[1] + q[1], q[2] + q[2]};
+
+  // 0 + x isn't x for -0, so this is done exactly like the original.
+  float rows[3][4] = {{0.f + q[3], 0.f + q[2], 0.f - q[1], 0.f},
+                      {0.f - q[2], 0.f + q[3], 0.f + q[0], 0.f},
+                      {0.f + q[1], 0.f - q[0], 0.f + q[3], 0.f}};
+  for (auto& r : rows) {
+    float x = (q2[1] * r[2]) - (r[1] * q2[2]);
+    float y = (q2[2] * r[0]) - (r[2] * q2[0]);
+    float z = (q2[0] * r[1]) - (r[0] * q2[1]);
+    r[0] = x;
+    r[1] = y;
+    r[2] = z;
+  }
+  rows[0][0] += 1.f;
+  rows[1][1] += 1.f;
+  rows[2][2] += 1.f;
+
+  const __m128 p0 = _mm_loadu_ps(parent->transform[0]);
+  const __m128 p1 = _mm_loadu_ps(parent->transform[1]);
+  const __m128 p2 = _mm_loadu_ps(parent->transform[2]);
+  const __m128 p3 = _mm_loadu_ps(parent->transform[3]);
+  const float parent_sx = parent->scale[0];
+  const float parent_sy = parent->scale[1];
+
+  // the original stores the scale before it reads the rest of the parent.
+  float scale[4];
+  memcpy(scale, xform->scale, 16);
+  const float trans[4] = {xform->trans[0], xform->trans[1], xform->trans[2], xform->trans[3]};
+  memcpy(bone->scale, scale, 16);
+
+  const float parent_sz = parent->scale[2];
+  u32 parent_scale_flag;
+  memcpy(&parent_scale_flag, &parent->scale[3], 4);
+
+  __m128 r[3];
+  for (int i = 0; i < 3; i++) {
+    r[i] = _mm_mul_ps(_mm_loadu_ps(rows[i]), _mm_set1_ps(scale[i]));
+  }
+
+  if (parent_scale_flag) {
+    float inv_z = ps2_div(1.f, parent_sz);
+    float inv_w = 0.f;
+    if (!clear_negative_scale_nan) {
+      // sign extension from mfc1.
+      s32 z_bits;
+      memcpy(&z_bits, &inv_z, 4);
+      u32 w_bits = z_bits < 0 ? UINT32_MAX : 0;
+      memcpy(&inv_w, &w_bits, 4);
+    }
+    const __m128 inv_scale =
+        _mm_setr_ps(ps2_div(1.f, parent_sx), ps2_div(1.f, parent_sy), inv_z, inv_w);
+    for (auto& row : r) {
+      row = _mm_mul_ps(row, inv_scale);
+    }
+  }
+
+  auto transform = [&](const float* v, float w) {
+    __m128 acc = _mm_mul_ps(p0, _mm_set1_ps(v[0]));
+    acc = _mm_add_ps(acc, _mm_mul_ps(p1, _mm_set1_ps(v[1])));
+    acc = _mm_add_ps(acc, _mm_mul_ps(p2, _mm_set1_ps(v[2])));
+    return _mm_add_ps(acc, _mm_mul_ps(p3, _mm_set1_ps(w)));
+  };
+
+  alignas(16) float row_data[3][4];
+  for (int i = 0; i < 3; i++) {
+    _mm_store_ps(row_data[i], r[i]);
+  }
+  for (int i = 0; i < 3; i++) {
+    _mm_storeu_ps(bone->transform[i], transform(row_data[i], row_data[i][3]));
+  }
+  _mm_storeu_ps(bone->transform[3], transform(trans, 1.f));
+}
+
+}  // namespace Mips2C::joint_native
@@ -10,6 +10,7 @@
 #include "common/util/BitUtils.h"
 
 #include "game/common/vu.h"
+#include "game/kernel/common/kscheme.h"
 #include "game/mips2c/mips2c_table.h"
 
 #include "third-party/fmt/core.h"
@@ -1558,6 +1559,28 @@ struct ExecutionContext {
 
 static_assert(sizeof(ExecutionContext) <= 1280);
 
+/*!
+ * Runs the mips2c version of a function registered with reg_args. Only a0-a3, s7 and sp are set up,
+ * so this is just for functions that don't call other functions. mips2c code uses sp as a GOAL
+ * address, so the stack is a small one the function table allocated in EE memory, shared by all
+ * ArgsContexts. These only run on the EE thread, one at a time.
+ */
+struct ArgsContext {
+  ExecutionContext c;
+
+  ArgsContext(u64 arg0, u64 arg1, u64 arg2, u64 arg3) {
+    c.gprs[a0].du64[0] = arg0;
+    c.gprs[a1].du64[0] = arg1;
+    c.gprs[a2].du64[0] = arg2;
+    c.gprs[a3].du64[0] = arg3;
+    c.gprs[s7].du64[0] = ::s7.offset;
+    c.gprs[sp].du64[0] = gLinkedFunctionTable.args_stack_top();
+    ASSERT(c.gprs[sp].du64[0]);
+  }
+
+  u64 run(u64 (*exec)(void*)) { return exec(&c); }
+};
+
 inline void get_fake_spad_addr(int dst, void* sym_addr, u32 offset, ExecutionContext* c) {
   u32 val;
   memcpy(&val, sym_addr, 4);
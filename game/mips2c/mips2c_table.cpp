@@ -1,5 +1,14 @@
 #include "mips2c_table.h"
 
+#ifdef _WIN32
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+
+#include <algorithm>
+
+#include "common/global_profiler/GlobalProfiler.h"
 #include "common/log/log.h"
 #include "common/symbols.h"
 
@@ -12,6 +21,7 @@
 extern "C" {
 void _mips2c_call_linux();
 void _mips2c_call_windows();
+void _arg_call_linux();
 }
 
 // clang-format off
@@ -423,42 +433,140 @@ PerGameVersion<std::unordered_map<std::string, std::vector<void (*)()>>> gMips2C
        jak2::shadow_scissor_top::link, jak2::shadow_scissor_edges::link,
        jak2::shadow_calc_dual_verts::link, jak2::shadow_xform_verts::link}}}};
 
-void LinkedFunctionTable::reg(const std::string& name, u64 (*exec)(void*), u32 stack_size) {
-  const auto& it = m_executes.insert({name, {exec, Ptr<u8>()}});
-  if (!it.second) {
-    lg::error("MIPS2C Function {} is registered multiple times, ignoring later registrations.",
-              name);
-  }
+namespace {
+// set by the trampoline before calling the function, so profiled_call knows what it's calling.
+LinkedFunctionTable::Func* g_current_func = nullptr;
 
-  // this is short stub that will jump to the appropriate function.
-  Ptr<u8> jump_to_asm;
+u64 profiled_call(void* ctxt) {
+  auto* func = g_current_func;
+  func->calls.store(func->calls.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  prof().begin_event(func->name);
+  u64 start = __rdtsc();
+  u64 result = func->c_func(ctxt);
+  u64 cycles = __rdtsc() - start;
+  prof().end_event();
+  func->cycles.store(func->cycles.load(std::memory_order_relaxed) + cycles,
+                     std::memory_order_relaxed);
+  return result;
+}
+
+u64 profiled_args_call(u64 arg0, u64 arg1, u64 arg2, u64 arg3) {
+  auto* func = g_current_func;
+  func->calls.store(func->calls.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  prof().begin_event(func->name);
+  u64 start = __rdtsc();
+  u64 result = func->args_func(arg0, arg1, arg2, arg3);
+  u64 cycles = __rdtsc() - start;
+  prof().end_event();
+  func->cycles.store(func->cycles.load(std::memory_order_relaxed) + cycles,
+                     std::memory_order_relaxed);
+  return result;
+}
+
+Ptr<u8> alloc_stub() {
+  Ptr<u8> stub;
   switch (g_game_version) {
     case GameVersion::Jak1:
-      jump_to_asm = Ptr<u8>(::jak1::alloc_heap_object(s7.offset + jak1_symbols::FIX_SYM_GLOBAL_HEAP,
-                                                      *(s7 + jak1_symbols::FIX_SYM_FUNCTION_TYPE),
-                                                      0x40, UNKNOWN_PP));
+      stub = Ptr<u8>(::jak1::alloc_heap_object(s7.offset + jak1_symbols::FIX_SYM_GLOBAL_HEAP,
+                                               *(s7 + jak1_symbols::FIX_SYM_FUNCTION_TYPE), 0x40,
+                                               UNKNOWN_PP));
       break;
     case GameVersion::Jak2:
-      jump_to_asm = Ptr<u8>(::jak2::alloc_heap_object(
+      stub = Ptr<u8>(::jak2::alloc_heap_object(
           s7.offset + jak2_symbols::FIX_SYM_GLOBAL_HEAP,
           ::jak2::u32_in_fixed_sym(jak2_symbols::FIX_SYM_FUNCTION_TYPE), 0x40, UNKNOWN_PP));
       break;
     default:
       ASSERT(false);
   }
+  return stub;
+}
 
-  it.first->second.goal_trampoline = jump_to_asm;
+u8* emit_bytes(u8* ptr, std::initializer_list<u8> bytes) {
+  for (auto b : bytes) {
+    *ptr++ = b;
+  }
+  return ptr;
+}
 
-  u8* ptr = jump_to_asm.c();
+u8* emit_u64(u8* ptr, u64 val) {
+  memcpy(ptr, &val, 8);
+  return ptr + 8;
+}
+
+// remember which function this is, for the profiled calls.
+u8* emit_set_current_func(u8* ptr, LinkedFunctionTable::Func* func) {
+  ptr = emit_bytes(ptr, {0x48, 0xb8});  // mov rax, &func
+  ptr = emit_u64(ptr, (u64)func);
+  ptr = emit_bytes(ptr, {0x48, 0xa3});  // mov [g_current_func], rax
+  return emit_u64(ptr, (u64)&g_current_func);
+}
+}  // namespace
+
+void LinkedFunctionTable::reg_args(const std::string& name, ArgsFunc exec) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  const auto& it = m_executes.try_emplace(name);
+  if (!it.second) {
+    lg::error("MIPS2C Function {} is registered multiple times, ignoring later registrations.",
+              name);
+  }
+  auto& func = it.first->second;
+  func.args_func = exec;
+  func.args_entry = m_profiling ? profiled_args_call : exec;
+  func.name = it.first->first.c_str();
+  func.goal_trampoline = alloc_stub();
+  if (!m_args_stack_top) {
+    // the mips2c versions of these functions need a stack in EE memory, see ArgsContext.
+    constexpr int ARGS_STACK_SIZE = 1024;
+    m_args_stack_top =
+        kmalloc(kglobalheap, ARGS_STACK_SIZE, KMALLOC_ALIGN_16, "mips2c-args-stack").offset +
+        ARGS_STACK_SIZE;
+  }
+
+  u8* ptr = emit_set_current_func(func.goal_trampoline.c(), &func);
+  // the function is loaded from func.args_entry, like in reg.
+  ptr = emit_bytes(ptr, {0x48, 0xa1});  // mov rax, [func.args_entry]
+  ptr = emit_u64(ptr, (u64)&func.args_entry);
+#ifdef __linux__
+  // the same as make_function_from_c_linux: _arg_call_linux pops the function and calls it.
+  ptr = emit_bytes(ptr, {0x50, 0x48, 0xb8});  // push rax, mov rax, _arg_call_linux
+  ptr = emit_u64(ptr, (u64)_arg_call_linux);
+  emit_bytes(ptr, {0xff, 0xe0});  // jmp rax
+#elif _WIN32
+  // the same as make_function_from_c_win32: move the arguments to rcx, rdx, r8, r9 and call.
+  emit_bytes(ptr, {0x57, 0x56, 0x52, 0x51, 0x41, 0x59, 0x41, 0x58, 0x5A, 0x59, 0x41, 0x52,
+                   0x41, 0x53, 0x48, 0x83, 0xEC, 0x28, 0xFF, 0xD0, 0x48, 0x83, 0xC4, 0x28,
+                   0x41, 0x5B, 0x41, 0x5A, 0xC3});
+#endif
+}
+
+void LinkedFunctionTable::reg(const std::string& name, u64 (*exec)(void*), u32 stack_size) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  const auto& it = m_executes.try_emplace(name);
+  if (!it.second) {
+    lg::error("MIPS2C Function {} is registered multiple times, ignoring later registrations.",
+              name);
+  }
+  auto& func = it.first->second;
+  func.c_func = exec;
+  func.entry = m_profiling ? profiled_call : exec;
+  func.name = it.first->first.c_str();
+
+  // this is short stub that will jump to the appropriate function.
+  Ptr<u8> jump_to_asm = alloc_stub();
+  func.goal_trampoline = jump_to_asm;
+
+  u8* ptr = emit_set_current_func(jump_to_asm.c(), &func);
 
   {
     // linux
 
-    // push the function
-    u64 addr = (u64)exec;
+    // push the function. This is loaded from func.entry, so profiling can be turned on and off
+    // without modifying the code.
+    u64 addr = (u64)&func.entry;
     *ptr = 0x48;
     ptr++;
-    *ptr = 0xb8;
+    *ptr = 0xa1;  // mov rax, [func.entry]
     ptr++;
     memcpy(ptr, &addr, 8);
     ptr += 8;
@@ -497,7 +605,49 @@ void LinkedFunctionTable::reg(const std::string& name, u64 (*exec)(void*), u32 s
   }
 }
 
+void LinkedFunctionTable::clear() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_executes.clear();
+  // the global heap is reset along with this.
+  m_args_stack_top = 0;
+}
+
+void LinkedFunctionTable::set_profiling(bool enable) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_profiling = enable;
+  for (auto& [name, func] : m_executes) {
+    if (func.args_func) {
+      func.args_entry = enable ? profiled_args_call : func.args_func;
+    } else {
+      func.entry = enable ? profiled_call : func.c_func;
+    }
+  }
+}
+
+void LinkedFunctionTable::reset_stats() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (auto& [name, func] : m_executes) {
+    func.calls = 0;
+    func.cycles = 0;
+  }
+}
+
+std::vector<LinkedFunctionTable::FuncStats> LinkedFunctionTable::get_stats() const {
+  std::vector<FuncStats> result;
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (auto& [name, func] : m_executes) {
+    u64 calls = func.calls.load(std::memory_order_relaxed);
+    if (calls) {
+      result.push_back({name, calls, func.cycles.load(std::memory_order_relaxed)});
+    }
+  }
+  std::sort(result.begin(), result.end(),
+            [](const FuncStats& a, const FuncStats& b) { return a.cycles > b.cycles; });
+  return result;
+}
+
 u32 LinkedFunctionTable::get(const std::string& name) {
+  std::lock_guard<std::mutex> lock(m_mutex);
   auto it = m_executes.find(name);
   if (it == m_executes.end()) {
     ASSERT_NOT_REACHED_MSG(fmt::format("mips2c function {} is unknown", name));
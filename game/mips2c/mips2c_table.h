@@ -1,6 +1,8 @@
 #pragma once
 
+#include <atomic>
 #include <cstring>
+#include <mutex>
 #include <random>
 #include <string>
 #include <unordered_map>
@@ -15,15 +17,55 @@ namespace Mips2C {
 
 class LinkedFunctionTable {
  public:
+  using ArgsFunc = u64 (*)(u64, u64, u64, u64);
+
   void reg(const std::string& name, u64 (*exec)(void*), u32 goal_stack_size);
+  /*!
+   * Register a function that takes its first 4 arguments directly, like a kernel function. This
+   * skips setting up an ExecutionContext and the GOAL stack, so it's much cheaper to call. It's for
+   * small functions with a native version: the mips2c version can be run with an ArgsContext.
+   */
+  void reg_args(const std::string& name, ArgsFunc exec);
+  // GOAL address of the top of the stack used by ArgsContext, or 0 if there is none yet.
+  u32 args_stack_top() const { return m_args_stack_top; }
   u32 get(const std::string& name);
+  void clear();
 
- private:
   struct Func {
-    u64 (*c_func)(void*);
+    u64 (*c_func)(void*) = nullptr;
+    // the function the trampoline calls: either c_func, or profiled_call when profiling.
+    std::atomic<u64 (*)(void*)> entry = nullptr;
+    // the same, for functions registered with reg_args.
+    ArgsFunc args_func = nullptr;
+    std::atomic<ArgsFunc> args_entry = nullptr;
     Ptr<u8> goal_trampoline;
+    const char* name = nullptr;
+    // only counts calls from GOAL, not mips2c functions that call each other directly.
+    std::atomic<u64> calls = 0;
+    // rdtsc cycles, including any functions called from this one.
+    std::atomic<u64> cycles = 0;
+  };
+
+  struct FuncStats {
+    std::string name;
+    u64 calls = 0;
+    u64 cycles = 0;
   };
+
+  /*!
+   * Enable or disable call counting and timing. This can be done at any time, from any thread.
+   */
+  void set_profiling(bool enable);
+  bool profiling() const { return m_profiling; }
+  void reset_stats();
+  std::vector<FuncStats> get_stats() const;
+
+ private:
+  // the debug gui reads the stats while the game is registering functions.
+  mutable std::mutex m_mutex;
   std::unordered_map<std::string, Func> m_executes;
+  bool m_profiling = false;
+  u32 m_args_stack_top = 0;
 };
 
 extern PerGameVersion<std::unordered_map<std::string, std::vector<void (*)()>>>
@@ -0,0 +1,128 @@
+#pragma once
+
+/*!
+ * @file native_mode.h
+ * Some mips2c functions also have a hand-written native version. The mips2c translations are kept
+ * as the reference: each group of native functions has a mode to switch back to them, or to run
+ * both and check that the results are bit-identical. The modes can be changed while the game runs,
+ * from the MIPS2C Profiler window.
+ *
+ * To match, the native versions do every float operation in the same order as VU0: a multiply,
+ * then a separate add, with no reassociation.
+ */
+
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <initializer_list>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/util/Assert.h"
+
+#include "third-party/fmt/core.h"
+
+extern u8* g_ee_main_mem;
+
+namespace Mips2C {
+
+enum class NativeMode {
+  NATIVE,  // only run the native version
+  MIPS2C,  // only run the mips2c version
+  CHECK,   // run both and assert that they match
+};
+
+enum class NativeGroup {
+  COLLIDE,
+  JOINT,
+  SPATIAL_HASH,
+  GENERIC,
+  SHADOW,
+  FONT,
+  SPARTICLE,
+  NAV,
+  BONES,
+  TIME_OF_DAY,
+  OCEAN,
+  COUNT
+};
+
+constexpr const char* native_group_names[(int)NativeGroup::COUNT] = {
+    "collide",
+    "joint",
+    "spatial hash",
+    "generic",
+    "shadow",
+    "font",
+    "sparticle",
+    "nav",
+    "bones",
+    "time of day",
+    "ocean",
+};
+
+// written by the debug GUI, read by the game thread. Each function reads it once per call, so the
+// mode doesn't change halfway through. Zero is NATIVE.
+inline std::atomic<NativeMode> g_native_modes[(int)NativeGroup::COUNT] = {};
+
+constexpr std::atomic<NativeMode>& native_mode(NativeGroup group) {
+  return g_native_modes[(int)group];
+}
+
+/*!
+ * A GOAL address, as seen by the native versions.
+ */
+template <typename T>
+T* ee_ptr(u32 addr) {
+  return (T*)(g_ee_main_mem + addr);
+}
+
+/*!
+ * Compare float results for CHECK mode. The payload of a NaN depends on the operand order the
+ * compiler picked for the mips2c version, so any two NaNs are considered equal.
+ */
+inline bool same_floats(const float* a, const float* b, int count) {
+  for (int i = 0; i < count; i++) {
+    if (memcmp(&a[i], &b[i], sizeof(float)) && !(std::isnan(a[i]) && std::isnan(b[i]))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+struct NativeOutput {
+  void* data;
+  size_t size;
+};
+
+/*!
+ * CHECK mode for functions with integer results: run the mips2c version, put the outputs back how
+ * they were, run the native version, and assert that the outputs and return values match.
+ */
+template <typename Native, typename Reference>
+u64 check_native(const char* name,
+                 std::initializer_list<NativeOutput> outputs,
+                 Native&& native,
+                 Reference&& mips2c) {
+  std::vector<std::vector<u8>> before, reference;
+  for (auto& out : outputs) {
+    before.emplace_back((u8*)out.data, (u8*)out.data + out.size);
+  }
+  u64 reference_result = mips2c();
+  size_t i = 0;
+  for (auto& out : outputs) {
+    reference.emplace_back((u8*)out.data, (u8*)out.data + out.size);
+    memcpy(out.data, before[i++].data(), out.size);
+  }
+  u64 result = native();
+  ASSERT_MSG(result == reference_result, fmt::format("{} returned {}, mips2c returned {}", name,
+                                                     result, reference_result));
+  i = 0;
+  for (auto& out : outputs) {
+    ASSERT_MSG(!memcmp(out.data, reference[i++].data(), out.size),
+               fmt::format("{} output {} mismatch", name, i - 1));
+  }
+  return result;
+}
+
+}  // namespace Mips2C
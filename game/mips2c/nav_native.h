@@ -0,0 +1,278 @@
+#pragma once
+
+/*!
+ * @file nav_native.h
+ * Hand-written versions of the jak 2 nav mips2c functions that run for every nav-control each
+ * frame: moving the nav-controls' pointers between main memory and the scratchpad copy of the
+ * mesh, and limiting how fast a nav-state can turn.
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+#include "common/common_types.h"
+
+#include "game/mips2c/native_mode.h"
+
+namespace Mips2C::nav_native {
+
+inline std::atomic<NativeMode>& g_mode = native_mode(NativeGroup::NAV);
+
+// nav-control-flag
+constexpr u32 NAV_CONTROL_KERNEL_RUN = 256;
+// process-mask
+constexpr u32 PROCESS_MASK_KERNEL_RUN = 2048;
+
+// nav-mesh-work
+struct NavMeshWork {
+  s8 vert0_table[4];
+  s8 vert1_table[4];
+  u8 edge_mask_table[3];
+  u8 pad;
+  u32 pad0;
+  float deg_to_rad;
+  float rad_to_deg;
+  float nav_poly_min_dist;
+  float nav_poly_epsilon;
+};
+
+// nav-mesh. This starts after the type tag, where the GOAL pointer points.
+struct NavMesh {
+  u32 work;
+  u32 poly_array;
+};
+
+// nav-state
+struct NavState {
+  u32 flags;
+  u32 nav;
+  u32 user_poly;
+  u32 mesh;
+  u32 current_poly;
+  u32 virtual_current_poly;
+  u32 next_poly;
+  u32 target_poly;
+  float rotation_rate;
+  float speed;
+  float prev_speed;
+  u32 pad0;
+  float travel[4];
+  float target_post[4];
+  float current_pos[4];
+  float current_pos_local[4];
+  float virtual_current_pos_local[4];
+  float velocity[4];
+  float heading[4];
+  float target_dir[4];
+};
+static_assert(sizeof(NavState) == 0xb0);
+
+// nav-control
+struct NavControl {
+  u32 flags;
+  u32 callback_info;
+  u32 process;
+  u32 pad0;
+  u32 shape;
+  float nearest_y_threshold;
+  float nav_cull_radius;
+  float sec_per_frame;
+  float target_speed;
+  float acceleration;
+  float turning_acceleration;
+  float max_rotation_rate;
+  float speed_scale;
+  s32 sphere_count;
+  u32 sphere_array;
+  u8 spheres[52];
+  NavState state;
+};
+static_assert(sizeof(NavControl) == 288);
+static_assert(offsetof(NavControl, state) == 112);
+
+// nav-engine-spr-buffer
+struct NavEngineSprBuffer {
+  u32 mem_addr;
+  u32 spr_addr;
+  u32 q_size;
+  u8 i_nav;
+  s8 done;
+  s8 nav_count;
+  s8 i_pass;
+};
+static_assert(sizeof(NavEngineSprBuffer) == 16);
+
+// nav-engine
+struct NavEngine {
+  u32 spr_addr;
+  u32 spr_work;
+  u32 spr_mesh;
+  u32 spr_poly_array;
+  u32 hash_sphere_list;
+  u32 hash_buckets;
+  s8 buf_nav_control_count;
+  s8 max_pass_count;
+  u8 output_sphere_hash;
+  u8 pad;
+  NavEngineSprBuffer work_buf_array[3];
+  u32 mem_work;
+  u32 mem_mesh;
+  u32 mem_poly_array;
+  u32 to_spr_wait;
+  u32 from_spr_wait;
+};
+static_assert(sizeof(NavEngine) == 0x60);
+
+// (-> process nav), from the GOAL pointer of a process-drawable.
+inline u32* process_nav(u32 process) {
+  return ee_ptr<u32>(process + 140);
+}
+
+// (-> process mask)
+inline u32 process_mask(u32 process) {
+  return *ee_ptr<u32>(process + 4);
+}
+
+inline float float_from_bits(u32 bits) {
+  float result;
+  memcpy(&result, &bits, 4);
+  return result;
+}
+
+/*!
+ * nav-state-patch-pointers: move the poly pointers by offset, leaving #f alone.
+ */
+inline void patch_pointers(NavState* state, u32 offset, u32 false_symbol) {
+  for (u32* poly : {&state->current_poly, &state->target_poly, &state->next_poly,
+                    &state->virtual_current_poly}) {
+    if (*poly != false_symbol) {
+      *poly += offset;
+    }
+  }
+}
+
+/*!
+ * (method 20 nav-engine), reloc-ptrs-to-spad: point the nav-controls that were just copied to the
+ * scratchpad at the scratchpad copies of the work and mesh. Only the nav-controls whose processes
+ * are running get kernel-run.
+ */
+inline void reloc_ptrs_to_spad(const NavEngine* engine,
+                               const NavEngineSprBuffer* buf,
+                               u32 false_symbol) {
+  const u32 offset = ee_ptr<NavMesh>(engine->spr_mesh)->poly_array -
+                     ee_ptr<NavMesh>(engine->mem_mesh)->poly_array;
+  auto* controls = ee_ptr<NavControl>(buf->spr_addr);
+  for (s64 i = 0; i < buf->nav_count; i++) {
+    NavControl& nav = controls[i];
+    if (nav.process == false_symbol) {
+      continue;
+    }
+    nav.flags &= ~NAV_CONTROL_KERNEL_RUN;
+    if (process_mask(nav.process) & PROCESS_MASK_KERNEL_RUN) {
+      nav.flags |= NAV_CONTROL_KERNEL_RUN;
+    }
+    nav.sphere_array = engine->spr_work + 32;
+    nav.state.mesh = engine->spr_mesh;
+    patch_pointers(&nav.state, offset, false_symbol);
+    *process_nav(nav.process) = false_symbol;
+  }
+}
+
+/*!
+ * (method 21 nav-engine), reloc-ptrs-to-mem: the opposite of reloc-ptrs-to-spad, before the
+ * nav-controls are copied back to main memory.
+ */
+inline void reloc_ptrs_to_mem(const NavEngine* engine,
+                              const NavEngineSprBuffer* buf,
+                              u32 false_symbol) {
+  const u32 offset = ee_ptr<NavMesh>(engine->mem_mesh)->poly_array -
+                     ee_ptr<NavMesh>(engine->spr_mesh)->poly_array;
+  auto* controls = ee_ptr<NavControl>(buf->spr_addr);
+  for (s64 i = 0; i < buf->nav_count; i++) {
+    NavControl& nav = controls[i];
+    if (nav.process == false_symbol) {
+      continue;
+    }
+    const u32 mem_addr = buf->mem_addr + sizeof(NavControl) * i;
+    nav.sphere_array = engine->mem_work + 32;
+    nav.state.mesh = engine->mem_mesh;
+    nav.state.nav = mem_addr;
+    patch_pointers(&nav.state, offset, false_symbol);
+    *process_nav(nav.process) = mem_addr;
+  }
+}
+
+inline float dot_xyz(const float* a, const float* b) {
+  return a[2] * b[2] + a[1] * b[1] + a[0] * b[0];
+}
+
+/*!
+ * Rotate v around y by the angle with this sin and cos.
+ */
+inline void rotate_y(float* out, const float* v, float sin, float cos) {
+  out[0] = cos * v[0] + sin * v[2];
+  out[1] = v[1];
+  out[2] = cos * v[2] - sin * v[0];
+}
+
+/*!
+ * (method 39 nav-state): if the travel direction is further from the heading than the nav can turn
+ * this frame, turn the heading as far as it can towards it, and use that instead. Returns whether
+ * the travel was changed.
+ */
+inline bool limit_rotation(NavState* state) {
+  const auto* nav = ee_ptr<NavControl>(state->nav);
+  const auto* work = ee_ptr<NavMeshWork>(ee_ptr<NavMesh>(state->mesh)->work);
+  float max_angle = state->rotation_rate * nav->sec_per_frame;
+  float* travel = state->travel;
+  float len = std::sqrt(std::abs(travel[0] * travel[0] + travel[2] * travel[2]));
+  if (!(work->nav_poly_epsilon < len)) {
+    return false;
+  }
+
+  float dir[3];
+  float inv_len = 1.f / len;
+  dir[0] = travel[0] * inv_len;
+  dir[1] = 0;
+  dir[2] = travel[2] * inv_len;
+
+  // the angle wraps to 16 bits like GOAL degrees, then the sin and cos are the same polynomials as
+  // the original.
+  s32 angle_int = max_angle;
+  float x = work->deg_to_rad * (float)(s32)(s16)angle_int;
+  float x2 = x * x;
+  float x3 = x2 * x;
+  float x4 = x2 * x2;
+  float x5 = x3 * x2;
+  float x6 = x3 * x3;
+  float x7 = x4 * x3;
+  float x8 = x4 * x4;
+  float x9 = x5 * x4;
+  float acc = x * float_from_bits(0x3f7fffde);
+  acc += x3 * float_from_bits(0xbe2aa8f5);
+  acc += x5 * float_from_bits(0x3c086bf6);
+  acc += x7 * float_from_bits(0xb94d2072);
+  float sin_angle = acc + (x9 * float_from_bits(0x361aa27f));
+  acc = 1.f * 1.f;
+  acc += x2 * float_from_bits(0xbeff0000);
+  acc += x4 * float_from_bits(0x3d2a7a28);
+  acc += x6 * float_from_bits(0xbab2bc31);
+  float cos_angle = acc + (x8 * float_from_bits(0x37a933eb));
+
+  if (!(dot_xyz(dir, state->heading) < cos_angle)) {
+    return false;
+  }
+
+  float left[3], right[3];
+  rotate_y(left, state->heading, sin_angle, cos_angle);
+  rotate_y(right, state->heading, -sin_angle, cos_angle);
+  const float* turned = dot_xyz(right, dir) < dot_xyz(left, dir) ? left : right;
+  for (int i = 0; i < 3; i++) {
+    travel[i] = turned[i] * len;
+  }
+  travel[3] = 1.f;
+  return true;
+}
+
+}  // namespace Mips2C::nav_native
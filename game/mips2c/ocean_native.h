@@ -0,0 +1,62 @@
+#pragma once
+
+/*!
+ * @file ocean_native.h
+ * Hand-written versions of the ocean VU0 functions that build the per-frame wave height table:
+ * blending two of the 64 frames of *ocean-wave-frames*, and (jak 2) adding two tables together.
+ * The table is built once per frame, and everything that needs the ocean height reads it.
+ */
+
+#include <emmintrin.h>
+
+#include <cstring>
+
+#include "common/common_types.h"
+
+#include "game/mips2c/native_mode.h"
+
+namespace Mips2C::ocean_native {
+
+inline std::atomic<NativeMode>& g_mode = native_mode(NativeGroup::OCEAN);
+
+// ocean-wave-data is 32x32 heights, one signed byte each.
+constexpr u32 WAVE_FRAME_COUNT = 64;
+constexpr u32 WAVE_HEIGHT_COUNT = 1024;
+
+/*!
+ * Four heights as floats. Like the original, each byte is put at the top of a word and converted
+ * with itof15, so the result is the height times 512.
+ */
+inline __m128 heights_to_float(const s8* heights) {
+  s32 packed;
+  memcpy(&packed, heights, 4);
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i bytes = _mm_cvtsi32_si128(packed);
+  const __m128i words = _mm_unpacklo_epi16(zero, _mm_unpacklo_epi8(zero, bytes));
+  return _mm_mul_ps(_mm_cvtepi32_ps(words), _mm_set1_ps(1.f / 32768.f));
+}
+
+/*!
+ * out = frame0 * w0 + frame1 * w1, for a whole height table.
+ */
+inline void interp_wave(float* out, const s8* frame0, const s8* frame1, float w0, float w1) {
+  const __m128 w0_vec = _mm_set1_ps(w0);
+  const __m128 w1_vec = _mm_set1_ps(w1);
+  for (u32 i = 0; i < WAVE_HEIGHT_COUNT; i += 4) {
+    const __m128 a = _mm_mul_ps(heights_to_float(frame0 + i), w0_vec);
+    const __m128 b = _mm_mul_ps(heights_to_float(frame1 + i), w1_vec);
+    _mm_storeu_ps(out + i, _mm_add_ps(a, b));
+  }
+}
+
+/*!
+ * (method 15 ocean), jak 2: add src to a whole height table. The original never advances src, so
+ * the same 16 heights are added to every group of 16.
+ */
+inline void add_waves(float* dst, const float* src) {
+  for (u32 i = 0; i < WAVE_HEIGHT_COUNT; i += 4) {
+    _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_loadu_ps(src + i % 16)));
+  }
+}
+
+}  // namespace Mips2C::ocean_native
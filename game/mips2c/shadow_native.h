@@ -0,0 +1,153 @@
+#pragma once
+
+/*!
+ * @file shadow_native.h
+ * Hand-written versions of the vertex math in the shadow mips2c functions: skinning the shadow
+ * vertices and projecting them onto the ground plane. These run on every shadow vertex, and the
+ * translated versions do it one VU0 instruction at a time. The find/add/scissor passes that build
+ * the volume are still translated. The layouts are the same in jak 1 and jak 2, except that jak 2
+ * moved the center and plane 16 bytes later in shadow-dcache.
+ */
+
+#include <immintrin.h>
+
+#include <cfloat>
+#include <cmath>
+
+#include "common/common_types.h"
+
+#include "game/mips2c/native_mode.h"
+
+namespace Mips2C::shadow_native {
+
+inline std::atomic<NativeMode>& g_mode = native_mode(NativeGroup::SHADOW);
+
+// shadow-frag-header
+struct ShadowFragHeader {
+  u32 qwc_data;
+  u32 num_joints;
+  u16 num_verts;
+  u16 num_twos;
+  u16 num_single_tris;
+  u16 num_single_edges;
+  u16 num_double_tris;
+  u16 num_double_edges;
+  u32 ofs_verts;
+  u32 ofs_refs;
+  u32 ofs_single_tris;
+  u32 ofs_single_edges;
+  u32 ofs_double_tris;
+  u32 ofs_double_edges;
+};
+static_assert(sizeof(ShadowFragHeader) == 44);
+
+// the start of shadow-dcache, which is the same in both games.
+struct ShadowDcacheHeader {
+  u32 vtx_table;
+  u32 single_edge_table;
+  u32 double_edge_table;
+  u32 double_tri_table;
+  u32 dcache_top;
+  u32 num_facing_single_tris;
+  u32 num_single_edges;
+  u32 num_double_edges;
+  u32 single_tri_list;
+  u32 single_edge_list;
+  u32 double_edge_list;
+  u32 ptr_dual_verts;
+};
+static_assert(sizeof(ShadowDcacheHeader) == 48);
+
+// the joint matrices start this far after the end of the fragment data.
+constexpr u32 SHADOW_MATRIX_OFFSET = 144;
+constexpr u32 SHADOW_MATRIX_STRIDE = 128;
+
+// m3 + m0 * v.x + m1 * v.y + m2 * v.z, like the vmula/vmadda chain.
+inline __m128 transform_point(u32 matrix, const float* v) {
+  // loaded with lqc2, which ignores the low 4 bits.
+  const float* m = ee_ptr<float>(matrix & ~15);
+  // multiplied by vf0.w = 1.0 on VU0.
+  __m128 acc = _mm_mul_ps(_mm_loadu_ps(m + 12), _mm_set1_ps(1.f));
+  acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(m), _mm_set1_ps(v[0])));
+  acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(m + 4), _mm_set1_ps(v[1])));
+  return _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(m + 8), _mm_set1_ps(v[2])));
+}
+
+/*!
+ * shadow-xform-verts: transform the fragment's vertices in place by their joints. The first
+ * (num-verts - num-twos) vertices use one joint and keep their w. The rest blend two joints by w,
+ * and get a w of 1. matrices is the address of joint 0's matrix.
+ */
+inline void xform_verts(const ShadowFragHeader* frag, u32 frag_addr, u32 matrices) {
+  float* vtx = ee_ptr<float>((frag_addr + frag->ofs_verts) & ~15);
+  const u8* refs = ee_ptr<u8>(frag_addr + frag->ofs_refs);
+
+  for (u32 i = frag->num_twos; i < frag->num_verts; i++) {
+    __m128 v = _mm_loadu_ps(vtx);
+    __m128 result = transform_point(matrices + SHADOW_MATRIX_STRIDE * refs[0], vtx);
+    _mm_storeu_ps(vtx, _mm_blend_ps(result, v, 0b1000));
+    vtx += 4;
+    refs += 2;
+  }
+
+  for (u32 i = 0; i < frag->num_twos; i++) {
+    __m128 a = transform_point(matrices + SHADOW_MATRIX_STRIDE * refs[0], vtx);
+    __m128 b = transform_point(matrices + SHADOW_MATRIX_STRIDE * refs[1], vtx);
+    const float w = vtx[3];
+    __m128 result =
+        _mm_add_ps(_mm_mul_ps(a, _mm_set1_ps(w)), _mm_mul_ps(b, _mm_set1_ps(1.f - w)));
+    // w is set to vf0.w + vf0.x, which is 1.
+    _mm_storeu_ps(vtx, _mm_blend_ps(result, _mm_set1_ps(1.f), 0b1000));
+    vtx += 4;
+    refs += 2;
+  }
+}
+
+inline __m128 saturate_infs(__m128 v) {
+  // NaN stays NaN: max/min return the second operand if either is NaN.
+  return _mm_min_ps(_mm_set1_ps(FLT_MAX), _mm_max_ps(_mm_set1_ps(-FLT_MAX), v));
+}
+
+inline float saturate_infs(float f) {
+  if (std::isinf(f)) {
+    return f > 0 ? FLT_MAX : -FLT_MAX;
+  }
+  return f;
+}
+
+/*!
+ * shadow-calc-dual-verts: move each vertex along the line from the center until it's on the plane,
+ * and write it to out. The original does 4 vertices at a time, and clamps infinities in the plane
+ * distance for the last two of each group, so that's kept.
+ */
+inline void calc_dual_verts(const float* in,
+                            u32 vertex_count,
+                            const float* center,
+                            const float* plane,
+                            float* out) {
+  const __m128 c = _mm_loadu_ps(center);
+  const __m128 n = _mm_loadu_ps(plane);
+  for (u32 i = 0; i < vertex_count; i++) {
+    const bool saturate = i & 2;
+    const __m128 p = _mm_loadu_ps(in + 4 * i);
+    const __m128 dir = _mm_sub_ps(c, p);
+
+    __m128 p_n = _mm_mul_ps(p, n);
+    if (saturate) {
+      p_n = saturate_infs(p_n);
+    }
+    alignas(16) float dist[4];
+    alignas(16) float dir_n[4];
+    _mm_store_ps(dist, p_n);
+    _mm_store_ps(dir_n, _mm_mul_ps(dir, n));
+
+    float num = ((dist[0] + dist[1]) + dist[2]) + dist[3];
+    if (saturate) {
+      num = saturate_infs(num);
+    }
+    const float t = num / ((dir_n[0] + dir_n[1]) + dir_n[2]);
+    _mm_storeu_ps(out + 4 * i, _mm_sub_ps(p, _mm_mul_ps(dir, _mm_set1_ps(t))));
+  }
+}
+
+}  // namespace Mips2C::shadow_native
@@ -0,0 +1,387 @@
+#pragma once
+
+/*!
+ * @file sparticle_native.h
+ * Hand-written versions of the jak 1 sp-process-block-2d and sp-process-block-3d, which run once
+ * per particle each frame: count down the timers, integrate velocity, rotation and fade, and free
+ * the particles that are done.
+ *
+ * The particles stay in the game's sparticle-cpuinfo and sprite-vec-data arrays, because the
+ * sprite renderer and the GOAL particle code both read them there. The callbacks (the particle's
+ * func, relaunching, sp-orbiter and sp-free-particle) are still GOAL functions, called through
+ * Calls.
+ *
+ * The callbacks change the particle system, so they can't be run twice for CHECK mode. See
+ * check_process_block.
+ */
+
+#include <immintrin.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "common/common_types.h"
+
+#include "game/mips2c/native_mode.h"
+
+namespace Mips2C::sparticle_native {
+
+inline std::atomic<NativeMode>& g_mode = native_mode(NativeGroup::SPARTICLE);
+
+// sparticle-cpuinfo
+struct CpuInfo {
+  u32 sprite;
+  u32 adgif;
+  float radius;
+  float omega;
+  float vel_sxvel[4];
+  float rot_syvel[4];
+  float fade[4];
+  float acc[4];
+  float rotvel3d[4];
+  float friction;
+  s32 timer;
+  u32 flags;
+  u32 user;
+  u32 func;
+  s32 next_time;
+  u32 next_launcher;
+  float cache_alpha;
+  u32 valid;
+  u32 key;
+  u32 binding;
+  u32 pad;
+};
+static_assert(sizeof(CpuInfo) == 144);
+
+// sprite-vec-data-2d and sprite-vec-data-3d
+struct SpriteVec {
+  float x_y_z_sx[4];
+  float flag_rot_sy[4];  // qx, qy, qz, sy for 3d
+  float r_g_b_a[4];
+};
+static_assert(sizeof(SpriteVec) == 48);
+
+// sp-cpuinfo-flag
+constexpr u32 SP_BIT0 = 1;              // free when the sprite has shrunk to nothing
+constexpr u32 SP_BIT1 = 2;              // free when r, g and b are all zero
+constexpr u32 SP_BIT2 = 4;              // free when fully transparent
+constexpr u32 SP_READY_TO_LAUNCH = 64;  // restore the alpha from cache-alpha
+constexpr u32 SP_BIT7 = 128;            // call sp-orbiter
+constexpr u32 SP_BIT13 = 8192;          // keeps updating while paused
+
+inline u32 float_bits(float f) {
+  u32 result;
+  memcpy(&result, &f, 4);
+  return result;
+}
+
+/*!
+ * VU max: the second operand is kept unless the first is bigger, like std::max.
+ */
+inline __m128 vu_max(__m128 a, __m128 b) {
+  return _mm_max_ps(b, a);
+}
+
+/*!
+ * quaternion*!, in the same order as the VU code. dst can be a or b.
+ */
+inline void quaternion_mul(float* dst, const float* a, const float* b) {
+  float sq[4];
+  for (int i = 0; i < 4; i++) {
+    sq[i] = a[i] * b[i];
+  }
+  float cross[3] = {a[1] * b[2] - b[1] * a[2], a[2] * b[0] - b[2] * a[0],
+                    a[0] * b[1] - b[0] * a[1]};
+  float result[4];
+  for (int i = 0; i < 3; i++) {
+    result[i] = (a[i] * b[3] + b[i] * a[3]) + cross[i];
+  }
+  result[3] = ((((a[3] * b[3] + b[3] * a[3]) - sq[3]) - sq[2]) - sq[1]) - sq[0];
+  memcpy(dst, result, 16);
+}
+
+/*!
+ * The timer and the alpha restore at the start of each particle. Returns false if the particle
+ * should be freed.
+ */
+inline bool update_timer(CpuInfo& cpu, SpriteVec& sprite, s32 ticks) {
+  s32 timer = cpu.timer;
+  if (timer != -1) {
+    if (timer == 0) {
+      return false;
+    }
+    cpu.timer = std::max((s32)((s64)timer - ticks), 0);
+  }
+  if (cpu.flags & SP_READY_TO_LAUNCH) {
+    cpu.flags ^= SP_READY_TO_LAUNCH;
+    memcpy(&sprite.r_g_b_a[3], &cpu.cache_alpha, 4);
+  }
+  return true;
+}
+
+/*!
+ * While paused, only particles that have run out of time are freed. Returns false if the particle
+ * should be freed.
+ */
+inline bool update_paused(CpuInfo& cpu, SpriteVec& sprite) {
+  if (cpu.timer != -1 && cpu.timer == 0) {
+    return false;
+  }
+  if (cpu.flags & SP_READY_TO_LAUNCH) {
+    cpu.flags ^= SP_READY_TO_LAUNCH;
+    memcpy(&sprite.r_g_b_a[3], &cpu.cache_alpha, 4);
+  }
+  return true;
+}
+
+/*!
+ * Add the acceleration and friction to the velocity, and return the velocity after.
+ */
+inline __m128 update_velocity(CpuInfo& cpu, const float* frame) {
+  __m128 vel = _mm_loadu_ps(cpu.vel_sxvel);
+  __m128 acc = _mm_mul_ps(_mm_loadu_ps(cpu.acc), _mm_set1_ps(frame[2]));
+  // xyz only: w is scalevelx.
+  vel = _mm_blend_ps(_mm_add_ps(vel, acc), vel, 0b1000);
+  if (float_bits(cpu.friction)) {
+    float keep = 1.f - (1.f - cpu.friction) * frame[3];
+    vel = _mm_blend_ps(_mm_mul_ps(vel, _mm_set1_ps(keep)), vel, 0b1000);
+  }
+  _mm_storeu_ps(cpu.vel_sxvel, vel);
+  return vel;
+}
+
+/*!
+ * The checks for freeing a particle at the end of its update. rgba and the sx and sy words are
+ * the values computed this frame.
+ */
+inline bool should_free(u32 flags, const u32* rgba, s32 sx, s32 sy) {
+  if ((flags & SP_BIT1) && !rgba[0] && !rgba[1] && !rgba[2]) {
+    return true;
+  }
+  if ((flags & SP_BIT2) && (s32)rgba[3] <= 0) {
+    return true;
+  }
+  if ((flags & SP_BIT0) && (sx < 0 || sy < 0)) {
+    return true;
+  }
+  return false;
+}
+
+/*!
+ * sp-process-block-2d. Calls must have:
+ *  func(cpuinfo, sprite, func): the particle's func
+ *  relaunch(next_launcher, cpuinfo, sprite)
+ *  orbiter(cpuinfo, sprite)
+ *  free(index, cpuinfo, sprite)
+ * with GOAL addresses. Returns the index after the last particle.
+ */
+template <typename Calls>
+u32 process_block_2d(u32 cpuinfo_addr,
+                     u32 sprite_addr,
+                     u32 index,
+                     u32 count,
+                     bool paused,
+                     u32 false_symbol,
+                     const float* frame,
+                     Calls& calls) {
+  const s32 ticks = float_bits(frame[0]) & 255;
+  const __m128 step = _mm_set1_ps(frame[1]);
+  for (u32 n = 0; n < count; n++, index++, cpuinfo_addr += 144, sprite_addr += 48) {
+    auto& cpu = *ee_ptr<CpuInfo>(cpuinfo_addr);
+    auto& sprite = *ee_ptr<SpriteVec>(sprite_addr);
+    if (cpu.valid == false_symbol) {
+      continue;
+    }
+    if (paused && !(cpu.flags & SP_BIT13)) {
+      if (!update_paused(cpu, sprite)) {
+        calls.free(index, cpuinfo_addr, sprite_addr);
+      }
+      continue;
+    }
+    if (!update_timer(cpu, sprite, ticks)) {
+      calls.free(index, cpuinfo_addr, sprite_addr);
+      continue;
+    }
+    if (cpu.func) {
+      calls.func(cpuinfo_addr, sprite_addr, cpu.func);
+    }
+    if (cpu.next_launcher) {
+      s64 next_time = (s64)cpu.next_time - ticks;
+      cpu.next_time = next_time;
+      if (next_time - 1 < 0) {
+        calls.relaunch(cpu.next_launcher, cpuinfo_addr, sprite_addr);
+      }
+    }
+
+    __m128 vel = update_velocity(cpu, frame);
+    __m128 pos = _mm_add_ps(_mm_loadu_ps(sprite.x_y_z_sx), _mm_mul_ps(vel, step));
+    __m128 rot_in = _mm_loadu_ps(sprite.flag_rot_sy);
+    __m128 rot = _mm_add_ps(rot_in, _mm_mul_ps(_mm_loadu_ps(cpu.rot_syvel), step));
+    rot = _mm_blend_ps(rot_in, rot, 0b1100);  // flag and matrix are ints
+    __m128 rgba =
+        _mm_add_ps(_mm_loadu_ps(sprite.r_g_b_a), _mm_mul_ps(_mm_loadu_ps(cpu.fade), step));
+    rgba = vu_max(rgba, _mm_setzero_ps());
+    _mm_storeu_ps(sprite.x_y_z_sx, pos);
+    _mm_storeu_ps(sprite.flag_rot_sy, rot);
+    _mm_storeu_ps(sprite.r_g_b_a, rgba);
+    // the rotation wraps around as a 16-bit integer.
+    s32 rot_int = sprite.flag_rot_sy[2];
+    sprite.flag_rot_sy[2] = (float)(s16)rot_int;
+
+    alignas(16) s32 pos_words[4];
+    alignas(16) s32 rot_words[4];
+    _mm_store_ps((float*)pos_words, pos);
+    _mm_store_ps((float*)rot_words, rot);
+    if (cpu.flags & SP_BIT7) {
+      calls.orbiter(cpuinfo_addr, sprite_addr);
+    }
+    // the color is read back, in case the orbiter changed it. The size is not.
+    u32 rgba_words[4];
+    memcpy(rgba_words, sprite.r_g_b_a, 16);
+    if (should_free(cpu.flags, rgba_words, pos_words[3], rot_words[3])) {
+      calls.free(index, cpuinfo_addr, sprite_addr);
+    }
+  }
+  return index;
+}
+
+/*!
+ * sp-process-block-3d. Calls are the same as process_block_2d, without orbiter.
+ */
+template <typename Calls>
+u32 process_block_3d(u32 cpuinfo_addr,
+                     u32 sprite_addr,
+                     u32 index,
+                     u32 count,
+                     bool paused,
+                     u32 false_symbol,
+                     const float* frame,
+                     Calls& calls) {
+  const s32 ticks = float_bits(frame[0]) & 255;
+  const __m128 step = _mm_set1_ps(frame[1]);
+  for (u32 n = 0; n < count; n++, index++, cpuinfo_addr += 144, sprite_addr += 48) {
+    auto& cpu = *ee_ptr<CpuInfo>(cpuinfo_addr);
+    auto& sprite = *ee_ptr<SpriteVec>(sprite_addr);
+    if (cpu.valid == false_symbol) {
+      continue;
+    }
+    if (paused && !(cpu.flags & SP_BIT13)) {
+      if (!update_paused(cpu, sprite)) {
+        calls.free(index, cpuinfo_addr, sprite_addr);
+      }
+      continue;
+    }
+    if (!update_timer(cpu, sprite, ticks)) {
+      calls.free(index, cpuinfo_addr, sprite_addr);
+      continue;
+    }
+    if (cpu.func) {
+      calls.func(cpuinfo_addr, sprite_addr, cpu.func);
+    }
+    if (cpu.next_launcher) {
+      s64 next_time = (s64)cpu.next_time - ticks;
+      cpu.next_time = next_time;
+      if (next_time < 0) {
+        calls.relaunch(cpu.next_launcher, cpuinfo_addr, sprite_addr);
+      }
+    }
+
+    __m128 vel = update_velocity(cpu, frame);
+    __m128 pos = _mm_add_ps(_mm_loadu_ps(sprite.x_y_z_sx), _mm_mul_ps(vel, step));
+    __m128 quat_in = _mm_loadu_ps(sprite.flag_rot_sy);
+    __m128 quat_sy = _mm_add_ps(quat_in, _mm_mul_ps(_mm_loadu_ps(cpu.rot_syvel), step));
+    quat_sy = _mm_blend_ps(quat_in, quat_sy, 0b1000);  // only sy
+    __m128 rgba =
+        _mm_add_ps(_mm_loadu_ps(sprite.r_g_b_a), _mm_mul_ps(_mm_loadu_ps(cpu.fade), step));
+    rgba = vu_max(rgba, _mm_setzero_ps());
+    _mm_storeu_ps(sprite.x_y_z_sx, pos);
+    _mm_storeu_ps(sprite.flag_rot_sy, quat_sy);
+    _mm_storeu_ps(sprite.r_g_b_a, rgba);
+
+    // the sprite only has xyz of the rotation. w is positive.
+    float quat[4];
+    memcpy(quat, sprite.flag_rot_sy, 12);
+    quat[3] = std::sqrt(std::abs(((1.f - quat[2] * quat[2]) - quat[1] * quat[1]) -
+                                 quat[0] * quat[0]));
+    if ((float_bits(frame[0]) & 255) >= 10) {
+      quaternion_mul(quat, quat, cpu.rotvel3d);
+    }
+    quaternion_mul(quat, quat, cpu.rotvel3d);
+    for (int i = 0; i < 3; i++) {
+      sprite.flag_rot_sy[i] = quat[3] < 0 ? 0.f - quat[i] : 0.f + quat[i];
+    }
+
+    alignas(16) s32 pos_words[4];
+    alignas(16) s32 quat_words[4];
+    alignas(16) u32 rgba_words[4];
+    _mm_store_ps((float*)pos_words, pos);
+    _mm_store_ps((float*)quat_words, quat_sy);
+    _mm_store_ps((float*)rgba_words, rgba);
+    if (should_free(cpu.flags, rgba_words, pos_words[3], quat_words[3])) {
+      calls.free(index, cpuinfo_addr, sprite_addr);
+    }
+  }
+  return index;
+}
+
+/*!
+ * Calls for CHECK mode: the native version runs with these, and they only remember which particles
+ * had a callback.
+ */
+struct RecordedCalls {
+  u32 cpuinfo_addr;
+  std::vector<bool> called;
+
+  void mark(u32 cpuinfo) { called.at((cpuinfo - cpuinfo_addr) / sizeof(CpuInfo)) = true; }
+  void func(u32 cpuinfo, u32, u32) { mark(cpuinfo); }
+  void relaunch(u32, u32 cpuinfo, u32) { mark(cpuinfo); }
+  void orbiter(u32 cpuinfo, u32) { mark(cpuinfo); }
+  void free(u32, u32 cpuinfo, u32) { mark(cpuinfo); }
+};
+
+/*!
+ * CHECK mode for the process blocks. The native version runs first with RecordedCalls, then the
+ * particles are put back and the mips2c version runs with the real callbacks. The particles that
+ * were valid before and had no callbacks must match exactly. The others may have been changed by
+ * GOAL code, which a callback can also use to launch new particles into invalid slots.
+ */
+template <typename Native, typename Reference>
+u32 check_process_block(const char* name,
+                        u32 cpuinfo_addr,
+                        u32 sprite_addr,
+                        u32 count,
+                        u32 false_symbol,
+                        Native&& native,
+                        Reference&& mips2c) {
+  auto* cpus = ee_ptr<CpuInfo>(cpuinfo_addr);
+  auto* sprites = ee_ptr<SpriteVec>(sprite_addr);
+  const std::vector<CpuInfo> cpus_before(cpus, cpus + count);
+  const std::vector<SpriteVec> sprites_before(sprites, sprites + count);
+
+  RecordedCalls calls{cpuinfo_addr, std::vector<bool>(count)};
+  u32 native_result = native(calls);
+  const std::vector<CpuInfo> native_cpus(cpus, cpus + count);
+  const std::vector<SpriteVec> native_sprites(sprites, sprites + count);
+  memcpy(cpus, cpus_before.data(), count * sizeof(CpuInfo));
+  memcpy(sprites, sprites_before.data(), count * sizeof(SpriteVec));
+
+  u32 result = mips2c();
+  ASSERT_MSG(result == native_result,
+             fmt::format("{} returned {}, mips2c returned {}", name, native_result, result));
+  for (u32 i = 0; i < count; i++) {
+    if (calls.called[i] || cpus_before[i].valid == false_symbol) {
+      continue;
+    }
+    ASSERT_MSG(same_floats((const float*)&cpus[i], (const float*)&native_cpus[i],
+                           sizeof(CpuInfo) / 4) &&
+                   same_floats(sprites[i].x_y_z_sx, native_sprites[i].x_y_z_sx,
+                               sizeof(SpriteVec) / 4),
+               fmt::format("{} particle {} mismatch", name, i));
+  }
+  return result;
+}
+
+}  // namespace Mips2C::sparticle_native
@@ -0,0 +1,395 @@
+#pragma once
+
+/*!
+ * @file spatial_hash_native.h
+ * Hand-written versions of the jak 2 grid-hash, sphere-hash and spatial-hash mips2c functions.
+ * Each grid cell is a bucket of bucket-size bytes, with one bit per object. These are used for
+ * nav spheres and actor lookups, which happen a lot in the city with traffic.
+ */
+
+#include <immintrin.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "common/common_types.h"
+
+#include "game/mips2c/native_mode.h"
+
+namespace Mips2C::spatial_hash_native {
+
+inline std::atomic<NativeMode>& g_mode = native_mode(NativeGroup::SPATIAL_HASH);
+
+// grid-hash-box
+struct GridHashBox {
+  s8 min[3];
+  s8 max[3];
+};
+static_assert(sizeof(GridHashBox) == 6);
+
+// grid-hash. All of these start after the type tag, where the GOAL pointer points.
+struct GridHash {
+  u32 work;
+  GridHashBox search_box;
+  s16 bucket_size;
+  float axis_scale[3];
+  s8 dimension_array[3];
+  s8 vertical_cell_count;
+  u32 bucket_array;
+  float box_min[3];
+  float box_max[3];
+  s16 object_count;
+  s16 bucket_count;
+  float min_cell_size;
+  s32 bucket_memory_size;
+  u32 mem_bucket_array;
+  u32 spr_bucket_array;
+  u32 debug_draw;
+  u32 use_scratch_ram;
+};
+static_assert(sizeof(GridHash) == 0x58 - 4);
+
+// sphere-hash
+struct SphereHash {
+  GridHash grid;
+  u32 sphere_array;
+  s16 max_object_count;
+  s16 pad;
+  u32 mem_sphere_array;
+  u32 spr_sphere_array;
+};
+static_assert(sizeof(SphereHash) == 0x68 - 4);
+
+// spatial-hash
+struct SpatialHash {
+  SphereHash sphere;
+  u32 object_array;
+  u32 mem_object_array;
+  u32 spr_object_array;
+};
+static_assert(sizeof(SpatialHash) == 0x74 - 4);
+
+// find-nav-sphere-ids-params
+struct FindNavSphereIdsParams {
+  float bsphere[4];
+  float y_threshold;
+  s16 len;
+  s16 max_len;
+  u8 mask;
+  u8 pad[3];
+  u32 array;
+};
+static_assert(sizeof(FindNavSphereIdsParams) == 0x20);
+
+// the outputs for CHECK mode
+inline NativeOutput bucket_memory(const GridHash* grid) {
+  return {ee_ptr<u8>(grid->bucket_array), (size_t)grid->bucket_memory_size};
+}
+
+inline size_t search_result_size(const GridHash* grid) {
+  return std::max(32, (grid->bucket_size + 7) & ~7);
+}
+
+/*!
+ * The search functions count their calls in *perf-stats*, and add the (unused on PC) counters
+ * at the end.
+ */
+inline void perf_stat_begin(u8* stat) {
+  u32 count;
+  memcpy(&count, stat + 4, 4);
+  count++;
+  memcpy(stat + 4, &count, 4);
+}
+
+inline void perf_stat_end(u8* stat) {
+  u32 ctrl, a, b;
+  memcpy(&ctrl, stat + 28, 4);
+  if (ctrl) {
+    // the mfpc's are dropped, so this adds whatever was left in the register.
+    memcpy(&a, stat + 32, 4);
+    a += ctrl;
+    memcpy(stat + 32, &a, 4);
+    memcpy(&b, stat + 36, 4);
+    b += a;
+    memcpy(stat + 36, &b, 4);
+  }
+}
+
+/*!
+ * Call fn(bucket) for every bucket in the box, offset by byte_offset. Like the original, the box
+ * must not be empty.
+ */
+template <typename F>
+void for_each_bucket_in_box(const GridHash* grid,
+                            const GridHashBox* box,
+                            s64 byte_offset,
+                            F&& fn) {
+  const s32 x_stride = grid->bucket_size;
+  const s32 z_stride = (s32)grid->dimension_array[0] * x_stride;
+  const s32 y_stride = (s32)grid->dimension_array[2] * z_stride;
+  const s64 x_count = 1 - box->min[0] + box->max[0];
+  const s64 y_count = 1 - box->min[1] + box->max[1];
+  const s64 z_count = 1 - box->min[2] + box->max[2];
+  u32 y_base = (s64)(box->min[0] * x_stride) + (s64)(box->min[1] * y_stride) +
+               (s64)(box->min[2] * z_stride) + byte_offset + grid->bucket_array;
+  for (s64 y = 0; y < y_count; y++, y_base += y_stride) {
+    u32 z_base = y_base;
+    for (s64 z = 0; z < z_count; z++, z_base += z_stride) {
+      u32 addr = z_base;
+      for (s64 x = 0; x < x_count; x++, addr += x_stride) {
+        fn(ee_ptr<u8>(addr));
+      }
+    }
+  }
+}
+
+/*!
+ * (method 18 grid-hash): set the bit for object id in every bucket in the box.
+ */
+inline void set_id_in_box(const GridHash* grid, const GridHashBox* box, s64 id) {
+  const u8 bit = 1 << (id & 7);
+  for_each_bucket_in_box(grid, box, id >> 3, [&](u8* b) { *b |= bit; });
+}
+
+/*!
+ * (method 19 grid-hash): clear the bit for object id in every bucket in the box.
+ */
+inline void clear_id_in_box(const GridHash* grid, const GridHashBox* box, s64 id) {
+  const u8 mask = ~(1 << (id & 7));
+  for_each_bucket_in_box(grid, box, id >> 3, [&](u8* b) { *b &= mask; });
+}
+
+/*!
+ * (method 20 grid-hash): OR together all buckets in the box into result.
+ * Unlike set/clear, empty ranges are treated as a single cell. The buckets are read and combined 8
+ * bytes at a time, so if bucket-size isn't a multiple of 8, bytes from the next bucket end up in
+ * the end of the result, like on the PS2.
+ */
+inline void search_box(const GridHash* grid, const GridHashBox* box, u8* result) {
+  const s32 x_stride = grid->bucket_size;
+  const s32 z_stride = x_stride * (s32)grid->dimension_array[0];
+  const s32 y_stride = z_stride * (s32)grid->dimension_array[2];
+  const s64 x_count = std::max<s64>(1, box->max[0] - box->min[0] + 1);
+  const s64 y_count = std::max<s64>(1, box->max[1] - box->min[1] + 1);
+  const s64 z_count = std::max<s64>(1, box->max[2] - box->min[2] + 1);
+  const int words = std::max(1, (x_stride + 7) / 8);
+  u32 y_base = (s64)(box->min[0] * x_stride) + (s64)(box->min[1] * y_stride) +
+               (s64)(box->min[2] * z_stride) + grid->bucket_array;
+
+  memset(result, 0, 32);
+  if (words == 4) {
+    // the usual case, 256 objects.
+    __m128i lo = _mm_setzero_si128();
+    __m128i hi = _mm_setzero_si128();
+    for (s64 y = 0; y < y_count; y++, y_base += y_stride) {
+      u32 z_base = y_base;
+      for (s64 z = 0; z < z_count; z++, z_base += z_stride) {
+        u32 addr = z_base;
+        for (s64 x = 0; x < x_count; x++, addr += x_stride) {
+          lo = _mm_or_si128(lo, _mm_loadu_si128(ee_ptr<__m128i>(addr)));
+          hi = _mm_or_si128(hi, _mm_loadu_si128(ee_ptr<__m128i>(addr + 16)));
+        }
+      }
+    }
+    _mm_storeu_si128((__m128i*)result, lo);
+    _mm_storeu_si128((__m128i*)(result + 16), hi);
+    return;
+  }
+
+  for (s64 y = 0; y < y_count; y++, y_base += y_stride) {
+    u32 z_base = y_base;
+    for (s64 z = 0; z < z_count; z++, z_base += z_stride) {
+      u32 addr = z_base;
+      for (s64 x = 0; x < x_count; x++, addr += x_stride) {
+        for (int w = 0; w < words; w++) {
+          u64 in, out;
+          memcpy(&in, ee_ptr<u8>(addr + 8 * w), 8);
+          memcpy(&out, result + 8 * w, 8);
+          out |= in;
+          memcpy(result + 8 * w, &out, 8);
+        }
+      }
+    }
+  }
+}
+
+/*!
+ * (method 22 grid-hash): find the box of cells that a sphere covers, clamped to the grid.
+ * This writes 8 bytes over the box. The byte after the box is kept, but the w lane from the
+ * vector math is also packed in, like the original.
+ */
+inline void sphere_to_grid_box(const GridHash* grid, GridHashBox* box, const float* sphere) {
+  const __m128 s = _mm_loadu_ps(sphere);
+  const __m128 r = _mm_set1_ps(sphere[3]);
+  u32 bucket_array = grid->bucket_array;
+  float bucket_array_f;
+  memcpy(&bucket_array_f, &bucket_array, 4);
+  const __m128 origin =
+      _mm_setr_ps(grid->box_min[0], grid->box_min[1], grid->box_min[2], bucket_array_f);
+  // axis-scale and the dimension array, as floats in w.
+  const __m128 scale = _mm_loadu_ps(grid->axis_scale);
+
+  auto to_cells = [&](__m128 p) {
+    __m128 f = _mm_mul_ps(_mm_sub_ps(p, origin), scale);
+    // vftoi0 is only done on xyz.
+    __m128i i = _mm_castps_si128(_mm_blend_ps(_mm_castsi128_ps(_mm_cvttps_epi32(f)), f, 0b1000));
+    return i;
+  };
+  __m128i lo = to_cells(_mm_sub_ps(s, r));
+  __m128i hi = to_cells(_mm_add_ps(s, r));
+
+  u32 dims;
+  memcpy(&dims, grid->dimension_array, 4);
+  const u32 max_bytes = (dims & 0xffffff) - 0x10101;
+  const __m128i max_cell = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(max_bytes));
+  lo = _mm_min_epi32(_mm_max_epi32(lo, _mm_setzero_si128()), max_cell);
+  hi = _mm_min_epi32(_mm_max_epi32(hi, _mm_setzero_si128()), max_cell);
+
+  alignas(16) s32 lo_i[4], hi_i[4];
+  _mm_store_si128((__m128i*)lo_i, lo);
+  _mm_store_si128((__m128i*)hi_i, hi);
+  u64 packed = 0;
+  for (int i = 0; i < 4; i++) {
+    packed |= (u64)(u8)lo_i[i] << (8 * i);
+    packed |= (u64)(u8)hi_i[i] << (8 * (i + 3));
+  }
+  u64 old;
+  memcpy(&old, box, 8);
+  packed |= old & (UINT64_MAX << 48);
+  memcpy(box, &packed, 8);
+}
+
+/*!
+ * Find the buckets for a sphere and combine them into the result in the work, like the search
+ * functions do with methods 22 and 20. Returns the result.
+ */
+inline const u8* search_sphere(GridHash* grid, const float* sphere) {
+  sphere_to_grid_box(grid, &grid->search_box, sphere);
+  u8* result = ee_ptr<u8>(grid->work + 12);
+  search_box(grid, &grid->search_box, result);
+  return result;
+}
+
+/*!
+ * Call fn(id) for each bit set in the first bucket-size bytes of a search result, in order.
+ */
+template <typename F>
+void for_each_id(const GridHash* grid, const u8* result, F&& fn) {
+  for (s32 i = 0; i < grid->bucket_size; i++) {
+    u32 bits = result[i];
+    while (bits) {
+      int bit = __builtin_ctz(bits);
+      bits &= bits - 1;
+      fn(i * 8 + bit);
+    }
+  }
+}
+
+inline u32 float_bits(float f) {
+  u32 result;
+  memcpy(&result, &f, 4);
+  return result;
+}
+
+// squared distance in xz, used by (method 29 sphere-hash) and find-nav-sphere-ids.
+inline float xz_dist_sq(const float* query, const float* sphere) {
+  float dx = sphere[0] - query[0];
+  float dz = sphere[2] - query[2];
+  return (dx * dx) + (dz * dz);
+}
+
+/*!
+ * (method 29 sphere-hash): find up to max_count spheres that overlap the query in xz and have a
+ * flag from mask. The ids are written to out. Returns the number found.
+ */
+inline s64 find_spheres_xz(SphereHash* hash,
+                           const float* query,
+                           u64 mask,
+                           u8* out,
+                           s64 max_count) {
+  const u8* result = search_sphere(&hash->grid, query);
+  const float* spheres = ee_ptr<float>(hash->sphere_array);
+  s64 count = 0;
+  for_each_id(&hash->grid, result, [&](int id) {
+    const float* sphere = spheres + 4 * id;
+    // the flags are in the low bits of the radius, sign extended by mfc1.
+    if (!(mask & (s64)(s32)float_bits(sphere[3]))) {
+      return;
+    }
+    // spheres at exactly the same xz as the query are never found.
+    float dist_sq = xz_dist_sq(query, sphere);
+    if (!(0.f < dist_sq)) {
+      return;
+    }
+    float r = sphere[3] + query[3];
+    if (dist_sq < r * r && count < max_count) {
+      out[count++] = id;
+    }
+  });
+  return count;
+}
+
+/*!
+ * find-nav-sphere-ids: like find_spheres_xz, but also checks the y distance and uses the params for
+ * the input and output.
+ */
+inline void find_nav_sphere_ids(SphereHash* hash, FindNavSphereIdsParams* params) {
+  const u8* result = search_sphere(&hash->grid, params->bsphere);
+  const float* spheres = ee_ptr<float>(hash->sphere_array);
+  const float* query = params->bsphere;
+  params->len = 0;
+  for_each_id(&hash->grid, result, [&](int id) {
+    const float* sphere = spheres + 4 * id;
+    if (!(params->mask & float_bits(sphere[3]))) {
+      return;
+    }
+    float dist_sq = xz_dist_sq(query, sphere);
+    if (!(0.f < dist_sq)) {
+      return;
+    }
+    if (!(std::abs(sphere[1] - query[1]) < params->y_threshold)) {
+      return;
+    }
+    float r = sphere[3] + query[3];
+    if (dist_sq < r * r && params->len < params->max_len) {
+      ee_ptr<u8>(params->array)[params->len++] = id;
+    }
+  });
+}
+
+/*!
+ * (method 33 sphere-hash): remove the object from the buckets that the sphere covers.
+ */
+inline void remove_by_id(SphereHash* hash, const float* sphere, s64 id) {
+  sphere_to_grid_box(&hash->grid, &hash->grid.search_box, sphere);
+  clear_id_in_box(&hash->grid, &hash->grid.search_box, id);
+}
+
+/*!
+ * fill-actor-list-for-sphere: find up to max_count objects with a sphere that overlaps the query.
+ * Writes the object of their hash-object-info to out. Returns the number found.
+ */
+inline s64 fill_actor_list_for_sphere(SpatialHash* hash,
+                                      const float* query,
+                                      u32* out,
+                                      s64 max_count) {
+  const u8* result = search_sphere(&hash->sphere.grid, query);
+  const float* spheres = ee_ptr<float>(hash->sphere.sphere_array);
+  const __m128 q = _mm_loadu_ps(query);
+  s64 count = 0;
+  for_each_id(&hash->sphere.grid, result, [&](int id) {
+    const float* sphere = spheres + 4 * id;
+    __m128 d = _mm_sub_ps(_mm_loadu_ps(sphere), q);
+    alignas(16) float sq[4];
+    _mm_store_ps(sq, _mm_mul_ps(d, d));
+    float dist_sq = (sq[0] + sq[1]) + sq[2];
+    float r = query[3] + sphere[3];
+    if (dist_sq < r * r && count < max_count) {
+      memcpy(&out[count++], ee_ptr<u8>(hash->object_array + 16 * id), 4);
+    }
+  });
+  return count;
+}
+
+}  // namespace Mips2C::spatial_hash_native
@@ -0,0 +1,68 @@
+#pragma once
+
+/*!
+ * @file time_of_day_native.h
+ * Hand-written version of the jak 1 time-of-day-interp-colors-scratch, which blends the 8 colors
+ * of each time of day palette entry with the mood's weights. The original uses the EE's 16-bit
+ * multiply-add instructions, and the integer rounding here is the same as those.
+ */
+
+#include <emmintrin.h>
+
+#include "common/common_types.h"
+
+#include "game/mips2c/native_mode.h"
+
+namespace Mips2C::time_of_day_native {
+
+inline std::atomic<NativeMode>& g_mode = native_mode(NativeGroup::TIME_OF_DAY);
+
+// the palette is blended in blocks of this many colors, so the last block may read past the end.
+constexpr s32 COLORS_PER_BLOCK = 32;
+// (-> time-of-day-palette height) and (-> time-of-day-palette data), from the GOAL pointer.
+constexpr u32 PALETTE_HEIGHT_OFFSET = 4;
+constexpr u32 PALETTE_DATA_OFFSET = 12;
+// (-> mood-context itimes), from the GOAL pointer: a 16-bit weight for each channel of each of the
+// 8 colors of a palette entry.
+constexpr u32 MOOD_ITIMES_OFFSET = 1852;
+
+/*!
+ * The number of colors written for a palette: the original rounds up to a whole block, and always
+ * does at least one.
+ */
+inline s32 interp_color_count(s32 height) {
+  s32 blocks = (height + COLORS_PER_BLOCK - 1) >> 5;
+  return (blocks > 0 ? blocks : 1) * COLORS_PER_BLOCK;
+}
+
+/*!
+ * time-of-day-interp-colors-scratch: each output color is the sum of the palette colors times the
+ * weights, divided by 64. The even and odd colors are summed in 16 bits and divided separately,
+ * then added and clamped to 255, or 128 for alpha.
+ */
+inline void interp_colors(u32* out, const u8* palette, const u8* itimes, s32 count) {
+  const __m128i weights[4] = {_mm_loadu_si128((const __m128i*)itimes),
+                              _mm_loadu_si128((const __m128i*)(itimes + 16)),
+                              _mm_loadu_si128((const __m128i*)(itimes + 32)),
+                              _mm_loadu_si128((const __m128i*)(itimes + 48))};
+  const __m128i limit = _mm_setr_epi16(0xff, 0xff, 0xff, 0x80, 0, 0, 0, 0);
+  const __m128i byte_mask = _mm_set1_epi16(0xff);
+  const __m128i zero = _mm_setzero_si128();
+
+  for (s32 i = 0; i < count; i++) {
+    const __m128i lo = _mm_loadu_si128((const __m128i*)(palette + 32 * i));
+    const __m128i hi = _mm_loadu_si128((const __m128i*)(palette + 32 * i + 16));
+    // only the low 16 bits of each product and sum are kept.
+    __m128i acc = _mm_mullo_epi16(_mm_unpacklo_epi8(lo, zero), weights[0]);
+    acc = _mm_add_epi16(acc, _mm_mullo_epi16(_mm_unpackhi_epi8(lo, zero), weights[1]));
+    acc = _mm_add_epi16(acc, _mm_mullo_epi16(_mm_unpacklo_epi8(hi, zero), weights[2]));
+    acc = _mm_add_epi16(acc, _mm_mullo_epi16(_mm_unpackhi_epi8(hi, zero), weights[3]));
+    acc = _mm_srli_epi16(acc, 6);
+    acc = _mm_add_epi16(acc, _mm_srli_si128(acc, 8));
+    // signed, like pminh. Only the low byte of each channel is kept.
+    acc = _mm_and_si128(_mm_min_epi16(acc, limit), byte_mask);
+    out[i] = _mm_cvtsi128_si32(_mm_packus_epi16(acc, acc));
+  }
+}
+
+}  // namespace Mips2C::time_of_day_native
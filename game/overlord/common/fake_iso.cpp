@@ -13,6 +13,10 @@
 
 #include <cstring>
 
+#ifdef __linux__
+#include <fcntl.h>
+#endif
+
 #include "common/log/log.h"
 #include "common/util/Assert.h"
 #include "common/util/FileUtil.h"
@@ -40,6 +44,7 @@ struct FakeIsoEntry {
 FakeIsoEntry fake_iso_entries[MAX_ISO_FILES];  //! List of all known files
 static FileRecord sFiles[MAX_ISO_FILES];       //! List of "FileRecords" for IsoFs API consumers
 u32 fake_iso_entry_count;                      //! Total count of fake iso files
+FakeIsoCache g_fake_iso_cache;
 
 void fake_iso_init_globals() {
   // init file lists
@@ -47,6 +52,143 @@ void fake_iso_init_globals() {
   memset(sFiles, 0, sizeof(sFiles));
 
   fake_iso_entry_count = 0;
+  g_fake_iso_cache.clear();
+}
+
+void FakeIsoCache::clear() {
+  for (auto& [idx, file] : m_files) {
+    if (file.fp) {
+      fclose(file.fp);
+    }
+  }
+  m_files.clear();
+  m_lru.clear();
+  m_blocks.clear();
+  m_size = 0;
+  m_stats = {};
+}
+
+/*!
+ * Drop the cached data for a file if it's been changed since it was read. Called when the file is
+ * opened, so recompiled files are picked up without restarting.
+ */
+void FakeIsoCache::check_file(FileRecord* fr) {
+  auto it = m_files.find(fr->location);
+  if (it == m_files.end()) {
+    return;
+  }
+  std::error_code ec;
+  auto write_time = fs::last_write_time(get_file_path(fr), ec);
+  if (ec || write_time != it->second.write_time) {
+    drop_file(fr->location);
+  }
+}
+
+void FakeIsoCache::drop_file(u32 file_idx) {
+  for (auto it = m_lru.begin(); it != m_lru.end();) {
+    if ((it->key >> 32) == file_idx) {
+      m_size -= it->size;
+      m_blocks.erase(it->key);
+      it = m_lru.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  auto& file = m_files.at(file_idx);
+  if (file.fp) {
+    fclose(file.fp);
+  }
+  m_files.erase(file_idx);
+}
+
+FakeIsoCache::File& FakeIsoCache::open(u32 file_idx) {
+  auto& file = m_files[file_idx];
+  if (!file.fp) {
+    const char* path = fake_iso_entries[file_idx].file_path;
+    auto full_path = file_util::get_jak_project_dir() / path;
+    file.fp = file_util::open_file(full_path, "rb");
+    if (!file.fp) {
+      lg::error("[OVERLORD] fake iso could not open the file \"{}\"", full_path.string());
+    }
+    ASSERT(file.fp);
+#ifdef __linux__
+    // files are mostly read start to end, so let the kernel read ahead more.
+    posix_fadvise(fileno(file.fp), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    std::error_code ec;
+    file.write_time = fs::last_write_time(full_path, ec);
+    fseek(file.fp, 0, SEEK_END);
+    file.length = ftell(file.fp);
+    rewind(file.fp);
+  }
+  return file;
+}
+
+const FakeIsoCache::Block& FakeIsoCache::get_block(u32 file_idx, u32 block_idx) {
+  u64 key = ((u64)file_idx << 32) | block_idx;
+  auto existing = m_blocks.find(key);
+  if (existing != m_blocks.end()) {
+    m_stats.hits++;
+    m_lru.splice(m_lru.begin(), m_lru, existing->second);
+    return *existing->second;
+  }
+
+  m_stats.misses++;
+  auto& file = open(file_idx);
+  u32 offset = block_idx * BLOCK_SIZE;
+  ASSERT(offset < file.length);
+  Block block;
+  block.key = key;
+  block.size = std::min(BLOCK_SIZE, file.length - offset);
+  block.data = std::make_unique<u8[]>(block.size);
+  fseek(file.fp, offset, SEEK_SET);
+  if (fread(block.data.get(), block.size, 1, file.fp) != 1) {
+    ASSERT_MSG(false, "fake iso block read failed");
+  }
+  m_stats.bytes_read += block.size;
+
+  while (m_size + block.size > DEFAULT_CAPACITY && !m_lru.empty()) {
+    m_size -= m_lru.back().size;
+    m_blocks.erase(m_lru.back().key);
+    m_lru.pop_back();
+  }
+  m_size += block.size;
+  m_lru.push_front(std::move(block));
+  m_blocks[key] = m_lru.begin();
+  return m_lru.front();
+}
+
+u32 FakeIsoCache::file_length(FileRecord* fr) {
+  return open(fr->location).length;
+}
+
+/*!
+ * Read up to size bytes at offset in the file to dst. Returns the number of bytes read, which is
+ * only less than size at the end of the file.
+ */
+u32 FakeIsoCache::read(FileRecord* fr, u32 offset, void* dst, u32 size) {
+  u32 length = file_length(fr);
+  if (offset >= length) {
+    return 0;
+  }
+  size = std::min(size, length - offset);
+  u32 done = 0;
+  while (done < size) {
+    u32 pos = offset + done;
+    const auto& block = get_block(fr->location, pos / BLOCK_SIZE);
+    u32 block_offset = pos % BLOCK_SIZE;
+    u32 amount = std::min(size - done, block.size - block_offset);
+    memcpy((u8*)dst + done, block.data.get() + block_offset, amount);
+    done += amount;
+  }
+  return done;
+}
+
+void FakeIsoCache::log_stats() const {
+  u64 total = m_stats.hits + m_stats.misses;
+  lg::info("[FAKEISO] cache: {} hits, {} misses ({:.1f}% hit), {:.2f} MB read, {:.2f} MB cached",
+           m_stats.hits, m_stats.misses, total ? 100. * m_stats.hits / total : 0.,
+           m_stats.bytes_read / (1024. * 1024.), m_size / (1024. * 1024.));
 }
 
 /*!
@@ -11,8 +11,65 @@
  * should work.
  */
 
+#include <cstdio>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
 #include "isocommon.h"
 
+#include "common/util/FileUtil.h"
+
+/*!
+ * A cache of 64 kB blocks of the fake iso files, so streams that loop and files that are loaded
+ * again don't go back to the disk. The least recently used blocks are dropped once it's full.
+ * A file's blocks are dropped if it changes on disk, checked when it's opened.
+ */
+class FakeIsoCache {
+ public:
+  static constexpr u32 BLOCK_SIZE = 0x10000;
+  static constexpr size_t DEFAULT_CAPACITY = 64 * 1024 * 1024;
+
+  struct Stats {
+    u64 hits = 0;
+    u64 misses = 0;
+    u64 bytes_read = 0;  // from the disk
+  };
+
+  ~FakeIsoCache() { clear(); }
+  void clear();
+  void check_file(FileRecord* fr);
+  u32 file_length(FileRecord* fr);
+  u32 read(FileRecord* fr, u32 offset, void* dst, u32 size);
+  const Stats& stats() const { return m_stats; }
+  void log_stats() const;
+
+ private:
+  struct File {
+    FILE* fp = nullptr;
+    u32 length = 0;
+    fs::file_time_type write_time;
+  };
+
+  struct Block {
+    u64 key;
+    u32 size;
+    std::unique_ptr<u8[]> data;
+  };
+
+  File& open(u32 file_idx);
+  const Block& get_block(u32 file_idx, u32 block_idx);
+  void drop_file(u32 file_idx);
+
+  std::unordered_map<u32, File> m_files;
+  std::list<Block> m_lru;  // most recently used at the front
+  std::unordered_map<u64, std::list<Block>::iterator> m_blocks;
+  size_t m_size = 0;
+  Stats m_stats;
+};
+
+extern FakeIsoCache g_fake_iso_cache;
+
 void fake_iso_init_globals();
 int fake_iso_FS_Init();
 const char* get_file_path(FileRecord* fr);
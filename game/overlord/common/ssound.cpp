@@ -348,6 +348,47 @@ void UpdateLocation(Sound* sound) {
   }
 }
 
+/*!
+ * Like calling UpdateAutoVol (if needed) and UpdateLocation on every playing sound effect, but the
+ * new volumes and pans are all sent to the sound player at once.
+ */
+void UpdateLocations(s32 ticks) {
+  Sound* sounds[64];
+  s32 handles[64];
+  s32 volumes[64];
+  s32 pans[64];
+  s32 count = 0;
+
+  for (auto& s : gSounds) {
+    if (s.id == 0 || s.is_music != 0) {
+      continue;
+    }
+    if (s.auto_time != 0) {
+      UpdateAutoVol(&s, ticks);
+      if (s.id == 0) {
+        continue;
+      }
+    }
+    if (g_game_version == GameVersion::Jak1 && (s.bank_entry->fallof_params >> 28) == 0) {
+      continue;
+    }
+
+    s32 volume = GetVolume(&s);
+    sounds[count] = &s;
+    handles[count] = s.sound_handle;
+    volumes[count] = volume;
+    pans[count] = volume == 0 ? 0 : GetPan(&s);
+    count++;
+  }
+
+  snd_UpdateSoundVolPans(handles, volumes, pans, count);
+  for (s32 i = 0; i < count; i++) {
+    if (handles[i] == 0) {
+      sounds[i]->id = 0;
+    }
+  }
+}
+
 void UpdateAutoVol(Sound* sound, s32 ticks) {
   if (ticks < sound->auto_time) {
     s32 nvol = sound->new_volume;
@@ -70,5 +70,6 @@ s32 CalculateAngle(Vec3w* trans);
 void KillSoundsInGroup(u8 group);
 void UpdateLocation(Sound* sound);
 void UpdateAutoVol(Sound* sound, s32 ticks);
+void UpdateLocations(s32 ticks);
 void PrintActiveSounds();
 void SetCurve(s32 curve, s32 fallof, s32 ease);
@@ -49,6 +49,7 @@ void fake_iso_init_globals() {
  */
 LoadStackEntry* FS_Open(FileRecord* fr, int32_t offset) {
   lg::debug("[OVERLORD] FS Open {}", fr->name);
+  g_fake_iso_cache.check_file(fr);
   LoadStackEntry* selected = nullptr;
   // find first unused spot on load stack.
   for (uint32_t i = 0; i < MAX_OPEN_FILES; i++) {
@@ -75,6 +76,7 @@ LoadStackEntry* FS_Open(FileRecord* fr, int32_t offset) {
  */
 LoadStackEntry* FS_OpenWad(FileRecord* fr, int32_t offset) {
   lg::debug("[OVERLORD] FS_OpenWad {}", fr->name);
+  g_fake_iso_cache.check_file(fr);
   LoadStackEntry* selected = nullptr;
   for (uint32_t i = 0; i < MAX_OPEN_FILES; i++) {
     if (!sLoadStack[i].fr) {
@@ -106,8 +108,6 @@ void FS_Close(LoadStackEntry* fd) {
 /*!
  * Begin reading!  Returns FS_READ_OK on success (always)
  * This is an ISO FS API Function
- *
- * Idea: do the fopen in FS_Open and keep the file open?  It would be faster.
  */
 uint32_t FS_BeginRead(LoadStackEntry* fd, void* buffer, int32_t len) {
   ASSERT(fd->fr->location < fake_iso_entry_count);
@@ -123,29 +123,8 @@ uint32_t FS_BeginRead(LoadStackEntry* fd, void* buffer, int32_t len) {
   real_size = sectors * SECTOR_SIZE;
   u32 offset_into_file = SECTOR_SIZE * fd->location;
 
-  const char* path = get_file_path(fd->fr);
-  FILE* fp = file_util::open_file(path, "rb");
-  if (!fp) {
-    lg::error("[OVERLORD] fake iso could not open the file \"{}\"", path);
-  }
-  ASSERT(fp);
-  fseek(fp, 0, SEEK_END);
-  uint32_t file_len = ftell(fp);
-  rewind(fp);
-
-  if (offset_into_file < file_len) {
-    if (offset_into_file) {
-      fseek(fp, offset_into_file, SEEK_SET);
-    }
-
-    if (offset_into_file + real_size > file_len) {
-      real_size = (file_len - offset_into_file);
-    }
-
-    if (fread(buffer, real_size, 1, fp) != 1) {
-      ASSERT(false);
-    }
-  }
+  // read through the cache, which keeps the file open and reads it in large blocks.
+  g_fake_iso_cache.read(fd->fr, offset_into_file, buffer, real_size);
 
   if (len < 0) {
     len = len + 0x7ff;
@@ -154,8 +133,6 @@ uint32_t FS_BeginRead(LoadStackEntry* fd, void* buffer, int32_t len) {
   fd->location += (len / SECTOR_SIZE);
   sReadInfo = fd;
 
-  fclose(fp);
-
   return CMD_STATUS_IN_PROGRESS;
 }
 
@@ -211,9 +188,8 @@ uint32_t FS_LoadSoundBank(char* name, SoundBank* bank) {
       return 0;
   }
 
-  auto fp = file_util::open_file(get_file_path(file), "rb");
-  fread(bank, offset, 1, fp);
-  fclose(fp);
+  g_fake_iso_cache.check_file(file);
+  g_fake_iso_cache.read(file, 0, bank, offset);
 
   s32 handle = snd_BankLoadEx(get_file_path(file), offset, 0, 0);
   snd_ResolveBankXREFS();
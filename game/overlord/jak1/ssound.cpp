@@ -125,14 +125,7 @@ void SetEarTrans(Vec3w* ear_trans0, Vec3w* ear_trans1, Vec3w* cam_trans, s32 cam
   gCamTrans = *cam_trans;
   gCamAngle = cam_angle;
 
-  for (auto& s : gSounds) {
-    if (s.id != 0 && s.is_music == 0) {
-      if (s.auto_time != 0) {
-        UpdateAutoVol(&s, delta);
-      }
-      UpdateLocation(&s);
-    }
-  }
+  UpdateLocations(delta);
 
   SetVAGVol();
 }
@@ -11,10 +11,24 @@
 using namespace iop;
 namespace jak2 {
 
+namespace {
+void push_free_page(PageList* page_list, Page* page) {
+  if (page->state == PageState::FREE) {
+    // the original would count this page twice. it can't be on the stack twice.
+    printf("IOP: pages: page %d freed twice\n", page->maybe_page_id);
+    return;
+  }
+  ASSERT(page_list->free_pages < page_list->page_count);
+  page->state = PageState::FREE;
+  page_list->free_stack[page_list->free_pages++] = page;
+}
+}  // namespace
+
 void InitPagedMemory(PageList* pool, int page_count, int page_size) {
   // this is such a hack...
   // we assume that we're allocated on the scratchpad, and can jump bump the pointer again.
   pool->pages = (Page*)(pool + 1);
+  ASSERT(page_count <= MAX_PAGES_IN_POOL);
   pool->page_count = page_count;
   pool->page_size = page_size;
   ScratchPadMemory = ScratchPadMemory + page_count * sizeof(Page);
@@ -24,6 +38,8 @@ void InitPagedMemory(PageList* pool, int page_count, int page_size) {
   }
   pool->sector_per_page = fixed_page_size >> 0xb;
   pool->free_pages = page_count;
+  pool->min_free_pages = page_count;
+  pool->alloc_count = 0;
   pool->page_memory = nullptr;
   uintptr_t addr = (uintptr_t)AllocSysMemory(0, page_count * page_size + 0x100, nullptr);
   addr += 0x3f;
@@ -47,6 +63,8 @@ void InitPagedMemory(PageList* pool, int page_count, int page_size) {
       page->next = nullptr;
       page->prev = nullptr;
       page->end_page_first_only = nullptr;
+      // the lowest pages are on top, so they're used first like the original.
+      pool->free_stack[page_count - 1 - i] = page;
       page++;
       mem += page_size;
     }
@@ -84,29 +102,29 @@ Page* AllocPages(PageList* page_list, u32 num_pages) {
   if (num_pages == 0) {
     first_page = nullptr;
   } else {
+    // changed: the original scanned the pages for free ones, these are popped from free_stack.
     Page* prev_page = nullptr;
-    int page_idx_in_page_list = 0;
     u32 added_pages = 0;
-    Page* iter = page_list->pages;
-    do {
-      if (iter->state == PageState::FREE) {
-        added_pages++;
-        page_list->free_pages = page_list->free_pages + -1;
-        iter->state = PageState::ALLOCATED_EMPTY;
-        iter->pages_after_this = num_pages - added_pages;
-        if (!first_page) {
-          iter->prev = nullptr;
-          first_page = iter;
-        } else {
-          prev_page->next = iter;
-          iter->prev = prev_page;
-        }
-        iter->end_page_first_only = nullptr;
-        prev_page = iter;
+    while (added_pages < num_pages) {
+      Page* iter = page_list->free_stack[--page_list->free_pages];
+      ASSERT(iter->state == PageState::FREE);
+      added_pages++;
+      iter->state = PageState::ALLOCATED_EMPTY;
+      iter->pages_after_this = num_pages - added_pages;
+      if (!first_page) {
+        iter->prev = nullptr;
+        first_page = iter;
+      } else {
+        prev_page->next = iter;
+        iter->prev = prev_page;
       }
-      page_idx_in_page_list++;
-      iter++;
-    } while ((page_idx_in_page_list < MAX_PAGES_IN_POOL) && (added_pages < num_pages));
+      iter->end_page_first_only = nullptr;
+      prev_page = iter;
+    }
+    page_list->alloc_count++;
+    if (page_list->free_pages < page_list->min_free_pages) {
+      page_list->min_free_pages = page_list->free_pages;
+    }
     prev_page->next = nullptr;
     first_page->end_page_first_only = prev_page;
     first_page->free_pages = added_pages;
@@ -131,8 +149,7 @@ Page* FreePagesList(PageList* page_list, Page* pages) {
       pages->prev = nullptr;
       pages->next = nullptr;
       pages->end_page_first_only = nullptr;
-      pages->state = PageState::FREE;
-      page_list->free_pages = page_list->free_pages + 1;
+      push_free_page(page_list, pages);
       pages = next;
     } while (next);
   }
@@ -165,8 +182,7 @@ Page* StepTopPage(PageList* param_1, Page* top_page) {
 
     // return to pool
     top_page->next = nullptr;
-    top_page->state = PageState::FREE;
-    param_1->free_pages = param_1->free_pages + 1;
+    push_free_page(param_1, top_page);
   }
   return result;
 }
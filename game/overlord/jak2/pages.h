@@ -31,6 +31,8 @@ struct Page {
   Page* end_page_first_only;
 };
 
+constexpr int MAX_PAGES_IN_POOL = 0x12;
+
 struct PageList {
   u32 page_count;
   u32 page_size;
@@ -38,9 +40,13 @@ struct PageList {
   u32 free_pages;
   u8* page_memory;
   Page* pages;
-};
 
-constexpr int MAX_PAGES_IN_POOL = 0x12;
+  // added: the free pages, as a stack with free_pages entries, so allocating doesn't scan.
+  Page* free_stack[MAX_PAGES_IN_POOL];
+  // added: the fewest free pages there have been, and the number of allocations.
+  u32 min_free_pages;
+  u32 alloc_count;
+};
 void InitPagedMemory(PageList* pool, int page_count, int page_size);
 Page* AllocPagesBytes(PageList* page_list, u32 size_bytes);
 Page* AllocPages(PageList* page_list, u32 num_pages);
@@ -1,6 +1,7 @@
 #include "spustreams.h"
 
 #include "common/common_types.h"
+#include "common/log/log.h"
 #include "common/util/Assert.h"
 
 #include "game/overlord/jak2/dma.h"
@@ -19,8 +20,21 @@ void ProcessStreamData();
 void StopVagStream(VagCmd* cmd, int suspend_irq);
 
 s32 StreamsThread = 0;
+// added: the number of times a stream voice ran past its buffers while there was still data to
+// send, meaning the ISO reads didn't keep up.
+u32 StreamUnderruns = 0;
 void spusstreams_init_globals() {
   StreamsThread = 0;
+  StreamUnderruns = 0;
+}
+
+// added: called when the voice has jumped to the trap address. At the end of a stream that's
+// expected, so it's only an underrun if there's more to transfer.
+static void NoteStreamUnderrun(VagCmd* cmd) {
+  if (cmd->xfer_size > 0) {
+    StreamUnderruns++;
+    lg::warn("[OVERLORD] stream {} underrun ({} total)", cmd->name, StreamUnderruns);
+  }
 }
 
 int ProcessVAGData(CmdHeader* param_1_in, Buffer* param_2) {
@@ -317,6 +331,7 @@ int GetVAGStreamPos(VagCmd* param_1) {
       goto LAB_00010860;
     // CpuSuspendIntr(local_30);
     if ((0x4000 < primary_dma_offset) && (param_1->byte20 == '\0')) {
+      NoteStreamUnderrun(param_1);
       param_1->byte20 = '\x01';
       param_1->byte21 = '\0';
       param_1->byte22 = '\0';
@@ -359,6 +374,7 @@ int GetVAGStreamPos(VagCmd* param_1) {
       } else {
       }
     } else if (pRVar7->byte20 == '\0') {
+      NoteStreamUnderrun(param_1);
       param_1->byte20 = '\x01';
       param_1->byte21 = '\0';
       param_1->byte22 = '\0';
@@ -592,6 +608,7 @@ LAB_00010860:
       goto LAB_000108cc;
     }
   } else if (param_1->byte20 == '\0') {
+    NoteStreamUnderrun(param_1);
     param_1->byte20 = '\x01';
     param_1->byte21 = '\0';
     param_1->byte22 = '\0';
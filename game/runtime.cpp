@@ -72,7 +72,10 @@
 #include "game/overlord/jak2/stream.h"
 #include "game/overlord/jak2/streamlist.h"
 #include "game/overlord/jak2/vag.h"
+#include "game/settings/settings.h"
 #include "game/system/Deci2Server.h"
+#include "game/system/benchmark.h"
+#include "game/system/hid/pad_recording.h"
 #include "game/system/iop_thread.h"
 #include "game/system/vm/dmac.h"
 #include "game/system/vm/vm.h"
@@ -90,6 +93,7 @@ int g_server_port = DECI2_PORT;
 namespace {
 
 int g_argc = 0;
+int g_listener_print_interval_ms = 0;
 const char** g_argv = nullptr;
 
 /*!
@@ -102,6 +106,7 @@ void deci2_runner(SystemThreadInterface& iface) {
 
   // create and register server
   Deci2Server server(shutdown_callback, DECI2_PORT - 1 + (int)g_game_version);
+  server.set_print_interval(g_listener_print_interval_ms);
   ee::LIBRARY_sceDeci2_register(&server);
 
   // now its ok to continue with initialization
@@ -316,12 +321,17 @@ void iop_runner(SystemThreadInterface& iface, GameVersion version) {
     prof().root_event();
     // The IOP scheduler informs us of how many microseconds are left until it has something to do.
     // So we can wait for that long or until something else needs it to wake up.
-    auto wait_duration = iop.kernel.dispatch();
+    auto wait_duration = [&] {
+      benchmark::ScopedCpuTime cpu_time(benchmark::Counter::IOP);
+      return iop.kernel.dispatch();
+    }();
     if (wait_duration) {
       iop.wait_run_iop(*wait_duration);
     }
   }
 
+  iop.kernel.log_thread_stats();
+  g_fake_iso_cache.log_stats();
   Gfx::clear_vsync_callback();
 }
 }  // namespace
@@ -368,11 +378,15 @@ RuntimeExitStatus exec_runtime(GameLaunchOptions game_options, int argc, const c
   g_argc = argc;
   g_argv = argv;
   g_main_thread_id = std::this_thread::get_id();
+  prof().set_thread_name("Main");
 
   bool enable_display = !game_options.disable_display;
   VM::use = !game_options.disable_debug_vm;
   g_game_version = game_options.game_version;
+  game_settings::start_loading_settings();
   g_server_port = game_options.server_port;
+  g_direct_dgo_loads = game_options.direct_dgo_loads;
+  g_listener_print_interval_ms = game_options.listener_print_interval_ms;
 
   gStartTime = time(nullptr);
   prof().instant_event("ROOT");
@@ -381,12 +395,29 @@ RuntimeExitStatus exec_runtime(GameLaunchOptions game_options, int argc, const c
     init_discord_rpc();
   }
 
+  if (game_options.null_renderer) {
+    enable_display = false;
+  }
+  benchmark::BenchmarkOptions benchmark_options;
+  benchmark_options.frames = game_options.benchmark_frames;
+  benchmark_options.warmup_frames = game_options.benchmark_warmup_frames;
+  benchmark_options.csv_path = game_options.benchmark_csv_path;
+  benchmark::start(benchmark_options);
+  if (!game_options.pad_playback_path.empty()) {
+    pad_recording::start_playback(game_options.pad_playback_path);
+  } else if (!game_options.pad_record_path.empty()) {
+    pad_recording::start_recording(game_options.pad_record_path);
+  }
+
   // initialize graphics first - the EE code will upload textures during boot and we
   // want the graphics system to catch them.
   {
     auto p = scoped_prof("startup::exec_runtime::init_gfx");
     if (enable_display) {
       Gfx::Init(g_game_version);
+    } else if (game_options.null_renderer) {
+      Gfx::SetRenderer(GfxPipeline::Null);
+      Gfx::GetCurrentRenderer()->init(Gfx::g_global_settings);
     }
   }
 
@@ -459,6 +490,7 @@ RuntimeExitStatus exec_runtime(GameLaunchOptions game_options, int argc, const c
   if (enable_display) {
     Gfx::Exit();
   }
+  pad_recording::stop();
   lg::info("GOAL Runtime Shutdown (code {})", fmt::underlying(MasterExit));
   munmap(g_ee_main_mem, EE_MAIN_MEM_SIZE);
   Discord_Shutdown();
@@ -6,6 +6,7 @@
 #include "game/graphics/gfx.h"
 #include "game/kernel/common/kernel_types.h"
 #include "game/system/hid/input_bindings.h"
+#include "game/system/hid/pad_recording.h"
 
 /*!
  * @file libpad.cpp
@@ -66,6 +67,10 @@ int scePadRead(int port, int /*slot*/, u8* rdata) {
 
   cpad->status = 0x70 /* (dualshock2) */ | (20 / 2); /* (dualshock2 data size) */
 
+  if (pad_recording::playback(port, cpad)) {
+    return 32;
+  }
+
   std::optional<std::shared_ptr<PadData>> pad_data = std::nullopt;
   if (Display::GetMainDisplay()) {
     pad_data = Display::GetMainDisplay()->get_input_manager()->get_current_data(port);
@@ -87,6 +92,7 @@ int scePadRead(int port, int /*slot*/, u8* rdata) {
     }
   }
 
+  pad_recording::record(port, *cpad);
   return 32;
 }
 
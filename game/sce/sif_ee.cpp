@@ -4,6 +4,10 @@
 #include <cstring>
 #include <unordered_map>
 
+#ifdef __linux__
+#include <fcntl.h>
+#endif
+
 #include "common/util/Assert.h"
 #include "common/util/FileUtil.h"
 
@@ -106,6 +110,12 @@ s32 sceOpen(const char* filename, s32 flag) {
   switch (flag) {
     case SCE_RDONLY: {
       fp = file_util::open_file(name.c_str(), "rb");
+#ifdef __linux__
+      // files are read start to end in one go, so let the kernel read ahead more.
+      if (fp) {
+        posix_fadvise(fileno(fp), 0, 0, POSIX_FADV_SEQUENTIAL);
+      }
+#endif
     } break;
 
     default: {
@@ -1,12 +1,90 @@
 #include "settings.h"
 
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
 #include "common/log/log.h"
+#include "common/util/ThreadPool.h"
 #include "common/util/json_util.h"
 
 #include "game/runtime.h"
 
 namespace game_settings {
 
+namespace {
+std::string debug_settings_path() {
+  return (file_util::get_user_misc_dir(g_game_version) / "debug-settings.json").string();
+}
+
+std::string display_settings_path() {
+  return (file_util::get_user_settings_dir(g_game_version) / "display-settings.json").string();
+}
+
+std::string input_settings_path() {
+  return (file_util::get_user_settings_dir(g_game_version) / "input-settings.json").string();
+}
+
+/*!
+ * Read and parse a settings file, or nothing if it doesn't exist.
+ */
+std::optional<json> load_settings_file(const std::string& file_path, const std::string& name) {
+  if (!file_util::file_exists(file_path)) {
+    return std::nullopt;
+  }
+  lg::info("Loading {} at {}", name, file_path);
+  return parse_commented_json(file_util::read_text_file(file_path), name);
+}
+
+// settings files started by start_loading_settings, by path. Each one is used once.
+std::mutex g_preload_mutex;
+std::unordered_map<std::string, std::shared_future<std::optional<json>>> g_preloaded_files;
+
+/*!
+ * Get a settings file, either from start_loading_settings, or by loading it now. Errors loading
+ * the file are thrown here, either way.
+ */
+std::optional<json> read_settings_file(const std::string& file_path, const std::string& name) {
+  std::shared_future<std::optional<json>> preloaded;
+  {
+    std::lock_guard<std::mutex> lk(g_preload_mutex);
+    auto it = g_preloaded_files.find(file_path);
+    if (it != g_preloaded_files.end()) {
+      preloaded = std::move(it->second);
+      g_preloaded_files.erase(it);
+    }
+  }
+  if (preloaded.valid()) {
+    return preloaded.get();
+  }
+  return load_settings_file(file_path, name);
+}
+}  // namespace
+
+/*!
+ * Start reading and parsing the settings files on the thread pool, so they're ready by the time
+ * the graphics and input systems that use them are created. g_game_version must be set.
+ */
+void start_loading_settings() {
+  std::lock_guard<std::mutex> lk(g_preload_mutex);
+  for (const auto& [file_path, name] :
+       {std::pair<std::string, std::string>{debug_settings_path(), "debug-settings.json"},
+        {display_settings_path(), "display-settings.json"},
+        {input_settings_path(), "input-settings.json"}}) {
+    auto promise = std::make_shared<std::promise<std::optional<json>>>();
+    g_preloaded_files[file_path] = promise->get_future().share();
+    ThreadPool::global().submit([promise, file_path = file_path, name = name]() {
+      try {
+        promise->set_value(load_settings_file(file_path, name));
+      } catch (...) {
+        promise->set_exception(std::current_exception());
+      }
+    });
+  }
+}
+
 void to_json(json& j, const DebugSettings& obj) {
   j = json{{"version", obj.version},
            {"show_imgui", obj.show_imgui},
@@ -33,14 +111,10 @@ void from_json(const json& j, DebugSettings& obj) {
 
 DebugSettings::DebugSettings() {
   try {
-    std::string file_path =
-        (file_util::get_user_misc_dir(g_game_version) / "debug-settings.json").string();
-    if (!file_util::file_exists(file_path)) {
-      return;
+    auto data = read_settings_file(debug_settings_path(), "debug-settings.json");
+    if (data) {
+      from_json(*data, *this);
     }
-    lg::info("Loading display settings at {}", file_path);
-    auto raw = file_util::read_text_file(file_path);
-    from_json(parse_commented_json(raw, "debug-settings.json"), *this);
   } catch (std::exception& e) {
     // do nothing
     lg::error("Error encountered when attempting to load debug settings {}", e.what());
@@ -70,14 +144,10 @@ void from_json(const json& j, DisplaySettings& obj) {
 
 DisplaySettings::DisplaySettings() {
   try {
-    std::string file_path =
-        (file_util::get_user_settings_dir(g_game_version) / "display-settings.json").string();
-    if (!file_util::file_exists(file_path)) {
-      return;
+    auto data = read_settings_file(display_settings_path(), "display-settings.json");
+    if (data) {
+      from_json(*data, *this);
     }
-    lg::info("Loading display settings at {}", file_path);
-    auto raw = file_util::read_text_file(file_path);
-    from_json(parse_commented_json(raw, "display-settings.json"), *this);
   } catch (std::exception& e) {
     // do nothing
     lg::error("Error encountered when attempting to load display settings {}", e.what());
@@ -113,14 +183,10 @@ InputSettings::InputSettings() {
   try {
     keyboard_binds = DEFAULT_KEYBOARD_BINDS;
     mouse_binds = DEFAULT_MOUSE_BINDS;
-    std::string file_path =
-        (file_util::get_user_settings_dir(g_game_version) / "input-settings.json").string();
-    if (!file_util::file_exists(file_path)) {
-      return;
+    auto data = read_settings_file(input_settings_path(), "input-settings.json");
+    if (data) {
+      from_json(*data, *this);
     }
-    lg::info("Loading display settings at {}", file_path);
-    auto raw = file_util::read_text_file(file_path);
-    from_json(parse_commented_json(raw, "input-settings.json"), *this);
   } catch (std::exception& e) {
     // do nothing
     lg::error("Error encountered when attempting to load input settings {}", e.what());
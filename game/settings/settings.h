@@ -7,6 +7,8 @@
 #include "game/tools/filter_menu/filter_menu.h"
 
 namespace game_settings {
+void start_loading_settings();
+
 struct DebugSettings {
   DebugSettings();
 
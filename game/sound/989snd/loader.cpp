@@ -19,7 +19,7 @@ enum chunk : u32 { bank, samples, midi };
 
 #define FOURCC(a, b, c, d) ((u32)(((d) << 24) | ((c) << 16) | ((b) << 8) | (a)))
 
-u32 loader::read_bank(std::fstream& in) {
+u32 loader::read_bank(std::istream& in) {
   size_t origin = in.tellg();
   FileAttributes<3> attr;
   in.read((char*)(&attr), sizeof(attr));
@@ -76,7 +76,7 @@ u32 loader::read_bank(std::fstream& in) {
   return bank_id;
 }
 
-void loader::load_midi(std::fstream& in) {
+void loader::load_midi(std::istream& in) {
   FileAttributes<1> attr;
   u32 cur = in.tellg();
 
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: ISC
 #pragma once
 
+#include <istream>
 #include <memory>
 #include <vector>
 
@@ -42,8 +43,8 @@ class loader : public locator {
 
   void unload_bank(u32 id);
 
-  u32 read_bank(std::fstream& in);
-  void load_midi(std::fstream& in);
+  u32 read_bank(std::istream& in);
+  void load_midi(std::istream& in);
 
   bool read_midi();
 
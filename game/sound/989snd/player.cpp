@@ -3,6 +3,7 @@
 #include "player.h"
 
 #include <fstream>
+#include <sstream>
 
 #include "third-party/fmt/core.h"
 
@@ -10,6 +11,7 @@
 #include <combaseapi.h>
 #include <windows.h>
 #endif
+#include "common/global_profiler/GlobalProfiler.h"
 #include "common/log/log.h"
 
 namespace snd {
@@ -83,6 +85,13 @@ long player::sound_callback([[maybe_unused]] cubeb_stream* stream,
                             [[maybe_unused]] const void* input,
                             void* output_buffer,
                             long nframes) {
+  // cubeb makes the thread that calls this.
+  thread_local bool named_thread = false;
+  if (!named_thread) {
+    PROF_THREAD_NAME("Audio");
+    named_thread = true;
+  }
+  PROF_ZONE("audio-tick");
   ((player*)user)->tick((s16_output*)output_buffer, nframes);
   return nframes;
 }
@@ -96,7 +105,7 @@ void player::tick(s16_output* stream, int samples) {
   m_tick++;
   static int htick = 200;
   static int stick = 48000;
-  for (int i = 0; i < samples; i++) {
+  while (samples > 0) {
     // The handlers expect to tick at 240hz
     // 48000/240 = 200
     if (htick == 200) {
@@ -114,14 +123,18 @@ void player::tick(s16_output* stream, int samples) {
       htick = 0;
     }
 
-    if (stick == 48000) {
+    if (stick >= 48000) {
       // fmt::print("{} handlers active\n", m_handlers.size());
       stick = 0;
     }
 
-    stick++;
-    htick++;
-    *stream++ = m_synth.tick();
+    // mix up to the next handler tick in one go.
+    int count = std::min(samples, 200 - htick);
+    stick += count;
+    htick += count;
+    m_synth.tick_block(stream, count);
+    stream += count;
+    samples -= count;
   }
 }
 
@@ -230,11 +243,30 @@ void player::set_master_volume(u32 group, s32 volume) {
 }
 
 u32 player::load_bank(fs::path& filepath, size_t offset) {
-  std::scoped_lock lock(m_ticklock);
+  // read the bank into memory before taking the lock, so the audio thread doesn't wait on the disk.
   std::fstream in(filepath, std::fstream::binary | std::fstream::in);
   in.seekg(offset, std::fstream::beg);
+  FileAttributes<3> attr{};
+  in.read((char*)&attr, sizeof(attr));
+  size_t size = sizeof(attr);
+  for (u32 i = 0; i < std::min(attr.num_chunks, 3u); i++) {
+    size = std::max(size, (size_t)attr.where[i].offset + attr.where[i].size);
+  }
+  if (attr.num_chunks >= 3) {
+    // the midi chunk has its own header, with offsets from the start of the chunk.
+    FileAttributes<1> midi_attr{};
+    in.seekg(offset + attr.where[2].offset, std::fstream::beg);
+    in.read((char*)&midi_attr, sizeof(midi_attr));
+    size = std::max(size, (size_t)attr.where[2].offset + midi_attr.where[0].offset +
+                              midi_attr.where[0].size);
+  }
+  std::string data(size, '\0');
+  in.seekg(offset, std::fstream::beg);
+  in.read(data.data(), size);
+  std::istringstream bank(std::move(data));
 
-  return m_loader.read_bank(in);
+  std::scoped_lock lock(m_ticklock);
+  return m_loader.read_bank(bank);
 }
 
 void player::unload_bank(u32 bank_handle) {
@@ -312,6 +344,27 @@ void player::set_sound_vol_pan(s32 sound_id, s32 vol, s32 pan) {
   handler->second->set_vol_pan(vol, pan);
 }
 
+/*!
+ * Set the volume and pan of many sounds while holding the lock once. A sound with a volume of 0 is
+ * stopped instead, and the handles of sounds that are no longer playing are set to 0.
+ */
+void player::update_sound_vol_pans(s32* sound_handles,
+                                   const s32* vols,
+                                   const s32* pans,
+                                   int count) {
+  std::scoped_lock lock(m_ticklock);
+  for (int i = 0; i < count; i++) {
+    auto handler = m_handlers.find(sound_handles[i]);
+    if (handler == m_handlers.end()) {
+      sound_handles[i] = 0;
+    } else if (vols[i] == 0) {
+      handler->second->stop();
+    } else {
+      handler->second->set_vol_pan(vols[i], pans[i]);
+    }
+  }
+}
+
 void player::set_sound_pmod(s32 sound_handle, s32 mod) {
   auto handler = m_handlers.find(sound_handle);
   if (handler == m_handlers.end())
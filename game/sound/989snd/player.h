@@ -56,6 +56,7 @@ class player {
   void pause_all_sounds_in_group(u8 group);
   void continue_all_sounds_in_group(u8 group);
   void set_sound_vol_pan(s32 sound_handle, s32 vol, s32 pan);
+  void update_sound_vol_pans(s32* sound_handles, const s32* vols, const s32* pans, int count);
   void submit_voice(std::shared_ptr<voice>& voice) { m_synth.add_voice(voice); };
   void set_sound_pmod(s32 sound_handle, s32 mod);
   void init_cubeb();
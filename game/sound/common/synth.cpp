@@ -2,6 +2,9 @@
 // SPDX-License-Identifier: ISC
 #include "synth.h"
 
+#include <immintrin.h>
+
+#include <array>
 #include <stdexcept>
 
 namespace snd {
@@ -26,6 +29,45 @@ s16_output synth::tick() {
   return out;
 }
 
+/*!
+ * The same as calling tick() samples times. Each voice is run for the whole block before moving on
+ * to the next, and mixed in with saturating adds, which clamp the same way as s16_output's +=.
+ */
+void synth::tick_block(s16_output* out, int samples) {
+  constexpr int kBlockSize = 64;
+  static_assert(sizeof(s16_output) == 4);
+
+  while (samples > 0) {
+    int count = std::min(samples, kBlockSize);
+    std::array<s16_output, kBlockSize> mix{};
+    std::array<s16_output, kBlockSize> voice_out{};
+
+    m_voices.remove_if([](std::shared_ptr<voice>& v) { return v->dead(); });
+    for (auto& v : m_voices) {
+      // tick() would remove the voice before the next sample once it's dead, so stop there.
+      int n = 0;
+      while (n < count && (n == 0 || !v->dead())) {
+        voice_out[n++] = v->run();
+      }
+      std::fill(voice_out.begin() + n, voice_out.begin() + count, s16_output{});
+      for (int i = 0; i < count; i += 4) {
+        __m128i a = _mm_loadu_si128((const __m128i*)&mix[i]);
+        __m128i b = _mm_loadu_si128((const __m128i*)&voice_out[i]);
+        _mm_storeu_si128((__m128i*)&mix[i], _mm_adds_epi16(a, b));
+      }
+    }
+
+    for (int i = 0; i < count; i++) {
+      out[i].left = ApplyVolume(mix[i].left, m_Volume.left.Get());
+      out[i].right = ApplyVolume(mix[i].right, m_Volume.right.Get());
+      m_Volume.Run();
+    }
+
+    out += count;
+    samples -= count;
+  }
+}
+
 void synth::add_voice(std::shared_ptr<voice> voice) {
   m_voices.emplace_front(voice);
 }
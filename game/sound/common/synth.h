@@ -26,6 +26,7 @@ class synth {
   }
 
   s16_output tick();
+  void tick_block(s16_output* out, int samples);
   void add_voice(std::shared_ptr<voice> voice);
   void set_master_vol(u32 volume);
 
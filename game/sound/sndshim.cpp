@@ -108,6 +108,16 @@ void snd_SetSoundVolPan(s32 sound_handle, s32 vol, s32 pan) {
   }
 }
 
+void snd_UpdateSoundVolPans(s32* sound_handles, const s32* vols, const s32* pans, s32 count) {
+  if (player) {
+    player->update_sound_vol_pans(sound_handles, vols, pans, count);
+  } else {
+    for (s32 i = 0; i < count; i++) {
+      sound_handles[i] = 0;
+    }
+  }
+}
+
 void snd_SetMasterVolume(s32 which, s32 volume) {
   if (player) {
     player->set_master_volume(which, volume);
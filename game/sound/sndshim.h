@@ -31,6 +31,7 @@ void snd_SetPlayBackMode(s32 mode);
 s32 snd_SoundIsStillPlaying(s32 sound_handle);
 void snd_StopSound(s32 sound_handle);
 void snd_SetSoundVolPan(s32 sound_handle, s32 vol, s32 pan);
+void snd_UpdateSoundVolPans(s32* sound_handles, const s32* vols, const s32* pans, s32 count);
 void snd_SetMasterVolume(s32 which, s32 volume);
 void snd_UnloadBank(s32 bank_handle);
 void snd_ResolveBankXREFS();
@@ -25,6 +25,8 @@
 // clang-format on
 
 Deci2Server::~Deci2Server() {
+  stop_send_thread();
+
   // Cleanup the accept thread
   if (accept_thread_running) {
     kill_accept_thread = true;
@@ -42,6 +44,19 @@ void Deci2Server::post_init() {
   accept_thread_running = true;
   kill_accept_thread = false;
   accept_thread = std::thread(&Deci2Server::accept_thread_func, this);
+  kill_send_thread = false;
+  send_thread = std::thread(&Deci2Server::send_thread_func, this);
+}
+
+void Deci2Server::stop_send_thread() {
+  if (send_thread.joinable()) {
+    {
+      std::lock_guard<std::mutex> lk(send_mutex);
+      kill_send_thread = true;
+    }
+    send_cv.notify_all();
+    send_thread.join();
+  }
 }
 
 void Deci2Server::accept_thread_func() {
@@ -171,22 +186,71 @@ void Deci2Server::read_data() {
   unlock();
 }
 
+/*!
+ * Queue a message to be sent by the send thread. Prints may be held for print_interval_ms, so more
+ * of them get sent together. This is called by the game, so it never waits for the listener: if
+ * too much is queued, prints are dropped. Other messages are always queued, the listener waits
+ * for them.
+ */
 void Deci2Server::send_data(void* buf, u16 len) {
-  lock();
   if (!client_connected) {
     printf("[DECI2] send while not connected, not sending!\n");
-  } else {
-    uint16_t prog = 0;
-    while (prog < len) {
-      int wrote = write_to_socket(accepted_socket, (char*)(buf) + prog, len - prog);
-      prog += wrote;
+    return;
+  }
+
+  auto* msg = (const ListenerMessageHeader*)buf;
+  bool is_print = len >= sizeof(ListenerMessageHeader) &&
+                  msg->deci2_header.proto == DECI2_PROTOCOL &&
+                  msg->msg_kind == ListenerMessageKind::MSG_PRINT;
+  {
+    std::lock_guard<std::mutex> lk(send_mutex);
+    if (is_print && send_queue.size() + len > MAX_SEND_QUEUE_SIZE) {
+      dropped_print_bytes += len;
+      return;
+    }
+    send_queue.insert(send_queue.end(), (char*)buf, (char*)buf + len);
+    send_now = send_now || !is_print;
+  }
+  send_cv.notify_all();
+}
+
+void Deci2Server::send_thread_func() {
+  std::vector<char> to_send;
+  size_t dropped = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lk(send_mutex);
+      send_cv.wait(lk, [&] { return !send_queue.empty() || kill_send_thread; });
+      int interval = print_interval_ms;
+      if (!send_now && !kill_send_thread && interval > 0) {
+        send_cv.wait_for(lk, std::chrono::milliseconds(interval),
+                         [&] { return send_now || kill_send_thread; });
+      }
+      if (send_queue.empty()) {
+        return;  // only get here if we're killed
+      }
+      std::swap(to_send, send_queue);
+      send_now = false;
+      std::swap(dropped, dropped_print_bytes);
+    }
+
+    if (dropped) {
+      lg::warn("[DECI2] listener isn't keeping up, dropped {} bytes of prints", dropped);
+      dropped = 0;
+    }
+
+    size_t prog = 0;
+    while (prog < to_send.size()) {
+      int wrote = write_to_socket(accepted_socket, to_send.data() + prog, to_send.size() - prog);
+      if (wrote > 0) {
+        prog += wrote;
+      }
       if (!client_connected || want_exit_callback()) {
-        unlock();
-        return;
+        break;
       }
     }
+    to_send.clear();
   }
-  unlock();
 }
 
 void Deci2Server::lock() {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 
 #include "deci_common.h"
@@ -17,6 +18,8 @@ class Deci2Server : public XSocketServer {
 
   void read_data();
   void send_data(void* buf, u16 len);
+  // how long a print message can wait for more messages before it's written. Others aren't held.
+  void set_print_interval(int ms) { print_interval_ms = ms; }
 
   bool is_client_connected();
   bool wait_for_protos_ready();  // return true if ready, false if we should shut down.
@@ -28,6 +31,8 @@ class Deci2Server : public XSocketServer {
 
  protected:
   void accept_thread_func();
+  void send_thread_func();
+  void stop_send_thread();
 
  private:
   bool want_shutdown = false;
@@ -44,4 +49,17 @@ class Deci2Server : public XSocketServer {
   std::mutex server_mutex;
 
   bool client_connected = false;
+
+  // messages are written to the socket by send_thread, so the game doesn't wait for the writes.
+  // anything queued while a write is in progress goes out in one write after it. Prints that
+  // would make the queue bigger than MAX_SEND_QUEUE_SIZE are dropped.
+  static constexpr size_t MAX_SEND_QUEUE_SIZE = 8 * 1024 * 1024;
+  std::thread send_thread;
+  std::mutex send_mutex;
+  std::condition_variable send_cv;
+  std::vector<char> send_queue;
+  bool send_now = false;  // something other than a print is queued
+  size_t dropped_print_bytes = 0;
+  bool kill_send_thread = false;
+  std::atomic<int> print_interval_ms = 0;
 };
@@ -1,7 +1,10 @@
 #include "IOP_Kernel.h"
 
+#include <algorithm>
 #include <cstring>
 
+#include "common/global_profiler/GlobalProfiler.h"
+#include "common/log/log.h"
 #include "common/util/Assert.h"
 #include "common/util/FileUtil.h"
 
@@ -98,8 +101,11 @@ void IOP_Kernel::WakeupThread(s32 id) {
 
 void IOP_Kernel::iWakeupThread(s32 id) {
   ASSERT(id > 0);
-  std::scoped_lock lock(wakeup_mtx);
-  wakeup_queue.push(id);
+  {
+    std::scoped_lock lock(wakeup_mtx);
+    wakeup_queue.push(id);
+  }
+  notify_event();
 }
 
 s32 IOP_Kernel::WaitSema(s32 id) {
@@ -182,7 +188,11 @@ void IOP_Kernel::runThread(IopThread* thread) {
   ASSERT(_currentThread == nullptr);  // should run in the kernel thread
   _currentThread = thread;
   thread->state = IopThread::State::Run;
+  PROF_ZONE(thread->name.c_str());
+  auto start = steady_clock::now();
   co_switch(thread->thread);
+  thread->run_time += duration_cast<microseconds>(steady_clock::now() - start);
+  thread->run_count++;
   _currentThread = nullptr;
 }
 
@@ -202,7 +212,9 @@ void IOP_Kernel::updateDelay() {
 
 std::optional<time_stamp> IOP_Kernel::nextWakeup() {
   bool found_ready = false;
-  time_stamp lowest = time_point_cast<microseconds>(steady_clock::now()) + microseconds(1000);
+  // everything else that can make a thread ready calls notify_event, so if no thread is delayed we
+  // can wait for a long time. this limit is just in case something doesn't.
+  time_stamp lowest = time_point_cast<microseconds>(steady_clock::now()) + milliseconds(100);
 
   for (auto& t : threads) {
     if (t.waitType == IopThread::Wait::Delay) {
@@ -254,10 +266,24 @@ void IOP_Kernel::processWakeups() {
   }
 }
 
+/*!
+ * Run the vblank handler, if there's been a vblank since it last ran.
+ */
+void IOP_Kernel::runVblankHandler() {
+  if (vblank_handler != nullptr && vblank_recieved) {
+    vblank_handler(nullptr);
+    vblank_recieved = false;
+  }
+}
+
 /*!
  * Run the next IOP thread.
  */
 std::optional<time_stamp> IOP_Kernel::dispatch() {
+  PROF_ZONE("iop-dispatch");
+  // the vblank handler can wake threads, so it runs even if none are ready yet.
+  runVblankHandler();
+
   // Update thread states
   updateDelay();
   processWakeups();
@@ -266,10 +292,7 @@ std::optional<time_stamp> IOP_Kernel::dispatch() {
   IopThread* next = schedNext();
   while (next != nullptr) {
     // Check vblank interrupt
-    if (vblank_handler != nullptr && vblank_recieved) {
-      vblank_handler(nullptr);
-      vblank_recieved = false;
-    }
+    runVblankHandler();
     // printf("[IOP Kernel] Dispatch %s (%d)\n", next->name.c_str(), next->thID);
     runThread(next);
     updateDelay();
@@ -282,6 +305,50 @@ std::optional<time_stamp> IOP_Kernel::dispatch() {
   return nextWakeup();
 }
 
+/*!
+ * Block the IOP until the deadline, or until notify_event is called.
+ */
+void IOP_Kernel::wait_for_event(time_stamp deadline) {
+  std::unique_lock<std::mutex> lk(event_mtx);
+  event_cv.wait_until(lk, deadline, [&] { return event_pending; });
+  event_pending = false;
+}
+
+/*!
+ * Wake up the IOP if it's in wait_for_event, or make the next wait_for_event return immediately.
+ * This is called by anything that may make an IOP thread ready from outside of the IOP.
+ */
+void IOP_Kernel::notify_event() {
+  {
+    std::lock_guard<std::mutex> lk(event_mtx);
+    event_pending = true;
+  }
+  event_cv.notify_one();
+}
+
+/*!
+ * Print how long each thread has run for, and how many RPCs each channel got.
+ */
+void IOP_Kernel::log_thread_stats() {
+  std::vector<const IopThread*> sorted;
+  for (auto& t : threads) {
+    if (t.run_count) {
+      sorted.push_back(&t);
+    }
+  }
+  std::sort(sorted.begin(), sorted.end(),
+            [](const IopThread* a, const IopThread* b) { return a->run_time > b->run_time; });
+  lg::info("[IOP Kernel] thread run times:");
+  for (auto* t : sorted) {
+    lg::info("  {:20s} {:10.2f} ms, {} runs", t->name, t->run_time.count() / 1000., t->run_count);
+  }
+  std::lock_guard<std::mutex> lock(sif_mtx);
+  lg::info("[IOP Kernel] rpc calls:");
+  for (auto& r : sif_records) {
+    lg::info("  channel 0x{:x}: {}", r.qd->serve_data->command, r.call_count);
+  }
+}
+
 void IOP_Kernel::set_rpc_queue(iop::sceSifQueueData* qd, u32 thread) {
   sif_mtx.lock();
   for (const auto& r : sif_records) {
@@ -347,6 +414,7 @@ void IOP_Kernel::sif_rpc(s32 rpcChannel,
   rec->cmd.copy_back_size = recvSize;
   rec->cmd.started = false;
   rec->cmd.finished = false;
+  rec->call_count++;
 
   iWakeupThread(rec->thread_to_wake);
 
@@ -41,6 +41,7 @@ struct SifRecord {
   iop::sceSifQueueData* qd;
   SifRpcCommand cmd;
   u32 thread_to_wake;
+  u32 call_count = 0;
 };
 
 struct IopThread {
@@ -75,6 +76,10 @@ struct IopThread {
   time_stamp resumeTime = {};
   u32 priority = 0;
   s32 thID = -1;
+
+  // how many times the kernel switched to this thread, and how long it ran for.
+  u64 run_count = 0;
+  std::chrono::microseconds run_time{0};
 };
 
 struct Semaphore {
@@ -110,6 +115,9 @@ class IOP_Kernel {
   void WakeupThread(s32 id);
   void iWakeupThread(s32 id);
   std::optional<time_stamp> dispatch();
+  void wait_for_event(time_stamp deadline);
+  void notify_event();
+  void log_thread_stats();
   void set_rpc_queue(iop::sceSifQueueData* qd, u32 thread);
   void rpc_loop(iop::sceSifQueueData* qd);
   void shutdown();
@@ -177,7 +185,10 @@ class IOP_Kernel {
     return 0;
   }
 
-  void signal_vblank() { vblank_recieved = true; };
+  void signal_vblank() {
+    vblank_recieved = true;
+    notify_event();
+  };
 
   bool sif_busy(u32 id);
 
@@ -198,7 +209,9 @@ class IOP_Kernel {
   IopThread* schedNext();
   std::optional<time_stamp> nextWakeup();
 
-  s32 (*vblank_handler)(void*);
+  void runVblankHandler();
+
+  s32 (*vblank_handler)(void*) = nullptr;
   std::atomic_bool vblank_recieved = false;
 
   cothread_t kernel_thread;
@@ -211,4 +224,9 @@ class IOP_Kernel {
   std::queue<int> wakeup_queue;
   bool mainThreadSleep = false;
   std::mutex sif_mtx, wakeup_mtx;
+
+  // set by notify_event, so a wakeup sent before wait_for_event starts waiting isn't lost.
+  bool event_pending = false;
+  std::mutex event_mtx;
+  std::condition_variable event_cv;
 };
@@ -0,0 +1,167 @@
+#include "benchmark.h"
+
+#include <algorithm>
+#include <atomic>
+#include <ctime>
+#include <fstream>
+#include <vector>
+
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#endif
+
+#include "common/log/log.h"
+#include "common/util/Timer.h"
+
+#include "game/kernel/common/kboot.h"
+
+#include "third-party/fmt/core.h"
+
+namespace benchmark {
+
+namespace {
+
+struct FrameTimes {
+  float wall_ms = 0;
+  float ee_ms = 0;
+  float iop_ms = 0;
+  float render_ms = 0;
+};
+
+std::atomic<bool> g_active = false;
+BenchmarkOptions g_options;
+std::atomic<s64> g_counters[3];
+
+// only used by the EE thread.
+s64 g_last_ee_cpu_time = -1;
+Timer g_frame_timer;
+int g_frame_count = 0;
+std::vector<FrameTimes> g_frames;
+
+void print_stat(const char* name, std::vector<float> samples) {
+  std::sort(samples.begin(), samples.end());
+  auto at = [&](float p) {
+    return samples[std::min(samples.size() - 1, (size_t)(p * samples.size()))];
+  };
+  double mean = 0;
+  for (auto x : samples) {
+    mean += x;
+  }
+  mean /= samples.size();
+  lg::info("{:>10s} {:8.3f} {:8.3f} {:8.3f} {:8.3f} {:8.3f}", name, mean, at(0.5f), at(0.9f),
+           at(0.99f), samples.back());
+}
+
+void report() {
+  std::vector<float> wall, ee, iop, render;
+  for (auto& frame : g_frames) {
+    wall.push_back(frame.wall_ms);
+    ee.push_back(frame.ee_ms);
+    iop.push_back(frame.iop_ms);
+    render.push_back(frame.render_ms);
+  }
+  lg::info("Benchmark: {} frames", g_frames.size());
+  lg::info("{:>10s} {:>8s} {:>8s} {:>8s} {:>8s} {:>8s}", "ms", "mean", "p50", "p90", "p99",
+           "max");
+  print_stat("frame", wall);
+  print_stat("ee cpu", ee);
+  print_stat("iop cpu", iop);
+  print_stat("render cpu", render);
+
+  if (!g_options.csv_path.empty()) {
+    std::ofstream csv(g_options.csv_path);
+    csv << "frame,wall_ms,ee_ms,iop_ms,render_ms\n";
+    for (size_t i = 0; i < g_frames.size(); i++) {
+      auto& frame = g_frames[i];
+      csv << fmt::format("{},{},{},{},{}\n", i, frame.wall_ms, frame.ee_ms, frame.iop_ms,
+                         frame.render_ms);
+    }
+  }
+}
+
+}  // namespace
+
+void start(const BenchmarkOptions& options) {
+  g_options = options;
+  for (auto& counter : g_counters) {
+    counter = 0;
+  }
+  g_last_ee_cpu_time = -1;
+  g_frame_count = 0;
+  g_frames.clear();
+  g_frames.reserve(options.frames);
+  g_active = options.frames > 0;
+}
+
+bool active() {
+  return g_active.load(std::memory_order_relaxed);
+}
+
+s64 thread_cpu_time_ns() {
+#ifdef _WIN32
+  FILETIME creation, exit, kernel, user;
+  GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user);
+  auto to_ns = [](const FILETIME& t) {
+    return (((s64)t.dwHighDateTime << 32) | t.dwLowDateTime) * 100;
+  };
+  return to_ns(kernel) + to_ns(user);
+#else
+  timespec now;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+  return (s64)now.tv_sec * 1000000000 + now.tv_nsec;
+#endif
+}
+
+void add_cpu_time(Counter counter, s64 ns) {
+  g_counters[(int)counter].fetch_add(ns, std::memory_order_relaxed);
+}
+
+void end_ee_frame() {
+  if (!active()) {
+    return;
+  }
+  s64 ee_time = thread_cpu_time_ns();
+  s64 iop = g_counters[(int)Counter::IOP].exchange(0);
+  s64 render = g_counters[(int)Counter::RENDER].exchange(0);
+  s64 render_on_ee = g_counters[(int)Counter::RENDER_ON_EE].exchange(0);
+  if (g_last_ee_cpu_time < 0) {
+    // the first frame starts here.
+    g_last_ee_cpu_time = ee_time;
+    g_frame_timer.start();
+    return;
+  }
+
+  FrameTimes frame;
+  frame.wall_ms = g_frame_timer.getMs();
+  frame.ee_ms = (ee_time - g_last_ee_cpu_time - render_on_ee) / 1.e6;
+  frame.iop_ms = iop / 1.e6;
+  frame.render_ms = (render + render_on_ee) / 1.e6;
+  g_frame_timer.start();
+  g_last_ee_cpu_time = ee_time;
+
+  if (++g_frame_count <= g_options.warmup_frames) {
+    return;
+  }
+  g_frames.push_back(frame);
+  if ((int)g_frames.size() == g_options.frames) {
+    report();
+    g_active = false;
+    MasterExit = RuntimeExitStatus::EXIT;
+  }
+}
+
+ScopedCpuTime::ScopedCpuTime(Counter counter) : m_counter(counter) {
+  if (active()) {
+    m_start = thread_cpu_time_ns();
+  }
+}
+
+ScopedCpuTime::~ScopedCpuTime() {
+  if (m_start >= 0) {
+    add_cpu_time(m_counter, thread_cpu_time_ns() - m_start);
+  }
+}
+
+}  // namespace benchmark
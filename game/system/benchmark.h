@@ -0,0 +1,65 @@
+#pragma once
+
+/*!
+ * @file benchmark.h
+ * Benchmark mode for the runtime: count the CPU time the EE, IOP and renderer use on each frame,
+ * then exit after a number of frames and report it. With recorded pad input, no frame limit, and
+ * optionally no renderer, this gives repeatable numbers for engine and kernel changes.
+ */
+
+#include <string>
+
+#include "common/common_types.h"
+
+namespace benchmark {
+
+struct BenchmarkOptions {
+  int frames = 0;         // frames to measure, after the warmup
+  int warmup_frames = 0;  // frames to skip first, like the boot and the first level load
+  std::string csv_path;   // if set, the time of every frame is also written here
+};
+
+// where CPU time is counted, other than the EE thread.
+enum class Counter {
+  IOP,
+  RENDER,
+  // rendering done on the EE thread, which isn't counted as EE time.
+  RENDER_ON_EE,
+};
+
+/*!
+ * Start counting. Called before the runtime threads start.
+ */
+void start(const BenchmarkOptions& options);
+bool active();
+
+/*!
+ * The CPU time used by the calling thread so far.
+ */
+s64 thread_cpu_time_ns();
+
+void add_cpu_time(Counter counter, s64 ns);
+
+/*!
+ * Called by the EE thread once per frame, on vsync. Once enough frames are measured, this reports
+ * them and asks the runtime to exit.
+ */
+void end_ee_frame();
+
+/*!
+ * Adds the CPU time of this thread between construction and destruction to a counter. Does nothing
+ * when there's no benchmark.
+ */
+class ScopedCpuTime {
+ public:
+  explicit ScopedCpuTime(Counter counter);
+  ~ScopedCpuTime();
+  ScopedCpuTime(const ScopedCpuTime&) = delete;
+  ScopedCpuTime& operator=(const ScopedCpuTime&) = delete;
+
+ private:
+  Counter m_counter;
+  s64 m_start = -1;
+};
+
+}  // namespace benchmark
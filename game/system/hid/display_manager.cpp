@@ -11,8 +11,7 @@ DisplayManager::DisplayManager(SDL_Window* window)
   SDL_SetHint("SDL_WINDOWS_DPI_SCALING", "true");
   update_curr_display_info();
   update_video_modes();
-  // Load display settings from a file
-  m_display_settings = game_settings::DisplaySettings();
+  // m_display_settings was loaded from a file when it was constructed
   // Adjust window / monitor position
   initialize_window_position_from_settings();
 }
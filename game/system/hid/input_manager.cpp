@@ -138,6 +138,16 @@ void InputManager::process_sdl_event(const SDL_Event& event,
     m_ignored_device_last_frame = false;
   }
 
+  if (sdl_util::is_any_event_type(
+          event.type, {SDL_KEYDOWN, SDL_KEYUP, SDL_CONTROLLERBUTTONDOWN, SDL_CONTROLLERBUTTONUP,
+                       SDL_CONTROLLERAXISMOTION}) ||
+      (m_mouse_enabled && sdl_util::is_any_event_type(event.type, {SDL_MOUSEMOTION,
+                                                                   SDL_MOUSEBUTTONDOWN,
+                                                                   SDL_MOUSEBUTTONUP}))) {
+    // SDL stamps events when it receives them from the OS, which is earlier than now.
+    m_last_input_ticks = event.common.timestamp;
+  }
+
   if (m_data.find(m_keyboard_and_mouse_port) != m_data.end()) {
     m_keyboard.process_event(event, m_command_binds, m_data.at(m_keyboard_and_mouse_port),
                              m_waiting_for_bind, ignore_kb || !m_keyboard_enabled);
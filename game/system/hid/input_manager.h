@@ -34,6 +34,9 @@ class InputManager {
   std::optional<std::shared_ptr<PadData>> get_current_data(const int port) const;
   int update_rumble(const int port, const u8 low_intensity, const u8 high_intensity);
   std::pair<int, int> get_mouse_pos() const { return m_mouse.get_mouse_pos(); }
+  /// SDL timestamp (ms) of the newest input event that can change pad data, 0 if there hasn't
+  /// been one. Used to measure input latency.
+  u32 get_last_input_ticks() const { return m_last_input_ticks; }
 
   void register_command(const CommandBinding::Source source, const CommandBinding bind);
 
@@ -86,6 +89,7 @@ class InputManager {
   CommandBindingGroups m_command_binds;
 
   bool m_ignored_device_last_frame = false;
+  u32 m_last_input_ticks = 0;
 
   bool m_keyboard_enabled = true;
   bool m_mouse_enabled = false;
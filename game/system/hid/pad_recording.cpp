@@ -0,0 +1,115 @@
+#include "pad_recording.h"
+
+#include <array>
+#include <cstring>
+#include <vector>
+
+#include "common/log/log.h"
+#include "common/util/FileUtil.h"
+#include "common/util/Serializer.h"
+
+#include "game/kernel/common/kernel_types.h"
+
+#include "third-party/fmt/core.h"
+
+namespace pad_recording {
+
+namespace {
+
+constexpr u32 VERSION = 1;
+
+// the part of CPadInfo that scePadRead fills in.
+struct PadSample {
+  u16 button0 = 0;
+  u8 rightx = 0x80;
+  u8 righty = 0x80;
+  u8 leftx = 0x80;
+  u8 lefty = 0x80;
+  u8 abutton[12] = {};
+};
+
+enum class Mode { NONE, RECORD, PLAYBACK };
+
+Mode g_mode = Mode::NONE;
+std::string g_path;
+std::array<std::vector<PadSample>, MAX_PORTS> g_samples;
+std::array<size_t, MAX_PORTS> g_next_sample = {};
+bool g_playback_ended = false;
+
+}  // namespace
+
+void start_recording(const std::string& path) {
+  g_mode = Mode::RECORD;
+  g_path = path;
+  for (auto& samples : g_samples) {
+    samples.clear();
+  }
+}
+
+void start_playback(const std::string& path) {
+  auto data = file_util::read_binary_file(path);
+  Serializer ser(data.data(), data.size());
+  u32 version = ser.load<u32>();
+  ASSERT_MSG(version == VERSION, fmt::format("Pad recording {} has version {}, expected {}", path,
+                                             version, VERSION));
+  for (auto& samples : g_samples) {
+    ser.from_pod_vector(&samples);
+  }
+  g_next_sample = {};
+  g_playback_ended = false;
+  g_mode = Mode::PLAYBACK;
+  g_path = path;
+  lg::info("Playing back {} frames of pad input from {}", g_samples[0].size(), path);
+}
+
+void stop() {
+  if (g_mode == Mode::RECORD) {
+    Serializer ser;
+    ser.save<u32>(VERSION);
+    for (auto& samples : g_samples) {
+      ser.from_pod_vector(&samples);
+    }
+    auto result = ser.get_save_result();
+    file_util::create_dir_if_needed_for_file(g_path);
+    file_util::write_binary_file(g_path, result.first, result.second);
+    lg::info("Saved {} frames of pad input to {}", g_samples[0].size(), g_path);
+  }
+  g_mode = Mode::NONE;
+}
+
+bool playback(int port, CPadInfo* cpad) {
+  if (g_mode != Mode::PLAYBACK || port < 0 || port >= MAX_PORTS) {
+    return false;
+  }
+  PadSample sample;
+  auto& next = g_next_sample[port];
+  if (next < g_samples[port].size()) {
+    sample = g_samples[port][next++];
+  } else if (port == 0 && !g_playback_ended) {
+    g_playback_ended = true;
+    lg::info("Pad playback ended");
+  }
+  cpad->button0 = sample.button0;
+  cpad->rightx = sample.rightx;
+  cpad->righty = sample.righty;
+  cpad->leftx = sample.leftx;
+  cpad->lefty = sample.lefty;
+  memcpy(cpad->abutton, sample.abutton, sizeof(sample.abutton));
+  return true;
+}
+
+void record(int port, const CPadInfo& cpad) {
+  if (g_mode != Mode::RECORD || port < 0 || port >= MAX_PORTS) {
+    return;
+  }
+  PadSample sample;
+  sample.button0 = cpad.button0;
+  sample.rightx = cpad.rightx;
+  sample.righty = cpad.righty;
+  sample.leftx = cpad.leftx;
+  sample.lefty = cpad.lefty;
+  memcpy(sample.abutton, cpad.abutton, sizeof(sample.abutton));
+  g_samples[port].push_back(sample);
+}
+
+}  // namespace pad_recording
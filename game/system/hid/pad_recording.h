@@ -0,0 +1,39 @@
+#pragma once
+
+/*!
+ * @file pad_recording.h
+ * Records the pad data the game reads to a file, or plays a recording back instead of the real
+ * input. The game reads each pad once per frame, so a recording replays the same input on the same
+ * frames. Only used from the EE thread.
+ */
+
+#include <string>
+
+#include "common/common_types.h"
+
+struct CPadInfo;
+
+namespace pad_recording {
+
+constexpr int MAX_PORTS = 4;
+
+void start_recording(const std::string& path);
+void start_playback(const std::string& path);
+
+/*!
+ * Write the recording, if there is one.
+ */
+void stop();
+
+/*!
+ * Fill in the pad data from the recording. Returns false if nothing is playing back. After the
+ * end of the recording, the pad is idle.
+ */
+bool playback(int port, CPadInfo* cpad);
+
+/*!
+ * Add the pad data the game just read, if recording.
+ */
+void record(int port, const CPadInfo& cpad);
+
+}  // namespace pad_recording
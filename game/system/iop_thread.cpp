@@ -57,8 +57,7 @@ void* IOP::iop_alloc(int size) {
 
 void IOP::wait_run_iop(
     std::chrono::time_point<std::chrono::steady_clock, std::chrono::microseconds> wakeup) {
-  std::unique_lock<std::mutex> lk(run_cv_mutex);
-  iop_run_cv.wait_until(lk, wakeup);
+  kernel.wait_for_event(wakeup);
 }
 
 void IOP::kill_from_ee() {
@@ -67,8 +66,7 @@ void IOP::kill_from_ee() {
 }
 
 void IOP::signal_run_iop() {
-  std::unique_lock<std::mutex> lk(run_cv_mutex);
-  iop_run_cv.notify_all();
+  kernel.notify_event();
 }
 
 IOP::~IOP() {
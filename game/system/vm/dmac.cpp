@@ -17,15 +17,18 @@ namespace VM {
 
 Ptr<DmaCommonRegisters> dmac;
 Ptr<DmaChannelRegisters> dmac_ch[10];
+Ptr<u8> dmac_regs;
 
 void dmac_init_globals() {
-  dmac = kmalloc(kdebugheap, sizeof(DmaCommonRegisters), KMALLOC_ALIGN_16 | KMALLOC_MEMSET, "dmac")
-             .cast<DmaCommonRegisters>();
+  // the gaps between the channels are wasted, but it's only about 25 KB of the debug heap.
+  dmac_regs = kmalloc(kdebugheap, DMAC_REGS_END - DMAC_REGS_START,
+                      KMALLOC_ALIGN_16 | KMALLOC_MEMSET, "dmac")
+                  .cast<u8>();
 
+  dmac = (dmac_regs + (DMAC_COMMON_ADDR - DMAC_REGS_START)).cast<DmaCommonRegisters>();
   for (int i = 0; i < 10; ++i) {
     dmac_ch[i] =
-        kmalloc(kdebugheap, sizeof(DmaChannelRegisters), KMALLOC_ALIGN_16 | KMALLOC_MEMSET, "dmach")
-            .cast<DmaChannelRegisters>();
+        (dmac_regs + (DMAC_CHANNEL_ADDRS[i] - DMAC_REGS_START)).cast<DmaChannelRegisters>();
   }
 }
 
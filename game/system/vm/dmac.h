@@ -58,10 +58,22 @@ struct alignas(16) DmaCommonRegisters {
   alignas(16) u32 stadr;
 };
 
+// EE addresses of the DMA channel registers. The DMAC registers come after the last one.
+constexpr u32 DMAC_CHANNEL_ADDRS[10] = {0x10008000, 0x10009000, 0x1000a000, 0x1000b000,
+                                        0x1000b400, 0x1000c000, 0x1000c400, 0x1000c800,
+                                        0x1000d000, 0x1000d400};
+constexpr u32 DMAC_COMMON_ADDR = 0x1000e000;
+// all of the registers are in one block of GOAL memory, laid out like the EE's, so that the
+// address of any register can be found with a subtraction.
+constexpr u32 DMAC_REGS_START = DMAC_CHANNEL_ADDRS[0];
+constexpr u32 DMAC_REGS_END = DMAC_COMMON_ADDR + sizeof(DmaCommonRegisters);
+
 // pointer to DMAC registers
 extern Ptr<DmaCommonRegisters> dmac;
 // array of pointers to DMAC channels (they are not stored contiguously)
 extern Ptr<DmaChannelRegisters> dmac_ch[10];
+// the block of memory with all of the registers, starting at DMAC_REGS_START.
+extern Ptr<u8> dmac_regs;
 
 // enum DmaChannel { VIF0, VIF1, GIF, fromIPU, toIPU, SIF0, SIF1, SIF2, fromSPR, toSPR };
 
@@ -106,35 +106,15 @@ void unsubscribe_component() {
  */
 u64 get_vm_ptr(u32 ptr) {
   // currently, only DMAC and DMA channel banks are implemented. add more as necessary.
-  if (ptr == 0x10008000) {
-    return VM::dmac_ch[0].offset;
-  } else if (ptr == 0x10009000) {
-    return VM::dmac_ch[1].offset;
-  } else if (ptr == 0x1000a000) {
-    return VM::dmac_ch[2].offset;
-  } else if (ptr == 0x1000b000) {
-    return VM::dmac_ch[3].offset;
-  } else if (ptr == 0x1000b400) {
-    return VM::dmac_ch[4].offset;
-  } else if (ptr == 0x1000c000) {
-    return VM::dmac_ch[5].offset;
-  } else if (ptr == 0x1000c400) {
-    return VM::dmac_ch[6].offset;
-  } else if (ptr == 0x1000c800) {
-    return VM::dmac_ch[7].offset;
-  } else if (ptr == 0x1000d000) {
-    return VM::dmac_ch[8].offset;
-  } else if (ptr == 0x1000d400) {
-    return VM::dmac_ch[9].offset;
-  } else if (ptr == 0x1000e000) {
-    return VM::dmac.offset;
-  } else {
-    // return zero, using this result will segfault GOAL!
-    // we could die immediately, but it might be worth it to keep going just on the off chance more
-    // errors are reported, and not just only this one.
-    lg::error("unknown EE register for VM at #x{:08x}", ptr);
-    return 0;
+  // they are in one block, so any register in it works, not just the start of a bank.
+  if (ptr >= DMAC_REGS_START && ptr < DMAC_REGS_END) {
+    return VM::dmac_regs.offset + (ptr - DMAC_REGS_START);
   }
+  // return zero, using this result will segfault GOAL!
+  // we could die immediately, but it might be worth it to keep going just on the off chance more
+  // errors are reported, and not just only this one.
+  lg::error("unknown EE register for VM at #x{:08x}", ptr);
+  return 0;
 }
 
 }  // namespace VM
@@ -1,8 +1,11 @@
 #include "common/custom_data/Tfrag3Data.h"
+#include "common/custom_data/chunked_fr3.h"
 #include "common/log/log.h"
 #include "common/util/FileUtil.h"
-#include "common/util/compress.h"
+#include "common/util/Serializer.h"
+#include "common/util/crc32.h"
 #include "common/util/json_util.h"
+#include "common/versions/versions.h"
 
 #include "goalc/build_level/Entity.h"
 #include "goalc/build_level/FileInfo.h"
@@ -17,14 +20,12 @@
 void save_pc_data(const std::string& nickname,
                   tfrag3::Level& data,
                   const fs::path& fr3_output_dir) {
-  Serializer ser;
-  data.serialize(ser);
-  auto compressed =
-      compression::compress_zstd(ser.get_save_result().first, ser.get_save_result().second);
+  size_t uncompressed_size = 0;
+  auto compressed = tfrag3::save_chunked_fr3(data, &uncompressed_size);
   lg::print("stats for {}\n", data.level_name);
-  print_memory_usage(data, ser.get_save_result().second);
-  lg::print("compressed: {} -> {} ({:.2f}%)\n", ser.get_save_result().second, compressed.size(),
-            100.f * compressed.size() / ser.get_save_result().second);
+  print_memory_usage(data, uncompressed_size);
+  lg::print("compressed: {} -> {} ({:.2f}%)\n", uncompressed_size, compressed.size(),
+            100.f * compressed.size() / uncompressed_size);
   file_util::write_binary_file(fr3_output_dir / fmt::format("{}.fr3", nickname), compressed.data(),
                                compressed.size());
 }
@@ -35,6 +36,80 @@ std::vector<std::string> get_build_level_deps(const std::string& input_file) {
   return {level_json.at("gltf_file").get<std::string>()};
 }
 
+namespace {
+constexpr u32 MESH_CACHE_VERSION = 1;
+
+// level json keys that only affect the entities. Everything else is assumed to affect the mesh.
+const char* const ENTITY_ONLY_KEYS[] = {"actors", "ambients", "base_id"};
+
+/*!
+ * Hash of everything the mesh stages (mesh extraction, tfrag, textures, collide) depend on: the
+ * glTF file, the level json without the entities, and the tool itself.
+ */
+u64 mesh_cache_key(const nlohmann::json& level_json, const fs::path& gltf_path) {
+  auto mesh_json = level_json;
+  for (auto key : ENTITY_ONLY_KEYS) {
+    mesh_json.erase(key);
+  }
+  auto gltf_data = file_util::read_binary_file(gltf_path);
+  auto text = fmt::format("{} {} {:08x} {} {}", MESH_CACHE_VERSION, build_revision(),
+                          crc32(gltf_data.data(), gltf_data.size()), gltf_data.size(),
+                          mesh_json.dump());
+  return ((u64)crc32((const u8*)text.data(), text.size()) << 32) | (u32)text.size();
+}
+
+/*!
+ * The outputs of the mesh stages from the last build of a level. The PC data isn't stored here:
+ * the fr3 file from the last build is reused as-is, as long as it hasn't changed size since.
+ */
+struct MeshCache {
+  u64 fr3_size = 0;
+  bool has_collide = false;
+  DrawableTreeCollideFragment collide;
+
+  void serialize(Serializer& ser) {
+    ser.from_ptr(&fr3_size);
+    ser.from_ptr(&has_collide);
+    if (has_collide) {
+      collide.serialize(ser);
+    }
+  }
+};
+
+/*!
+ * Load the mesh cache, if it was made from the same inputs. Otherwise returns false.
+ */
+bool load_mesh_cache(const fs::path& path, u64 key, const fs::path& fr3_path, MeshCache& cache) {
+  if (!fs::exists(path) || !fs::exists(fr3_path)) {
+    return false;
+  }
+  auto data = file_util::read_binary_file(path);
+  if (data.size() < sizeof(u32) + sizeof(u64)) {
+    return false;
+  }
+  Serializer ser(data.data(), data.size());
+  if (ser.load<u32>() != MESH_CACHE_VERSION || ser.load<u64>() != key) {
+    return false;
+  }
+  cache.serialize(ser);
+  return cache.fr3_size == fs::file_size(fr3_path);
+}
+
+void save_mesh_cache(const fs::path& path, u64 key, MeshCache& cache) {
+  Serializer ser;
+  ser.save<u32>(MESH_CACHE_VERSION);
+  ser.save<u64>(key);
+  cache.serialize(ser);
+  auto [data, size] = ser.get_save_result();
+  try {
+    file_util::create_dir_if_needed_for_file(path);
+    file_util::write_binary_file(path, data, size);
+  } catch (std::exception& e) {
+    lg::warn("Failed to save mesh cache {}: {}", path.string(), e.what());
+  }
+}
+}  // namespace
+
 bool run_build_level(const std::string& input_file,
                      const std::string& bsp_output_file,
                      const std::string& output_prefix) {
@@ -44,16 +119,31 @@ bool run_build_level(const std::string& input_file,
   tfrag3::Level pc_level;  // PC level file
   TexturePool tex_pool;    // pc level texture pool
 
+  // when only the entities changed, the mesh stages are skipped and their outputs are reused.
+  file.nickname = level_json.at("nickname").get<std::string>();
+  const auto out_dir = file_util::get_jak_project_dir() / "out" / output_prefix;
+  const auto fr3_path = out_dir / "fr3" / fmt::format("{}.fr3", file.nickname);
+  const auto mesh_cache_path = out_dir / "cache" / fmt::format("{}-mesh.bin", file.nickname);
+  const auto gltf_path =
+      fs::path(file_util::get_file_path({level_json.at("gltf_file").get<std::string>()}));
+  MeshCache mesh_cache;
+  const u64 mesh_key = mesh_cache_key(level_json, gltf_path);
+  const bool mesh_cached = load_mesh_cache(mesh_cache_path, mesh_key, fr3_path, mesh_cache);
+
   // process input mesh from blender
   gltf_mesh_extract::Input mesh_extract_in;
-  mesh_extract_in.filename =
-      file_util::get_file_path({level_json.at("gltf_file").get<std::string>()});
+  mesh_extract_in.filename = gltf_path.string();
   mesh_extract_in.auto_wall_enable = level_json.value("automatic_wall_detection", true);
   mesh_extract_in.double_sided_collide = level_json.at("double_sided_collide").get<bool>();
   mesh_extract_in.auto_wall_angle = level_json.value("automatic_wall_angle", 30.0);
+  mesh_extract_in.color_kmeans_iterations = level_json.value("color_kmeans_iterations", 0);
   mesh_extract_in.tex_pool = &tex_pool;
   gltf_mesh_extract::Output mesh_extract_out;
-  gltf_mesh_extract::extract(mesh_extract_in, mesh_extract_out);
+  if (mesh_cached) {
+    lg::info("Mesh for {} is unchanged, reusing {}", file.nickname, fr3_path.string());
+  } else {
+    gltf_mesh_extract::extract(mesh_extract_in, mesh_extract_out);
+  }
 
   // add stuff to the GOAL level structure
   file.info = make_file_info_for_level(fs::path(input_file).filename().string());
@@ -65,8 +155,7 @@ bool run_build_level(const std::string& input_file,
   // unk zero
   // name
   file.name = level_json.at("long_name").get<std::string>();
-  // nick
-  file.nickname = level_json.at("nickname").get<std::string>();
+  // nick (set above)
   // vis infos
   // actors
   std::vector<EntityActor> actors;
@@ -95,16 +184,26 @@ bool run_build_level(const std::string& input_file,
 
   // TFRAG
   auto& tfrag_drawable_tree = file.drawable_trees.tfrags.emplace_back();
-  tfrag_from_gltf(mesh_extract_out.tfrag, tfrag_drawable_tree,
-                  pc_level.tfrag_trees[0].emplace_back());
-  pc_level.textures = std::move(tex_pool.textures_by_idx);
+  if (!mesh_cached) {
+    tfrag_from_gltf(mesh_extract_out.tfrag, tfrag_drawable_tree,
+                    pc_level.tfrag_trees[0].emplace_back());
+    pc_level.textures = std::move(tex_pool.textures_by_idx);
+  }
 
   // COLLIDE
-  if (mesh_extract_out.collide.faces.empty()) {
+  if (mesh_cached) {
+    if (mesh_cache.has_collide) {
+      file.drawable_trees.collides.push_back(std::move(mesh_cache.collide));
+    }
+  } else if (mesh_extract_out.collide.faces.empty()) {
     lg::error("No collision geometry was found");
   } else {
     auto& collide_drawable_tree = file.drawable_trees.collides.emplace_back();
-    collide_drawable_tree.bvh = collide::construct_collide_bvh(mesh_extract_out.collide.faces);
+    auto bvh_split = level_json.value("collide_bvh_split", "sah") == "median"
+                         ? collide::BvhSplit::MEDIAN
+                         : collide::BvhSplit::SAH;
+    collide_drawable_tree.bvh =
+        collide::construct_collide_bvh(mesh_extract_out.collide.faces, bvh_split);
     collide_drawable_tree.packed_frags = pack_collide_frags(collide_drawable_tree.bvh.frags.frags);
   }
 
@@ -117,8 +216,16 @@ bool run_build_level(const std::string& input_file,
   file_util::write_binary_file(save_path, result.data(), result.size());
 
   // Save the PC level
-  save_pc_data(file.nickname, pc_level,
-               file_util::get_jak_project_dir() / "out" / output_prefix / "fr3");
+  if (!mesh_cached) {
+    save_pc_data(file.nickname, pc_level, out_dir / "fr3");
+    mesh_cache.fr3_size = fs::file_size(fr3_path);
+    mesh_cache.has_collide = !file.drawable_trees.collides.empty();
+    if (mesh_cache.has_collide) {
+      // the bsp is already saved, so the collide tree can be moved out.
+      mesh_cache.collide = std::move(file.drawable_trees.collides.front());
+    }
+    save_mesh_cache(mesh_cache_path, mesh_key, mesh_cache);
+  }
 
   return true;
 }
@@ -1,17 +1,23 @@
 #include "collide_bvh.h"
 
 #include <algorithm>
+#include <cmath>
+#include <future>
 #include <map>
 #include <unordered_set>
 
 #include "common/log/log.h"
 #include "common/util/Assert.h"
+#include "common/util/Serializer.h"
 #include "common/util/Timer.h"
 
 // Collision BVH algorithm
 // We start with all the points in a single node, then recursively split nodes in 8 until no nodes
 // have too many faces.
-// The splitting is done by doing median cuts along the x, y, or z axis.
+// The splitting is done by cuts along the x, y, or z axis. The cut is either at the median, or
+// picked by a binned surface area heuristic (SAH), which tries to keep the boxes of both sides
+// small so a query touches fewer faces.
+// Large subtrees are split on separate threads.
 
 // The bspheres are built at the end.
 
@@ -147,6 +153,119 @@ void split_node_once(CNode& node, CNode* out0, CNode* out1) {
   *out1 = temps[best_dim * 2 + 1];
 }
 
+constexpr int SAH_BIN_COUNT = 16;
+// leaves may be split in two again when laying out the tree, so don't make any with a single face.
+constexpr int SAH_MIN_FACES = 2;
+
+struct Aabb {
+  math::Vector3f lo = math::Vector3f(INFINITY, INFINITY, INFINITY);
+  math::Vector3f hi = math::Vector3f(-INFINITY, -INFINITY, -INFINITY);
+
+  void add(const math::Vector3f& pt) {
+    lo.min_in_place(pt);
+    hi.max_in_place(pt);
+  }
+
+  void add(const Aabb& other) {
+    lo.min_in_place(other.lo);
+    hi.max_in_place(other.hi);
+  }
+
+  float half_area() const {
+    if (lo.x() > hi.x()) {
+      return 0;
+    }
+    auto d = hi - lo;
+    return d.x() * d.y() + d.y() * d.z() + d.z() * d.x();
+  }
+};
+
+/*!
+ * Split a node into two nodes, at the bin boundary with the lowest SAH cost. Falls back to a
+ * median split if there's no boundary with enough faces on both sides.
+ * The outputs should be uninitialized nodes.
+ */
+void split_node_once_sah(CNode& node, CNode* out0, CNode* out1) {
+  auto& faces = node.faces;
+  ASSERT(!faces.empty());
+
+  Aabb centers;
+  for (auto& face : faces) {
+    centers.add(face.bsphere.xyz());
+  }
+
+  auto bin_of = [&](const CollideFace& face, int dim) {
+    float extent = centers.hi[dim] - centers.lo[dim];
+    int bin = (int)((face.bsphere[dim] - centers.lo[dim]) * (SAH_BIN_COUNT / extent));
+    return std::clamp(bin, 0, SAH_BIN_COUNT - 1);
+  };
+
+  float best_cost = INFINITY;
+  int best_dim = -1;
+  int best_split = -1;  // first bin on the right side.
+  for (int dim = 0; dim < 3; dim++) {
+    if (!(centers.hi[dim] > centers.lo[dim])) {
+      continue;
+    }
+
+    Aabb bin_boxes[SAH_BIN_COUNT];
+    int bin_counts[SAH_BIN_COUNT] = {};
+    for (auto& face : faces) {
+      int bin = bin_of(face, dim);
+      bin_counts[bin]++;
+      for (auto& v : face.v) {
+        bin_boxes[bin].add(v);
+      }
+    }
+
+    // sweep from the right to get the size of every right side, then from the left to cost them.
+    float right_area[SAH_BIN_COUNT];
+    int right_count[SAH_BIN_COUNT];
+    Aabb box;
+    int count = 0;
+    for (int i = SAH_BIN_COUNT - 1; i > 0; i--) {
+      box.add(bin_boxes[i]);
+      count += bin_counts[i];
+      right_area[i] = box.half_area();
+      right_count[i] = count;
+    }
+
+    box = Aabb();
+    count = 0;
+    for (int i = 0; i < SAH_BIN_COUNT - 1; i++) {
+      box.add(bin_boxes[i]);
+      count += bin_counts[i];
+      if (count < SAH_MIN_FACES || right_count[i + 1] < SAH_MIN_FACES) {
+        continue;
+      }
+      float cost = box.half_area() * count + right_area[i + 1] * right_count[i + 1];
+      if (cost < best_cost) {
+        best_cost = cost;
+        best_dim = dim;
+        best_split = i + 1;
+      }
+    }
+  }
+
+  if (best_dim == -1) {
+    split_node_once(node, out0, out1);
+    return;
+  }
+
+  for (auto& face : faces) {
+    if (bin_of(face, best_dim) < best_split) {
+      out0->faces.push_back(face);
+    } else {
+      out1->faces.push_back(face);
+    }
+  }
+  faces.clear();
+  compute_my_bsphere_ritters(*out0);
+  compute_my_bsphere_ritters(*out1);
+}
+
+using SplitFunction = void (*)(CNode&, CNode*, CNode*);
+
 bool needs_split(const CNode& node) {
   // quick reject.
   if (node.faces.size() > 100) {
@@ -168,27 +287,30 @@ bool needs_split(const CNode& node) {
   return unique_verts.size() >= MAX_UNIQUE_VERTS_IN_FRAG;
 }
 
-void split_recursive(CNode& to_split) {
+// subtrees this close to the root with at least this many faces are built on their own thread.
+constexpr int PARALLEL_SPLIT_DEPTH = 2;
+constexpr size_t PARALLEL_SPLIT_MIN_FACES = 1000;
+
+void split_recursive(CNode& to_split, SplitFunction split, int depth) {
   ASSERT(to_split.child_nodes.empty());
   ASSERT(!to_split.faces.empty());
 
+  std::vector<size_t> children_to_split;
   CNode level0[2];
-  split_node_once(to_split, &level0[0], &level0[1]);
+  split(to_split, &level0[0], &level0[1]);
   for (int i = 0; i < 2; i++) {
     if (needs_split(level0[i])) {
       CNode level1[2];
-      split_node_once(level0[i], &level1[0], &level1[1]);
+      split(level0[i], &level1[0], &level1[1]);
       for (int j = 0; j < 2; j++) {
         if (needs_split(level1[j])) {
           CNode level2[2];
-          split_node_once(level1[j], &level2[0], &level2[1]);
+          split(level1[j], &level2[0], &level2[1]);
           for (int k = 0; k < 2; k++) {
             if (needs_split(level2[k])) {
-              to_split.child_nodes.push_back(std::move(level2[k]));
-              split_recursive(to_split.child_nodes.back());
-            } else {
-              to_split.child_nodes.push_back(std::move(level2[k]));
+              children_to_split.push_back(to_split.child_nodes.size());
             }
+            to_split.child_nodes.push_back(std::move(level2[k]));
           }
         } else {
           to_split.child_nodes.push_back(std::move(level1[j]));
@@ -201,6 +323,22 @@ void split_recursive(CNode& to_split) {
 
   ASSERT(to_split.child_nodes.size() <= 8);
 
+  // the children are done being added, so they can be split independently.
+  std::vector<std::future<void>> child_tasks;
+  for (auto idx : children_to_split) {
+    auto& child = to_split.child_nodes[idx];
+    if (depth < PARALLEL_SPLIT_DEPTH && child.faces.size() >= PARALLEL_SPLIT_MIN_FACES) {
+      child_tasks.push_back(std::async(std::launch::async, [&child, split, depth] {
+        split_recursive(child, split, depth + 1);
+      }));
+    } else {
+      split_recursive(child, split, depth + 1);
+    }
+  }
+  for (auto& task : child_tasks) {
+    task.get();
+  }
+
   bool has_leaves = false;
   bool has_not_leaves = false;
   for (auto& child : to_split.child_nodes) {
@@ -219,8 +357,8 @@ void split_recursive(CNode& to_split) {
       if (!c.faces.empty()) {
         to_split.child_nodes.emplace_back();
         to_split.child_nodes.emplace_back();
-        split_node_once(c, &to_split.child_nodes[to_split.child_nodes.size() - 1],
-                        &to_split.child_nodes[to_split.child_nodes.size() - 2]);
+        split(c, &to_split.child_nodes[to_split.child_nodes.size() - 1],
+              &to_split.child_nodes[to_split.child_nodes.size() - 2]);
       } else {
         to_split.child_nodes.push_back(std::move(c));
       }
@@ -232,10 +370,19 @@ void split_recursive(CNode& to_split) {
  * Recursively compute bspheres of all children
  * (note that we don't do bspheres of bspheres... I think this is better?)
  */
-void bsphere_recursive(CNode& node) {
+void bsphere_recursive(CNode& node, int depth) {
   compute_my_bsphere_ritters(node);
+  std::vector<std::future<void>> child_tasks;
   for (auto& child : node.child_nodes) {
-    bsphere_recursive(child);
+    if (depth < PARALLEL_SPLIT_DEPTH) {
+      child_tasks.push_back(
+          std::async(std::launch::async, [&child, depth] { bsphere_recursive(child, depth + 1); }));
+    } else {
+      bsphere_recursive(child, depth + 1);
+    }
+  }
+  for (auto& task : child_tasks) {
+    task.get();
   }
 }
 
@@ -266,7 +413,50 @@ CollideTree build_collide_tree(CNode& root) {
   return tree;
 }
 
-void debug_stats(const CollideTree& tree) {
+bool spheres_overlap(const math::Vector4f& a, const math::Vector4f& b) {
+  float r = a.w() + b.w();
+  return (a.xyz() - b.xyz()).squared_length() <= r * r;
+}
+
+int faces_tested_by_query(const DrawNode& node,
+                          const CollideTree& tree,
+                          const math::Vector4f& query) {
+  int result = 0;
+  for (auto& child : node.draw_node_children) {
+    if (spheres_overlap(child.bsphere, query)) {
+      result += faces_tested_by_query(child, tree, query);
+    }
+  }
+  for (int frag_idx : node.frag_children) {
+    auto& frag = tree.frags.frags[frag_idx];
+    if (spheres_overlap(frag.bsphere, query)) {
+      result += frag.faces.size();
+    }
+  }
+  return result;
+}
+
+/*!
+ * Estimate how good the tree is for the game's collision queries: place a query sphere about the
+ * size of the player on the faces, and count how many faces each query has to test.
+ */
+float average_faces_tested_per_query(const CollideTree& tree,
+                                     const std::vector<CollideFace>& tris) {
+  constexpr float QUERY_RADIUS = 2.f * 4096.f;
+  constexpr size_t MAX_QUERIES = 4096;
+  size_t stride = std::max(size_t(1), tris.size() / MAX_QUERIES);
+  u64 total = 0;
+  int queries = 0;
+  for (size_t i = 0; i < tris.size(); i += stride) {
+    math::Vector4f query = tris[i].bsphere;
+    query.w() = QUERY_RADIUS;
+    total += faces_tested_by_query(tree.fake_root_node, tree, query);
+    queries++;
+  }
+  return queries ? float(total) / queries : 0;
+}
+
+void debug_stats(const CollideTree& tree, const std::vector<CollideFace>& tris) {
   float sum_w = 0, max_w = 0;
   for (auto& frag : tree.frags.frags) {
     sum_w += frag.bsphere.w();
@@ -274,28 +464,31 @@ void debug_stats(const CollideTree& tree) {
   }
   lg::info("Max bsphere radius: {:.2f}m, average {:.2f} (aiming for around 20-30m avg)",
            max_w / 4096, sum_w / (4096 * tree.frags.frags.size()));
+  lg::info("{} frags, {:.1f} faces tested per query on average", tree.frags.frags.size(),
+           average_faces_tested_per_query(tree, tris));
 }
 
 }  // namespace
 
-CollideTree construct_collide_bvh(const std::vector<CollideFace>& tris) {
+CollideTree construct_collide_bvh(const std::vector<CollideFace>& tris, BvhSplit split) {
   // part 1: build the tree
   Timer bvh_timer;
-  lg::info("Building collide bvh from {} triangles", tris.size());
+  lg::info("Building collide bvh from {} triangles ({} split)", tris.size(),
+           split == BvhSplit::SAH ? "sah" : "median");
   CNode root;
   root.faces = tris;
-  split_recursive(root);
+  split_recursive(root, split == BvhSplit::SAH ? split_node_once_sah : split_node_once, 0);
   lg::info("BVH tree constructed in {:.2f} ms", bvh_timer.getMs());
 
   // part 2: compute bspheres
   bvh_timer.start();
-  bsphere_recursive(root);
+  bsphere_recursive(root, 0);
   lg::info("Found bspheres in {:.2f} ms", bvh_timer.getMs());
 
   // part 3: layout tree
   bvh_timer.start();
   auto tree = build_collide_tree(root);
-  debug_stats(tree);
+  debug_stats(tree, tris);
 
   lg::info("Tree layout done in {:.2f} ms", bvh_timer.getMs());
   std::map<int, int> size_histogram;
@@ -310,4 +503,34 @@ CollideTree construct_collide_bvh(const std::vector<CollideFace>& tris) {
   return tree;
 }
 
+void DrawNode::serialize(Serializer& ser) {
+  ser.from_ptr(&bsphere);
+  ser.from_pod_vector(&frag_children);
+  if (ser.is_saving()) {
+    ser.save<size_t>(draw_node_children.size());
+  } else {
+    draw_node_children.resize(ser.load<size_t>());
+  }
+  for (auto& child : draw_node_children) {
+    child.serialize(ser);
+  }
+}
+
+void CollideFrag::serialize(Serializer& ser) {
+  ser.from_ptr(&bsphere);
+  ser.from_pod_vector(&faces);
+}
+
+void CollideTree::serialize(Serializer& ser) {
+  fake_root_node.serialize(ser);
+  if (ser.is_saving()) {
+    ser.save<size_t>(frags.frags.size());
+  } else {
+    frags.frags.resize(ser.load<size_t>());
+  }
+  for (auto& frag : frags.frags) {
+    frag.serialize(ser);
+  }
+}
+
 }  // namespace collide
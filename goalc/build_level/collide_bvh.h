@@ -4,6 +4,8 @@
 
 #include "goalc/build_level/collide_common.h"
 
+class Serializer;
+
 // requirements:
 // max depth of 3 (maybe?)
 // max face per frag = 90
@@ -15,11 +17,13 @@ struct DrawNode {
   std::vector<DrawNode> draw_node_children;
   std::vector<int> frag_children;
   math::Vector4f bsphere;
+  void serialize(Serializer& ser);
 };
 
 struct CollideFrag {
   math::Vector4f bsphere;
   std::vector<CollideFace> faces;
+  void serialize(Serializer& ser);
 };
 
 struct DrawableInlineArrayNode {
@@ -34,7 +38,15 @@ struct CollideTree {
   //  std::vector<DrawableInlineArrayNode> node_arrays;
   DrawNode fake_root_node;  // the children of this are the ones that go in the top level.
   DrawableInlineArrayCollideFrag frags;
+  void serialize(Serializer& ser);
+};
+
+// how a node's faces are divided in two.
+enum class BvhSplit {
+  MEDIAN,  // at the median face, along the axis giving the smallest bspheres
+  SAH,     // at the cut with the lowest surface area heuristic cost
 };
 
-CollideTree construct_collide_bvh(const std::vector<CollideFace>& tris);
+CollideTree construct_collide_bvh(const std::vector<CollideFace>& tris,
+                                  BvhSplit split = BvhSplit::SAH);
 }  // namespace collide
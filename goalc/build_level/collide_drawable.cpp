@@ -4,6 +4,7 @@
 #include <unordered_set>
 
 #include "common/util/Assert.h"
+#include "common/util/Serializer.h"
 
 #include "goalc/data_compiler/DataObjectGenerator.h"
 
@@ -343,3 +344,8 @@ size_t DrawableTreeCollideFragment::add_to_object_file(DataObjectGenerator& gen)
     return result;
   }
 }
+
+void DrawableTreeCollideFragment::serialize(Serializer& ser) {
+  packed_frags.serialize(ser);
+  bvh.serialize(ser);
+}
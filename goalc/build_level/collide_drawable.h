@@ -4,9 +4,11 @@
 #include "goalc/build_level/collide_pack.h"
 
 class DataObjectGenerator;
+class Serializer;
 
 struct DrawableTreeCollideFragment {
   CollideFragMeshDataArray packed_frags;
   collide::CollideTree bvh;
   size_t add_to_object_file(DataObjectGenerator& gen) const;
+  void serialize(Serializer& ser);
 };
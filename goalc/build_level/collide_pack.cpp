@@ -1,10 +1,13 @@
 #include "collide_pack.h"
 
+#include <algorithm>
 #include <functional>
 #include <unordered_map>
 
 #include "common/log/log.h"
 #include "common/util/Assert.h"
+#include "common/util/Serializer.h"
+#include "common/util/ThreadPool.h"
 #include "common/util/Timer.h"
 
 struct PackedU16Verts {
@@ -142,16 +145,17 @@ struct Vector3fHash {
 };
 
 /*!
- * Deduplicate vertices, converted to indexed, add to pat palette, pack to u16s.
+ * Deduplicate vertices, converted to indexed, look up in pat palette, pack to u16s.
+ * All pats must already be in the palette, so frags can be done in parallel.
  */
-IndexedFaces dedup_frag_mesh(const collide::CollideFrag& frag, PatMap* pat_map) {
+IndexedFaces dedup_frag_mesh(const collide::CollideFrag& frag, const PatMap& pat_map) {
   IndexedFaces result;
   std::unordered_map<math::Vector3f, u32, Vector3fHash> vertex_map;
 
   for (auto& face_in : frag.faces) {
     auto& face_out = result.faces.emplace_back();
     // pat:
-    face_out.pat_idx = pat_map->add_pat(face_in.pat);
+    face_out.pat_idx = pat_map.map.at(face_in.pat);
     // vertices
     for (int i = 0; i < 3; i++) {
       const auto& lookup = vertex_map.find(face_in.v[i]);
@@ -188,56 +192,73 @@ std::vector<u8> make_dumb_strip_table(const IndexedFaces& faces) {
   return out;
 }
 
+void pack_collide_frag(const collide::CollideFrag& frag_in,
+                       const PatMap& pat_map,
+                       CollideFragMeshData& frag_out) {
+  auto indexed = dedup_frag_mesh(frag_in, pat_map);
+  // first part of packed_data is the u16 vertex data:
+  frag_out.vertex_count = indexed.vertices_u16.vertex.size();
+  if (frag_out.vertex_count > 128) {
+    lg::print("frag with too many vertices: {} had {} tris\n", frag_out.vertex_count,
+              frag_in.faces.size());
+    lg::error("SHOULD CRASH\n");
+  }
+  // the
+  frag_out.packed_data.resize(sizeof(u16) * frag_out.vertex_count * 3);
+  memcpy(frag_out.packed_data.data(), indexed.vertices_u16.vertex.data(),
+         frag_out.packed_data.size());
+  // align to 16-bytes
+  while (frag_out.packed_data.size() & 0xf) {
+    frag_out.packed_data.push_back(0);
+  }
+  // remember where
+  frag_out.vertex_data_qwc = frag_out.packed_data.size() / 16;
+
+  // up next, the strip table
+  auto strip = make_dumb_strip_table(indexed);
+  frag_out.packed_data.insert(frag_out.packed_data.end(), strip.begin(), strip.end());
+  frag_out.strip_data_len = strip.size();
+  ASSERT(frag_out.strip_data_len < UINT16_MAX);  // probably in big trouble in here.
+
+  // pat table
+  for (auto& face : indexed.faces) {
+    frag_out.packed_data.push_back(face.pat_idx);
+  }
+
+  // align to 16-bytes so total_qwc works.
+  while (frag_out.packed_data.size() & 0xf) {
+    frag_out.packed_data.push_back(0);
+  }
+  // gonna guess here:
+  frag_out.poly_count = indexed.faces.size();
+  frag_out.total_qwc = frag_out.packed_data.size() / 16;
+  ASSERT(frag_out.total_qwc <= 128);
+  frag_out.base_trans_xyz_s32 = indexed.vertices_u16.base;
+  frag_out.bsphere = frag_in.bsphere;
+}
+
 CollideFragMeshDataArray pack_collide_frags(const std::vector<collide::CollideFrag>& frag_data) {
   Timer pack_timer;
   CollideFragMeshDataArray result;
   PatMap pat_map;
 
-  size_t total_pack_bytes = 0;
   lg::info("Packing {} fragments", frag_data.size());
 
+  // pats are numbered in the order they're first seen, so this has to happen in order.
   for (auto& frag_in : frag_data) {
-    auto& frag_out = result.packed_frag_data.emplace_back();
-    auto indexed = dedup_frag_mesh(frag_in, &pat_map);
-    // first part of packed_data is the u16 vertex data:
-    frag_out.vertex_count = indexed.vertices_u16.vertex.size();
-    if (frag_out.vertex_count > 128) {
-      lg::print("frag with too many vertices: {} had {} tris\n", frag_out.vertex_count,
-                frag_in.faces.size());
-      lg::error("SHOULD CRASH\n");
-    }
-    // the
-    frag_out.packed_data.resize(sizeof(u16) * frag_out.vertex_count * 3);
-    memcpy(frag_out.packed_data.data(), indexed.vertices_u16.vertex.data(),
-           frag_out.packed_data.size());
-    // align to 16-bytes
-    while (frag_out.packed_data.size() & 0xf) {
-      frag_out.packed_data.push_back(0);
-    }
-    // remember where
-    frag_out.vertex_data_qwc = frag_out.packed_data.size() / 16;
-
-    // up next, the strip table
-    auto strip = make_dumb_strip_table(indexed);
-    frag_out.packed_data.insert(frag_out.packed_data.end(), strip.begin(), strip.end());
-    frag_out.strip_data_len = strip.size();
-    ASSERT(frag_out.strip_data_len < UINT16_MAX);  // probably in big trouble in here.
-
-    // pat table
-    for (auto& face : indexed.faces) {
-      frag_out.packed_data.push_back(face.pat_idx);
+    for (auto& face : frag_in.faces) {
+      pat_map.add_pat(face.pat);
     }
+  }
 
-    // align to 16-bytes so total_qwc works.
-    while (frag_out.packed_data.size() & 0xf) {
-      frag_out.packed_data.push_back(0);
-    }
-    // gonna guess here:
-    frag_out.poly_count = indexed.faces.size();
-    frag_out.total_qwc = frag_out.packed_data.size() / 16;
-    ASSERT(frag_out.total_qwc <= 128);
-    frag_out.base_trans_xyz_s32 = indexed.vertices_u16.base;
-    frag_out.bsphere = frag_in.bsphere;
+  // each frag is packed on its own.
+  result.packed_frag_data.resize(frag_data.size());
+  parallel_for(frag_data.size(), [&](int i) {
+    pack_collide_frag(frag_data[i], pat_map, result.packed_frag_data[i]);
+  });
+
+  size_t total_pack_bytes = 0;
+  for (auto& frag_out : result.packed_frag_data) {
     total_pack_bytes += frag_out.packed_data.size();
   }
 
@@ -248,6 +269,29 @@ CollideFragMeshDataArray pack_collide_frags(const std::vector<collide::CollideFr
   return result;
 }
 
+void CollideFragMeshData::serialize(Serializer& ser) {
+  ser.from_ptr(&bsphere);
+  ser.from_pod_vector(&packed_data);
+  ser.from_ptr(&strip_data_len);
+  ser.from_ptr(&poly_count);
+  ser.from_ptr(&base_trans_xyz_s32);
+  ser.from_ptr(&vertex_count);
+  ser.from_ptr(&vertex_data_qwc);
+  ser.from_ptr(&total_qwc);
+}
+
+void CollideFragMeshDataArray::serialize(Serializer& ser) {
+  if (ser.is_saving()) {
+    ser.save<size_t>(packed_frag_data.size());
+  } else {
+    packed_frag_data.resize(ser.load<size_t>());
+  }
+  for (auto& frag : packed_frag_data) {
+    frag.serialize(ser);
+  }
+  ser.from_pod_vector(&pats);
+}
+
 /*
 (deftype collide-frag-mesh (basic)
   ((packed-data     uint32         :offset-assert 4)  <- ptr
@@ -1,10 +1,18 @@
 #include "color_quantization.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
 #include <unordered_map>
 
+#if !defined(__arm__) && !defined(__aarch64__)
+#include <immintrin.h>
+#endif
+
 #include "common/log/log.h"
 #include "common/util/Assert.h"
+#include "common/util/SimpleThreadGroup.h"
 
 /*!
  * Just removes duplicate colors, which can work if there are only a few unique colors.
@@ -37,6 +45,7 @@ using Color = math::Vector<u8, 4>;
 // An octree node.
 // Represents a color in the output if rgb_sum_count > 0.
 // Otherwise, just organizational.
+// Nodes are stored in a pool, and refer to each other by index.
 struct Node {
   u32 r_sum = 0;
   u32 g_sum = 0;
@@ -46,12 +55,22 @@ struct Node {
 
   // children stuff
   u32 leaves_under_me = 0;
-  std::vector<Node> children;
-  Node* parent = nullptr;
+  s32 first_child = -1;  // the 8 children are next to each other in the pool
+  s32 parent = -1;
 
   u32 final_idx = UINT32_MAX;
 };
 
+struct Octree {
+  std::vector<Node> nodes;  // nodes[0] is the root
+
+  Octree() {
+    nodes.emplace_back().depth = 0;
+  }
+
+  Node& root() { return nodes[0]; }
+};
+
 u8 child_index(Color color, u8 depth) {
   u8 r_bit = (color.x() >> (7 - depth)) & 1;
   u8 g_bit = (color.y() >> (7 - depth)) & 1;
@@ -59,64 +78,65 @@ u8 child_index(Color color, u8 depth) {
   return (r_bit) + (g_bit * 2) + (b_bit * 4);
 }
 
-void insert(Node& root, Color color, u8 current_depth) {
-  if (current_depth == 7) {
-    root.r_sum += color.x();
-    root.g_sum += color.y();
-    root.b_sum += color.z();
-    if (root.rgb_sum_count == 0) {
-      for (auto* up = root.parent; up; up = up->parent) {
-        up->leaves_under_me++;
-      }
-    }
-    root.rgb_sum_count++;
-  } else {
-    if (root.children.empty()) {
-      root.children.resize(8);
+/*!
+ * Add count copies of a color to the tree.
+ */
+void insert(Octree& tree, Color color, u32 count) {
+  s32 node_idx = 0;
+  for (u8 depth = 0; depth < 7; depth++) {
+    if (tree.nodes[node_idx].first_child == -1) {
+      // note: this may move the nodes, so no references are held across it.
+      s32 first_child = tree.nodes.size();
+      tree.nodes.resize(tree.nodes.size() + 8);
+      tree.nodes[node_idx].first_child = first_child;
     }
-    auto& next_node = root.children[child_index(color, current_depth)];
+    s32 next_idx = tree.nodes[node_idx].first_child + child_index(color, depth);
+    auto& next_node = tree.nodes[next_idx];
     if (next_node.depth == 0xff) {
-      next_node.depth = current_depth + 1;
-      next_node.parent = &root;
+      next_node.depth = depth + 1;
+      next_node.parent = node_idx;
     }
-    insert(next_node, color, current_depth + 1);
+    node_idx = next_idx;
   }
-}
 
-template <typename T>
-void for_each_node(Node& root, T&& func) {
-  func(root);
-  for (auto& child : root.children) {
-    for_each_node(child, func);
+  auto& leaf = tree.nodes[node_idx];
+  leaf.r_sum += color.x() * count;
+  leaf.g_sum += color.y() * count;
+  leaf.b_sum += color.z() * count;
+  if (leaf.rgb_sum_count == 0) {
+    for (s32 up = leaf.parent; up != -1; up = tree.nodes[up].parent) {
+      tree.nodes[up].leaves_under_me++;
+    }
   }
+  leaf.rgb_sum_count += count;
 }
 
-u32 count_leaves(Node& root) {
-  u32 result = 0;
-  for_each_node(root, [&](Node& n) {
-    if (n.rgb_sum_count) {
-      ASSERT(n.children.empty());
-      result++;
+template <typename T>
+void for_each_node(Octree& tree, s32 idx, T&& func) {
+  func(tree.nodes[idx]);
+  s32 first_child = tree.nodes[idx].first_child;
+  if (first_child != -1) {
+    for (s32 i = 0; i < 8; i++) {
+      for_each_node(tree, first_child + i, func);
     }
-  });
-  return result;
+  }
 }
 
-void collapse1(Node& root) {
-  ASSERT(!root.children.empty());
+void collapse1(Octree& tree, s32 idx) {
+  auto& root = tree.nodes[idx];
+  ASSERT(root.first_child != -1);
   u32 total_children_removed = 0;
-  u32 total_rgb_sum_moved_up = 0;
   bool started_as_leaf = root.rgb_sum_count;
-  for (auto& child : root.children) {
+  for (s32 i = 0; i < 8; i++) {
+    auto& child = tree.nodes[root.first_child + i];
     if (child.depth != 0xff) {
-      ASSERT(child.children.empty());
+      ASSERT(child.first_child == -1);
       ASSERT(child.rgb_sum_count);
       total_children_removed++;
       root.r_sum += child.r_sum;
       root.g_sum += child.g_sum;
       root.b_sum += child.b_sum;
       root.rgb_sum_count += child.rgb_sum_count;
-      total_rgb_sum_moved_up += child.rgb_sum_count;
     }
   }
   ASSERT(total_children_removed == root.leaves_under_me);
@@ -124,49 +144,52 @@ void collapse1(Node& root) {
   if (!started_as_leaf && root.rgb_sum_count) {
     total_children_removed--;
   }
-  root.children.clear();
+  // the children are left in the pool, but can't be reached anymore.
+  root.first_child = -1;
   root.leaves_under_me = 0;
   if (total_children_removed) {
-    for (auto* up = root.parent; up; up = up->parent) {
-      up->leaves_under_me -= total_children_removed;
+    for (s32 up = root.parent; up != -1; up = tree.nodes[up].parent) {
+      tree.nodes[up].leaves_under_me -= total_children_removed;
     }
   }
-
-  ASSERT(count_leaves(root) == 1);
+  ASSERT(root.rgb_sum_count);
 }
 
-void find_nodes_at_level(Node& n, std::vector<Node*>& out, u8 level) {
+void find_nodes_at_level(Octree& tree, s32 idx, std::vector<s32>& out, u8 level) {
+  auto& n = tree.nodes[idx];
   if (n.depth == level) {
-    out.push_back(&n);
-  } else if (n.depth < level) {
-    for (auto& child : n.children) {
-      find_nodes_at_level(child, out, level);
+    out.push_back(idx);
+  } else if (n.depth < level && n.first_child != -1) {
+    for (s32 i = 0; i < 8; i++) {
+      find_nodes_at_level(tree, n.first_child + i, out, level);
     }
   }
 }
 
-void collapse_at_level(Node& root, u8 level, u32 target_leaf_count) {
-  std::vector<Node*> nodes_at_level;
-  find_nodes_at_level(root, nodes_at_level, level);
-  std::stable_sort(nodes_at_level.begin(), nodes_at_level.end(),
-                   [](Node* a, Node* b) { return a->leaves_under_me < b->leaves_under_me; });
+void collapse_at_level(Octree& tree, u8 level, u32 target_leaf_count) {
+  std::vector<s32> nodes_at_level;
+  find_nodes_at_level(tree, 0, nodes_at_level, level);
+  std::stable_sort(nodes_at_level.begin(), nodes_at_level.end(), [&](s32 a, s32 b) {
+    return tree.nodes[a].leaves_under_me < tree.nodes[b].leaves_under_me;
+  });
 
   size_t at_level_to_try = 0;
-  while (root.leaves_under_me > target_leaf_count && at_level_to_try < nodes_at_level.size()) {
-    collapse1(*nodes_at_level[at_level_to_try++]);
+  while (tree.root().leaves_under_me > target_leaf_count &&
+         at_level_to_try < nodes_at_level.size()) {
+    collapse1(tree, nodes_at_level[at_level_to_try++]);
   }
 }
 
-void collapse_as_needed(Node& root, u32 target_leaf_count) {
+void collapse_as_needed(Octree& tree, u32 target_leaf_count) {
   u32 level_to_reduce = 6;
-  while (root.leaves_under_me > target_leaf_count) {
-    collapse_at_level(root, level_to_reduce--, target_leaf_count);
+  while (tree.root().leaves_under_me > target_leaf_count) {
+    collapse_at_level(tree, level_to_reduce--, target_leaf_count);
   }
 }
 
-void assign_colors(Node& root, std::vector<Color>& palette_out) {
+void assign_colors(Octree& tree, std::vector<Color>& palette_out) {
   u32 idx = 0;
-  for_each_node(root, [&](Node& n) {
+  for_each_node(tree, 0, [&](Node& n) {
     if (n.rgb_sum_count) {
       n.final_idx = idx++;
       palette_out.emplace_back(n.r_sum / n.rgb_sum_count, n.g_sum / n.rgb_sum_count,
@@ -175,11 +198,151 @@ void assign_colors(Node& root, std::vector<Color>& palette_out) {
   });
 }
 
-u32 lookup_node_for_color(Node& root, Color c, u8 depth) {
-  if (root.children.empty()) {
-    return root.final_idx;
-  } else {
-    return lookup_node_for_color(root.children[child_index(c, depth)], c, depth + 1);
+u32 lookup_node_for_color(const Octree& tree, Color c) {
+  s32 idx = 0;
+  for (u8 depth = 0; tree.nodes[idx].first_child != -1; depth++) {
+    idx = tree.nodes[idx].first_child + child_index(c, depth);
+  }
+  return tree.nodes[idx].final_idx;
+}
+
+/*!
+ * The palette, split by channel so four entries can be compared at once.
+ */
+struct PaletteSoa {
+  std::vector<float> r, g, b;
+
+  explicit PaletteSoa(const std::vector<Color>& palette) {
+    // pad to a multiple of 4 with entries that are too far away to ever be picked.
+    size_t padded_size = (palette.size() + 3) & ~size_t(3);
+    r.resize(padded_size, 1e9f);
+    g.resize(padded_size, 1e9f);
+    b.resize(padded_size, 1e9f);
+    for (size_t i = 0; i < palette.size(); i++) {
+      r[i] = palette[i].x();
+      g[i] = palette[i].y();
+      b[i] = palette[i].z();
+    }
+  }
+};
+
+/*!
+ * Find the palette entry closest to a color. Ties go to the lowest index.
+ */
+#if defined(__arm__) || defined(__aarch64__)
+u32 find_nearest(const PaletteSoa& palette, Color c) {
+  u32 result = 0;
+  float result_dist = INFINITY;
+  for (size_t i = 0; i < palette.r.size(); i++) {
+    float dr = palette.r[i] - c.x();
+    float dg = palette.g[i] - c.y();
+    float db = palette.b[i] - c.z();
+    float dist = dr * dr + dg * dg + db * db;
+    if (dist < result_dist) {
+      result = i;
+      result_dist = dist;
+    }
+  }
+  return result;
+}
+#else
+u32 find_nearest(const PaletteSoa& palette, Color c) {
+  __m128 cr = _mm_set1_ps(c.x());
+  __m128 cg = _mm_set1_ps(c.y());
+  __m128 cb = _mm_set1_ps(c.z());
+  __m128 best_dist = _mm_set1_ps(INFINITY);
+  __m128i best_idx = _mm_setzero_si128();
+  __m128i idx = _mm_setr_epi32(0, 1, 2, 3);
+  const __m128i four = _mm_set1_epi32(4);
+  for (size_t i = 0; i < palette.r.size(); i += 4) {
+    __m128 dr = _mm_sub_ps(_mm_loadu_ps(&palette.r[i]), cr);
+    __m128 dg = _mm_sub_ps(_mm_loadu_ps(&palette.g[i]), cg);
+    __m128 db = _mm_sub_ps(_mm_loadu_ps(&palette.b[i]), cb);
+    __m128 dist =
+        _mm_add_ps(_mm_add_ps(_mm_mul_ps(dr, dr), _mm_mul_ps(dg, dg)), _mm_mul_ps(db, db));
+    __m128 closer = _mm_cmplt_ps(dist, best_dist);
+    best_dist = _mm_min_ps(dist, best_dist);
+    best_idx = _mm_or_si128(_mm_and_si128(_mm_castps_si128(closer), idx),
+                            _mm_andnot_si128(_mm_castps_si128(closer), best_idx));
+    idx = _mm_add_epi32(idx, four);
+  }
+
+  float dists[4];
+  u32 idxs[4];
+  _mm_storeu_ps(dists, best_dist);
+  _mm_storeu_si128((__m128i*)idxs, best_idx);
+  u32 result = idxs[0];
+  float result_dist = dists[0];
+  for (int lane = 1; lane < 4; lane++) {
+    if (dists[lane] < result_dist || (dists[lane] == result_dist && idxs[lane] < result)) {
+      result = idxs[lane];
+      result_dist = dists[lane];
+    }
+  }
+  return result;
+}
+#endif
+
+/*!
+ * Improve the palette with a few rounds of k-means: assign each color to the nearest palette entry,
+ * then move each entry to the average of its colors. The assignment is split across threads.
+ */
+void refine_kmeans(const std::vector<Color>& colors,
+                   const std::vector<u32>& counts,
+                   std::vector<Color>& palette,
+                   std::vector<u32>& color_to_palette,
+                   int iterations) {
+  struct Sums {
+    std::vector<u64> r, g, b, count;
+    explicit Sums(size_t size) : r(size), g(size), b(size), count(size) {}
+  };
+
+  constexpr size_t COLORS_PER_CHUNK = 4096;
+  int num_chunks = (colors.size() + COLORS_PER_CHUNK - 1) / COLORS_PER_CHUNK;
+  int num_threads = std::max(1, std::min(num_chunks, (int)std::thread::hardware_concurrency()));
+
+  for (int iter = 0; iter <= iterations; iter++) {
+    PaletteSoa soa(palette);
+    std::vector<Sums> thread_sums(num_threads, Sums(palette.size()));
+    std::atomic<int> next_chunk = 0;
+    SimpleThreadGroup threads;
+    threads.run(
+        [&](int thread_idx) {
+          auto& sums = thread_sums[thread_idx];
+          for (int chunk = next_chunk++; chunk < num_chunks; chunk = next_chunk++) {
+            size_t end = std::min(colors.size(), (chunk + 1) * COLORS_PER_CHUNK);
+            for (size_t i = chunk * COLORS_PER_CHUNK; i < end; i++) {
+              u32 nearest = find_nearest(soa, colors[i]);
+              color_to_palette[i] = nearest;
+              sums.r[nearest] += colors[i].x() * counts[i];
+              sums.g[nearest] += colors[i].y() * counts[i];
+              sums.b[nearest] += colors[i].z() * counts[i];
+              sums.count[nearest] += counts[i];
+            }
+          }
+        },
+        num_threads, num_threads);
+    threads.join();
+
+    // the last round only assigns colors, so they match the final palette.
+    if (iter == iterations) {
+      break;
+    }
+
+    for (size_t p = 0; p < palette.size(); p++) {
+      u64 r = 0, g = 0, b = 0, count = 0;
+      for (auto& sums : thread_sums) {
+        r += sums.r[p];
+        g += sums.g[p];
+        b += sums.b[p];
+        count += sums.count[p];
+      }
+      // an entry nobody picked keeps its color.
+      if (count) {
+        palette[p] = Color((r + count / 2) / count, (g + count / 2) / count,
+                           (b + count / 2) / count, palette[p].w());
+      }
+    }
   }
 }
 
@@ -187,37 +350,68 @@ u32 lookup_node_for_color(Node& root, Color c, u8 depth) {
 
 /*!
  * Quantize colors using an octree for clustering.
+ * If kmeans_iterations is nonzero, the octree's palette is then refined with k-means, which
+ * lowers the error but takes longer.
  */
 QuantizedColors quantize_colors_octree(const std::vector<math::Vector<u8, 4>>& in,
-                                       u32 target_count) {
-  Node root;
-  root.depth = 0;
-  for (auto& color : in) {
-    insert(root, color, 0);
+                                       u32 target_count,
+                                       int kmeans_iterations) {
+  // vertices often share colors, so do all the work on unique colors.
+  std::vector<Color> unique_colors;
+  std::vector<u32> unique_counts;
+  std::vector<u32> vtx_to_unique;
+  vtx_to_unique.reserve(in.size());
+  {
+    std::unordered_map<u32, u32> rgb_to_unique;
+    for (auto& color : in) {
+      u32 key = color.x() | (color.y() << 8) | (color.z() << 16);
+      auto [it, inserted] = rgb_to_unique.try_emplace(key, unique_colors.size());
+      if (inserted) {
+        unique_colors.push_back(color);
+        unique_counts.push_back(0);
+      }
+      unique_counts[it->second]++;
+      vtx_to_unique.push_back(it->second);
+    }
   }
 
-  collapse_as_needed(root, target_count);
+  Octree tree;
+  for (size_t i = 0; i < unique_colors.size(); i++) {
+    insert(tree, unique_colors[i], unique_counts[i]);
+  }
+
+  collapse_as_needed(tree, target_count);
 
   QuantizedColors out;
-  assign_colors(root, out.final_colors);
-  for (auto& color : in) {
-    out.vtx_to_color.push_back(lookup_node_for_color(root, color, 0));
+  assign_colors(tree, out.final_colors);
+  std::vector<u32> unique_to_color(unique_colors.size());
+  for (size_t i = 0; i < unique_colors.size(); i++) {
+    unique_to_color[i] = lookup_node_for_color(tree, unique_colors[i]);
   }
 
-  float total_error[3] = {0, 0, 0};
+  if (kmeans_iterations > 0 && !out.final_colors.empty()) {
+    refine_kmeans(unique_colors, unique_counts, out.final_colors, unique_to_color,
+                  kmeans_iterations);
+  }
+
+  out.vtx_to_color.resize(in.size());
   for (size_t i = 0; i < in.size(); i++) {
-    // lg::print(" {} -> {}\n", in[i].to_string_hex_byte(),
-    // out.final_colors[out.vtx_to_color[i]].to_string_hex_byte());
-    auto diff = in[i].cast<int>() - out.final_colors[out.vtx_to_color[i]].cast<int>();
+    out.vtx_to_color[i] = unique_to_color[vtx_to_unique[i]];
+  }
+
+  float total_error[3] = {0, 0, 0};
+  for (size_t i = 0; i < unique_colors.size(); i++) {
+    auto diff = unique_colors[i].cast<int>() - out.final_colors[unique_to_color[i]].cast<int>();
 
     for (int j = 0; j < 3; j++) {
-      total_error[j] += std::abs(diff[j]);
+      total_error[j] += std::abs(diff[j]) * (float)unique_counts[i];
     }
   }
 
   lg::info("Octree quantize average error (as 8-bit ints): r: {}, g: {} b: {}",
            total_error[0] / in.size(), total_error[1] / in.size(), total_error[2] / in.size());
-  lg::info("Final palette size: {}", out.final_colors.size());
+  lg::info("Final palette size: {} (from {} unique colors)", out.final_colors.size(),
+           unique_colors.size());
 
   return out;
 }
@@ -18,4 +18,5 @@ struct QuantizedColors {
 QuantizedColors quantize_colors_dumb(const std::vector<math::Vector<u8, 4>>& in);
 
 QuantizedColors quantize_colors_octree(const std::vector<math::Vector<u8, 4>>& in,
-                                       u32 target_count);
\ No newline at end of file
+                                       u32 target_count,
+                                       int kmeans_iterations = 0);
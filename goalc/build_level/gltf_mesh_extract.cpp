@@ -4,10 +4,13 @@
 
 #include "gltf_mesh_extract.h"
 
+#include <algorithm>
+#include <future>
 #include <optional>
 
 #include "common/log/log.h"
 #include "common/math/geometry.h"
+#include "common/util/ThreadPool.h"
 #include "common/util/Timer.h"
 
 #include "goalc/build_level/color_quantization.h"
@@ -426,6 +429,15 @@ std::vector<NodeWithTransform> flatten_nodes_from_all_scenes(const tinygltf::Mod
   return out;
 }
 
+/*!
+ * A primitive of a mesh, and the node that places it in the world.
+ */
+struct PrimitiveInNode {
+  const NodeWithTransform* node;
+  const tinygltf::Mesh* mesh;
+  const tinygltf::Primitive* prim;
+};
+
 void dedup_vertices(const std::vector<tfrag3::PreloadedVertex>& vertices_in,
                     std::vector<tfrag3::PreloadedVertex>& vertices_out,
                     std::vector<u32>& old_to_new_out) {
@@ -433,20 +445,29 @@ void dedup_vertices(const std::vector<tfrag3::PreloadedVertex>& vertices_in,
   ASSERT(old_to_new_out.empty());
   old_to_new_out.resize(vertices_in.size(), -1);
 
-  std::unordered_map<tfrag3::PreloadedVertex, u32, tfrag3::PreloadedVertex::hash> vtx_to_new;
+  // open addressing table of indices into vertices_out, with linear probing. It's at least twice
+  // the number of input vertices, so it never fills up and probe sequences stay short.
+  constexpr u32 kEmpty = UINT32_MAX;
+  size_t table_size = 16;
+  while (table_size < 2 * vertices_in.size()) {
+    table_size *= 2;
+  }
+  const size_t mask = table_size - 1;
+  std::vector<u32> table(table_size, kEmpty);
+  tfrag3::PreloadedVertex::hash hasher;
 
   for (size_t in_idx = 0; in_idx < vertices_in.size(); in_idx++) {
     auto& vtx = vertices_in[in_idx];
-    const auto& lookup = vtx_to_new.find(vtx);
-    if (lookup == vtx_to_new.end()) {
+    size_t slot = hasher(vtx) & mask;
+    while (table[slot] != kEmpty && !(vertices_out[table[slot]] == vtx)) {
+      slot = (slot + 1) & mask;
+    }
+    if (table[slot] == kEmpty) {
       // first time seeing this one
-      size_t new_idx = vertices_out.size();
+      table[slot] = vertices_out.size();
       vertices_out.push_back(vtx);
-      old_to_new_out[in_idx] = new_idx;
-      vtx_to_new[vtx] = new_idx;
-    } else {
-      old_to_new_out[in_idx] = lookup->second;
     }
+    old_to_new_out[in_idx] = table[slot];
   }
 }
 
@@ -513,8 +534,8 @@ void extract(const Input& in,
   ASSERT(out.vertices.empty());
   std::map<int, tfrag3::StripDraw> draw_by_material;
   int mesh_count = 0;
-  int prim_count = 0;
 
+  std::vector<PrimitiveInNode> prims;
   for (const auto& n : all_nodes) {
     const auto& node = model.nodes[n.node_idx];
     if (node.extras.Has("set_invisible") && node.extras.Get("set_invisible").Get<int>()) {
@@ -528,42 +549,63 @@ void extract(const Input& in,
             model.materials[prim.material].extras.Get("set_invisible").Get<int>()) {
           continue;
         }
-        prim_count++;
-        // extract index buffer
-        std::vector<u32> prim_indices = gltf_index_buffer(model, prim.indices, out.vertices.size());
-        ASSERT_MSG(prim.mode == TINYGLTF_MODE_TRIANGLES, "Unsupported triangle mode");
-        // extract vertices
-        auto verts =
-            gltf_vertices(model, prim.attributes, n.w_T_node, in.get_colors, false, mesh.name);
-        out.vertices.insert(out.vertices.end(), verts.vtx.begin(), verts.vtx.end());
-        if (in.get_colors) {
-          all_vtx_colors.insert(all_vtx_colors.end(), verts.vtx_colors.begin(),
-                                verts.vtx_colors.end());
-          ASSERT(all_vtx_colors.size() == out.vertices.size());
-        }
+        prims.push_back({&n, &mesh, &prim});
+      }
+    }
+  }
 
-        // TODO: just putting it all in one material
-        auto& draw = draw_by_material[prim.material];
-        draw.mode = make_default_draw_mode();                        // todo rm
-        draw.tree_tex_id = texture_pool_debug_checker(in.tex_pool);  // todo rm
-        draw.num_triangles += prim_indices.size() / 3;
-        if (draw.vis_groups.empty()) {
-          auto& grp = draw.vis_groups.emplace_back();
-          grp.num_inds += prim_indices.size();
-          grp.num_tris += draw.num_triangles;
-          grp.vis_idx_in_pc_bvh = UINT16_MAX;
-        } else {
-          auto& grp = draw.vis_groups.back();
-          grp.num_inds += prim_indices.size();
-          grp.num_tris += draw.num_triangles;
-          grp.vis_idx_in_pc_bvh = UINT16_MAX;
-        }
+  // extract the index buffers and vertices of all primitives in parallel. The indices are
+  // relative to the primitive, and are offset when the primitives are merged below.
+  struct ExtractedPrimitive {
+    std::vector<u32> indices;
+    ExtractedVertices verts;
+  };
+  std::vector<ExtractedPrimitive> extracted(prims.size());
+  parallel_for(prims.size(), [&](int i) {
+    const auto& prim = *prims[i].prim;
+    extracted[i].indices = gltf_index_buffer(model, prim.indices, 0);
+    ASSERT_MSG(prim.mode == TINYGLTF_MODE_TRIANGLES, "Unsupported triangle mode");
+    extracted[i].verts = gltf_vertices(model, prim.attributes, prims[i].node->w_T_node,
+                                       in.get_colors, false, prims[i].mesh->name);
+  });
+
+  for (size_t prim_idx = 0; prim_idx < prims.size(); prim_idx++) {
+    const auto& prim = *prims[prim_idx].prim;
+    auto& prim_indices = extracted[prim_idx].indices;
+    auto& verts = extracted[prim_idx].verts;
+    u32 index_offset = out.vertices.size();
+    for (auto& idx : prim_indices) {
+      idx += index_offset;
+    }
+    out.vertices.insert(out.vertices.end(), verts.vtx.begin(), verts.vtx.end());
+    if (in.get_colors) {
+      all_vtx_colors.insert(all_vtx_colors.end(), verts.vtx_colors.begin(),
+                            verts.vtx_colors.end());
+      ASSERT(all_vtx_colors.size() == out.vertices.size());
+    }
 
-        draw.plain_indices.insert(draw.plain_indices.end(), prim_indices.begin(),
-                                  prim_indices.end());
-      }
+    // TODO: just putting it all in one material
+    auto& draw = draw_by_material[prim.material];
+    draw.mode = make_default_draw_mode();                        // todo rm
+    draw.tree_tex_id = texture_pool_debug_checker(in.tex_pool);  // todo rm
+    draw.num_triangles += prim_indices.size() / 3;
+    if (draw.vis_groups.empty()) {
+      auto& grp = draw.vis_groups.emplace_back();
+      grp.num_inds += prim_indices.size();
+      grp.num_tris += draw.num_triangles;
+      grp.vis_idx_in_pc_bvh = UINT16_MAX;
+    } else {
+      auto& grp = draw.vis_groups.back();
+      grp.num_inds += prim_indices.size();
+      grp.num_tris += draw.num_triangles;
+      grp.vis_idx_in_pc_bvh = UINT16_MAX;
     }
+
+    draw.plain_indices.insert(draw.plain_indices.end(), prim_indices.begin(), prim_indices.end());
+    // done with this primitive, free it now.
+    extracted[prim_idx] = {};
   }
+  int prim_count = prims.size();
 
   for (const auto& [mat_idx, d_] : draw_by_material) {
     out.strip_draws.push_back(d_);
@@ -598,7 +640,7 @@ void extract(const Input& in,
 
   if (in.get_colors) {
     Timer quantize_timer;
-    auto quantized = quantize_colors_octree(all_vtx_colors, 1024);
+    auto quantized = quantize_colors_octree(all_vtx_colors, 1024, in.color_kmeans_iterations);
     for (size_t i = 0; i < out.vertices.size(); i++) {
       out.vertices[i].color_index = quantized.vtx_to_color[i];
     }
@@ -728,9 +770,9 @@ void extract(const Input& in,
              const tinygltf::Model& model,
              const std::vector<NodeWithTransform>& all_nodes) {
   int mesh_count = 0;
-  int prim_count = 0;
-  int suspicious_faces = 0;
 
+  std::vector<PrimitiveInNode> prims;
+  std::vector<PatResult> prim_pats;
   for (const auto& n : all_nodes) {
     const auto& node = model.nodes[n.node_idx];
     PatResult mesh_default_collide = custom_props_to_pat(node.extras, node.name);
@@ -752,68 +794,87 @@ void extract(const Input& in,
         if (pat.set && pat.ignore) {
           continue;  // skip, no collide here
         }
-        prim_count++;
-        // extract index buffer
-        std::vector<u32> prim_indices = gltf_index_buffer(model, prim.indices, 0);
-        ASSERT_MSG(prim.mode == TINYGLTF_MODE_TRIANGLES, "Unsupported triangle mode");
-        // extract vertices
-        auto verts = gltf_vertices(model, prim.attributes, n.w_T_node, false, true, mesh.name);
-
-        for (size_t iidx = 0; iidx < prim_indices.size(); iidx += 3) {
-          CollideFace face;
-
-          // get the positions
-          for (int j = 0; j < 3; j++) {
-            auto& vtx = verts.vtx.at(prim_indices.at(iidx + j));
-            face.v[j].x() = vtx.x;
-            face.v[j].y() = vtx.y;
-            face.v[j].z() = vtx.z;
-          }
+        prims.push_back({&n, &mesh, &prim});
+        prim_pats.push_back(pat);
+      }
+    }
+  }
 
-          // now face normal
-          math::Vector3f face_normal =
-              (face.v[2] - face.v[0]).cross(face.v[1] - face.v[0]).normalized();
+  // build the faces of each primitive in parallel, then put them together in the original order.
+  struct PrimitiveFaces {
+    std::vector<CollideFace> faces;
+    int suspicious_faces = 0;
+    int fix_count = 0;
+  };
+  std::vector<PrimitiveFaces> prim_faces(prims.size());
+  parallel_for(prims.size(), [&](int prim_idx) {
+    const auto& prim = *prims[prim_idx].prim;
+    const auto& pat = prim_pats[prim_idx];
+    auto& result = prim_faces[prim_idx];
+    // extract index buffer
+    std::vector<u32> prim_indices = gltf_index_buffer(model, prim.indices, 0);
+    ASSERT_MSG(prim.mode == TINYGLTF_MODE_TRIANGLES, "Unsupported triangle mode");
+    // extract vertices
+    auto verts = gltf_vertices(model, prim.attributes, prims[prim_idx].node->w_T_node, false, true,
+                               prims[prim_idx].mesh->name);
+
+    for (size_t iidx = 0; iidx < prim_indices.size(); iidx += 3) {
+      CollideFace face;
+
+      // get the positions
+      for (int j = 0; j < 3; j++) {
+        auto& vtx = verts.vtx.at(prim_indices.at(iidx + j));
+        face.v[j].x() = vtx.x;
+        face.v[j].y() = vtx.y;
+        face.v[j].z() = vtx.z;
+      }
 
-          float dots[3];
-          for (int j = 0; j < 3; j++) {
-            dots[j] = face_normal.dot(verts.normals.at(prim_indices.at(iidx + j)).normalized());
-          }
+      // now face normal
+      math::Vector3f face_normal =
+          (face.v[2] - face.v[0]).cross(face.v[1] - face.v[0]).normalized();
 
-          if (dots[0] > 1e-3 && dots[1] > 1e-3 && dots[2] > 1e-3) {
-            suspicious_faces++;
-            auto temp = face.v[2];
-            face.v[2] = face.v[1];
-            face.v[1] = temp;
-          }
+      float dots[3];
+      for (int j = 0; j < 3; j++) {
+        dots[j] = face_normal.dot(verts.normals.at(prim_indices.at(iidx + j)).normalized());
+      }
 
-          face.bsphere = math::bsphere_of_triangle(face.v);
-          face.bsphere.w() += 1e-1 * 5;
-          for (int j = 0; j < 3; j++) {
-            float output_dist = face.bsphere.w() - (face.bsphere.xyz() - face.v[j]).length();
-            if (output_dist < 0) {
-              lg::print("{}\n", output_dist);
-              lg::print("BAD:\n{}\n{}\n{}\n", face.v[0].to_string_aligned(),
-                        face.v[1].to_string_aligned(), face.v[2].to_string_aligned());
-              lg::print("bsphere: {}\n", face.bsphere.to_string_aligned());
-            }
-          }
-          face.pat = pat.pat;
-          out.faces.push_back(face);
+      if (dots[0] > 1e-3 && dots[1] > 1e-3 && dots[2] > 1e-3) {
+        result.suspicious_faces++;
+        auto temp = face.v[2];
+        face.v[2] = face.v[1];
+        face.v[1] = temp;
+      }
+
+      face.bsphere = math::bsphere_of_triangle(face.v);
+      face.bsphere.w() += 1e-1 * 5;
+      for (int j = 0; j < 3; j++) {
+        float output_dist = face.bsphere.w() - (face.bsphere.xyz() - face.v[j]).length();
+        if (output_dist < 0) {
+          lg::print("{}\n", output_dist);
+          lg::print("BAD:\n{}\n{}\n{}\n", face.v[0].to_string_aligned(),
+                    face.v[1].to_string_aligned(), face.v[2].to_string_aligned());
+          lg::print("bsphere: {}\n", face.bsphere.to_string_aligned());
         }
       }
+      face.pat = pat.pat;
+
+      auto try_fix = subdivide_face_if_needed(face);
+      if (try_fix) {
+        result.fix_count++;
+        result.faces.insert(result.faces.end(), try_fix->begin(), try_fix->end());
+      } else {
+        result.faces.push_back(face);
+      }
     }
-  }
+  });
 
   std::vector<CollideFace> fixed_faces;
+  int suspicious_faces = 0;
   int fix_count = 0;
-  for (auto& face : out.faces) {
-    auto try_fix = subdivide_face_if_needed(face);
-    if (try_fix) {
-      fix_count++;
-      fixed_faces.insert(fixed_faces.end(), try_fix->begin(), try_fix->end());
-    } else {
-      fixed_faces.push_back(face);
-    }
+  for (auto& result : prim_faces) {
+    fixed_faces.insert(fixed_faces.end(), result.faces.begin(), result.faces.end());
+    suspicious_faces += result.suspicious_faces;
+    fix_count += result.fix_count;
   }
 
   if (in.double_sided_collide) {
@@ -859,8 +920,11 @@ void extract(const Input& in, Output& out) {
   ASSERT_MSG(err.empty(), err.c_str());
   ASSERT_MSG(res, "Failed to load GLTF file!");
   auto all_nodes = flatten_nodes_from_all_scenes(model);
+  // the collision mesh doesn't depend on the tfrag mesh, so extract both at once.
+  auto collide = std::async(std::launch::async,
+                            [&] { extract(in, out.collide, model, all_nodes); });
   extract(in, out.tfrag, model, all_nodes);
-  extract(in, out.collide, model, all_nodes);
+  collide.get();
   lg::info("GLTF total took {:.2f} ms", read_timer.getMs());
 }
 }  // namespace gltf_mesh_extract
@@ -16,6 +16,7 @@ struct Input {
   bool auto_wall_enable = true;
   float auto_wall_angle = 30.f;
   bool double_sided_collide = false;
+  int color_kmeans_iterations = 0;  // refine the vertex color palette, 0 to skip
 };
 
 struct TfragOutput {
@@ -0,0 +1,149 @@
+#include "CompileProfiler.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "common/global_profiler/GlobalProfiler.h"
+#include "common/util/FileUtil.h"
+
+#include "third-party/fmt/core.h"
+
+namespace {
+const char* phase_name(CompileProfiler::Phase phase) {
+  switch (phase) {
+    case CompileProfiler::Phase::READ:
+      return "read";
+    case CompileProfiler::Phase::COMPILE:
+      return "compile";
+    case CompileProfiler::Phase::MACRO_EXPAND:
+      return "macro-expand";
+    case CompileProfiler::Phase::REGALLOC:
+      return "regalloc";
+    case CompileProfiler::Phase::CODEGEN:
+      return "codegen";
+    default:
+      return "invalid";
+  }
+}
+
+// enough for the phases and top-level forms of a full game build.
+constexpr size_t TRACE_EVENTS = 1 << 18;
+}  // namespace
+
+void CompileProfiler::start() {
+  *this = CompileProfiler();
+  m_enabled = true;
+  auto& p = prof();
+  p.set_enable(false);
+  p.set_max_events(TRACE_EVENTS);
+  p.clear();
+  p.set_enable(true);
+  p.root_event();
+}
+
+void CompileProfiler::stop(const std::string& json_path, const std::string& report_path) {
+  m_enabled = false;
+  auto& p = prof();
+  p.root_event();
+  p.set_enable(false);
+  file_util::create_dir_if_needed_for_file(json_path);
+  p.dump_to_json(json_path);
+  file_util::create_dir_if_needed_for_file(report_path);
+  file_util::write_text_file(report_path, report(SIZE_MAX));
+}
+
+CompileProfiler::Scope::Scope(CompileProfiler* profiler, Phase phase, const std::string& file) {
+  if (profiler->enabled()) {
+    m_profiler = profiler;
+    m_phase = phase;
+    prof().begin_event(fmt::format("{} {}", phase_name(phase), file).c_str());
+  }
+}
+
+CompileProfiler::Scope::Scope(CompileProfiler* profiler,
+                              const std::string& file,
+                              const std::string& form) {
+  if (profiler->enabled()) {
+    m_profiler = profiler;
+    m_name = fmt::format("{}: {}", file, form);
+    prof().begin_event(m_name.c_str());
+  }
+}
+
+CompileProfiler::Scope::~Scope() {
+  if (!m_profiler) {
+    return;
+  }
+  prof().end_event();
+  double ms = m_timer.getMs();
+  if (m_phase == Phase::MAX) {
+    m_profiler->m_forms.emplace_back(ms, std::move(m_name));
+  } else {
+    m_profiler->m_phase_ms[(int)m_phase] += ms;
+  }
+}
+
+CompileProfiler::MacroScope::MacroScope(CompileProfiler* profiler, const std::string& name) {
+  if (profiler->enabled()) {
+    m_profiler = profiler;
+    m_profiler->m_macro_stack.push_back({name});
+  }
+}
+
+void CompileProfiler::MacroScope::done_expanding() {
+  if (m_profiler && !m_profiler->m_macro_stack.empty()) {
+    double ms = m_timer.getMs();
+    m_profiler->m_macro_stack.back().expand_ms = ms;
+    m_profiler->m_phase_ms[(int)Phase::MACRO_EXPAND] += ms;
+  }
+}
+
+CompileProfiler::MacroScope::~MacroScope() {
+  // the stack is empty if the profiler was restarted inside of this macro.
+  if (!m_profiler || m_profiler->m_macro_stack.empty()) {
+    return;
+  }
+  double ms = m_timer.getMs();
+  auto& stack = m_profiler->m_macro_stack;
+  auto& stats = m_profiler->m_macros[stack.back().name];
+  stats.count++;
+  stats.expand_ms += stack.back().expand_ms;
+  stats.self_ms += ms - stack.back().nested_ms;
+  stack.pop_back();
+  if (!stack.empty()) {
+    stack.back().nested_ms += ms;
+  }
+}
+
+/*!
+ * The phase totals, then the slowest top-level forms and macros. Compile time includes the macro
+ * expansion. A macro's time is expanding it and compiling what it expanded to, without the time
+ * for the macros inside of that.
+ */
+std::string CompileProfiler::report(size_t max_lines) const {
+  std::string result = fmt::format("{:12} {:>10}\n", "phase", "ms");
+  for (int i = 0; i < (int)Phase::MAX; i++) {
+    result += fmt::format("{:12} {:10.1f}\n", phase_name((Phase)i), m_phase_ms[i]);
+  }
+
+  auto forms = m_forms;
+  std::sort(forms.begin(), forms.end(), std::greater<>());
+  result += fmt::format("\nTop-level forms ({}):\n{:>10}  form\n", forms.size(), "ms");
+  for (size_t i = 0; i < std::min(max_lines, forms.size()); i++) {
+    result += fmt::format("{:10.3f}  {}\n", forms[i].first, forms[i].second);
+  }
+
+  std::vector<std::pair<double, std::string>> macros;
+  for (const auto& [name, stats] : m_macros) {
+    macros.emplace_back(stats.self_ms, name);
+  }
+  std::sort(macros.begin(), macros.end(), std::greater<>());
+  result += fmt::format("\nMacros ({}):\n{:>10}  {:>10}  {:>8}  macro\n", macros.size(), "ms",
+                        "expand ms", "uses");
+  for (size_t i = 0; i < std::min(max_lines, macros.size()); i++) {
+    const auto& stats = m_macros.at(macros[i].second);
+    result += fmt::format("{:10.3f}  {:10.3f}  {:8}  {}\n", stats.self_ms, stats.expand_ms,
+                          stats.count, macros[i].second);
+  }
+  return result;
+}
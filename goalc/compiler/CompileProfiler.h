@@ -0,0 +1,80 @@
+#pragma once
+
+/*!
+ * @file CompileProfiler.h
+ * Records where compile time goes, per phase, per top-level form, and per macro. Started and
+ * stopped with (start-compile-profile) and (stop-compile-profile), which writes a Chrome trace
+ * (with the GlobalProfiler) and a text report sorted by time.
+ */
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/util/Timer.h"
+
+class CompileProfiler {
+ public:
+  enum class Phase { READ, COMPILE, MACRO_EXPAND, REGALLOC, CODEGEN, MAX };
+
+  bool enabled() const { return m_enabled; }
+  void start();
+  void stop(const std::string& json_path, const std::string& report_path);
+
+  /*!
+   * Times a phase of a file, or a top-level form, while it's in scope, and adds it to the trace.
+   * Does nothing if the profiler isn't running.
+   */
+  class Scope {
+   public:
+    Scope(CompileProfiler* profiler, Phase phase, const std::string& file);
+    Scope(CompileProfiler* profiler, const std::string& file, const std::string& form);
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+    ~Scope();
+
+   private:
+    CompileProfiler* m_profiler = nullptr;
+    Phase m_phase = Phase::MAX;
+    std::string m_name;
+    Timer m_timer;
+  };
+
+  /*!
+   * Times a macro use while it's in scope: expanding it and compiling the result, without the
+   * macros used inside of it.
+   */
+  class MacroScope {
+   public:
+    MacroScope(CompileProfiler* profiler, const std::string& name);
+    MacroScope(const MacroScope&) = delete;
+    MacroScope& operator=(const MacroScope&) = delete;
+    ~MacroScope();
+    void done_expanding();
+
+   private:
+    CompileProfiler* m_profiler = nullptr;
+    Timer m_timer;
+  };
+
+  std::string report(size_t max_lines) const;
+
+ private:
+  struct MacroStats {
+    int count = 0;
+    double expand_ms = 0;
+    double self_ms = 0;
+  };
+
+  struct OpenMacro {
+    std::string name;
+    double expand_ms = 0;
+    double nested_ms = 0;
+  };
+
+  bool m_enabled = false;
+  double m_phase_ms[(int)Phase::MAX] = {};
+  std::vector<std::pair<double, std::string>> m_forms;  // time, file and form
+  std::unordered_map<std::string, MacroStats> m_macros;
+  std::vector<OpenMacro> m_macro_stack;
+};
@@ -1,5 +1,6 @@
 #include "Compiler.h"
 
+#include <algorithm>
 #include <chrono>
 #include <thread>
 
@@ -9,6 +10,7 @@
 #include "common/goos/PrettyPrinter.h"
 #include "common/link_types.h"
 #include "common/util/FileUtil.h"
+#include "common/util/SimpleThreadGroup.h"
 
 #include "goalc/make/Tools.h"
 #include "goalc/regalloc/Allocator.h"
@@ -239,8 +241,11 @@ Val* Compiler::compile_error_guard(const goos::Object& code, Env* env) {
 
 void Compiler::color_object_file(FileEnv* env) {
   int num_spills_in_file = 0;
-  for (auto& f : env->functions()) {
-    AllocationInput input;
+  const auto& functions = env->functions();
+  std::vector<AllocationInput> inputs(functions.size());
+  for (size_t fi = 0; fi < functions.size(); fi++) {
+    auto& f = functions[fi];
+    auto& input = inputs[fi];
     input.is_asm_function = f->is_asm_func;
     for (auto& i : f->code()) {
       input.instructions.push_back(i->to_rai());
@@ -257,6 +262,7 @@ void Compiler::color_object_file(FileEnv* env) {
     input.constraints = f->constraints();
     input.stack_slots_for_stack_vars = f->stack_slots_used_for_stack_vars();
     input.function_name = f->name();
+    input.force_linear_scan = m_settings.regalloc_linear_scan;
 
     if (m_settings.debug_print_regalloc) {
       input.debug_settings.print_input = true;
@@ -264,10 +270,55 @@ void Compiler::color_object_file(FileEnv* env) {
       input.debug_settings.print_analysis = true;
       input.debug_settings.allocate_log_level = 2;
     }
+  }
+
+  // each function is allocated on its own, so they can be done in parallel. The results are used in
+  // order below, so the output doesn't depend on the threads.
+  std::vector<AllocationResult> results(functions.size());
+  if (m_settings.debug_print_regalloc || functions.size() < 8) {
+    for (size_t fi = 0; fi < functions.size(); fi++) {
+      results[fi] = allocate_registers_v2(inputs[fi]);
+    }
+  } else {
+    std::vector<std::exception_ptr> errors(functions.size());
+    SimpleThreadGroup threads;
+    threads.run(
+        [&](int fi) {
+          try {
+            results[fi] = allocate_registers_v2(inputs[fi]);
+          } catch (...) {
+            errors[fi] = std::current_exception();
+          }
+        },
+        functions.size());
+    threads.join();
+    for (auto& e : errors) {
+      if (e) {
+        std::rethrow_exception(e);
+      }
+    }
+  }
 
+  for (size_t fi = 0; fi < functions.size(); fi++) {
+    auto& f = functions[fi];
+    auto& input = inputs[fi];
+    auto& regalloc_result_2 = results[fi];
     m_debug_stats.total_funcs++;
 
-    auto regalloc_result_2 = allocate_registers_v2(input);
+    double regalloc_ms = regalloc_result_2.analysis_time_ms + regalloc_result_2.assign_time_ms;
+    m_debug_stats.regalloc_time_ms += regalloc_ms;
+    if (regalloc_result_2.used_linear_scan) {
+      m_debug_stats.funcs_linear_scan++;
+    }
+    auto& slowest = m_debug_stats.slowest_regalloc_funcs;
+    constexpr size_t MAX_SLOWEST_FUNCS = 10;
+    if (slowest.size() < MAX_SLOWEST_FUNCS || regalloc_ms > slowest.back().first) {
+      slowest.emplace_back(regalloc_ms, f->name());
+      std::sort(slowest.begin(), slowest.end(), std::greater<>());
+      if (slowest.size() > MAX_SLOWEST_FUNCS) {
+        slowest.pop_back();
+      }
+    }
 
     if (regalloc_result_2.ok) {
       if (regalloc_result_2.num_spilled_vars > 0) {
@@ -306,6 +357,8 @@ std::vector<u8> Compiler::codegen_object_file(FileEnv* env) {
     }
     auto stats = gen.get_obj_stats();
     m_debug_stats.num_moves_eliminated += stats.moves_eliminated;
+    m_debug_stats.num_jumps_eliminated += stats.jumps_eliminated;
+    m_debug_stats.num_jumps_threaded += stats.jumps_threaded;
     env->cleanup_after_codegen();
     return result;
   } catch (std::exception& e) {
@@ -449,8 +502,6 @@ void Compiler::asm_file(const CompilationOptions& options) {
     file_path = candidate_paths.at(0).string();
   }
 
-  auto code = m_goos.reader.read_from_file({file_path});
-
   std::string obj_file_name = file_path;
 
   // Extract object name from file name.
@@ -462,14 +513,31 @@ void Compiler::asm_file(const CompilationOptions& options) {
   }
   obj_file_name = obj_file_name.substr(0, obj_file_name.find_last_of('.'));
 
+  goos::Object code;
+  {
+    CompileProfiler::Scope scope(&m_compile_profiler, CompileProfiler::Phase::READ, obj_file_name);
+    code = m_goos.reader.read_from_file({file_path});
+  }
+
   // COMPILE
-  auto obj_file = compile_object_file(obj_file_name, code, !options.no_code);
+  FileEnv* obj_file = nullptr;
+  {
+    CompileProfiler::Scope scope(&m_compile_profiler, CompileProfiler::Phase::COMPILE,
+                                 obj_file_name);
+    obj_file = compile_object_file(obj_file_name, code, !options.no_code);
+  }
 
   if (options.color) {
     // register allocation
-    color_object_file(obj_file);
+    {
+      CompileProfiler::Scope scope(&m_compile_profiler, CompileProfiler::Phase::REGALLOC,
+                                   obj_file_name);
+      color_object_file(obj_file);
+    }
 
     // code/object file generation
+    CompileProfiler::Scope codegen_scope(&m_compile_profiler, CompileProfiler::Phase::CODEGEN,
+                                         obj_file_name);
     std::vector<u8> data;
     std::string disasm;
     if (options.disassemble) {
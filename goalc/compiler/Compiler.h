@@ -8,6 +8,7 @@
 #include "common/repl/util.h"
 #include "common/type_system/TypeSystem.h"
 
+#include "goalc/compiler/CompileProfiler.h"
 #include "goalc/compiler/CompilerException.h"
 #include "goalc/compiler/CompilerSettings.h"
 #include "goalc/compiler/Env.h"
@@ -97,6 +98,7 @@ class Compiler {
   MakeSystem& make_system() { return m_make; }
   std::set<std::string> lookup_symbol_infos_starting_with(const std::string& prefix) const;
   std::vector<SymbolInfo>* lookup_exact_name_info(const std::string& name) const;
+  const SymbolInfoMap& symbol_info_map() const { return m_symbol_info; }
   std::optional<TypeSpec> lookup_typespec(const std::string& symbol_name) const;
 
  private:
@@ -124,9 +126,17 @@ class Compiler {
     int num_spills = 0;
     int num_spills_v1 = 0;
     int num_moves_eliminated = 0;
+    int num_jumps_eliminated = 0;
+    int num_jumps_threaded = 0;
     int total_funcs = 0;
     int funcs_requiring_v1_allocator = 0;
+    int funcs_linear_scan = 0;
+    // summed over the functions, so it's more than the wall time when they run in parallel.
+    double regalloc_time_ms = 0;
+    std::vector<std::pair<double, std::string>> slowest_regalloc_funcs;  // time, name
+    std::unordered_map<std::string, int> auto_inlined_calls;            // function, calls
   } m_debug_stats;
+  CompileProfiler m_compile_profiler;
 
   void setup_goos_forms();
   bool get_true_or_false(const goos::Object& form, const goos::Object& boolean);
@@ -620,6 +630,8 @@ class Compiler {
                                           const goos::Object& rest,
                                           Env* env);
   Val* compile_gen_docs(const goos::Object& form, const goos::Object& rest, Env* env);
+  Val* compile_start_compile_profile(const goos::Object& form, const goos::Object& rest, Env* env);
+  Val* compile_stop_compile_profile(const goos::Object& form, const goos::Object& rest, Env* env);
 
   // ControlFlow
   Condition compile_condition(const goos::Object& condition, Env* env, bool invert);
@@ -647,6 +659,7 @@ class Compiler {
   Val* compile_bp(const goos::Object& form, const goos::Object& rest, Env* env);
   Val* compile_ubp(const goos::Object& form, const goos::Object& rest, Env* env);
   Val* compile_d_sym_name(const goos::Object& form, const goos::Object& rest, Env* env);
+  Val* compile_prof(const goos::Object& form, const goos::Object& rest, Env* env);
   u32 parse_address_spec(const goos::Object& form);
 
   // Macro
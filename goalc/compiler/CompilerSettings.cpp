@@ -7,8 +7,18 @@ CompilerSettings::CompilerSettings() {
   m_settings["print-regalloc"].kind = SettingKind::BOOL;
   m_settings["print-regalloc"].boolp = &debug_print_regalloc;
 
+  // allocate registers with linear scan for all functions, not just huge ones. Faster, but the code
+  // is worse, so this is only for debugging.
+  m_settings["regalloc-linear-scan"].kind = SettingKind::BOOL;
+  m_settings["regalloc-linear-scan"].boolp = &regalloc_linear_scan;
+
   m_settings["disable-math-const-prop"].kind = SettingKind::BOOL;
   m_settings["disable-math-const-prop"].boolp = &disable_math_const_prop;
+
+  // inline calls to small leaf functions defined after this is set, even without a
+  // (declare (inline)). If the function's symbol is set! at runtime, inlined calls won't see it.
+  m_settings["auto-inline"].kind = SettingKind::BOOL;
+  m_settings["auto-inline"].boolp = &auto_inline;
 }
 
 void CompilerSettings::set(const std::string& name, const goos::Object& value) {
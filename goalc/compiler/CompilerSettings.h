@@ -10,8 +10,10 @@ class CompilerSettings {
   CompilerSettings();
   bool debug_print_ir = false;
   bool debug_print_regalloc = false;
+  bool regalloc_linear_scan = false;
   bool disable_math_const_prop = false;
   bool emit_move_after_return = true;
+  bool auto_inline = false;
 
   void set(const std::string& name, const goos::Object& value);
 
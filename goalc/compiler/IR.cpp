@@ -377,7 +377,11 @@ RegAllocInstr IR_GotoLabel::to_rai() {
 void IR_GotoLabel::do_codegen(emitter::ObjectGenerator* gen,
                               const AllocationResult& allocs,
                               emitter::IR_Record irec) {
-  (void)allocs;
+  // a goto the next IR is a jump of 0, so skip it. Nested forms end up with a lot of these.
+  if (m_dest->idx == irec.ir_id + 1 && allocs.stack_ops.at(irec.ir_id).ops.empty()) {
+    gen->count_eliminated_jump();
+    return;
+  }
   auto instr = gen->add_instr(IGen::jmp_32(), irec);
   gen->link_instruction_jump(instr, gen->get_future_ir_record_in_same_func(irec, m_dest->idx));
 }
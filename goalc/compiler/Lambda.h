@@ -20,4 +20,5 @@ struct InlineableFunction {
   Lambda lambda;
   TypeSpec type;
   bool inline_by_default = false;
+  bool auto_inline = false;  // not declared inline, but small enough for the auto-inline setting
 };
@@ -1232,11 +1232,11 @@ Val* Compiler::compile_asm_div_vf(const goos::Object& form, const goos::Object&
   // Save one temp reg, use the destination as one
   auto temp_reg = env->make_vfr(dest->type());
 
+  // Splat src2's value into the the temp reg. This is done first, in case dest is src2.
+  env->emit_ir<IR_SplatVF>(form, color, temp_reg, src2, ftf_fsf_to_vector_element(ftf));
   // Splat src1's value into the dest reg, keep it simple, this way no matter which vector component
   // is accessed from the final result will be the correct answer
   env->emit_ir<IR_SplatVF>(form, color, dest, src1, ftf_fsf_to_vector_element(fsf));
-  // Splat src1's value into the the temp reg
-  env->emit_ir<IR_SplatVF>(form, color, temp_reg, src2, ftf_fsf_to_vector_element(ftf));
 
   // Perform the Division
   env->emit_ir<IR_VFMath3Asm>(form, color, dest, dest, temp_reg, IR_VFMath3Asm::Kind::DIV);
@@ -1312,11 +1312,11 @@ Val* Compiler::compile_asm_inv_sqrt_vf(const goos::Object& form,
   // Save one temp reg, use the destination as one
   auto temp_reg = env->make_vfr(dest->type());
 
+  // Splat src2's value into the the temp reg. This is done first, in case dest is src2.
+  env->emit_ir<IR_SplatVF>(form, color, temp_reg, src2, ftf_fsf_to_vector_element(ftf));
   // Splat src1's value into the dest reg, keep it simple, this way no matter which vector component
   // is accessed from the final result will be the correct answer
   env->emit_ir<IR_SplatVF>(form, color, dest, src1, ftf_fsf_to_vector_element(fsf));
-  // Splat src1's value into the the temp reg
-  env->emit_ir<IR_SplatVF>(form, color, temp_reg, src2, ftf_fsf_to_vector_element(ftf));
   // Square Root the temp reg
   env->emit_ir<IR_SqrtVF>(form, color, temp_reg, temp_reg);
 
@@ -1348,43 +1348,34 @@ Val* Compiler::compile_asm_outer_product_vf(const goos::Object& form,
   // z = (V1x * V2y) - (V2x * V1y) => (1 * 6) - (5 * 2) => -4
   // w = N/A, left alone                                => 999
   //
-  // There is probably a more optimized alg for this, but we can just do this in two stages
-  // First swizzle the first two vectors accordingly, and store in `dest`
-  // Then follow up with the second half.
-  //
-  // Some temporary regs are required AND its important to not modify dest's `w` or the source
-  // registers at all
+  // This is done in two stages: the first products go in `temp1` and the second in `temp2`. The
+  // `w` of the temps is junk, and only the final blend touches `dest`, so it's important to keep
+  // that blend, but not to blend anything before it. The sources are not modified.
 
-  // Init two temp registers
+  // Init the temp registers
   auto temp1 = env->make_vfr(dest->type());
   auto temp2 = env->make_vfr(dest->type());
-  auto temp_dst = env->make_vfr(dest->type());
+  auto temp3 = env->make_vfr(dest->type());
 
   // First Portion
-  // - Swizzle src1 appropriately
+  // - Swizzle src1 and src2 appropriately
   env->emit_ir<IR_SwizzleVF>(form, color, temp1, src1, 0b00001001);
-  // - Move it into 'dest' safely (avoid mutating `w`)
-  env->emit_ir<IR_BlendVF>(form, color, temp_dst, temp_dst, temp1, 0b0111);
-  // - Swizzle src2 appropriately
-  env->emit_ir<IR_SwizzleVF>(form, color, temp1, src2, 0b00010010);
-  // - Multiply - Result in `dest`
-  env->emit_ir<IR_VFMath3Asm>(form, color, temp1, temp_dst, temp1, IR_VFMath3Asm::Kind::MUL);
-  // - Move it into 'dest' safely (avoid mutating `w`)
-  env->emit_ir<IR_BlendVF>(form, color, temp_dst, temp_dst, temp1, 0b0111);
-
-  // Second Portion
-  // - Swizzle src2 appropriately
-  env->emit_ir<IR_SwizzleVF>(form, color, temp1, src2, 0b00001001);
-  // - Swizzle src1 appropriately
-  env->emit_ir<IR_SwizzleVF>(form, color, temp2, src1, 0b00010010);
+  env->emit_ir<IR_SwizzleVF>(form, color, temp2, src2, 0b00010010);
   // - Multiply - Result in `temp1`
   env->emit_ir<IR_VFMath3Asm>(form, color, temp1, temp1, temp2, IR_VFMath3Asm::Kind::MUL);
 
+  // Second Portion
+  // - Swizzle src2 and src1 appropriately
+  env->emit_ir<IR_SwizzleVF>(form, color, temp2, src2, 0b00001001);
+  env->emit_ir<IR_SwizzleVF>(form, color, temp3, src1, 0b00010010);
+  // - Multiply - Result in `temp2`
+  env->emit_ir<IR_VFMath3Asm>(form, color, temp2, temp2, temp3, IR_VFMath3Asm::Kind::MUL);
+
   // Finalize
   // - Subtract
-  env->emit_ir<IR_VFMath3Asm>(form, color, temp2, temp_dst, temp1, IR_VFMath3Asm::Kind::SUB);
+  env->emit_ir<IR_VFMath3Asm>(form, color, temp1, temp1, temp2, IR_VFMath3Asm::Kind::SUB);
   // - Blend result, as to avoid not modifying dest's `w` component
-  env->emit_ir<IR_BlendVF>(form, color, dest, dest, temp2, 0b0111);
+  env->emit_ir<IR_BlendVF>(form, color, dest, dest, temp1, 0b0111);
   return get_none();
 }
 
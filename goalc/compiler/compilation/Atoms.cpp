@@ -159,6 +159,8 @@ const std::unordered_map<
         {"load-project", {"", &Compiler::compile_load_project}},
         {"make", {"", &Compiler::compile_make}},
         {"print-debug-compiler-stats", {"", &Compiler::compile_print_debug_compiler_stats}},
+        {"start-compile-profile", {"", &Compiler::compile_start_compile_profile}},
+        {"stop-compile-profile", {"", &Compiler::compile_stop_compile_profile}},
         {"gen-docs", {"", &Compiler::compile_gen_docs}},
         {"gc-text", {"", &Compiler::compile_gc_text}},
 
@@ -192,6 +194,7 @@ const std::unordered_map<
         {":bp", {"", &Compiler::compile_bp}},
         {":ubp", {"", &Compiler::compile_ubp}},
         {":sym-name", {"", &Compiler::compile_d_sym_name}},
+        {":prof", {"", &Compiler::compile_prof}},
 
         // TYPE
         {"deftype", {"", &Compiler::compile_deftype}},
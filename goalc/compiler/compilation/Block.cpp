@@ -9,10 +9,29 @@
 using namespace goos;
 
 /*!
- * Compile "top-level" form, which is equivalent to a begin.
+ * Compile "top-level" form, which is equivalent to a begin. Each form is timed separately by the
+ * compile profiler.
  */
 Val* Compiler::compile_top_level(const goos::Object& form, const goos::Object& rest, Env* env) {
-  return compile_begin(form, rest, env);
+  if (!m_compile_profiler.enabled()) {
+    return compile_begin(form, rest, env);
+  }
+
+  const auto& file_name = env->file_env()->name();
+  Val* result = get_none();
+  for_each_in_list(rest, [&](const Object& o) {
+    // the head and name, like "defun vector-dot", are enough to find the form.
+    std::string label = o.is_pair() ? o.as_pair()->car.print() : o.print();
+    if (o.is_pair() && o.as_pair()->cdr.is_pair() && o.as_pair()->cdr.as_pair()->car.is_symbol()) {
+      label += " " + o.as_pair()->cdr.as_pair()->car.print();
+    }
+    CompileProfiler::Scope scope(&m_compile_profiler, file_name, label);
+    result = compile_error_guard(o, env);
+    if (!dynamic_cast<None*>(result)) {
+      result = result->to_reg(o, env);
+    }
+  });
+  return result;
 }
 
 /*!
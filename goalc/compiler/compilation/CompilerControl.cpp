@@ -3,6 +3,7 @@
  * Compiler implementation for forms which actually control the compiler.
  */
 
+#include <algorithm>
 #include <regex>
 #include <stack>
 
@@ -653,13 +654,69 @@ Val* Compiler::compile_print_debug_compiler_stats(const goos::Object& form,
   lg::print("Spill operations (total): {}\n", m_debug_stats.num_spills);
   lg::print("Spill operations (v1 only): {}\n", m_debug_stats.num_spills_v1);
   lg::print("Eliminated moves: {}\n", m_debug_stats.num_moves_eliminated);
+  lg::print("Eliminated jumps: {}\n", m_debug_stats.num_jumps_eliminated);
+  lg::print("Threaded jumps: {}\n", m_debug_stats.num_jumps_threaded);
   lg::print("Total functions: {}\n", m_debug_stats.total_funcs);
   lg::print("Functions requiring v1: {}\n", m_debug_stats.funcs_requiring_v1_allocator);
+  lg::print("Functions using linear scan: {}\n", m_debug_stats.funcs_linear_scan);
+  lg::print("Register allocation time: {:.1f} ms, slowest functions:\n",
+            m_debug_stats.regalloc_time_ms);
+  for (const auto& [ms, name] : m_debug_stats.slowest_regalloc_funcs) {
+    lg::print("  {:8.2f} ms  {}\n", ms, name);
+  }
+  std::vector<std::pair<int, std::string>> inlined;
+  int inlined_calls = 0;
+  for (const auto& [name, count] : m_debug_stats.auto_inlined_calls) {
+    inlined.emplace_back(count, name);
+    inlined_calls += count;
+  }
+  std::sort(inlined.begin(), inlined.end(), std::greater<>());
+  lg::print("Auto-inlined calls: {} to {} functions\n", inlined_calls, inlined.size());
+  for (const auto& [count, name] : inlined) {
+    lg::print("  {:8}  {}\n", count, name);
+  }
   lg::print("Size of autocomplete prefix tree: {}\n", m_symbol_info.symbol_count());
 
   return get_none();
 }
 
+/*!
+ * Start timing each phase of compiling files, each top-level form, and each macro.
+ */
+Val* Compiler::compile_start_compile_profile(const goos::Object& form,
+                                             const goos::Object& rest,
+                                             Env*) {
+  auto args = get_va(form, rest);
+  va_check(form, args, {}, {});
+  m_compile_profiler.start();
+  return get_none();
+}
+
+/*!
+ * Stop the compile profiler and write the results. Takes an optional name for the output files,
+ * which defaults to log/compile_profile. The .json is a Chrome trace, and the .txt has the slowest
+ * forms and macros, which are also printed.
+ */
+Val* Compiler::compile_stop_compile_profile(const goos::Object& form,
+                                            const goos::Object& rest,
+                                            Env*) {
+  auto args = get_va(form, rest);
+  if (args.unnamed.empty()) {
+    va_check(form, args, {}, {});
+  } else {
+    va_check(form, args, {goos::ObjectType::STRING}, {});
+  }
+  if (!m_compile_profiler.enabled()) {
+    throw_compiler_error(form, "The compile profiler was not started.");
+  }
+  std::string name = args.unnamed.empty() ? file_util::get_file_path({"log", "compile_profile"})
+                                          : as_string(args.unnamed.at(0));
+  m_compile_profiler.stop(name + ".json", name + ".txt");
+  lg::print("{}", m_compile_profiler.report(20));
+  lg::print("Wrote {}.json and {}.txt\n", name, name);
+  return get_none();
+}
+
 Val* Compiler::compile_gen_docs(const goos::Object& form, const goos::Object& rest, Env*) {
   auto args = get_va(form, rest);
   va_check(form, args, {goos::ObjectType::STRING}, {});
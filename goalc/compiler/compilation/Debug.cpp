@@ -1,5 +1,8 @@
+#include <algorithm>
+
 #include "common/log/log.h"
 #include "common/util/FileUtil.h"
+#include "common/util/string_util.h"
 
 #include "goalc/compiler/Compiler.h"
 #include "goalc/debugger/disassemble.h"
@@ -439,3 +442,71 @@ Val* Compiler::compile_d_sym_name(const goos::Object& form, const goos::Object&
 
   return get_none();
 }
+
+/*!
+ * Sample the call stacks of the running target for some number of seconds:
+ *   (:prof 10 :hz 500 :file "out.folded")
+ * and save them in the folded format used by flamegraph.pl and speedscope. Prints the functions
+ * with the most samples.
+ */
+Val* Compiler::compile_prof(const goos::Object& form, const goos::Object& rest, Env* env) {
+  (void)env;
+  auto args = get_va(form, rest);
+  va_check(form, args, {{}},
+           {{"hz", {false, {goos::ObjectType::INTEGER}}},
+            {"file", {false, {goos::ObjectType::STRING}}}});
+
+  const auto& seconds_arg = args.unnamed.at(0);
+  double seconds = 0;
+  if (seconds_arg.is_int()) {
+    seconds = seconds_arg.as_int();
+  } else if (seconds_arg.is_float()) {
+    seconds = seconds_arg.as_float();
+  } else {
+    throw_compiler_error(form, ":prof must be given a number of seconds.");
+  }
+
+  int hz = 250;
+  if (args.has_named("hz")) {
+    hz = args.get_named("hz").as_int();
+    if (hz <= 0 || hz > 10000) {
+      throw_compiler_error(form, ":prof sample rate must be between 1 and 10000 hz.");
+    }
+  }
+
+  if (!m_debugger.is_running()) {
+    throw_compiler_error(
+        form, "Cannot profile, the debugger must be connected and the target must be running.");
+  }
+
+  fs::path out_path;
+  if (args.has_named("file")) {
+    out_path = args.get_named("file").as_string()->data;
+  } else {
+    out_path = file_util::get_jak_project_dir() / "profile_data" /
+               fmt::format("goal-{}.folded", str_util::current_local_timestamp_no_colons());
+  }
+
+  lg::print("Profiling for {} seconds at {} hz...\n", seconds, hz);
+  auto profile = m_debugger.profile(seconds, hz);
+  lg::print("Got {} samples ({} failed)\n", profile.samples, profile.failed_samples);
+  if (profile.samples == 0) {
+    return get_none();
+  }
+
+  std::vector<std::pair<std::string, int>> functions(profile.self_samples.begin(),
+                                                     profile.self_samples.end());
+  std::sort(functions.begin(), functions.end(), [](const auto& a, const auto& b) {
+    return a.second != b.second ? a.second > b.second : a.first < b.first;
+  });
+  lg::print("  self %  samples  function\n");
+  for (size_t i = 0; i < std::min<size_t>(functions.size(), 20); i++) {
+    lg::print("  {:6.2f}  {:7d}  {}\n", 100. * functions[i].second / profile.samples,
+              functions[i].second, functions[i].first);
+  }
+
+  file_util::create_dir_if_needed_for_file(out_path);
+  file_util::write_text_file(out_path, profile.to_folded_string());
+  lg::print("Wrote stacks to {}\n", out_path.string());
+  return get_none();
+}
@@ -4,6 +4,46 @@
  */
 
 #include "goalc/compiler/Compiler.h"
+#include "goalc/compiler/IR.h"
+
+namespace {
+
+// the most IR (not counting moves) a function can have and still get inlined by auto-inline.
+constexpr int AUTO_INLINE_MAX_IR = 10;
+
+/*!
+ * Can calls to this function be inlined without a (declare (inline))? Only small leaf functions
+ * are, and only if all their IR means the same thing when the body is compiled again in the caller.
+ * Static data is excluded because each inlined copy would get its own, and asm because rlet
+ * registers and behaviors depend on the function's own registers.
+ */
+bool can_auto_inline(FunctionEnv* func, const TypeSpec& type, size_t param_count) {
+  if (func->is_asm_func || type.try_get_tag("behavior") ||
+      func->constraints().size() != param_count) {
+    return false;
+  }
+
+  int size = 0;
+  for (const auto& ir : func->code()) {
+    auto* i = ir.get();
+    if (dynamic_cast<IR_RegSet*>(i) || dynamic_cast<IR_ValueReset*>(i) ||
+        dynamic_cast<IR_Null*>(i) || dynamic_cast<IR_Return*>(i)) {
+      continue;
+    }
+    if (!dynamic_cast<IR_LoadConstant64*>(i) && !dynamic_cast<IR_LoadSymbolPointer*>(i) &&
+        !dynamic_cast<IR_GetSymbolValue*>(i) && !dynamic_cast<IR_SetSymbolValue*>(i) &&
+        !dynamic_cast<IR_IntegerMath*>(i) && !dynamic_cast<IR_FloatMath*>(i) &&
+        !dynamic_cast<IR_GotoLabel*>(i) && !dynamic_cast<IR_ConditionalBranch*>(i) &&
+        !dynamic_cast<IR_FloatToInt*>(i) && !dynamic_cast<IR_IntToFloat*>(i) &&
+        !dynamic_cast<IR_LoadConstOffset*>(i) && !dynamic_cast<IR_StoreConstOffset*>(i)) {
+      return false;
+    }
+    size++;
+  }
+  return size <= AUTO_INLINE_MAX_IR;
+}
+
+}  // namespace
 
 /*!
  * Define or set a global value. Has some special magic to store data for functions which may be
@@ -35,6 +75,13 @@ Val* Compiler::compile_define(const goos::Object& form, const goos::Object& rest
   auto sym_val = fe->alloc_val<SymbolVal>(symbol_string(sym), m_ts.make_typespec("symbol"));
   auto compiled_val = compile_error_guard(val, env);
   auto as_lambda = dynamic_cast<LambdaVal*>(compiled_val);
+
+  // forget the old body if this was auto-inlined, it may not be the same function anymore.
+  auto inlineable = m_inlineable_functions.find(sym.as_symbol());
+  if (inlineable != m_inlineable_functions.end() && inlineable->second.auto_inline) {
+    m_inlineable_functions.erase(inlineable);
+  }
+
   if (as_lambda) {
     // there are two cases in which we save a function body that is passed to a define:
     // 1. It generated code [so went through the compiler] and the allow_inline flag is set.
@@ -47,6 +94,12 @@ Val* Compiler::compile_define(const goos::Object& form, const goos::Object& rest
       f.inline_by_default = (!as_lambda->func) || as_lambda->func->settings.inline_by_default;
       f.lambda = as_lambda->lambda;
       f.type = as_lambda->type();
+    } else if (m_settings.auto_inline && can_auto_inline(as_lambda->func, as_lambda->type(),
+                                                         as_lambda->lambda.params.size())) {
+      auto& f = m_inlineable_functions[sym.as_symbol()];
+      f.auto_inline = true;
+      f.lambda = as_lambda->lambda;
+      f.type = as_lambda->type();
     }
     // Most defines come via macro invokations, we want the TRUE defining form location
     // if we can get it
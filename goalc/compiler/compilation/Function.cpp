@@ -328,8 +328,12 @@ Val* Compiler::compile_function_or_method_call(const goos::Object& form, Env* en
     auto kv = m_inlineable_functions.find(uneval_head.as_symbol());
     if (kv != m_inlineable_functions.end()) {
       // it's inlinable.  However, we do not always inline an inlinable function by default
-      if (kv->second.inline_by_default) {  // inline when possible, so we should inline
+      bool small_enough = kv->second.auto_inline && m_settings.auto_inline;
+      if (kv->second.inline_by_default || small_enough) {  // inline when possible
         auto_inline = true;
+        if (small_enough) {
+          m_debug_stats.auto_inlined_calls[uneval_head.as_symbol()->name]++;
+        }
         auto* lv = env->function_env()->alloc_val<LambdaVal>(kv->second.type, false);
         lv->lambda = kv->second.lambda;
         head = lv;
@@ -32,12 +32,14 @@ Val* Compiler::compile_goos_macro(const goos::Object& o,
                                   const goos::Object& name,
                                   Env* env) {
   auto macro = macro_obj.as_macro();
+  CompileProfiler::MacroScope profile_scope(&m_compile_profiler, macro->name);
   Arguments args = m_goos.get_args(o, rest, macro->args);
   auto mac_env_obj = EnvironmentObject::make_new();
   auto mac_env = mac_env_obj.as_env_ptr();
   mac_env->parent_env = m_goos.global_environment.as_env_ptr();
   m_goos.set_args_in_env(o, args, macro->args, mac_env);
   auto goos_result = m_goos.eval_list_return_last(macro->body, macro->body, mac_env);
+  profile_scope.done_expanding();
   // make the macro expanded form point to the source where the macro was used for error messages.
   // m_goos.reader.db.inherit_info(o, goos_result);
 
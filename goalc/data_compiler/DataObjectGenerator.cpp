@@ -29,6 +29,10 @@ void push_variable_length_integer(u32 value, std::vector<u8>* vec) {
   }
 }
 
+size_t variable_length_integer_size(u32 value) {
+  return value / UINT8_MAX + 1;
+}
+
 void push_better_variable_length_integer(u32 value, std::vector<u8>* vec) {
   if (value > 0xffffff) {
     vec->push_back((value & 0xff) | 3);
@@ -46,8 +50,44 @@ void push_better_variable_length_integer(u32 value, std::vector<u8>* vec) {
     vec->push_back(value & 0xff);
   }
 }
+
+size_t better_variable_length_integer_size(u32 value) {
+  if (value > 0xffffff) {
+    return 4;
+  } else if (value > 0xffff) {
+    return 3;
+  } else if (value > 0xff) {
+    return 2;
+  } else {
+    return 1;
+  }
+}
 }  // namespace
 
+std::vector<int>& DataObjectGenerator::NamedLinks::get(const std::string& name) {
+  auto [it, inserted] = m_ids.try_emplace(name, (int)m_names.size());
+  if (inserted) {
+    m_names.push_back(name);
+    m_words.emplace_back();
+  }
+  return m_words[it->second];
+}
+
+/*!
+ * Get the names in alphabetical order, each with its words in order.
+ */
+DataObjectGenerator::NamedLinks::Sorted DataObjectGenerator::NamedLinks::sorted() {
+  Sorted result;
+  result.reserve(m_names.size());
+  for (size_t i = 0; i < m_names.size(); i++) {
+    std::sort(m_words[i].begin(), m_words[i].end());
+    result.emplace_back(&m_names[i], &m_words[i]);
+  }
+  std::sort(result.begin(), result.end(),
+            [](const auto& a, const auto& b) { return *a.first < *b.first; });
+  return result;
+}
+
 int DataObjectGenerator::add_word(u32 word) {
   auto result = int(m_words.size());
   m_words.push_back(word);
@@ -78,30 +118,30 @@ void DataObjectGenerator::link_word_to_byte(int source_word, int target_byte) {
 int DataObjectGenerator::add_ref_to_string_in_pool(const std::string& str) {
   auto result = int(m_words.size());
   m_words.push_back(0);
-  m_string_pool[str].push_back(result);
+  m_string_pool.get(str).push_back(result);
   return result;
 }
 
 void DataObjectGenerator::link_word_to_string_in_pool(const std::string& str, int word_idx) {
-  m_string_pool[str].push_back(word_idx);
+  m_string_pool.get(str).push_back(word_idx);
 }
 
 int DataObjectGenerator::add_type_tag(const std::string& str) {
   auto result = int(m_words.size());
   m_words.push_back(0);
-  m_type_links[str].push_back(result);
+  m_type_links.get(str).push_back(result);
   return result;
 }
 
 int DataObjectGenerator::add_symbol_link(const std::string& str) {
   auto result = int(m_words.size());
   m_words.push_back(0);
-  m_symbol_links[str].push_back(result);
+  m_symbol_links.get(str).push_back(result);
   return result;
 }
 
 void DataObjectGenerator::link_word_to_symbol(const std::string& str, int word_idx) {
-  m_symbol_links[str].push_back(word_idx);
+  m_symbol_links.get(str).push_back(word_idx);
 }
 
 void DataObjectGenerator::align(int alignment_words) {
@@ -133,6 +173,7 @@ std::vector<u8> DataObjectGenerator::generate_v2() {
 
   // build
   std::vector<u8> result;
+  result.reserve(align16(sizeof(LinkHeaderV2) + link.size() + m_words.size() * 4));
   add_data_to_vector(header, &result);
   result.insert(result.end(), link.begin(), link.end());
 
@@ -167,6 +208,8 @@ std::vector<u8> DataObjectGenerator::generate_v4() {
   second_header.length = first_header.length;
 
   std::vector<u8> result;
+  result.reserve(sizeof(LinkHeaderV4) + first_header.code_size + sizeof(LinkHeaderV2) +
+                 link.size());
   add_data_to_vector(first_header, &result);
   auto start = result.size();
   result.resize(result.size() + m_words.size() * 4);
@@ -179,14 +222,57 @@ std::vector<u8> DataObjectGenerator::generate_v4() {
   return result;
 }
 
-std::vector<u8> DataObjectGenerator::generate_link_table() {
-  std::vector<u8> link;
+/*!
+ * The exact size of the link table, so it can be built without reallocating. The pointer links must
+ * already be sorted.
+ */
+size_t DataObjectGenerator::link_table_size(const NamedLinks::Sorted& symbols,
+                                            const NamedLinks::Sorted& types) const {
+  size_t size = 0;
+  u32 last_word = 0;
+  for (size_t i = 0; i < m_ptr_links.size();) {
+    size += variable_length_integer_size(m_ptr_links[i].source_word - last_word);
+    size_t consecutive = 1;
+    while (i + consecutive < m_ptr_links.size() &&
+           m_ptr_links[i + consecutive].source_word ==
+               m_ptr_links[i + consecutive - 1].source_word + 1) {
+      consecutive++;
+    }
+    size += variable_length_integer_size(consecutive);
+    i += consecutive;
+    last_word = m_ptr_links[i - 1].source_word + 1;
+  }
+  size += variable_length_integer_size(0);
+
+  for (auto* links : {&symbols, &types}) {
+    for (auto& [name, words] : *links) {
+      // type flag, name, null terminator
+      size += (links == &types ? 1 : 0) + name->size() + 1;
+      int prev = 0;
+      for (auto x : *words) {
+        size += better_variable_length_integer_size((x - prev) * 4);
+        prev = x;
+      }
+      size++;  // end of this name's links
+    }
+  }
+  size += variable_length_integer_size(0);
+
+  // align to 16 bytes for data start!
+  return align64(size + sizeof(LinkHeaderV2)) - sizeof(LinkHeaderV2);
+}
 
+std::vector<u8> DataObjectGenerator::generate_link_table() {
   // pointer links are in source order.
   std::sort(m_ptr_links.begin(), m_ptr_links.end(),
             [](const PointerLinkRecord& a, const PointerLinkRecord& b) {
               return a.source_word < b.source_word;
             });
+  auto symbols = m_symbol_links.sorted();
+  auto types = m_type_links.sorted();
+
+  std::vector<u8> link;
+  link.reserve(link_table_size(symbols, types));
 
   int i = 0;
 
@@ -219,16 +305,13 @@ std::vector<u8> DataObjectGenerator::generate_link_table() {
   }
   push_variable_length_integer(0, &link);
 
-  for (auto& sl : m_symbol_links) {
+  for (auto& [name, words] : symbols) {
     // insert name. first char won't have the highest bit set
-    for (auto c : sl.first) {
-      link.push_back(c);
-    }
+    link.insert(link.end(), name->begin(), name->end());
     link.push_back(0);
-    std::sort(sl.second.begin(), sl.second.end());
     int prev = 0;
 
-    for (auto& x : sl.second) {
+    for (auto& x : *words) {
       int diff = x - prev;
       ASSERT(diff >= 0);
       push_better_variable_length_integer(diff * 4, &link);
@@ -239,17 +322,13 @@ std::vector<u8> DataObjectGenerator::generate_link_table() {
   }
 
   // types
-  for (auto& tl : m_type_links) {
+  for (auto& [name, words] : types) {
     link.push_back(0x80);
-    for (auto c : tl.first) {
-      link.push_back(c);
-    }
+    link.insert(link.end(), name->begin(), name->end());
     link.push_back(0);
-
-    std::sort(tl.second.begin(), tl.second.end());
     int prev = 0;
 
-    for (auto& x : tl.second) {
+    for (auto& x : *words) {
       int diff = x - prev;
       ASSERT(diff >= 0);
       push_better_variable_length_integer(diff * 4, &link);
@@ -261,32 +340,31 @@ std::vector<u8> DataObjectGenerator::generate_link_table() {
   push_variable_length_integer(0, &link);
 
   // align to 16 bytes for data start!
-  while ((link.size() + sizeof(LinkHeaderV2)) % 64) {
-    link.push_back(0);
-  }
+  link.resize(align64(link.size() + sizeof(LinkHeaderV2)) - sizeof(LinkHeaderV2));
   return link;
 }
 
 void DataObjectGenerator::add_strings() {
-  for (auto& entry : m_string_pool) {
+  auto strings = m_string_pool.sorted();
+  size_t string_words = 0;
+  for (auto& [str, sources] : strings) {
+    // alignment, type tag, length, data and null terminator
+    string_words += 3 + 1 + (str->length() + 1 + 3) / 4;
+  }
+  m_words.reserve(m_words.size() + string_words);
+
+  for (auto& [str, sources] : strings) {
     // add the string
     align(4);
     add_type_tag("string");
-    auto target_word = add_word(entry.first.length());
-    std::vector<u8> string_buff;
-    for (auto c : entry.first) {
-      string_buff.push_back(c);
-    }
-    string_buff.push_back(0);
-    while (string_buff.size() & 3) {
-      string_buff.push_back(0);
-    }
-
-    for (int i = 0; i < int(string_buff.size()) / 4; i++) {
-      add_word(*(u32*)(string_buff.data() + i * 4));
-    }
-
-    for (auto& source : entry.second) {
+    auto target_word = add_word(str->length());
+    // the data, padded with zeros to a whole word. always includes a null terminator.
+    auto data_word = m_words.size();
+    m_words.resize(data_word + (str->length() + 1 + 3) / 4);
+    memset(m_words.data() + data_word, 0, (m_words.size() - data_word) * 4);
+    memcpy(m_words.data() + data_word, str->data(), str->length());
+
+    for (auto& source : *sources) {
       link_word_to_word(source, target_word);
     }
   }
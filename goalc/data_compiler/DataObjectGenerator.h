@@ -1,7 +1,7 @@
 #pragma once
 
-#include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "common/common_types.h"
@@ -27,19 +27,36 @@ class DataObjectGenerator {
   u8* data() { return (u8*)m_words.data(); }
 
  private:
-  void add_strings();
-  std::vector<u8> generate_link_table();
-
   struct PointerLinkRecord {
     int source_word;
     int target_byte;
   };
 
-  std::map<std::string, std::vector<int>> m_string_pool;
+  /*!
+   * Words that refer to a name (a string, symbol or type). Names get an id when they're first used,
+   * so adding a reference is a hash lookup. They are sorted by name when generating.
+   */
+  class NamedLinks {
+   public:
+    using Sorted = std::vector<std::pair<const std::string*, std::vector<int>*>>;
+    std::vector<int>& get(const std::string& name);
+    Sorted sorted();
+
+   private:
+    std::unordered_map<std::string, int> m_ids;
+    std::vector<std::string> m_names;
+    std::vector<std::vector<int>> m_words;
+  };
+
+  void add_strings();
+  size_t link_table_size(const NamedLinks::Sorted& symbols, const NamedLinks::Sorted& types) const;
+  std::vector<u8> generate_link_table();
+
+  NamedLinks m_string_pool;
   std::vector<u32> m_words;
   std::vector<PointerLinkRecord> m_ptr_links;
 
-  // both alphabetical.
+  // both alphabetical in the link table.
   // symbols before types.
-  std::map<std::string, std::vector<int>> m_type_links, m_symbol_links;
+  NamedLinks m_type_links, m_symbol_links;
 };
@@ -14,7 +14,10 @@
 #include "game_text_common.h"
 
 #include <algorithm>
+#include <exception>
+#include <functional>
 #include <queue>
+#include <unordered_map>
 
 #include "DataObjectGenerator.h"
 
@@ -22,7 +25,11 @@
 #include "common/goos/Reader.h"
 #include "common/util/FileUtil.h"
 #include "common/util/FontUtils.h"
+#include "common/util/SimpleThreadGroup.h"
+#include "common/util/ThreadPool.h"
+#include "common/util/crc32.h"
 #include "common/util/json_util.h"
+#include "common/util/string_util.h"
 
 #include "third-party/fmt/core.h"
 
@@ -40,6 +47,100 @@ std::string uppercase(const std::string& in) {
   return result;
 }
 
+/*!
+ * Collects the data that goes into one output file, so it can be hashed.
+ */
+class TextHasher {
+ public:
+  void add_word(u32 x) { m_data.insert(m_data.end(), (u8*)&x, (u8*)(&x + 1)); }
+  void add_float(float x) { m_data.insert(m_data.end(), (u8*)&x, (u8*)(&x + 1)); }
+  void add_string(const std::string& str) {
+    add_word(str.size());
+    m_data.insert(m_data.end(), str.begin(), str.end());
+  }
+  u64 hash() const {
+    return ((u64)crc32(m_data.data(), m_data.size()) << 32) | (u32)m_data.size();
+  }
+
+ private:
+  std::vector<u8> m_data;
+};
+
+/*!
+ * One output file, and the hash of the data it is generated from.
+ */
+struct TextOutput {
+  std::string file_name;
+  u64 input_hash = 0;
+  std::function<std::vector<u8>()> generate;
+};
+
+/*!
+ * Generate and write the output files in out/<prefix>/iso. The files are independent, so they are
+ * generated in parallel. The input hash of each file is remembered in
+ * out/<prefix>/<kind>-hashes.txt, and files with the same hash as the last time they were written
+ * are skipped, so editing one language doesn't rebuild all the others.
+ */
+void write_text_outputs(const std::string& kind,
+                        const std::vector<TextOutput>& outputs,
+                        const std::string& output_prefix) {
+  const auto iso_dir = file_util::get_jak_project_dir() / "out" / output_prefix / "iso";
+  const auto cache_path =
+      file_util::get_jak_project_dir() / "out" / output_prefix / fmt::format("{}-hashes.txt", kind);
+  file_util::create_dir_if_needed(iso_dir);
+
+  std::unordered_map<std::string, u64> old_hashes;
+  if (fs::exists(cache_path)) {
+    for (auto& line : str_util::split(file_util::read_text_file(cache_path))) {
+      auto parts = str_util::split(line, ' ');
+      if (parts.size() == 2) {
+        old_hashes[parts[1]] = std::stoull(parts[0], nullptr, 16);
+      }
+    }
+  }
+
+  std::vector<const TextOutput*> stale;
+  for (auto& output : outputs) {
+    auto it = old_hashes.find(output.file_name);
+    if (it == old_hashes.end() || it->second != output.input_hash ||
+        !fs::exists(iso_dir / output.file_name)) {
+      stale.push_back(&output);
+    }
+  }
+
+  if (!stale.empty()) {
+    std::vector<std::exception_ptr> errors(stale.size());
+    SimpleThreadGroup threads;
+    threads.run(
+        [&](int i) {
+          try {
+            auto data = stale[i]->generate();
+            file_util::write_binary_file(iso_dir / stale[i]->file_name, data.data(), data.size());
+          } catch (...) {
+            errors[i] = std::current_exception();
+          }
+        },
+        stale.size());
+    threads.join();
+    for (auto& e : errors) {
+      if (e) {
+        std::rethrow_exception(e);
+      }
+    }
+  }
+  lg::print("[Build Game Text] wrote {} of {} {} files\n", stale.size(), outputs.size(), kind);
+
+  std::string cache_text;
+  for (auto& output : outputs) {
+    cache_text += fmt::format("{:016x} {}\n", output.input_hash, output.file_name);
+  }
+  try {
+    file_util::write_text_file(cache_path, cache_text);
+  } catch (std::exception& e) {
+    lg::warn("Failed to save text hash cache {}: {}", cache_path.string(), e.what());
+  }
+}
+
 /*
 (deftype game-text (structure)
   ((id   uint32  :offset-assert 0)
@@ -61,33 +162,43 @@ std::string uppercase(const std::string& in) {
  * OpenGOAL, so this should produce exactly identical files to what is found in the game.
  */
 void compile_text(GameTextDB& db, const std::string& output_prefix) {
+  std::vector<TextOutput> outputs;
   for (const auto& [group_name, banks] : db.groups()) {
     for (const auto& [lang, bank] : banks) {
-      DataObjectGenerator gen;
-      gen.add_type_tag("game-text-info");  // type
-      gen.add_word(bank->lines().size());  // length
-      gen.add_word(lang);                  // language-id
-      // this string is found in the string pool.
-      gen.add_ref_to_string_in_pool(group_name);  // group-name
+      auto& output = outputs.emplace_back();
+      output.file_name = fmt::format("{}{}.TXT", lang, uppercase(group_name));
 
-      // now add all the datas: (the lines are already sorted by id)
+      TextHasher hasher;
+      hasher.add_string(group_name);
+      hasher.add_word(lang);
       for (auto& [id, line] : bank->lines()) {
-        gen.add_word(id);  // id
-        // these strings must be in the string pool, as sometimes there are duplicate
-        // strings in a single language, and these strings should be stored once and have multiple
-        // references to them.
-        gen.add_ref_to_string_in_pool(line);  // text
+        hasher.add_word(id);
+        hasher.add_string(line);
       }
+      output.input_hash = hasher.hash();
 
-      auto data = gen.generate_v2();
+      output.generate = [group_name = group_name, lang = lang, bank = bank]() {
+        DataObjectGenerator gen;
+        gen.add_type_tag("game-text-info");  // type
+        gen.add_word(bank->lines().size());  // length
+        gen.add_word(lang);                  // language-id
+        // this string is found in the string pool.
+        gen.add_ref_to_string_in_pool(group_name);  // group-name
 
-      file_util::create_dir_if_needed(file_util::get_file_path({"out", output_prefix, "iso"}));
-      file_util::write_binary_file(
-          file_util::get_file_path(
-              {"out", output_prefix, "iso", fmt::format("{}{}.TXT", lang, uppercase(group_name))}),
-          data.data(), data.size());
+        // now add all the datas: (the lines are already sorted by id)
+        for (auto& [id, line] : bank->lines()) {
+          gen.add_word(id);  // id
+          // these strings must be in the string pool, as sometimes there are duplicate
+          // strings in a single language, and these strings should be stored once and have
+          // multiple references to them.
+          gen.add_ref_to_string_in_pool(line);  // text
+        }
+
+        return gen.generate_v2();
+      };
     }
   }
+  write_text_outputs("text", outputs, output_prefix);
 }
 
 /*!
@@ -95,53 +206,70 @@ void compile_text(GameTextDB& db, const std::string& output_prefix) {
  * OpenGOAL.
  */
 void compile_subtitle(GameSubtitleDB& db, const std::string& output_prefix) {
+  std::vector<TextOutput> outputs;
   for (const auto& [lang, bank] : db.banks()) {
-    DataObjectGenerator gen;
-    gen.add_type_tag("subtitle-text-info");  // type
-    gen.add_word(bank->scenes().size());     // length
-    gen.add_word(lang);                      // lang
-    gen.add_word(0);                         // dummy
-
-    // fifo queue for scene data arrays
-    std::queue<int> array_link_sources;
-    // now add all the scene infos
-    for (auto& [name, scene] : bank->scenes()) {
-      gen.add_word((u16)scene.kind() |
-                   (scene.lines().size() << 16));  // kind (lower 16 bits), length (upper 16 bits)
+    auto& output = outputs.emplace_back();
+    output.file_name = fmt::format("{}{}.TXT", lang, uppercase("subtit"));
 
-      array_link_sources.push(gen.words());
-      gen.add_word(0);  // keyframes (linked later)
-
-      if (scene.kind() == SubtitleSceneKind::Movie ||
-          scene.kind() == SubtitleSceneKind::HintNamed) {
-        gen.add_ref_to_string_in_pool(scene.name());  // name
-      } else if (scene.kind() == SubtitleSceneKind::Hint) {
-        gen.add_word(0);  // nothing
-      }
-      gen.add_word(scene.id());
-    }
-    // now add all the scene *data!* (keyframes)
+    TextHasher hasher;
+    hasher.add_word(lang);
     for (auto& [name, scene] : bank->scenes()) {
-      // link inline-array with reference from earlier
-      gen.link_word_to_word(array_link_sources.front(), gen.words());
-      array_link_sources.pop();
-
+      hasher.add_word((u32)scene.kind());
+      hasher.add_string(scene.name());
+      hasher.add_word(scene.id());
+      hasher.add_word(scene.lines().size());
       for (auto& subtitle : scene.lines()) {
-        gen.add_word(subtitle.frame);                     // frame
-        gen.add_ref_to_string_in_pool(subtitle.line);     // line
-        gen.add_ref_to_string_in_pool(subtitle.speaker);  // speaker
-        gen.add_word(subtitle.offscreen);                 // offscreen
+        hasher.add_word(subtitle.frame);
+        hasher.add_string(subtitle.line);
+        hasher.add_string(subtitle.speaker);
+        hasher.add_word(subtitle.offscreen);
       }
     }
+    output.input_hash = hasher.hash();
+
+    output.generate = [lang = lang, bank = bank]() {
+      DataObjectGenerator gen;
+      gen.add_type_tag("subtitle-text-info");  // type
+      gen.add_word(bank->scenes().size());     // length
+      gen.add_word(lang);                      // lang
+      gen.add_word(0);                         // dummy
 
-    auto data = gen.generate_v2();
+      // fifo queue for scene data arrays
+      std::queue<int> array_link_sources;
+      // now add all the scene infos
+      for (auto& [name, scene] : bank->scenes()) {
+        gen.add_word((u16)scene.kind() |
+                     (scene.lines().size() << 16));  // kind (lower 16 bits), length (upper 16 bits)
 
-    file_util::create_dir_if_needed(file_util::get_file_path({"out", output_prefix, "iso"}));
-    file_util::write_binary_file(
-        file_util::get_file_path(
-            {"out", output_prefix, "iso", fmt::format("{}{}.TXT", lang, uppercase("subtit"))}),
-        data.data(), data.size());
+        array_link_sources.push(gen.words());
+        gen.add_word(0);  // keyframes (linked later)
+
+        if (scene.kind() == SubtitleSceneKind::Movie ||
+            scene.kind() == SubtitleSceneKind::HintNamed) {
+          gen.add_ref_to_string_in_pool(scene.name());  // name
+        } else if (scene.kind() == SubtitleSceneKind::Hint) {
+          gen.add_word(0);  // nothing
+        }
+        gen.add_word(scene.id());
+      }
+      // now add all the scene *data!* (keyframes)
+      for (auto& [name, scene] : bank->scenes()) {
+        // link inline-array with reference from earlier
+        gen.link_word_to_word(array_link_sources.front(), gen.words());
+        array_link_sources.pop();
+
+        for (auto& subtitle : scene.lines()) {
+          gen.add_word(subtitle.frame);                     // frame
+          gen.add_ref_to_string_in_pool(subtitle.line);     // line
+          gen.add_ref_to_string_in_pool(subtitle.speaker);  // speaker
+          gen.add_word(subtitle.offscreen);                 // offscreen
+        }
+      }
+
+      return gen.generate_v2();
+    };
   }
+  write_text_outputs("subtit", outputs, output_prefix);
 }
 
 /*!
@@ -149,76 +277,102 @@ void compile_subtitle(GameSubtitleDB& db, const std::string& output_prefix) {
  * and OpenGOAL.
  */
 void compile_subtitle2(GameSubtitle2DB& db, const std::string& output_prefix) {
-  auto& speaker_names = get_speaker_names(db.version());
+  const auto speaker_names = get_speaker_names(db.version());
+  std::vector<TextOutput> outputs;
   for (const auto& [lang, bank] : db.banks()) {
-    auto font = get_font_bank(bank->text_version);
-    DataObjectGenerator gen;
-    gen.add_type_tag("subtitle2-text-info");                   // type
-    gen.add_word((bank->scenes.size() & 0xffff) | (1 << 16));  // length (lo) + version (hi)
-    // note: we add 1 because "none" isn't included
-    gen.add_word((lang & 0xffff) | ((speaker_names.size() + 1) << 16));  // lang + speaker-length
-    int speaker_array_link = gen.add_word(0);  // speaker array (dummy for now)
-
-    auto speaker_index_by_name = [&speaker_names](const std::string& name) {
-      for (int i = 0; i < (int)speaker_names.size(); ++i) {
-        if (speaker_names.at(i) == name) {
-          return i + 1;
-        }
-      }
-      return 0;
-    };
+    auto& output = outputs.emplace_back();
+    output.file_name = fmt::format("{}{}.TXT", lang, uppercase("subti2"));
 
-    // fifo queue for scene data arrays
-    std::queue<int> array_link_sources;
-    // now add all the scenes inline
-    for (auto& [name, scene] : bank->scenes) {
-      gen.add_ref_to_string_in_pool(name);  // scene name
-      gen.add_word(scene.lines.size());     // line amount
-      array_link_sources.push(gen.words());
-      gen.add_word(0);  // line array (linked later)
+    TextHasher hasher;
+    hasher.add_word(lang);
+    hasher.add_word((u32)bank->text_version);
+    for (auto& speaker_name : speaker_names) {
+      hasher.add_string(speaker_name);
+    }
+    for (auto& [speaker_name, speaker] : bank->speakers) {
+      hasher.add_string(speaker_name);
+      hasher.add_string(speaker);
     }
-    // now add all the line arrays and link them to their scene
     for (auto& [name, scene] : bank->scenes) {
-      // link inline-array with reference from earlier
-      gen.link_word_to_word(array_link_sources.front(), gen.words());
-      array_link_sources.pop();
-
+      hasher.add_string(name);
+      hasher.add_word(scene.lines.size());
       for (auto& line : scene.lines) {
-        gen.add_word_float(line.start);  // start frame
-        gen.add_word_float(line.end);    // end frame
-        if (!line.merge) {
-          gen.add_ref_to_string_in_pool(font->convert_utf8_to_game(line.text));  // line text
-        } else {
-          gen.add_symbol_link("#f");
-        }
-        u16 speaker = speaker_index_by_name(line.speaker);
-        u16 flags = 0;
-        flags |= line.offscreen << 0;
-        flags |= line.merge << 1;
-        gen.add_word(speaker | (flags << 16));  // speaker (lo) + flags (hi)
+        hasher.add_float(line.start);
+        hasher.add_float(line.end);
+        hasher.add_string(line.text);
+        hasher.add_string(line.speaker);
+        hasher.add_word(line.offscreen);
+        hasher.add_word(line.merge);
       }
     }
-    // now write the array of strings for the speakers
-    gen.link_word_to_word(speaker_array_link, gen.words());
-    // we write #f for invalid entries, including the "none" at the start
-    gen.add_symbol_link("#f");
-    for (auto& speaker_name : speaker_names) {
-      if (bank->speakers.count(speaker_name) == 0) {
-        // no speaker for this
-        gen.add_symbol_link("#f");
-      } else {
-        gen.add_ref_to_string_in_pool(font->convert_utf8_to_game(bank->speakers.at(speaker_name)));
+    output.input_hash = hasher.hash();
+
+    output.generate = [lang = lang, bank = bank, &speaker_names]() {
+      auto font = get_font_bank(bank->text_version);
+      DataObjectGenerator gen;
+      gen.add_type_tag("subtitle2-text-info");                   // type
+      gen.add_word((bank->scenes.size() & 0xffff) | (1 << 16));  // length (lo) + version (hi)
+      // note: we add 1 because "none" isn't included
+      gen.add_word((lang & 0xffff) | ((speaker_names.size() + 1) << 16));  // lang + speaker-length
+      int speaker_array_link = gen.add_word(0);  // speaker array (dummy for now)
+
+      auto speaker_index_by_name = [&speaker_names](const std::string& name) {
+        for (int i = 0; i < (int)speaker_names.size(); ++i) {
+          if (speaker_names.at(i) == name) {
+            return i + 1;
+          }
+        }
+        return 0;
+      };
+
+      // fifo queue for scene data arrays
+      std::queue<int> array_link_sources;
+      // now add all the scenes inline
+      for (auto& [name, scene] : bank->scenes) {
+        gen.add_ref_to_string_in_pool(name);  // scene name
+        gen.add_word(scene.lines.size());     // line amount
+        array_link_sources.push(gen.words());
+        gen.add_word(0);  // line array (linked later)
       }
-    }
+      // now add all the line arrays and link them to their scene
+      for (auto& [name, scene] : bank->scenes) {
+        // link inline-array with reference from earlier
+        gen.link_word_to_word(array_link_sources.front(), gen.words());
+        array_link_sources.pop();
 
-    auto data = gen.generate_v2();
+        for (auto& line : scene.lines) {
+          gen.add_word_float(line.start);  // start frame
+          gen.add_word_float(line.end);    // end frame
+          if (!line.merge) {
+            gen.add_ref_to_string_in_pool(font->convert_utf8_to_game(line.text));  // line text
+          } else {
+            gen.add_symbol_link("#f");
+          }
+          u16 speaker = speaker_index_by_name(line.speaker);
+          u16 flags = 0;
+          flags |= line.offscreen << 0;
+          flags |= line.merge << 1;
+          gen.add_word(speaker | (flags << 16));  // speaker (lo) + flags (hi)
+        }
+      }
+      // now write the array of strings for the speakers
+      gen.link_word_to_word(speaker_array_link, gen.words());
+      // we write #f for invalid entries, including the "none" at the start
+      gen.add_symbol_link("#f");
+      for (auto& speaker_name : speaker_names) {
+        if (bank->speakers.count(speaker_name) == 0) {
+          // no speaker for this
+          gen.add_symbol_link("#f");
+        } else {
+          gen.add_ref_to_string_in_pool(
+              font->convert_utf8_to_game(bank->speakers.at(speaker_name)));
+        }
+      }
 
-    file_util::create_dir_if_needed(file_util::get_file_path({"out", output_prefix, "iso"}));
-    file_util::write_binary_file(
-        file_util::get_file_path(
-            {"out", output_prefix, "iso", fmt::format("{}{}.TXT", lang, uppercase("subti2"))}),
-        data.data(), data.size());
+      return gen.generate_v2();
+    };
   }
+  write_text_outputs("subti2", outputs, output_prefix);
 }
 }  // namespace
 
@@ -228,17 +382,27 @@ void compile_subtitle2(GameSubtitle2DB& db, const std::string& output_prefix) {
 void compile_game_text(const std::vector<GameTextDefinitionFile>& files,
                        GameTextDB& db,
                        const std::string& output_prefix) {
+  // the json files are read and parsed in parallel, then added to the db in order.
+  std::vector<std::shared_ptr<const nlohmann::json>> json_files(files.size());
+  ThreadPool::global().parallel_for(
+      [&](int i) {
+        if (files[i].format == GameTextDefinitionFile::Format::JSON) {
+          json_files[i] = read_commented_json_file(
+              (file_util::get_jak_project_dir() / files[i].file_path).string());
+        }
+      },
+      files.size());
+
   goos::Reader reader;
-  for (auto& file : files) {
+  for (size_t i = 0; i < files.size(); i++) {
+    const auto& file = files[i];
     if (file.format == GameTextDefinitionFile::Format::GOAL) {
       lg::print("[Build Game Text] GOAL {}\n", file.file_path);
       auto code = reader.read_from_file({file.file_path});
       parse_text(code, db, file);
     } else if (file.format == GameTextDefinitionFile::Format::JSON) {
       lg::print("[Build Game Text] JSON {}\n", file.file_path);
-      auto file_path = file_util::get_jak_project_dir() / file.file_path;
-      auto json = parse_commented_json(file_util::read_text_file(file_path), file.file_path);
-      parse_text_json(json, db, file);
+      parse_text_json(*json_files[i], db, file);
     }
   }
   compile_text(db, output_prefix);
@@ -247,27 +411,23 @@ void compile_game_text(const std::vector<GameTextDefinitionFile>& files,
 void compile_game_subtitle(const std::vector<GameSubtitleDefinitionFile>& files,
                            GameSubtitleDB& db,
                            const std::string& output_prefix) {
-  goos::Reader reader;
   for (auto& file : files) {
     if (file.format == GameSubtitleDefinitionFile::Format::GOAL) {
       lg::print("[Build Game Subtitle] GOAL {}\n", file.lines_path);
-      auto code = reader.read_from_file({file.lines_path});
-      parse_subtitle(code, db, file.lines_path);
     } else if (file.format == GameSubtitleDefinitionFile::Format::JSON) {
       lg::print("[Build Game Subtitle] JSON {}:{}\n", file.lines_path, file.meta_path);
-      parse_subtitle_json(db, file);
     }
   }
+  parse_subtitle_files(db, files);
   compile_subtitle(db, output_prefix);
 }
 
 void compile_game_subtitle2(const std::vector<GameSubtitle2DefinitionFile>& files,
                             GameSubtitle2DB& db,
                             const std::string& output_prefix) {
-  goos::Reader reader;
   for (auto& file : files) {
     lg::print("[Build Game Subtitle] JSON {}\n", file.file_path);
-    parse_subtitle2_json(db, file);
   }
+  parse_subtitle2_files(db, files);
   compile_subtitle2(db, output_prefix);
 }
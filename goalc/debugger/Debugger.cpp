@@ -6,6 +6,9 @@
 
 #include "Debugger.h"
 
+#include <algorithm>
+#include <chrono>
+
 #include "common/goal_constants.h"
 #include "common/log/log.h"
 #include "common/symbols.h"
@@ -46,6 +49,8 @@ bool Debugger::is_valid() const {
  */
 void Debugger::invalidate() {
   m_context_valid = false;
+  clear_memory_cache();
+  m_symbol_string_snapshot.clear();
 }
 
 /*!
@@ -87,6 +92,7 @@ bool Debugger::detach() {
 #endif
     // m_context_valid = false;
     m_attached = false;
+    clear_memory_cache();
   } else {
     succ = false;
   }
@@ -102,6 +108,8 @@ void Debugger::set_context(u32 s7, uintptr_t base, const std::string& thread_id)
   m_debug_context.base = base;
   m_debug_context.tid = xdbg::ThreadID(thread_id);
   m_context_valid = true;
+  clear_memory_cache();
+  m_symbol_string_snapshot.clear();
 }
 
 /*!
@@ -363,6 +371,129 @@ std::vector<BacktraceFrame> Debugger::get_backtrace(u64 rip,
   return bt;
 }
 
+/*!
+ * Get the names of the functions on the stack, innermost first, without printing anything. This
+ * is the same walk as get_backtrace, but it stops at the first function it can't find the caller
+ * of. Code outside of GOAL memory is named [native], and code in an object file without debug
+ * info is named by the object file. Assumes we have an up-to-date memory map.
+ */
+std::vector<std::string> Debugger::get_stack_function_names(u64 rip, u64 rsp, int max_depth) {
+  std::vector<std::string> names;
+  while ((int)names.size() < max_depth) {
+    auto info = get_rip_info(rip);
+    if (!info.in_goal_mem) {
+      // returning to the C++ code that called into GOAL is the end of the GOAL stack.
+      if (names.empty()) {
+        names.push_back("[native]");
+      }
+      break;
+    }
+    if (!info.knows_function) {
+      names.push_back(info.knows_object ? fmt::format("[{}]", info.object_name) : "[unknown]");
+      break;
+    }
+    names.push_back(info.function_name);
+    if (!info.func_debug || !info.func_debug->stack_usage) {
+      break;
+    }
+
+    u64 rsp_at_call = rsp + *info.func_debug->stack_usage;
+    u64 next_rip = 0;
+    if (!read_memory_if_safe<u64>(&next_rip, rsp_at_call - m_debug_context.base)) {
+      break;
+    }
+    rip = next_rip;
+    rsp = rsp_at_call + 8;  // 8 for the call itself.
+  }
+  return names;
+}
+
+/*!
+ * Stop the running target, get its call stack, and continue it. Returns false if the target
+ * couldn't be sampled. If it stopped for some other reason, like a crash, it's left stopped.
+ */
+bool Debugger::sample_stack(std::vector<std::string>* frames) {
+  m_expecting_immeidate_break = true;
+  m_continue_info.valid = false;
+  clear_signal_queue();
+  if (!xdbg::break_now(m_debug_context.tid)) {
+    return false;
+  }
+  auto info = pop_signal();
+  m_running = false;
+  if (info.kind != xdbg::SignalInfo::BREAK) {
+    update_break_info({});
+    return false;
+  }
+
+  m_regs_valid = xdbg::get_regs_now(m_debug_context.tid, &m_regs_at_break);
+  if (!m_regs_valid) {
+    lg::print("[Debugger] get_regs_now failed while profiling, something is wrong\n");
+    return false;
+  }
+  *frames = get_stack_function_names(m_regs_at_break.rip, m_regs_at_break.gprs[emitter::RSP],
+                                     MAX_PROFILE_STACK_DEPTH);
+  return do_continue();
+}
+
+/*!
+ * Sample the call stack of the running target samples_per_second times a second, for the given
+ * number of seconds. Each sample stops the target briefly, so this slows down the game a little.
+ * Native profilers can't name GOAL functions, because they are linked at runtime. Function names
+ * come from the debug info of the code compiled by this compiler, so code that was loaded from a
+ * DGO without being compiled here is only named by its object file.
+ */
+SampledProfile Debugger::profile(double seconds, int samples_per_second) {
+  ASSERT(is_valid() && is_attached() && is_running());
+  SampledProfile result;
+  m_memory_map = m_listener->build_memory_map();
+  m_profiling = true;
+
+  const auto period = std::chrono::microseconds(1000000 / std::max(1, samples_per_second));
+  const auto end = std::chrono::steady_clock::now() +
+                   std::chrono::microseconds((s64)(seconds * 1000000));
+  auto next_sample = std::chrono::steady_clock::now();
+  std::vector<std::string> frames;
+  while (next_sample < end) {
+    std::this_thread::sleep_until(next_sample);
+    next_sample += period;
+
+    frames.clear();
+    if (!sample_stack(&frames)) {
+      result.failed_samples++;
+      if (!is_running()) {
+        lg::print("[Debugger] target stopped while profiling, run (:di) for more information.\n");
+        break;
+      }
+      continue;
+    }
+
+    result.samples++;
+    result.self_samples[frames.front()]++;
+    std::string stack;
+    for (auto it = frames.rbegin(); it != frames.rend(); ++it) {
+      if (!stack.empty()) {
+        stack.push_back(';');
+      }
+      stack += *it;
+    }
+    result.stacks[stack]++;
+  }
+
+  m_profiling = false;
+  return result;
+}
+
+std::string SampledProfile::to_folded_string() const {
+  std::vector<std::pair<std::string, int>> sorted(stacks.begin(), stacks.end());
+  std::sort(sorted.begin(), sorted.end());
+  std::string result;
+  for (const auto& [stack, count] : sorted) {
+    result += fmt::format("{} {}\n", stack, count);
+  }
+  return result;
+}
+
 /*!
  * This assumes we have an up-to-date memory map and symbol info.
  */
@@ -508,6 +639,7 @@ bool Debugger::do_continue() {
   }
 
   m_expecting_immeidate_break = false;
+  clear_memory_cache();
   if (!xdbg::cont_now(m_debug_context.tid)) {
     return false;
   } else {
@@ -518,10 +650,58 @@ bool Debugger::do_continue() {
 
 /*!
  * Read memory from an attached and halted target.
+ * Goes through the page cache: only the pages that haven't been read since the target stopped are
+ * read from the target, with one read for each run of missing pages.
  */
 bool Debugger::read_memory(u8* dest_buffer, int size, u32 goal_addr) const {
   ASSERT(is_valid() && is_attached() && is_halted());
-  return xdbg::read_goal_memory(dest_buffer, size, goal_addr, m_debug_context, m_memory_handle);
+  if (size <= 0 || (u64)goal_addr + size > EE_MAIN_MEM_SIZE) {
+    m_memory_reads++;
+    m_memory_bytes_read += std::max(size, 0);
+    return xdbg::read_goal_memory(dest_buffer, size, goal_addr, m_debug_context, m_memory_handle);
+  }
+
+  u32 first_page = goal_addr / MEMORY_CACHE_PAGE_SIZE;
+  u32 last_page = (goal_addr + size - 1) / MEMORY_CACHE_PAGE_SIZE;
+  u32 page = first_page;
+  while (page <= last_page) {
+    if (m_memory_cache.find(page) != m_memory_cache.end()) {
+      page++;
+      continue;
+    }
+    u32 run_end = page + 1;
+    while (run_end <= last_page && m_memory_cache.find(run_end) == m_memory_cache.end()) {
+      run_end++;
+    }
+    std::vector<u8> data((run_end - page) * MEMORY_CACHE_PAGE_SIZE);
+    m_memory_reads++;
+    m_memory_bytes_read += data.size();
+    if (!xdbg::read_goal_memory(data.data(), data.size(), page * MEMORY_CACHE_PAGE_SIZE,
+                                m_debug_context, m_memory_handle)) {
+      // some pages may not be readable (the protected low memory on windows). Read only what was
+      // asked for, without caching it.
+      m_memory_reads++;
+      m_memory_bytes_read += size;
+      return xdbg::read_goal_memory(dest_buffer, size, goal_addr, m_debug_context,
+                                    m_memory_handle);
+    }
+    for (u32 i = page; i < run_end; i++) {
+      auto start = data.begin() + (i - page) * MEMORY_CACHE_PAGE_SIZE;
+      m_memory_cache[i].assign(start, start + MEMORY_CACHE_PAGE_SIZE);
+    }
+    page = run_end;
+  }
+
+  u32 addr = goal_addr;
+  u32 end = goal_addr + size;
+  while (addr < end) {
+    u32 offset = addr % MEMORY_CACHE_PAGE_SIZE;
+    u32 count = std::min(end - addr, MEMORY_CACHE_PAGE_SIZE - offset);
+    memcpy(dest_buffer + (addr - goal_addr),
+           m_memory_cache.at(addr / MEMORY_CACHE_PAGE_SIZE).data() + offset, count);
+    addr += count;
+  }
+  return true;
 }
 
 bool Debugger::read_memory_if_safe(u8* dest_buffer, int size, u32 goal_addr) const {
@@ -537,6 +717,12 @@ bool Debugger::read_memory_if_safe(u8* dest_buffer, int size, u32 goal_addr) con
  */
 bool Debugger::write_memory(const u8* src_buffer, int size, u32 goal_addr) {
   ASSERT(is_valid() && is_attached() && is_halted());
+  if (size > 0) {
+    u32 last_page = (u32)(((u64)goal_addr + size - 1) / MEMORY_CACHE_PAGE_SIZE);
+    for (u32 page = goal_addr / MEMORY_CACHE_PAGE_SIZE; page <= last_page; page++) {
+      m_memory_cache.erase(page);
+    }
+  }
   return xdbg::write_goal_memory(src_buffer, size, goal_addr, m_debug_context, m_memory_handle);
 }
 
@@ -544,8 +730,8 @@ void Debugger::read_symbol_table_jak1() {
   using namespace jak1_symbols;
   using namespace jak1;
   ASSERT(is_valid() && is_attached() && is_halted());
-  u32 bytes_read = 0;
-  u32 reads = 0;
+  u32 reads_before = m_memory_reads;
+  u64 bytes_before = m_memory_bytes_read;
   Timer timer;
 
   u32 st_base = m_debug_context.s7 - ((GOAL_MAX_SYMBOLS / 2) * 8 + BASIC_OFFSET);
@@ -554,13 +740,10 @@ void Debugger::read_symbol_table_jak1() {
   std::vector<u8> mem;
   mem.resize(SYM_TABLE_MEM_SIZE);
 
-  if (!xdbg::read_goal_memory(mem.data(), SYM_TABLE_MEM_SIZE, st_base, m_debug_context,
-                              m_memory_handle)) {
+  if (!read_memory(mem.data(), SYM_TABLE_MEM_SIZE, st_base)) {
     lg::print("Read failed during read_symbol_table\n");
     return;
   }
-  reads++;
-  bytes_read += SYM_TABLE_MEM_SIZE;
 
   struct SymLower {
     u32 type;
@@ -600,23 +783,17 @@ void Debugger::read_symbol_table_jak1() {
       auto info = (SymUpper*)(mem.data() + i * sizeof(SymLower) + SYM_INFO_OFFSET + BASIC_OFFSET);
 
       // now get the string.
-      char str_buff[128];
-      if (!xdbg::read_goal_memory((u8*)str_buff, 128, info->str + 4, m_debug_context,
-                                  m_memory_handle)) {
+      std::string str;
+      if (!read_symbol_string(info->str, &str)) {
         lg::print("Read symbol string failed during read_symbol_table\n");
         return;
       }
-      reads++;
-      bytes_read += 128;
-      // just in case
-      str_buff[127] = '\0';
 
       // GOAL sym - s7
       auto sym_offset = s32(offset + st_base + BASIC_OFFSET) - s32(m_debug_context.s7);
       ASSERT(sym_offset >= -SYM_TABLE_MEM_SIZE / 4);
       ASSERT(sym_offset < SYM_TABLE_MEM_SIZE / 4);
 
-      std::string str(str_buff);
       if (str.length() >= 50) {
         lg::print("Invalid symbol #x{:x}!\n", sym_offset);
         continue;
@@ -644,7 +821,8 @@ void Debugger::read_symbol_table_jak1() {
   }
 
   ASSERT(m_symbol_offset_to_name_map.size() == m_symbol_name_to_offset_map.size());
-  lg::print("Read symbol table ({} bytes, {} reads, {} symbols, {:.2f} ms)\n", bytes_read, reads,
+  lg::print("Read symbol table ({} bytes, {} reads, {} symbols, {:.2f} ms)\n",
+            m_memory_bytes_read - bytes_before, m_memory_reads - reads_before,
             m_symbol_name_to_offset_map.size(), timer.getMs());
 }
 
@@ -652,8 +830,8 @@ void Debugger::read_symbol_table_jak2() {
   using namespace jak2_symbols;
   using namespace jak2;
   ASSERT(is_valid() && is_attached() && is_halted());
-  u32 bytes_read = 0;
-  u32 reads = 0;
+  u32 reads_before = m_memory_reads;
+  u64 bytes_before = m_memory_bytes_read;
   Timer timer;
 
   u32 st_base = m_debug_context.s7 - ((GOAL_MAX_SYMBOLS / 2) * 4 + 1);
@@ -663,13 +841,10 @@ void Debugger::read_symbol_table_jak2() {
   std::vector<u8> mem;
   mem.resize(SYM_TABLE_MEM_SIZE);
 
-  if (!xdbg::read_goal_memory(mem.data(), SYM_TABLE_MEM_SIZE, st_base, m_debug_context,
-                              m_memory_handle)) {
+  if (!read_memory(mem.data(), SYM_TABLE_MEM_SIZE, st_base)) {
     lg::print("Read failed during read_symbol_table\n");
     return;
   }
-  reads++;
-  bytes_read += SYM_TABLE_MEM_SIZE;
 
   m_symbol_name_to_offset_map.clear();
   m_symbol_offset_to_name_map.clear();
@@ -685,22 +860,17 @@ void Debugger::read_symbol_table_jak2() {
     auto info = *(u32*)(mem.data() + i * 4 + SYM_TO_STRING_OFFSET + 1);
     if (info) {
       // now get the string.
-      char str_buff[128];
-      if (!xdbg::read_goal_memory((u8*)str_buff, 128, info + 4, m_debug_context, m_memory_handle)) {
+      std::string str;
+      if (!read_symbol_string(info, &str)) {
         lg::print("Read symbol string failed during read_symbol_table\n");
         return;
       }
-      reads++;
-      bytes_read += 128;
-      // just in case
-      str_buff[127] = '\0';
 
       // GOAL sym - s7
       auto sym_offset = s32(offset + st_base) - s32(m_debug_context.s7);
       ASSERT(sym_offset >= -SYM_TABLE_MEM_SIZE / 4);
       ASSERT(sym_offset < SYM_TABLE_MEM_SIZE / 4);
 
-      std::string str(str_buff);
       if (str.length() >= 50) {
         lg::print("Invalid symbol #x{:x}!\n", sym_offset);
         continue;
@@ -728,10 +898,33 @@ void Debugger::read_symbol_table_jak2() {
   }
 
   ASSERT(m_symbol_offset_to_name_map.size() == m_symbol_name_to_offset_map.size());
-  lg::print("Read symbol table ({} bytes, {} reads, {} symbols, {:.2f} ms)\n", bytes_read, reads,
+  lg::print("Read symbol table ({} bytes, {} reads, {} symbols, {:.2f} ms)\n",
+            m_memory_bytes_read - bytes_before, m_memory_reads - reads_before,
             m_symbol_name_to_offset_map.size(), timer.getMs());
 }
 
+/*!
+ * Get the name of a symbol from its GOAL string. Names that were read before come from the
+ * snapshot, so reading the symbol table again only reads the strings of new symbols.
+ */
+bool Debugger::read_symbol_string(u32 str_addr, std::string* out) {
+  auto it = m_symbol_string_snapshot.find(str_addr);
+  if (it != m_symbol_string_snapshot.end()) {
+    *out = it->second;
+    return true;
+  }
+
+  char str_buff[128];
+  if (!read_memory((u8*)str_buff, 128, str_addr + 4)) {
+    return false;
+  }
+  // just in case
+  str_buff[127] = '\0';
+  *out = str_buff;
+  m_symbol_string_snapshot[str_addr] = *out;
+  return true;
+}
+
 /*!
  * Read the GOAL Symbol table from an attached and halted target.
  */
@@ -868,7 +1061,9 @@ void Debugger::watcher() {
           printf("Target has crashed with a SEGFAULT! Run (:di) to get more information.\n");
           break;
         case xdbg::SignalInfo::BREAK:
-          printf("Target has stopped. Run (:di) to get more information.\n");
+          if (!m_profiling) {
+            printf("Target has stopped. Run (:di) to get more information.\n");
+          }
           break;
         case xdbg::SignalInfo::MATH_EXCEPTION:
           printf("Target has crashed with a MATH_EXCEPTION! Run (:di) to get more information.\n");
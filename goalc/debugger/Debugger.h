@@ -6,12 +6,14 @@
 
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <cstring>
 #include <mutex>
 #include <queue>
 #include <thread>
 #include <unordered_map>
+#include <vector>
 
 #include "DebugInfo.h"
 
@@ -60,6 +62,21 @@ struct BacktraceFrame {
   u64 rsp_at_rip = 0;
 };
 
+/*!
+ * Call stacks sampled from a running target by Debugger::profile.
+ */
+struct SampledProfile {
+  int samples = 0;
+  int failed_samples = 0;
+  // number of samples of each call stack, as function names separated by ';', outermost first.
+  // This is the "folded" format read by flamegraph.pl and speedscope.
+  std::unordered_map<std::string, int> stacks;
+  // number of samples in each function, not counting the functions it called.
+  std::unordered_map<std::string, int> self_samples;
+
+  std::string to_folded_string() const;
+};
+
 class Debugger {
  public:
   explicit Debugger(listener::Listener* listener, const goos::Reader* reader, GameVersion version)
@@ -106,6 +123,8 @@ class Debugger {
   Disassembly disassemble_at_rip(const InstructionPointerInfo& info);
 
   std::vector<BacktraceFrame> get_backtrace(u64 rip, u64 rsp, std::optional<std::string> dump_path);
+  std::vector<std::string> get_stack_function_names(u64 rip, u64 rsp, int max_depth);
+  SampledProfile profile(double seconds, int samples_per_second);
 
   std::string disassemble_x86_with_symbols(int len, u64 base_addr) const;
 
@@ -155,11 +174,25 @@ class Debugger {
   // how many bytes of instructions to look at ahead of / behind rip when stopping
   static constexpr int INSTR_DUMP_SIZE_REV = 32;
   static constexpr int INSTR_DUMP_SIZE_FWD = 64;
+  static constexpr int MAX_PROFILE_STACK_DEPTH = 64;
 
   // symbol table info (all s7-relative offsets)
   std::unordered_map<std::string, s32> m_symbol_name_to_offset_map;
   std::unordered_map<std::string, u32> m_symbol_name_to_value_map;
   std::unordered_map<s32, std::string> m_symbol_offset_to_name_map;
+  // symbol name strings by GOAL address. These are never freed or changed by the runtime, so they
+  // are kept between reads of the symbol table until the target restarts.
+  std::unordered_map<u32, std::string> m_symbol_string_snapshot;
+  bool read_symbol_string(u32 str_addr, std::string* out);
+
+  // pages of target memory that have been read since the target last stopped. Reads are done a
+  // page at a time and missing pages next to each other are read together, so many small reads
+  // (backtraces, the symbol table) only cost a few calls to xdbg. Cleared when the target runs.
+  static constexpr u32 MEMORY_CACHE_PAGE_SIZE = 4096;
+  mutable std::unordered_map<u32, std::vector<u8>> m_memory_cache;
+  mutable u32 m_memory_reads = 0;
+  mutable u64 m_memory_bytes_read = 0;
+  void clear_memory_cache() { m_memory_cache.clear(); }
 
   // debug state
   xdbg::DebugContext m_debug_context;
@@ -187,6 +220,9 @@ class Debugger {
   };
 
   bool m_expecting_immeidate_break = false;
+  // set while profile() is stopping the target, so the watcher doesn't report each stop.
+  std::atomic<bool> m_profiling = false;
+  bool sample_stack(std::vector<std::string>* frames);
 
   std::unordered_map<u32, Breakpoint> m_addr_breakpoints;
 
@@ -15,6 +15,11 @@
 
 #include "ObjectGenerator.h"
 
+#include <algorithm>
+#include <unordered_map>
+
+#include "IGen.h"
+
 #include "common/goal_constants.h"
 #include "common/type_system/TypeSystem.h"
 #include "common/versions/versions.h"
@@ -33,9 +38,21 @@ ObjectGenerator::ObjectGenerator(GameVersion version) : m_version(version) {}
 ObjectFileData ObjectGenerator::generate_data_v3(const TypeSystem* ts) {
   ObjectFileData out;
 
+  const int function_type_id = link_name_id("function");
+
   // do functions (step 2, part 1)
   for (int seg = N_SEG; seg-- > 0;) {
     auto& data = m_data_by_seg.at(seg);
+    // reserve the upper bound of the segment size, so the data isn't reallocated while adding it.
+    size_t max_size = 0;
+    for (auto& function : m_function_data_by_seg.at(seg)) {
+      max_size += function.min_align + POINTER_SIZE + function.instructions.size() * 16;
+    }
+    for (auto& s : m_static_data_by_seg.at(seg)) {
+      max_size += s.min_align + s.data.size();
+    }
+    data.reserve(data.size() + max_size);
+
     // loop over functions in this segment
     for (auto& function : m_function_data_by_seg.at(seg)) {
       // align
@@ -44,7 +61,7 @@ ObjectFileData ObjectGenerator::generate_data_v3(const TypeSystem* ts) {
       }
 
       // add a type tag link
-      m_type_ptr_links_by_seg.at(seg)["function"].push_back(data.size());
+      add_named_link<int>(m_type_ptr_links_by_seg.at(seg), function_type_id, data.size());
 
       // add room for a type tag
       for (int i = 0; i < POINTER_SIZE; i++) {
@@ -56,7 +73,7 @@ ObjectFileData ObjectGenerator::generate_data_v3(const TypeSystem* ts) {
       function.debug->seg = seg;
 
       // insert instructions!
-
+      function.instruction_to_byte_in_data.reserve(function.instructions.size());
       for (size_t instr_idx = 0; instr_idx < function.instructions.size(); instr_idx++) {
         const auto& instr = function.instructions[instr_idx];
         u8 temp[128];
@@ -65,9 +82,7 @@ ObjectFileData ObjectGenerator::generate_data_v3(const TypeSystem* ts) {
         function.instruction_to_byte_in_data.push_back(data.size());
         function.debug->instructions.at(instr_idx).offset =
             data.size() - function.debug->offset_in_seg;
-        for (int i = 0; i < count; i++) {
-          insert_data<u8>(seg, temp[i]);
-        }
+        data.insert(data.end(), temp, temp + count);
       }
 
       function.debug->length = m_data_by_seg.at(seg).size() - function.debug->offset_in_seg;
@@ -93,6 +108,7 @@ ObjectFileData ObjectGenerator::generate_data_v3(const TypeSystem* ts) {
   for (int seg = N_SEG; seg-- > 0;) {
     handle_temp_static_type_links(seg);
     handle_temp_static_sym_links(seg);
+    thread_temp_jump_links(seg);
     handle_temp_jump_links(seg);
     handle_temp_instr_sym_links(seg);
     handle_temp_rip_func_links(seg);
@@ -100,7 +116,13 @@ ObjectFileData ObjectGenerator::generate_data_v3(const TypeSystem* ts) {
     handle_temp_static_ptr_links(seg);
   }
 
-  // step 4, generate the link table
+  // step 4, generate the link table. Symbols and types are linked in alphabetical order.
+  m_sorted_link_name_ids.resize(m_link_names.size());
+  for (size_t i = 0; i < m_link_names.size(); i++) {
+    m_sorted_link_name_ids[i] = i;
+  }
+  std::sort(m_sorted_link_name_ids.begin(), m_sorted_link_name_ids.end(),
+            [&](int a, int b) { return m_link_names[a] < m_link_names[b]; });
   for (int seg = N_SEG; seg-- > 0;) {
     emit_link_table(seg, ts);
   }
@@ -233,7 +255,7 @@ void ObjectGenerator::link_static_type_ptr(StaticRecord rec,
   StaticTypeLink link;
   link.offset = offset;
   link.rec = rec;
-  m_static_type_temp_links_by_seg.at(rec.seg)[type_name].push_back(link);
+  add_named_link(m_static_type_temp_links_by_seg.at(rec.seg), link_name_id(type_name), link);
 }
 
 /*!
@@ -256,7 +278,7 @@ void ObjectGenerator::link_instruction_jump(InstructionRecord jump_instr, IR_Rec
  */
 void ObjectGenerator::link_instruction_symbol_mem(const InstructionRecord& rec,
                                                   const std::string& name) {
-  m_symbol_instr_temp_links_by_seg.at(rec.seg)[name].push_back({rec, true});
+  add_named_link(m_symbol_instr_temp_links_by_seg.at(rec.seg), link_name_id(name), {rec, true});
 }
 
 /*!
@@ -265,7 +287,7 @@ void ObjectGenerator::link_instruction_symbol_mem(const InstructionRecord& rec,
  */
 void ObjectGenerator::link_instruction_symbol_ptr(const InstructionRecord& rec,
                                                   const std::string& name) {
-  m_symbol_instr_temp_links_by_seg.at(rec.seg)[name].push_back({rec, false});
+  add_named_link(m_symbol_instr_temp_links_by_seg.at(rec.seg), link_name_id(name), {rec, false});
 }
 
 /*!
@@ -275,7 +297,7 @@ void ObjectGenerator::link_instruction_symbol_ptr(const InstructionRecord& rec,
 void ObjectGenerator::link_static_symbol_ptr(StaticRecord rec,
                                              int offset,
                                              const std::string& name) {
-  m_static_sym_temp_links_by_seg.at(rec.seg)[name].push_back({rec, offset});
+  add_named_link(m_static_sym_temp_links_by_seg.at(rec.seg), link_name_id(name), {rec, offset});
 }
 
 /*!
@@ -327,13 +349,13 @@ void ObjectGenerator::link_instruction_to_function(const InstructionRecord& inst
  * after memory layout is done and before link tables are generated
  */
 void ObjectGenerator::handle_temp_static_type_links(int seg) {
-  for (const auto& type_links : m_static_type_temp_links_by_seg.at(seg)) {
-    const auto& type_name = type_links.first;
-    for (const auto& link : type_links.second) {
+  const auto& temp_links = m_static_type_temp_links_by_seg.at(seg);
+  for (int type_id = 0; type_id < (int)temp_links.size(); type_id++) {
+    for (const auto& link : temp_links[type_id]) {
       ASSERT(seg == link.rec.seg);
       const auto& static_object = m_static_data_by_seg.at(seg).at(link.rec.static_id);
       int total_offset = static_object.location + link.offset;
-      m_type_ptr_links_by_seg.at(seg)[type_name].push_back(total_offset);
+      add_named_link(m_type_ptr_links_by_seg.at(seg), type_id, total_offset);
     }
   }
 }
@@ -344,13 +366,13 @@ void ObjectGenerator::handle_temp_static_type_links(int seg) {
  * after memory layout is done and before link tables are generated
  */
 void ObjectGenerator::handle_temp_static_sym_links(int seg) {
-  for (const auto& sym_links : m_static_sym_temp_links_by_seg.at(seg)) {
-    const auto& sym_name = sym_links.first;
-    for (const auto& link : sym_links.second) {
+  const auto& temp_links = m_static_sym_temp_links_by_seg.at(seg);
+  for (int sym_id = 0; sym_id < (int)temp_links.size(); sym_id++) {
+    for (const auto& link : temp_links[sym_id]) {
       ASSERT(seg == link.rec.seg);
       const auto& static_object = m_static_data_by_seg.at(seg).at(link.rec.static_id);
       int total_offset = static_object.location + link.offset;
-      m_sym_links_by_seg.at(seg)[sym_name].push_back(total_offset);
+      add_named_link(m_sym_links_by_seg.at(seg), sym_id, total_offset);
     }
   }
 }
@@ -382,6 +404,44 @@ void ObjectGenerator::handle_temp_static_ptr_links(int seg) {
   }
 }
 
+/*!
+ * If a jump's destination starts with an unconditional jump, go straight to where that one goes.
+ * This happens a lot with nested conds and return-froms, which all jump to the end of their form.
+ * The jump instructions don't change, so the layout stays the same.
+ */
+void ObjectGenerator::thread_temp_jump_links(int seg) {
+  auto& links = m_jump_temp_links_by_seg.at(seg);
+  // (function, instruction) of each linked unconditional jump, to its link.
+  std::unordered_map<u64, size_t> unconditional_jumps;
+  auto key = [](int func_id, int instr_id) { return ((u64)func_id << 32) | (u32)instr_id; };
+  for (size_t i = 0; i < links.size(); i++) {
+    const auto& rec = links[i].jump_instr;
+    const auto& function = m_function_data_by_seg.at(seg).at(rec.func_id);
+    const auto& instr = function.instructions.at(rec.instr_id);
+    if (instr.op == IGen::jmp_32().op && !(instr.m_flags & ~Instruction::kSetImm) && !instr.n_vex) {
+      unconditional_jumps[key(rec.func_id, rec.instr_id)] = i;
+    }
+  }
+
+  for (auto& link : links) {
+    const auto& function = m_function_data_by_seg.at(seg).at(link.dest.func_id);
+    // a limit, so a jump to itself doesn't loop forever.
+    for (int depth = 0; depth < 8; depth++) {
+      int dest_instr = function.ir_to_instruction.at(link.dest.ir_id);
+      auto it = unconditional_jumps.find(key(link.dest.func_id, dest_instr));
+      if (it == unconditional_jumps.end()) {
+        break;
+      }
+      const auto& next_dest = links.at(it->second).dest;
+      if (next_dest.ir_id == link.dest.ir_id) {
+        break;
+      }
+      link.dest = next_dest;
+      m_stats.jumps_threaded++;
+    }
+  }
+}
+
 /*!
  * m_jump_temp_links_by_seg patching after memory layout is done
  */
@@ -419,9 +479,9 @@ void ObjectGenerator::handle_temp_jump_links(int seg) {
  * after memory layout is done and before link tables are generated
  */
 void ObjectGenerator::handle_temp_instr_sym_links(int seg) {
-  for (const auto& links : m_symbol_instr_temp_links_by_seg.at(seg)) {
-    const auto& sym_name = links.first;
-    for (const auto& link : links.second) {
+  const auto& temp_links = m_symbol_instr_temp_links_by_seg.at(seg);
+  for (int sym_id = 0; sym_id < (int)temp_links.size(); sym_id++) {
+    for (const auto& link : temp_links[sym_id]) {
       ASSERT(seg == link.rec.seg);
       const auto& function = m_function_data_by_seg.at(seg).at(link.rec.func_id);
       const auto& instruction = function.instructions.at(link.rec.instr_id);
@@ -433,7 +493,8 @@ void ObjectGenerator::handle_temp_instr_sym_links(int seg) {
       } else {
         ASSERT(instruction.get_imm_size() == 4);
       }
-      m_sym_links_by_seg.at(seg)[sym_name].push_back(offset_of_instruction + offset_in_instruction);
+      add_named_link(m_sym_links_by_seg.at(seg), sym_id,
+                     offset_of_instruction + offset_in_instruction);
     }
   }
 }
@@ -472,38 +533,38 @@ uint32_t push_data(const T& data, std::vector<u8>& v) {
 
 void ObjectGenerator::emit_link_type_pointer(int seg, const TypeSystem* ts) {
   auto& out = m_link_by_seg.at(seg);
-  for (auto& rec : m_type_ptr_links_by_seg.at(seg)) {
-    u32 size = rec.second.size();
-    if (!size) {
+  const auto& links = m_type_ptr_links_by_seg.at(seg);
+  for (int type_id : m_sorted_link_name_ids) {
+    if (type_id >= (int)links.size() || links[type_id].empty()) {
       continue;
     }
+    const auto& name = m_link_names[type_id];
+    const auto& offsets = links[type_id];
 
     // start
     out.push_back(LINK_TYPE_PTR);
 
     // name
-    for (char c : rec.first) {
-      out.push_back(c);
-    }
+    out.insert(out.end(), name.begin(), name.end());
     out.push_back(0);
 
     // method count
     switch (m_version) {
       case GameVersion::Jak1:
-        out.push_back(ts->get_type_method_count(rec.first));
+        out.push_back(ts->get_type_method_count(name));
         break;
       case GameVersion::Jak2:
         // the linker/intern_type functions do the +3.
-        out.push_back(ts->get_type_method_count(rec.first) / 4);
+        out.push_back(ts->get_type_method_count(name) / 4);
         break;
       default:
         ASSERT(false);
     }
 
     // number of links
-    push_data<u32>(size, out);
+    push_data<u32>(offsets.size(), out);
 
-    for (auto& r : rec.second) {
+    for (auto& r : offsets) {
       push_data<s32>(r, out);
     }
   }
@@ -511,17 +572,22 @@ void ObjectGenerator::emit_link_type_pointer(int seg, const TypeSystem* ts) {
 
 void ObjectGenerator::emit_link_symbol(int seg) {
   auto& out = m_link_by_seg.at(seg);
-  for (auto& rec : m_sym_links_by_seg.at(seg)) {
-    out.push_back(LINK_SYMBOL_OFFSET);
-    for (char c : rec.first) {
-      out.push_back(c);
+  const auto& links = m_sym_links_by_seg.at(seg);
+  for (int sym_id : m_sorted_link_name_ids) {
+    if (sym_id >= (int)links.size() || links[sym_id].empty()) {
+      continue;
     }
+    const auto& name = m_link_names[sym_id];
+    const auto& offsets = links[sym_id];
+
+    out.push_back(LINK_SYMBOL_OFFSET);
+    out.insert(out.end(), name.begin(), name.end());
     out.push_back(0);
 
     // number of links
-    push_data<u32>(rec.second.size(), out);
+    push_data<u32>(offsets.size(), out);
 
-    for (auto& r : rec.second) {
+    for (auto& r : offsets) {
       push_data<s32>(r, out);
     }
   }
@@ -566,7 +632,30 @@ void ObjectGenerator::emit_link_rip(int seg) {
   }
 }
 
+/*!
+ * The exact size of the link table for a segment, so it can be built without reallocating.
+ */
+size_t ObjectGenerator::link_table_size(int seg) const {
+  size_t size = 1;  // LINK_TABLE_END
+  const auto& sym_links = m_sym_links_by_seg.at(seg);
+  const auto& type_links = m_type_ptr_links_by_seg.at(seg);
+  for (int id = 0; id < (int)m_link_names.size(); id++) {
+    // kind, name, null terminator, count, offsets
+    size_t name_record_size = 1 + m_link_names[id].size() + 1 + sizeof(u32);
+    if (id < (int)sym_links.size() && !sym_links[id].empty()) {
+      size += name_record_size + sym_links[id].size() * sizeof(s32);
+    }
+    if (id < (int)type_links.size() && !type_links[id].empty()) {
+      size += name_record_size + 1 + type_links[id].size() * sizeof(s32);  // + method count
+    }
+  }
+  size += m_rip_links_by_seg.at(seg).size() * (2 + 3 * sizeof(u32));
+  size += m_pointer_links_by_seg.at(seg).size() * (1 + 2 * sizeof(u32));
+  return size;
+}
+
 void ObjectGenerator::emit_link_table(int seg, const TypeSystem* ts) {
+  m_link_by_seg.at(seg).reserve(m_link_by_seg.at(seg).size() + link_table_size(seg));
   emit_link_symbol(seg);
   emit_link_type_pointer(seg, ts);
   emit_link_rip(seg);
@@ -574,6 +663,18 @@ void ObjectGenerator::emit_link_table(int seg, const TypeSystem* ts) {
   m_link_by_seg.at(seg).push_back(LINK_TABLE_END);
 }
 
+/*!
+ * Get the id of a symbol or type name that is linked to. The same name has the same id in all
+ * segments.
+ */
+int ObjectGenerator::link_name_id(const std::string& name) {
+  auto [it, inserted] = m_link_name_ids.try_emplace(name, (int)m_link_names.size());
+  if (inserted) {
+    m_link_names.push_back(name);
+  }
+  return it->second;
+}
+
 /*!
  * Generate linker header.
  */
@@ -636,4 +737,8 @@ ObjectGeneratorStats ObjectGenerator::get_stats() const {
 void ObjectGenerator::count_eliminated_move() {
   m_stats.moves_eliminated++;
 }
+
+void ObjectGenerator::count_eliminated_jump() {
+  m_stats.jumps_eliminated++;
+}
 }  // namespace emitter
@@ -6,8 +6,8 @@
 #pragma once
 
 #include <cstring>
-#include <map>
 #include <string>
+#include <unordered_map>
 
 #include "Instruction.h"
 #include "ObjectFileData.h"
@@ -59,6 +59,8 @@ struct StaticRecord {
 
 struct ObjectGeneratorStats {
   int moves_eliminated = 0;
+  int jumps_eliminated = 0;  // jumps to the next instruction, which weren't emitted
+  int jumps_threaded = 0;    // jumps to a jump, changed to go to its destination
 };
 
 class ObjectGenerator {
@@ -96,11 +98,13 @@ class ObjectGenerator {
                                     const FunctionRecord& target_func);
   ObjectGeneratorStats get_stats() const;
   void count_eliminated_move();
+  void count_eliminated_jump();
 
   GameVersion version() const { return m_version; }
 
  private:
   void handle_temp_static_type_links(int seg);
+  void thread_temp_jump_links(int seg);
   void handle_temp_jump_links(int seg);
   void handle_temp_instr_sym_links(int seg);
   void handle_temp_static_sym_links(int seg);
@@ -108,6 +112,16 @@ class ObjectGenerator {
   void handle_temp_rip_func_links(int seg);
   void handle_temp_static_ptr_links(int seg);
 
+  int link_name_id(const std::string& name);
+  template <typename T>
+  void add_named_link(std::vector<std::vector<T>>& links, int name_id, const T& link) {
+    if (name_id >= (int)links.size()) {
+      links.resize(name_id + 1);
+    }
+    links[name_id].push_back(link);
+  }
+
+  size_t link_table_size(int seg) const;
   void emit_link_table(int seg, const TypeSystem* ts);
   void emit_link_type_pointer(int seg, const TypeSystem* ts);
   void emit_link_symbol(int seg);
@@ -206,8 +220,10 @@ class ObjectGenerator {
   template <typename T>
   using seg_vector = std::array<std::vector<T>, N_SEG>;
 
+  // links to symbols and types are stored by the id of the name from link_name_id, so adding one
+  // doesn't have to look up the name in a map. Names are only sorted to build the link table.
   template <typename T>
-  using seg_map = std::array<std::map<std::string, std::vector<T>>, N_SEG>;
+  using seg_map = std::array<std::vector<std::vector<T>>, N_SEG>;
   GameVersion m_version;
 
   // final data
@@ -236,6 +252,10 @@ class ObjectGenerator {
 
   std::vector<FunctionRecord> m_all_function_records;
 
+  std::unordered_map<std::string, int> m_link_name_ids;
+  std::vector<std::string> m_link_names;
+  std::vector<int> m_sorted_link_name_ids;  // filled when generating the link tables.
+
   ObjectGeneratorStats m_stats;
 };
 }  // namespace emitter
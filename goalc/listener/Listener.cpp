@@ -28,6 +28,7 @@
 
 #include "common/cross_sockets/XSocket.h"
 #include "common/util/Assert.h"
+#include "common/util/compress.h"
 #include "common/versions/versions.h"
 #include "common/log/log.h"
 
@@ -38,6 +39,8 @@
 
 using namespace versions;
 constexpr bool debug_listener = false;
+// code smaller than this is sent uncompressed, it's not worth the time.
+constexpr size_t MIN_COMPRESSED_CODE_SIZE = 4096;
 
 namespace listener {
 Listener::Listener() {
@@ -352,7 +355,20 @@ int Listener::get_received_message_count() {
  */
 void Listener::send_code(std::vector<uint8_t>& code, const std::optional<std::string>& load_name) {
   got_ack = false;
-  int total_size = code.size() + sizeof(ListenerMessageHeader);
+  // compressing the big objects makes them faster to send, and lets them fit in the target's
+  // message buffer.
+  const std::vector<uint8_t>* data = &code;
+  std::vector<uint8_t> compressed;
+  auto kind = LTT_MSG_CODE;
+  if (code.size() >= MIN_COMPRESSED_CODE_SIZE) {
+    compressed = compression::compress_zstd(code.data(), code.size());
+    if (compressed.size() < code.size()) {
+      data = &compressed;
+      kind = LTT_MSG_CODE_ZSTD;
+    }
+  }
+
+  int total_size = data->size() + sizeof(ListenerMessageHeader);
   if (total_size > BUFFER_SIZE) {
     printf("[ERROR] Listener send_code got too big of a message\n");
     return;
@@ -369,12 +385,12 @@ void Listener::send_code(std::vector<uint8_t>& code, const std::optional<std::st
   header->deci2_header.proto = DECI2_PROTOCOL;
   header->deci2_header.src = 'H';
   header->deci2_header.dst = 'E';
-  header->msg_size = code.size();
-  header->ltt_msg_kind = LTT_MSG_CODE;
+  header->msg_size = data->size();
+  header->ltt_msg_kind = kind;
   header->u6 = 0;
   last_sent_id++;
   header->msg_id = last_sent_id;
-  memcpy(buffer_data, code.data(), code.size());
+  memcpy(buffer_data, data->data(), data->size());
   send_buffer(total_size);
 }
 
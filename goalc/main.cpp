@@ -24,15 +24,37 @@ void setup_logging() {
   lg::initialize();
 }
 
+/*!
+ * The newest write time of the files that the compiler reads when it starts up. If this changes,
+ * the macros and types a warm compiler has loaded may be out of date.
+ */
+fs::file_time_type startup_files_time(GameVersion version) {
+  auto game_dir = file_util::get_jak_project_dir() / "goal_src" / version_to_game_name(version);
+  const fs::path files[] = {file_util::get_jak_project_dir() / "goal_src" / "goal-lib.gc",
+                            game_dir / "compiler-setup.gc", game_dir / "kernel-defs.gc",
+                            game_dir / "game.gp"};
+  fs::file_time_type newest = fs::file_time_type::min();
+  for (auto& file : files) {
+    std::error_code ec;
+    auto time = fs::last_write_time(file, ec);
+    if (!ec) {
+      newest = std::max(newest, time);
+    }
+  }
+  return newest;
+}
+
 int main(int argc, char** argv) {
   ArgumentGuard u8_guard(argc, argv);
 
   bool auto_mi_exit = false;
   bool auto_find_user = false;
+  bool server_mode = false;
   std::string cmd = "";
   std::string username = "#f";
   std::string game = "jak1";
   int nrepl_port = -1;
+  int jobs = 1;
   fs::path project_path_override;
 
   // TODO - a lot of these flags could be deprecated and moved into `repl-config.json`
@@ -50,6 +72,11 @@ int main(int argc, char** argv) {
                  "Specify the location of the 'data/' folder");
   app.add_option("--auto-mi-exit", auto_mi_exit,
                  "Attempt to automatically mi and exit");
+  app.add_flag("--server", server_mode,
+               "Don't read from the terminal, only take commands from nREPL. The compiler reloads "
+               "itself when goal-lib or the game's compiler setup files change");
+  app.add_option("-j,--jobs", jobs,
+                 "How many build steps (other than GOAL files) the make system can run at once");
   app.validate_positionals();
   CLI11_PARSE(app, argc, argv);
 
@@ -104,6 +131,7 @@ int main(int argc, char** argv) {
   try {
     if (!cmd.empty()) {
       compiler = std::make_unique<Compiler>(game_version);
+      compiler->make_system().set_jobs(jobs);
       compiler->run_front_end_on_string(cmd);
       return 0;
     }
@@ -115,6 +143,7 @@ int main(int argc, char** argv) {
     try {
     if (auto_mi_exit) {
       compiler = std::make_unique<Compiler>(game_version);
+      compiler->make_system().set_jobs(jobs);
       compiler->run_front_end_on_string("(mi)");
       compiler->run_front_end_on_string("(e)");
       return 0;
@@ -138,24 +167,53 @@ int main(int argc, char** argv) {
   std::function<bool()> shutdown_callback = [&]() { return status == ReplStatus::WANT_EXIT; };
   ReplServer repl_server(shutdown_callback, nrepl_port);
   bool repl_server_ok = repl_server.init_server();
+  if (server_mode && !repl_server_ok) {
+    lg::error("Server mode needs the nREPL server, but it couldn't be started on port {}",
+              nrepl_port);
+    return 1;
+  }
   std::thread nrepl_thread;
+  auto startup_time = startup_files_time(game_version);
+  // called with compiler_mutex held.
+  auto reload_compiler = [&]() {
+    lg::info("Reloading compiler...");
+    if (compiler) {
+      compiler->save_repl_history();
+    }
+    startup_time = startup_files_time(game_version);
+    compiler = std::make_unique<Compiler>(
+        game_version, std::make_optional(repl_config), username,
+        std::make_unique<REPL::Wrapper>(username, repl_config, startup_file));
+    compiler->make_system().set_jobs(jobs);
+    status = ReplStatus::OK;
+  };
   // the compiler may throw an exception if it fails to load its standard library.
   try {
     compiler = std::make_unique<Compiler>(
         game_version, std::make_optional(repl_config), username,
         std::make_unique<REPL::Wrapper>(username, repl_config, startup_file));
-    // Start nREPL Server if it spun up successfully
+    compiler->make_system().set_jobs(jobs);
+    // Start nREPL Server if it spun up successfully. The server queues forms from its own network
+    // thread, and this thread compiles them. get_msg waits for a form, so this doesn't spin.
     if (repl_server_ok) {
       nrepl_thread = std::thread([&]() {
         while (!shutdown_callback()) {
           auto resp = repl_server.get_msg();
           if (resp) {
             std::lock_guard<std::mutex> lock(compiler_mutex);
+            if (server_mode && startup_files_time(game_version) != startup_time) {
+              try {
+                reload_compiler();
+              } catch (std::exception& e) {
+                lg::error("Compiler Fatal Error: {}", e.what());
+                status = ReplStatus::WANT_EXIT;
+                break;
+              }
+            }
             status = compiler->handle_repl_string(resp.value());
             // Print out the prompt, just for better UX
             compiler->print_to_repl(compiler->get_prompt());
           }
-          std::this_thread::sleep_for(std::chrono::microseconds(50000));
         }
       });
     }
@@ -164,15 +222,12 @@ int main(int argc, char** argv) {
     // Poll Terminal
     while (status != ReplStatus::WANT_EXIT) {
       if (status == ReplStatus::WANT_RELOAD) {
-        lg::info("Reloading compiler...");
         std::lock_guard<std::mutex> lock(compiler_mutex);
-        if (compiler) {
-          compiler->save_repl_history();
-        }
-        compiler = std::make_unique<Compiler>(
-            game_version, std::make_optional(repl_config), username,
-            std::make_unique<REPL::Wrapper>(username, repl_config, startup_file));
-        status = ReplStatus::OK;
+        reload_compiler();
+      }
+      if (server_mode) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        continue;
       }
       // process user input
       std::string input_from_stdin = compiler->get_repl_input();
@@ -1,5 +1,10 @@
 #include "MakeSystem.h"
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
 #include "common/goos/ParseHelpers.h"
 #include "common/log/log.h"
 #include "common/util/FileUtil.h"
@@ -383,7 +388,9 @@ std::vector<std::string> MakeSystem::filter_dependencies(const std::vector<std::
 
     bool added = false;
 
-    if (tool->needs_run(task, m_path_map)) {
+    if (tool->needs_run(task, m_path_map) &&
+        !(tool->can_use_hash_cache() &&
+          m_hash_cache.up_to_date(to_make, hashed_inputs(*rule, *tool), rule->outputs))) {
       result.push_back(to_make);
       stale_deps.insert(to_make);
       added = true;
@@ -435,10 +442,176 @@ void print_input(const std::vector<std::string>& in, char end) {
     lg::print("{}{}{}", all_names, std::string(70 - all_names.length(), ' '), end);
   }
 }
+
+void print_step_done(int percent,
+                     const std::string& tool_name,
+                     const std::vector<std::string>& input,
+                     double seconds) {
+  if (seconds > 0.05) {
+    lg::print("[{:3d}%] [{:8s}] ", percent, tool_name);
+    lg::print(fg(fmt::color::yellow), "{:.3f} ", seconds);
+    print_input(input, '\n');
+  } else {
+    lg::print("[{:3d}%] [{:8s}] {:.3f} ", percent, tool_name, seconds);
+    print_input(input, '\n');
+  }
+}
 }  // namespace
 
+/*!
+ * The files that decide if a step can be skipped by the hash cache.
+ */
+std::vector<std::string> MakeSystem::hashed_inputs(MakeStep& rule, Tool& tool) const {
+  std::vector<std::string> files = rule.input;
+  files.insert(files.end(), rule.deps.begin(), rule.deps.end());
+  const ToolInput task = {rule.input, rule.deps, rule.outputs, rule.arg};
+  auto additional = tool.get_additional_dependencies(task, m_path_map);
+  files.insert(files.end(), additional.begin(), additional.end());
+  auto sources = tool.get_source_dependencies(task, m_path_map);
+  files.insert(files.end(), sources.begin(), sources.end());
+  return files;
+}
+
+/*!
+ * Run the step that makes to_make, and remember its files in the hash cache if it built. Safe to
+ * call from a worker thread if the step's tool can run in parallel.
+ */
+bool MakeSystem::run_step(const std::string& to_make) {
+  auto& rule = *m_output_to_step.at(to_make);
+  auto& tool = *m_tools.at(rule.tool);
+  bool success = false;
+  try {
+    success = tool.run({rule.input, rule.deps, rule.outputs, rule.arg}, m_path_map);
+  } catch (std::exception& e) {
+    lg::print("\n");
+    lg::print("Error: {}\n", e.what());
+  }
+  if (!success) {
+    lg::print("Build failed on {}{}\n", rule.input.at(0), rule.input.size() > 1 ? ", ..." : "");
+  } else if (tool.can_use_hash_cache()) {
+    m_hash_cache.update(to_make, hashed_inputs(rule, tool), rule.outputs);
+  }
+  return success;
+}
+
+/*!
+ * Build the steps in deps, which are in dependency order. Steps that can run in parallel are run on
+ * m_jobs worker threads as soon as their dependencies are built. The others are run on this thread
+ * in the same order as a serial build.
+ */
+void MakeSystem::make_parallel(const std::vector<std::string>& deps) {
+  struct Job {
+    MakeStep* rule = nullptr;
+    Tool* tool = nullptr;
+    std::vector<int> dependents;
+    int waiting_on = 0;
+  };
+  std::vector<Job> jobs(deps.size());
+  std::unordered_map<std::string, int> output_to_job;
+  for (size_t i = 0; i < deps.size(); i++) {
+    jobs[i].rule = m_output_to_step.at(deps[i]).get();
+    jobs[i].tool = m_tools.at(jobs[i].rule->tool).get();
+    for (auto& out : jobs[i].rule->outputs) {
+      output_to_job[out] = i;
+    }
+  }
+
+  std::deque<int> ready;
+  std::vector<int> serial_jobs;
+  for (size_t i = 0; i < deps.size(); i++) {
+    auto& job = jobs[i];
+    auto dep_names = job.tool->get_additional_dependencies(
+        {job.rule->input, job.rule->deps, job.rule->outputs, job.rule->arg}, m_path_map);
+    dep_names.insert(dep_names.end(), job.rule->deps.begin(), job.rule->deps.end());
+    std::unordered_set<int> dep_jobs;
+    for (auto& name : dep_names) {
+      auto it = output_to_job.find(name);
+      if (it != output_to_job.end() && it->second != (int)i && dep_jobs.insert(it->second).second) {
+        jobs[it->second].dependents.push_back(i);
+        job.waiting_on++;
+      }
+    }
+    if (!job.tool->can_run_in_parallel()) {
+      serial_jobs.push_back(i);
+    } else if (job.waiting_on == 0) {
+      ready.push_back(i);
+    }
+  }
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  size_t finished = 0;
+  bool failed = false;
+
+  // called with the lock held.
+  auto finish = [&](int idx, bool success, double seconds) {
+    auto& job = jobs[idx];
+    finished++;
+    if (!success) {
+      failed = true;
+    } else {
+      int percent = (100.0 * finished / deps.size()) + 0.5;
+      print_step_done(percent, job.tool->name(), job.rule->input, seconds);
+      for (int d : job.dependents) {
+        if (--jobs[d].waiting_on == 0 && jobs[d].tool->can_run_in_parallel()) {
+          ready.push_back(d);
+        }
+      }
+    }
+    cv.notify_all();
+  };
+
+  auto done = [&]() { return failed || finished == deps.size(); };
+
+  std::vector<std::thread> workers;
+  for (int i = 0; i < m_jobs; i++) {
+    workers.emplace_back([&]() {
+      std::unique_lock<std::mutex> lock(mutex);
+      while (true) {
+        cv.wait(lock, [&]() { return done() || !ready.empty(); });
+        if (done()) {
+          return;
+        }
+        int idx = ready.front();
+        ready.pop_front();
+        lock.unlock();
+        Timer step_timer;
+        bool success = run_step(deps[idx]);
+        lock.lock();
+        finish(idx, success, step_timer.getSeconds());
+      }
+    });
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (int idx : serial_jobs) {
+      cv.wait(lock, [&]() { return done() || jobs[idx].waiting_on == 0; });
+      if (done()) {
+        break;
+      }
+      lock.unlock();
+      Timer step_timer;
+      bool success = run_step(deps[idx]);
+      lock.lock();
+      finish(idx, success, step_timer.getSeconds());
+    }
+    cv.wait(lock, done);
+  }
+
+  for (auto& t : workers) {
+    t.join();
+  }
+  m_hash_cache.save();
+  if (failed) {
+    throw std::runtime_error("Build failed.");
+  }
+}
+
 bool MakeSystem::make(const std::string& target_in, bool force, bool verbose) {
   std::string target = m_path_map.apply_remaps(target_in);
+  m_hash_cache.load(file_util::get_jak_project_dir() / "out" / m_path_map.output_prefix /
+                    "build-hashes.txt");
   auto deps = get_dependencies(target);
   //  lg::print("All deps:\n");
   //  for (auto& dep : deps) {
@@ -455,6 +628,12 @@ bool MakeSystem::make(const std::string& target_in, bool force, bool verbose) {
 
   Timer make_timer;
   lg::print("Building {} targets...\n", deps.size());
+  if (m_jobs > 1) {
+    make_parallel(deps);
+    lg::print("\nSuccessfully built all {} targets in {:.3f}s\n", deps.size(),
+              make_timer.getSeconds());
+    return true;
+  }
   int i = 0;
   for (auto& to_make : deps) {
     Timer step_timer;
@@ -469,15 +648,8 @@ bool MakeSystem::make(const std::string& target_in, bool force, bool verbose) {
       print_input(rule->input, '\r');
     }
 
-    bool success = false;
-    try {
-      success = tool->run({rule->input, rule->deps, rule->outputs, rule->arg}, m_path_map);
-    } catch (std::exception& e) {
-      lg::print("\n");
-      lg::print("Error: {}\n", e.what());
-    }
-    if (!success) {
-      lg::print("Build failed on {}{}\n", rule->input.at(0), rule->input.size() > 1 ? ", ..." : "");
+    if (!run_step(to_make)) {
+      m_hash_cache.save();
       throw std::runtime_error("Build failed.");
       return false;
     }
@@ -489,16 +661,10 @@ bool MakeSystem::make(const std::string& target_in, bool force, bool verbose) {
         lg::print(" {:.3f}\n", step_timer.getSeconds());
       }
     } else {
-      if (step_timer.getSeconds() > 0.05) {
-        lg::print("[{:3d}%] [{:8s}] ", percent, tool->name());
-        lg::print(fg(fmt::color::yellow), "{:.3f} ", step_timer.getSeconds());
-        print_input(rule->input, '\n');
-      } else {
-        lg::print("[{:3d}%] [{:8s}] {:.3f} ", percent, tool->name(), step_timer.getSeconds());
-        print_input(rule->input, '\n');
-      }
+      print_step_done(percent, tool->name(), rule->input, step_timer.getSeconds());
     }
   }
+  m_hash_cache.save();
   lg::print("\nSuccessfully built all {} targets in {:.3f}s\n", deps.size(),
             make_timer.getSeconds());
   return true;
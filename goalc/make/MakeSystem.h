@@ -59,6 +59,12 @@ class MakeSystem {
 
   bool make(const std::string& target, bool force, bool verbose);
 
+  /*!
+   * Set how many steps can build at once. Steps whose tool can run in parallel go to a pool of this
+   * many threads, and the rest (like the compiler) still run one at a time, in order.
+   */
+  void set_jobs(int jobs) { m_jobs = jobs; }
+
   void add_tool(std::shared_ptr<Tool> tool);
   void set_constant(const std::string& name, const std::string& value);
   void set_constant(const std::string& name, bool value);
@@ -87,6 +93,10 @@ class MakeSystem {
                         std::vector<std::string>* result_order,
                         std::unordered_set<std::string>* result_set) const;
 
+  void make_parallel(const std::vector<std::string>& deps);
+  bool run_step(const std::string& to_make);
+  std::vector<std::string> hashed_inputs(MakeStep& rule, Tool& tool) const;
+
   goos::Interpreter m_goos;
 
   std::optional<REPL::Config> m_repl_config;
@@ -96,4 +106,6 @@ class MakeSystem {
   PathMap m_path_map;
   std::vector<std::string> m_gsrc_folder;
   std::map<std::string, std::string> m_gsrc_files = {};
+  int m_jobs = 1;
+  BuildHashCache m_hash_cache;
 };
@@ -3,7 +3,10 @@
 
 #include <chrono>
 
+#include "common/log/log.h"
 #include "common/util/FileUtil.h"
+#include "common/util/crc32.h"
+#include "common/util/string_util.h"
 
 #include "third-party/fmt/core.h"
 
@@ -32,6 +35,18 @@ bool Tool::needs_run(const ToolInput& task, const PathMap& path_map) {
       }
     }
 
+    for (auto& dep : get_source_dependencies(task, path_map)) {
+      auto dep_path = fs::path(file_util::get_file_path({dep}));
+      if (fs::exists(dep_path)) {
+        auto dep_time = fs::last_write_time(dep_path);
+        if (dep_time > newest_input) {
+          newest_input = dep_time;
+        }
+      } else {
+        return true;  // don't have a dep.
+      }
+    }
+
     for (auto& dep : get_additional_dependencies(task, path_map)) {
       auto dep_path = fs::path(file_util::get_file_path({dep}));
       if (fs::exists(dep_path)) {
@@ -60,6 +75,105 @@ bool Tool::needs_run(const ToolInput& task, const PathMap& path_map) {
   return false;
 }
 
+namespace {
+/*!
+ * Hash the names and contents of the files. Returns nullopt if one of them doesn't exist.
+ */
+std::optional<u64> hash_files(const std::vector<std::string>& files) {
+  std::vector<u8> hashes;
+  for (auto& file : files) {
+    auto path = fs::path(file_util::get_file_path({file}));
+    if (!fs::exists(path)) {
+      return std::nullopt;
+    }
+    auto data = file_util::read_binary_file(path);
+    u64 file_hash = ((u64)crc32(data.data(), data.size()) << 32) | (u32)data.size();
+    u32 name_hash = crc32((const u8*)file.data(), file.size());
+    hashes.insert(hashes.end(), (u8*)&file_hash, (u8*)(&file_hash + 1));
+    hashes.insert(hashes.end(), (u8*)&name_hash, (u8*)(&name_hash + 1));
+  }
+  // two crc32s with different starting data, so one collision isn't enough to skip a build.
+  u32 lo = crc32(hashes.data(), hashes.size());
+  hashes.push_back(0x5a);
+  u32 hi = crc32(hashes.data(), hashes.size());
+  return ((u64)hi << 32) | lo;
+}
+}  // namespace
+
+void BuildHashCache::load(const fs::path& path) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (path == m_path) {
+    return;
+  }
+  m_path = path;
+  m_entries.clear();
+  m_dirty = false;
+  if (!fs::exists(path)) {
+    return;
+  }
+  for (auto& line : str_util::split(file_util::read_text_file(path))) {
+    auto parts = str_util::split(line, ' ');
+    if (parts.size() != 3) {
+      continue;
+    }
+    Entry entry;
+    entry.input_hash = std::stoull(parts[0], nullptr, 16);
+    entry.output_hash = std::stoull(parts[1], nullptr, 16);
+    m_entries[parts[2]] = entry;
+  }
+}
+
+void BuildHashCache::save() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (!m_dirty || m_path.empty()) {
+    return;
+  }
+  std::string text;
+  for (auto& [step, entry] : m_entries) {
+    text += fmt::format("{:016x} {:016x} {}\n", entry.input_hash, entry.output_hash, step);
+  }
+  try {
+    file_util::create_dir_if_needed_for_file(m_path);
+    file_util::write_text_file(m_path, text);
+    m_dirty = false;
+  } catch (std::exception& e) {
+    lg::warn("Failed to save build hash cache {}: {}", m_path.string(), e.what());
+  }
+}
+
+bool BuildHashCache::up_to_date(const std::string& step,
+                                const std::vector<std::string>& inputs,
+                                const std::vector<std::string>& outputs) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_entries.find(step) == m_entries.end()) {
+      return false;
+    }
+  }
+  auto input_hash = hash_files(inputs);
+  auto output_hash = hash_files(outputs);
+  if (!input_hash || !output_hash) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(m_mutex);
+  const auto& entry = m_entries.at(step);
+  return entry.input_hash == *input_hash && entry.output_hash == *output_hash;
+}
+
+void BuildHashCache::update(const std::string& step,
+                            const std::vector<std::string>& inputs,
+                            const std::vector<std::string>& outputs) {
+  auto input_hash = hash_files(inputs);
+  auto output_hash = hash_files(outputs);
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (input_hash && output_hash) {
+    m_entries[step] = {*input_hash, *output_hash};
+  } else {
+    m_entries.erase(step);
+  }
+  m_dirty = true;
+}
+
 std::string PathMap::apply_remaps(const std::string& input) const {
   if (!input.empty() && input[0] == '$') {
     std::string prefix = "$";
@@ -1,10 +1,14 @@
 #pragma once
 
+#include <mutex>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include "common/common_types.h"
 #include "common/goos/Object.h"
+#include "common/util/FileUtil.h"
 
 struct PathMap {
   std::string output_prefix;
@@ -27,7 +31,17 @@ class Tool {
                                                                const PathMap& /*path_map*/) {
     return {};
   }
+  // files read by the step that aren't made by another step, like the files listed in a project.
+  virtual std::vector<std::string> get_source_dependencies(const ToolInput&,
+                                                           const PathMap& /*path_map*/) {
+    return {};
+  }
   virtual bool needs_run(const ToolInput& task, const PathMap& path_map);
+  // if true, run may be called from a worker thread while other steps are running.
+  virtual bool can_run_in_parallel() const { return false; }
+  // if true, needs_run only looks at the task's files, so the contents of those files decide if a
+  // step built by this tool is up to date.
+  virtual bool can_use_hash_cache() const { return false; }
   virtual ~Tool() = default;
 
   const std::string& name() const { return m_name; }
@@ -35,3 +49,31 @@ class Tool {
  private:
   std::string m_name;
 };
+
+/*!
+ * Remembers a hash of each step's input and output files after it builds. When the timestamps say
+ * a step is stale (like on a fresh checkout), but the files hash the same as the last build, the
+ * step can be skipped.
+ */
+class BuildHashCache {
+ public:
+  void load(const fs::path& path);
+  void save();
+  bool up_to_date(const std::string& step,
+                  const std::vector<std::string>& inputs,
+                  const std::vector<std::string>& outputs);
+  void update(const std::string& step,
+              const std::vector<std::string>& inputs,
+              const std::vector<std::string>& outputs);
+
+ private:
+  struct Entry {
+    u64 input_hash = 0;
+    u64 output_hash = 0;
+  };
+
+  std::mutex m_mutex;
+  fs::path m_path;
+  std::unordered_map<std::string, Entry> m_entries;
+  bool m_dirty = false;
+};
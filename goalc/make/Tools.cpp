@@ -85,7 +85,9 @@ bool DgoTool::run(const ToolInput& task, const PathMap& path_map) {
   if (task.input.size() != 1) {
     throw std::runtime_error(fmt::format("Invalid amount of inputs to {} tool", name()));
   }
-  auto desc = parse_desc_file(task.input.at(0), m_reader);
+  // these can run on worker threads, so each call gets its own reader.
+  goos::Reader reader;
+  auto desc = parse_desc_file(task.input.at(0), reader);
   build_dgo(desc, path_map.output_prefix);
   return true;
 }
@@ -93,7 +95,8 @@ bool DgoTool::run(const ToolInput& task, const PathMap& path_map) {
 std::vector<std::string> DgoTool::get_additional_dependencies(const ToolInput& task,
                                                               const PathMap& path_map) {
   std::vector<std::string> result;
-  auto desc = parse_desc_file(task.input.at(0), m_reader);
+  goos::Reader reader;
+  auto desc = parse_desc_file(task.input.at(0), reader);
   for (auto& x : desc.entries) {
     // todo out
     result.push_back(fmt::format("out/{}obj/{}", path_map.output_prefix, x.file_name));
@@ -136,7 +139,8 @@ bool GameCntTool::run(const ToolInput& task, const PathMap& path_map) {
 
 TextTool::TextTool() : Tool("text") {}
 
-bool TextTool::needs_run(const ToolInput& task, const PathMap& path_map) {
+std::vector<std::string> TextTool::get_source_dependencies(const ToolInput& task,
+                                                           const PathMap& path_map) {
   if (task.input.size() != 1) {
     throw std::runtime_error(fmt::format("Invalid amount of inputs to {} tool", name()));
   }
@@ -147,7 +151,7 @@ bool TextTool::needs_run(const ToolInput& task, const PathMap& path_map) {
   for (auto& file : files) {
     deps.push_back(path_map.apply_remaps(file.file_path));
   }
-  return Tool::needs_run({task.input, deps, task.output, task.arg}, path_map);
+  return deps;
 }
 
 bool TextTool::run(const ToolInput& task, const PathMap& path_map) {
@@ -169,7 +173,8 @@ bool GroupTool::run(const ToolInput&, const PathMap& /*path_map*/) {
 
 SubtitleTool::SubtitleTool() : Tool("subtitle") {}
 
-bool SubtitleTool::needs_run(const ToolInput& task, const PathMap& path_map) {
+std::vector<std::string> SubtitleTool::get_source_dependencies(const ToolInput& task,
+                                                               const PathMap& path_map) {
   if (task.input.size() != 1) {
     throw std::runtime_error(fmt::format("Invalid amount of inputs to {} tool", name()));
   }
@@ -189,7 +194,7 @@ bool SubtitleTool::needs_run(const ToolInput& task, const PathMap& path_map) {
       }
     }
   }
-  return Tool::needs_run({task.input, deps, task.output, task.arg}, path_map);
+  return deps;
 }
 
 bool SubtitleTool::run(const ToolInput& task, const PathMap& path_map) {
@@ -216,7 +221,8 @@ bool SubtitleTool::run(const ToolInput& task, const PathMap& path_map) {
 
 Subtitle2Tool::Subtitle2Tool() : Tool("subtitle2") {}
 
-bool Subtitle2Tool::needs_run(const ToolInput& task, const PathMap& path_map) {
+std::vector<std::string> Subtitle2Tool::get_source_dependencies(const ToolInput& task,
+                                                                const PathMap& path_map) {
   if (task.input.size() != 1) {
     throw std::runtime_error(fmt::format("Invalid amount of inputs to {} tool", name()));
   }
@@ -227,7 +233,7 @@ bool Subtitle2Tool::needs_run(const ToolInput& task, const PathMap& path_map) {
   for (auto& file : files) {
     deps.push_back(path_map.apply_remaps(file.file_path));
   }
-  return Tool::needs_run({task.input, deps, task.output, task.arg}, path_map);
+  return deps;
 }
 
 bool Subtitle2Tool::run(const ToolInput& task, const PathMap& path_map) {
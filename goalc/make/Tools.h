@@ -20,61 +20,77 @@ class DgoTool : public Tool {
  public:
   DgoTool();
   bool run(const ToolInput& task, const PathMap& path_map) override;
+  bool can_run_in_parallel() const override { return true; }
+  bool can_use_hash_cache() const override { return true; }
   std::vector<std::string> get_additional_dependencies(const ToolInput&,
                                                        const PathMap& path_map) override;
-
- private:
-  goos::Reader m_reader;
 };
 
 class TpageDirTool : public Tool {
  public:
   TpageDirTool();
   bool run(const ToolInput& task, const PathMap& path_map) override;
+  bool can_run_in_parallel() const override { return true; }
+  bool can_use_hash_cache() const override { return true; }
 };
 
 class CopyTool : public Tool {
  public:
   CopyTool();
   bool run(const ToolInput& task, const PathMap& path_map) override;
+  bool can_run_in_parallel() const override { return true; }
+  bool can_use_hash_cache() const override { return true; }
 };
 
 class GameCntTool : public Tool {
  public:
   GameCntTool();
   bool run(const ToolInput& task, const PathMap& path_map) override;
+  bool can_run_in_parallel() const override { return true; }
+  bool can_use_hash_cache() const override { return true; }
 };
 
 class TextTool : public Tool {
  public:
   TextTool();
   bool run(const ToolInput& task, const PathMap& path_map) override;
-  bool needs_run(const ToolInput& task, const PathMap& path_map) override;
+  bool can_run_in_parallel() const override { return true; }
+  bool can_use_hash_cache() const override { return true; }
+  std::vector<std::string> get_source_dependencies(const ToolInput& task,
+                                                   const PathMap& path_map) override;
 };
 
 class GroupTool : public Tool {
  public:
   GroupTool();
   bool run(const ToolInput& task, const PathMap& path_map) override;
+  bool can_run_in_parallel() const override { return true; }
 };
 
 class SubtitleTool : public Tool {
  public:
   SubtitleTool();
   bool run(const ToolInput& task, const PathMap& path_map) override;
-  bool needs_run(const ToolInput& task, const PathMap& path_map) override;
+  bool can_run_in_parallel() const override { return true; }
+  bool can_use_hash_cache() const override { return true; }
+  std::vector<std::string> get_source_dependencies(const ToolInput& task,
+                                                   const PathMap& path_map) override;
 };
 
 class Subtitle2Tool : public Tool {
  public:
   Subtitle2Tool();
   bool run(const ToolInput& task, const PathMap& path_map) override;
-  bool needs_run(const ToolInput& task, const PathMap& path_map) override;
+  bool can_run_in_parallel() const override { return true; }
+  bool can_use_hash_cache() const override { return true; }
+  std::vector<std::string> get_source_dependencies(const ToolInput& task,
+                                                   const PathMap& path_map) override;
 };
 
 class BuildLevelTool : public Tool {
  public:
   BuildLevelTool();
   bool run(const ToolInput& task, const PathMap& path_map) override;
+  bool can_run_in_parallel() const override { return true; }
   bool needs_run(const ToolInput& task, const PathMap& path_map) override;
 };
@@ -1,11 +1,13 @@
 #include "Allocator_v2.h"
 
 #include <algorithm>
+#include <array>
 #include <optional>
 #include <unordered_map>
 
 #include "common/log/log.h"
 #include "common/util/Range.h"
+#include "common/util/Timer.h"
 
 #include "third-party/fmt/core.h"
 
@@ -43,8 +45,12 @@
  - Move Eliminator (try to eliminate move instructions)
  - Allow Read Write Same Reg
 
- Future improvements:
- - Within a basic block, try to drop load/store instructions for stack ops.
+ Very large functions (or all functions, with force_linear_scan) skip the passes above, and instead
+ assign variables with a single linear scan in order of where they become live. See
+ run_linear_scan.
+
+ After assignment, spill loads into a register that already has the value (from an earlier load or
+ store in the same basic block) are dropped. See remove_redundant_stack_loads.
  */
 
 namespace {
@@ -193,6 +199,12 @@ class VarAssignment {
     return stack_reg && (*stack_reg == reg);
   }
 
+  // the temporary register for the stack slot at the given instruction, if there is one.
+  const std::optional<emitter::Register>& stack_slot_reg_at(int instr_idx) const {
+    ASSERT(assigned_to_stack());
+    return m_stack_temp_regs.at(instr_idx - m_first_live);
+  }
+
   // result get
   std::vector<Assignment> make_assignment_vector() const {
     std::vector<Assignment> asses;
@@ -362,13 +374,11 @@ std::vector<Range<s32>> find_live_range_instr(const AllocationInput& input,
 
     ASSERT(block.live.size() == block.instr_idx.size());
     for (uint32_t i = 0; i < block.live.size(); i++) {
-      for (int j = 0; j < block.live[i].size(); j++) {
-        if (block.live[i][j]) {
-          int instr_idx = block.instr_idx.at(i);
-          result.at(j).first() = std::min(result.at(j).first(), instr_idx);
-          result.at(j).last() = std::max(result.at(j).last(), instr_idx);
-        }
-      }
+      int instr_idx = block.instr_idx.at(i);
+      block.live[i].for_each([&](int j) {
+        result.at(j).first() = std::min(result.at(j).first(), instr_idx);
+        result.at(j).last() = std::max(result.at(j).last(), instr_idx);
+      });
     }
   }
 
@@ -414,15 +424,13 @@ std::vector<VarAssignment> initialize_unassigned(const std::vector<Range<s32>>&
     // and liveliness analysis
     ASSERT(block.live.size() == block.instr_idx.size());
     for (uint32_t instr = 0; instr < block.live.size(); instr++) {
-      for (int var = 0; var < block.live[instr].size(); var++) {
-        if (block.live[instr][var]) {
-          result.at(var).mark_live(block.instr_idx.at(instr));
-          auto& i = input.instructions.at(block.instr_idx.at(instr));
-          if (!i.clobber.empty()) {
-            result.at(var).mark_crossing_function();
-          }
+      auto& i = input.instructions.at(block.instr_idx.at(instr));
+      block.live[instr].for_each([&](int var) {
+        result.at(var).mark_live(block.instr_idx.at(instr));
+        if (!i.clobber.empty()) {
+          result.at(var).mark_crossing_function();
         }
-      }
+      });
     }
   }
 
@@ -470,11 +478,13 @@ void do_liveliness_analysis(const AllocationInput& input, RACache* cache) {
   }
 
   // phase 2
+  // liveness flows backward, so visiting the blocks in reverse takes far fewer iterations.
   bool changed = false;
   do {
     changed = false;
-    for (auto& block : cache->control_flow.basic_blocks) {
-      if (block.analyze_liveliness_phase2(cache->control_flow.basic_blocks, input.instructions)) {
+    for (auto it = cache->control_flow.basic_blocks.rbegin();
+         it != cache->control_flow.basic_blocks.rend(); it++) {
+      if (it->analyze_liveliness_phase2(cache->control_flow.basic_blocks, input.instructions)) {
         changed = true;
       }
     }
@@ -591,6 +601,9 @@ bool check_constrained_alloc(RACache* cache, const AllocationInput& in) {
   for (uint32_t i = 0; i < in.instructions.size(); i++) {
     for (auto idx1 : cache->live_per_instruction.at(i)) {
       auto& lr1 = cache->vars.at(idx1);
+      if (!lr1.assigned_to_reg()) {
+        continue;
+      }
       for (auto idx2 : cache->live_per_instruction.at(i)) {
         if (idx1 == idx2) {
           continue;
@@ -1111,10 +1124,288 @@ int run_assignment_on_all_vars(const AllocationInput& input,
   }
   return assigned_count;
 }
+
+/*!
+ * A register that the linear scan can't give to a variable over [start, end]: it holds another
+ * variable, or a spilled variable's temporary at a single instruction.
+ */
+struct LinearScanReservation {
+  int start = -1;
+  int end = -1;  // inclusive
+  int var = -1;
+  bool stack_temp = false;
+};
+
+struct LinearScanRegister {
+  // reservations that start at or before the current position, and haven't ended.
+  std::vector<LinearScanReservation> active;
+  // reservations that start after the current position, from next on, sorted by start.
+  std::vector<LinearScanReservation> pending;
+  size_t next = 0;
+  // instructions that clobber or exclude this register, in order.
+  std::vector<int> clobbered_at;
+  std::vector<int> excluded_at;
+};
+
+struct LinearScanState {
+  std::array<LinearScanRegister, emitter::RegisterInfo::N_REGS> regs;
+  int pos = 0;                              // first_live of the variable being assigned
+  std::vector<bool> reserved_stack_temps;  // per var
+};
+
+void linear_scan_reserve(LinearScanState* ls,
+                         emitter::Register reg,
+                         const LinearScanReservation& res) {
+  if (res.end < ls->pos) {
+    return;  // nothing after this can overlap it.
+  }
+  auto& r = ls->regs.at(reg.id());
+  if (res.start <= ls->pos) {
+    r.active.push_back(res);
+  } else {
+    auto it = std::upper_bound(
+        r.pending.begin() + r.next, r.pending.end(), res,
+        [](const LinearScanReservation& a, const LinearScanReservation& b) {
+          return a.start < b.start;
+        });
+    r.pending.insert(it, res);
+  }
+}
+
+/*!
+ * Reserve the temporary registers of any variables that were put on the stack since last time.
+ * Spilling can also demote other variables, so all of them are checked.
+ */
+void linear_scan_reserve_stack_temps(RACache* cache, LinearScanState* ls) {
+  for (auto& var : cache->vars) {
+    if (!var.assigned_to_stack() || ls->reserved_stack_temps.at(var.var())) {
+      continue;
+    }
+    ls->reserved_stack_temps.at(var.var()) = true;
+    for (int instr = std::max(ls->pos, var.first_live()); instr <= var.last_live(); instr++) {
+      const auto& reg = var.stack_slot_reg_at(instr);
+      if (reg) {
+        linear_scan_reserve(ls, *reg, {instr, instr, var.var(), true});
+      }
+    }
+  }
+}
+
+/*!
+ * Can the variable go in this register? Like check_register_assign, but other variables count as
+ * live over their whole range.
+ */
+bool linear_scan_check_register(const AllocationInput& input,
+                                RACache& cache,
+                                LinearScanState* ls,
+                                const VarAssignment& var,
+                                emitter::Register reg) {
+  auto& r = ls->regs.at(reg.id());
+  const int first = var.first_live();
+  const int last = var.last_live();
+
+  // catch up to the current position
+  while (r.next < r.pending.size() && r.pending[r.next].start <= ls->pos) {
+    r.active.push_back(r.pending[r.next++]);
+  }
+  auto ended = [&](const LinearScanReservation& res) { return res.end < ls->pos; };
+  r.active.erase(std::remove_if(r.active.begin(), r.active.end(), ended), r.active.end());
+
+  // both may use the register at a single instruction, if it's a safe overlap there.
+  auto overlap_ok = [&](const LinearScanReservation& res) {
+    int overlap_start = std::max(first, res.start);
+    int overlap_end = std::min(last, res.end);
+    if (overlap_start > overlap_end) {
+      return true;
+    }
+    return overlap_start == overlap_end && !res.stack_temp &&
+           safe_overlap(input, cache, var, cache.vars.at(res.var), overlap_start);
+  };
+
+  for (const auto& res : r.active) {
+    if (!overlap_ok(res)) {
+      return false;
+    }
+  }
+  for (size_t i = r.next; i < r.pending.size() && r.pending[i].start <= last; i++) {
+    if (!overlap_ok(r.pending[i])) {
+      return false;
+    }
+  }
+
+  auto ex = std::lower_bound(r.excluded_at.begin(), r.excluded_at.end(), first);
+  if (ex != r.excluded_at.end() && *ex <= last) {
+    return false;
+  }
+
+  // same rule as check_register_assign: it's okay to be clobbered where we die, or are written.
+  for (auto it = std::lower_bound(r.clobbered_at.begin(), r.clobbered_at.end(), first);
+       it != r.clobbered_at.end() && *it <= last; it++) {
+    if (var.live(*it) && cache.liveout_per_instr.at(*it)[var.var()] &&
+        !input.instructions.at(*it).writes(var.var())) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/*!
+ * Assign all unassigned variables in one pass, in order of where they become live. Each gets the
+ * first register in its allocation order that's free over its whole live range, and reserves it.
+ * The time for each variable depends on the number of registers and reservations, not the length of
+ * its live range, so this is much faster than run_assignment_on_all_vars for huge functions.
+ * Only moves from an already assigned variable are eliminated, and spills use the same
+ * handle_failed_register_allocation as the passes.
+ */
+void run_linear_scan(const AllocationInput& input,
+                     RACache* cache,
+                     const AssignmentSettings& settings) {
+  cache->stats.assign_passes++;
+  LinearScanState ls;
+  ls.reserved_stack_temps.resize(input.max_vars, false);
+
+  for (int instr_idx = 0; instr_idx < (int)input.instructions.size(); instr_idx++) {
+    const auto& instr = input.instructions[instr_idx];
+    for (auto& reg : instr.clobber) {
+      ls.regs.at(reg.id()).clobbered_at.push_back(instr_idx);
+    }
+    for (auto& reg : instr.exclude) {
+      ls.regs.at(reg.id()).excluded_at.push_back(instr_idx);
+    }
+  }
+
+  std::vector<int> order;
+  for (int var_idx = 0; var_idx < input.max_vars; var_idx++) {
+    const auto& var = cache->vars.at(var_idx);
+    if (!var.seen()) {
+      continue;
+    }
+    if (var.assigned_to_reg()) {
+      // constrained
+      linear_scan_reserve(&ls, var.reg(), {var.first_live(), var.last_live(), var_idx});
+    } else if (var.unassigned()) {
+      order.push_back(var_idx);
+    }
+  }
+  std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+    return cache->vars.at(a).first_live() < cache->vars.at(b).first_live();
+  });
+
+  for (int var_idx : order) {
+    auto& var = cache->vars.at(var_idx);
+    ls.pos = var.first_live();
+    bool can_be_in_register =
+        input.force_on_stack_regs.find(var_idx) == input.force_on_stack_regs.end();
+
+    std::optional<emitter::Register> assigned_reg;
+    auto try_reg = [&](emitter::Register reg) {
+      if (!assigned_reg && linear_scan_check_register(input, *cache, &ls, var, reg)) {
+        assigned_reg = reg;
+      }
+    };
+
+    if (can_be_in_register) {
+      // move eliminate with the other side of a move, if it's already in a register.
+      auto try_move_elim = [&](int other_idx) {
+        const auto& other = cache->vars.at(other_idx);
+        if (other.assigned_to_reg() &&
+            vector_contains(allowable_local_var_move_elim, other.reg())) {
+          try_reg(other.reg());
+        }
+      };
+      const auto& first_instr = input.instructions.at(var.first_live());
+      const auto& last_instr = input.instructions.at(var.last_live());
+      if (first_instr.is_move) {
+        try_move_elim(first_instr.read.front().id);
+      }
+      if (last_instr.is_move) {
+        try_move_elim(last_instr.write.front().id);
+      }
+
+      for (auto reg : get_alloc_order(var_idx, input, *cache, var.crosses_function())) {
+        try_reg(reg);
+      }
+    }
+
+    if (assigned_reg) {
+      var.assign_to_register(*assigned_reg);
+      linear_scan_reserve(&ls, *assigned_reg, {var.first_live(), var.last_live(), var_idx});
+    } else {
+      if (!handle_failed_register_allocation(input, cache, var_idx, settings)) {
+        cache->failed_alloc = true;
+      }
+      linear_scan_reserve_stack_temps(cache, &ls);
+    }
+  }
+}
+
+/*!
+ * Drop stack loads where the register already holds the value in that stack slot, because an
+ * earlier instruction in the basic block loaded or stored it, and nothing has written the register
+ * since. Returns the number of loads removed.
+ */
+int remove_redundant_stack_loads(const AllocationInput& input, RACache* cache) {
+  int removed = 0;
+  for (const auto& block : cache->control_flow.basic_blocks) {
+    // the stack slot that each register has the value of, or -1. Nothing is known at the start of
+    // a block, since we might have jumped there.
+    std::array<int, emitter::RegisterInfo::N_REGS> slot_in_reg;
+    slot_in_reg.fill(-1);
+
+    for (int instr_idx : block.instr_idx) {
+      const auto& instr = input.instructions.at(instr_idx);
+      auto& ops = cache->stack_ops.at(instr_idx).ops;
+      for (auto& op : ops) {
+        if (op.load) {
+          if (slot_in_reg.at(op.reg.id()) == op.slot) {
+            op.load = false;
+            removed++;
+          } else {
+            slot_in_reg.at(op.reg.id()) = op.slot;
+          }
+        }
+      }
+
+      // the instruction writes junk into clobbers and excludes, then writes its results.
+      for (auto& reg : instr.clobber) {
+        slot_in_reg.at(reg.id()) = -1;
+      }
+      for (auto& reg : instr.exclude) {
+        slot_in_reg.at(reg.id()) = -1;
+      }
+      for (auto& wr : instr.write) {
+        const auto& var = cache->vars.at(wr.id);
+        if (var.assigned_to_reg()) {
+          slot_in_reg.at(var.reg().id()) = -1;
+        } else if (var.assigned_to_stack()) {
+          const auto& reg = var.stack_slot_reg_at(instr_idx);
+          if (reg) {
+            slot_in_reg.at(reg->id()) = -1;
+          }
+        }
+      }
+
+      for (auto& op : ops) {
+        if (op.store) {
+          // other registers loaded from this slot have the old value.
+          for (auto& slot : slot_in_reg) {
+            if (slot == op.slot) {
+              slot = -1;
+            }
+          }
+          slot_in_reg.at(op.reg.id()) = op.slot;
+        }
+      }
+    }
+  }
+  return removed;
+}
 }  // namespace
 
 AllocationResult allocate_registers_v2(const AllocationInput& input) {
   AllocationResult result;
+  Timer timer;
 
   // stores internal allocator state
   RACache cache;
@@ -1126,17 +1417,21 @@ AllocationResult allocate_registers_v2(const AllocationInput& input) {
 
   // STEP 1: Analysis:
   do_liveliness_analysis(input, &cache);
+  result.analysis_time_ms = timer.getMs();
 
   // STEP 2: Constrained allocation.
   do_constrained_alloc(&cache, input, input.debug_settings.trace_debug_constraints);
-  check_constrained_alloc(&cache, input);
   if (!check_constrained_alloc(&cache, input)) {
     result.ok = false;
     lg::print("[RegAlloc Error] Register allocation has failed due to bad constraints.\n");
     return result;
   }
 
-  if (torture_test_spills) {
+  result.used_linear_scan = input.force_linear_scan ||
+                            (int)input.instructions.size() >= LINEAR_SCAN_MIN_INSTRUCTIONS;
+  if (result.used_linear_scan) {
+    run_linear_scan(input, &cache, AssignmentSettings());
+  } else if (torture_test_spills) {
     AssignmentSettings pick_up_new_settings;
     run_assignment_on_all_vars(input, &cache, pick_up_new_settings);
   } else {
@@ -1159,6 +1454,7 @@ AllocationResult allocate_registers_v2(const AllocationInput& input) {
 
     run_assignment_on_all_vars(input, &cache, pick_up_new_settings);
   }
+  result.assign_time_ms = timer.getMs() - result.analysis_time_ms;
 
   result.ok = true;
 
@@ -1175,32 +1471,30 @@ AllocationResult allocate_registers_v2(const AllocationInput& input) {
     }
   }
 
+  cache.stats.num_spill_ops -= remove_redundant_stack_loads(input, &cache);
+
   result.needs_aligned_stack_for_spills = cache.used_stack;
   result.stack_slots_for_spills = cache.current_stack_slot;
   result.stack_slots_for_vars = input.stack_slots_for_stack_vars;
 
   // check for use of saved registers
-  for (auto sr : emitter::gRegInfo.get_all_saved()) {
-    bool uses_sr = false;
-    for (auto& lr : cache.vars) {
+  std::array<bool, emitter::RegisterInfo::N_REGS> used_regs = {};
+  for (auto& lr : cache.vars) {
+    if (lr.assigned_to_reg()) {
+      if (lr.first_live() <= lr.last_live()) {
+        used_regs.at(lr.reg().id()) = true;
+      }
+    } else if (lr.assigned_to_stack()) {
       for (int instr_idx = lr.first_live(); instr_idx <= lr.last_live(); instr_idx++) {
-        if (lr.assigned_to_reg()) {
-          if (lr.assigned_to_reg(sr)) {
-            uses_sr = true;
-            break;
-          }
-        } else if (lr.assigned_to_stack()) {
-          if (lr.stack_bonus_op_needs_reg(sr, instr_idx)) {
-            uses_sr = true;
-            break;
-          }
+        const auto& reg = lr.stack_slot_reg_at(instr_idx);
+        if (reg) {
+          used_regs.at(reg->id()) = true;
         }
       }
-      if (uses_sr) {
-        break;
-      }
     }
-    if (uses_sr) {
+  }
+  for (auto sr : emitter::gRegInfo.get_all_saved()) {
+    if (used_regs.at(sr.id())) {
       result.used_saved_regs.push_back(sr);
     }
   }
@@ -2,5 +2,9 @@
 
 #include "goalc/regalloc/allocator_interface.h"
 
+// Functions with at least this many instructions are assigned with a single linear scan instead of
+// the usual passes. It's much faster on huge functions, but spills more and eliminates fewer moves.
+constexpr int LINEAR_SCAN_MIN_INSTRUCTIONS = 5000;
+
 // Allocator v2's interface
 AllocationResult allocate_registers_v2(const AllocationInput& input);
@@ -88,6 +88,22 @@ class IRegSet {
 
   bool operator!=(const IRegSet& other) const { return !((*this) == other); }
 
+  /*!
+   * Call f with each ireg in the set, in increasing order.
+   * Skips empty words, so this is much faster than checking each ireg in sparse sets.
+   */
+  template <typename F>
+  void for_each(F&& f) const {
+    for (size_t word = 0; word < m_data.size(); word++) {
+      int x = word * 64;
+      for (u64 bits = m_data[word]; bits; bits >>= 1, x++) {
+        if (bits & 1) {
+          f(x);
+        }
+      }
+    }
+  }
+
   void resize(int bits) {
     if (bits > m_bits) {
       auto new_vector_size = (bits + 63) / 64;
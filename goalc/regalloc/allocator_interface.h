@@ -135,6 +135,11 @@ struct AllocationResult {
   int num_spills = 0;
   int num_spilled_vars = 0;
 
+  // how this function was allocated, for the compiler's stats.
+  bool used_linear_scan = false;
+  double analysis_time_ms = 0;
+  double assign_time_ms = 0;
+
   // we put the variables before the spills so the variables are 16-byte aligned.
 
   int total_stack_slots() const { return stack_slots_for_spills + stack_slots_for_vars; }
@@ -166,6 +171,9 @@ struct AllocationInput {
 
   int allocator_version = 1;
 
+  // use the linear scan assignment for this function, even if it's small. (see Allocator_v2.h)
+  bool force_linear_scan = false;
+
   struct {
     bool print_input = false;
     bool print_analysis = false;
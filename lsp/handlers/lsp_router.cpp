@@ -48,6 +48,7 @@ void LSPRouter::init_routes() {
   m_routes["textDocument/completion"] = LSPRoute(get_completions_handler);
   m_routes["textDocument/documentColor"] = LSPRoute(document_color_handler);
   m_routes["textDocument/formatting"] = LSPRoute(formatting_handler);
+  m_routes["textDocument/rangeFormatting"] = LSPRoute(range_formatting_handler);
   // TODO - m_routes["textDocument/signatureHelp"] = LSPRoute(get_completions_handler);
   // Not Yet Supported Routes, noops
   m_routes["$/cancelRequest"] = LSPRoute();
@@ -9,10 +9,6 @@
 
 std::optional<json> get_completions_handler(Workspace& workspace, int id, json params) {
   auto converted_params = params.get<LSPSpec::CompletionParams>();
-
-  // TODO - these need to be cached,
-
-  // TODO - implement response object
-
-  return json::array();
+  return workspace.get_completions(converted_params.m_textDocument.m_uri,
+                                   converted_params.m_position);
 }
@@ -21,7 +21,8 @@ std::optional<json> formatting_handler(Workspace& workspace, int id, json raw_pa
       return nullptr;
     }
     // TODO move away from holding the content directly
-    const auto result = formatter::format_code(tracked_file->m_content);
+    const auto result =
+        workspace.get_formatter(params.textDocument.m_uri).format(tracked_file->m_content);
     if (!result) {
       return nullptr;
     }
@@ -35,3 +36,31 @@ std::optional<json> formatting_handler(Workspace& workspace, int id, json raw_pa
 
   return nullptr;
 }
+
+std::optional<json> range_formatting_handler(Workspace& workspace, int id, json raw_params) {
+  auto params = raw_params.get<LSPSpec::DocumentRangeFormattingParams>();
+  const auto file_type = workspace.determine_filetype_from_uri(params.textDocument.m_uri);
+
+  if (file_type == Workspace::FileType::OpenGOAL) {
+    auto tracked_file = workspace.get_tracked_og_file(params.textDocument.m_uri);
+    if (!tracked_file) {
+      return nullptr;
+    }
+    const auto result = workspace.get_formatter(params.textDocument.m_uri)
+                            .format_range(tracked_file->m_content, params.range.m_start.m_line,
+                                          params.range.m_end.m_line);
+    if (!result || result->end_line >= tracked_file->m_lines.size()) {
+      return nullptr;
+    }
+    json edits = json::array();
+    auto format_edit = LSPSpec::TextEdit();
+    format_edit.range = {
+        {result->start_line, 0},
+        {result->end_line, (uint32_t)tracked_file->m_lines.at(result->end_line).length()}};
+    format_edit.newText = result->text;
+    edits.push_back(format_edit);
+    return edits;
+  }
+
+  return nullptr;
+}
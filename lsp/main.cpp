@@ -19,6 +19,7 @@
 #include "lsp/state/workspace.h"
 #include "lsp/transport/stdio.h"
 #include "lsp/state/app.h"
+#include "lsp/state/lsp_requester.h"
 
 #include "third-party/CLI11.hpp"
 
@@ -104,7 +105,7 @@ int main(int argc, char** argv) {
         auto responses = lsp_router.route_message(message_buffer, appstate);
         if (responses) {
           for (const auto& response : responses.value()) {
-            std::cout << response.c_str() << std::flush;
+            LSPRequester::write_message(response);
             if (appstate.verbose) {
               lg::debug("<<< Sending message: {}", response);
             } else {
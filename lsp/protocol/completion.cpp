@@ -9,6 +9,65 @@ void LSPSpec::from_json(const json& j, CompletionParams& obj) {
   j.at("position").get_to(obj.m_position);
 }
 
-void LSPSpec::to_json(json& j, const CompletionList& obj) {}
+void LSPSpec::to_json(json& j, const CompletionItem& obj) {
+  j = json{{"label", obj.label}};
+  if (obj.labelDetails) {
+    json details = json::object();
+    if (obj.labelDetails->detail) {
+      details["detail"] = obj.labelDetails->detail.value();
+    }
+    if (obj.labelDetails->description) {
+      details["description"] = obj.labelDetails->description.value();
+    }
+    j["labelDetails"] = details;
+  }
+  if (obj.kind) {
+    j["kind"] = obj.kind.value();
+  }
+  if (obj.tags) {
+    j["tags"] = obj.tags.value();
+  }
+  if (obj.detail) {
+    j["detail"] = obj.detail.value();
+  }
+  if (obj.documentation) {
+    j["documentation"] = obj.documentation.value();
+  }
+  if (obj.preselect) {
+    j["preselect"] = obj.preselect.value();
+  }
+  if (obj.sortText) {
+    j["sortText"] = obj.sortText.value();
+  }
+  if (obj.filterText) {
+    j["filterText"] = obj.filterText.value();
+  }
+}
+
+void LSPSpec::from_json(const json& j, CompletionItem& obj) {
+  j.at("label").get_to(obj.label);
+  if (j.contains("kind")) {
+    obj.kind = j.at("kind").get<CompletionItemKind>();
+  }
+  if (j.contains("detail")) {
+    obj.detail = j.at("detail").get<std::string>();
+  }
+  if (j.contains("documentation") && j.at("documentation").is_string()) {
+    obj.documentation = j.at("documentation").get<std::string>();
+  }
+  if (j.contains("sortText")) {
+    obj.sortText = j.at("sortText").get<std::string>();
+  }
+  if (j.contains("filterText")) {
+    obj.filterText = j.at("filterText").get<std::string>();
+  }
+}
 
-void LSPSpec::from_json(const json& j, CompletionList& obj) {}
+void LSPSpec::to_json(json& j, const CompletionList& obj) {
+  j = json{{"isIncomplete", obj.m_isIncomplete}, {"items", obj.m_items}};
+}
+
+void LSPSpec::from_json(const json& j, CompletionList& obj) {
+  j.at("isIncomplete").get_to(obj.m_isIncomplete);
+  j.at("items").get_to(obj.m_items);
+}
@@ -111,6 +111,9 @@ struct CompletionItem {
   // TODO - a lot of other fields...
 };
 
+void to_json(json& j, const CompletionItem& obj);
+void from_json(const json& j, CompletionItem& obj);
+
 struct CompletionList {
   /// This list is not complete. Further typing should result in recomputing this list.
   ///
@@ -25,3 +25,15 @@ void LSPSpec::from_json(const json& j, DocumentFormattingParams& obj) {
   json_deserialize_if_exists(textDocument);
   json_deserialize_if_exists(options);
 }
+
+void LSPSpec::to_json(json& j, const DocumentRangeFormattingParams& obj) {
+  json_serialize(textDocument);
+  json_serialize(range);
+  json_serialize(options);
+}
+
+void LSPSpec::from_json(const json& j, DocumentRangeFormattingParams& obj) {
+  json_deserialize_if_exists(textDocument);
+  json_deserialize_if_exists(range);
+  json_deserialize_if_exists(options);
+}
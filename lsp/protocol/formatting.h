@@ -39,4 +39,16 @@ struct DocumentFormattingParams {
 void to_json(json& j, const DocumentFormattingParams& obj);
 void from_json(const json& j, DocumentFormattingParams& obj);
 
+struct DocumentRangeFormattingParams {
+  // The document to format.
+  TextDocumentIdentifier textDocument;
+  // The range to format
+  Range range;
+  // The format options.
+  FormattingOptions options;
+};
+
+void to_json(json& j, const DocumentRangeFormattingParams& obj);
+void from_json(const json& j, DocumentRangeFormattingParams& obj);
+
 }  // namespace LSPSpec
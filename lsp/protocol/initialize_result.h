@@ -50,7 +50,7 @@ class InitializeResult {
                    {"codeActionProvider", false},
                    {"codeLensProvider", code_lens_provider},
                    {"documentFormattingProvider", true},
-                   {"documentRangeFormattingProvider", false},
+                   {"documentRangeFormattingProvider", true},
                    {"documentOnTypeFormattingProvider", document_on_type_formatting_provider},
                    {"renameProvider", false},
                    {"documentLinkProvider", document_link_provider},
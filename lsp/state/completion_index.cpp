@@ -0,0 +1,129 @@
+#include "completion_index.h"
+
+#include <unordered_map>
+
+#include "third-party/fmt/core.h"
+
+namespace {
+LSPSpec::CompletionItemKind symbol_completion_kind(SymbolInfo::Kind kind) {
+  switch (kind) {
+    case SymbolInfo::Kind::FUNCTION:
+      return LSPSpec::CompletionItemKind::Function;
+    case SymbolInfo::Kind::TYPE:
+      return LSPSpec::CompletionItemKind::Class;
+    case SymbolInfo::Kind::CONSTANT:
+      return LSPSpec::CompletionItemKind::Constant;
+    case SymbolInfo::Kind::MACRO:
+      return LSPSpec::CompletionItemKind::Snippet;
+    case SymbolInfo::Kind::LANGUAGE_BUILTIN:
+      return LSPSpec::CompletionItemKind::Keyword;
+    case SymbolInfo::Kind::METHOD:
+      return LSPSpec::CompletionItemKind::Method;
+    case SymbolInfo::Kind::GLOBAL_VAR:
+    case SymbolInfo::Kind::FWD_DECLARED_SYM:
+    default:
+      return LSPSpec::CompletionItemKind::Variable;
+  }
+}
+}  // namespace
+
+CompletionIndex::CompletionIndex(std::vector<Entry> entries) : m_entries(std::move(entries)) {
+  std::vector<std::string> names;
+  names.reserve(m_entries.size());
+  for (const auto& entry : m_entries) {
+    names.push_back(entry.name);
+  }
+  m_index = FuzzyIndex(std::move(names));
+}
+
+CompletionIndex CompletionIndex::from_compiler(const Compiler& compiler) {
+  std::vector<Entry> entries;
+  // a name can have several infos (a method defined by many types, for example). The first one
+  // is kept, unless a later one is documented and it isn't.
+  std::unordered_map<std::string, size_t> entry_of_name;
+  for (const auto& info : compiler.symbol_info_map().get_all_symbols()) {
+    Entry entry;
+    entry.name = info.name();
+    entry.kind = symbol_completion_kind(info.kind());
+    entry.documentation = info.meta().docstring;
+    if (info.kind() == SymbolInfo::Kind::METHOD) {
+      entry.detail = fmt::format("method of {}", info.method_info().defined_in_type);
+      if (entry.documentation.empty() && info.method_info().docstring) {
+        entry.documentation = *info.method_info().docstring;
+      }
+    } else if (info.kind() != SymbolInfo::Kind::MACRO &&
+               info.kind() != SymbolInfo::Kind::LANGUAGE_BUILTIN) {
+      auto ts = compiler.lookup_typespec(info.name());
+      if (ts) {
+        entry.detail = ts->print();
+      }
+    }
+
+    auto existing = entry_of_name.find(entry.name);
+    if (existing == entry_of_name.end()) {
+      entry_of_name[entry.name] = entries.size();
+      entries.push_back(std::move(entry));
+    } else if (entries[existing->second].documentation.empty() && !entry.documentation.empty()) {
+      entries[existing->second] = std::move(entry);
+    }
+  }
+  return CompletionIndex(std::move(entries));
+}
+
+CompletionIndex CompletionIndex::from_type_system(decompiler::DecompilerTypeSystem& dts) {
+  std::vector<Entry> entries;
+  std::unordered_map<std::string, size_t> entry_of_name;
+  auto add = [&](const std::string& name, LSPSpec::CompletionItemKind kind,
+                 const std::string& detail) {
+    if (entry_of_name.count(name)) {
+      return;
+    }
+    entry_of_name[name] = entries.size();
+    Entry entry;
+    entry.name = name;
+    entry.kind = kind;
+    entry.detail = detail;
+    auto meta = dts.symbol_metadata_map.find(name);
+    if (meta != dts.symbol_metadata_map.end() && meta->second.docstring) {
+      entry.documentation = *meta->second.docstring;
+    }
+    entries.push_back(std::move(entry));
+  };
+
+  for (const auto& [name, ts] : dts.symbol_types) {
+    add(name,
+        ts.base_type() == "function" ? LSPSpec::CompletionItemKind::Function
+                                     : LSPSpec::CompletionItemKind::Variable,
+        ts.print());
+  }
+  for (const auto& name : dts.ts.get_all_type_names()) {
+    add(name, LSPSpec::CompletionItemKind::Class, "type");
+  }
+  return CompletionIndex(std::move(entries));
+}
+
+std::vector<LSPSpec::CompletionItem> CompletionIndex::complete(const std::string& query,
+                                                               size_t max_results,
+                                                               bool* incomplete) const {
+  std::vector<LSPSpec::CompletionItem> items;
+  const auto matches = m_index.search(query, max_results, incomplete);
+  items.reserve(matches.size());
+  for (size_t i = 0; i < matches.size(); i++) {
+    const auto& entry = m_entries.at(matches[i].idx);
+    LSPSpec::CompletionItem item;
+    item.label = entry.name;
+    item.kind = entry.kind;
+    if (!entry.detail.empty()) {
+      item.detail = entry.detail;
+    }
+    if (!entry.documentation.empty()) {
+      item.documentation = entry.documentation;
+    }
+    // keep our ranking instead of the client's, and don't let the client drop fuzzy matches that
+    // aren't prefixes.
+    item.sortText = fmt::format("{:05d}", i);
+    item.filterText = query;
+    items.push_back(std::move(item));
+  }
+  return items;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "common/util/FuzzyIndex.h"
+
+#include "decompiler/util/DecompilerTypeSystem.h"
+#include "goalc/compiler/Compiler.h"
+#include "lsp/protocol/completion.h"
+
+/// The names that can be completed in a file, searched fuzzily. It's built once, when the compiler
+/// or all-types file it comes from is indexed, and never changes after that, so requests can share
+/// it without holding any locks while searching.
+class CompletionIndex {
+ public:
+  static CompletionIndex from_compiler(const Compiler& compiler);
+  static CompletionIndex from_type_system(decompiler::DecompilerTypeSystem& dts);
+
+  /// The best completions for the text being typed, best first. If there were more than
+  /// max_results, incomplete is set, so the client asks again as the user keeps typing.
+  std::vector<LSPSpec::CompletionItem> complete(const std::string& query,
+                                                size_t max_results,
+                                                bool* incomplete) const;
+  size_t size() const { return m_index.size(); }
+
+ private:
+  struct Entry {
+    std::string name;
+    LSPSpec::CompletionItemKind kind = LSPSpec::CompletionItemKind::Text;
+    std::string detail;
+    std::string documentation;
+  };
+  explicit CompletionIndex(std::vector<Entry> entries);
+
+  std::vector<Entry> m_entries;
+  FuzzyIndex m_index;
+};
@@ -1,12 +1,19 @@
 #include "lsp_requester.h"
 
 #include <iostream>
+#include <mutex>
 
 #include "common/log/log.h"
 #include "common/util/string_util.h"
 
 #include "lsp/protocol/progress_report.h"
 
+void LSPRequester::write_message(const std::string& message) {
+  static std::mutex output_mutex;
+  std::lock_guard<std::mutex> lk(output_mutex);
+  std::cout << message.c_str() << std::flush;
+}
+
 void LSPRequester::send_request(const json& params, const std::string& method) {
   json req;
   req["id"] = str_util::uuid();
@@ -22,7 +29,7 @@ void LSPRequester::send_request(const json& params, const std::string& method) {
 
   // Send requests immediately, as they may be done during the handling of a client request
   lg::info("Sending Request {}", method);
-  std::cout << request.c_str() << std::flush;
+  write_message(request);
 }
 
 void LSPRequester::send_notification(const json& params, const std::string& method) {
@@ -39,7 +46,7 @@ void LSPRequester::send_notification(const json& params, const std::string& meth
 
   // Send requests immediately, as they may be done during the handling of a client request
   lg::info("Sending Notification {}", method);
-  std::cout << request.c_str() << std::flush;
+  write_message(request);
 }
 
 void LSPRequester::send_progress_create_request(const std::string& token,
@@ -9,6 +9,9 @@
 
 class LSPRequester {
  public:
+  /// Write a message to the client. Indexing sends progress from its own thread, so all writes to
+  /// stdout go through this.
+  static void write_message(const std::string& message);
   void send_progress_create_request(const std::string& token, const std::string& title);
   void send_progress_update_request(const std::string& token, const std::string& message);
   void send_progress_finish_request(const std::string& token, const std::string& message);
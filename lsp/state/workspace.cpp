@@ -1,5 +1,6 @@
 #include "workspace.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <regex>
 #include <sstream>
@@ -83,7 +84,86 @@ std::string uri_to_path(LSPSpec::DocumentUri uri) {
 }
 
 Workspace::Workspace(){};
-Workspace::~Workspace(){};
+
+Workspace::~Workspace() {
+  {
+    std::lock_guard<std::mutex> lk(m_index_queue_mutex);
+    m_indexer_should_stop = true;
+  }
+  m_index_queue_cv.notify_all();
+  if (m_indexer_thread.joinable()) {
+    m_indexer_thread.join();
+  }
+};
+
+/*!
+ * Add a task for the indexer thread, starting it if needed. A queued re-parse of the same all-types
+ * file is out of date, and is dropped.
+ */
+void Workspace::queue_index_task(const IndexTask& task) {
+  {
+    std::lock_guard<std::mutex> lk(m_index_queue_mutex);
+    if (task.kind == IndexTask::Kind::ALL_TYPES) {
+      m_index_queue.erase(std::remove_if(m_index_queue.begin(), m_index_queue.end(),
+                                         [&](const IndexTask& queued) {
+                                           return queued.kind == IndexTask::Kind::ALL_TYPES &&
+                                                  queued.uri == task.uri;
+                                         }),
+                          m_index_queue.end());
+    }
+    m_index_queue.push_back(task);
+  }
+  if (!m_indexer_thread.joinable()) {
+    m_indexer_thread = std::thread([this]() { run_indexer(); });
+  }
+  m_index_queue_cv.notify_one();
+}
+
+void Workspace::run_indexer() {
+  while (true) {
+    IndexTask task;
+    {
+      std::unique_lock<std::mutex> lk(m_index_queue_mutex);
+      m_index_queue_cv.wait(lk, [&]() { return m_indexer_should_stop || !m_index_queue.empty(); });
+      if (m_indexer_should_stop) {
+        return;
+      }
+      task = m_index_queue.front();
+      m_index_queue.pop_front();
+    }
+
+    if (task.kind == IndexTask::Kind::COMPILER) {
+      const auto game_name = version_to_game_name(task.game_version);
+      const auto token = fmt::format("indexing-{}", game_name);
+      m_requester.send_progress_create_request(token, fmt::format("Indexing - {}", game_name));
+      auto compiler = std::make_unique<Compiler>(task.game_version);
+      // TODO - if this fails, annotate some errors
+      try {
+        compiler->run_front_end_on_string("(make-group \"all-code\")");
+      } catch (std::exception& e) {
+        lg::error("Failed to index {} - {}", game_name, e.what());
+      }
+      auto completions =
+          std::make_shared<const CompletionIndex>(CompletionIndex::from_compiler(*compiler));
+      {
+        std::lock_guard<std::mutex> lk(m_index_mutex);
+        m_compiler_instances[task.game_version] = std::move(compiler);
+        m_compiler_completions[task.game_version] = std::move(completions);
+      }
+      m_requester.send_progress_finish_request(token, fmt::format("Indexed - {}", game_name));
+    } else {
+      WorkspaceAllTypesFile file(task.uri, task.game_version, task.file_path);
+      try {
+        file.parse_type_system();
+      } catch (std::exception& e) {
+        lg::error("Failed to parse all-types file {} - {}", task.file_path.string(), e.what());
+        continue;
+      }
+      std::lock_guard<std::mutex> lk(m_index_mutex);
+      m_tracked_all_types_files[task.uri] = std::move(file);
+    }
+  }
+}
 
 bool Workspace::is_initialized() {
   return m_initialized;
@@ -128,6 +208,7 @@ std::optional<WorkspaceIRFile> Workspace::get_tracked_ir_file(const LSPSpec::URI
 std::optional<DefinitionMetadata> Workspace::get_definition_info_from_all_types(
     const std::string& symbol_name,
     const LSPSpec::DocumentUri& all_types_uri) {
+  std::lock_guard<std::mutex> lk(m_index_mutex);
   if (m_tracked_all_types_files.count(all_types_uri) == 0) {
     return {};
   }
@@ -155,6 +236,7 @@ std::optional<GameVersion> determine_game_version_from_uri(const LSPSpec::Docume
 
 std::optional<SymbolInfo> Workspace::get_global_symbol_info(const WorkspaceOGFile& file,
                                                             const std::string& symbol_name) {
+  std::lock_guard<std::mutex> lk(m_index_mutex);
   if (m_compiler_instances.find(file.m_game_version) == m_compiler_instances.end()) {
     lg::debug("Compiler not instantiated for game version - {}",
               version_to_game_name(file.m_game_version));
@@ -175,6 +257,7 @@ std::optional<SymbolInfo> Workspace::get_global_symbol_info(const WorkspaceOGFil
 
 std::optional<TypeSpec> Workspace::get_symbol_typespec(const WorkspaceOGFile& file,
                                                        const std::string& symbol_name) {
+  std::lock_guard<std::mutex> lk(m_index_mutex);
   if (m_compiler_instances.find(file.m_game_version) == m_compiler_instances.end()) {
     lg::debug("Compiler not instantiated for game version - {}",
               version_to_game_name(file.m_game_version));
@@ -191,6 +274,7 @@ std::optional<TypeSpec> Workspace::get_symbol_typespec(const WorkspaceOGFile& fi
 std::optional<Docs::DefinitionLocation> Workspace::get_symbol_def_location(
     const WorkspaceOGFile& file,
     const SymbolInfo& symbol_info) {
+  std::lock_guard<std::mutex> lk(m_index_mutex);
   if (m_compiler_instances.find(file.m_game_version) == m_compiler_instances.end()) {
     lg::debug("Compiler not instantiated for game version - {}",
               version_to_game_name(file.m_game_version));
@@ -209,6 +293,67 @@ std::optional<Docs::DefinitionLocation> Workspace::get_symbol_def_location(
   return def_loc;
 }
 
+namespace {
+/*!
+ * The symbol being typed at the position: everything back to the start of the form or word.
+ */
+std::string completion_query(const std::vector<std::string>& lines,
+                             const LSPSpec::Position& position) {
+  if (position.m_line >= lines.size()) {
+    return "";
+  }
+  const auto& line = lines.at(position.m_line);
+  size_t end = std::min<size_t>(position.m_character, line.size());
+  size_t start = end;
+  while (start > 0) {
+    char c = line.at(start - 1);
+    if (isspace((unsigned char)c) || c == '(' || c == ')' || c == '\'' || c == '`' || c == ',' ||
+        c == '"') {
+      break;
+    }
+    start--;
+  }
+  return line.substr(start, end - start);
+}
+}  // namespace
+
+LSPSpec::CompletionList Workspace::get_completions(const LSPSpec::DocumentUri& file_uri,
+                                                   const LSPSpec::Position& position) {
+  constexpr size_t max_completions = 100;
+  LSPSpec::CompletionList result;
+  result.m_isIncomplete = false;
+
+  std::string query;
+  std::shared_ptr<const CompletionIndex> index;
+  if (m_tracked_og_files.count(file_uri)) {
+    const auto& file = m_tracked_og_files.at(file_uri);
+    query = completion_query(file.m_lines, position);
+    std::lock_guard<std::mutex> lk(m_index_mutex);
+    if (m_compiler_completions.count(file.m_game_version)) {
+      index = m_compiler_completions.at(file.m_game_version);
+    }
+  } else if (m_tracked_ir_files.count(file_uri)) {
+    const auto& file = m_tracked_ir_files.at(file_uri);
+    query = completion_query(file.m_lines, position);
+    std::lock_guard<std::mutex> lk(m_index_mutex);
+    if (m_tracked_all_types_files.count(file.m_all_types_uri)) {
+      index = m_tracked_all_types_files.at(file.m_all_types_uri).m_completions;
+    }
+  }
+
+  // nothing to complete until the file has been indexed, or if there's nothing typed yet.
+  if (!index || query.empty()) {
+    return result;
+  }
+  // the index never changes, so the search doesn't need the lock.
+  result.m_items = index->complete(query, max_completions, &result.m_isIncomplete);
+  return result;
+}
+
+formatter::Formatter& Workspace::get_formatter(const LSPSpec::DocumentUri& file_uri) {
+  return m_formatters[file_uri];
+}
+
 void Workspace::start_tracking_file(const LSPSpec::DocumentUri& file_uri,
                                     const std::string& language_id,
                                     const std::string& content) {
@@ -217,11 +362,12 @@ void Workspace::start_tracking_file(const LSPSpec::DocumentUri& file_uri,
     WorkspaceIRFile file(content);
     m_tracked_ir_files[file_uri] = file;
     if (!file.m_all_types_uri.empty()) {
-      if (m_tracked_all_types_files.count(file.m_all_types_uri) == 0) {
+      if (m_requested_all_types_files.count(file.m_all_types_uri) == 0) {
         lg::debug("new all-types file - {}", file.m_all_types_uri);
-        m_tracked_all_types_files[file.m_all_types_uri] = WorkspaceAllTypesFile(
-            file.m_all_types_uri, file.m_game_version, file.m_all_types_file_path);
-        m_tracked_all_types_files[file.m_all_types_uri].parse_type_system();
+        IndexTask task{IndexTask::Kind::ALL_TYPES, file.m_game_version, file.m_all_types_uri,
+                       file.m_all_types_file_path};
+        m_requested_all_types_files[file.m_all_types_uri] = task;
+        queue_index_task(task);
       }
     }
   } else if (language_id == "opengoal") {
@@ -230,9 +376,7 @@ void Workspace::start_tracking_file(const LSPSpec::DocumentUri& file_uri,
       lg::debug("Could not determine game version from path - {}", file_uri);
       return;
     }
-    // TODO - this should happen on a separate thread so the LSP is not blocking during this lengthy
-    // step
-    if (m_compiler_instances.find(*game_version) == m_compiler_instances.end()) {
+    if (m_requested_compilers.count(*game_version) == 0) {
       lg::debug(
           "first time encountering a OpenGOAL file for game version - {}, initializing a compiler",
           version_to_game_name(*game_version));
@@ -242,12 +386,8 @@ void Workspace::start_tracking_file(const LSPSpec::DocumentUri& file_uri,
         lg::debug("unable to setup project path, not initializing a compiler");
         return;
       }
-      m_requester.send_progress_create_request("indexing-jak2", "Indexing - Jak 2");
-      m_compiler_instances.emplace(game_version.value(),
-                                   std::make_unique<Compiler>(game_version.value()));
-      // TODO - if this fails, annotate some errors, adjust progress
-      m_compiler_instances.at(*game_version)->run_front_end_on_string("(make-group \"all-code\")");
-      m_requester.send_progress_finish_request("indexing-jak2", "Indexed - Jak 2");
+      m_requested_compilers.insert(*game_version);
+      queue_index_task({IndexTask::Kind::COMPILER, *game_version});
     }
     //  TODO - otherwise, just `ml` the file instead of rebuilding the entire thing
     //  TODO - if the file fails to `ml`, annotate some errors
@@ -260,6 +400,11 @@ void Workspace::update_tracked_file(const LSPSpec::DocumentUri& file_uri,
   lg::debug("potentially updating - {}", file_uri);
   // Check if the file is already tracked or not, this is done because change events don't give
   // language details it's assumed you are keeping track of that!
+  if (m_tracked_og_files.count(file_uri) != 0) {
+    lg::debug("updating tracked OG file - {}", file_uri);
+    auto& file = m_tracked_og_files[file_uri];
+    file = WorkspaceOGFile(content, file.m_game_version);
+  }
   if (m_tracked_ir_files.count(file_uri) != 0) {
     lg::debug("updating tracked IR file - {}", file_uri);
     WorkspaceIRFile file(content);
@@ -267,28 +412,39 @@ void Workspace::update_tracked_file(const LSPSpec::DocumentUri& file_uri,
     // There is the potential for the all-types to have changed, albeit this is probably never going
     // to happen
     if (!file.m_all_types_uri.empty() &&
-        m_tracked_all_types_files.count(file.m_all_types_uri) == 0) {
-      auto& all_types_file = m_tracked_all_types_files[file.m_all_types_uri];
-      all_types_file.m_file_path = file.m_all_types_file_path;
-      all_types_file.m_uri = file.m_all_types_uri;
-      all_types_file.m_game_version = file.m_game_version;
-      all_types_file.update_type_system();
+        m_requested_all_types_files.count(file.m_all_types_uri) == 0) {
+      IndexTask task{IndexTask::Kind::ALL_TYPES, file.m_game_version, file.m_all_types_uri,
+                     file.m_all_types_file_path};
+      m_requested_all_types_files[file.m_all_types_uri] = task;
+      queue_index_task(task);
     }
   }
 
-  if (m_tracked_all_types_files.count(file_uri) != 0) {
+  if (m_requested_all_types_files.count(file_uri) != 0) {
     lg::debug("updating tracked all types file - {}", file_uri);
-    // If the all-types file has changed, re-parse it
+    // If the all-types file has changed, re-parse it. The old one is used until that's done.
     // NOTE - this assumes its still for the same game version!
-    m_tracked_all_types_files[file_uri].update_type_system();
+    queue_index_task(m_requested_all_types_files.at(file_uri));
   }
 };
 
 void Workspace::stop_tracking_file(const LSPSpec::DocumentUri& file_uri) {
+  m_formatters.erase(file_uri);
   if (m_tracked_ir_files.count(file_uri) != 0) {
     m_tracked_ir_files.erase(file_uri);
   }
-  if (m_tracked_all_types_files.count(file_uri) != 0) {
+  if (m_requested_all_types_files.count(file_uri) != 0) {
+    m_requested_all_types_files.erase(file_uri);
+    {
+      std::lock_guard<std::mutex> lk(m_index_queue_mutex);
+      m_index_queue.erase(std::remove_if(m_index_queue.begin(), m_index_queue.end(),
+                                         [&](const IndexTask& queued) {
+                                           return queued.kind == IndexTask::Kind::ALL_TYPES &&
+                                                  queued.uri == file_uri;
+                                         }),
+                          m_index_queue.end());
+    }
+    std::lock_guard<std::mutex> lk(m_index_mutex);
     m_tracked_all_types_files.erase(file_uri);
   }
 }
@@ -348,7 +504,7 @@ WorkspaceIRFile::WorkspaceIRFile(const std::string& content) {
 // This is kind of a hack, but to ensure consistency.  The file will reference the all-types.gc
 // file it was generated with, this lets us accurately jump to the definition properly!
 void WorkspaceIRFile::find_all_types_path(const std::string& line) {
-  std::regex regex("; ALL_TYPES=(.*)=(.*)");
+  static const std::regex regex("; ALL_TYPES=(.*)=(.*)");
   std::smatch matches;
 
   if (std::regex_search(line, matches, regex)) {
@@ -371,7 +527,7 @@ void WorkspaceIRFile::find_all_types_path(const std::string& line) {
 
 void WorkspaceIRFile::find_function_symbol(const uint32_t line_num_zero_based,
                                            const std::string& line) {
-  std::regex regex("; \\.function (.*)");
+  static const std::regex regex("; \\.function (.*)");
   std::smatch matches;
 
   if (std::regex_search(line, matches, regex)) {
@@ -396,7 +552,7 @@ void WorkspaceIRFile::find_function_symbol(const uint32_t line_num_zero_based,
     }
   }
 
-  std::regex end_function("^;; \\.endfunction\\s*$");
+  static const std::regex end_function("^;; \\.endfunction\\s*$");
   if (std::regex_match(line, end_function)) {
     // Set the previous symbols end-line
     if (!m_symbols.empty()) {
@@ -407,9 +563,9 @@ void WorkspaceIRFile::find_function_symbol(const uint32_t line_num_zero_based,
 
 void WorkspaceIRFile::identify_diagnostics(const uint32_t line_num_zero_based,
                                            const std::string& line) {
-  std::regex info_regex(";; INFO: (.*)");
-  std::regex warn_regex(";; WARN: (.*)");
-  std::regex error_regex(";; ERROR: (.*)");
+  static const std::regex info_regex(";; INFO: (.*)");
+  static const std::regex warn_regex(";; WARN: (.*)");
+  static const std::regex error_regex(";; ERROR: (.*)");
   std::smatch info_matches;
   std::smatch warn_matches;
   std::smatch error_matches;
@@ -505,6 +661,7 @@ std::optional<std::string> WorkspaceIRFile::get_symbol_at_position(
 void WorkspaceAllTypesFile::parse_type_system() {
   lg::debug("DTS Loading - '{}'", m_file_path.string());
   m_dts.parse_type_defs({m_file_path.string()});
+  m_completions = std::make_shared<const CompletionIndex>(CompletionIndex::from_type_system(m_dts));
   lg::debug("DTS Loaded At - '{}'", m_file_path.string());
 }
 
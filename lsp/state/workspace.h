@@ -1,17 +1,26 @@
 #pragma once
 
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
 
+#include "common/formatter/formatter.h"
 #include "common/util/FileUtil.h"
 
 #include "decompiler/util/DecompilerTypeSystem.h"
 #include "goalc/compiler/Compiler.h"
 #include "goalc/compiler/docs/DocTypes.h"
 #include "lsp/protocol/common_types.h"
+#include "lsp/protocol/completion.h"
 #include "lsp/protocol/document_diagnostics.h"
 #include "lsp/protocol/document_symbols.h"
+#include "lsp/state/completion_index.h"
 #include "lsp/state/lsp_requester.h"
 
 class WorkspaceOGFile {
@@ -68,6 +77,7 @@ class WorkspaceAllTypesFile {
   LSPSpec::DocumentUri m_uri;
   decompiler::DecompilerTypeSystem m_dts;
   fs::path m_file_path;
+  std::shared_ptr<const CompletionIndex> m_completions;
 
   void parse_type_system();
   void update_type_system();
@@ -104,13 +114,43 @@ class Workspace {
                                               const std::string& symbol_name);
   std::optional<Docs::DefinitionLocation> get_symbol_def_location(const WorkspaceOGFile& file,
                                                                   const SymbolInfo& symbol_info);
+  // Completions for the text before the position, from the compiler or all-types file of the file.
+  LSPSpec::CompletionList get_completions(const LSPSpec::DocumentUri& file_uri,
+                                          const LSPSpec::Position& position);
+  // The formatter for a file, which keeps what it needs to quickly format the next version of it.
+  formatter::Formatter& get_formatter(const LSPSpec::DocumentUri& file_uri);
 
  private:
+  // Compiling all-code for a game and parsing an all-types file are slow, so they are done on a
+  // background thread and swapped in when they finish. Until then, lookups that need them find
+  // nothing instead of blocking the request.
+  struct IndexTask {
+    enum class Kind { COMPILER, ALL_TYPES };
+    Kind kind = Kind::COMPILER;
+    GameVersion game_version = GameVersion::Jak1;
+    LSPSpec::DocumentUri uri;
+    fs::path file_path;
+  };
+  void queue_index_task(const IndexTask& task);
+  void run_indexer();
+
+  std::thread m_indexer_thread;
+  std::mutex m_index_queue_mutex;
+  std::condition_variable m_index_queue_cv;
+  std::deque<IndexTask> m_index_queue;
+  bool m_indexer_should_stop = false;
+  // held while using or replacing the compilers and all-types files.
+  std::mutex m_index_mutex;
+  // what has been requested from the indexer (only used on the request thread).
+  std::unordered_set<GameVersion> m_requested_compilers;
+  std::unordered_map<LSPSpec::DocumentUri, IndexTask> m_requested_all_types_files;
+
   LSPRequester m_requester;
   bool m_initialized = false;
   std::unordered_map<LSPSpec::DocumentUri, WorkspaceOGFile> m_tracked_og_files = {};
   std::unordered_map<LSPSpec::DocumentUri, WorkspaceIRFile> m_tracked_ir_files = {};
   std::unordered_map<LSPSpec::DocumentUri, WorkspaceAllTypesFile> m_tracked_all_types_files = {};
+  std::unordered_map<LSPSpec::DocumentUri, formatter::Formatter> m_formatters = {};
 
   // TODO:
   // OpenGOAL is still incredibly tightly coupled to the jak projects as a language
@@ -120,4 +160,5 @@ class Workspace {
   //
   // Until that decoupling happens, things like this will remain fairly clunky.
   std::unordered_map<GameVersion, std::unique_ptr<Compiler>> m_compiler_instances;
+  std::unordered_map<GameVersion, std::shared_ptr<const CompletionIndex>> m_compiler_completions;
 };
@@ -145,3 +145,17 @@ bool find_and_run_tests() {
 TEST(Formatter, FormatterTests) {
   EXPECT_TRUE(find_and_run_tests());
 }
+
+TEST(Formatter, FormatAfterEdit) {
+  formatter::Formatter formatter;
+  const std::string before = "(println \"test\")\n\n(println   \"other\")";
+  EXPECT_EQ(formatter.format(before), formatter::format_code(before));
+  const std::string after = "(println \"test\" 1)\n\n(println   \"other\")";
+  EXPECT_EQ(formatter.format(after), formatter::format_code(after));
+
+  const auto range = formatter.format_range(after, 2, 2);
+  ASSERT_TRUE(range);
+  EXPECT_EQ(range->start_line, 2u);
+  EXPECT_EQ(range->end_line, 2u);
+  EXPECT_EQ(range->text, "(println \"other\")");
+}
@@ -134,6 +134,24 @@ TEST_F(ControlStatementTests, AllowInline) {
   runner->run_static_test(testCategory, "inline-call.static.gc", {"44\n"});
 }
 
+TEST_F(ControlStatementTests, AutoInline) {
+  auto code = compiler->get_goos().reader.read_from_file(
+      {"test/goalc/source_templates/control-statements/auto-inline.static.gc"});
+  auto compiled = compiler->compile_object_file("test-code", code, true);
+  EXPECT_EQ(compiled->functions().size(), 2);
+  auto& ir = compiled->top_level_function().code();
+  bool got_mult = false;
+  for (auto& x : ir) {
+    EXPECT_EQ(dynamic_cast<IR_FunctionCall*>(x.get()), nullptr);
+    auto as_im = dynamic_cast<IR_IntegerMath*>(x.get());
+    if (as_im && as_im->get_kind() == IntegerMathKind::IMUL_32) {
+      got_mult = true;
+    }
+  }
+  EXPECT_TRUE(got_mult);
+  runner->run_static_test(testCategory, "auto-inline.static.gc", {"32\n"});
+}
+
 TEST_F(ControlStatementTests, ReturnNone) {
   runner->run_static_test(testCategory, "function-returning-none.static.gc", {"1\n"});
 }
@@ -182,3 +200,20 @@ TEST_F(ControlStatementTests, Desfun) {
 TEST_F(ControlStatementTests, DeReference) {
   runner->run_static_test(testCategory, "methods.static.gc", {"#t#t\n0\n"});
 }
+
+TEST_F(ControlStatementTests, SpillLoadAcrossLabel) {
+  runner->run_static_test(testCategory, "spill-load-across-label.static.gc", {"631\n"});
+}
+
+TEST_F(ControlStatementTests, JumpToJump) {
+  runner->run_static_test(testCategory, "jump-to-jump.static.gc", {"8556\n"});
+}
+
+TEST_F(ControlStatementTests, GotoNext) {
+  runner->run_static_test(testCategory, "goto-next.static.gc", {"412\n"});
+}
+
+TEST_F(ControlStatementTests, LinearScanSpills) {
+  runner->run_static_test(testCategory, "linear-scan-spills.static.gc", {"631\n"});
+  runner->run_static_test(testCategory, "linear-scan-off.static.gc", {"0\n"});
+}
@@ -71,6 +71,26 @@ TEST(Jak1Debugger, DebuggerBreakAndContinue) {
   }
 }
 
+TEST(Jak1Debugger, DebuggerProfile) {
+  Compiler compiler(GameVersion::Jak1);
+  if (!fork()) {
+    GoalTest::runtime_no_kernel_jak1();
+    exit(0);
+  } else {
+    connect_compiler_and_debugger(compiler, true);
+    EXPECT_TRUE(compiler.get_debugger().do_continue());
+    auto profile = compiler.get_debugger().profile(0.2, 200);
+    EXPECT_TRUE(profile.samples > 0);
+    EXPECT_EQ(profile.failed_samples, 0);
+    EXPECT_TRUE(compiler.get_debugger().is_running());
+    EXPECT_TRUE(compiler.get_debugger().do_break());
+    compiler.shutdown_target();
+
+    // and now the child process should be done!
+    EXPECT_TRUE(wait(nullptr) >= 0);
+  }
+}
+
 TEST(Jak1Debugger, DebuggerReadMemory) {
   Compiler compiler(GameVersion::Jak1);
   // evidently you can't ptrace threads in your own process, so we need to run the runtime in a
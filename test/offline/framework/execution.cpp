@@ -1,5 +1,6 @@
 #include "execution.h"
 
+#include "common/util/Timer.h"
 #include "common/util/string_util.h"
 
 #include "goalc/compiler/Compiler.h"
@@ -21,14 +22,25 @@ void disassemble(OfflineTestDecompiler& dc) {
 
 void decompile(OfflineTestDecompiler& dc,
                const OfflineTestConfig& config,
-               const std::shared_ptr<OfflineTestThreadStatus> status) {
+               const std::shared_ptr<OfflineTestThreadStatus> status,
+               OfflineTestFileTimes& times) {
   dc.db->extract_art_info();
   dc.db->ir2_top_level_pass(*dc.config);
+  // the callbacks make the files go one at a time, on this thread.
+  Timer file_timer;
+  std::string current_file;
   dc.db->analyze_functions_ir2(
       {}, *dc.config,
-      [status](std::string file_name) mutable { status->update_curr_file(file_name); },
-      [status]() mutable { status->complete_step(); }, config.skip_compile_functions,
-      config.skip_compile_states);
+      [&, status](std::string file_name) mutable {
+        status->update_curr_file(file_name);
+        current_file = file_name;
+        file_timer.start();
+      },
+      [&, status]() mutable {
+        times[current_file] += file_timer.getSeconds();
+        status->complete_step();
+      },
+      config.skip_compile_functions, config.skip_compile_states);
 }
 
 /// @brief Removes trailing new-lines and comment lines
@@ -70,10 +82,12 @@ decompiler::ObjectFileData& get_data(OfflineTestDecompiler& dc,
 
 OfflineTestCompareResult compare(OfflineTestDecompiler& dc,
                                  const OfflineTestWorkGroup& work_group,
-                                 const OfflineTestConfig& config) {
+                                 const OfflineTestConfig& config,
+                                 OfflineTestFileTimes& times) {
   OfflineTestCompareResult compare_result;
 
   for (const auto& file : work_group.work_collection.source_files) {
+    Timer file_timer;
     work_group.status->update_curr_file(file.name_in_dgo);
     auto& data = get_data(dc, file.unique_name, file.name_in_dgo);
     std::string result = clean_decompilation_code(data.full_output);
@@ -83,6 +97,8 @@ OfflineTestCompareResult compare(OfflineTestDecompiler& dc,
     if (result != ref) {
       compare_result.failing_files.push_back({file.unique_name, str_util::diff(ref, result)});
       compare_result.total_pass = false;
+      // report it now, instead of after every file is done.
+      lg::error("{} doesn't match the reference", file.unique_name);
       if (config.dump_mode) {
         auto failure_dir = file_util::get_jak_project_dir() / "failures";
         file_util::create_dir_if_needed(failure_dir);
@@ -92,6 +108,7 @@ OfflineTestCompareResult compare(OfflineTestDecompiler& dc,
     } else {
       compare_result.ok_files++;
     }
+    times[file.unique_name] += file_timer.getSeconds();
     work_group.status->complete_step();
   }
 
@@ -100,7 +117,8 @@ OfflineTestCompareResult compare(OfflineTestDecompiler& dc,
 
 OfflineTestCompileResult compile(OfflineTestDecompiler& dc,
                                  const OfflineTestWorkGroup& work_group,
-                                 const OfflineTestConfig& config) {
+                                 const OfflineTestConfig& config,
+                                 OfflineTestFileTimes& times) {
   OfflineTestCompileResult result;
   Compiler compiler(game_name_to_version(config.game_name));
 
@@ -122,6 +140,7 @@ OfflineTestCompileResult compile(OfflineTestDecompiler& dc,
     }
 
     lg::info("Compiling {}...", file.unique_name);
+    Timer file_timer;
 
     auto& data = get_data(dc, file.unique_name, file.name_in_dgo);
 
@@ -132,7 +151,9 @@ OfflineTestCompileResult compile(OfflineTestDecompiler& dc,
     } catch (const std::exception& e) {
       result.ok = false;
       result.failing_files.push_back({file.name_in_dgo, e.what()});
+      lg::error("{} failed to compile", file.name_in_dgo);
     }
+    times[file.unique_name] += file_timer.getSeconds();
     work_group.status->complete_step();
   }
 
@@ -5,18 +5,27 @@
 #include "decompiler/ObjectFile/ObjectFileDB.h"
 #include "test/offline/config/config.h"
 
+// seconds spent on each file, by unique name.
+using OfflineTestFileTimes = std::unordered_map<std::string, float>;
+
 struct OfflineTestDecompiler {
   std::unique_ptr<decompiler::ObjectFileDB> db;
   std::unique_ptr<decompiler::Config> config;
 };
 
+OfflineTestDecompiler setup_decompiler(const OfflineTestWorkGroup& work,
+                                       const fs::path& iso_data_path,
+                                       const OfflineTestConfig& offline_config);
 void disassemble(OfflineTestDecompiler& dc);
 void decompile(OfflineTestDecompiler& dc,
                const OfflineTestConfig& config,
-               const std::shared_ptr<OfflineTestThreadStatus> status);
+               const std::shared_ptr<OfflineTestThreadStatus> status,
+               OfflineTestFileTimes& times);
 OfflineTestCompareResult compare(OfflineTestDecompiler& dc,
                                  const OfflineTestWorkGroup& work_group,
-                                 const OfflineTestConfig& config);
+                                 const OfflineTestConfig& config,
+                                 OfflineTestFileTimes& times);
 OfflineTestCompileResult compile(OfflineTestDecompiler& dc,
                                  const OfflineTestWorkGroup& work_group,
-                                 const OfflineTestConfig& config);
+                                 const OfflineTestConfig& config,
+                                 OfflineTestFileTimes& times);
@@ -1,7 +1,12 @@
 #include "orchestration.h"
 
+#include <algorithm>
+#include <atomic>
+#include <unordered_set>
+
 #include "execution.h"
 #include "file_management.h"
+#include "result_cache.h"
 
 #include "common/log/log.h"
 #include "common/util/FileUtil.h"
@@ -77,105 +82,145 @@ OfflineTestDecompiler setup_decompiler(const OfflineTestWorkGroup& work,
   return dc;
 }
 
+namespace {
+/*!
+ * Split the files into bins of roughly equal expected time. The longest files are placed first,
+ * each into the bin with the least time so far.
+ */
+std::vector<OfflineTestWorkCollection> make_bins(const std::vector<OfflineTestSourceFile>& files,
+                                                 const OfflineTestResultCache& cache,
+                                                 int bin_count) {
+  std::vector<std::pair<float, const OfflineTestSourceFile*>> by_time;
+  for (const auto& file : files) {
+    by_time.push_back({cache.expected_seconds(file), &file});
+  }
+  std::stable_sort(by_time.begin(), by_time.end(),
+                   [](const auto& a, const auto& b) { return a.first > b.first; });
+
+  bin_count = std::max(1, std::min(bin_count, (int)files.size()));
+  std::vector<OfflineTestWorkCollection> bins(bin_count);
+  std::vector<float> bin_times(bin_count, 0.f);
+  for (const auto& [seconds, file] : by_time) {
+    int best = std::min_element(bin_times.begin(), bin_times.end()) - bin_times.begin();
+    bins.at(best).source_files.push_back(*file);
+    bin_times.at(best) += seconds;
+  }
+  return bins;
+}
+}  // namespace
+
 std::vector<std::future<OfflineTestThreadResult>> distribute_work(
     const OfflineTestConfig& offline_config,
-    const std::vector<OfflineTestSourceFile>& files) {
-  // First, group files by their DGO so they can be partitioned
-  std::unordered_map<std::string, OfflineTestWorkCollection> work_colls = {};
-
+    const std::vector<OfflineTestSourceFile>& files,
+    OfflineTestResultCache& cache) {
+  std::vector<OfflineTestSourceFile> to_run;
+  int skipped_cached = 0;
   for (const auto& file : files) {
-    if (work_colls.count(file.containing_dgo) == 0) {
-      work_colls[file.containing_dgo] = OfflineTestWorkCollection();
+    if (cache.passed_last_time(file)) {
+      skipped_cached++;
+    } else {
+      to_run.push_back(file);
     }
-    work_colls[file.containing_dgo].source_files.push_back(file);
   }
 
-  // Now partition by DGO so that threads do not consume unnecessary or duplicate resources
-  //
-  // TODO - additionally, if we have more threads than we can actually utilize we should not
-  // reserve them and dynamically adjust the used thread count
-  std::vector<OfflineTestWorkGroup> work_groups = {};
-  for (int i = 0; i < (int)offline_config.num_threads; i++) {
-    auto new_group = OfflineTestWorkGroup();
-    new_group.status = std::make_shared<OfflineTestThreadStatus>(offline_config);
-    work_groups.push_back(new_group);
-    g_offline_test_thread_manager.statuses.push_back(new_group.status);
+  // Each bin needs its own decompiler, so there are a few bins per thread: enough for the threads
+  // that finish early to take work from the others, but not so many that setup dominates.
+  struct SharedState {
+    std::vector<OfflineTestWorkCollection> bins;
+    std::atomic<int> next_bin = 0;
+    // set when a comparison fails with fail_on_cmp, so the other threads stop early.
+    std::atomic<bool> failed = false;
+  };
+  auto state = std::make_shared<SharedState>();
+  if (!to_run.empty()) {
+    state->bins = make_bins(to_run, cache, offline_config.num_threads * 2);
   }
 
-  g_offline_test_thread_manager.print_current_test_status(offline_config);
-
-  // Count the total number of files.
-  // We'll divide the files evenly between workers. We want to avoid the case where all workers need
-  // all DGOs, so assign consecutive files (likely to belong to the same dgo) to the same worker.
-  int total_files = 0;
-  for (const auto& [dgo, work] : work_colls) {
-    total_files += work.source_files.size();
-  }
-  int divisor = (total_files + work_groups.size() - 1) / work_groups.size();
-
-  // Divide up the work
-  int file_idx = 0;
-  for (const auto& [dgo, work] : work_colls) {
-    // source files
-    for (auto& source_file : work.source_files) {
-      auto& wg = work_groups.at(file_idx / divisor);
-      wg.dgo_set.insert(dgo);
-      wg.work_collection.source_files.push_back(source_file);
-      file_idx++;
-    }
+  std::vector<std::shared_ptr<OfflineTestThreadStatus>> statuses;
+  for (int i = 0; i < (int)offline_config.num_threads; i++) {
+    statuses.push_back(std::make_shared<OfflineTestThreadStatus>(offline_config));
+    g_offline_test_thread_manager.statuses.push_back(statuses.back());
   }
 
-  // Create summary of work for pretty printing.
-  for (auto& wg : work_groups) {
-    wg.status->dgos = wg.dgo_set;
-    wg.status->total_steps = wg.work_size() * 3;  // decomp, compare, compile
-  }
+  g_offline_test_thread_manager.print_current_test_status(offline_config);
 
-  // Now we can finally create the futures
   std::vector<std::future<OfflineTestThreadResult>> threads;
-  for (auto& work_group : work_groups) {
-    threads.push_back(std::async(std::launch::async, [&, work_group]() mutable {
+  for (int i = 0; i < (int)statuses.size(); i++) {
+    auto status = statuses.at(i);
+    threads.push_back(std::async(std::launch::async, [&, state, status, i]() mutable {
       OfflineTestThreadResult result;
-      if (work_group.work_size() == 0) {
-        return result;
+      if (i == 0) {
+        result.skipped_cached = skipped_cached;
       }
       Timer total_timer;
 
-      Timer decompiler_timer;
-      work_group.status->update_stage(OfflineTestThreadStatus::Stage::PREPARING);
-      auto decompiler =
-          setup_decompiler(work_group, fs::path(offline_config.iso_data_path), offline_config);
-      disassemble(decompiler);
-
-      work_group.status->update_stage(OfflineTestThreadStatus::Stage::DECOMPILING);
-      decompile(decompiler, offline_config, work_group.status);
-
-      result.time_spent_decompiling = decompiler_timer.getSeconds();
+      while (!state->failed) {
+        int bin_idx = state->next_bin.fetch_add(1);
+        if (bin_idx >= (int)state->bins.size()) {
+          break;
+        }
+        OfflineTestWorkGroup work_group;
+        work_group.work_collection = std::move(state->bins.at(bin_idx));
+        work_group.status = status;
+        for (const auto& file : work_group.work_collection.source_files) {
+          work_group.dgo_set.insert(file.containing_dgo);
+        }
+        status->dgos = work_group.dgo_set;
+        status->total_steps += work_group.work_size() * 3;  // decomp, compare, compile
+
+        OfflineTestFileTimes times;
+        Timer decompiler_timer;
+        status->update_stage(OfflineTestThreadStatus::Stage::PREPARING);
+        auto decompiler =
+            setup_decompiler(work_group, fs::path(offline_config.iso_data_path), offline_config);
+        disassemble(decompiler);
+
+        status->update_stage(OfflineTestThreadStatus::Stage::DECOMPILING);
+        decompile(decompiler, offline_config, status, times);
+        result.time_spent_decompiling += decompiler_timer.getSeconds();
+
+        status->update_stage(OfflineTestThreadStatus::Stage::COMPARING);
+        auto compare_result = compare(decompiler, work_group, offline_config, times);
+        result.compare.add(compare_result);
+
+        OfflineTestCompileResult compile_result;
+        if (!compare_result.total_pass) {
+          result.exit_code = 1;
+          if (offline_config.fail_on_cmp) {
+            state->failed = true;
+          }
+        }
+        if (!state->failed) {
+          Timer compile_timer;
+          status->update_stage(OfflineTestThreadStatus::Stage::COMPILING);
+          compile_result = compile(decompiler, work_group, offline_config, times);
+          result.time_spent_compiling += compile_timer.getSeconds();
+          result.compile.add(compile_result);
+          if (!compile_result.ok) {
+            result.exit_code = 1;
+          }
+        }
 
-      work_group.status->update_stage(OfflineTestThreadStatus::Stage::COMPARING);
-      result.compare = compare(decompiler, work_group, offline_config);
-      if (!result.compare.total_pass) {
-        result.exit_code = 1;
-        if (offline_config.fail_on_cmp) {
-          work_group.status->update_stage(OfflineTestThreadStatus::Stage::FAILED);
-          return result;
+        // a file that wasn't compiled (we're failing fast) doesn't count as passing.
+        std::unordered_set<std::string> compare_failures, compile_failures;
+        for (const auto& fail : compare_result.failing_files) {
+          compare_failures.insert(fail.filename);
+        }
+        for (const auto& fail : compile_result.failing_files) {
+          compile_failures.insert(fail.filename);
+        }
+        bool compiled = !state->failed || compare_result.total_pass;
+        for (const auto& file : work_group.work_collection.source_files) {
+          bool passed = compiled && !compare_failures.count(file.unique_name) &&
+                        !compile_failures.count(file.name_in_dgo);
+          auto time = times.find(file.unique_name);
+          cache.record(file, passed, time == times.end() ? 0.f : time->second);
         }
       }
 
-      // TODO - if anything has failed, fail fast and skip compiling
-
-      Timer compile_timer;
-      work_group.status->update_stage(OfflineTestThreadStatus::Stage::COMPILING);
-      result.compile = compile(decompiler, work_group, offline_config);
-      result.time_spent_compiling = compile_timer.getSeconds();
-      if (!result.compile.ok) {
-        work_group.status->update_stage(OfflineTestThreadStatus::Stage::FAILED);
-        result.exit_code = 1;
-      } else {
-        work_group.status->update_stage(OfflineTestThreadStatus::Stage::FINISHED);
-      }
+      status->update_stage(result.exit_code ? OfflineTestThreadStatus::Stage::FAILED
+                                            : OfflineTestThreadStatus::Stage::FINISHED);
       result.total_time = total_timer.getSeconds();
-
       return result;
     }));
   }
@@ -62,6 +62,9 @@ struct OfflineTestThreadResult {
   float time_spent_decompiling = 0;
   float total_time = 0;
 
+  // files that passed last time and haven't changed since.
+  int skipped_cached = 0;
+
   OfflineTestCompareResult compare;
   OfflineTestCompileResult compile;
 
@@ -69,6 +72,7 @@ struct OfflineTestThreadResult {
     if (other.exit_code) {
       exit_code = other.exit_code;
     }
+    skipped_cached += other.skipped_cached;
     time_spent_compiling += other.time_spent_compiling;
     time_spent_decompiling += other.time_spent_decompiling;
     total_time += other.total_time;
@@ -124,6 +128,13 @@ class OfflineTestThreadManager {
 
 extern OfflineTestThreadManager g_offline_test_thread_manager;
 
+class OfflineTestResultCache;
+
+/*!
+ * Start num_threads workers for the files. Files that passed last time are skipped, and the rest
+ * are split into bins of similar expected time that the workers take as they finish the last one.
+ */
 std::vector<std::future<OfflineTestThreadResult>> distribute_work(
     const OfflineTestConfig& offline_config,
-    const std::vector<OfflineTestSourceFile>& files);
+    const std::vector<OfflineTestSourceFile>& files,
+    OfflineTestResultCache& cache);
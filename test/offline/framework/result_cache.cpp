@@ -0,0 +1,111 @@
+#include "result_cache.h"
+
+#include <algorithm>
+
+#include "common/log/log.h"
+#include "common/util/FileUtil.h"
+#include "common/util/MappedFile.h"
+
+#include "third-party/fmt/core.h"
+#include "third-party/json.hpp"
+#include "third-party/zstd/lib/common/xxhash.h"
+
+namespace {
+u64 hash_file(const fs::path& path, u64 seed) {
+  file_util::MappedFile file(path);
+  return XXH64(file.data(), file.size(), seed);
+}
+
+/*!
+ * Hash everything, other than the reference files, that the results depend on.
+ */
+u64 hash_inputs(const OfflineTestConfig& config) {
+  auto project = file_util::get_jak_project_dir();
+  u64 hash = hash_file(file_util::get_current_executable_path(), 0);
+
+  auto config_files = file_util::find_files_recursively(
+      project / "decompiler" / "config" / config.game_name, std::regex(".*"));
+  std::sort(config_files.begin(), config_files.end());
+  config_files.push_back(project / "test" / "offline" / "config" / config.game_name /
+                         "config.jsonc");
+  config_files.push_back(project / "test" / "decompiler" / "reference" / config.game_name /
+                         "decompiler-macros.gc");
+  for (auto& path : config_files) {
+    auto name = path.string();
+    hash = XXH64(name.data(), name.size(), hash);
+    hash = hash_file(path, hash);
+  }
+
+  // the DGOs don't change, but a different ISO could be used.
+  for (auto& dgo : config.dgos) {
+    auto path = fs::path(config.iso_data_path) / dgo;
+    u64 size = fs::exists(path) ? fs::file_size(path) : 0;
+    hash = XXH64(&size, sizeof(size), hash);
+  }
+  return hash;
+}
+}  // namespace
+
+OfflineTestResultCache::OfflineTestResultCache(const OfflineTestConfig& config, bool enabled)
+    : m_enabled(enabled) {
+  m_path = file_util::get_jak_project_dir() / "out" / "offline-test" /
+           fmt::format("{}-results.json", config.game_name);
+  if (!fs::exists(m_path)) {
+    return;
+  }
+
+  try {
+    auto json = nlohmann::json::parse(file_util::read_text_file(m_path));
+    for (auto& [name, entry] : json.items()) {
+      m_entries[name] = {entry.at("key").get<u64>(), entry.at("passed").get<bool>(),
+                         entry.at("seconds").get<float>()};
+    }
+  } catch (const std::exception& e) {
+    lg::warn("Ignoring bad offline test results file {}: {}", m_path.string(), e.what());
+    m_entries.clear();
+  }
+
+  if (m_enabled) {
+    m_inputs_hash = hash_inputs(config);
+  }
+}
+
+u64 OfflineTestResultCache::file_key(const OfflineTestSourceFile& file) const {
+  return hash_file(file.path, m_inputs_hash);
+}
+
+bool OfflineTestResultCache::passed_last_time(const OfflineTestSourceFile& file) const {
+  if (!m_enabled) {
+    return false;
+  }
+  auto it = m_entries.find(file.unique_name);
+  return it != m_entries.end() && it->second.passed && it->second.key == file_key(file);
+}
+
+float OfflineTestResultCache::expected_seconds(const OfflineTestSourceFile& file) const {
+  auto it = m_entries.find(file.unique_name);
+  if (it != m_entries.end()) {
+    return it->second.seconds;
+  }
+  // roughly how fast files are decompiled, compared and compiled.
+  constexpr float BYTES_PER_SECOND = 200000;
+  return fs::file_size(file.path) / BYTES_PER_SECOND;
+}
+
+void OfflineTestResultCache::record(const OfflineTestSourceFile& file,
+                                    bool passed,
+                                    float seconds) {
+  u64 key = m_enabled ? file_key(file) : 0;
+  std::lock_guard<std::mutex> lk(m_mutex);
+  m_entries[file.unique_name] = {key, passed && m_enabled, seconds};
+}
+
+void OfflineTestResultCache::save() const {
+  std::lock_guard<std::mutex> lk(m_mutex);
+  nlohmann::json json;
+  for (auto& [name, entry] : m_entries) {
+    json[name] = {{"key", entry.key}, {"passed", entry.passed}, {"seconds", entry.seconds}};
+  }
+  file_util::create_dir_if_needed_for_file(m_path);
+  file_util::write_text_file(m_path, json.dump(1));
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "file_management.h"
+
+#include "common/common_types.h"
+
+#include "test/offline/config/config.h"
+
+/*!
+ * Results of earlier offline test runs, by file. A file that passed is skipped if none of its
+ * inputs changed: the test executable, the decompiler and offline test configs of the game, and
+ * the reference file. How long each file took is kept too, so the slowest files can start first.
+ */
+class OfflineTestResultCache {
+ public:
+  OfflineTestResultCache(const OfflineTestConfig& config, bool enabled);
+
+  bool passed_last_time(const OfflineTestSourceFile& file) const;
+  // seconds the file took last time, or a guess from the size of its reference file.
+  float expected_seconds(const OfflineTestSourceFile& file) const;
+  // can be called from any thread.
+  void record(const OfflineTestSourceFile& file, bool passed, float seconds);
+  void save() const;
+
+ private:
+  u64 file_key(const OfflineTestSourceFile& file) const;
+
+  struct Entry {
+    u64 key = 0;
+    bool passed = false;
+    float seconds = 0;
+  };
+
+  bool m_enabled = false;
+  fs::path m_path;
+  u64 m_inputs_hash = 0;
+  std::unordered_map<std::string, Entry> m_entries;  // by unique name
+  mutable std::mutex m_mutex;
+};
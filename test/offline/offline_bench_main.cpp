@@ -0,0 +1,168 @@
+// Runs the decompiler over the offline test's reference objects (the files with a _REF.gc in
+// test/decompiler/reference) and reports the time spent in each IR2 pass, the slowest functions in
+// each pass, and peak memory, as JSON. Nothing is compared or compiled.
+//
+// With --baseline, the pass times are compared against an earlier report, so a pass that got slower
+// shows up in review.
+
+#include <string>
+
+#include "common/log/log.h"
+#include "common/util/FileUtil.h"
+#include "common/util/Timer.h"
+#include "common/util/os.h"
+#include "common/util/unicode_util.h"
+
+#include "config/config.h"
+#include "decompiler/ObjectFile/ObjectFileDB.h"
+#include "framework/execution.h"
+#include "framework/file_management.h"
+
+#include "third-party/CLI11.hpp"
+#include "third-party/fmt/core.h"
+#include "third-party/json.hpp"
+
+namespace {
+
+nlohmann::json pass_stats_to_json(const decompiler::PassProfiler::PassStats& pass) {
+  nlohmann::json slowest = nlohmann::json::array();
+  for (auto& f : pass.slowest) {
+    slowest.push_back({{"function", f.function}, {"object", f.object}, {"ms", f.ms}});
+  }
+  nlohmann::json result;
+  result["name"] = pass.name;
+  result["total_ms"] = pass.total_ms;
+  result["runs"] = pass.runs;
+  result["functions"] = pass.functions;
+  result["function_ms"] = pass.function_ms;
+  result["slowest"] = slowest;
+  return result;
+}
+
+/*!
+ * Print each pass next to its time in the baseline. Returns false if a pass got slower by more
+ * than max_regression_percent (when it's positive).
+ */
+bool compare_to_baseline(const nlohmann::json& result,
+                         const nlohmann::json& baseline,
+                         double max_regression_percent) {
+  std::unordered_map<std::string, double> baseline_ms;
+  for (auto& pass : baseline.at("passes")) {
+    baseline_ms[pass.at("name").get<std::string>()] = pass.at("total_ms").get<double>();
+  }
+
+  bool ok = true;
+  fmt::print("{:<28} {:>12} {:>12} {:>9}\n", "pass", "baseline ms", "ms", "change");
+  for (auto& pass : result.at("passes")) {
+    auto name = pass.at("name").get<std::string>();
+    double ms = pass.at("total_ms").get<double>();
+    auto it = baseline_ms.find(name);
+    if (it == baseline_ms.end() || it->second <= 0) {
+      fmt::print("{:<28} {:>12} {:>12.2f} {:>9}\n", name, "-", ms, "new");
+      continue;
+    }
+    double change = 100. * (ms - it->second) / it->second;
+    bool regressed = max_regression_percent > 0 && change > max_regression_percent;
+    fmt::print("{:<28} {:>12.2f} {:>12.2f} {:>+8.1f}%{}\n", name, it->second, ms, change,
+               regressed ? " REGRESSED" : "");
+    if (regressed) {
+      ok = false;
+    }
+  }
+  return ok;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  ArgumentGuard u8_guard(argc, argv);
+
+  std::string iso_data_path;
+  std::string game_name;
+  int max_files = -1;
+  std::string single_file = "";
+  int outliers = 10;
+  std::string output_path;
+  std::string baseline_path;
+  double max_regression_percent = 0;
+  std::string project_path;
+
+  CLI::App app{"OpenGOAL - Decompiler Pass Benchmark"};
+  app.add_option("--iso_data_path", iso_data_path, "The path to the folder with the ISO data files")
+      ->check(CLI::ExistingPath)
+      ->required();
+  app.add_option("--game", game_name, "The game name, for example 'jak1'")->required();
+  app.add_option("-m,--max_files", max_files,
+                 "Limit the amount of files ran in a single test, picks the first N");
+  app.add_option("-f,--file", single_file, "Only run on a single file");
+  app.add_option("--outliers", outliers, "Number of slowest functions to report for each pass");
+  app.add_option("-o,--output", output_path, "Write the JSON report to this file");
+  app.add_option("--baseline", baseline_path, "JSON report from an earlier run to compare with");
+  app.add_option("--max-regression", max_regression_percent,
+                 "Fail if a pass is this many percent slower than the baseline");
+  app.add_option("--proj-path", project_path, "Project path");
+  app.validate_positionals();
+  CLI11_PARSE(app, argc, argv);
+
+  lg::initialize();
+
+  std::optional<fs::path> pp;
+  if (!project_path.empty()) {
+    pp = project_path;
+  }
+  if (!file_util::setup_project_path(pp)) {
+    lg::error("Couldn't setup project path, tool is supposed to be ran in the jak-project repo!");
+    return 1;
+  }
+
+  auto config = OfflineTestConfig(game_name, iso_data_path, 1, false, false, false, false);
+
+  lg::info("Finding files...");
+  OfflineTestWorkGroup work;
+  work.work_collection.source_files = find_source_files(game_name, config.dgos, single_file);
+  auto& source_files = work.work_collection.source_files;
+  if (max_files > 0 && max_files < (int)source_files.size()) {
+    source_files.erase(source_files.begin() + max_files, source_files.end());
+  }
+
+  decompiler::init_opcode_info();
+  Timer total_timer;
+  auto dc = setup_decompiler(work, fs::path(iso_data_path), config);
+  // a single thread, so the pass times don't depend on the machine's core count.
+  dc.config->decompile_threads = 1;
+  auto& db = *dc.db;
+  db.profiler.enable(outliers);
+
+  db.profiler.run("disassemble", [&] { disassemble(dc); });
+  db.profiler.run("extract_art_info", [&] { db.extract_art_info(); });
+  db.profiler.run("top_level", [&] { db.ir2_top_level_pass(*dc.config); });
+  db.analyze_functions_ir2({}, *dc.config, {}, {}, config.skip_compile_functions,
+                           config.skip_compile_states);
+
+  nlohmann::json result;
+  result["game"] = game_name;
+  result["files"] = source_files.size();
+  result["total_ms"] = total_timer.getMs();
+  result["peak_rss_bytes"] = get_peak_rss();
+  result["passes"] = nlohmann::json::array();
+  for (auto& pass : db.profiler.stats()) {
+    result["passes"].push_back(pass_stats_to_json(pass));
+  }
+
+  if (!output_path.empty()) {
+    file_util::write_text_file(output_path, result.dump(2));
+    lg::info("Wrote {}", output_path);
+  } else {
+    fmt::print("{}\n", result.dump(2));
+  }
+
+  if (!baseline_path.empty()) {
+    auto baseline = nlohmann::json::parse(file_util::read_text_file(baseline_path));
+    if (!compare_to_baseline(result, baseline, max_regression_percent)) {
+      lg::error("Some passes are more than {}% slower than the baseline", max_regression_percent);
+      return 1;
+    }
+  }
+
+  return 0;
+}
@@ -9,6 +9,7 @@
 #include "decompiler/ObjectFile/ObjectFileDB.h"
 #include "framework/file_management.h"
 #include "framework/orchestration.h"
+#include "framework/result_cache.h"
 
 #include "third-party/CLI11.hpp"
 #include "third-party/fmt/format.h"
@@ -26,6 +27,7 @@ int main(int argc, char* argv[]) {
   std::string project_path;
   bool fail_on_cmp = false;
   bool pretty_print = false;
+  bool no_cache = false;
 
   CLI::App app{"OpenGOAL - Offline Reference Test Runner"};
   app.add_option("--iso_data_path", iso_data_path, "The path to the folder with the ISO data files")
@@ -45,6 +47,8 @@ int main(int argc, char* argv[]) {
   app.add_flag("--fail-on-cmp", fail_on_cmp, "Fail the tests immediately if the comparison fails");
   app.add_flag("-p,--pretty-print", pretty_print,
                "Use the condensed and progress-indicating printing format");
+  app.add_flag("--no-cache", no_cache,
+               "Run every file, even the ones that passed last time and haven't changed since");
   app.add_option("--proj-path", project_path, "Project path");
   app.validate_positionals();
   CLI11_PARSE(app, argc, argv);
@@ -64,6 +68,13 @@ int main(int argc, char* argv[]) {
     return 1;
   }
 
+  // Figure out the number of threads
+  if (num_threads < 1) {
+    num_threads = 1;
+  } else if (num_threads > 1) {
+    num_threads = std::min(num_threads, std::thread::hardware_concurrency());
+  }
+
   // Setup environment, fetch files
   auto config = OfflineTestConfig(game_name, iso_data_path, num_threads, dump_current_output,
                                   fail_on_cmp, false, pretty_print);
@@ -74,16 +85,10 @@ int main(int argc, char* argv[]) {
     source_files.erase(source_files.begin() + max_files, source_files.end());
   }
 
-  // Figure out the number of threads, prepare their statuses and start printing it
-  if (num_threads < 1) {
-    num_threads = 1;
-  } else if (num_threads > 1) {
-    num_threads = std::min(num_threads, std::thread::hardware_concurrency());
-  }
-
-  // Distribute the work amongst the threads, partitioning by DGO
+  // Distribute the work amongst the threads, longest files first
+  OfflineTestResultCache cache(config, !no_cache && single_file.empty());
   decompiler::init_opcode_info();
-  auto workers = distribute_work(config, source_files);
+  auto workers = distribute_work(config, source_files, cache);
 
   // summarize results:
   OfflineTestThreadResult total;
@@ -91,6 +96,11 @@ int main(int argc, char* argv[]) {
     auto ret = worker.get();
     total.add(ret);
   }
+  cache.save();
+  if (total.skipped_cached) {
+    lg::info("Skipped {} files that passed last time (--no-cache to run them)",
+             total.skipped_cached);
+  }
 
   if (!total.compare.total_pass) {
     lg::error("Comparison failed.");
@@ -1,19 +1,27 @@
+#include <atomic>
 #include <limits>
+#include <stdexcept>
 #include <string>
 #include <unordered_set>
 #include <vector>
 
+#include "common/texture/texture_compression.h"
+#include "common/texture/texture_conversion.h"
 #include "common/util/Assert.h"
 #include "common/util/BitUtils.h"
 #include "common/util/CopyOnWrite.h"
 #include "common/util/FileUtil.h"
+#include "common/util/FuzzyIndex.h"
 #include "common/util/Range.h"
+#include "common/util/SimpleThreadGroup.h"
 #include "common/util/SmallVector.h"
+#include "common/util/ThreadPool.h"
 #include "common/util/Trie.h"
 #include "common/util/crc32.h"
 #include "common/util/json_util.h"
 #include "common/util/os.h"
 #include "common/util/print_float.h"
+#include "common/util/string_util.h"
 
 #include "gtest/gtest.h"
 #include "test/all_jak1_symbols.h"
@@ -59,6 +67,24 @@ TEST(CommonUtil, Trie) {
   EXPECT_FALSE(test.lookup("path1-k") == nullptr);
 }
 
+TEST(CommonUtil, StringViews) {
+  std::string text = "  (a b)\n\n\tc  ";
+  auto lines = str_util::split_view(text);
+  ASSERT_EQ(3, lines.size());
+  EXPECT_EQ("  (a b)", lines[0]);
+  EXPECT_EQ("", lines[1]);
+  EXPECT_EQ("\tc  ", lines[2]);
+  EXPECT_EQ(str_util::split(text), std::vector<std::string>(lines.begin(), lines.end()));
+  EXPECT_EQ("(a b)", str_util::trim_view(lines[0]));
+  EXPECT_EQ("c  ", str_util::ltrim_view(lines[2]));
+  EXPECT_EQ("\tc", str_util::rtrim_view(lines[2]));
+  EXPECT_EQ("", str_util::trim_view(" \t "));
+  EXPECT_EQ("(a b)\n\nc  ", str_util::trim_newline_indents(text));
+  EXPECT_TRUE(str_util::starts_with(text, "  (a"));
+  EXPECT_TRUE(str_util::ends_with(lines[2], "c  "));
+  EXPECT_FALSE(str_util::contains(lines[0], "c"));
+}
+
 TEST(CommonUtil, StripComments) {
   std::string test_input =
       R"(
@@ -82,6 +108,29 @@ test "asdf /* y */ /////a\"bcd"
   EXPECT_EQ(strip_cpp_style_comments(test_input), test_expected);
 }
 
+TEST(CommonUtil, ParseCommentedJsonParallel) {
+  std::string object_input = R"(
+{
+  // a comment
+  "a": [1, 2, {"b": "}],{"}],
+  "c,d": "with \"escaped\" quotes and a , comma", /* more */
+  "e": {"nested": {"x": [[], {}]}},
+  "a": "duplicate",
+  "empty": {}
+}
+)";
+  std::string objects;
+  for (int i = 0; i < 100; i++) {
+    objects += fmt::format("{}\"f{}\": [{}, \"{{\"]", i ? "," : "", i, i);
+  }
+  for (const auto& input :
+       {object_input, "{" + objects + "}", std::string("{}"), std::string(" [1, {\"a\": 2}] ")}) {
+    EXPECT_EQ(parse_commented_json_parallel(input, "test"), parse_commented_json(input, "test"));
+  }
+  EXPECT_EQ(parse_commented_json_parallel(object_input, "test")["a"], "duplicate");
+  EXPECT_ANY_THROW(parse_commented_json_parallel("{\"a\": [1, 2,]}", "test"));
+}
+
 TEST(CommonUtil, RangeIterator) {
   std::vector<int> result = {}, expected_result = {4, 5, 6, 7};
 
@@ -396,6 +445,51 @@ TEST(SmallVector, Construction) {
   EXPECT_FALSE(one.empty());
 }
 
+TEST(SmallVector, ClearThenPush) {
+  SmallVector<std::string, 1> one({long_string_1, long_string_2, long_string_3});
+  one.clear();
+  EXPECT_TRUE(one.empty());
+  EXPECT_EQ(one.capacity(), 1);
+  one.push_back(long_string_2);
+  one.push_back(long_string_3);
+  EXPECT_EQ(one.size(), 2);
+  EXPECT_EQ(one.at(1), long_string_3);
+}
+
+TEST(SmallVector, Erase) {
+  SmallVector<std::string, 2> one({"a", "b", "c", "d", "e"});
+  auto it = one.erase(one.begin());
+  EXPECT_EQ(*it, "b");
+  it = one.erase(one.begin() + 1, one.begin() + 3);
+  EXPECT_EQ(*it, "e");
+  EXPECT_EQ(one.size(), 2);
+  EXPECT_EQ(one.at(0), "b");
+  EXPECT_EQ(one.at(1), "e");
+  one.erase(one.begin(), one.end());
+  EXPECT_TRUE(one.empty());
+}
+
+TEST(SmallVector, InsertRange) {
+  std::vector<std::string> src = {long_string_1, long_string_2};
+  // fits inline
+  SmallVector<std::string, 4> one({"a", "b"});
+  one.insert(one.begin() + 1, src.begin(), src.end());
+  EXPECT_EQ(one.size(), 4);
+  EXPECT_EQ(one.at(0), "a");
+  EXPECT_EQ(one.at(1), long_string_1);
+  EXPECT_EQ(one.at(2), long_string_2);
+  EXPECT_EQ(one.at(3), "b");
+
+  // needs to move to the heap
+  SmallVector<std::string, 1> two({"a"});
+  two.insert(two.begin(), src.begin(), src.end());
+  two.insert(two.end(), src.begin(), src.end());
+  EXPECT_EQ(two.size(), 5);
+  EXPECT_EQ(two.at(0), long_string_1);
+  EXPECT_EQ(two.at(2), "a");
+  EXPECT_EQ(two.at(4), long_string_2);
+}
+
 #ifndef NO_ASSERT
 TEST(Assert, Death) {
   EXPECT_DEATH(private_assert_failed("foo", "bar", 12, "aaa"), "");
@@ -423,5 +517,222 @@ TEST(CRC32, Reference) {
   }
 }
 
+TEST(TextureConversion, PageTablesMatchAddressFunctions) {
+  // the per-page tables must give the same addresses as the per-pixel functions, for textures
+  // that span several pages.
+  const u32 base = 37;
+  for (u32 width : {64, 128, 256, 512}) {
+    u32 w = width;
+    u32 h = 256;
+    std::vector<u32> addrs;
+    auto record = [&](u32 i, u32 addr) {
+      EXPECT_EQ(i, addrs.size());
+      addrs.push_back(addr);
+    };
+
+    for_each_swizzled_pixel(psmt8_page_table(), 8192, base * 256, w, h, width, record);
+    for (u32 y = 0; y < h; y++) {
+      for (u32 x = 0; x < w; x++) {
+        EXPECT_EQ(addrs.at(x + y * w), psmt8_addr(x, y, width) + base * 256);
+      }
+    }
+
+    addrs.clear();
+    for_each_swizzled_pixel(psmt4_page_table(), 16384, base * 512, w, h, width, record);
+    for (u32 y = 0; y < h; y++) {
+      for (u32 x = 0; x < w; x++) {
+        EXPECT_EQ(addrs.at(x + y * w), psmt4_addr_half_byte(x, y, width) + base * 512);
+      }
+    }
+
+    addrs.clear();
+    for_each_swizzled_pixel(psmct16_page_table(), 8192, base * 256, w, h, width, record);
+    for (u32 y = 0; y < h; y++) {
+      for (u32 x = 0; x < w; x++) {
+        EXPECT_EQ(addrs.at(x + y * w), psmct16_addr(x, y, width) + base * 256);
+      }
+    }
+
+    addrs.clear();
+    for_each_swizzled_pixel(psmct32_page_table(), 8192, base * 256, w, h, width, record);
+    for (u32 y = 0; y < h; y++) {
+      for (u32 x = 0; x < w; x++) {
+        EXPECT_EQ(addrs.at(x + y * w), psmct32_addr(x, y, width) + base * 256);
+      }
+    }
+  }
+
+  for (u32 i = 0; i < 0x10000; i++) {
+    EXPECT_EQ(rgba16_to_rgba32_table(i), rgba16_to_rgba32(i));
+  }
+}
+
 }  // namespace test
 }  // namespace cu
+
+namespace {
+// a smooth gradient with a little noise, like a real texture. The encoder uses bounding-box
+// endpoints, so the colors change together. Alpha varies only if requested.
+std::vector<u32> texture_compression_test_data(int w, int h, bool alpha) {
+  std::vector<u32> result;
+  for (int y = 0; y < h; y++) {
+    for (int x = 0; x < w; x++) {
+      u32 shade = (x * 2 + y) * 120 / (2 * w + h);
+      u32 noise = (x * 7 + y * 13) % 5;
+      u32 r = 60 + shade + noise;
+      u32 g = 40 + shade * 3 / 2;
+      u32 b = 30 + shade / 2 + noise;
+      u32 a = alpha ? 20 + (x + y) * 230 / (w + h) : 255;
+      result.push_back(r | (g << 8) | (b << 16) | (a << 24));
+    }
+  }
+  return result;
+}
+
+int max_channel_error(const std::vector<u32>& a, const std::vector<u32>& b) {
+  int result = 0;
+  for (size_t i = 0; i < a.size(); i++) {
+    for (int c = 0; c < 4; c++) {
+      int diff = (int)((a[i] >> (8 * c)) & 0xff) - (int)((b[i] >> (8 * c)) & 0xff);
+      result = std::max(result, std::abs(diff));
+    }
+  }
+  return result;
+}
+}  // namespace
+
+TEST(TextureCompression, LevelRoundTrip) {
+  // includes sizes that aren't a multiple of the block size.
+  for (auto format : {tfrag3::TextureCompression::BC1, tfrag3::TextureCompression::BC3}) {
+    const bool alpha = format == tfrag3::TextureCompression::BC3;
+    for (auto [w, h] : {std::pair{16, 8}, std::pair{6, 5}, std::pair{1, 1}, std::pair{2, 9}}) {
+      auto rgba = texture_compression_test_data(w, h, alpha);
+      auto compressed = texture_compression::compress_level(format, rgba.data(), w, h);
+      EXPECT_EQ(compressed.size(), texture_compression::level_size(format, w, h));
+      EXPECT_EQ(compressed.size(), ((w + 3) / 4) * ((h + 3) / 4) * (alpha ? 16 : 8));
+      auto decompressed = texture_compression::decompress_level(format, compressed.data(), w, h);
+      ASSERT_EQ(decompressed.size(), rgba.size());
+      // 5 bits of red and blue, and the interpolated palette.
+      EXPECT_LE(max_channel_error(rgba, decompressed), 16) << w << "x" << h;
+    }
+  }
+}
+
+TEST(TextureCompression, CompressTexture) {
+  for (bool alpha : {false, true}) {
+    tfrag3::Texture tex;
+    tex.w = 16;
+    tex.h = 8;
+    tex.data = texture_compression_test_data(tex.w, tex.h, alpha);
+    const auto rgba = tex.data;
+    texture_compression::compress_texture(tex);
+
+    // opaque textures don't need the alpha block.
+    const auto format =
+        alpha ? tfrag3::TextureCompression::BC3 : tfrag3::TextureCompression::BC1;
+    EXPECT_EQ(tex.compression, format);
+    EXPECT_TRUE(tex.data.empty());
+    // 16x8, 8x4, 4x2, 2x1, 1x1
+    EXPECT_EQ(tex.num_mips, 5);
+    u32 size = 0;
+    for (auto [w, h] : {std::pair{16, 8}, {8, 4}, {4, 2}, {2, 1}, {1, 1}}) {
+      size += texture_compression::level_size(format, w, h);
+    }
+    EXPECT_EQ(tex.compressed_size_bytes(), size);
+    EXPECT_LE(max_channel_error(rgba, texture_compression::texture_rgba(tex)), 16);
+  }
+
+  // the texture pool needs RGBA data.
+  tfrag3::Texture pool_tex;
+  pool_tex.w = 4;
+  pool_tex.h = 4;
+  pool_tex.load_to_pool = true;
+  pool_tex.data = texture_compression_test_data(4, 4, false);
+  texture_compression::compress_texture(pool_tex);
+  EXPECT_EQ(pool_tex.compression, tfrag3::TextureCompression::NONE);
+  EXPECT_EQ(pool_tex.data, texture_compression_test_data(4, 4, false));
+}
+
+TEST(ThreadPool, ParallelForRunsEachIndexOnce) {
+  std::vector<std::atomic<int>> hits(10000);
+  parallel_for(hits.size(), [&](int i) { hits[i]++; });
+  for (auto& h : hits) {
+    EXPECT_EQ(h.load(), 1);
+  }
+}
+
+TEST(ThreadPool, Nested) {
+  ThreadPool pool(4);
+  std::atomic<int> count = 0;
+  pool.parallel_for(
+      [&](int) { pool.parallel_for([&](int) { parallel_for(4, [&](int) { count++; }); }, 20); },
+      20);
+  EXPECT_EQ(count.load(), 20 * 20 * 4);
+}
+
+TEST(ThreadPool, Exception) {
+  EXPECT_THROW(parallel_for(100,
+                            [](int i) {
+                              if (i == 37) {
+                                throw std::runtime_error("fail");
+                              }
+                            }),
+               std::runtime_error);
+}
+
+TEST(ThreadPool, Cancel) {
+  CancelToken cancel;
+  ParallelForOptions options;
+  options.cancel = &cancel;
+  std::atomic<int> count = 0;
+  parallel_for(
+      100000,
+      [&](int i) {
+        if (i == 10) {
+          cancel.cancel();
+        }
+        count++;
+      },
+      options);
+  EXPECT_LT(count.load(), 100000);
+}
+
+TEST(ThreadPool, SimpleThreadGroup) {
+  std::atomic<int> sum = 0;
+  SimpleThreadGroup threads;
+  threads.run([&](int i) { sum += i; }, 100, 3);
+  threads.join();
+  EXPECT_EQ(sum.load(), 4950);
+}
+
+TEST(CommonUtil, FuzzyIndex) {
+  EXPECT_FALSE(FuzzyIndex::score("xyz", "draw-model-id"));
+  EXPECT_FALSE(FuzzyIndex::score("dim", "draw-model-id"));  // out of order
+  EXPECT_TRUE(FuzzyIndex::score("DMI", "draw-model-id"));
+
+  // exact, then prefix, then the start of words, then anywhere.
+  EXPECT_GT(*FuzzyIndex::score("vector", "vector"), *FuzzyIndex::score("vector", "vector-dot"));
+  EXPECT_GT(*FuzzyIndex::score("vec", "vector-dot"), *FuzzyIndex::score("vec", "new-vector"));
+  EXPECT_GT(*FuzzyIndex::score("dot", "vector-dot"), *FuzzyIndex::score("dot", "redotted"));
+
+  std::vector<std::string> names;
+  for (auto sym : all_syms) {
+    names.push_back(sym);
+  }
+  FuzzyIndex index(names);
+  bool truncated = false;
+  auto matches = index.search("vector-", 5, &truncated);
+  EXPECT_EQ(matches.size(), 5);
+  EXPECT_TRUE(truncated);
+  for (size_t i = 0; i < matches.size(); i++) {
+    EXPECT_TRUE(str_util::starts_with(index.name(matches[i].idx), "vector-"));
+    if (i > 0) {
+      EXPECT_GE(matches[i - 1].score, matches[i].score);
+    }
+  }
+
+  matches = index.search("inspect", 1000, &truncated);
+  EXPECT_FALSE(truncated);
+  ASSERT_FALSE(matches.empty());
+  EXPECT_EQ(index.name(matches[0].idx), "inspect");
+}
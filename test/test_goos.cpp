@@ -540,6 +540,27 @@ TEST(GoosEval, KeywordArgsWithDefault) {
   }
 }
 
+TEST(GoosEval, CustomForms) {
+  Interpreter i;
+  // a custom form replaces a macro or lambda with the same name, even after it has been used.
+  e(i, "(desfun foo (x) (+ x 1))");
+  EXPECT_EQ(e(i, "(foo 1)"), "2");
+  i.register_form("foo", [](const Object&, Arguments& args, const auto&) {
+    return Object::make_integer(args.unnamed.size());
+  });
+  EXPECT_EQ(e(i, "(foo 1 2 3)"), "3");
+  // registering again replaces it.
+  i.register_form("foo", [](const Object&, Arguments&, const auto&) {
+    return Object::make_integer(12);
+  });
+  EXPECT_EQ(e(i, "(foo 1 2 3)"), "12");
+  // but the special and builtin forms come first.
+  i.register_form("+", [](const Object&, Arguments&, const auto&) {
+    return Object::make_integer(12);
+  });
+  EXPECT_EQ(e(i, "(+ 1 2)"), "3");
+}
+
 TEST(GoosIntegrated, Begin) {
   Interpreter i;
   EXPECT_EQ(e(i, R"(
@@ -1,6 +1,8 @@
+#include <algorithm>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "common/goal_constants.h"
 #include "common/listener_common.h"
@@ -314,6 +316,7 @@ void setup_hack_heaps(void* mem, int size) {
   SymbolTable2 = symbol_table + BASIC_OFFSET;
   LastSymbol = symbol_table + 0xff00;
   NumSymbols = 0;
+  g_symbol_index.clear();
 
   // set up the empty pair (might not be needed?)
   *(s7 + FIX_SYM_EMPTY_CAR) = (s7 + FIX_SYM_EMPTY_PAIR).offset;
@@ -351,6 +354,79 @@ TEST(Kernel, PrintBuffer) {
   // more complicated tests for format will be done from within GOAL.
 }
 
+TEST(Kernel, KmallocStats) {
+  constexpr int size = 32 * 1024 * 1024;
+  auto mem = new u8[size];
+  setup_hack_heaps(mem, size);
+
+  g_kmalloc_stats.set_enabled(true);
+  kmalloc(kdebugheap, 24, 0, "thing");
+  u32 unaligned = kdebugheap->current.offset;
+  u32 padding = kmalloc(kdebugheap, 24, KMALLOC_ALIGN_256, "thing").offset - unaligned;
+  kmalloc(kdebugheap, 100, KMALLOC_TOP, "temp");
+  EXPECT_EQ(0, kmalloc(kdebugheap, size, 0, "too-big").offset);
+  kmalloc(kglobalheap, 16, 0, "thing");
+  g_kmalloc_stats.set_enabled(false);
+  kmalloc(kdebugheap, 16, 0, "thing");
+
+  auto stats = g_kmalloc_stats.get_stats(kdebugheap.offset);
+  ASSERT_EQ(3, stats.size());
+  EXPECT_EQ("temp", stats[0].name);
+  EXPECT_EQ(100, stats[0].bytes);
+  EXPECT_EQ(12, stats[0].padding);
+  EXPECT_EQ("thing", stats[1].name);
+  EXPECT_EQ(2, stats[1].count);
+  EXPECT_EQ(48, stats[1].bytes);
+  EXPECT_EQ(padding, stats[1].padding);
+  EXPECT_EQ("too-big", stats[2].name);
+  EXPECT_EQ(0, stats[2].count);
+  EXPECT_EQ(1, stats[2].failed);
+  EXPECT_EQ(4, g_kmalloc_stats.get_stats().size());
+
+  EXPECT_EQ(0, KmallocStats::size_bucket(16));
+  EXPECT_EQ(1, KmallocStats::size_bucket(17));
+  EXPECT_EQ(KmallocStats::SIZE_BUCKETS - 1, KmallocStats::size_bucket(size));
+  auto heaps = g_kmalloc_stats.get_heap_stats();
+  auto debug_heap = std::find_if(heaps.begin(), heaps.end(), [](const auto& heap) {
+    return heap.heap == kdebugheap.offset;
+  });
+  ASSERT_TRUE(debug_heap != heaps.end());
+  EXPECT_EQ(2, debug_heap->size_counts[1]);
+  EXPECT_EQ(48, debug_heap->size_bytes[1]);
+  EXPECT_EQ(1, debug_heap->size_counts[3]);
+  EXPECT_EQ(100, debug_heap->largest);
+  EXPECT_EQ(size, debug_heap->largest_failed);
+
+  kinitheap(kdebugheap, kdebugheap->base, kdebugheap->top_base - kdebugheap->base);
+  EXPECT_EQ(0, g_kmalloc_stats.get_stats(kdebugheap.offset).size());
+  g_kmalloc_stats.reset();
+
+  delete[] mem;
+}
+
+TEST(Kernel, Crc32) {
+  init_crc();
+  // crc32 is the remainder of the data divided by CRC_POLY. Check the table-driven version against
+  // dividing one bit at a time, for every length.
+  std::vector<u8> data(100);
+  for (size_t i = 0; i < data.size(); i++) {
+    data[i] = i * 37 + 11;
+  }
+  for (int size = 0; size <= (int)data.size(); size++) {
+    u32 expected = 0;
+    for (int i = 0; i < size; i++) {
+      for (int bit = 7; bit >= 0; bit--) {
+        bool carry = expected & 0x80000000;
+        expected = (expected << 1) | ((data[i] >> bit) & 1);
+        if (carry) {
+          expected ^= CRC_POLY;
+        }
+      }
+    }
+    EXPECT_EQ(~expected, crc32(data.data(), size)) << size;
+  }
+}
+
 TEST(Kernel, HashTable) {
   constexpr int size = 32 * 1024 * 1024;
   auto mem = new u8[size];
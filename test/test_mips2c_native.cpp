@@ -0,0 +1,1221 @@
+// Compare the hand-written native versions of mips2c functions against the mips2c translations,
+// on random inputs. Each function is run once as mips2c and once as native, starting from the same
+// EE memory, and the outputs must be bit-identical.
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+#include "common/math/Vector.h"
+
+#include "game/kernel/common/kscheme.h"
+#include "game/mips2c/bones_native.h"
+#include "game/mips2c/collide_native.h"
+#include "game/mips2c/font_native.h"
+#include "game/mips2c/generic_native.h"
+#include "game/mips2c/joint_native.h"
+#include "game/mips2c/mips2c_private.h"
+#include "game/mips2c/native_mode.h"
+#include "game/mips2c/nav_native.h"
+#include "game/mips2c/ocean_native.h"
+#include "game/mips2c/shadow_native.h"
+#include "game/mips2c/sparticle_native.h"
+#include "game/mips2c/spatial_hash_native.h"
+#include "game/mips2c/time_of_day_native.h"
+#include "gtest/gtest.h"
+
+namespace Mips2C {
+namespace jak1 {
+namespace bones_mtx_calc {
+struct Cache {
+  void* fake_scratchpad_data;
+};
+extern Cache cache;
+u64 execute(void* ctxt);
+u64 execute_mips2c(void* ctxt);
+}  // namespace bones_mtx_calc
+namespace cspace_parented_transformq_joint {
+u64 execute(void* ctxt);
+u64 execute_mips2c(void* ctxt);
+}  // namespace cspace_parented_transformq_joint
+namespace normalize_frame_quaternions {
+u64 execute(void* ctxt);
+u64 execute_mips2c(void* ctxt);
+}  // namespace normalize_frame_quaternions
+namespace clear_frame_accumulator {
+u64 execute(void* ctxt);
+u64 execute_mips2c(void* ctxt);
+}  // namespace clear_frame_accumulator
+namespace generic_light_proc {
+struct Cache {
+  void* fake_scratchpad_data;
+};
+extern Cache cache;
+u64 execute(void* ctxt);
+u64 execute_mips2c(void* ctxt);
+}  // namespace generic_light_proc
+namespace method_11_collide_mesh {
+struct Cache {
+  void* closest_pt_in_triangle;
+};
+extern Cache cache;
+u64 execute(void* ctxt);
+u64 execute_mips2c(void* ctxt);
+}  // namespace method_11_collide_mesh
+namespace method_12_collide_mesh {
+struct Cache {
+  void* closest_pt_in_triangle;
+};
+extern Cache cache;
+u64 execute(void* ctxt);
+u64 execute_mips2c(void* ctxt);
+}  // namespace method_12_collide_mesh
+namespace method_10_collide_puss_work {
+u64 execute(u64 arg0, u64 arg1, u64 arg2, u64 arg3);
+u64 execute_mips2c(void* ctxt);
+}  // namespace method_10_collide_puss_work
+namespace shadow_calc_dual_verts {
+u64 execute(void* ctxt);
+u64 execute_mips2c(void* ctxt);
+}  // namespace shadow_calc_dual_verts
+namespace sp_process_block_2d {
+struct Cache {
+  void* sp_frame_time;
+  void* sp_free_particle;
+  void* sp_orbiter;
+  void* sp_relaunch_particle_2d;
+};
+extern Cache cache;
+u64 execute(void* ctxt);
+u64 execute_mips2c(void* ctxt);
+}  // namespace sp_process_block_2d
+namespace sp_process_block_3d {
+struct Cache {
+  void* sp_frame_time;
+  void* quaternion;
+  void* sp_free_particle;
+  void* sp_relaunch_particle_3d;
+};
+extern Cache cache;
+u64 execute(void* ctxt);
+u64 execute_mips2c(void* ctxt);
+}  // namespace sp_process_block_3d
+namespace time_of_day_interp_colors_scratch {
+struct Cache {
+  void* fake_scratchpad_data;
+};
+extern Cache cache;
+u64 execute(void* ctxt);
+u64 execute_mips2c(void* ctxt);
+}  // namespace time_of_day_interp_colors_scratch
+}  // namespace jak1
+
+namespace jak2 {
+namespace bones_mtx_calc {
+struct Cache {
+  void* fake_scratchpad_data;
+};
+extern Cache cache;
+u64 execute(void* ctxt);
+u64 execute_mips2c(void* ctxt);
+}  // namespace bones_mtx_calc
+namespace cspace_parented_transformq_joint {
+u64 execute(void* ctxt);
+u64 execute_mips2c(void* ctxt);
+}  // namespace cspace_parented_transformq_joint
+namespace generic_light_proc {
+struct Cache {
+  void* fake_scratchpad_data;
+};
+extern Cache cache;
+u64 execute(void* ctxt);
+u64 execute_mips2c(void* ctxt);
+}  // namespace generic_light_proc
+namespace get_string_length {
+struct Cache {
+  void* font_work;
+  void* font12_table;
+  void* font24_table;
+  void* video_params;
+};
+extern Cache cache;
+u64 execute(u64 arg0, u64 arg1, u64 arg2, u64 arg3);
+u64 execute_mips2c(void* ctxt);
+}  // namespace get_string_length
+namespace method_15_ocean {
+u64 execute(u64 arg0, u64 arg1, u64 arg2, u64 arg3);
+u64 execute_mips2c(void* ctxt);
+}  // namespace method_15_ocean
+namespace method_18_grid_hash {
+u64 execute(u64 arg0, u64 arg1, u64 arg2, u64 arg3);
+u64 execute_mips2c(void* ctxt);
+}  // namespace method_18_grid_hash
+namespace method_19_grid_hash {
+u64 execute(u64 arg0, u64 arg1, u64 arg2, u64 arg3);
+u64 execute_mips2c(void* ctxt);
+}  // namespace method_19_grid_hash
+namespace method_39_nav_state {
+u64 execute(u64 arg0, u64 arg1, u64 arg2, u64 arg3);
+u64 execute_mips2c(void* ctxt);
+}  // namespace method_39_nav_state
+}  // namespace jak2
+}  // namespace Mips2C
+
+namespace {
+
+using namespace Mips2C;
+
+class Mips2cNativeTest : public testing::Test {
+ protected:
+  static constexpr u32 MEM_SIZE = 1024 * 1024;
+  // the functions here use little or no stack.
+  static constexpr u32 STACK_TOP = MEM_SIZE - 16;
+
+  void SetUp() override {
+    m_mem.assign(MEM_SIZE, 0);
+    m_old_mem = g_ee_main_mem;
+    m_old_s7 = ::s7;
+    g_ee_main_mem = m_mem.data();
+    // only used for #f and #t here.
+    ::s7 = Ptr<u32>(alloc(16) + 1);
+  }
+
+  void TearDown() override {
+#ifdef __linux__
+    for (void* page : m_code_pages) {
+      munmap(page, kCodePageSize);
+    }
+#endif
+    g_ee_main_mem = m_old_mem;
+    ::s7 = m_old_s7;
+    for (auto& mode : g_native_modes) {
+      mode = NativeMode::NATIVE;
+    }
+  }
+
+  u32 alloc(u32 size) {
+    u32 addr = m_next;
+    m_next += (size + 15) & ~15;
+    EXPECT_LE(m_next, STACK_TOP - 4096);
+    return addr;
+  }
+
+  template <typename T>
+  T* ptr(u32 addr) {
+    return (T*)(m_mem.data() + addr);
+  }
+
+  float random_float(float lo, float hi) {
+    return std::uniform_real_distribution<float>(lo, hi)(m_rng);
+  }
+
+  int random_int(int lo, int hi) { return std::uniform_int_distribution<int>(lo, hi)(m_rng); }
+
+  ExecutionContext context(u64 arg0, u64 arg1 = 0, u64 arg2 = 0, u64 arg3 = 0) {
+    ExecutionContext c;
+    memset(&c, 0, sizeof(c));
+    c.gprs[a0].du64[0] = arg0;
+    c.gprs[a1].du64[0] = arg1;
+    c.gprs[a2].du64[0] = arg2;
+    c.gprs[a3].du64[0] = arg3;
+    c.gprs[Mips2C::s7].du64[0] = ::s7.offset;
+    c.gprs[sp].du64[0] = STACK_TOP;
+    return c;
+  }
+
+  /*!
+   * Run mips2c, then put EE memory back and run native. Returns the two results, and leaves the
+   * mips2c version of EE memory in m_reference.
+   */
+  template <typename Reference, typename Native>
+  std::pair<u64, u64> run_both(NativeGroup group, Reference&& mips2c, Native&& native) {
+    const std::vector<u8> before = m_mem;
+    native_mode(group) = NativeMode::MIPS2C;
+    u64 reference_result = mips2c();
+    m_reference = m_mem;
+    m_mem = before;
+    native_mode(group) = NativeMode::NATIVE;
+    u64 result = native();
+    return {reference_result, result};
+  }
+
+  /*!
+   * A fake jak 1 symbol holding value. Returns what intern_from_c(...).c() would, for filling in
+   * the cache of a mips2c function.
+   */
+  void* jak1_symbol(u32 value) {
+    const u32 sym = alloc(4);
+    *ptr<u32>(sym) = value;
+    return ptr<u8>(sym);
+  }
+
+  /*!
+   * Same as jak1_symbol, but jak 2 symbol pointers are one byte past the value.
+   */
+  void* jak2_symbol(u32 value) {
+    const u32 sym = alloc(4);
+    *ptr<u32>(sym) = value;
+    return ptr<u8>(sym + 1);
+  }
+
+  /*!
+   * A GOAL function that runs fn, for mips2c functions that call back into GOAL. Returns its GOAL
+   * address, or 0 if it can't be made on this platform. GOAL passes the first four arguments in
+   * the same registers as the System V ABI, so the function just jumps to fn.
+   */
+  u32 goal_function(u64 (*fn)(u64, u64, u64, u64)) {
+#ifdef __linux__
+    // GOAL addresses are 32-bit offsets from EE memory, so the code goes somewhere after it.
+    const uintptr_t base = (uintptr_t)m_mem.data();
+    const uintptr_t end = base + m_mem.size();
+    void* page = nullptr;
+    for (uintptr_t hint = (end + 2 * kCodePageSize) & ~(kCodePageSize - 1);
+         !page && hint - base < UINT32_MAX; hint += 64 * 1024 * 1024) {
+      void* mapped = mmap((void*)hint, kCodePageSize, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (mapped == MAP_FAILED) {
+        return 0;
+      }
+      if ((uintptr_t)mapped >= end && (uintptr_t)mapped - base < UINT32_MAX - kCodePageSize) {
+        page = mapped;
+      } else {
+        munmap(mapped, kCodePageSize);
+      }
+    }
+    if (!page) {
+      return 0;
+    }
+    m_code_pages.push_back(page);
+    const uintptr_t offset = (uintptr_t)page - base;
+    // mov rax, fn; jmp rax
+    u8* code = (u8*)page;
+    code[0] = 0x48;
+    code[1] = 0xb8;
+    memcpy(code + 2, &fn, 8);
+    code[10] = 0xff;
+    code[11] = 0xe0;
+    if (mprotect(page, kCodePageSize, PROT_READ | PROT_EXEC)) {
+      return 0;
+    }
+    return offset;
+#else
+    (void)fn;
+    return 0;
+#endif
+  }
+
+  bool same_floats_as_reference(u32 addr, u32 size) {
+    return same_floats((const float*)(m_reference.data() + addr), ptr<float>(addr), size / 4);
+  }
+
+  bool same_bytes_as_reference(u32 addr, u32 size) {
+    return !memcmp(m_reference.data() + addr, ptr<u8>(addr), size);
+  }
+
+  std::vector<u8> m_mem;
+  std::vector<u8> m_reference;
+  u32 m_next = 0x1000;
+  std::mt19937 m_rng{1234};
+
+ private:
+  static constexpr size_t kCodePageSize = 4096;
+  u8* m_old_mem = nullptr;
+  Ptr<u32> m_old_s7;
+  std::vector<void*> m_code_pages;
+};
+
+template <typename Random>
+void random_unit_quaternion(float* q, Random&& random) {
+  float len = 0;
+  for (int i = 0; i < 4; i++) {
+    q[i] = random(-1.f, 1.f);
+    len += q[i] * q[i];
+  }
+  len = std::sqrt(len);
+  for (int i = 0; i < 4; i++) {
+    q[i] /= len;
+  }
+}
+
+class Mips2cNativeJointTest : public Mips2cNativeTest {
+ protected:
+  /*!
+   * cspace<-parented-transformq-joint! on random bones. Includes parents with negative and zero
+   * scale, and with the scale flag off.
+   */
+  template <typename Mips2cFunc, typename NativeFunc>
+  void test_parented_transformq(Mips2cFunc mips2c, NativeFunc native) {
+    const u32 parent_bone = alloc(sizeof(joint_native::Bone));
+    const u32 bone = alloc(sizeof(joint_native::Bone));
+    const u32 parent_cspace = alloc(32);
+    const u32 cspace = alloc(32);
+    const u32 xform = alloc(sizeof(joint_native::TransformQ));
+    *ptr<u32>(parent_cspace + 16) = parent_bone;
+    *ptr<u32>(cspace) = parent_cspace;
+    *ptr<u32>(cspace + 16) = bone;
+    auto random = [&](float lo, float hi) { return random_float(lo, hi); };
+
+    for (int iter = 0; iter < 200; iter++) {
+      auto* parent = ptr<joint_native::Bone>(parent_bone);
+      for (auto& row : parent->transform) {
+        for (auto& x : row) {
+          x = random_float(-2.f, 2.f);
+        }
+      }
+      for (int i = 0; i < 3; i++) {
+        parent->scale[i] = random_float(0.5f, 2.f);
+      }
+      switch (iter % 4) {
+        case 0:
+          parent->scale[3] = 0.f;
+          break;
+        case 1:
+          parent->scale[2] = -parent->scale[2];
+          parent->scale[3] = 1.f;
+          break;
+        case 2:
+          parent->scale[random_int(0, 2)] = 0.f;
+          parent->scale[3] = 1.f;
+          break;
+        default:
+          parent->scale[3] = 1.f;
+          break;
+      }
+      auto* q = ptr<joint_native::TransformQ>(xform);
+      for (int i = 0; i < 3; i++) {
+        q->trans[i] = random_float(-100.f, 100.f);
+        q->scale[i] = random_float(0.25f, 4.f);
+      }
+      q->trans[3] = 1.f;
+      q->scale[3] = 1.f;
+      random_unit_quaternion(q->quat, random);
+      memset(ptr<u8>(bone), 0, sizeof(joint_native::Bone));
+
+      auto [reference, result] = run_both(
+          NativeGroup::JOINT,
+          [&]() {
+            auto c = context(cspace, xform);
+            return mips2c(&c);
+          },
+          [&]() {
+            auto c = context(cspace, xform);
+            return native(&c);
+          });
+      EXPECT_EQ(reference, result);
+      ASSERT_TRUE(same_floats_as_reference(bone, sizeof(joint_native::Bone))) << "iter " << iter;
+    }
+  }
+
+  /*!
+   * A frame accumulator with random joints. The last one is all zero.
+   */
+  u32 random_frame(s64 joint_count) {
+    const u32 size = joint_native::frame_accumulator_size(joint_count);
+    const u32 frame = alloc(size);
+    for (u32 i = 0; i < size / 4; i++) {
+      ptr<float>(frame)[i] = random_float(-3.f, 3.f);
+    }
+    memset(ptr<u8>(frame + size - sizeof(joint_native::AccumulatorJoint)), 0,
+           sizeof(joint_native::AccumulatorJoint));
+    return frame;
+  }
+
+  /*!
+   * The accumulator functions take the frame in a0 and the joint count in s2.
+   */
+  template <typename Mips2cFunc, typename NativeFunc>
+  void test_frame_function(Mips2cFunc mips2c, NativeFunc native) {
+    for (s64 joint_count : {3, 4, 17, 50}) {
+      const u32 frame = random_frame(joint_count);
+      auto run = [&](auto f) {
+        auto c = context(frame);
+        c.gprs[s2].du64[0] = joint_count;
+        u64 ret = f(&c);
+        EXPECT_EQ(0u, c.gprs[s2].du64[0]);
+        return ret;
+      };
+      auto [reference, result] = run_both(
+          NativeGroup::JOINT, [&]() { return run(mips2c); }, [&]() { return run(native); });
+      EXPECT_EQ(reference, result);
+      EXPECT_TRUE(
+          same_floats_as_reference(frame, joint_native::frame_accumulator_size(joint_count)))
+          << joint_count << " joints";
+    }
+  }
+};
+
+class Mips2cNativeGenericTest : public Mips2cNativeTest {
+ protected:
+  /*!
+   * generic-light-proc on random vertices. The function finds everything through the scratchpad,
+   * with generic-saves at saves_offset. Includes NaN normals, negative color limits and vertex
+   * tables that aren't 16-byte aligned.
+   */
+  template <typename Mips2cFunc, typename NativeFunc>
+  void test_light_proc(void*& spad_symbol_cache,
+                       bool jak2,
+                       u32 saves_offset,
+                       Mips2cFunc mips2c,
+                       NativeFunc native) {
+    using namespace Mips2C::generic_native;
+    constexpr u32 kMaxGroups = 32;
+    const u32 spad = alloc(16 * 1024);
+    spad_symbol_cache = jak2 ? jak2_symbol(spad) : jak1_symbol(spad);
+    auto* saves = ptr<GenericSaves>(spad + saves_offset);
+    saves->gsf_buf = alloc(sizeof(GsfInfo));
+    auto* gsf = ptr<GsfInfo>(saves->gsf_buf);
+    gsf->ptr_iks = alloc(8 * kMaxGroups);
+    const u32 verts = alloc(32 * 256 + 16);
+    saves->ptr_vtxs = alloc(48 * kMaxGroups);
+    saves->ptr_texs = alloc(16 * kMaxGroups);
+    saves->ptr_clrs = alloc(16 * kMaxGroups);
+
+    for (int iter = 0; iter < 200; iter++) {
+      saves->num_dps = random_int(0, 4 * kMaxGroups);
+      gsf->ptr_verts = verts + (iter % 3 == 0 ? 8 : 0);
+      for (u32 i = 0; i < 4 * kMaxGroups; i++) {
+        ptr<u16>(gsf->ptr_iks)[i] = random_int(0, 511);
+      }
+      for (u32 i = 0; i < 256 * 8; i++) {
+        ptr<float>(gsf->ptr_verts)[i] = random_float(-1.f, 1.f);
+      }
+      for (u32 i = 0; i < 256; i++) {
+        auto* v = ptr<GsfVertex>(gsf->ptr_verts + 32 * i);
+        v->tex = m_rng();
+        for (auto& x : v->clr) {
+          x = random_int(0, 255);
+        }
+        if (random_int(0, 50) == 0) {
+          v->nrm[random_int(0, 2)] = NAN;
+        }
+      }
+      auto* lights = ptr<VuLights>(spad + GENERIC_LIGHTS_OFFSET);
+      for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 4; j++) {
+          lights->direction[i][j] = random_float(-1.f, 1.f);
+          lights->color[i][j] = random_float(0.f, 2.f);
+        }
+      }
+      for (auto& x : lights->ambient) {
+        x = random_float(0.f, 1.f);
+      }
+      *ptr<float>(spad + GENERIC_LIGHT_CONSTS_OFFSET) =
+          iter % 10 ? random_float(128.f, 255.f) : random_float(-255.f, 0.f);
+
+      // the mips2c version saves registers relative to at, which is the scratchpad in game.
+      auto run = [&](auto f) {
+        auto c = context(0);
+        c.gprs[at].du64[0] = spad;
+        return f(&c);
+      };
+      auto [reference, result] = run_both(
+          NativeGroup::GENERIC, [&]() { return run(mips2c); }, [&]() { return run(native); });
+      EXPECT_EQ(reference, result);
+      const u32 groups = light_groups(saves);
+      ASSERT_TRUE(same_bytes_as_reference(saves->ptr_vtxs, 48 * groups)) << "iter " << iter;
+      ASSERT_TRUE(same_bytes_as_reference(saves->ptr_texs, 16 * groups)) << "iter " << iter;
+      ASSERT_TRUE(same_bytes_as_reference(saves->ptr_clrs, 16 * groups)) << "iter " << iter;
+    }
+  }
+};
+
+/*!
+ * Stand-in for the GOAL closest-pt-in-triangle(out, point, tri, normal), from Real-Time Collision
+ * Detection. Both versions call it, so it only needs to be a reasonable closest point.
+ */
+u64 closest_pt_in_triangle(u64 out, u64 point, u64 tri, u64 /*normal*/) {
+  using math::Vector3f;
+  auto vec = [](u64 addr) {
+    Vector3f result;
+    memcpy(result.data(), g_ee_main_mem + addr, 12);
+    return result;
+  };
+  const Vector3f p = vec(point);
+  const Vector3f a = vec(tri);
+  const Vector3f b = vec(tri + 16);
+  const Vector3f c = vec(tri + 32);
+  const Vector3f ab = b - a;
+  const Vector3f ac = c - a;
+  const Vector3f ap = p - a;
+  const Vector3f bp = p - b;
+  const Vector3f cp = p - c;
+  const float d1 = ab.dot(ap), d2 = ac.dot(ap);
+  const float d3 = ab.dot(bp), d4 = ac.dot(bp);
+  const float d5 = ab.dot(cp), d6 = ac.dot(cp);
+  const float va = d3 * d6 - d5 * d4;
+  const float vb = d5 * d2 - d1 * d6;
+  const float vc = d1 * d4 - d3 * d2;
+  Vector3f result;
+  if (d1 <= 0 && d2 <= 0) {
+    result = a;
+  } else if (d3 >= 0 && d4 <= d3) {
+    result = b;
+  } else if (vc <= 0 && d1 >= 0 && d3 <= 0) {
+    result = a + ab * (d1 / (d1 - d3));
+  } else if (d6 >= 0 && d5 <= d6) {
+    result = c;
+  } else if (vb <= 0 && d2 >= 0 && d6 <= 0) {
+    result = a + ac * (d2 / (d2 - d6));
+  } else if (va <= 0 && (d4 - d3) >= 0 && (d5 - d6) >= 0) {
+    result = b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+  } else {
+    const float denom = 1.f / (va + vb + vc);
+    result = a + ab * (vb * denom) + ac * (vc * denom);
+  }
+  memcpy(g_ee_main_mem + out, result.data(), 12);
+  return out;
+}
+
+class Mips2cNativeSparticleTest : public Mips2cNativeTest {
+ protected:
+  static constexpr u32 kCount = 32;
+
+  void SetUp() override {
+    Mips2cNativeTest::SetUp();
+    m_frame = alloc(16);
+    m_cpuinfo = alloc(kCount * sizeof(sparticle_native::CpuInfo));
+    m_sprites = alloc(kCount * sizeof(sparticle_native::SpriteVec));
+  }
+
+  /*!
+   * Random particles that don't call back into GOAL: the callbacks and quaternion*! are GOAL code,
+   * which can't run here. So there are no funcs, launchers or orbiters, timers don't run out, and
+   * the sizes and colors stay positive so the free flags don't trigger. Some are invalid. The 3d
+   * ones are only run paused, since an update calls quaternion*!.
+   */
+  void random_particles(bool is_3d) {
+    using namespace Mips2C::sparticle_native;
+    auto* frame = ptr<float>(m_frame);
+    const u32 ticks = random_int(1, 12);
+    memcpy(&frame[0], &ticks, 4);
+    frame[1] = random_float(0.5f, 3.f);
+    frame[2] = random_float(0.5f, 3.f);
+    frame[3] = random_float(0.5f, 3.f);
+
+    const u32 flag_choices[] = {0, SP_BIT0, SP_BIT1, SP_BIT2, SP_READY_TO_LAUNCH, SP_BIT13,
+                                SP_BIT0 | SP_BIT1 | SP_BIT2 | SP_READY_TO_LAUNCH | SP_BIT13};
+    for (u32 i = 0; i < kCount; i++) {
+      auto* cpu = ptr<CpuInfo>(m_cpuinfo) + i;
+      auto* sprite = ptr<SpriteVec>(m_sprites) + i;
+      memset(cpu, 0, sizeof(CpuInfo));
+      for (int j = 0; j < 4; j++) {
+        cpu->vel_sxvel[j] = random_float(-5.f, 5.f);
+        cpu->rot_syvel[j] = random_float(-500.f, 500.f);
+        cpu->fade[j] = random_float(0.f, 2.f);
+        cpu->acc[j] = random_float(-1.f, 1.f);
+        sprite->x_y_z_sx[j] = random_float(-1000.f, 1000.f);
+        sprite->r_g_b_a[j] = random_float(1.f, 128.f);
+      }
+      cpu->vel_sxvel[3] = random_float(0.f, 5.f);
+      cpu->rot_syvel[3] = random_float(0.f, 5.f);
+      cpu->friction = random_int(0, 1) ? random_float(0.9f, 1.f) : 0.f;
+      cpu->timer = random_int(0, 3) ? random_int(50, 1000) : -1;
+      cpu->flags = flag_choices[random_int(0, 6)];
+      if (is_3d) {
+        // would update while paused.
+        cpu->flags &= ~SP_BIT13;
+      }
+      cpu->cache_alpha = random_float(0.f, 128.f);
+      cpu->valid = random_int(0, 7) ? ::s7.offset + 4 : ::s7.offset;
+      sprite->x_y_z_sx[3] = random_float(0.f, 10.f);
+      if (is_3d) {
+        float q[4];
+        random_unit_quaternion(q, [&](float lo, float hi) { return random_float(lo, hi); });
+        memcpy(sprite->flag_rot_sy, q, 12);
+        random_unit_quaternion(cpu->rotvel3d,
+                               [&](float lo, float hi) { return random_float(lo, hi); });
+      } else {
+        const s32 flag_and_matrix[2] = {random_int(0, 3), random_int(0, 3)};
+        memcpy(sprite->flag_rot_sy, flag_and_matrix, 8);
+        // big enough to wrap around.
+        sprite->flag_rot_sy[2] = random_float(-40000.f, 40000.f);
+      }
+      sprite->flag_rot_sy[3] = random_float(0.f, 10.f);
+    }
+  }
+
+  template <typename Mips2cFunc, typename NativeFunc>
+  void run_block(NativeGroup group, bool paused, Mips2cFunc mips2c, NativeFunc native) {
+    const u32 index = random_int(0, 100);
+    auto run = [&](auto f) {
+      auto c = context(0, m_cpuinfo, m_sprites, index);
+      c.gprs[t0].du64[0] = kCount;
+      c.gprs[t1].du64[0] = paused ? ::s7.offset + 4 : ::s7.offset;
+      return f(&c);
+    };
+    auto [reference, result] =
+        run_both(group, [&]() { return run(mips2c); }, [&]() { return run(native); });
+    EXPECT_EQ(index + kCount, reference);
+    EXPECT_EQ(reference, result);
+    EXPECT_TRUE(same_floats_as_reference(m_cpuinfo, kCount * sizeof(sparticle_native::CpuInfo)));
+    EXPECT_TRUE(same_floats_as_reference(m_sprites, kCount * sizeof(sparticle_native::SpriteVec)));
+  }
+
+  u32 m_frame = 0;
+  u32 m_cpuinfo = 0;
+  u32 m_sprites = 0;
+};
+
+}  // namespace
+
+TEST_F(Mips2cNativeJointTest, ParentedTransformqJak1) {
+  test_parented_transformq(Mips2C::jak1::cspace_parented_transformq_joint::execute_mips2c,
+                           Mips2C::jak1::cspace_parented_transformq_joint::execute);
+}
+
+TEST_F(Mips2cNativeJointTest, ParentedTransformqJak2) {
+  test_parented_transformq(Mips2C::jak2::cspace_parented_transformq_joint::execute_mips2c,
+                           Mips2C::jak2::cspace_parented_transformq_joint::execute);
+}
+
+TEST_F(Mips2cNativeJointTest, NormalizeFrameQuaternions) {
+  test_frame_function(Mips2C::jak1::normalize_frame_quaternions::execute_mips2c,
+                      Mips2C::jak1::normalize_frame_quaternions::execute);
+}
+
+TEST_F(Mips2cNativeJointTest, ClearFrameAccumulator) {
+  test_frame_function(Mips2C::jak1::clear_frame_accumulator::execute_mips2c,
+                      Mips2C::jak1::clear_frame_accumulator::execute);
+}
+
+TEST_F(Mips2cNativeGenericTest, LightProcJak1) {
+  // jak 1's generic-work starts 16 bytes into the scratchpad.
+  test_light_proc(Mips2C::jak1::generic_light_proc::cache.fake_scratchpad_data, false, 16,
+                  Mips2C::jak1::generic_light_proc::execute_mips2c,
+                  Mips2C::jak1::generic_light_proc::execute);
+}
+
+TEST_F(Mips2cNativeGenericTest, LightProcJak2) {
+  test_light_proc(Mips2C::jak2::generic_light_proc::cache.fake_scratchpad_data, true, 0,
+                  Mips2C::jak2::generic_light_proc::execute_mips2c,
+                  Mips2C::jak2::generic_light_proc::execute);
+}
+
+TEST_F(Mips2cNativeTest, PussSpheresOverlap) {
+  const u32 work_addr = alloc(sizeof(collide_native::PussWork));
+  const u32 sphere = alloc(16);
+  // only the count, at offset 4, is read.
+  const u32 cache = alloc(16);
+  auto* work = ptr<collide_native::PussWork>(work_addr);
+
+  int hits = 0;
+  for (int iter = 0; iter < 500; iter++) {
+    const u32 count = iter % 17;
+    *ptr<u32>(cache + 4) = count;
+    for (int i = 0; i < 3; i++) {
+      work->spheres_bbox_min[i] = INT32_MAX;
+      work->spheres_bbox_max[i] = INT32_MIN;
+    }
+    for (u32 s = 0; s < count; s++) {
+      auto& bs = work->spheres[s].bsphere;
+      bs[3] = random_float(1.f, 10.f);
+      for (int i = 0; i < 3; i++) {
+        bs[i] = random_float(-50.f, 50.f);
+        work->spheres_bbox_min[i] = std::min(work->spheres_bbox_min[i], (s32)(bs[i] - bs[3]));
+        work->spheres_bbox_max[i] = std::max(work->spheres_bbox_max[i], (s32)(bs[i] + bs[3]));
+      }
+    }
+    for (int i = 0; i < 3; i++) {
+      ptr<float>(sphere)[i] = random_float(-70.f, 70.f);
+    }
+    ptr<float>(sphere)[3] = random_float(1.f, 20.f);
+
+    auto [reference, result] = run_both(
+        NativeGroup::COLLIDE,
+        [&]() {
+          auto c = context(work_addr, sphere, cache);
+          return Mips2C::jak1::method_10_collide_puss_work::execute_mips2c(&c);
+        },
+        [&]() {
+          return Mips2C::jak1::method_10_collide_puss_work::execute(work_addr, sphere, cache, 0);
+        });
+    ASSERT_EQ(reference, result) << "iter " << iter;
+    hits += result != ::s7.offset;
+  }
+  // both answers should have come up.
+  EXPECT_GT(hits, 0);
+  EXPECT_LT(hits, 500);
+}
+
+TEST_F(Mips2cNativeTest, OceanAddWaves) {
+  const u32 size = ocean_native::WAVE_HEIGHT_COUNT * sizeof(float);
+  const u32 dst = alloc(size);
+  const u32 src = alloc(size);
+  for (u32 i = 0; i < ocean_native::WAVE_HEIGHT_COUNT; i++) {
+    ptr<float>(dst)[i] = random_float(-1000.f, 1000.f);
+    ptr<float>(src)[i] = random_float(-1000.f, 1000.f);
+  }
+  auto [reference, result] = run_both(
+      NativeGroup::OCEAN,
+      [&]() {
+        auto c = context(0, dst, src);
+        return Mips2C::jak2::method_15_ocean::execute_mips2c(&c);
+      },
+      [&]() { return Mips2C::jak2::method_15_ocean::execute(0, dst, src, 0); });
+  EXPECT_EQ(reference, result);
+  EXPECT_TRUE(same_floats_as_reference(dst, size));
+}
+
+TEST_F(Mips2cNativeTest, GridHashSetAndClearIdInBox) {
+  const u32 grid_addr = alloc(sizeof(spatial_hash_native::GridHash));
+  const u32 box_addr = alloc(16);
+  auto* grid = ptr<spatial_hash_native::GridHash>(grid_addr);
+  grid->dimension_array[0] = 8;
+  grid->dimension_array[1] = 4;
+  grid->dimension_array[2] = 6;
+  grid->bucket_size = 16;
+  grid->bucket_count = 8 * 4 * 6;
+  grid->bucket_memory_size = grid->bucket_count * grid->bucket_size;
+  grid->bucket_array = alloc(grid->bucket_memory_size);
+  for (s32 i = 0; i < grid->bucket_memory_size; i++) {
+    ptr<u8>(grid->bucket_array)[i] = random_int(0, 255);
+  }
+
+  auto* box = ptr<spatial_hash_native::GridHashBox>(box_addr);
+  for (int iter = 0; iter < 200; iter++) {
+    for (int i = 0; i < 3; i++) {
+      s8 a = random_int(0, grid->dimension_array[i] - 1);
+      s8 b = random_int(0, grid->dimension_array[i] - 1);
+      box->min[i] = std::min(a, b);
+      box->max[i] = std::max(a, b);
+    }
+    const s64 id = random_int(0, grid->bucket_size * 8 - 1);
+    const bool set = iter % 2;
+    auto [reference, result] = run_both(
+        NativeGroup::SPATIAL_HASH,
+        [&]() {
+          auto c = context(grid_addr, box_addr, id);
+          return set ? Mips2C::jak2::method_18_grid_hash::execute_mips2c(&c)
+                     : Mips2C::jak2::method_19_grid_hash::execute_mips2c(&c);
+        },
+        [&]() {
+          return set ? Mips2C::jak2::method_18_grid_hash::execute(grid_addr, box_addr, id, 0)
+                     : Mips2C::jak2::method_19_grid_hash::execute(grid_addr, box_addr, id, 0);
+        });
+    EXPECT_EQ(reference, result);
+    ASSERT_TRUE(same_bytes_as_reference(grid->bucket_array, grid->bucket_memory_size))
+        << "iter " << iter;
+  }
+}
+
+TEST_F(Mips2cNativeTest, ShadowCalcDualVerts) {
+  using namespace Mips2C::shadow_native;
+  const u32 frag = alloc(sizeof(ShadowFragHeader));
+  // jak 1 has the center and plane right after the header.
+  const u32 dcache_addr = alloc(96);
+  const u32 verts = alloc(64 * 16);
+  const u32 out = alloc(64 * 16 + 64);
+  auto* dcache = ptr<ShadowDcacheHeader>(dcache_addr);
+
+  for (int iter = 0; iter < 100; iter++) {
+    const u32 count = 1 + iter % 40;
+    ptr<ShadowFragHeader>(frag)->num_verts = count;
+    dcache->vtx_table = verts;
+    // not aligned, the functions round it up.
+    dcache->dcache_top = out + 4;
+    dcache->ptr_dual_verts = 0;
+    for (u32 i = 0; i < count; i++) {
+      float* v = ptr<float>(verts + 16 * i);
+      v[0] = random_float(-10.f, 10.f);
+      v[1] = random_float(0.f, 10.f);
+      v[2] = random_float(-10.f, 10.f);
+      v[3] = 1.f;
+    }
+    float* center = ptr<float>(dcache_addr + 64);
+    float* plane = ptr<float>(dcache_addr + 80);
+    center[0] = random_float(-5.f, 5.f);
+    center[1] = random_float(20.f, 40.f);
+    center[2] = random_float(-5.f, 5.f);
+    center[3] = 1.f;
+    float normal[4];
+    random_unit_quaternion(normal, [&](float lo, float hi) { return random_float(lo, hi); });
+    plane[0] = normal[0] * 0.2f;
+    plane[1] = 1.f;
+    plane[2] = normal[2] * 0.2f;
+    plane[3] = random_float(-2.f, 2.f);
+
+    auto run = [&](auto f) {
+      auto c = context(frag, dcache_addr);
+      return f(&c);
+    };
+    auto [reference, result] = run_both(
+        NativeGroup::SHADOW,
+        [&]() { return run(Mips2C::jak1::shadow_calc_dual_verts::execute_mips2c); },
+        [&]() { return run(Mips2C::jak1::shadow_calc_dual_verts::execute); });
+    EXPECT_EQ(reference, result);
+    ASSERT_TRUE(same_bytes_as_reference(dcache_addr, sizeof(ShadowDcacheHeader)))
+        << count << " verts";
+    ASSERT_TRUE(same_floats_as_reference(out + 16, 16 * count)) << count << " verts";
+  }
+}
+
+TEST_F(Mips2cNativeTest, NavLimitRotation) {
+  using namespace Mips2C::nav_native;
+  const u32 state_addr = alloc(sizeof(NavState));
+  const u32 nav_addr = alloc(sizeof(NavControl));
+  const u32 mesh_addr = alloc(sizeof(NavMesh));
+  const u32 work_addr = alloc(sizeof(NavMeshWork));
+  auto* state = ptr<NavState>(state_addr);
+  state->nav = nav_addr;
+  state->mesh = mesh_addr;
+  ptr<NavMesh>(mesh_addr)->work = work_addr;
+  ptr<NavControl>(nav_addr)->sec_per_frame = 1.f / 60.f;
+  auto* work = ptr<NavMeshWork>(work_addr);
+  // GOAL degrees are 65536 to a turn.
+  work->deg_to_rad = 9.58738e-05f;
+  work->rad_to_deg = 10430.378f;
+  work->nav_poly_epsilon = 0.1f;
+
+  int changed = 0;
+  for (int iter = 0; iter < 500; iter++) {
+    state->rotation_rate = random_float(0.f, 65536.f * 4);
+    const float len = iter % 10 ? random_float(0.2f, 100.f) : random_float(0.f, 0.2f);
+    const float travel_angle = random_float(-3.14159f, 3.14159f);
+    state->travel[0] = std::sin(travel_angle) * len;
+    state->travel[1] = random_float(-1.f, 1.f);
+    state->travel[2] = std::cos(travel_angle) * len;
+    state->travel[3] = 0.f;
+    const float heading_angle = travel_angle + random_float(-1.f, 1.f);
+    state->heading[0] = std::sin(heading_angle);
+    state->heading[1] = 0.f;
+    state->heading[2] = std::cos(heading_angle);
+    state->heading[3] = 0.f;
+
+    auto [reference, result] = run_both(
+        NativeGroup::NAV,
+        [&]() {
+          auto c = context(state_addr);
+          return Mips2C::jak2::method_39_nav_state::execute_mips2c(&c);
+        },
+        [&]() { return Mips2C::jak2::method_39_nav_state::execute(state_addr, 0, 0, 0); });
+    ASSERT_EQ(reference, result) << "iter " << iter;
+    ASSERT_TRUE(same_floats_as_reference(state_addr, sizeof(NavState))) << "iter " << iter;
+    changed += result != ::s7.offset;
+  }
+  EXPECT_GT(changed, 0);
+  EXPECT_LT(changed, 500);
+}
+
+TEST_F(Mips2cNativeTest, TimeOfDayInterpColors) {
+  using namespace Mips2C::time_of_day_native;
+  Mips2C::jak1::time_of_day_interp_colors_scratch::cache.fake_scratchpad_data =
+      jak1_symbol(alloc(16 * 1024));
+  constexpr s32 kMaxHeight = 100;
+  // both are basics, so the fields the mips2c version reads with lq are aligned.
+  const u32 palette = alloc(PALETTE_DATA_OFFSET + 32 * interp_color_count(kMaxHeight)) + 4;
+  const u32 mood = alloc(MOOD_ITIMES_OFFSET + 64) + 4;
+  const u32 out = alloc(4 * interp_color_count(kMaxHeight));
+
+  for (s32 height : {0, 1, 31, 32, 33, 64, kMaxHeight}) {
+    *ptr<s32>(palette + PALETTE_HEIGHT_OFFSET) = height;
+    for (s32 i = 0; i < 32 * interp_color_count(height); i++) {
+      ptr<u8>(palette + PALETTE_DATA_OFFSET)[i] = random_int(0, 255);
+    }
+    // large weights, so the 16-bit sums wrap and the clamp is hit.
+    for (int i = 0; i < 32; i++) {
+      ptr<u16>(mood + MOOD_ITIMES_OFFSET)[i] = random_int(0, height % 2 ? 0xffff : 64);
+    }
+    auto run = [&](auto f) {
+      auto c = context(out, palette, mood);
+      return f(&c);
+    };
+    auto [reference, result] = run_both(
+        NativeGroup::TIME_OF_DAY,
+        [&]() { return run(Mips2C::jak1::time_of_day_interp_colors_scratch::execute_mips2c); },
+        [&]() { return run(Mips2C::jak1::time_of_day_interp_colors_scratch::execute); });
+    EXPECT_EQ(reference, result);
+    EXPECT_TRUE(same_bytes_as_reference(out, 4 * interp_color_count(height)))
+        << "height " << height;
+  }
+}
+
+TEST_F(Mips2cNativeTest, GetStringLength) {
+  using namespace Mips2C::font_native;
+  constexpr u32 kFontWorkSize = FONT_WORK_FLAGS + 16;
+  constexpr int kMaxLength = 60;
+  // glyphs are looked up 96 bytes before the table.
+  auto random_table = [&]() {
+    const u32 table = alloc(96 + 16 * 256) + 96;
+    for (u32 i = 0; i < 16 * 256; i++) {
+      ptr<float>(table - 96)[i] = random_float(0.f, 20.f);
+    }
+    return table;
+  };
+  const u32 font_work = alloc(kFontWorkSize);
+  const u32 video_params = alloc(32);
+  auto& cache = Mips2C::jak2::get_string_length::cache;
+  cache.font_work = jak2_symbol(font_work);
+  cache.font12_table = jak2_symbol(random_table());
+  cache.font24_table = jak2_symbol(random_table());
+  cache.video_params = jak2_symbol(video_params);
+  // a basic, so the origin at 12 is aligned.
+  const u32 font_context = alloc(80) + 4;
+  const u32 str = alloc(4 + kMaxLength + 1) + 4;
+
+  // mostly ~ codes and the characters that can follow them, to hit the parser's corner cases.
+  const std::string alphabet = "~~~~~~~~+-0123456789nNkKhHyYzZlwjvuAb \n\r\1\2\3";
+  // the returned width and the parts of font-work the function writes, after each call.
+  struct Call {
+    u64 result;
+    u8 size2_and_save[FONT_WORK_SAVE + 16 - FONT_WORK_SIZE2];
+    u8 str_ptr_and_flags[8];
+  };
+  constexpr int kCallsPerRun = 100;
+
+  for (int run = 0; run < 2000; run++) {
+    for (u32 i = 0; i < kFontWorkSize / 4; i++) {
+      ptr<float>(font_work)[i] = random_float(-10.f, 10.f);
+    }
+    ptr<float>(video_params)[4] = random_float(0.5f, 2.f);
+    for (int i = 0; i < 20; i++) {
+      ptr<float>(font_context)[i] = random_float(-100.f, 100.f);
+    }
+    const u32 flag_choices[] = {0, FONT_FLAG_KERNING, FONT_FLAG_LARGE,
+                                FONT_FLAG_KERNING | FONT_FLAG_LARGE};
+    *ptr<u32>(font_context + 64) = flag_choices[random_int(0, 3)];
+    std::vector<std::string> strings;
+    for (int i = 0; i < kCallsPerRun; i++) {
+      std::string& text = strings.emplace_back();
+      const int length = random_int(0, kMaxLength);
+      for (int j = 0; j < length; j++) {
+        text.push_back(alphabet[random_int(0, alphabet.size() - 1)]);
+      }
+    }
+
+    auto run_strings = [&](auto f) {
+      std::vector<Call> calls(kCallsPerRun);
+      for (int i = 0; i < kCallsPerRun; i++) {
+        memset(ptr<char>(str + 4), 0, kMaxLength + 1);
+        memcpy(ptr<char>(str + 4), strings[i].data(), strings[i].size());
+        *ptr<u32>(str) = strings[i].size();
+        calls[i].result = f();
+        memcpy(calls[i].size2_and_save, ptr<u8>(font_work + FONT_WORK_SIZE2),
+               sizeof(calls[i].size2_and_save));
+        memcpy(calls[i].str_ptr_and_flags, ptr<u8>(font_work + FONT_WORK_STR_PTR), 8);
+      }
+      return calls;
+    };
+    std::vector<Call> reference, result;
+    run_both(
+        NativeGroup::FONT,
+        [&]() {
+          reference = run_strings([&]() {
+            auto c = context(str, font_context);
+            return Mips2C::jak2::get_string_length::execute_mips2c(&c);
+          });
+          return 0;
+        },
+        [&]() {
+          result = run_strings(
+              [&]() { return Mips2C::jak2::get_string_length::execute(str, font_context, 0, 0); });
+          return 0;
+        });
+    for (int i = 0; i < kCallsPerRun; i++) {
+      ASSERT_EQ(reference[i].result, result[i].result) << "\"" << strings[i] << "\"";
+      ASSERT_TRUE(!memcmp(&reference[i], &result[i], sizeof(Call))) << "\"" << strings[i] << "\"";
+    }
+    ASSERT_TRUE(same_bytes_as_reference(font_work, kFontWorkSize));
+  }
+}
+
+TEST_F(Mips2cNativeSparticleTest, ProcessBlock2d) {
+  auto& cache = Mips2C::jak1::sp_process_block_2d::cache;
+  cache.sp_frame_time = jak1_symbol(m_frame);
+  // the functions are loaded in branch delay slots, but never called.
+  cache.sp_free_particle = jak1_symbol(0);
+  cache.sp_orbiter = jak1_symbol(0);
+  cache.sp_relaunch_particle_2d = jak1_symbol(0);
+  for (int iter = 0; iter < 200; iter++) {
+    random_particles(false);
+    run_block(NativeGroup::SPARTICLE, iter % 4 == 0,
+              Mips2C::jak1::sp_process_block_2d::execute_mips2c,
+              Mips2C::jak1::sp_process_block_2d::execute);
+    ASSERT_FALSE(HasFailure()) << "iter " << iter;
+  }
+}
+
+TEST_F(Mips2cNativeSparticleTest, ProcessBlock3dPaused) {
+  // running 3d particles calls quaternion*!, so only the paused update can be compared here.
+  auto& cache = Mips2C::jak1::sp_process_block_3d::cache;
+  cache.sp_frame_time = jak1_symbol(m_frame);
+  cache.quaternion = jak1_symbol(0);
+  cache.sp_free_particle = jak1_symbol(0);
+  cache.sp_relaunch_particle_3d = jak1_symbol(0);
+  for (int iter = 0; iter < 200; iter++) {
+    random_particles(true);
+    run_block(NativeGroup::SPARTICLE, true, Mips2C::jak1::sp_process_block_3d::execute_mips2c,
+              Mips2C::jak1::sp_process_block_3d::execute);
+    ASSERT_FALSE(HasFailure()) << "iter " << iter;
+  }
+}
+
+TEST_F(Mips2cNativeTest, CollideMeshSphereTests) {
+  using namespace Mips2C::collide_native;
+  const u32 closest_pt = goal_function(closest_pt_in_triangle);
+  if (!closest_pt) {
+    GTEST_SKIP() << "can't make a GOAL function on this platform";
+  }
+  Mips2C::jak1::method_11_collide_mesh::cache.closest_pt_in_triangle = jak1_symbol(closest_pt);
+  Mips2C::jak1::method_12_collide_mesh::cache.closest_pt_in_triangle = jak1_symbol(closest_pt);
+
+  constexpr u32 kMaxTris = 40;
+  // only the triangle count, at 4, is read from the mesh.
+  const u32 mesh = alloc(16);
+  const u32 tris = alloc(kMaxTris * sizeof(MeshCacheTri));
+  const u32 result = alloc(sizeof(TriResult));
+  const u32 sphere = alloc(16);
+  const u32 pats[] = {0, 8, 16, 24, 0x40, 0x50};
+
+  int found = 0;
+  for (int iter = 0; iter < 1000; iter++) {
+    const u32 count = random_int(0, kMaxTris);
+    *ptr<u32>(mesh + 4) = count;
+    for (u32 i = 0; i < count; i++) {
+      auto* tri = ptr<MeshCacheTri>(tris) + i;
+      // small triangles around the sphere, facing mostly up.
+      const float center[3] = {random_float(-30.f, 30.f), random_float(-30.f, 30.f),
+                               random_float(-30.f, 30.f)};
+      for (auto& v : tri->vertex) {
+        for (int j = 0; j < 3; j++) {
+          v[j] = center[j] + random_float(-10.f, 10.f);
+        }
+        v[3] = 1.f;
+      }
+      math::Vector3f e0, e1;
+      for (int j = 0; j < 3; j++) {
+        e0[j] = tri->vertex[1][j] - tri->vertex[0][j];
+        e1[j] = tri->vertex[2][j] - tri->vertex[0][j];
+      }
+      math::Vector3f normal = e0.cross(e1).normalized();
+      if (normal.y() < 0 && random_int(0, 3)) {
+        normal = normal * -1.f;
+      }
+      memcpy(tri->normal, normal.data(), 12);
+      const u32 pat = pats[random_int(0, 5)];
+      memcpy(&tri->normal[3], &pat, 4);
+      for (int j = 0; j < 3; j++) {
+        float lo = std::min({tri->vertex[0][j], tri->vertex[1][j], tri->vertex[2][j]});
+        float hi = std::max({tri->vertex[0][j], tri->vertex[1][j], tri->vertex[2][j]});
+        tri->bbox_min[j] = (s32)std::floor(lo);
+        tri->bbox_max[j] = (s32)std::ceil(hi);
+      }
+    }
+    for (int j = 0; j < 3; j++) {
+      ptr<float>(sphere)[j] = random_float(-30.f, 30.f);
+    }
+    ptr<float>(sphere)[3] = random_float(1.f, 15.f);
+    if (iter % 4 == 1 && count > 0) {
+      // the platform test also finds triangles far below the sphere.
+      const auto* tri = ptr<MeshCacheTri>(tris);
+      for (int j = 0; j < 3; j++) {
+        ptr<float>(sphere)[j] = (tri->vertex[0][j] + tri->vertex[1][j] + tri->vertex[2][j]) / 3;
+      }
+      ptr<float>(sphere)[1] += ptr<float>(sphere)[3] + random_float(80.f, 130.f);
+    }
+    memset(ptr<u8>(result), 0, sizeof(TriResult));
+    const float best = iter % 3 ? 1e10f : random_float(-10.f, 10.f);
+    u32 best_bits;
+    memcpy(&best_bits, &best, 4);
+    const bool platform = iter % 2;
+
+    auto run = [&](auto f) {
+      auto c = context(mesh, tris, result, sphere);
+      c.gprs[t0].du64[0] = (s64)(s32)best_bits;
+      return f(&c);
+    };
+    auto [reference, native] = run_both(
+        NativeGroup::COLLIDE,
+        [&]() {
+          return platform ? run(Mips2C::jak1::method_12_collide_mesh::execute_mips2c)
+                          : run(Mips2C::jak1::method_11_collide_mesh::execute_mips2c);
+        },
+        [&]() {
+          return platform ? run(Mips2C::jak1::method_12_collide_mesh::execute)
+                          : run(Mips2C::jak1::method_11_collide_mesh::execute);
+        });
+    ASSERT_EQ(reference, native) << "iter " << iter;
+    ASSERT_TRUE(same_bytes_as_reference(result, sizeof(TriResult))) << "iter " << iter;
+    found += reference != (s64)(s32)best_bits;
+  }
+  // some calls should find a triangle, and some shouldn't.
+  EXPECT_GT(found, 0);
+  EXPECT_LT(found, 1000);
+}
+
+TEST_F(Mips2cNativeTest, BonesMtxCalc) {
+  using namespace Mips2C::bones_native;
+  // the mips2c version does 16 bones at a time.
+  constexpr s64 kMaxBones = 50;
+  // the layout below holds scratchpad addresses, which are masked to get the offsets.
+  const u32 spad = (alloc(32 * 1024) + 16 * 1024 - 1) & ~(16 * 1024 - 1);
+  Mips2C::jak1::bones_mtx_calc::cache.fake_scratchpad_data = jak1_symbol(spad);
+  Mips2C::jak2::bones_mtx_calc::cache.fake_scratchpad_data = jak2_symbol(spad);
+  // joints are basics, and bone i uses joint i - 1. Leave room for reading past the end too.
+  const u32 joints = alloc(JOINT_STRIDE * (kMaxBones + 16)) + JOINT_STRIDE + 4;
+  const u32 bones = alloc(JAK1_BONE_STRIDE * (kMaxBones + 16));
+  const u32 camera = alloc(64);
+  const u32 matrix_area = alloc(sizeof(SkinningMatrix) * kMaxBones);
+
+  auto random_matrix = [&](float* m) {
+    for (int i = 0; i < 16; i++) {
+      m[i] = random_float(-2.f, 2.f);
+    }
+    // mostly affine, like the real ones.
+    if (random_int(0, 3)) {
+      m[3] = m[7] = m[11] = 0.f;
+      m[15] = 1.f;
+    }
+  };
+
+  for (int iter = 0; iter < 200; iter++) {
+    const s64 count = iter % 4 ? random_int(1, kMaxBones) : iter / 4 % 34;
+    const bool jak2 = iter % 3 == 0;
+    const u32 bone_stride = jak2 ? JAK2_BONE_STRIDE : JAK1_BONE_STRIDE;
+    for (s64 i = -1; i < count; i++) {
+      random_matrix(ptr<float>(joints + JOINT_BIND_POSE_OFFSET + JOINT_STRIDE * i));
+    }
+    for (s64 i = 0; i < count; i++) {
+      // the bone transform is followed by a scale, which isn't used.
+      random_matrix(ptr<float>(bones + bone_stride * i));
+    }
+    random_matrix(ptr<float>(camera));
+    // the original gets the uncached addresses.
+    const u32 uncached = iter % 2 ? 0x80000000 : 0;
+    // the double buffered scratchpad layout from bones-init.
+    if (jak2) {
+      const u32 layout[6] = {80, 80 + 0x1100, 80 + 1024, 80 + 0x1100 + 1024, 80 + 2304,
+                             80 + 0x1100 + 2304};
+      for (int i = 0; i < 6; i++) {
+        ptr<u32>(spad)[i] = spad + layout[i];
+      }
+    } else {
+      const u32 layout[6] = {256, 4864, 1280, 5888, 2816, 7424};
+      for (int i = 0; i < 6; i++) {
+        ptr<u32>(spad + 16)[i] = spad + layout[i];
+      }
+    }
+
+    auto run = [&](auto f) {
+      auto c = context(matrix_area, joints | uncached, bones | uncached, count);
+      c.gprs[t0].du64[0] = camera;
+      return f(&c);
+    };
+    auto [reference, result] = run_both(
+        NativeGroup::BONES,
+        [&]() {
+          return jak2 ? run(Mips2C::jak2::bones_mtx_calc::execute_mips2c)
+                      : run(Mips2C::jak1::bones_mtx_calc::execute_mips2c);
+        },
+        [&]() {
+          return jak2 ? run(Mips2C::jak2::bones_mtx_calc::execute)
+                      : run(Mips2C::jak1::bones_mtx_calc::execute);
+        });
+    EXPECT_EQ(reference, result);
+    ASSERT_TRUE(same_floats_as_reference(matrix_area, sizeof(SkinningMatrix) * count))
+        << "iter " << iter << " count " << count;
+  }
+}
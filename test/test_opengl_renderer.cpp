@@ -0,0 +1,182 @@
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/util/os.h"
+
+#include "game/graphics/opengl_renderer/background/background_common.h"
+#include "game/graphics/opengl_renderer/foreground/merc_blerc.h"
+
+#include "gtest/gtest.h"
+
+namespace {
+struct BlercInput {
+  std::vector<u32> int_data;
+  std::vector<tfrag3::BlercFloatData> float_data;
+  std::vector<tfrag3::MercVertex> vertices;
+  float weights[kMaxBlercTargets];
+};
+
+BlercInput random_blerc_input(std::mt19937& rng, int num_verts) {
+  std::uniform_real_distribution<float> pos(-1000.f, 1000.f);
+  std::uniform_real_distribution<float> weight(-1.f, 1.f);
+  std::uniform_int_distribution<u32> target(0, kMaxBlercTargets - 1);
+  std::uniform_int_distribution<int> target_count(0, 6);
+
+  BlercInput in;
+  in.vertices.resize(num_verts);
+  for (auto& w : in.weights) {
+    w = weight(rng);
+  }
+  auto add_float = [&]() {
+    auto& f = in.float_data.emplace_back();
+    for (auto& x : f.v) {
+      x = pos(rng);
+    }
+  };
+  for (int vtx = 0; vtx < num_verts; vtx++) {
+    add_float();  // base
+    int count = target_count(rng);
+    for (int i = 0; i < count; i++) {
+      in.int_data.push_back(target(rng));
+      add_float();
+    }
+    in.int_data.push_back(tfrag3::Blerc::kTargetIdxTerminator);
+    in.int_data.push_back(vtx);
+  }
+  return in;
+}
+
+std::vector<tfrag3::MercVertex> run_blerc(decltype(&blerc) fn, const BlercInput& in, float mult) {
+  auto out = in.vertices;
+  fn(in.int_data.data(), in.int_data.data() + in.int_data.size(), in.float_data.data(),
+     in.weights, out.data(), mult);
+  return out;
+}
+
+/*!
+ * Plain C++ version of blerc, with the same operation order as blerc_avx. The compiler may still
+ * contract the multiply-add, so results are compared with a tolerance.
+ */
+std::vector<tfrag3::MercVertex> blerc_reference(const BlercInput& in, float mult) {
+  auto out = in.vertices;
+  const u32* i_data = in.int_data.data();
+  const auto* floats = in.float_data.data();
+  while (i_data != in.int_data.data() + in.int_data.size()) {
+    float result[8];
+    for (int i = 0; i < 8; i++) {
+      result[i] = floats->v[i];
+    }
+    floats++;
+    while (*i_data != tfrag3::Blerc::kTargetIdxTerminator) {
+      float w = in.weights[*i_data] * mult;
+      for (int i = 0; i < 8; i++) {
+        float offset = floats->v[i] * w;
+        result[i] += offset;
+      }
+      floats++;
+      i_data++;
+    }
+    i_data++;
+    memcpy(out[*i_data].pos, result, sizeof(result));
+    i_data++;
+  }
+  return out;
+}
+
+void expect_same_pos_nrm(const std::vector<tfrag3::MercVertex>& a,
+                         const std::vector<tfrag3::MercVertex>& b,
+                         float tolerance) {
+  ASSERT_EQ(a.size(), b.size());
+  for (size_t v = 0; v < a.size(); v++) {
+    for (int i = 0; i < 3; i++) {
+      EXPECT_NEAR(a[v].pos[i], b[v].pos[i], tolerance);
+      EXPECT_NEAR(a[v].normal[i], b[v].normal[i], tolerance);
+    }
+  }
+}
+}  // namespace
+
+TEST(Blerc, AvxMatchesReference) {
+  std::mt19937 rng(12);
+  for (int iter = 0; iter < 20; iter++) {
+    auto in = random_blerc_input(rng, 100);
+    expect_same_pos_nrm(run_blerc(blerc_avx, in, 0.5f), blerc_reference(in, 0.5f), 1e-2f);
+  }
+}
+
+TEST(Blerc, DispatchMatchesAvx) {
+  // blerc() may pick the FMA version, which rounds once instead of twice.
+  setup_cpu_info();
+  std::mt19937 rng(34);
+  for (int iter = 0; iter < 20; iter++) {
+    auto in = random_blerc_input(rng, 100);
+    expect_same_pos_nrm(run_blerc(blerc, in, 1.f), run_blerc(blerc_avx, in, 1.f), 1e-2f);
+  }
+}
+
+#ifdef __AVX2__
+TEST(Blerc, Avx2MatchesAvx) {
+  setup_cpu_info();
+  if (!get_cpu_info().has_avx2 || !get_cpu_info().has_fma) {
+    GTEST_SKIP() << "CPU doesn't support AVX2 and FMA";
+  }
+  std::mt19937 rng(56);
+  for (int iter = 0; iter < 20; iter++) {
+    auto in = random_blerc_input(rng, 100);
+    expect_same_pos_nrm(run_blerc(blerc_avx2, in, 1.f), run_blerc(blerc_avx, in, 1.f), 1e-2f);
+  }
+}
+#endif
+
+TEST(BackgroundCulling, FastMatchesSlow) {
+  std::mt19937 rng(78);
+  std::uniform_real_distribution<float> unit(-1.f, 1.f);
+  std::uniform_real_distribution<float> pos(-100000.f, 100000.f);
+  std::uniform_int_distribution<int> byte(0, 255);
+  for (int iter = 0; iter < 100; iter++) {
+    // the planes are transposed: planes[0..2] hold x, y and z of each plane's normal, and
+    // planes[3] the distances.
+    math::Vector4f planes[4];
+    for (auto& plane : planes) {
+      for (int i = 0; i < 4; i++) {
+        plane[i] = iter % 4 == 3 ? pos(rng) : unit(rng);
+      }
+    }
+
+    std::vector<tfrag3::VisNode> nodes(iter * 7 % 50);
+    for (size_t i = 0; i < nodes.size(); i++) {
+      auto& node = nodes[i];
+      for (int j = 0; j < 3; j++) {
+        node.bsphere[j] = pos(rng);
+      }
+      node.bsphere.w() = std::abs(pos(rng));
+      if (i % 3 == 0) {
+        // put the sphere right on one of the planes, where the comparison decides.
+        int plane = byte(rng) % 4;
+        float acc = planes[0][plane] * node.bsphere.x() + planes[1][plane] * node.bsphere.y() +
+                    planes[2][plane] * node.bsphere.z() - planes[3][plane];
+        node.bsphere.w() = std::nextafter(std::abs(acc), i % 2 ? 0.f : INFINITY);
+        if (i % 4 == 0) {
+          node.bsphere.w() = -acc;
+        }
+      }
+      node.my_id = i % 11 == 5 ? 0xffff : byte(rng) * 16 + i % 16;
+    }
+    std::vector<u8> occlusion(4096 / 8);
+    for (auto& b : occlusion) {
+      b = byte(rng);
+    }
+    const auto soa = make_vis_nodes_soa(nodes);
+
+    for (const u8* occ : {(const u8*)nullptr, (const u8*)occlusion.data()}) {
+      std::vector<u8> slow(nodes.size(), 0xaa);
+      std::vector<u8> fast(nodes.size(), 0x55);
+      cull_check_all_slow(planes, nodes, occ, slow.data());
+      cull_check_all_fast(planes, soa, occ, fast.data());
+      ASSERT_EQ(slow, fast) << "iter " << iter;
+    }
+  }
+}
@@ -1,7 +1,9 @@
 #include "common/goos/ParseHelpers.h"
 #include "common/goos/Reader.h"
 #include "common/type_system/TypeSystem.h"
+#include "common/type_system/defenum.h"
 #include "common/type_system/deftype.h"
+#include "common/util/Serializer.h"
 
 #include "gtest/gtest.h"
 
@@ -395,6 +397,35 @@ TEST(TypeSystem, lca) {
             "(pointer object)");
 }
 
+TEST(TypeSystem, RedefineParent) {
+  // typechecks and lookups remember the parents of each type, so make sure they follow a redefined
+  // parent.
+  TypeSystem ts;
+  ts.add_builtin_types(GameVersion::Jak1);
+  goos::Reader reader;
+  auto add_type = [&](const std::string& str) {
+    auto& in = reader.read_from_string(str).as_pair()->cdr.as_pair()->car.as_pair()->cdr;
+    parse_deftype(in, &ts);
+  };
+
+  add_type("(deftype test-parent (basic) ((x int32)))");
+  add_type("(deftype test-child (test-parent) ((y int32)))");
+  EXPECT_TRUE(ts_name_name(ts, "basic", "test-child"));
+  std::vector<std::string> expected_path = {"test-child", "test-parent", "basic", "structure",
+                                            "object"};
+  EXPECT_EQ(ts.get_path_up_tree("test-child"), expected_path);
+
+  ts.add_type_to_allowed_redefinition_list("test-parent");
+  add_type("(deftype test-parent (structure) ((x int32)))");
+  EXPECT_FALSE(ts_name_name(ts, "basic", "test-child"));
+  EXPECT_TRUE(ts_name_name(ts, "structure", "test-child"));
+  EXPECT_EQ(ts.get_path_up_tree("test-child"),
+            std::vector<std::string>({"test-child", "test-parent", "structure", "object"}));
+  EXPECT_EQ(ts.lowest_common_ancestor(ts.make_typespec("test-child"), ts.make_typespec("string"))
+                .print(),
+            "structure");
+}
+
 TEST(TypeSystem, DecompLookupsTypeOfBasic) {
   TypeSystem ts;
   ts.add_builtin_types(GameVersion::Jak1);
@@ -525,4 +556,46 @@ TEST(Deftype, deftype) {
   EXPECT_EQ(f5.is_inline(), false);
 }
 
+TEST(TypeSystem, Serialize) {
+  TypeSystem ts;
+  ts.add_builtin_types(GameVersion::Jak1);
+  goos::Reader reader;
+  auto read_form = [&](const std::string& str) -> goos::Object& {
+    return reader.read_from_string(str).as_pair()->cdr.as_pair()->car.as_pair()->cdr;
+  };
+  parse_deftype(read_form("(deftype my-type (basic) ((f1 int64) (f2 (pointer string) 3))"
+                          "  (:methods (my-method (_type_ int) none 9)))"),
+                &ts);
+  parse_deftype(read_form("(deftype my-bits (uint32) ((a uint8 :offset 0) (b uint8 :offset 8)))"),
+                &ts);
+  DefinitionMetadata enum_metadata;
+  parse_defenum(read_form("(defenum my-enum :type uint8 (a 1) (b 2))"), &ts, &enum_metadata);
+  ts.forward_declare_type_as("my-later-type", "basic");
+
+  Serializer saver;
+  ts.serialize(saver);
+  auto [data, size] = saver.get_save_result();
+  Serializer loader(data, size);
+  TypeSystem loaded;
+  loaded.serialize(loader);
+  EXPECT_TRUE(loader.get_load_finished());
+
+  auto names = ts.get_all_type_names();
+  EXPECT_EQ(names.size(), loaded.get_all_type_names().size());
+  for (auto& name : names) {
+    auto* type = ts.lookup_type_allow_partial_def(name);
+    auto* loaded_type = loaded.lookup_type_allow_partial_def(name);
+    // NullTypes can't be compared.
+    if (!dynamic_cast<NullType*>(type)) {
+      EXPECT_TRUE(*type == *loaded_type) << name << "\n" << type->diff(*loaded_type);
+    }
+  }
+  EXPECT_EQ(loaded.lookup_method("my-type", "my-method").id, 9);
+  EXPECT_TRUE(loaded.tc(TypeSpec("basic"), TypeSpec("my-type")));
+  EXPECT_EQ(loaded.lookup_bitfield_info("my-bits", "b").offset, 8);
+  EXPECT_EQ(loaded.try_enum_lookup("my-enum")->entries().at("b"), 2);
+  EXPECT_TRUE(loaded.partially_defined_type_exists("my-later-type"));
+  EXPECT_FALSE(loaded.fully_defined_type_exists("my-later-type"));
+}
+
 // TODO - a big test to make sure all the builtin types are what we expect.
@@ -0,0 +1,62 @@
+#include <random>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/dma/vif_unpack.h"
+
+#include "gtest/gtest.h"
+
+TEST(VifUnpack, SrcBytes) {
+  EXPECT_EQ(vif_unpack_src_bytes(VifCode::Kind::UNPACK_V4_32, 3), 48);
+  EXPECT_EQ(vif_unpack_src_bytes(VifCode::Kind::UNPACK_V3_32, 3), 36);
+  EXPECT_EQ(vif_unpack_src_bytes(VifCode::Kind::UNPACK_V4_8, 3), 12);
+  // padded to 4 bytes
+  EXPECT_EQ(vif_unpack_src_bytes(VifCode::Kind::UNPACK_V2_16, 3), 12);
+  EXPECT_EQ(vif_unpack_src_bytes((VifCode::Kind)0b1101001, 3), 20);  // V3-16
+}
+
+TEST(VifUnpack, Supported) {
+  EXPECT_TRUE(vif_unpack_supported(VifCode::Kind::UNPACK_V4_8));
+  EXPECT_FALSE(vif_unpack_supported((VifCode::Kind)0b1101111));  // V4-5
+  EXPECT_FALSE(vif_unpack_supported((VifCode::Kind)0b1111110));  // masked V4-8
+  EXPECT_FALSE(vif_unpack_supported(VifCode::Kind::STCYCL));
+}
+
+TEST(VifUnpack, MatchesReference) {
+  std::mt19937 rng(123);
+  std::vector<u8> src(1024);
+  for (auto& x : src) {
+    x = rng();
+  }
+  const std::pair<u16, u16> cycles[] = {{4, 4}, {4, 2}, {4, 1}, {3, 2}};
+
+  for (u8 format = 0; format < 16; format++) {
+    auto kind = (VifCode::Kind)((u8)VifCode::Kind::UNPACK_MASK | format);
+    if (!vif_unpack_supported(kind)) {
+      continue;
+    }
+    for (bool usn : {false, true}) {
+      for (auto [cl, wl] : cycles) {
+        for (u32 num = 1; num < 20; num++) {
+          std::vector<u8> expected(16 * 4 * 20, 0xcd);
+          std::vector<u8> actual(16 * 4 * 20, 0xcd);
+          vif_unpack_reference(expected.data(), src.data(), kind, num, usn, cl, wl);
+          vif_unpack(actual.data(), src.data(), kind, num, usn, cl, wl);
+          EXPECT_EQ(expected, actual) << "format " << (int)format << " usn " << usn << " cl " << cl
+                                      << " wl " << wl << " num " << num;
+        }
+      }
+    }
+  }
+}
+
+TEST(VifUnpack, V4_8) {
+  u8 src[8] = {1, 2, 0xff, 4, 5, 6, 7, 0x80};
+  s32 dst[8];
+  vif_unpack(dst, src, VifCode::Kind::UNPACK_V4_8, 2, false);
+  EXPECT_EQ(dst[2], -1);
+  EXPECT_EQ(dst[7], -128);
+  vif_unpack(dst, src, VifCode::Kind::UNPACK_V4_8, 2, true);
+  EXPECT_EQ(dst[2], 255);
+  EXPECT_EQ(dst[7], 128);
+}
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cstdio>
 #include <string>
 #include <vector>
@@ -56,4 +57,73 @@ TEST(ZSTD, CommonLibrary) {
   }
 
   EXPECT_TRUE(compressed.size() < 0.5 * all.size());
-}
\ No newline at end of file
+}
+
+namespace {
+std::string all_symbols() {
+  std::string all;
+  for (auto& x : all_syms) {
+    all.append(x);
+    all.append("\n");
+  }
+  return all;
+}
+}  // namespace
+
+TEST(ZSTD, Workers) {
+  auto all = all_symbols();
+  compression::ZstdOptions options;
+  options.level = 3;
+  options.workers = 2;
+  auto compressed = compression::compress_zstd(all.data(), all.size(), options);
+  auto decompressed = compression::decompress_zstd(compressed.data(), compressed.size());
+  EXPECT_EQ(std::string(decompressed.begin(), decompressed.end()), all);
+}
+
+TEST(ZSTD, Stream) {
+  auto all = all_symbols();
+  compression::ZstdStreamCompressor compressor;
+  for (size_t i = 0; i < all.size(); i += 1000) {
+    compressor.write(all.data() + i, std::min(size_t(1000), all.size() - i));
+  }
+  auto compressed = compressor.finish();
+  EXPECT_EQ(compression::zstd_decompressed_size(compressed.data(), compressed.size()),
+            all.size());
+
+  // the same format as compress_zstd
+  auto decompressed = compression::decompress_zstd(compressed.data(), compressed.size());
+  EXPECT_EQ(std::string(decompressed.begin(), decompressed.end()), all);
+
+  compression::ZstdStreamDecompressor decompressor(compressed.data(), compressed.size());
+  std::string streamed;
+  char buffer[777];
+  while (!decompressor.done()) {
+    streamed.append(buffer, decompressor.read(buffer, sizeof(buffer)));
+  }
+  EXPECT_EQ(streamed, all);
+}
+
+TEST(ZSTD, Dictionary) {
+  auto all = all_symbols();
+  std::vector<std::vector<u8>> samples;
+  for (size_t i = 0; i + 200 < all.size() / 2; i += 200) {
+    samples.emplace_back(all.begin() + i, all.begin() + i + 200);
+  }
+  compression::ZstdDictionary dict(
+      compression::ZstdDictionary::content_from_samples(samples, 16 * 1024));
+  EXPECT_EQ(dict.content().size(), 16 * 1024);
+
+  // a small piece from the part of the data the dictionary has in it.
+  size_t offset = all.size() / 2 - 1000;
+  auto with_dict = compression::compress_zstd(all.data() + offset, 500, dict);
+  auto without_dict = compression::compress_zstd(all.data() + offset, 500);
+  EXPECT_LT(with_dict.size(), without_dict.size());
+
+  auto decompressed = compression::decompress_zstd(with_dict.data(), with_dict.size(), dict);
+  EXPECT_EQ(std::string(decompressed.begin(), decompressed.end()), all.substr(offset, 500));
+
+  std::vector<u8> into(500);
+  EXPECT_TRUE(compression::decompress_zstd_into(with_dict.data(), with_dict.size(), into.data(),
+                                                into.size(), &dict));
+  EXPECT_EQ(into, decompressed);
+}
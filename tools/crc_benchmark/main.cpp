@@ -0,0 +1,161 @@
+// Times the kernel's crc32, which hashes symbol names on every intern and lookup, on every symbol
+// in the GOAL source files under the given folders (goal_src by default). It's compared with the
+// byte at a time loop the kernel used before, and with the hardware crc32 in common/util used for
+// hashing in the renderer, which uses a different polynomial.
+
+#include <algorithm>
+#include <regex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "common/log/log.h"
+#include "common/util/FileUtil.h"
+#include "common/util/Timer.h"
+#include "common/util/crc32.h"
+
+#include "game/kernel/common/kscheme.h"
+
+#include "third-party/CLI11.hpp"
+#include "third-party/fmt/core.h"
+
+namespace {
+
+// runs the function iterations times, and returns the fastest.
+template <typename F>
+double best_of(int iterations, F&& f) {
+  double best = 0;
+  for (int i = 0; i < iterations; i++) {
+    Timer timer;
+    f();
+    double ms = timer.getMs();
+    best = i == 0 ? ms : std::min(best, ms);
+  }
+  return best;
+}
+
+// the crc32 of the kernel, one byte at a time.
+u32 bytewise_table[0x100];
+
+void init_bytewise_table() {
+  for (u32 i = 0; i < 0x100; i++) {
+    u32 n = i << 24;
+    for (u32 j = 0; j < 8; j++) {
+      n = n & 0x80000000 ? (n << 1) ^ CRC_POLY : (n << 1);
+    }
+    bytewise_table[i] = n;
+  }
+}
+
+u32 crc32_bytewise(const u8* data, s32 size) {
+  u32 crc = 0;
+  for (int i = size; i != 0; i--, data++) {
+    crc = bytewise_table[crc >> 24] ^ ((crc << 8) | *data);
+  }
+  return ~crc;
+}
+
+std::vector<std::string> find_symbols(const std::vector<fs::path>& paths) {
+  std::unordered_set<std::string> symbols;
+  const std::string separators = " \t\r\n()'`,\"";
+  for (auto& path : paths) {
+    auto text = file_util::read_text_file(path);
+    size_t pos = 0;
+    while (pos < text.size()) {
+      size_t start = text.find_first_not_of(separators, pos);
+      if (start == std::string::npos) {
+        break;
+      }
+      size_t end = text.find_first_of(separators, start);
+      if (end == std::string::npos) {
+        end = text.size();
+      }
+      symbols.emplace(text, start, end - start);
+      pos = end;
+    }
+  }
+  return std::vector<std::string>(symbols.begin(), symbols.end());
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::vector<std::string> folders = {"goal_src"};
+  int iterations = 20;
+  fs::path project_path_override;
+
+  lg::initialize();
+
+  CLI::App app{"OpenGOAL CRC Benchmark"};
+  app.add_option("folders", folders, "Folders to read, relative to the project (default goal_src)");
+  app.add_option("-n,--iterations", iterations, "Number of times to hash all the symbols");
+  app.add_option("--proj-path", project_path_override,
+                 "Specify the location of the 'data/' folder");
+  app.validate_positionals();
+  CLI11_PARSE(app, argc, argv);
+
+  if (!file_util::setup_project_path(
+          project_path_override.empty() ? std::nullopt : std::optional(project_path_override))) {
+    lg::error("couldn't setup project path, exiting");
+    return 1;
+  }
+
+  std::vector<fs::path> paths;
+  const std::regex source_pattern(".*\\.g[cdps]$");
+  for (const auto& folder : folders) {
+    auto base = file_util::get_jak_project_dir() / folder;
+    auto found = file_util::find_files_recursively(base, source_pattern);
+    paths.insert(paths.end(), found.begin(), found.end());
+  }
+  auto symbols = find_symbols(paths);
+  size_t total_bytes = 0;
+  for (auto& symbol : symbols) {
+    total_bytes += symbol.size();
+  }
+  lg::info("Hashing {} symbols ({:.1f} bytes on average), best of {}", symbols.size(),
+           (double)total_bytes / symbols.size(), iterations);
+
+  init_crc();
+  init_bytewise_table();
+  int mismatches = 0;
+  for (auto& symbol : symbols) {
+    auto data = (const u8*)symbol.data();
+    if (crc32(data, (s32)symbol.size()) != crc32_bytewise(data, (s32)symbol.size())) {
+      mismatches++;
+    }
+  }
+
+  // the results are added up, so the compiler can't skip the work.
+  u32 check = 0;
+  double bytewise_ms = best_of(iterations, [&]() {
+    for (auto& symbol : symbols) {
+      check += crc32_bytewise((const u8*)symbol.data(), (s32)symbol.size());
+    }
+  });
+  double kernel_ms = best_of(iterations, [&]() {
+    for (auto& symbol : symbols) {
+      check += crc32((const u8*)symbol.data(), (s32)symbol.size());
+    }
+  });
+  double hardware_ms = best_of(iterations, [&]() {
+    for (auto& symbol : symbols) {
+      check += crc32((const u8*)symbol.data(), symbol.size());
+    }
+  });
+
+  fmt::print("{:>20}  {:>10}  {:>10}\n", "crc32", "ms", "MB/s");
+  auto print = [&](const char* name, double ms) {
+    fmt::print("{:>20}  {:>10.3f}  {:>10.1f}\n", name, ms,
+               total_bytes / (1024. * 1024.) / (ms / 1000.));
+  };
+  print("kernel, bytewise", bytewise_ms);
+  print("kernel", kernel_ms);
+  print("common/util", hardware_ms);
+  lg::info("check: {}", check);
+  if (mismatches) {
+    lg::error("{} symbols hashed differently by the kernel crc32 and the bytewise loop",
+              mismatches);
+    return 1;
+  }
+  return 0;
+}
@@ -1,5 +1,6 @@
 #include <fstream>
 #include <iomanip>
+#include <memory>
 #include <optional>
 #include <string>
 
@@ -9,6 +10,8 @@
 #include "common/type_system/TypeSystem.h"
 #include "common/util/Assert.h"
 #include "common/util/FileUtil.h"
+#include "common/util/MappedFile.h"
+#include "common/util/ThreadPool.h"
 #include "common/util/unicode_util.h"
 
 #include "decompiler/util/DecompilerTypeSystem.h"
@@ -17,23 +20,28 @@
 #include "third-party/fmt/core.h"
 #include "third-party/json.hpp"
 
+/*!
+ * EE memory from a dump. The dump may be missing the start of memory, so data is the memory from
+ * start to size.
+ */
 struct Ram {
   const u8* data = nullptr;
   u32 size = 0;
+  u32 start = 0;
 
-  Ram(const u8* _data, u32 _size) : data(_data), size(_size) {}
+  Ram(const u8* _data, u32 _size, u32 _start = 0) : data(_data), size(_size), start(_start) {}
 
   template <typename T>
   T read(u32 addr) const {
     ASSERT(in_memory<T>(addr));
     T result;
-    memcpy(&result, data + addr, sizeof(T));
+    memcpy(&result, data + (addr - start), sizeof(T));
     return result;
   }
 
   template <typename T>
   bool in_memory(u32 addr) const {
-    return addr > (1 << 19) && addr <= (size - sizeof(T));
+    return addr > (1 << 19) && addr >= start && addr <= (size - sizeof(T));
   }
 
   u32 word(u32 addr) const { return read<u32>(addr); }
@@ -230,21 +238,44 @@ std::unordered_map<u32, std::string> build_type_map(const Ram& ram,
 const std::vector<std::string> ignored_types = {"symbol", "string", "function", "object",
                                                 "integer"};
 
+/*!
+ * Find everything that looks like a basic: a type tag on a 16-byte boundary. The memory is split
+ * into chunks that are scanned in parallel. The addresses of each type are in increasing order.
+ */
 std::unordered_map<std::string, std::vector<u32>> find_basics(
     const Ram& ram,
     const std::unordered_map<u32, std::string>& type_map) {
-  lg::info("Scanning memory for objects. This may take a while...");
+  lg::info("Scanning memory for objects...");
+
+  // ignore the stupid types.
+  std::unordered_map<u32, const std::string*> scan_types;
+  for (auto& [tag, name] : type_map) {
+    if (std::find(ignored_types.begin(), ignored_types.end(), name) == ignored_types.end()) {
+      scan_types[tag] = &name;
+    }
+  }
+
+  constexpr u32 CHUNK_SIZE = 1 << 20;
+  u32 scan_start = std::max(1u << 20, (ram.start + 15) & ~15u);
+  int chunk_count = (ram.size - scan_start + CHUNK_SIZE - 1) / CHUNK_SIZE;
+  std::vector<std::vector<std::pair<const std::string*, u32>>> found(chunk_count);
+  ThreadPool::global().parallel_for(
+      [&](int chunk) {
+        u32 end = std::min(ram.size, scan_start + (chunk + 1) * CHUNK_SIZE);
+        for (u32 addr = scan_start + chunk * CHUNK_SIZE; addr + 4 <= end; addr += 16) {
+          auto iter = scan_types.find(ram.word(addr));
+          if (iter != scan_types.end()) {
+            found[chunk].emplace_back(iter->second, addr);
+          }
+        }
+      },
+      chunk_count);
 
   std::unordered_map<std::string, std::vector<u32>> result;
   int total_objects = 0;
-
-  for (u32 addr = (1 << 20); addr < ram.size; addr += 16) {
-    u32 tag = ram.word(addr);
-    auto iter = type_map.find(tag);
-    // ignore the stupid types.
-    if (iter != type_map.end() && std::find(ignored_types.begin(), ignored_types.end(),
-                                            iter->second) == ignored_types.end()) {
-      result[iter->second].push_back(addr);
+  for (auto& chunk : found) {
+    for (auto& [name, addr] : chunk) {
+      result[*name].push_back(addr);
       total_objects++;
     }
   }
@@ -253,6 +284,269 @@ std::unordered_map<std::string, std::vector<u32>> find_basics(
   return result;
 }
 
+/*!
+ * Bytes used by the object of the given type with its type tag at addr. Processes are sized by
+ * their heap, other dynamic types only count their fixed part.
+ */
+u32 object_size(const Ram& ram, const TypeSystem& type_system, const std::string& name, u32 addr) {
+  if (!type_system.fully_defined_type_exists(name)) {
+    return 16;
+  }
+  auto type = type_system.lookup_type(name);
+  if (auto structure = dynamic_cast<StructureType*>(type)) {
+    for (auto& field : structure->fields()) {
+      if (field.name() == "heap-top" && ram.word_in_memory(addr + 4 + field.offset())) {
+        u32 top = ram.word(addr + 4 + field.offset());
+        if (top > addr && ram.word_in_memory(top - 4)) {
+          return top - addr;
+        }
+      }
+    }
+  }
+  return std::max(16, type->get_size_in_memory());
+}
+
+struct TypeUsage {
+  u32 count = 0;
+  u64 bytes = 0;
+};
+
+std::unordered_map<std::string, TypeUsage> summarize_types(
+    const Ram& ram,
+    const TypeSystem& type_system,
+    const std::unordered_map<std::string, std::vector<u32>>& basics) {
+  std::unordered_map<std::string, TypeUsage> result;
+  for (auto& [name, addrs] : basics) {
+    auto& usage = result[name];
+    for (auto addr : addrs) {
+      usage.count++;
+      usage.bytes += object_size(ram, type_system, name, addr);
+    }
+  }
+  return result;
+}
+
+void print_type_summary(const std::unordered_map<std::string, TypeUsage>& usage, int max_types) {
+  std::vector<std::string> names;
+  u64 total = 0;
+  for (auto& [name, u] : usage) {
+    names.push_back(name);
+    total += u.bytes;
+  }
+  std::sort(names.begin(), names.end(),
+            [&](const auto& a, const auto& b) { return usage.at(a).bytes > usage.at(b).bytes; });
+  fmt::print("Memory by type ({} types, {:.2f} MB total):\n", names.size(),
+             total / (1024. * 1024.));
+  for (int i = 0; i < (int)names.size() && i < max_types; i++) {
+    auto& u = usage.at(names[i]);
+    fmt::print("  {:10d} bytes {:7d} objects  {}\n", u.bytes, u.count, names[i]);
+  }
+}
+
+struct Heap {
+  std::string name;
+  u32 base, top, current;
+};
+
+std::optional<Heap> try_read_heap(const Ram& ram, const std::string& name, u32 addr) {
+  if (!ram.word_in_memory(addr) || !ram.word_in_memory(addr + 8)) {
+    return {};
+  }
+  Heap heap{name, ram.word(addr), ram.word(addr + 4), ram.word(addr + 8)};
+  if (heap.base <= heap.current && heap.current <= heap.top && heap.top <= ram.size &&
+      heap.base > (1 << 19)) {
+    return heap;
+  }
+  return {};
+}
+
+/*!
+ * Find the kheaps: the ones that the *...-heap* symbols point to, and the ones inside of objects
+ * (like the level heaps).
+ */
+std::vector<Heap> find_heaps(const Ram& ram,
+                             const SymbolMap& symbols,
+                             const GameVersion& game_version,
+                             const TypeSystem& type_system,
+                             const std::unordered_map<std::string, std::vector<u32>>& basics) {
+  std::vector<Heap> result;
+  for (auto& [name, addr] : symbols.name_to_addr) {
+    if (name.size() > 6 && name.front() == '*' && name.substr(name.size() - 6) == "-heap*") {
+      u32 value = ram.word(game_version == GameVersion::Jak1 ? addr : addr - 1);
+      if (auto heap = try_read_heap(ram, name, value)) {
+        result.push_back(*heap);
+      }
+    }
+  }
+
+  for (auto& [name, addrs] : basics) {
+    if (!type_system.fully_defined_type_exists(name)) {
+      continue;
+    }
+    auto type = dynamic_cast<StructureType*>(type_system.lookup_type(name));
+    if (!type) {
+      continue;
+    }
+    for (auto& field : type->fields()) {
+      if (field.is_inline() && field.type() == TypeSpec("kheap")) {
+        for (auto addr : addrs) {
+          auto heap_name = fmt::format("{}@#x{:x} {}", name, addr + 4, field.name());
+          if (auto heap = try_read_heap(ram, heap_name, addr + 4 + field.offset())) {
+            result.push_back(*heap);
+          }
+        }
+      }
+    }
+  }
+  std::sort(result.begin(), result.end(),
+            [](const Heap& a, const Heap& b) { return a.base < b.base; });
+  return result;
+}
+
+/*!
+ * Print how full each heap is, and which types use the most of it.
+ */
+void print_heap_report(const Ram& ram,
+                       const std::vector<Heap>& heaps,
+                       const TypeSystem& type_system,
+                       const std::unordered_map<std::string, std::vector<u32>>& basics,
+                       int max_types) {
+  fmt::print("Heaps:\n");
+  for (auto& heap : heaps) {
+    u32 size = heap.top - heap.base;
+    u32 used = heap.current - heap.base;
+    fmt::print("{} #x{:x}-#x{:x}: {:.2f} of {:.2f} MB used ({:.1f}%)\n", heap.name, heap.base,
+               heap.top, used / (1024. * 1024.), size / (1024. * 1024.),
+               size ? 100. * used / size : 0.);
+
+    std::unordered_map<std::string, std::vector<u32>> in_heap;
+    for (auto& [name, addrs] : basics) {
+      auto lo = std::lower_bound(addrs.begin(), addrs.end(), heap.base);
+      auto hi = std::lower_bound(addrs.begin(), addrs.end(), heap.current);
+      if (lo != hi) {
+        in_heap[name].assign(lo, hi);
+      }
+    }
+    auto usage = summarize_types(ram, type_system, in_heap);
+    std::vector<std::string> names;
+    for (auto& [name, u] : usage) {
+      names.push_back(name);
+    }
+    std::sort(names.begin(), names.end(),
+              [&](const auto& a, const auto& b) { return usage.at(a).bytes > usage.at(b).bytes; });
+    for (int i = 0; i < (int)names.size() && i < max_types; i++) {
+      auto& u = usage.at(names[i]);
+      fmt::print("  {:10d} bytes {:7d} objects  {}\n", u.bytes, u.count, names[i]);
+    }
+  }
+}
+
+/*!
+ * Print how much of their heaps the processes of each type use.
+ */
+void print_process_heaps(const Ram& ram,
+                         const TypeSystem& type_system,
+                         const std::unordered_map<std::string, std::vector<u32>>& basics,
+                         int max_types) {
+  struct Usage {
+    std::string name;
+    u32 count = 0;
+    u64 used = 0;
+    u64 size = 0;
+  };
+  std::vector<Usage> usage;
+  for (auto& [name, addrs] : basics) {
+    if (!type_system.fully_defined_type_exists(name)) {
+      continue;
+    }
+    auto type = dynamic_cast<StructureType*>(type_system.lookup_type(name));
+    if (!type) {
+      continue;
+    }
+    int base_offset = -1, top_offset = -1, cur_offset = -1;
+    for (auto& field : type->fields()) {
+      if (field.name() == "heap-base") {
+        base_offset = field.offset();
+      } else if (field.name() == "heap-top") {
+        top_offset = field.offset();
+      } else if (field.name() == "heap-cur") {
+        cur_offset = field.offset();
+      }
+    }
+    if (base_offset < 0 || top_offset < 0 || cur_offset < 0) {
+      continue;
+    }
+    Usage u;
+    u.name = name;
+    for (auto addr : addrs) {
+      if (!ram.word_in_memory(addr + 4 + std::max({base_offset, top_offset, cur_offset}))) {
+        continue;
+      }
+      u32 base = ram.word(addr + 4 + base_offset);
+      u32 top = ram.word(addr + 4 + top_offset);
+      u32 cur = ram.word(addr + 4 + cur_offset);
+      if (base <= cur && cur <= top && top <= ram.size) {
+        u.count++;
+        u.used += cur - base;
+        u.size += top - base;
+      }
+    }
+    if (u.count) {
+      usage.push_back(u);
+    }
+  }
+  std::sort(usage.begin(), usage.end(),
+            [](const Usage& a, const Usage& b) { return a.size > b.size; });
+  fmt::print("Process heaps by type:\n");
+  for (int i = 0; i < (int)usage.size() && i < max_types; i++) {
+    auto& u = usage[i];
+    fmt::print("  {:10d} of {:10d} bytes used {:5d} processes  {}\n", u.used, u.size, u.count,
+               u.name);
+  }
+}
+
+/*!
+ * Print the types whose memory use changed the most between two dumps.
+ */
+void print_type_diff(const std::unordered_map<std::string, TypeUsage>& before,
+                     const std::unordered_map<std::string, TypeUsage>& after,
+                     int max_types) {
+  struct Diff {
+    std::string name;
+    s64 count = 0;
+    s64 bytes = 0;
+  };
+  std::unordered_map<std::string, Diff> diffs;
+  for (auto& [name, u] : before) {
+    auto& d = diffs[name];
+    d.name = name;
+    d.count -= u.count;
+    d.bytes -= u.bytes;
+  }
+  for (auto& [name, u] : after) {
+    auto& d = diffs[name];
+    d.name = name;
+    d.count += u.count;
+    d.bytes += u.bytes;
+  }
+  std::vector<Diff> sorted;
+  s64 total = 0;
+  for (auto& [name, d] : diffs) {
+    if (d.count || d.bytes) {
+      sorted.push_back(d);
+      total += d.bytes;
+    }
+  }
+  std::sort(sorted.begin(), sorted.end(), [](const Diff& a, const Diff& b) {
+    return std::abs(a.bytes) > std::abs(b.bytes);
+  });
+  fmt::print("Changes by type ({} types changed, {:+d} bytes total):\n", sorted.size(), total);
+  for (int i = 0; i < (int)sorted.size() && i < max_types; i++) {
+    fmt::print("  {:+11d} bytes {:+8d} objects  {}\n", sorted[i].bytes, sorted[i].count,
+               sorted[i].name);
+  }
+}
+
 void inspect_process_self(const Ram& ram,
                           const std::unordered_map<std::string, std::vector<u32>>& basics,
                           const std::unordered_map<u32, std::string>& types,
@@ -606,12 +900,73 @@ void inspect_symbols(const Ram& ram,
   }
 }
 
+/*!
+ * A memory dump, and what we found in it.
+ */
+struct Dump {
+  std::unique_ptr<file_util::MappedFile> file;
+  std::unique_ptr<Ram> ram;
+  u32 s7 = 0;
+  SymbolMap symbols;
+  std::unordered_map<u32, std::string> types;
+  std::unordered_map<std::string, std::vector<u32>> basics;
+};
+
+/*!
+ * Map a dump file and find the symbols, types and objects in it. Returns nullptr on errors.
+ */
+std::unique_ptr<Dump> load_dump(const fs::path& dump_path, const GameVersion& game_version) {
+  if (dump_path.extension() == "p2s") {
+    lg::error("PCSX2 savestates are not directly supported. Please extract contents beforehand");
+    return nullptr;
+  }
+
+  lg::info("Loading memory from '{}'", dump_path.string());
+  auto dump = std::make_unique<Dump>();
+  dump->file = std::make_unique<file_util::MappedFile>(dump_path);
+  dump->file->prefetch();
+  const u8* data = dump->file->data();
+  size_t size = dump->file->size();
+
+  u32 one_mb = (1 << 20);
+
+  if (size == 32 * one_mb) {
+    lg::info("Got 32MB file");
+    dump->ram = std::make_unique<Ram>(data, size);
+  } else if (size == 128 * one_mb) {
+    lg::info("Got 128MB file");
+    dump->ram = std::make_unique<Ram>(data, size);
+  } else if (size == 127 * one_mb) {
+    lg::warn("Got a 127MB file. Assuming this is a dump with the first 1 MB missing.\n");
+    dump->ram = std::make_unique<Ram>(data, 128 * one_mb, one_mb);
+  } else {
+    lg::error("Invalid size: {} bytes", size);
+    return nullptr;
+  }
+
+  auto& ram = *dump->ram;
+  dump->s7 = scan_for_symbol_table(ram, game_version, one_mb, 2 * one_mb);
+  if (!dump->s7) {
+    lg::error("Failed to find symbol table");
+    return nullptr;
+  }
+
+  dump->symbols = build_symbol_map(game_version, ram, dump->s7);
+  dump->types = build_type_map(ram, dump->symbols, game_version, dump->s7);
+  dump->basics = find_basics(ram, dump->types);
+  return dump;
+}
+
 int main(int argc, char** argv) {
   ArgumentGuard u8_guard(argc, argv);
 
   fs::path dump_path;
   fs::path output_path;
+  fs::path diff_path;
   std::string game_name = "jak1";
+  std::string find_type;
+  bool summary_only = false;
+  int max_types = 40;
 
   lg::initialize();
 
@@ -620,6 +975,12 @@ int main(int argc, char** argv) {
   app.add_option("--output-path", output_path,
                  "Where the output files should be sent, defaults to current directory otherwise");
   app.add_option("-g,--game", game_name, "Specify the game name, defaults to 'jak1'");
+  app.add_flag("--summary", summary_only,
+               "Only print memory use by type and heap, skip the slower field inspection");
+  app.add_option("--find-type", find_type, "Print the address of every object of this type");
+  app.add_option("--diff", diff_path,
+                 "Another dump of the same game, to print what changed from it to this dump");
+  app.add_option("--max-types", max_types, "How many types to list in each report");
   app.validate_positionals();
   CLI11_PARSE(app, argc, argv);
 
@@ -634,9 +995,8 @@ int main(int argc, char** argv) {
 
   decompiler::DecompilerTypeSystem dts(game_version);
 
-  // TODO - this could be better (have a `jak1` folder)
   if (game_version == GameVersion::Jak1) {
-    dts.parse_type_defs({"decompiler", "config", "all-types.gc"});
+    dts.parse_type_defs({"decompiler", "config", "jak1", "all-types.gc"});
   } else if (game_version == GameVersion::Jak2) {
     dts.parse_type_defs({"decompiler", "config", "jak2", "all-types.gc"});
   } else {
@@ -644,45 +1004,49 @@ int main(int argc, char** argv) {
     return 1;
   }
 
-  fs::path output_folder;
+  fs::path output_folder = output_path;
 
   if (output_folder.empty() || !fs::exists(output_folder)) {
     lg::warn("Output folder not found or not provided, defaulting to current directory");
     output_folder = "./";
   }
 
-  if (dump_path.extension() == "p2s") {
-    lg::error("PCSX2 savestates are not directly supported. Please extract contents beforehand");
+  auto dump = load_dump(dump_path, game_version);
+  if (!dump) {
     return 1;
   }
+  const auto& ram = *dump->ram;
 
-  lg::info("Loading memory from '{}'", dump_path.string());
-  auto data = file_util::read_binary_file(dump_path);
-
-  u32 one_mb = (1 << 20);
+  if (!find_type.empty()) {
+    auto it = dump->basics.find(find_type);
+    if (it == dump->basics.end()) {
+      fmt::print("No objects of type {}\n", find_type);
+    } else {
+      fmt::print("{} objects of type {}:\n", it->second.size(), find_type);
+      for (auto addr : it->second) {
+        fmt::print("  #x{:x} ({} bytes)\n", addr + 4,
+                   object_size(ram, dts.ts, find_type, addr));
+      }
+    }
+    return 0;
+  }
 
-  if (data.size() == 32 * one_mb) {
-    lg::info("Got 32MB file");
-  } else if (data.size() == 128 * one_mb) {
-    lg::info("Got 128MB file");
-  } else if (data.size() == 127 * one_mb) {
-    lg::warn("Got a 127MB file. Assuming this is a dump with the first 1 MB missing.\n");
-    data.insert(data.begin(), one_mb, 0);
-    if (data.size() != 128 * one_mb) {
-      lg::error("it was not!");
+  auto usage = summarize_types(ram, dts.ts, dump->basics);
+  if (!diff_path.empty()) {
+    auto before = load_dump(diff_path, game_version);
+    if (!before) {
       return 1;
     }
-  } else {
-    lg::error("Invalid size: {} bytes", data.size());
-    return 1;
+    print_type_diff(summarize_types(*before->ram, dts.ts, before->basics), usage, max_types);
+    return 0;
   }
 
-  Ram ram(data.data(), data.size());
-
-  u32 s7 = scan_for_symbol_table(ram, game_version, one_mb, 2 * one_mb);
-  if (!s7) {
-    lg::error("Failed to find symbol table");
-    return 1;
+  print_type_summary(usage, max_types);
+  print_heap_report(ram, find_heaps(ram, dump->symbols, game_version, dts.ts, dump->basics),
+                    dts.ts, dump->basics, max_types);
+  print_process_heaps(ram, dts.ts, dump->basics, max_types);
+  if (summary_only) {
+    return 0;
   }
 
   nlohmann::json results;
@@ -693,15 +1057,12 @@ int main(int argc, char** argv) {
     i >> results;
   }
 
-  auto symbol_map = build_symbol_map(game_version, ram, s7);
-  auto types = build_type_map(ram, symbol_map, game_version, s7);
-  auto basics = find_basics(ram, types);
-
-  follow_references_to_find_pointers(ram, dts.ts, basics, s7 + 0x100);
+  auto& basics = dump->basics;
+  follow_references_to_find_pointers(ram, dts.ts, basics, dump->s7 + 0x100);
 
-  inspect_basics(ram, basics, types, symbol_map, dts.ts, results);
-  inspect_symbols(ram, types, symbol_map);
-  inspect_process_self(ram, basics, types, dts.ts);
+  inspect_basics(ram, basics, dump->types, dump->symbols, dts.ts, results);
+  inspect_symbols(ram, dump->types, dump->symbols);
+  inspect_process_self(ram, basics, dump->types, dts.ts);
 
   if (fs::exists(output_folder / json_path)) {
     fs::remove(output_folder / json_path);
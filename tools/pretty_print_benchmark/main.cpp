@@ -0,0 +1,115 @@
+// Pretty-prints every top-level form of the decompiler's _disasm.gc output files with
+// PrettyPrinter2, and reports how long it takes. The files are read before timing, so this only
+// measures the pretty printer itself: building the node tree, breaking lists, and printing.
+
+#include <algorithm>
+#include <regex>
+#include <string>
+#include <vector>
+
+#include "common/goos/ParseHelpers.h"
+#include "common/goos/PrettyPrinter2.h"
+#include "common/goos/Reader.h"
+#include "common/log/log.h"
+#include "common/util/FileUtil.h"
+#include "common/util/Timer.h"
+
+#include "third-party/CLI11.hpp"
+#include "third-party/fmt/core.h"
+
+namespace {
+
+struct DisasmFile {
+  std::string name;
+  std::vector<goos::Object> forms;
+  size_t output_bytes = 0;
+  double best_ms = 0;
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::vector<std::string> folders = {"decompiler_out"};
+  int iterations = 5;
+  int slowest_count = 10;
+  int line_length = 110;
+  fs::path project_path_override;
+
+  lg::initialize();
+
+  CLI::App app{"OpenGOAL Pretty Printer Benchmark"};
+  app.add_option("folders", folders,
+                 "Folders with _disasm.gc files, relative to the project (default decompiler_out)");
+  app.add_option("-n,--iterations", iterations, "Number of times to print all the files");
+  app.add_option("--slowest", slowest_count, "Number of slowest files to print");
+  app.add_option("--line-length", line_length, "Line length to pretty print with");
+  app.add_option("--proj-path", project_path_override,
+                 "Specify the location of the 'data/' folder");
+  app.validate_positionals();
+  CLI11_PARSE(app, argc, argv);
+
+  if (!file_util::setup_project_path(
+          project_path_override.empty() ? std::nullopt : std::optional(project_path_override))) {
+    lg::error("couldn't setup project path, exiting");
+    return 1;
+  }
+
+  // the reader has to outlive the forms, they point into its symbol table.
+  goos::Reader reader;
+  std::vector<DisasmFile> files;
+  size_t total_forms = 0;
+  const std::regex disasm_pattern(".*_disasm\\.gc$");
+  for (const auto& folder : folders) {
+    auto base = file_util::get_jak_project_dir() / folder;
+    for (const auto& path : file_util::find_files_recursively(base, disasm_pattern)) {
+      auto name = fs::relative(path, file_util::get_jak_project_dir()).string();
+      try {
+        auto code = reader.read_from_string(file_util::read_text_file(path), true, name);
+        auto& file = files.emplace_back();
+        file.name = name;
+        goos::for_each_in_list(code.as_pair()->cdr,
+                               [&](const goos::Object& form) { file.forms.push_back(form); });
+        total_forms += file.forms.size();
+      } catch (std::exception& e) {
+        lg::warn("Failed to read {}: {}", name, e.what());
+      }
+    }
+  }
+  if (files.empty()) {
+    lg::error("No _disasm.gc files found, run the decompiler first");
+    return 1;
+  }
+  lg::info("Printing {} forms from {} files, {} times", total_forms, files.size(), iterations);
+
+  double best_total_ms = 0;
+  size_t total_bytes = 0;
+  for (int i = 0; i < iterations; i++) {
+    double total_ms = 0;
+    total_bytes = 0;
+    for (auto& file : files) {
+      Timer timer;
+      file.output_bytes = 0;
+      for (const auto& form : file.forms) {
+        file.output_bytes += pretty_print::to_string(form, line_length).size();
+      }
+      double ms = timer.getMs();
+      total_ms += ms;
+      total_bytes += file.output_bytes;
+      file.best_ms = i == 0 ? ms : std::min(file.best_ms, ms);
+    }
+    best_total_ms = i == 0 ? total_ms : std::min(best_total_ms, total_ms);
+    lg::info("  iteration {}: {:.2f} ms", i, total_ms);
+  }
+
+  lg::info("Best: {:.2f} ms, {:.1f} MB/s of output", best_total_ms,
+           total_bytes / (1024. * 1024.) / (best_total_ms / 1000.));
+
+  std::sort(files.begin(), files.end(),
+            [](const DisasmFile& a, const DisasmFile& b) { return a.best_ms > b.best_ms; });
+  fmt::print("{:>10}  {:>10}  {}\n", "ms", "KB", "file");
+  for (int i = 0; i < std::min(slowest_count, (int)files.size()); i++) {
+    fmt::print("{:>10.3f}  {:>10.1f}  {}\n", files[i].best_ms, files[i].output_bytes / 1024.,
+               files[i].name);
+  }
+  return 0;
+}
@@ -0,0 +1,104 @@
+// Reads every GOAL source file under the given folders (goal_src by default) with the GOOS reader,
+// and reports how long it takes. The files are loaded before timing, so this only measures the
+// reader itself: tokenizing, building the lists, interning symbols, and linking them in the TextDb.
+
+#include <algorithm>
+#include <regex>
+#include <string>
+#include <vector>
+
+#include "common/goos/Reader.h"
+#include "common/log/log.h"
+#include "common/util/FileUtil.h"
+#include "common/util/Timer.h"
+
+#include "third-party/CLI11.hpp"
+#include "third-party/fmt/core.h"
+
+namespace {
+
+struct SourceFile {
+  std::string name;
+  std::string text;
+  double best_ms = 0;
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::vector<std::string> folders = {"goal_src"};
+  int iterations = 5;
+  int slowest_count = 10;
+  fs::path project_path_override;
+
+  lg::initialize();
+
+  CLI::App app{"OpenGOAL Reader Benchmark"};
+  app.add_option("folders", folders, "Folders to read, relative to the project (default goal_src)");
+  app.add_option("-n,--iterations", iterations, "Number of times to read all the files");
+  app.add_option("--slowest", slowest_count, "Number of slowest files to print");
+  app.add_option("--proj-path", project_path_override,
+                 "Specify the location of the 'data/' folder");
+  app.validate_positionals();
+  CLI11_PARSE(app, argc, argv);
+
+  if (!file_util::setup_project_path(
+          project_path_override.empty() ? std::nullopt : std::optional(project_path_override))) {
+    lg::error("couldn't setup project path, exiting");
+    return 1;
+  }
+
+  std::vector<SourceFile> files;
+  size_t total_bytes = 0;
+  const std::regex source_pattern(".*\\.g[cdps]$");
+  for (const auto& folder : folders) {
+    auto base = file_util::get_jak_project_dir() / folder;
+    for (const auto& path : file_util::find_files_recursively(base, source_pattern)) {
+      auto& file = files.emplace_back();
+      file.name = fs::relative(path, file_util::get_jak_project_dir()).string();
+      file.text = file_util::read_text_file(path);
+      total_bytes += file.text.size();
+    }
+  }
+  lg::info("Reading {} files ({:.2f} MB), {} times", files.size(), total_bytes / (1024. * 1024.),
+           iterations);
+
+  double best_total_ms = 0;
+  int failed = 0;
+  for (int i = 0; i < iterations; i++) {
+    // a new reader each time, so the symbol table and TextDb are the size they'd be in a compile.
+    goos::Reader reader;
+    double total_ms = 0;
+    for (auto& file : files) {
+      Timer timer;
+      try {
+        reader.read_from_string(file.text, true, file.name);
+      } catch (std::exception& e) {
+        if (i == 0) {
+          lg::warn("Failed to read {}: {}", file.name, e.what());
+          failed++;
+        }
+      }
+      double ms = timer.getMs();
+      total_ms += ms;
+      file.best_ms = i == 0 ? ms : std::min(file.best_ms, ms);
+    }
+    best_total_ms = i == 0 ? total_ms : std::min(best_total_ms, total_ms);
+    lg::info("  iteration {}: {:.2f} ms", i, total_ms);
+  }
+
+  lg::info("Best: {:.2f} ms, {:.1f} MB/s", best_total_ms,
+           total_bytes / (1024. * 1024.) / (best_total_ms / 1000.));
+  if (failed) {
+    lg::warn("{} files failed to read", failed);
+  }
+
+  std::sort(files.begin(), files.end(),
+            [](const SourceFile& a, const SourceFile& b) { return a.best_ms > b.best_ms; });
+  fmt::print("{:>10}  {:>10}  {}\n", "ms", "KB", "file");
+  for (int i = 0; i < std::min(slowest_count, (int)files.size()); i++) {
+    fmt::print("{:>10.3f}  {:>10.1f}  {}\n", files[i].best_ms, files[i].text.size() / 1024.,
+               files[i].name);
+  }
+  return 0;
+}
@@ -0,0 +1,394 @@
+// Replays frame captures (from "Capture DMA Frames" in the debug menu) through the renderer
+// with a hidden window, and reports CPU and GPU time percentiles for each bucket and renderer.
+// This gives reproducible numbers for renderer changes without running the game.
+// With --golden, each frame is also rendered once to a png and compared to the golden image of
+// that frame, to catch changes to the output.
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/goal_constants.h"
+#include "common/log/log.h"
+#include "common/util/FileUtil.h"
+#include "common/util/unicode_util.h"
+
+#include "game/graphics/opengl_renderer/FrameCapture.h"
+#include "game/graphics/opengl_renderer/OpenGLRenderer.h"
+#include "game/graphics/opengl_renderer/loader/Loader.h"
+#include "game/graphics/pipelines/opengl.h"
+#include "game/graphics/texture/TexturePool.h"
+
+#include "third-party/CLI11.hpp"
+#include "third-party/SDL/include/SDL.h"
+#include "third-party/fmt/core.h"
+
+namespace {
+
+constexpr PerGameVersion<int> fr3_level_count(jak1::LEVEL_TOTAL, jak2::LEVEL_TOTAL);
+
+struct NodeSamples {
+  std::string path;
+  int depth = 0;
+  std::vector<float> cpu_ms;
+  std::vector<float> gpu_ms;
+};
+
+/*!
+ * Samples for every profiler node seen, in the order they were first seen.
+ */
+struct FrameSamples {
+  std::vector<NodeSamples> nodes;
+  std::unordered_map<std::string, size_t> index_of_path;
+
+  void add(const ProfilerNode& node, int depth) {
+    auto it = index_of_path.find(node.path());
+    if (it == index_of_path.end()) {
+      it = index_of_path.insert({node.path(), nodes.size()}).first;
+      nodes.emplace_back().path = node.path();
+      nodes.back().depth = depth;
+    }
+    auto& samples = nodes[it->second];
+    samples.cpu_ms.push_back(node.stats().duration * 1000.f);
+    samples.gpu_ms.push_back(node.stats().gpu_duration * 1000.f);
+    for (auto& child : node.children()) {
+      add(child, depth + 1);
+    }
+  }
+};
+
+struct Percentiles {
+  float mean = 0, p50 = 0, p90 = 0, p99 = 0, max = 0;
+};
+
+Percentiles compute_percentiles(std::vector<float> samples) {
+  Percentiles result;
+  if (samples.empty()) {
+    return result;
+  }
+  std::sort(samples.begin(), samples.end());
+  auto at = [&](float p) {
+    return samples[std::min(samples.size() - 1, (size_t)(p * samples.size()))];
+  };
+  for (auto x : samples) {
+    result.mean += x;
+  }
+  result.mean /= samples.size();
+  result.p50 = at(0.5f);
+  result.p90 = at(0.9f);
+  result.p99 = at(0.99f);
+  result.max = samples.back();
+  return result;
+}
+
+/*!
+ * Load the levels and textures the game had on this frame.
+ */
+void prepare_frame(Loader& loader,
+                   TexturePool& texture_pool,
+                   const FrameCapture::Frame& frame,
+                   std::vector<std::string>* loaded_levels) {
+  if (frame.levels != *loaded_levels) {
+    loader.set_want_levels(frame.levels);
+    loader.update_blocking(texture_pool);
+    *loaded_levels = frame.levels;
+  }
+  apply_texture_links(texture_pool, frame);
+}
+
+std::string image_name(const fs::path& capture_path, int frame) {
+  return fmt::format("{}_{:04d}.png", capture_path.stem().string(), frame);
+}
+
+/*!
+ * Render every frame of the capture once, in order, and save a png of each to out_dir. The pngs
+ * are finished when the renderer is destroyed.
+ */
+void render_images(OpenGLRenderer& renderer,
+                   Loader& loader,
+                   TexturePool& texture_pool,
+                   SDL_Window* window,
+                   const FrameCapture& capture,
+                   const fs::path& capture_path,
+                   RenderOptions options,
+                   const fs::path& out_dir) {
+  std::vector<std::string> loaded_levels;
+  options.save_screenshot = true;
+  for (int i = 0; i < capture.frame_count(); i++) {
+    auto frame = capture.load_frame(i);
+    prepare_frame(loader, texture_pool, frame, &loaded_levels);
+    options.pmode_alp_register = frame.pmode_alp;
+    options.screenshot_path = (out_dir / image_name(capture_path, i)).string();
+    renderer.render(DmaFollower(frame.dma_data.data(), frame.dma_start_offset), options);
+    SDL_GL_SwapWindow(window);
+  }
+}
+
+/*!
+ * Render the frames of the capture in a loop until all of their levels are loaded and the GPU
+ * timers have caught up, then record the profile of each frame.
+ */
+FrameSamples run_capture(OpenGLRenderer& renderer,
+                         Loader& loader,
+                         TexturePool& texture_pool,
+                         SDL_Window* window,
+                         const FrameCapture& capture,
+                         RenderOptions options,
+                         int warmup,
+                         int iterations) {
+  std::vector<std::string> loaded_levels;
+  FrameSamples samples;
+  FrameCapture::Frame frame;
+  for (int i = 0; i < warmup + iterations; i++) {
+    int idx = i % capture.frame_count();
+    // unpacking is outside of the renderer's profile, and a single frame only needs it once.
+    if (i == 0 || capture.frame_count() > 1) {
+      frame = capture.load_frame(idx);
+      prepare_frame(loader, texture_pool, frame, &loaded_levels);
+    }
+    options.pmode_alp_register = frame.pmode_alp;
+    renderer.render(DmaFollower(frame.dma_data.data(), frame.dma_start_offset), options);
+    SDL_GL_SwapWindow(window);
+    if (i >= warmup) {
+      samples.add(renderer.last_frame_profile(), 0);
+    }
+  }
+  return samples;
+}
+
+/*!
+ * Compare a rendered image to its golden image. Channels that differ by up to tolerance are the
+ * same. Returns the number of pixels that differ, or -1 if either image is missing or they are
+ * different sizes.
+ */
+s64 compare_image(const fs::path& image_path, const fs::path& golden_path, int tolerance) {
+  std::vector<u8> image, golden;
+  int w, h, golden_w, golden_h;
+  if (!file_util::read_rgba_png(image_path, &image, &w, &h) ||
+      !file_util::read_rgba_png(golden_path, &golden, &golden_w, &golden_h) || w != golden_w ||
+      h != golden_h) {
+    return -1;
+  }
+  s64 bad_pixels = 0;
+  for (size_t px = 0; px < image.size(); px += 4) {
+    for (size_t c = 0; c < 4; c++) {
+      if (std::abs(image[px + c] - golden[px + c]) > tolerance) {
+        bad_pixels++;
+        break;
+      }
+    }
+  }
+  return bad_pixels;
+}
+
+void print_report(const std::string& name, const FrameSamples& samples, int max_depth) {
+  fmt::print("{}\n", name);
+  fmt::print("{:50s} {:>40s} {:>40s}\n", "", "cpu ms (mean p50 p90 p99 max)",
+             "gpu ms (mean p50 p90 p99 max)");
+  for (auto& node : samples.nodes) {
+    if (node.depth > max_depth) {
+      continue;
+    }
+    auto cpu = compute_percentiles(node.cpu_ms);
+    auto gpu = compute_percentiles(node.gpu_ms);
+    auto short_name = node.path.substr(node.path.find_last_of('/') + 1);
+    fmt::print("{:50s} {:7.3f} {:7.3f} {:7.3f} {:7.3f} {:7.3f}",
+               std::string(node.depth * 2, ' ') + short_name, cpu.mean, cpu.p50, cpu.p90, cpu.p99,
+               cpu.max);
+    fmt::print(" {:7.3f} {:7.3f} {:7.3f} {:7.3f} {:7.3f}\n", gpu.mean, gpu.p50, gpu.p90, gpu.p99,
+               gpu.max);
+  }
+  fmt::print("\n");
+}
+
+void write_csv(std::ofstream& out, const std::string& name, const FrameSamples& samples) {
+  for (auto& node : samples.nodes) {
+    auto cpu = compute_percentiles(node.cpu_ms);
+    auto gpu = compute_percentiles(node.gpu_ms);
+    out << fmt::format("{},{},{},{},{},{},{},{},{},{},{},{}\n", name, node.path, cpu.mean, cpu.p50,
+                       cpu.p90, cpu.p99, cpu.max, gpu.mean, gpu.p50, gpu.p90, gpu.p99, gpu.max);
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  ArgumentGuard u8_guard(argc, argv);
+
+  std::vector<fs::path> capture_paths;
+  int iterations = 300;
+  int warmup = 30;
+  int width = 0;
+  int height = 0;
+  int msaa = 0;
+  int max_depth = 3;
+  fs::path csv_path;
+  fs::path golden_dir;
+  fs::path out_dir = "render_benchmark_out";
+  bool write_golden = false;
+  int tolerance = 2;
+  double max_bad_fraction = 0.001;
+
+  lg::initialize();
+
+  CLI::App app{"OpenGOAL Renderer Replay Benchmark"};
+  app.add_option("captures", capture_paths, "Frame capture files to replay")->required();
+  app.add_option("-n,--iterations", iterations, "Number of timed frames per capture");
+  app.add_option("--warmup", warmup, "Number of untimed frames before timing each capture");
+  app.add_option("--width", width, "Render width, instead of the capture's");
+  app.add_option("--height", height, "Render height, instead of the capture's");
+  app.add_option("--msaa", msaa, "MSAA samples, instead of the capture's");
+  app.add_option("--depth", max_depth, "Deepest profiler node to print");
+  app.add_option("--csv", csv_path, "Also write all results to this csv file");
+  app.add_option("--golden", golden_dir, "Compare each frame to the golden images in this folder");
+  app.add_option("--out", out_dir, "Folder for the images compared to the golden images");
+  app.add_flag("--write-golden", write_golden, "Write the golden images instead of comparing");
+  app.add_option("--tolerance", tolerance, "Largest difference of a channel that still matches");
+  app.add_option("--max-bad-fraction", max_bad_fraction,
+                 "Fraction of pixels that may differ before a frame fails");
+  app.validate_positionals();
+  CLI11_PARSE(app, argc, argv);
+
+  if (!file_util::setup_project_path({})) {
+    lg::error("couldn't setup project path, exiting");
+    return 1;
+  }
+
+  // GPU timestamps are read back a few frames late, so the warmup has to cover that.
+  warmup = std::max(warmup, 8);
+
+  std::vector<FrameCapture> captures;
+  for (auto& path : capture_paths) {
+    lg::info("Loading capture {}", path.string());
+    captures.push_back(load_frame_capture(path.string()));
+    if (captures.back().game_version != captures.front().game_version) {
+      lg::error("All captures must be from the same game");
+      return 1;
+    }
+    if (captures.back().frame_count() == 0) {
+      lg::error("Capture {} has no frames", path.string());
+      return 1;
+    }
+  }
+  const auto version = captures.front().game_version;
+  const bool render_golden_images = !golden_dir.empty();
+  if (render_golden_images) {
+    if (write_golden) {
+      out_dir = golden_dir;
+    }
+    file_util::create_dir_if_needed(out_dir);
+  }
+
+  auto options_for = [&](const FrameCapture& capture) {
+    RenderOptions options;
+    options.game_res_w = width ? width : capture.game_res_w;
+    options.game_res_h = height ? height : capture.game_res_h;
+    options.window_framebuffer_width = options.game_res_w;
+    options.window_framebuffer_height = options.game_res_h;
+    options.draw_region_width = options.game_res_w;
+    options.draw_region_height = options.game_res_h;
+    options.msaa_samples = msaa ? msaa : capture.msaa_samples;
+    return options;
+  };
+
+  SDL_SetHint(SDL_HINT_NO_SIGNAL_HANDLERS, "1");
+  if (SDL_Init(SDL_INIT_VIDEO) != 0) {
+    lg::error("Could not initialize SDL: {}", SDL_GetError());
+    return 1;
+  }
+  SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1);
+  SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
+  SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 4);
+  SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 3);
+  SDL_GL_SetAttribute(SDL_GL_DEPTH_SIZE, 24);
+  SDL_GL_SetAttribute(SDL_GL_STENCIL_SIZE, 8);
+  SDL_GL_SetAttribute(SDL_GL_ALPHA_SIZE, 8);
+
+  // the window is never shown, we only need it for the context.
+  const auto first_options = options_for(captures.front());
+  SDL_Window* window = SDL_CreateWindow(
+      "render_benchmark", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
+      first_options.game_res_w, first_options.game_res_h, SDL_WINDOW_OPENGL | SDL_WINDOW_HIDDEN);
+  if (!window) {
+    lg::error("Could not create window: {}", SDL_GetError());
+    return 1;
+  }
+  SDL_GLContext gl_context = SDL_GL_CreateContext(window);
+  if (!gl_context || SDL_GL_MakeCurrent(window, gl_context) != 0) {
+    lg::error("Could not create OpenGL context: {}", SDL_GetError());
+    return 1;
+  }
+  SDL_GL_SetSwapInterval(0);
+  if (!gladLoadGLLoader((GLADloadproc)SDL_GL_GetProcAddress)) {
+    lg::error("GL init fail");
+    return 1;
+  }
+  lg::info("OpenGL: {} {}", (const char*)glGetString(GL_VENDOR),
+           (const char*)glGetString(GL_RENDERER));
+
+  std::ofstream csv;
+  if (!csv_path.empty()) {
+    csv.open(csv_path);
+    csv << "capture,node,cpu_mean,cpu_p50,cpu_p90,cpu_p99,cpu_max,gpu_mean,gpu_p50,gpu_p90,gpu_p99,"
+           "gpu_max\n";
+  }
+
+  for (size_t i = 0; i < captures.size(); i++) {
+    // a new renderer for each capture, so the images don't depend on what was replayed before.
+    auto texture_pool = std::make_shared<TexturePool>(version);
+    auto loader = std::make_shared<Loader>(
+        file_util::get_jak_project_dir() / "out" / game_version_names[version] / "fr3",
+        fr3_level_count[version]);
+    OpenGLRenderer renderer(texture_pool, loader, version);
+    auto options = options_for(captures[i]);
+
+    // the images come first, so they start from the same state as the recording.
+    if (render_golden_images) {
+      render_images(renderer, *loader, *texture_pool, window, captures[i], capture_paths[i],
+                    options, out_dir);
+    }
+    auto samples = run_capture(renderer, *loader, *texture_pool, window, captures[i], options,
+                               warmup, iterations);
+    auto name = capture_paths[i].filename().string();
+    print_report(name, samples, max_depth);
+    if (csv.is_open()) {
+      write_csv(csv, name, samples);
+    }
+  }
+
+  SDL_GL_DeleteContext(gl_context);
+  SDL_DestroyWindow(window);
+  SDL_Quit();
+
+  if (!render_golden_images || write_golden) {
+    return 0;
+  }
+
+  int failed_frames = 0;
+  for (size_t i = 0; i < captures.size(); i++) {
+    for (int frame = 0; frame < captures[i].frame_count(); frame++) {
+      auto name = image_name(capture_paths[i], frame);
+      s64 bad_pixels = compare_image(out_dir / name, golden_dir / name, tolerance);
+      auto options = options_for(captures[i]);
+      s64 pixel_count = (s64)options.game_res_w * options.game_res_h;
+      if (bad_pixels < 0) {
+        lg::error("{}: missing image, or the size doesn't match the golden image", name);
+        failed_frames++;
+      } else if (bad_pixels > max_bad_fraction * pixel_count) {
+        lg::error("{}: {} of {} pixels differ from the golden image", name, bad_pixels,
+                  pixel_count);
+        failed_frames++;
+      }
+    }
+  }
+  if (failed_frames) {
+    lg::error("{} frames don't match the golden images", failed_frames);
+    return 1;
+  }
+  lg::info("All frames match the golden images");
+  return 0;
+}
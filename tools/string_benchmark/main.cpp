@@ -0,0 +1,163 @@
+// Times the string utilities and Trie on the GOAL source files under the given folders (goal_src by
+// default). Each file is split into lines and trimmed, with and without copies, then every symbol
+// in the files is added to a Trie and looked up by name and by prefix, like LSP completion does.
+
+#include <algorithm>
+#include <regex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "common/log/log.h"
+#include "common/util/FileUtil.h"
+#include "common/util/Timer.h"
+#include "common/util/Trie.h"
+#include "common/util/string_util.h"
+
+#include "third-party/CLI11.hpp"
+#include "third-party/fmt/core.h"
+
+namespace {
+
+struct Result {
+  const char* name;
+  double best_ms = 0;
+};
+
+// runs the function iterations times, and returns the fastest.
+template <typename F>
+double best_of(int iterations, F&& f) {
+  double best = 0;
+  for (int i = 0; i < iterations; i++) {
+    Timer timer;
+    f();
+    double ms = timer.getMs();
+    best = i == 0 ? ms : std::min(best, ms);
+  }
+  return best;
+}
+
+std::vector<std::string> find_symbols(const std::vector<std::string>& files) {
+  std::unordered_set<std::string> symbols;
+  const std::string separators = " \t\r\n()'`,\"";
+  for (auto& text : files) {
+    size_t pos = 0;
+    while (pos < text.size()) {
+      size_t start = text.find_first_not_of(separators, pos);
+      if (start == std::string::npos) {
+        break;
+      }
+      size_t end = text.find_first_of(separators, start);
+      if (end == std::string::npos) {
+        end = text.size();
+      }
+      symbols.emplace(text, start, end - start);
+      pos = end;
+    }
+  }
+  return std::vector<std::string>(symbols.begin(), symbols.end());
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::vector<std::string> folders = {"goal_src"};
+  int iterations = 5;
+  fs::path project_path_override;
+
+  lg::initialize();
+
+  CLI::App app{"OpenGOAL String Benchmark"};
+  app.add_option("folders", folders, "Folders to read, relative to the project (default goal_src)");
+  app.add_option("-n,--iterations", iterations, "Number of times to run each test");
+  app.add_option("--proj-path", project_path_override,
+                 "Specify the location of the 'data/' folder");
+  app.validate_positionals();
+  CLI11_PARSE(app, argc, argv);
+
+  if (!file_util::setup_project_path(
+          project_path_override.empty() ? std::nullopt : std::optional(project_path_override))) {
+    lg::error("couldn't setup project path, exiting");
+    return 1;
+  }
+
+  std::vector<std::string> files;
+  size_t total_bytes = 0;
+  const std::regex source_pattern(".*\\.g[cdps]$");
+  for (const auto& folder : folders) {
+    auto base = file_util::get_jak_project_dir() / folder;
+    for (const auto& path : file_util::find_files_recursively(base, source_pattern)) {
+      files.push_back(file_util::read_text_file(path));
+      total_bytes += files.back().size();
+    }
+  }
+  auto symbols = find_symbols(files);
+  lg::info("{} files ({:.2f} MB), {} symbols, best of {}", files.size(),
+           total_bytes / (1024. * 1024.), symbols.size(), iterations);
+
+  // the results are added up, so the compiler can't skip the work.
+  size_t check = 0;
+  std::vector<Result> results;
+  results.push_back({"split", best_of(iterations, [&]() {
+                       for (auto& text : files) {
+                         check += str_util::split(text).size();
+                       }
+                     })});
+  results.push_back({"split_view", best_of(iterations, [&]() {
+                       for (auto& text : files) {
+                         check += str_util::split_view(text).size();
+                       }
+                     })});
+  results.push_back({"split + trim", best_of(iterations, [&]() {
+                       for (auto& text : files) {
+                         for (auto& line : str_util::split(text)) {
+                           check += str_util::trim(line).size();
+                         }
+                       }
+                     })});
+  results.push_back({"split_view + trim_view", best_of(iterations, [&]() {
+                       for (auto& text : files) {
+                         for (auto line : str_util::split_view(text)) {
+                           check += str_util::trim_view(line).size();
+                         }
+                       }
+                     })});
+  results.push_back({"trim_newline_indents", best_of(iterations, [&]() {
+                       for (auto& text : files) {
+                         check += str_util::trim_newline_indents(text).size();
+                       }
+                     })});
+
+  results.push_back({"Trie insert", best_of(iterations, [&]() {
+                       Trie<int> trie;
+                       for (auto& symbol : symbols) {
+                         trie.insert(symbol, 1);
+                       }
+                       check += trie.size();
+                     })});
+  Trie<int> trie;
+  for (auto& symbol : symbols) {
+    trie.insert(symbol, 1);
+  }
+  results.push_back({"Trie lookup", best_of(iterations, [&]() {
+                       for (auto& symbol : symbols) {
+                         check += *trie.lookup(symbol);
+                       }
+                     })});
+  // the first few characters of every symbol, as completion would see them while typing.
+  results.push_back({"Trie lookup_prefix", best_of(iterations, [&]() {
+                       for (size_t i = 0; i < symbols.size(); i += 16) {
+                         for (size_t len = 1; len <= std::min((size_t)4, symbols[i].size());
+                              len++) {
+                           check += trie.lookup_prefix(symbols[i].substr(0, len)).size();
+                         }
+                       }
+                     })});
+
+  fmt::print("{:>24}  {:>10}\n", "test", "ms");
+  for (auto& result : results) {
+    fmt::print("{:>24}  {:>10.3f}\n", result.name, result.best_ms);
+  }
+  lg::info("check: {}", check);
+  return 0;
+}
@@ -0,0 +1,153 @@
+// Times vram_to_rgba8888 against the per-pixel conversion TextureConverter used before, which
+// computed the swizzled address and decoded the CLUT entry again for every pixel. VRAM is filled
+// with random data, and the outputs of the two are checked to be identical.
+
+#include <random>
+#include <vector>
+
+#include "common/log/log.h"
+#include "common/texture/texture_conversion.h"
+#include "common/util/Timer.h"
+
+#include "third-party/CLI11.hpp"
+#include "third-party/fmt/core.h"
+
+namespace {
+
+template <typename F>
+double best_ms(int iterations, const F& f) {
+  double best = 0;
+  for (int i = 0; i < iterations; i++) {
+    Timer timer;
+    f();
+    double ms = timer.getMs();
+    best = i == 0 ? ms : std::min(best, ms);
+  }
+  return best;
+}
+
+// the CLUT lookup of the old converter, done for every pixel.
+u32 reference_clut(const u8* vram, u32 value, u32 clut_base, bool psmt4, bool psmct16) {
+  u32 clx, cly;
+  if (psmt4) {
+    clx = value & 0x7;
+    cly = value >> 3;
+  } else {
+    u32 clut_chunk = value / 16;
+    u32 off_in_chunk = value % 16;
+    clx = (clut_chunk & 1) ? 8 : 0;
+    cly = (clut_chunk >> 1) * 2;
+    if (off_in_chunk >= 8) {
+      off_in_chunk -= 8;
+      cly++;
+    }
+    clx += off_in_chunk;
+  }
+  if (psmct16) {
+    u16 clut_value;
+    memcpy(&clut_value, vram + psmct16_addr(clx, cly, 64) + clut_base, 2);
+    return rgba16_to_rgba32(clut_value);
+  }
+  u32 clut_value;
+  memcpy(&clut_value, vram + psmct32_addr(clx, cly, 64) + clut_base, 4);
+  return clut_value;
+}
+
+void reference_convert(u32* out,
+                       const u8* vram,
+                       u32 tex_base,
+                       u32 w,
+                       u32 h,
+                       u32 width,
+                       PSM psm,
+                       u32 clut_base,
+                       bool clut16) {
+  u32 i = 0;
+  for (u32 y = 0; y < h; y++) {
+    for (u32 x = 0; x < w; x++) {
+      switch (psm) {
+        case PSM::PSMT8:
+          out[i++] = reference_clut(vram, vram[psmt8_addr(x, y, width) + tex_base * 256],
+                                    clut_base, false, clut16);
+          break;
+        case PSM::PSMT4: {
+          u32 addr = psmt4_addr_half_byte(x, y, width) + tex_base * 512;
+          u8 value = vram[addr / 2];
+          value = (addr & 1) ? (value >> 4) : (value & 0x0f);
+          out[i++] = reference_clut(vram, value, clut_base, true, clut16);
+        } break;
+        case PSM::PSMCT16: {
+          u16 value;
+          memcpy(&value, vram + psmct16_addr(x, y, width) + tex_base * 256, 2);
+          out[i++] = rgba16_to_rgba32(value);
+        } break;
+        case PSM::PSMCT32:
+          memcpy(&out[i++], vram + psmct32_addr(x, y, width) + tex_base * 256, 4);
+          break;
+      }
+    }
+  }
+}
+
+struct Case {
+  const char* name;
+  PSM psm;
+  bool clut16;
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int iterations = 20;
+  u32 size = 256;
+
+  lg::initialize();
+
+  CLI::App app{"OpenGOAL Texture Conversion Benchmark"};
+  app.add_option("-n,--iterations", iterations, "Number of times to time each format");
+  app.add_option("--size", size, "Width and height of the texture, a multiple of 128");
+  CLI11_PARSE(app, argc, argv);
+  size = std::clamp((size + 127) / 128 * 128, 128u, 1024u);
+
+  std::mt19937 rng(0);
+  std::vector<u8> vram(4 * 1024 * 1024);
+  for (auto& x : vram) {
+    x = rng();
+  }
+  // the texture at the start of VRAM, the CLUT after it.
+  const u32 tex_base = 0;
+  const u32 clut_base = 2 * 1024 * 1024;
+
+  const Case cases[] = {
+      {"PSMT8/CT32", PSM::PSMT8, false}, {"PSMT8/CT16", PSM::PSMT8, true},
+      {"PSMT4/CT32", PSM::PSMT4, false}, {"PSMT4/CT16", PSM::PSMT4, true},
+      {"PSMCT16", PSM::PSMCT16, false},  {"PSMCT32", PSM::PSMCT32, false},
+  };
+
+  std::vector<u32> reference(size * size);
+  std::vector<u32> result(size * size);
+  u32 palette[256];
+  bool all_match = true;
+  fmt::print("{}x{} textures\n", size, size);
+  fmt::print("{:>12}  {:>10}  {:>12}  {:>8}  {}\n", "format", "table ms", "per-pixel ms", "speedup",
+             "output");
+  for (const auto& c : cases) {
+    const bool has_clut = c.psm == PSM::PSMT8 || c.psm == PSM::PSMT4;
+    // the palette is decoded once per texture, so it's part of the time.
+    double table = best_ms(iterations, [&]() {
+      if (has_clut) {
+        load_clut_rgba8888(palette, vram.data(), clut_base, c.psm == PSM::PSMT4, c.clut16);
+      }
+      vram_to_rgba8888(result.data(), vram.data(), tex_base, size, size, size, c.psm, palette);
+    });
+    double per_pixel = best_ms(iterations, [&]() {
+      reference_convert(reference.data(), vram.data(), tex_base, size, size, size, c.psm,
+                        clut_base, c.clut16);
+    });
+    bool match = reference == result;
+    all_match &= match;
+    fmt::print("{:>12}  {:>10.3f}  {:>12.3f}  {:>7.2f}x  {}\n", c.name, table, per_pixel,
+               per_pixel / table, match ? "same" : "DIFFERENT");
+  }
+  return all_match ? 0 : 1;
+}
@@ -0,0 +1,131 @@
+#include "TypeSearchIndex.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace {
+std::vector<int> intersect(const std::vector<int>& a, const std::vector<int>& b) {
+  std::vector<int> result;
+  std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(result));
+  return result;
+}
+}  // namespace
+
+TypeSearchIndex::TypeSearchIndex(TypeSystem& ts) {
+  for (auto& name : ts.get_all_type_names()) {
+    // Only NullType's have no parent
+    if (ts.lookup_type(name)->has_parent()) {
+      m_names.push_back(name);
+    }
+  }
+  std::sort(m_names.begin(), m_names.end());
+
+  for (int id = 0; id < (int)m_names.size(); id++) {
+    m_ids[m_names[id]] = id;
+  }
+
+  for (int id = 0; id < (int)m_names.size(); id++) {
+    auto type = ts.lookup_type(m_names[id]);
+    m_children[type->get_parent()].push_back(id);
+    m_by_size.emplace_back(type->get_size_in_memory(), id);
+    auto method_count = ts.try_get_type_method_count(m_names[id]);
+    if (method_count) {
+      m_by_method_id.emplace_back(*method_count - 1, id);
+    }
+    if (auto structure = dynamic_cast<StructureType*>(type)) {
+      for (auto& field : structure->fields()) {
+        auto& ids = m_by_field[{field.offset(), field.type().base_type()}];
+        // a type can have two fields of the same type at the same offset.
+        if (ids.empty() || ids.back() != id) {
+          ids.push_back(id);
+        }
+      }
+    }
+  }
+  std::sort(m_by_size.begin(), m_by_size.end());
+  std::sort(m_by_method_id.begin(), m_by_method_id.end());
+}
+
+TypeSearchIndex::Ids TypeSearchIndex::descendants(const std::string& parent) const {
+  Ids result;
+  auto it = m_ids.find(parent);
+  if (it != m_ids.end()) {
+    result.push_back(it->second);
+  }
+  std::vector<std::string> stack = {parent};
+  while (!stack.empty()) {
+    auto children = m_children.find(stack.back());
+    stack.pop_back();
+    if (children == m_children.end()) {
+      continue;
+    }
+    for (int child : children->second) {
+      if (m_names[child] != children->first) {
+        result.push_back(child);
+        stack.push_back(m_names[child]);
+      }
+    }
+  }
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  return result;
+}
+
+TypeSearchIndex::Ids TypeSearchIndex::with_min_method_id(int min_method_id) const {
+  Ids result;
+  auto it = std::lower_bound(m_by_method_id.begin(), m_by_method_id.end(),
+                             std::make_pair(min_method_id, -1));
+  for (; it != m_by_method_id.end(); ++it) {
+    result.push_back(it->second);
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+TypeSearchIndex::Ids TypeSearchIndex::with_size(int min_size, int max_size) const {
+  Ids result;
+  auto it = std::lower_bound(m_by_size.begin(), m_by_size.end(), std::make_pair(min_size, -1));
+  for (; it != m_by_size.end() && it->first <= max_size; ++it) {
+    result.push_back(it->second);
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+TypeSearchIndex::Ids TypeSearchIndex::with_field(
+    const TypeSystem::TypeSearchFieldInput& field) const {
+  auto it = m_by_field.find({field.field_offset, field.field_type_name});
+  if (it == m_by_field.end()) {
+    return {};
+  }
+  return it->second;
+}
+
+std::vector<std::string> TypeSearchIndex::search(const Query& query) const {
+  // start from the most selective index, then narrow it down.
+  std::optional<Ids> ids;
+  auto narrow = [&](Ids&& matches) {
+    ids = ids ? intersect(*ids, matches) : std::move(matches);
+  };
+  for (auto& field : query.fields) {
+    narrow(with_field(field));
+  }
+  if (query.min_size) {
+    narrow(with_size(*query.min_size, query.max_size.value_or(*query.min_size)));
+  }
+  if (query.parent) {
+    narrow(descendants(*query.parent));
+  }
+  if (query.min_method_id) {
+    narrow(with_min_method_id(*query.min_method_id));
+  }
+
+  std::vector<std::string> result;
+  if (!ids) {
+    return m_names;
+  }
+  for (int id : *ids) {
+    result.push_back(m_names[id]);
+  }
+  return result;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <map>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "common/type_system/TypeSystem.h"
+
+/*!
+ * Indexes of every type in a TypeSystem by size, method count, parent and fields, so each search
+ * is a few lookups and intersections instead of a pass over every type.
+ */
+class TypeSearchIndex {
+ public:
+  explicit TypeSearchIndex(TypeSystem& ts);
+
+  struct Query {
+    std::optional<std::string> parent;
+    std::optional<int> min_method_id;
+    std::optional<int> min_size;
+    std::optional<int> max_size;  // if min_size is set without this, the size must be exact
+    std::vector<TypeSystem::TypeSearchFieldInput> fields;
+  };
+
+  // the names of the types matching all of the query, in alphabetical order.
+  std::vector<std::string> search(const Query& query) const;
+  const std::vector<std::string>& all_names() const { return m_names; }
+
+ private:
+  using Ids = std::vector<int>;  // indices into m_names, sorted.
+  Ids descendants(const std::string& parent) const;
+  Ids with_min_method_id(int min_method_id) const;
+  Ids with_size(int min_size, int max_size) const;
+  Ids with_field(const TypeSystem::TypeSearchFieldInput& field) const;
+
+  std::vector<std::string> m_names;
+  std::unordered_map<std::string, int> m_ids;
+  std::unordered_map<std::string, Ids> m_children;
+  // (size, id) and (highest method id, id), sorted.
+  std::vector<std::pair<int, int>> m_by_size;
+  std::vector<std::pair<int, int>> m_by_method_id;
+  // (offset, field type) -> types with a field of that type at that offset.
+  std::map<std::pair<int, std::string>, Ids> m_by_field;
+};
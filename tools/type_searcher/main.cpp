@@ -3,6 +3,7 @@
 // - field types at given offsets
 // - parent-types
 // - ...
+// Many queries can be run at once with --batch, which loads the types and builds the indexes once.
 
 #include "common/log/log.h"
 #include "common/util/FileUtil.h"
@@ -11,15 +12,69 @@
 #include "common/util/unicode_util.h"
 
 #include "decompiler/util/DecompilerTypeSystem.h"
+#include "tools/type_searcher/TypeSearchIndex.h"
 
 #include "third-party/CLI11.hpp"
 #include "third-party/fmt/core.h"
 #include "third-party/json.hpp"
 
+namespace {
+/*!
+ * Parse a size, which can be a range (max-min). Assumes decimal.
+ */
+void parse_size(const std::string& type_size, TypeSearchIndex::Query& query) {
+  if (str_util::contains(type_size, "-")) {
+    auto tokens = str_util::split(type_size, '-');
+    query.min_size = std::stoi(tokens[0]);
+    query.max_size = std::stoi(tokens[1]);
+  } else {
+    query.min_size = std::stoi(type_size);
+  }
+}
+
+void parse_fields(const nlohmann::json& data, TypeSearchIndex::Query& query) {
+  for (auto& item : data) {
+    TypeSystem::TypeSearchFieldInput new_field;
+    try {
+      new_field.field_offset = item.at("offset").get<int>();
+      new_field.field_type_name = item.at("type").get<std::string>();
+      query.fields.push_back(new_field);
+    } catch (std::exception& ex) {
+      fmt::print("Bad field search entry - {}", ex.what());
+    }
+  }
+}
+
+/*!
+ * A query in a batch file, with the same keys as the command line options:
+ * {"parent": "process", "method_id": 20, "size": "16-32",
+ *  "fields": [{"offset": 4, "type": "int32"}]}
+ */
+TypeSearchIndex::Query parse_batch_query(const nlohmann::json& data) {
+  TypeSearchIndex::Query query;
+  if (data.contains("parent")) {
+    query.parent = data.at("parent").get<std::string>();
+  }
+  if (data.contains("method_id")) {
+    query.min_method_id = data.at("method_id").get<int>();
+  }
+  if (data.contains("size")) {
+    auto& size = data.at("size");
+    parse_size(size.is_string() ? size.get<std::string>() : std::to_string(size.get<int>()),
+               query);
+  }
+  if (data.contains("fields")) {
+    parse_fields(data.at("fields"), query);
+  }
+  return query;
+}
+}  // namespace
+
 int main(int argc, char** argv) {
   ArgumentGuard u8_guard(argc, argv);
 
   fs::path output_path;
+  fs::path batch_path;
   std::string game_name = "jak1";
   std::string parent_type = "";
   int method_id_min = -1;
@@ -42,6 +97,9 @@ int main(int argc, char** argv) {
   app.add_option("-f,--fields", field_json,
                  "JSON encoded string specifying which field types and their offsets are required "
                  "- [{offset,type}]");
+  app.add_option("-b,--batch", batch_path,
+                 "JSON file with a list of queries - [{parent,method_id,size,fields}]. The results "
+                 "are a list with the matching types of each query");
   app.validate_positionals();
   CLI11_PARSE(app, argc, argv);
 
@@ -56,9 +114,8 @@ int main(int argc, char** argv) {
 
   decompiler::DecompilerTypeSystem dts(game_version);
 
-  // TODO - this could be better (have a jak1 folder)
   if (game_version == GameVersion::Jak1) {
-    dts.parse_type_defs({"decompiler", "config", "all-types.gc"});
+    dts.parse_type_defs({"decompiler", "config", "jak1", "all-types.gc"});
   } else if (game_version == GameVersion::Jak2) {
     dts.parse_type_defs({"decompiler", "config", "jak2", "all-types.gc"});
   } else {
@@ -66,11 +123,11 @@ int main(int argc, char** argv) {
     return 1;
   }
 
+  TypeSearchIndex index(dts.ts);
   auto results = nlohmann::json::array({});
 
   if (get_all) {
-    auto type_names = dts.ts.get_all_type_names();
-    for (const auto& name : type_names) {
+    for (const auto& name : index.all_names()) {
       fmt::print("{}\n", name);
       results.push_back(name);
     }
@@ -80,54 +137,32 @@ int main(int argc, char** argv) {
     return 0;
   }
 
-  std::optional<std::vector<std::string>> potential_types = {};
+  if (!batch_path.empty()) {
+    auto queries = parse_commented_json(file_util::read_text_file(batch_path), batch_path.string());
+    for (auto& query : queries) {
+      results.push_back(index.search(parse_batch_query(query)));
+    }
+    fmt::print("Ran {} queries\n", results.size());
+    file_util::write_text_file(output_path.string(), results.dump());
+    return 0;
+  }
 
-  // First filter by parent type is available
+  TypeSearchIndex::Query query;
   if (!parent_type.empty()) {
-    potential_types = dts.ts.search_types_by_parent_type(parent_type);
+    query.parent = parent_type;
   }
-
-  // Filter by method count
   if (method_id_min != -1) {
-    potential_types = dts.ts.search_types_by_minimum_method_id(method_id_min, potential_types);
+    query.min_method_id = method_id_min;
   }
-
-  // Filter out types by size next
   if (!type_size.empty()) {
-    // Check if a range was given
-    int min_size = 0;
-    std::optional<int> max_size = {};
-    if (str_util::contains(type_size, "-")) {
-      auto tokens = str_util::split(type_size, '-');
-      min_size = std::stoi(tokens[0]);
-      max_size = std::stoi(tokens[1]);
-    } else {
-      min_size = std::stoi(type_size);
-    }
-    potential_types = dts.ts.search_types_by_size(min_size, max_size, potential_types);
+    parse_size(type_size, query);
   }
-
-  // Filter out by fields
   if (!field_json.empty()) {
-    std::vector<TypeSystem::TypeSearchFieldInput> search_fields = {};
-    if (!field_json.empty()) {
-      auto data = parse_commented_json(field_json, "--fields arg");
-      for (auto& item : data) {
-        TypeSystem::TypeSearchFieldInput new_field;
-        try {
-          new_field.field_offset = item.at("offset").get<int>();
-          new_field.field_type_name = item.at("type").get<std::string>();
-          search_fields.push_back(new_field);
-        } catch (std::exception& ex) {
-          fmt::print("Bad field search entry - {}", ex.what());
-        }
-      }
-    }
-    potential_types = dts.ts.search_types_by_fields(search_fields, potential_types);
+    parse_fields(parse_commented_json(field_json, "--fields arg"), query);
   }
 
-  if (potential_types) {
-    for (const auto& val : potential_types.value()) {
+  if (query.parent || query.min_method_id || query.min_size || !field_json.empty()) {
+    for (const auto& val : index.search(query)) {
       fmt::print("{}\n", val);
       results.push_back(val);
     }
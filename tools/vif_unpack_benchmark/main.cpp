@@ -0,0 +1,76 @@
+// Times vif_unpack against the one-value-at-a-time reference for each unpack format, with the
+// sizes of unpacks the renderers see: a few hundred vectors at a time.
+
+#include <random>
+#include <vector>
+
+#include "common/dma/vif_unpack.h"
+#include "common/log/log.h"
+#include "common/util/Timer.h"
+
+#include "third-party/CLI11.hpp"
+#include "third-party/fmt/core.h"
+
+namespace {
+const char* format_names[16] = {"S-32",  "S-16",  "S-8",  "",    "V2-32", "V2-16",
+                                "V2-8",  "",      "V3-32", "V3-16", "V3-8", "",
+                                "V4-32", "V4-16", "V4-8", "V4-5"};
+
+template <typename F>
+double best_ms(int iterations, const F& f) {
+  double best = 0;
+  for (int i = 0; i < iterations; i++) {
+    Timer timer;
+    f();
+    double ms = timer.getMs();
+    best = i == 0 ? ms : std::min(best, ms);
+  }
+  return best;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  int iterations = 10;
+  int unpacks = 10000;
+  u32 num = 200;
+
+  lg::initialize();
+
+  CLI::App app{"OpenGOAL VIF Unpack Benchmark"};
+  app.add_option("-n,--iterations", iterations, "Number of times to time each format");
+  app.add_option("--unpacks", unpacks, "Number of unpacks per iteration");
+  app.add_option("--num", num, "Vectors per unpack (max 256)");
+  CLI11_PARSE(app, argc, argv);
+  num = std::min(num, (u32)256);
+
+  std::mt19937 rng(0);
+  std::vector<u8> src(num * 16);
+  for (auto& x : src) {
+    x = rng();
+  }
+  std::vector<u8> dst(num * 16 * 4);
+
+  fmt::print("{:>6}  {:>4}  {:>12}  {:>12}  {:>8}\n", "format", "wl", "simd ms", "scalar ms",
+             "speedup");
+  for (u8 format = 0; format < 16; format++) {
+    auto kind = (VifCode::Kind)((u8)VifCode::Kind::UNPACK_MASK | format);
+    if (!vif_unpack_supported(kind)) {
+      continue;
+    }
+    for (u16 wl : {4, 2}) {
+      double simd = best_ms(iterations, [&]() {
+        for (int i = 0; i < unpacks; i++) {
+          vif_unpack(dst.data(), src.data(), kind, num, true, 4, wl);
+        }
+      });
+      double scalar = best_ms(iterations, [&]() {
+        for (int i = 0; i < unpacks; i++) {
+          vif_unpack_reference(dst.data(), src.data(), kind, num, true, 4, wl);
+        }
+      });
+      fmt::print("{:>6}  {:>4}  {:>12.3f}  {:>12.3f}  {:>7.2f}x\n", format_names[format], wl, simd,
+                 scalar, scalar / simd);
+    }
+  }
+  return 0;
+}